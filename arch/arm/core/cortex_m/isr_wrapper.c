@@ -77,8 +77,17 @@ void _isr_wrapper(void)
 	irq_number -= 16;
 
 	struct _isr_table_entry *entry = &_sw_isr_table[irq_number];
+
+#ifdef CONFIG_IRQ_STATS_ISR
+	z_irq_stats_isr_enter();
+#endif /* CONFIG_IRQ_STATS_ISR */
+
 	(entry->isr)(entry->arg);
 
+#ifdef CONFIG_IRQ_STATS_ISR
+	z_irq_stats_isr_exit(irq_number);
+#endif /* CONFIG_IRQ_STATS_ISR */
+
 #if defined(CONFIG_ARM_CUSTOM_INTERRUPT_CONTROLLER)
 	z_soc_irq_eoi(irq_number);
 #endif
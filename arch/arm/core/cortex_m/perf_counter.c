@@ -0,0 +1,52 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM Cortex-M performance counters based on DWT
+ *
+ * The DWT profiling counters other than the cycle counter are only 8-bit
+ * wide, too narrow to be read at context switches, so only cycles can be
+ * counted.
+ */
+
+#include <zephyr/kernel.h>
+#include <cortex_m/dwt.h>
+#include <cmsis_core.h>
+
+unsigned int arch_perf_counter_num(void)
+{
+	return CONFIG_PERF_COUNTERS_NUM;
+}
+
+int arch_perf_counter_start(unsigned int idx, enum k_perf_event event)
+{
+	ARG_UNUSED(idx);
+
+	if (event != K_PERF_EVENT_CYCLES) {
+		return -ENOTSUP;
+	}
+
+	/* The cycle counter may be shared with the timing functions, it is
+	 * never reset.
+	 */
+	z_arm_dwt_init();
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	return 0;
+}
+
+void arch_perf_counter_stop(unsigned int idx)
+{
+	ARG_UNUSED(idx);
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	ARG_UNUSED(idx);
+
+	return z_arm_dwt_get_cycles();
+}
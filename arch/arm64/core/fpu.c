@@ -269,6 +269,9 @@ void z_arm64_fpu_trap(struct arch_esf *esf)
 	/* restore our content */
 	z_arm64_fpu_restore(&_current->arch.saved_fp_context);
 	DBG("restore", _current);
+
+	/* active FPU user, restore its content eagerly for a while */
+	_current->arch.fpu_usage = CONFIG_FPU_SHARING_EAGER_SWITCHES;
 }
 
 /*
@@ -290,6 +293,25 @@ static void fpu_access_update(unsigned int exc_update_level)
 		if (atomic_ptr_get(&_current_cpu->arch.fpu_owner) == _current) {
 			/* turn on FPU access */
 			write_cpacr_el1(cpacr | CPACR_EL1_FPEN_NOTRAP);
+		} else if (_current->arch.fpu_usage > 0) {
+			/*
+			 * This thread trapped on FPU access within its last
+			 * few context switches, but someone else took the FPU
+			 * away in the mean time. Let's preemptively claim it
+			 * back to avoid the likely exception trap to come
+			 * otherwise. Without another trap, the thread is
+			 * left to the on-demand regime after a few times.
+			 */
+			_current->arch.fpu_usage--;
+			arch_flush_local_fpu();
+#ifdef CONFIG_SMP
+			flush_owned_fpu(_current);
+#endif
+			write_cpacr_el1(cpacr | CPACR_EL1_FPEN_NOTRAP);
+			barrier_isync_fence_full();
+			atomic_ptr_set(&_current_cpu->arch.fpu_owner, _current);
+			z_arm64_fpu_restore(&_current->arch.saved_fp_context);
+			DBG("reclaim", _current);
 		} else {
 			/* deny FPU access */
 			write_cpacr_el1(cpacr & ~CPACR_EL1_FPEN_NOTRAP);
@@ -1185,6 +1185,24 @@ size_t arch_virt_region_align(uintptr_t phys, size_t size)
 	return alignment;
 }
 
+size_t arch_mem_large_page_size(uintptr_t phys, size_t size)
+{
+	uint64_t level_size;
+	unsigned int level;
+
+	/* Level 0 descriptors cannot be blocks */
+	for (level = MAX(BASE_XLAT_LEVEL, 1U); level < XLAT_LAST_LEVEL; level++) {
+		level_size = 1ULL << LEVEL_TO_VA_SIZE_SHIFT(level);
+
+		if ((ROUND_UP((uint64_t)phys, level_size) + level_size) <=
+		    ((uint64_t)phys + size)) {
+			return level_size;
+		}
+	}
+
+	return CONFIG_MMU_PAGE_SIZE;
+}
+
 #ifdef CONFIG_USERSPACE
 
 static uint16_t next_asid = 1;
@@ -1445,6 +1463,48 @@ void arch_mem_page_out(void *addr, uintptr_t location)
 	invalidate_tlb_page(virt);
 }
 
+#ifdef CONFIG_DEMAND_MAPPING_ZERO_PAGE
+/* Shared read-only backing of the anonymous pages not written yet */
+static __pinned_bss uint8_t zero_page[CONFIG_MMU_PAGE_SIZE] __aligned(CONFIG_MMU_PAGE_SIZE);
+
+/*
+ * Map an unpaged anonymous zeroed page to the zero page on a read fault,
+ * without involving the core code. The write fault that follows goes
+ * through the regular page fault path, which allocates a page frame.
+ */
+static bool map_zero_page(uint64_t *pte, uintptr_t virt)
+{
+	k_spinlock_key_t key = k_spin_lock(&z_mm_lock);
+	uint64_t desc = *pte;
+
+	/* the core code may be paging it in meanwhile */
+	if ((desc & PTE_DESC_TYPE_MASK) != PTE_INVALID_DESC ||
+	    (desc & PTE_PHYSADDR_MASK) != ARCH_UNPAGED_ANON_ZERO) {
+		k_spin_unlock(&z_mm_lock, key);
+		return false;
+	}
+
+	desc &= ~(PTE_DESC_TYPE_MASK | PTE_PHYSADDR_MASK);
+	desc |= PTE_PAGE_DESC | K_MEM_PHYS_ADDR((uintptr_t)zero_page);
+	desc |= PTE_BLOCK_DESC_AP_RO | PTE_BLOCK_DESC_AF | PTE_SW_ZERO_PAGE;
+
+	*pte = desc;
+	MMU_DEBUG("zero_page: virt=%#lx\n", virt);
+	debug_show_pte(pte, XLAT_LAST_LEVEL);
+
+	sync_domains(virt, CONFIG_MMU_PAGE_SIZE, "zero_page");
+	/* no TLB inval needed when making an invalid entry valid */
+	k_spin_unlock(&z_mm_lock, key);
+
+	return true;
+}
+#endif /* CONFIG_DEMAND_MAPPING_ZERO_PAGE */
+
+static inline bool is_zero_page_desc(uint64_t desc)
+{
+	return IS_ENABLED(CONFIG_DEMAND_MAPPING_ZERO_PAGE) && (desc & PTE_SW_ZERO_PAGE) != 0;
+}
+
 void arch_mem_page_in(void *addr, uintptr_t phys)
 {
 	uintptr_t virt = (uintptr_t)addr;
@@ -1469,7 +1529,7 @@ void arch_mem_page_in(void *addr, uintptr_t phys)
 	desc |= PTE_BLOCK_DESC_AP_RO;
 
 	/* and make it initially unaccessible to track unaccessed pages */
-	desc &= ~PTE_BLOCK_DESC_AF;
+	desc &= ~(PTE_BLOCK_DESC_AF | PTE_SW_ZERO_PAGE);
 
 	*pte = desc;
 	MMU_DEBUG("page_in: virt=%#lx phys=%#lx\n", virt, phys);
@@ -1494,6 +1554,12 @@ enum arch_page_location arch_page_location_get(void *addr, uintptr_t *location)
 		return ARCH_PAGE_LOCATION_BAD;
 	}
 
+	if (is_zero_page_desc(desc)) {
+		/* not backed by a page frame of its own */
+		*location = ARCH_UNPAGED_ANON_ZERO;
+		return ARCH_PAGE_LOCATION_PAGED_OUT;
+	}
+
 	switch (desc & PTE_DESC_TYPE_MASK) {
 	case PTE_PAGE_DESC:
 		status = ARCH_PAGE_LOCATION_PAGED_IN;
@@ -1524,6 +1590,14 @@ uintptr_t arch_page_info_get(void *addr, uintptr_t *phys, bool clear_accessed)
 		return ARCH_DATA_PAGE_NOT_MAPPED;
 	}
 
+	if (is_zero_page_desc(desc)) {
+		/* same as a page not loaded yet */
+		if (phys) {
+			*phys = ARCH_UNPAGED_ANON_ZERO;
+		}
+		return 0;
+	}
+
 	switch (desc & PTE_DESC_TYPE_MASK) {
 	case PTE_PAGE_DESC:
 		status |= ARCH_DATA_PAGE_LOADED;
@@ -1627,10 +1701,24 @@ bool z_arm64_do_demand_paging(struct arch_esf *esf, uint64_t esr, uint64_t far)
 	}
 	desc = *pte;
 	if ((desc & PTE_DESC_TYPE_MASK) != PTE_PAGE_DESC) {
+#ifdef CONFIG_DEMAND_MAPPING_ZERO_PAGE
+		/* data reads of anonymous memory never written are served
+		 * by the zero page
+		 */
+		if (GET_ESR_EC(esr) == 0x25 && (GET_ESR_ISS(esr) & BIT(6)) == 0 &&
+		    map_zero_page(pte, virt)) {
+			return true;
+		}
+#endif /* CONFIG_DEMAND_MAPPING_ZERO_PAGE */
 		/* page is not loaded/mapped */
 		return do_mem_page_fault(esf, virt);
 	}
 
+	if (is_zero_page_desc(desc)) {
+		/* first write to the zero page: get a page frame of its own */
+		return do_mem_page_fault(esf, virt);
+	}
+
 	/*
 	 * From this point, we expect only 2 cases:
 	 *
@@ -134,6 +134,12 @@
  */
 #define PTE_SW_WRITABLE			(1ULL << 55)
 
+/*
+ * Bit 56 marks anonymous pages mapped to the shared zero page as long as
+ * they are only read. They are reported as paged out to the core code.
+ */
+#define PTE_SW_ZERO_PAGE		(1ULL << 56)
+
 /*
  * TCR definitions.
  */
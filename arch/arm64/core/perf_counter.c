@@ -0,0 +1,85 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM64 performance counters based on the PMUv3 event counters
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/arm64/lib_helpers.h>
+#include <zephyr/sys/barrier.h>
+
+#define PMCR_EL0_E		BIT(0)
+#define PMCR_EL0_N_SHIFT	11
+#define PMCR_EL0_N_MASK		0x1F
+
+/* Common architectural and microarchitectural event numbers */
+#define PMU_EVENT_L1D_CACHE_REFILL	0x03
+#define PMU_EVENT_INST_RETIRED		0x08
+#define PMU_EVENT_BR_MIS_PRED		0x10
+#define PMU_EVENT_CPU_CYCLES		0x11
+#define PMU_EVENT_STALL_BACKEND		0x24
+
+static int pmu_event(enum k_perf_event event)
+{
+	switch (event) {
+	case K_PERF_EVENT_CYCLES:
+		return PMU_EVENT_CPU_CYCLES;
+	case K_PERF_EVENT_INSTRUCTIONS:
+		return PMU_EVENT_INST_RETIRED;
+	case K_PERF_EVENT_CACHE_MISSES:
+		return PMU_EVENT_L1D_CACHE_REFILL;
+	case K_PERF_EVENT_BRANCH_MISSES:
+		return PMU_EVENT_BR_MIS_PRED;
+	case K_PERF_EVENT_STALLS:
+		return PMU_EVENT_STALL_BACKEND;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void pmu_select(unsigned int idx)
+{
+	write_sysreg(idx, pmselr_el0);
+	barrier_isync_fence_full();
+}
+
+unsigned int arch_perf_counter_num(void)
+{
+	return (read_sysreg(pmcr_el0) >> PMCR_EL0_N_SHIFT) & PMCR_EL0_N_MASK;
+}
+
+int arch_perf_counter_start(unsigned int idx, enum k_perf_event event)
+{
+	int type = pmu_event(event);
+
+	if (type < 0) {
+		return type;
+	}
+
+	/* Count in all exception levels */
+	pmu_select(idx);
+	write_sysreg(type, pmxevtyper_el0);
+	write_sysreg(read_sysreg(pmcr_el0) | PMCR_EL0_E, pmcr_el0);
+	write_sysreg(BIT(idx), pmcntenset_el0);
+	barrier_isync_fence_full();
+
+	return 0;
+}
+
+void arch_perf_counter_stop(unsigned int idx)
+{
+	write_sysreg(BIT(idx), pmcntenclr_el0);
+	barrier_isync_fence_full();
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	pmu_select(idx);
+
+	return (uint32_t)read_sysreg(pmxevcntr_el0);
+}
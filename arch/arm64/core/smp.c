@@ -191,7 +191,8 @@ static void send_ipi(unsigned int ipi, uint32_t cpu_bitmap)
 	uint64_t mpidr = MPIDR_TO_CORE(GET_MPIDR());
 
 	/*
-	 * Send SGI to all cores except itself
+	 * Send SGI to all cores except itself, with one SGI per cluster
+	 * listing its targeted cores
 	 */
 	unsigned int num_cpus = arch_num_cpus();
 
@@ -201,14 +202,28 @@ static void send_ipi(unsigned int ipi, uint32_t cpu_bitmap)
 		}
 
 		uint64_t target_mpidr = cpu_map[i];
-		uint8_t aff0;
+		uint64_t cluster = target_mpidr >> MPIDR_AFF1_SHIFT;
+		uint16_t target_list = 0;
 
-		if (mpidr == target_mpidr || target_mpidr == INV_MPID) {
-			continue;
+		for (int j = i; j < num_cpus; j++) {
+			uint64_t core_mpidr = cpu_map[j];
+
+			if (((cpu_bitmap & BIT(j)) == 0) ||
+			    ((core_mpidr >> MPIDR_AFF1_SHIFT) != cluster)) {
+				continue;
+			}
+			cpu_bitmap &= ~BIT(j);
+
+			if (mpidr == core_mpidr || core_mpidr == INV_MPID) {
+				continue;
+			}
+
+			target_list |= 1 << MPIDR_AFFLVL(core_mpidr, 0);
 		}
 
-		aff0 = MPIDR_AFFLVL(target_mpidr, 0);
-		gic_raise_sgi(ipi, target_mpidr, 1 << aff0);
+		if (target_list != 0) {
+			gic_raise_sgi(ipi, target_mpidr, target_list);
+		}
 	}
 }
 
@@ -135,6 +135,9 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 
 	/* thread birth happens through the exception return path */
 	thread->arch.exception_depth = 1;
+#ifdef CONFIG_FPU_SHARING
+	thread->arch.fpu_usage = 0;
+#endif
 
 	/*
 	 * We are saving SP_EL1 to pop out entry and parameters when going
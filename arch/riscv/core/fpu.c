@@ -115,11 +115,13 @@ void arch_flush_local_fpu(void)
 			csr_set(mstatus, MSTATUS_FS_CLEAN);
 			/* save current owner's content */
 			z_riscv_fpu_save(&owner->arch.saved_fp_context);
+			/* dirty means active use */
+			owner->arch.fpu_usage = CONFIG_FPU_SHARING_EAGER_SWITCHES;
+		} else if (owner->arch.fpu_usage > 0) {
+			/* one more scheduling slot without using it */
+			owner->arch.fpu_usage--;
 		}
 
-		/* dirty means active use */
-		owner->arch.fpu_recently_used = dirty;
-
 		/* disable FPU access */
 		csr_clear(mstatus, MSTATUS_FS);
 
@@ -262,10 +264,10 @@ static bool fpu_access_allowed(unsigned int exc_update_level)
 			/* everything is already in place */
 			return true;
 		}
-		if (_current->arch.fpu_recently_used) {
+		if (_current->arch.fpu_usage > 0) {
 			/*
-			 * Before this thread was context-switched out,
-			 * it made active use of the FPU, but someone else
+			 * This thread made active use of the FPU within
+			 * its last few scheduling slots, but someone else
 			 * took it away in the mean time. Let's preemptively
 			 * claim it back to avoid the likely exception trap
 			 * to come otherwise.
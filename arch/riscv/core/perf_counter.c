@@ -0,0 +1,51 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RISC-V performance counters based on the machine counters
+ *
+ * Only the cycle and instructions retired counters are standard, the
+ * events of the hpmcounters are implementation defined.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/arch/riscv/csr.h>
+
+/* One slot per standard counter */
+#define PERF_COUNTER_NUM 2
+
+static enum k_perf_event counter_event[PERF_COUNTER_NUM];
+
+unsigned int arch_perf_counter_num(void)
+{
+	return PERF_COUNTER_NUM;
+}
+
+int arch_perf_counter_start(unsigned int idx, enum k_perf_event event)
+{
+	if ((event != K_PERF_EVENT_CYCLES) && (event != K_PERF_EVENT_INSTRUCTIONS)) {
+		return -ENOTSUP;
+	}
+
+	counter_event[idx] = event;
+
+	return 0;
+}
+
+void arch_perf_counter_stop(unsigned int idx)
+{
+	counter_event[idx] = K_PERF_EVENT_NONE;
+}
+
+uint32_t arch_perf_counter_read(unsigned int idx)
+{
+	if (counter_event[idx] == K_PERF_EVENT_INSTRUCTIONS) {
+		return csr_read(minstret);
+	}
+
+	return csr_read(mcycle);
+}
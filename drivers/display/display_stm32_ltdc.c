@@ -21,6 +21,9 @@
 #include <zephyr/pm/device.h>
 #include <zephyr/sys/barrier.h>
 #include <zephyr/cache.h>
+#if defined(CONFIG_DISPLAY_DMA_MEMCPY)
+#include <zephyr/sys/dma_memcpy.h>
+#endif
 #if defined(CONFIG_STM32_LTDC_FB_USE_SHARED_MULTI_HEAP)
 #include <zephyr/multi_heap/shared_multi_heap.h>
 #endif
@@ -195,7 +198,11 @@ static int stm32_ltdc_write(const struct device *dev, const uint16_t x,
 				dst = data->frame_buffer + data->frame_buffer_len;
 			}
 
+#if defined(CONFIG_DISPLAY_DMA_MEMCPY)
+			(void)sys_dma_memcpy(dst, data->front_buf, data->frame_buffer_len);
+#else
 			memcpy(dst, data->front_buf, data->frame_buffer_len);
+#endif
 		}
 
 		pend_buf = dst;
@@ -21,6 +21,9 @@ LOG_MODULE_REGISTER(eth_ivshmem, CONFIG_ETHERNET_LOG_LEVEL);
 #define ETH_IVSHMEM_STATE_READY		2
 #define ETH_IVSHMEM_STATE_RUN		3
 
+/* How long a frame waits for room in a full TX queue */
+#define ETH_IVSHMEM_TX_TIMEOUT		K_MSEC(10)
+
 static const char * const eth_ivshmem_state_names[] = {
 	[ETH_IVSHMEM_STATE_RESET] = "RESET",
 	[ETH_IVSHMEM_STATE_INIT] = "INIT",
@@ -28,17 +31,37 @@ static const char * const eth_ivshmem_state_names[] = {
 	[ETH_IVSHMEM_STATE_RUN] = "RUN"
 };
 
+struct eth_ivshmem_txrx {
+	struct eth_ivshmem_queue ivshmem_queue;
+	uint32_t tx_rx_vector;
+	/* Serializes the TX threads of the traffic classes sharing the queue */
+	struct k_mutex tx_lock;
+	/* Given when the peer notifies the queue, for senders waiting for room */
+	struct k_sem tx_space;
+	/* Taken frames may be released from any thread */
+	struct k_spinlock rx_lock;
+	/* Incremented on queue reset, frames taken before are not released */
+	uint32_t rx_gen;
+};
+
 struct eth_ivshmem_dev_data {
 	struct net_if *iface;
 
-	uint32_t tx_rx_vector;
 	uint32_t peer_id;
 	uint8_t mac_addr[6];
 	struct k_poll_signal poll_signal;
-	struct eth_ivshmem_queue ivshmem_queue;
+	struct eth_ivshmem_txrx txrx[CONFIG_ETH_IVSHMEM_QUEUES];
 
 	K_KERNEL_STACK_MEMBER(thread_stack, CONFIG_ETH_IVSHMEM_THREAD_STACK_SIZE);
 	struct k_thread thread;
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+	/* The queues other than the first one have their own vector and thread */
+	struct eth_ivshmem_queue_thread {
+		struct k_poll_signal poll_signal;
+		K_KERNEL_STACK_MEMBER(thread_stack, CONFIG_ETH_IVSHMEM_THREAD_STACK_SIZE);
+		struct k_thread thread;
+	} queue_threads[CONFIG_ETH_IVSHMEM_QUEUES - 1];
+#endif
 	bool enabled;
 	uint32_t state;
 #if defined(CONFIG_NET_STATISTICS_ETHERNET)
@@ -91,44 +114,180 @@ static enum ethernet_hw_caps eth_ivshmem_caps(const struct device *dev)
 	return ETHERNET_LINK_10BASE | ETHERNET_LINK_100BASE | ETHERNET_LINK_1000BASE;
 }
 
+static struct eth_ivshmem_txrx *eth_ivshmem_tx_queue(struct eth_ivshmem_dev_data *dev_data,
+						     struct net_pkt *pkt)
+{
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+	int tc = net_tx_priority2tc(net_pkt_priority(pkt));
+
+	return &dev_data->txrx[tc % CONFIG_ETH_IVSHMEM_QUEUES];
+#else
+	ARG_UNUSED(pkt);
+
+	return &dev_data->txrx[0];
+#endif
+}
+
 static int eth_ivshmem_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct eth_ivshmem_dev_data *dev_data = dev->data;
 	const struct eth_ivshmem_cfg_data *cfg_data = dev->config;
+	struct eth_ivshmem_txrx *txrx = eth_ivshmem_tx_queue(dev_data, pkt);
+	k_timepoint_t end = sys_timepoint_calc(ETH_IVSHMEM_TX_TIMEOUT);
 	size_t len = net_pkt_get_len(pkt);
+	bool kick = false;
 
 	void *data;
-	int res = eth_ivshmem_queue_tx_get_buff(&dev_data->ivshmem_queue, &data, len);
+	int res;
+
+	k_mutex_lock(&txrx->tx_lock, K_FOREVER);
+
+	res = eth_ivshmem_queue_tx_get_buff(&txrx->ivshmem_queue, &data, len);
+	while (res == -ENOBUFS &&
+	       k_sem_take(&txrx->tx_space, sys_timepoint_timeout(end)) == 0) {
+		res = eth_ivshmem_queue_tx_get_buff(&txrx->ivshmem_queue, &data, len);
+	}
 
 	if (res != 0) {
 		LOG_ERR("Failed to allocate tx buffer");
 		eth_stats_update_errors_tx(dev_data->iface);
-		return res;
+		goto unlock;
 	}
 
 	if (net_pkt_read(pkt, data, len)) {
 		LOG_ERR("Failed to read tx packet");
 		eth_stats_update_errors_tx(dev_data->iface);
-		return -EIO;
+		res = -EIO;
+		goto unlock;
 	}
 
-	res = eth_ivshmem_queue_tx_commit_buff(&dev_data->ivshmem_queue);
+	res = eth_ivshmem_queue_tx_commit_buff(&txrx->ivshmem_queue);
 	if (res == 0) {
+		kick = eth_ivshmem_queue_tx_kick(&txrx->ivshmem_queue);
+	}
+
+unlock:
+	k_mutex_unlock(&txrx->tx_lock);
+
+	if (kick) {
 		/* Notify peer */
-		ivshmem_int_peer(cfg_data->ivshmem, dev_data->peer_id, dev_data->tx_rx_vector);
+		ivshmem_int_peer(cfg_data->ivshmem, dev_data->peer_id, txrx->tx_rx_vector);
 	}
 
 	return res;
 }
 
-static struct net_pkt *eth_ivshmem_rx(const struct device *dev)
+static void eth_ivshmem_rx_complete(const struct device *dev, uint32_t queue, int pos,
+				    uint32_t gen)
 {
 	struct eth_ivshmem_dev_data *dev_data = dev->data;
 	const struct eth_ivshmem_cfg_data *cfg_data = dev->config;
+	struct eth_ivshmem_txrx *txrx = &dev_data->txrx[queue];
+	k_spinlock_key_t key = k_spin_lock(&txrx->rx_lock);
+	bool kick = false;
+	int res;
+
+	if (gen != txrx->rx_gen) {
+		/* Taken before the queue was reset */
+		res = -ESTALE;
+	} else if (pos < 0) {
+		res = eth_ivshmem_queue_rx_complete(&txrx->ivshmem_queue);
+	} else {
+		res = eth_ivshmem_queue_rx_release(&txrx->ivshmem_queue, pos);
+	}
+
+	if (res == 0) {
+		kick = eth_ivshmem_queue_rx_kick(&txrx->ivshmem_queue);
+	}
+
+	k_spin_unlock(&txrx->rx_lock, key);
+
+	if (kick) {
+		/* Notify peer */
+		ivshmem_int_peer(cfg_data->ivshmem, dev_data->peer_id, txrx->tx_rx_vector);
+	}
+}
+
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+struct eth_ivshmem_rx_buf {
+	const struct device *dev;
+	uint32_t queue;
+	uint32_t gen;
+	uint16_t pos;
+};
+
+static void eth_ivshmem_rx_buf_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(eth_ivshmem_rx_pool, CONFIG_ETH_IVSHMEM_RX_ZERO_COPY_BUF_COUNT, 0,
+		    sizeof(struct eth_ivshmem_rx_buf), eth_ivshmem_rx_buf_destroy);
+
+static void eth_ivshmem_rx_buf_destroy(struct net_buf *buf)
+{
+	struct eth_ivshmem_rx_buf rx_buf = *(struct eth_ivshmem_rx_buf *)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+
+	if (rx_buf.dev != NULL) {
+		/* Give the frame back to the peer */
+		eth_ivshmem_rx_complete(rx_buf.dev, rx_buf.queue, rx_buf.pos, rx_buf.gen);
+	}
+}
+
+/* Hands the frame to the stack in place, it is released with its buffer */
+static struct net_pkt *eth_ivshmem_rx_zero_copy(const struct device *dev, uint32_t queue,
+						const void *rx_data, size_t rx_len)
+{
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+	struct eth_ivshmem_txrx *txrx = &dev_data->txrx[queue];
+	struct eth_ivshmem_rx_buf *rx_buf;
+	struct net_pkt *pkt;
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+	uint16_t pos;
+
+	buf = net_buf_alloc_with_data(&eth_ivshmem_rx_pool, (void *)rx_data, rx_len, K_NO_WAIT);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	rx_buf = net_buf_user_data(buf);
+	rx_buf->dev = NULL;
+
+	pkt = net_pkt_rx_alloc_on_iface(dev_data->iface, K_NO_WAIT);
+	if (pkt == NULL) {
+		net_buf_unref(buf);
+		return NULL;
+	}
+
+	key = k_spin_lock(&txrx->rx_lock);
+	if (eth_ivshmem_queue_rx_take(&txrx->ivshmem_queue, &pos) == 0) {
+		rx_buf->dev = dev;
+		rx_buf->queue = queue;
+		rx_buf->gen = txrx->rx_gen;
+		rx_buf->pos = pos;
+	}
+	k_spin_unlock(&txrx->rx_lock, key);
+
+	if (rx_buf->dev == NULL) {
+		net_pkt_unref(pkt);
+		net_buf_unref(buf);
+		return NULL;
+	}
+
+	net_pkt_append_buffer(pkt, buf);
+
+	return pkt;
+}
+#endif /* CONFIG_ETH_IVSHMEM_RX_ZERO_COPY */
+
+static struct net_pkt *eth_ivshmem_rx(const struct device *dev, uint32_t queue)
+{
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+	struct eth_ivshmem_txrx *txrx = &dev_data->txrx[queue];
 	const void *rx_data;
 	size_t rx_len;
 
-	int res = eth_ivshmem_queue_rx(&dev_data->ivshmem_queue, &rx_data, &rx_len);
+	int res = eth_ivshmem_queue_rx(&txrx->ivshmem_queue, &rx_data, &rx_len);
 
 	if (res != 0) {
 		if (res != -EWOULDBLOCK) {
@@ -138,6 +297,16 @@ static struct net_pkt *eth_ivshmem_rx(const struct device *dev)
 		return NULL;
 	}
 
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+	struct net_pkt *zc_pkt = eth_ivshmem_rx_zero_copy(dev, queue, rx_data, rx_len);
+
+	if (zc_pkt != NULL) {
+		return zc_pkt;
+	}
+
+	/* Out of zero copy buffers, copy the frame */
+#endif
+
 	struct net_pkt *pkt = net_pkt_rx_alloc_with_buffer(
 		dev_data->iface, rx_len, AF_UNSPEC, 0, K_MSEC(100));
 	if (pkt == NULL) {
@@ -153,14 +322,66 @@ static struct net_pkt *eth_ivshmem_rx(const struct device *dev)
 	}
 
 dequeue:
-	if (eth_ivshmem_queue_rx_complete(&dev_data->ivshmem_queue) == 0) {
-		/* Notify peer */
-		ivshmem_int_peer(cfg_data->ivshmem, dev_data->peer_id, dev_data->tx_rx_vector);
-	}
+	eth_ivshmem_rx_complete(dev, queue, -1, txrx->rx_gen);
 
 	return pkt;
 }
 
+static void eth_ivshmem_rx_queue(const struct device *dev, uint32_t queue)
+{
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+
+	/* The peer may have made room for senders waiting for it */
+	k_sem_give(&dev_data->txrx[queue].tx_space);
+
+	while (dev_data->state == ETH_IVSHMEM_STATE_RUN) {
+		struct net_pkt *pkt = eth_ivshmem_rx(dev, queue);
+
+		if (pkt == NULL) {
+			break;
+		}
+
+		if (net_recv_data(dev_data->iface, pkt) < 0) {
+			/* Upper layers are not ready to receive packets */
+			net_pkt_unref(pkt);
+		}
+
+		k_yield();
+	}
+}
+
+static void eth_ivshmem_reset_queues(const struct device *dev)
+{
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+
+	for (int i = 0; i < CONFIG_ETH_IVSHMEM_QUEUES; i++) {
+		struct eth_ivshmem_txrx *txrx = &dev_data->txrx[i];
+		k_spinlock_key_t key;
+
+		k_mutex_lock(&txrx->tx_lock, K_FOREVER);
+		key = k_spin_lock(&txrx->rx_lock);
+
+		eth_ivshmem_queue_reset(&txrx->ivshmem_queue);
+		txrx->rx_gen++;
+
+		k_spin_unlock(&txrx->rx_lock, key);
+		k_mutex_unlock(&txrx->tx_lock);
+	}
+}
+
+static void eth_ivshmem_wake_queues(const struct device *dev)
+{
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+
+	for (int i = 0; i < CONFIG_ETH_IVSHMEM_QUEUES - 1; i++) {
+		k_poll_signal_raise(&dev_data->queue_threads[i].poll_signal, 0);
+	}
+#else
+	ARG_UNUSED(dev);
+#endif
+}
+
 static void eth_ivshmem_set_state(const struct device *dev, uint32_t state)
 {
 	struct eth_ivshmem_dev_data *dev_data = dev->data;
@@ -197,7 +418,7 @@ static void eth_ivshmem_state_update(const struct device *dev)
 			/* Peer is not ready for init */
 			break;
 		}
-		eth_ivshmem_queue_reset(&dev_data->ivshmem_queue);
+		eth_ivshmem_reset_queues(dev);
 		eth_ivshmem_set_state(dev, ETH_IVSHMEM_STATE_READY);
 		break;
 	case ETH_IVSHMEM_STATE_READY:
@@ -212,6 +433,7 @@ static void eth_ivshmem_state_update(const struct device *dev)
 			if (dev_data->enabled && dev_data->state == ETH_IVSHMEM_STATE_READY) {
 				eth_ivshmem_set_state(dev, ETH_IVSHMEM_STATE_RUN);
 				net_eth_carrier_on(dev_data->iface);
+				eth_ivshmem_wake_queues(dev);
 			} else if (!dev_data->enabled && dev_data->state == ETH_IVSHMEM_STATE_RUN) {
 				net_eth_carrier_off(dev_data->iface);
 				eth_ivshmem_set_state(dev, ETH_IVSHMEM_STATE_RESET);
@@ -242,26 +464,34 @@ FUNC_NORETURN static void eth_ivshmem_thread(void *arg1, void *arg2, void *arg3)
 		poll_event.state = K_POLL_STATE_NOT_READY;
 
 		eth_ivshmem_state_update(dev);
-		if (dev_data->state != ETH_IVSHMEM_STATE_RUN) {
-			continue;
-		}
+		eth_ivshmem_rx_queue(dev, 0);
+	}
+}
 
-		while (true) {
-			struct net_pkt *pkt = eth_ivshmem_rx(dev);
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+FUNC_NORETURN static void eth_ivshmem_queue_thread(void *arg1, void *arg2, void *arg3)
+{
+	const struct device *dev = arg1;
+	uint32_t queue = POINTER_TO_UINT(arg2);
+	struct eth_ivshmem_dev_data *dev_data = dev->data;
+	struct k_poll_event poll_event;
 
-			if (pkt == NULL) {
-				break;
-			}
+	ARG_UNUSED(arg3);
 
-			if (net_recv_data(dev_data->iface, pkt) < 0) {
-				/* Upper layers are not ready to receive packets */
-				net_pkt_unref(pkt);
-			}
+	k_poll_event_init(&poll_event,
+			  K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY,
+			  &dev_data->queue_threads[queue - 1].poll_signal);
 
-			k_yield();
-		};
+	while (true) {
+		k_poll(&poll_event, 1, K_FOREVER);
+		poll_event.signal->signaled = 0;
+		poll_event.state = K_POLL_STATE_NOT_READY;
+
+		eth_ivshmem_rx_queue(dev, queue);
 	}
 }
+#endif
 
 int eth_ivshmem_initialize(const struct device *dev)
 {
@@ -270,6 +500,15 @@ int eth_ivshmem_initialize(const struct device *dev)
 	int res;
 
 	k_poll_signal_init(&dev_data->poll_signal);
+	for (int i = 0; i < CONFIG_ETH_IVSHMEM_QUEUES; i++) {
+		k_mutex_init(&dev_data->txrx[i].tx_lock);
+		k_sem_init(&dev_data->txrx[i].tx_space, 0, 1);
+	}
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+	for (int i = 0; i < CONFIG_ETH_IVSHMEM_QUEUES - 1; i++) {
+		k_poll_signal_init(&dev_data->queue_threads[i].poll_signal);
+	}
+#endif
 
 	if (!device_is_ready(cfg_data->ivshmem)) {
 		LOG_ERR("ivshmem device not ready");
@@ -303,31 +542,62 @@ int eth_ivshmem_initialize(const struct device *dev)
 	ivshmem_get_output_mem_section(
 		cfg_data->ivshmem, 1, &output_sections[1]);
 
-	res = eth_ivshmem_queue_init(
-		&dev_data->ivshmem_queue, output_sections[id],
-		output_sections[dev_data->peer_id], output_section_size);
-	if (res != 0) {
-		LOG_ERR("Failed to init ivshmem queue");
-		return res;
+	/* Each queue gets an equal, aligned share of both output sections */
+	size_t queue_size = ROUND_DOWN(output_section_size / CONFIG_ETH_IVSHMEM_QUEUES,
+				       ETH_IVSHMEM_VRING_ALIGNMENT);
+
+	for (int i = 0; i < CONFIG_ETH_IVSHMEM_QUEUES; i++) {
+		res = eth_ivshmem_queue_init(
+			&dev_data->txrx[i].ivshmem_queue,
+			output_sections[id] + i * queue_size,
+			output_sections[dev_data->peer_id] + i * queue_size,
+			queue_size);
+		if (res != 0) {
+			LOG_ERR("Failed to init ivshmem queue %d", i);
+			return res;
+		}
 	}
 	LOG_INF("shmem queue: desc len 0x%hX, header size 0x%X, data size 0x%X",
-		dev_data->ivshmem_queue.desc_max_len,
-		dev_data->ivshmem_queue.vring_header_size,
-		dev_data->ivshmem_queue.vring_data_max_len);
+		dev_data->txrx[0].ivshmem_queue.desc_max_len,
+		dev_data->txrx[0].ivshmem_queue.vring_header_size,
+		dev_data->txrx[0].ivshmem_queue.vring_data_max_len);
 
 	uint16_t n_vectors = ivshmem_get_vectors(cfg_data->ivshmem);
 
 	/* For simplicity, state and TX/RX vectors do the same thing */
 	ivshmem_register_handler(cfg_data->ivshmem, &dev_data->poll_signal, 0);
-	dev_data->tx_rx_vector = 0;
+	dev_data->txrx[0].tx_rx_vector = 0;
 	if (n_vectors == 0) {
 		LOG_ERR("Error no ivshmem ISR vectors");
 		return -EINVAL;
 	} else if (n_vectors > 1) {
 		ivshmem_register_handler(cfg_data->ivshmem, &dev_data->poll_signal, 1);
-		dev_data->tx_rx_vector = 1;
+		dev_data->txrx[0].tx_rx_vector = 1;
 	}
 
+#if CONFIG_ETH_IVSHMEM_QUEUES > 1
+	/* Queue N is signalled on vector N + 1 and served by a thread of its own */
+	if (n_vectors < CONFIG_ETH_IVSHMEM_QUEUES + 1) {
+		LOG_ERR("%u queues need %u ivshmem ISR vectors, have %hu",
+			CONFIG_ETH_IVSHMEM_QUEUES, CONFIG_ETH_IVSHMEM_QUEUES + 1, n_vectors);
+		return -EINVAL;
+	}
+
+	for (uint32_t i = 1; i < CONFIG_ETH_IVSHMEM_QUEUES; i++) {
+		struct eth_ivshmem_queue_thread *qt = &dev_data->queue_threads[i - 1];
+
+		ivshmem_register_handler(cfg_data->ivshmem, &qt->poll_signal, i + 1);
+		dev_data->txrx[i].tx_rx_vector = i + 1;
+
+		k_thread_create(&qt->thread, qt->thread_stack,
+				K_KERNEL_STACK_SIZEOF(qt->thread_stack),
+				eth_ivshmem_queue_thread,
+				(void *) dev, UINT_TO_POINTER(i), NULL,
+				CONFIG_ETH_IVSHMEM_THREAD_PRIORITY,
+				K_ESSENTIAL, K_NO_WAIT);
+	}
+#endif
+
 	ivshmem_set_state(cfg_data->ivshmem, ETH_IVSHMEM_STATE_RESET);
 
 	cfg_data->generate_mac_addr(dev_data->mac_addr);
@@ -13,6 +13,11 @@
 
 #include <openamp/virtio_ring.h>
 
+/* These defines must match on the peer */
+#define ETH_IVSHMEM_VRING_ALIGNMENT 64
+/* Largest number of descriptors of a vring */
+#define ETH_IVSHMEM_DESC_MAX_LEN 4096
+
 struct eth_ivshmem_queue {
 	struct {
 		struct vring vring;
@@ -27,12 +32,22 @@ struct eth_ivshmem_queue {
 
 		uint32_t pending_data_head;
 		uint32_t pending_data_len;
+
+		/* Avail index the peer was last notified of */
+		uint16_t kick_idx;
 	} tx;
 	struct {
 		struct vring vring;
 		void *shmem;
 		uint16_t avail_idx;
 		uint16_t used_idx;
+
+		/* Used index the peer was last notified of */
+		uint16_t kick_idx;
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+		/* Frames released out of order, by avail ring position */
+		uint32_t released[ETH_IVSHMEM_DESC_MAX_LEN / 32];
+#endif
 	} rx;
 	uint16_t desc_max_len;
 	uint32_t vring_header_size;
@@ -45,7 +60,11 @@ int eth_ivshmem_queue_init(
 void eth_ivshmem_queue_reset(struct eth_ivshmem_queue *q);
 int eth_ivshmem_queue_tx_get_buff(struct eth_ivshmem_queue *q, void **data, size_t len);
 int eth_ivshmem_queue_tx_commit_buff(struct eth_ivshmem_queue *q);
+bool eth_ivshmem_queue_tx_kick(struct eth_ivshmem_queue *q);
 int eth_ivshmem_queue_rx(struct eth_ivshmem_queue *q, const void **data, size_t *len);
 int eth_ivshmem_queue_rx_complete(struct eth_ivshmem_queue *q);
+int eth_ivshmem_queue_rx_take(struct eth_ivshmem_queue *q, uint16_t *pos);
+int eth_ivshmem_queue_rx_release(struct eth_ivshmem_queue *q, uint16_t pos);
+bool eth_ivshmem_queue_rx_kick(struct eth_ivshmem_queue *q);
 
 #endif /* ETH_IVSHMEM_PRIV_H */
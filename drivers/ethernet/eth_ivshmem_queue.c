@@ -14,7 +14,6 @@
 #include <string.h>
 
 /* These defines must match on the peer */
-#define ETH_IVSHMEM_VRING_ALIGNMENT 64
 #define ETH_IVSHMEM_FRAME_SIZE(len) ROUND_UP(18 + (len), L1_CACHE_BYTES)
 
 #define VRING_FLUSH(x)		sys_cache_data_flush_range(&(x), sizeof(x))
@@ -26,6 +25,7 @@ static int calc_vring_size(
 static uint32_t tx_buffer_advance(uint32_t max_len, uint32_t *position, uint32_t *len);
 static int tx_clean_used(struct eth_ivshmem_queue *q);
 static int get_rx_avail_desc_idx(struct eth_ivshmem_queue *q, uint16_t *avail_desc_idx);
+static void rx_used_add(struct eth_ivshmem_queue *q);
 
 int eth_ivshmem_queue_init(
 		struct eth_ivshmem_queue *q, uintptr_t tx_shmem,
@@ -76,8 +76,13 @@ void eth_ivshmem_queue_reset(struct eth_ivshmem_queue *q)
 	q->tx.used_idx = 0;
 	q->tx.pending_data_head = 0;
 	q->tx.pending_data_len = 0;
+	q->tx.kick_idx = 0;
 	q->rx.avail_idx = 0;
 	q->rx.used_idx = 0;
+	q->rx.kick_idx = 0;
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+	memset(q->rx.released, 0, sizeof(q->rx.released));
+#endif
 
 	memset(q->tx.shmem, 0, q->vring_header_size);
 
@@ -90,23 +95,37 @@ void eth_ivshmem_queue_reset(struct eth_ivshmem_queue *q)
 
 int eth_ivshmem_queue_tx_get_buff(struct eth_ivshmem_queue *q, void **data, size_t len)
 {
-	/* Clean used TX buffers */
-	int res = tx_clean_used(q);
+	uint32_t head;
+	uint32_t consumed_len;
+	uint32_t new_head;
 
-	if (res != 0) {
-		return res;
-	}
+	for (bool armed = false; true; armed = true) {
+		/* Clean used TX buffers */
+		int res = tx_clean_used(q);
 
-	if (q->tx.desc_len >= q->desc_max_len) {
-		return -ENOBUFS;
-	}
+		if (res != 0) {
+			return res;
+		}
 
-	uint32_t head = q->tx.data_head;
-	uint32_t consumed_len = len;
-	uint32_t new_head = tx_buffer_advance(q->vring_data_max_len, &head, &consumed_len);
+		head = q->tx.data_head;
+		consumed_len = len;
+		new_head = tx_buffer_advance(q->vring_data_max_len, &head, &consumed_len);
+
+		if (q->tx.desc_len < q->desc_max_len &&
+		    q->vring_data_max_len - q->tx.data_len >= consumed_len) {
+			break;
+		}
+
+		if (armed) {
+			return -ENOBUFS;
+		}
 
-	if (q->vring_data_max_len - q->tx.data_len < consumed_len) {
-		return -ENOBUFS;
+		/* Ask the peer to notify us of the next used buffer, then check
+		 * again in case it was used before the peer could see the request.
+		 */
+		vring_used_event(&q->tx.vring) = q->tx.used_idx;
+		VRING_FLUSH(vring_used_event(&q->tx.vring));
+		atomic_thread_fence(memory_order_seq_cst);
 	}
 
 	struct vring_desc *tx_desc = &q->tx.vring.desc[q->tx.desc_head];
@@ -154,6 +173,22 @@ int eth_ivshmem_queue_tx_commit_buff(struct eth_ivshmem_queue *q)
 	return 0;
 }
 
+/**
+ * Tells whether the peer must be notified of the TX buffers committed since
+ * the last call, following the avail event index it published.
+ */
+bool eth_ivshmem_queue_tx_kick(struct eth_ivshmem_queue *q)
+{
+	uint16_t old_idx = q->tx.kick_idx;
+
+	atomic_thread_fence(memory_order_seq_cst);
+	VRING_INVALIDATE(vring_avail_event(&q->tx.vring));
+
+	q->tx.kick_idx = q->tx.avail_idx;
+
+	return vring_need_event(vring_avail_event(&q->tx.vring), q->tx.avail_idx, old_idx);
+}
+
 int eth_ivshmem_queue_rx(struct eth_ivshmem_queue *q, const void **data, size_t *len)
 {
 	*data = NULL;
@@ -186,6 +221,22 @@ int eth_ivshmem_queue_rx(struct eth_ivshmem_queue *q, const void **data, size_t
 }
 
 int eth_ivshmem_queue_rx_complete(struct eth_ivshmem_queue *q)
+{
+	uint16_t pos;
+	int res = eth_ivshmem_queue_rx_take(q, &pos);
+
+	if (res != 0) {
+		return res;
+	}
+
+	return eth_ivshmem_queue_rx_release(q, pos);
+}
+
+/**
+ * Moves past the current RX frame, which stays owned by this side until
+ * released with eth_ivshmem_queue_rx_release() using the returned position.
+ */
+int eth_ivshmem_queue_rx_take(struct eth_ivshmem_queue *q, uint16_t *pos)
 {
 	uint16_t avail_desc_idx;
 	int res = get_rx_avail_desc_idx(q, &avail_desc_idx);
@@ -194,23 +245,65 @@ int eth_ivshmem_queue_rx_complete(struct eth_ivshmem_queue *q)
 		return res;
 	}
 
-	uint16_t used_idx = q->rx.used_idx % q->desc_max_len;
+	*pos = q->rx.avail_idx;
 
-	q->rx.used_idx++;
-	q->rx.vring.used->ring[used_idx].id = avail_desc_idx;
-	q->rx.vring.used->ring[used_idx].len = 1;
-	VRING_FLUSH(q->rx.vring.used->ring[used_idx]);
+	q->rx.avail_idx++;
+	vring_avail_event(&q->rx.vring) = q->rx.avail_idx;
+	VRING_FLUSH(vring_avail_event(&q->rx.vring));
+
+	return 0;
+}
+
+int eth_ivshmem_queue_rx_release(struct eth_ivshmem_queue *q, uint16_t pos)
+{
+	uint16_t taken_len = q->rx.avail_idx - q->rx.used_idx;
+
+	if ((uint16_t)(pos - q->rx.used_idx) >= taken_len) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+	/* The peer frees its buffers in order, frames released early wait */
+	uint16_t slot = pos % q->desc_max_len;
+
+	q->rx.released[slot / 32] |= BIT(slot % 32);
+
+	while (q->rx.used_idx != q->rx.avail_idx) {
+		slot = q->rx.used_idx % q->desc_max_len;
+		if ((q->rx.released[slot / 32] & BIT(slot % 32)) == 0) {
+			break;
+		}
+		q->rx.released[slot / 32] &= ~BIT(slot % 32);
+		rx_used_add(q);
+	}
+#else
+	if (pos != q->rx.used_idx) {
+		return -EINVAL;
+	}
+	rx_used_add(q);
+#endif
 	atomic_thread_fence(memory_order_seq_cst);
 
 	q->rx.vring.used->idx = q->rx.used_idx;
 	VRING_FLUSH(q->rx.vring.used->idx);
+
+	return 0;
+}
+
+/**
+ * Tells whether the peer must be notified of the RX frames released since
+ * the last call, following the used event index it published.
+ */
+bool eth_ivshmem_queue_rx_kick(struct eth_ivshmem_queue *q)
+{
+	uint16_t old_idx = q->rx.kick_idx;
+
 	atomic_thread_fence(memory_order_seq_cst);
+	VRING_INVALIDATE(vring_used_event(&q->rx.vring));
 
-	q->rx.avail_idx++;
-	vring_avail_event(&q->rx.vring) = q->rx.avail_idx;
-	VRING_FLUSH(vring_avail_event(&q->rx.vring));
+	q->rx.kick_idx = q->rx.used_idx;
 
-	return 0;
+	return vring_need_event(vring_used_event(&q->rx.vring), q->rx.used_idx, old_idx);
 }
 
 /**
@@ -225,7 +318,7 @@ static int calc_vring_size(
 	uint32_t header_size;
 	int16_t desc_len;
 
-	for (desc_len = 4096; desc_len > 32; desc_len >>= 1) {
+	for (desc_len = ETH_IVSHMEM_DESC_MAX_LEN; desc_len > 32; desc_len >>= 1) {
 		header_size = vring_size(desc_len, ETH_IVSHMEM_VRING_ALIGNMENT);
 		header_size = ROUND_UP(header_size, ETH_IVSHMEM_VRING_ALIGNMENT);
 		if (header_size < section_size / 8) {
@@ -323,3 +416,17 @@ static int get_rx_avail_desc_idx(struct eth_ivshmem_queue *q, uint16_t *avail_de
 
 	return 0;
 }
+
+/* Returns the next taken RX descriptor to the peer, without publishing it */
+static void rx_used_add(struct eth_ivshmem_queue *q)
+{
+	uint16_t used_idx = q->rx.used_idx % q->desc_max_len;
+
+	/* The avail ring entry is not reused until the descriptor is used */
+	VRING_INVALIDATE(q->rx.vring.avail->ring[used_idx]);
+	q->rx.vring.used->ring[used_idx].id = q->rx.vring.avail->ring[used_idx];
+	q->rx.vring.used->ring[used_idx].len = 1;
+	VRING_FLUSH(q->rx.vring.used->ring[used_idx]);
+
+	q->rx.used_idx++;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/flash.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/work.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(flash_rtio, CONFIG_FLASH_LOG_LEVEL);
+
+const struct rtio_iodev_api flash_iodev_api = {
+	.submit = flash_iodev_submit,
+};
+
+static int flash_rtio_sqe_run(const struct device *dev, const struct rtio_sqe *sqe)
+{
+	switch (sqe->op) {
+	case RTIO_OP_FLASH_READ:
+		return flash_read(dev, sqe->flash.offset, sqe->flash.buf, sqe->flash.len);
+	case RTIO_OP_FLASH_WRITE:
+		return flash_write(dev, sqe->flash.offset, sqe->flash.buf, sqe->flash.len);
+	case RTIO_OP_FLASH_ERASE:
+		return flash_erase(dev, sqe->flash.offset, sqe->flash.len);
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -EIO;
+	}
+}
+
+static void flash_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct device *dev = (const struct device *)txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc;
+
+	LOG_DBG("Sync RTIO work item for: %p", (void *)txn_first);
+
+	/* The submissions of a transaction complete together */
+	do {
+		rc = flash_rtio_sqe_run(dev, &txn_curr->sqe);
+		txn_curr = rtio_txn_next(txn_curr);
+	} while ((rc == 0) && (txn_curr != NULL));
+
+	if (rc != 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+void flash_iodev_submit_fallback(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	LOG_DBG("Executing fallback for dev: %p, sqe: %p", (void *)dev, (void *)iodev_sqe);
+
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, flash_iodev_submit_work_handler);
+}
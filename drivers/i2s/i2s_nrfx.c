@@ -34,6 +34,9 @@ struct i2s_nrfx_drv_data {
 	struct k_msgq rx_queue;
 	const nrfx_i2s_t *p_i2s;
 	const uint32_t *last_tx_buffer;
+	const struct device *dev;
+	i2s_callback_t callback;
+	void *callback_user_data;
 	enum i2s_state state;
 	enum i2s_dir active_dir;
 	bool stop;       /* stop after the current (TX or RX) block */
@@ -219,6 +222,13 @@ static bool get_next_rx_buffer(struct i2s_nrfx_drv_data *drv_data,
 static void free_tx_buffer(struct i2s_nrfx_drv_data *drv_data,
 			   const void *buffer)
 {
+	if (drv_data->callback != NULL) {
+		drv_data->callback(drv_data->dev, I2S_DIR_TX,
+				   (void *)buffer, drv_data->tx.cfg.block_size,
+				   drv_data->callback_user_data);
+		return;
+	}
+
 	k_mem_slab_free(drv_data->tx.cfg.mem_slab, (void *)buffer);
 	LOG_DBG("Freed TX %p", buffer);
 }
@@ -306,6 +316,15 @@ static void data_handler(const struct device *dev,
 	if (released->p_rx_buffer) {
 		if (drv_data->discard_rx) {
 			free_rx_buffer(drv_data, released->p_rx_buffer);
+		} else if (drv_data->callback != NULL) {
+			drv_data->callback(dev, I2S_DIR_RX, released->p_rx_buffer,
+					   released->buffer_size * sizeof(uint32_t),
+					   drv_data->callback_user_data);
+
+			if (drv_data->active_dir == I2S_DIR_RX && drv_data->stop) {
+				drv_data->discard_rx = true;
+				stop_transfer = true;
+			}
 		} else {
 			struct i2s_buf buf = {
 				.mem_block = released->p_rx_buffer,
@@ -627,7 +646,8 @@ static int i2s_nrfx_write(const struct device *dev,
 
 	ret = k_msgq_put(&drv_data->tx_queue,
 			 &buf,
-			 SYS_TIMEOUT_MS(drv_data->tx.cfg.timeout));
+			 k_is_in_isr() ? K_NO_WAIT
+				       : SYS_TIMEOUT_MS(drv_data->tx.cfg.timeout));
 	if (ret < 0) {
 		return ret;
 	}
@@ -914,12 +934,30 @@ static void init_clock_manager(const struct device *dev)
 	__ASSERT_NO_MSG(drv_data->clk_mgr != NULL);
 }
 
+static int i2s_nrfx_callback_set(const struct device *dev,
+				 i2s_callback_t cb, void *user_data)
+{
+	struct i2s_nrfx_drv_data *drv_data = dev->data;
+
+	if (drv_data->state == I2S_STATE_RUNNING ||
+	    drv_data->state == I2S_STATE_STOPPING) {
+		return -EBUSY;
+	}
+
+	drv_data->dev = dev;
+	drv_data->callback = cb;
+	drv_data->callback_user_data = user_data;
+
+	return 0;
+}
+
 static DEVICE_API(i2s, i2s_nrf_drv_api) = {
 	.configure = i2s_nrfx_configure,
 	.config_get = i2s_nrfx_config_get,
 	.read = i2s_nrfx_read,
 	.write = i2s_nrfx_write,
 	.trigger = i2s_nrfx_trigger,
+	.callback_set = i2s_nrfx_callback_set,
 };
 
 #define I2S(idx) DT_NODELABEL(i2s##idx)
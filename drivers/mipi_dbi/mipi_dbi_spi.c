@@ -24,6 +24,8 @@ struct mipi_dbi_spi_config {
 	const struct gpio_dt_spec reset;
 	/* Minimum transfer bits */
 	const uint8_t xfr_min_bits;
+	/* Send 16 bit pixels most significant byte first */
+	const bool swap_bytes;
 };
 
 struct mipi_dbi_spi_data {
@@ -315,13 +317,65 @@ static int mipi_dbi_spi_command_write(const struct device *dev,
 					 data_buf, len);
 }
 
+/*
+ * Send 16 bit pixels as 16 bit SPI words. The SPI controller shifts each
+ * word out most significant bit first, so pixels stored little endian go
+ * out most significant byte first without the CPU rewriting the buffer.
+ */
+static int mipi_dbi_spi_write_swapped(const struct device *dev,
+				      const struct mipi_dbi_config *dbi_config,
+				      const uint8_t *framebuf, size_t len)
+{
+	const struct mipi_dbi_spi_config *config = dev->config;
+	struct mipi_dbi_spi_data *data = dev->data;
+	struct spi_config tmp_config;
+	struct spi_buf buffer = {
+		.buf = (void *)framebuf,
+		.len = len,
+	};
+	struct spi_buf_set buf_set = {
+		.buffers = &buffer,
+		.count = 1,
+	};
+	int ret;
+
+	memcpy(&tmp_config, &dbi_config->config, sizeof(tmp_config));
+	tmp_config.operation &= ~SPI_WORD_SIZE_MASK;
+	tmp_config.operation |= SPI_WORD_SET(16);
+
+	ret = k_mutex_lock(&data->lock, K_FOREVER);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Set CD pin high for data */
+	gpio_pin_set_dt(&config->cmd_data, 1);
+	ret = spi_write(config->spi_dev, &tmp_config, &buf_set);
+
+	k_mutex_unlock(&data->lock);
+	return ret;
+}
+
 static int mipi_dbi_spi_write_display(const struct device *dev,
 				      const struct mipi_dbi_config *dbi_config,
 				      const uint8_t *framebuf,
 				      struct display_buffer_descriptor *desc,
 				      enum display_pixel_format pixfmt)
 {
-	ARG_UNUSED(pixfmt);
+	const struct mipi_dbi_spi_config *config = dev->config;
+	int ret;
+
+	if (config->swap_bytes && DISPLAY_BITS_PER_PIXEL(pixfmt) == 16 &&
+	    dbi_config->mode == MIPI_DBI_MODE_SPI_4WIRE &&
+	    config->xfr_min_bits == MIPI_DBI_SPI_XFR_8BIT &&
+	    (desc->buf_size % sizeof(uint16_t)) == 0) {
+		ret = mipi_dbi_spi_write_swapped(dev, dbi_config, framebuf,
+						 desc->buf_size);
+		if (ret != -ENOTSUP) {
+			return ret;
+		}
+		LOG_WRN_ONCE("SPI controller lacks 16 bit words, bytes not swapped");
+	}
 
 	return mipi_dbi_spi_write_helper(dev, dbi_config, false, 0x0,
 					 framebuf, desc->buf_size);
@@ -562,7 +616,8 @@ static DEVICE_API(mipi_dbi, mipi_dbi_spi_driver_api) = {
 				    DT_INST_PHANDLE(n, spi_dev)),		\
 		    .cmd_data = GPIO_DT_SPEC_INST_GET_OR(n, dc_gpios, {}),	\
 		    .reset = GPIO_DT_SPEC_INST_GET_OR(n, reset_gpios, {}),	\
-		    .xfr_min_bits = DT_INST_STRING_UPPER_TOKEN(n, xfr_min_bits) \
+		    .xfr_min_bits = DT_INST_STRING_UPPER_TOKEN(n, xfr_min_bits), \
+		    .swap_bytes = DT_INST_PROP(n, swap_bytes),			\
 	};									\
 	static struct mipi_dbi_spi_data mipi_dbi_spi_data_##n;			\
 										\
@@ -416,18 +416,28 @@ static int emmc_dma_init(const struct device *dev, struct sdhc_data *data, bool
 
 	if (IS_ENABLED(CONFIG_INTEL_EMMC_HOST_ADMA)) {
 		uint8_t *buff = data->data;
+		size_t remaining = data->blocks * data->block_size;
+		/* Largest whole number of blocks a descriptor can move */
+		size_t desc_max = (EMMC_HOST_ADMA_BUFF_LEN_MAX / data->block_size) *
+				  data->block_size;
+		size_t len;
 
 		/* Setup DMA transfer using ADMA2 */
 		memset(emmc->desc_table, 0, sizeof(emmc->desc_table));
 
 #if defined(CONFIG_INTEL_EMMC_HOST_ADMA_DESC_SIZE)
-		__ASSERT_NO_MSG(data->blocks < CONFIG_INTEL_EMMC_HOST_ADMA_DESC_SIZE);
+		__ASSERT_NO_MSG(DIV_ROUND_UP(remaining, desc_max) <=
+				CONFIG_INTEL_EMMC_HOST_ADMA_DESC_SIZE);
 #endif
-		for (int i = 0; i < data->blocks; i++) {
+		/* The buffer is contiguous, each descriptor covers as many blocks as it can */
+		for (int i = 0; remaining > 0; i++) {
+			len = MIN(remaining, desc_max);
+			remaining -= len;
+
 			emmc->desc_table[i] = ((uint64_t)buff) << EMMC_HOST_ADMA_BUFF_ADD_LOC;
-			emmc->desc_table[i] |= data->block_size << EMMC_HOST_ADMA_BUFF_LEN_LOC;
+			emmc->desc_table[i] |= (uint64_t)len << EMMC_HOST_ADMA_BUFF_LEN_LOC;
 
-			if (i == (data->blocks - 1u)) {
+			if (remaining == 0) {
 				emmc->desc_table[i] |= EMMC_HOST_ADMA_BUFF_LINK_LAST;
 				emmc->desc_table[i] |= EMMC_HOST_ADMA_INTR_EN;
 				emmc->desc_table[i] |= EMMC_HOST_ADMA_BUFF_LAST;
@@ -435,7 +445,7 @@ static int emmc_dma_init(const struct device *dev, struct sdhc_data *data, bool
 				emmc->desc_table[i] |= EMMC_HOST_ADMA_BUFF_LINK_NEXT;
 			}
 			emmc->desc_table[i] |= EMMC_HOST_ADMA_BUFF_VALID;
-			buff += data->block_size;
+			buff += len;
 			LOG_DBG("desc_table:%llx", emmc->desc_table[i]);
 		}
 
@@ -38,6 +38,7 @@
 
 #define EMMC_HOST_ADMA_BUFF_ADD_LOC   32
 #define EMMC_HOST_ADMA_BUFF_LEN_LOC   16
+#define EMMC_HOST_ADMA_BUFF_LEN_MAX   0xFFFFu
 #define EMMC_HOST_ADMA_BUFF_LINK_NEXT (0x3 << 4)
 #define EMMC_HOST_ADMA_BUFF_LINK_LAST (0x2 << 4)
 #define EMMC_HOST_ADMA_INTR_EN        BIT(2)
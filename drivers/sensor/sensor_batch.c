@@ -0,0 +1,278 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stddef.h>
+
+#include <zephyr/drivers/sensor_batch.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(sensor_batch, CONFIG_SENSOR_LOG_LEVEL);
+
+#define SENSOR_BATCH_CHUNK CONFIG_SENSOR_BATCH_DECODE_CHUNK
+
+/* Room for a chunk of frames of the largest supported type */
+union sensor_batch_scratch {
+	struct sensor_three_axis_data three_axis;
+	struct sensor_q31_data q31;
+	uint8_t raw[sizeof(struct sensor_three_axis_data) +
+		    (SENSOR_BATCH_CHUNK - 1) * sizeof(struct sensor_three_axis_sample_data)];
+};
+
+/* The samples of both types are read the same way */
+BUILD_ASSERT(offsetof(struct sensor_three_axis_sample_data, values) ==
+	     offsetof(struct sensor_q31_sample_data, value));
+
+static inline q31_t sensor_batch_rescale(q31_t value, int shift_diff)
+{
+	if (shift_diff < 0) {
+		return value >> -shift_diff;
+	}
+
+	return (q31_t)CLAMP((int64_t)value << shift_diff, INT32_MIN, INT32_MAX);
+}
+
+/* Append a chunk of decoded frames to the batch, one axis at a time */
+static void sensor_batch_append(struct sensor_batch *batch, const void *readings,
+				size_t frame_size, int count, int shift_diff, uint32_t time_offset)
+{
+	const uint8_t *frame = readings;
+
+	for (uint8_t axis = 0; axis < batch->num_axes; axis++) {
+		const uint8_t *src = frame + offsetof(struct sensor_q31_sample_data, value) +
+				     axis * sizeof(q31_t);
+		q31_t *dst = &batch->values[axis][batch->count];
+
+		if (shift_diff == 0) {
+			for (int i = 0; i < count; i++) {
+				dst[i] = *(const q31_t *)(src + i * frame_size);
+			}
+		} else {
+			for (int i = 0; i < count; i++) {
+				q31_t value = *(const q31_t *)(src + i * frame_size);
+
+				dst[i] = sensor_batch_rescale(value, shift_diff);
+			}
+		}
+	}
+
+	if (batch->timestamp_deltas != NULL) {
+		for (int i = 0; i < count; i++) {
+			batch->timestamp_deltas[batch->count + i] =
+				time_offset + *(const uint32_t *)(frame + i * frame_size);
+		}
+	}
+
+	batch->count += count;
+}
+
+int sensor_batch_decode(const struct sensor_decoder_api *decoder, const uint8_t *buf,
+			struct sensor_chan_spec chan_spec, struct sensor_batch *batch)
+{
+	union sensor_batch_scratch scratch;
+	struct sensor_data_header *header;
+	const void *readings;
+	size_t base_size;
+	size_t frame_size;
+	uint16_t frame_count;
+	uint32_t time_offset;
+	uint32_t fit = 0;
+	int8_t shift;
+	int rc;
+
+	rc = decoder->get_size_info(chan_spec, &base_size, &frame_size);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (base_size == sizeof(struct sensor_three_axis_data) &&
+	    frame_size == sizeof(struct sensor_three_axis_sample_data)) {
+		batch->num_axes = 3;
+		header = &scratch.three_axis.header;
+		readings = scratch.three_axis.readings;
+	} else if (base_size == sizeof(struct sensor_q31_data) &&
+		   frame_size == sizeof(struct sensor_q31_sample_data)) {
+		batch->num_axes = 1;
+		header = &scratch.q31.header;
+		readings = scratch.q31.readings;
+	} else {
+		return -ENOTSUP;
+	}
+
+	for (uint8_t axis = 0; axis < batch->num_axes; axis++) {
+		if (batch->values[axis] == NULL) {
+			return -EINVAL;
+		}
+	}
+
+	rc = decoder->get_frame_count(buf, chan_spec, &frame_count);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (frame_count > batch->capacity) {
+		LOG_DBG("%u frames for %u entries", frame_count, batch->capacity);
+		return -ENOSPC;
+	}
+
+	batch->count = 0;
+
+	while (batch->count < frame_count) {
+		rc = decoder->decode(buf, chan_spec, &fit,
+				     MIN(SENSOR_BATCH_CHUNK, frame_count - batch->count),
+				     &scratch);
+		if (rc <= 0) {
+			break;
+		}
+
+		shift = (batch->num_axes == 3) ? scratch.three_axis.shift : scratch.q31.shift;
+
+		if (batch->count == 0) {
+			batch->base_timestamp_ns = header->base_timestamp_ns;
+			batch->shift = shift;
+		}
+
+		time_offset = (uint32_t)(header->base_timestamp_ns - batch->base_timestamp_ns);
+		sensor_batch_append(batch, readings, frame_size, rc, shift - batch->shift,
+				    time_offset);
+	}
+
+	return MIN(rc, 0);
+}
+
+#ifdef CONFIG_SENSOR_BATCH_FILTER
+int sensor_batch_filter_init_biquad(struct sensor_batch_filter *filter, uint8_t num_axes,
+				    uint8_t num_stages, const q31_t *coeffs, int8_t post_shift,
+				    q31_t *state)
+{
+	if (num_axes == 0 || num_axes > SENSOR_BATCH_MAX_AXES || num_stages == 0) {
+		return -EINVAL;
+	}
+
+	filter->type = SENSOR_BATCH_FILTER_BIQUAD;
+	filter->num_axes = num_axes;
+
+	for (uint8_t axis = 0; axis < num_axes; axis++) {
+		arm_biquad_cascade_df1_init_q31(&filter->inst[axis].biquad, num_stages, coeffs,
+						&state[axis * 4 * num_stages], post_shift);
+	}
+
+	return 0;
+}
+
+int sensor_batch_filter_init_fir(struct sensor_batch_filter *filter, uint8_t num_axes,
+				 uint16_t num_taps, const q31_t *coeffs, uint16_t max_count,
+				 q31_t *state)
+{
+	const size_t state_len = num_taps + max_count - 1;
+
+	if (num_axes == 0 || num_axes > SENSOR_BATCH_MAX_AXES || num_taps == 0 ||
+	    max_count == 0) {
+		return -EINVAL;
+	}
+
+	filter->type = SENSOR_BATCH_FILTER_FIR;
+	filter->num_axes = num_axes;
+
+	for (uint8_t axis = 0; axis < num_axes; axis++) {
+		arm_fir_init_q31(&filter->inst[axis].fir, num_taps, coeffs,
+				 &state[axis * state_len], max_count);
+	}
+
+	return 0;
+}
+
+int sensor_batch_filter_init_decimate(struct sensor_batch_filter *filter, uint8_t num_axes,
+				      uint16_t num_taps, uint8_t factor, const q31_t *coeffs,
+				      uint16_t max_count, q31_t *state)
+{
+	const size_t state_len = num_taps + max_count - 1;
+
+	if (num_axes == 0 || num_axes > SENSOR_BATCH_MAX_AXES || num_taps == 0 ||
+	    factor == 0) {
+		return -EINVAL;
+	}
+
+	filter->type = SENSOR_BATCH_FILTER_DECIMATE;
+	filter->num_axes = num_axes;
+
+	for (uint8_t axis = 0; axis < num_axes; axis++) {
+		if (arm_fir_decimate_init_q31(&filter->inst[axis].decimate, num_taps, factor,
+					      coeffs, &state[axis * state_len],
+					      max_count) != ARM_MATH_SUCCESS) {
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+static int sensor_batch_filter_one(struct sensor_batch_filter *filter,
+				   struct sensor_batch *batch)
+{
+	uint8_t factor = 1;
+
+	if (filter->num_axes != batch->num_axes) {
+		return -EINVAL;
+	}
+
+	if (filter->type == SENSOR_BATCH_FILTER_DECIMATE) {
+		factor = filter->inst[0].decimate.M;
+		if ((batch->count % factor) != 0) {
+			return -EINVAL;
+		}
+	}
+
+	for (uint8_t axis = 0; axis < batch->num_axes; axis++) {
+		q31_t *values = batch->values[axis];
+
+		switch (filter->type) {
+		case SENSOR_BATCH_FILTER_BIQUAD:
+			arm_biquad_cascade_df1_q31(&filter->inst[axis].biquad, values, values,
+						   batch->count);
+			break;
+		case SENSOR_BATCH_FILTER_FIR:
+			arm_fir_q31(&filter->inst[axis].fir, values, values, batch->count);
+			break;
+		case SENSOR_BATCH_FILTER_DECIMATE:
+			arm_fir_decimate_q31(&filter->inst[axis].decimate, values, values,
+					     batch->count);
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	if (factor > 1) {
+		batch->count /= factor;
+
+		/* Each output sample is computed once the last sample of its group is in */
+		if (batch->timestamp_deltas != NULL) {
+			for (uint16_t i = 0; i < batch->count; i++) {
+				batch->timestamp_deltas[i] =
+					batch->timestamp_deltas[i * factor + factor - 1];
+			}
+		}
+	}
+
+	return 0;
+}
+
+int sensor_batch_filter(struct sensor_batch_filter *filters, size_t num_filters,
+			struct sensor_batch *batch)
+{
+	for (size_t i = 0; i < num_filters; i++) {
+		int rc = sensor_batch_filter_one(&filters[i], batch);
+
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SENSOR_BATCH_FILTER */
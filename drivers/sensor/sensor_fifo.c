@@ -0,0 +1,214 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/drivers/sensor_clock.h>
+#include <zephyr/drivers/sensor_fifo.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(sensor_fifo, CONFIG_SENSOR_LOG_LEVEL);
+
+struct sensor_stream_trigger *sensor_read_config_trigger(const struct sensor_read_config *cfg,
+							 enum sensor_trigger_type trig)
+{
+	for (size_t i = 0; i < cfg->count; ++i) {
+		if (cfg->triggers[i].trigger == trig) {
+			return &cfg->triggers[i];
+		}
+	}
+
+	return NULL;
+}
+
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r)
+{
+	__ASSERT_NO_MSG(cfg->level_len <= sizeof(stream->level));
+
+	memset(stream, 0, sizeof(*stream));
+	stream->dev = dev;
+	stream->cfg = cfg;
+	stream->r = r;
+}
+
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe)
+{
+	stream->iodev_sqe = iodev_sqe;
+}
+
+/* Takes the pending submission, which RTIO submits again once completed */
+static struct rtio_iodev_sqe *sensor_fifo_stream_take(struct sensor_fifo_stream *stream)
+{
+	struct rtio_iodev_sqe *iodev_sqe = stream->iodev_sqe;
+
+	stream->iodev_sqe = NULL;
+
+	return iodev_sqe;
+}
+
+static void sensor_fifo_stream_flush_cqes(struct rtio *r)
+{
+	struct rtio_cqe *cqe;
+
+	do {
+		cqe = rtio_cqe_consume(r);
+		if (cqe != NULL) {
+			rtio_cqe_release(r, cqe);
+		}
+	} while (cqe != NULL);
+}
+
+static void sensor_fifo_stream_data_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	struct rtio_iodev_sqe *iodev_sqe = sqe->userdata;
+
+	rtio_iodev_sqe_ok(iodev_sqe, stream->read_len);
+
+	stream->cfg->api->int_enable(stream->dev);
+}
+
+static void sensor_fifo_stream_level_cb(struct rtio *r, const struct rtio_sqe *sqe, void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	struct rtio_iodev_sqe *iodev_sqe = sensor_fifo_stream_take(stream);
+	uint32_t fifo_bytes = cfg->api->fifo_bytes(stream->dev, stream->level);
+	struct rtio_sqe *complete;
+	uint8_t *buf;
+	uint32_t buf_len;
+	int rc;
+
+	if (iodev_sqe == NULL) {
+		LOG_DBG("No pending SQE");
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	rc = rtio_sqe_rx_buf(iodev_sqe, cfg->header_size + cfg->frame_size,
+			     cfg->header_size + fifo_bytes, &buf, &buf_len);
+	if (rc != 0) {
+		LOG_ERR("Failed to get buffer");
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	/* Whole frames only, what does not fit is left for the next time */
+	stream->read_len = MIN(fifo_bytes, buf_len - cfg->header_size);
+	stream->read_len -= stream->read_len % cfg->frame_size;
+	cfg->api->fill_header(stream->dev, buf, stream->timestamp, stream->read_len);
+
+	if (stream->read_len == 0) {
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	sensor_fifo_stream_flush_cqes(r);
+
+	/* Drain the FIFO with a single burst */
+	rc = cfg->api->prep_read(stream->dev, r, cfg->data_reg, buf + cfg->header_size,
+				 stream->read_len);
+	complete = rtio_sqe_acquire(r);
+	if (rc != 0 || complete == NULL) {
+		rtio_sqe_drop_all(r);
+		rtio_iodev_sqe_err(iodev_sqe, rc != 0 ? rc : -ENOMEM);
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+	rtio_sqe_prep_callback(complete, sensor_fifo_stream_data_cb, stream, iodev_sqe);
+
+	rtio_submit(r, 0);
+}
+
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream, bool watermark, bool full)
+{
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	const struct sensor_read_config *read_cfg;
+	struct sensor_stream_trigger *wm_trig = NULL;
+	struct sensor_stream_trigger *full_trig = NULL;
+	enum sensor_stream_data_opt opt;
+	struct rtio_iodev_sqe *iodev_sqe;
+	struct rtio_sqe *check;
+	uint64_t cycles;
+	uint8_t *buf;
+	uint32_t buf_len;
+	int rc;
+
+	if (stream->iodev_sqe == NULL) {
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	rc = sensor_clock_get_cycles(&cycles);
+	if (rc != 0) {
+		LOG_ERR("Failed to get sensor clock cycles");
+		rtio_iodev_sqe_err(sensor_fifo_stream_take(stream), rc);
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+	stream->timestamp = sensor_clock_cycles_to_ns(cycles);
+
+	read_cfg = stream->iodev_sqe->sqe.iodev->data;
+	if (watermark) {
+		wm_trig = sensor_read_config_trigger(read_cfg, SENSOR_TRIG_FIFO_WATERMARK);
+	}
+	if (full) {
+		full_trig = sensor_read_config_trigger(read_cfg, SENSOR_TRIG_FIFO_FULL);
+	}
+
+	if (wm_trig == NULL && full_trig == NULL) {
+		LOG_DBG("No FIFO trigger is configured");
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	if (wm_trig != NULL && full_trig != NULL) {
+		opt = MIN(wm_trig->opt, full_trig->opt);
+	} else {
+		opt = (wm_trig != NULL) ? wm_trig->opt : full_trig->opt;
+	}
+
+	if (opt == SENSOR_STREAM_DATA_NOP || opt == SENSOR_STREAM_DATA_DROP) {
+		iodev_sqe = sensor_fifo_stream_take(stream);
+		if (rtio_sqe_rx_buf(iodev_sqe, cfg->header_size, cfg->header_size,
+				    &buf, &buf_len) != 0) {
+			rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+			cfg->api->int_enable(stream->dev);
+			return;
+		}
+
+		memset(buf, 0, buf_len);
+		cfg->api->fill_header(stream->dev, buf, stream->timestamp, 0);
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
+
+		if (opt == SENSOR_STREAM_DATA_DROP && cfg->api->flush != NULL) {
+			cfg->api->flush(stream->dev);
+		}
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+
+	sensor_fifo_stream_flush_cqes(stream->r);
+
+	/* The data is needed, read the FIFO level first */
+	rc = cfg->api->prep_read(stream->dev, stream->r, cfg->level_reg, stream->level,
+				 cfg->level_len);
+	check = rtio_sqe_acquire(stream->r);
+	if (rc != 0 || check == NULL) {
+		rtio_sqe_drop_all(stream->r);
+		rtio_iodev_sqe_err(sensor_fifo_stream_take(stream), rc != 0 ? rc : -ENOMEM);
+		cfg->api->int_enable(stream->dev);
+		return;
+	}
+	rtio_sqe_prep_callback(check, sensor_fifo_stream_level_cb, stream, NULL);
+
+	rtio_submit(stream->r, 0);
+}
@@ -13,9 +13,16 @@ static uint8_t inc(struct uart_async_rx *rx_data, uint8_t val)
 	return (val + 1) & (rx_data->config->buf_cnt - 1);
 }
 
+/* Buffers start at the first location suitable for their header. */
+static uint8_t *get_base(const struct uart_async_rx_config *config)
+{
+	return (uint8_t *)ROUND_UP((uintptr_t)config->buffer,
+				   __alignof__(struct uart_async_rx_buf));
+}
+
 static struct uart_async_rx_buf *get_buf(struct uart_async_rx *rx_data, uint8_t idx)
 {
-	uint8_t *p = rx_data->config->buffer;
+	uint8_t *p = get_base(rx_data->config);
 
 	p += idx * (rx_data->buf_len + sizeof(struct uart_async_rx_buf));
 
@@ -137,15 +144,24 @@ void uart_async_rx_reset(struct uart_async_rx *rx_data)
 int uart_async_rx_init(struct uart_async_rx *rx_data,
 		       const struct uart_async_rx_config *config)
 {
+	size_t skip = get_base(config) - config->buffer;
+	size_t chunk;
+
 	__ASSERT_NO_MSG(config->buf_cnt > 0);
-	__ASSERT_NO_MSG(config->length / config->buf_cnt <= UINT8_MAX);
 	memset(rx_data, 0, sizeof(*rx_data));
 	rx_data->config = config;
-	rx_data->buf_len = (config->length / config->buf_cnt) - UART_ASYNC_RX_BUF_OVERHEAD;
 
-	if (rx_data->buf_len >= BIT(7)) {
+	if (config->length <= skip) {
+		return -EINVAL;
+	}
+
+	chunk = ROUND_DOWN((config->length - skip) / config->buf_cnt,
+			   __alignof__(struct uart_async_rx_buf));
+	if ((chunk <= UART_ASYNC_RX_BUF_OVERHEAD) ||
+	    (chunk - UART_ASYNC_RX_BUF_OVERHEAD >= BIT(15))) {
 		return -EINVAL;
 	}
+	rx_data->buf_len = chunk - UART_ASYNC_RX_BUF_OVERHEAD;
 	uart_async_rx_reset(rx_data);
 
 	return 0;
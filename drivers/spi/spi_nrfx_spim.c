@@ -59,6 +59,13 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_PM_DEVICE_SYSTEM_MANAGED));
 #define SPIM_REQUESTS_CLOCK(idx) 0
 #endif
 
+/* Clock requests cannot be made from the interrupt context RTIO transactions
+ * are chained from, instances that need them use the default RTIO handler.
+ */
+#if defined(CONFIG_SPI_RTIO) && !defined(USE_CLOCK_REQUESTS)
+#define SPI_NRFX_RTIO 1
+#endif
+
 struct spi_nrfx_data {
 	struct spi_context ctx;
 	const struct device *dev;
@@ -77,6 +84,11 @@ struct spi_nrfx_data {
 #ifdef USE_CLOCK_REQUESTS
 	bool clock_requested;
 #endif
+#ifdef SPI_NRFX_RTIO
+	struct spi_rtio *rtio_ctx;
+	struct spi_buf rtio_tx;
+	struct spi_buf rtio_rx;
+#endif
 };
 
 struct spi_nrfx_config {
@@ -101,6 +113,9 @@ struct spi_nrfx_config {
 };
 
 static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context);
+#ifdef SPI_NRFX_RTIO
+static void spi_nrfx_iodev_complete(const struct device *dev, int status);
+#endif
 
 static inline int request_clock(const struct device *dev)
 {
@@ -400,6 +415,13 @@ static void finish_transaction(const struct device *dev, int error)
 
 	LOG_DBG("Transaction finished with status %d", error);
 
+#ifdef SPI_NRFX_RTIO
+	if (dev_data->rtio_ctx->txn_head != NULL) {
+		spi_nrfx_iodev_complete(dev, error);
+		return;
+	}
+#endif
+
 	spi_context_complete(ctx, dev, error);
 	dev_data->busy = false;
 
@@ -532,6 +554,136 @@ static void event_handler(const nrfx_spim_evt_t *p_event, void *p_context)
 	}
 }
 
+#ifdef SPI_NRFX_RTIO
+/* Starts the current submission through the same chunked transfer as
+ * transceive(), so EasyDMA limits and RAM bounce buffers apply to it too.
+ */
+static void spi_nrfx_iodev_start(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct rtio_sqe *sqe = &dev_data->rtio_ctx->txn_curr->sqe;
+	const struct spi_buf_set tx_bufs = {
+		.buffers = &dev_data->rtio_tx,
+		.count = 1,
+	};
+	const struct spi_buf_set rx_bufs = {
+		.buffers = &dev_data->rtio_rx,
+		.count = 1,
+	};
+	bool tx = true;
+	bool rx = false;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		dev_data->rtio_rx.buf = sqe->rx.buf;
+		dev_data->rtio_rx.len = sqe->rx.buf_len;
+		tx = false;
+		rx = true;
+		break;
+	case RTIO_OP_TX:
+		dev_data->rtio_tx.buf = (uint8_t *)sqe->tx.buf;
+		dev_data->rtio_tx.len = sqe->tx.buf_len;
+		break;
+	case RTIO_OP_TINY_TX:
+		dev_data->rtio_tx.buf = sqe->tiny_tx.buf;
+		dev_data->rtio_tx.len = sqe->tiny_tx.buf_len;
+		break;
+	case RTIO_OP_TXRX:
+		dev_data->rtio_tx.buf = (uint8_t *)sqe->txrx.tx_buf;
+		dev_data->rtio_tx.len = sqe->txrx.buf_len;
+		dev_data->rtio_rx.buf = sqe->txrx.rx_buf;
+		dev_data->rtio_rx.len = sqe->txrx.buf_len;
+		rx = true;
+		break;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		spi_nrfx_iodev_complete(dev, -EINVAL);
+		return;
+	}
+
+	spi_context_buffers_setup(&dev_data->ctx, tx ? &tx_bufs : NULL,
+				  rx ? &rx_bufs : NULL, 1);
+	transfer_next_chunk(dev);
+}
+
+/* Begins the transaction at the head of the queue, failing transactions
+ * that cannot be started until one can or the queue is empty.
+ */
+static void spi_nrfx_iodev_begin(const struct device *dev)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	const struct spi_nrfx_config *dev_config = dev->config;
+	struct spi_rtio *rtio_ctx = dev_data->rtio_ctx;
+	void *reg = dev_config->spim.p_reg;
+	struct spi_dt_spec *spi_dt_spec;
+	int error;
+
+	do {
+		/* This may run in the completion interrupt of the previous
+		 * transaction, where resuming a suspended device is refused.
+		 */
+		error = pm_device_runtime_get(dev);
+		if (error < 0) {
+			continue;
+		}
+
+		spi_dt_spec = rtio_ctx->txn_curr->sqe.iodev->data;
+		error = configure(dev, &spi_dt_spec->config);
+		if (error == 0) {
+			dev_data->busy = true;
+
+			if (dev_config->wake_pin != WAKE_PIN_NOT_USED &&
+			    spi_nrfx_wake_request(&dev_config->wake_gpiote,
+						  dev_config->wake_pin) == -ETIMEDOUT) {
+				LOG_WRN("Waiting for WAKE acknowledgment timed out");
+			}
+
+			if (NRF_SPIM_IS_320MHZ_SPIM(reg)) {
+				nrfy_spim_enable(reg);
+			}
+			spi_context_cs_control(&dev_data->ctx, true);
+
+			spi_nrfx_iodev_start(dev);
+			return;
+		}
+
+		pm_device_runtime_put_async(dev, K_NO_WAIT);
+	} while (spi_rtio_complete(rtio_ctx, error));
+}
+
+static void spi_nrfx_iodev_complete(const struct device *dev, int status)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+	struct spi_rtio *rtio_ctx = dev_data->rtio_ctx;
+
+	/* Submissions of a transaction follow each other straight from the
+	 * interrupt handler, with CS kept asserted.
+	 */
+	if (!status && rtio_ctx->txn_curr->sqe.flags & RTIO_SQE_TRANSACTION) {
+		rtio_ctx->txn_curr = rtio_txn_next(rtio_ctx->txn_curr);
+		spi_nrfx_iodev_start(dev);
+		return;
+	}
+
+	dev_data->busy = false;
+	finalize_spi_transaction(dev, true);
+
+	if (spi_rtio_complete(rtio_ctx, status)) {
+		spi_nrfx_iodev_begin(dev);
+	}
+}
+
+static void spi_nrfx_iodev_submit(const struct device *dev,
+				  struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_nrfx_data *dev_data = dev->data;
+
+	if (spi_rtio_submit(dev_data->rtio_ctx, iodev_sqe)) {
+		spi_nrfx_iodev_begin(dev);
+	}
+}
+#endif /* SPI_NRFX_RTIO */
+
 static int transceive(const struct device *dev,
 		      const struct spi_config *spi_cfg,
 		      const struct spi_buf_set *tx_bufs,
@@ -545,6 +697,21 @@ static int transceive(const struct device *dev,
 	void *reg = dev_config->spim.p_reg;
 	int error;
 
+#ifdef SPI_NRFX_RTIO
+	/* Go through the RTIO queue so that these transfers cannot interleave
+	 * with the ones submitted to it directly.
+	 */
+	ARG_UNUSED(reg);
+
+	spi_context_lock(&dev_data->ctx, false, NULL, NULL, spi_cfg);
+	error = spi_rtio_transceive(dev_data->rtio_ctx, spi_cfg, tx_bufs, rx_bufs);
+	if (asynchronous && cb != NULL) {
+		cb(dev, error, userdata);
+	}
+	spi_context_release(&dev_data->ctx, error);
+
+	return error;
+#else
 	pm_device_runtime_get(dev);
 	spi_context_lock(&dev_data->ctx, asynchronous, cb, userdata, spi_cfg);
 
@@ -612,6 +779,7 @@ static int transceive(const struct device *dev,
 	spi_context_release(&dev_data->ctx, error);
 
 	return error;
+#endif /* SPI_NRFX_RTIO */
 }
 
 static int spi_nrfx_transceive(const struct device *dev,
@@ -658,7 +826,9 @@ static DEVICE_API(spi, spi_nrfx_driver_api) = {
 #ifdef CONFIG_SPI_ASYNC
 	.transceive_async = spi_nrfx_transceive_async,
 #endif
-#ifdef CONFIG_SPI_RTIO
+#if defined(SPI_NRFX_RTIO)
+	.iodev_submit = spi_nrfx_iodev_submit,
+#elif defined(CONFIG_SPI_RTIO)
 	.iodev_submit = spi_rtio_iodev_default_submit,
 #endif
 	.release = spi_nrfx_release,
@@ -753,6 +923,10 @@ static int spi_nrfx_init(const struct device *dev)
 
 	spi_context_unlock_unconditionally(&dev_data->ctx);
 
+#ifdef SPI_NRFX_RTIO
+	spi_rtio_init(dev_data->rtio_ctx, dev);
+#endif
+
 #ifdef CONFIG_SOC_NRF52832_ALLOW_SPIM_DESPITE_PAN_58
 	err = anomaly_58_workaround_init(dev);
 	if (err < 0) {
@@ -816,6 +990,10 @@ static int spi_nrfx_init(const struct device *dev)
 		 static uint8_t spim_##idx##_rx_buffer			       \
 			[CONFIG_SPI_NRFX_RAM_BUFFER_SIZE]		       \
 			SPIM_MEMORY_SECTION(idx);))			       \
+	IF_ENABLED(SPI_NRFX_RTIO,					       \
+		(SPI_RTIO_DEFINE(spi_##idx##_rtio,			       \
+				 CONFIG_SPI_NRFX_SPIM_RTIO_SQ_SIZE,	       \
+				 CONFIG_SPI_NRFX_SPIM_RTIO_SQ_SIZE);))	       \
 	static struct spi_nrfx_data spi_##idx##_data = {		       \
 		SPI_CONTEXT_INIT_LOCK(spi_##idx##_data, ctx),		       \
 		SPI_CONTEXT_INIT_SYNC(spi_##idx##_data, ctx),		       \
@@ -823,6 +1001,8 @@ static int spi_nrfx_init(const struct device *dev)
 		IF_ENABLED(SPI_BUFFER_IN_RAM,				       \
 			(.tx_buffer = spim_##idx##_tx_buffer,		       \
 			 .rx_buffer = spim_##idx##_rx_buffer,))		       \
+		IF_ENABLED(SPI_NRFX_RTIO,				       \
+			(.rtio_ctx = &spi_##idx##_rtio,))		       \
 		.dev  = DEVICE_DT_GET(SPIM(idx)),			       \
 		.busy = false,						       \
 	};								       \
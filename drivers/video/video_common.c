@@ -7,6 +7,7 @@
 
 #include <string.h>
 
+#include <zephyr/cache.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/video.h>
@@ -77,6 +78,39 @@ struct video_buffer *video_buffer_alloc(size_t size, k_timeout_t timeout)
 	return video_buffer_aligned_alloc(size, sizeof(void *), timeout);
 }
 
+struct video_buffer *video_buffer_import(void *mem, size_t size)
+{
+	int i;
+
+	__ASSERT_NO_MSG(mem != NULL);
+
+	/* The memory is owned by the caller, it gets no block */
+	for (i = 0; i < ARRAY_SIZE(video_buf); i++) {
+		if (video_buf[i].buffer == NULL) {
+			video_buf[i].buffer = mem;
+			video_buf[i].size = size;
+			video_buf[i].bytesused = 0;
+			return &video_buf[i];
+		}
+	}
+
+	return NULL;
+}
+
+void video_buffer_cache_flush(const struct video_buffer *vbuf)
+{
+	__ASSERT_NO_MSG(vbuf != NULL);
+
+	(void)sys_cache_data_flush_range(vbuf->buffer, vbuf->bytesused);
+}
+
+void video_buffer_cache_invd(const struct video_buffer *vbuf)
+{
+	__ASSERT_NO_MSG(vbuf != NULL);
+
+	(void)sys_cache_data_invd_range(vbuf->buffer, vbuf->size);
+}
+
 void video_buffer_release(struct video_buffer *vbuf)
 {
 	struct mem_block *block = NULL;
@@ -95,6 +129,8 @@ void video_buffer_release(struct video_buffer *vbuf)
 	vbuf->buffer = NULL;
 	if (block) {
 		VIDEO_COMMON_FREE(block->data);
+		/* Not to be taken for a later imported buffer */
+		block->data = NULL;
 	}
 }
 
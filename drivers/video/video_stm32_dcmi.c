@@ -17,6 +17,7 @@
 #include <zephyr/drivers/clock_control.h>
 #include <zephyr/drivers/dma.h>
 #include <zephyr/drivers/dma/dma_stm32.h>
+#include <zephyr/sys/dma_memcpy.h>
 
 #include <stm32_ll_dma.h>
 
@@ -45,6 +46,8 @@ struct video_stm32_dcmi_data {
 	struct k_fifo fifo_in;
 	struct k_fifo fifo_out;
 	struct video_buffer *vbuf;
+	/* Buffer the last frame is being copied to */
+	struct video_buffer *copy_vbuf;
 };
 
 struct video_stm32_dcmi_config {
@@ -60,6 +63,20 @@ void HAL_DCMI_ErrorCallback(DCMI_HandleTypeDef *hdcmi)
 	LOG_WRN("%s", __func__);
 }
 
+static void video_stm32_dcmi_frame_copied(void *user_data, int result)
+{
+	struct video_stm32_dcmi_data *dev_data = user_data;
+
+	if (result < 0) {
+		LOG_WRN("Frame copy failed: %d", result);
+	}
+
+	k_fifo_put(&dev_data->fifo_out, dev_data->copy_vbuf);
+
+	/* Capture overwrites the frame, so it resumes once copied */
+	HAL_DCMI_Resume(&dev_data->hdcmi);
+}
+
 void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi)
 {
 	struct video_stm32_dcmi_data *dev_data =
@@ -76,6 +93,14 @@ void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi)
 	}
 
 	vbuf->timestamp = k_uptime_get_32();
+
+	if (IS_ENABLED(CONFIG_VIDEO_DMA_MEMCPY)) {
+		dev_data->copy_vbuf = vbuf;
+		sys_dma_memcpy_async(vbuf->buffer, dev_data->vbuf->buffer, vbuf->bytesused,
+				     video_stm32_dcmi_frame_copied, dev_data);
+		return;
+	}
+
 	memcpy(vbuf->buffer, dev_data->vbuf->buffer, vbuf->bytesused);
 
 	k_fifo_put(&dev_data->fifo_out, vbuf);
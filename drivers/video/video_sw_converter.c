@@ -0,0 +1,411 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/video.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "video_device.h"
+
+LOG_MODULE_REGISTER(video_sw_converter, CONFIG_VIDEO_LOG_LEVEL);
+
+/*
+ * Memory to memory device: the source frames are enqueued as input buffers,
+ * the frames to fill as output buffers. Each pair of them is converted to the
+ * output format and scaled to the output size with a nearest neighbour, then
+ * both are returned by dequeue, told apart by their type.
+ */
+
+struct video_sw_converter_data {
+	struct video_format fmt_in;
+	struct video_format fmt_out;
+	struct k_fifo fifo_src;
+	struct k_fifo fifo_dst;
+	struct k_fifo fifo_done;
+	struct k_work work;
+	struct k_poll_signal *sig;
+	bool streaming;
+};
+
+#define VIDEO_SW_CONVERTER_FORMAT_CAP(pixfmt)                                                      \
+	{                                                                                          \
+		.pixelformat = pixfmt,                                                             \
+		.width_min = 2,                                                                    \
+		.width_max = 1920,                                                                 \
+		.height_min = 2,                                                                   \
+		.height_max = 1080,                                                                \
+		.width_step = 2,                                                                   \
+		.height_step = 2,                                                                  \
+	}
+
+static const struct video_format_cap fmts_in[] = {
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_YUYV),
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_RGB24),
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_SRGGB8),
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_SGRBG8),
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_SBGGR8),
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_SGBRG8),
+	{0},
+};
+
+static const struct video_format_cap fmts_out[] = {
+	VIDEO_SW_CONVERTER_FORMAT_CAP(VIDEO_PIX_FMT_RGB565),
+	{0},
+};
+
+/* Color (0 red, 1 green, 2 blue) of each pixel of a 2x2 Bayer quad */
+static const uint8_t bayer_rggb_idx[] = {0, 1, 1, 2};
+static const uint8_t bayer_bggr_idx[] = {2, 1, 1, 0};
+static const uint8_t bayer_gbrg_idx[] = {1, 2, 0, 1};
+static const uint8_t bayer_grbg_idx[] = {1, 0, 2, 1};
+
+static inline uint16_t rgb565(int r, int g, int b)
+{
+	r = CLAMP(r, 0, 255);
+	g = CLAMP(g, 0, 255);
+	b = CLAMP(b, 0, 255);
+
+	return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+}
+
+/* BT.709 limited range, the chroma terms being shared by the two pixels of a pair */
+static inline void yuv_terms(uint8_t u, uint8_t v, int *r, int *g, int *b)
+{
+	int d = u - 128;
+	int e = v - 128;
+
+	*r = 459 * e + 128;
+	*g = -55 * d - 136 * e + 128;
+	*b = 541 * d + 128;
+}
+
+static inline uint16_t yuv_rgb565(uint8_t y, int r, int g, int b)
+{
+	int c = 298 * (y - 16);
+
+	return rgb565((c + r) >> 8, (c + g) >> 8, (c + b) >> 8);
+}
+
+/* Same size YUYV rows, the common camera to display case */
+static void conv_row_yuyv_1x(const uint8_t *src, uint8_t *dst, uint32_t width)
+{
+	int r, g, b;
+
+	for (uint32_t x = 0; x < width; x += 2, src += 4, dst += 4) {
+		yuv_terms(src[1], src[3], &r, &g, &b);
+		sys_put_le16(yuv_rgb565(src[0], r, g, b), &dst[0]);
+		sys_put_le16(yuv_rgb565(src[2], r, g, b), &dst[2]);
+	}
+}
+
+static void conv_row_yuyv(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t x_step)
+{
+	int r, g, b;
+
+	for (uint32_t x = 0, sx = 0; x < width; x++, sx += x_step) {
+		const uint8_t *pair = &src[((sx >> 16) & ~1U) * 2];
+
+		yuv_terms(pair[1], pair[3], &r, &g, &b);
+		sys_put_le16(yuv_rgb565(pair[((sx >> 16) & 1U) * 2], r, g, b), &dst[x * 2]);
+	}
+}
+
+static void conv_row_rgb24(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t x_step)
+{
+	for (uint32_t x = 0, sx = 0; x < width; x++, sx += x_step) {
+		const uint8_t *p = &src[(sx >> 16) * 3];
+
+		sys_put_le16(rgb565(p[0], p[1], p[2]), &dst[x * 2]);
+	}
+}
+
+/* Each 2x2 quad gives the color of its four pixels */
+static void conv_row_bayer8(const uint8_t *row0, const uint8_t *row1, uint8_t *dst,
+			    uint32_t width, uint32_t x_step, const uint8_t *bayer_idx)
+{
+	for (uint32_t x = 0, sx = 0; x < width; x++, sx += x_step) {
+		uint32_t q = (sx >> 16) & ~1U;
+		const uint8_t quad[] = {row0[q], row0[q + 1], row1[q], row1[q + 1]};
+		int rgb[3] = {0};
+
+		for (int i = 0; i < ARRAY_SIZE(quad); i++) {
+			rgb[bayer_idx[i]] += quad[i];
+		}
+
+		sys_put_le16(rgb565(rgb[0], rgb[1] / 2, rgb[2]), &dst[x * 2]);
+	}
+}
+
+static int video_sw_converter_convert(struct video_sw_converter_data *data,
+				      const struct video_buffer *src, struct video_buffer *dst)
+{
+	const struct video_format *in = &data->fmt_in;
+	const struct video_format *out = &data->fmt_out;
+	const uint8_t *bayer_idx = NULL;
+	uint32_t x_step = (in->width << 16) / out->width;
+	uint32_t y_step = (in->height << 16) / out->height;
+
+	if (src->bytesused < in->pitch * in->height || dst->size < out->pitch * out->height) {
+		LOG_ERR("Buffers too small for the formats");
+		return -EINVAL;
+	}
+
+	switch (in->pixelformat) {
+	case VIDEO_PIX_FMT_SRGGB8:
+		bayer_idx = bayer_rggb_idx;
+		break;
+	case VIDEO_PIX_FMT_SGRBG8:
+		bayer_idx = bayer_grbg_idx;
+		break;
+	case VIDEO_PIX_FMT_SBGGR8:
+		bayer_idx = bayer_bggr_idx;
+		break;
+	case VIDEO_PIX_FMT_SGBRG8:
+		bayer_idx = bayer_gbrg_idx;
+		break;
+	default:
+		break;
+	}
+
+	for (uint32_t y = 0, sy = 0; y < out->height; y++, sy += y_step) {
+		const uint8_t *row = &src->buffer[(sy >> 16) * in->pitch];
+		uint8_t *dst_row = &dst->buffer[y * out->pitch];
+
+		if (bayer_idx != NULL) {
+			row = &src->buffer[((sy >> 16) & ~1U) * in->pitch];
+			conv_row_bayer8(row, row + in->pitch, dst_row, out->width, x_step,
+					bayer_idx);
+		} else if (in->pixelformat == VIDEO_PIX_FMT_YUYV && in->width == out->width) {
+			conv_row_yuyv_1x(row, dst_row, out->width);
+		} else if (in->pixelformat == VIDEO_PIX_FMT_YUYV) {
+			conv_row_yuyv(row, dst_row, out->width, x_step);
+		} else {
+			conv_row_rgb24(row, dst_row, out->width, x_step);
+		}
+	}
+
+	dst->bytesused = out->pitch * out->height;
+	dst->timestamp = src->timestamp;
+	dst->line_offset = 0;
+
+	return 0;
+}
+
+static void video_sw_converter_done(struct video_sw_converter_data *data,
+				    struct video_buffer *vbuf, enum video_signal_result result)
+{
+	k_fifo_put(&data->fifo_done, vbuf);
+
+	if (IS_ENABLED(CONFIG_POLL) && data->sig) {
+		k_poll_signal_raise(data->sig, result);
+	}
+}
+
+static void video_sw_converter_worker(struct k_work *work)
+{
+	struct video_sw_converter_data *data =
+		CONTAINER_OF(work, struct video_sw_converter_data, work);
+	struct video_buffer *src, *dst;
+	int ret;
+
+	/* The worker is the only consumer while streaming */
+	while (data->streaming && !k_fifo_is_empty(&data->fifo_src) &&
+	       !k_fifo_is_empty(&data->fifo_dst)) {
+		src = k_fifo_get(&data->fifo_src, K_NO_WAIT);
+		dst = k_fifo_get(&data->fifo_dst, K_NO_WAIT);
+
+		ret = video_sw_converter_convert(data, src, dst);
+
+		video_sw_converter_done(data, dst, ret ? VIDEO_BUF_ERROR : VIDEO_BUF_DONE);
+		video_sw_converter_done(data, src, VIDEO_BUF_DONE);
+	}
+}
+
+static int video_sw_converter_set_fmt(const struct device *dev, struct video_format *fmt)
+{
+	struct video_sw_converter_data *data = dev->data;
+	bool is_input = fmt->type == VIDEO_BUF_TYPE_INPUT;
+	size_t idx;
+	int ret;
+
+	if (data->streaming) {
+		return -EBUSY;
+	}
+
+	ret = video_format_caps_index(is_input ? fmts_in : fmts_out, fmt, &idx);
+	if (ret < 0) {
+		LOG_ERR("Unsupported pixel format or resolution");
+		return ret;
+	}
+
+	fmt->pitch = fmt->width * video_bits_per_pixel(fmt->pixelformat) / BITS_PER_BYTE;
+
+	if (is_input) {
+		data->fmt_in = *fmt;
+	} else {
+		data->fmt_out = *fmt;
+	}
+
+	return 0;
+}
+
+static int video_sw_converter_get_fmt(const struct device *dev, struct video_format *fmt)
+{
+	struct video_sw_converter_data *data = dev->data;
+
+	*fmt = (fmt->type == VIDEO_BUF_TYPE_INPUT) ? data->fmt_in : data->fmt_out;
+
+	return 0;
+}
+
+static int video_sw_converter_set_stream(const struct device *dev, bool enable,
+					 enum video_buf_type type)
+{
+	struct video_sw_converter_data *data = dev->data;
+	struct k_work_sync work_sync;
+
+	data->streaming = enable;
+
+	if (enable) {
+		k_work_submit(&data->work);
+	} else {
+		k_work_cancel_sync(&data->work, &work_sync);
+	}
+
+	return 0;
+}
+
+static int video_sw_converter_enqueue(const struct device *dev, struct video_buffer *vbuf)
+{
+	struct video_sw_converter_data *data = dev->data;
+
+	if (vbuf->type == VIDEO_BUF_TYPE_INPUT) {
+		k_fifo_put(&data->fifo_src, vbuf);
+	} else {
+		k_fifo_put(&data->fifo_dst, vbuf);
+	}
+
+	if (data->streaming) {
+		k_work_submit(&data->work);
+	}
+
+	return 0;
+}
+
+static int video_sw_converter_dequeue(const struct device *dev, struct video_buffer **vbuf,
+				      k_timeout_t timeout)
+{
+	struct video_sw_converter_data *data = dev->data;
+
+	*vbuf = k_fifo_get(&data->fifo_done, timeout);
+	if (*vbuf == NULL) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+static int video_sw_converter_flush(const struct device *dev, bool cancel)
+{
+	struct video_sw_converter_data *data = dev->data;
+	struct k_work_sync work_sync;
+	struct video_buffer *vbuf;
+
+	if (!cancel) {
+		/* Buffers left without a peer are never processed */
+		while (data->streaming && !k_fifo_is_empty(&data->fifo_src) &&
+		       !k_fifo_is_empty(&data->fifo_dst)) {
+			k_sleep(K_MSEC(1));
+		}
+
+		return 0;
+	}
+
+	k_work_cancel_sync(&data->work, &work_sync);
+
+	while ((vbuf = k_fifo_get(&data->fifo_src, K_NO_WAIT)) ||
+	       (vbuf = k_fifo_get(&data->fifo_dst, K_NO_WAIT))) {
+		video_sw_converter_done(data, vbuf, VIDEO_BUF_ABORTED);
+	}
+
+	if (data->streaming) {
+		k_work_submit(&data->work);
+	}
+
+	return 0;
+}
+
+static int video_sw_converter_get_caps(const struct device *dev, struct video_caps *caps)
+{
+	caps->format_caps = (caps->type == VIDEO_BUF_TYPE_INPUT) ? fmts_in : fmts_out;
+	caps->min_vbuf_count = 0;
+
+	/* Whole frames are needed for scaling */
+	caps->min_line_count = caps->max_line_count = LINE_COUNT_HEIGHT;
+
+	return 0;
+}
+
+#ifdef CONFIG_POLL
+static int video_sw_converter_set_signal(const struct device *dev, struct k_poll_signal *sig)
+{
+	struct video_sw_converter_data *data = dev->data;
+
+	if (data->sig && sig != NULL) {
+		return -EALREADY;
+	}
+
+	data->sig = sig;
+
+	return 0;
+}
+#endif
+
+static DEVICE_API(video, video_sw_converter_driver_api) = {
+	.set_format = video_sw_converter_set_fmt,
+	.get_format = video_sw_converter_get_fmt,
+	.set_stream = video_sw_converter_set_stream,
+	.flush = video_sw_converter_flush,
+	.enqueue = video_sw_converter_enqueue,
+	.dequeue = video_sw_converter_dequeue,
+	.get_caps = video_sw_converter_get_caps,
+#ifdef CONFIG_POLL
+	.set_signal = video_sw_converter_set_signal,
+#endif
+};
+
+static struct video_sw_converter_data video_sw_converter_data_0 = {
+	.fmt_in.type = VIDEO_BUF_TYPE_INPUT,
+	.fmt_in.width = 320,
+	.fmt_in.height = 240,
+	.fmt_in.pitch = 320 * 2,
+	.fmt_in.pixelformat = VIDEO_PIX_FMT_YUYV,
+	.fmt_out.type = VIDEO_BUF_TYPE_OUTPUT,
+	.fmt_out.width = 320,
+	.fmt_out.height = 240,
+	.fmt_out.pitch = 320 * 2,
+	.fmt_out.pixelformat = VIDEO_PIX_FMT_RGB565,
+};
+
+static int video_sw_converter_init(const struct device *dev)
+{
+	struct video_sw_converter_data *data = dev->data;
+
+	k_fifo_init(&data->fifo_src);
+	k_fifo_init(&data->fifo_dst);
+	k_fifo_init(&data->fifo_done);
+	k_work_init(&data->work, video_sw_converter_worker);
+
+	return 0;
+}
+
+DEVICE_DEFINE(video_sw_converter, "VIDEO_SW_CONVERTER", &video_sw_converter_init, NULL,
+	      &video_sw_converter_data_0, NULL, POST_KERNEL, CONFIG_VIDEO_INIT_PRIORITY,
+	      &video_sw_converter_driver_api);
+
+VIDEO_DEVICE_DEFINE(video_sw_converter, DEVICE_GET(video_sw_converter), NULL);
@@ -818,6 +818,23 @@ int arch_buffer_validate(const void *addr, size_t size, int write);
  */
 size_t arch_virt_region_align(uintptr_t phys, size_t size);
 
+/**
+ * Get the largest page size usable to map part of a region
+ *
+ * Used for K_MEM_MAP_LARGE mappings: the virtual address of the region is
+ * made congruent to its physical address modulo the returned size, so
+ * that all the pages of that size fully inside the region can be mapped
+ * as such by arch_mem_map().
+ *
+ * @param[in] phys Physical address of region to be mapped,
+ *                 aligned to @kconfig{CONFIG_MMU_PAGE_SIZE}
+ * @param[in] size Size of region to be mapped,
+ *                 aligned to @kconfig{CONFIG_MMU_PAGE_SIZE}
+ *
+ * @return Largest page size, or @kconfig{CONFIG_MMU_PAGE_SIZE} if none
+ */
+size_t arch_mem_large_page_size(uintptr_t phys, size_t size);
+
 /**
  * Perform a one-way transition from supervisor to user mode.
  *
@@ -1211,6 +1228,59 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_PERF_COUNTERS
+#include <zephyr/kernel/stats.h>
+
+/**
+ * @brief Arch specific hardware performance counters APIs
+ * @defgroup arch-perf-counter Architecture performance counters APIs
+ * @ingroup arch-interface
+ *
+ * Counters are free running 32-bit values, the kernel accounts the
+ * difference between two reads, so a counter must be read before it
+ * wraps around.
+ *
+ * @{
+ */
+
+/**
+ * @brief Number of counters which can be used at the same time.
+ *
+ * @return Number of counters of the current CPU.
+ */
+unsigned int arch_perf_counter_num(void);
+
+/**
+ * @brief Start counting an event.
+ *
+ * @param idx Counter index, below arch_perf_counter_num().
+ * @param event Event to count.
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if the counter cannot count @a event
+ */
+int arch_perf_counter_start(unsigned int idx, enum k_perf_event event);
+
+/**
+ * @brief Stop counting.
+ *
+ * @param idx Counter index, below arch_perf_counter_num().
+ */
+void arch_perf_counter_stop(unsigned int idx);
+
+/**
+ * @brief Read a counter.
+ *
+ * @param idx Counter index, below arch_perf_counter_num().
+ *
+ * @return Current value of the counter.
+ */
+uint32_t arch_perf_counter_read(unsigned int idx);
+
+/** @} */
+
+#endif /* CONFIG_PERF_COUNTERS */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
@@ -66,6 +66,8 @@ struct _thread_arch {
 #endif
 #ifdef CONFIG_FPU_SHARING
 	struct z_arm64_fp_context saved_fp_context;
+	/* context switches left with an eager FPU context restore */
+	uint8_t fpu_usage;
 #endif
 	uint8_t exception_depth;
 };
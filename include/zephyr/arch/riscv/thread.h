@@ -68,7 +68,8 @@ typedef struct z_riscv_fp_context z_riscv_fp_context_t;
 struct _thread_arch {
 #ifdef CONFIG_FPU_SHARING
 	struct z_riscv_fp_context saved_fp_context;
-	bool fpu_recently_used;
+	/* context switches left with an eager FPU context restore */
+	uint8_t fpu_usage;
 	uint8_t exception_depth;
 #endif
 #ifdef CONFIG_USERSPACE
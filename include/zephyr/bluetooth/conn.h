@@ -1046,6 +1046,28 @@ enum bt_conn_auth_keypress {
  */
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info);
 
+/** Connection transmit statistics */
+struct bt_conn_tx_stats {
+	/** Bytes of data handed to the controller, wraps around */
+	uint32_t bytes;
+	/** HCI data packets handed to the controller, wraps around */
+	uint32_t packets;
+};
+
+/** @brief Get connection transmit statistics
+ *
+ *  The counters start at zero when the connection is created. Sampling
+ *  them periodically gives the throughput of the connection.
+ *
+ *  @note @kconfig{CONFIG_BT_CONN_TX_STATS} must be enabled.
+ *
+ *  @param conn Connection object.
+ *  @param stats Statistics object.
+ *
+ *  @return Zero on success or (negative) error code on failure.
+ */
+int bt_conn_get_tx_stats(const struct bt_conn *conn, struct bt_conn_tx_stats *stats);
+
 /** @brief Function to determine the type of a connection
  *
  *  @param conn The connection object
@@ -1451,6 +1451,32 @@ int bt_gatt_notify_multiple(struct bt_conn *conn,
 			    uint16_t num_params,
 			    struct bt_gatt_notify_params params[]);
 
+/** @brief Send a batch of notifications to a client.
+ *
+ *  Sends the notifications like @ref bt_gatt_notify_cb, in order, and packs
+ *  them in as few PDUs as possible. If the peer supports Multiple Handle
+ *  Value Notifications, consecutive notifications with the same `func`,
+ *  `user_data` and `chan_opt` share ATT_MULTIPLE_HANDLE_VALUE_NTF PDUs up to
+ *  the MTU, which are sent before this function returns instead of after
+ *  @kconfig{CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS}. Otherwise each one is
+ *  sent as an ATT_HANDLE_VALUE_NTF.
+ *
+ *  Use it to push several characteristics updated at the same time, so they
+ *  go out in the same connection event.
+ *
+ *  @param conn Target client, notifying all clients is not supported.
+ *  @param num_params Element count of `params` array.
+ *  @param params Array of notification parameters. It is okay to free this
+ *                after calling this function.
+ *
+ *  @return 0 in case of success or negative value in case of error, as
+ *          returned by @ref bt_gatt_notify_cb for the first notification that
+ *          failed. The notifications before it are sent anyway.
+ */
+int bt_gatt_notify_batch(struct bt_conn *conn,
+			 uint16_t num_params,
+			 struct bt_gatt_notify_params params[]);
+
 /** @brief Notify attribute value change.
  *
  *  Send notification of attribute value change, if connection is NULL notify
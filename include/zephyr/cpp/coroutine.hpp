@@ -0,0 +1,668 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief C++20 coroutines on kernel work queues
+ *
+ * Lets application code wait for semaphores, message queues, timeouts,
+ * RTIO completions and socket readiness with `co_await`, instead of
+ * blocking a thread per state machine or chaining callbacks.
+ *
+ * A zephyr::task is a lazily started coroutine. It runs when awaited by
+ * another task, or when handed to zephyr::spawn(), which runs it on the
+ * work queue of a zephyr::executor. Whenever a task waits, its work queue
+ * thread goes on with other work items and coroutines, so hundreds of
+ * waiting tasks cost their frames only, not a thread stack each. Frames
+ * come from a pool of @kconfig{CONFIG_CPP_COROUTINE_FRAMES} blocks of
+ * @kconfig{CONFIG_CPP_COROUTINE_FRAME_SIZE} bytes.
+ *
+ * @code{.cpp}
+ * zephyr::task<> blink(zephyr::executor &exec)
+ * {
+ *	for (;;) {
+ *		if (co_await zephyr::sem_take(exec, &button, K_SECONDS(10)) == 0) {
+ *			gpio_pin_toggle_dt(&led);
+ *		}
+ *	}
+ * }
+ *
+ * zephyr::spawn(exec, blink(exec));
+ * @endcode
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_COROUTINE_HPP_
+#define ZEPHYR_INCLUDE_CPP_COROUTINE_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/slist.h>
+
+#ifdef CONFIG_RTIO_CONSUME_SEM
+#include <zephyr/rtio/rtio.h>
+#endif
+
+namespace zephyr
+{
+
+/**
+ * @defgroup cpp_coroutine_apis C++ coroutines
+ * @ingroup kernel_apis
+ * @{
+ */
+
+class executor;
+
+/** @cond INTERNAL_HIDDEN */
+namespace detail
+{
+
+extern "C" {
+void *z_cpp_coroutine_frame_alloc(size_t size);
+void z_cpp_coroutine_frame_free(void *ptr);
+
+/* Also defined in lib/cpp/coroutine/coroutine.c */
+struct z_cpp_socket_wait {
+	int fd;
+	short events;
+	short revents;
+	void (*ready)(struct z_cpp_socket_wait *wait);
+};
+
+int z_cpp_coroutine_socket_wait(struct z_cpp_socket_wait *wait);
+}
+
+/* Coroutine ready to be resumed by an executor */
+struct ready_node {
+	sys_snode_t node;
+	std::coroutine_handle<> handle;
+};
+
+template <typename T> class promise;
+
+} /* namespace detail */
+/** @endcond */
+
+/**
+ * @brief Runs coroutines on a work queue
+ *
+ * Coroutines ready to run are queued to the executor, which resumes them
+ * in order from a single work item of its queue. Every zephyr::task it
+ * runs, and the tasks they await, resume on that work queue thread.
+ *
+ * An executor must outlive the coroutines it runs.
+ */
+class executor {
+public:
+	/**
+	 * @param queue Work queue to run the coroutines on
+	 */
+	explicit executor(struct k_work_q *queue = &k_sys_work_q) noexcept : queue_(queue)
+	{
+		k_work_init(&work_, run);
+		sys_slist_init(&ready_);
+	}
+
+	executor(const executor &) = delete;
+	executor &operator=(const executor &) = delete;
+
+	/** @return The work queue the coroutines run on */
+	struct k_work_q *queue() const noexcept
+	{
+		return queue_;
+	}
+
+	/**
+	 * @brief Yield to the other work items of the queue
+	 *
+	 * `co_await exec.schedule()` also moves a coroutine to the work queue
+	 * of @p exec.
+	 */
+	auto schedule() noexcept
+	{
+		struct awaiter {
+			executor &exec;
+			detail::ready_node node;
+
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> h) noexcept
+			{
+				node.handle = h;
+				exec.post(node);
+			}
+
+			void await_resume() const noexcept
+			{
+			}
+		};
+
+		return awaiter{*this, {}};
+	}
+
+	/** @cond INTERNAL_HIDDEN */
+	void post(detail::ready_node &node) noexcept;
+	/** @endcond */
+
+private:
+	static void run(struct k_work *work);
+
+	/* First, so that run() finds the executor from its work item */
+	struct k_work work_;
+	struct k_work_q *queue_;
+	struct k_spinlock lock_;
+	sys_slist_t ready_;
+};
+
+/**
+ * @brief Lazily started coroutine
+ *
+ * The coroutine starts when the task is awaited, which returns the value
+ * it `co_return`s, or when the task is given to zephyr::spawn(). An empty
+ * task, from a coroutine whose frame could not be allocated, converts to
+ * false.
+ *
+ * @tparam T Type of the result of the coroutine
+ */
+template <typename T = void> class [[nodiscard]] task {
+public:
+	/** @cond INTERNAL_HIDDEN */
+	using promise_type = detail::promise<T>;
+	/** @endcond */
+
+	task() noexcept = default;
+
+	task(task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr))
+	{
+	}
+
+	task &operator=(task &&other) noexcept
+	{
+		if (this != &other) {
+			if (handle_) {
+				handle_.destroy();
+			}
+			handle_ = std::exchange(other.handle_, nullptr);
+		}
+
+		return *this;
+	}
+
+	~task()
+	{
+		if (handle_) {
+			handle_.destroy();
+		}
+	}
+
+	/** @return true unless the frame of the coroutine could not be allocated */
+	explicit operator bool() const noexcept
+	{
+		return static_cast<bool>(handle_);
+	}
+
+	/** @cond INTERNAL_HIDDEN */
+	bool await_ready() const noexcept
+	{
+		return false;
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+	{
+		handle_.promise().continuation = awaiting;
+
+		return handle_;
+	}
+
+	T await_resume()
+	{
+		if constexpr (!std::is_void_v<T>) {
+			return std::move(*handle_.promise().value);
+		}
+	}
+
+	std::coroutine_handle<promise_type> release() noexcept
+	{
+		return std::exchange(handle_, nullptr);
+	}
+	/** @endcond */
+
+private:
+	friend promise_type;
+
+	explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle)
+	{
+	}
+
+	std::coroutine_handle<promise_type> handle_;
+};
+
+/** @cond INTERNAL_HIDDEN */
+namespace detail
+{
+
+struct promise_base {
+	std::coroutine_handle<> continuation;
+	/* Used by spawn() to start the coroutine */
+	ready_node start;
+	bool detached = false;
+
+	static void *operator new(std::size_t size) noexcept
+	{
+		return z_cpp_coroutine_frame_alloc(size);
+	}
+
+	static void operator delete(void *ptr) noexcept
+	{
+		z_cpp_coroutine_frame_free(ptr);
+	}
+
+	std::suspend_always initial_suspend() noexcept
+	{
+		return {};
+	}
+
+	struct final_awaiter {
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		template <typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+		{
+			promise_base &p = h.promise();
+
+			if (p.continuation) {
+				return p.continuation;
+			}
+
+			if (p.detached) {
+				h.destroy();
+			}
+
+			return std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept
+		{
+		}
+	};
+
+	final_awaiter final_suspend() noexcept
+	{
+		return {};
+	}
+
+	void unhandled_exception() noexcept
+	{
+		std::terminate();
+	}
+};
+
+template <typename T> class promise : public promise_base {
+public:
+	std::optional<T> value;
+
+	task<T> get_return_object() noexcept
+	{
+		return task<T>(std::coroutine_handle<promise>::from_promise(*this));
+	}
+
+	static task<T> get_return_object_on_allocation_failure() noexcept
+	{
+		return task<T>();
+	}
+
+	template <typename U> void return_value(U &&v)
+	{
+		value.emplace(std::forward<U>(v));
+	}
+};
+
+template <> class promise<void> : public promise_base {
+public:
+	task<void> get_return_object() noexcept
+	{
+		return task<void>(std::coroutine_handle<promise>::from_promise(*this));
+	}
+
+	static task<void> get_return_object_on_allocation_failure() noexcept
+	{
+		return task<void>();
+	}
+
+	void return_void() noexcept
+	{
+	}
+};
+
+/* Posts a coroutine to its executor from the handler of a kernel work item */
+struct delayed_post {
+	struct k_work_delayable dwork;
+	executor *exec;
+	ready_node node;
+
+	static void handler(struct k_work *work)
+	{
+		auto *self = reinterpret_cast<delayed_post *>(k_work_delayable_from_work(work));
+
+		self->exec->post(self->node);
+	}
+};
+
+struct poll_post {
+	struct k_work_poll work;
+	executor *exec;
+	ready_node node;
+
+	static void handler(struct k_work *work)
+	{
+		auto *self = reinterpret_cast<poll_post *>(work);
+
+		self->exec->post(self->node);
+	}
+};
+
+struct socket_post {
+	struct z_cpp_socket_wait wait;
+	executor *exec;
+	ready_node node;
+
+	static void ready(struct z_cpp_socket_wait *wait)
+	{
+		auto *self = reinterpret_cast<socket_post *>(wait);
+
+		self->exec->post(self->node);
+	}
+};
+
+} /* namespace detail */
+/** @endcond */
+
+/**
+ * @brief Run a task on an executor
+ *
+ * The task starts from the work queue of @p exec, and its frame is freed
+ * when it completes.
+ *
+ * @param exec Executor to run the task on
+ * @param t Task to run
+ *
+ * @return false if @p t is empty, i.e. its frame could not be allocated.
+ */
+inline bool spawn(executor &exec, task<> &&t) noexcept
+{
+	auto handle = t.release();
+
+	if (!handle) {
+		return false;
+	}
+
+	handle.promise().detached = true;
+	handle.promise().start.handle = handle;
+	exec.post(handle.promise().start);
+
+	return true;
+}
+
+/**
+ * @brief Wait for some time
+ *
+ * @code{.cpp}
+ * co_await zephyr::sleep_for(exec, K_MSEC(100));
+ * @endcode
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param timeout Time to wait
+ */
+inline auto sleep_for(executor &exec, k_timeout_t timeout) noexcept
+{
+	struct awaiter {
+		detail::delayed_post post;
+		k_timeout_t timeout;
+
+		bool await_ready() const noexcept
+		{
+			return K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+		}
+
+		void await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			post.node.handle = h;
+			k_work_init_delayable(&post.dwork, detail::delayed_post::handler);
+			(void)k_work_schedule_for_queue(post.exec->queue(), &post.dwork, timeout);
+		}
+
+		void await_resume() const noexcept
+		{
+		}
+	};
+
+	return awaiter{{{}, &exec, {}}, timeout};
+}
+
+/**
+ * @brief Wait for kernel objects, like k_poll()
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param events Events to wait for, initialized with k_poll_event_init().
+ *               They must stay valid until the coroutine resumes.
+ * @param num_events Number of events
+ * @param timeout Time to wait for one of the events
+ *
+ * @return The result of the wait: 0 when an event is ready, -EAGAIN on
+ *         timeout, or another negative errno code of
+ *         k_work_poll_submit_to_queue().
+ */
+inline auto poll(executor &exec, struct k_poll_event *events, int num_events,
+		 k_timeout_t timeout) noexcept
+{
+	struct awaiter {
+		detail::poll_post post;
+		struct k_poll_event *events;
+		int num_events;
+		k_timeout_t timeout;
+		int ret;
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			int err;
+
+			post.node.handle = h;
+			k_work_poll_init(&post.work, detail::poll_post::handler);
+			err = k_work_poll_submit_to_queue(post.exec->queue(), &post.work, events,
+							  num_events, timeout);
+			if (err != 0) {
+				/* Not submitted, so nothing can resume the coroutine meanwhile */
+				ret = err;
+				return false;
+			}
+
+			return true;
+		}
+
+		int await_resume() const noexcept
+		{
+			return (ret != 0) ? ret : post.work.poll_result;
+		}
+	};
+
+	return awaiter{{{}, &exec, {}}, events, num_events, timeout, 0};
+}
+
+/**
+ * @brief Wait for a readiness event on a socket
+ *
+ * Requires @kconfig{CONFIG_CPP_COROUTINE_SOCKETS} and waits through the
+ * socket service, so that one thread polls the sockets of all the
+ * coroutines.
+ *
+ * @code{.cpp}
+ * if (co_await zephyr::socket_poll(exec, fd, ZSOCK_POLLIN) > 0) {
+ *	len = zsock_recv(fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+ * }
+ * @endcode
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param fd Socket to wait for
+ * @param events Events to wait for, as in `struct zsock_pollfd`
+ *
+ * @return The received events, as in `struct zsock_pollfd`, or -ENOMEM if
+ *         too many coroutines are waiting for sockets.
+ */
+inline auto socket_poll(executor &exec, int fd, short events) noexcept
+{
+	struct awaiter {
+		detail::socket_post post;
+		int ret;
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		bool await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			int err;
+
+			post.node.handle = h;
+			err = detail::z_cpp_coroutine_socket_wait(&post.wait);
+			if (err != 0) {
+				ret = err;
+				return false;
+			}
+
+			return true;
+		}
+
+		int await_resume() const noexcept
+		{
+			return (ret != 0) ? ret : post.wait.revents;
+		}
+	};
+
+	return awaiter{{{fd, events, 0, detail::socket_post::ready}, &exec, {}}, 0};
+}
+
+/**
+ * @brief Take a semaphore
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param sem Semaphore to take
+ * @param timeout Time to wait for the semaphore
+ *
+ * @return 0 when the semaphore was taken, -EAGAIN on timeout.
+ */
+inline task<int> sem_take(executor &exec, struct k_sem *sem, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct k_poll_event event;
+	int ret;
+
+	/* Another thread can take the semaphore between the event and the resume */
+	while (k_sem_take(sem, K_NO_WAIT) != 0) {
+		k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, sem);
+		ret = co_await poll(exec, &event, 1, sys_timepoint_timeout(end));
+		if (ret != 0) {
+			co_return ret;
+		}
+	}
+
+	co_return 0;
+}
+
+/**
+ * @brief Receive a message from a message queue
+ *
+ * This also receives the channel notifications of a zbus subscriber, from
+ * its message queue.
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param msgq Message queue
+ * @param data Where to store the message
+ * @param timeout Time to wait for a message
+ *
+ * @return 0 when a message was received, -EAGAIN on timeout.
+ */
+inline task<int> msgq_get(executor &exec, struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct k_poll_event event;
+	int ret;
+
+	while (k_msgq_get(msgq, data, K_NO_WAIT) != 0) {
+		k_poll_event_init(&event, K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+				  msgq);
+		ret = co_await poll(exec, &event, 1, sys_timepoint_timeout(end));
+		if (ret != 0) {
+			co_return ret;
+		}
+	}
+
+	co_return 0;
+}
+
+#ifdef CONFIG_RTIO_CONSUME_SEM
+/**
+ * @brief Wait for a completion of an RTIO context
+ *
+ * Submit requests with rtio_submit(r, 0), then wait for their completions
+ * with this instead of rtio_cqe_consume_block().
+ *
+ * @param exec Executor to resume the coroutine on
+ * @param r RTIO context
+ * @param cqe Where to copy the result, userdata and flags of the
+ *            completion, which is released
+ * @param timeout Time to wait for a completion
+ *
+ * @return 0 when a completion was consumed, -EAGAIN on timeout.
+ */
+inline task<int> rtio_cqe_wait(executor &exec, struct rtio *r, struct rtio_cqe *cqe,
+			       k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct k_poll_event event;
+	struct rtio_cqe *c;
+	int ret;
+
+	while ((c = rtio_cqe_consume(r)) == nullptr) {
+		k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+				  r->consume_sem);
+		ret = co_await poll(exec, &event, 1, sys_timepoint_timeout(end));
+		if (ret != 0) {
+			co_return ret;
+		}
+	}
+
+	cqe->result = c->result;
+	cqe->userdata = c->userdata;
+	cqe->flags = c->flags;
+	rtio_cqe_release(r, c);
+
+	co_return 0;
+}
+#endif /* CONFIG_RTIO_CONSUME_SEM */
+
+/** @} */
+
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_INCLUDE_CPP_COROUTINE_HPP_ */
@@ -0,0 +1,233 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Polymorphic memory resources backed by kernel allocators
+ *
+ * Adapters letting `std::pmr` containers allocate from a k_heap, a
+ * k_mem_slab or a sys_arena instead of the heap of the C library. They
+ * need a C++17 standard library providing `<memory_resource>`.
+ */
+
+#ifndef ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+#define ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/arena.h>
+
+namespace zephyr
+{
+
+/**
+ * @defgroup cpp_memory_resource_apis C++ memory resources
+ * @ingroup heaps
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+namespace detail
+{
+
+inline bool in_range(const void *p, const void *start, std::size_t bytes)
+{
+	uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+	uintptr_t base = reinterpret_cast<uintptr_t>(start);
+
+	return (addr >= base) && (addr - base < bytes);
+}
+
+} /* namespace detail */
+/** @endcond */
+
+/**
+ * @brief Memory resource allocating from a k_heap
+ *
+ * Allocations never wait. When the heap is full, the upstream resource is
+ * used instead, by default std::pmr::null_memory_resource(), which fails
+ * the allocation.
+ */
+class k_heap_resource : public std::pmr::memory_resource {
+public:
+	/**
+	 * @param heap Heap to allocate from
+	 * @param upstream Resource used when @p heap is full
+	 */
+	explicit k_heap_resource(struct k_heap *heap,
+				 std::pmr::memory_resource *upstream =
+					 std::pmr::null_memory_resource())
+		: heap_(heap), upstream_(upstream)
+	{
+	}
+
+	/** @return The heap this resource allocates from */
+	struct k_heap *heap() const
+	{
+		return heap_;
+	}
+
+protected:
+	void *do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		void *p = k_heap_aligned_alloc(heap_, align, bytes, K_NO_WAIT);
+
+		return (p != nullptr) ? p : upstream_->allocate(bytes, align);
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t align) override
+	{
+		if (detail::in_range(p, heap_->heap.init_mem, heap_->heap.init_bytes)) {
+			k_heap_free(heap_, p);
+		} else {
+			upstream_->deallocate(p, bytes, align);
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	struct k_heap *heap_;
+	std::pmr::memory_resource *upstream_;
+};
+
+/**
+ * @brief Memory resource allocating from a k_mem_slab
+ *
+ * Allocations that fit in a block take one from the slab without waiting.
+ * Larger or more aligned allocations, and allocations made while the slab
+ * is empty, go to the upstream resource, by default
+ * std::pmr::null_memory_resource(), which fails them.
+ *
+ * Typically used for the nodes of a std::pmr::list, std::pmr::map, etc.
+ */
+class k_mem_slab_resource : public std::pmr::memory_resource {
+public:
+	/**
+	 * @param slab Slab to allocate from
+	 * @param upstream Resource used for what @p slab cannot allocate
+	 */
+	explicit k_mem_slab_resource(struct k_mem_slab *slab,
+				     std::pmr::memory_resource *upstream =
+					     std::pmr::null_memory_resource())
+		: slab_(slab), upstream_(upstream)
+	{
+	}
+
+	/** @return The slab this resource allocates from */
+	struct k_mem_slab *slab() const
+	{
+		return slab_;
+	}
+
+protected:
+	void *do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		void *p;
+
+		if ((bytes <= slab_->info.block_size) && (align <= block_align()) &&
+		    (k_mem_slab_alloc(slab_, &p, K_NO_WAIT) == 0)) {
+			return p;
+		}
+
+		return upstream_->allocate(bytes, align);
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t align) override
+	{
+		if (detail::in_range(p, slab_->buffer,
+				     slab_->info.num_blocks * slab_->info.block_size)) {
+			k_mem_slab_free(slab_, p);
+		} else {
+			upstream_->deallocate(p, bytes, align);
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	/* Every block is aligned on the lowest set bit of its size and of the buffer */
+	std::size_t block_align() const
+	{
+		uintptr_t bits = reinterpret_cast<uintptr_t>(slab_->buffer) |
+				 slab_->info.block_size;
+
+		return bits & -bits;
+	}
+
+	struct k_mem_slab *slab_;
+	std::pmr::memory_resource *upstream_;
+};
+
+/**
+ * @brief Memory resource allocating from a sys_arena
+ *
+ * Like std::pmr::monotonic_buffer_resource, deallocation does nothing:
+ * the memory comes back when the arena is rewound or reset. When the arena
+ * is full, the upstream resource is used instead, by default
+ * std::pmr::null_memory_resource(), which fails the allocation.
+ *
+ * The arena has no lock, so neither has this resource.
+ */
+class sys_arena_resource : public std::pmr::memory_resource {
+public:
+	/**
+	 * @param arena Arena to allocate from
+	 * @param upstream Resource used when @p arena is full
+	 */
+	explicit sys_arena_resource(struct sys_arena *arena,
+				    std::pmr::memory_resource *upstream =
+					    std::pmr::null_memory_resource())
+		: arena_(arena), upstream_(upstream)
+	{
+	}
+
+	/** @return The arena this resource allocates from */
+	struct sys_arena *arena() const
+	{
+		return arena_;
+	}
+
+protected:
+	void *do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		/* The arena refuses empty allocations, the resource must not */
+		void *p = sys_arena_aligned_alloc(arena_, align, (bytes != 0) ? bytes : 1);
+
+		return (p != nullptr) ? p : upstream_->allocate(bytes, align);
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t align) override
+	{
+		if (!detail::in_range(p, arena_->base, arena_->size)) {
+			upstream_->deallocate(p, bytes, align);
+		}
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	struct sys_arena *arena_;
+	std::pmr::memory_resource *upstream_;
+};
+
+/** @} */
+
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_INCLUDE_CPP_MEMORY_RESOURCE_HPP_ */
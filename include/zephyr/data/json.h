@@ -134,6 +134,50 @@ struct json_obj_descr {
 typedef int (*json_append_bytes_t)(const char *bytes, size_t len,
 				   void *data);
 
+/**
+ * @brief Function pointer type receiving the values found by a streaming
+ * parser.
+ *
+ * Strings are given as they appear in the document, without the quotes and
+ * with escape sequences left as they are. Tokens only remain valid during
+ * the call.
+ *
+ * @param key Member name of the value, or NULL if the value is not in an
+ * object
+ * @param value Value, with type JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END,
+ * JSON_TOK_ARRAY_START, JSON_TOK_ARRAY_END, JSON_TOK_STRING,
+ * JSON_TOK_NUMBER, JSON_TOK_TRUE, JSON_TOK_FALSE or JSON_TOK_NULL. Start and
+ * end are only meaningful for the scalar types.
+ * @param depth Number of objects and arrays the value is in
+ * @param data User-provided pointer
+ *
+ * @return 0 to go on parsing, or a negative number to stop, which is then
+ * returned by json_stream_parser_feed().
+ */
+typedef int (*json_stream_cb_t)(const struct json_token *key, const struct json_token *value,
+				size_t depth, void *data);
+
+/**
+ * @brief State of a streaming parser.
+ *
+ * Members are internal, use json_stream_parser_init().
+ */
+struct json_stream_parser {
+	json_stream_cb_t cb;
+	void *data;
+	/* Holds the member name, then the scalar value being received */
+	char *buf;
+	size_t buf_size;
+	size_t key_len;
+	size_t value_len;
+	/* One bit per nesting level, set for objects */
+	uint32_t objects;
+	uint8_t depth;
+	uint8_t state;
+	bool escape;
+	bool has_key;
+};
+
 #define Z_ALIGN_SHIFT(type)	(__alignof__(type) == 1 ? 0 : \
 				 __alignof__(type) == 2 ? 1 : \
 				 __alignof__(type) == 4 ? 2 : 3)
@@ -699,6 +743,47 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Initialize a streaming parser.
+ *
+ * A streaming parser takes a JSON document in chunks of any size, so it does
+ * not have to be received whole first. It reports every value to @a cb as
+ * soon as the value is complete. Only a member name and a string or number
+ * are kept between chunks, in @a buf. Nesting is limited to 32 levels.
+ *
+ * @param parser Parser to initialize
+ * @param buf Buffer for the longest member name plus the longest string or
+ * number of the document
+ * @param buf_size Size of @a buf, in bytes
+ * @param cb Function receiving the values
+ * @param data Data pointer to be passed to @a cb
+ */
+void json_stream_parser_init(struct json_stream_parser *parser, char *buf, size_t buf_size,
+			     json_stream_cb_t cb, void *data);
+
+/**
+ * @brief Feed the next chunk of a document to a streaming parser.
+ *
+ * @param parser Parser initialized with json_stream_parser_init()
+ * @param chunk Next bytes of the document
+ * @param len Number of bytes in @a chunk
+ *
+ * @return 0 on success, -EINVAL if the document is not valid JSON, -ENOSPC
+ * if a member name and value do not fit in the buffer of the parser, or the
+ * negative value returned by the callback.
+ */
+int json_stream_parser_feed(struct json_stream_parser *parser, const char *chunk, size_t len);
+
+/**
+ * @brief Tell a streaming parser that the document is complete.
+ *
+ * @param parser Parser initialized with json_stream_parser_init()
+ *
+ * @return 0 if a whole document was received, -EINVAL if it is truncated,
+ * or the negative value returned by the callback.
+ */
+int json_stream_parser_end(struct json_stream_parser *parser);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
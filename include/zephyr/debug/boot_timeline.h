@@ -0,0 +1,99 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_BOOT_TIMELINE_H_
+#define ZEPHYR_INCLUDE_DEBUG_BOOT_TIMELINE_H_
+
+#include <stdint.h>
+#include <zephyr/init.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup boot_timeline Boot timeline recorder
+ *  @ingroup debug
+ *  @brief Module recording when each step of the boot ran
+ *
+ *  This module records the start and end time of every init entry run by
+ *  the kernel, along with the start of the kernel and of main(), to find
+ *  out where the boot time goes.
+ *  @{
+ */
+
+/** @brief Type of a boot timeline record */
+enum boot_timeline_event {
+	/** The kernel started, before the EARLY init level */
+	BOOT_TIMELINE_KERNEL_START,
+	/** An init entry ran, a device or a SYS_INIT() function */
+	BOOT_TIMELINE_INIT_ENTRY,
+	/** main() is about to be called */
+	BOOT_TIMELINE_MAIN,
+};
+
+/** @brief One step of the boot */
+struct boot_timeline_record {
+	/** Hardware cycle count when the step started */
+	uint32_t start;
+	/** Hardware cycle count when the step ended, same as start for events */
+	uint32_t end;
+	/** Init entry, NULL for the other events */
+	const struct init_entry *entry;
+	/** Result of the init entry */
+	int16_t result;
+	/** Init level of the init entry, as numbered by the kernel, EARLY being 0 */
+	uint8_t level;
+	/** Type of the record, a @ref boot_timeline_event */
+	uint8_t event;
+};
+
+/**
+ * @brief Callback for walking the boot timeline
+ *
+ * @param record Record, only valid during the call.
+ * @param user_data User data given to boot_timeline_foreach().
+ */
+typedef void (*boot_timeline_cb_t)(const struct boot_timeline_record *record, void *user_data);
+
+/**
+ * @brief Walk the recorded boot timeline, in the order the steps ended
+ *
+ * Timestamps are read with k_cycle_get_32(). The ones taken before the
+ * system timer is initialized depend on the timer driver, and may be 0.
+ *
+ * @param cb Callback called for each record.
+ * @param user_data User data passed to the callback.
+ */
+void boot_timeline_foreach(boot_timeline_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the name of the step of a record
+ *
+ * @param record Record.
+ *
+ * @return Name of the device of an init entry, or NULL for a SYS_INIT()
+ *         function and the other events.
+ */
+const char *boot_timeline_name(const struct boot_timeline_record *record);
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Called by the kernel */
+void z_boot_timeline_event(enum boot_timeline_event event);
+void z_boot_timeline_init_entry(const struct init_entry *entry, uint8_t level, uint32_t start,
+				int result);
+
+/** @endcond */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_BOOT_TIMELINE_H_ */
@@ -0,0 +1,89 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_MEM_SAMPLER_H_
+#define ZEPHYR_INCLUDE_DEBUG_MEM_SAMPLER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup mem_sampler Memory usage sampler
+ *  @ingroup debug
+ *  @brief Module recording a timeline of memory pool usage
+ *
+ *  This module periodically records the usage of every statically defined
+ *  k_heap, k_mem_slab, sys_mem_blocks and net_buf_pool into a ring buffer
+ *  in RAM, to find out which one filled up before an allocation failure.
+ *  @{
+ */
+
+/** @brief Type of a sampled memory pool */
+enum mem_sampler_type {
+	/** struct k_heap, in bytes */
+	MEM_SAMPLER_HEAP,
+	/** struct k_mem_slab, in bytes */
+	MEM_SAMPLER_MEM_SLAB,
+	/** sys_mem_blocks_t, in bytes */
+	MEM_SAMPLER_MEM_BLOCKS,
+	/** struct net_buf_pool, in buffers */
+	MEM_SAMPLER_NET_BUF_POOL,
+};
+
+/** @brief One memory pool usage sample */
+struct mem_sampler_record {
+	/** Uptime of the sample, in milliseconds */
+	uint32_t timestamp;
+	/** Sampled memory pool */
+	const void *obj;
+	/** Amount in use */
+	uint32_t used;
+	/** Total amount */
+	uint32_t total;
+	/** Type of the memory pool, an @ref mem_sampler_type */
+	uint8_t type;
+};
+
+/**
+ * @brief Callback for walking the sampled timeline
+ *
+ * @param record Sample, only valid during the call.
+ * @param user_data User data given to mem_sampler_foreach().
+ */
+typedef void (*mem_sampler_cb_t)(const struct mem_sampler_record *record, void *user_data);
+
+/**
+ * @brief Sample all memory pools now
+ *
+ * Besides periodic sampling, this can be called from an allocation
+ * failure path to record the state leading to it.
+ */
+void mem_sampler_sample(void);
+
+/**
+ * @brief Walk the recorded samples, oldest first
+ *
+ * New samples may be recorded during the walk, and older ones overwritten.
+ *
+ * @param cb Callback called for each sample.
+ * @param user_data User data passed to the callback.
+ */
+void mem_sampler_foreach(mem_sampler_cb_t cb, void *user_data);
+
+/** @brief Drop all recorded samples */
+void mem_sampler_clear(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_MEM_SAMPLER_H_ */
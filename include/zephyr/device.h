@@ -13,6 +13,7 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/sections.h>
 #include <zephyr/pm/state.h>
+#include <zephyr/sys/__assert.h>
 #include <zephyr/sys/device_mmio.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/util.h>
@@ -462,8 +463,19 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+#if defined(CONFIG_DEVICE_INIT_PARALLEL) || defined(__DOXYGEN__)
+	/** Progress of the initialization when it is run in parallel, internal */
+	uint8_t init_stage;
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+#if defined(CONFIG_DEVICE_INIT_LAZY) || defined(__DOXYGEN__)
+	/** Thread running the lazy initialization of the device, if any, internal */
+	struct k_thread *init_thread;
+#endif /* CONFIG_DEVICE_INIT_LAZY */
 };
 
+struct k_thread;
 struct pm_device_base;
 struct pm_device;
 struct pm_device_isr;
@@ -488,6 +500,9 @@ typedef uint8_t device_flags_t;
 /** Device initialization is deferred */
 #define DEVICE_FLAG_INIT_DEFERRED BIT(0)
 
+/** Device initialization is deferred until the device is first checked for readiness */
+#define DEVICE_FLAG_INIT_LAZY BIT(1)
+
 /** @} */
 
 /** Device operations */
@@ -851,6 +866,10 @@ size_t z_device_get_all_static(const struct device **devices);
  * does not include the readiness checks of device_get_binding(). At minimum
  * this means that the device has been successfully initialized.
  *
+ * With @kconfig{CONFIG_DEVICE_INIT_LAZY}, a device marked as
+ * ``zephyr,lazy-init`` on devicetree is initialized by the first call, along
+ * with the lazy devices it depends on, unless called from an interrupt.
+ *
  * @param dev pointer to the device in question.
  *
  * @retval true If the device is ready for use.
@@ -920,7 +939,18 @@ __syscall int device_deinit(const struct device *dev);
  * @param node_id Devicetree node identifier.
  */
 #define Z_DEVICE_DT_FLAGS(node_id)                                             \
-	(DT_PROP_OR(node_id, zephyr_deferred_init, 0U) * DEVICE_FLAG_INIT_DEFERRED)
+	((DT_PROP_OR(node_id, zephyr_deferred_init, 0U) ||                     \
+	  Z_DEVICE_DT_LAZY(node_id)) * DEVICE_FLAG_INIT_DEFERRED |               \
+	 Z_DEVICE_DT_LAZY(node_id) * DEVICE_FLAG_INIT_LAZY)
+
+/**
+ * @brief Whether a device is initialized lazily, 1 or 0.
+ *
+ * @param node_id Devicetree node identifier.
+ */
+#define Z_DEVICE_DT_LAZY(node_id)                                              \
+	(IS_ENABLED(CONFIG_DEVICE_INIT_LAZY) &&                                \
+	 DT_PROP_OR(node_id, zephyr_lazy_init, 0U))
 
 #if defined(CONFIG_DEVICE_DEPS) || defined(__DOXYGEN__)
 
@@ -1271,6 +1301,8 @@ device_get_dt_nodelabels(const struct device *dev)
 			data, config, level, prio, api, state, ...)             \
 	Z_DEVICE_NAME_CHECK(name);                                              \
                                                                                 \
+	Z_DEVICE_API_STATIC_CHECK(node_id, api)                                 \
+                                                                                \
 	IF_ENABLED(CONFIG_DEVICE_DEPS,                                          \
 		   (Z_DEVICE_DEPS_DEFINE(node_id, dev_id, __VA_ARGS__);))       \
                                                                                 \
@@ -1307,6 +1339,39 @@ DT_FOREACH_STATUS_OKAY_NODE(Z_MAYBE_DEVICE_DECLARE_INTERNAL)
 /** @brief Expands to the full type. */
 #define Z_DEVICE_API_TYPE(_class) _CONCAT(_class, _driver_api)
 
+#if defined(CONFIG_DEVICE_API_STATIC_DISPATCH) && !defined(__cplusplus)
+/**
+ * @brief Check that a device implementing a device API class dispatched at
+ * compile time has the compatible found in devicetree for that class.
+ */
+#define Z_DEVICE_API_STATIC_CHECK_CLASS(_class, node_id, api)                                      \
+	BUILD_ASSERT(!_Generic((api), const struct Z_DEVICE_API_TYPE(_class) *: 1, default: 0) ||  \
+		     !DT_API_HAS_SINGLE_IMPL(_class) ||                                            \
+		     DT_NODE_HAS_COMPAT(node_id, DT_API_SINGLE_IMPL_COMPAT(_class)),               \
+		     "Device implements the " STRINGIFY(_class) " API but is not a node of its "  \
+		     "compatible in devicetree, disable CONFIG_DEVICE_API_STATIC_DISPATCH");
+
+/* Classes listed in STATIC_API_CLASSES of scripts/dts/gen_defines.py */
+#define Z_DEVICE_API_STATIC_CHECK(node_id, api)                                                    \
+	Z_DEVICE_API_STATIC_CHECK_CLASS(gpio, node_id, api)                                        \
+	Z_DEVICE_API_STATIC_CHECK_CLASS(i2c, node_id, api)                                         \
+	Z_DEVICE_API_STATIC_CHECK_CLASS(spi, node_id, api)
+#else
+#define Z_DEVICE_API_STATIC_CHECK(node_id, api)
+#endif
+
+/** @brief API of the first device implementing a device API class */
+#define Z_DEVICE_API_SINGLE(_class)                                                                \
+	((const struct Z_DEVICE_API_TYPE(_class) *)DEVICE_DT_GET(DT_API_SINGLE_IMPL(_class))->api)
+
+/** @brief API of a device of a class implemented by a single compatible */
+#define Z_DEVICE_API_STATIC_GET(_class, _dev)                                                      \
+	({                                                                                         \
+		__ASSERT((_dev)->api == (const void *)Z_DEVICE_API_SINGLE(_class),                 \
+			 "%s does not share the " STRINGIFY(_class) " API", (_dev)->name);         \
+		Z_DEVICE_API_SINGLE(_class);                                                       \
+	})
+
 /** @endcond */
 
 /**
@@ -1320,12 +1385,23 @@ DT_FOREACH_STATUS_OKAY_NODE(Z_MAYBE_DEVICE_DECLARE_INTERNAL)
 /**
  * @brief Expands to the pointer of a device's API for a given class.
  *
+ * With @kconfig{CONFIG_DEVICE_API_STATIC_DISPATCH}, if the devicetree shows
+ * a single compatible implementing @p _class, this is the API of the first
+ * device of that compatible, which lets the compiler resolve the calls made
+ * through it.
+ *
  * @param _class The device API class.
  * @param _dev The device instance pointer.
  *
  * @return the pointer to the device API.
  */
+#ifdef CONFIG_DEVICE_API_STATIC_DISPATCH
+#define DEVICE_API_GET(_class, _dev)                                                               \
+	COND_CODE_1(DT_API_HAS_SINGLE_IMPL(_class), (Z_DEVICE_API_STATIC_GET(_class, _dev)),     \
+		    (((const struct Z_DEVICE_API_TYPE(_class) *)_dev->api)))
+#else
 #define DEVICE_API_GET(_class, _dev) ((const struct Z_DEVICE_API_TYPE(_class) *)_dev->api)
+#endif
 
 /**
  * @brief Macro that evaluates to a boolean that can be used to check if
@@ -1341,8 +1417,8 @@ DT_FOREACH_STATUS_OKAY_NODE(Z_MAYBE_DEVICE_DECLARE_INTERNAL)
 	({                                                                                         \
 		STRUCT_SECTION_START_EXTERN(Z_DEVICE_API_TYPE(_class));                            \
 		STRUCT_SECTION_END_EXTERN(Z_DEVICE_API_TYPE(_class));                              \
-		(DEVICE_API_GET(_class, _dev) < STRUCT_SECTION_END(Z_DEVICE_API_TYPE(_class)) &&   \
-		 DEVICE_API_GET(_class, _dev) >= STRUCT_SECTION_START(Z_DEVICE_API_TYPE(_class))); \
+		(_dev->api < (const void *)STRUCT_SECTION_END(Z_DEVICE_API_TYPE(_class)) &&        \
+		 _dev->api >= (const void *)STRUCT_SECTION_START(Z_DEVICE_API_TYPE(_class)));      \
 	})
 
 #ifdef __cplusplus
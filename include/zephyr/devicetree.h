@@ -3721,6 +3721,41 @@
 	UTIL_AND(DT_HAS_COMPAT_STATUS_OKAY(compat),		\
 		 UTIL_CAT(DT_N_INST, DT_DASH(compat, NUM_OKAY)))
 
+/**
+ * @brief Is a device API class implemented by a single compatible?
+ *
+ * The devicetree scripts recognize the nodes implementing some device
+ * API classes: `gpio` (nodes with a `gpio-controller` property), `i2c`
+ * and `spi` (bus controller nodes). This returns 1 if all status `okay`
+ * nodes implementing @p api share the same compatible.
+ *
+ * @param api device API class, e.g. `gpio`
+ * @return 1 if a single compatible implements @p api, 0 otherwise
+ */
+#define DT_API_HAS_SINGLE_IMPL(api) \
+	IS_ENABLED(DT_CAT(DT_API_HAS_SINGLE_, api))
+
+/**
+ * @brief Get a node implementing a device API class
+ *
+ * It is an error to use this unless DT_API_HAS_SINGLE_IMPL(api) is 1.
+ *
+ * @param api device API class, e.g. `gpio`
+ * @return node identifier of the first status `okay` node implementing
+ *         @p api
+ */
+#define DT_API_SINGLE_IMPL(api) DT_CAT(DT_API_SINGLE_, api)
+
+/**
+ * @brief Get the compatible implementing a device API class
+ *
+ * It is an error to use this unless DT_API_HAS_SINGLE_IMPL(api) is 1.
+ *
+ * @param api device API class, e.g. `gpio`
+ * @return lowercase-and-underscores compatible implementing @p api
+ */
+#define DT_API_SINGLE_IMPL_COMPAT(api) DT_CAT3(DT_API_SINGLE_, api, _COMPAT)
+
 /**
  * @brief Does a devicetree node match a compatible?
  *
@@ -17,6 +17,14 @@
 
 #include <zephyr/storage/stream_flash.h>
 
+#ifdef CONFIG_IMG_STREAM_HASH
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+#include <psa/crypto.h>
+#else
+#include <mbedtls/sha256.h>
+#endif
+#endif
+
 /**
  * @brief Abstraction layer to write firmware images to flash
  *
@@ -33,6 +41,14 @@ struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
+#ifdef CONFIG_IMG_STREAM_HASH
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+	psa_hash_operation_t hash;
+#else
+	mbedtls_sha256_context hash;
+#endif
+	bool hash_ok;
+#endif
 };
 
 /**
@@ -111,6 +127,129 @@ int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
 		    uint8_t area_id);
 
+/**
+ * @brief Get the SHA-256 hash of the data written to the image.
+ *
+ * The hash covers all the data passed to flash_img_buffered_write() since
+ * the context was initialized, and is computed as the data is written, so
+ * getting it does not read the flash. This ends the hashing.
+ *
+ * The function is enabled via CONFIG_IMG_STREAM_HASH Kconfig option.
+ *
+ * @param[in] ctx context.
+ * @param[out] hash buffer of 32 bytes for the hash.
+ *
+ * @return  0 on success, -ENODATA if the hash is not available, e.g. because
+ * a write failed or the hash was already taken.
+ */
+int flash_img_hash_finish(struct flash_img_context *ctx, uint8_t *hash);
+
+/** Magic of a binary patch, the first word of its header */
+#define FLASH_IMG_DELTA_MAGIC 0x544c445aU
+
+/** Patch operation: copy bytes of the source image */
+#define FLASH_IMG_DELTA_OP_COPY 1
+/** Patch operation: add the bytes that follow to bytes of the source image */
+#define FLASH_IMG_DELTA_OP_ADD 2
+/** Patch operation: insert the bytes that follow */
+#define FLASH_IMG_DELTA_OP_INSERT 3
+
+/**
+ * @brief Header of a binary patch
+ *
+ * A patch starts with this header, all fields little endian, and follows
+ * with operations that produce the target image in order. Each operation
+ * is a byte with the FLASH_IMG_DELTA_OP_* code, the little endian 32-bit
+ * length of the data it produces and the little endian 32-bit offset in
+ * the source image it reads from, unused by FLASH_IMG_DELTA_OP_INSERT.
+ * FLASH_IMG_DELTA_OP_ADD and FLASH_IMG_DELTA_OP_INSERT are followed by
+ * their length in bytes of data. This is the bsdiff model, whose
+ * generators can be converted to this format.
+ */
+struct flash_img_delta_header {
+	uint32_t magic;		/** FLASH_IMG_DELTA_MAGIC */
+	uint32_t source_size;	/** Size of the source image */
+	uint32_t source_crc;	/** CRC-32 (IEEE) of the source image */
+	uint32_t target_size;	/** Size of the image the patch produces */
+	uint32_t target_crc;	/** CRC-32 (IEEE) of the image the patch produces */
+};
+
+/** Size of the operation header in a binary patch */
+#define FLASH_IMG_DELTA_OP_SIZE 9
+
+#if defined(CONFIG_IMG_DELTA) || defined(__DOXYGEN__)
+/**
+ * @brief Context applying a binary patch
+ */
+struct flash_img_delta {
+	struct flash_img_context *img;
+	const struct flash_area *source;
+	struct flash_img_delta_header hdr;
+	uint8_t in[sizeof(struct flash_img_delta_header)];
+	size_t in_len;
+	bool started;
+	uint8_t op;
+	uint32_t op_len;
+	uint32_t op_off;
+	uint32_t written;
+	uint32_t crc;
+	uint8_t buf[CONFIG_IMG_DELTA_BUF_SIZE];
+};
+#endif
+
+/**
+ * @brief Parse the header of a binary patch.
+ *
+ * @param[in] data start of the patch.
+ * @param[in] len number of bytes available at @p data.
+ * @param[out] hdr parsed header.
+ *
+ * @return  0 on success, -EINVAL if @p data does not start with a patch
+ * header.
+ */
+int flash_img_delta_parse_header(const uint8_t *data, size_t len,
+				 struct flash_img_delta_header *hdr);
+
+/**
+ * @brief Initialize context needed for applying a binary patch.
+ *
+ * The image produced is written through @p img, which must have been
+ * initialized and is used for nothing else until the patch is applied.
+ *
+ * The function is enabled via CONFIG_IMG_DELTA Kconfig option.
+ *
+ * @param delta context to be initialized.
+ * @param img context of the image to write.
+ * @param source_area_id flash area id of partition holding the image the
+ * patch applies to.
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_delta_init(struct flash_img_delta *delta, struct flash_img_context *img,
+			 uint8_t source_area_id);
+
+/**
+ * @brief Apply the next part of a binary patch.
+ *
+ * The patch can be split at any point between calls. The source image is
+ * checked against the patch header before anything is written, and the
+ * final call, with flush set to true, flushes the image and checks that
+ * it is complete and matches the CRC of the patch header.
+ *
+ * The function is enabled via CONFIG_IMG_DELTA Kconfig option.
+ *
+ * @param delta context.
+ * @param data patch data.
+ * @param len number of bytes of patch data.
+ * @param flush when true this is the end of the patch.
+ *
+ * @return  0 on success, -EINVAL if the patch is malformed, -ESPIPE if it
+ * does not apply to the source image, -EILSEQ if the image produced does
+ * not match, other negative errno code on read or write failure.
+ */
+int flash_img_delta_write(struct flash_img_delta *delta, const uint8_t *data,
+			  size_t len, bool flush);
+
 /**
  * @brief Get the flash area id for the image upload slot.
  *
@@ -97,6 +97,14 @@ struct disk_info {
 	const struct device *dev;
 	/** Internally used disk reference count */
 	uint16_t refcnt;
+#if defined(CONFIG_DISK_CACHE) || defined(__DOXYGEN__)
+	/** Internally used block cache state */
+	struct {
+		uint32_t sector_count;
+		uint32_t next_sector;
+		uint8_t state;
+	} cache;
+#endif
 };
 
 /**
@@ -26,6 +26,7 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <zephyr/device.h>
+#include <zephyr/rtio/rtio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -202,6 +203,15 @@ typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 typedef int (*flash_api_ex_op)(const struct device *dev, uint16_t code,
 			       const uintptr_t in, void *out);
 
+/**
+ * @brief Flash RTIO submission implementation handler type
+ *
+ * Starts the operation of @p iodev_sqe, and completes it, with
+ * rtio_iodev_sqe_ok() or rtio_iodev_sqe_err(), once the flash is done.
+ */
+typedef void (*flash_api_iodev_submit)(const struct device *dev,
+				       struct rtio_iodev_sqe *iodev_sqe);
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -218,6 +228,9 @@ __subsystem struct flash_driver_api {
 #if defined(CONFIG_FLASH_EX_OP_ENABLED)
 	flash_api_ex_op ex_op;
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
+#if defined(CONFIG_FLASH_RTIO)
+	flash_api_iodev_submit iodev_submit;
+#endif /* CONFIG_FLASH_RTIO */
 };
 
 /**
@@ -702,6 +715,123 @@ static inline int z_impl_flash_ex_op(const struct device *dev, uint16_t code,
 #endif /* CONFIG_FLASH_EX_OP_ENABLED */
 }
 
+#if defined(CONFIG_FLASH_RTIO) || defined(__DOXYGEN__)
+
+/**
+ * @brief Fallback submit implementation
+ *
+ * This implementation runs the blocking flash_read(), flash_write() and
+ * flash_erase() calls on the RTIO work queue. It is used if the flash driver
+ * did not implement the iodev_submit function.
+ *
+ * @param dev Flash device.
+ * @param iodev_sqe Prepared submissions queue entry connected to an iodev
+ *                  defined by FLASH_DT_IODEV_DEFINE.
+ */
+void flash_iodev_submit_fallback(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Submit request(s) to a flash device with RTIO
+ *
+ * @param iodev_sqe Prepared submissions queue entry connected to an iodev
+ *                  defined by FLASH_DT_IODEV_DEFINE.
+ */
+static inline void flash_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct device *dev = (const struct device *)iodev_sqe->sqe.iodev->data;
+	const struct flash_driver_api *api = (const struct flash_driver_api *)dev->api;
+
+	if (api->iodev_submit == NULL) {
+		flash_iodev_submit_fallback(dev, iodev_sqe);
+		return;
+	}
+	api->iodev_submit(dev, iodev_sqe);
+}
+
+extern const struct rtio_iodev_api flash_iodev_api;
+
+/**
+ * @brief Define an iodev for a given flash device
+ *
+ * Submissions to the iodev which are not chained may run concurrently, chain
+ * them when they have to run in order, e.g. an erase and the writes after it.
+ *
+ * @param name Symbolic name of the iodev to define
+ * @param node_id Devicetree node identifier of the flash device
+ */
+#define FLASH_DT_IODEV_DEFINE(name, node_id)					\
+	RTIO_IODEV_DEFINE(name, &flash_iodev_api, (void *)DEVICE_DT_GET(node_id))
+
+/**
+ * @brief Prepare a flash read submission
+ *
+ * @param sqe Submission to prepare
+ * @param iodev Flash iodev defined with FLASH_DT_IODEV_DEFINE
+ * @param offset Offset in flash to read from
+ * @param buf Buffer to read into
+ * @param len Number of bytes to read
+ * @param userdata Data returned in the completion
+ */
+static inline void flash_rtio_prep_read(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+					off_t offset, void *buf, uint32_t len, void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_READ;
+	sqe->prio = RTIO_PRIO_NORM;
+	sqe->iodev = iodev;
+	sqe->flash.offset = offset;
+	sqe->flash.buf = buf;
+	sqe->flash.len = len;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a flash write submission
+ *
+ * @param sqe Submission to prepare
+ * @param iodev Flash iodev defined with FLASH_DT_IODEV_DEFINE
+ * @param offset Offset in flash to write to
+ * @param buf Buffer to write from, which has to stay valid until completion
+ * @param len Number of bytes to write
+ * @param userdata Data returned in the completion
+ */
+static inline void flash_rtio_prep_write(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+					 off_t offset, const void *buf, uint32_t len,
+					 void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_WRITE;
+	sqe->prio = RTIO_PRIO_NORM;
+	sqe->iodev = iodev;
+	sqe->flash.offset = offset;
+	sqe->flash.buf = (uint8_t *)buf;
+	sqe->flash.len = len;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a flash erase submission
+ *
+ * @param sqe Submission to prepare
+ * @param iodev Flash iodev defined with FLASH_DT_IODEV_DEFINE
+ * @param offset Offset in flash of the area to erase
+ * @param size Size of the area to erase
+ * @param userdata Data returned in the completion
+ */
+static inline void flash_rtio_prep_erase(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+					 off_t offset, uint32_t size, void *userdata)
+{
+	memset(sqe, 0, sizeof(struct rtio_sqe));
+	sqe->op = RTIO_OP_FLASH_ERASE;
+	sqe->prio = RTIO_PRIO_NORM;
+	sqe->iodev = iodev;
+	sqe->flash.offset = offset;
+	sqe->flash.len = size;
+	sqe->userdata = userdata;
+}
+
+#endif /* CONFIG_FLASH_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
@@ -717,8 +717,7 @@ __syscall int i2c_configure(const struct device *dev, uint32_t dev_config);
 static inline int z_impl_i2c_configure(const struct device *dev,
 				       uint32_t dev_config)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	return api->configure(dev, dev_config);
 }
@@ -766,7 +765,7 @@ __syscall int i2c_get_config(const struct device *dev, uint32_t *dev_config);
 
 static inline int z_impl_i2c_get_config(const struct device *dev, uint32_t *dev_config)
 {
-	const struct i2c_driver_api *api = (const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->get_config == NULL) {
 		return -ENOSYS;
@@ -814,8 +813,7 @@ static inline int z_impl_i2c_transfer(const struct device *dev,
 				      struct i2c_msg *msgs, uint8_t num_msgs,
 				      uint16_t addr)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (!num_msgs) {
 		return 0;
@@ -867,8 +865,7 @@ static inline int i2c_transfer_cb(const struct device *dev,
 				  i2c_callback_t cb,
 				  void *userdata)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->transfer_cb == NULL) {
 		return -ENOSYS;
@@ -1016,7 +1013,7 @@ static inline int i2c_transfer_signal(const struct device *dev,
 				 uint16_t addr,
 				 struct k_poll_signal *sig)
 {
-	const struct i2c_driver_api *api = (const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->transfer_cb == NULL) {
 		return -ENOSYS;
@@ -1054,7 +1051,7 @@ static inline void i2c_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 {
 	const struct i2c_dt_spec *dt_spec = (const struct i2c_dt_spec *)iodev_sqe->sqe.iodev->data;
 	const struct device *dev = dt_spec->bus;
-	const struct i2c_driver_api *api = (const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->iodev_submit == NULL) {
 		rtio_iodev_sqe_err(iodev_sqe, -ENOSYS);
@@ -1193,8 +1190,7 @@ __syscall int i2c_recover_bus(const struct device *dev);
 
 static inline int z_impl_i2c_recover_bus(const struct device *dev)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->recover_bus == NULL) {
 		return -ENOSYS;
@@ -1230,8 +1226,7 @@ static inline int z_impl_i2c_recover_bus(const struct device *dev)
 static inline int i2c_target_register(const struct device *dev,
 				     struct i2c_target_config *cfg)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->target_register == NULL) {
 		return -ENOSYS;
@@ -1259,8 +1254,7 @@ static inline int i2c_target_register(const struct device *dev,
 static inline int i2c_target_unregister(const struct device *dev,
 				       struct i2c_target_config *cfg)
 {
-	const struct i2c_driver_api *api =
-		(const struct i2c_driver_api *)dev->api;
+	const struct i2c_driver_api *api = DEVICE_API_GET(i2c, dev);
 
 	if (api->target_unregister == NULL) {
 		return -ENOSYS;
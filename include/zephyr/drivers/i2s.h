@@ -313,6 +313,22 @@ struct i2s_config {
 	int32_t timeout;
 };
 
+/**
+ * @typedef i2s_callback_t
+ * @brief Callback handing back a finished memory block.
+ *
+ * Called from the interrupt of the interface for every RX block filled
+ * and every TX block sent, see i2s_callback_set().
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param dir Stream direction of the block, I2S_DIR_RX or I2S_DIR_TX.
+ * @param mem_block The memory block, now owned by the callback.
+ * @param size Number of bytes received, or the size of the TX block.
+ * @param user_data User data given to i2s_callback_set().
+ */
+typedef void (*i2s_callback_t)(const struct device *dev, enum i2s_dir dir,
+			       void *mem_block, size_t size, void *user_data);
+
 /**
  * @cond INTERNAL_HIDDEN
  *
@@ -327,6 +343,8 @@ __subsystem struct i2s_driver_api {
 	int (*write)(const struct device *dev, void *mem_block, size_t size);
 	int (*trigger)(const struct device *dev, enum i2s_dir dir,
 		       enum i2s_trigger_cmd cmd);
+	int (*callback_set)(const struct device *dev, i2s_callback_t cb,
+			    void *user_data);
 };
 /**
  * @endcond
@@ -536,6 +554,44 @@ static inline int z_impl_i2s_trigger(const struct device *dev,
 	return api->trigger(dev, dir, cmd);
 }
 
+/**
+ * @brief Set the callback handing back finished memory blocks.
+ *
+ * With a callback set, blocks are handed to it from the interrupt as soon
+ * as the interface is done with them, with no queueing and no call per
+ * block needed:
+ *
+ * - Filled RX blocks are passed to the callback instead of being queued
+ *   for i2s_read(). The callback must free them to the RX memory slab or
+ *   pass them on, for example to i2s_write() once processed in place.
+ * - Sent TX blocks are passed to the callback instead of being freed to
+ *   the TX memory slab, so TX blocks do not have to come from that slab.
+ *   Blocks dropped from the TX queue are passed to it as well.
+ *
+ * i2s_write() may be called from the callback, it does not wait then.
+ * The callback can only be changed while the interface is not running.
+ *
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param cb The callback, or NULL to go back to queueing and freeing.
+ * @param user_data User data for the callback.
+ *
+ * @retval 0 If successful.
+ * @retval -EBUSY The interface is running.
+ * @retval -ENOSYS The driver does not support callbacks.
+ */
+static inline int i2s_callback_set(const struct device *dev, i2s_callback_t cb,
+				   void *user_data)
+{
+	const struct i2s_driver_api *api =
+		(const struct i2s_driver_api *)dev->api;
+
+	if (api->callback_set == NULL) {
+		return -ENOSYS;
+	}
+
+	return api->callback_set(dev, cb, user_data);
+}
+
 /**
  * @}
  */
@@ -0,0 +1,176 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_SENSOR_BATCH_H_
+#define ZEPHYR_DRIVERS_SENSOR_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/dsp/types.h>
+
+#ifdef CONFIG_SENSOR_BATCH_FILTER
+#include <arm_math.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Batch decoding and filtering of sensor data
+ *
+ * Instead of iterating over the frames of a buffer one at a time, the whole
+ * buffer of a channel, typically a drained hardware FIFO, is decoded into one
+ * q31 array per axis sharing a single shift. The arrays can then go through a
+ * chain of CMSIS-DSP filters, so that the application processes a batch of
+ * samples at a time.
+ */
+
+/** Largest number of axes of a batch */
+#define SENSOR_BATCH_MAX_AXES 3
+
+/** Decoded samples of a channel */
+struct sensor_batch {
+	/** Samples of each axis, @ref capacity entries each, set by the caller */
+	q31_t *values[SENSOR_BATCH_MAX_AXES];
+	/** Time of each sample relative to @ref base_timestamp_ns, or NULL if not needed */
+	uint32_t *timestamp_deltas;
+	/** Number of entries of the arrays */
+	uint16_t capacity;
+	/** Time of the first sample */
+	uint64_t base_timestamp_ns;
+	/** Number of samples */
+	uint16_t count;
+	/** Number of axes, 3 for the XYZ channels and 1 for the q31 ones */
+	uint8_t num_axes;
+	/** Shift of all the samples */
+	int8_t shift;
+};
+
+/**
+ * @brief Decode all the frames of a channel
+ *
+ * Only the channels decoded to @ref sensor_three_axis_data or @ref sensor_q31_data
+ * are supported. Samples decoded with a shift different from the one of the
+ * first frame are converted to it, saturating if needed.
+ *
+ * @param decoder Decoder of the sensor
+ * @param buf Buffer read from the sensor
+ * @param chan_spec Channel to decode
+ * @param batch Batch to fill, its arrays must be set
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if the channel is not decoded to q31 values
+ * @retval -ENOSPC if the buffer holds more frames than @p batch can
+ * @retval -EINVAL if an array needed for the channel is missing
+ */
+int sensor_batch_decode(const struct sensor_decoder_api *decoder, const uint8_t *buf,
+			struct sensor_chan_spec chan_spec, struct sensor_batch *batch);
+
+#if defined(CONFIG_SENSOR_BATCH_FILTER) || defined(__DOXYGEN__)
+
+/** Type of a batch filter */
+enum sensor_batch_filter_type {
+	/** Cascade of biquads, direct form I */
+	SENSOR_BATCH_FILTER_BIQUAD,
+	/** FIR filter */
+	SENSOR_BATCH_FILTER_FIR,
+	/** FIR filter followed by decimation */
+	SENSOR_BATCH_FILTER_DECIMATE,
+};
+
+/** Filter applied to each axis of a batch, with a state per axis */
+struct sensor_batch_filter {
+	enum sensor_batch_filter_type type;
+	uint8_t num_axes;
+	union {
+		arm_biquad_casd_df1_inst_q31 biquad;
+		arm_fir_instance_q31 fir;
+		arm_fir_decimate_instance_q31 decimate;
+	} inst[SENSOR_BATCH_MAX_AXES];
+};
+
+/**
+ * @brief Initialize a biquad cascade filter
+ *
+ * @param filter Filter to initialize
+ * @param num_axes Number of axes of the filtered batches
+ * @param num_stages Number of biquad stages
+ * @param coeffs 5 coefficients per stage, in CMSIS-DSP order
+ * @param post_shift Shift of the coefficients, as for CMSIS-DSP
+ * @param state 4 entries per stage and axis
+ *
+ * @retval 0 on success
+ * @retval -EINVAL on invalid parameters
+ */
+int sensor_batch_filter_init_biquad(struct sensor_batch_filter *filter, uint8_t num_axes,
+				    uint8_t num_stages, const q31_t *coeffs, int8_t post_shift,
+				    q31_t *state);
+
+/**
+ * @brief Initialize a FIR filter
+ *
+ * @param filter Filter to initialize
+ * @param num_axes Number of axes of the filtered batches
+ * @param num_taps Number of coefficients
+ * @param coeffs Coefficients, in time reversed order as for CMSIS-DSP
+ * @param max_count Largest number of samples of the filtered batches
+ * @param state num_taps + max_count - 1 entries per axis
+ *
+ * @retval 0 on success
+ * @retval -EINVAL on invalid parameters
+ */
+int sensor_batch_filter_init_fir(struct sensor_batch_filter *filter, uint8_t num_axes,
+				 uint16_t num_taps, const q31_t *coeffs, uint16_t max_count,
+				 q31_t *state);
+
+/**
+ * @brief Initialize a decimating FIR filter
+ *
+ * Filtered batches must hold a multiple of @p factor samples, only one sample
+ * out of @p factor is kept.
+ *
+ * @param filter Filter to initialize
+ * @param num_axes Number of axes of the filtered batches
+ * @param num_taps Number of coefficients of the anti-aliasing filter
+ * @param factor Decimation factor
+ * @param coeffs Coefficients, in time reversed order as for CMSIS-DSP
+ * @param max_count Largest number of samples of the filtered batches, a multiple of @p factor
+ * @param state num_taps + max_count - 1 entries per axis
+ *
+ * @retval 0 on success
+ * @retval -EINVAL on invalid parameters
+ */
+int sensor_batch_filter_init_decimate(struct sensor_batch_filter *filter, uint8_t num_axes,
+				      uint16_t num_taps, uint8_t factor, const q31_t *coeffs,
+				      uint16_t max_count, q31_t *state);
+
+/**
+ * @brief Run a batch through a chain of filters, in place
+ *
+ * The filters keep their state from one batch to the next, so consecutive
+ * batches of a stream are filtered as one signal. Decimation reduces the
+ * number of samples and keeps the timestamp of the last sample of each group.
+ *
+ * @param filters Filters applied in order
+ * @param num_filters Number of filters
+ * @param batch Batch to filter
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the batch does not match a filter
+ */
+int sensor_batch_filter(struct sensor_batch_filter *filters, size_t num_filters,
+			struct sensor_batch *batch);
+
+#endif /* CONFIG_SENSOR_BATCH_FILTER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SENSOR_BATCH_H_ */
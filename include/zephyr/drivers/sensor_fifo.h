@@ -0,0 +1,131 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_DRIVERS_SENSOR_FIFO_H_
+#define ZEPHYR_DRIVERS_SENSOR_FIFO_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Generic FIFO streaming for sensor drivers
+ *
+ * A driver with a hardware FIFO hands its streaming submission to the helper
+ * and reports its FIFO interrupts to it. On each watermark or full interrupt
+ * the helper reads the FIFO level, takes a buffer from the multishot
+ * submission and drains the FIFO into it with a single bus burst, all through
+ * the RTIO context of the driver. The buffer starts with a driver header, so
+ * the samples are only decoded when the application asks the decoder for them.
+ */
+
+/** Driver specific operations of a FIFO stream */
+struct sensor_fifo_stream_api {
+	/**
+	 * @brief Queue the bus reads of @p len bytes from register @p reg
+	 *
+	 * The last queued submission must have the RTIO_SQE_CHAINED flag set,
+	 * the helper chains its own callback after it.
+	 */
+	int (*prep_read)(const struct device *dev, struct rtio *r, uint8_t reg,
+			 uint8_t *buf, uint32_t len);
+
+	/** @brief Get the number of bytes in the FIFO out of the level registers */
+	uint32_t (*fifo_bytes)(const struct device *dev, const uint8_t *level);
+
+	/**
+	 * @brief Write the decoder header at the start of a buffer
+	 *
+	 * @param fifo_bytes Number of FIFO bytes following the header
+	 */
+	void (*fill_header)(const struct device *dev, uint8_t *buf, uint64_t timestamp,
+			    uint32_t fifo_bytes);
+
+	/** @brief Discard the content of the FIFO (optional) */
+	void (*flush)(const struct device *dev);
+
+	/** @brief Re-enable the FIFO interrupt */
+	void (*int_enable)(const struct device *dev);
+};
+
+/** Constant description of a FIFO stream */
+struct sensor_fifo_stream_config {
+	/** Driver operations */
+	const struct sensor_fifo_stream_api *api;
+	/** First FIFO level register */
+	uint8_t level_reg;
+	/** Number of FIFO level registers, at most 4 */
+	uint8_t level_len;
+	/** FIFO data register */
+	uint8_t data_reg;
+	/** Size of a FIFO frame, only whole frames are read */
+	uint16_t frame_size;
+	/** Size of the header written by fill_header */
+	uint16_t header_size;
+};
+
+/** State of a FIFO stream, part of the driver data */
+struct sensor_fifo_stream {
+	const struct device *dev;
+	const struct sensor_fifo_stream_config *cfg;
+	/** RTIO context of the driver bus */
+	struct rtio *r;
+	/** Pending streaming submission */
+	struct rtio_iodev_sqe *iodev_sqe;
+	/** Time of the last FIFO interrupt */
+	uint64_t timestamp;
+	/** FIFO bytes being read */
+	uint32_t read_len;
+	uint8_t level[4];
+};
+
+/**
+ * @brief Find a trigger in a streaming read configuration
+ *
+ * @return The trigger or NULL if @p cfg does not stream it
+ */
+struct sensor_stream_trigger *sensor_read_config_trigger(const struct sensor_read_config *cfg,
+							 enum sensor_trigger_type trig);
+
+/**
+ * @brief Initialize a FIFO stream
+ */
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r);
+
+/**
+ * @brief Hand a streaming submission to a FIFO stream
+ *
+ * To be called from the driver submit call once the sensor is set up for the
+ * triggers of the submission. The submission is completed on the next FIFO
+ * interrupt and then submitted again by RTIO as it is a multishot one.
+ */
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Report a FIFO interrupt
+ *
+ * To be called by the driver with the FIFO interrupt disabled, it is enabled
+ * again through the int_enable operation once the FIFO has been handled.
+ *
+ * @param watermark The watermark interrupt fired
+ * @param full The FIFO full interrupt fired
+ */
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream, bool watermark, bool full);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SENSOR_FIFO_H_ */
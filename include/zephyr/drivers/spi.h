@@ -910,8 +910,7 @@ static inline int z_impl_spi_transceive(const struct device *dev,
 					const struct spi_buf_set *tx_bufs,
 					const struct spi_buf_set *rx_bufs)
 {
-	const struct spi_driver_api *api =
-		(const struct spi_driver_api *)dev->api;
+	const struct spi_driver_api *api = DEVICE_API_GET(spi, dev);
 	int ret;
 
 	ret = api->transceive(dev, config, tx_bufs, rx_bufs);
@@ -1084,8 +1083,7 @@ static inline int spi_transceive_cb(const struct device *dev,
 				    spi_callback_t callback,
 				    void *userdata)
 {
-	const struct spi_driver_api *api =
-		(const struct spi_driver_api *)dev->api;
+	const struct spi_driver_api *api = DEVICE_API_GET(spi, dev);
 
 	return api->transceive_async(dev, config, tx_bufs, rx_bufs, callback, userdata);
 }
@@ -1133,8 +1131,7 @@ static inline int spi_transceive_signal(const struct device *dev,
 				       const struct spi_buf_set *rx_bufs,
 				       struct k_poll_signal *sig)
 {
-	const struct spi_driver_api *api =
-		(const struct spi_driver_api *)dev->api;
+	const struct spi_driver_api *api = DEVICE_API_GET(spi, dev);
 	spi_callback_t cb = (sig == NULL) ? NULL : z_spi_transfer_signal_cb;
 
 	return api->transceive_async(dev, config, tx_bufs, rx_bufs, cb, sig);
@@ -1235,7 +1232,7 @@ static inline void spi_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 {
 	const struct spi_dt_spec *dt_spec = (const struct spi_dt_spec *)iodev_sqe->sqe.iodev->data;
 	const struct device *dev = dt_spec->bus;
-	const struct spi_driver_api *api = (const struct spi_driver_api *)dev->api;
+	const struct spi_driver_api *api = DEVICE_API_GET(spi, dev);
 
 	api->iodev_submit(dt_spec->bus, iodev_sqe);
 }
@@ -1304,8 +1301,7 @@ __syscall int spi_release(const struct device *dev,
 static inline int z_impl_spi_release(const struct device *dev,
 				     const struct spi_config *config)
 {
-	const struct spi_driver_api *api =
-		(const struct spi_driver_api *)dev->api;
+	const struct spi_driver_api *api = DEVICE_API_GET(spi, dev);
 
 	return api->release(dev, config);
 }
@@ -777,6 +777,22 @@ struct video_buffer *video_buffer_aligned_alloc(size_t size, size_t align, k_tim
  */
 struct video_buffer *video_buffer_alloc(size_t size, k_timeout_t timeout);
 
+/**
+ * @brief Wrap memory owned by the caller into a video buffer.
+ *
+ * Lets a video device fill or read memory that belongs to another driver,
+ * such as a display frame buffer or the output of a 2D accelerator, without
+ * copying the frame. The buffer takes a slot of the video buffer pool, which
+ * video_buffer_release() gives back without freeing @p mem.
+ *
+ * @param mem Memory of the frame, reachable by the DMA of the video device.
+ * @param size Size of @p mem in bytes.
+ *
+ * @retval pointer to the video buffer
+ * @retval NULL if the pool has no free slot
+ */
+struct video_buffer *video_buffer_import(void *mem, size_t size);
+
 /**
  * @brief Release a video buffer.
  *
@@ -784,6 +800,24 @@ struct video_buffer *video_buffer_alloc(size_t size, k_timeout_t timeout);
  */
 void video_buffer_release(struct video_buffer *buf);
 
+/**
+ * @brief Write back the data cache over the valid data of a video buffer.
+ *
+ * To call after the CPU wrote a frame that a device is going to read.
+ *
+ * @param vbuf Pointer to the video buffer.
+ */
+void video_buffer_cache_flush(const struct video_buffer *vbuf);
+
+/**
+ * @brief Invalidate the data cache over a whole video buffer.
+ *
+ * To call before the CPU reads a frame that a device has written.
+ *
+ * @param vbuf Pointer to the video buffer.
+ */
+void video_buffer_cache_invd(const struct video_buffer *vbuf);
+
 /**
  * @brief Search for a format that matches in a list of capabilities
  *
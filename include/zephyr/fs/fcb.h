@@ -79,6 +79,37 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+#if defined(CONFIG_FCB_INDEX) || defined(__DOXYGEN__)
+/**
+ * @brief Location of an element in the RAM index of a sector.
+ */
+struct fcb_index_entry {
+	uint32_t ie_elem_off; /**< Offset of the element in the sector */
+	uint16_t ie_data_len; /**< Size of data area of the element */
+};
+
+/**
+ * @brief RAM index of the valid elements of an FCB sector.
+ *
+ * The index holds the first CONFIG_FCB_INDEX_SIZE valid elements of the
+ * sector, in order. Elements past them are looked up in flash.
+ */
+struct fcb_sector_index {
+	uint16_t si_cnt; /**< Number of elements indexed */
+	bool si_overflow; /**< Whether the sector has elements past the index */
+	struct fcb_index_entry si_entries[CONFIG_FCB_INDEX_SIZE];
+	/**< Indexed elements, by increasing offset */
+};
+#endif
+
+/**
+ * @brief Element to append with @ref fcb_append_batch.
+ */
+struct fcb_batch_elem {
+	const void *data; /**< Element data */
+	uint16_t len; /**< Length of element data */
+};
+
 /**
  * @brief Flag to disable CRC for the fcb_entries in flash.
  */
@@ -112,6 +143,14 @@ struct fcb {
 	struct flash_sector *f_sectors;
 	/**< Array of sectors, must be contiguous */
 
+#if defined(CONFIG_FCB_INDEX) || defined(__DOXYGEN__)
+	struct fcb_sector_index *f_index;
+	/**< Optional array of f_sector_cnt sector indexes, filled in by FCB.
+	 * When given, getting the next element reads nothing from flash
+	 * unless the element is past the index of its sector.
+	 */
+#endif
+
 	/* Flash circular buffer internal state */
 	struct k_mutex f_mtx;
 	/**< Locking for accessing the FCB data, internal state */
@@ -191,6 +230,27 @@ int fcb_append(struct fcb *fcbp, uint16_t len, struct fcb_entry *loc);
  */
 int fcb_append_finish(struct fcb *fcbp, struct fcb_entry *append_loc);
 
+/**
+ * Appends several entries to circular buffer at once.
+ *
+ * The entries are laid out in @p buf, each with its length and end marker,
+ * and written with as few flash writes as the buffer size and the sectors
+ * allow, instead of the three writes needed by fcb_append(), the write of
+ * the data and fcb_append_finish() for each entry.
+ *
+ * @param[in] fcbp FCB instance structure.
+ * @param[in] elems entries to append.
+ * @param[in] cnt number of entries to append.
+ * @param[in] buf buffer the entries are laid out in.
+ * @param[in] buf_size size of @p buf, which must hold the largest entry
+ *            along with its length and end marker.
+ *
+ * @return 0 on success, non-zero on failure, in which case the entries
+ *         before the failing one may have been appended.
+ */
+int fcb_append_batch(struct fcb *fcbp, const struct fcb_batch_elem *elems, size_t cnt,
+		     uint8_t *buf, size_t buf_size);
+
 /**
  * FCB Walk callback function type.
  *
@@ -243,6 +303,21 @@ int fcb_walk(struct fcb *fcbp, struct flash_sector *sector, fcb_walk_cb cb, void
  */
 int fcb_getnext(struct fcb *fcbp, struct fcb_entry *loc);
 
+/**
+ * Get the location of the n-th entry, counted from the oldest one.
+ *
+ * With CONFIG_FCB_INDEX and an index given to the FCB instance, this takes
+ * one step per sector instead of one per entry.
+ *
+ * @param[in] fcbp FCB instance structure.
+ * @param[in] n index of the entry, 0 for the oldest one.
+ * @param[out] loc entry location information
+ *
+ * @return 0 on success, -ENOENT if there are not that many entries, other
+ *         non-zero value on failure.
+ */
+int fcb_get_nth(struct fcb *fcbp, uint32_t n, struct fcb_entry *loc);
+
 /**
  * Rotate fcb sectors
  *
@@ -464,6 +464,59 @@ int fs_truncate(struct fs_file_t *zfp, off_t length);
  */
 int fs_sync(struct fs_file_t *zfp);
 
+/**
+ * @brief Read-only mapping of a part of a file
+ *
+ * Filled by fs_mmap() and released by fs_munmap().
+ */
+struct fs_mapping {
+	/** Address of the mapped data */
+	const void *addr;
+	/** Number of mapped bytes */
+	size_t len;
+	/** @cond INTERNAL_HIDDEN */
+	bool copy;
+	/** @endcond */
+};
+
+/**
+ * @brief Map a part of a file for reading
+ *
+ * When the file system stores the requested range contiguously in memory
+ * mapped storage, the mapping points to the data in place. Otherwise the
+ * range is read into a buffer taken from a heap of
+ * CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE bytes. The file position is not
+ * changed.
+ *
+ * The mapped data must not be modified, and is not updated by later writes
+ * to the file. The file must stay open until the mapping is released with
+ * fs_munmap().
+ *
+ * @param zfp Pointer to a file object opened for reading
+ * @param offset Offset of the first byte to map
+ * @param len Number of bytes to map
+ * @param map Mapping to fill in
+ *
+ * @retval 0 on success;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file,
+ *         or a file not opened for reading;
+ * @retval -EINVAL when the range extends beyond the end of the file;
+ * @retval -ENOMEM when the data has to be copied and there is no memory for it;
+ * @retval <0 an other negative errno code on error.
+ */
+int fs_mmap(struct fs_file_t *zfp, off_t offset, size_t len,
+	    struct fs_mapping *map);
+
+/**
+ * @brief Release a mapping made by fs_mmap()
+ *
+ * @param map Mapping to release
+ *
+ * @retval 0 on success;
+ * @retval -EINVAL when @p map doesn't describe a mapping.
+ */
+int fs_munmap(struct fs_mapping *map);
+
 /**
  * @brief Directory create
  *
@@ -80,6 +80,10 @@ struct fs_file_t {
 	const struct fs_mount_t *mp;
 	/** Open/create flags */
 	fs_mode_t flags;
+#if defined(CONFIG_FILE_SYSTEM_LOOKUP_CACHE) || defined(__DOXYGEN__)
+	/** Hash of the path the file was opened with, used by the lookup cache */
+	uint32_t lookup_hash;
+#endif
 };
 
 /**
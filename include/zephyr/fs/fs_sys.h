@@ -91,6 +91,21 @@ struct fs_file_system_t {
 	 * @return 0 on success, negative errno code on fail.
 	 */
 	int (*close)(struct fs_file_t *filp);
+	/**
+	 * Gets the address at which a part of a file can be read in place.
+	 *
+	 * Optional, only file systems which store files contiguously in
+	 * memory mapped storage can implement it.
+	 *
+	 * @param filp File to map.
+	 * @param off Offset in the file.
+	 * @param len Number of bytes to map.
+	 * @param addr Address of the data.
+	 * @return 0 on success, -ENOTSUP if the data can't be read in place,
+	 *         other negative errno code on fail.
+	 */
+	int (*mmap)(struct fs_file_t *filp, off_t off, size_t len,
+		    const void **addr);
 	/** @} */
 
 	/**
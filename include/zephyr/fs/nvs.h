@@ -62,6 +62,41 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_BACKGROUND_GC
+	/** Work item running the background garbage collection */
+	struct k_work gc_work;
+	/** Sector in which the background garbage collection gave up */
+	uint16_t gc_skip_sector;
+#endif
+#if CONFIG_NVS_LOOKUP_INDEX
+	/** IDs in the lookup index, in ascending order */
+	uint16_t lookup_index_id[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	/** Address of the most recent ATE of each ID in the lookup index */
+	uint32_t lookup_index_addr[CONFIG_NVS_LOOKUP_INDEX_SIZE];
+	/** Number of IDs in the lookup index */
+	uint16_t lookup_index_count;
+	/** Flag indicating that some IDs did not fit in the lookup index */
+	bool lookup_index_full;
+#endif
+};
+
+/**
+ * @brief Non-volatile Storage batch of entries
+ *
+ * Entries are staged in a buffer provided by the caller, then written to
+ * flash together by nvs_batch_commit().
+ */
+struct nvs_batch {
+	/** File system the entries are written to */
+	struct nvs_fs *fs;
+	/** Staging buffer: data from the start, allocation entries from the end */
+	uint8_t *buf;
+	/** Size of the staging buffer */
+	size_t buf_size;
+	/** Number of bytes of data staged, aligned to the write block size */
+	size_t data_size;
+	/** Number of entries staged */
+	uint16_t count;
 };
 
 /**
@@ -188,6 +223,59 @@ size_t nvs_sector_max_data_size(struct nvs_fs *fs);
  */
 int nvs_sector_use_next(struct nvs_fs *fs);
 
+/**
+ * @brief Start a batch of entries to be written together.
+ *
+ * Writing the entries of a batch takes one flash write for all their data
+ * and one for all their allocation entries, instead of at least two per
+ * entry with nvs_write(). Each entry of @p buf needs its data with the data
+ * CRC if any, and one allocation entry, both aligned to the write block size
+ * of the flash.
+ *
+ * @param fs Pointer to file system
+ * @param batch Batch to start
+ * @param buf Buffer in which the entries are staged until the commit
+ * @param size Size of @p buf
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ */
+int nvs_batch_begin(struct nvs_fs *fs, struct nvs_batch *batch, void *buf, size_t size);
+
+/**
+ * @brief Add an entry to a batch.
+ *
+ * The entry is compared to the one stored in the file system like with
+ * nvs_write(), nothing is staged if they are the same. A @p len of @p 0
+ * deletes the entry.
+ *
+ * @param batch Batch started with nvs_batch_begin()
+ * @param id Id of the entry to be written
+ * @param data Pointer to the data to be written
+ * @param len Number of bytes to be written
+ *
+ * @return Number of bytes staged, 0 when the entry is already stored. On
+ * error, returns negative value of errno.h defined error codes, -ENOSPC when
+ * the entry does not fit in the buffer or in a sector along with the
+ * entries already staged.
+ */
+ssize_t nvs_batch_add(struct nvs_batch *batch, uint16_t id, const void *data, size_t len);
+
+/**
+ * @brief Write the entries of a batch to flash.
+ *
+ * The entries are written in the sector in use, or all in the next one after
+ * a garbage collection, in the order they were added. Each entry is only
+ * valid once its allocation entry is written: a power loss during the commit
+ * can leave a part of the entries written, the others keeping their previous
+ * value. The batch is empty afterwards, whether the commit succeeded or not.
+ *
+ * @param batch Batch started with nvs_batch_begin()
+ *
+ * @return Number of entries written. On error, returns negative value of
+ * errno.h defined error codes.
+ */
+int nvs_batch_commit(struct nvs_batch *batch);
+
 /**
  * @}
  */
@@ -61,6 +61,12 @@ struct zms_fs {
 	const struct flash_parameters *flash_parameters;
 	/** Size of an Allocation Table Entry */
 	size_t ate_size;
+#if CONFIG_ZMS_BACKGROUND_GC
+	/** Work item running the background garbage collection */
+	struct k_work gc_work;
+	/** Sector in which the background garbage collection gave up */
+	uint32_t gc_skip_sector;
+#endif
 #if CONFIG_ZMS_LOOKUP_CACHE
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
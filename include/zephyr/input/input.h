@@ -127,6 +127,8 @@ struct input_callback {
 	void (*callback)(struct input_event *evt, void *user_data);
 	/** User data pointer. */
 	void *user_data;
+	/** The batch callback function, used instead of callback if set. */
+	void (*batch_callback)(struct input_event *evts, size_t num_evts, void *user_data);
 };
 
 /**
@@ -158,6 +160,39 @@ struct input_callback {
 #define INPUT_CALLBACK_DEFINE(_dev, _callback, _user_data)                     \
 	INPUT_CALLBACK_DEFINE_NAMED(_dev, _callback, _user_data, _callback)
 
+/**
+ * @brief Register a batch callback structure for input events with a custom
+ * name.
+ *
+ * Same as @ref INPUT_BATCH_CALLBACK_DEFINE but allows specifying a custom
+ * name for the callback structure.
+ */
+#define INPUT_BATCH_CALLBACK_DEFINE_NAMED(_dev, _callback, _user_data, name)   \
+	static const STRUCT_SECTION_ITERABLE(input_callback,                   \
+					     _input_callback__##name) = {      \
+		.dev = _dev,                                                   \
+		.batch_callback = _callback,                                   \
+		.user_data = _user_data,                                       \
+	}
+
+/**
+ * @brief Register a batch callback structure for input events.
+ *
+ * Same as @ref INPUT_CALLBACK_DEFINE, but the callback gets the events in
+ * batches. A batch holds consecutive events of a single device and ends
+ * with the next event with the sync flag set, unless
+ * @kconfig{CONFIG_INPUT_BATCH_MAX_EVENTS} events have been collected or no
+ * more events were queued. With @kconfig{CONFIG_INPUT_MODE_SYNCHRONOUS}
+ * every batch holds a single event.
+ *
+ * @param _dev @ref device pointer or NULL.
+ * @param _callback The callback function, taking the events, their number
+ *        and the user data.
+ * @param _user_data Pointer to user specified data.
+ */
+#define INPUT_BATCH_CALLBACK_DEFINE(_dev, _callback, _user_data)               \
+	INPUT_BATCH_CALLBACK_DEFINE_NAMED(_dev, _callback, _user_data, _callback)
+
 #ifdef __cplusplus
 }
 #endif
@@ -539,11 +539,37 @@ static inline int k_object_validation_check(struct k_object *ko,
 	return ret;
 }
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+/**
+ * @brief Validate a kernel object for the current thread, with a cache
+ *
+ * Same as k_object_validation_check() on the result of k_object_find(),
+ * skipping the lookup and the permission check for the objects the
+ * current thread was recently allowed to use.
+ *
+ * @note This is an internal API. Do not use unless you are extending
+ *       functionality in the Zephyr tree.
+ *
+ * @param obj Address of the kernel object
+ * @param otype Expected type of the kernel object, or K_OBJ_ANY
+ * @param init Indicate whether the object needs to already be in initialized
+ *             or uninitialized state, or that we don't care
+ * @return 0 If the object is valid, an error as k_object_validate() otherwise
+ */
+int k_object_validation_check_cached(const void *obj, enum k_objects otype,
+				     enum _obj_init_check init);
+
+#define K_SYSCALL_IS_OBJ(ptr, type, init) \
+	K_SYSCALL_VERIFY_MSG(k_object_validation_check_cached(		\
+				     (const void *)(ptr),		\
+				     (type), (init)) == 0, "access denied")
+#else
 #define K_SYSCALL_IS_OBJ(ptr, type, init) \
 	K_SYSCALL_VERIFY_MSG(k_object_validation_check(			\
 				     k_object_find((const void *)(ptr)),	\
 				     (const void *)(ptr),		\
 				     (type), (init)) == 0, "access denied")
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
 
 /**
  * @brief Runtime check driver object pointer for presence of operation
@@ -101,6 +101,17 @@ struct icmsg_data_t {
 	uint16_t remote_sid;
 	uint16_t local_sid;
 	atomic_t state;
+
+	/* TX buffer claimed for no-copy sending, with the TX lock taken. */
+	char *tx_buf;
+	uint32_t tx_buf_size;
+
+	/* In-place RX message being received, and the one held by the user. */
+	struct k_spinlock rx_lock;
+	const void *rx_in_place;
+	const void *rx_held;
+	uint16_t rx_in_place_len;
+	uint16_t rx_held_len;
 };
 
 /** @brief Open an icmsg instance
@@ -170,6 +181,105 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	       struct icmsg_data_t *dev_data,
 	       const void *msg, size_t len);
 
+/** @brief Get a buffer in the shared memory to send a message with no copy.
+ *
+ *  The buffer is the space left up to the end of the TX ring, or up to the
+ *  oldest unread message. Until it is sent with @ref icmsg_send_nocopy or
+ *  dropped with @ref icmsg_drop_tx_buffer, no other message can be sent. With
+ *  @kconfig{CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC}, the buffer must be sent
+ *  or dropped by the thread which got it.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[out] data Pointer to the buffer.
+ *  @param[inout] size Requested size, 0 for any. Size of the buffer on return,
+ *                     also when the requested size is too big.
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY when the instance has not finished handshake with the remote
+ *                 instance.
+ *  @retval -EALREADY when a buffer is already claimed.
+ *  @retval -ENOBUFS when there is no space in the TX ring.
+ *  @retval -ENOMEM when the requested size is too big.
+ *  @retval other errno codes from dependent modules.
+ */
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, uint32_t *size);
+
+/** @brief Release a buffer got with @ref icmsg_get_tx_buffer without sending it.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Pointer to the buffer.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when no buffer is claimed.
+ *  @retval -ENXIO when @p data is not the claimed buffer.
+ */
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data);
+
+/** @brief Send a message written in a buffer got with @ref icmsg_get_tx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] msg Pointer to the buffer.
+ *  @param[in] len Size of the message in the buffer.
+ *
+ *  @retval Number of sent bytes.
+ *  @retval -ENXIO when @p msg is not the claimed buffer.
+ *  @retval -ENODATA when the message is empty.
+ *  @retval -EBADMSG when the message is larger than the buffer.
+ *  @retval other errno codes from dependent modules.
+ */
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data,
+		      const void *msg, size_t len);
+
+/** @brief Keep a received message in the shared memory after the receive callback.
+ *
+ *  Only one message can be held, and no other message is received until it is
+ *  released with @ref icmsg_release_rx_buffer. Messages wrapping around the end
+ *  of the RX ring are received from a copy and cannot be held.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Message passed to the receive callback, which must be running.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when a message is already held.
+ *  @retval -ENXIO when @p data cannot be held.
+ */
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data);
+
+/** @brief Release a message held with @ref icmsg_hold_rx_buffer.
+ *
+ *  @param[in] conf Structure containing configuration parameters for the icmsg
+ *                  instance.
+ *  @param[inout] dev_data Structure containing run-time data used by the icmsg
+ *                         instance.
+ *  @param[in] data Held message.
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY when no message is held.
+ *  @retval -ENXIO when @p data is not the held message.
+ */
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data,
+			    const void *data);
+
 /**
  * @}
  */
@@ -235,6 +235,65 @@ int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
  */
 int pbuf_read(struct pbuf *pb, char *buf, uint16_t len);
 
+/**
+ * @brief Get the free space of the packet buffer for writing a packet in place.
+ *
+ * The data of a packet written in place cannot wrap around the end of the
+ * buffer, so the space returned may be less than pbuf_write() could take.
+ * Nothing is reserved until the packet is committed with pbuf_tx_buf_commit().
+ *
+ * @param pb		A buffer to which to write.
+ * @param[out] buf	Pointer to the packet data in the buffer.
+ * @retval int	Number of bytes available at @p buf, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ */
+int pbuf_tx_buf_get(struct pbuf *pb, char **buf);
+
+/**
+ * @brief Commit a packet written in place.
+ *
+ * @param pb	A buffer to which the packet was written.
+ * @param len	Number of bytes written at the location given by pbuf_tx_buf_get().
+ *		Must be positive and fit in the space it returned.
+ * @retval int	Number of bytes committed, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ */
+int pbuf_tx_buf_commit(struct pbuf *pb, uint16_t len);
+
+/**
+ * @brief Get the amount of data written and not read yet.
+ *
+ * @param pb		A buffer to which data was written.
+ * @retval uint32_t	Number of bytes waiting for the reader, packet headers and
+ *			padding included.
+ */
+uint32_t pbuf_tx_pending(struct pbuf *pb);
+
+/**
+ * @brief Get the next packet of the packet buffer in place.
+ *
+ * The packet stays in the buffer until it is freed with pbuf_rx_buf_free().
+ *
+ * @param pb		A buffer from which data will be read.
+ * @param[out] buf	Pointer to the packet data in the buffer.
+ * @retval int	Packet length, 0 if the buffer is empty, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ *		-EAGAIN, if not whole message is ready yet.
+ *		-ENOBUFS, if the packet wraps around the end of the buffer and
+ *		must be read with pbuf_read().
+ */
+int pbuf_rx_buf_get(struct pbuf *pb, char **buf);
+
+/**
+ * @brief Free the packet got with pbuf_rx_buf_get().
+ *
+ * @param pb	A buffer from which data was read.
+ * @param len	Packet length returned by pbuf_rx_buf_get().
+ * @retval int	0 on success, negative error code on fail.
+ *		-EINVAL, if any of input parameter is incorrect.
+ */
+int pbuf_rx_buf_free(struct pbuf *pb, uint16_t len);
+
 /**
  * @brief Read handshake word from pbuf.
  *
@@ -248,6 +248,9 @@ irq_disconnect_dynamic(unsigned int irq, unsigned int priority,
 #ifdef CONFIG_SMP
 unsigned int z_smp_global_lock(void);
 #define irq_lock() z_smp_global_lock()
+#elif defined(CONFIG_IRQ_STATS_LOCK)
+unsigned int z_irq_stats_lock(void);
+#define irq_lock() z_irq_stats_lock()
 #else
 #define irq_lock() arch_irq_lock()
 #endif
@@ -276,10 +279,21 @@ unsigned int z_smp_global_lock(void);
 #ifdef CONFIG_SMP
 void z_smp_global_unlock(unsigned int key);
 #define irq_unlock(key) z_smp_global_unlock(key)
+#elif defined(CONFIG_IRQ_STATS_LOCK)
+void z_irq_stats_unlock(unsigned int key);
+#define irq_unlock(key) z_irq_stats_unlock(key)
 #else
 #define irq_unlock(key) arch_irq_unlock(key)
 #endif
 
+#ifdef CONFIG_IRQ_STATS_ISR
+/* Called by the arch interrupt entry path around the ISR of an IRQ line,
+ * irq being its index in the software ISR table.
+ */
+void z_irq_stats_isr_enter(void);
+void z_irq_stats_isr_exit(unsigned int irq);
+#endif /* CONFIG_IRQ_STATS_ISR */
+
 /**
  * @brief Enable an IRQ.
  *
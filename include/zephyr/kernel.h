@@ -707,6 +707,24 @@ static inline k_tid_t k_current_get(void)
  */
 __syscall void k_thread_abort(k_tid_t thread);
 
+/**
+ * @brief Abort a thread without waiting for it to stop.
+ *
+ * Same as k_thread_abort(), except that when @a thread is running on
+ * another CPU the caller neither blocks nor spins.  The thread is
+ * flagged, its CPU is interrupted and reaps it, then wakes up the
+ * threads joining it.  Use k_thread_join() to wait for, or with
+ * K_NO_WAIT to poll, the completion.
+ *
+ * This routine may be called from ISRs.
+ *
+ * @param thread ID of thread to abort.
+ *
+ * @retval 0 The thread is dead on return.
+ * @retval -EINPROGRESS The abort will complete asynchronously.
+ */
+__syscall int k_thread_abort_async(k_tid_t thread);
+
 k_ticks_t z_timeout_expires(const struct _timeout *timeout);
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
 
@@ -1705,6 +1723,26 @@ void k_timer_init(struct k_timer *timer,
 __syscall void k_timer_start(struct k_timer *timer,
 			     k_timeout_t duration, k_timeout_t period);
 
+/**
+ * @brief Start a timer that may expire late.
+ *
+ * This routine behaves like k_timer_start(), except that each expiry of
+ * the timer may be deferred by up to @a slack so that it can be handled
+ * in the same wakeup as other timeouts.  Periodic expiries are still
+ * spaced relative to their nominal expiry, so the slack does not
+ * accumulate.
+ *
+ * The slack is only honored with @kconfig{CONFIG_TIMEOUT_SLACK}; without
+ * it this routine is equivalent to k_timer_start().
+ *
+ * @param timer     Address of timer.
+ * @param duration  Initial timer duration.
+ * @param period    Timer period.
+ * @param slack     Maximum delay of each expiry (relative, or @c K_FOREVER).
+ */
+__syscall void k_timer_start_slack(struct k_timer *timer, k_timeout_t duration,
+				   k_timeout_t period, k_timeout_t slack);
+
 /**
  * @brief Stop a timer.
  *
@@ -2363,6 +2401,9 @@ struct k_event {
 #ifdef CONFIG_OBJ_CORE_EVENT
 	struct k_obj_core obj_core;
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	struct k_obj_wait_stats wait_stats;
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
 
 };
 
@@ -3084,6 +3125,9 @@ struct k_mutex {
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	struct k_obj_wait_stats wait_stats;
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 };
 
 /**
@@ -3260,6 +3304,159 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @}
  */
 
+#ifdef CONFIG_RWLOCK
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Layout of k_rwlock::state: reader count in the low bits */
+#define Z_RWLOCK_WRITER  BIT(30)
+#define Z_RWLOCK_WAITERS BIT(29)
+#define Z_RWLOCK_READERS (Z_RWLOCK_WAITERS - 1)
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Reader-writer lock structure
+ *
+ * All the members are internal and should not be accessed directly.
+ */
+struct k_rwlock {
+	/**
+	 * @cond INTERNAL_HIDDEN
+	 */
+	atomic_t state;
+	struct k_thread *writer;
+	struct k_spinlock lock;
+	_wait_q_t rd_wait_q;
+	_wait_q_t wr_wait_q;
+	/**
+	 * INTERNAL_HIDDEN @endcond
+	 */
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_RWLOCK_INITIALIZER(obj)                                              \
+	{                                                                      \
+		.state = ATOMIC_INIT(0),                                       \
+		.writer = NULL,                                                \
+		.lock = {},                                                    \
+		.rd_wait_q = Z_WAIT_Q_INIT(&(obj).rd_wait_q),                  \
+		.wr_wait_q = Z_WAIT_Q_INIT(&(obj).wr_wait_q),                  \
+	}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup rwlock_apis Reader-Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a reader-writer lock.
+ *
+ * Reader-writer locks let any number of threads hold the lock for reading
+ * at the same time, while a writer has exclusive access. Taking or
+ * releasing the lock for reading is a single atomic operation as long as
+ * no writer holds or waits for it; the scheduler is only involved when a
+ * thread actually has to block or be woken up.
+ *
+ * Once a writer is waiting, new readers queue behind it; when a writer
+ * releases the lock, all waiting readers are let in before the next
+ * writer. Neither side can thus be starved by the other.
+ *
+ * There is no priority inheritance and no recursion: a thread must not
+ * take a lock it already holds, for reading or writing.
+ *
+ * Reader-writer locks are only usable from supervisor mode threads.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Reader-writer lock initialized.
+ */
+int k_rwlock_init(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for reading.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to take the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock taken for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for reading.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader-writer lock for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ * @param timeout Waiting period to take the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock taken for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a reader-writer lock held for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The current thread does not hold the lock for writing.
+ */
+int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Get the thread holding a reader-writer lock for writing.
+ *
+ * @param rwlock Address of the reader-writer lock.
+ *
+ * @return The writer, or NULL if the lock is not held for writing.
+ */
+static inline struct k_thread *k_rwlock_writer_get(struct k_rwlock *rwlock)
+{
+	return rwlock->writer;
+}
+
+/**
+ * @brief Statically define and initialize a reader-writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the reader-writer lock.
+ */
+#define K_RWLOCK_DEFINE(name)                                                  \
+	struct k_rwlock name = Z_RWLOCK_INITIALIZER(name)
+
+/** @} */
+
+#endif /* CONFIG_RWLOCK */
+
 /**
  * @defgroup semaphore_apis Semaphore APIs
  * @ingroup kernel_apis
@@ -3287,6 +3484,9 @@ struct k_sem {
 #ifdef CONFIG_OBJ_CORE_SEM
 	struct k_obj_core  obj_core;
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	struct k_obj_wait_stats wait_stats;
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 	/** @endcond */
 };
 
@@ -3635,6 +3835,49 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Initialize a work queue served by a pool of threads.
+ *
+ * This behaves like k_work_queue_start(), except that @p num_workers threads
+ * take items off the queue, so that one slow handler does not hold up the
+ * others and, on SMP, items can be processed on several CPUs at once.  A
+ * given work item still never runs on two workers at the same time, and
+ * flush and cancellation keep their usual semantics.
+ *
+ * The first worker is the thread embedded in @p queue, which is the one
+ * returned by k_work_queue_thread_get().
+ *
+ * @note Work items submitted to a pool run concurrently with each other,
+ * so handlers must not rely on the implicit serialization of a single
+ * thread queue.
+ *
+ * Available only with @kconfig{CONFIG_WORKQUEUE_POOL}.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param threads array of @p num_workers - 1 thread objects for the workers
+ * beyond the first.
+ *
+ * @param stacks stack array for the workers, defined with
+ * K_THREAD_STACK_ARRAY_DEFINE() with @p num_workers elements.
+ *
+ * @param stack_size size of each stack, as passed to
+ * K_THREAD_STACK_ARRAY_DEFINE().
+ *
+ * @param num_workers number of worker threads, at least 1.
+ *
+ * @param prio initial priority of all worker threads
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_start_pool(struct k_work_q *queue, struct k_thread *threads,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     size_t num_workers, int prio,
+			     const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3843,6 +4086,48 @@ int k_work_schedule_for_queue(struct k_work_q *queue,
 int k_work_schedule(struct k_work_delayable *dwork,
 				   k_timeout_t delay);
 
+/** @brief Submit an idle work item to a queue after a delay, allowing the
+ * submission to be deferred.
+ *
+ * This behaves like k_work_schedule_for_queue(), except that the work item
+ * may be submitted up to @p slack after @p delay has elapsed so that its
+ * timeout can share a wakeup with other timeouts.  The slack is only
+ * honored with @kconfig{CONFIG_TIMEOUT_SLACK}.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue the queue on which the work item should be submitted after the
+ * delay.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @param slack the additional time the submission may be deferred by.
+ *
+ * @return as with k_work_schedule_for_queue().
+ */
+int k_work_schedule_for_queue_slack(struct k_work_q *queue,
+				    struct k_work_delayable *dwork,
+				    k_timeout_t delay, k_timeout_t slack);
+
+/** @brief Submit an idle work item to the system work queue after a
+ * delay, allowing the submission to be deferred.
+ *
+ * This is a thin wrapper around k_work_schedule_for_queue_slack(), with all
+ * the API characteristics of that function.
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param delay the time to wait before submitting the work item.
+ *
+ * @param slack the additional time the submission may be deferred by.
+ *
+ * @return as with k_work_schedule_for_queue().
+ */
+int k_work_schedule_slack(struct k_work_delayable *dwork,
+			  k_timeout_t delay, k_timeout_t slack);
+
 /** @brief Reschedule a work item to a queue after a delay.
  *
  * Unlike k_work_schedule_for_queue() this function can change the deadline of
@@ -4138,6 +4423,10 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Item being flushed, which the flusher must not overtake */
+	struct k_work *target;
+#endif /* CONFIG_WORKQUEUE_POOL */
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4207,6 +4496,14 @@ struct k_work_queue_config {
 	 * essential thread.
 	 */
 	bool essential;
+
+	/** Control whether the workers of a pool are pinned to CPUs.
+	 *
+	 * When set, k_work_queue_start_pool() pins worker N to CPU N
+	 * modulo the number of CPUs.  Ignored without
+	 * @kconfig{CONFIG_SCHED_CPU_MASK}.
+	 */
+	bool pin_workers;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4229,6 +4526,20 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Workers beyond the embedded thread, see k_work_queue_start_pool() */
+	struct k_thread *workers;
+
+	/* Total number of worker threads */
+	uint8_t num_workers;
+
+	/* Workers currently running an item */
+	uint8_t num_busy;
+
+	/* Workers that have not exited since the queue was started */
+	uint8_t num_alive;
+#endif /* CONFIG_WORKQUEUE_POOL */
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4634,6 +4945,10 @@ struct k_msgq {
 #ifdef CONFIG_OBJ_CORE_MSGQ
 	struct k_obj_core  obj_core;
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+	/** Contention statistics */
+	struct k_obj_wait_stats wait_stats;
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 };
 /**
  * @cond INTERNAL_HIDDEN
@@ -5277,6 +5592,9 @@ struct k_pipe {
 #ifdef CONFIG_OBJ_CORE_PIPE
 	struct k_obj_core  obj_core;
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	struct k_obj_wait_stats wait_stats;
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 };
 
@@ -5393,6 +5711,9 @@ struct k_mem_slab {
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	atomic_t free_head;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 	struct k_mem_slab_info info;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
@@ -5622,10 +5943,44 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+/** @cond INTERNAL_HIDDEN */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	void *blocks[CONFIG_HEAP_PERCPU_CACHE_CLASSES][CONFIG_HEAP_PERCPU_CACHE_DEPTH];
+	uint8_t count[CONFIG_HEAP_PERCPU_CACHE_CLASSES];
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t refills;
+	uint32_t drains;
+};
+/** @endcond */
+
+/**
+ * @brief Statistics of the per-CPU caches of a k_heap
+ */
+struct k_heap_cache_stats {
+	/** Allocations served from a cache */
+	uint32_t hits;
+	/** Cacheable allocations that found their cache empty */
+	uint32_t misses;
+	/** Batches of blocks taken from the heap into a cache */
+	uint32_t refills;
+	/** Batches of blocks given back to the heap from a cache */
+	uint32_t drains;
+	/** Bytes currently held by the caches */
+	size_t cached_bytes;
+};
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+	atomic_t cache_waiters;
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 };
 
 /**
@@ -5754,10 +6109,32 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+#if defined(CONFIG_HEAP_PERCPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Get the statistics of the per-CPU caches of a k_heap
+ *
+ * The counters of all CPUs are added up. They are sampled without
+ * stopping other CPUs, so the result is only approximate while the heap
+ * is in use.
+ *
+ * @param h Heap to get the statistics of
+ * @param stats Where to store the statistics
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if a NULL pointer was passed
+ */
+int k_heap_cache_stats_get(struct k_heap *h, struct k_heap_cache_stats *stats);
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
+#ifdef CONFIG_SYS_HEAP_TLSF
+/* Upper bound reached when all buckets of such a tiny heap are linear */
+#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 120 : 84)
+#else
 #define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#endif /* CONFIG_SYS_HEAP_TLSF */
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -6496,6 +6873,168 @@ void k_sys_runtime_stats_enable(void);
  */
 void k_sys_runtime_stats_disable(void);
 
+struct k_sched_latency_stats;
+
+/**
+ * @brief Get the scheduler latency statistics of a CPU
+ *
+ * Copies the wake-to-run latency histograms gathered on @a cpu with
+ * CONFIG_SCHED_LATENCY_STATS.
+ *
+ * @param cpu The cpu number
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer or invalid cpu, otherwise 0
+ */
+int k_sched_latency_stats_get(int cpu, struct k_sched_latency_stats *stats);
+
+/**
+ * @brief Reset the scheduler latency statistics of all CPUs
+ */
+void k_sched_latency_stats_reset(void);
+
+struct k_ipi_stats;
+
+/**
+ * @brief Get the scheduling IPI counters of a CPU
+ *
+ * Copies the counters gathered for @a cpu with CONFIG_SCHED_IPI_STATS.
+ *
+ * @param cpu The cpu number
+ * @param stats Pointer to struct to copy the counters into.
+ * @return -EINVAL if null pointer or invalid cpu, otherwise 0
+ */
+int k_ipi_stats_get(int cpu, struct k_ipi_stats *stats);
+
+struct k_perf_counter_stats;
+
+/**
+ * @brief Start a hardware performance counter
+ *
+ * Counter @a idx counts @a event from now on, from zero. With
+ * CONFIG_THREAD_PERF_COUNTERS, the events are also attributed to the
+ * thread running when they occur.
+ *
+ * @param idx Counter index, below CONFIG_PERF_COUNTERS_NUM.
+ * @param event Event to count.
+ * @return 0 on success, -EINVAL for an invalid counter, -ENOTSUP if the
+ *         hardware cannot count @a event with counter @a idx
+ */
+int k_perf_counter_start(unsigned int idx, enum k_perf_event event);
+
+/**
+ * @brief Stop a hardware performance counter
+ *
+ * The counted events are kept until the counter is started again.
+ *
+ * @param idx Counter index, below CONFIG_PERF_COUNTERS_NUM.
+ * @return 0 on success, -EINVAL for an invalid counter
+ */
+int k_perf_counter_stop(unsigned int idx);
+
+/**
+ * @brief Get the values of the hardware performance counters
+ *
+ * @param stats Pointer to struct to copy the counters into.
+ * @return -EINVAL if null pointer, otherwise 0
+ */
+int k_perf_counter_stats_get(struct k_perf_counter_stats *stats);
+
+/**
+ * @brief Get the performance counters values of a thread
+ *
+ * With CONFIG_THREAD_PERF_COUNTERS, gets the events counted by each
+ * counter while @a thread was running.
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy the counters into.
+ * @return -EINVAL if null pointer, otherwise 0
+ */
+int k_thread_perf_counter_stats_get(k_tid_t thread, struct k_perf_counter_stats *stats);
+
+/**
+ * @brief Reset the performance counters values of the system and of all
+ * threads
+ */
+void k_perf_counter_stats_reset(void);
+
+struct k_irq_stats;
+struct k_irq_lock_stats;
+
+/**
+ * @brief Get the ISR duration statistics of an IRQ line
+ *
+ * Copies the statistics gathered with CONFIG_IRQ_STATS_ISR for the ISR
+ * of @a irq, excluding the time spent in nested ISRs.
+ *
+ * @param irq IRQ line, as an index of the software ISR table.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer or invalid IRQ line, otherwise 0
+ */
+int k_irq_stats_get(unsigned int irq, struct k_irq_stats *stats);
+
+/**
+ * @brief Get the interrupt masking statistics
+ *
+ * Copies the statistics gathered with CONFIG_IRQ_STATS_LOCK.
+ *
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer, -ENOTSUP without CONFIG_IRQ_STATS_LOCK,
+ *         otherwise 0
+ */
+int k_irq_lock_stats_get(struct k_irq_lock_stats *stats);
+
+/**
+ * @brief Reset the ISR duration and interrupt masking statistics
+ */
+void k_irq_stats_reset(void);
+
+struct k_spinlock;
+struct k_spinlock_stats;
+
+/**
+ * @brief Get the contention statistics of a spinlock
+ *
+ * Copies the statistics gathered with CONFIG_SPINLOCK_STATS for @a lock.
+ * They are read while the other CPUs may update them, the values can be
+ * off by the acquisitions in progress.
+ *
+ * @param lock Spinlock to get the statistics of.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointer, -ENOENT if the spinlock is not tracked,
+ *         otherwise 0
+ */
+int k_spinlock_stats_get(const struct k_spinlock *lock,
+			 struct k_spinlock_stats *stats);
+
+/**
+ * @brief Get the statistics of the most contended spinlocks
+ *
+ * Copies the statistics of up to @a count spinlocks, sorted by
+ * decreasing number of spin iterations. Spinlocks which never had to
+ * spin are not reported.
+ *
+ * @param stats Array of @a count structs to copy statistics into.
+ * @param count Number of elements of @a stats.
+ * @return Number of spinlocks copied.
+ */
+unsigned int k_spinlock_stats_top(struct k_spinlock_stats *stats,
+				  unsigned int count);
+
+/**
+ * @brief Get the number of spinlock acquisitions not recorded
+ *
+ * @return Number of acquisitions of spinlocks which did not fit in the
+ *         statistics table.
+ */
+uint32_t k_spinlock_stats_dropped(void);
+
+/**
+ * @brief Reset the spinlock contention statistics
+ *
+ * The tracked spinlocks stay in the statistics table.
+ */
+void k_spinlock_stats_reset(void);
+
 #ifdef __cplusplus
 }
 #endif
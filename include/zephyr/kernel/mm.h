@@ -77,6 +77,20 @@
 /** Region will be mapped to 1:1 virtual and physical address */
 #define K_MEM_DIRECT_MAP	BIT(6)
 
+/**
+ * Region should be mapped with the largest pages the MMU supports
+ *
+ * The virtual address is picked so it has the same offset as the physical
+ * address within the largest page size which fits in the region, see
+ * arch_mem_large_page_size(). Architectures mapping with large pages when
+ * both addresses are aligned then cover the region with fewer TLB entries,
+ * at the cost of up to one large page of virtual address space.
+ *
+ * Only meaningful for physically contiguous regions, i.e. with
+ * k_mem_map_phys_bare().
+ */
+#define K_MEM_MAP_LARGE		BIT(7)
+
 /** @} */
 
 #ifndef _ASMLANGUAGE
@@ -58,7 +58,33 @@ struct k_mem_paging_stats_t {
 
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
+
+		/**
+		 * Number of page faults on one of the last
+		 * CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW evicted pages
+		 */
+		unsigned long			refaults;
 	} eviction;
+
+#if defined(CONFIG_BACKING_STORE_COMPRESSED) || defined(__DOXYGEN__)
+	/**
+	 * Compressed backing store usage. Only kept system-wide,
+	 * and zero in per-thread statistics.
+	 */
+	struct {
+		/** Number of data pages stored */
+		unsigned long			pages;
+
+		/** Number of bytes used to store them */
+		unsigned long			stored_bytes;
+
+		/** Number of them filled with a repeated word, taking no bytes */
+		unsigned long			same_filled;
+
+		/** Number of them stored uncompressed */
+		unsigned long			incompressible;
+	} compression;
+#endif /* CONFIG_BACKING_STORE_COMPRESSED */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
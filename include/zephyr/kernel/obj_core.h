@@ -51,8 +51,14 @@
 #define K_OBJ_TYPE_MUTEX_ID      K_OBJ_TYPE_ID_GEN("MUTX")
 /** Pipe object type */
 #define K_OBJ_TYPE_PIPE_ID       K_OBJ_TYPE_ID_GEN("PIPE")
+/** Performance counters object type */
+#define K_OBJ_TYPE_PERF_COUNTERS_ID K_OBJ_TYPE_ID_GEN("PCNT")
+/** Scheduler latency statistics object type */
+#define K_OBJ_TYPE_SCHED_LATENCY_ID K_OBJ_TYPE_ID_GEN("SLAT")
 /** Semaphore object type */
 #define K_OBJ_TYPE_SEM_ID        K_OBJ_TYPE_ID_GEN("SEM4")
+/** Dynamic thread stack cache object type */
+#define K_OBJ_TYPE_STACK_CACHE_ID K_OBJ_TYPE_ID_GEN("STKC")
 /** Stack object type */
 #define K_OBJ_TYPE_STACK_ID      K_OBJ_TYPE_ID_GEN("STCK")
 /** Thread object type */
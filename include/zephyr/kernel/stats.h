@@ -10,6 +10,33 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#if defined(CONFIG_SCHED_THREAD_USAGE_WINDOWS) || defined(__DOXYGEN__)
+/** Number of rolling usage windows: 1, 10 and 60 seconds */
+#define K_USAGE_WINDOWS 3
+
+/** Number of burst duration percentiles: 50th, 90th and 99th */
+#define K_USAGE_BURST_PERCENTILES 3
+
+/**
+ * Rolling usage windows and burst durations of a thread or CPU.
+ *
+ * Seconds are counted by each CPU from the cycles it accounts.  A burst
+ * is the time a thread runs from being switched in to being switched
+ * out, or the time a CPU runs non-idle threads.  Bucket 0 of the burst
+ * histogram counts bursts below 2 cycles, bucket N bursts of
+ * [2^N, 2^(N+1)) cycles, and the last bucket everything above.
+ */
+struct k_usage_windows {
+	uint32_t  second;       /**< second of the current slot */
+	uint32_t  elapsed;      /**< cycles elapsed in the current second (CPU only) */
+	uint32_t  current;      /**< usage cycles of the current second */
+	uint32_t  sec1[10];     /**< usage cycles of the last 10 seconds */
+	uint64_t  sec10[6];     /**< usage cycles of the last 6 10-second periods */
+	/** burst duration histogram */
+	uint32_t  bursts[CONFIG_SCHED_THREAD_USAGE_BURST_BUCKETS];
+};
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 /**
  * Structure used to track internal statistics about both thread
  * and CPU usage.
@@ -27,7 +54,168 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_WINDOWS) || defined(__DOXYGEN__)
+	struct k_usage_windows windows; /**< rolling windows and bursts */
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) || defined(__DOXYGEN__)
+/**
+ * Number of thread priority levels covered by the scheduler latency
+ * histograms, indexed by (priority - K_HIGHEST_THREAD_PRIO).
+ */
+#define K_SCHED_LATENCY_PRIOS \
+	(CONFIG_NUM_PREEMPT_PRIORITIES + CONFIG_NUM_COOP_PRIORITIES + 1)
+
+/**
+ * Wake-to-run latency statistics of one CPU.
+ *
+ * A sample is the time, in the thread runtime statistics time base,
+ * from a thread being made ready to it being switched in.  Bucket 0
+ * of a histogram counts samples below 2 units, bucket N samples in
+ * [2^N, 2^(N+1)), and the last bucket everything above.
+ */
+struct k_sched_latency_stats {
+	uint64_t  total;        /**< sum of all samples */
+	uint32_t  count;        /**< \# of samples */
+	uint32_t  max;          /**< largest sample */
+	/** per priority level histograms */
+	uint32_t  hist[K_SCHED_LATENCY_PRIOS][CONFIG_SCHED_LATENCY_STATS_BUCKETS];
+};
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+#if defined(CONFIG_SCHED_IPI_STATS) || defined(__DOXYGEN__)
+/**
+ * Scheduling IPI counters of one CPU.
+ *
+ * Requests beyond the IPIs sent were merged into an IPI already on its
+ * way, or not needed on a uniprocessor run.
+ */
+struct k_ipi_stats {
+	uint32_t  requested;    /**< \# of times the CPU was flagged for an IPI */
+	uint32_t  sent;         /**< \# of IPIs sent to the CPU */
+	uint32_t  received;     /**< \# of IPIs processed by the CPU */
+};
+#endif /* CONFIG_SCHED_IPI_STATS */
+
+#if defined(CONFIG_DYNAMIC_THREAD_STACK_CACHE) || defined(__DOXYGEN__)
+/**
+ * Counters of the dynamic thread stack cache.
+ */
+struct k_thread_stack_cache_stats {
+	uint32_t  hits;         /**< allocations served from the cache */
+	uint32_t  misses;       /**< allocations that went to the heap */
+	uint32_t  cached;       /**< frees kept in the cache */
+	uint32_t  released;     /**< frees returned to the heap */
+};
+#endif /* CONFIG_DYNAMIC_THREAD_STACK_CACHE */
+
+#if defined(CONFIG_IRQ_STATS) || defined(__DOXYGEN__)
+/**
+ * Duration statistics of an ISR or of interrupt masking.
+ *
+ * A sample is a duration in the thread runtime statistics time base.
+ * Bucket 0 of the histogram counts samples below 2 units, bucket N
+ * samples in [2^N, 2^(N+1)), and the last bucket everything above.
+ */
+struct k_irq_stats {
+	uint64_t  total;        /**< sum of all samples */
+	uint32_t  count;        /**< \# of samples */
+	uint32_t  max;          /**< largest sample */
+	uint32_t  hist[CONFIG_IRQ_STATS_BUCKETS]; /**< histogram */
+};
+
+#if defined(CONFIG_IRQ_STATS_LOCK) || defined(__DOXYGEN__)
+/**
+ * Code location which masked interrupts.
+ */
+struct k_irq_lock_holder {
+	uintptr_t addr;         /**< return address of the lock call */
+	uint32_t  max;          /**< longest masking from this location */
+};
+
+/**
+ * Interrupt masking statistics.
+ */
+struct k_irq_lock_stats {
+	struct k_irq_stats  masked; /**< masking durations */
+	/** locations which masked interrupts the longest, longest first */
+	struct k_irq_lock_holder holders[CONFIG_IRQ_STATS_LOCK_HOLDERS];
+};
+#endif /* CONFIG_IRQ_STATS_LOCK */
+#endif /* CONFIG_IRQ_STATS */
+
+#if defined(CONFIG_SPINLOCK_STATS) || defined(__DOXYGEN__)
+/**
+ * Contention statistics of a call site of k_spin_lock().
+ */
+struct k_spinlock_site_stats {
+	uintptr_t addr;         /**< return address of the lock call, 0 if unused */
+	uint32_t  count;        /**< \# of acquisitions */
+	uint32_t  contended;    /**< \# of acquisitions which had to spin */
+	uint64_t  spins;        /**< \# of spin iterations */
+	uint32_t  max_hold;     /**< longest hold time in cycles */
+};
+
+/**
+ * Contention statistics of a spinlock.
+ */
+struct k_spinlock_stats {
+	const struct k_spinlock *lock; /**< spinlock the statistics are about */
+	uint32_t  count;        /**< \# of acquisitions */
+	uint32_t  contended;    /**< \# of acquisitions which had to spin */
+	uint64_t  spins;        /**< \# of spin iterations */
+	uint32_t  max_spins;    /**< most spin iterations of an acquisition */
+	uint32_t  max_hold;     /**< longest hold time in cycles */
+	/** call sites which acquired the lock */
+	struct k_spinlock_site_stats sites[CONFIG_SPINLOCK_STATS_SITES];
+};
+#endif /* CONFIG_SPINLOCK_STATS */
+
+#if defined(CONFIG_OBJ_CORE_STATS_WAIT) || defined(__DOXYGEN__)
+/**
+ * Contention statistics of a semaphore, mutex, message queue, pipe or
+ * event object.
+ *
+ * Wait times are in cycles of k_cycle_get_32(). The level is the count of
+ * a semaphore, the number of messages in a message queue, the number of
+ * bytes in a pipe and the nesting of a mutex. It is not used by events.
+ */
+struct k_obj_wait_stats {
+	uint32_t  unavailable;  /**< \# of operations which could not complete at once */
+	uint32_t  pended;       /**< \# of operations which pended */
+	uint32_t  timeouts;     /**< \# of pended operations which timed out */
+	uint32_t  waiting;      /**< \# of threads pending now */
+	uint32_t  max_waiting;  /**< most threads pending at once */
+	uint32_t  max_wait;     /**< longest wait */
+	uint64_t  total_wait;   /**< sum of the waits */
+	uint32_t  max_level;    /**< highest level reached */
+};
+#endif /* CONFIG_OBJ_CORE_STATS_WAIT */
+
+/**
+ * Hardware events counted by the performance counters.
+ */
+enum k_perf_event {
+	K_PERF_EVENT_NONE,          /**< counter not in use */
+	K_PERF_EVENT_CYCLES,        /**< CPU cycles */
+	K_PERF_EVENT_INSTRUCTIONS,  /**< instructions retired */
+	K_PERF_EVENT_CACHE_MISSES,  /**< data cache refills */
+	K_PERF_EVENT_BRANCH_MISSES, /**< mispredicted branches */
+	K_PERF_EVENT_STALLS,        /**< cycles stalled waiting for data */
+};
+
+#if defined(CONFIG_PERF_COUNTERS) || defined(__DOXYGEN__)
+/**
+ * Values of the performance counters.
+ */
+struct k_perf_counter_stats {
+	/** event counted by each counter, an enum k_perf_event value */
+	uint8_t   event[CONFIG_PERF_COUNTERS_NUM];
+	/** \# of events counted since the counter was started */
+	uint64_t  count[CONFIG_PERF_COUNTERS_NUM];
+};
+#endif /* CONFIG_PERF_COUNTERS */
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
@@ -119,6 +119,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* CPU whose ready queue holds the thread while queued */
+	uint8_t runq_cpu;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 #endif /* CONFIG_SMP */
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -147,6 +152,16 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	/* Timestamp of the thread being made ready, 0 when not pending */
+	uint32_t ready_stamp;
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	/* Events counted by the performance counters while running */
+	uint64_t perf_counters[CONFIG_PERF_COUNTERS_NUM];
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -199,6 +214,20 @@ struct _mem_domain_info {
 typedef struct _mem_domain_info _mem_domain_info_t;
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+/* Direct-mapped by object address */
+struct _thread_obj_cache {
+	/** cache generation the entries are valid for */
+	long generation;
+	/** validated object pointers, NULL if the slot is empty */
+	const void *obj[CONFIG_OBJ_VALIDATION_CACHE_SIZE];
+	/** kernel object of each pointer */
+	struct k_object *ko[CONFIG_OBJ_VALIDATION_CACHE_SIZE];
+	/** type each pointer was validated as */
+	uint8_t otype[CONFIG_OBJ_VALIDATION_CACHE_SIZE];
+};
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 #ifdef CONFIG_THREAD_USERSPACE_LOCAL_DATA
 struct _thread_userspace_local_data {
 #if defined(CONFIG_ERRNO) && !defined(CONFIG_ERRNO_IN_TLS) && !defined(CONFIG_LIBC_ERRNO)
@@ -240,8 +269,29 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	/*
+	 * Usage over the last 1, 10 and 60 seconds, in thousandths of the
+	 * window, and upper bounds of the 50th, 90th and 99th percentiles
+	 * of the burst durations in cycles. Bursts are bounded as the
+	 * usage windows above. The 60 seconds window moves by steps of 10
+	 * seconds.
+	 */
+	uint32_t window_load[K_USAGE_WINDOWS];
+	uint64_t burst_cycles[K_USAGE_BURST_PERCENTILES];
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	/*
+	 * Events counted by each performance counter while the thread was
+	 * running. Always zero for CPU and system statistics.
+	 */
+	uint64_t perf_counters[CONFIG_PERF_COUNTERS_NUM];
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
-	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL) && \
+	!defined(CONFIG_THREAD_PERF_COUNTERS)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
 	 * which is not allowed in C++ (it'll have a size 1). To prevent this, we add a 1 byte dummy
 	 * variable when the struct would otherwise be empty.
@@ -334,6 +384,11 @@ struct k_thread {
 
 	/** current syscall frame pointer */
 	void *syscall_frame;
+
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	/** kernel objects recently validated for the thread */
+	struct _thread_obj_cache obj_cache;
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
 #endif /* CONFIG_USERSPACE */
 
 
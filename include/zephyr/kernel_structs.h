@@ -30,6 +30,7 @@
 #include <zephyr/kernel/stats.h>
 #include <zephyr/kernel/obj_core.h>
 #include <zephyr/sys/rb.h>
+#include <zephyr/sys/percpu.h>
 #endif
 
 #define K_NUM_THREAD_PRIO (CONFIG_NUM_PREEMPT_PRIORITIES + CONFIG_NUM_COOP_PRIORITIES + 1)
@@ -112,16 +113,23 @@ struct _priq_rb {
 };
 
 
-/* Traditional/textbook "multi-queue" structure.  Separate lists for a
- * small number (max 32 here) of fixed priorities.  This corresponds
- * to the original Zephyr scheduler.  RAM requirements are
- * comparatively high, but performance is very fast.  Won't work with
- * features like deadline scheduling which need large priority spaces
- * to represent their requirements.
+/* Traditional/textbook "multi-queue" structure.  Separate lists for
+ * a fixed number of priorities.  This corresponds to the original
+ * Zephyr scheduler.  RAM requirements are comparatively high, but
+ * performance is very fast.  Won't work with features like deadline
+ * scheduling which need large priority spaces to represent their
+ * requirements.
+ *
+ * When the priorities don't fit in a single bitmask word, a summary
+ * word flags the non-empty ones, so that the highest priority is
+ * always found with two find-first-set operations.
  */
 struct _priq_mq {
 	sys_dlist_t queues[K_NUM_THREAD_PRIO];
 	unsigned long bitmask[PRIQ_BITMAP_SIZE];
+#if PRIQ_BITMAP_SIZE > 1
+	unsigned long bitmask_summary;
+#endif
 #ifndef CONFIG_SMP
 	unsigned int cached_queue_index;
 #endif
@@ -157,7 +165,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -198,7 +206,7 @@ struct _cpu {
 
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
-};
+} __percpu_aligned;
 
 typedef struct _cpu _cpu_t;
 
@@ -213,7 +221,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_Q
 	struct _ready_q ready_q;
 #endif
 
@@ -232,6 +240,10 @@ struct z_kernel {
 	/* Identify CPUs to send IPIs to at the next scheduling point */
 	atomic_t pending_ipi;
 #endif
+#ifdef CONFIG_IPI_COALESCE
+	/* Identify CPUs sent an IPI they did not process yet */
+	atomic_t ipi_in_flight;
+#endif
 };
 
 typedef struct z_kernel _kernel_t;
@@ -305,6 +317,14 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* CPU whose queue holds the timeout */
+	uint8_t cpu;
+#endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be deferred by to share a wakeup */
+	uint32_t slack;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
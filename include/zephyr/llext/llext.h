@@ -148,7 +148,12 @@ static inline unsigned int llext_section_count(const struct llext *ext)
  * This structure contains advanced parameters for @ref llext_load.
  */
 struct llext_load_param {
-	/** Perform local relocation */
+	/**
+	 * Perform local relocation. When cleared together with
+	 * @ref pre_located, the extension must already be linked for its final
+	 * addresses, and read-only sections of an extension in persistent
+	 * storage, such as memory-mapped flash, are executed in place.
+	 */
 	bool relocate_local;
 
 	/**
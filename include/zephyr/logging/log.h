@@ -96,6 +96,114 @@ extern "C" {
 		}						\
 	} while (0)
 
+/**
+ * @brief Writes an ERROR level message to the log, at most @p _limit times per
+ * CONFIG_LOG_RATELIMIT_INTERVAL.
+ *
+ * @details Messages over the limit are dropped before being created and
+ * counted in the periodic report of suppressed messages.
+ *
+ * @param _limit Maximum number of messages per interval.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_ERR_RATELIMIT(_limit, ...) \
+	Z_LOG_RATELIMIT(z_log_ratelimit_check, _limit, LOG_LEVEL_ERR, __VA_ARGS__)
+
+/**
+ * @brief Writes a WARNING level message to the log, at most @p _limit times per
+ * CONFIG_LOG_RATELIMIT_INTERVAL.
+ *
+ * @details Messages over the limit are dropped before being created and
+ * counted in the periodic report of suppressed messages.
+ *
+ * @param _limit Maximum number of messages per interval.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_WRN_RATELIMIT(_limit, ...) \
+	Z_LOG_RATELIMIT(z_log_ratelimit_check, _limit, LOG_LEVEL_WRN, __VA_ARGS__)
+
+/**
+ * @brief Writes an INFO level message to the log, at most @p _limit times per
+ * CONFIG_LOG_RATELIMIT_INTERVAL.
+ *
+ * @details Messages over the limit are dropped before being created and
+ * counted in the periodic report of suppressed messages.
+ *
+ * @param _limit Maximum number of messages per interval.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_INF_RATELIMIT(_limit, ...) \
+	Z_LOG_RATELIMIT(z_log_ratelimit_check, _limit, LOG_LEVEL_INF, __VA_ARGS__)
+
+/**
+ * @brief Writes a DEBUG level message to the log, at most @p _limit times per
+ * CONFIG_LOG_RATELIMIT_INTERVAL.
+ *
+ * @details Messages over the limit are dropped before being created and
+ * counted in the periodic report of suppressed messages.
+ *
+ * @param _limit Maximum number of messages per interval.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_DBG_RATELIMIT(_limit, ...) \
+	Z_LOG_RATELIMIT(z_log_ratelimit_check, _limit, LOG_LEVEL_DBG, __VA_ARGS__)
+
+/**
+ * @brief Writes an ERROR level message to the log on one execution out of @p _n.
+ *
+ * @details The first execution is logged. Other messages are dropped before
+ * being created and counted in the periodic report of suppressed messages.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_ERR_SAMPLED(_n, ...) \
+	Z_LOG_RATELIMIT(z_log_sample_check, _n, LOG_LEVEL_ERR, __VA_ARGS__)
+
+/**
+ * @brief Writes a WARNING level message to the log on one execution out of @p _n.
+ *
+ * @details The first execution is logged. Other messages are dropped before
+ * being created and counted in the periodic report of suppressed messages.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_WRN_SAMPLED(_n, ...) \
+	Z_LOG_RATELIMIT(z_log_sample_check, _n, LOG_LEVEL_WRN, __VA_ARGS__)
+
+/**
+ * @brief Writes an INFO level message to the log on one execution out of @p _n.
+ *
+ * @details The first execution is logged. Other messages are dropped before
+ * being created and counted in the periodic report of suppressed messages.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_INF_SAMPLED(_n, ...) \
+	Z_LOG_RATELIMIT(z_log_sample_check, _n, LOG_LEVEL_INF, __VA_ARGS__)
+
+/**
+ * @brief Writes a DEBUG level message to the log on one execution out of @p _n.
+ *
+ * @details The first execution is logged. Other messages are dropped before
+ * being created and counted in the periodic report of suppressed messages.
+ *
+ * @param _n Sampling period.
+ * @param ... A string optionally containing printk valid conversion specifier,
+ * followed by as many values as specifiers.
+ */
+#define LOG_DBG_SAMPLED(_n, ...) \
+	Z_LOG_RATELIMIT(z_log_sample_check, _n, LOG_LEVEL_DBG, __VA_ARGS__)
+
 /**
  * @brief Unconditionally print raw log message.
  *
@@ -319,6 +427,25 @@ void z_log_vprintk(const char *fmt, va_list ap);
 		  (GET_ARG_N(2, __VA_ARGS__, CONFIG_LOG_DEFAULT_LEVEL)))
 #endif
 
+/* Rate limited and sampled logging. Call site state is kept in an iterable
+ * section so that suppressed messages can be reported. Without a log core,
+ * messages are never suppressed.
+ */
+#if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
+#define Z_LOG_RATELIMIT(_check, _n, _level, ...)						\
+	do {											\
+		static STRUCT_SECTION_ITERABLE(log_ratelimit, _log_ratelimit) = {		\
+			IF_ENABLED(CONFIG_LOG_RATELIMIT_SUMMARY,				\
+				   (.file = __FILE__, .line = __LINE__))			\
+		};										\
+		if (Z_LOG_CONST_LEVEL_CHECK(_level) && _check(&_log_ratelimit, _n)) {		\
+			Z_LOG(_level, __VA_ARGS__);						\
+		}										\
+	} while (false)
+#else
+#define Z_LOG_RATELIMIT(_check, _n, _level, ...) Z_LOG(_level, __VA_ARGS__)
+#endif
+
 /* Return first argument */
 #define _LOG_ARG1(arg1, ...) arg1
 
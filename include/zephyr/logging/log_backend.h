@@ -64,6 +64,9 @@ struct log_backend_api {
 	void (*process)(const struct log_backend *const backend,
 			union log_msg_generic *msg);
 
+	void (*process_batch)(const struct log_backend *const backend,
+			      union log_msg_generic **msgs, size_t cnt);
+
 	void (*dropped)(const struct log_backend *const backend, uint32_t cnt);
 	void (*panic)(const struct log_backend *const backend);
 	void (*init)(const struct log_backend *const backend);
@@ -182,6 +185,32 @@ static inline void log_backend_msg_process(const struct log_backend *const backe
 	backend->api->process(backend, msg);
 }
 
+/**
+ * @brief Process a batch of messages.
+ *
+ * Function is optional. If the backend does not implement it, messages are
+ * processed one by one.
+ *
+ * @param[in] backend  Pointer to the backend instance.
+ * @param[in] msgs     Array of messages, in processing order.
+ * @param[in] cnt      Number of messages.
+ */
+static inline void log_backend_msg_process_batch(const struct log_backend *const backend,
+						 union log_msg_generic **msgs, size_t cnt)
+{
+	__ASSERT_NO_MSG(backend != NULL);
+	__ASSERT_NO_MSG(msgs != NULL);
+
+	if (backend->api->process_batch != NULL) {
+		backend->api->process_batch(backend, msgs, cnt);
+		return;
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		backend->api->process(backend, msgs[i]);
+	}
+}
+
 /**
  * @brief Notify backend about dropped log messages.
  *
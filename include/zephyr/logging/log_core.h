@@ -517,6 +517,65 @@ void z_log_printf_arg_checker(const char *fmt, ...)
 	ARG_UNUSED(fmt);
 }
 
+/** @brief State of a rate limited or sampled logging call site. */
+struct log_ratelimit {
+	/** Messages in the current interval, or since the start if sampled. */
+	atomic_t count;
+	/** Start of the current interval in milliseconds. */
+	atomic_t start;
+	/** Messages suppressed since the last report. */
+	atomic_t suppressed;
+#if defined(CONFIG_LOG_RATELIMIT_SUMMARY)
+	const char *file;
+	uint32_t line;
+#endif
+};
+
+/** @brief Count a message suppressed by a call site.
+ *
+ * @param rl Call site state.
+ *
+ * @return false.
+ */
+static inline bool z_log_ratelimit_suppress(struct log_ratelimit *rl)
+{
+#if defined(CONFIG_LOG_RATELIMIT_SUMMARY)
+	extern atomic_t z_log_suppressed_cnt;
+
+	atomic_inc(&z_log_suppressed_cnt);
+#endif
+	atomic_inc(&rl->suppressed);
+
+	return false;
+}
+
+/** @brief Check if a rate limited message shall be created.
+ *
+ * @param rl    Call site state.
+ * @param limit Maximum number of messages per CONFIG_LOG_RATELIMIT_INTERVAL.
+ *
+ * @retval true Continue with log message creation.
+ * @retval false Drop that message.
+ */
+bool z_log_ratelimit_check(struct log_ratelimit *rl, uint32_t limit);
+
+/** @brief Check if a sampled message shall be created.
+ *
+ * @param rl Call site state.
+ * @param n  One message out of @p n is created, starting with the first one.
+ *
+ * @retval true Continue with log message creation.
+ * @retval false Drop that message.
+ */
+static inline bool z_log_sample_check(struct log_ratelimit *rl, uint32_t n)
+{
+	if (((uint32_t)atomic_inc(&rl->count) % n) == 0U) {
+		return true;
+	}
+
+	return z_log_ratelimit_suppress(rl);
+}
+
 /**
  * @brief Write a generic log message.
  *
@@ -57,6 +57,13 @@ extern "C" {
 /** @brief Flag forcing to skip logging the source. */
 #define LOG_OUTPUT_FLAG_SKIP_SOURCE		BIT(8)
 
+/** @brief Flag preventing the flush of the output buffer after the message.
+ *
+ * Used when processing a batch of messages, the caller then flushes the
+ * output with @ref log_output_flush after the last message.
+ */
+#define LOG_OUTPUT_FLAG_NO_FLUSH		BIT(9)
+
 /**@} */
 
 /** @brief Supported backend logging format types for use
@@ -90,6 +97,10 @@ struct log_output_control_block {
 	atomic_t offset;
 	void *ctx;
 	const char *hostname;
+#if defined(CONFIG_LOG_DICTIONARY_FRAMING)
+	uint8_t frame[CONFIG_LOG_DICTIONARY_FRAME_SIZE];
+	uint16_t frame_len;
+#endif
 };
 
 /** @brief Log_output instance structure. */
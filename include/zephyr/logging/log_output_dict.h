@@ -47,6 +47,35 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/** First byte of a frame header. */
+#define LOG_DICT_OUTPUT_FRAME_MAGIC0 0x5A
+/** Second byte of a frame header. */
+#define LOG_DICT_OUTPUT_FRAME_MAGIC1 0x4C
+
+/** Frame payload is compressed. */
+#define LOG_DICT_OUTPUT_FRAME_COMPRESSED BIT(0)
+
+/**
+ * Header of a frame of dictionary based log messages, used with
+ * CONFIG_LOG_DICTIONARY_FRAMING.
+ *
+ * A frame holds a whole number of messages. The header is followed by the
+ * payload, compressed if @ref LOG_DICT_OUTPUT_FRAME_COMPRESSED is set, and by
+ * the CRC-16/CCITT of the uncompressed payload. Multi-byte fields of the
+ * frame header and CRC are little endian.
+ *
+ * A compressed payload is a sequence of tokens. A token byte below 0x80 is
+ * followed by (token + 1) literal bytes. A token byte of 0x80 or above is
+ * followed by a 2 byte distance and copies ((token & 0x7F) + 3) bytes
+ * starting that far back in the uncompressed payload.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t magic[2];
+	uint8_t flags;
+	/** Length of the uncompressed payload. */
+	uint16_t len;
+} __packed;
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
@@ -204,6 +204,16 @@ struct img_mgmt_state {
 	/** Hash of image data; used for resumption of a partial upload. */
 	uint8_t data_sha_len;
 	uint8_t data_sha[IMG_MGMT_DATA_SHA_LEN];
+#if defined(CONFIG_IMG_STREAM_HASH) || defined(__DOXYGEN__)
+	/** Hash of the image data written so far, computed while writing it. */
+	uint8_t written_sha[IMG_MGMT_DATA_SHA_LEN];
+	/** Whether written_sha holds the hash of the complete uploaded image. */
+	bool written_sha_valid;
+#endif
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA) || defined(__DOXYGEN__)
+	/** Flash area the uploaded patch applies to; -1 if uploading an image. */
+	int delta_area_id;
+#endif
 };
 
 /** Describes what to do during processing of an upload request. */
@@ -218,6 +228,12 @@ struct img_mgmt_upload_action {
 	bool proceed;
 	/** Whether to erase the destination flash area. */
 	bool erase;
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA) || defined(__DOXYGEN__)
+	/** Flash area the uploaded patch applies to; -1 if uploading an image. */
+	int delta_area_id;
+	/** Size of the image the uploaded patch produces. */
+	size_t delta_image_size;
+#endif
 #ifdef CONFIG_MCUMGR_GRP_IMG_VERBOSE_ERR
 	/** "rsn" string to be sent as explanation for "rc" code */
 	const char *rc_rsn;
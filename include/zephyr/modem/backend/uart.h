@@ -8,6 +8,7 @@
 #include <zephyr/types.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_async_rx.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <zephyr/sys/atomic.h>
 
@@ -58,10 +59,9 @@ struct modem_backend_uart_async {
 
 struct modem_backend_uart_async {
 	struct modem_backend_uart_async_common common;
-	uint8_t *receive_bufs[2];
-	uint32_t receive_buf_size;
-	struct ring_buf receive_rb;
-	struct k_spinlock receive_rb_lock;
+	struct uart_async_rx receive_rx;
+	struct uart_async_rx_config receive_rx_config;
+	atomic_t receive_buf_req_pending;
 };
 
 #endif /* CONFIG_MODEM_BACKEND_UART_ASYNC_HWFC */
@@ -12,6 +12,10 @@
 #ifndef ZEPHYR_INCLUDE_MULTI_HEAP_MANAGER_SMH_H_
 #define ZEPHYR_INCLUDE_MULTI_HEAP_MANAGER_SMH_H_
 
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/mem_stats.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,6 +62,15 @@ extern "C" {
  *    take care of selecting the correct heap (thus memory region) to carve
  *    memory from, based on the opaque parameter and the runtime state of the
  *    heaps (available memory, heap state, etc...)
+ *
+ *  - Regions with the same attribute are tried by increasing rank, e.g. the
+ *    lowest latency or highest bandwidth memory first. When all of them are
+ *    full, the allocation can spill over to the regions of a compatible
+ *    attribute set with @ref shared_multi_heap_spill_set.
+ *
+ * Each region has its own lock, so concurrent allocations from different
+ * regions do not contend. Regions must be added before the pool is used
+ * concurrently.
  */
 
 /**
@@ -98,6 +111,28 @@ struct shared_multi_heap_region {
 
 	/** Memory heap size in bytes */
 	size_t size;
+	/**
+	 * Allocation preference among the regions with the same attribute,
+	 * lowest first. Regions with the same rank are tried in the order
+	 * they were added.
+	 */
+	uint32_t rank;
+};
+
+/**
+ * @brief SMH region statistics
+ *
+ * @see shared_multi_heap_stats_get
+ */
+struct shared_multi_heap_stats {
+	/** Memory usage of the region */
+	struct sys_memory_stats heap;
+	/** Number of successful allocations */
+	unsigned long alloc_cnt;
+	/** Number of allocations the region could not satisfy */
+	unsigned long fail_cnt;
+	/** Number of allocations spilled over from another attribute */
+	unsigned long spill_cnt;
 };
 
 /**
@@ -176,6 +211,42 @@ void shared_multi_heap_free(void *block);
  */
 int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_data);
 
+/**
+ * @brief Set the attribute an attribute spills over to
+ *
+ * When no region with attribute @p attr can satisfy an allocation, the
+ * regions with attribute @p spill are tried, then the ones of its own
+ * spill attribute and so on. Only attributes whose memory is suitable for
+ * all users of @p attr must be chained this way, e.g. internal cacheable
+ * SRAM spilling over to external cacheable DDR.
+ *
+ * @param attr		attribute to configure.
+ * @param spill		attribute to fall back to, or
+ *			MAX_SHARED_MULTI_HEAP_ATTR for none (default).
+ *
+ * @retval 0		on success.
+ * @retval -EINVAL	when an attribute is out-of-bound or @p spill is @p attr.
+ */
+int shared_multi_heap_spill_set(enum shared_multi_heap_attr attr,
+				enum shared_multi_heap_attr spill);
+
+/**
+ * @brief Get the statistics of a region
+ *
+ * @note Requires CONFIG_SHARED_MULTI_HEAP_STATS.
+ *
+ * @param attr		attribute of the region.
+ * @param idx		index of the region among those of @p attr, in rank
+ *			order.
+ * @param stats		pointer to the statistics to fill.
+ *
+ * @retval 0		on success.
+ * @retval -EINVAL	when the attribute is out-of-bound or @p stats is NULL.
+ * @retval -ENOENT	when there is no such region.
+ */
+int shared_multi_heap_stats_get(enum shared_multi_heap_attr attr, unsigned int idx,
+				struct shared_multi_heap_stats *stats);
+
 /**
  * @}
  */
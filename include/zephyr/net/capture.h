@@ -333,6 +333,133 @@ static inline void net_capture_data(struct net_capture_cooked *ctx,
 }
 #endif
 
+/** Packet header captured into the capture ring buffer */
+struct net_capture_record {
+	/** Capture time, in hardware cycles (see k_cycle_get_32()) */
+	uint32_t timestamp;
+	/** Length of the packet */
+	uint32_t len;
+	/** Number of bytes of the packet in @a data */
+	uint16_t caplen;
+	/** Network interface the packet was captured on */
+	struct net_if *iface;
+	/** Start of the packet */
+	const uint8_t *data;
+};
+
+/**
+ * @typedef net_capture_ring_filter_t
+ * @brief Callback deciding whether a packet is captured into the ring buffer
+ *
+ * Called for every packet before anything is copied, from the context
+ * sending or receiving the packet, so it must be short.
+ *
+ * @param iface Network interface the packet is sent or received on
+ * @param pkt The network packet
+ * @param user_data User data given to net_capture_ring_enable()
+ *
+ * @return True if the packet is to be captured, false otherwise.
+ */
+typedef bool (*net_capture_ring_filter_t)(struct net_if *iface, struct net_pkt *pkt,
+					  void *user_data);
+
+/**
+ * @typedef net_capture_ring_cb_t
+ * @brief Callback called for each record drained from the ring buffer
+ *
+ * @param record The captured record, valid only during the call
+ * @param user_data User data given to net_capture_ring_drain()
+ */
+typedef void (*net_capture_ring_cb_t)(const struct net_capture_record *record,
+				      void *user_data);
+
+#if defined(CONFIG_NET_CAPTURE_RING) || defined(__DOXYGEN__)
+/**
+ * @brief Start capturing packet headers into the ring buffer.
+ *
+ * @details The first @kconfig{CONFIG_NET_CAPTURE_RING_SNAPLEN} bytes of the
+ * packets are stored with a timestamp, without cloning the packets. Any
+ * record left in the buffer from a previous capture is discarded.
+ *
+ * @param iface Network interface to capture, NULL for all of them.
+ * @param filter Filter deciding which packets to capture, NULL for all.
+ * @param user_data User data given to the filter.
+ *
+ * @return 0 if ok, -EALREADY if the capture is already enabled.
+ */
+int net_capture_ring_enable(struct net_if *iface, net_capture_ring_filter_t filter,
+			    void *user_data);
+
+/**
+ * @brief Stop capturing packet headers into the ring buffer.
+ *
+ * @details The records in the buffer can still be drained.
+ *
+ * @return 0 if ok, -EALREADY if the capture is not enabled.
+ */
+int net_capture_ring_disable(void);
+
+/**
+ * @brief Drain the records of the ring buffer.
+ *
+ * @details Calls @a cb for every record in the buffer, oldest first, and
+ * frees them. Only one thread may drain the buffer at a time.
+ *
+ * @param cb Callback to call for each record.
+ * @param user_data User data given to the callback.
+ *
+ * @return Number of records drained, <0 on error.
+ */
+int net_capture_ring_drain(net_capture_ring_cb_t cb, void *user_data);
+
+/**
+ * @brief Number of packets that could not be recorded since the capture
+ *        was enabled, because the ring buffer was full.
+ *
+ * @return Number of dropped packets.
+ */
+uint32_t net_capture_ring_dropped(void);
+
+/** @cond INTERNAL_HIDDEN */
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt);
+/** @endcond */
+#else
+static inline int net_capture_ring_enable(struct net_if *iface,
+					  net_capture_ring_filter_t filter,
+					  void *user_data)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(filter);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+
+static inline int net_capture_ring_disable(void)
+{
+	return -ENOTSUP;
+}
+
+static inline int net_capture_ring_drain(net_capture_ring_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+
+static inline uint32_t net_capture_ring_dropped(void)
+{
+	return 0;
+}
+
+static inline void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+}
+#endif
+
 struct net_capture_info {
 	const struct device *capture_dev;
 	struct net_if *capture_iface;
@@ -89,6 +89,19 @@ struct coap_client_option {
 };
 
 /** @cond INTERNAL_HIDDEN */
+#if CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1
+struct coap_client_block2_slot {
+	uint32_t num;
+	uint16_t mid;
+	uint16_t len;
+	uint8_t code;
+	bool sent;
+	bool received;
+	bool more;
+	uint8_t payload[CONFIG_COAP_CLIENT_BLOCK_SIZE];
+};
+#endif
+
 struct coap_client_internal_request {
 	uint8_t request_token[COAP_TOKEN_MAX_LEN];
 	uint32_t offset;
@@ -106,6 +119,13 @@ struct coap_client_internal_request {
 	/* For GETs with observe option set */
 	bool is_observe;
 	int last_response_id;
+
+#if CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1
+	/* Block2 requests sent ahead of the current block */
+	struct coap_client_block2_slot block2_slots[CONFIG_COAP_CLIENT_BLOCK2_WINDOW - 1];
+	uint32_t block2_last;
+	bool block2_last_known;
+#endif
 };
 
 struct coap_client {
@@ -47,6 +47,9 @@ struct coap_service_data {
 	int sock_fd;
 	struct coap_observer observers[CONFIG_COAP_SERVICE_OBSERVERS];
 	struct coap_pending pending[CONFIG_COAP_SERVICE_PENDING_MESSAGES];
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+	uint16_t index_root;
+#endif
 };
 
 struct coap_service {
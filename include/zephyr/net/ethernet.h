@@ -208,6 +208,9 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE	= BIT(22),
+
+	/** TCP segmentation offload supported, see net_pkt_tso_mss() */
+	ETHERNET_HW_TSO			= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -727,6 +730,11 @@ struct ethernet_context {
 
 	/** Types of Ethernet network interfaces */
 	enum ethernet_if_types eth_if_type;
+
+#if defined(CONFIG_NET_ETHERNET_NAPI)
+	/** Polled reception context of the driver, if it uses one */
+	struct net_eth_napi *napi;
+#endif
 };
 
 /**
@@ -1306,6 +1314,110 @@ void net_eth_carrier_on(struct net_if *iface);
  */
 void net_eth_carrier_off(struct net_if *iface);
 
+/** @cond INTERNAL_HIDDEN */
+#define NET_ETH_NAPI_SCHED 0
+/** @endcond */
+
+struct net_eth_napi;
+
+/**
+ * @typedef net_eth_napi_poll_t
+ * @brief Receive frames from the driver RX ring.
+ *
+ * Called with the RX interrupt of the driver disabled. The handler passes
+ * the received frames to net_recv_data() as usual.
+ *
+ * @param napi Polled reception context.
+ * @param budget Maximum number of frames to receive.
+ *
+ * @return Number of frames received. If less than @a budget, the ring is
+ * considered empty and the RX interrupt is re-enabled.
+ */
+typedef int (*net_eth_napi_poll_t)(struct net_eth_napi *napi, int budget);
+
+/**
+ * @typedef net_eth_napi_irq_enable_t
+ * @brief Re-enable the RX interrupt of the driver.
+ *
+ * If the controller does not latch RX events that happen while its
+ * interrupt is disabled, the driver must check for pending frames here and
+ * call net_eth_napi_schedule() if there are any.
+ *
+ * @param napi Polled reception context.
+ */
+typedef void (*net_eth_napi_irq_enable_t)(struct net_eth_napi *napi);
+
+/**
+ * @brief Polled reception context of an Ethernet driver.
+ *
+ * Embedded in the driver data and initialized with net_eth_napi_init().
+ */
+struct net_eth_napi {
+	/** Work item running the poll handler */
+	struct k_work work;
+
+	/** Network interface */
+	struct net_if *iface;
+
+	/** Poll handler of the driver */
+	net_eth_napi_poll_t poll;
+
+	/** RX interrupt enable function of the driver */
+	net_eth_napi_irq_enable_t irq_enable;
+
+	/** Scheduling state */
+	atomic_t state;
+};
+
+#if defined(CONFIG_NET_ETHERNET_NAPI)
+/**
+ * @brief Initialize polled reception for an Ethernet driver.
+ *
+ * Called from the interface init function of the driver, after
+ * ethernet_init().
+ *
+ * @param napi Polled reception context.
+ * @param iface Network interface.
+ * @param poll Poll handler.
+ * @param irq_enable RX interrupt enable function.
+ */
+void net_eth_napi_init(struct net_eth_napi *napi, struct net_if *iface,
+		       net_eth_napi_poll_t poll,
+		       net_eth_napi_irq_enable_t irq_enable);
+
+/**
+ * @brief Schedule the poll handler.
+ *
+ * Called from the RX interrupt handler of the driver, after disabling the
+ * RX interrupt.
+ *
+ * @param napi Polled reception context.
+ *
+ * @return True if scheduled, false if a poll was already pending.
+ */
+bool net_eth_napi_schedule(struct net_eth_napi *napi);
+
+/**
+ * @brief Run the poll handler of an interface in the calling thread.
+ *
+ * Used to busy poll for frames while a socket waits for data, see
+ * SO_BUSY_POLL. Does nothing if a poll is already pending.
+ *
+ * @param iface Network interface.
+ *
+ * @return Number of frames received, <0 if the interface does not
+ * support polled reception.
+ */
+int net_eth_napi_busy_poll(struct net_if *iface);
+#else
+static inline int net_eth_napi_busy_poll(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_ETHERNET_NAPI */
+
 /**
  * @brief Set promiscuous mode either ON or OFF.
  *
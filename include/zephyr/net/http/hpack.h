@@ -104,6 +104,38 @@ enum http_hpack_static_key {
 #define HTTP_SERVER_HUFFMAN_DECODE_BUFFER_SIZE 0
 #endif
 
+/* RFC7541, ch 4.1, size accounted for each dynamic table entry on top of the
+ * header field name and value lengths.
+ */
+#define HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD 32
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+
+struct http_hpack_dynamic_entry {
+	uint16_t offset;
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+/* HPACK decoder dynamic table. Header field names and values are stored back
+ * to back in a circular buffer, entries is a circular array of the table
+ * entries, oldest first.
+ */
+struct http_hpack_dynamic_table {
+	struct http_hpack_dynamic_entry entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE /
+						HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD];
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+	uint32_t size;
+	uint32_t max_size;
+	uint16_t first;
+	uint16_t count;
+	uint16_t head;
+};
+#else
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE 0
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 /** @endcond */
 
 /** HTTP2 header field with decoding buffer. */
@@ -125,6 +157,9 @@ struct http_hpack_header_buf {
 
 	/** Length of the data in the decoding buffer. */
 	size_t datalen;
+
+	/** Dynamic table used when decoding, NULL if not used. */
+	struct http_hpack_dynamic_table *dynamic_table;
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -137,6 +172,8 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 			     struct http_hpack_header_buf *header);
 int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 			     struct http_hpack_header_buf *header);
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table,
+				   uint32_t max_size);
 
 /** @endcond */
 
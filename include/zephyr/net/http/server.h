@@ -440,6 +440,12 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+/** @cond INTERNAL_HIDDEN */
+	/** HTTP/2 HPACK decoder dynamic table. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE,
+		   (struct http_hpack_dynamic_table hpack_table));
+/** @endcond */
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -490,6 +496,11 @@ struct http_client_ctx {
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (uint8_t supported_compression));
 /** @endcond */
 
+/** @cond INTERNAL_HIDDEN */
+	/** Entity tag of the If-None-Match request header. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE, (uint32_t if_none_match));
+/** @endcond */
+
 	/** Flag indicating that HTTP2 preface was sent. */
 	bool preface_sent : 1;
 
@@ -511,6 +522,12 @@ struct http_client_ctx {
 	/** Flag indicating accept encoding is being processed. */
 	IF_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION, (bool accept_encoding_next: 1));
 
+	/** Flag indicating If-None-Match is being processed. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE, (bool if_none_match_next : 1));
+
+	/** Flag indicating a valid If-None-Match header was received. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE, (bool if_none_match_set : 1));
+
 	/** The next frame on the stream is expectd to be a continuation frame. */
 	bool expect_continuation : 1;
 };
@@ -544,6 +561,15 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Drop all the static filesystem resources cached by the server.
+ *
+ * The cache notices a file changing size on its own. An application
+ * modifying a file served through @ref HTTP_RESOURCE_TYPE_STATIC_FS without
+ * changing its size shall call this function afterwards.
+ * Only available if CONFIG_HTTP_SERVER_STATIC_FS_CACHE is enabled.
+ */
+void http_server_fs_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
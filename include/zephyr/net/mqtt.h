@@ -877,6 +877,16 @@ struct mqtt_internal {
 	/** Internal. Remaining payload length to read. */
 	uint32_t remaining_payload;
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW) || defined(__DOXYGEN__)
+	/** Internal. Packet identifiers of the unacknowledged QoS 1 and QoS 2
+	 *  messages, hashed with linear probing. Zero marks a free slot.
+	 */
+	uint16_t inflight_ids[NHPOT(2 * CONFIG_MQTT_INFLIGHT_MAX)];
+
+	/** Internal. Number of unacknowledged QoS 1 and QoS 2 messages. */
+	uint16_t inflight_count;
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 #if defined(CONFIG_MQTT_VERSION_5_0) || defined(__DOXYGEN__)
 	/** Internal. MQTT 5.0 topic alias mapping. */
 	struct mqtt_topic_alias topic_aliases[CONFIG_MQTT_TOPIC_ALIAS_MAX];
@@ -1077,10 +1087,36 @@ int mqtt_connect(struct mqtt_client *client);
  *                  Shall not be NULL.
  *
  * @return 0 or a negative error code (errno.h) indicating reason of failure.
+ *         -EAGAIN is returned when @kconfig{CONFIG_MQTT_INFLIGHT_WINDOW} is
+ *         enabled and @kconfig{CONFIG_MQTT_INFLIGHT_MAX} QoS 1 or QoS 2
+ *         messages are already waiting for an acknowledgment.
  */
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param);
 
+/**
+ * @brief API to publish several messages with a single transport write.
+ *
+ * The messages are sent in order. Sending stops at the first message that
+ * does not fit in the client's TX buffer, cannot be encoded, or would exceed
+ * the in-flight window (@kconfig{CONFIG_MQTT_INFLIGHT_MAX}); the caller is
+ * expected to publish the remaining messages later.
+ *
+ * @param[in] client Client instance for which the procedure is requested.
+ *                   Shall not be NULL.
+ * @param[in] params Parameters to be used for the publish messages.
+ *                   Shall not be NULL.
+ * @param[in] count Number of entries in @p params, at most
+ *                  @kconfig{CONFIG_MQTT_PUBLISH_BATCH_MAX} are sent.
+ *
+ * @return Number of messages published or a negative error code (errno.h)
+ *         indicating reason of failure when none could be published.
+ *         -EAGAIN is returned when the in-flight window is full.
+ */
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params,
+		       size_t count);
+
 /**
  * @brief API used by client to send acknowledgment on receiving QoS1 publish
  *        message. Should be called on reception of @ref MQTT_EVT_PUBLISH with
@@ -122,6 +122,24 @@ typedef void (*net_context_send_cb_t)(struct net_context *context,
 				      int status,
 				      void *user_data);
 
+/**
+ * @typedef net_context_zerocopy_cb_t
+ * @brief Zero-copy send completion callback.
+ *
+ * @details The callback is called once the network stack does not use a
+ * buffer given to net_context_send_zerocopy() anymore. It is called from
+ * the context releasing the last reference to the data, which may be the
+ * TCP work queue or a network driver, so it must not block.
+ *
+ * @param buf Start of the data which was queued.
+ * @param len Number of bytes which were queued.
+ * @param status 0 if all the data was acknowledged by the peer, a negative
+ * errno if the connection was closed before.
+ * @param user_data The user data given to net_context_send_zerocopy().
+ */
+typedef void (*net_context_zerocopy_cb_t)(const void *buf, size_t len,
+					  int status, void *user_data);
+
 /**
  * @typedef net_tcp_accept_cb_t
  * @brief Accept callback
@@ -347,6 +365,10 @@ __net_socket struct net_context {
 		/** Send buffer maximum size */
 		uint16_t sndbuf;
 #endif
+#if defined(CONFIG_NET_CONTEXT_BUSY_POLL)
+		/** Busy poll time in microseconds */
+		uint16_t busy_poll;
+#endif
 #if defined(CONFIG_NET_CONTEXT_DSCP_ECN)
 		/**
 		 * DSCP (Differentiated Services Code point) and
@@ -1310,6 +1332,31 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send data on a TCP connection without copying it.
+ *
+ * @details The data is referenced by the network buffers and must stay
+ * valid and unmodified until @p cb is called. Like net_context_send(),
+ * this queues no more than the send window allows, so the caller may
+ * need to send the rest later. Each call that queues data is completed
+ * with its own call of @p cb.
+ * Only available with @kconfig{CONFIG_NET_TCP_ZEROCOPY}.
+ *
+ * @param context The network context to use.
+ * @param buf The data to send.
+ * @param len Number of bytes to send.
+ * @param cb Callback called when the data is no longer used.
+ * @param user_data Caller-supplied user data passed to @p cb.
+ *
+ * @return number of bytes queued on success, a negative errno otherwise.
+ * -EAGAIN means that the send window is full.
+ */
+int net_context_send_zerocopy(struct net_context *context,
+			      const void *buf,
+			      size_t len,
+			      net_context_zerocopy_cb_t cb,
+			      void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1399,6 +1446,7 @@ enum net_context_option {
 	NET_OPT_LOCAL_PORT_RANGE  = 21, /**< Clamp local port range */
 	NET_OPT_IPV6_MCAST_LOOP	  = 22, /**< IPV6 multicast loop */
 	NET_OPT_IPV4_MCAST_LOOP	  = 23, /**< IPV4 multicast loop */
+	NET_OPT_BUSY_POLL         = 24, /**< Busy poll time */
 };
 
 /**
@@ -632,7 +632,7 @@ struct net_traffic_class {
 	struct k_fifo fifo;
 
 #if NET_TC_COUNT > 1 || defined(CONFIG_NET_TC_TX_SKIP_FOR_HIGH_PRIO) \
-	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO)
+	|| defined(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) || defined(CONFIG_NET_RX_RSS)
 	/** Semaphore for tracking the available slots in the fifo */
 	struct k_sem fifo_slot;
 #endif
@@ -720,6 +720,13 @@ struct net_if {
 	/** Network statistics related to this network interface */
 	struct net_stats stats;
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	/** Copies of the statistics updated by each CPU, summed into
+	 * @a stats when they are read.
+	 */
+	struct net_stats_cpu stats_cpu[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 	/** Promethus collector for this network interface */
 	IF_ENABLED(CONFIG_NET_STATISTICS_VIA_PROMETHEUS,
 		   (struct prometheus_collector *collector);)
@@ -264,6 +264,12 @@ struct msghdr {
 	int           msg_flags;      /**< Flags on received message */
 };
 
+/** Message of a zsock_sendmmsg() or zsock_recvmmsg() batch */
+struct mmsghdr {
+	struct msghdr msg_hdr;        /**< Message to send or receive */
+	unsigned int  msg_len;        /**< Number of bytes sent or received */
+};
+
 /** Control message ancillary data */
 struct cmsghdr {
 	socklen_t cmsg_len;    /**< Number of bytes, including header */
@@ -360,6 +360,16 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_RX_RSS)
+	/* Hardware queue the packet was received on plus 1, 0 if unknown */
+	uint8_t rx_queue;
+#endif /* CONFIG_NET_RX_RSS */
+
+#if defined(CONFIG_NET_TCP_TSO)
+	/* Size of the segments to split this TCP packet into, 0 if none */
+	uint16_t tso_mss;
+#endif /* CONFIG_NET_TCP_TSO */
+
 	/* @endcond */
 };
 
@@ -1058,6 +1068,56 @@ static inline void net_pkt_set_priority(struct net_pkt *pkt,
 	pkt->priority = priority;
 }
 
+#if defined(CONFIG_NET_RX_RSS)
+static inline int net_pkt_rx_queue(struct net_pkt *pkt)
+{
+	return (int)pkt->rx_queue - 1;
+}
+
+static inline void net_pkt_set_rx_queue(struct net_pkt *pkt, uint8_t queue)
+{
+	pkt->rx_queue = queue + 1U;
+}
+#else
+static inline int net_pkt_rx_queue(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return -1;
+}
+
+static inline void net_pkt_set_rx_queue(struct net_pkt *pkt, uint8_t queue)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(queue);
+}
+#endif /* CONFIG_NET_RX_RSS */
+
+#if defined(CONFIG_NET_TCP_TSO)
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	return pkt->tso_mss;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	pkt->tso_mss = mss;
+}
+#else
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(mss);
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 #if defined(CONFIG_NET_CAPTURE_COOKED_MODE)
 static inline bool net_pkt_is_cooked_mode(struct net_pkt *pkt)
 {
@@ -1641,6 +1701,11 @@ struct net_buf *net_pkt_get_frag_debug(struct net_pkt *pkt, size_t min_len,
 void net_pkt_unref_debug(struct net_pkt *pkt, const char *caller, int line);
 #define net_pkt_unref(pkt) net_pkt_unref_debug(pkt, __func__, __LINE__)
 
+void net_pkt_unref_bulk_debug(struct net_pkt **pkts, int count,
+			      const char *caller, int line);
+#define net_pkt_unref_bulk(pkts, count)					\
+	net_pkt_unref_bulk_debug(pkts, count, __func__, __LINE__)
+
 struct net_pkt *net_pkt_ref_debug(struct net_pkt *pkt, const char *caller,
 				  int line);
 #define net_pkt_ref(pkt) net_pkt_ref_debug(pkt, __func__, __LINE__)
@@ -1771,6 +1836,18 @@ struct net_buf *net_pkt_get_frag(struct net_pkt *pkt, size_t min_len,
  *
  */
 void net_pkt_unref(struct net_pkt *pkt);
+
+/**
+ * @brief Release several packets at once
+ *
+ * @details Drops one reference from each packet, e.g. for a batch of
+ * TX completions reported by a driver.  The buffers of the packets
+ * released are handed back to their pools together.
+ *
+ * @param pkts  Array of network packets to release.
+ * @param count Number of packets in @a pkts.
+ */
+void net_pkt_unref_bulk(struct net_pkt **pkts, int count);
 #endif
 
 #if !defined(NET_PKT_DEBUG_ENABLED)
@@ -1969,6 +2046,16 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer_debug(struct net_if *iface,
 					   _proto, _timeout,		\
 					   __func__, __LINE__)
 
+int net_pkt_rx_alloc_bulk_debug(struct net_if *iface, size_t size,
+				sa_family_t family,
+				enum net_ip_protocol proto,
+				struct net_pkt **pkts, int count,
+				const char *caller, int line);
+#define net_pkt_rx_alloc_bulk(_iface, _size, _family, _proto,		\
+			      _pkts, _count)				\
+	net_pkt_rx_alloc_bulk_debug(_iface, _size, _family, _proto,	\
+				    _pkts, _count, __func__, __LINE__)
+
 int net_pkt_alloc_buffer_with_reserve_debug(struct net_pkt *pkt,
 					    size_t size,
 					    size_t reserve,
@@ -2145,6 +2232,27 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
 
 /** @endcond */
 
+/**
+ * @brief Allocate several RX network packets and their buffers at once
+ *
+ * @details Never blocks: as many packets as can be allocated right away
+ * are returned, e.g. to refill the receive descriptor ring of a driver.
+ * When the buffer of each packet fits in a single fragment, all the
+ * fragments are taken from the RX data pool in one go.
+ *
+ * @param iface  The network interface the packets are received on.
+ * @param size   The size of buffer of each packet.
+ * @param family The family to which the packets belong.
+ * @param proto  The IP protocol type (can be 0 for none).
+ * @param pkts   Array to store the packets in.
+ * @param count  Number of packets requested.
+ *
+ * @return Number of packets allocated, stored first in @a pkts.
+ */
+int net_pkt_rx_alloc_bulk(struct net_if *iface, size_t size,
+			  sa_family_t family, enum net_ip_protocol proto,
+			  struct net_pkt **pkts, int count);
+
 #endif
 
 /**
@@ -505,6 +505,15 @@ struct net_stats {
 #endif
 };
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Copy of the statistics updated by a single CPU */
+struct net_stats_cpu {
+	struct net_stats stats;
+};
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+/** @endcond */
+
 /**
  * @brief Ethernet error statistics
  */
@@ -17,6 +17,7 @@
  */
 
 #include <zephyr/net/prometheus/collector.h>
+#include <zephyr/net/http/server.h>
 
 /**
  * @brief Format exposition data for Prometheus
@@ -49,6 +50,72 @@ int prometheus_format_exposition(struct prometheus_collector *collector, char *b
 int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 				 size_t buffer_size, int *written);
 
+/**
+ * @brief Format the next chunk of exposition data for Prometheus
+ *
+ * Formats as many whole metrics of the collector as fit into the buffer,
+ * starting where the previous call stopped. The walk context must be
+ * initialized with @ref prometheus_collector_walk_init, and is in the
+ * PROMETHEUS_WALK_STOP state once all the metrics are written. The collector
+ * is only locked during each call.
+ *
+ * @param ctx Pointer to the walker context.
+ * @param buffer Pointer to the buffer where the chunk will be stored.
+ * @param buffer_size Size of the buffer.
+ *
+ * @return Number of bytes written on success, negative errno on error.
+ *         -ENOMEM means that a single metric does not fit into the buffer.
+ */
+int prometheus_format_exposition_chunk(struct prometheus_collector_walk_context *ctx,
+				       char *buffer, size_t buffer_size);
+
+/**
+ * @brief Context of a streamed scrape
+ *
+ * Use @ref PROMETHEUS_SCRAPE_CTX_DEFINE to define one.
+ */
+struct prometheus_scrape_ctx {
+	/** @cond INTERNAL_HIDDEN */
+	struct prometheus_collector_walk_context walk;
+	char buffer[CONFIG_PROMETHEUS_SCRAPE_CHUNK_SIZE];
+	/** @endcond */
+};
+
+/**
+ * @brief Define a scrape context for a collector
+ *
+ * @param _name Name of the scrape context.
+ * @param _collector Pointer to the collector to scrape.
+ */
+#define PROMETHEUS_SCRAPE_CTX_DEFINE(_name, _collector)				\
+	struct prometheus_scrape_ctx _name = {					\
+		.walk = {							\
+			.collector = (_collector),				\
+			.state = PROMETHEUS_WALK_START,				\
+		},								\
+	}
+
+/**
+ * @brief HTTP server dynamic resource handler streaming a scrape
+ *
+ * Sends the exposition data of a collector in chunks of
+ * @kconfig{CONFIG_PROMETHEUS_SCRAPE_CHUNK_SIZE} bytes, using the chunked
+ * transfer encoding of the HTTP server, instead of formatting all of it
+ * into one buffer. Can be used directly as the callback of a dynamic
+ * resource, or called from one.
+ *
+ * @param client HTTP client context.
+ * @param status Status of the request data.
+ * @param request_ctx Request context.
+ * @param response_ctx Response context to fill.
+ * @param user_data Pointer to a @ref prometheus_scrape_ctx.
+ *
+ * @return 0 on success, negative errno on error.
+ */
+int prometheus_scrape_http_handler(struct http_client_ctx *client, enum http_data_status status,
+				   const struct http_request_ctx *request_ctx,
+				   struct http_response_ctx *response_ctx, void *user_data);
+
 /**
  * @}
  */
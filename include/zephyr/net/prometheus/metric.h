@@ -66,9 +66,22 @@ struct prometheus_metric {
 	int num_labels;
 	/** User defined data */
 	void *user_data;
+#if defined(CONFIG_PROMETHEUS_LABEL_CACHE) || defined(__DOXYGEN__)
+	/** Rendered header and sample prefixes, see @kconfig{CONFIG_PROMETHEUS_LABEL_CACHE} */
+	char cache[CONFIG_PROMETHEUS_LABEL_CACHE_SIZE];
+	/** Length of the header in @a cache */
+	uint16_t cache_header_len;
+	/** Used length of @a cache, 0 if not rendered yet */
+	uint16_t cache_len;
+#endif
 	/* Add any other necessary fields */
 };
 
+/** @cond INTERNAL_HIDDEN */
+/* Value of cache_len for a metric that does not fit in the cache */
+#define PROMETHEUS_CACHE_UNFIT UINT16_MAX
+/** @endcond */
+
 /**
  * @}
  */
@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block until the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -189,6 +191,13 @@ extern "C" {
 /** Socket option to control TLS session caching on a socket. Accepted values:
  *  - 0 - Disabled.
  *  - 1 - Enabled.
+ *
+ *  On a client socket, the session is saved after the handshake and resumed
+ *  on the next connection to the same peer. The peer is identified by the
+ *  hostname set with TLS_HOSTNAME and the port if a hostname is set, by its
+ *  address otherwise.
+ *  On a server socket, sessions are kept in the server session cache and,
+ *  if session tickets are supported, session tickets are issued to clients.
  */
 #define TLS_SESSION_CACHE 12
 /** Write-only socket option to purge session cache immediately.
@@ -260,6 +269,12 @@ extern "C" {
  *  Kconfig option is enabled.
  */
 #define TLS_CERT_VERIFY_CALLBACK 20
+/** Read-only socket option to get the TLS session cache statistics. The
+ *  option accepts a pointer to a @ref tls_session_cache_stats structure.
+ *  The statistics are global to all sockets and are reset by
+ *  TLS_SESSION_CACHE_PURGE.
+ */
+#define TLS_SESSION_CACHE_STATS 21
 
 /* Valid values for @ref TLS_PEER_VERIFY option */
 #define TLS_PEER_VERIFY_NONE 0     /**< Peer verification disabled. */
@@ -289,6 +304,18 @@ extern "C" {
 #define TLS_DTLS_CID_STATUS_UPLINK		2 /**< CID is in use by peer */
 #define TLS_DTLS_CID_STATUS_BIDIRECTIONAL	3 /**< CID is in use by us and peer */
 
+/** Data structure for @ref TLS_SESSION_CACHE_STATS socket option. */
+struct tls_session_cache_stats {
+	/** Number of handshakes for which a session to resume was found, in
+	 *  the client session cache, the server session cache or a session
+	 *  ticket.
+	 */
+	uint32_t hits;
+
+	/** Number of handshakes for which no session to resume was found. */
+	uint32_t misses;
+};
+
 /** Data structure for @ref TLS_CERT_VERIFY_CALLBACK socket option. */
 struct tls_cert_verify_cb {
 	/** A pointer to the certificate verification callback function.
@@ -498,6 +525,41 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 	return zsock_sendto(sock, buf, len, flags, NULL, 0);
 }
 
+/**
+ * @brief Zero-copy send completion callback
+ *
+ * @details
+ * See @ref net_context_zerocopy_cb_t, which this is the same as.
+ */
+typedef void (*zsock_zerocopy_cb_t)(const void *buf, size_t len, int status,
+				    void *user_data);
+
+/**
+ * @brief Send data on a TCP socket without copying it
+ *
+ * @details
+ * Works like zsock_send() on a connected TCP socket, but the data is
+ * referenced by the network buffers instead of being copied. It must
+ * stay valid and unmodified until @p cb is called, once the data has been
+ * acknowledged by the peer or the connection is gone. There is one call
+ * of @p cb for each call of this function which returned a positive value,
+ * with the part of @p buf which was actually queued.
+ *
+ * This is not a system call, so it is only available to kernel threads.
+ * Only available with @kconfig{CONFIG_NET_TCP_ZEROCOPY}.
+ *
+ * @param sock Socket descriptor
+ * @param buf Data to send
+ * @param len Number of bytes to send, up to UINT16_MAX are queued per call
+ * @param flags @ref ZSOCK_MSG_DONTWAIT or 0
+ * @param cb Callback telling when @p buf is no longer used
+ * @param user_data User data passed to @p cb
+ *
+ * @return Number of bytes queued, or -1 with errno set.
+ */
+ssize_t zsock_send_zerocopy(int sock, const void *buf, size_t len, int flags,
+			    zsock_zerocopy_cb_t cb, void *user_data);
+
 /**
  * @brief Send data to an arbitrary network address
  *
@@ -537,6 +599,59 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send several messages with a single call
+ *
+ * @details
+ * This works like calling zsock_sendmsg() on each message of @p msgvec,
+ * but the socket is locked only once for the batch, which also avoids a
+ * system call per message in user mode. The number of bytes sent for each
+ * message is stored in its @c msg_len field.
+ * See Linux sendmmsg(2) for the normative description.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to send
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent. An error is only reported, with -1 and
+ * errno set, when the first message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages with a single call
+ *
+ * @details
+ * This works like calling zsock_recvmsg() on each message of @p msgvec,
+ * but the socket is locked only once for the batch, which also avoids a
+ * system call per message in user mode. The number of bytes received for
+ * each message is stored in its @c msg_len field.
+ *
+ * With @ref ZSOCK_MSG_WAITFORONE, only the first message is waited for and
+ * the call then returns the messages already queued, so that a single
+ * wakeup drains the socket. The optional @p timeout is only checked after
+ * each message, like in Linux.
+ * See Linux recvmmsg(2) for the normative description.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Buffers for the messages
+ * @param vlen Number of messages in @p msgvec
+ * @param flags Flags, as for zsock_recvmsg(), and @ref ZSOCK_MSG_WAITFORONE
+ * @param timeout Time after which no more messages are received, or NULL
+ *
+ * @return Number of messages received. An error is only reported, with -1
+ * and errno set, when the first message could not be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     const struct timespec *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -553,6 +668,35 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Works like zsock_recvfrom(), but hands the network buffers holding the
+ * data of the next received packet over to the caller instead of copying
+ * it. Protocol headers are already removed from the returned fragment
+ * chain, which the caller must release with net_buf_unref() once done
+ * with it. As those buffers come from the network RX pools, keeping them
+ * for long prevents receiving more packets.
+ *
+ * On datagram sockets, one call returns one whole datagram. On stream
+ * sockets, it returns the data of the next received segment, whatever its
+ * size. @ref ZSOCK_MSG_PEEK is not supported.
+ *
+ * This is not a system call, so it is only available to kernel threads.
+ *
+ * @param sock Socket descriptor
+ * @param frags Set to the received fragment chain, or NULL
+ * @param flags @ref ZSOCK_MSG_DONTWAIT or 0
+ * @param src_addr Source address of a datagram, or NULL
+ * @param addrlen Value-result length of @p src_addr, or NULL
+ *
+ * @return Number of bytes in @p frags, 0 for end of stream, or -1 with
+ * errno set.
+ */
+ssize_t zsock_recv_zerocopy(int sock, struct net_buf **frags, int flags,
+			    struct sockaddr *src_addr, socklen_t *addrlen);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -792,6 +936,26 @@ int zsock_getaddrinfo(const char *host, const char *service,
  */
 void zsock_freeaddrinfo(struct zsock_addrinfo *ai);
 
+/**
+ * @brief Connect a stream socket to one of the addresses of a
+ *        zsock_getaddrinfo() result
+ *
+ * @details
+ * Connection attempts are made in the order of RFC 8305 ("Happy Eyeballs"):
+ * IPv6 and IPv4 addresses are tried alternately, and a new attempt is started
+ * every @kconfig{CONFIG_NET_SOCKETS_HAPPY_EYEBALLS_DELAY} milliseconds, or as
+ * soon as the previous one fails, without closing the attempts still pending.
+ * The first attempt to complete wins and the other sockets are closed.
+ *
+ * @param res List of addresses, as returned by zsock_getaddrinfo()
+ * @param timeout Overall timeout in milliseconds, negative to wait forever
+ *
+ * @return Connected socket on success, -1 with errno set on error. errno is
+ *         ETIMEDOUT if no attempt completed in time, or the error of the last
+ *         failed attempt.
+ */
+int zsock_connect_happy(const struct zsock_addrinfo *res, int timeout);
+
 /**
  * @brief Convert zsock_getaddrinfo() error code to textual message
  *
@@ -924,6 +1088,9 @@ struct ifreq {
 /** Domain used with SOCKET */
 #define SO_DOMAIN 39
 
+/** Busy poll the device for this many microseconds before blocking on receive */
+#define SO_BUSY_POLL 46
+
 /** Enable SOCKS5 for Socket */
 #define SO_SOCKS5 60
 
@@ -959,6 +1126,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Name of the congestion control algorithm, such as "reno" or "cubic" */
+#define TCP_CONGESTION 5
 
 /** @} */
 
@@ -1113,6 +1113,14 @@ struct net_buf_pool {
 
 	/** Start of buffer storage array */
 	struct net_buf * const __bufs;
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	/** Per-CPU caches of free buffers, only used by fixed size pools */
+	atomic_ptr_t cache[CONFIG_MP_MAX_NUM_CPUS][CONFIG_NET_BUF_POOL_CACHE_SIZE];
+
+	/** Number of threads about to block on the free LIFO */
+	atomic_t cache_waiters;
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1238,6 +1246,46 @@ extern const struct net_buf_data_cb net_buf_fixed_cb;
 					 _net_buf_##_name, _count, _ud_size,   \
 					 _destroy)
 
+/** @cond INTERNAL_HIDDEN */
+extern const struct net_buf_data_cb net_buf_arena_cb;
+/** @endcond */
+
+/**
+ *
+ * @brief Define a new pool for buffers with payloads taken from an arena
+ *
+ * Defines a net_buf_pool struct and the necessary memory storage (array of
+ * structs) for the needed amount of buffers. After this, the buffers can be
+ * accessed from the pool through net_buf_alloc.
+ *
+ * The data payloads are allocated from a sys_arena, and are not freed along
+ * with their buffer: all of them are reclaimed at once when the arena is
+ * reset or rewound, which the user must only do once the buffers allocated
+ * since are no longer accessed. Arenas have no lock, so all allocations
+ * from the pool and the arena itself must be serialized, e.g. by only using
+ * them from the thread handling one request. Allocating the data never
+ * blocks, the timeout passed to net_buf_alloc is treated as K_NO_WAIT.
+ *
+ * Requires CONFIG_SYS_ARENA.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _arena     Pointer to the struct sys_arena to allocate from.
+ * @param _ud_size   User data space to reserve per buffer.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_ARENA_DEFINE(_name, _count, _arena, _ud_size, _destroy)   \
+	_NET_BUF_ARRAY_DEFINE(_name, _count, _ud_size);                        \
+	static const struct net_buf_data_alloc net_buf_data_alloc_##_name = {  \
+		.cb = &net_buf_arena_cb,                                       \
+		.alloc_data = (_arena),                                        \
+		.max_alloc_size = 0,                                           \
+	};                                                                     \
+	static STRUCT_SECTION_ITERABLE(net_buf_pool, _name) =                  \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_data_alloc_##_name,   \
+					 _net_buf_##_name, _count, _ud_size,   \
+					 _destroy)
+
 /** @cond INTERNAL_HIDDEN */
 extern const struct net_buf_data_cb net_buf_var_cb;
 /** @endcond */
@@ -1390,6 +1438,25 @@ struct net_buf * __must_check net_buf_alloc_len(struct net_buf_pool *pool,
 						k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate several buffers from a pool at once.
+ *
+ * Never blocks: as many buffers as are immediately available are
+ * allocated, each with at least @a size bytes of data, e.g. to refill
+ * the receive ring of a driver.  All the uninitialized buffers needed
+ * are claimed at once, and with CONFIG_NET_BUF_POOL_CACHE the buffers
+ * cached by the current CPU are taken without any lock.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param bufs Array to store the buffers in.
+ * @param count Number of buffers requested.
+ *
+ * @return Number of buffers allocated, stored first in @a bufs.
+ */
+int __must_check net_buf_alloc_bulk(struct net_buf_pool *pool, size_t size,
+				    struct net_buf **bufs, int count);
+
 /**
  * @brief Allocate a new buffer from a pool but with external data pointer.
  *
@@ -1423,6 +1490,12 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+bool net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1443,6 +1516,12 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	if (net_buf_pool_cache_put(pool, buf)) {
+		return;
+	}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
 	k_lifo_put(&pool->free, buf);
 }
 
@@ -1497,6 +1576,17 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line);
 void net_buf_unref(struct net_buf *buf);
 #endif
 
+/**
+ * @brief Decrements the reference count of several buffers.
+ *
+ * Same as calling net_buf_unref() on each buffer, which goes back into
+ * the cache of the current CPU when its pool has one.
+ *
+ * @param bufs Array of valid pointers on buffers
+ * @param count Number of buffers in @a bufs
+ */
+void net_buf_unref_bulk(struct net_buf **bufs, int count);
+
 /**
  * @brief Increment the reference count of a buffer.
  *
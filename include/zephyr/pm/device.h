@@ -173,6 +173,8 @@ struct pm_device {
 #if defined(CONFIG_PM_DEVICE_RUNTIME_ASYNC) || defined(__DOXYGEN__)
 	/** Work object for asynchronous calls */
 	struct k_work_delayable work;
+	/** Delay before pm_device_runtime_put() suspends the device, in ms */
+	uint32_t autosuspend_delay;
 #endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
 };
@@ -199,12 +201,23 @@ BUILD_ASSERT(offsetof(struct pm_device_isr, base) == 0);
 
 /** @cond INTERNAL_HIDDEN */
 
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+#define Z_PM_DEVICE_RUNTIME_AUTOSUSPEND_INIT(node_id)			\
+	.autosuspend_delay = COND_CODE_1(DT_NODE_EXISTS(node_id),	\
+		(DT_PROP_OR(node_id,					\
+			    zephyr_pm_device_runtime_autosuspend_delay_ms, 0)), \
+		(0)),
+#else
+#define Z_PM_DEVICE_RUNTIME_AUTOSUSPEND_INIT(node_id)
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+
 #ifdef CONFIG_PM_DEVICE_RUNTIME
-#define Z_PM_DEVICE_RUNTIME_INIT(obj)			\
+#define Z_PM_DEVICE_RUNTIME_INIT(obj, node_id)		\
 	.lock = Z_SEM_INITIALIZER(obj.lock, 1, 1),	\
-	.event = Z_EVENT_INITIALIZER(obj.event),
+	.event = Z_EVENT_INITIALIZER(obj.event),	\
+	Z_PM_DEVICE_RUNTIME_AUTOSUSPEND_INIT(node_id)
 #else
-#define Z_PM_DEVICE_RUNTIME_INIT(obj)
+#define Z_PM_DEVICE_RUNTIME_INIT(obj, node_id)
 #endif /* CONFIG_PM_DEVICE_RUNTIME */
 
 #ifdef CONFIG_PM_DEVICE_POWER_DOMAIN
@@ -264,7 +277,7 @@ BUILD_ASSERT(offsetof(struct pm_device_isr, base) == 0);
 	{									\
 		.base = Z_PM_DEVICE_BASE_INIT(obj, node_id, pm_action_cb,	\
 				isr_safe ? BIT(PM_DEVICE_FLAG_ISR_SAFE) : 0),	\
-		COND_CODE_1(isr_safe, (), (Z_PM_DEVICE_RUNTIME_INIT(obj)))	\
+		COND_CODE_1(isr_safe, (), (Z_PM_DEVICE_RUNTIME_INIT(obj, node_id)))	\
 	}
 
 /**
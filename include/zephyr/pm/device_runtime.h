@@ -104,6 +104,11 @@ int pm_device_runtime_get(const struct device *dev);
  * state will be left unchanged. In all other cases, usage count will be
  * decremented (down to 0).
  *
+ * If the device has an autosuspend delay, the suspension is scheduled to
+ * happen once the delay expires instead, like pm_device_runtime_put_async()
+ * would. A pm_device_runtime_get() call within the delay cancels it, which
+ * saves a suspend/resume cycle when the device is used in bursts.
+ *
  * @funcprops \pre_kernel_ok
  *
  * @param dev Device instance.
@@ -144,6 +149,26 @@ int pm_device_runtime_put(const struct device *dev);
  */
 int pm_device_runtime_put_async(const struct device *dev, k_timeout_t delay);
 
+/**
+ * @brief Set the autosuspend delay of a device.
+ *
+ * The autosuspend delay is the minimum amount of time a device stays active
+ * after its last user released it with pm_device_runtime_put(). It is
+ * initialized from the zephyr,pm-device-runtime-autosuspend-delay-ms devicetree
+ * property, a delay of 0 suspends the device right away.
+ *
+ * @funcprops \pre_kernel_ok
+ *
+ * @param dev Device instance.
+ * @param delay_ms Autosuspend delay in milliseconds.
+ *
+ * @retval 0 If it succeeds.
+ * @retval -ENOTSUP If the device does not support PM, or supports it from
+ * interrupt context only (@ref PM_DEVICE_ISR_SAFE).
+ * @retval -ENOSYS If asynchronous device runtime PM is not available.
+ */
+int pm_device_runtime_autosuspend_delay_set(const struct device *dev, uint32_t delay_ms);
+
 /**
  * @brief Check if device runtime is enabled for a given device.
  *
@@ -209,6 +234,14 @@ static inline int pm_device_runtime_put_async(const struct device *dev,
 	return 0;
 }
 
+static inline int pm_device_runtime_autosuspend_delay_set(const struct device *dev,
+							  uint32_t delay_ms)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(delay_ms);
+	return -ENOSYS;
+}
+
 static inline bool pm_device_runtime_is_enabled(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -297,6 +297,62 @@ static inline int64_t pm_policy_next_event_ticks(void)
 
 #endif /* CONFIG_PM */
 
+#if defined(CONFIG_PM_POLICY_MENU) || defined(__DOXYGEN__)
+/**
+ * @brief Idle statistics gathered by the menu PM policy.
+ *
+ * A prediction is counted as a hit when the state picked for an idle period
+ * is the deepest one whose minimum residency plus exit latency fits the
+ * measured residency, ignoring state locks. It is too deep when that state
+ * is a shallower one, and too shallow when it is a deeper one.
+ */
+struct pm_policy_menu_stats {
+	/** Number of idle periods */
+	uint32_t idle_count;
+	/** Predictions that picked the best fitting state */
+	uint32_t hits;
+	/** Predictions that picked a state the CPU woke up too early for */
+	uint32_t too_deep;
+	/** Predictions that missed a deeper state that would have fit */
+	uint32_t too_shallow;
+	/** Total idle residency, in microseconds */
+	uint64_t residency_us;
+	/** Idle residency histogram, bucket n counts periods of [2^n, 2^(n+1)) us */
+	uint32_t hist[CONFIG_PM_POLICY_MENU_HIST_BUCKETS];
+};
+
+/**
+ * @brief Account for the end of an idle period.
+ *
+ * Called by pm_system_resume() when the CPU wakes up from the state picked
+ * by pm_policy_next_state(), i.e. at the entry of the waking interrupt or
+ * once the state is left, before any woken thread runs. Feeds the measured
+ * idle residency back into the predictor and the statistics. Only the first
+ * call after pm_policy_next_state() is accounted for.
+ *
+ * @param cpu CPU index.
+ */
+void pm_policy_menu_idle_exit(uint8_t cpu);
+
+/**
+ * @brief Get the menu PM policy statistics of a CPU.
+ *
+ * @param cpu CPU index.
+ * @param stats Where to store the statistics.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p cpu is out of range.
+ */
+int pm_policy_menu_stats_get(uint8_t cpu, struct pm_policy_menu_stats *stats);
+
+/**
+ * @brief Reset the menu PM policy statistics of all CPUs.
+ *
+ * The prediction history is kept.
+ */
+void pm_policy_menu_stats_reset(void);
+#endif /* CONFIG_PM_POLICY_MENU */
+
 #if defined(CONFIG_PM) || defined(CONFIG_PM_POLICY_LATENCY_STANDALONE) || defined(__DOXYGEN__)
 /**
  * @brief Add a new latency requirement.
@@ -324,8 +324,13 @@ __PICOLIBC_MINOR__ == 8 && __PICOLIBC_PATCHLEVEL__ >= 9)))
 #define NZERO      (20)
 
 /* Runtime invariant values */
+#ifdef CONFIG_POSIX_ASYNCHRONOUS_IO
+#define AIO_LISTIO_MAX     CONFIG_POSIX_AIO_LISTIO_MAX
+#define AIO_MAX            CONFIG_POSIX_AIO_MAX
+#else
 #define AIO_LISTIO_MAX     _POSIX_AIO_LISTIO_MAX
 #define AIO_MAX            _POSIX_AIO_MAX
+#endif
 #define AIO_PRIO_DELTA_MAX (0)
 #define DELAYTIMER_MAX     _POSIX_DELAYTIMER_MAX
 #define HOST_NAME_MAX      _POSIX_HOST_NAME_MAX
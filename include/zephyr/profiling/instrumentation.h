@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Function instrumentation recorder
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_INSTRUMENTATION_H_
+#define ZEPHYR_INCLUDE_PROFILING_INSTRUMENTATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup profiling_instrumentation Function instrumentation
+ * @ingroup os_services
+ * @{
+ */
+
+/** Function entry record */
+#define INSTR_RECORD_ENTRY 0U
+/** Function exit record */
+#define INSTR_RECORD_EXIT  1U
+
+/**
+ * @brief Entry or exit of an instrumented function.
+ */
+struct instr_record {
+	/** Address of the function */
+	uintptr_t func;
+	/** Thread running the function */
+	uintptr_t thread;
+	/** Hardware cycle counter value, see k_cycle_get_32() */
+	uint32_t timestamp;
+	/** INSTR_RECORD_ENTRY or INSTR_RECORD_EXIT */
+	uint32_t type;
+};
+
+/**
+ * @brief Callback called for each record.
+ *
+ * @param cpu CPU which recorded the entry or exit.
+ * @param record The record.
+ * @param user_data User data given to instr_foreach().
+ */
+typedef void (*instr_record_cb_t)(unsigned int cpu, const struct instr_record *record,
+				  void *user_data);
+
+/**
+ * @brief Start recording the entries and exits of the instrumented functions.
+ */
+void instr_start(void);
+
+/**
+ * @brief Stop recording.
+ */
+void instr_stop(void);
+
+/**
+ * @brief Check whether recording is on.
+ *
+ * @return true if the entries and exits are being recorded.
+ */
+bool instr_is_enabled(void);
+
+/**
+ * @brief Discard the records of all the CPUs.
+ */
+void instr_reset(void);
+
+/**
+ * @brief Walk the records, oldest first, one CPU after the other.
+ *
+ * Recording must be stopped.
+ *
+ * @param cb Callback called for each record.
+ * @param user_data Data given to the callback.
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if recording is on.
+ */
+int instr_foreach(instr_record_cb_t cb, void *user_data);
+
+/**
+ * @brief Get the number of records lost because a buffer was full.
+ *
+ * @return Number of records dropped, or overwritten with
+ *         CONFIG_PROFILING_INSTRUMENTATION_OVERWRITE, since the last reset.
+ */
+uint32_t instr_dropped(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_INSTRUMENTATION_H_ */
@@ -27,6 +27,7 @@
 #define ZEPHYR_INCLUDE_RTIO_RTIO_H_
 
 #include <string.h>
+#include <sys/types.h>
 
 #include <zephyr/app_memory/app_memdomain.h>
 #include <zephyr/device.h>
@@ -371,6 +372,13 @@ struct rtio_sqe {
 			rtio_signaled_t callback;
 			void *userdata;
 		} await;
+
+		/** OP_FLASH_READ, OP_FLASH_WRITE and OP_FLASH_ERASE */
+		struct {
+			uint32_t len; /**< Length of the buffer or of the area to erase */
+			uint8_t *buf; /**< Buffer to read into or write from */
+			off_t offset; /**< Offset in flash */
+		} flash;
 	};
 };
 
@@ -531,6 +539,20 @@ struct rtio_iodev_api {
 	 * @param iodev_sqe Submission queue entry
 	 */
 	void (*submit)(struct rtio_iodev_sqe *iodev_sqe);
+
+	/**
+	 * @brief Submit to the iodev several entries to work on at once (optional)
+	 *
+	 * Called instead of @ref rtio_iodev_api.submit with consecutive submissions
+	 * of a context to the iodev, in order, allowing to program the hardware for
+	 * all of them at once (e.g. a DMA descriptor list). Each entry is completed
+	 * on its own as with @ref rtio_iodev_api.submit. The array is only valid
+	 * for the duration of the call.
+	 *
+	 * @param iodev_sqes Submission queue entries
+	 * @param count Number of entries, at least 2
+	 */
+	void (*submit_batch)(struct rtio_iodev_sqe **iodev_sqes, size_t count);
 };
 
 /**
@@ -583,6 +605,15 @@ struct rtio_iodev {
 /** An operation to suspend bus while awaiting signal */
 #define RTIO_OP_AWAIT (RTIO_OP_I3C_CCC+1)
 
+/** An operation to read from flash */
+#define RTIO_OP_FLASH_READ (RTIO_OP_AWAIT+1)
+
+/** An operation to write to flash */
+#define RTIO_OP_FLASH_WRITE (RTIO_OP_FLASH_READ+1)
+
+/** An operation to erase flash */
+#define RTIO_OP_FLASH_ERASE (RTIO_OP_FLASH_WRITE+1)
+
 /**
  * @brief Prepare a nop (no op) submission
  */
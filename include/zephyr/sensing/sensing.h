@@ -282,6 +282,27 @@ int sensing_get_config(
 const struct sensing_sensor_info *sensing_get_sensor_info(
 		sensing_sensor_handle_t handle);
 
+/**
+ * @brief Keep a sensor data buffer past its data event callback.
+ *
+ * All the clients of a sensor get the same buffer in their data event
+ * callback, which is returned to the memory pool once the callbacks are done
+ * unless held. A held buffer must be released with sensing_data_release().
+ *
+ * @param buf The data buffer given to the data event callback.
+ * @return 0 on success, -ENOMEM when no more buffers can be held or
+ *         -EINVAL when @p buf is no longer valid.
+ */
+int sensing_data_hold(const void *buf);
+
+/**
+ * @brief Release a sensor data buffer kept with sensing_data_hold().
+ *
+ * @param buf The held data buffer.
+ * @return 0 on success or -EINVAL when @p buf is not held.
+ */
+int sensing_data_release(const void *buf);
+
 #ifdef __cplusplus
 }
 #endif
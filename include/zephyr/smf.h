@@ -95,6 +95,49 @@ struct smf_state {
 #endif /* CONFIG_SMF_ANCESTOR_SUPPORT */
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+/**
+ * @brief Precomputed hierarchy of the states of an array
+ *
+ * Holds the path from the topmost ancestor of each state down to the
+ * state itself, so that transitions find their least common ancestor and
+ * run their entry actions by walking these arrays instead of the parent
+ * chains. Define it with SMF_TABLE_DEFINE().
+ */
+struct smf_table {
+	/** @cond INTERNAL_HIDDEN */
+	const struct smf_state *states;
+	size_t num_states;
+	uint8_t max_levels;
+	/* num_states rows of max_levels states, topmost first */
+	const struct smf_state **paths;
+	/* Index of each state in its own row */
+	uint8_t *depth;
+	/** @endcond */
+};
+
+/**
+ * @brief Define the transition table of an array of states
+ *
+ * The table must be filled with smf_table_init() before use.
+ *
+ * @param _name       Name of the table
+ * @param _states     Array holding all the states of the state machine
+ * @param _max_levels Maximum number of nesting levels, 1 for a flat machine
+ */
+#define SMF_TABLE_DEFINE(_name, _states, _max_levels)                                   \
+	static const struct smf_state *_smf_table_paths_##_name[ARRAY_SIZE(_states) *   \
+								 (_max_levels)];        \
+	static uint8_t _smf_table_depth_##_name[ARRAY_SIZE(_states)];                   \
+	struct smf_table _name = {                                                      \
+		.states = _states,                                                      \
+		.num_states = ARRAY_SIZE(_states),                                      \
+		.max_levels = (_max_levels),                                            \
+		.paths = _smf_table_paths_##_name,                                      \
+		.depth = _smf_table_depth_##_name,                                      \
+	}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /** Defines the current context of the state machine. */
 struct smf_ctx {
 	/** Current state the state machine is executing. */
@@ -106,6 +149,10 @@ struct smf_ctx {
 	/** Currently executing state (which may be a parent) */
 	const struct smf_state *executing;
 #endif /* CONFIG_SMF_ANCESTOR_SUPPORT */
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	/** Precomputed state hierarchy, or NULL. See smf_set_table(). */
+	const struct smf_table *table;
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
 	/**
 	 * This value is set by the set_terminate function and
 	 * should terminate the state machine when its set to a
@@ -120,6 +167,38 @@ struct smf_ctx {
 	uint32_t internal;
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+/**
+ * @brief Compute the state hierarchy of a transition table
+ *
+ * Only needs to be called once, even if several state machines share the
+ * table.
+ *
+ * @param table Table defined with SMF_TABLE_DEFINE()
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if an ancestor of a state is not in the array of states.
+ * @retval -ENOSPC if states are nested deeper than the table allows.
+ */
+int smf_table_init(struct smf_table *table);
+
+/**
+ * @brief Make a state machine use a transition table
+ *
+ * Call before smf_set_initial(). All the states the machine transitions
+ * to must then be in the array of the table. Contexts not using a table
+ * must have it set to NULL, e.g. by being zero-initialized.
+ *
+ * @param ctx   State machine context
+ * @param table Table initialized with smf_table_init(), or NULL to walk
+ *              the parent chains of the states again.
+ */
+static inline void smf_set_table(struct smf_ctx *ctx, const struct smf_table *table)
+{
+	ctx->table = table;
+}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 /**
  * @brief Initializes the state machine and sets its initial state.
  *
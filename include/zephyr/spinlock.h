@@ -24,6 +24,20 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IRQ_STATS_LOCK
+/* Interrupt masking measurement, see kernel/irq_stats.c */
+void z_irq_stats_locked(unsigned int key);
+void z_irq_stats_unlocking(unsigned int key);
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
+struct k_spinlock;
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* Contention statistics, see kernel/spinlock_stats.c */
+void z_spin_stats_acquired(struct k_spinlock *l, uint32_t spins);
+void z_spin_stats_release(struct k_spinlock *l);
+#endif /* CONFIG_SPINLOCK_STATS */
+
 /**
  * @brief Spinlock APIs
  * @defgroup spinlock_apis Spinlock APIs
@@ -183,12 +197,16 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 {
 	ARG_UNUSED(l);
 	k_spinlock_key_t k;
+	__maybe_unused uint32_t spins = 0U;
 
 	/* Note that we need to use the underlying arch-specific lock
 	 * implementation.  The "irq_lock()" API in SMP context is
 	 * actually a wrapper for a global spinlock!
 	 */
 	k.key = arch_irq_lock();
+#ifdef CONFIG_IRQ_STATS_LOCK
+	z_irq_stats_locked(k.key);
+#endif /* CONFIG_IRQ_STATS_LOCK */
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
@@ -201,14 +219,19 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	/* Spin until our ticket is served */
 	while (atomic_get(&l->owner) != ticket) {
 		arch_spin_relax();
+		spins++;
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
 		arch_spin_relax();
+		spins++;
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+#ifdef CONFIG_SPINLOCK_STATS
+	z_spin_stats_acquired(l, spins);
+#endif /* CONFIG_SPINLOCK_STATS */
 
 	return k;
 }
@@ -230,6 +253,9 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *k)
 {
 	int key = arch_irq_lock();
+#ifdef CONFIG_IRQ_STATS_LOCK
+	z_irq_stats_locked(key);
+#endif /* CONFIG_IRQ_STATS_LOCK */
 
 	z_spinlock_validate_pre(l);
 #ifdef CONFIG_SMP
@@ -264,6 +290,9 @@ static ALWAYS_INLINE int k_spin_trylock(struct k_spinlock *l, k_spinlock_key_t *
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
 	z_spinlock_validate_post(l);
+#ifdef CONFIG_SPINLOCK_STATS
+	z_spin_stats_acquired(l, 0U);
+#endif /* CONFIG_SPINLOCK_STATS */
 
 	k->key = key;
 
@@ -312,6 +341,9 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 		 l, delta, CONFIG_SPIN_LOCK_TIME_LIMIT);
 #endif /* CONFIG_SPIN_LOCK_TIME_LIMIT */
 #endif /* CONFIG_SPIN_VALIDATE */
+#ifdef CONFIG_SPINLOCK_STATS
+	z_spin_stats_release(l);
+#endif /* CONFIG_SPINLOCK_STATS */
 
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
@@ -328,6 +360,9 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 	(void)atomic_clear(&l->locked);
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
+#ifdef CONFIG_IRQ_STATS_LOCK
+	z_irq_stats_unlocking(key.key);
+#endif /* CONFIG_IRQ_STATS_LOCK */
 	arch_irq_unlock(key.key);
 }
 
@@ -362,6 +397,9 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 #ifdef CONFIG_SPIN_VALIDATE
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
+#ifdef CONFIG_SPINLOCK_STATS
+	z_spin_stats_release(l);
+#endif /* CONFIG_SPINLOCK_STATS */
 #ifdef CONFIG_SMP
 #ifdef CONFIG_TICKET_SPINLOCKS
 	(void)atomic_inc(&l->owner);
@@ -348,6 +348,24 @@ const char *flash_area_label(const struct flash_area *fa);
  */
 uint8_t flash_area_erased_val(const struct flash_area *fa);
 
+/**
+ * @brief Get the address at which the CPU can read flash area data in place.
+ *
+ * Available with CONFIG_FLASH_MAP_MMAP, for areas defined as fixed partitions
+ * of a "soc-nv-flash" memory. Data read through the returned address may be
+ * stale in the CPU caches after writing or erasing the area.
+ *
+ * @param[in]  fa    Flash area.
+ * @param[in]  off   Offset relative from beginning of flash area.
+ * @param[in]  len   Number of bytes to access.
+ * @param[out] addr  Address of the data.
+ *
+ * @return 0 on success, -ENOTSUP if the area isn't memory mapped,
+ *         -EINVAL if the range is outside of the area.
+ */
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **addr);
+
 /**
  * Returns non-0 value if fixed-partition of given DTS node label exists.
  *
@@ -25,6 +25,7 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#include <zephyr/kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +75,18 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	uint8_t *sync_buf;		/* Half of the write buffer not being
+					 * filled, NULL unless double buffering
+					 * is enabled.
+					 */
+	size_t sync_bytes;		/* Number of bytes of sync_buf being
+					 * written to flash, 0 when idle.
+					 */
+	int sync_rc;			/* Result of the write of sync_buf */
+	struct k_work sync_work;
+	struct k_sem sync_done;
+#endif
 };
 
 /**
@@ -95,6 +108,31 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Split the write buffer of a context for double buffered writes.
+ *
+ * The write buffer given to stream_flash_init() is split in two halves.
+ * Once a half is full, it is written to flash from a work queue while
+ * stream_flash_buffered_write() returns and the caller fills the other
+ * half. The work queue also erases the page needed next ahead of time.
+ *
+ * A failed write is reported by the next call to
+ * stream_flash_buffered_write(). The post write callback is invoked from
+ * the work queue. stream_flash_bytes_written() does not account for the
+ * half being written until a flush completes or the half is reused. The
+ * context must be flushed before being initialized again.
+ *
+ * @note Available when CONFIG_STREAM_FLASH_DOUBLE_BUFFER is enabled.
+ *
+ * @param ctx context initialized with stream_flash_init(), without any
+ *            buffered data.
+ *
+ * @return 0 on success, -EINVAL if the halves of the buffer are not a
+ *         multiple of the flash device write-block-size, -EBUSY if data
+ *         is already buffered, -EALREADY if already enabled.
+ */
+int stream_flash_double_buffer_enable(struct stream_flash_ctx *ctx);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -0,0 +1,191 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_ARENA_H_
+#define ZEPHYR_INCLUDE_SYS_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys_clock.h>
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct k_heap;
+
+/**
+ * @defgroup sys_arena_apis Arena Allocator APIs
+ * @ingroup heaps
+ * @{
+ */
+
+/** Alignment of blocks returned by sys_arena_alloc(), same as sys_heap */
+#define SYS_ARENA_ALIGN 8
+
+/**
+ * @brief Bump pointer arena
+ *
+ * Allocation only moves a pointer forward in a fixed region, and memory
+ * is never freed block by block.  Instead, everything allocated after a
+ * checkpoint is freed at once by rewinding to it, and sys_arena_reset()
+ * frees the whole arena.  This suits code making many small allocations
+ * with a common lifetime, e.g. while handling a request.
+ *
+ * Arenas have no lock: users must serialize accesses themselves.
+ */
+struct sys_arena {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *base;
+	size_t size;
+	size_t used;
+	size_t max_used;
+	struct k_heap *heap;
+	/** @endcond */
+};
+
+/** @brief Arena position, as returned by sys_arena_checkpoint() */
+typedef size_t sys_arena_checkpoint_t;
+
+/**
+ * @brief Statically define and initialize an arena
+ *
+ * @param name Name of the arena
+ * @param bytes Size of the arena
+ */
+#define SYS_ARENA_DEFINE(name, bytes)						\
+	static uint8_t __aligned(SYS_ARENA_ALIGN) _sys_arena_buf_##name[bytes];	\
+	struct sys_arena name = {						\
+		.base = _sys_arena_buf_##name,					\
+		.size = (bytes),						\
+	}
+
+/**
+ * @brief Initialize an arena over a buffer
+ *
+ * @param arena Arena to initialize
+ * @param mem Buffer to allocate from
+ * @param bytes Size of the buffer
+ */
+void sys_arena_init(struct sys_arena *arena, void *mem, size_t bytes);
+
+/**
+ * @brief Initialize an arena carved from a k_heap
+ *
+ * The memory goes back to the heap with sys_arena_release().
+ *
+ * @param arena Arena to initialize
+ * @param heap Heap to take the arena memory from
+ * @param bytes Size of the arena
+ * @param timeout How long to wait for the heap memory
+ * @retval 0 on success
+ * @retval -ENOMEM if the heap memory could not be allocated
+ */
+int sys_arena_init_from_heap(struct sys_arena *arena, struct k_heap *heap,
+			     size_t bytes, k_timeout_t timeout);
+
+/**
+ * @brief Give the memory of an arena back to its heap
+ *
+ * Does nothing but forget the memory for arenas not carved from a heap.
+ *
+ * @param arena Arena to release
+ */
+void sys_arena_release(struct sys_arena *arena);
+
+/**
+ * @brief Allocate memory from an arena, with a given alignment
+ *
+ * @param arena Arena to allocate from
+ * @param align Power of two alignment, or 0 for SYS_ARENA_ALIGN
+ * @param bytes Number of bytes requested
+ * @return Pointer to the memory, or NULL if no space is left
+ */
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align, size_t bytes);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * The memory is aligned on SYS_ARENA_ALIGN bytes.
+ *
+ * @param arena Arena to allocate from
+ * @param bytes Number of bytes requested
+ * @return Pointer to the memory, or NULL if no space is left
+ */
+static inline void *sys_arena_alloc(struct sys_arena *arena, size_t bytes)
+{
+	return sys_arena_aligned_alloc(arena, 0, bytes);
+}
+
+/**
+ * @brief Get the current position of an arena
+ *
+ * Checkpoints nest: rewinding to one discards later checkpoints too.
+ *
+ * @param arena Arena
+ * @return Checkpoint to pass to sys_arena_rewind()
+ */
+static inline sys_arena_checkpoint_t sys_arena_checkpoint(const struct sys_arena *arena)
+{
+	return arena->used;
+}
+
+/**
+ * @brief Free everything allocated since a checkpoint
+ *
+ * @param arena Arena
+ * @param cp Checkpoint to rewind to
+ */
+static inline void sys_arena_rewind(struct sys_arena *arena, sys_arena_checkpoint_t cp)
+{
+	__ASSERT(cp <= arena->used, "stale arena checkpoint");
+	arena->used = cp;
+}
+
+/**
+ * @brief Free everything allocated from an arena
+ *
+ * @param arena Arena
+ */
+static inline void sys_arena_reset(struct sys_arena *arena)
+{
+	arena->used = 0;
+}
+
+/**
+ * @brief Get the number of bytes in use in an arena
+ *
+ * Includes the alignment padding.
+ *
+ * @param arena Arena
+ * @return Bytes in use
+ */
+static inline size_t sys_arena_used(const struct sys_arena *arena)
+{
+	return arena->used;
+}
+
+/**
+ * @brief Get the peak number of bytes ever in use in an arena
+ *
+ * @param arena Arena
+ * @return Highest number of bytes in use since initialization
+ */
+static inline size_t sys_arena_max_used(const struct sys_arena *arena)
+{
+	return arena->max_used;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_ARENA_H_ */
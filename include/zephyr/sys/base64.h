@@ -62,6 +62,67 @@ extern "C" {
 int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		  size_t slen);
 
+/**
+ * @brief Streaming base64 encoder
+ *
+ * Encodes data handed over in pieces of any size, without the whole output
+ * having to fit in one buffer. Each piece produces the base64 of the
+ * complete groups of 3 bytes it makes up, and the encoder keeps the 1 or 2
+ * bytes left over for the next one. Concatenating all the outputs gives
+ * what base64_encode() produces for the whole data, without the NUL
+ * terminator.
+ *
+ * The fields are internal, only use the functions below on it.
+ */
+struct base64_encode_ctx {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t buf[3];
+	uint8_t len;
+	/** @endcond */
+};
+
+/**
+ * @brief          Initialize a streaming base64 encoder
+ *
+ * @param ctx      encoder
+ */
+void base64_encode_init(struct base64_encode_ctx *ctx);
+
+/**
+ * @brief          Encode a piece of data
+ *
+ * @param ctx      encoder
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer
+ * @param olen     number of bytes written
+ * @param src      source buffer
+ * @param slen     amount of data to be encoded
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small,
+ *                 in which case *olen is set to the size needed and nothing
+ *                 is consumed. At most 4 * ((slen + 2) / 3) bytes are
+ *                 written. No NUL terminator is written.
+ */
+int base64_encode_update(struct base64_encode_ctx *ctx, uint8_t *dst, size_t dlen,
+			 size_t *olen, const uint8_t *src, size_t slen);
+
+/**
+ * @brief          Finish encoding, writing the last group and its padding
+ *
+ * The encoder can then be used again for new data.
+ *
+ * @param ctx      encoder
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer
+ * @param olen     number of bytes written: 0 or 4
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small,
+ *                 in which case *olen is set to the size needed. No NUL
+ *                 terminator is written.
+ */
+int base64_encode_finish(struct base64_encode_ctx *ctx, uint8_t *dst, size_t dlen,
+			 size_t *olen);
+
 /**
  * @brief          Decode a base64-formatted buffer
  *
@@ -39,6 +39,11 @@ struct sys_bitarray {
 	/* Bundle of bits */
 	uint32_t *bundles;
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+	/* One bit per bundle, set when the bundle is full */
+	uint32_t *summary;
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
 };
@@ -54,15 +59,28 @@ typedef struct sys_bitarray sys_bitarray_t;
  * @param total_bits Total number of bits in this bitarray object.
  * @param sba_mod Modifier to the bitarray variables.
  */
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)	\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 32), 32)] = {0};
+#define _SYS_BITARRAY_SUMMARY_INIT(name)				\
+		.summary = _sys_bitarray_summary_##name,
+#else
+#define _SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)
+#define _SYS_BITARRAY_SUMMARY_INIT(name)
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+
 #define _SYS_BITARRAY_DEFINE(name, total_bits, sba_mod)			\
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
 		[DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8),		\
 			       sizeof(uint32_t))] = {0};		\
+	_SYS_BITARRAY_SUMMARY_DEFINE(name, total_bits, sba_mod)		\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = (total_bits),				\
 		.num_bundles = DIV_ROUND_UP(				\
 			DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t)),	\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		_SYS_BITARRAY_SUMMARY_INIT(name)			\
 	}
 
 /**
@@ -0,0 +1,266 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @defgroup btree_apis B-tree
+ * @ingroup datastructure_apis
+ *
+ * @brief Ordered map of 64-bit keys to 64-bit values, stored in a B-tree.
+ *
+ * Each node holds up to 2 * @kconfig{CONFIG_SYS_BTREE_MIN_DEGREE} - 1 keys
+ * next to each other, so a lookup reads a few contiguous nodes instead of
+ * following one pointer per level of a binary tree. That makes it faster
+ * than @ref rbtree_apis on large ordered sets, at the cost of allocating
+ * nodes. Nodes are allocated with a realloc() like function, the same way
+ * as the nodes of @ref sys_hashmap.
+ *
+ * The tree is not protected against concurrent access.
+ *
+ * @{
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <zephyr/math/ilog2.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+struct sys_btree_node;
+
+/* Enough levels for 2^32 keys with the smallest fan-out */
+#define SYS_BTREE_MAX_HEIGHT (1 + DIV_ROUND_UP(31, ilog2(CONFIG_SYS_BTREE_MIN_DEGREE)))
+
+/** @endcond */
+
+/**
+ * @brief B-tree node allocator
+ *
+ * Behaves like `realloc()`, and like `free()` when @p new_size is zero.
+ *
+ * @param ptr Previously allocated memory, or NULL.
+ * @param new_size Size to allocate, or zero to free @p ptr.
+ */
+typedef void *(*sys_btree_allocator_t)(void *ptr, size_t new_size);
+
+/**
+ * @brief B-tree visitor callback
+ *
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ * @param cookie User-specified data.
+ */
+typedef void (*sys_btree_callback_t)(uint64_t key, uint64_t value, void *cookie);
+
+/**
+ * @brief B-tree ordered map
+ */
+struct sys_btree {
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_btree_node *root;
+	sys_btree_allocator_t alloc_func;
+	size_t size;
+	uint8_t height;
+	/** @endcond */
+};
+
+/**
+ * @brief B-tree iterator
+ *
+ * Visits the entries in ascending key order. It is invalidated by any
+ * insertion or removal.
+ */
+struct sys_btree_iter {
+	/** Key of the current entry */
+	uint64_t key;
+	/** Value of the current entry */
+	uint64_t value;
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_btree_node *path[SYS_BTREE_MAX_HEIGHT];
+	uint16_t pos[SYS_BTREE_MAX_HEIGHT];
+	uint8_t depth;
+	/** @endcond */
+};
+
+/*
+ * A safe wrapper for realloc(), invariant of which libc provides it.
+ */
+static inline void *sys_btree_default_allocator(void *ptr, size_t size)
+{
+	if (size == 0) {
+		free(ptr);
+		return NULL;
+	}
+
+	return realloc(ptr, size);
+}
+
+/**
+ * @brief Statically initialize a B-tree
+ *
+ * @param _alloc_func Node allocator, see @ref sys_btree_allocator_t.
+ */
+#define SYS_BTREE_INIT(_alloc_func)                                                                \
+	{                                                                                          \
+		.alloc_func = _alloc_func,                                                         \
+	}
+
+/**
+ * @brief Define an empty B-tree using the heap of the C library
+ *
+ * @param _name Name of the B-tree.
+ */
+#define SYS_BTREE_DEFINE(_name) struct sys_btree _name = SYS_BTREE_INIT(sys_btree_default_allocator)
+
+/**
+ * @brief Initialize an empty B-tree
+ *
+ * @param tree B-tree to initialize.
+ * @param alloc_func Node allocator, see @ref sys_btree_allocator_t.
+ */
+static inline void sys_btree_init(struct sys_btree *tree, sys_btree_allocator_t alloc_func)
+{
+	tree->root = NULL;
+	tree->alloc_func = alloc_func;
+	tree->size = 0;
+	tree->height = 0;
+}
+
+/**
+ * @brief Insert or replace an entry
+ *
+ * @param tree B-tree to modify.
+ * @param key Key of the entry.
+ * @param value Value of the entry.
+ * @param old_value Where to store the replaced value, may be NULL.
+ *
+ * @retval 1 if the key was added.
+ * @retval 0 if the value of an existing key was replaced.
+ * @retval -ENOMEM if a node could not be allocated. The entries are unchanged.
+ * @retval -ENOSPC if the tree would become too high.
+ */
+int sys_btree_insert(struct sys_btree *tree, uint64_t key, uint64_t value, uint64_t *old_value);
+
+/**
+ * @brief Remove an entry
+ *
+ * @param tree B-tree to modify.
+ * @param key Key of the entry.
+ * @param value Where to store the value of the removed entry, may be NULL.
+ *
+ * @return true if the key was found and removed, false otherwise.
+ */
+bool sys_btree_remove(struct sys_btree *tree, uint64_t key, uint64_t *value);
+
+/**
+ * @brief Look up an entry
+ *
+ * @param tree B-tree to search.
+ * @param key Key of the entry.
+ * @param value Where to store the value of the entry, may be NULL.
+ *
+ * @return true if the key was found, false otherwise.
+ */
+bool sys_btree_get(const struct sys_btree *tree, uint64_t key, uint64_t *value);
+
+/**
+ * @brief Check whether a key is in the tree
+ *
+ * @param tree B-tree to search.
+ * @param key Key to look for.
+ *
+ * @return true if the key was found, false otherwise.
+ */
+static inline bool sys_btree_contains_key(const struct sys_btree *tree, uint64_t key)
+{
+	return sys_btree_get(tree, key, NULL);
+}
+
+/**
+ * @brief Remove all entries
+ *
+ * @param tree B-tree to clear.
+ * @param cb Callback called for each entry, may be NULL.
+ * @param cookie User-specified data for @p cb.
+ */
+void sys_btree_clear(struct sys_btree *tree, sys_btree_callback_t cb, void *cookie);
+
+/**
+ * @brief Number of entries of the tree
+ *
+ * @param tree B-tree to query.
+ *
+ * @return The number of entries.
+ */
+static inline size_t sys_btree_size(const struct sys_btree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Check whether the tree is empty
+ *
+ * @param tree B-tree to query.
+ *
+ * @return true if the tree has no entries.
+ */
+static inline bool sys_btree_is_empty(const struct sys_btree *tree)
+{
+	return tree->size == 0;
+}
+
+/**
+ * @brief Start iterating at a key
+ *
+ * The first call to sys_btree_iter_next() then returns the first entry
+ * whose key is greater than or equal to @p key.
+ *
+ * @param tree B-tree to iterate over.
+ * @param it Iterator to initialize.
+ * @param key Smallest key to visit, 0 for all of them.
+ */
+void sys_btree_iter_init(const struct sys_btree *tree, struct sys_btree_iter *it, uint64_t key);
+
+/**
+ * @brief Advance an iterator
+ *
+ * On success, the entry is in the key and value fields of @p it.
+ *
+ * @param it Iterator.
+ *
+ * @return true if there was an entry, false at the end of the tree.
+ */
+bool sys_btree_iter_next(struct sys_btree_iter *it);
+
+/**
+ * @brief Walk the entries of a tree in ascending key order
+ *
+ * @param tree B-tree to iterate over.
+ * @param it A struct sys_btree_iter, holding the entry in the loop body.
+ */
+#define SYS_BTREE_FOR_EACH(tree, it)                                                               \
+	for (sys_btree_iter_init((tree), &(it), 0); sys_btree_iter_next(&(it));)
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
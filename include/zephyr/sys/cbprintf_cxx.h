@@ -262,62 +262,64 @@ static inline size_t z_cbprintf_cxx_arg_size(T arg)
 	return MAX(sizeof(T), sizeof(int));
 }
 
-/* C++ version for storing arguments. */
+/* C++ version for storing arguments. Like in C, arguments are stored with a
+ * single typed store unless 64 bit values must be copied by words, so that
+ * static packaging compiles to a sequence of stores.
+ */
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, float arg)
 {
 	double d = (double)arg;
-	void *p = &d;
 
-	z_cbprintf_wcpy((int *)dst, (int *)p, sizeof(d) / sizeof(int));
+	if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY) {
+		void *p = &d;
+
+		z_cbprintf_wcpy((int *)dst, (int *)p, sizeof(d) / sizeof(int));
+	} else {
+		*(double *)dst = d;
+	}
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, void *p)
 {
-	z_cbprintf_wcpy((int *)dst, (int *)&p, sizeof(p) / sizeof(int));
+	*(void **)dst = p;
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, char arg)
 {
-	int tmp = arg + 0;
-
-	z_cbprintf_wcpy((int *)dst, &tmp, 1);
+	*(int *)dst = arg + 0;
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, unsigned char arg)
 {
-	int tmp = arg + 0;
-
-	z_cbprintf_wcpy((int *)dst, &tmp, 1);
+	*(int *)dst = arg + 0;
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, signed char arg)
 {
-	int tmp = arg + 0;
-
-	z_cbprintf_wcpy((int *)dst, &tmp, 1);
+	*(int *)dst = arg + 0;
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, short arg)
 {
-	int tmp = arg + 0;
-
-	z_cbprintf_wcpy((int *)dst, &tmp, 1);
+	*(int *)dst = arg + 0;
 }
 
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, unsigned short arg)
 {
-	int tmp = arg + 0;
-
-	z_cbprintf_wcpy((int *)dst, &tmp, 1);
+	*(int *)dst = arg + 0;
 }
 
 template < typename T >
 static inline void z_cbprintf_cxx_store_arg(uint8_t *dst, T arg)
 {
-	size_t wlen = z_cbprintf_cxx_arg_size(arg) / sizeof(int);
-	void *p = &arg;
+	if (Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY || (sizeof(T) < sizeof(int))) {
+		size_t wlen = z_cbprintf_cxx_arg_size(arg) / sizeof(int);
+		void *p = &arg;
 
-	z_cbprintf_wcpy((int *)dst, (int *)p, wlen);
+		z_cbprintf_wcpy((int *)dst, (int *)p, wlen);
+	} else {
+		*(T *)dst = arg;
+	}
 }
 
 /* C++ version for long double detection. */
@@ -59,13 +59,6 @@ static inline void z_cbprintf_wcpy(int *dst, int *src, size_t len)
 	}
 }
 
-#include <zephyr/sys/cbprintf_cxx.h>
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
 #if defined(__sparc__)
 /* The SPARC V8 ABI guarantees that the arguments of a variable argument
  * list function are stored on the stack at addresses which are 32-bit
@@ -82,6 +75,12 @@ extern "C" {
 #define Z_CBPRINTF_VA_STACK_LL_DBL_MEMCPY	0
 #endif
 
+#include <zephyr/sys/cbprintf_cxx.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /** Trick compiler to allow working with all types of arguments, including bitfields,
  * opaque struct pointers. Alternative is to add + 0 but that requires suppressing
  * compiler warning about pointer arithmetic and does not cover opaque structs.
@@ -0,0 +1,110 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_
+#define ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA offloaded memory copy API
+ * @defgroup sys_dma_memcpy DMA offloaded memory copy API
+ * @ingroup os_services
+ * @{
+ */
+
+/**
+ * @brief Completion callback of an offloaded copy.
+ *
+ * Called from the interrupt of the DMA controller when the copy was done with
+ * DMA, or from the caller of the copy when it was done by the CPU.
+ *
+ * @param user_data User data given with the copy.
+ * @param result 0 on success, negative errno if the DMA transfer failed.
+ */
+typedef void (*sys_dma_memcpy_cb_t)(void *user_data, int result);
+
+/**
+ * @brief Copy memory, with DMA when worthwhile.
+ *
+ * Copies of at least @kconfig{CONFIG_SYS_DMA_MEMCPY_THRESHOLD} bytes go
+ * through the DMA channel taken from the @c zephyr,dma-memcpy chosen node.
+ * Smaller copies, copies made while the channel is busy and copies the
+ * controller refuses are done by the CPU before returning. Either way @p cb
+ * is called once, when @p dst holds the data.
+ *
+ * Both buffers must be reachable by the DMA controller and must not be
+ * touched until the callback. Cache maintenance of both is done here.
+ *
+ * @param dst Destination buffer.
+ * @param src Source buffer.
+ * @param len Number of bytes to copy.
+ * @param cb Completion callback, may be NULL.
+ * @param user_data User data for @p cb.
+ */
+void sys_dma_memcpy_async(void *dst, const void *src, size_t len,
+			  sys_dma_memcpy_cb_t cb, void *user_data);
+
+/**
+ * @brief Fill memory, with DMA when worthwhile.
+ *
+ * Same as sys_dma_memcpy_async() for memset().
+ *
+ * @param dst Destination buffer.
+ * @param c Value of each byte.
+ * @param len Number of bytes to fill.
+ * @param cb Completion callback, may be NULL.
+ * @param user_data User data for @p cb.
+ */
+void sys_dma_memset_async(void *dst, uint8_t c, size_t len,
+			  sys_dma_memcpy_cb_t cb, void *user_data);
+
+#if defined(CONFIG_POLL) || defined(__DOXYGEN__)
+/**
+ * @brief Completion callback raising a poll signal.
+ *
+ * Pass it as callback with a struct k_poll_signal as user data to wait for
+ * the copy with k_poll(). The signal is raised with the result.
+ *
+ * @param user_data Poll signal to raise.
+ * @param result Result of the copy.
+ */
+static inline void sys_dma_memcpy_signal(void *user_data, int result)
+{
+	k_poll_signal_raise((struct k_poll_signal *)user_data, result);
+}
+#endif
+
+/**
+ * @brief Copy memory, with DMA when worthwhile, and wait for it.
+ *
+ * Must not be called from an interrupt.
+ *
+ * @param dst Destination buffer.
+ * @param src Source buffer.
+ * @param len Number of bytes to copy.
+ *
+ * @retval 0 on success.
+ * @retval -errno if the DMA transfer failed.
+ */
+int sys_dma_memcpy(void *dst, const void *src, size_t len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_DMA_MEMCPY_H_ */
@@ -108,6 +108,36 @@ uint32_t sys_hash32_djb2(const void *str, size_t n);
  */
 uint32_t sys_hash32_murmur3(const void *str, size_t n);
 
+/**
+ * @brief xxHash32 hash function
+ *
+ * @param str a string of input data
+ * @param n the number of bytes in @p str
+ *
+ * @return the numeric hash associated with @p str
+ *
+ * @note enable with @kconfig{CONFIG_SYS_HASH_FUNC32_XXHASH32}
+ *
+ * @see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ */
+uint32_t sys_hash32_xxhash32(const void *str, size_t n);
+
+/**
+ * @brief wyhash hash function
+ *
+ * The lower 32 bits of the 64-bit wyhash.
+ *
+ * @param str a string of input data
+ * @param n the number of bytes in @p str
+ *
+ * @return the numeric hash associated with @p str
+ *
+ * @note enable with @kconfig{CONFIG_SYS_HASH_FUNC32_WYHASH}
+ *
+ * @see https://github.com/wangyi-fudan/wyhash
+ */
+uint32_t sys_hash32_wyhash(const void *str, size_t n);
+
 /**
  * @brief System default 32-bit hash function
  *
@@ -130,6 +160,14 @@ static inline uint32_t sys_hash32(const void *str, size_t n)
 		return sys_hash32_murmur3(str, n);
 	}
 
+	if (IS_ENABLED(CONFIG_SYS_HASH_FUNC32_CHOICE_XXHASH32)) {
+		return sys_hash32_xxhash32(str, n);
+	}
+
+	if (IS_ENABLED(CONFIG_SYS_HASH_FUNC32_CHOICE_WYHASH)) {
+		return sys_hash32_wyhash(str, n);
+	}
+
 	__ASSERT(0, "No default 32-bit hash. See CONFIG_SYS_HASH_FUNC32_CHOICE");
 
 	return 0;
@@ -34,6 +34,7 @@ enum heap_event_types {
 	HEAP_ALLOC,
 	HEAP_FREE,
 	HEAP_REALLOC,
+	HEAP_ALLOC_AT,
 
 	HEAP_MAX_EVENTS
 };
@@ -71,6 +72,23 @@ typedef void (*heap_listener_resize_cb_t)(uintptr_t heap_id,
 typedef void (*heap_listener_alloc_cb_t)(uintptr_t heap_id,
 					 void *mem, size_t bytes);
 
+/**
+ * @typedef heap_listener_alloc_at_cb_t
+ * @brief Callback used when there is heap allocation, with its call site
+ *
+ * @note Only sys_heap reports call sites, and only with
+ *       CONFIG_SYS_HEAP_PROFILE enabled. Otherwise, or for other heaps,
+ *       @a call_site is NULL.
+ *
+ * @param heap_id Heap identifier
+ * @param mem Pointer to the allocated memory
+ * @param bytes Size of allocated memory
+ * @param call_site Return address of the allocation function call
+ */
+typedef void (*heap_listener_alloc_at_cb_t)(uintptr_t heap_id,
+					    void *mem, size_t bytes,
+					    void *call_site);
+
 /**
  * @typedef heap_listener_free_cb_t
  * @brief Callback used when memory is freed from heap
@@ -109,6 +127,7 @@ struct heap_listener {
 
 	union {
 		heap_listener_alloc_cb_t alloc_cb;
+		heap_listener_alloc_at_cb_t alloc_at_cb;
 		heap_listener_free_cb_t free_cb;
 		heap_listener_resize_cb_t resize_cb;
 	};
@@ -147,6 +166,21 @@ void heap_listener_unregister(struct heap_listener *listener);
  */
 void heap_listener_notify_alloc(uintptr_t heap_id, void *mem, size_t bytes);
 
+/**
+ * @brief Notify listeners of heap allocation event, with its call site
+ *
+ * Same as heap_listener_notify_alloc(), for heaps able to tell where the
+ * allocation was made from. Listeners of both HEAP_ALLOC and HEAP_ALLOC_AT
+ * events are notified.
+ *
+ * @param heap_id Heap identifier
+ * @param mem Pointer to the allocated memory
+ * @param bytes Size of allocated memory
+ * @param call_site Return address of the allocation function call
+ */
+void heap_listener_notify_alloc_at(uintptr_t heap_id, void *mem, size_t bytes,
+				   void *call_site);
+
 /**
  * @brief Notify listeners of heap free event
  *
@@ -214,6 +248,22 @@ void heap_listener_notify_resize(uintptr_t heap_id, void *old_heap_end, void *ne
 		}, \
 	}
 
+/**
+ * @brief Define heap event listener node for allocation event with call site
+ *
+ * @param name		Name of the heap event listener object
+ * @param _heap_id	Identifier of the heap to be listened
+ * @param _alloc_at_cb	Function to be called for allocation event
+ */
+#define HEAP_LISTENER_ALLOC_AT_DEFINE(name, _heap_id, _alloc_at_cb) \
+	struct heap_listener name = { \
+		.heap_id = _heap_id, \
+		.event = HEAP_ALLOC_AT, \
+		{ \
+			.alloc_at_cb = _alloc_at_cb \
+		}, \
+	}
+
 /**
  * @brief Define heap event listener node for free event
  *
@@ -279,6 +329,15 @@ static inline void heap_listener_notify_alloc(uintptr_t heap_id, void *mem, size
 	ARG_UNUSED(bytes);
 }
 
+static inline void heap_listener_notify_alloc_at(uintptr_t heap_id, void *mem, size_t bytes,
+						 void *call_site)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+	ARG_UNUSED(bytes);
+	ARG_UNUSED(call_site);
+}
+
 static inline void heap_listener_notify_free(uintptr_t heap_id, void *mem, size_t bytes)
 {
 	ARG_UNUSED(heap_id);
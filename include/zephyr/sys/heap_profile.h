@@ -0,0 +1,215 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_
+#define ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys/sys_heap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_SYS_HEAP_PROFILE) || defined(__DOXYGEN__)
+
+/**
+ * @defgroup heap_profile_apis Heap Profiler APIs
+ * @ingroup heaps
+ * @{
+ */
+
+/** @brief Allocation statistics of one call site */
+struct sys_heap_profile_site {
+	/** Return address of the sys_heap allocation call */
+	void *call_site;
+	/** Number of allocations made */
+	uint32_t allocs;
+	/** Number of those allocations since freed */
+	uint32_t frees;
+	/** Bytes allocated in total */
+	uint64_t total_bytes;
+	/** Bytes currently allocated */
+	size_t live_bytes;
+	/** Summed lifetime of the freed allocations, in milliseconds */
+	uint64_t lifetime_ms;
+};
+
+/** @cond INTERNAL_HIDDEN */
+struct z_heap_profile_block {
+	void *mem;
+	size_t bytes;
+	uint32_t stamp;
+	uint8_t site;
+	bool resized;
+};
+/** @endcond */
+
+/**
+ * @brief Allocation profile of a sys_heap
+ *
+ * All fields are private, use sys_heap_profile_dump() or
+ * sys_heap_profile_site_get() to read them.
+ */
+struct sys_heap_profile {
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	struct sys_heap *heap;
+	struct k_spinlock *lock;
+	struct heap_listener alloc_listener;
+	struct heap_listener free_listener;
+	uint32_t size_hist[CONFIG_SYS_HEAP_PROFILE_SIZE_BUCKETS];
+	uint32_t untracked;
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES];
+	struct z_heap_profile_block blocks[CONFIG_SYS_HEAP_PROFILE_BLOCKS];
+	/** @endcond */
+};
+
+/**
+ * @typedef sys_heap_profile_print_t
+ * @brief printf() like function used to dump a profile
+ *
+ * @param ctx Context passed to sys_heap_profile_dump()
+ * @param fmt Format string
+ * @param ap Format arguments
+ */
+typedef void (*sys_heap_profile_print_t)(void *ctx, const char *fmt, va_list ap);
+
+/**
+ * @brief Start profiling a heap
+ *
+ * Registers heap listeners that record, from then on:
+ *
+ * - a histogram of allocation sizes, in power-of-two byte classes,
+ * - per call site counts and live and total bytes, for the
+ *   CONFIG_SYS_HEAP_PROFILE_SITES busiest sites,
+ * - the lifetime of up to CONFIG_SYS_HEAP_PROFILE_BLOCKS live blocks.
+ *
+ * Allocations that do not fit these tables are only accounted for in
+ * the size histogram and in an "untracked" counter.
+ *
+ * The call site is the return address of the allocation call. For
+ * allocations made through k_heap, k_malloc() or malloc(), it is the
+ * return address of those APIs rather than of the sys_heap calls they
+ * make.
+ *
+ * Dumping a profile walks the free lists of the heap, which must not
+ * change meanwhile: @a lock is held for that, as it is by the owner of
+ * the heap around any other use of it.
+ *
+ * @param profile Profile object, owned by the profiler until stopped
+ * @param heap Heap to profile
+ * @param lock Lock of the owner of @a heap, such as the lock of a
+ *        k_heap, or NULL if the heap is not used concurrently with dumps
+ * @retval 0 on success
+ * @retval -EBUSY if the profile or the heap is already in use
+ */
+int sys_heap_profile_start(struct sys_heap_profile *profile, struct sys_heap *heap,
+			   struct k_spinlock *lock);
+
+/**
+ * @brief Stop profiling a heap
+ *
+ * The recorded data can still be read once stopped.
+ *
+ * @param profile Profile to stop
+ */
+void sys_heap_profile_stop(struct sys_heap_profile *profile);
+
+/**
+ * @brief Clear the data recorded by a profile
+ *
+ * Blocks allocated before the reset are no longer tracked.
+ *
+ * @param profile Profile to clear
+ */
+void sys_heap_profile_reset(struct sys_heap_profile *profile);
+
+/**
+ * @brief Get the statistics of one call site
+ *
+ * Sites are kept in no particular order, iterate from zero until an
+ * error is returned.
+ *
+ * @param profile Profile to read
+ * @param idx Site index
+ * @param site Where to copy the statistics
+ * @retval 0 on success
+ * @retval -ENOENT if there is no such site
+ */
+int sys_heap_profile_site_get(struct sys_heap_profile *profile, unsigned int idx,
+			      struct sys_heap_profile_site *site);
+
+/**
+ * @brief Compute the fragmentation of a heap's free memory
+ *
+ * The index is 1 - (largest free chunk / total free memory), in per
+ * mille: 0 when all free memory is contiguous, close to 1000 when it is
+ * scattered in small chunks.
+ *
+ * As with sys_heap_print_info(), the heap must not be modified
+ * concurrently: callers must hold the lock of the owner of the heap.
+ *
+ * @param heap Heap to inspect
+ * @param free_bytes If not NULL, where to store the free memory size
+ * @param largest_free If not NULL, where to store the largest free chunk size
+ * @return Fragmentation index, in per mille
+ */
+unsigned int sys_heap_fragmentation(struct sys_heap *heap, size_t *free_bytes,
+				    size_t *largest_free);
+
+/**
+ * @brief Dump a profile
+ *
+ * Sites are listed busiest first.
+ *
+ * @param profile Profile to dump
+ * @param print Output function
+ * @param ctx Context passed to @a print
+ */
+void sys_heap_profile_dump(struct sys_heap_profile *profile,
+			   sys_heap_profile_print_t print, void *ctx);
+
+/**
+ * @brief Dump a profile to the console
+ *
+ * @param profile Profile to dump
+ */
+void sys_heap_profile_print(struct sys_heap_profile *profile);
+
+/**
+ * @typedef sys_heap_profile_cb_t
+ * @brief Callback used to iterate over running profiles
+ *
+ * @param profile A running profile
+ * @param user_data Data passed to sys_heap_profile_foreach()
+ */
+typedef void (*sys_heap_profile_cb_t)(struct sys_heap_profile *profile, void *user_data);
+
+/**
+ * @brief Iterate over running profiles
+ *
+ * Profiles are not started or stopped during the iteration, and must
+ * not be from the callback. This cannot be called from an ISR.
+ *
+ * @param cb Function called for each profile
+ * @param user_data Data passed to @a cb
+ */
+void sys_heap_profile_foreach(sys_heap_profile_cb_t cb, void *user_data);
+
+/** @} */
+
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HEAP_PROFILE_H_ */
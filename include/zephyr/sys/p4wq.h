@@ -31,12 +31,21 @@ typedef void (*k_p4wq_done_handler_t)(struct k_p4wq_work *work);
  * User-populated struct representing a single work item.  The
  * priority and deadline fields are interpreted as thread scheduling
  * priorities, exactly as per k_thread_priority_set() and
- * k_thread_deadline_set().
+ * k_thread_deadline_set().  Items of equal priority are thus run in
+ * earliest-deadline-first order.
+ *
+ * With CONFIG_SCHED_CPU_MASK, a non-zero cpu_mask restricts the
+ * worker thread running the item to the given CPUs (bit N for CPU
+ * N) for the duration of the handler.  Zero leaves the worker's own
+ * CPU mask in place.
  */
 struct k_p4wq_work {
 	/* Filled out by submitting code */
 	int32_t priority;
 	int32_t deadline;
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t cpu_mask;
+#endif /* CONFIG_SCHED_CPU_MASK */
 	k_p4wq_handler_t handler;
 	bool sync;
 	struct k_sem done_sem;
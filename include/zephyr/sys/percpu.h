@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Per-CPU variables
+ *
+ * Data updated by every CPU, such as statistics counters, makes its cache
+ * line bounce between the cores writing to it. Per-CPU variables instead
+ * give each CPU its own copy, on a cache line of its own. Readers combine
+ * the copies of all CPUs when they need the overall value.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_PERCPU_H_
+#define ZEPHYR_INCLUDE_SYS_PERCPU_H_
+
+#include <zephyr/toolchain.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup percpu_apis Per-CPU variables
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Alignment keeping data written by different CPUs apart
+ *
+ * This is the cache line size on SMP, while uniprocessor builds do not
+ * need any padding.
+ */
+#ifdef CONFIG_SMP
+#define PERCPU_ALIGN CONFIG_SMP_CACHE_LINE_SIZE
+#else
+#define PERCPU_ALIGN 1
+#endif /* CONFIG_SMP */
+
+/**
+ * @brief Align an object so that it starts its own cache line on SMP
+ *
+ * Structures with this attribute are also padded to full cache lines,
+ * which makes elements of arrays of them never share one.
+ */
+#define __percpu_aligned __aligned(PERCPU_ALIGN)
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_PERCPU_TYPE(name) struct z_percpu_##name
+
+#define Z_PERCPU_TYPE_DEFINE(type, name)						\
+	Z_PERCPU_TYPE(name) {								\
+		type val;								\
+	} __percpu_aligned
+/** @endcond */
+
+/**
+ * @brief Declare a per-CPU variable
+ *
+ * The file defining the variable with PERCPU_DEFINE() must see this
+ * declaration first.
+ *
+ * @param type Type of the variable
+ * @param name Name of the variable
+ */
+#define PERCPU_DECLARE(type, name)							\
+	Z_PERCPU_TYPE_DEFINE(type, name);						\
+	extern Z_PERCPU_TYPE(name) name[CONFIG_MP_MAX_NUM_CPUS]
+
+/**
+ * @brief Define a per-CPU variable declared with PERCPU_DECLARE()
+ *
+ * The copies of all CPUs are zero-initialized.
+ *
+ * @param name Name of the variable
+ */
+#define PERCPU_DEFINE(name) Z_PERCPU_TYPE(name) name[CONFIG_MP_MAX_NUM_CPUS]
+
+/**
+ * @brief Define a per-CPU variable local to a file
+ *
+ * The copies of all CPUs are zero-initialized.
+ *
+ * @param type Type of the variable
+ * @param name Name of the variable
+ */
+#define PERCPU_DEFINE_STATIC(type, name)						\
+	Z_PERCPU_TYPE_DEFINE(type, name);						\
+	static Z_PERCPU_TYPE(name) name[CONFIG_MP_MAX_NUM_CPUS]
+
+/**
+ * @brief Get a pointer to the copy of a per-CPU variable for a given CPU
+ *
+ * Readers typically go through all copies, with @p cpu up to
+ * arch_num_cpus().
+ *
+ * @param name Name of the variable
+ * @param cpu CPU index
+ * @return Pointer to the copy of @p cpu
+ */
+#define PERCPU_PTR(name, cpu) (&(name)[(cpu)].val)
+
+/**
+ * @brief Get a pointer to the copy of a per-CPU variable for the current CPU
+ *
+ * Unless interrupts are locked or the thread is pinned to a CPU, the
+ * thread may migrate right after this. Users must either prevent that
+ * or only do updates which tolerate it, like atomic operations: the
+ * point is to avoid sharing cache lines, not to serialize accesses.
+ *
+ * @param name Name of the variable
+ * @return Pointer to the copy of the current CPU
+ */
+#ifdef CONFIG_SMP
+#define PERCPU_GET(name) PERCPU_PTR(name, arch_curr_cpu()->id)
+#else
+#define PERCPU_GET(name) PERCPU_PTR(name, 0)
+#endif /* CONFIG_SMP */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_PERCPU_H_ */
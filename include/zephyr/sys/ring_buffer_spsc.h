@@ -0,0 +1,266 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RING_BUFFER_SPSC_H_
+#define ZEPHYR_INCLUDE_SYS_RING_BUFFER_SPSC_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @defgroup ring_buffer_spsc_apis Lock-free SPSC Ring Buffer APIs
+ * @ingroup datastructure_apis
+ *
+ * @brief Byte ring buffer for one producer and one consumer, without locks.
+ *
+ * Same byte and zero-copy API as @ref ring_buffer_apis, for the common case
+ * of one context writing and another one reading, such as an ISR and a
+ * thread. The read and write positions are published with atomics, so the
+ * two sides need neither a lock nor irq_lock() around the calls.
+ *
+ * @warning Only one context may put and only one context may get. Several
+ * producers or several consumers still need their own serialization.
+ *
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+
+#define RING_BUF_SPSC_MAX_SIZE (INT32_MAX / 2)
+
+/** @endcond */
+
+/**
+ * @brief A lock-free single producer single consumer ring buffer
+ */
+struct ring_buf_spsc {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *buffer;
+	uint32_t size;
+	/* Positions run over twice the size, so full and empty differ */
+	atomic_t head;
+	atomic_t tail;
+	/* Claimed and not finished yet, private to each side */
+	uint32_t put_claimed;
+	uint32_t get_claimed;
+	/** @endcond */
+};
+
+/**
+ * @brief Statically initialize a lock-free SPSC ring buffer.
+ *
+ * @param buf Data area of the ring buffer.
+ * @param size8 Size of the data area (in bytes).
+ */
+#define RING_BUF_SPSC_INIT(buf, size8)                                                             \
+	{                                                                                          \
+		.buffer = buf,                                                                     \
+		.size = size8,                                                                     \
+		.head = ATOMIC_INIT(0),                                                            \
+		.tail = ATOMIC_INIT(0),                                                            \
+	}
+
+/**
+ * @brief Define and initialize a lock-free SPSC ring buffer.
+ *
+ * @param name Name of the ring buffer.
+ * @param size8 Size of the ring buffer (in bytes).
+ */
+#define RING_BUF_SPSC_DECLARE(name, size8)                                                         \
+	BUILD_ASSERT((size8) <= RING_BUF_SPSC_MAX_SIZE, "Size too big");                           \
+	static uint8_t __noinit _ring_buffer_spsc_data_##name[size8];                              \
+	struct ring_buf_spsc name = RING_BUF_SPSC_INIT(_ring_buffer_spsc_data_##name, size8)
+
+/**
+ * @brief Initialize a lock-free SPSC ring buffer.
+ *
+ * Must not be called while the ring buffer is in use.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size (in bytes).
+ * @param data Ring buffer data area (uint8_t data[size]).
+ */
+static inline void ring_buf_spsc_init(struct ring_buf_spsc *buf, uint32_t size, uint8_t *data)
+{
+	__ASSERT(size <= RING_BUF_SPSC_MAX_SIZE, "Size too big");
+
+	buf->buffer = data;
+	buf->size = size;
+	buf->put_claimed = 0U;
+	buf->get_claimed = 0U;
+	atomic_set(&buf->head, 0);
+	atomic_set(&buf->tail, 0);
+}
+
+/** @cond INTERNAL_HIDDEN */
+
+static inline uint32_t ring_buf_spsc_used(const struct ring_buf_spsc *buf, uint32_t head,
+					  uint32_t tail)
+{
+	return (head >= tail) ? (head - tail) : (head + 2U * buf->size - tail);
+}
+
+/** @endcond */
+
+/**
+ * @brief Determine size of available data in a lock-free SPSC ring buffer.
+ *
+ * The result is exact from the consumer, and a lower bound elsewhere.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer data size (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_size_get(struct ring_buf_spsc *buf)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+
+	return ring_buf_spsc_used(buf, (uint32_t)atomic_get(&buf->head), tail);
+}
+
+/**
+ * @brief Determine free space in a lock-free SPSC ring buffer.
+ *
+ * The result is exact from the producer, and a lower bound elsewhere.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_space_get(struct ring_buf_spsc *buf)
+{
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+
+	return buf->size - ring_buf_spsc_used(buf, head, (uint32_t)atomic_get(&buf->tail));
+}
+
+/**
+ * @brief Determine if a lock-free SPSC ring buffer is empty.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+static inline bool ring_buf_spsc_is_empty(struct ring_buf_spsc *buf)
+{
+	return atomic_get(&buf->head) == atomic_get(&buf->tail);
+}
+
+/**
+ * @brief Return lock-free SPSC ring buffer capacity.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline uint32_t ring_buf_spsc_capacity_get(const struct ring_buf_spsc *buf)
+{
+	return buf->size;
+}
+
+/**
+ * @brief Allocate buffer for writing data to a lock-free SPSC ring buffer.
+ *
+ * Producer only. Works like ring_buf_put_claim(): the returned area is
+ * contiguous, so it can be smaller than requested when the buffer wraps,
+ * and successive claims return the following areas.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested allocation size (in bytes).
+ *
+ * @return Size of allocated buffer, 0 if the ring buffer is full.
+ */
+uint32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Make written data visible to the consumer.
+ *
+ * Producer only. Works like ring_buf_put_finish(): @p size bytes from the
+ * start of the claimed areas are handed over and the rest is released.
+ *
+ * @param buf  Address of ring buffer.
+ * @param size Number of valid bytes in the allocated buffers.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed size.
+ */
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *buf, uint32_t size);
+
+/**
+ * @brief Write (copy) data to a lock-free SPSC ring buffer.
+ *
+ * Producer only.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written.
+ */
+uint32_t ring_buf_spsc_put(struct ring_buf_spsc *buf, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Get address of valid data in a lock-free SPSC ring buffer.
+ *
+ * Consumer only. Works like ring_buf_get_claim().
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a location within
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Number of valid bytes in the provided buffer, 0 if the ring buffer
+ *	   is empty.
+ */
+uint32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Release read data to the producer.
+ *
+ * Consumer only. Works like ring_buf_get_finish(): @p size bytes from the
+ * start of the claimed areas are freed and the rest stays available.
+ *
+ * @param  buf  Address of ring buffer.
+ * @param  size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Provided @a size exceeds the claimed size.
+ */
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *buf, uint32_t size);
+
+/**
+ * @brief Read data from a lock-free SPSC ring buffer.
+ *
+ * Consumer only.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard data.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes read.
+ */
+uint32_t ring_buf_spsc_get(struct ring_buf_spsc *buf, uint8_t *data, uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RING_BUFFER_SPSC_H_ */
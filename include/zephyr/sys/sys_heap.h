@@ -202,6 +202,30 @@ void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes);
 void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 			       size_t align, size_t bytes);
 
+/** @cond INTERNAL_HIDDEN */
+
+/*
+ * Where an allocation API was called from, as reported to heap listeners.
+ * Allocators built on sys_heap take it in their own entry points and pass
+ * it down, so that it does not point into the allocator itself.
+ */
+#ifdef CONFIG_SYS_HEAP_PROFILE
+#define Z_HEAP_CALL_SITE() __builtin_return_address(0)
+#else
+#define Z_HEAP_CALL_SITE() NULL
+#endif
+
+void *z_sys_heap_noalign_alloc_at(struct sys_heap *heap, size_t align, size_t bytes,
+				  void *call_site);
+
+void *z_sys_heap_aligned_alloc_at(struct sys_heap *heap, size_t align, size_t bytes,
+				  void *call_site);
+
+void *z_sys_heap_aligned_realloc_at(struct sys_heap *heap, void *ptr, size_t align,
+				    size_t bytes, void *call_site);
+
+/** @endcond */
+
 /** @brief Return allocated memory size
  *
  * Returns the size, in bytes, of a block returned from a successful
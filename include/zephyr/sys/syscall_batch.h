@@ -0,0 +1,100 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/syscall.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup syscall_batch System call batching
+ * @ingroup usermode_apis
+ * @brief Run several system calls in one kernel entry
+ *
+ * A user thread making many small system calls in a row pays for the trap
+ * into the kernel each time. Handing them over as a batch pays for it once.
+ * Each call of a batch is checked as thoroughly as when made alone, and a
+ * failed check kills the thread the same way.
+ * @{
+ */
+
+/** @brief One system call of a batch */
+struct k_syscall_batch_entry {
+	/** System call ID, K_SYSCALL_ followed by the name of the function in upper case */
+	uintptr_t id;
+	/**
+	 * Arguments, as passed by the generated user mode wrapper: 64-bit
+	 * values take two words on 32-bit targets, timeouts are passed as
+	 * their ticks, and calls with more than 6 words of arguments take a
+	 * pointer to the rest as the last one.
+	 */
+	uintptr_t args[6];
+	/** Return value, set by k_syscall_batch() */
+	uintptr_t ret;
+};
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_SYSCALL_BATCH_ARG(arg) ((uintptr_t)(arg))
+/** @endcond */
+
+/**
+ * @brief Initializer of a batch entry
+ *
+ * For instance, to give a semaphore then put a message in a queue:
+ *
+ * @code{.c}
+ * struct k_syscall_batch_entry batch[] = {
+ *         K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_GIVE, &sem),
+ *         K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_MSGQ_PUT, &msgq, &msg, 0),
+ * };
+ *
+ * k_syscall_batch(batch, ARRAY_SIZE(batch));
+ * @endcode
+ *
+ * @param _id System call ID.
+ * @param ... Up to 6 arguments.
+ */
+#define K_SYSCALL_BATCH_ENTRY(_id, ...)                                                     \
+	{                                                                                   \
+		.id = (_id),                                                                \
+		.args = {FOR_EACH(Z_SYSCALL_BATCH_ARG, (,), __VA_ARGS__)},                  \
+	}
+
+/**
+ * @brief Run a batch of system calls
+ *
+ * Runs the calls in order, as if they were made one after another, and
+ * stores the return value of each in its entry. A call that blocks blocks
+ * the batch. Batches cannot be nested.
+ *
+ * Only user threads need this: supervisor threads call the functions
+ * directly, and get -ENOTSUP.
+ *
+ * @param entries Calls to make.
+ * @param count Number of calls, at most @kconfig{CONFIG_SYSCALL_BATCH_MAX}.
+ *
+ * @retval 0 All calls were made.
+ * @retval -EINVAL Too many calls.
+ * @retval -ENOTSUP Called from supervisor mode.
+ */
+__syscall int k_syscall_batch(struct k_syscall_batch_entry *entries, size_t count);
+
+/** @} */
+
+#include <zephyr/syscalls/syscall_batch.h>
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_ */
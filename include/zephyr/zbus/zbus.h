@@ -65,6 +65,13 @@ struct zbus_channel_data {
 	struct net_buf_pool *msg_subscriber_pool;
 #endif /* ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION */
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK) || defined(__DOXYGEN__)
+	/** Message sequence counter. Odd while the message is being changed, readers copying
+	 * the message without the semaphore retry when it changed under them.
+	 */
+	atomic_t seq;
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 #if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS) || defined(__DOXYGEN__)
 	/** Kernel timestamp of the last publish action on this channel */
 	k_ticks_t publish_timestamp;
@@ -1126,6 +1133,30 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+/**
+ * @brief Wait for channel messages and take the pending ones at once.
+ *
+ * This routine waits for a message like zbus_sub_wait_msg() does, then takes without waiting the
+ * messages already queued behind it, up to @p max. A message larger than @p msg_size stops the
+ * batch and stays queued.
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chans Array of at least @p max entries for the notification channels' references.
+ * @param[out] msgs Array of at least @p max slots of @p msg_size bytes for the message copies.
+ * @param[in] msg_size Size of each slot of @p msgs.
+ * @param[in] max Maximum number of messages to take.
+ * @param[in] timeout Waiting period for the first message arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages taken, when positive.
+ * @retval -ENOMSG Could not retrieve a net_buf from the subscriber FIFO.
+ * @retval -EMSGSIZE The first message is larger than @p msg_size.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_msg_batch(const struct zbus_observer *sub, const struct zbus_channel **chans,
+			    void *msgs, size_t msg_size, size_t max, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 /**
@@ -0,0 +1,93 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN      0x001
+#define ZVFS_EPOLLPRI     0x002
+#define ZVFS_EPOLLOUT     0x004
+#define ZVFS_EPOLLERR     0x008
+#define ZVFS_EPOLLHUP     0x010
+#define ZVFS_EPOLLONESHOT BIT(30)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+#define ZVFS_EPOLL_CLOEXEC 0x80000
+
+typedef union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zvfs_epoll_data_t;
+
+struct zvfs_epoll_event {
+	uint32_t events;
+	zvfs_epoll_data_t data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance keeps a set of file descriptors registered once with
+ * @ref zvfs_epoll_ctl. The file descriptors becoming ready are queued on
+ * the instance as they are signaled, so that @ref zvfs_epoll_wait only
+ * looks at those instead of polling the whole set.
+ *
+ * @param flags 0 or ZVFS_EPOLL_CLOEXEC, which has no effect.
+ *
+ * @return New ZVFS epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of a ZVFS epoll instance
+ *
+ * Interests are level-triggered, unless ZVFS_EPOLLONESHOT is given: then
+ * the file descriptor is reported once and must be re-enabled with
+ * ZVFS_EPOLL_CTL_MOD. Edge-triggered interests are not supported.
+ *
+ * A file descriptor should be removed before it is closed. A socket
+ * closed while registered is removed when it is found closed.
+ *
+ * @param epfd  ZVFS epoll file descriptor
+ * @param op    ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd    File descriptor to act on
+ * @param event Events to watch and data to report, unused for
+ *              ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for events on a ZVFS epoll instance
+ *
+ * @param epfd      ZVFS epoll file descriptor
+ * @param events    Array to store the events in
+ * @param maxevents Size of @a events
+ * @param timeout   Timeout in milliseconds, negative to wait forever
+ *
+ * @return Number of events stored in @a events, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
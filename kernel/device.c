@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <string.h>
 #include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/kobject.h>
@@ -130,6 +132,81 @@ size_t z_device_get_all_static(struct device const **devices)
 	return cnt;
 }
 
+#ifdef CONFIG_DEVICE_INIT_LAZY
+/* Guards the init_thread of the lazy devices, never held across an init function */
+static K_MUTEX_DEFINE(lazy_init_lock);
+static K_CONDVAR_DEFINE(lazy_init_done);
+
+static void device_init_lazy(const struct device *dev);
+
+static int lazy_init_dep(const struct device *dev, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (((dev->flags & DEVICE_FLAG_INIT_LAZY) != 0U) && !dev->state->initialized) {
+		device_init_lazy(dev);
+	}
+
+	return 0;
+}
+
+/*
+ * The first user of a device claims it by setting its init_thread, and
+ * initializes it with no lock held, so that the init function can sleep or
+ * wait on other threads using other lazy devices. Concurrent users of the
+ * same device wait for it to be done. A device checked again by the thread
+ * initializing it, e.g. by its own driver, is reported as not ready yet.
+ */
+static void device_init_lazy(const struct device *dev)
+{
+	struct device_state *state = dev->state;
+	bool locked = !k_is_pre_kernel();
+	bool claimed = false;
+
+	/* Init functions may sleep */
+	if (k_is_in_isr()) {
+		return;
+	}
+
+	if (locked) {
+		(void)k_mutex_lock(&lazy_init_lock, K_FOREVER);
+
+		while ((state->init_thread != NULL) && (state->init_thread != _current)) {
+			(void)k_condvar_wait(&lazy_init_done, &lazy_init_lock, K_FOREVER);
+		}
+	}
+
+	if (!state->initialized && (state->init_thread == NULL)) {
+		state->init_thread = _current;
+		claimed = true;
+	}
+
+	if (locked) {
+		(void)k_mutex_unlock(&lazy_init_lock);
+	}
+
+	if (!claimed) {
+		return;
+	}
+
+#ifdef CONFIG_DEVICE_DEPS
+	(void)device_required_foreach(dev, lazy_init_dep, NULL);
+#endif /* CONFIG_DEVICE_DEPS */
+	(void)z_impl_device_init(dev);
+
+	if (locked) {
+		(void)k_mutex_lock(&lazy_init_lock, K_FOREVER);
+	}
+
+	state->init_thread = NULL;
+
+	if (locked) {
+		(void)k_condvar_broadcast(&lazy_init_done);
+		(void)k_mutex_unlock(&lazy_init_lock);
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_LAZY */
+
 bool z_impl_device_is_ready(const struct device *dev)
 {
 	/*
@@ -140,6 +217,12 @@ bool z_impl_device_is_ready(const struct device *dev)
 		return false;
 	}
 
+#ifdef CONFIG_DEVICE_INIT_LAZY
+	if (((dev->flags & DEVICE_FLAG_INIT_LAZY) != 0U) && !dev->state->initialized) {
+		device_init_lazy(dev);
+	}
+#endif /* CONFIG_DEVICE_INIT_LAZY */
+
 	return dev->state->initialized && (dev->state->init_res == 0U);
 }
 
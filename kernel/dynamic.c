@@ -13,6 +13,8 @@
 #include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/kobject.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/init.h>
+#include <string.h>
 
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
@@ -56,6 +58,216 @@ static k_thread_stack_t *z_thread_stack_alloc_pool(size_t size)
 	return stack;
 }
 
+#ifdef CONFIG_DYNAMIC_THREAD_STACK_CACHE
+#define STACK_CACHE_CLASSES  CONFIG_DYNAMIC_THREAD_STACK_CACHE_CLASSES
+#define STACK_CACHE_DEPTH    CONFIG_DYNAMIC_THREAD_STACK_CACHE_DEPTH
+#define STACK_CACHE_NO_CLASS UINT8_MAX
+#define STACK_HDR_MAGIC      0x53544b43U /* "STKC" */
+
+/* Heap-allocated kernel stacks are preceded by this header, so that
+ * the free path knows their size class.
+ */
+struct stack_hdr {
+	uint32_t magic;
+	uint8_t cls;
+};
+
+#define STACK_HDR_SIZE ROUND_UP(sizeof(struct stack_hdr), Z_KERNEL_STACK_OBJ_ALIGN)
+
+struct stack_magazine {
+	uint8_t count;
+	k_thread_stack_t *stacks[STACK_CACHE_DEPTH];
+};
+
+/* Each CPU only touches its own magazines, with interrupts masked */
+struct stack_cache {
+#ifdef CONFIG_OBJ_CORE_STATS_STACK_CACHE
+	struct k_obj_core obj_core;
+	struct k_thread_stack_cache_stats stats[CONFIG_MP_MAX_NUM_CPUS];
+#endif /* CONFIG_OBJ_CORE_STATS_STACK_CACHE */
+	struct stack_magazine mag[CONFIG_MP_MAX_NUM_CPUS][STACK_CACHE_CLASSES];
+};
+
+static struct stack_cache stack_cache;
+
+#ifdef CONFIG_OBJ_CORE_STATS_STACK_CACHE
+/* The stats of all CPUs are read and reset from any CPU */
+static struct k_spinlock lock;
+
+#define STACK_CACHE_STAT_INC(cpu, field)		\
+	do {						\
+		K_SPINLOCK(&lock) {			\
+			stack_cache.stats[cpu].field++;	\
+		}					\
+	} while (false)
+#else
+#define STACK_CACHE_STAT_INC(cpu, field) do { } while (false)
+#endif /* CONFIG_OBJ_CORE_STATS_STACK_CACHE */
+
+static inline size_t stack_class_size(unsigned int cls)
+{
+	return (size_t)CONFIG_DYNAMIC_THREAD_STACK_CACHE_MIN_SIZE << cls;
+}
+
+static unsigned int stack_class(size_t size)
+{
+	for (unsigned int cls = 0; cls < STACK_CACHE_CLASSES; cls++) {
+		if (size <= stack_class_size(cls)) {
+			return cls;
+		}
+	}
+
+	return STACK_CACHE_NO_CLASS;
+}
+
+static k_thread_stack_t *stack_cache_get(unsigned int cls)
+{
+	k_thread_stack_t *stack = NULL;
+	unsigned int key = arch_irq_lock();
+	unsigned int cpu = _current_cpu->id;
+	struct stack_magazine *mag = &stack_cache.mag[cpu][cls];
+
+	if (mag->count > 0U) {
+		stack = mag->stacks[--mag->count];
+		STACK_CACHE_STAT_INC(cpu, hits);
+	} else {
+		STACK_CACHE_STAT_INC(cpu, misses);
+	}
+	arch_irq_unlock(key);
+
+	return stack;
+}
+
+static bool stack_cache_put(k_thread_stack_t *stack, unsigned int cls)
+{
+	bool cached = false;
+	unsigned int key = arch_irq_lock();
+	unsigned int cpu = _current_cpu->id;
+	struct stack_magazine *mag = &stack_cache.mag[cpu][cls];
+
+	if (mag->count < STACK_CACHE_DEPTH) {
+		mag->stacks[mag->count++] = stack;
+		cached = true;
+		STACK_CACHE_STAT_INC(cpu, cached);
+	} else {
+		STACK_CACHE_STAT_INC(cpu, released);
+	}
+	arch_irq_unlock(key);
+
+	return cached;
+}
+
+static k_thread_stack_t *stack_cache_alloc(size_t size)
+{
+	unsigned int cls = stack_class(size);
+	struct stack_hdr *hdr;
+
+	if (cls != STACK_CACHE_NO_CLASS) {
+		k_thread_stack_t *stack = stack_cache_get(cls);
+
+		if (stack != NULL) {
+			return stack;
+		}
+
+		/* Stacks of a class must be interchangeable */
+		size = stack_class_size(cls);
+	}
+
+	hdr = z_thread_aligned_alloc(Z_KERNEL_STACK_OBJ_ALIGN,
+				     STACK_HDR_SIZE + K_KERNEL_STACK_LEN(size));
+	if (hdr == NULL) {
+		return NULL;
+	}
+
+	hdr->magic = STACK_HDR_MAGIC;
+	hdr->cls = cls;
+
+	return (k_thread_stack_t *)((uint8_t *)hdr + STACK_HDR_SIZE);
+}
+
+static void stack_cache_free(k_thread_stack_t *stack)
+{
+	struct stack_hdr *hdr = (struct stack_hdr *)((uint8_t *)stack - STACK_HDR_SIZE);
+
+	__ASSERT(hdr->magic == STACK_HDR_MAGIC, "stack %p not from the heap", stack);
+
+	if ((hdr->cls == STACK_CACHE_NO_CLASS) || !stack_cache_put(stack, hdr->cls)) {
+		k_free(hdr);
+	}
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_STACK_CACHE
+static struct k_obj_type obj_type_stack_cache;
+
+static int stack_cache_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	ARG_UNUSED(obj_core);
+
+	K_SPINLOCK(&lock) {
+		memcpy(stats, stack_cache.stats, sizeof(stack_cache.stats));
+	}
+
+	return 0;
+}
+
+static int stack_cache_stats_query(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_thread_stack_cache_stats *ptr = stats;
+
+	ARG_UNUSED(obj_core);
+
+	memset(ptr, 0, sizeof(*ptr));
+	K_SPINLOCK(&lock) {
+		for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+			ptr->hits += stack_cache.stats[i].hits;
+			ptr->misses += stack_cache.stats[i].misses;
+			ptr->cached += stack_cache.stats[i].cached;
+			ptr->released += stack_cache.stats[i].released;
+		}
+	}
+
+	return 0;
+}
+
+static int stack_cache_stats_reset(struct k_obj_core *obj_core)
+{
+	ARG_UNUSED(obj_core);
+
+	K_SPINLOCK(&lock) {
+		memset(stack_cache.stats, 0, sizeof(stack_cache.stats));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc stack_cache_stats_desc = {
+	.raw_size = sizeof(stack_cache.stats),
+	.query_size = sizeof(struct k_thread_stack_cache_stats),
+	.raw   = stack_cache_stats_raw,
+	.query = stack_cache_stats_query,
+	.reset = stack_cache_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static int init_stack_cache_obj_core_list(void)
+{
+	z_obj_type_init(&obj_type_stack_cache, K_OBJ_TYPE_STACK_CACHE_ID,
+			offsetof(struct stack_cache, obj_core));
+	k_obj_type_stats_init(&obj_type_stack_cache, &stack_cache_stats_desc);
+
+	k_obj_core_init_and_link(K_OBJ_CORE(&stack_cache), &obj_type_stack_cache);
+	k_obj_core_stats_register(K_OBJ_CORE(&stack_cache), stack_cache.stats,
+				  sizeof(stack_cache.stats));
+
+	return 0;
+}
+
+SYS_INIT(init_stack_cache_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_STATS_STACK_CACHE */
+#endif /* CONFIG_DYNAMIC_THREAD_STACK_CACHE */
+
 static k_thread_stack_t *z_thread_stack_alloc_dyn(size_t size, int flags)
 {
 	if ((flags & K_USER) == K_USER) {
@@ -69,7 +281,11 @@ static k_thread_stack_t *z_thread_stack_alloc_dyn(size_t size, int flags)
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 	}
 
+#ifdef CONFIG_DYNAMIC_THREAD_STACK_CACHE
+	return stack_cache_alloc(size);
+#else
 	return z_thread_aligned_alloc(Z_KERNEL_STACK_OBJ_ALIGN, K_KERNEL_STACK_LEN(size));
+#endif /* CONFIG_DYNAMIC_THREAD_STACK_CACHE */
 }
 
 k_thread_stack_t *z_impl_k_thread_stack_alloc(size_t size, int flags)
@@ -143,12 +359,14 @@ int z_impl_k_thread_stack_free(k_thread_stack_t *stack)
 #ifdef CONFIG_USERSPACE
 		if (k_object_find(stack)) {
 			k_object_free(stack);
-		} else {
-			k_free(stack);
+			return 0;
 		}
+#endif /* CONFIG_USERSPACE */
+#ifdef CONFIG_DYNAMIC_THREAD_STACK_CACHE
+		stack_cache_free(stack);
 #else
 		k_free(stack);
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_DYNAMIC_THREAD_STACK_CACHE */
 	} else {
 		LOG_DBG("Invalid stack %p", stack);
 		return -EINVAL;
@@ -32,6 +32,7 @@
 #include <zephyr/sys/check.h>
 /* private kernel APIs */
 #include <wait_q.h>
+#include <wait_stats.h>
 #include <ksched.h>
 
 #define K_EVENT_WAIT_ANY      0x00   /* Wait for any events */
@@ -49,6 +50,47 @@ struct event_walk_data {
 static struct k_obj_type obj_type_event;
 #endif /* CONFIG_OBJ_CORE_EVENT */
 
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+static int event_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_event *event = CONTAINER_OF(obj_core, struct k_event, obj_core);
+
+	K_SPINLOCK(&event->lock) {
+		memcpy(stats, &event->wait_stats, sizeof(event->wait_stats));
+	}
+
+	return 0;
+}
+
+static int event_stats_reset(struct k_obj_core *obj_core)
+{
+	struct k_event *event = CONTAINER_OF(obj_core, struct k_event, obj_core);
+
+	K_SPINLOCK(&event->lock) {
+		z_wait_stats_reset(&event->wait_stats, 0U);
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc event_stats_desc = {
+	.raw_size = sizeof(struct k_obj_wait_stats),
+	.query_size = sizeof(struct k_obj_wait_stats),
+	.raw   = event_stats_raw,
+	.query = event_stats_raw,
+	.reset = event_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static void event_stats_init(struct k_event *event)
+{
+	z_wait_stats_init(&event->wait_stats, 0U);
+	k_obj_core_stats_register(K_OBJ_CORE(event), &event->wait_stats,
+				  sizeof(event->wait_stats));
+}
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
+
 void z_impl_k_event_init(struct k_event *event)
 {
 	__ASSERT_NO_MSG(!arch_is_in_isr());
@@ -65,6 +107,9 @@ void z_impl_k_event_init(struct k_event *event)
 #ifdef CONFIG_OBJ_CORE_EVENT
 	k_obj_core_init_and_link(K_OBJ_CORE(event), &obj_type_event);
 #endif /* CONFIG_OBJ_CORE_EVENT */
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	event_stats_init(event);
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
 }
 
 #ifdef CONFIG_USERSPACE
@@ -155,22 +200,27 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	 * is done in three steps:
 	 *
 	 * 1. Walk the waitq and create a linked list of threads to unpend.
-	 * 2. Unpend each of the threads in the linked list
-	 * 3. Ready each of the threads in the linked list
+	 * 2. Unpend and ready all the threads in the linked list as a
+	 *    single batch, so that the scheduler is locked once and each
+	 *    CPU gets at most one IPI however many threads are woken.
 	 */
 
 	z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
 
 	if (data.head != NULL) {
-		thread = data.head;
+		struct z_sched_wake_batch batch;
 		struct k_thread *next;
+
+		thread = data.head;
+		z_sched_wake_batch_begin(&batch);
 		do {
 			arch_thread_return_value_set(thread, 0);
 			thread->events = events;
 			next = thread->next_event_link;
-			z_sched_wake_thread(thread, false);
+			z_sched_wake_batch_add(&batch, thread);
 			thread = next;
 		} while (thread != NULL);
+		(void)z_sched_wake_batch_end(&batch);
 	}
 
 	z_reschedule(&event->lock, key);
@@ -277,6 +327,10 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 
 	/* Match conditions have not been met. */
 
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	z_wait_stats_unavailable(&event->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&event->lock, key);
 		goto out;
@@ -293,7 +347,19 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_event, wait, event, events,
 					   options, timeout);
 
-	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) == 0) {
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	uint32_t start = z_wait_stats_pend(&event->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
+
+	int ret = z_pend_curr(&event->lock, key, &event->wait_q, timeout);
+
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	K_SPINLOCK(&event->lock) {
+		z_wait_stats_woken(&event->wait_stats, start, ret);
+	}
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
+
+	if (ret == 0) {
 		/* Retrieve the set of events that woke the thread */
 		rv = thread->events;
 	}
@@ -354,11 +420,17 @@ static int init_event_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_event, K_OBJ_TYPE_EVENT_ID,
 			offsetof(struct k_event, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+	k_obj_type_stats_init(&obj_type_event, &event_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
 
 	/* Initialize and link statically defined condvars */
 
 	STRUCT_SECTION_FOREACH(k_event, event) {
 		k_obj_core_init_and_link(K_OBJ_CORE(event), &obj_type_event);
+#ifdef CONFIG_OBJ_CORE_STATS_EVENT
+		event_stats_init(event);
+#endif /* CONFIG_OBJ_CORE_STATS_EVENT */
 	}
 
 	return 0;
@@ -107,6 +107,28 @@ void *z_thread_aligned_alloc(size_t align, size_t size);
  */
 void *z_thread_malloc(size_t size);
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+/**
+ * @brief Allocate a small block from the current CPU's cache of a heap
+ *
+ * Refills the cache from the heap if needed, and never blocks.
+ *
+ * @param heap Heap to allocate from
+ * @param bytes Allocation size
+ * @return The block, or NULL if @a bytes is too large to be cached or the
+ * heap is exhausted
+ */
+void *z_heap_cache_alloc(struct k_heap *heap, size_t bytes);
+
+/**
+ * @brief Give the blocks in the caches of all CPUs back to a heap
+ *
+ * @param heap Heap to flush the caches of
+ * @return true if any block was given back
+ */
+bool z_heap_cache_flush(struct k_heap *heap);
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 
 #ifdef CONFIG_USE_SWITCH
 /* This is a arch function traditionally, but when the switch-based
@@ -243,6 +265,24 @@ bool pm_system_suspend(int32_t ticks);
 
 #endif /* CONFIG_PM */
 
+#ifdef CONFIG_DEMAND_PAGING_STATS
+/**
+ * Remember a data page selected for eviction, to detect refaults.
+ *
+ * @param addr Virtual address of the evicted data page.
+ */
+void z_paging_stats_evicted(void *addr);
+
+/**
+ * Tell whether a page fault is a refault.
+ *
+ * @param addr Faulting virtual address.
+ *
+ * @return True if the data page is among the last evicted ones.
+ */
+bool z_paging_stats_is_refault(void *addr);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 /**
  * Initialize the timing histograms for demand paging.
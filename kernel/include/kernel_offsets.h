@@ -40,9 +40,9 @@ GEN_OFFSET_SYM(_cpu_t, fp_ctx);
 GEN_OFFSET_SYM(_kernel_t, idle);
 #endif /* CONFIG_PM */
 
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifndef CONFIG_SCHED_CPU_READY_Q
 GEN_OFFSET_SYM(_kernel_t, ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_READY_Q */
 
 #ifndef CONFIG_SMP
 GEN_OFFSET_SYM(_ready_q_t, cache);
@@ -72,6 +72,13 @@ void z_requeue_current(struct k_thread *curr);
 struct k_thread *z_swap_next_thread(void);
 void z_thread_abort(struct k_thread *thread);
 void move_thread_to_end_of_prio_q(struct k_thread *thread);
+#ifdef CONFIG_SCHED_CPU_MASK
+/* Set the CPU mask of a thread which is either the current one or
+ * neither queued nor running. The current thread moves to an allowed CPU right away
+ * if the new mask excludes the one it runs on.
+ */
+void z_sched_cpu_mask_set(struct k_thread *thread, uint32_t cpu_mask);
+#endif /* CONFIG_SCHED_CPU_MASK */
 bool thread_is_sliceable(struct k_thread *thread);
 
 static inline void z_reschedule_unlocked(void)
@@ -240,27 +247,70 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Like invoking z_sched_wake() until there are no more threads to wake up,
+ * but done as a single batch (see z_sched_wake_batch_begin()).
  *
- * @param wait_q Wait queue to wake up the highest prio thread
- * @param swap_retval Swap return value for woken thread
+ * @param wait_q Wait queue to wake up the threads of
+ * @param swap_retval Swap return value for woken threads
  * @param swap_data Data return value to supplement swap_retval. May be NULL.
- * @retval true If any threads were woken up
- * @retval false If the wait_q was empty
+ * @return Number of threads woken up
  */
-static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
-				    void *swap_data)
-{
-	bool woken = false;
+int z_sched_wake_all(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
+/**
+ * State of a batched wakeup
+ *
+ * Opaque to callers, lives on the stack between z_sched_wake_batch_begin()
+ * and z_sched_wake_batch_end().
+ */
+struct z_sched_wake_batch {
+	k_spinlock_key_t key;
+	uint32_t ipi_mask;
+	int woken;
+	bool queued;
+};
 
-	/* True if we woke at least one thread up */
-	return woken;
-}
+/**
+ * Start a batched wakeup
+ *
+ * Takes the scheduler lock, which is then held until
+ * z_sched_wake_batch_end().  Threads added to the batch in between are
+ * unpended and queued in one go; the scheduler cache is updated and the
+ * IPIs they need are flagged only once, when the batch ends, so waking N
+ * threads costs one lock round trip and at most one IPI per CPU.
+ *
+ * No other scheduler API may be called, and no lock other than the
+ * timeout queue locks taken, while a batch is in progress.
+ *
+ * @param batch Batch state
+ */
+void z_sched_wake_batch_begin(struct z_sched_wake_batch *batch);
+
+/**
+ * Add a thread to a batched wakeup
+ *
+ * Removes the thread from the wait queue it pends on, if any, cancels its
+ * timeout and makes it ready.  As with z_sched_wake_thread(), killed
+ * threads are not made ready.  The caller sets the thread's swap return
+ * value beforehand if needed.
+ *
+ * @param batch Batch state
+ * @param thread Thread to wake up
+ */
+void z_sched_wake_batch_add(struct z_sched_wake_batch *batch,
+			    struct k_thread *thread);
+
+/**
+ * Finish a batched wakeup
+ *
+ * Flags the IPIs needed by the woken threads and releases the scheduler
+ * lock.  Any rescheduling is left to the caller, typically through
+ * z_reschedule(), which also sends the IPIs.
+ *
+ * @param batch Batch state
+ * @return Number of threads added to the batch
+ */
+int z_sched_wake_batch_end(struct z_sched_wake_batch *batch);
 
 /**
  * Atomically put the current thread to sleep on a wait queue, with timeout
@@ -347,4 +397,52 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+uint32_t z_sched_latency_now(void);
+void z_sched_latency_record(struct k_thread *thread);
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+/*
+ * Called with the scheduler lock held when @a thread is made ready,
+ * starts a wake-to-run latency sample.
+ */
+static inline void z_sched_latency_ready(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	thread->base.ready_stamp = z_sched_latency_now();
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+}
+
+/*
+ * Called with local interrupts masked when @a thread is about to be
+ * switched in on the current CPU, completes its pending sample if any.
+ */
+static inline void z_sched_latency_switch(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+#ifdef CONFIG_SCHED_LATENCY_STATS
+	if (thread->base.ready_stamp != 0U) {
+		z_sched_latency_record(thread);
+	}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+}
+
+#ifdef CONFIG_PERF_COUNTERS
+void z_perf_counters_switch(void);
+void z_thread_perf_counters_get(struct k_thread *thread, uint64_t *counts);
+#endif /* CONFIG_PERF_COUNTERS */
+
+/*
+ * Called with local interrupts masked before the current thread is
+ * switched out, attributes the events counted since the previous call
+ * to it.
+ */
+static inline void z_sched_perf_counters_switch(void)
+{
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	z_perf_counters_switch();
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+}
+
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
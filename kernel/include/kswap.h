@@ -103,6 +103,11 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 
 	old_thread = _current;
 
+#ifdef CONFIG_IRQ_STATS_LOCK
+	/* Interrupts stay masked only until the switch */
+	z_irq_stats_unlocking(key);
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
 	z_check_stack_sentinel();
 
 	old_thread->swap_retval = -EAGAIN;
@@ -122,6 +127,8 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 
 	if (new_thread != old_thread) {
 		z_sched_usage_switch(new_thread);
+		z_sched_latency_switch(new_thread);
+		z_sched_perf_counters_switch();
 
 #ifdef CONFIG_SMP
 		new_thread->base.cpu = arch_curr_cpu()->id;
@@ -260,6 +260,9 @@ static inline void k_mem_assert_phys_aligned(uintptr_t phys)
 
 extern struct k_mem_page_frame k_mem_page_frames[K_MEM_NUM_PAGE_FRAMES];
 
+/* Serializes page table updates between the core and arch code */
+extern struct k_spinlock z_mm_lock;
+
 static inline uintptr_t k_mem_page_frame_to_phys(struct k_mem_page_frame *pf)
 {
 	return (uintptr_t)((pf - k_mem_page_frames) * CONFIG_MMU_PAGE_SIZE) +
@@ -28,6 +28,28 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0U;
+#endif /* CONFIG_TIMEOUT_SLACK */
+}
+
+/* Sets how long past its expiry the timeout may fire, so that its wakeup
+ * can be shared with that of other timeouts.  Only takes effect on the
+ * next z_add_timeout(); ignored without CONFIG_TIMEOUT_SLACK.
+ */
+static inline void z_set_timeout_slack(struct _timeout *to, k_timeout_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	if (K_TIMEOUT_EQ(slack, K_FOREVER)) {
+		to->slack = UINT32_MAX;
+	} else {
+		__ASSERT(Z_IS_TIMEOUT_RELATIVE(slack), "slack must be relative");
+		to->slack = (uint32_t)MIN((uint64_t)slack.ticks, UINT32_MAX);
+	}
+#else
+	ARG_UNUSED(to);
+	ARG_UNUSED(slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
 }
 
 /* Adds the timeout to the queue.
@@ -36,6 +58,24 @@ static inline void z_init_timeout(struct _timeout *to)
  */
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout);
 
+/* Adds the timeout to the queue of a given CPU.
+ *
+ * With CONFIG_TIMEOUT_PER_CPU the timeout expires on, and its callback
+ * runs on, @p cpu; a negative value selects the calling CPU.  Without
+ * it this behaves like z_add_timeout().
+ *
+ * @return Absolute tick value when timeout will expire.
+ */
+k_ticks_t z_add_timeout_on(struct _timeout *to, _timeout_func_t fn,
+			   k_timeout_t timeout, int cpu);
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Reprograms the local timer if another CPU queued an earlier timeout
+ * for this CPU.  Called from the scheduler IPI handler.
+ */
+void z_timeout_q_reprogram(void);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
@@ -56,9 +96,28 @@ static inline void z_init_thread_timeout(struct _thread_base *thread_base)
 
 extern void z_thread_timeout(struct _timeout *timeout);
 
+/* CPU a thread's timeout is queued on: the CPU it is pinned to, if any,
+ * so that its wakeup does not need to cross CPUs.
+ */
+static inline int z_thread_timeout_cpu(struct k_thread *thread)
+{
+#if defined(CONFIG_TIMEOUT_PER_CPU) && defined(CONFIG_SCHED_CPU_MASK)
+	uint32_t mask = thread->base.cpu_mask;
+
+	if (IS_POWER_OF_TWO(mask)) {
+		return (int)find_lsb_set(mask) - 1;
+	}
+#else
+	ARG_UNUSED(thread);
+#endif /* CONFIG_TIMEOUT_PER_CPU && CONFIG_SCHED_CPU_MASK */
+
+	return -1;
+}
+
 static inline k_ticks_t z_add_thread_timeout(struct k_thread *thread, k_timeout_t ticks)
 {
-	return z_add_timeout(&thread->base.timeout, z_thread_timeout, ticks);
+	return z_add_timeout_on(&thread->base.timeout, z_thread_timeout, ticks,
+				z_thread_timeout_cpu(thread));
 }
 
 static inline void z_abort_thread_timeout(struct k_thread *thread)
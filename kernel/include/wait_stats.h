@@ -0,0 +1,83 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_WAIT_STATS_H_
+#define ZEPHYR_KERNEL_INCLUDE_WAIT_STATS_H_
+
+/**
+ * @file
+ * @brief contention statistics of the kernel objects threads pend on
+ *
+ * All the helpers are to be called with the lock protecting the object
+ * held.  A pending thread calls z_wait_stats_pend() right before
+ * z_pend_curr() and, once it has taken the lock again,
+ * z_wait_stats_woken() with the start time and the value returned by
+ * z_pend_curr().
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#ifdef CONFIG_OBJ_CORE_STATS_WAIT
+
+static inline void z_wait_stats_unavailable(struct k_obj_wait_stats *stats)
+{
+	stats->unavailable++;
+}
+
+static inline uint32_t z_wait_stats_pend(struct k_obj_wait_stats *stats)
+{
+	stats->pended++;
+	stats->waiting++;
+	stats->max_waiting = MAX(stats->max_waiting, stats->waiting);
+
+	return k_cycle_get_32();
+}
+
+static inline void z_wait_stats_woken(struct k_obj_wait_stats *stats,
+				      uint32_t start, int ret)
+{
+	uint32_t wait = k_cycle_get_32() - start;
+
+	/* A reset while pending may have cleared the count already */
+	if (stats->waiting != 0U) {
+		stats->waiting--;
+	}
+	if (ret == -EAGAIN) {
+		stats->timeouts++;
+	}
+	stats->total_wait += wait;
+	stats->max_wait = MAX(stats->max_wait, wait);
+}
+
+static inline void z_wait_stats_level(struct k_obj_wait_stats *stats,
+				      uint32_t level)
+{
+	stats->max_level = MAX(stats->max_level, level);
+}
+
+static inline void z_wait_stats_init(struct k_obj_wait_stats *stats,
+				     uint32_t level)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->max_level = level;
+}
+
+/* Keeps the pending threads accounted, the maximums restart from now */
+static inline void z_wait_stats_reset(struct k_obj_wait_stats *stats,
+				      uint32_t level)
+{
+	uint32_t waiting = stats->waiting;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->waiting = waiting;
+	stats->max_waiting = waiting;
+	stats->max_level = level;
+}
+
+#endif /* CONFIG_OBJ_CORE_STATS_WAIT */
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_WAIT_STATS_H_ */
@@ -34,6 +34,7 @@
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/debug/gcov.h>
+#include <zephyr/debug/boot_timeline.h>
 #include <kswap.h>
 #include <zephyr/timing/timing.h>
 #include <zephyr/logging/log.h>
@@ -337,6 +338,194 @@ static int do_device_init(const struct device *dev)
 	return rc;
 }
 
+static void init_entry_run(const struct init_entry *entry, enum init_level level)
+{
+	const struct device *dev = entry->dev;
+	int result = 0;
+#ifdef CONFIG_BOOT_TIMELINE
+	uint32_t start = k_cycle_get_32();
+#endif /* CONFIG_BOOT_TIMELINE */
+
+	sys_trace_sys_init_enter(entry, level);
+	if (dev != NULL) {
+		if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
+			result = do_device_init(dev);
+		}
+	} else {
+		result = entry->init_fn();
+	}
+	sys_trace_sys_init_exit(entry, level, result);
+
+#ifdef CONFIG_BOOT_TIMELINE
+	z_boot_timeline_init_entry(entry, level, start, result);
+#endif /* CONFIG_BOOT_TIMELINE */
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+
+/*
+ * The devices of a run go from pending to running to done, under the lock
+ * of the run. The devices outside of any run stay idle.
+ */
+#define INIT_STAGE_IDLE    0U
+#define INIT_STAGE_PENDING 1U
+#define INIT_STAGE_RUNNING 2U
+#define INIT_STAGE_DONE    3U
+
+/* Unused once the devices are initialized, but never given back */
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+
+/* Consecutive device entries of a level, initialized together */
+static struct {
+	struct k_mutex lock;
+	struct k_condvar changed;
+	const struct init_entry *start;
+	const struct init_entry *end;
+	enum init_level level;
+	size_t pending;
+	size_t running;
+} init_run;
+
+static bool init_deps_done(const struct device *dev)
+{
+	const device_handle_t *handles;
+	size_t count;
+
+	handles = device_required_handles_get(dev, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(handles[i]);
+
+		if ((dep != NULL) && ((dep->state->init_stage == INIT_STAGE_PENDING) ||
+				      (dep->state->init_stage == INIT_STAGE_RUNNING))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * First pending device whose dependencies are initialized. If none is
+ * but nothing is running either, the dependencies are circular or go
+ * against the init priorities: fall back to link order so that the run
+ * still completes.
+ */
+static const struct init_entry *init_run_next(void)
+{
+	const struct init_entry *first = NULL;
+
+	for (const struct init_entry *entry = init_run.start; entry < init_run.end; entry++) {
+		if (entry->dev->state->init_stage != INIT_STAGE_PENDING) {
+			continue;
+		}
+
+		if (init_deps_done(entry->dev)) {
+			return entry;
+		}
+
+		if (first == NULL) {
+			first = entry;
+		}
+	}
+
+	return (init_run.running == 0U) ? first : NULL;
+}
+
+static void init_run_work(void)
+{
+	const struct init_entry *entry;
+
+	k_mutex_lock(&init_run.lock, K_FOREVER);
+
+	while (init_run.pending > 0U) {
+		entry = init_run_next();
+		if (entry == NULL) {
+			(void)k_condvar_wait(&init_run.changed, &init_run.lock, K_FOREVER);
+			continue;
+		}
+
+		entry->dev->state->init_stage = INIT_STAGE_RUNNING;
+		init_run.pending--;
+		init_run.running++;
+		k_mutex_unlock(&init_run.lock);
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL_REPORT
+		uint32_t start_ms = k_uptime_get_32();
+		uint32_t start_cyc = k_cycle_get_32();
+
+		init_entry_run(entry, init_run.level);
+		LOG_INF("%s: init started at %u ms, took %u us, result %d", entry->dev->name,
+			start_ms, k_cyc_to_us_floor32(k_cycle_get_32() - start_cyc),
+			-(int)entry->dev->state->init_res);
+#else
+		init_entry_run(entry, init_run.level);
+#endif /* CONFIG_DEVICE_INIT_PARALLEL_REPORT */
+
+		k_mutex_lock(&init_run.lock, K_FOREVER);
+		entry->dev->state->init_stage = INIT_STAGE_DONE;
+		init_run.running--;
+		(void)k_condvar_broadcast(&init_run.changed);
+	}
+
+	k_mutex_unlock(&init_run.lock);
+}
+
+static void init_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	init_run_work();
+}
+
+/* Initialize the devices of entries start to end, the main thread helping the pool */
+static void init_run_parallel(enum init_level level, const struct init_entry *start,
+			      const struct init_entry *end)
+{
+	size_t pending = 0;
+	size_t threads;
+
+	for (const struct init_entry *entry = start; entry < end; entry++) {
+		if ((entry->dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
+			entry->dev->state->init_stage = INIT_STAGE_PENDING;
+			pending++;
+		}
+	}
+
+	if (pending == 0U) {
+		return;
+	}
+
+	k_mutex_init(&init_run.lock);
+	k_condvar_init(&init_run.changed);
+	init_run.start = start;
+	init_run.end = end;
+	init_run.level = level;
+	init_run.pending = pending;
+	init_run.running = 0U;
+
+	threads = MIN(pending - 1U, ARRAY_SIZE(init_threads));
+
+	for (size_t i = 0; i < threads; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]), init_thread_entry,
+				NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "device_init");
+	}
+
+	init_run_work();
+
+	for (size_t i = 0; i < threads; i++) {
+		(void)k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -363,21 +552,35 @@ static void z_sys_init_run_level(enum init_level level)
 		__init_end,
 	};
 	const struct init_entry *entry;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL_REPORT
+	uint32_t start_ms = k_uptime_get_32();
+#endif /* CONFIG_DEVICE_INIT_PARALLEL_REPORT */
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int result = 0;
-
-		sys_trace_sys_init_enter(entry, level);
-		if (dev != NULL) {
-			if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
-				result = do_device_init(dev);
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		/* Devices between two SYS_INIT() entries are initialized together */
+		if (((level == INIT_LEVEL_POST_KERNEL) || (level == INIT_LEVEL_APPLICATION)) &&
+		    (entry->dev != NULL)) {
+			const struct init_entry *end = entry;
+
+			while ((end < levels[level+1]) && (end->dev != NULL)) {
+				end++;
 			}
-		} else {
-			result = entry->init_fn();
+
+			init_run_parallel(level, entry, end);
+			entry = end - 1;
+			continue;
 		}
-		sys_trace_sys_init_exit(entry, level, result);
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+		init_entry_run(entry, level);
 	}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL_REPORT
+	if ((level == INIT_LEVEL_POST_KERNEL) || (level == INIT_LEVEL_APPLICATION)) {
+		LOG_INF("init level %d took %u ms", level, k_uptime_get_32() - start_ms);
+	}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL_REPORT */
 }
 
 
@@ -574,6 +777,10 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	z_mem_manage_boot_finish();
 #endif /* CONFIG_MMU */
 
+#ifdef CONFIG_BOOT_TIMELINE
+	z_boot_timeline_event(BOOT_TIMELINE_MAIN);
+#endif /* CONFIG_BOOT_TIMELINE */
+
 #ifdef CONFIG_BOOTARGS
 	extern int main(int, char **);
 
@@ -770,6 +977,10 @@ __boot_func
 FUNC_NO_STACK_PROTECTOR
 FUNC_NORETURN void z_cstart(void)
 {
+#ifdef CONFIG_BOOT_TIMELINE
+	z_boot_timeline_event(BOOT_TIMELINE_KERNEL_START);
+#endif /* CONFIG_BOOT_TIMELINE */
+
 	/* gcov hook needed to get the coverage report.*/
 	gcov_static_init();
 
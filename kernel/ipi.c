@@ -7,17 +7,53 @@
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
+#include <timeout_q.h>
 
 #ifdef CONFIG_TRACE_SCHED_IPI
 extern void z_trace_sched_ipi(void);
 #endif
 
+#ifdef CONFIG_SCHED_IPI_STATS
+/* Updated from any CPU */
+static struct {
+	atomic_t requested;
+	atomic_t sent;
+	atomic_t received;
+} ipi_stats[CONFIG_MP_MAX_NUM_CPUS];
+
+static void ipi_stats_count(uint32_t ipi_mask, bool sent)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if ((ipi_mask & BIT(i)) != 0) {
+			atomic_inc(sent ? &ipi_stats[i].sent : &ipi_stats[i].requested);
+		}
+	}
+}
+
+int k_ipi_stats_get(int cpu, struct k_ipi_stats *stats)
+{
+	if ((stats == NULL) || (cpu < 0) || ((unsigned int)cpu >= arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	stats->requested = (uint32_t)atomic_get(&ipi_stats[cpu].requested);
+	stats->sent = (uint32_t)atomic_get(&ipi_stats[cpu].sent);
+	stats->received = (uint32_t)atomic_get(&ipi_stats[cpu].received);
+
+	return 0;
+}
+#endif /* CONFIG_SCHED_IPI_STATS */
 
 void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
 		atomic_or(&_kernel.pending_ipi, (atomic_val_t)ipi_mask);
+#ifdef CONFIG_SCHED_IPI_STATS
+		ipi_stats_count(ipi_mask & ~BIT(_current_cpu->id), false);
+#endif /* CONFIG_SCHED_IPI_STATS */
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 }
@@ -78,15 +114,32 @@ void signal_pending_ipi(void)
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
 		uint32_t  cpu_bitmap;
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_SCHED_IPI_STATS)
+		/* Stay on this CPU to leave it out, it is never sent an IPI */
+		unsigned int key = arch_irq_lock();
+#endif
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+#ifdef CONFIG_IPI_COALESCE
+		/* The CPUs yet to process an IPI will reschedule after our changes */
+		cpu_bitmap &= ~BIT(arch_curr_cpu()->id);
+		cpu_bitmap &= ~(uint32_t)atomic_or(&_kernel.ipi_in_flight,
+						   (atomic_val_t)cpu_bitmap);
+#endif /* CONFIG_IPI_COALESCE */
 		if (cpu_bitmap != 0) {
+#ifdef CONFIG_SCHED_IPI_STATS
+			ipi_stats_count(cpu_bitmap & ~BIT(arch_curr_cpu()->id), true);
+#endif /* CONFIG_SCHED_IPI_STATS */
 #ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
 			arch_sched_directed_ipi(cpu_bitmap);
 #else
 			arch_sched_broadcast_ipi();
 #endif
 		}
+
+#if defined(CONFIG_IPI_COALESCE) || defined(CONFIG_SCHED_IPI_STATS)
+		arch_irq_unlock(key);
+#endif
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 }
@@ -96,10 +149,23 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_IPI_COALESCE
+	/* From now on, changes need another IPI to be noticed */
+	(void)atomic_and(&_kernel.ipi_in_flight, ~(atomic_val_t)BIT(_current_cpu->id));
+#endif /* CONFIG_IPI_COALESCE */
+
+#ifdef CONFIG_SCHED_IPI_STATS
+	atomic_inc(&ipi_stats[_current_cpu->id].received);
+#endif /* CONFIG_SCHED_IPI_STATS */
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
 
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	z_timeout_q_reprogram();
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 #ifdef CONFIG_TIMESLICING
 	if (thread_is_sliceable(_current)) {
 		z_time_slice();
@@ -0,0 +1,253 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/irq.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/math_extras.h>
+#include <string.h>
+
+/*
+ * The statistics are only gathered on uniprocessor systems.  They are
+ * updated with interrupts masked, and read with interrupts masked.  The
+ * hooks mask interrupts with arch_irq_lock() directly, so that the
+ * masking they do is not measured, and the time base they read may take
+ * a spinlock: it is then taken from a masked state, which is not
+ * measured either.
+ */
+
+static uint32_t irq_stats_now(void)
+{
+	uint32_t now;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	now = (uint32_t)timing_counter_get();
+#else
+	now = k_cycle_get_32();
+#endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
+
+	/* A zero stamp means "no sample pending" */
+	return (now == 0U) ? 1U : now;
+}
+
+static void irq_stats_record(struct k_irq_stats *stats, uint32_t delta)
+{
+	unsigned int bucket = (delta < 2U) ? 0U : (31U - u32_count_leading_zeros(delta));
+
+	stats->hist[MIN(bucket, CONFIG_IRQ_STATS_BUCKETS - 1U)]++;
+	stats->total += delta;
+	stats->count++;
+	if (delta > stats->max) {
+		stats->max = delta;
+	}
+}
+
+#ifdef CONFIG_IRQ_STATS_ISR
+static struct k_irq_stats isr_stats[CONFIG_NUM_IRQS];
+
+/* Start and time spent in nested ISRs of each ISR being serviced */
+static struct {
+	uint32_t start;
+	uint32_t nested;
+} isr_frames[CONFIG_IRQ_STATS_MAX_NESTING];
+static unsigned int isr_depth;
+
+void z_irq_stats_isr_enter(void)
+{
+	unsigned int key = arch_irq_lock();
+
+	if (isr_depth < CONFIG_IRQ_STATS_MAX_NESTING) {
+		isr_frames[isr_depth].nested = 0U;
+		isr_frames[isr_depth].start = irq_stats_now();
+	}
+	isr_depth++;
+
+	arch_irq_unlock(key);
+}
+
+void z_irq_stats_isr_exit(unsigned int irq)
+{
+	unsigned int key = arch_irq_lock();
+
+	if (isr_depth == 0U) {
+		/* Reset while servicing an interrupt */
+		goto out;
+	}
+
+	isr_depth--;
+	if (isr_depth < CONFIG_IRQ_STATS_MAX_NESTING) {
+		uint32_t delta = irq_stats_now() - isr_frames[isr_depth].start;
+
+		if (irq < CONFIG_NUM_IRQS) {
+			irq_stats_record(&isr_stats[irq], delta - isr_frames[isr_depth].nested);
+		}
+
+		if (isr_depth > 0U) {
+			isr_frames[isr_depth - 1U].nested += delta;
+		}
+	}
+
+out:
+	arch_irq_unlock(key);
+}
+#endif /* CONFIG_IRQ_STATS_ISR */
+
+int k_irq_stats_get(unsigned int irq, struct k_irq_stats *stats)
+{
+	unsigned int key;
+
+	if ((stats == NULL) || (irq >= CONFIG_NUM_IRQS)) {
+		return -EINVAL;
+	}
+
+	key = arch_irq_lock();
+#ifdef CONFIG_IRQ_STATS_ISR
+	memcpy(stats, &isr_stats[irq], sizeof(*stats));
+#else
+	memset(stats, 0, sizeof(*stats));
+#endif /* CONFIG_IRQ_STATS_ISR */
+	arch_irq_unlock(key);
+
+	return 0;
+}
+
+#ifdef CONFIG_IRQ_STATS_LOCK
+static struct k_irq_lock_stats lock_stats;
+
+/* Outermost lock being measured */
+static uint32_t lock_start;
+static uintptr_t lock_addr;
+static struct k_thread *lock_thread;
+
+/*
+ * Keep the locations with the longest maskings, sorted longest first.
+ * The table is only searched when the masking is longer than the
+ * shortest one it holds.
+ */
+static void lock_holder_record(uintptr_t addr, uint32_t delta)
+{
+	struct k_irq_lock_holder *holders = lock_stats.holders;
+	unsigned int last = CONFIG_IRQ_STATS_LOCK_HOLDERS - 1U;
+	unsigned int i;
+
+	if (delta <= holders[last].max) {
+		return;
+	}
+
+	for (i = 0U; (i < last) && (holders[i].addr != addr); i++) {
+	}
+
+	if ((holders[i].addr == addr) && (delta <= holders[i].max)) {
+		return;
+	}
+
+	/* Drop entry i, the previous record of addr or the shortest one */
+	while ((i > 0U) && (holders[i - 1U].max < delta)) {
+		holders[i] = holders[i - 1U];
+		i--;
+	}
+
+	holders[i].addr = addr;
+	holders[i].max = delta;
+}
+
+static ALWAYS_INLINE void lock_start_record(unsigned int key, void *addr)
+{
+	if (arch_irq_unlocked(key)) {
+		lock_addr = (uintptr_t)addr;
+		lock_thread = _current;
+		lock_start = irq_stats_now();
+	}
+}
+
+void z_irq_stats_locked(unsigned int key)
+{
+	lock_start_record(key, __builtin_return_address(0));
+}
+
+void z_irq_stats_unlocking(unsigned int key)
+{
+	uint32_t delta;
+
+	if (!arch_irq_unlocked(key) || (lock_start == 0U)) {
+		return;
+	}
+
+	delta = irq_stats_now() - lock_start;
+	lock_start = 0U;
+
+	/* The lock was left by a context switch not seen here */
+	if (lock_thread != _current) {
+		return;
+	}
+
+	irq_stats_record(&lock_stats.masked, delta);
+	lock_holder_record(lock_addr, delta);
+}
+
+unsigned int z_irq_stats_lock(void)
+{
+	unsigned int key = arch_irq_lock();
+
+	lock_start_record(key, __builtin_return_address(0));
+
+	return key;
+}
+
+void z_irq_stats_unlock(unsigned int key)
+{
+	z_irq_stats_unlocking(key);
+	arch_irq_unlock(key);
+}
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
+int k_irq_lock_stats_get(struct k_irq_lock_stats *stats)
+{
+	unsigned int key;
+
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_IRQ_STATS_LOCK
+	key = arch_irq_lock();
+	memcpy(stats, &lock_stats, sizeof(*stats));
+	arch_irq_unlock(key);
+
+	return 0;
+#else
+	ARG_UNUSED(key);
+
+	return -ENOTSUP;
+#endif /* CONFIG_IRQ_STATS_LOCK */
+}
+
+void k_irq_stats_reset(void)
+{
+	unsigned int key = arch_irq_lock();
+
+#ifdef CONFIG_IRQ_STATS_ISR
+	memset(isr_stats, 0, sizeof(isr_stats));
+#endif /* CONFIG_IRQ_STATS_ISR */
+#ifdef CONFIG_IRQ_STATS_LOCK
+	memset(&lock_stats, 0, sizeof(lock_stats));
+	lock_start = 0U;
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
+	arch_irq_unlock(key);
+}
+
+/* Drop what was recorded before the memory and time base were set up */
+static int irq_stats_init(void)
+{
+	k_irq_stats_reset();
+
+	return 0;
+}
+
+SYS_INIT(irq_stats_init, POST_KERNEL, 0);
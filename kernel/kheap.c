@@ -8,14 +8,260 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <string.h>
 /* private kernel APIs */
+#include <kernel_internal.h>
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+/*
+ * Each CPU allocates from and frees to its own cache, under the lock of
+ * that cache only. Refills and drains take the heap lock first, then the
+ * cache lock, so that an allocation which does not fit can reclaim the
+ * blocks of all the caches while holding the heap lock.
+ *
+ * Frees bypass the caches while threads wait for memory. Waiters are
+ * counted before the caches are flushed, and frees check that count under
+ * the cache lock: a free either sees the waiter, or lands in a cache
+ * before the flush reclaims it.
+ */
+
+#define CACHE_CLASSES CONFIG_HEAP_PERCPU_CACHE_CLASSES
+#define CACHE_DEPTH   CONFIG_HEAP_PERCPU_CACHE_DEPTH
+#define CACHE_BATCH   MAX(CACHE_DEPTH / 2, 1)
+#define CACHE_CLASS_SIZE(cls) ((size_t)CONFIG_HEAP_PERCPU_CACHE_MIN_SIZE << (cls))
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_HEAP_PERCPU_CACHE_MIN_SIZE),
+	     "CONFIG_HEAP_PERCPU_CACHE_MIN_SIZE must be a power of two");
+
+/* Smallest class that can serve an allocation, or -1 */
+static int cache_class_alloc(size_t bytes)
+{
+	for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+		if (bytes <= CACHE_CLASS_SIZE(cls)) {
+			return cls;
+		}
+	}
+
+	return -1;
+}
+
+/* Class a freed block can serve without wasting half of it, or -1 */
+static int cache_class_free(size_t usable)
+{
+	for (int cls = CACHE_CLASSES - 1; cls >= 0; cls--) {
+		if (usable >= CACHE_CLASS_SIZE(cls)) {
+			return (usable < (2 * CACHE_CLASS_SIZE(cls))) ? cls : -1;
+		}
+	}
+
+	return -1;
+}
+
+static inline struct z_heap_cache *cache_get(struct k_heap *heap)
+{
+	return &heap->cache[arch_curr_cpu()->id];
+}
+
+/* Refill the current CPU's cache of a class and take a block from it */
+static void *cache_refill(struct k_heap *heap, int cls)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	struct z_heap_cache *cache = cache_get(heap);
+	k_spinlock_key_t cache_key = k_spin_lock(&cache->lock);
+	void *mem = NULL;
+
+	cache->misses++;
+
+	while (cache->count[cls] < CACHE_BATCH) {
+		mem = sys_heap_alloc(&heap->heap, CACHE_CLASS_SIZE(cls));
+		if (mem == NULL) {
+			break;
+		}
+		cache->blocks[cls][cache->count[cls]++] = mem;
+	}
+
+	if (cache->count[cls] > 0U) {
+		cache->refills++;
+		mem = cache->blocks[cls][--cache->count[cls]];
+	}
+
+	k_spin_unlock(&cache->lock, cache_key);
+	k_spin_unlock(&heap->lock, key);
+
+	return mem;
+}
+
+void *z_heap_cache_alloc(struct k_heap *heap, size_t bytes)
+{
+	int cls = cache_class_alloc(bytes);
+	struct z_heap_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	void *mem = NULL;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	irq = arch_irq_lock();
+	cache = cache_get(heap);
+	key = k_spin_lock(&cache->lock);
+
+	if (cache->count[cls] > 0U) {
+		cache->hits++;
+		mem = cache->blocks[cls][--cache->count[cls]];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	if (mem == NULL) {
+		mem = cache_refill(heap, cls);
+	}
+
+	return mem;
+}
+
+static void cache_drain_locked(struct k_heap *heap, struct z_heap_cache *cache,
+			       int cls, unsigned int keep)
+{
+	while (cache->count[cls] > keep) {
+		sys_heap_free(&heap->heap, cache->blocks[cls][--cache->count[cls]]);
+	}
+}
+
+/* Drain half of the current CPU's full cache of a class and cache mem in it */
+static bool cache_drain_and_free(struct k_heap *heap, int cls, void *mem)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	struct z_heap_cache *cache = cache_get(heap);
+	k_spinlock_key_t cache_key = k_spin_lock(&cache->lock);
+	bool cached = atomic_get(&heap->cache_waiters) == 0;
+
+	if (cached) {
+		if (cache->count[cls] == CACHE_DEPTH) {
+			cache_drain_locked(heap, cache, cls, CACHE_DEPTH - CACHE_BATCH);
+			cache->drains++;
+		}
+		cache->blocks[cls][cache->count[cls]++] = mem;
+	}
+
+	k_spin_unlock(&cache->lock, cache_key);
+	k_spin_unlock(&heap->lock, key);
+
+	return cached;
+}
+
+static bool cache_free(struct k_heap *heap, void *mem)
+{
+	struct z_heap_cache *cache;
+	k_spinlock_key_t key;
+	unsigned int irq;
+	bool cached = false;
+	bool full = false;
+	int cls;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	cls = cache_class_free(sys_heap_usable_size(&heap->heap, mem));
+	if (cls < 0) {
+		return false;
+	}
+
+	irq = arch_irq_lock();
+	cache = cache_get(heap);
+	key = k_spin_lock(&cache->lock);
+
+	/* Waiters need the memory back in the heap */
+	if (atomic_get(&heap->cache_waiters) == 0) {
+		full = cache->count[cls] == CACHE_DEPTH;
+		if (!full) {
+			cache->blocks[cls][cache->count[cls]++] = mem;
+			cached = true;
+		}
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq);
+
+	if (full) {
+		cached = cache_drain_and_free(heap, cls, mem);
+	}
+
+	return cached;
+}
+
+/* Give the blocks of the caches of all CPUs back to the heap */
+static bool cache_flush_locked(struct k_heap *heap)
+{
+	bool flushed = false;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cache *cache = &heap->cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			if (cache->count[cls] > 0U) {
+				cache_drain_locked(heap, cache, cls, 0U);
+				cache->drains++;
+				flushed = true;
+			}
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return flushed;
+}
+
+bool z_heap_cache_flush(struct k_heap *heap)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	bool flushed = cache_flush_locked(heap);
+
+	k_spin_unlock(&heap->lock, key);
+
+	return flushed;
+}
+
+int k_heap_cache_stats_get(struct k_heap *heap, struct k_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	*stats = (struct k_heap_cache_stats) {};
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cache *cache = &heap->cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		stats->hits += cache->hits;
+		stats->misses += cache->misses;
+		stats->refills += cache->refills;
+		stats->drains += cache->drains;
+		for (int cls = 0; cls < CACHE_CLASSES; cls++) {
+			stats->cached_bytes += cache->count[cls] * CACHE_CLASS_SIZE(cls);
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	heap->lock = (struct k_spinlock) {};
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	(void)memset(heap->cache, 0, sizeof(heap->cache));
+	atomic_clear(&heap->cache_waiters);
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 	sys_heap_init(&heap->heap, mem, bytes);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
@@ -63,10 +309,11 @@ SYS_INIT_NAMED(statics_init_pre, statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_
 SYS_INIT_NAMED(statics_init_post, statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
-typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes);
+typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes,
+				      void *call_site);
 
 static void *z_heap_alloc_helper(struct k_heap *heap, size_t align, size_t bytes,
-				 k_timeout_t timeout,
+				 k_timeout_t timeout, void *call_site,
 				 sys_heap_allocator_t *sys_heap_allocator)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
@@ -77,15 +324,35 @@ static void *z_heap_alloc_helper(struct k_heap *heap, size_t align, size_t bytes
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	bool blocked_alloc = false;
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	bool waiting = false;
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 
 	while (ret == NULL) {
-		ret = sys_heap_allocator(&heap->heap, align, bytes);
+		ret = sys_heap_allocator(&heap->heap, align, bytes, call_site);
+
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+		if ((ret == NULL) && cache_flush_locked(heap)) {
+			continue;
+		}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
 		}
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+		if (!waiting) {
+			/* Stop the caching of frees, then reclaim what was
+			 * cached since the flush above before pending.
+			 */
+			waiting = true;
+			atomic_inc(&heap->cache_waiters);
+			continue;
+		}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 		if (!blocked_alloc) {
 			blocked_alloc = true;
 
@@ -101,29 +368,50 @@ static void *z_heap_alloc_helper(struct k_heap *heap, size_t align, size_t bytes
 		key = k_spin_lock(&heap->lock);
 	}
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	if (waiting) {
+		atomic_dec(&heap->cache_waiters);
+	}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 	k_spin_unlock(&heap->lock, key);
 	return ret;
 }
 
-void *k_heap_alloc(struct k_heap *heap, size_t bytes, k_timeout_t timeout)
+static void *heap_alloc_at(struct k_heap *heap, size_t bytes, k_timeout_t timeout,
+			   void *call_site)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, alloc, heap, timeout);
 
-	void *ret = z_heap_alloc_helper(heap, 0, bytes, timeout,
-					sys_heap_noalign_alloc);
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	void *ret = z_heap_cache_alloc(heap, bytes);
+
+	if (ret == NULL) {
+		ret = z_heap_alloc_helper(heap, 0, bytes, timeout, call_site,
+					  z_sys_heap_noalign_alloc_at);
+	}
+#else
+	void *ret = z_heap_alloc_helper(heap, 0, bytes, timeout, call_site,
+					z_sys_heap_noalign_alloc_at);
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, alloc, heap, timeout, ret);
 
 	return ret;
 }
 
+void *k_heap_alloc(struct k_heap *heap, size_t bytes, k_timeout_t timeout)
+{
+	return heap_alloc_at(heap, bytes, timeout, Z_HEAP_CALL_SITE());
+}
+
 void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
 
-	void *ret = z_heap_alloc_helper(heap, align, bytes, timeout,
-					sys_heap_aligned_alloc);
+	void *ret = z_heap_alloc_helper(heap, align, bytes, timeout, Z_HEAP_CALL_SITE(),
+					z_sys_heap_aligned_alloc_at);
 
 	/*
 	 * modules/debug/percepio/TraceRecorder/kernelports/Zephyr/include/tracing_tracerecorder.h
@@ -147,7 +435,7 @@ void *k_heap_calloc(struct k_heap *heap, size_t num, size_t size, k_timeout_t ti
 	size_t bounds = 0U;
 
 	if (!size_mul_overflow(num, size, &bounds)) {
-		ret = k_heap_alloc(heap, bounds, timeout);
+		ret = heap_alloc_at(heap, bounds, timeout, Z_HEAP_CALL_SITE());
 	}
 	if (ret != NULL) {
 		(void)memset(ret, 0, bounds);
@@ -161,6 +449,7 @@ void *k_heap_calloc(struct k_heap *heap, size_t num, size_t size, k_timeout_t ti
 void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t timeout)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
+	void *call_site = Z_HEAP_CALL_SITE();
 	void *ret = NULL;
 
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
@@ -170,7 +459,7 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	while (ret == NULL) {
-		ret = sys_heap_realloc(&heap->heap, ptr, bytes);
+		ret = z_sys_heap_aligned_realloc_at(&heap->heap, ptr, 0, bytes, call_site);
 
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -190,6 +479,13 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	if (cache_free(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
@@ -13,6 +13,7 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/math_extras.h>
 #include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
@@ -92,6 +93,125 @@ static struct k_obj_core_stats_desc mem_slab_stats_desc = {
 #endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
 #endif /* CONFIG_OBJ_CORE_MEM_SLAB */
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+/*
+ * The lock-free free list head packs, from the least significant bit:
+ * a flag telling that threads may be pending on the slab, the index of
+ * the first free block plus one (zero when the list is empty), and a
+ * generation tag bumped on every update so that a compare-and-swap based
+ * on a stale head fails even if the same block is back at the top (ABA).
+ *
+ * The flag is only ever set while the list is empty, under the slab
+ * lock. Frees seeing it take the lock to wake a waiter, so blocks can
+ * never be left on the list while threads wait for one.
+ */
+#define SLAB_WAITERS 1UL
+#define SLAB_MIN_TAG_BITS 8
+
+static inline unsigned int slab_idx_bits(struct k_mem_slab *slab)
+{
+	return 32U - u32_count_leading_zeros(slab->info.num_blocks);
+}
+
+static inline char *slab_head_block(struct k_mem_slab *slab, atomic_val_t head)
+{
+	unsigned long idx = ((unsigned long)head >> 1) & BIT_MASK(slab_idx_bits(slab));
+
+	return (idx == 0UL) ? NULL : (slab->buffer + (idx - 1UL) * slab->info.block_size);
+}
+
+static inline atomic_val_t slab_head_pack(struct k_mem_slab *slab, atomic_val_t old,
+					  char *block, unsigned long waiters)
+{
+	unsigned int tag_shift = slab_idx_bits(slab) + 1U;
+	unsigned long tag = ((unsigned long)old >> tag_shift) + 1UL;
+	unsigned long idx = 0UL;
+
+	if (block != NULL) {
+		idx = ((uintptr_t)block - (uintptr_t)slab->buffer) / slab->info.block_size + 1UL;
+	}
+
+	return (atomic_val_t)((tag << tag_shift) | (idx << 1) | waiters);
+}
+
+static bool slab_pop(struct k_mem_slab *slab, void **mem)
+{
+	atomic_val_t old, new;
+	char *block;
+
+	do {
+		old = atomic_get(&slab->free_head);
+		block = slab_head_block(slab, old);
+		if (block == NULL) {
+			return false;
+		}
+
+		/*
+		 * The block may be allocated and overwritten under our
+		 * feet, in which case the tag changed and the CAS fails.
+		 */
+		new = slab_head_pack(slab, old, *(char * volatile *)block, 0UL);
+	} while (!atomic_cas(&slab->free_head, old, new));
+
+	*mem = block;
+
+	uint32_t used = __atomic_add_fetch(&slab->info.num_used, 1U, __ATOMIC_RELAXED);
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	uint32_t max_used = __atomic_load_n(&slab->info.max_used, __ATOMIC_RELAXED);
+
+	while ((used > max_used) &&
+	       !__atomic_compare_exchange_n(&slab->info.max_used, &max_used, used, true,
+					    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+	}
+#else
+	ARG_UNUSED(used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+
+	return true;
+}
+
+static bool slab_push(struct k_mem_slab *slab, void *mem)
+{
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(&slab->free_head);
+		if ((old & SLAB_WAITERS) != 0) {
+			return false;
+		}
+
+		*(char **)mem = slab_head_block(slab, old);
+		new = slab_head_pack(slab, old, mem, 0UL);
+	} while (!atomic_cas(&slab->free_head, old, new));
+
+	__atomic_sub_fetch(&slab->info.num_used, 1U, __ATOMIC_RELAXED);
+
+	return true;
+}
+
+/*
+ * Called with the slab lock held when the fast path found no block: take
+ * one if some got freed meanwhile, or flag the upcoming wait.
+ */
+static bool slab_pop_or_wait(struct k_mem_slab *slab, void **mem)
+{
+	atomic_val_t old;
+
+	for (;;) {
+		if (slab_pop(slab, mem)) {
+			return true;
+		}
+
+		old = atomic_get(&slab->free_head);
+		if ((slab_head_block(slab, old) == NULL) &&
+		    atomic_cas(&slab->free_head, old, old | SLAB_WAITERS)) {
+			return false;
+		}
+	}
+}
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -119,6 +239,16 @@ static int create_free_list(struct k_mem_slab *slab)
 		slab->free_list = p;
 		p -= slab->info.block_size;
 	}
+
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	CHECKIF((slab_idx_bits(slab) + 1U + SLAB_MIN_TAG_BITS) > ATOMIC_BITS) {
+		return -EINVAL;
+	}
+
+	atomic_set(&slab->free_head, slab_head_pack(slab, 0, slab->free_list, 0UL));
+	slab->free_list = NULL;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
+
 	return 0;
 }
 
@@ -220,11 +350,39 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	if (likely(slab_pop(slab, mem))) {
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		*mem = NULL;
+		result = -ENOMEM;
+	} else {
+		key = k_spin_lock(&slab->lock);
+		if (slab_pop_or_wait(slab, mem)) {
+			k_spin_unlock(&slab->lock, key);
+			result = 0;
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
+
+			result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
+			if (result == 0) {
+				*mem = _current->base.swap_data;
+			}
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
+
+	return result;
+#else
+	key = k_spin_lock(&slab->lock);
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -265,6 +423,7 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	k_spin_unlock(&slab->lock, key);
 
 	return result;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 }
 
 void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
@@ -275,6 +434,35 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+	if (likely(slab_push(slab, mem))) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+
+	/* Threads may be waiting, and the flag keeps blocks off the list */
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+	if (z_waitq_is_empty(&slab->wait_q)) {
+		atomic_and(&slab->free_head, ~SLAB_WAITERS);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+	if (pending_thread != NULL) {
+		z_thread_return_value_set_with_data(pending_thread, 0, mem);
+		z_ready_thread(pending_thread);
+		z_reschedule(&slab->lock, key);
+		return;
+	}
+
+	/* The waiters all timed out */
+	(void)slab_push(slab, mem);
+	k_spin_unlock(&slab->lock, key);
+#else
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -297,6 +485,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
 }
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
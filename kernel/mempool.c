@@ -8,11 +8,13 @@
 #include <string.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/util.h>
+#include <kernel_internal.h>
 
-typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes);
+typedef void * (sys_heap_allocator_t)(struct sys_heap *heap, size_t align, size_t bytes,
+				      void *call_site);
 
 static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
-			    sys_heap_allocator_t sys_heap_allocator)
+			    void *call_site, sys_heap_allocator_t sys_heap_allocator)
 {
 	void *mem;
 	struct k_heap **heap_ref;
@@ -38,9 +40,24 @@ static void *z_alloc_helper(struct k_heap *heap, size_t align, size_t size,
 	 * No point calling k_heap_malloc/k_heap_aligned_alloc with K_NO_WAIT.
 	 * Better bypass them and go directly to sys_heap_*() instead.
 	 */
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+	/* Only plain allocations come out of sys_heap_alloc() as cached */
+	mem = (align == 0) ? z_heap_cache_alloc(heap, size) : NULL;
+	if (mem == NULL) {
+		key = k_spin_lock(&heap->lock);
+		mem = sys_heap_allocator(&heap->heap, __align, size, call_site);
+		k_spin_unlock(&heap->lock, key);
+	}
+	if ((mem == NULL) && z_heap_cache_flush(heap)) {
+		key = k_spin_lock(&heap->lock);
+		mem = sys_heap_allocator(&heap->heap, __align, size, call_site);
+		k_spin_unlock(&heap->lock, key);
+	}
+#else
 	key = k_spin_lock(&heap->lock);
-	mem = sys_heap_allocator(&heap->heap, __align, size);
+	mem = sys_heap_allocator(&heap->heap, __align, size, call_site);
 	k_spin_unlock(&heap->lock, key);
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
 
 	if (mem == NULL) {
 		return NULL;
@@ -81,24 +98,31 @@ void *k_aligned_alloc(size_t align, size_t size)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, align, size, sys_heap_aligned_alloc);
+	void *ret = z_alloc_helper(_SYSTEM_HEAP, align, size, Z_HEAP_CALL_SITE(),
+				   z_sys_heap_aligned_alloc_at);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
 	return ret;
 }
 
-void *k_malloc(size_t size)
+static void *malloc_at(size_t size, void *call_site)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_malloc, _SYSTEM_HEAP);
 
-	void *ret = z_alloc_helper(_SYSTEM_HEAP, 0, size, sys_heap_noalign_alloc);
+	void *ret = z_alloc_helper(_SYSTEM_HEAP, 0, size, call_site,
+				   z_sys_heap_noalign_alloc_at);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_malloc, _SYSTEM_HEAP, ret);
 
 	return ret;
 }
 
+void *k_malloc(size_t size)
+{
+	return malloc_at(size, Z_HEAP_CALL_SITE());
+}
+
 void *k_calloc(size_t nmemb, size_t size)
 {
 	void *ret;
@@ -112,7 +136,7 @@ void *k_calloc(size_t nmemb, size_t size)
 		return NULL;
 	}
 
-	ret = k_malloc(bounds);
+	ret = malloc_at(bounds, Z_HEAP_CALL_SITE());
 	if (ret != NULL) {
 		(void)memset(ret, 0, bounds);
 	}
@@ -125,6 +149,7 @@ void *k_calloc(size_t nmemb, size_t size)
 void *k_realloc(void *ptr, size_t size)
 {
 	struct k_heap *heap, **heap_ref;
+	void *call_site = Z_HEAP_CALL_SITE();
 	k_spinlock_key_t key;
 	void *ret;
 
@@ -133,7 +158,7 @@ void *k_realloc(void *ptr, size_t size)
 		return NULL;
 	}
 	if (ptr == NULL) {
-		return k_malloc(size);
+		return malloc_at(size, call_site);
 	}
 	heap_ref = ptr;
 	ptr = --heap_ref;
@@ -151,7 +176,7 @@ void *k_realloc(void *ptr, size_t size)
 	 * Better bypass it and go directly to sys_heap_realloc() instead.
 	 */
 	key = k_spin_lock(&heap->lock);
-	ret = sys_heap_realloc(&heap->heap, ptr, size);
+	ret = z_sys_heap_aligned_realloc_at(&heap->heap, ptr, 0, size, call_site);
 	k_spin_unlock(&heap->lock, key);
 
 	if (ret != NULL) {
@@ -172,7 +197,7 @@ void k_thread_system_pool_assign(struct k_thread *thread)
 #define _SYSTEM_HEAP	NULL
 #endif /* K_HEAP_MEM_POOL_SIZE */
 
-static void *z_thread_alloc_helper(size_t align, size_t size,
+static void *z_thread_alloc_helper(size_t align, size_t size, void *call_site,
 				   sys_heap_allocator_t sys_heap_allocator)
 {
 	void *ret;
@@ -185,7 +210,7 @@ static void *z_thread_alloc_helper(size_t align, size_t size,
 	}
 
 	if (heap != NULL) {
-		ret = z_alloc_helper(heap, align, size, sys_heap_allocator);
+		ret = z_alloc_helper(heap, align, size, call_site, sys_heap_allocator);
 	} else {
 		ret = NULL;
 	}
@@ -195,10 +220,12 @@ static void *z_thread_alloc_helper(size_t align, size_t size,
 
 void *z_thread_aligned_alloc(size_t align, size_t size)
 {
-	return z_thread_alloc_helper(align, size, sys_heap_aligned_alloc);
+	return z_thread_alloc_helper(align, size, Z_HEAP_CALL_SITE(),
+				     z_sys_heap_aligned_alloc_at);
 }
 
 void *z_thread_malloc(size_t size)
 {
-	return z_thread_alloc_helper(0, size, sys_heap_noalign_alloc);
+	return z_thread_alloc_helper(0, size, Z_HEAP_CALL_SITE(),
+				     z_sys_heap_noalign_alloc_at);
 }
@@ -884,6 +884,43 @@ static size_t virt_region_align(uintptr_t phys, size_t size)
 
 __weak FUNC_ALIAS(virt_region_align, arch_virt_region_align, size_t);
 
+/* Get the default large page size, i.e. no large page support
+ *
+ * @param[in] phys Physical address of region to be mapped, aligned to MMU_PAGE_SIZE
+ * @param[in] size Size of region to be mapped, aligned to MMU_PAGE_SIZE
+ *
+ * @retval largest page size usable within this region
+ */
+static size_t mem_large_page_size(uintptr_t phys, size_t size)
+{
+	ARG_UNUSED(phys);
+	ARG_UNUSED(size);
+
+	return CONFIG_MMU_PAGE_SIZE;
+}
+
+__weak FUNC_ALIAS(mem_large_page_size, arch_mem_large_page_size, size_t);
+
+/* Allocate virtual memory at the same offset as phys within large pages */
+static void *virt_region_alloc_large(uintptr_t phys, size_t size, size_t align)
+{
+	size_t large = arch_mem_large_page_size(phys, size);
+	size_t phase = phys & (large - 1);
+	uint8_t *dest_addr;
+
+	if (large <= align) {
+		return virt_region_alloc(size, align);
+	}
+
+	dest_addr = virt_region_alloc(size + phase, large);
+	if ((dest_addr != NULL) && (phase != 0U)) {
+		virt_region_free(dest_addr, phase);
+		dest_addr += phase;
+	}
+
+	return dest_addr;
+}
+
 /* This may be called from arch early boot code before z_cstart() is invoked.
  * Data will be copied and BSS zeroed, but this must not rely on any
  * initialization functions being called prior to work correctly.
@@ -943,7 +980,12 @@ void k_mem_map_phys_bare(uint8_t **virt_ptr, uintptr_t phys, size_t size, uint32
 		}
 	} else {
 		/* Obtain an appropriately sized chunk of virtual memory */
-		dest_addr = virt_region_alloc(aligned_size, align_boundary);
+		if ((flags & K_MEM_MAP_LARGE) != 0U) {
+			dest_addr = virt_region_alloc_large(aligned_phys, aligned_size,
+							    align_boundary);
+		} else {
+			dest_addr = virt_region_alloc(aligned_size, align_boundary);
+		}
 		if (!dest_addr) {
 			goto fail;
 		}
@@ -1555,10 +1597,29 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_refault_check(struct k_thread *faulting_thread,
+					      void *addr)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	if (!z_paging_stats_is_refault(addr)) {
+		return;
+	}
+
+	paging_stats.eviction.refaults++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.eviction.refaults++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
-					     bool dirty)
+					     void *addr, bool dirty)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
+	z_paging_stats_evicted(addr);
+
 	if (dirty) {
 		paging_stats.eviction.dirty++;
 	} else {
@@ -1709,6 +1770,7 @@ static bool do_page_fault(void *addr, bool pin)
 		 "unexpected status value %d", status);
 
 	paging_stats_faults_inc(faulting_thread, key.key);
+	paging_stats_refault_check(faulting_thread, addr);
 
 	pf = free_page_frame_list_get();
 	if (pf == NULL) {
@@ -1719,7 +1781,7 @@ static bool do_page_fault(void *addr, bool pin)
 			k_mem_page_frame_to_virt(pf),
 			k_mem_page_frame_to_phys(pf));
 
-		paging_stats_eviction_inc(faulting_thread, dirty);
+		paging_stats_eviction_inc(faulting_thread, k_mem_page_frame_to_virt(pf), dirty);
 	}
 	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
 	__ASSERT(ret == 0, "failed to prepare page frame");
@@ -1798,9 +1860,84 @@ void k_mem_pin(void *addr, size_t size)
 	virt_region_foreach(addr, size, do_mem_pin);
 }
 
+#ifdef CONFIG_DEMAND_PAGING_READAHEAD
+/*
+ * Page faults on consecutive data pages read the next ones ahead from a
+ * work item, so the faulting thread only waits for its own data page.
+ * The fault path of the work item does not look for sequential faults
+ * itself, and readahead thus never feeds on itself. State is protected
+ * by z_mm_lock.
+ */
+static uint8_t *readahead_last_fault;
+static uint8_t *readahead_next;
+static size_t readahead_count;
+
+static void readahead_handler(struct k_work *work)
+{
+	k_spinlock_key_t key;
+	uint8_t *addr;
+	size_t count;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&z_mm_lock);
+	addr = readahead_next;
+	count = readahead_count;
+	readahead_count = 0;
+	k_spin_unlock(&z_mm_lock, key);
+
+	/* Stops at the end of the mapped region, and when the
+	 * next data page is already there.
+	 */
+	for (; count > 0; count--, addr += CONFIG_MMU_PAGE_SIZE) {
+		uintptr_t location;
+
+		key = k_spin_lock(&z_mm_lock);
+		if (arch_page_location_get(addr, &location) != ARCH_PAGE_LOCATION_PAGED_OUT) {
+			k_spin_unlock(&z_mm_lock, key);
+			break;
+		}
+		k_spin_unlock(&z_mm_lock, key);
+
+		if (!do_page_fault(addr, false)) {
+			break;
+		}
+	}
+}
+
+static K_WORK_DEFINE(readahead_work, readahead_handler);
+
+static void readahead_fault(void *addr)
+{
+	uint8_t *page = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr),
+						   CONFIG_MMU_PAGE_SIZE));
+	k_spinlock_key_t key = k_spin_lock(&z_mm_lock);
+	bool sequential = (page == (readahead_last_fault + CONFIG_MMU_PAGE_SIZE));
+
+	readahead_last_fault = page;
+	if (sequential) {
+		readahead_next = page + CONFIG_MMU_PAGE_SIZE;
+		readahead_count = CONFIG_DEMAND_PAGING_READAHEAD_PAGES;
+	}
+	k_spin_unlock(&z_mm_lock, key);
+
+	if (sequential) {
+		(void)k_work_submit(&readahead_work);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_READAHEAD */
+
 bool k_mem_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	bool ret = do_page_fault(addr, false);
+
+#ifdef CONFIG_DEMAND_PAGING_READAHEAD
+	if (ret) {
+		readahead_fault(addr);
+	}
+#endif /* CONFIG_DEMAND_PAGING_READAHEAD */
+
+	return ret;
 }
 
 static void do_mem_unpin(void *addr)
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <ksched.h>
 #include <wait_q.h>
+#include <wait_stats.h>
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/init.h>
@@ -29,6 +30,47 @@
 static struct k_obj_type obj_type_msgq;
 #endif /* CONFIG_OBJ_CORE_MSGQ */
 
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+static int msgq_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_msgq *msgq = CONTAINER_OF(obj_core, struct k_msgq, obj_core);
+
+	K_SPINLOCK(&msgq->lock) {
+		memcpy(stats, &msgq->wait_stats, sizeof(msgq->wait_stats));
+	}
+
+	return 0;
+}
+
+static int msgq_stats_reset(struct k_obj_core *obj_core)
+{
+	struct k_msgq *msgq = CONTAINER_OF(obj_core, struct k_msgq, obj_core);
+
+	K_SPINLOCK(&msgq->lock) {
+		z_wait_stats_reset(&msgq->wait_stats, msgq->used_msgs);
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc msgq_stats_desc = {
+	.raw_size = sizeof(struct k_obj_wait_stats),
+	.query_size = sizeof(struct k_obj_wait_stats),
+	.raw   = msgq_stats_raw,
+	.query = msgq_stats_raw,
+	.reset = msgq_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static void msgq_stats_init(struct k_msgq *msgq)
+{
+	z_wait_stats_init(&msgq->wait_stats, msgq->used_msgs);
+	k_obj_core_stats_register(K_OBJ_CORE(msgq), &msgq->wait_stats,
+				  sizeof(msgq->wait_stats));
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
+
 static inline bool handle_poll_events(struct k_msgq *msgq)
 {
 #ifdef CONFIG_POLL
@@ -60,6 +102,9 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 #ifdef CONFIG_OBJ_CORE_MSGQ
 	k_obj_core_init_and_link(K_OBJ_CORE(msgq), &obj_type_msgq);
 #endif /* CONFIG_OBJ_CORE_MSGQ */
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+	msgq_stats_init(msgq);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_msgq, msgq);
 
@@ -159,11 +204,17 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 				msgq->write_ptr = msgq->buffer_start;
 			}
 			msgq->used_msgs++;
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+			z_wait_stats_level(&msgq->wait_stats, msgq->used_msgs);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 			resched = handle_poll_events(msgq);
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for message space to become available */
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		z_wait_stats_unavailable(&msgq->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 		result = -ENOMSG;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
@@ -171,7 +222,18 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 		/* wait for put message success, failure, or timeout */
 		_current->base.swap_data = (void *) data;
 
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		z_wait_stats_unavailable(&msgq->wait_stats);
+		uint32_t start = z_wait_stats_pend(&msgq->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
+
 		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		K_SPINLOCK(&msgq->lock) {
+			z_wait_stats_woken(&msgq->wait_stats, start, result);
+		}
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
 		return result;
 	}
@@ -263,6 +325,9 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		z_wait_stats_unavailable(&msgq->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 		result = -ENOMSG;
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
@@ -270,7 +335,18 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		/* wait for get message success or timeout */
 		_current->base.swap_data = data;
 
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		z_wait_stats_unavailable(&msgq->wait_stats);
+		uint32_t start = z_wait_stats_pend(&msgq->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
+
 		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		K_SPINLOCK(&msgq->lock) {
+			z_wait_stats_woken(&msgq->wait_stats, start, result);
+		}
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
 		return result;
 	}
@@ -438,11 +514,17 @@ static int init_msgq_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_msgq, K_OBJ_TYPE_MSGQ_ID,
 			offsetof(struct k_msgq, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+	k_obj_type_stats_init(&obj_type_msgq, &msgq_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 
 	/* Initialize and link statically defined message queues */
 
 	STRUCT_SECTION_FOREACH(k_msgq, msgq) {
 		k_obj_core_init_and_link(K_OBJ_CORE(msgq), &obj_type_msgq);
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+		msgq_stats_init(msgq);
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
 	}
 
 	return 0;
@@ -32,6 +32,7 @@
 #include <ksched.h>
 #include <kthread.h>
 #include <wait_q.h>
+#include <wait_stats.h>
 #include <errno.h>
 #include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
@@ -52,6 +53,47 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_mutex;
 #endif /* CONFIG_OBJ_CORE_MUTEX */
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+
+	K_SPINLOCK(&lock) {
+		memcpy(stats, &mutex->wait_stats, sizeof(mutex->wait_stats));
+	}
+
+	return 0;
+}
+
+static int mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	struct k_mutex *mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+
+	K_SPINLOCK(&lock) {
+		z_wait_stats_reset(&mutex->wait_stats, mutex->lock_count);
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_obj_wait_stats),
+	.query_size = sizeof(struct k_obj_wait_stats),
+	.raw   = mutex_stats_raw,
+	.query = mutex_stats_raw,
+	.reset = mutex_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static void mutex_stats_init(struct k_mutex *mutex)
+{
+	z_wait_stats_init(&mutex->wait_stats, mutex->lock_count);
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->wait_stats,
+				  sizeof(mutex->wait_stats));
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
@@ -64,6 +106,9 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif /* CONFIG_OBJ_CORE_MUTEX */
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex_stats_init(mutex);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
@@ -102,6 +147,69 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+static inline bool mutex_available(struct k_mutex *mutex)
+{
+	return (mutex->lock_count == 0U) || (mutex->owner == _current);
+}
+
+static inline void mutex_acquire(struct k_mutex *mutex)
+{
+	mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+				_current->base.prio :
+				mutex->owner_orig_prio;
+
+	mutex->lock_count++;
+	mutex->owner = _current;
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	z_wait_stats_level(&mutex->wait_stats, mutex->lock_count);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* Upper bound of the number of relax loops between two checks */
+#define MUTEX_SPIN_BACKOFF_MAX 64U
+
+/* Whether @a owner currently runs on a CPU other than ours.  Only a
+ * hint, it is read without the scheduler lock.
+ */
+static inline bool owner_running_elsewhere(struct k_thread *owner)
+{
+	struct _cpu *cpu = &_kernel.cpus[owner->base.cpu];
+
+	return (cpu != _current_cpu) && (cpu->current == owner);
+}
+
+/* Spins, dropping the lock while doing so, as long as @a mutex is
+ * owned by a thread running on another CPU and the spin budget isn't
+ * exhausted.  Returns with the lock held again.
+ */
+static k_spinlock_key_t mutex_spin(struct k_mutex *mutex, k_spinlock_key_t key)
+{
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+	uint32_t start = k_cycle_get_32();
+	unsigned int backoff = 1U;
+
+	while (!mutex_available(mutex) &&
+	       owner_running_elsewhere(mutex->owner) &&
+	       ((k_cycle_get_32() - start) < budget)) {
+		k_spin_unlock(&lock, key);
+
+		for (unsigned int i = 0; i < backoff; i++) {
+			arch_spin_relax();
+		}
+		backoff = MIN(backoff * 2U, MUTEX_SPIN_BACKOFF_MAX);
+
+		key = k_spin_lock(&lock);
+	}
+
+	return key;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -114,18 +222,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
-
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
-
-		mutex->lock_count++;
-		mutex->owner = _current;
-
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+	if (likely(mutex_available(mutex))) {
+		mutex_acquire(mutex);
 
 		k_spin_unlock(&lock, key);
 
@@ -134,6 +232,10 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	z_wait_stats_unavailable(&mutex->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
 		k_spin_unlock(&lock, key);
 
@@ -142,6 +244,20 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	key = mutex_spin(mutex, key);
+
+	if (mutex_available(mutex)) {
+		mutex_acquire(mutex);
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -153,8 +269,18 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	uint32_t start = z_wait_stats_pend(&mutex->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	K_SPINLOCK(&lock) {
+		z_wait_stats_woken(&mutex->wait_stats, start, got_mutex);
+	}
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
+
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
 	LOG_DBG("%p got mutex %p (y/n): %c", _current, mutex,
@@ -299,11 +425,17 @@ static int init_mutex_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 
 	/* Initialize and link statically defined mutexes */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		mutex_stats_init(mutex);
+#endif /* CONFIG_OBJ_CORE_STATS_MUTEX */
 	}
 
 	return 0;
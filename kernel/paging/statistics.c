@@ -76,6 +76,35 @@ k_mem_paging_backing_store_histogram_bounds[
 #endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+/*
+ * Last data pages selected for eviction, in a ring. Only accessed with
+ * z_mm_lock held by the page fault code.
+ */
+static void *evicted_pages[CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW];
+static unsigned int evicted_next;
+
+void z_paging_stats_evicted(void *addr)
+{
+	evicted_pages[evicted_next] = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr),
+								 CONFIG_MMU_PAGE_SIZE));
+	evicted_next = (evicted_next + 1U) % ARRAY_SIZE(evicted_pages);
+}
+
+bool z_paging_stats_is_refault(void *addr)
+{
+	void *page = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr), CONFIG_MMU_PAGE_SIZE));
+
+	for (int i = 0; i < ARRAY_SIZE(evicted_pages); i++) {
+		if (evicted_pages[i] == page) {
+			/* Count each eviction as a refault once at most */
+			evicted_pages[i] = NULL;
+			return true;
+		}
+	}
+
+	return false;
+}
+
 unsigned long k_mem_num_pagefaults_get(void)
 {
 	unsigned long ret;
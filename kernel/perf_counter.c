@@ -0,0 +1,228 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <ksched.h>
+#include <string.h>
+
+/*
+ * The hardware counters are free running, the difference between two
+ * reads is added to the system values and, with
+ * CONFIG_THREAD_PERF_COUNTERS, to the values of the thread which was
+ * running in between.  Counters are read at each context switch, with
+ * interrupts masked, and under perf_counter_lock otherwise.
+ */
+struct perf_counters {
+#ifdef CONFIG_OBJ_CORE_STATS_PERF_COUNTERS
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_STATS_PERF_COUNTERS */
+	struct k_perf_counter_stats stats;
+	uint32_t last[CONFIG_PERF_COUNTERS_NUM];
+};
+
+static struct perf_counters perf_counters;
+static struct k_spinlock perf_counter_lock;
+
+static void perf_counters_update(struct k_thread *thread)
+{
+	for (unsigned int i = 0; i < CONFIG_PERF_COUNTERS_NUM; i++) {
+		uint32_t now, delta;
+
+		if (perf_counters.stats.event[i] == K_PERF_EVENT_NONE) {
+			continue;
+		}
+
+		now = arch_perf_counter_read(i);
+		delta = now - perf_counters.last[i];
+		perf_counters.last[i] = now;
+
+		perf_counters.stats.count[i] += delta;
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+		if (thread != NULL) {
+			thread->base.perf_counters[i] += delta;
+		}
+#else
+		ARG_UNUSED(thread);
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+	}
+}
+
+void z_perf_counters_switch(void)
+{
+	perf_counters_update(_current);
+}
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+/* Clear the values of one counter, or of all of them if user_data is NULL */
+static void thread_perf_counters_clear(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	unsigned int *idx = user_data;
+
+	if (idx != NULL) {
+		thread->base.perf_counters[*idx] = 0U;
+	} else {
+		memset(thread->base.perf_counters, 0, sizeof(thread->base.perf_counters));
+	}
+}
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
+int k_perf_counter_start(unsigned int idx, enum k_perf_event event)
+{
+	int ret = 0;
+
+	if ((idx >= MIN(CONFIG_PERF_COUNTERS_NUM, arch_perf_counter_num())) ||
+	    (event == K_PERF_EVENT_NONE)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&perf_counter_lock) {
+		/* Account the events of the previous use of the counter */
+		perf_counters_update(_current);
+		perf_counters.stats.event[idx] = K_PERF_EVENT_NONE;
+
+		ret = arch_perf_counter_start(idx, event);
+		if (ret < 0) {
+			K_SPINLOCK_BREAK;
+		}
+
+		perf_counters.stats.event[idx] = event;
+		perf_counters.stats.count[idx] = 0U;
+		perf_counters.last[idx] = arch_perf_counter_read(idx);
+	}
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	if (ret == 0) {
+		k_thread_foreach_unlocked(thread_perf_counters_clear, &idx);
+	}
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
+	return ret;
+}
+
+int k_perf_counter_stop(unsigned int idx)
+{
+	if (idx >= CONFIG_PERF_COUNTERS_NUM) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&perf_counter_lock) {
+		if (perf_counters.stats.event[idx] == K_PERF_EVENT_NONE) {
+			K_SPINLOCK_BREAK;
+		}
+
+		perf_counters_update(_current);
+		perf_counters.stats.event[idx] = K_PERF_EVENT_NONE;
+		arch_perf_counter_stop(idx);
+	}
+
+	return 0;
+}
+
+int k_perf_counter_stats_get(struct k_perf_counter_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&perf_counter_lock) {
+		perf_counters_update(_current);
+		memcpy(stats, &perf_counters.stats, sizeof(*stats));
+	}
+
+	return 0;
+}
+
+void z_thread_perf_counters_get(struct k_thread *thread, uint64_t *counts)
+{
+	K_SPINLOCK(&perf_counter_lock) {
+		perf_counters_update(_current);
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+		memcpy(counts, thread->base.perf_counters,
+		       sizeof(thread->base.perf_counters));
+#else
+		ARG_UNUSED(thread);
+		memset(counts, 0, sizeof(perf_counters.stats.count));
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+	}
+}
+
+int k_thread_perf_counter_stats_get(k_tid_t thread, struct k_perf_counter_stats *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&perf_counter_lock) {
+		memcpy(stats->event, perf_counters.stats.event, sizeof(stats->event));
+	}
+	z_thread_perf_counters_get(thread, stats->count);
+
+	return 0;
+}
+
+void k_perf_counter_stats_reset(void)
+{
+	K_SPINLOCK(&perf_counter_lock) {
+		perf_counters_update(NULL);
+		memset(perf_counters.stats.count, 0, sizeof(perf_counters.stats.count));
+	}
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	k_thread_foreach_unlocked(thread_perf_counters_clear, NULL);
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_PERF_COUNTERS
+static struct k_obj_type obj_type_perf_counters;
+
+static int perf_counters_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	ARG_UNUSED(obj_core);
+
+	return k_perf_counter_stats_get(stats);
+}
+
+static int perf_counters_stats_reset(struct k_obj_core *obj_core)
+{
+	ARG_UNUSED(obj_core);
+
+	k_perf_counter_stats_reset();
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc perf_counters_stats_desc = {
+	.raw_size = sizeof(struct k_perf_counter_stats),
+	.query_size = sizeof(struct k_perf_counter_stats),
+	.raw   = perf_counters_stats_raw,
+	.query = perf_counters_stats_raw,
+	.reset = perf_counters_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static int init_perf_counters_obj_core_list(void)
+{
+	z_obj_type_init(&obj_type_perf_counters, K_OBJ_TYPE_PERF_COUNTERS_ID,
+			offsetof(struct perf_counters, obj_core));
+	k_obj_type_stats_init(&obj_type_perf_counters,
+			      &perf_counters_stats_desc);
+
+	k_obj_core_init_and_link(K_OBJ_CORE(&perf_counters),
+				 &obj_type_perf_counters);
+	k_obj_core_stats_register(K_OBJ_CORE(&perf_counters),
+				  &perf_counters.stats,
+				  sizeof(perf_counters.stats));
+
+	return 0;
+}
+
+SYS_INIT(init_perf_counters_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_STATS_PERF_COUNTERS */
@@ -9,11 +9,53 @@
 #include <ksched.h>
 #include <kthread.h>
 #include <wait_q.h>
+#include <wait_stats.h>
 
 #ifdef CONFIG_OBJ_CORE_PIPE
 static struct k_obj_type obj_type_pipe;
 #endif /* CONFIG_OBJ_CORE_PIPE */
 
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+static int pipe_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_pipe *pipe = CONTAINER_OF(obj_core, struct k_pipe, obj_core);
+
+	K_SPINLOCK(&pipe->lock) {
+		memcpy(stats, &pipe->wait_stats, sizeof(pipe->wait_stats));
+	}
+
+	return 0;
+}
+
+static int pipe_stats_reset(struct k_obj_core *obj_core)
+{
+	struct k_pipe *pipe = CONTAINER_OF(obj_core, struct k_pipe, obj_core);
+
+	K_SPINLOCK(&pipe->lock) {
+		z_wait_stats_reset(&pipe->wait_stats, ring_buf_size_get(&pipe->buf));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc pipe_stats_desc = {
+	.raw_size = sizeof(struct k_obj_wait_stats),
+	.query_size = sizeof(struct k_obj_wait_stats),
+	.raw   = pipe_stats_raw,
+	.query = pipe_stats_raw,
+	.reset = pipe_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static void pipe_stats_init(struct k_pipe *pipe)
+{
+	z_wait_stats_init(&pipe->wait_stats, ring_buf_size_get(&pipe->buf));
+	k_obj_core_stats_register(K_OBJ_CORE(pipe), &pipe->wait_stats,
+				  sizeof(pipe->wait_stats));
+}
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
+
 static inline bool pipe_closed(struct k_pipe *pipe)
 {
 	return (pipe->flags & PIPE_FLAG_OPEN) == 0;
@@ -40,6 +82,10 @@ static int wait_for(_wait_q_t *waitq, struct k_pipe *pipe, k_spinlock_key_t *key
 	k_timeout_t timeout = sys_timepoint_timeout(time_limit);
 	int rc;
 
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	z_wait_stats_unavailable(&pipe->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		return -EAGAIN;
 	}
@@ -51,8 +97,14 @@ static int wait_for(_wait_q_t *waitq, struct k_pipe *pipe, k_spinlock_key_t *key
 	} else {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, read, pipe, timeout);
 	}
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	uint32_t start = z_wait_stats_pend(&pipe->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 	rc = z_pend_curr(&pipe->lock, *key, waitq, timeout);
 	*key = k_spin_lock(&pipe->lock);
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	z_wait_stats_woken(&pipe->wait_stats, start, rc);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 	pipe->waiting--;
 	if (unlikely(pipe_resetting(pipe))) {
 		if (pipe->waiting == 0) {
@@ -81,6 +133,9 @@ void z_impl_k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_size
 #ifdef CONFIG_OBJ_CORE_PIPE
 	k_obj_core_init_and_link(K_OBJ_CORE(pipe), &obj_type_pipe);
 #endif /* CONFIG_OBJ_CORE_PIPE */
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	pipe_stats_init(pipe);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 	SYS_PORT_TRACING_OBJ_INIT(k_pipe, pipe, buffer, buffer_size);
 }
 
@@ -176,7 +231,7 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 				 * supporting direct-to-readers copy with them.
 				 * Simply wake up all pending readers instead.
 				 */
-				need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+				need_resched = z_sched_wake_all(&pipe->data, 0, NULL) != 0;
 			} else if (pipe->waiting != 0) {
 				written += copy_to_pending_readers(pipe, &need_resched,
 								   &data[written],
@@ -194,6 +249,9 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 #endif /* CONFIG_POLL */
 
 		written += ring_buf_put(&pipe->buf, &data[written], len - written);
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+		z_wait_stats_level(&pipe->wait_stats, ring_buf_size_get(&pipe->buf));
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 		if (likely(written == len)) {
 			rc = written;
 			break;
@@ -235,7 +293,7 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 	for (;;) {
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
-			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+			need_resched = z_sched_wake_all(&pipe->space, 0, NULL) != 0;
 		}
 
 		buf.used += ring_buf_get(&pipe->buf, &data[buf.used], len - buf.used);
@@ -344,10 +402,16 @@ static int init_pipe_obj_core_list(void)
 	/* Initialize pipe object type */
 	z_obj_type_init(&obj_type_pipe, K_OBJ_TYPE_PIPE_ID,
 			offsetof(struct k_pipe, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	k_obj_type_stats_init(&obj_type_pipe, &pipe_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 
 	/* Initialize and link statically defined pipes */
 	STRUCT_SECTION_FOREACH(k_pipe, pipe) {
 		k_obj_core_init_and_link(K_OBJ_CORE(pipe), &obj_type_pipe);
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+		pipe_stats_init(pipe);
+#endif /* CONFIG_OBJ_CORE_STATS_PIPE */
 	}
 
 	return 0;
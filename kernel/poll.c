@@ -37,7 +37,8 @@ static struct k_spinlock lock;
 
 enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
 
-static int signal_poller(struct k_poll_event *event, uint32_t state);
+static int signal_poller(struct k_poll_event *event, uint32_t state,
+			 struct z_sched_wake_batch *batch);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
@@ -261,7 +262,9 @@ static inline int register_events(struct k_poll_event *events,
 	return events_registered;
 }
 
-static int signal_poller(struct k_poll_event *event, uint32_t state)
+/* Wakes the thread polling on @event, as part of @batch if not NULL */
+static int signal_poller(struct k_poll_event *event, uint32_t state,
+			 struct z_sched_wake_batch *batch)
 {
 	struct k_thread *thread = poller_thread(event->poller);
 
@@ -271,6 +274,13 @@ static int signal_poller(struct k_poll_event *event, uint32_t state)
 		return 0;
 	}
 
+	if (batch != NULL) {
+		arch_thread_return_value_set(thread,
+			state == K_POLL_STATE_CANCELLED ? -EINTR : 0);
+		z_sched_wake_batch_add(batch, thread);
+		return 0;
+	}
+
 	z_unpend_thread(thread);
 	arch_thread_return_value_set(thread,
 		state == K_POLL_STATE_CANCELLED ? -EINTR : 0);
@@ -435,14 +445,19 @@ oops_free:
 #endif /* CONFIG_USERSPACE */
 
 /* must be called with interrupts locked */
-static int signal_poll_event(struct k_poll_event *event, uint32_t state)
+/* Signals @event.  With a @batch in progress, only events of MODE_POLL
+ * pollers may be signaled, as triggered work submission needs the
+ * scheduler lock the batch holds.
+ */
+static int signal_poll_event(struct k_poll_event *event, uint32_t state,
+			     struct z_sched_wake_batch *batch)
 {
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
-			retcode = signal_poller(event, state);
+			retcode = signal_poller(event, state, batch);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
 		} else {
@@ -468,7 +483,7 @@ bool z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
-		(void) signal_poll_event(poll_event, state);
+		(void) signal_poll_event(poll_event, state, NULL);
 	}
 
 	k_spin_unlock(&lock, key);
@@ -526,13 +541,15 @@ void z_vrfy_k_poll_signal_check(struct k_poll_signal *sig,
 int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 {
 	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_dlist_t triggered = SYS_DLIST_STATIC_INIT(&triggered);
+	struct z_sched_wake_batch batch;
 	struct k_poll_event *poll_event;
+	int rc = 0;
 
 	sig->result = result;
 	sig->signaled = 1U;
 
-	poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events);
-	if (poll_event == NULL) {
+	if (sys_dlist_is_empty(&sig->poll_events)) {
 		k_spin_unlock(&lock, key);
 
 		SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, 0);
@@ -540,7 +557,28 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 		return 0;
 	}
 
-	int rc = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED);
+	/* The signal stays raised, so every poller registered on it is
+	 * signaled.  Polling threads are woken as one batch; triggered
+	 * work is submitted once the batch is over.
+	 */
+	z_sched_wake_batch_begin(&batch);
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events)) != NULL) {
+		if ((poll_event->poller != NULL) &&
+		    (poll_event->poller->mode == MODE_TRIGGERED)) {
+			sys_dlist_append(&triggered, &poll_event->_node);
+			continue;
+		}
+		(void)signal_poll_event(poll_event, K_POLL_STATE_SIGNALED, &batch);
+	}
+	(void)z_sched_wake_batch_end(&batch);
+
+	while ((poll_event = (struct k_poll_event *)sys_dlist_get(&triggered)) != NULL) {
+		int ret = signal_poll_event(poll_event, K_POLL_STATE_SIGNALED, NULL);
+
+		if ((ret < 0) && (rc == 0)) {
+			rc = ret;
+		}
+	}
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
@@ -84,6 +84,24 @@ static void prepare_thread_to_run(struct k_thread *thread, void *data)
 	z_ready_thread(thread);
 }
 
+/* Threads only ever pend on a queue with its lock held, so with that lock
+ * held an empty wait queue cannot gain waiters and the common producer
+ * path can skip the scheduler lock entirely.  A stale non-empty view
+ * (a waiter timing out concurrently) merely takes the slow path.
+ *
+ * The queue lock itself is kept: a lock-free producer would need k_poll()
+ * to register on the queue before checking it for data, which it does the
+ * other way around for all object types, or wakeups would be lost.
+ */
+static inline struct k_thread *unpend_first_waiter(struct k_queue *queue)
+{
+	if (likely(z_waitq_is_empty(&queue->wait_q))) {
+		return NULL;
+	}
+
+	return z_unpend_first_thread(&queue->wait_q);
+}
+
 static inline bool handle_poll_events(struct k_queue *queue, uint32_t state)
 {
 #ifdef CONFIG_POLL
@@ -104,7 +122,7 @@ void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 	struct k_thread *first_pending_thread;
 	bool resched = false;
 
-	first_pending_thread = z_unpend_first_thread(&queue->wait_q);
+	first_pending_thread = unpend_first_waiter(queue);
 
 	if (first_pending_thread != NULL) {
 		resched = true;
@@ -142,7 +160,7 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
-	first_pending_thread = z_unpend_first_thread(&queue->wait_q);
+	first_pending_thread = unpend_first_waiter(queue);
 
 	if (unlikely(first_pending_thread != NULL)) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, queue_insert, queue, alloc, K_FOREVER);
@@ -270,14 +288,14 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	struct k_thread *thread = NULL;
 
 	if (head != NULL) {
-		thread = z_unpend_first_thread(&queue->wait_q);
+		thread = unpend_first_waiter(queue);
 	}
 
 	while ((head != NULL) && (thread != NULL)) {
 		resched = true;
 		prepare_thread_to_run(thread, head);
 		head = *(void **)head;
-		thread = z_unpend_first_thread(&queue->wait_q);
+		thread = unpend_first_waiter(queue);
 	}
 
 	if (head != NULL) {
@@ -334,11 +352,24 @@ int k_queue_merge_slist(struct k_queue *queue, sys_slist_t *list)
 
 void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 {
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key;
 	void *data;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
+	/* Polling an empty queue needs no lock: the head is read in a
+	 * single access, and an item racing in is simply seen on the next
+	 * call, as if it had arrived just after this one.
+	 */
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	    sys_sflist_is_empty(&queue->data_q)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, NULL);
+
+		return NULL;
+	}
+
+	key = k_spin_lock(&queue->lock);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
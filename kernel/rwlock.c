@@ -0,0 +1,265 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/check.h>
+#include <ksched.h>
+#include <wait_q.h>
+
+/*
+ * The whole lock state lives in one atomic word: the number of readers,
+ * whether a writer holds the lock, and whether any thread is (or is about
+ * to be) pending on one of the wait queues.  Threads only take the fast,
+ * lock-free paths while the WAITERS bit is clear; once it is set, every
+ * acquisition and the final release go through rwlock->lock, which also
+ * protects the wait queues.
+ *
+ * The only thing that can still change the state behind the back of a
+ * thread holding rwlock->lock is a reader dropping its hold, which is why
+ * handing the lock over to a writer is done with a compare-and-swap on a
+ * zero reader count.
+ */
+
+int k_rwlock_init(struct k_rwlock *rwlock)
+{
+	atomic_set(&rwlock->state, 0);
+	rwlock->writer = NULL;
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+
+	return 0;
+}
+
+static inline bool rwlock_has_waiters(struct k_rwlock *rwlock)
+{
+	return !z_waitq_is_empty(&rwlock->rd_wait_q) ||
+	       !z_waitq_is_empty(&rwlock->wr_wait_q);
+}
+
+static void rwlock_sync_waiters(struct k_rwlock *rwlock)
+{
+	if (!rwlock_has_waiters(rwlock)) {
+		atomic_and(&rwlock->state, ~Z_RWLOCK_WAITERS);
+	}
+}
+
+static void rwlock_wake_readers(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+
+	/*
+	 * Readers may time out under our feet, so each one is accounted
+	 * for before it is taken off the queue and gets a chance to run.
+	 */
+	for (;;) {
+		atomic_inc(&rwlock->state);
+		thread = z_unpend_first_thread(&rwlock->rd_wait_q);
+		if (thread == NULL) {
+			atomic_dec(&rwlock->state);
+			break;
+		}
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/*
+ * Hand the lock over to whichever waiters can have it now, then bring the
+ * WAITERS bit back in line with the wait queues.  Called with
+ * rwlock->lock held.
+ */
+static void rwlock_grant(struct k_rwlock *rwlock, bool prefer_readers)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+	struct k_thread *writer = z_waitq_head(&rwlock->wr_wait_q);
+	struct k_thread *thread;
+
+	if ((state & Z_RWLOCK_WRITER) != 0) {
+		/* The writer's unlock will get back here */
+	} else if ((prefer_readers || (writer == NULL)) &&
+		   !z_waitq_is_empty(&rwlock->rd_wait_q)) {
+		rwlock_wake_readers(rwlock);
+	} else if ((writer != NULL) && ((state & Z_RWLOCK_READERS) == 0) &&
+		   atomic_cas(&rwlock->state, state,
+			      Z_RWLOCK_WRITER | Z_RWLOCK_WAITERS)) {
+		thread = z_unpend_first_thread(&rwlock->wr_wait_q);
+		if (thread != NULL) {
+			rwlock->writer = thread;
+			arch_thread_return_value_set(thread, 0);
+			z_ready_thread(thread);
+		} else {
+			/* It timed out, and will get back here itself */
+			atomic_and(&rwlock->state, ~Z_RWLOCK_WRITER);
+		}
+	} else {
+		/* Still read locked, the last reader will get back here */
+	}
+
+	rwlock_sync_waiters(rwlock);
+}
+
+static int rwlock_pend(struct k_rwlock *rwlock, k_spinlock_key_t key,
+		       _wait_q_t *wait_q, k_timeout_t timeout)
+{
+	int ret = z_pend_curr(&rwlock->lock, key, wait_q, timeout);
+
+	if (ret != 0) {
+		/*
+		 * A queued writer holds back new readers, so its
+		 * departure may be what lets them in.
+		 */
+		key = k_spin_lock(&rwlock->lock);
+		rwlock_grant(rwlock, false);
+		z_reschedule(&rwlock->lock, key);
+	}
+
+	return ret;
+}
+
+static bool rwlock_read_trylock(struct k_rwlock *rwlock, atomic_val_t mask)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+
+	while ((state & mask) == 0) {
+		__ASSERT((state & Z_RWLOCK_READERS) != Z_RWLOCK_READERS,
+			 "too many readers");
+		if (atomic_cas(&rwlock->state, state, state + 1)) {
+			return true;
+		}
+		state = atomic_get(&rwlock->state);
+	}
+
+	return false;
+}
+
+int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+
+	__ASSERT(rwlock->writer != _current, "rwlock already write locked");
+
+	if (likely(rwlock_read_trylock(rwlock,
+				       Z_RWLOCK_WRITER | Z_RWLOCK_WAITERS))) {
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	for (;;) {
+		/*
+		 * Readers queue behind waiting writers, but may
+		 * otherwise join a read locked rwlock.
+		 */
+		if (z_waitq_is_empty(&rwlock->wr_wait_q) &&
+		    rwlock_read_trylock(rwlock, Z_RWLOCK_WRITER)) {
+			rwlock_sync_waiters(rwlock);
+			k_spin_unlock(&rwlock->lock, key);
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&rwlock->lock, key);
+			return -EBUSY;
+		}
+
+		/*
+		 * Once WAITERS is set the writer can no longer release
+		 * the lock behind our back, check again to be sure it
+		 * did not just do so.
+		 */
+		if ((atomic_or(&rwlock->state, Z_RWLOCK_WAITERS) &
+		     Z_RWLOCK_WAITERS) != 0) {
+			break;
+		}
+	}
+
+	return rwlock_pend(rwlock, key, &rwlock->rd_wait_q, timeout);
+}
+
+int k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	atomic_val_t state;
+	k_spinlock_key_t key;
+
+	do {
+		state = atomic_get(&rwlock->state);
+		CHECKIF((state & Z_RWLOCK_READERS) == 0) {
+			return -EINVAL;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state - 1));
+
+	if (likely(((state & Z_RWLOCK_READERS) != 1) ||
+		   ((state & Z_RWLOCK_WAITERS) == 0))) {
+		return 0;
+	}
+
+	/* Last reader out with threads waiting */
+	key = k_spin_lock(&rwlock->lock);
+	rwlock_grant(rwlock, false);
+	z_reschedule(&rwlock->lock, key);
+
+	return 0;
+}
+
+int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
+	__ASSERT(rwlock->writer != _current, "rwlock already write locked");
+
+	if (likely(atomic_cas(&rwlock->state, 0, Z_RWLOCK_WRITER))) {
+		rwlock->writer = _current;
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+
+	/*
+	 * Setting WAITERS first keeps readers from coming in and makes
+	 * sure the last one out goes through rwlock_grant(), so the state
+	 * seen afterwards can only ever get better for us.
+	 */
+	state = atomic_or(&rwlock->state, Z_RWLOCK_WAITERS);
+	if (((state & (Z_RWLOCK_WRITER | Z_RWLOCK_READERS)) == 0) &&
+	    z_waitq_is_empty(&rwlock->wr_wait_q)) {
+		atomic_or(&rwlock->state, Z_RWLOCK_WRITER);
+		rwlock->writer = _current;
+		rwlock_sync_waiters(rwlock);
+		k_spin_unlock(&rwlock->lock, key);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		rwlock_sync_waiters(rwlock);
+		k_spin_unlock(&rwlock->lock, key);
+		return -EBUSY;
+	}
+
+	return rwlock_pend(rwlock, key, &rwlock->wr_wait_q, timeout);
+}
+
+int k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF(rwlock->writer != _current) {
+		return -EPERM;
+	}
+
+	rwlock->writer = NULL;
+	if (likely(atomic_cas(&rwlock->state, Z_RWLOCK_WRITER, 0))) {
+		return 0;
+	}
+
+	key = k_spin_lock(&rwlock->lock);
+	atomic_and(&rwlock->state, ~Z_RWLOCK_WRITER);
+	rwlock_grant(rwlock, true);
+	z_reschedule(&rwlock->lock, key);
+
+	return 0;
+}
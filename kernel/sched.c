@@ -59,6 +59,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,17 +69,44 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_READY_Q */
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* The run queue a thread is made ready on: that of the CPU readying it,
+ * which likely has the data it was woken for in cache, unless its CPU
+ * mask does not allow it there.
+ */
+static ALWAYS_INLINE unsigned int runq_home_cpu(struct k_thread *thread)
+{
+	unsigned int cpu = _current_cpu->id;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask & BIT_MASK(arch_num_cpus());
+
+	if ((m != 0U) && ((m & BIT(cpu)) == 0U)) {
+		cpu = u32_count_trailing_zeros(m);
+	}
+#else
+	ARG_UNUSED(thread);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return cpu;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread->base.runq_cpu = runq_home_cpu(thread);
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -95,7 +124,35 @@ static ALWAYS_INLINE void runq_yield(void)
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	unsigned int id = _current_cpu->id;
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+
+	/* Steal from other CPUs only what outranks the local choice (or
+	 * anything when there is none), so the global priority order is
+	 * kept while ties go to the thread already queued here.  The
+	 * mask-aware simple backend only returns threads allowed on this
+	 * CPU, whichever queue they sit in.
+	 */
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *thread;
+
+		if (i == id) {
+			continue;
+		}
+
+		thread = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -218,12 +275,23 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 	 */
 	bool queued = z_is_thread_queued(_current);
 	bool active = !z_is_thread_prevented_from_running(_current);
+	bool allowed = active;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* See z_sched_cpu_mask_set(), _current may have been told to
+	 * leave this CPU, in which case it only goes back to the queue.
+	 */
+	if (!z_is_idle_thread_object(_current) &&
+	    ((_current->base.cpu_mask & BIT(_current_cpu->id)) == 0U)) {
+		allowed = false;
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
 
 	if (thread == NULL) {
 		thread = _current_cpu->idle_thread;
 	}
 
-	if (active) {
+	if (allowed) {
 		int32_t cmp = z_sched_prio_cmp(_current, thread);
 
 		/* Ties only switch if state says we yielded */
@@ -347,6 +415,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_latency_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 
@@ -391,6 +460,19 @@ static void thread_halt_spin(struct k_thread *thread, k_spinlock_key_t key)
 	}
 }
 
+/* Pokes @a cpu so it notices the halting flag of the thread it runs */
+static ALWAYS_INLINE void halt_ipi(struct _cpu *cpu)
+{
+	ARG_UNUSED(cpu);
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	arch_sched_directed_ipi(IPI_CPU_MASK(cpu->id));
+#else
+	arch_sched_broadcast_ipi();
+#endif
+#endif
+}
+
 /* Shared handler for k_thread_{suspend,abort}().  Called with the
  * scheduler lock held and the key passed (which it may
  * release/reacquire!) which will be released before a possible return
@@ -417,13 +499,7 @@ static ALWAYS_INLINE void z_thread_halt(struct k_thread *thread, k_spinlock_key_
 	if (cpu != NULL) {
 		thread->base.thread_state |= (terminate ? _THREAD_ABORTING
 					      : _THREAD_SUSPENDING);
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
-		arch_sched_directed_ipi(IPI_CPU_MASK(cpu->id));
-#else
-		arch_sched_broadcast_ipi();
-#endif
-#endif
+		halt_ipi(cpu);
 		if (arch_is_in_isr()) {
 			thread_halt_spin(thread, key);
 		} else  {
@@ -870,6 +946,8 @@ void *z_get_next_switch_handle(void *interrupted)
 		if (old_thread != new_thread) {
 			uint8_t  cpu_id;
 
+			z_sched_latency_switch(new_thread);
+			z_sched_perf_counters_switch();
 			update_metairq_preempt(new_thread);
 			z_sched_switch_spin(new_thread);
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
@@ -919,6 +997,8 @@ void *z_get_next_switch_handle(void *interrupted)
 	return ret;
 #else
 	z_sched_usage_switch(_kernel.ready_q.cache);
+	z_sched_latency_switch(_kernel.ready_q.cache);
+	z_sched_perf_counters_switch();
 	_current->switch_handle = interrupted;
 	set_current(_kernel.ready_q.cache);
 	return _current->switch_handle;
@@ -928,16 +1008,15 @@ void *z_get_next_switch_handle(void *interrupted)
 
 int z_unpend_all(_wait_q_t *wait_q)
 {
-	int need_sched = 0;
+	struct z_sched_wake_batch batch;
 	struct k_thread *thread;
 
-	for (thread = z_waitq_head(wait_q); thread != NULL; thread = z_waitq_head(wait_q)) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
+	z_sched_wake_batch_begin(&batch);
+	while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+		z_sched_wake_batch_add(&batch, thread);
 	}
 
-	return need_sched;
+	return z_sched_wake_batch_end(&batch);
 }
 
 void init_ready_q(struct _ready_q *ready_q)
@@ -947,13 +1026,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_CPU_READY_Q
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_READY_Q */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1069,6 +1148,36 @@ void z_impl_k_yield(void)
 	z_swap(&_sched_spinlock, key);
 }
 
+#ifdef CONFIG_SCHED_CPU_MASK
+void z_sched_cpu_mask_set(struct k_thread *thread, uint32_t cpu_mask)
+{
+	k_spinlock_key_t key = k_spin_lock(&_sched_spinlock);
+
+	thread->base.cpu_mask = cpu_mask;
+
+	if (thread != _current) {
+		__ASSERT(!z_is_thread_queued(thread) && (thread_active_elsewhere(thread) == NULL),
+			 "only the current thread can change CPU mask when runnable");
+		k_spin_unlock(&_sched_spinlock, key);
+		return;
+	}
+
+#ifdef CONFIG_SMP
+	if ((cpu_mask & BIT(_current_cpu->id)) == 0U) {
+		/* next_up() won't keep us here but queues us back, make
+		 * sure an allowed CPU comes looking for us.
+		 */
+		flag_ipi(ipi_mask_create(thread));
+		update_cache(1);
+		z_swap(&_sched_spinlock, key);
+		return;
+	}
+#endif /* CONFIG_SMP */
+
+	k_spin_unlock(&_sched_spinlock, key);
+}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_yield(void)
 {
@@ -1356,6 +1465,33 @@ void z_impl_k_thread_abort(k_tid_t thread)
 }
 #endif /* !CONFIG_ARCH_HAS_THREAD_ABORT */
 
+int z_impl_k_thread_abort_async(k_tid_t thread)
+{
+#if defined(CONFIG_SMP) && !defined(CONFIG_ARCH_HAS_THREAD_ABORT)
+	k_spinlock_key_t key = k_spin_lock(&_sched_spinlock);
+	struct _cpu *cpu = thread_active_elsewhere(thread);
+
+	/* A thread running on another CPU is only flagged: that CPU
+	 * reaps it at its next scheduling point (see next_up()),
+	 * which the IPI forces to happen right away, and wakes up
+	 * the joiners.  Essential threads take the synchronous path
+	 * below to get its diagnostics.
+	 */
+	if ((cpu != NULL) && !z_is_thread_essential(thread)) {
+		thread->base.thread_state |= _THREAD_ABORTING;
+		halt_ipi(cpu);
+		k_spin_unlock(&_sched_spinlock, key);
+		return -EINPROGRESS;
+	}
+	k_spin_unlock(&_sched_spinlock, key);
+#endif /* CONFIG_SMP && !CONFIG_ARCH_HAS_THREAD_ABORT */
+
+	/* Not running elsewhere, nothing to wait for */
+	k_thread_abort(thread);
+
+	return 0;
+}
+
 int z_impl_k_thread_join(struct k_thread *thread, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&_sched_spinlock);
@@ -1440,6 +1576,19 @@ static inline void z_vrfy_k_thread_abort(k_tid_t thread)
 	z_impl_k_thread_abort((struct k_thread *)thread);
 }
 #include <zephyr/syscalls/k_thread_abort_mrsh.c>
+
+static inline int z_vrfy_k_thread_abort_async(k_tid_t thread)
+{
+	if (thread_obj_validate(thread)) {
+		return 0;
+	}
+
+	K_OOPS(K_SYSCALL_VERIFY_MSG(!z_is_thread_essential(thread),
+				    "aborting essential thread %p", thread));
+
+	return z_impl_k_thread_abort_async((struct k_thread *)thread);
+}
+#include <zephyr/syscalls/k_thread_abort_async_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 /*
@@ -1467,6 +1616,90 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+int z_sched_wake_all(_wait_q_t *wait_q, int swap_retval, void *swap_data)
+{
+	struct z_sched_wake_batch batch;
+	struct k_thread *thread;
+
+	z_sched_wake_batch_begin(&batch);
+	while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+		z_thread_return_value_set_with_data(thread, swap_retval, swap_data);
+		z_sched_wake_batch_add(&batch, thread);
+	}
+
+	return z_sched_wake_batch_end(&batch);
+}
+
+void z_sched_wake_batch_begin(struct z_sched_wake_batch *batch)
+{
+	batch->key = k_spin_lock(&_sched_spinlock);
+	batch->ipi_mask = 0U;
+	batch->woken = 0;
+	batch->queued = false;
+}
+
+void z_sched_wake_batch_add(struct z_sched_wake_batch *batch,
+			    struct k_thread *thread)
+{
+	bool killed = (thread->base.thread_state &
+			(_THREAD_DEAD | _THREAD_ABORTING));
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(thread));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+#ifdef CONFIG_EVENTS
+	thread->no_wake_on_timeout = false;
+#endif /* CONFIG_EVENTS */
+
+	/* Always unpend, so that callers draining a wait queue make
+	 * progress even past a thread that is being killed.
+	 */
+	if (thread->base.pended_on != NULL) {
+		unpend_thread_no_timeout(thread);
+	}
+	z_abort_thread_timeout(thread);
+	batch->woken++;
+
+	if (killed) {
+		return;
+	}
+
+	z_mark_thread_as_not_sleeping(thread);
+
+	/* As ready_thread(), minus the cache update and with the IPI
+	 * flagged by z_sched_wake_batch_end()
+	 */
+	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
+
+		z_sched_latency_ready(thread);
+		queue_thread(thread);
+		batch->queued = true;
+
+#ifdef CONFIG_SMP
+		/* Once every other CPU is flagged there is nothing to add */
+		uint32_t others = IPI_ALL_CPUS_MASK & ~BIT(_current_cpu->id);
+
+		if ((batch->ipi_mask & others) != others) {
+			batch->ipi_mask |= (uint32_t)ipi_mask_create(thread);
+		}
+#endif /* CONFIG_SMP */
+	}
+}
+
+int z_sched_wake_batch_end(struct z_sched_wake_batch *batch)
+{
+	if (batch->queued) {
+		update_cache(0);
+		flag_ipi(batch->ipi_mask);
+	}
+
+	k_spin_unlock(&_sched_spinlock, batch->key);
+
+	return batch->woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
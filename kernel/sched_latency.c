@@ -0,0 +1,143 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/math_extras.h>
+#include <ksched.h>
+#include <string.h>
+
+/*
+ * Samples are taken and recorded with the scheduler lock held (or,
+ * for interrupt-driven switches on uniprocessor arches without
+ * USE_SWITCH, with interrupts masked), so readers synchronize on the
+ * scheduler lock as well.  Each CPU only ever writes its own slot.
+ */
+struct sched_latency {
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+	struct k_obj_core obj_core;
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
+	struct k_sched_latency_stats stats;
+};
+
+static struct sched_latency cpu_latency[CONFIG_MP_MAX_NUM_CPUS];
+
+uint32_t z_sched_latency_now(void)
+{
+	uint32_t now;
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	now = (uint32_t)timing_counter_get();
+#else
+	now = k_cycle_get_32();
+#endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
+
+	/* A zero stamp means "no sample pending" */
+	return (now == 0U) ? 1U : now;
+}
+
+void z_sched_latency_record(struct k_thread *thread)
+{
+	struct k_sched_latency_stats *stats = &cpu_latency[_current_cpu->id].stats;
+	uint32_t delta = z_sched_latency_now() - thread->base.ready_stamp;
+	unsigned int prio = CLAMP(thread->base.prio - K_HIGHEST_THREAD_PRIO,
+				  0, K_SCHED_LATENCY_PRIOS - 1);
+	unsigned int bucket = (delta < 2U) ? 0U : (31U - u32_count_leading_zeros(delta));
+
+	thread->base.ready_stamp = 0U;
+
+	bucket = MIN(bucket, CONFIG_SCHED_LATENCY_STATS_BUCKETS - 1U);
+	stats->hist[prio][bucket]++;
+	stats->total += delta;
+	stats->count++;
+	if (delta > stats->max) {
+		stats->max = delta;
+	}
+}
+
+int k_sched_latency_stats_get(int cpu, struct k_sched_latency_stats *stats)
+{
+	if ((stats == NULL) || (cpu < 0) || ((unsigned int)cpu >= arch_num_cpus())) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		memcpy(stats, &cpu_latency[cpu].stats, sizeof(*stats));
+	}
+
+	return 0;
+}
+
+void k_sched_latency_stats_reset(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		for (unsigned int i = 0; i < ARRAY_SIZE(cpu_latency); i++) {
+			memset(&cpu_latency[i].stats, 0,
+			       sizeof(cpu_latency[i].stats));
+		}
+	}
+}
+
+#ifdef CONFIG_OBJ_CORE_STATS_SCHED_LATENCY
+static struct k_obj_type obj_type_sched_latency;
+
+static int sched_latency_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct sched_latency *lat;
+
+	lat = CONTAINER_OF(obj_core, struct sched_latency, obj_core);
+	K_SPINLOCK(&_sched_spinlock) {
+		memcpy(stats, &lat->stats, sizeof(lat->stats));
+	}
+
+	return 0;
+}
+
+static int sched_latency_stats_reset(struct k_obj_core *obj_core)
+{
+	struct sched_latency *lat;
+
+	lat = CONTAINER_OF(obj_core, struct sched_latency, obj_core);
+	K_SPINLOCK(&_sched_spinlock) {
+		memset(&lat->stats, 0, sizeof(lat->stats));
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sched_latency_stats_desc = {
+	.raw_size = sizeof(struct k_sched_latency_stats),
+	.query_size = sizeof(struct k_sched_latency_stats),
+	.raw   = sched_latency_stats_raw,
+	.query = sched_latency_stats_raw,
+	.reset = sched_latency_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static int init_sched_latency_obj_core_list(void)
+{
+	z_obj_type_init(&obj_type_sched_latency, K_OBJ_TYPE_SCHED_LATENCY_ID,
+			offsetof(struct sched_latency, obj_core));
+	k_obj_type_stats_init(&obj_type_sched_latency,
+			      &sched_latency_stats_desc);
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(cpu_latency); i++) {
+		k_obj_core_init_and_link(K_OBJ_CORE(&cpu_latency[i]),
+					 &obj_type_sched_latency);
+		k_obj_core_stats_register(K_OBJ_CORE(&cpu_latency[i]),
+					  &cpu_latency[i].stats,
+					  sizeof(cpu_latency[i].stats));
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_sched_latency_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_STATS_SCHED_LATENCY */
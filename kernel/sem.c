@@ -24,6 +24,7 @@
 #include <wait_q.h>
 #include <zephyr/sys/dlist.h>
 #include <ksched.h>
+#include <wait_stats.h>
 #include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
@@ -42,6 +43,47 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_sem;
 #endif /* CONFIG_OBJ_CORE_SEM */
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+static int sem_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct k_sem *sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+
+	K_SPINLOCK(&lock) {
+		memcpy(stats, &sem->wait_stats, sizeof(sem->wait_stats));
+	}
+
+	return 0;
+}
+
+static int sem_stats_reset(struct k_obj_core *obj_core)
+{
+	struct k_sem *sem = CONTAINER_OF(obj_core, struct k_sem, obj_core);
+
+	K_SPINLOCK(&lock) {
+		z_wait_stats_reset(&sem->wait_stats, sem->count);
+	}
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc sem_stats_desc = {
+	.raw_size = sizeof(struct k_obj_wait_stats),
+	.query_size = sizeof(struct k_obj_wait_stats),
+	.raw   = sem_stats_raw,
+	.query = sem_stats_raw,
+	.reset = sem_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static void sem_stats_init(struct k_sem *sem)
+{
+	z_wait_stats_init(&sem->wait_stats, sem->count);
+	k_obj_core_stats_register(K_OBJ_CORE(sem), &sem->wait_stats,
+				  sizeof(sem->wait_stats));
+}
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -68,6 +110,9 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #ifdef CONFIG_OBJ_CORE_SEM
 	k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
 #endif /* CONFIG_OBJ_CORE_SEM */
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	sem_stats_init(sem);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	return 0;
 }
@@ -108,6 +153,9 @@ void z_impl_k_sem_give(struct k_sem *sem)
 		resched = true;
 	} else {
 		sem->count += (sem->count != sem->limit) ? 1U : 0U;
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		z_wait_stats_level(&sem->wait_stats, sem->count);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 		resched = handle_poll_events(sem);
 	}
 
@@ -147,6 +195,10 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	z_wait_stats_unavailable(&sem->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&lock, key);
 		ret = -EBUSY;
@@ -155,8 +207,18 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	uint32_t start = z_wait_stats_pend(&sem->wait_stats);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	K_SPINLOCK(&lock) {
+		z_wait_stats_woken(&sem->wait_stats, start, ret);
+	}
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
 
@@ -222,11 +284,17 @@ static int init_sem_obj_core_list(void)
 
 	z_obj_type_init(&obj_type_sem, K_OBJ_TYPE_SEM_ID,
 			offsetof(struct k_sem, obj_core));
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+	k_obj_type_stats_init(&obj_type_sem, &sem_stats_desc);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 
 	/* Initialize and link statically defined semaphores */
 
 	STRUCT_SECTION_FOREACH(k_sem, sem) {
 		k_obj_core_init_and_link(K_OBJ_CORE(sem), &obj_type_sem);
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+		sem_stats_init(sem);
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
 	}
 
 	return 0;
@@ -155,6 +155,11 @@ static void start_cpu(int id, struct cpu_start_cb *csc)
 	 */
 	(void)atomic_clear(&ready_flag);
 
+#ifdef CONFIG_IPI_COALESCE
+	/* An IPI sent while the CPU was down may have been lost */
+	(void)atomic_and(&_kernel.ipi_in_flight, ~(atomic_val_t)BIT(id));
+#endif
+
 	/* Power up the CPU */
 	arch_cpu_start(id, z_interrupt_stacks[id], CONFIG_ISR_STACK_SIZE,
 		       smp_init_top, csc);
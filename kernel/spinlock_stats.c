@@ -0,0 +1,225 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+/*
+ * The statistics of a spinlock are only updated by the CPU holding it,
+ * which serializes the updates without any other lock.  A table entry is
+ * claimed with a compare and swap at the first acquisition of a spinlock
+ * and found again by hashing its address.  The time base is
+ * k_cycle_get_32(), which is lock free with
+ * CONFIG_SYSTEM_CLOCK_LOCK_FREE_COUNT and so does not recurse here.
+ */
+struct spin_stats {
+	atomic_ptr_t lock;
+	struct k_spinlock_stats stats;
+	/* Acquisition in progress */
+	uint32_t start;
+	uint8_t site;
+};
+
+#define NO_SITE UINT8_MAX
+
+BUILD_ASSERT(CONFIG_SPINLOCK_STATS_SITES < NO_SITE);
+
+static struct spin_stats spin_stats[CONFIG_SPINLOCK_STATS_LOCKS];
+static atomic_t spin_stats_dropped;
+
+static struct spin_stats *spin_stats_find(const struct k_spinlock *l, bool claim)
+{
+	unsigned int i = ((uint32_t)((uintptr_t)l >> 2) * 2654435761U) %
+			 CONFIG_SPINLOCK_STATS_LOCKS;
+
+	for (unsigned int n = 0U; n < CONFIG_SPINLOCK_STATS_LOCKS; n++) {
+		struct spin_stats *entry = &spin_stats[i];
+		void *lock = atomic_ptr_get(&entry->lock);
+
+		if (lock == l) {
+			return entry;
+		}
+
+		if (lock == NULL) {
+			if (!claim) {
+				return NULL;
+			}
+
+			/* Only fails if another CPU took the entry for another lock */
+			if (atomic_ptr_cas(&entry->lock, NULL, (void *)l)) {
+				return entry;
+			}
+		}
+
+		i = (i + 1U) % CONFIG_SPINLOCK_STATS_LOCKS;
+	}
+
+	return NULL;
+}
+
+/*
+ * Find the site of addr, or a free one.  Once they are all in use, the
+ * site which spun the least is replaced if this acquisition spun longer.
+ */
+static uint8_t spin_stats_site(struct k_spinlock_stats *stats, uintptr_t addr,
+			       uint32_t spins)
+{
+	struct k_spinlock_site_stats *sites = stats->sites;
+	uint8_t least = 0U;
+
+	for (uint8_t i = 0U; i < CONFIG_SPINLOCK_STATS_SITES; i++) {
+		if (sites[i].addr == addr) {
+			return i;
+		}
+
+		if (sites[i].addr == 0U) {
+			sites[i].addr = addr;
+			return i;
+		}
+
+		if (sites[i].spins < sites[least].spins) {
+			least = i;
+		}
+	}
+
+	if (spins <= sites[least].spins) {
+		return NO_SITE;
+	}
+
+	memset(&sites[least], 0, sizeof(sites[least]));
+	sites[least].addr = addr;
+
+	return least;
+}
+
+void z_spin_stats_acquired(struct k_spinlock *l, uint32_t spins)
+{
+	uintptr_t addr = (uintptr_t)__builtin_return_address(0);
+	struct spin_stats *entry = spin_stats_find(l, true);
+	struct k_spinlock_stats *stats;
+
+	if (entry == NULL) {
+		atomic_inc(&spin_stats_dropped);
+		return;
+	}
+
+	stats = &entry->stats;
+	stats->count++;
+	if (spins != 0U) {
+		stats->contended++;
+		stats->spins += spins;
+		stats->max_spins = MAX(stats->max_spins, spins);
+	}
+
+	entry->site = spin_stats_site(stats, addr, spins);
+	if (entry->site != NO_SITE) {
+		struct k_spinlock_site_stats *site = &stats->sites[entry->site];
+
+		site->count++;
+		if (spins != 0U) {
+			site->contended++;
+			site->spins += spins;
+		}
+	}
+
+	entry->start = k_cycle_get_32();
+}
+
+void z_spin_stats_release(struct k_spinlock *l)
+{
+	struct spin_stats *entry = spin_stats_find(l, false);
+	struct k_spinlock_stats *stats;
+	uint32_t hold;
+
+	if (entry == NULL) {
+		return;
+	}
+
+	hold = k_cycle_get_32() - entry->start;
+
+	stats = &entry->stats;
+	stats->max_hold = MAX(stats->max_hold, hold);
+	if (entry->site != NO_SITE) {
+		struct k_spinlock_site_stats *site = &stats->sites[entry->site];
+
+		site->max_hold = MAX(site->max_hold, hold);
+	}
+}
+
+int k_spinlock_stats_get(const struct k_spinlock *lock,
+			 struct k_spinlock_stats *stats)
+{
+	struct spin_stats *entry;
+
+	if ((lock == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	entry = spin_stats_find(lock, false);
+	if (entry == NULL) {
+		return -ENOENT;
+	}
+
+	memcpy(stats, &entry->stats, sizeof(*stats));
+	stats->lock = lock;
+
+	return 0;
+}
+
+unsigned int k_spinlock_stats_top(struct k_spinlock_stats *stats,
+				  unsigned int count)
+{
+	struct k_spinlock_stats snapshot;
+	unsigned int n = 0U;
+
+	for (unsigned int i = 0U; i < CONFIG_SPINLOCK_STATS_LOCKS; i++) {
+		void *lock = atomic_ptr_get(&spin_stats[i].lock);
+		unsigned int pos;
+
+		if (lock == NULL) {
+			continue;
+		}
+
+		memcpy(&snapshot, &spin_stats[i].stats, sizeof(snapshot));
+		snapshot.lock = lock;
+		if (snapshot.spins == 0U) {
+			continue;
+		}
+
+		/* Insert in the array, most spins first */
+		for (pos = n; (pos > 0U) && (stats[pos - 1U].spins < snapshot.spins); pos--) {
+		}
+
+		if (pos >= count) {
+			continue;
+		}
+
+		if (n < count) {
+			n++;
+		}
+
+		memmove(&stats[pos + 1U], &stats[pos], (n - 1U - pos) * sizeof(*stats));
+		memcpy(&stats[pos], &snapshot, sizeof(snapshot));
+	}
+
+	return n;
+}
+
+uint32_t k_spinlock_stats_dropped(void)
+{
+	return (uint32_t)atomic_get(&spin_stats_dropped);
+}
+
+void k_spinlock_stats_reset(void)
+{
+	for (unsigned int i = 0U; i < CONFIG_SPINLOCK_STATS_LOCKS; i++) {
+		memset(&spin_stats[i].stats, 0, sizeof(spin_stats[i].stats));
+	}
+
+	atomic_clear(&spin_stats_dropped);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/speculation.h>
+#include <zephyr/sys/syscall_batch.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/syscall_list.h>
+
+int z_impl_k_syscall_batch(struct k_syscall_batch_entry *entries, size_t count)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	/* Supervisor threads call the functions directly */
+	return -ENOTSUP;
+}
+
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_batch_entry *entries, size_t count)
+{
+	/* The frame of the batch is the one the calls oops on */
+	void *ssf = _current->syscall_frame;
+	uintptr_t args[6];
+	uintptr_t id;
+
+	if (count > CONFIG_SYSCALL_BATCH_MAX) {
+		return -EINVAL;
+	}
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(entries, count, sizeof(*entries)));
+
+	for (size_t i = 0; i < count; i++) {
+		/* Another thread may change the entries meanwhile, use a copy */
+		id = entries[i].id;
+		memcpy(args, entries[i].args, sizeof(args));
+
+		if ((id >= K_SYSCALL_LIMIT) || (id == K_SYSCALL_K_SYSCALL_BATCH)) {
+			K_OOPS(K_SYSCALL_VERIFY_MSG(false, "invalid system call %lu in batch",
+						    (unsigned long)id));
+		}
+		id = k_array_index_sanitize(id, K_SYSCALL_LIMIT);
+
+		entries[i].ret = _k_syscall_table[id](args[0], args[1], args[2], args[3],
+						      args[4], args[5], ssf);
+	}
+
+	return 0;
+}
+#include <zephyr/syscalls/k_syscall_batch_mrsh.c>
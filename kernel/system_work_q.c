@@ -14,8 +14,16 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 
+#if defined(CONFIG_SYSTEM_WORKQUEUE_WORKERS) && (CONFIG_SYSTEM_WORKQUEUE_WORKERS > 1)
+#define SYS_WORK_Q_POOL 1
+
+static K_THREAD_STACK_ARRAY_DEFINE(sys_work_q_stacks, CONFIG_SYSTEM_WORKQUEUE_WORKERS,
+				   CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+static struct k_thread sys_work_q_workers[CONFIG_SYSTEM_WORKQUEUE_WORKERS - 1];
+#else
 static K_KERNEL_STACK_DEFINE(sys_work_q_stack,
 			     CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE);
+#endif /* CONFIG_SYSTEM_WORKQUEUE_WORKERS > 1 */
 
 struct k_work_q k_sys_work_q;
 
@@ -27,10 +35,18 @@ static int k_sys_work_q_init(void)
 		.essential = true,
 	};
 
+#ifdef SYS_WORK_Q_POOL
+	k_work_queue_start_pool(&k_sys_work_q, sys_work_q_workers,
+				&sys_work_q_stacks[0][0],
+				CONFIG_SYSTEM_WORKQUEUE_STACK_SIZE,
+				CONFIG_SYSTEM_WORKQUEUE_WORKERS,
+				CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#else
 	k_work_queue_start(&k_sys_work_q,
 			    sys_work_q_stack,
 			    K_KERNEL_STACK_SIZEOF(sys_work_q_stack),
 			    CONFIG_SYSTEM_WORKQUEUE_PRIORITY, &cfg);
+#endif /* SYS_WORK_Q_POOL */
 	return 0;
 }
 
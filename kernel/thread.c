@@ -537,6 +537,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	k_object_init(stack);
 	new_thread->stack_obj = stack;
 	new_thread->syscall_frame = NULL;
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+	(void)memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
 
 	/* Any given thread has access to itself */
 	k_object_access_grant(new_thread, new_thread);
@@ -643,6 +646,11 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	(void)memset(new_thread->base.perf_counters, 0,
+		     sizeof(new_thread->base.perf_counters));
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -920,6 +928,11 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_LATENCY_STATS) && !defined(CONFIG_USE_SWITCH)
+	/* Interrupt-driven switches bypass z_swap() on these arches */
+	z_sched_latency_switch(_current);
+#endif /* CONFIG_SCHED_LATENCY_STATS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
@@ -931,6 +944,11 @@ void z_thread_mark_switched_out(void)
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_THREAD_PERF_COUNTERS) && !defined(CONFIG_USE_SWITCH)
+	/* Interrupt-driven switches bypass z_swap() on these arches */
+	z_sched_perf_counters_switch();
+#endif /* CONFIG_THREAD_PERF_COUNTERS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 #ifdef CONFIG_THREAD_LOCAL_STORAGE
 	/* Dummy thread won't have TLS set up to run arbitrary code */
@@ -957,6 +975,10 @@ int k_thread_runtime_stats_get(k_tid_t thread,
 	*stats = (k_thread_runtime_stats_t) {};
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	z_thread_perf_counters_get(thread, stats->perf_counters);
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
 	return 0;
 }
 
@@ -987,6 +1009,16 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->peak_cycles      += tmp_stats.peak_cycles;
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+		/* Average load of the CPUs, longest burst percentiles */
+		for (unsigned int j = 0; j < K_USAGE_WINDOWS; j++) {
+			stats->window_load[j] += tmp_stats.window_load[j] / num_cpus;
+		}
+		for (unsigned int j = 0; j < K_USAGE_BURST_PERCENTILES; j++) {
+			stats->burst_cycles[j] = MAX(stats->burst_cycles[j],
+						     tmp_stats.burst_cycles[j]);
+		}
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
 		stats->idle_cycles      += tmp_stats.idle_cycles;
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -7,27 +7,96 @@
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <ksched.h>
+#include <ipi.h>
 #include <timeout_q.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
-static uint64_t curr_tick;
+#ifdef CONFIG_TIMEOUT_WHEEL
+/*
+ * Hierarchical timing wheel.
+ *
+ * Level N holds WHEEL_SLOTS slots, each spanning 2^(N * WHEEL_SLOT_BITS)
+ * ticks.  A timeout is stored in the lowest level whose higher-order
+ * slot bits match those of the queue tick, so every entry of a level 0
+ * slot expires on the same tick, and the slots of higher levels are
+ * cascaded down one level at a time as the queue tick reaches them.
+ * Timeouts beyond the reach of the top level sit in an unsorted overflow
+ * list which is re-examined once per revolution of the top level.
+ *
+ * In this mode _timeout.dticks holds the absolute expiry tick rather
+ * than a delta to the previous entry.
+ */
+#define WHEEL_SLOT_BITS 5U
+#define WHEEL_SLOTS     BIT(WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_LEVELS * WHEEL_SLOT_BITS)
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+struct timeout_q {
+	struct k_spinlock lock;
+
+	/* Tick the queue contents are relative to */
+	uint64_t tick;
+
+	/* Ticks left to process in the currently-executing sys_clock_announce() */
+	int announce_remaining;
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+	/* Slot lists are initialized lazily, when their pending bit gets set */
+	sys_dlist_t slots[WHEEL_LEVELS * WHEEL_SLOTS];
+	uint32_t pending[WHEEL_LEVELS];
+	sys_dlist_t overflow;
+#else
+	sys_dlist_t list;
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	/* Set by other CPUs when the owning CPU must reprogram its timer */
+	atomic_t reprogram;
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+};
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+#define TIMEOUT_Q_INIT(q) { .overflow = SYS_DLIST_STATIC_INIT(&(q).overflow) }
+#else
+#define TIMEOUT_Q_INIT(q) { .list = SYS_DLIST_STATIC_INIT(&(q).list) }
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+#define NUM_TIMEOUT_QS CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_TIMEOUT_QS 1
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#define TIMEOUT_Q_INIT_N(n, _) TIMEOUT_Q_INIT(timeout_qs[n])
+
+static struct timeout_q timeout_qs[NUM_TIMEOUT_QS] = {
+	LISTIFY(NUM_TIMEOUT_QS, TIMEOUT_Q_INIT_N, (,))
+};
 
 /*
- * The timeout code shall take no locks other than its own (timeout_lock), nor
- * shall it call any other subsystem while holding this lock.
+ * The timeout code shall take no locks other than its own (the queue locks
+ * and timeout_lock), nor shall it call any other subsystem while holding
+ * these locks.  When both are needed, a queue lock is taken first.
+ */
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Announced system time.  Each CPU's queue trails it until that CPU
+ * processes its own expiries.
  */
+static uint64_t curr_tick;
 static struct k_spinlock timeout_lock;
+#else
+/* With a single queue, the queue time is the system time */
+#define curr_tick (timeout_qs[0].tick)
+#define timeout_lock (timeout_qs[0].lock)
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
-/* Ticks left to process in the currently-executing sys_clock_announce() */
-static int announce_remaining;
-
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
 unsigned int z_clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 
@@ -40,29 +109,196 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+#ifdef CONFIG_TIMEOUT_WHEEL
+static inline unsigned int wheel_index(uint64_t tick, unsigned int lvl)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	return (tick >> (lvl * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+}
+
+/* must be locked */
+static void wheel_insert(struct timeout_q *q, struct _timeout *to)
+{
+	uint64_t expiry = (uint64_t)to->dticks;
+	uint64_t diff = expiry ^ q->tick;
+	unsigned int lvl;
+
+	for (lvl = 0U; lvl < WHEEL_LEVELS; lvl++) {
+		if ((diff >> ((lvl + 1U) * WHEEL_SLOT_BITS)) == 0U) {
+			break;
+		}
+	}
+
+	if (lvl == WHEEL_LEVELS) {
+		sys_dlist_append(&q->overflow, &to->node);
+		return;
+	}
+
+	unsigned int idx = wheel_index(expiry, lvl);
+	sys_dlist_t *slot = &q->slots[lvl * WHEEL_SLOTS + idx];
+
+	if ((q->pending[lvl] & BIT(idx)) == 0U) {
+		sys_dlist_init(slot);
+		q->pending[lvl] |= BIT(idx);
+	}
+	sys_dlist_append(slot, &to->node);
+}
+
+/* must be locked */
+static void remove_timeout(struct timeout_q *q, struct _timeout *to)
+{
+	sys_dnode_t *prev = to->node.prev;
+
+	/* A lone entry is linked to its list head on both sides; if that
+	 * head is a wheel slot, the slot becomes empty.
+	 */
+	if ((prev == to->node.next) && IS_ARRAY_ELEMENT(q->slots, prev)) {
+		size_t i = ARRAY_INDEX(q->slots, prev);
+
+		q->pending[i / WHEEL_SLOTS] &= ~BIT(i % WHEEL_SLOTS);
+	}
+
+	sys_dlist_remove(&to->node);
+}
+
+/* Returns the next tick at which the wheel has work to do: either the
+ * expiry of a level 0 slot or the start of a higher-level slot that will
+ * need to be cascaded.  Must be locked.
+ */
+static uint64_t next_event(struct timeout_q *q)
+{
+	for (unsigned int lvl = 0U; lvl < WHEEL_LEVELS; lvl++) {
+		unsigned int shift = lvl * WHEEL_SLOT_BITS;
+		unsigned int cur = wheel_index(q->tick, lvl);
+		uint32_t pending = (q->pending[lvl] >> cur) >> 1;
+
+		/* Entries of a level always lie before those of the next
+		 * level, so the first non-empty level wins.
+		 */
+		if (pending != 0U) {
+			uint64_t base = (q->tick >> (shift + WHEEL_SLOT_BITS))
+					<< (shift + WHEEL_SLOT_BITS);
+
+			return base + ((uint64_t)(cur + find_lsb_set(pending)) << shift);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&q->overflow)) {
+		return ((q->tick >> WHEEL_SPAN_BITS) + 1U) << WHEEL_SPAN_BITS;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Redistributes the entries of the slots the queue tick has just reached,
+ * top level first so that cascaded entries keep their insertion order.
+ * Must be locked.
+ */
+static void wheel_cascade(struct timeout_q *q)
+{
+	sys_dnode_t *node;
+
+	if (((q->tick & BIT64_MASK(WHEEL_SPAN_BITS)) == 0U) &&
+	    !sys_dlist_is_empty(&q->overflow)) {
+		sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+
+		while ((node = sys_dlist_get(&q->overflow)) != NULL) {
+			sys_dlist_append(&pending, node);
+		}
+		while ((node = sys_dlist_get(&pending)) != NULL) {
+			wheel_insert(q, CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+
+	for (unsigned int lvl = WHEEL_LEVELS - 1U; lvl > 0U; lvl--) {
+		unsigned int idx = wheel_index(q->tick, lvl);
+		sys_dlist_t *slot = &q->slots[lvl * WHEEL_SLOTS + idx];
+
+		if ((q->pending[lvl] & BIT(idx)) == 0U) {
+			continue;
+		}
+
+		q->pending[lvl] &= ~BIT(idx);
+		while ((node = sys_dlist_get(slot)) != NULL) {
+			wheel_insert(q, CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+}
+
+/* Returns the first timeout expiring on the queue tick, if any.  Must be
+ * locked.
+ */
+static struct _timeout *wheel_first_expired(struct timeout_q *q)
+{
+	unsigned int idx = wheel_index(q->tick, 0U);
+	sys_dnode_t *t;
+
+	if ((q->pending[0] & BIT(idx)) == 0U) {
+		return NULL;
+	}
+
+	t = sys_dlist_peek_head(&q->slots[idx]);
+
+	return CONTAINER_OF(t, struct _timeout, node);
+}
+#else
+static struct _timeout *first(struct timeout_q *q)
+{
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return (t == NULL) ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_q *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+static void remove_timeout(struct timeout_q *q, struct _timeout *t)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Returns the earliest absolute deadline (expiry plus slack) in the
+ * queue.  Waking up then announces every timeout expired by that tick,
+ * so timeouts with overlapping windows share a single wakeup.  Must be
+ * locked.
+ */
+static uint64_t next_event(struct timeout_q *q)
+{
+	uint64_t expiry = q->tick;
+	uint64_t deadline = UINT64_MAX;
+
+	/* The list is sorted by expiry, so once an expiry reaches the best
+	 * deadline found no later entry can improve on it.
+	 */
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
+		expiry += t->dticks;
+		if (expiry >= deadline) {
+			break;
+		}
+		deadline = MIN(deadline, expiry + t->slack);
+	}
+
+	return deadline;
+}
+#else
+/* Returns the absolute expiry tick of the queue head.  Must be locked. */
+static uint64_t next_event(struct timeout_q *q)
+{
+	struct _timeout *to = first(q);
+
+	return (to == NULL) ? UINT64_MAX : q->tick + to->dticks;
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -80,27 +316,127 @@ static int32_t elapsed(void)
 	 * The distinction is implemented by looking at announce_remaining which
 	 * will be non-zero while sys_clock_announce() is executing and zero
 	 * otherwise.
+	 *
+	 * With per-CPU queues the same applies to the queue being processed
+	 * (see queue_now()), but the system time itself is never held back.
 	 */
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	return sys_clock_elapsed();
+#else
+	return timeout_qs[0].announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+}
+
+/* Current tick as seen by new timeouts added to @q.  Must be locked. */
+static uint64_t queue_now(struct timeout_q *q)
+{
+	uint64_t now = 0U;
+
+	if (q->announce_remaining != 0) {
+		return q->tick;
+	}
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	K_SPINLOCK(&timeout_lock) {
+		now = curr_tick + elapsed();
+	}
+#else
+	now = curr_tick + elapsed();
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
+	return now;
 }
 
-static int32_t next_timeout(int32_t ticks_elapsed)
+/* Ticks from @now until the next event of @q.  Must be locked. */
+static int32_t next_timeout(struct timeout_q *q, uint64_t now)
 {
-	struct _timeout *to = first();
+	uint64_t next = next_event(q);
+	int64_t dticks = (int64_t)(next - now);
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((next == UINT64_MAX) || (dticks > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, dticks);
 	}
 
 	return ret;
 }
 
-k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+#ifdef CONFIG_TIMEOUT_PER_CPU
+static inline unsigned int queue_cpu(struct timeout_q *q)
+{
+	return ARRAY_INDEX(timeout_qs, q);
+}
+
+/* Returns the queue serving @cpu, or the calling CPU for a negative value.
+ * The calling CPU may be stale if the caller migrates, which is harmless:
+ * the timeout then simply expires on another CPU.
+ */
+static struct timeout_q *timeout_q_get(int cpu)
+{
+	if (cpu < 0) {
+		cpu = (int)arch_curr_cpu()->id;
+	}
+
+	__ASSERT_NO_MSG(cpu < arch_num_cpus());
+
+	return &timeout_qs[cpu];
+}
+
+void z_timeout_q_reprogram(void)
+{
+	struct timeout_q *q = &timeout_qs[_current_cpu->id];
+
+	if (atomic_clear(&q->reprogram) != 0) {
+		K_SPINLOCK(&q->lock) {
+			if (q->announce_remaining == 0) {
+				sys_clock_set_timeout(next_timeout(q, queue_now(q)), false);
+			}
+		}
+	}
+}
+#else
+static inline struct timeout_q *timeout_q_get(int cpu)
+{
+	ARG_UNUSED(cpu);
+
+	return &timeout_qs[0];
+}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
+static inline struct timeout_q *timeout_q_of(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	return &timeout_qs[to->cpu];
+#else
+	ARG_UNUSED(to);
+
+	return &timeout_qs[0];
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+}
+
+/* Reprograms the timer serving @q after its next event moved earlier.
+ * Must be locked.
+ */
+static void queue_reprogram(struct timeout_q *q, uint64_t now)
 {
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	if (queue_cpu(q) != arch_curr_cpu()->id) {
+		/* Only the owning CPU can program its local timer */
+		atomic_set(&q->reprogram, 1);
+		flag_ipi(IPI_CPU_MASK(queue_cpu(q)));
+		return;
+	}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
+	sys_clock_set_timeout(next_timeout(q, now), false);
+}
+
+k_ticks_t z_add_timeout_on(struct _timeout *to, _timeout_func_t fn,
+			   k_timeout_t timeout, int cpu)
+{
+	struct timeout_q *q;
 	k_ticks_t ticks = 0;
 
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
@@ -114,24 +450,37 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-		int32_t ticks_elapsed;
-		bool has_elapsed = false;
+	q = timeout_q_get(cpu);
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	to->cpu = queue_cpu(q);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
+	K_SPINLOCK(&q->lock) {
+		uint64_t now = 0U;
+		bool has_now = false;
+		uint64_t prev_event;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
-			ticks_elapsed = elapsed();
-			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
+			now = queue_now(q);
+			has_now = true;
+			to->dticks = (now - q->tick) + timeout.ticks + 1;
+			ticks = q->tick + to->dticks;
 		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - q->tick;
 
 			to->dticks = MAX(1, dticks);
 			ticks = timeout.ticks;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
+		prev_event = next_event(q);
+
+#ifdef CONFIG_TIMEOUT_WHEEL
+		to->dticks += q->tick;
+		wheel_insert(q, to);
+#else
+		struct _timeout *t;
+
+		for (t = first(q); t != NULL; t = next(q, t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
 				sys_dlist_insert(&t->node, &to->node);
@@ -141,36 +490,53 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 		}
 
 		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
+			sys_dlist_append(&q->list, &to->node);
 		}
+#endif /* CONFIG_TIMEOUT_WHEEL */
 
-		if (to == first() && announce_remaining == 0) {
-			if (!has_elapsed) {
+		if ((next_event(q) < prev_event) && (q->announce_remaining == 0)) {
+			if (!has_now) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
 				 */
-				ticks_elapsed = elapsed();
+				now = queue_now(q);
 			}
-			sys_clock_set_timeout(next_timeout(ticks_elapsed), false);
+			queue_reprogram(q, now);
 		}
 	}
 
+	if (IS_ENABLED(CONFIG_TIMEOUT_PER_CPU)) {
+		signal_pending_ipi();
+	}
+
 	return ticks;
 }
 
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	return z_add_timeout_on(to, fn, timeout, -1);
+}
+
 int z_abort_timeout(struct _timeout *to)
 {
+	struct timeout_q *q = timeout_q_of(to);
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
+	K_SPINLOCK(&q->lock) {
 		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
+			uint64_t prev_event = next_event(q);
 
-			remove_timeout(to);
+			remove_timeout(q, to);
 			to->dticks = TIMEOUT_DTICKS_ABORTED;
 			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(elapsed()), false);
+
+			/* A remote CPU is left to take one spurious wakeup
+			 * rather than being interrupted right now.
+			 */
+			if ((next_event(q) != prev_event) &&
+			    (!IS_ENABLED(CONFIG_TIMEOUT_PER_CPU) ||
+			     (timeout_q_get(-1) == q))) {
+				sys_clock_set_timeout(next_timeout(q, queue_now(q)), false);
 			}
 		}
 	}
@@ -179,11 +545,14 @@ int z_abort_timeout(struct _timeout *to)
 }
 
 /* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+static k_ticks_t timeout_rem(struct timeout_q *q, const struct _timeout *timeout)
 {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	return (k_ticks_t)((uint64_t)timeout->dticks - q->tick);
+#else
 	k_ticks_t ticks = 0;
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
@@ -191,15 +560,17 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 	}
 
 	return ticks;
+#endif /* CONFIG_TIMEOUT_WHEEL */
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
+	struct timeout_q *q = timeout_q_of(timeout);
 	k_ticks_t ticks = 0;
 
-	K_SPINLOCK(&timeout_lock) {
+	K_SPINLOCK(&q->lock) {
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks = timeout_rem(timeout) - elapsed();
+			ticks = timeout_rem(q, timeout) - (queue_now(q) - q->tick);
 		}
 	}
 
@@ -208,12 +579,13 @@ k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
+	struct timeout_q *q = timeout_q_of(timeout);
 	k_ticks_t ticks = 0;
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick;
+	K_SPINLOCK(&q->lock) {
+		ticks = q->tick;
 		if (!z_is_inactive_timeout(timeout)) {
-			ticks += timeout_rem(timeout);
+			ticks += timeout_rem(q, timeout);
 		}
 	}
 
@@ -224,15 +596,37 @@ int32_t z_get_next_timeout_expiry(void)
 {
 	int32_t ret = (int32_t) K_TICKS_FOREVER;
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout(elapsed());
+	struct timeout_q *q = timeout_q_get(-1);
+
+	K_SPINLOCK(&q->lock) {
+		ret = next_timeout(q, queue_now(q));
 	}
 	return ret;
 }
 
 void sys_clock_announce(int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct timeout_q *q;
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	uint64_t now = 0U;
+
+	K_SPINLOCK(&timeout_lock) {
+		curr_tick += ticks;
+		now = curr_tick;
+	}
+
+	/* Each CPU only ever processes its own queue, from its own timer
+	 * interrupt, catching up on whatever other CPUs announced meanwhile.
+	 */
+	q = &timeout_qs[_current_cpu->id];
+	key = k_spin_lock(&q->lock);
+	ticks = (int32_t)(now - q->tick) - q->announce_remaining;
+#else
+	q = &timeout_qs[0];
+	key = k_spin_lock(&q->lock);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
 	/* We release the lock around the callbacks below, so on SMP
 	 * systems someone might be already running the loop.  Don't
@@ -240,41 +634,67 @@ void sys_clock_announce(int32_t ticks)
 	 * timeouts and confuse apps), just increment the tick count
 	 * and return.
 	 */
-	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
-		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
+	if (IS_ENABLED(CONFIG_SMP) && (q->announce_remaining != 0)) {
+		q->announce_remaining += ticks;
+		k_spin_unlock(&q->lock, key);
 		return;
 	}
 
-	announce_remaining = ticks;
+	q->announce_remaining = ticks;
 
 	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
+#ifdef CONFIG_TIMEOUT_WHEEL
+	for (uint64_t next = next_event(q);
+	     next <= q->tick + q->announce_remaining;
+	     next = next_event(q)) {
+		int dt = (int)(next - q->tick);
+
+		q->tick = next;
+		wheel_cascade(q);
+
+		for (t = wheel_first_expired(q); t != NULL; t = wheel_first_expired(q)) {
+			remove_timeout(q, t);
+
+			k_spin_unlock(&q->lock, key);
+			t->fn(t);
+			key = k_spin_lock(&q->lock);
+		}
+
+		q->announce_remaining -= dt;
+	}
+#else
+	for (t = first(q);
+	     (t != NULL) && (t->dticks <= q->announce_remaining);
+	     t = first(q)) {
 		int dt = t->dticks;
 
-		curr_tick += dt;
+		q->tick += dt;
 		t->dticks = 0;
-		remove_timeout(t);
+		remove_timeout(q, t);
 
-		k_spin_unlock(&timeout_lock, key);
+		k_spin_unlock(&q->lock, key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
-		announce_remaining -= dt;
+		key = k_spin_lock(&q->lock);
+		q->announce_remaining -= dt;
 	}
 
 	if (t != NULL) {
-		t->dticks -= announce_remaining;
+		t->dticks -= q->announce_remaining;
 	}
+#endif /* CONFIG_TIMEOUT_WHEEL */
 
-	curr_tick += announce_remaining;
-	announce_remaining = 0;
+	q->tick += q->announce_remaining;
+	q->announce_remaining = 0;
 
-	sys_clock_set_timeout(next_timeout(0), false);
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	atomic_clear(&q->reprogram);
+	sys_clock_set_timeout(next_timeout(q, queue_now(q)), false);
+#else
+	sys_clock_set_timeout(next_timeout(q, q->tick), false);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
-	k_spin_unlock(&timeout_lock, key);
+	k_spin_unlock(&q->lock, key);
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
@@ -354,6 +774,11 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
 	curr_tick = tick;
+#ifdef CONFIG_TIMEOUT_PER_CPU
+	for (unsigned int i = 0; i < ARRAY_SIZE(timeout_qs); i++) {
+		timeout_qs[i].tick = tick;
+	}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -136,11 +136,9 @@ void k_timer_init(struct k_timer *timer,
 }
 
 
-void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
-			  k_timeout_t period)
+static void timer_start(struct k_timer *timer, k_timeout_t duration,
+			k_timeout_t period, k_timeout_t slack)
 {
-	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
-
 	/* Acquire spinlock to ensure safety during concurrent calls to
 	 * k_timer_start for scheduling or rescheduling. This is necessary
 	 * since k_timer_start can be preempted, especially for the same
@@ -179,12 +177,29 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 	timer->period = period;
 	timer->status = 0U;
 
+	z_set_timeout_slack(&timer->timeout, slack);
 	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
 		     duration);
 
 	k_spin_unlock(&lock, key);
 }
 
+void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
+			  k_timeout_t period)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	timer_start(timer, duration, period, K_NO_WAIT);
+}
+
+void z_impl_k_timer_start_slack(struct k_timer *timer, k_timeout_t duration,
+				k_timeout_t period, k_timeout_t slack)
+{
+	SYS_PORT_TRACING_OBJ_FUNC(k_timer, start, timer, duration, period);
+
+	timer_start(timer, duration, period, slack);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 					k_timeout_t duration,
@@ -194,6 +209,18 @@ static inline void z_vrfy_k_timer_start(struct k_timer *timer,
 	z_impl_k_timer_start(timer, duration, period);
 }
 #include <zephyr/syscalls/k_timer_start_mrsh.c>
+
+static inline void z_vrfy_k_timer_start_slack(struct k_timer *timer,
+					      k_timeout_t duration,
+					      k_timeout_t period,
+					      k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	K_OOPS(K_SYSCALL_VERIFY_MSG(Z_IS_TIMEOUT_RELATIVE(slack),
+				    "slack must be relative"));
+	z_impl_k_timer_start_slack(timer, duration, period, slack);
+}
+#include <zephyr/syscalls/k_timer_start_slack_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 void z_impl_k_timer_stop(struct k_timer *timer)
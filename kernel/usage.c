@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -32,6 +33,155 @@ static uint32_t usage_now(void)
 	return (now == 0) ? 1 : now;
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+#define USAGE_SEC1_SLOTS  ARRAY_SIZE(((struct k_usage_windows *)0)->sec1)
+#define USAGE_SEC10_SLOTS ARRAY_SIZE(((struct k_usage_windows *)0)->sec10)
+
+static const uint8_t usage_burst_percentiles[K_USAGE_BURST_PERCENTILES] = { 50, 90, 99 };
+
+static uint32_t usage_freq(void)
+{
+#ifdef CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS
+	return (uint32_t)timing_freq_get();
+#else
+	return sys_clock_hw_cycles_per_sec();
+#endif /* CONFIG_THREAD_RUNTIME_STATS_USE_TIMING_FUNCTIONS */
+}
+
+/* Close the current second, and the current 10 seconds period with it */
+static void usage_windows_next(struct k_usage_windows *w)
+{
+	w->sec1[w->second % USAGE_SEC1_SLOTS] = w->current;
+	w->current = 0U;
+	w->second++;
+
+	if ((w->second % USAGE_SEC1_SLOTS) == 0U) {
+		uint64_t sum = 0U;
+
+		for (unsigned int i = 0; i < USAGE_SEC1_SLOTS; i++) {
+			sum += w->sec1[i];
+		}
+
+		w->sec10[(w->second / USAGE_SEC1_SLOTS - 1U) % USAGE_SEC10_SLOTS] = sum;
+	}
+}
+
+/* Bring the windows of a thread, which may not have run for a while, to
+ * the given second of the CPU clock. Past 70 seconds all the slots are
+ * zero, so the remaining seconds are skipped.
+ */
+static void usage_windows_sync(struct k_usage_windows *w, uint32_t second)
+{
+	for (unsigned int n = 0;
+	     ((int32_t)(second - w->second) > 0) && (n < USAGE_SEC1_SLOTS * (USAGE_SEC10_SLOTS + 1U));
+	     n++) {
+		usage_windows_next(w);
+	}
+
+	if ((int32_t)(second - w->second) > 0) {
+		w->second = second;
+	}
+}
+
+static void usage_burst_record(struct k_usage_windows *w, uint64_t cycles)
+{
+	uint32_t burst = (uint32_t)MIN(cycles, UINT32_MAX);
+	unsigned int bucket = (burst < 2U) ? 0U : (31U - u32_count_leading_zeros(burst));
+
+	w->bursts[MIN(bucket, CONFIG_SCHED_THREAD_USAGE_BURST_BUCKETS - 1U)]++;
+}
+
+/*
+ * Account cycles to the windows of a CPU and of its current thread. The
+ * cycles are split at the second boundaries of the CPU clock, so that a
+ * thread running for several seconds without switching fills each slot.
+ */
+static void sched_windows_update(struct _cpu *cpu, uint32_t cycles)
+{
+	struct k_usage_windows *cw = &cpu->usage->windows;
+	struct k_thread *thread = cpu->current;
+	bool busy = (thread != cpu->idle_thread);
+	uint32_t freq = usage_freq();
+
+	while (cycles > 0U) {
+		uint32_t part = MIN(cycles, freq - cw->elapsed);
+
+		if (thread->base.usage.track_usage) {
+			usage_windows_sync(&thread->base.usage.windows, cw->second);
+			thread->base.usage.windows.current += part;
+		}
+
+		if (busy) {
+			cw->current += part;
+		}
+
+		cw->elapsed += part;
+		cycles -= part;
+
+		if (cw->elapsed >= freq) {
+			cw->elapsed = 0U;
+			usage_windows_next(cw);
+		}
+	}
+}
+
+/* Fill the windows and burst fields of stats, syncing w to second first */
+static void usage_windows_get(struct k_usage_windows *w, uint32_t second, uint64_t longest,
+			      struct k_thread_runtime_stats *stats)
+{
+	uint64_t cycles[K_USAGE_WINDOWS] = { 0 };
+	uint32_t secs[K_USAGE_WINDOWS];
+	uint64_t freq = usage_freq();
+	uint64_t total = 0U;
+
+	usage_windows_sync(w, second);
+
+	/* Seconds since the CPU clock started, if shorter than the windows */
+	secs[0] = MIN(w->second, 1U);
+	secs[1] = MIN(w->second, USAGE_SEC1_SLOTS);
+	secs[2] = MIN(w->second - (w->second % USAGE_SEC1_SLOTS),
+		      USAGE_SEC1_SLOTS * USAGE_SEC10_SLOTS);
+
+	if (w->second > 0U) {
+		cycles[0] = w->sec1[(w->second - 1U) % USAGE_SEC1_SLOTS];
+	}
+	for (unsigned int i = 0; i < USAGE_SEC1_SLOTS; i++) {
+		cycles[1] += w->sec1[i];
+	}
+	for (unsigned int i = 0; i < USAGE_SEC10_SLOTS; i++) {
+		cycles[2] += w->sec10[i];
+	}
+
+	for (unsigned int i = 0; i < K_USAGE_WINDOWS; i++) {
+		stats->window_load[i] = (secs[i] == 0U) ? 0U :
+			(uint32_t)MIN((cycles[i] * 1000U) / (secs[i] * freq), 1000U);
+	}
+
+	for (unsigned int i = 0; i < CONFIG_SCHED_THREAD_USAGE_BURST_BUCKETS; i++) {
+		total += w->bursts[i];
+	}
+
+	for (unsigned int i = 0; i < K_USAGE_BURST_PERCENTILES; i++) {
+		uint64_t target = DIV_ROUND_UP(total * usage_burst_percentiles[i], 100U);
+		uint64_t count = 0U;
+		unsigned int bucket = 0U;
+
+		stats->burst_cycles[i] = 0U;
+		if (target == 0U) {
+			continue;
+		}
+
+		while (count + w->bursts[bucket] < target) {
+			count += w->bursts[bucket++];
+		}
+
+		/* Upper bound of the bucket, the last one has none */
+		stats->burst_cycles[i] = (bucket == CONFIG_SCHED_THREAD_USAGE_BURST_BUCKETS - 1U) ?
+					 longest : MIN(BIT64(bucket + 1U), longest);
+	}
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 {
@@ -39,6 +189,10 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 		return;
 	}
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	sched_windows_update(cpu, cycles);
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 	if (cpu->current != cpu->idle_thread) {
 		cpu->usage->total += cycles;
 
@@ -49,6 +203,11 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 			cpu->usage->longest = cpu->usage->current;
 		}
 	} else {
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+		if (cpu->usage->current != 0U) {
+			usage_burst_record(&cpu->usage->windows, cpu->usage->current);
+		}
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
 		cpu->usage->current = 0;
 		cpu->usage->num_windows++;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
@@ -114,6 +273,14 @@ void z_sched_usage_stop(void)
 		sched_cpu_update_usage(cpu, cycles);
 	}
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	/* The thread is being switched out, its burst ends */
+	if (cpu->current->base.usage.track_usage && (cpu->current->base.usage.current != 0U)) {
+		usage_burst_record(&cpu->current->base.usage.windows,
+				   cpu->current->base.usage.current);
+	}
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 	cpu->usage0 = 0;
 	k_spin_unlock(&usage_lock, k);
 }
@@ -161,6 +328,11 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	usage_windows_get(&cpu->usage->windows, cpu->usage->windows.second,
+			  cpu->usage->longest, stats);
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
@@ -217,6 +389,11 @@ void z_sched_thread_usage(struct k_thread *thread,
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	usage_windows_get(&thread->base.usage.windows, cpu->usage->windows.second,
+			  thread->base.usage.longest, stats);
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -363,6 +540,11 @@ int z_thread_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	z_sched_thread_usage(thread, stats);
 
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	z_thread_perf_counters_get(thread,
+				   ((struct k_thread_runtime_stats *)stats)->perf_counters);
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
 	return 0;
 }
 
@@ -383,6 +565,14 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+	/* Keep the position of the windows, which follows the CPU clock */
+	stats->windows.current = 0U;
+	memset(stats->windows.sec1, 0, sizeof(stats->windows.sec1));
+	memset(stats->windows.sec10, 0, sizeof(stats->windows.sec10));
+	memset(stats->windows.bursts, 0, sizeof(stats->windows.bursts));
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 	if (thread != _current_cpu->current) {
 
 		/*
@@ -80,6 +80,22 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 
 static void clear_perms_cb(struct k_object *ko, void *ctx_ptr);
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+BUILD_ASSERT(K_OBJ_LAST <= UINT8_MAX, "object types do not fit the validation cache");
+
+/* Bumped whenever a validation may no longer hold, emptying all the caches */
+static atomic_t obj_cache_generation;
+
+static inline void obj_cache_invalidate(void)
+{
+	atomic_inc(&obj_cache_generation);
+}
+#else
+static inline void obj_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -470,6 +486,7 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
+		obj_cache_invalidate();
 		sys_dlist_remove(&dyn->dobj_list);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
@@ -565,6 +582,9 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 {
 	k_spinlock_key_t key = k_spin_lock(&obj_lock);
 
+	/* A permission is being revoked, and the object may be freed */
+	obj_cache_invalidate();
+
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
@@ -757,21 +777,8 @@ void k_object_access_all_grant(const void *object)
 	}
 }
 
-int k_object_validate(struct k_object *ko, enum k_objects otype,
-		       enum _obj_init_check init)
+static int validate_init(struct k_object *ko, enum _obj_init_check init)
 {
-	if (unlikely((ko == NULL) ||
-		((otype != K_OBJ_ANY) && (ko->type != otype)))) {
-		return -EBADF;
-	}
-
-	/* Manipulation of any kernel objects by a user thread requires that
-	 * thread be granted access first, even for uninitialized objects
-	 */
-	if (unlikely(thread_perms_test(ko) == 0)) {
-		return -EPERM;
-	}
-
 	/* Initialization state checks. _OBJ_INIT_ANY, we don't care */
 	if (likely(init == _OBJ_INIT_TRUE)) {
 		/* Object MUST be initialized */
@@ -790,6 +797,59 @@ int k_object_validate(struct k_object *ko, enum k_objects otype,
 	return 0;
 }
 
+int k_object_validate(struct k_object *ko, enum k_objects otype,
+		       enum _obj_init_check init)
+{
+	if (unlikely((ko == NULL) ||
+		((otype != K_OBJ_ANY) && (ko->type != otype)))) {
+		return -EBADF;
+	}
+
+	/* Manipulation of any kernel objects by a user thread requires that
+	 * thread be granted access first, even for uninitialized objects
+	 */
+	if (unlikely(thread_perms_test(ko) == 0)) {
+		return -EPERM;
+	}
+
+	return validate_init(ko, init);
+}
+
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+int k_object_validation_check_cached(const void *obj, enum k_objects otype,
+				     enum _obj_init_check init)
+{
+	struct _thread_obj_cache *cache = &_current->obj_cache;
+	long generation = atomic_get(&obj_cache_generation);
+	size_t slot = ((uintptr_t)obj / sizeof(void *)) % CONFIG_OBJ_VALIDATION_CACHE_SIZE;
+	struct k_object *ko;
+	int ret;
+
+	if (cache->generation != generation) {
+		(void)memset(cache->obj, 0, sizeof(cache->obj));
+		cache->generation = generation;
+	}
+
+	/* The type and the permission were checked when the entry was made,
+	 * failures go through the full check to be reported
+	 */
+	if ((obj != NULL) && (cache->obj[slot] == obj) && (cache->otype[slot] == otype) &&
+	    (validate_init(cache->ko[slot], init) == 0)) {
+		return 0;
+	}
+
+	ko = k_object_find(obj);
+	ret = k_object_validation_check(ko, obj, otype, init);
+	if (ret == 0) {
+		cache->obj[slot] = obj;
+		cache->ko[slot] = ko;
+		cache->otype[slot] = otype;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 void k_object_init(const void *obj)
 {
 	struct k_object *ko;
@@ -820,6 +880,7 @@ void k_object_recycle(const void *obj)
 	struct k_object *ko = k_object_find(obj);
 
 	if (ko != NULL) {
+		obj_cache_invalidate();
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
 		k_thread_perms_set(ko, _current);
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
@@ -189,6 +189,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 				 struct z_work_flusher *flusher)
 {
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_POOL
+	flusher->target = work;
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
 		sys_slist_insert(&queue->pending, &work->node,
@@ -213,6 +216,41 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 	}
 }
 
+/* Number of threads serving a queue. */
+static inline size_t queue_num_workers(const struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	return queue->num_workers;
+#else
+	ARG_UNUSED(queue);
+
+	return 1;
+#endif /* CONFIG_WORKQUEUE_POOL */
+}
+
+/* Thread of worker @p i of a queue. */
+static inline struct k_thread *queue_worker(struct k_work_q *queue, size_t i)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (i > 0) {
+		return &queue->workers[i - 1];
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return &queue->thread;
+}
+
+static bool queue_is_worker(struct k_work_q *queue, const struct k_thread *thread)
+{
+	for (size_t i = 0; i < queue_num_workers(queue); i++) {
+		if (thread == queue_worker(queue, i)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -262,7 +300,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = !k_is_in_isr() && queue_is_worker(queue, _current);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -599,6 +637,78 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Whether a pending item may be started by a pool worker.
+ *
+ * An item resubmitted while it runs stays pending until the worker running
+ * it is done, and so does a flusher whose target still runs: the flusher is
+ * queued right behind its target, which another worker may just have
+ * started.
+ *
+ * Invoked with work lock held.
+ */
+static bool work_startable_locked(struct k_work *work)
+{
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		return !flag_test(&flusher->target->flags, K_WORK_RUNNING_BIT);
+	}
+
+	return true;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Take the next item that may be started off the pending list.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the work item, or NULL if there is none.
+ */
+static struct k_work *queue_take_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	sys_snode_t *node;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+		struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+
+		if (work_startable_locked(work)) {
+			sys_slist_remove(&queue->pending, prev, node);
+			return work;
+		}
+		prev = node;
+	}
+
+	return NULL;
+#else
+	sys_snode_t *node = sys_slist_get(&queue->pending);
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct k_work, node);
+#endif /* CONFIG_WORKQUEUE_POOL */
+}
+
+/* Whether no item is pending nor running on the queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_idle_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->num_busy != 0U) {
+		return false;
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return sys_slist_is_empty(&queue->pending);
+}
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
@@ -611,37 +721,27 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
 
 	while (true) {
-		sys_snode_t *node;
-		struct k_work *work = NULL;
+		struct k_work *work;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
-		if (node != NULL) {
+		work = queue_take_locked(queue);
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
+#ifdef CONFIG_WORKQUEUE_POOL
+			queue->num_busy++;
+#endif /* CONFIG_WORKQUEUE_POOL */
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
 
-			/* Static code analysis tool can raise a false-positive violation
-			 * in the line below that 'work' is checked for null after being
-			 * dereferenced.
-			 *
-			 * The work is figured out by CONTAINER_OF, as a container
-			 * of type struct k_work that contains the node.
-			 * The only way for it to be NULL is if node would be a member
-			 * of struct k_work object that has been placed at address NULL,
-			 * which should never happen, even line 'if (work != NULL)'
-			 * ensures that.
-			 * This means that if node is not NULL, then work will not be NULL.
-			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (queue_idle_locked(queue) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -654,8 +754,17 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
 		} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
-			/* User has requested that the queue stop. Clear the status flags and exit.
+			/* User has requested that the queue stop. The last
+			 * worker to exit clears the status flags; with a pool
+			 * the others are woken in turn so they see the request.
 			 */
+#ifdef CONFIG_WORKQUEUE_POOL
+			if (--queue->num_alive != 0U) {
+				(void)notify_queue_locked(queue);
+				k_spin_unlock(&lock, key);
+				return;
+			}
+#endif /* CONFIG_WORKQUEUE_POOL */
 			flags_set(&queue->flags, 0);
 			k_spin_unlock(&lock, key);
 			return;
@@ -671,6 +780,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * the lock, and we didn't find work nor got asked to
 			 * stop.  Just go to sleep: when something happens the
 			 * work thread will be woken and we can check again.
+			 * Items held back for another worker are picked up
+			 * by that worker once it is done.
 			 */
 
 			(void)z_sched_wait(&lock, key, &queue->notifyq,
@@ -698,7 +809,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (--queue->num_busy == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif /* CONFIG_WORKQUEUE_POOL */
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -722,19 +839,16 @@ void k_work_queue_init(struct k_work_q *queue)
 	SYS_PORT_TRACING_OBJ_INIT(k_work_queue, queue);
 }
 
-void k_work_queue_start(struct k_work_q *queue,
-			k_thread_stack_t *stack,
-			size_t stack_size,
-			int prio,
-			const struct k_work_queue_config *cfg)
+/* Set up the state of a queue about to be started.
+ *
+ * It hasn't actually been started yet, but all the state is in place so we
+ * can submit things and once the workers get control they're ready to roll.
+ */
+static void queue_prepare(struct k_work_q *queue,
+			  const struct k_work_queue_config *cfg)
 {
-	__ASSERT_NO_MSG(queue);
-	__ASSERT_NO_MSG(stack);
-	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
 	uint32_t flags = K_WORK_QUEUE_STARTED;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
-
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
@@ -743,29 +857,95 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
-	/* It hasn't actually been started yet, but all the state is in place
-	 * so we can submit things and once the thread gets control it's ready
-	 * to roll.
-	 */
 	flags_set(&queue->flags, flags);
+}
+
+/* Create and start worker @p i of a queue, pinning it to a CPU if @p pin. */
+static void worker_start(struct k_work_q *queue, size_t i,
+			 k_thread_stack_t *stack, size_t stack_size,
+			 int prio, const struct k_work_queue_config *cfg, bool pin)
+{
+	struct k_thread *thread = queue_worker(queue, i);
 
-	(void)k_thread_create(&queue->thread, stack, stack_size,
+	(void)k_thread_create(thread, stack, stack_size,
 			      work_queue_main, queue, NULL, NULL,
 			      prio, 0, K_FOREVER);
 
 	if ((cfg != NULL) && (cfg->name != NULL)) {
-		k_thread_name_set(&queue->thread, cfg->name);
+		k_thread_name_set(thread, cfg->name);
 	}
 
 	if ((cfg != NULL) && (cfg->essential)) {
-		queue->thread.base.user_options |= K_ESSENTIAL;
+		thread->base.user_options |= K_ESSENTIAL;
 	}
 
-	k_thread_start(&queue->thread);
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (pin) {
+		(void)k_thread_cpu_pin(thread, (int)(i % arch_num_cpus()));
+	}
+#else
+	ARG_UNUSED(pin);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	k_thread_start(thread);
+}
+
+void k_work_queue_start(struct k_work_q *queue,
+			k_thread_stack_t *stack,
+			size_t stack_size,
+			int prio,
+			const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	queue_prepare(queue, cfg);
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->workers = NULL;
+	queue->num_workers = 1U;
+	queue->num_busy = 0U;
+	queue->num_alive = 1U;
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	worker_start(queue, 0, stack, stack_size, prio, cfg, false);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_start_pool(struct k_work_q *queue, struct k_thread *threads,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     size_t num_workers, int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG((num_workers == 1U) || (threads != NULL));
+	__ASSERT_NO_MSG((num_workers >= 1U) && (num_workers <= UINT8_MAX));
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	uintptr_t ssz = K_THREAD_STACK_LEN(stack_size);
+	bool pin = (cfg != NULL) && cfg->pin_workers;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	queue_prepare(queue, cfg);
+	queue->workers = threads;
+	queue->num_workers = (uint8_t)num_workers;
+	queue->num_busy = 0U;
+	queue->num_alive = (uint8_t)num_workers;
+
+	for (size_t i = 0; i < num_workers; i++) {
+		worker_start(queue, i, &stacks[ssz * i], stack_size, prio, cfg, pin);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -841,12 +1021,18 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	notify_queue_locked(queue);
 	k_spin_unlock(&lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
-	if (k_thread_join(&queue->thread, timeout)) {
-		key = k_spin_lock(&lock);
-		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
-		k_spin_unlock(&lock, key);
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, -ETIMEDOUT);
-		return -ETIMEDOUT;
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	for (size_t i = 0; i < queue_num_workers(queue); i++) {
+		if (k_thread_join(queue_worker(queue, i), sys_timepoint_timeout(end))) {
+			key = k_spin_lock(&lock);
+			flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
+			k_spin_unlock(&lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout,
+						       -ETIMEDOUT);
+			return -ETIMEDOUT;
+		}
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, stop, queue, timeout, 0);
@@ -937,12 +1123,14 @@ int k_work_delayable_busy_get(const struct k_work_delayable *dwork)
  *
  * @param delay the delay to use before scheduling.
  *
+ * @param slack how much later than the delay the timeout may fire.
+ *
  * @retval from submit_to_queue_locked() if delay is K_NO_WAIT; otherwise
  * @retval 1 to indicate successfully scheduled.
  */
 static int schedule_for_queue_locked(struct k_work_q **queuep,
 				     struct k_work_delayable *dwork,
-				     k_timeout_t delay)
+				     k_timeout_t delay, k_timeout_t slack)
 {
 	int ret = 1;
 	struct k_work *work = &dwork->work;
@@ -955,6 +1143,7 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	dwork->queue = *queuep;
 
 	/* Add timeout */
+	z_set_timeout_slack(&dwork->timeout, slack);
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
 
 	return ret;
@@ -1007,25 +1196,33 @@ static int cancel_delayable_async_locked(struct k_work_delayable *dwork)
 	return cancel_async_locked(&dwork->work);
 }
 
-int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
-			      k_timeout_t delay)
+static int schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+			      k_timeout_t delay, k_timeout_t slack)
 {
-	__ASSERT_NO_MSG(queue != NULL);
-	__ASSERT_NO_MSG(dwork != NULL);
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, schedule_for_queue, queue, dwork, delay);
-
 	struct k_work *work = &dwork->work;
 	int ret = 0;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	/* Schedule the work item if it's idle or running. */
 	if ((work_busy_get_locked(work) & ~K_WORK_RUNNING) == 0U) {
-		ret = schedule_for_queue_locked(&queue, dwork, delay);
+		ret = schedule_for_queue_locked(&queue, dwork, delay, slack);
 	}
 
 	k_spin_unlock(&lock, key);
 
+	return ret;
+}
+
+int k_work_schedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
+			      k_timeout_t delay)
+{
+	__ASSERT_NO_MSG(queue != NULL);
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, schedule_for_queue, queue, dwork, delay);
+
+	int ret = schedule_for_queue(queue, dwork, delay, K_NO_WAIT);
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, schedule_for_queue, queue, dwork, delay, ret);
 
 	return ret;
@@ -1042,6 +1239,28 @@ int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay)
 	return ret;
 }
 
+int k_work_schedule_for_queue_slack(struct k_work_q *queue,
+				    struct k_work_delayable *dwork,
+				    k_timeout_t delay, k_timeout_t slack)
+{
+	__ASSERT_NO_MSG(queue != NULL);
+	__ASSERT_NO_MSG(dwork != NULL);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, schedule_for_queue, queue, dwork, delay);
+
+	int ret = schedule_for_queue(queue, dwork, delay, slack);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, schedule_for_queue, queue, dwork, delay, ret);
+
+	return ret;
+}
+
+int k_work_schedule_slack(struct k_work_delayable *dwork, k_timeout_t delay,
+			  k_timeout_t slack)
+{
+	return k_work_schedule_for_queue_slack(&k_sys_work_q, dwork, delay, slack);
+}
+
 int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable *dwork,
 				k_timeout_t delay)
 {
@@ -1057,7 +1276,7 @@ int k_work_reschedule_for_queue(struct k_work_q *queue, struct k_work_delayable
 	(void)unschedule_locked(dwork);
 
 	/* Schedule the work item with the new parameters. */
-	ret = schedule_for_queue_locked(&queue, dwork, delay);
+	ret = schedule_for_queue_locked(&queue, dwork, delay, K_NO_WAIT);
 
 	k_spin_unlock(&lock, key);
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_CPP_COROUTINE_SOCKETS
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
+#endif
+
+/*
+ * Coroutine frames come from a slab. The ones too large for it, or
+ * allocated while it is empty, come from the heap.
+ */
+K_MEM_SLAB_DEFINE_STATIC(coroutine_frames, CONFIG_CPP_COROUTINE_FRAME_SIZE,
+			 CONFIG_CPP_COROUTINE_FRAMES, sizeof(void *) * 2);
+
+void *z_cpp_coroutine_frame_alloc(size_t size)
+{
+	void *ptr;
+
+	if ((size <= CONFIG_CPP_COROUTINE_FRAME_SIZE) &&
+	    (k_mem_slab_alloc(&coroutine_frames, &ptr, K_NO_WAIT) == 0)) {
+		return ptr;
+	}
+
+	return malloc(size);
+}
+
+void z_cpp_coroutine_frame_free(void *ptr)
+{
+	uintptr_t offset = (uintptr_t)ptr - (uintptr_t)coroutine_frames.buffer;
+
+	if (offset < (uintptr_t)coroutine_frames.info.num_blocks *
+			     coroutine_frames.info.block_size) {
+		k_mem_slab_free(&coroutine_frames, ptr);
+	} else {
+		free(ptr);
+	}
+}
+
+#ifdef CONFIG_CPP_COROUTINE_SOCKETS
+
+/* Same layout as in zephyr/cpp/coroutine.hpp */
+struct z_cpp_socket_wait {
+	int fd;
+	short events;
+	short revents;
+	void (*ready)(struct z_cpp_socket_wait *wait);
+};
+
+/*
+ * Coroutines waiting for sockets share a single socket service. Unused
+ * entries have a negative fd, which the service ignores.
+ */
+static struct zsock_pollfd socket_fds[CONFIG_CPP_COROUTINE_SOCKETS] = {
+	[0 ... (CONFIG_CPP_COROUTINE_SOCKETS - 1)] = {.fd = -1},
+};
+static struct z_cpp_socket_wait *socket_waits[CONFIG_CPP_COROUTINE_SOCKETS];
+static K_MUTEX_DEFINE(socket_lock);
+
+static void socket_ready(struct net_socket_service_event *pev);
+
+NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(coroutine_sockets, socket_ready,
+				      CONFIG_CPP_COROUTINE_SOCKETS);
+
+static void socket_ready(struct net_socket_service_event *pev)
+{
+	struct z_cpp_socket_wait *wait = NULL;
+
+	k_mutex_lock(&socket_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH(socket_fds, i) {
+		if ((socket_waits[i] != NULL) && (socket_fds[i].fd == pev->event.fd)) {
+			wait = socket_waits[i];
+			socket_waits[i] = NULL;
+			socket_fds[i].fd = -1;
+			break;
+		}
+	}
+
+	/* The service keeps polling the fd until it is told to stop */
+	if (wait != NULL) {
+		(void)net_socket_service_register(&coroutine_sockets, socket_fds,
+						  ARRAY_SIZE(socket_fds), NULL);
+	}
+
+	k_mutex_unlock(&socket_lock);
+
+	if (wait != NULL) {
+		wait->revents = pev->event.revents;
+		wait->ready(wait);
+	}
+}
+
+int z_cpp_coroutine_socket_wait(struct z_cpp_socket_wait *wait)
+{
+	int ret = -ENOMEM;
+
+	k_mutex_lock(&socket_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH(socket_fds, i) {
+		if (socket_waits[i] == NULL) {
+			socket_waits[i] = wait;
+			socket_fds[i] = (struct zsock_pollfd){
+				.fd = wait->fd,
+				.events = wait->events,
+			};
+			ret = net_socket_service_register(&coroutine_sockets, socket_fds,
+							  ARRAY_SIZE(socket_fds), NULL);
+			if (ret != 0) {
+				socket_waits[i] = NULL;
+				socket_fds[i].fd = -1;
+			}
+			break;
+		}
+	}
+
+	k_mutex_unlock(&socket_lock);
+
+	return ret;
+}
+
+#endif /* CONFIG_CPP_COROUTINE_SOCKETS */
@@ -0,0 +1,45 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/cpp/coroutine.hpp>
+
+namespace zephyr
+{
+
+void executor::post(detail::ready_node &node) noexcept
+{
+	k_spinlock_key_t key = k_spin_lock(&lock_);
+
+	sys_slist_append(&ready_, &node.node);
+	k_spin_unlock(&lock_, key);
+
+	(void)k_work_submit_to_queue(queue_, &work_);
+}
+
+void executor::run(struct k_work *work)
+{
+	executor *self = reinterpret_cast<executor *>(work);
+	sys_slist_t ready;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	/*
+	 * Only resume the coroutines ready so far: the ones they post again
+	 * resubmit the work item, and wait for the other work items queued
+	 * meanwhile.
+	 */
+	key = k_spin_lock(&self->lock_);
+	ready = self->ready_;
+	sys_slist_init(&self->ready_);
+	k_spin_unlock(&self->lock_, key);
+
+	/* The node is in the frame, which may be gone once resumed */
+	while ((node = sys_slist_get(&ready)) != nullptr) {
+		reinterpret_cast<detail::ready_node *>(node)->handle.resume();
+	}
+}
+
+} /* namespace zephyr */
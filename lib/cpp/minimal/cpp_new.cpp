@@ -19,24 +19,53 @@
 #define NODISCARD [[nodiscard]]
 #endif /* __cplusplus */
 
+#ifdef CONFIG_CPP_NEW_SLABS
+extern "C" {
+void *z_cpp_new_alloc(size_t size);
+void z_cpp_new_free(void *ptr);
+void z_cpp_new_free_sized(void *ptr, size_t size);
+}
+
+#define new_alloc(size) z_cpp_new_alloc(size)
+#define new_free(ptr) z_cpp_new_free(ptr)
+#define new_free_sized(ptr, size) z_cpp_new_free_sized(ptr, size)
+#else
+#define new_alloc(size) malloc(size)
+#define new_free(ptr) free(ptr)
+#define new_free_sized(ptr, size) free(ptr)
+#endif /* CONFIG_CPP_NEW_SLABS */
+
+static inline void* new_alloc_or_throw(size_t size)
+{
+	void* ptr = new_alloc(size);
+
+#ifdef CONFIG_CPP_EXCEPTIONS
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+#endif /* CONFIG_CPP_EXCEPTIONS */
+
+	return ptr;
+}
+
 NODISCARD void* operator new(size_t size)
 {
-	return malloc(size);
+	return new_alloc_or_throw(size);
 }
 
 NODISCARD void* operator new[](size_t size)
 {
-	return malloc(size);
+	return new_alloc_or_throw(size);
 }
 
 NODISCARD void* operator new(std::size_t size, const std::nothrow_t& tag) NOEXCEPT
 {
-	return malloc(size);
+	return new_alloc(size);
 }
 
 NODISCARD void* operator new[](std::size_t size, const std::nothrow_t& tag) NOEXCEPT
 {
-	return malloc(size);
+	return new_alloc(size);
 }
 
 #if __cplusplus >= 201703L
@@ -65,22 +94,45 @@ NODISCARD void* operator new[](std::size_t size, std::align_val_t al,
 
 void operator delete(void* ptr) NOEXCEPT
 {
-	free(ptr);
+	new_free(ptr);
 }
 
 void operator delete[](void* ptr) NOEXCEPT
 {
-	free(ptr);
+	new_free(ptr);
 }
 
 #if (__cplusplus > 201103L)
-void operator delete(void* ptr, size_t) NOEXCEPT
+void operator delete(void* ptr, size_t size) NOEXCEPT
+{
+	new_free_sized(ptr, size);
+}
+
+void operator delete[](void* ptr, size_t size) NOEXCEPT
+{
+	new_free_sized(ptr, size);
+}
+#endif // __cplusplus > 201103L
+
+#if __cplusplus >= 201703L
+/* Aligned allocations come from aligned_alloc(), never from the slabs */
+void operator delete(void* ptr, std::align_val_t) NOEXCEPT
 {
 	free(ptr);
 }
 
-void operator delete[](void* ptr, size_t) NOEXCEPT
+void operator delete[](void* ptr, std::align_val_t) NOEXCEPT
 {
 	free(ptr);
 }
-#endif // __cplusplus > 201103L
+
+void operator delete(void* ptr, size_t, std::align_val_t) NOEXCEPT
+{
+	free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) NOEXCEPT
+{
+	free(ptr);
+}
+#endif /* __cplusplus >= 201703L */
@@ -0,0 +1,88 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Small object allocator behind the global operator new: allocations of up
+ * to 128 bytes take a block from the slab of their size class, without
+ * touching the lock of the system heap. Larger allocations, and the ones
+ * made while their slab is empty, use malloc().
+ */
+
+#include <stdlib.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define SLAB_MIN_SIZE 16
+#define SLAB_MAX_SIZE 128
+
+/* Blocks are aligned on their size, which covers any fundamental alignment */
+K_MEM_SLAB_DEFINE_STATIC(cpp_new_slab_16, 16, CONFIG_CPP_NEW_SLAB_BLOCKS, 16);
+K_MEM_SLAB_DEFINE_STATIC(cpp_new_slab_32, 32, CONFIG_CPP_NEW_SLAB_BLOCKS, 32);
+K_MEM_SLAB_DEFINE_STATIC(cpp_new_slab_64, 64, CONFIG_CPP_NEW_SLAB_BLOCKS, 64);
+K_MEM_SLAB_DEFINE_STATIC(cpp_new_slab_128, 128, CONFIG_CPP_NEW_SLAB_BLOCKS, 128);
+
+static struct k_mem_slab *const cpp_new_slabs[] = {
+	&cpp_new_slab_16,
+	&cpp_new_slab_32,
+	&cpp_new_slab_64,
+	&cpp_new_slab_128,
+};
+
+BUILD_ASSERT(SLAB_MIN_SIZE << (ARRAY_SIZE(cpp_new_slabs) - 1) == SLAB_MAX_SIZE);
+
+/* Slab serving size, or NULL if too large */
+static struct k_mem_slab *size_to_slab(size_t size)
+{
+	if (size > SLAB_MAX_SIZE) {
+		return NULL;
+	}
+
+	return cpp_new_slabs[LOG2CEIL(MAX(size, SLAB_MIN_SIZE)) - LOG2CEIL(SLAB_MIN_SIZE)];
+}
+
+static bool slab_owns(const struct k_mem_slab *slab, const void *ptr)
+{
+	uintptr_t offset = (uintptr_t)ptr - (uintptr_t)slab->buffer;
+
+	return offset < (uintptr_t)slab->info.num_blocks * slab->info.block_size;
+}
+
+void *z_cpp_new_alloc(size_t size)
+{
+	struct k_mem_slab *slab = size_to_slab(size);
+	void *ptr;
+
+	if ((slab != NULL) && (k_mem_slab_alloc(slab, &ptr, K_NO_WAIT) == 0)) {
+		return ptr;
+	}
+
+	return malloc(size);
+}
+
+void z_cpp_new_free(void *ptr)
+{
+	ARRAY_FOR_EACH(cpp_new_slabs, i) {
+		if (slab_owns(cpp_new_slabs[i], ptr)) {
+			k_mem_slab_free(cpp_new_slabs[i], ptr);
+			return;
+		}
+	}
+
+	free(ptr);
+}
+
+void z_cpp_new_free_sized(void *ptr, size_t size)
+{
+	/* Only the slab of the size class can hold ptr, no need to scan the others */
+	struct k_mem_slab *slab = size_to_slab(size);
+
+	if ((slab != NULL) && slab_owns(slab, ptr)) {
+		k_mem_slab_free(slab, ptr);
+		return;
+	}
+
+	free(ptr);
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC32_SLICE8_H_
+#define ZEPHYR_LIB_CRC_CRC32_SLICE8_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+/*
+ * Reflected CRC32 update, eight bytes per step. table[0] is the usual
+ * byte table, table[k] the CRC of a byte followed by k zero bytes.
+ */
+static inline uint32_t crc32_slice8_update(const uint32_t table[8][256], uint32_t crc,
+					   const uint8_t *data, size_t len)
+{
+	while (len >= 8) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+		uint32_t hi = sys_get_le32(&data[4]);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+
+		data += 8;
+		len -= 8;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		crc = (crc >> 8) ^ table[0][(crc ^ data[i]) & 0xff];
+	}
+
+	return crc;
+}
+
+#endif /* ZEPHYR_LIB_CRC_CRC32_SLICE8_H_ */
@@ -0,0 +1,113 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * wyhash final version 4, https://github.com/wangyi-fudan/wyhash, with a
+ * seed of 0 and the default secret. The 64-bit result is truncated.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+static const uint64_t wy_secret[4] = {
+	0xa0761d6478bd642fULL,
+	0xe7037ed1a0b428dbULL,
+	0x8ebc6af09c88c6e3ULL,
+	0x589965cc75374cc3ULL,
+};
+
+/* 64 x 64 -> 128 bit multiply, low half in *a and high half in *b */
+static inline void wy_mum(uint64_t *a, uint64_t *b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 r = (unsigned __int128)*a * *b;
+
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	uint64_t ha = *a >> 32, hb = *b >> 32;
+	uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32);
+	uint64_t c = t < rl;
+	uint64_t lo = t + (rm1 << 32);
+
+	c += lo < t;
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b)
+{
+	wy_mum(&a, &b);
+
+	return a ^ b;
+}
+
+static inline uint64_t wy_r3(const uint8_t *p, size_t k)
+{
+	return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint32_t sys_hash32_wyhash(const void *str, size_t n)
+{
+	const uint8_t *p = str;
+	uint64_t seed = wy_mix(wy_secret[0], wy_secret[1]);
+	uint64_t a, b;
+
+	if (n <= 16) {
+		if (n >= 4) {
+			size_t off = (n >> 3) << 2;
+
+			a = ((uint64_t)sys_get_le32(p) << 32) | sys_get_le32(p + off);
+			b = ((uint64_t)sys_get_le32(p + n - 4) << 32) |
+			    sys_get_le32(p + n - 4 - off);
+		} else if (n > 0) {
+			a = wy_r3(p, n);
+			b = 0;
+		} else {
+			a = 0;
+			b = 0;
+		}
+	} else {
+		size_t i = n;
+
+		if (i >= 48) {
+			/* Three independent lanes, like the reference */
+			uint64_t see1 = seed, see2 = seed;
+
+			do {
+				seed = wy_mix(sys_get_le64(p) ^ wy_secret[1],
+					      sys_get_le64(p + 8) ^ seed);
+				see1 = wy_mix(sys_get_le64(p + 16) ^ wy_secret[2],
+					      sys_get_le64(p + 24) ^ see1);
+				see2 = wy_mix(sys_get_le64(p + 32) ^ wy_secret[3],
+					      sys_get_le64(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+			seed ^= see1 ^ see2;
+		}
+
+		while (i > 16) {
+			seed = wy_mix(sys_get_le64(p) ^ wy_secret[1], sys_get_le64(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+
+		a = sys_get_le64(p + i - 16);
+		b = sys_get_le64(p + i - 8);
+	}
+
+	a ^= wy_secret[1];
+	b ^= seed;
+	wy_mum(&a, &b);
+
+	return (uint32_t)wy_mix(a ^ wy_secret[0] ^ n, b ^ wy_secret[1]);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * xxHash32, as specified in
+ * https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ * with a seed of 0.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#define XXH_PRIME32_1 0x9e3779b1U
+#define XXH_PRIME32_2 0x85ebca77U
+#define XXH_PRIME32_3 0xc2b2ae3dU
+#define XXH_PRIME32_4 0x27d4eb2fU
+#define XXH_PRIME32_5 0x165667b1U
+
+static inline uint32_t xxh32_rotl(uint32_t x, unsigned int r)
+{
+	return (x << r) | (x >> (32U - r));
+}
+
+static inline uint32_t xxh32_round(uint32_t acc, uint32_t input)
+{
+	acc += input * XXH_PRIME32_2;
+	acc = xxh32_rotl(acc, 13);
+
+	return acc * XXH_PRIME32_1;
+}
+
+uint32_t sys_hash32_xxhash32(const void *str, size_t n)
+{
+	const uint8_t *p = str;
+	const size_t len = n;
+	uint32_t h;
+
+	if (n >= 16) {
+		/* Four independent lanes, so their multiplies can overlap */
+		uint32_t v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+		uint32_t v2 = XXH_PRIME32_2;
+		uint32_t v3 = 0;
+		uint32_t v4 = -XXH_PRIME32_1;
+
+		for (; n >= 16; n -= 16, p += 16) {
+			v1 = xxh32_round(v1, sys_get_le32(p));
+			v2 = xxh32_round(v2, sys_get_le32(p + 4));
+			v3 = xxh32_round(v3, sys_get_le32(p + 8));
+			v4 = xxh32_round(v4, sys_get_le32(p + 12));
+		}
+
+		h = xxh32_rotl(v1, 1) + xxh32_rotl(v2, 7) + xxh32_rotl(v3, 12) +
+		    xxh32_rotl(v4, 18);
+	} else {
+		h = XXH_PRIME32_5;
+	}
+
+	h += (uint32_t)len;
+
+	for (; n >= 4; n -= 4, p += 4) {
+		h += sys_get_le32(p) * XXH_PRIME32_3;
+		h = xxh32_rotl(h, 17) * XXH_PRIME32_4;
+	}
+
+	for (; n != 0; --n, ++p) {
+		h += *p * XXH_PRIME32_5;
+		h = xxh32_rotl(h, 11) * XXH_PRIME32_1;
+	}
+
+	h ^= h >> 15;
+	h *= XXH_PRIME32_2;
+	h ^= h >> 13;
+	h *= XXH_PRIME32_3;
+	h ^= h >> 16;
+
+	return h;
+}
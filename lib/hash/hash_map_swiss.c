@@ -0,0 +1,405 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * The table is a single allocation: one control byte per bucket, followed by
+ * the entries. A control byte is EMPTY or holds the low 7 bits of the hash of
+ * the key in the bucket, the rest of the hash picks the home group.
+ *
+ * Groups of GROUP_WIDTH buckets are probed linearly. A lookup goes on past a
+ * group only if the group is full, so a key is always stored in its home
+ * group or after a run of full groups starting there. Removal keeps it that
+ * way by moving a later entry into the hole, instead of leaving a tombstone.
+ */
+
+#define GROUP_WIDTH 8
+#define CTRL_EMPTY  0x80
+
+#define CTRL_ONES  0x0101010101010101ULL
+#define CTRL_HIGHS 0x8080808080808080ULL
+
+struct swiss_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static inline uint8_t *swiss_ctrl(const struct sys_hashmap *map)
+{
+	return map->data->buckets;
+}
+
+static inline struct swiss_entry *swiss_entries(const struct sys_hashmap *map)
+{
+	return (struct swiss_entry *)(swiss_ctrl(map) + map->data->n_buckets);
+}
+
+static inline size_t swiss_n_groups(const struct sys_hashmap *map)
+{
+	return map->data->n_buckets / GROUP_WIDTH;
+}
+
+static inline uint64_t swiss_group_load(const struct sys_hashmap *map, size_t group)
+{
+	/* byte i of the group ends up in bits 8 * i of the word */
+	return sys_get_le64(&swiss_ctrl(map)[group * GROUP_WIDTH]);
+}
+
+/* High bit set in each byte of the group equal to h2, with rare false positives */
+static inline uint64_t swiss_group_match(uint64_t ctrl, uint8_t h2)
+{
+	uint64_t x = ctrl ^ (CTRL_ONES * h2);
+
+	return (x - CTRL_ONES) & ~x & CTRL_HIGHS;
+}
+
+/* High bit set in each EMPTY byte of the group */
+static inline uint64_t swiss_group_empty(uint64_t ctrl)
+{
+	return ctrl & CTRL_HIGHS;
+}
+
+/* Index in the group of the lowest byte flagged in the mask */
+static inline size_t swiss_mask_first(uint64_t mask)
+{
+	return (size_t)__builtin_ctzll(mask) / 8;
+}
+
+static inline uint32_t swiss_hash(const struct sys_hashmap *map, uint64_t key)
+{
+	return map->hash_func(&key, sizeof(key));
+}
+
+static inline size_t swiss_home(const struct sys_hashmap *map, uint32_t hash)
+{
+	return (hash >> 7) & (swiss_n_groups(map) - 1);
+}
+
+/* Bucket of the key, or of the EMPTY bucket ending its probe when absent */
+static size_t sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key, bool *found)
+{
+	const uint32_t hash = swiss_hash(map, key);
+	const uint8_t h2 = hash & 0x7f;
+	const size_t n_groups = swiss_n_groups(map);
+	const struct swiss_entry *entries = swiss_entries(map);
+	size_t group = swiss_home(map, hash);
+
+	for (size_t i = 0; i < n_groups; ++i, group = (group + 1) & (n_groups - 1)) {
+		uint64_t ctrl = swiss_group_load(map, group);
+		uint64_t mask;
+
+		for (mask = swiss_group_match(ctrl, h2); mask != 0; mask &= mask - 1) {
+			size_t bucket = group * GROUP_WIDTH + swiss_mask_first(mask);
+
+			if (entries[bucket].key == key) {
+				*found = true;
+				return bucket;
+			}
+		}
+
+		mask = swiss_group_empty(ctrl);
+		if (mask != 0) {
+			*found = false;
+			return group * GROUP_WIDTH + swiss_mask_first(mask);
+		}
+	}
+
+	__ASSERT(false, "Hashmap has no empty bucket");
+	*found = false;
+
+	return SIZE_MAX;
+}
+
+static int sys_hashmap_swiss_insert_no_rehash(struct sys_hashmap *map, uint64_t key,
+					      uint64_t value, uint64_t *old_value)
+{
+	bool found;
+	size_t bucket;
+	struct swiss_entry *entry;
+
+	bucket = sys_hashmap_swiss_find(map, key, &found);
+	__ASSERT_NO_MSG(bucket < map->data->n_buckets);
+
+	entry = &swiss_entries(map)[bucket];
+
+	if (found) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+		entry->value = value;
+		return 0;
+	}
+
+	swiss_ctrl(map)[bucket] = swiss_hash(map, key) & 0x7f;
+	entry->key = key;
+	entry->value = value;
+	++map->data->size;
+
+	return 1;
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t old_n_buckets;
+	size_t new_n_buckets = 0;
+	uint8_t *old_ctrl;
+	struct swiss_entry *old_entries;
+	uint8_t *new_buckets;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, 0, &new_n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	/* whole groups only */
+	if (new_n_buckets != 0) {
+		new_n_buckets = MAX(new_n_buckets, GROUP_WIDTH);
+	}
+
+	if (new_n_buckets == data->n_buckets) {
+		return 0;
+	}
+
+	old_n_buckets = data->n_buckets;
+	old_ctrl = data->buckets;
+	old_entries = (struct swiss_entry *)(old_ctrl + old_n_buckets);
+
+	new_buckets = map->alloc_func(NULL, new_n_buckets * (1 + sizeof(struct swiss_entry)));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		memset(new_buckets, CTRL_EMPTY, new_n_buckets);
+	}
+
+	data->size = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0; i < old_n_buckets; ++i) {
+		if (old_ctrl[i] != CTRL_EMPTY) {
+			sys_hashmap_swiss_insert_no_rehash(map, old_entries[i].key,
+							   old_entries[i].value, NULL);
+		}
+	}
+
+	/* free the old Hashmap */
+	map->alloc_func(old_ctrl, 0);
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	const uint8_t *ctrl = swiss_ctrl(map);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = (void *)ctrl;
+	}
+
+	i = (const uint8_t *)it->state - ctrl;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if (ctrl[i] != CTRL_EMPTY) {
+			it->state = (void *)&ctrl[i + 1];
+			it->key = swiss_entries(map)[i].key;
+			it->value = swiss_entries(map)[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const uint8_t *ctrl = data->buckets;
+
+	for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size; ++i) {
+		if (ctrl[i] != CTRL_EMPTY) {
+			cb(swiss_entries(map)[i].key, swiss_entries(map)[i].value, cookie);
+			++j;
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+}
+
+static inline int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+					   uint64_t *old_value)
+{
+	int ret;
+
+	ret = sys_hashmap_swiss_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return sys_hashmap_swiss_insert_no_rehash(map, key, value, old_value);
+}
+
+/* Empties a bucket, moving later entries back so that none is cut from its home group */
+static void sys_hashmap_swiss_erase(struct sys_hashmap *map, size_t hole)
+{
+	uint8_t *ctrl = swiss_ctrl(map);
+	struct swiss_entry *entries = swiss_entries(map);
+	const size_t n_groups = swiss_n_groups(map);
+	const size_t mask = n_groups - 1;
+
+	ctrl[hole] = CTRL_EMPTY;
+
+	while (true) {
+		size_t hole_group = hole / GROUP_WIDTH;
+		uint64_t empty = swiss_group_empty(swiss_group_load(map, hole_group));
+		size_t moved = SIZE_MAX;
+
+		/* Nothing probed past a group that had an EMPTY bucket already */
+		if ((empty & (empty - 1)) != 0) {
+			return;
+		}
+
+		for (size_t g = (hole_group + 1) & mask; g != hole_group && moved == SIZE_MAX;
+		     g = (g + 1) & mask) {
+			uint64_t group_ctrl = swiss_group_load(map, g);
+
+			for (size_t b = g * GROUP_WIDTH; b < (g + 1) * GROUP_WIDTH; ++b) {
+				size_t home;
+
+				if (ctrl[b] == CTRL_EMPTY) {
+					continue;
+				}
+
+				/* Entry with its home at or before the hole needs it filled */
+				home = swiss_home(map, swiss_hash(map, entries[b].key));
+				if (((g - home) & mask) >= ((g - hole_group) & mask)) {
+					moved = b;
+					break;
+				}
+			}
+
+			/* Entries after this group do not depend on the hole */
+			if (swiss_group_empty(group_ctrl) != 0) {
+				break;
+			}
+		}
+
+		if (moved == SIZE_MAX) {
+			return;
+		}
+
+		ctrl[hole] = ctrl[moved];
+		entries[hole] = entries[moved];
+		ctrl[moved] = CTRL_EMPTY;
+		hole = moved;
+	}
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	bool found;
+	size_t bucket;
+
+	if (map->data->size == 0) {
+		return false;
+	}
+
+	bucket = sys_hashmap_swiss_find(map, key, &found);
+	if (!found) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = swiss_entries(map)[bucket].value;
+	}
+
+	sys_hashmap_swiss_erase(map, bucket);
+	--map->data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_swiss_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	bool found;
+	size_t bucket;
+
+	if (map->data->size == 0) {
+		return false;
+	}
+
+	bucket = sys_hashmap_swiss_find(map, key, &found);
+	if (!found) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = swiss_entries(map)[bucket].value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
@@ -0,0 +1,65 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/arena.h>
+#include <zephyr/sys/util.h>
+
+void sys_arena_init(struct sys_arena *arena, void *mem, size_t bytes)
+{
+	arena->base = mem;
+	arena->size = bytes;
+	arena->used = 0;
+	arena->max_used = 0;
+	arena->heap = NULL;
+}
+
+int sys_arena_init_from_heap(struct sys_arena *arena, struct k_heap *heap,
+			     size_t bytes, k_timeout_t timeout)
+{
+	void *mem = k_heap_aligned_alloc(heap, SYS_ARENA_ALIGN, bytes, timeout);
+
+	if (mem == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_arena_init(arena, mem, bytes);
+	arena->heap = heap;
+
+	return 0;
+}
+
+void sys_arena_release(struct sys_arena *arena)
+{
+	if (arena->heap != NULL) {
+		k_heap_free(arena->heap, arena->base);
+	}
+
+	sys_arena_init(arena, NULL, 0);
+}
+
+void *sys_arena_aligned_alloc(struct sys_arena *arena, size_t align, size_t bytes)
+{
+	uintptr_t base = (uintptr_t)arena->base;
+	size_t offset;
+
+	if (align == 0) {
+		align = SYS_ARENA_ALIGN;
+	}
+	__ASSERT((align & (align - 1)) == 0, "align must be a power of 2");
+
+	/* Align the address, the buffer itself need not be aligned */
+	offset = ROUND_UP(base + arena->used, align) - base;
+	if ((bytes == 0) || (offset > arena->size) || (bytes > (arena->size - offset))) {
+		return NULL;
+	}
+
+	arena->used = offset + bytes;
+	arena->max_used = MAX(arena->max_used, arena->used);
+
+	return (void *)(base + offset);
+}
@@ -37,11 +37,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +70,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -246,10 +246,9 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	/* Otherwise pick the smallest non-empty bucket guaranteed to
 	 * fit and use that unconditionally.
 	 */
-	uint32_t bmask = h->avail_buckets & ~BIT_MASK(bi + 1);
+	int minbucket = next_avail_bucket(h, bi);
 
-	if (bmask != 0U) {
-		int minbucket = __builtin_ctz(bmask);
+	if (minbucket >= 0) {
 		chunkid_t c = h->buckets[minbucket].next;
 
 		free_list_remove_bidx(h, c, minbucket);
@@ -260,11 +259,13 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+static void *heap_alloc(struct sys_heap *heap, size_t bytes, void *call_site)
 {
 	struct z_heap *h = heap->heap;
 	void *mem;
 
+	ARG_UNUSED(call_site);
+
 	if ((bytes == 0U) || size_too_big(h, bytes)) {
 		return NULL;
 	}
@@ -290,26 +291,43 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
+	heap_listener_notify_alloc_at(HEAP_ID_FROM_POINTER(heap), mem,
+				      chunksz_to_bytes(h, chunk_size(h, c)),
+				      call_site);
 #endif
 
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	return heap_alloc(heap, bytes, Z_HEAP_CALL_SITE());
+}
+
 void *sys_heap_noalign_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 {
 	ARG_UNUSED(align);
 
-	return sys_heap_alloc(heap, bytes);
+	return heap_alloc(heap, bytes, Z_HEAP_CALL_SITE());
 }
 
-void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+void *z_sys_heap_noalign_alloc_at(struct sys_heap *heap, size_t align, size_t bytes,
+				  void *call_site)
+{
+	ARG_UNUSED(align);
+
+	return heap_alloc(heap, bytes, call_site);
+}
+
+static void *heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes,
+				void *call_site)
 {
 	struct z_heap *h = heap->heap;
 	size_t gap, rew;
 
+	ARG_UNUSED(call_site);
+
 	/*
 	 * Split align and rewind values (if any).
 	 * We allow for one bit of rewind in addition to the alignment
@@ -323,7 +341,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		gap = MIN(rew, chunk_header_bytes(h));
 	} else {
 		if (align <= chunk_header_bytes(h)) {
-			return sys_heap_alloc(heap, bytes);
+			return heap_alloc(heap, bytes, call_site);
 		}
 		rew = 0;
 		gap = chunk_header_bytes(h);
@@ -375,18 +393,33 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
+	heap_listener_notify_alloc_at(HEAP_ID_FROM_POINTER(heap), mem,
+				      chunksz_to_bytes(h, chunk_size(h, c)),
+				      call_site);
 #endif
 
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
-static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	return heap_aligned_alloc(heap, align, bytes, Z_HEAP_CALL_SITE());
+}
+
+void *z_sys_heap_aligned_alloc_at(struct sys_heap *heap, size_t align, size_t bytes,
+				  void *call_site)
+{
+	return heap_aligned_alloc(heap, align, bytes, call_site);
+}
+
+static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes,
+			    void *call_site)
 {
 	struct z_heap *h = heap->heap;
 
+	ARG_UNUSED(call_site);
+
 	if (size_too_big(h, bytes)) {
 		return false;
 	}
@@ -416,8 +449,9 @@ static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 		free_chunk(h, c + chunks_need);
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), ptr,
-					   chunksz_to_bytes(h, chunk_size(h, c)));
+		heap_listener_notify_alloc_at(HEAP_ID_FROM_POINTER(heap), ptr,
+					      chunksz_to_bytes(h, chunk_size(h, c)),
+					      call_site);
 		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), ptr,
 					  bytes_freed);
 #endif
@@ -451,8 +485,9 @@ static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 		set_chunk_used(h, c, true);
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), ptr,
-					   chunksz_to_bytes(h, chunk_size(h, c)));
+		heap_listener_notify_alloc_at(HEAP_ID_FROM_POINTER(heap), ptr,
+					      chunksz_to_bytes(h, chunk_size(h, c)),
+					      call_site);
 		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), ptr,
 					  bytes_freed);
 #endif
@@ -465,21 +500,23 @@ static bool inplace_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 
 void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 {
+	void *call_site = Z_HEAP_CALL_SITE();
+
 	/* special realloc semantics */
 	if (ptr == NULL) {
-		return sys_heap_alloc(heap, bytes);
+		return heap_alloc(heap, bytes, call_site);
 	}
 	if (bytes == 0) {
 		sys_heap_free(heap, ptr);
 		return NULL;
 	}
 
-	if (inplace_realloc(heap, ptr, bytes)) {
+	if (inplace_realloc(heap, ptr, bytes, call_site)) {
 		return ptr;
 	}
 
 	/* In-place realloc was not possible: fallback to allocate and copy. */
-	void *ptr2 = sys_heap_alloc(heap, bytes);
+	void *ptr2 = heap_alloc(heap, bytes, call_site);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = sys_heap_usable_size(heap, ptr);
@@ -492,10 +529,16 @@ void *sys_heap_realloc(struct sys_heap *heap, void *ptr, size_t bytes)
 
 void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 			       size_t align, size_t bytes)
+{
+	return z_sys_heap_aligned_realloc_at(heap, ptr, align, bytes, Z_HEAP_CALL_SITE());
+}
+
+void *z_sys_heap_aligned_realloc_at(struct sys_heap *heap, void *ptr, size_t align,
+				    size_t bytes, void *call_site)
 {
 	/* special realloc semantics */
 	if (ptr == NULL) {
-		return sys_heap_aligned_alloc(heap, align, bytes);
+		return heap_aligned_alloc(heap, align, bytes, call_site);
 	}
 	if (bytes == 0) {
 		sys_heap_free(heap, ptr);
@@ -505,7 +548,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	__ASSERT((align & (align - 1)) == 0, "align must be a power of 2");
 
 	if ((align == 0 || ((uintptr_t)ptr & (align - 1)) == 0) &&
-	    inplace_realloc(heap, ptr, bytes)) {
+	    inplace_realloc(heap, ptr, bytes, call_site)) {
 		return ptr;
 	}
 
@@ -513,7 +556,7 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	 * Either ptr is not sufficiently aligned for in-place realloc or
 	 * in-place realloc was not possible: fallback to allocate and copy.
 	 */
-	void *ptr2 = sys_heap_aligned_alloc(heap, align, bytes);
+	void *ptr2 = heap_aligned_alloc(heap, align, bytes, call_site);
 
 	if (ptr2 != NULL) {
 		size_t prev_size = sys_heap_usable_size(heap, ptr);
@@ -563,9 +606,15 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	sys_heap_array_save(heap);
 #endif
 
-	int nb_buckets = bucket_idx(h, heap_sz) + 1;
-	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+	int nb_buckets = heap_nb_buckets(h);
+	size_t chunk0_bytes = sizeof(struct z_heap) +
+			      nb_buckets * sizeof(struct z_heap_bucket);
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+	chunk0_bytes += avail_bitmap_bytes(nb_buckets);
+#endif
+
+	chunksz_t chunk0_size = chunksz(chunk0_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -573,6 +622,10 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+	(void)memset(avail_bitmap(h), 0, avail_bitmap_bytes(nb_buckets));
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
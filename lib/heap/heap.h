@@ -45,6 +45,14 @@
  * obviously.  This memory is part of the user's buffer when
  * allocated.
  *
+ * With CONFIG_SYS_HEAP_TLSF, each power-of-two category above the
+ * smallest ones is further split in 2^CONFIG_SYS_HEAP_TLSF_SL_LOG2
+ * linearly spaced sub-categories (the smallest sizes each get their
+ * own list), as in a Two-Level Segregated Fit allocator.  There are
+ * then too many lists for avail_buckets to have one bit for each, so
+ * a bitmap with one bit per list follows the bucket array, with
+ * avail_buckets flagging which of its 32-bit words are non-zero.
+ *
  * The field order is so that allocated buffers are immediately bounded
  * by SIZE_AND_USED of the current chunk at the bottom, and LEFT_SIZE of
  * the following chunk at the top. This ordering allows for quick buffer
@@ -247,10 +255,125 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+#ifdef CONFIG_SYS_HEAP_TLSF
+#define HEAP_SL_LOG2 CONFIG_SYS_HEAP_TLSF_SL_LOG2
+#define HEAP_SL_COUNT (1U << HEAP_SL_LOG2)
+#endif
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+#ifdef CONFIG_SYS_HEAP_TLSF
+	if (usable_sz < HEAP_SL_COUNT) {
+		return usable_sz - 1;
+	}
+
+	int shift = 31 - __builtin_clz(usable_sz) - HEAP_SL_LOG2;
+
+	return (HEAP_SL_COUNT - 1) + shift * HEAP_SL_COUNT +
+	       (usable_sz >> shift) - HEAP_SL_COUNT;
+#else
 	return 31 - __builtin_clz(usable_sz);
+#endif
+}
+
+/* Smallest chunk size that goes in a given bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	unsigned int usable_sz;
+#ifdef CONFIG_SYS_HEAP_TLSF
+	if (bidx < (int)HEAP_SL_COUNT - 1) {
+		usable_sz = bidx + 1;
+	} else {
+		unsigned int k = bidx - (HEAP_SL_COUNT - 1);
+
+		usable_sz = (HEAP_SL_COUNT + k % HEAP_SL_COUNT) << (k / HEAP_SL_COUNT);
+	}
+#else
+	usable_sz = 1U << bidx;
+#endif
+	return usable_sz + min_chunk_size(h) - 1;
+}
+
+static inline int heap_nb_buckets(struct z_heap *h)
+{
+	return bucket_idx(h, h->end_chunk) + 1;
+}
+
+#ifdef CONFIG_SYS_HEAP_TLSF
+static inline size_t avail_bitmap_bytes(int nb_buckets)
+{
+	return DIV_ROUND_UP(nb_buckets, 32) * sizeof(uint32_t);
+}
+
+static inline uint32_t *avail_bitmap(struct z_heap *h)
+{
+	return (uint32_t *)&h->buckets[heap_nb_buckets(h)];
+}
+#endif
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	return (avail_bitmap(h)[bidx / 32] & BIT(bidx % 32)) != 0U;
+#else
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+#endif
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	uint32_t *word = &avail_bitmap(h)[bidx / 32];
+
+	if (avail) {
+		*word |= BIT(bidx % 32);
+		h->avail_buckets |= BIT(bidx / 32);
+	} else {
+		*word &= ~BIT(bidx % 32);
+		if (*word == 0U) {
+			h->avail_buckets &= ~BIT(bidx / 32);
+		}
+	}
+#else
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+#endif
+}
+
+/* Smallest non-empty bucket above bidx, or -1 if there is none */
+static inline int next_avail_bucket(struct z_heap *h, int bidx)
+{
+#ifdef CONFIG_SYS_HEAP_TLSF
+	uint32_t *bitmap = avail_bitmap(h);
+	int next = bidx + 1;
+	int w = next / 32;
+	uint32_t mask;
+
+	if (next >= heap_nb_buckets(h)) {
+		return -1;
+	}
+
+	mask = bitmap[w] & ~BIT_MASK(next % 32);
+	if (mask != 0U) {
+		return w * 32 + __builtin_ctz(mask);
+	}
+
+	mask = (w < 31) ? (h->avail_buckets & ~BIT_MASK(w + 1)) : 0U;
+	if (mask == 0U) {
+		return -1;
+	}
+
+	w = __builtin_ctz(mask);
+	return w * 32 + __builtin_ctz(bitmap[w]);
+#else
+	uint32_t bmask = h->avail_buckets & ~BIT_MASK(bidx + 1);
+
+	return (bmask != 0U) ? __builtin_ctz(bmask) : -1;
+#endif
 }
 
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
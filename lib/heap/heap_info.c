@@ -13,7 +13,7 @@
  */
 static void heap_print_info(struct z_heap *h, bool dump_chunks)
 {
-	int i, nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+	int i, nb_buckets = heap_nb_buckets(h);
 	size_t free_bytes, allocated_bytes, total, overhead;
 
 	printk("Heap at %p contains %d units in %d buckets\n\n",
@@ -38,7 +38,7 @@ static void heap_print_info(struct z_heap *h, bool dump_chunks)
 		}
 		if (count) {
 			printk("%9d %12d %12d %12d %12zd\n",
-			       i, (1 << i) - 1 + min_chunk_size(h), count,
+			       i, bucket_min_size(h, i), count,
 			       largest, chunksz_to_bytes(h, largest));
 		}
 	}
@@ -28,22 +28,32 @@ void heap_listener_unregister(struct heap_listener *listener)
 	k_spin_unlock(&heap_listener_lock, key);
 }
 
-void heap_listener_notify_alloc(uintptr_t heap_id, void *mem, size_t bytes)
+void heap_listener_notify_alloc_at(uintptr_t heap_id, void *mem, size_t bytes,
+				   void *call_site)
 {
 	struct heap_listener *listener;
 	k_spinlock_key_t key = k_spin_lock(&heap_listener_lock);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&heap_listener_list, listener, node) {
-		if (listener->heap_id == heap_id
-		    && listener->alloc_cb != NULL
-		    && listener->event == HEAP_ALLOC) {
+		if (listener->heap_id != heap_id || listener->alloc_cb == NULL) {
+			continue;
+		}
+
+		if (listener->event == HEAP_ALLOC) {
 			listener->alloc_cb(heap_id, mem, bytes);
+		} else if (listener->event == HEAP_ALLOC_AT) {
+			listener->alloc_at_cb(heap_id, mem, bytes, call_site);
 		}
 	}
 
 	k_spin_unlock(&heap_listener_lock, key);
 }
 
+void heap_listener_notify_alloc(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	heap_listener_notify_alloc_at(heap_id, mem, bytes, NULL);
+}
+
 void heap_listener_notify_free(uintptr_t heap_id, void *mem, size_t bytes)
 {
 	struct heap_listener *listener;
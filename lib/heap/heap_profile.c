@@ -0,0 +1,379 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/heap_profile.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include "heap.h"
+
+/*
+ * Listener callbacks only get the heap identifier, so running profiles
+ * are looked up in a list.  One lock covers the list and all profile
+ * data: callbacks run with the heap listener lock held, and are thus
+ * serialized anyway.
+ *
+ * Callbacks also run with the lock of the heap owner held, which must
+ * thus never be taken under profile_lock.  Walking the list to dump the
+ * profiles needs the owner locks, so the list is also protected by a
+ * mutex held for the whole walk, and taken to add or remove profiles.
+ *
+ * Tracked blocks are found with a linear search, which bounds the extra
+ * cost of each heap operation by CONFIG_SYS_HEAP_PROFILE_BLOCKS.
+ */
+
+static struct k_spinlock profile_lock;
+static K_MUTEX_DEFINE(profile_list_mutex);
+static sys_slist_t profile_list = SYS_SLIST_STATIC_INIT(&profile_list);
+
+static struct sys_heap_profile *profile_find(uintptr_t heap_id)
+{
+	struct sys_heap_profile *profile;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&profile_list, profile, node) {
+		if (HEAP_ID_FROM_POINTER(profile->heap) == heap_id) {
+			return profile;
+		}
+	}
+
+	return NULL;
+}
+
+static struct z_heap_profile_block *block_find(struct sys_heap_profile *profile,
+					       void *mem, bool resized)
+{
+	for (int i = 0; i < ARRAY_SIZE(profile->blocks); i++) {
+		struct z_heap_profile_block *block = &profile->blocks[i];
+
+		if ((block->mem == mem) && (block->resized == resized)) {
+			return block;
+		}
+	}
+
+	return NULL;
+}
+
+/*
+ * Find the entry of a call site, or make room for it by recycling the
+ * least busy site that has no tracked block left.
+ */
+static int site_find(struct sys_heap_profile *profile, void *call_site)
+{
+	int victim = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(profile->sites); i++) {
+		struct sys_heap_profile_site *site = &profile->sites[i];
+
+		if ((site->call_site == call_site) && (site->allocs != 0U)) {
+			return i;
+		}
+
+		if ((site->live_bytes == 0U) &&
+		    ((victim < 0) || (site->allocs < profile->sites[victim].allocs))) {
+			victim = i;
+		}
+	}
+
+	if (victim >= 0) {
+		memset(&profile->sites[victim], 0, sizeof(profile->sites[victim]));
+		profile->sites[victim].call_site = call_site;
+	}
+
+	return victim;
+}
+
+static void profile_alloc(uintptr_t heap_id, void *mem, size_t bytes, void *call_site)
+{
+	k_spinlock_key_t key = k_spin_lock(&profile_lock);
+	struct sys_heap_profile *profile = profile_find(heap_id);
+	struct z_heap_profile_block *block;
+	unsigned int bucket;
+	bool resized;
+	int site;
+
+	if (profile == NULL) {
+		goto out;
+	}
+
+	bucket = (uint32_t)MIN(bytes, UINT32_MAX);
+	bucket = (bucket < 2U) ? 0U : (31U - u32_count_leading_zeros(bucket));
+	profile->size_hist[MIN(bucket, ARRAY_SIZE(profile->size_hist) - 1U)]++;
+
+	/*
+	 * In place reallocations report the new block before freeing the
+	 * old one, at the same address: tell them apart until then.
+	 */
+	resized = (block_find(profile, mem, false) != NULL);
+
+	block = block_find(profile, NULL, false);
+	site = (block != NULL) ? site_find(profile, call_site) : -1;
+	if (site < 0) {
+		profile->untracked++;
+		goto out;
+	}
+
+	profile->sites[site].allocs++;
+	profile->sites[site].total_bytes += bytes;
+	profile->sites[site].live_bytes += bytes;
+
+	block->mem = mem;
+	block->bytes = bytes;
+	block->stamp = k_uptime_get_32();
+	block->site = site;
+	block->resized = resized;
+
+out:
+	k_spin_unlock(&profile_lock, key);
+}
+
+static void profile_free(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&profile_lock);
+	struct sys_heap_profile *profile = profile_find(heap_id);
+	struct z_heap_profile_block *block;
+	struct sys_heap_profile_site *site;
+
+	ARG_UNUSED(bytes);
+
+	if (profile == NULL) {
+		goto out;
+	}
+
+	block = block_find(profile, mem, false);
+	if (block != NULL) {
+		site = &profile->sites[block->site];
+		site->frees++;
+		site->live_bytes -= block->bytes;
+		site->lifetime_ms += k_uptime_get_32() - block->stamp;
+		memset(block, 0, sizeof(*block));
+	}
+
+	block = block_find(profile, mem, true);
+	if (block != NULL) {
+		block->resized = false;
+	}
+
+out:
+	k_spin_unlock(&profile_lock, key);
+}
+
+int sys_heap_profile_start(struct sys_heap_profile *profile, struct sys_heap *heap,
+			   struct k_spinlock *lock)
+{
+	k_spinlock_key_t key;
+
+	k_mutex_lock(&profile_list_mutex, K_FOREVER);
+	key = k_spin_lock(&profile_lock);
+
+	if (sys_slist_find(&profile_list, &profile->node, NULL) ||
+	    (profile_find(HEAP_ID_FROM_POINTER(heap)) != NULL)) {
+		k_spin_unlock(&profile_lock, key);
+		k_mutex_unlock(&profile_list_mutex);
+		return -EBUSY;
+	}
+
+	memset(profile, 0, sizeof(*profile));
+	profile->heap = heap;
+	profile->lock = lock;
+	profile->alloc_listener.heap_id = HEAP_ID_FROM_POINTER(heap);
+	profile->alloc_listener.event = HEAP_ALLOC_AT;
+	profile->alloc_listener.alloc_at_cb = profile_alloc;
+	profile->free_listener.heap_id = HEAP_ID_FROM_POINTER(heap);
+	profile->free_listener.event = HEAP_FREE;
+	profile->free_listener.free_cb = profile_free;
+	sys_slist_append(&profile_list, &profile->node);
+
+	k_spin_unlock(&profile_lock, key);
+
+	heap_listener_register(&profile->alloc_listener);
+	heap_listener_register(&profile->free_listener);
+
+	k_mutex_unlock(&profile_list_mutex);
+
+	return 0;
+}
+
+void sys_heap_profile_stop(struct sys_heap_profile *profile)
+{
+	k_mutex_lock(&profile_list_mutex, K_FOREVER);
+
+	heap_listener_unregister(&profile->alloc_listener);
+	heap_listener_unregister(&profile->free_listener);
+
+	K_SPINLOCK(&profile_lock) {
+		sys_slist_find_and_remove(&profile_list, &profile->node);
+	}
+
+	k_mutex_unlock(&profile_list_mutex);
+}
+
+void sys_heap_profile_reset(struct sys_heap_profile *profile)
+{
+	K_SPINLOCK(&profile_lock) {
+		memset(profile->size_hist, 0, sizeof(profile->size_hist));
+		memset(profile->sites, 0, sizeof(profile->sites));
+		memset(profile->blocks, 0, sizeof(profile->blocks));
+		profile->untracked = 0U;
+	}
+}
+
+int sys_heap_profile_site_get(struct sys_heap_profile *profile, unsigned int idx,
+			      struct sys_heap_profile_site *site)
+{
+	int ret = -ENOENT;
+
+	K_SPINLOCK(&profile_lock) {
+		if ((idx < ARRAY_SIZE(profile->sites)) && (profile->sites[idx].allocs != 0U)) {
+			*site = profile->sites[idx];
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+unsigned int sys_heap_fragmentation(struct sys_heap *heap, size_t *free_bytes,
+				    size_t *largest_free)
+{
+	struct z_heap *h = heap->heap;
+	size_t total = 0U;
+	size_t largest = 0U;
+
+	for (int b = 0; b < heap_nb_buckets(h); b++) {
+		chunkid_t first = h->buckets[b].next;
+		chunkid_t c = first;
+
+		if (first == 0U) {
+			continue;
+		}
+
+		do {
+			size_t sz = chunksz_to_bytes(h, chunk_size(h, c));
+
+			total += sz;
+			largest = MAX(largest, sz);
+			c = next_free_chunk(h, c);
+		} while (c != first);
+	}
+
+	if (free_bytes != NULL) {
+		*free_bytes = total;
+	}
+	if (largest_free != NULL) {
+		*largest_free = largest;
+	}
+
+	return (total == 0U) ? 0U : (unsigned int)(1000U - ((uint64_t)largest * 1000U) / total);
+}
+
+static void dump_printf(sys_heap_profile_print_t print, void *ctx, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	print(ctx, fmt, ap);
+	va_end(ap);
+}
+
+void sys_heap_profile_dump(struct sys_heap_profile *profile,
+			   sys_heap_profile_print_t print, void *ctx)
+{
+	struct sys_heap_profile_site sites[CONFIG_SYS_HEAP_PROFILE_SITES];
+	uint32_t size_hist[CONFIG_SYS_HEAP_PROFILE_SIZE_BUCKETS];
+	struct k_spinlock *lock;
+	struct sys_heap *heap;
+	uint32_t untracked;
+	size_t free_bytes, largest_free;
+	unsigned int frag;
+
+	K_SPINLOCK(&profile_lock) {
+		memcpy(sites, profile->sites, sizeof(sites));
+		memcpy(size_hist, profile->size_hist, sizeof(size_hist));
+		untracked = profile->untracked;
+		heap = profile->heap;
+		lock = profile->lock;
+	}
+
+	/* Not under profile_lock, see the top of the file */
+	if (lock != NULL) {
+		k_spinlock_key_t key = k_spin_lock(lock);
+
+		frag = sys_heap_fragmentation(heap, &free_bytes, &largest_free);
+		k_spin_unlock(lock, key);
+	} else {
+		frag = sys_heap_fragmentation(heap, &free_bytes, &largest_free);
+	}
+	dump_printf(print, ctx, "heap %p: %zu bytes free, largest %zu, fragmentation %u/1000\n",
+		    heap, free_bytes, largest_free, frag);
+
+	dump_printf(print, ctx, "size classes (bytes >= 2^n):");
+	for (int i = 0; i < ARRAY_SIZE(size_hist); i++) {
+		dump_printf(print, ctx, " %u", size_hist[i]);
+	}
+	dump_printf(print, ctx, "\nuntracked allocations: %u\n", untracked);
+
+	dump_printf(print, ctx, "%-12s %10s %10s %12s %10s %12s\n",
+		    "call site", "allocs", "frees", "bytes", "live", "avg life ms");
+
+	/* Busiest first, sorting the snapshot in place */
+	for (int i = 0; i < ARRAY_SIZE(sites); i++) {
+		int best = i;
+
+		for (int j = i + 1; j < ARRAY_SIZE(sites); j++) {
+			if (sites[j].allocs > sites[best].allocs) {
+				best = j;
+			}
+		}
+
+		if (sites[best].allocs == 0U) {
+			break;
+		}
+
+		struct sys_heap_profile_site site = sites[best];
+
+		sites[best] = sites[i];
+		sites[i] = site;
+
+		dump_printf(print, ctx, "%-12p %10u %10u %12llu %10zu %12llu\n",
+			    site.call_site, site.allocs, site.frees,
+			    (unsigned long long)site.total_bytes, site.live_bytes,
+			    (site.frees != 0U) ?
+				(unsigned long long)(site.lifetime_ms / site.frees) : 0ULL);
+	}
+}
+
+static void console_print(void *ctx, const char *fmt, va_list ap)
+{
+	ARG_UNUSED(ctx);
+
+	vprintk(fmt, ap);
+}
+
+void sys_heap_profile_print(struct sys_heap_profile *profile)
+{
+	sys_heap_profile_dump(profile, console_print, NULL);
+}
+
+void sys_heap_profile_foreach(sys_heap_profile_cb_t cb, void *user_data)
+{
+	struct sys_heap_profile *profile;
+
+	/*
+	 * The callback is likely to dump the profile, which takes the locks
+	 * itself, so only the list mutex is held.
+	 */
+	k_mutex_lock(&profile_list_mutex, K_FOREVER);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&profile_list, profile, node) {
+		cb(profile, user_data);
+	}
+
+	k_mutex_unlock(&profile_list_mutex);
+}
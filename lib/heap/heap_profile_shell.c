@@ -0,0 +1,55 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/heap_profile.h>
+
+static void shell_profile_print(void *ctx, const char *fmt, va_list ap)
+{
+	shell_vfprintf(ctx, SHELL_NORMAL, fmt, ap);
+}
+
+static void dump_profile(struct sys_heap_profile *profile, void *user_data)
+{
+	sys_heap_profile_dump(profile, shell_profile_print, user_data);
+	shell_print((const struct shell *)user_data, "");
+}
+
+static void reset_profile(struct sys_heap_profile *profile, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	sys_heap_profile_reset(profile);
+}
+
+static int cmd_heap_profile(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sys_heap_profile_foreach(dump_profile, (void *)sh);
+
+	return 0;
+}
+
+static int cmd_heap_profile_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sys_heap_profile_foreach(reset_profile, NULL);
+	shell_print(sh, "Heap profiles reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_heap_profile,
+	SHELL_CMD(reset, NULL, "Reset all running profiles.", cmd_heap_profile_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(heap_profile, &sub_heap_profile,
+		   "Dump the running heap allocation profiles.", cmd_heap_profile);
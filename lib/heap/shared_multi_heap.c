@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/multi_heap.h>
 
@@ -13,15 +16,63 @@
 
 static struct sys_multi_heap shared_multi_heap;
 
+/*
+ * Each region has its own lock, so that allocations from different
+ * regions (or attributes) never contend.
+ */
+struct smh_region {
+	struct sys_heap heap;
+	struct k_spinlock lock;
+	uint32_t rank;
+#ifdef CONFIG_SHARED_MULTI_HEAP_STATS
+	unsigned long alloc_cnt;
+	unsigned long fail_cnt;
+	unsigned long spill_cnt;
+#endif /* CONFIG_SHARED_MULTI_HEAP_STATS */
+};
+
 static struct {
-	struct sys_heap heap_pool[MAX_MULTI_HEAPS];
+	struct smh_region *heap_pool[MAX_MULTI_HEAPS];
 	unsigned int heap_cnt;
+	/* Attribute to fall back to when all regions are full */
+	unsigned int spill;
 } smh_data[MAX_SHARED_MULTI_HEAP_ATTR];
 
+static struct smh_region smh_regions[MAX_MULTI_HEAPS];
+static unsigned int smh_region_cnt;
+
+/* Serializes region additions and spill configuration */
+static struct k_spinlock smh_lock;
+
+static void *smh_region_alloc(struct smh_region *r, size_t align, size_t size, bool spilled)
+{
+	k_spinlock_key_t key = k_spin_lock(&r->lock);
+	void *block = sys_heap_aligned_alloc(&r->heap, align, size);
+
+#ifdef CONFIG_SHARED_MULTI_HEAP_STATS
+	if (block == NULL) {
+		r->fail_cnt++;
+	} else {
+		r->alloc_cnt++;
+		if (spilled) {
+			r->spill_cnt++;
+		}
+	}
+#else
+	ARG_UNUSED(spilled);
+#endif /* CONFIG_SHARED_MULTI_HEAP_STATS */
+
+	k_spin_unlock(&r->lock, key);
+
+	return block;
+}
+
 static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, size_t size)
 {
-	struct sys_heap *h;
+	struct smh_region *pool[MAX_MULTI_HEAPS];
 	enum shared_multi_heap_attr attr;
+	unsigned int heap_cnt;
+	k_spinlock_key_t key;
 	void *block;
 
 	attr = (enum shared_multi_heap_attr)(long) cfg;
@@ -33,15 +84,30 @@ static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, s
 	/* Set in case the user requested a non-existing attr */
 	block = NULL;
 
-	for (size_t hdx = 0; hdx < smh_data[attr].heap_cnt; hdx++) {
-		h = &smh_data[attr].heap_pool[hdx];
+	/*
+	 * Regions of the requested attribute are tried in rank order, then
+	 * those of its spill attributes. The chain is bounded in case it
+	 * loops.
+	 *
+	 * The pool of an attribute is reordered by shared_multi_heap_add(),
+	 * so it is copied under smh_lock. Regions are never removed, the
+	 * allocations themselves only take the lock of their region.
+	 */
+	for (unsigned int hop = 0; hop < MAX_SHARED_MULTI_HEAP_ATTR; hop++) {
+		key = k_spin_lock(&smh_lock);
+		heap_cnt = smh_data[attr].heap_cnt;
+		memcpy(pool, smh_data[attr].heap_pool, heap_cnt * sizeof(pool[0]));
+		attr = smh_data[attr].spill;
+		k_spin_unlock(&smh_lock, key);
 
-		if (h->heap == NULL) {
-			return NULL;
+		for (size_t hdx = 0; hdx < heap_cnt; hdx++) {
+			block = smh_region_alloc(pool[hdx], align, size, hop != 0);
+			if (block != NULL) {
+				return block;
+			}
 		}
 
-		block = sys_heap_aligned_alloc(h, align, size);
-		if (block != NULL) {
+		if (attr >= MAX_SHARED_MULTI_HEAP_ATTR) {
 			break;
 		}
 	}
@@ -52,7 +118,8 @@ static void *smh_choice(struct sys_multi_heap *mheap, void *cfg, size_t align, s
 int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_data)
 {
 	enum shared_multi_heap_attr attr;
-	struct sys_heap *h;
+	struct smh_region *r;
+	k_spinlock_key_t key;
 	unsigned int slot;
 
 	attr = region->attr;
@@ -61,25 +128,69 @@ int shared_multi_heap_add(struct shared_multi_heap_region *region, void *user_da
 		return -EINVAL;
 	}
 
+	key = k_spin_lock(&smh_lock);
+
 	/* No more heaps available */
-	if (smh_data[attr].heap_cnt >= MAX_MULTI_HEAPS) {
+	if (smh_data[attr].heap_cnt >= MAX_MULTI_HEAPS ||
+	    smh_region_cnt >= ARRAY_SIZE(smh_regions)) {
+		k_spin_unlock(&smh_lock, key);
 		return -ENOMEM;
 	}
 
-	slot = smh_data[attr].heap_cnt;
-	h = &smh_data[attr].heap_pool[slot];
+	r = &smh_regions[smh_region_cnt++];
+	r->rank = region->rank;
+
+	sys_heap_init(&r->heap, (void *) region->addr, region->size);
+	sys_multi_heap_add_heap(&shared_multi_heap, &r->heap, user_data);
 
-	sys_heap_init(h, (void *) region->addr, region->size);
-	sys_multi_heap_add_heap(&shared_multi_heap, h, user_data);
+	/* Keep the regions of the attribute sorted by rank, stable */
+	slot = smh_data[attr].heap_cnt;
+	while (slot > 0 && smh_data[attr].heap_pool[slot - 1]->rank > r->rank) {
+		smh_data[attr].heap_pool[slot] = smh_data[attr].heap_pool[slot - 1];
+		slot--;
+	}
+	smh_data[attr].heap_pool[slot] = r;
 
 	smh_data[attr].heap_cnt++;
 
+	k_spin_unlock(&smh_lock, key);
+
+	return 0;
+}
+
+int shared_multi_heap_spill_set(enum shared_multi_heap_attr attr,
+				enum shared_multi_heap_attr spill)
+{
+	k_spinlock_key_t key;
+
+	if (attr >= MAX_SHARED_MULTI_HEAP_ATTR || attr == spill ||
+	    spill > MAX_SHARED_MULTI_HEAP_ATTR) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&smh_lock);
+	smh_data[attr].spill = spill;
+	k_spin_unlock(&smh_lock, key);
+
 	return 0;
 }
 
 void shared_multi_heap_free(void *block)
 {
-	sys_multi_heap_free(&shared_multi_heap, block);
+	const struct sys_multi_heap_rec *rec;
+	struct smh_region *r;
+	k_spinlock_key_t key;
+
+	if (block == NULL) {
+		return;
+	}
+
+	rec = sys_multi_heap_get_heap(&shared_multi_heap, block);
+	r = CONTAINER_OF(rec->heap, struct smh_region, heap);
+
+	key = k_spin_lock(&r->lock);
+	sys_heap_free(&r->heap, block);
+	k_spin_unlock(&r->lock, key);
 }
 
 void *shared_multi_heap_alloc(enum shared_multi_heap_attr attr, size_t bytes)
@@ -102,6 +213,34 @@ void *shared_multi_heap_aligned_alloc(enum shared_multi_heap_attr attr,
 					    align, bytes);
 }
 
+#ifdef CONFIG_SHARED_MULTI_HEAP_STATS
+int shared_multi_heap_stats_get(enum shared_multi_heap_attr attr, unsigned int idx,
+				struct shared_multi_heap_stats *stats)
+{
+	struct smh_region *r;
+	k_spinlock_key_t key;
+
+	if (attr >= MAX_SHARED_MULTI_HEAP_ATTR || stats == NULL) {
+		return -EINVAL;
+	}
+
+	if (idx >= smh_data[attr].heap_cnt) {
+		return -ENOENT;
+	}
+
+	r = smh_data[attr].heap_pool[idx];
+
+	key = k_spin_lock(&r->lock);
+	(void)sys_heap_runtime_stats_get(&r->heap, &stats->heap);
+	stats->alloc_cnt = r->alloc_cnt;
+	stats->fail_cnt = r->fail_cnt;
+	stats->spill_cnt = r->spill_cnt;
+	k_spin_unlock(&r->lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SHARED_MULTI_HEAP_STATS */
+
 int shared_multi_heap_pool_init(void)
 {
 	static atomic_t state;
@@ -112,6 +251,10 @@ int shared_multi_heap_pool_init(void)
 
 	sys_multi_heap_init(&shared_multi_heap, smh_choice);
 
+	for (unsigned int attr = 0; attr < MAX_SHARED_MULTI_HEAP_ATTR; attr++) {
+		smh_data[attr].spill = MAX_SHARED_MULTI_HEAP_ATTR;
+	}
+
 	atomic_set(&state, 1);
 
 	return 0;
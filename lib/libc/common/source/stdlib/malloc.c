@@ -137,13 +137,13 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
-void *malloc(size_t size)
+static void *malloc_at(size_t alignment, size_t size, void *call_site)
 {
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	void *ret = z_sys_heap_aligned_alloc_at(&z_malloc_heap,
+						alignment,
+						size, call_site);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -153,20 +153,14 @@ void *malloc(size_t size)
 	return ret;
 }
 
-void *aligned_alloc(size_t alignment, size_t size)
+void *malloc(size_t size)
 {
-	malloc_lock();
-
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
-	if (ret == NULL && size != 0) {
-		errno = ENOMEM;
-	}
-
-	malloc_unlock();
+	return malloc_at(__alignof__(z_max_align_t), size, Z_HEAP_CALL_SITE());
+}
 
-	return ret;
+void *aligned_alloc(size_t alignment, size_t size)
+{
+	return malloc_at(alignment, size, Z_HEAP_CALL_SITE());
 }
 
 #ifdef CONFIG_GLIBCXX_LIBCPP
@@ -186,7 +180,7 @@ void *aligned_alloc(size_t alignment, size_t size)
 
 void *memalign(size_t alignment, size_t size)
 {
-	return aligned_alloc(alignment, size);
+	return malloc_at(alignment, size, Z_HEAP_CALL_SITE());
 }
 #endif
 
@@ -238,13 +232,13 @@ static int malloc_prepare(void)
 	return 0;
 }
 
-void *realloc(void *ptr, size_t requested_size)
+static void *realloc_at(void *ptr, size_t requested_size, void *call_site)
 {
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
-					     __alignof__(z_max_align_t),
-					     requested_size);
+	void *ret = z_sys_heap_aligned_realloc_at(&z_malloc_heap, ptr,
+						  __alignof__(z_max_align_t),
+						  requested_size, call_site);
 
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
@@ -255,6 +249,11 @@ void *realloc(void *ptr, size_t requested_size)
 	return ret;
 }
 
+void *realloc(void *ptr, size_t requested_size)
+{
+	return realloc_at(ptr, requested_size, Z_HEAP_CALL_SITE());
+}
+
 void free(void *ptr)
 {
 	malloc_lock();
@@ -264,9 +263,11 @@ void free(void *ptr)
 
 SYS_INIT(malloc_prepare, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_LIBC);
 #else /* No malloc arena */
-void *malloc(size_t size)
+static void *malloc_at(size_t alignment, size_t size, void *call_site)
 {
+	ARG_UNUSED(alignment);
 	ARG_UNUSED(size);
+	ARG_UNUSED(call_site);
 
 	LOG_ERR("CONFIG_COMMON_LIBC_MALLOC_ARENA_SIZE is 0");
 	errno = ENOMEM;
@@ -274,6 +275,17 @@ void *malloc(size_t size)
 	return NULL;
 }
 
+static void *realloc_at(void *ptr, size_t size, void *call_site)
+{
+	ARG_UNUSED(ptr);
+	return malloc_at(0, size, call_site);
+}
+
+void *malloc(size_t size)
+{
+	return malloc_at(0, size, NULL);
+}
+
 void free(void *ptr)
 {
 	ARG_UNUSED(ptr);
@@ -281,8 +293,7 @@ void free(void *ptr)
 
 void *realloc(void *ptr, size_t size)
 {
-	ARG_UNUSED(ptr);
-	return malloc(size);
+	return realloc_at(ptr, size, NULL);
 }
 #endif /* else no malloc arena */
 
@@ -298,7 +309,7 @@ void *calloc(size_t nmemb, size_t size)
 		return NULL;
 	}
 
-	ret = malloc(size);
+	ret = malloc_at(__alignof__(z_max_align_t), size, Z_HEAP_CALL_SITE());
 
 	if (ret != NULL) {
 		(void)memset(ret, 0, size);
@@ -315,6 +326,6 @@ void *reallocarray(void *ptr, size_t nmemb, size_t size)
 		errno = ENOMEM;
 		return NULL;
 	}
-	return realloc(ptr, size);
+	return realloc_at(ptr, size, Z_HEAP_CALL_SITE());
 }
 #endif /* CONFIG_COMMON_LIBC_REALLOCARRAY */
@@ -10,6 +10,25 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+/* Byte value 0x01 and 0x80 in each byte of a word */
+#define MEM_WORD_ONES  ((mem_word_t)-1 / 0xff)
+#define MEM_WORD_HIGHS (MEM_WORD_ONES << 7)
+
+/* Non-zero when any byte of the word is zero */
+#define MEM_WORD_HAS_ZERO(w) (((w) - MEM_WORD_ONES) & ~(w) & MEM_WORD_HIGHS)
+#endif
+
+/*
+ * For functions loading whole words that may extend past the end of the
+ * object, which the address sanitizer would report.
+ */
+#if defined(CONFIG_ASAN) && !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+#define MEM_WORD_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define MEM_WORD_NO_ASAN
+#endif
+
 /**
  *
  * @brief Copy a string
@@ -104,16 +123,37 @@ char *strrchr(const char *s, int c)
  * @return number of bytes in string <s>
  */
 
+MEM_WORD_NO_ASAN
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *p = s;
 
-	while (*s != '\0') {
-		s++;
-		n++;
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	while (((uintptr_t)p) & mask) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
 	}
 
-	return n;
+	/* aligned word loads never cross into a page the string is not in */
+
+	const mem_word_t *w = (const mem_word_t *)p;
+
+	while (!MEM_WORD_HAS_ZERO(*w)) {
+		w++;
+	}
+
+	p = (const char *)w;
+#endif
+
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
 }
 
 /**
@@ -222,6 +262,26 @@ int memcmp(const void *m1, const void *m2, size_t n)
 	const char *c1 = m1;
 	const char *c2 = m2;
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	const uintptr_t mask = sizeof(mem_word_t) - 1;
+
+	/* skip identical words, the bytes of the first differing one are compared below */
+
+	if (((((uintptr_t)c1) | ((uintptr_t)c2)) & mask) == 0) {
+		const mem_word_t *w1 = (const mem_word_t *)c1;
+		const mem_word_t *w2 = (const mem_word_t *)c2;
+
+		while ((n >= sizeof(mem_word_t)) && (*w1 == *w2)) {
+			w1++;
+			w2++;
+			n -= sizeof(mem_word_t);
+		}
+
+		c1 = (const char *)w1;
+		c2 = (const char *)w2;
+	}
+#endif
+
 	if (!n) {
 		return 0;
 	}
@@ -303,6 +363,21 @@ void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 		mem_word_t *d_word = (mem_word_t *)d_byte;
 		const mem_word_t *s_word = (const mem_word_t *)s_byte;
 
+		while (n >= 4 * sizeof(mem_word_t)) {
+			mem_word_t w0 = s_word[0];
+			mem_word_t w1 = s_word[1];
+			mem_word_t w2 = s_word[2];
+			mem_word_t w3 = s_word[3];
+
+			d_word[0] = w0;
+			d_word[1] = w1;
+			d_word[2] = w2;
+			d_word[3] = w3;
+			d_word += 4;
+			s_word += 4;
+			n -= 4 * sizeof(mem_word_t);
+		}
+
 		while (n >= sizeof(mem_word_t)) {
 			*(d_word++) = *(s_word++);
 			n -= sizeof(mem_word_t);
@@ -357,6 +432,15 @@ void *memset(void *buf, int c, size_t n)
 	c_word |= c_word << 32;
 #endif
 
+	while (n >= 4 * sizeof(mem_word_t)) {
+		d_word[0] = c_word;
+		d_word[1] = c_word;
+		d_word[2] = c_word;
+		d_word[3] = c_word;
+		d_word += 4;
+		n -= 4 * sizeof(mem_word_t);
+	}
+
 	while (n >= sizeof(mem_word_t)) {
 		*(d_word++) = c_word;
 		n -= sizeof(mem_word_t);
@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include <errno.h>
 #include <stddef.h>
 #include <string.h>
+#include <zephyr/sys/arena.h>
 #include <zephyr/sys/byteorder.h>
 
 #include <zephyr/net_buf.h>
@@ -166,6 +167,36 @@ const struct net_buf_data_cb net_buf_fixed_cb = {
 	.unref = fixed_data_unref,
 };
 
+#ifdef CONFIG_SYS_ARENA
+static uint8_t *arena_data_alloc(struct net_buf *buf, size_t *size,
+				 k_timeout_t timeout)
+{
+	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	struct sys_arena *arena = pool->alloc->alloc_data;
+
+	ARG_UNUSED(timeout);
+
+	return sys_arena_alloc(arena, *size);
+}
+
+static uint8_t *arena_data_ref(struct net_buf *buf, uint8_t *data)
+{
+	/* Arena memory lives until the arena is reset */
+	return data;
+}
+
+static void arena_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	/* Arena memory is only freed in bulk */
+}
+
+const struct net_buf_data_cb net_buf_arena_cb = {
+	.alloc = arena_data_alloc,
+	.ref   = arena_data_ref,
+	.unref = arena_data_unref,
+};
+#endif /* CONFIG_SYS_ARENA */
+
 #if (K_HEAP_MEM_POOL_SIZE > 0)
 
 static uint8_t *heap_data_alloc(struct net_buf *buf, size_t *size,
@@ -222,6 +253,140 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+/*
+ * Fixed size pools keep some free buffers in per-CPU arrays of slots,
+ * which are taken and given back with a compare and swap instead of a
+ * round trip through the free LIFO.  Fixed data needs no lock either, so
+ * these buffers are recycled without taking any.  Slots are only CPU
+ * local for the sake of locality: other CPUs may empty them, e.g. when
+ * the free LIFO is empty.
+ *
+ * A thread about to block on the free LIFO bumps cache_waiters and then
+ * flushes all the caches, while buffers are only kept in a cache if it
+ * is still zero after storing them.  One side thus always sees the
+ * other, and no buffer is left in a cache while a thread waits for one.
+ */
+static inline bool pool_cache_enabled(struct net_buf_pool *pool)
+{
+	return pool->alloc->cb == &net_buf_fixed_cb;
+}
+
+static inline unsigned int pool_cache_cpu(void)
+{
+	return IS_ENABLED(CONFIG_SMP) ? arch_curr_cpu()->id : 0U;
+}
+
+static struct net_buf *pool_cache_get(struct net_buf_pool *pool, bool any_cpu)
+{
+	unsigned int cpu = pool_cache_cpu();
+	unsigned int nb_cpus = any_cpu ? CONFIG_MP_MAX_NUM_CPUS : 1U;
+
+	for (unsigned int i = 0U; i < nb_cpus; i++) {
+		atomic_ptr_t *slots = pool->cache[(cpu + i) % CONFIG_MP_MAX_NUM_CPUS];
+
+		for (int j = CONFIG_NET_BUF_POOL_CACHE_SIZE - 1; j >= 0; j--) {
+			struct net_buf *buf = atomic_ptr_get(&slots[j]);
+
+			if ((buf != NULL) && atomic_ptr_cas(&slots[j], buf, NULL)) {
+				return buf;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+bool net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	atomic_ptr_t *slots;
+
+	if (!pool_cache_enabled(pool) || (atomic_get(&pool->cache_waiters) != 0)) {
+		return false;
+	}
+
+	slots = pool->cache[pool_cache_cpu()];
+
+	for (int i = 0; i < CONFIG_NET_BUF_POOL_CACHE_SIZE; i++) {
+		if (!atomic_ptr_cas(&slots[i], NULL, buf)) {
+			continue;
+		}
+
+		/* Take it back if a thread started waiting meanwhile */
+		if ((atomic_get(&pool->cache_waiters) != 0) &&
+		    atomic_ptr_cas(&slots[i], buf, NULL)) {
+			return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+static bool pool_cache_wait_begin(struct net_buf_pool *pool, k_timeout_t timeout)
+{
+	struct net_buf *buf;
+
+	if (!pool_cache_enabled(pool) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return false;
+	}
+
+	atomic_inc(&pool->cache_waiters);
+
+	while ((buf = pool_cache_get(pool, true)) != NULL) {
+		k_lifo_put(&pool->free, buf);
+	}
+
+	return true;
+}
+
+static void pool_cache_wait_end(struct net_buf_pool *pool, bool waiting)
+{
+	if (waiting) {
+		atomic_dec(&pool->cache_waiters);
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
+static struct net_buf *buf_setup(struct net_buf_pool *pool, struct net_buf *buf,
+				 size_t size, k_timepoint_t end)
+{
+	NET_BUF_DBG("allocated buf %p", buf);
+
+	if (size) {
+#if __ASSERT_ON
+		size_t req_size = size;
+#endif
+		buf->__buf = data_alloc(buf, &size, sys_timepoint_timeout(end));
+		if (!buf->__buf) {
+			net_buf_destroy(buf);
+			return NULL;
+		}
+
+#if __ASSERT_ON
+		NET_BUF_ASSERT(req_size <= size);
+#endif
+	} else {
+		buf->__buf = NULL;
+	}
+
+	buf->ref   = 1U;
+	buf->flags = 0U;
+	buf->frags = NULL;
+	buf->size  = size;
+	memset(buf->user_data, 0, buf->user_data_size);
+	net_buf_reset(buf);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_dec(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
+	pool->max_used = MAX(pool->max_used,
+			     pool->buf_count - atomic_get(&pool->avail_count));
+#endif
+	return buf;
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -234,11 +399,23 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	struct net_buf *buf;
 	k_spinlock_key_t key;
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	bool waiting;
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
 
 	__ASSERT_NO_MSG(pool);
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	if (pool_cache_enabled(pool)) {
+		buf = pool_cache_get(pool, false);
+		if (buf) {
+			goto success;
+		}
+	}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -271,6 +448,18 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	k_spin_unlock(&pool->lock, key);
 
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	/* Other CPUs may have cached the last free buffers */
+	if (pool_cache_enabled(pool)) {
+		buf = pool_cache_get(pool, true);
+		if (buf) {
+			goto success;
+		}
+	}
+
+	waiting = pool_cache_wait_begin(pool, timeout);
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+
 #if defined(CONFIG_NET_BUF_LOG) && (CONFIG_NET_BUF_LOG_LEVEL >= LOG_LEVEL_WRN)
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		uint32_t ref = k_uptime_get_32();
@@ -300,48 +489,81 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 #else
 	buf = k_lifo_get(&pool->free, timeout);
 #endif
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	pool_cache_wait_end(pool, waiting);
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
 		return NULL;
 	}
 
 success:
-	NET_BUF_DBG("allocated buf %p", buf);
+	buf = buf_setup(pool, buf, size, end);
+	if (!buf) {
+		NET_BUF_ERR("%s():%d: Failed to allocate data", func, line);
+	}
 
-	if (size) {
-#if __ASSERT_ON
-		size_t req_size = size;
-#endif
-		timeout = sys_timepoint_timeout(end);
-		buf->__buf = data_alloc(buf, &size, timeout);
-		if (!buf->__buf) {
-			NET_BUF_ERR("%s():%d: Failed to allocate data",
-				    func, line);
-			net_buf_destroy(buf);
-			return NULL;
+	return buf;
+}
+
+int net_buf_alloc_bulk(struct net_buf_pool *pool, size_t size,
+		       struct net_buf **bufs, int count)
+{
+	k_timepoint_t end = sys_timepoint_calc(K_NO_WAIT);
+	k_spinlock_key_t key;
+	uint16_t uninit_count;
+	int claimed, n = 0;
+
+	__ASSERT_NO_MSG(pool);
+
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+	while (pool_cache_enabled(pool) && (n < count)) {
+		bufs[n] = pool_cache_get(pool, false);
+		if (!bufs[n]) {
+			break;
 		}
+		n++;
+	}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
 
-#if __ASSERT_ON
-		NET_BUF_ASSERT(req_size <= size);
-#endif
-	} else {
-		buf->__buf = NULL;
+	/* Claim all the uninitialized buffers needed at once */
+	key = k_spin_lock(&pool->lock);
+	uninit_count = pool->uninit_count;
+	claimed = MIN(count - n, uninit_count);
+	pool->uninit_count -= claimed;
+	k_spin_unlock(&pool->lock, key);
+
+	for (int i = 0; i < claimed; i++) {
+		bufs[n++] = pool_get_uninit(pool, uninit_count - i);
 	}
 
-	buf->ref   = 1U;
-	buf->flags = 0U;
-	buf->frags = NULL;
-	buf->size  = size;
-	memset(buf->user_data, 0, buf->user_data_size);
-	net_buf_reset(buf);
+	while (n < count) {
+		bufs[n] = k_lifo_get(&pool->free, K_NO_WAIT);
+#if defined(CONFIG_NET_BUF_POOL_CACHE)
+		if (!bufs[n] && pool_cache_enabled(pool)) {
+			bufs[n] = pool_cache_get(pool, true);
+		}
+#endif /* CONFIG_NET_BUF_POOL_CACHE */
+		if (!bufs[n]) {
+			break;
+		}
+		n++;
+	}
 
-#if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
-	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
-	pool->max_used = MAX(pool->max_used,
-			     pool->buf_count - atomic_get(&pool->avail_count));
-#endif
-	return buf;
+	/* Set the buffers up, keeping those that got their data first */
+	claimed = n;
+	n = 0;
+	for (int i = 0; i < claimed; i++) {
+		struct net_buf *buf = buf_setup(pool, bufs[i], size, end);
+
+		if (buf) {
+			bufs[n++] = buf;
+		}
+	}
+
+	NET_BUF_DBG("pool %p allocated %d/%d buffers", pool, n, count);
+
+	return n;
 }
 
 #if defined(CONFIG_NET_BUF_LOG)
@@ -464,6 +686,13 @@ void net_buf_unref(struct net_buf *buf)
 	}
 }
 
+void net_buf_unref_bulk(struct net_buf **bufs, int count)
+{
+	for (int i = 0; i < count; i++) {
+		net_buf_unref(bufs[i]);
+	}
+}
+
 struct net_buf *net_buf_ref(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf);
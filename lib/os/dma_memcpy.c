@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/cache.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/dma_memcpy.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_REGISTER(dma_memcpy, CONFIG_KERNEL_LOG_LEVEL);
+
+#define DMA_MEMCPY_NODE DT_CHOSEN(zephyr_dma_memcpy)
+
+#if DT_NODE_HAS_STATUS_OKAY(DMA_MEMCPY_NODE)
+
+static const struct device *const dma_dev = DEVICE_DT_GET(DMA_MEMCPY_NODE);
+
+static struct {
+	/* Channel taken at init, negative when there is none */
+	int channel;
+	atomic_t busy;
+	struct dma_config cfg;
+	struct dma_block_config block;
+	/* Source of fills, as the controller reads the value from memory */
+	uint32_t fill;
+	void *dst;
+	size_t len;
+	sys_dma_memcpy_cb_t cb;
+	void *user_data;
+} dma_memcpy = {
+	.channel = -1,
+};
+
+static void dma_memcpy_done(const struct device *dev, void *arg, uint32_t channel, int status)
+{
+	sys_dma_memcpy_cb_t cb = dma_memcpy.cb;
+	void *user_data = dma_memcpy.user_data;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(arg);
+	ARG_UNUSED(channel);
+
+	(void)sys_cache_data_invd_range(dma_memcpy.dst, dma_memcpy.len);
+
+	atomic_clear(&dma_memcpy.busy);
+
+	if (cb != NULL) {
+		cb(user_data, (status < 0) ? status : 0);
+	}
+}
+
+/* Widest unit both ends and the length are aligned to */
+static uint32_t dma_memcpy_width(uintptr_t dst, uintptr_t src, size_t len)
+{
+	uintptr_t bits = dst | src | len;
+
+	if ((bits & 3U) == 0U) {
+		return 4U;
+	} else if ((bits & 1U) == 0U) {
+		return 2U;
+	}
+
+	return 1U;
+}
+
+/* Starts the transfer, a fill when fill is not negative. Returns false
+ * when the CPU has to do it.
+ */
+static bool dma_memcpy_start(void *dst, const void *src, size_t len, int fill,
+			     sys_dma_memcpy_cb_t cb, void *user_data)
+{
+	struct dma_config *cfg = &dma_memcpy.cfg;
+	struct dma_block_config *block = &dma_memcpy.block;
+	uint32_t width;
+
+	if (dma_memcpy.channel < 0 || len < CONFIG_SYS_DMA_MEMCPY_THRESHOLD ||
+	    len > UINT32_MAX || !atomic_cas(&dma_memcpy.busy, 0, 1)) {
+		return false;
+	}
+
+	if (fill >= 0) {
+		dma_memcpy.fill = 0x01010101U * (uint8_t)fill;
+		src = &dma_memcpy.fill;
+	}
+
+	width = dma_memcpy_width((uintptr_t)dst, (uintptr_t)src, len);
+
+	memset(block, 0, sizeof(*block));
+	block->source_address = (uintptr_t)src;
+	block->dest_address = (uintptr_t)dst;
+	block->block_size = len;
+	block->source_addr_adj = (fill >= 0) ? DMA_ADDR_ADJ_NO_CHANGE : DMA_ADDR_ADJ_INCREMENT;
+	block->dest_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+
+	memset(cfg, 0, sizeof(*cfg));
+	cfg->channel_direction = MEMORY_TO_MEMORY;
+	cfg->source_data_size = width;
+	cfg->dest_data_size = width;
+	cfg->source_burst_length = width;
+	cfg->dest_burst_length = width;
+	cfg->block_count = 1U;
+	cfg->head_block = block;
+	cfg->dma_callback = dma_memcpy_done;
+
+	dma_memcpy.dst = dst;
+	dma_memcpy.len = len;
+	dma_memcpy.cb = cb;
+	dma_memcpy.user_data = user_data;
+
+	(void)sys_cache_data_flush_range((void *)src, (fill >= 0) ? sizeof(dma_memcpy.fill) : len);
+	(void)sys_cache_data_flush_and_invd_range(dst, len);
+
+	if (dma_config(dma_dev, dma_memcpy.channel, cfg) != 0 ||
+	    dma_start(dma_dev, dma_memcpy.channel) != 0) {
+		LOG_DBG("DMA refused a %zu bytes transfer", len);
+		atomic_clear(&dma_memcpy.busy);
+		return false;
+	}
+
+	return true;
+}
+
+static int dma_memcpy_init(void)
+{
+	if (!device_is_ready(dma_dev)) {
+		LOG_WRN("DMA controller not ready, copying with the CPU");
+		return 0;
+	}
+
+	dma_memcpy.channel = dma_request_channel(dma_dev, NULL);
+	if (dma_memcpy.channel < 0) {
+		LOG_WRN("No DMA channel, copying with the CPU");
+	}
+
+	return 0;
+}
+
+SYS_INIT(dma_memcpy_init, POST_KERNEL, CONFIG_SYS_DMA_MEMCPY_INIT_PRIORITY);
+
+#else /* DT_NODE_HAS_STATUS_OKAY(DMA_MEMCPY_NODE) */
+
+static inline bool dma_memcpy_start(void *dst, const void *src, size_t len, int fill,
+				    sys_dma_memcpy_cb_t cb, void *user_data)
+{
+	return false;
+}
+
+#endif /* DT_NODE_HAS_STATUS_OKAY(DMA_MEMCPY_NODE) */
+
+void sys_dma_memcpy_async(void *dst, const void *src, size_t len,
+			  sys_dma_memcpy_cb_t cb, void *user_data)
+{
+	if (dma_memcpy_start(dst, src, len, -1, cb, user_data)) {
+		return;
+	}
+
+	memcpy(dst, src, len);
+
+	if (cb != NULL) {
+		cb(user_data, 0);
+	}
+}
+
+void sys_dma_memset_async(void *dst, uint8_t c, size_t len,
+			  sys_dma_memcpy_cb_t cb, void *user_data)
+{
+	if (dma_memcpy_start(dst, NULL, len, c, cb, user_data)) {
+		return;
+	}
+
+	memset(dst, c, len);
+
+	if (cb != NULL) {
+		cb(user_data, 0);
+	}
+}
+
+struct dma_memcpy_wait {
+	struct k_sem sem;
+	int result;
+};
+
+static void dma_memcpy_wake(void *user_data, int result)
+{
+	struct dma_memcpy_wait *wait = user_data;
+
+	wait->result = result;
+	k_sem_give(&wait->sem);
+}
+
+int sys_dma_memcpy(void *dst, const void *src, size_t len)
+{
+	struct dma_memcpy_wait wait;
+
+	__ASSERT_NO_MSG(!k_is_in_isr());
+
+	k_sem_init(&wait.sem, 0, 1);
+	sys_dma_memcpy_async(dst, src, len, dma_memcpy_wake, &wait);
+	(void)k_sem_take(&wait.sem, K_FOREVER);
+
+	return wait.result;
+}
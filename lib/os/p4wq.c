@@ -23,6 +23,26 @@ static void set_prio(struct k_thread *th, struct k_p4wq_work *item)
 	th->base.prio_deadline = item->deadline;
 }
 
+#ifdef CONFIG_SCHED_CPU_MASK
+/* CPU mask of the worker running an item: the item's one if it has
+ * any, the worker's own one otherwise.
+ */
+static uint32_t item_cpu_mask(struct k_p4wq_work *item, uint32_t worker_mask)
+{
+	if (item->cpu_mask == 0U) {
+		return worker_mask;
+	}
+
+	__ASSERT((item->cpu_mask & BIT_MASK(arch_num_cpus())) != 0U,
+		 "item CPU mask selects no existing CPU");
+	__ASSERT(!IS_ENABLED(CONFIG_SCHED_CPU_MASK_PIN_ONLY) ||
+		 IS_POWER_OF_TWO(item->cpu_mask),
+		 "only one CPU allowed when CONFIG_SCHED_CPU_MASK_PIN_ONLY=y");
+
+	return item->cpu_mask;
+}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 static bool rb_lessthan(struct rbnode *a, struct rbnode *b)
 {
 	struct k_p4wq_work *aw = CONTAINER_OF(a, struct k_p4wq_work, rbnode);
@@ -77,6 +97,11 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* Affinity configured for this worker, restored after each item */
+	uint32_t worker_mask = _current->base.cpu_mask;
+	uint32_t cpu_mask;
+#endif /* CONFIG_SCHED_CPU_MASK */
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	while (true) {
@@ -91,11 +116,23 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 			sys_dlist_append(&queue->active, &w->dlnode);
 			set_prio(_current, w);
 			thread_clear_requeued(_current);
+#ifdef CONFIG_SCHED_CPU_MASK
+			cpu_mask = item_cpu_mask(w, worker_mask);
+#endif /* CONFIG_SCHED_CPU_MASK */
 
 			k_spin_unlock(&queue->lock, k);
 
+#ifdef CONFIG_SCHED_CPU_MASK
+			/* Moves us to an allowed CPU if this one isn't */
+			z_sched_cpu_mask_set(_current, cpu_mask);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 			w->handler(w);
 
+#ifdef CONFIG_SCHED_CPU_MASK
+			z_sched_cpu_mask_set(_current, worker_mask);
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 			k = k_spin_lock(&queue->lock);
 
 			/* Remove from the active list only if it
@@ -292,6 +329,10 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 	}
 
 	set_prio(th, item);
+#ifdef CONFIG_SCHED_CPU_MASK
+	/* Before readying it, so that its IPI goes to an allowed CPU */
+	z_sched_cpu_mask_set(th, item_cpu_mask(item, th->base.cpu_mask));
+#endif /* CONFIG_SCHED_CPU_MASK */
 	z_ready_thread(th);
 	z_reschedule(&queue->lock, k);
 
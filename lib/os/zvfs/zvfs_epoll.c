@@ -0,0 +1,498 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* Most file descriptors wait on one object per direction */
+#define ZVFS_EPOLL_ITEM_EVENTS 2
+
+#define ZVFS_EPOLL_EVENTS_SET                                                                      \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | ZVFS_EPOLLERR | ZVFS_EPOLLHUP |            \
+	 ZVFS_EPOLLONESHOT)
+
+#define ZVFS_EPOLL_ITEM_IN_USE 0x1
+#define ZVFS_EPOLL_ITEM_ARMED  0x2
+#define ZVFS_EPOLL_ITEM_QUEUED 0x4
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	/* Node in the ready list of the instance */
+	sys_dnode_t node;
+	/* Triggered by the objects the file descriptor waits on */
+	struct k_work_poll work;
+	struct k_poll_event pev[ZVFS_EPOLL_ITEM_EVENTS];
+	struct zvfs_epoll *ep;
+	zvfs_epoll_data_t data;
+	uint32_t events;
+	int fd;
+	int flags;
+};
+
+struct zvfs_epoll {
+	struct zvfs_epoll_item items[CONFIG_ZVFS_EPOLL_MAX_FDS];
+	/* Items which may be ready, pushed by their triggered work */
+	sys_dlist_t ready;
+	/* Protects the ready list and the item flags */
+	struct k_spinlock lock;
+	/* Serializes zvfs_epoll_ctl() and zvfs_epoll_wait() */
+	struct k_mutex mutex;
+	/* Given when an item is queued */
+	struct k_sem sem;
+	bool in_use;
+};
+
+int zvfs_poll_internal(struct zvfs_pollfd *fds, int nfds, k_timeout_t timeout);
+
+SYS_BITARRAY_DEFINE_STATIC(eps_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll eps[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static void zvfs_epoll_queue_locked(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	if ((item->flags & ZVFS_EPOLL_ITEM_QUEUED) == 0) {
+		item->flags |= ZVFS_EPOLL_ITEM_QUEUED;
+		sys_dlist_append(&ep->ready, &item->node);
+	}
+}
+
+static void zvfs_epoll_queue(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep->lock);
+
+	zvfs_epoll_queue_locked(ep, item);
+	k_spin_unlock(&ep->lock, key);
+
+	k_sem_give(&ep->sem);
+}
+
+static void zvfs_epoll_triggered(struct k_work *work)
+{
+	struct k_work_poll *twork = CONTAINER_OF(work, struct k_work_poll, work);
+	struct zvfs_epoll_item *item = CONTAINER_OF(twork, struct zvfs_epoll_item, work);
+	struct zvfs_epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->lock);
+
+	/* Ignore a trigger raced by a removal or a modification */
+	if ((item->flags & ZVFS_EPOLL_ITEM_ARMED) == 0) {
+		k_spin_unlock(&ep->lock, key);
+		return;
+	}
+
+	item->flags &= ~ZVFS_EPOLL_ITEM_ARMED;
+	zvfs_epoll_queue_locked(ep, item);
+	k_spin_unlock(&ep->lock, key);
+
+	k_sem_give(&ep->sem);
+}
+
+/* Watch the objects of the file descriptor until one of them is signaled */
+static int zvfs_epoll_arm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->events & ~ZVFS_EPOLLONESHOT,
+	};
+	struct k_poll_event *pev = item->pev;
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	void *ctx;
+	int ret;
+
+	ctx = zvfs_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (ctx == NULL) {
+		/* Reported and removed by zvfs_epoll_wait() */
+		zvfs_epoll_queue(ep, item);
+		return 0;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	ret = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				      item->pev + ARRAY_SIZE(item->pev));
+	k_mutex_unlock(lock);
+
+	if (ret == -EALREADY) {
+		zvfs_epoll_queue(ep, item);
+		return 0;
+	} else if (ret == -EXDEV) {
+		/* Offloaded sockets cannot be watched from here */
+		return -EPERM;
+	} else if (ret < 0) {
+		return ret == -1 ? -errno : ret;
+	}
+
+	key = k_spin_lock(&ep->lock);
+	item->flags |= ZVFS_EPOLL_ITEM_ARMED;
+	k_spin_unlock(&ep->lock, key);
+
+	ret = k_work_poll_submit(&item->work, item->pev, pev - item->pev, K_FOREVER);
+	if (ret < 0) {
+		key = k_spin_lock(&ep->lock);
+		item->flags &= ~ZVFS_EPOLL_ITEM_ARMED;
+		k_spin_unlock(&ep->lock, key);
+	}
+
+	return ret;
+}
+
+static void zvfs_epoll_disarm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key = k_spin_lock(&ep->lock);
+
+	item->flags &= ~ZVFS_EPOLL_ITEM_ARMED;
+	if ((item->flags & ZVFS_EPOLL_ITEM_QUEUED) != 0) {
+		item->flags &= ~ZVFS_EPOLL_ITEM_QUEUED;
+		sys_dlist_remove(&item->node);
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	(void)k_work_poll_cancel(&item->work);
+}
+
+static void zvfs_epoll_item_free(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	zvfs_epoll_disarm(ep, item);
+	item->flags = 0;
+}
+
+static struct zvfs_epoll_item *zvfs_epoll_item_find(struct zvfs_epoll *ep, int fd)
+{
+	ARRAY_FOR_EACH_PTR(ep->items, item) {
+		if ((item->flags & ZVFS_EPOLL_ITEM_IN_USE) != 0 && item->fd == fd) {
+			return item;
+		}
+	}
+
+	return NULL;
+}
+
+/* Report the queued items which are still ready, and arm the others again */
+static int zvfs_epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+			      int maxevents)
+{
+	sys_dlist_t pending;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	int n = 0;
+
+	sys_dlist_init(&pending);
+
+	key = k_spin_lock(&ep->lock);
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		struct zvfs_epoll_item *item = CONTAINER_OF(node, struct zvfs_epoll_item, node);
+
+		item->flags &= ~ZVFS_EPOLL_ITEM_QUEUED;
+		sys_dlist_append(&pending, node);
+	}
+	k_spin_unlock(&ep->lock, key);
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct zvfs_epoll_item *item = CONTAINER_OF(node, struct zvfs_epoll_item, node);
+		struct zvfs_pollfd pfd = {
+			.fd = item->fd,
+			.events = item->events & ~ZVFS_EPOLLONESHOT,
+		};
+
+		if (n == maxevents) {
+			zvfs_epoll_queue(ep, item);
+			continue;
+		}
+
+		if (zvfs_poll_internal(&pfd, 1, K_NO_WAIT) < 0) {
+			pfd.revents = ZVFS_POLLERR;
+		}
+
+		if ((pfd.revents & ZVFS_POLLNVAL) != 0) {
+			/* The file descriptor was closed */
+			zvfs_epoll_item_free(ep, item);
+			continue;
+		}
+
+		if (pfd.revents == 0) {
+			if (zvfs_epoll_arm(ep, item) == 0) {
+				continue;
+			}
+
+			pfd.revents = ZVFS_POLLERR;
+		}
+
+		events[n].events = pfd.revents;
+		events[n].data = item->data;
+		n++;
+
+		/* Level-triggered: check the item again on the next wait */
+		if ((item->events & ZVFS_EPOLLONESHOT) == 0) {
+			zvfs_epoll_queue(ep, item);
+		}
+	}
+
+	return n;
+}
+
+static ssize_t zvfs_epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t zvfs_epoll_write_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+	int err;
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(ep->items, item) {
+		if ((item->flags & ZVFS_EPOLL_ITEM_IN_USE) != 0) {
+			zvfs_epoll_item_free(ep, item);
+		}
+	}
+
+	ep->in_use = false;
+
+	err = sys_bitarray_free(&eps_bitarray, 1, ep - eps);
+	__ASSERT(err == 0, "sys_bitarray_free() failed: %d", err);
+
+	k_mutex_unlock(&ep->mutex);
+
+	/* Wake up a waiter, it will find the instance closed */
+	k_sem_give(&ep->sem);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.read = zvfs_epoll_read_op,
+	.write = zvfs_epoll_write_op,
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
+
+/*
+ * Public-facing API
+ */
+
+int zvfs_epoll_create(int flags)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if ((flags & ~ZVFS_EPOLL_CLOEXEC) != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sys_bitarray_alloc(&eps_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &eps[offset];
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		sys_bitarray_free(&eps_bitarray, 1, offset);
+		return -1;
+	}
+
+	sys_dlist_init(&ep->ready);
+	k_mutex_init(&ep->mutex);
+	k_sem_init(&ep->sem, 0, 1);
+
+	ARRAY_FOR_EACH_PTR(ep->items, item) {
+		item->ep = ep;
+		item->flags = 0;
+		k_work_poll_init(&item->work, zvfs_epoll_triggered);
+	}
+
+	ep->in_use = true;
+
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll *ep;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL &&
+	    (event == NULL || (event->events & ~ZVFS_EPOLL_EVENTS_SET) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	/* Sets errno to EBADF for an invalid file descriptor */
+	if (zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	item = zvfs_epoll_item_find(ep, fd);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		ARRAY_FOR_EACH_PTR(ep->items, free_item) {
+			if ((free_item->flags & ZVFS_EPOLL_ITEM_IN_USE) == 0) {
+				item = free_item;
+				break;
+			}
+		}
+
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		item->fd = fd;
+		item->events = event->events;
+		item->data = event->data;
+		item->flags = ZVFS_EPOLL_ITEM_IN_USE;
+
+		ret = zvfs_epoll_arm(ep, item);
+		if (ret < 0) {
+			zvfs_epoll_item_free(ep, item);
+		}
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_disarm(ep, item);
+
+		item->events = event->events;
+		item->data = event->data;
+
+		ret = zvfs_epoll_arm(ep, item);
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_item_free(ep, item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timepoint_t end;
+	int n;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EBADF);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	while (true) {
+		k_timeout_t remaining;
+
+		if (!ep->in_use) {
+			errno = EBADF;
+			n = -1;
+			break;
+		}
+
+		n = zvfs_epoll_collect(ep, events, maxevents);
+		if (n > 0) {
+			break;
+		}
+
+		remaining = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			break;
+		}
+
+		k_mutex_unlock(&ep->mutex);
+		(void)k_sem_take(&ep->sem, remaining);
+		(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	return n;
+}
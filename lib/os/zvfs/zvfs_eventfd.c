@@ -206,6 +206,10 @@ static int zvfs_eventfd_close_op(void *obj)
 	efd->flags = 0;
 	efd->cnt = 0;
 
+	/* Wake up those still watching the signals, e.g. an epoll instance */
+	k_poll_signal_raise(&efd->read_sig, 0);
+	k_poll_signal_raise(&efd->write_sig, 0);
+
 	ret = 0;
 
 unlock:
@@ -5,78 +5,447 @@
  */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/posix/aio.h>
+#include <zephyr/sys/util.h>
+
+/* prototypes for external, not-yet-public, functions in fdtable.c */
+ssize_t zvfs_read(int fd, void *buf, size_t sz, const size_t *from_offset);
+ssize_t zvfs_write(int fd, const void *buf, size_t sz, const size_t *from_offset);
+int zvfs_fsync(int fd);
+
+/* Internal opcode, next to LIO_READ and LIO_WRITE */
+#define AIO_FSYNC (LIO_WRITE + 1)
+
+/* Requests of one lio_listio() call */
+struct aio_list {
+	struct sigevent sig;
+	uint8_t pending;
+	bool in_use;
+};
+
+struct aio_req {
+	struct k_work work;
+	/* NULL when the slot is free */
+	struct aiocb *cb;
+	struct aio_list *list;
+	int opcode;
+};
+
+/* Notifications to send once the lock is released */
+struct aio_notification {
+	struct sigevent cb_sig;
+	struct sigevent list_sig;
+	bool list;
+};
+
+static K_MUTEX_DEFINE(aio_lock);
+static K_CONDVAR_DEFINE(aio_done);
+static struct aio_req aio_reqs[CONFIG_POSIX_AIO_MAX];
+static struct aio_list aio_lists[CONFIG_POSIX_AIO_MAX];
+
+static struct k_work_q aio_workq;
+static K_KERNEL_STACK_DEFINE(aio_workq_stack, CONFIG_POSIX_AIO_WORKQ_STACK_SIZE);
+
+/* SIGEV_SIGNAL is not supported, anything but SIGEV_THREAD means no notification */
+static bool aio_sigevent_is_valid(const struct sigevent *sig)
+{
+	switch (sig->sigev_notify) {
+	case SIGEV_SIGNAL:
+		return false;
+	case SIGEV_THREAD:
+		return sig->sigev_notify_function != NULL;
+	default:
+		return true;
+	}
+}
+
+static void aio_notify_one(const struct sigevent *sig)
+{
+	if (sig->sigev_notify == SIGEV_THREAD) {
+		sig->sigev_notify_function(sig->sigev_value);
+	}
+}
+
+static void aio_notify(const struct aio_notification *n)
+{
+	aio_notify_one(&n->cb_sig);
+	if (n->list) {
+		aio_notify_one(&n->list_sig);
+	}
+}
+
+static struct aio_req *aio_req_get_locked(void)
+{
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		if (req->cb == NULL) {
+			return req;
+		}
+	}
+
+	return NULL;
+}
+
+static size_t aio_req_num_free_locked(void)
+{
+	size_t n = 0;
+
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		n += (req->cb == NULL) ? 1 : 0;
+	}
+
+	return n;
+}
+
+static void aio_req_start_locked(struct aio_req *req, struct aiocb *cb, int opcode,
+				 struct aio_list *list)
+{
+	req->cb = cb;
+	req->opcode = opcode;
+	req->list = list;
+	cb->__aio_error = EINPROGRESS;
+	cb->__aio_return = 0;
+
+	(void)k_work_submit_to_queue(&aio_workq, &req->work);
+}
+
+/* Publish the result of a request and free its slot */
+static void aio_req_finish_locked(struct aio_req *req, int err, ssize_t ret,
+				  struct aio_notification *n)
+{
+	struct aiocb *cb = req->cb;
+	struct aio_list *list = req->list;
+
+	/* The block belongs to the application again once the result is set */
+	n->cb_sig = cb->aio_sigevent;
+	n->list = false;
+	cb->__aio_return = ret;
+	cb->__aio_error = err;
+	req->cb = NULL;
+
+	if (list != NULL) {
+		list->pending--;
+		if (list->pending == 0 && list->in_use) {
+			n->list_sig = list->sig;
+			n->list = true;
+			list->in_use = false;
+		}
+	}
+
+	k_condvar_broadcast(&aio_done);
+}
+
+static void aio_work_handler(struct k_work *work)
+{
+	struct aio_req *req = CONTAINER_OF(work, struct aio_req, work);
+	struct aiocb *cb = req->cb;
+	size_t offset = (size_t)cb->aio_offset;
+	struct aio_notification n;
+	ssize_t ret;
+
+	switch (req->opcode) {
+	case LIO_READ:
+		ret = zvfs_read(cb->aio_fildes, (void *)cb->aio_buf, cb->aio_nbytes, &offset);
+		if (ret < 0 && errno == ENOTSUP) {
+			/* aio_offset is ignored on files that cannot seek */
+			ret = zvfs_read(cb->aio_fildes, (void *)cb->aio_buf, cb->aio_nbytes, NULL);
+		}
+		break;
+	case LIO_WRITE:
+		ret = zvfs_write(cb->aio_fildes, (const void *)cb->aio_buf, cb->aio_nbytes,
+				 &offset);
+		if (ret < 0 && errno == ENOTSUP) {
+			ret = zvfs_write(cb->aio_fildes, (const void *)cb->aio_buf, cb->aio_nbytes,
+					 NULL);
+		}
+		break;
+	default:
+		ret = zvfs_fsync(cb->aio_fildes);
+		break;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	aio_req_finish_locked(req, (ret < 0) ? errno : 0, ret, &n);
+	k_mutex_unlock(&aio_lock);
+
+	aio_notify(&n);
+}
+
+static int aio_queue(struct aiocb *aiocbp, int opcode)
+{
+	struct aio_req *req;
+
+	if (aiocbp == NULL || aiocbp->aio_offset < 0 ||
+	    !aio_sigevent_is_valid(&aiocbp->aio_sigevent)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	req = aio_req_get_locked();
+	if (req != NULL) {
+		aio_req_start_locked(req, aiocbp, opcode, NULL);
+	}
+	k_mutex_unlock(&aio_lock);
+
+	if (req == NULL) {
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return 0;
+}
 
 int aio_cancel(int fildes, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+	struct aio_notification n[CONFIG_POSIX_AIO_MAX];
+	size_t canceled = 0;
+	bool not_canceled = false;
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		if (req->cb == NULL || req->cb->aio_fildes != fildes ||
+		    (aiocbp != NULL && req->cb != aiocbp)) {
+			continue;
+		}
 
-	errno = ENOSYS;
-	return -1;
+		/* The handler cannot finish meanwhile, it needs the lock */
+		if (k_work_cancel(&req->work) != 0) {
+			not_canceled = true;
+			continue;
+		}
+
+		aio_req_finish_locked(req, ECANCELED, -1, &n[canceled]);
+		canceled++;
+	}
+	k_mutex_unlock(&aio_lock);
+
+	for (size_t i = 0; i < canceled; i++) {
+		aio_notify(&n[i]);
+	}
+
+	if (not_canceled) {
+		return AIO_NOTCANCELED;
+	}
+
+	return (canceled > 0) ? AIO_CANCELED : AIO_ALLDONE;
 }
 
 int aio_error(const struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	int err;
+
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	err = aiocbp->__aio_error;
+	k_mutex_unlock(&aio_lock);
+
+	return err;
 }
 
-int aio_fsync(int fildes, struct aiocb *aiocbp)
+int aio_fsync(int op, struct aiocb *aiocbp)
 {
-	ARG_UNUSED(fildes);
-	ARG_UNUSED(aiocbp);
+#if defined(O_SYNC) && defined(O_DSYNC)
+	if (op != O_SYNC && op != O_DSYNC) {
+		errno = EINVAL;
+		return -1;
+	}
+#else
+	ARG_UNUSED(op);
+#endif
 
-	errno = ENOSYS;
-	return -1;
+	return aio_queue(aiocbp, AIO_FSYNC);
 }
 
 int aio_read(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
-
-	errno = ENOSYS;
-	return -1;
+	return aio_queue(aiocbp, LIO_READ);
 }
 
 ssize_t aio_return(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
+	ssize_t ret;
+
+	if (aiocbp == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
 
-	errno = ENOSYS;
-	return -1;
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	if (aiocbp->__aio_error == EINPROGRESS) {
+		ret = -1;
+		errno = EINVAL;
+	} else {
+		ret = aiocbp->__aio_return;
+	}
+	k_mutex_unlock(&aio_lock);
+
+	return ret;
+}
+
+static bool aio_any_done_locked(const struct aiocb *const list[], int nent)
+{
+	for (int i = 0; i < nent; i++) {
+		if (list[i] != NULL && list[i]->__aio_error != EINPROGRESS) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 int aio_suspend(const struct aiocb *const list[], int nent, const struct timespec *timeout)
 {
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(timeout);
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	int ret = 0;
+
+	if (list == NULL || nent < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= NSEC_PER_SEC) {
+			errno = EINVAL;
+			return -1;
+		}
+		end = sys_timepoint_calc(
+			K_NSEC((int64_t)timeout->tv_sec * NSEC_PER_SEC + timeout->tv_nsec));
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+	while (!aio_any_done_locked(list, nent)) {
+		if (k_condvar_wait(&aio_done, &aio_lock, sys_timepoint_timeout(end)) != 0) {
+			errno = EAGAIN;
+			ret = -1;
+			break;
+		}
+	}
+	k_mutex_unlock(&aio_lock);
 
-	errno = ENOSYS;
-	return -1;
+	return ret;
 }
 
 int aio_write(struct aiocb *aiocbp)
 {
-	ARG_UNUSED(aiocbp);
-
-	errno = ENOSYS;
-	return -1;
+	return aio_queue(aiocbp, LIO_WRITE);
 }
 
 int lio_listio(int mode, struct aiocb *const ZRESTRICT list[], int nent,
 	       struct sigevent *ZRESTRICT sig)
 {
-	ARG_UNUSED(mode);
-	ARG_UNUSED(list);
-	ARG_UNUSED(nent);
-	ARG_UNUSED(sig);
+	struct aio_list wait_list = {0};
+	struct aio_list *l = NULL;
+	int count = 0;
+	int ret = 0;
+
+	if ((mode != LIO_WAIT && mode != LIO_NOWAIT) || list == NULL || nent < 0 ||
+	    nent > AIO_LISTIO_MAX || (mode == LIO_NOWAIT && sig != NULL &&
+				      !aio_sigevent_is_valid(sig))) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (int i = 0; i < nent; i++) {
+		struct aiocb *cb = list[i];
+
+		if (cb == NULL || cb->aio_lio_opcode == LIO_NOP) {
+			continue;
+		}
+		if ((cb->aio_lio_opcode != LIO_READ && cb->aio_lio_opcode != LIO_WRITE) ||
+		    cb->aio_offset < 0 || !aio_sigevent_is_valid(&cb->aio_sigevent)) {
+			errno = EINVAL;
+			return -1;
+		}
+		count++;
+	}
+
+	(void)k_mutex_lock(&aio_lock, K_FOREVER);
+
+	/* All the requests are queued, or none */
+	if (aio_req_num_free_locked() < count) {
+		k_mutex_unlock(&aio_lock);
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (mode == LIO_WAIT) {
+		l = &wait_list;
+	} else if (sig != NULL && sig->sigev_notify == SIGEV_THREAD && count > 0) {
+		ARRAY_FOR_EACH_PTR(aio_lists, entry) {
+			if (!entry->in_use && entry->pending == 0) {
+				l = entry;
+				break;
+			}
+		}
+		if (l == NULL) {
+			k_mutex_unlock(&aio_lock);
+			errno = EAGAIN;
+			return -1;
+		}
+		l->sig = *sig;
+		l->in_use = true;
+	}
+
+	if (l != NULL) {
+		l->pending = count;
+	}
+
+	for (int i = 0; i < nent; i++) {
+		struct aiocb *cb = list[i];
+
+		if (cb != NULL && cb->aio_lio_opcode != LIO_NOP) {
+			aio_req_start_locked(aio_req_get_locked(), cb, cb->aio_lio_opcode, l);
+		}
+	}
+
+	if (mode == LIO_WAIT) {
+		while (wait_list.pending > 0) {
+			(void)k_condvar_wait(&aio_done, &aio_lock, K_FOREVER);
+		}
 
-	errno = ENOSYS;
-	return -1;
+		for (int i = 0; i < nent; i++) {
+			if (list[i] != NULL && list[i]->aio_lio_opcode != LIO_NOP &&
+			    list[i]->__aio_error != 0) {
+				errno = EIO;
+				ret = -1;
+			}
+		}
+	}
+
+	k_mutex_unlock(&aio_lock);
+
+	/* Nothing to wait for, the list is already complete */
+	if (mode == LIO_NOWAIT && sig != NULL && count == 0) {
+		aio_notify_one(sig);
+	}
+
+	return ret;
+}
+
+static int aio_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "posix_aio",
+	};
+
+	ARRAY_FOR_EACH_PTR(aio_reqs, req) {
+		k_work_init(&req->work, aio_work_handler);
+	}
+
+	k_work_queue_start(&aio_workq, aio_workq_stack, K_KERNEL_STACK_SIZEOF(aio_workq_stack),
+			   K_PRIO_PREEMPT(CONFIG_POSIX_AIO_WORKQ_PRIORITY), &cfg);
+
+	return 0;
 }
+
+SYS_INIT(aio_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
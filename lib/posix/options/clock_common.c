@@ -123,11 +123,42 @@ int z_clock_settime(clockid_t clock_id, const struct timespec *tp)
 	return 0;
 }
 
+static inline uint64_t uptime_get_ns(void)
+{
+#ifdef CONFIG_POSIX_CLOCK_NANOSLEEP_HIGH_RES
+	return k_cyc_to_ns_floor64(k_cycle_get_64());
+#else
+	return k_ticks_to_ns_ceil64(sys_clock_tick_get());
+#endif
+}
+
+/* Sleep until ns nanoseconds of uptime */
+static void sleep_until_ns(uint64_t ns)
+{
+#ifdef CONFIG_POSIX_CLOCK_NANOSLEEP_HIGH_RES
+	/* the cycle counter and the tick counter both run from boot */
+	const uint64_t end = k_ns_to_cyc_ceil64(ns);
+	const k_ticks_t ticks = k_ns_to_ticks_floor64(ns);
+
+	/* whole ticks first, then spin for the rest of the last tick */
+	while (k_sleep(K_TIMEOUT_ABS_TICKS(ticks)) != 0) {
+	}
+
+	while (k_cycle_get_64() < end) {
+	}
+#else
+	uint64_t us = DIV_ROUND_UP(ns, NSEC_PER_USEC);
+
+	do {
+		us = k_sleep(K_TIMEOUT_ABS_US(us)) * 1000;
+	} while (us != 0);
+#endif
+}
+
 int z_clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *rqtp,
 		      struct timespec *rmtp)
 {
 	uint64_t ns;
-	uint64_t us;
 	uint64_t uptime_ns;
 	const bool update_rmtp = rmtp != NULL;
 
@@ -153,7 +184,7 @@ int z_clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *rqtp
 		ns = (uint64_t)rqtp->tv_sec * NSEC_PER_SEC + rqtp->tv_nsec;
 	}
 
-	uptime_ns = k_ticks_to_ns_ceil64(sys_clock_tick_get());
+	uptime_ns = uptime_get_ns();
 
 	if (flags & TIMER_ABSTIME && clock_id == CLOCK_REALTIME) {
 		SYS_SEM_LOCK(&rt_clock_base_lock) {
@@ -169,10 +200,7 @@ int z_clock_nanosleep(clockid_t clock_id, int flags, const struct timespec *rqtp
 		goto do_rmtp_update;
 	}
 
-	us = DIV_ROUND_UP(ns, NSEC_PER_USEC);
-	do {
-		us = k_sleep(K_TIMEOUT_ABS_US(us)) * 1000;
-	} while (us != 0);
+	sleep_until_ns(ns);
 
 do_rmtp_update:
 	if (update_rmtp) {
@@ -11,16 +11,41 @@
 #include <errno.h>
 #include <string.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/hash_function.h>
 #include <zephyr/posix/mqueue.h>
 #include <zephyr/posix/pthread.h>
 
 #define SIGEV_MASK (SIGEV_NONE | SIGEV_SIGNAL | SIGEV_THREAD)
 
+/* Number of buckets of the name table, a power of two */
+#define MQ_HASH_BUCKETS 8
+
+/* Pending SIGEV_THREAD notifications */
+#define MQ_NOTIFY_QUEUE_LEN 4
+
+/* Message slot, followed by msg_size bytes of data */
+typedef struct mqueue_msg {
+	sys_snode_t snode;
+	uint32_t prio;
+	uint32_t len;
+	char data[];
+} mqueue_msg;
+
 typedef struct mqueue_object {
 	sys_snode_t snode;
 	char *mem_buffer;
 	char *mem_obj;
-	struct k_msgq queue;
+	/* Messages, highest priority first, FIFO within a priority */
+	sys_slist_t msgs;
+	sys_slist_t free_msgs;
+	struct k_mutex lock;
+	struct k_condvar not_empty;
+	struct k_condvar not_full;
+	size_t msg_size;
+	long max_msgs;
+	long num_msgs;
+	int num_receivers;
+	uint32_t hash;
 	atomic_t ref_count;
 	char *name;
 	struct sigevent not;
@@ -32,19 +57,30 @@ typedef struct mqueue_desc {
 	uint32_t  flags;
 } mqueue_desc;
 
+/* Protects the name table, each queue has its own lock for its messages */
 K_SEM_DEFINE(mq_sem, 1, 1);
 
-/* Initialize the list */
-sys_slist_t mq_list = SYS_SLIST_STATIC_INIT(&mq_list);
+/* Queues, hashed by name */
+static sys_slist_t mq_table[MQ_HASH_BUCKETS];
+
+K_MSGQ_DEFINE(mq_notify_msgq, sizeof(struct sigevent), MQ_NOTIFY_QUEUE_LEN, sizeof(void *));
 
-static mqueue_object *find_in_list(const char *name);
+static mqueue_object *find_in_table(const char *name, uint32_t hash);
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout);
+			    unsigned int msg_prio, k_timeout_t timeout);
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			   k_timeout_t timeout);
-static void remove_notification(mqueue_object *msg_queue);
+			       unsigned int *msg_prio, k_timeout_t timeout);
 static void remove_mq(mqueue_object *msg_queue);
-static void *mq_notify_thread(void *arg);
+
+static inline uint32_t mq_hash(const char *name)
+{
+	return sys_hash32_djb2(name, strlen(name));
+}
+
+static inline sys_slist_t *mq_bucket(uint32_t hash)
+{
+	return &mq_table[hash & (MQ_HASH_BUCKETS - 1)];
+}
 
 /**
  * @brief Open a message queue.
@@ -63,6 +99,8 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	mqueue_object *msg_queue;
 	mqueue_desc *msg_queue_desc = NULL, *mqd = (mqueue_desc *)(-1);
 	char *mq_desc_ptr, *mq_obj_ptr, *mq_buf_ptr, *mq_name_ptr;
+	size_t slot_size;
+	uint32_t hash;
 
 	va_start(va, oflags);
 	if ((oflags & O_CREAT) != 0) {
@@ -89,8 +127,9 @@ mqd_t mq_open(const char *name, int oflags, ...)
 	}
 
 	/* Check if queue already exists */
+	hash = mq_hash(name);
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_table(name, hash);
 	k_sem_give(&mq_sem);
 
 	if ((msg_queue != NULL) && (oflags & O_CREAT) != 0 &&
@@ -145,21 +184,30 @@ mqd_t mq_open(const char *name, int oflags, ...)
 
 		strcpy(msg_queue->name, name);
 
-		mq_buf_ptr = k_malloc(msg_size * max_msgs * sizeof(uint8_t));
+		slot_size = ROUND_UP(sizeof(mqueue_msg) + msg_size, sizeof(void *));
+		mq_buf_ptr = k_malloc(slot_size * max_msgs);
 		if (mq_buf_ptr != NULL) {
-			(void)memset(mq_buf_ptr, 0,
-				     msg_size * max_msgs * sizeof(uint8_t));
 			msg_queue->mem_buffer = mq_buf_ptr;
 		} else {
 			goto free_mq_buffer;
 		}
 
 		(void)atomic_set(&msg_queue->ref_count, 1);
-		/* initialize zephyr message queue */
-		k_msgq_init(&msg_queue->queue, msg_queue->mem_buffer, msg_size,
-			    max_msgs);
+		k_mutex_init(&msg_queue->lock);
+		k_condvar_init(&msg_queue->not_empty);
+		k_condvar_init(&msg_queue->not_full);
+		msg_queue->msg_size = msg_size;
+		msg_queue->max_msgs = max_msgs;
+		msg_queue->hash = hash;
+		sys_slist_init(&msg_queue->msgs);
+		sys_slist_init(&msg_queue->free_msgs);
+		for (long i = 0; i < max_msgs; i++) {
+			sys_slist_append(&msg_queue->free_msgs,
+					 (sys_snode_t *)&mq_buf_ptr[i * slot_size]);
+		}
+
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_append(&mq_list, (sys_snode_t *)&(msg_queue->snode));
+		sys_slist_append(mq_bucket(hash), (sys_snode_t *)&(msg_queue->snode));
 		k_sem_give(&mq_sem);
 
 	} else {
@@ -215,8 +263,13 @@ int mq_unlink(const char *name)
 {
 	mqueue_object *msg_queue;
 
+	if (name == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
 	k_sem_take(&mq_sem, K_FOREVER);
-	msg_queue = find_in_list(name);
+	msg_queue = find_in_table(name, mq_hash(name));
 
 	if (msg_queue == NULL) {
 		k_sem_give(&mq_sem);
@@ -234,8 +287,6 @@ int mq_unlink(const char *name)
 /**
  * @brief Send a message to a message queue.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -243,14 +294,12 @@ int mq_send(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return send_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return send_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Send message to a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
- *
  * See IEEE 1003.1
  */
 int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
@@ -263,14 +312,14 @@ int mq_timedsend(mqd_t mqdes, const char *msg_ptr, size_t msg_len,
 		return -1;
 	}
 
-	return send_message(mqd, msg_ptr, msg_len,
+	return send_message(mqd, msg_ptr, msg_len, msg_prio,
 			    K_MSEC(timespec_to_timeoutms(CLOCK_REALTIME, abstime)));
 }
 
 /**
  * @brief Receive a message from a message queue.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received first.
  *
  * See IEEE 1003.1
  */
@@ -279,13 +328,13 @@ int mq_receive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
 
-	return receive_message(mqd, msg_ptr, msg_len, K_FOREVER);
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio, K_FOREVER);
 }
 
 /**
  * @brief Receive message from a message queue within abstime time.
  *
- * All messages in message queue are of equal priority.
+ * The oldest message of the highest priority is received first.
  *
  * See IEEE 1003.1
  */
@@ -299,7 +348,7 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 		return -1;
 	}
 
-	return receive_message(mqd, msg_ptr, msg_len,
+	return receive_message(mqd, msg_ptr, msg_len, msg_prio,
 			       K_MSEC(timespec_to_timeoutms(CLOCK_REALTIME, abstime)));
 }
 
@@ -311,20 +360,20 @@ int mq_timedreceive(mqd_t mqdes, char *msg_ptr, size_t msg_len,
 int mq_getattr(mqd_t mqdes, struct mq_attr *mqstat)
 {
 	mqueue_desc *mqd = (mqueue_desc *)mqdes;
-	struct k_msgq_attrs attrs;
+	mqueue_object *msg_queue;
 
 	if (mqd == NULL) {
 		errno = EBADF;
 		return -1;
 	}
 
-	k_sem_take(&mq_sem, K_FOREVER);
-	k_msgq_get_attrs(&mqd->mqueue->queue, &attrs);
+	msg_queue = mqd->mqueue;
+	(void)k_mutex_lock(&msg_queue->lock, K_FOREVER);
 	mqstat->mq_flags = mqd->flags;
-	mqstat->mq_maxmsg = attrs.max_msgs;
-	mqstat->mq_msgsize = attrs.msg_size;
-	mqstat->mq_curmsgs = attrs.used_msgs;
-	k_sem_give(&mq_sem);
+	mqstat->mq_maxmsg = msg_queue->max_msgs;
+	mqstat->mq_msgsize = msg_queue->msg_size;
+	mqstat->mq_curmsgs = msg_queue->num_msgs;
+	k_mutex_unlock(&msg_queue->lock);
 	return 0;
 }
 
@@ -352,9 +401,9 @@ int mq_setattr(mqd_t mqdes, const struct mq_attr *mqstat,
 		mq_getattr(mqdes, omqstat);
 	}
 
-	k_sem_take(&mq_sem, K_FOREVER);
+	(void)k_mutex_lock(&mqd->mqueue->lock, K_FOREVER);
 	mqd->flags = mqstat->mq_flags;
-	k_sem_give(&mq_sem);
+	k_mutex_unlock(&mqd->mqueue->lock);
 
 	return 0;
 }
@@ -374,116 +423,161 @@ int mq_notify(mqd_t mqdes, const struct sigevent *notification)
 	}
 
 	mqueue_object *msg_queue = mqd->mqueue;
+	int ret = 0;
 
 	if (notification == NULL) {
+		(void)k_mutex_lock(&msg_queue->lock, K_FOREVER);
 		if ((msg_queue->not.sigev_notify & SIGEV_MASK) == 0) {
-			errno = EINVAL;
-			return -1;
+			ret = EINVAL;
+		} else {
+			memset(&msg_queue->not, 0, sizeof(struct sigevent));
 		}
-		remove_notification(msg_queue);
-		return 0;
+		k_mutex_unlock(&msg_queue->lock);
+		goto out;
 	}
 
-	if ((msg_queue->not.sigev_notify & SIGEV_MASK) != 0) {
-		errno = EBUSY;
-		return -1;
-	}
 	if (notification->sigev_notify == SIGEV_SIGNAL) {
 		errno = ENOSYS;
 		return -1;
 	}
-	if (notification->sigev_notify_attributes != NULL) {
-		int ret = pthread_attr_setdetachstate(notification->sigev_notify_attributes,
-						      PTHREAD_CREATE_DETACHED);
-		if (ret != 0) {
-			errno = ret;
-			return -1;
-		}
+
+	(void)k_mutex_lock(&msg_queue->lock, K_FOREVER);
+	if ((msg_queue->not.sigev_notify & SIGEV_MASK) != 0) {
+		ret = EBUSY;
+	} else {
+		memcpy(&msg_queue->not, notification, sizeof(struct sigevent));
 	}
+	k_mutex_unlock(&msg_queue->lock);
 
-	k_sem_take(&mq_sem, K_FOREVER);
-	memcpy(&msg_queue->not, notification, sizeof(struct sigevent));
-	k_sem_give(&mq_sem);
+out:
+	if (ret != 0) {
+		errno = ret;
+		return -1;
+	}
 
 	return 0;
 }
 
-static void *mq_notify_thread(void *arg)
+/*
+ * SIGEV_THREAD notifications of all the queues are delivered by this thread,
+ * instead of a new pthread for each of them.
+ */
+static void mq_notify_thread(void *p1, void *p2, void *p3)
 {
-	mqueue_object *mqueue = (mqueue_object *)arg;
-	struct sigevent *sevp = &mqueue->not;
+	struct sigevent sev;
 
-	pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
 
-	if (sevp->sigev_notify_attributes == NULL) {
-		pthread_detach(pthread_self());
+	while (true) {
+		(void)k_msgq_get(&mq_notify_msgq, &sev, K_FOREVER);
+		sev.sigev_notify_function(sev.sigev_value);
 	}
-
-	sevp->sigev_notify_function(sevp->sigev_value);
-
-	remove_notification(mqueue);
-
-	return NULL;
 }
 
+K_THREAD_DEFINE(mq_notify_tid, CONFIG_POSIX_MQ_NOTIFY_STACK_SIZE, mq_notify_thread, NULL, NULL,
+		NULL, K_PRIO_PREEMPT(0), 0, 0);
+
 /* Internal functions */
-static mqueue_object *find_in_list(const char *name)
+static mqueue_object *find_in_table(const char *name, uint32_t hash)
 {
-	sys_snode_t *mq;
 	mqueue_object *msg_queue;
 
-	mq = mq_list.head;
-
-	while (mq != NULL) {
-		msg_queue = (mqueue_object *)mq;
-		if ((msg_queue->name != NULL) && (strcmp(msg_queue->name, name) == 0)) {
+	SYS_SLIST_FOR_EACH_CONTAINER(mq_bucket(hash), msg_queue, snode) {
+		if ((msg_queue->hash == hash) && (msg_queue->name != NULL) &&
+		    (strcmp(msg_queue->name, name) == 0)) {
 			return msg_queue;
 		}
-
-		mq = mq->next;
 	}
 
 	return NULL;
 }
 
+/* Wait until list is not empty, with the lock of msg_queue held */
+static int wait_not_empty(mqueue_object *msg_queue, struct k_condvar *cond, sys_slist_t *list,
+			 k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret;
+
+	while (sys_slist_is_empty(list)) {
+		ret = k_condvar_wait(cond, &msg_queue->lock, sys_timepoint_timeout(end));
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
 static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_len,
-			  k_timeout_t timeout)
+			    unsigned int msg_prio, k_timeout_t timeout)
 {
-	int32_t ret = -1;
+	mqueue_object *msg_queue;
+	mqueue_msg *msg, *prev = NULL, *next;
+	struct sigevent sev = {0};
+	bool notify = false;
+	int ret;
 
 	if (mqd == NULL) {
 		errno = EBADF;
-		return ret;
+		return -1;
 	}
 
-	if ((mqd->flags & O_NONBLOCK) != 0U) {
-		timeout = K_NO_WAIT;
+	if (msg_prio >= CONFIG_POSIX_MQ_PRIO_MAX) {
+		errno = EINVAL;
+		return -1;
 	}
 
-	if (msg_len >  mqd->mqueue->queue.msg_size) {
+	msg_queue = mqd->mqueue;
+	if (msg_len > msg_queue->msg_size) {
 		errno = EMSGSIZE;
-		return ret;
+		return -1;
 	}
 
-	uint32_t msgq_num = k_msgq_num_used_get(&mqd->mqueue->queue);
+	if ((mqd->flags & O_NONBLOCK) != 0U) {
+		timeout = K_NO_WAIT;
+	}
 
-	if (k_msgq_put(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	(void)k_mutex_lock(&msg_queue->lock, K_FOREVER);
+	ret = wait_not_empty(msg_queue, &msg_queue->not_full, &msg_queue->free_msgs, timeout);
+	if (ret != 0) {
+		k_mutex_unlock(&msg_queue->lock);
 		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-		return ret;
+		return -1;
 	}
 
-	if (k_msgq_num_used_get(&mqd->mqueue->queue) - msgq_num > 0) {
-		struct sigevent *sevp = &mqd->mqueue->not;
+	/* The message is copied once, into its slot */
+	msg = (mqueue_msg *)sys_slist_get_not_empty(&msg_queue->free_msgs);
+	msg->prio = msg_prio;
+	msg->len = msg_len;
+	memcpy(msg->data, msg_ptr, msg_len);
 
-		if (sevp->sigev_notify == SIGEV_NONE) {
-			sevp->sigev_notify_function(sevp->sigev_value);
-		} else if (sevp->sigev_notify == SIGEV_THREAD) {
-			pthread_t th;
-
-			ret = pthread_create(&th,
-					     sevp->sigev_notify_attributes,
-					     mq_notify_thread,
-					     mqd->mqueue);
+	SYS_SLIST_FOR_EACH_CONTAINER(&msg_queue->msgs, next, snode) {
+		if (next->prio < msg_prio) {
+			break;
+		}
+		prev = next;
+	}
+	sys_slist_insert(&msg_queue->msgs, (prev == NULL) ? NULL : &prev->snode, &msg->snode);
+	msg_queue->num_msgs++;
+
+	/* Notify when the queue becomes non-empty and nobody waits for it */
+	if (msg_queue->num_msgs == 1 && msg_queue->num_receivers == 0 &&
+	    (msg_queue->not.sigev_notify & SIGEV_MASK) != 0) {
+		sev = msg_queue->not;
+		memset(&msg_queue->not, 0, sizeof(struct sigevent));
+		notify = true;
+	}
+	k_condvar_signal(&msg_queue->not_empty);
+	k_mutex_unlock(&msg_queue->lock);
+
+	if (notify) {
+		if (sev.sigev_notify == SIGEV_NONE) {
+			sev.sigev_notify_function(sev.sigev_value);
+		} else if (sev.sigev_notify == SIGEV_THREAD) {
+			(void)k_msgq_put(&mq_notify_msgq, &sev, K_FOREVER);
 		}
 	}
 
@@ -491,30 +585,50 @@ static int32_t send_message(mqueue_desc *mqd, const char *msg_ptr, size_t msg_le
 }
 
 static int32_t receive_message(mqueue_desc *mqd, char *msg_ptr, size_t msg_len,
-			     k_timeout_t timeout)
+			       unsigned int *msg_prio, k_timeout_t timeout)
 {
-	int ret = -1;
+	mqueue_object *msg_queue;
+	mqueue_msg *msg;
+	int ret;
 
 	if (mqd == NULL) {
 		errno = EBADF;
-		return ret;
+		return -1;
 	}
 
-	if (msg_len < mqd->mqueue->queue.msg_size) {
+	msg_queue = mqd->mqueue;
+	if (msg_len < msg_queue->msg_size) {
 		errno = EMSGSIZE;
-		return ret;
+		return -1;
 	}
 
 	if ((mqd->flags & O_NONBLOCK) != 0U) {
 		timeout = K_NO_WAIT;
 	}
 
-	if (k_msgq_get(&mqd->mqueue->queue, (void *)msg_ptr, timeout) != 0) {
+	(void)k_mutex_lock(&msg_queue->lock, K_FOREVER);
+	msg_queue->num_receivers++;
+	ret = wait_not_empty(msg_queue, &msg_queue->not_empty, &msg_queue->msgs, timeout);
+	msg_queue->num_receivers--;
+	if (ret != 0) {
+		k_mutex_unlock(&msg_queue->lock);
 		errno = K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? EAGAIN : ETIMEDOUT;
-	} else {
-		ret = mqd->mqueue->queue.msg_size;
+		return -1;
 	}
 
+	/* Copied straight from its slot to the caller */
+	msg = (mqueue_msg *)sys_slist_get_not_empty(&msg_queue->msgs);
+	memcpy(msg_ptr, msg->data, msg->len);
+	ret = msg->len;
+	if (msg_prio != NULL) {
+		*msg_prio = msg->prio;
+	}
+
+	sys_slist_prepend(&msg_queue->free_msgs, &msg->snode);
+	msg_queue->num_msgs--;
+	k_condvar_signal(&msg_queue->not_full);
+	k_mutex_unlock(&msg_queue->lock);
+
 	return ret;
 }
 
@@ -522,7 +636,7 @@ static void remove_mq(mqueue_object *msg_queue)
 {
 	if (atomic_cas(&msg_queue->ref_count, 0, 0)) {
 		k_sem_take(&mq_sem, K_FOREVER);
-		sys_slist_find_and_remove(&mq_list, (sys_snode_t *) msg_queue);
+		sys_slist_find_and_remove(mq_bucket(msg_queue->hash), (sys_snode_t *)msg_queue);
 		k_sem_give(&mq_sem);
 
 		/* Free mq buffer and pbject */
@@ -530,10 +644,3 @@ static void remove_mq(mqueue_object *msg_queue)
 		k_free(msg_queue->mem_obj);
 	}
 }
-
-static void remove_notification(mqueue_object *msg_queue)
-{
-	k_sem_take(&mq_sem, K_FOREVER);
-	memset(&msg_queue->not, 0, sizeof(struct sigevent));
-	k_sem_give(&mq_sem);
-}
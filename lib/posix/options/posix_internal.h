@@ -64,6 +64,12 @@ struct posix_thread {
 
 	/* Queue ID (internal-only) */
 	uint8_t qid;
+
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+	/* Stack of a previous thread created with default attributes */
+	void *cached_stack;
+	bool cached_stack_user;
+#endif
 };
 
 struct posix_condattr {
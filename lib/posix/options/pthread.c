@@ -456,6 +456,14 @@ int pthread_attr_setinheritsched(pthread_attr_t *_attr, int inheritsched)
 	return 0;
 }
 
+static void posix_thread_attr_set_defaults(struct posix_thread_attr *attr)
+{
+	*attr = (struct posix_thread_attr){0};
+	attr->guardsize = CONFIG_POSIX_PTHREAD_ATTR_GUARDSIZE_DEFAULT;
+	attr->contentionscope = PTHREAD_SCOPE_SYSTEM;
+	attr->inheritsched = PTHREAD_INHERIT_SCHED;
+}
+
 static void posix_thread_recycle_work_handler(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -536,6 +544,78 @@ static void zephyr_thread_wrapper(void *arg1, void *arg2, void *arg3)
 	CODE_UNREACHABLE;
 }
 
+/* Keep the auto-allocated stack of t for the next thread with default attributes */
+static bool posix_thread_cache_stack(struct posix_thread *t)
+{
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+	if (t->attr.stack != NULL && t->cached_stack == NULL) {
+		t->cached_stack = t->attr.stack;
+		return true;
+	}
+#else
+	ARG_UNUSED(t);
+#endif
+
+	return false;
+}
+
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+/* Take a cached stack, the one of t if possible, else one of a ready thread */
+static void *posix_thread_take_cached_stack(struct posix_thread *t, bool user)
+{
+	struct posix_thread *c = NULL;
+	void *stack = NULL;
+
+	SYS_SEM_LOCK(&pthread_pool_lock) {
+		if (t != NULL && t->cached_stack != NULL && t->cached_stack_user == user) {
+			c = t;
+		} else {
+			SYS_DLIST_FOR_EACH_CONTAINER(&posix_thread_q[POSIX_THREAD_READY_Q], c,
+						     q_node) {
+				if (c->cached_stack != NULL && c->cached_stack_user == user) {
+					break;
+				}
+			}
+		}
+
+		if (c != NULL) {
+			stack = c->cached_stack;
+			c->cached_stack = NULL;
+		}
+	}
+
+	return stack;
+}
+#endif
+
+/* Initialize the default attributes of t, with a cached stack if there is one */
+static int posix_thread_attr_init_default(struct posix_thread *t)
+{
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+	bool user = k_is_user_context();
+	void *stack;
+
+	if (t->cached_stack != NULL && t->cached_stack_user != user) {
+		(void)k_thread_stack_free(t->cached_stack);
+		t->cached_stack = NULL;
+	}
+
+	stack = posix_thread_take_cached_stack(t, user);
+	if (stack != NULL) {
+		posix_thread_attr_set_defaults(&t->attr);
+		t->attr.stack = stack;
+		__set_attr_stacksize(&t->attr, DYNAMIC_STACK_SIZE);
+		t->attr.initialized = true;
+		return 0;
+	}
+
+	/* flags of the stack allocated below, once it is cached */
+	t->cached_stack_user = user;
+#endif
+
+	return pthread_attr_init((pthread_attr_t *)&t->attr);
+}
+
 static void posix_thread_recycle(void)
 {
 	struct posix_thread *t;
@@ -564,6 +644,8 @@ static void posix_thread_recycle(void)
 	SYS_DLIST_FOR_EACH_CONTAINER(&recyclables, t, q_node) {
 		if (t->attr.caller_destroys) {
 			t->attr = (struct posix_thread_attr){0};
+		} else if (posix_thread_cache_stack(t)) {
+			t->attr = (struct posix_thread_attr){0};
 		} else {
 			(void)pthread_attr_destroy((pthread_attr_t *)&t->attr);
 		}
@@ -630,7 +712,7 @@ int pthread_create(pthread_t *th, const pthread_attr_t *_attr, void *(*threadrou
 	}
 
 	if (_attr == NULL) {
-		err = pthread_attr_init((pthread_attr_t *)&t->attr);
+		err = posix_thread_attr_init_default(t);
 		if (err == 0 && !__attr_is_runnable(&t->attr)) {
 			(void)pthread_attr_destroy((pthread_attr_t *)&t->attr);
 			err = EINVAL;
@@ -944,14 +1026,17 @@ int pthread_attr_init(pthread_attr_t *_attr)
 
 	BUILD_ASSERT(DYNAMIC_STACK_SIZE <= PTHREAD_STACK_MAX);
 
-	*attr = (struct posix_thread_attr){0};
-	attr->guardsize = CONFIG_POSIX_PTHREAD_ATTR_GUARDSIZE_DEFAULT;
-	attr->contentionscope = PTHREAD_SCOPE_SYSTEM;
-	attr->inheritsched = PTHREAD_INHERIT_SCHED;
+	posix_thread_attr_set_defaults(attr);
 
 	if (DYNAMIC_STACK_SIZE > 0) {
 		attr->stack = k_thread_stack_alloc(DYNAMIC_STACK_SIZE + attr->guardsize,
 						   k_is_user_context() ? K_USER : 0);
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+		if (attr->stack == NULL) {
+			/* recycled threads may be holding all the stacks */
+			attr->stack = posix_thread_take_cached_stack(NULL, k_is_user_context());
+		}
+#endif
 		if (attr->stack == NULL) {
 			LOG_DBG("Did not auto-allocate thread stack");
 		} else {
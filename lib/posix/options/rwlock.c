@@ -14,13 +14,8 @@
 #include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/sem.h>
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_POSIX_THREAD_THREADS_MAX + 1)
-
 struct posix_rwlock {
-	struct sys_sem rd_sem;
-	struct sys_sem wr_sem;
-	struct sys_sem reader_active; /* blocks WR till reader has acquired lock */
-	k_tid_t wr_owner;
+	struct k_rwlock rwlock;
 };
 
 struct posix_rwlockattr {
@@ -124,10 +119,7 @@ int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 		return ENOMEM;
 	}
 
-	sys_sem_init(&rwl->rd_sem, CONCURRENT_READER_LIMIT, CONCURRENT_READER_LIMIT);
-	sys_sem_init(&rwl->wr_sem, 1, 1);
-	sys_sem_init(&rwl->reader_active, 1, 1);
-	rwl->wr_owner = NULL;
+	(void)k_rwlock_init(&rwl->rwlock);
 
 	LOG_DBG("Initialized rwlock %p", rwl);
 
@@ -153,7 +145,7 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 			SYS_SEM_LOCK_BREAK;
 		}
 
-		if (rwl->wr_owner != NULL) {
+		if (k_rwlock_writer_get(&rwl->rwlock) != NULL) {
 			ret = EBUSY;
 			SYS_SEM_LOCK_BREAK;
 		}
@@ -170,9 +162,6 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
@@ -190,9 +179,6 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
@@ -221,9 +207,6 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for reading immediately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -241,8 +224,8 @@ int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, and readers waiting when a
+ * writer releases the lock get it before the next writer.
  *
  * See IEEE 1003.1
  */
@@ -261,8 +244,8 @@ int pthread_rwlock_wrlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for writing within specific time.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, and readers waiting when a
+ * writer releases the lock get it before the next writer.
  *
  * See IEEE 1003.1
  */
@@ -292,8 +275,8 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 /**
  * @brief Lock a read-write lock object for writing immediately.
  *
- * Write lock does not have priority over reader lock,
- * threads get lock based on priority.
+ * A waiting writer holds back new readers, and readers waiting when a
+ * writer releases the lock get it before the next writer.
  *
  * See IEEE 1003.1
  */
@@ -324,69 +307,31 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 		return EINVAL;
 	}
 
-	if (k_current_get() == rwl->wr_owner) {
-		/* Write unlock */
-		rwl->wr_owner = NULL;
-		(void)sys_sem_give(&rwl->reader_active);
-		(void)sys_sem_give(&rwl->wr_sem);
-	} else {
-		/* Read unlock */
-		(void)sys_sem_give(&rwl->rd_sem);
-
-		if (sys_sem_count_get(&rwl->rd_sem) == CONCURRENT_READER_LIMIT) {
-			/* Last read lock, unlock writer */
-			(void)sys_sem_give(&rwl->reader_active);
-		}
+	if (k_rwlock_writer_get(&rwl->rwlock) == k_current_get()) {
+		(void)k_rwlock_write_unlock(&rwl->rwlock);
+	} else if (k_rwlock_read_unlock(&rwl->rwlock) != 0) {
+		return EPERM;
 	}
+
 	return 0;
 }
 
 static uint32_t read_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
 {
-	uint32_t ret = 0U;
-
-	if (sys_sem_take(&rwl->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		(void)sys_sem_take(&rwl->reader_active, K_NO_WAIT);
-		(void)sys_sem_take(&rwl->rd_sem, K_NO_WAIT);
-		(void)sys_sem_give(&rwl->wr_sem);
-	} else {
-		ret = EBUSY;
+	if (k_rwlock_read_lock(&rwl->rwlock, SYS_TIMEOUT_MS(timeout)) != 0) {
+		return EBUSY;
 	}
 
-	return ret;
+	return 0U;
 }
 
 static uint32_t write_lock_acquire(struct posix_rwlock *rwl, uint32_t timeout)
 {
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (sys_sem_take(&rwl->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (sys_sem_take(&rwl->reader_active, k_timeout) == 0) {
-			rwl->wr_owner = k_current_get();
-		} else {
-			(void)sys_sem_give(&rwl->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
+	if (k_rwlock_write_lock(&rwl->rwlock, SYS_TIMEOUT_MS(timeout)) != 0) {
+		return EBUSY;
 	}
-	return ret;
+
+	return 0U;
 }
 
 int pthread_rwlockattr_getpshared(const pthread_rwlockattr_t *ZRESTRICT attr,
@@ -18,11 +18,17 @@
 #include <zephyr/posix/signal.h>
 #include <zephyr/posix/time.h>
 
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+#include <zephyr/drivers/counter.h>
+#endif
+
 #define ACTIVE 1
 #define NOT_ACTIVE 0
 
 LOG_MODULE_REGISTER(posix_timer);
 
+extern int z_clock_gettime(clockid_t clock_id, struct timespec *ts);
+
 static void zephyr_timer_wrapper(struct k_timer *ztimer);
 
 struct timer_obj {
@@ -31,8 +37,18 @@ struct timer_obj {
 	struct k_sem sem_cond;
 	pthread_t thread;
 	struct timespec interval;	/* Reload value */
-	uint32_t reload;			/* Reload value in ms */
+	k_ticks_t reload;		/* Reload value in ticks */
 	uint32_t status;
+	clockid_t clockid;
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+	/* Counter channel, or -1 when the timer runs on the k_timer */
+	int chan;
+	/* Period and next expiry, in counter ticks */
+	uint32_t period;
+	uint32_t expiry;
+	/* Expirations since the last timer_getoverrun() */
+	atomic_t expirations;
+#endif
 };
 
 K_MEM_SLAB_DEFINE(posix_timer_slab, sizeof(struct timer_obj), CONFIG_POSIX_TIMER_MAX,
@@ -105,6 +121,163 @@ static void zephyr_timer_interrupt(struct k_timer *ztimer)
 	k_sem_give(&timer->sem_cond);
 }
 
+static inline uint64_t ts_to_ns(const struct timespec *ts)
+{
+	return (uint64_t)ts->tv_sec * NSEC_PER_SEC + ts->tv_nsec;
+}
+
+static inline void ns_to_ts(uint64_t ns, struct timespec *ts)
+{
+	ts->tv_sec = ns / NSEC_PER_SEC;
+	ts->tv_nsec = ns % NSEC_PER_SEC;
+}
+
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+/*
+ * Timers needing a finer resolution than the system tick run on the channels
+ * of a hardware counter, when one is free. The others use a k_timer.
+ */
+static const struct device *const hr_counter =
+	DEVICE_DT_GET(DT_CHOSEN(zephyr_posix_timer_counter));
+static atomic_t hr_chans_used;
+static atomic_t hr_started;
+
+static uint32_t hr_add(uint32_t a, uint32_t b)
+{
+	uint64_t top = counter_get_top_value(hr_counter);
+	uint64_t sum = (uint64_t)a + b;
+
+	return (sum > top) ? (sum - top - 1) : sum;
+}
+
+static uint64_t hr_ns_to_ticks(uint64_t ns)
+{
+	return DIV_ROUND_UP(ns * counter_get_frequency(hr_counter), NSEC_PER_SEC);
+}
+
+static void hr_alarm(const struct device *dev, uint8_t chan, uint32_t ticks, void *user_data);
+
+static void hr_arm(struct timer_obj *timer, uint32_t expiry)
+{
+	const struct counter_alarm_cfg cfg = {
+		.callback = hr_alarm,
+		.ticks = expiry,
+		.user_data = timer,
+		.flags = COUNTER_ALARM_CFG_ABSOLUTE | COUNTER_ALARM_CFG_EXPIRE_WHEN_LATE,
+	};
+	int ret;
+
+	timer->expiry = expiry;
+	ret = counter_set_channel_alarm(hr_counter, timer->chan, &cfg);
+	/* -ETIME: the alarm was late and expires right away */
+	__ASSERT(ret == 0 || ret == -ETIME, "counter_set_channel_alarm() failed: %d", ret);
+	ARG_UNUSED(ret);
+}
+
+static void hr_alarm(const struct device *dev, uint8_t chan, uint32_t ticks, void *user_data)
+{
+	struct timer_obj *timer = user_data;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(chan);
+	ARG_UNUSED(ticks);
+
+	atomic_inc(&timer->expirations);
+
+	/* Next expiry relative to the previous one, so that the period does not drift */
+	if (timer->period != 0U) {
+		hr_arm(timer, hr_add(timer->expiry, timer->period));
+	} else {
+		timer->status = NOT_ACTIVE;
+	}
+
+	if (timer->evp.sigev_notify == SIGEV_SIGNAL) {
+		zephyr_timer_wrapper(&timer->ztimer);
+	} else if (timer->evp.sigev_notify == SIGEV_THREAD) {
+		k_sem_give(&timer->sem_cond);
+	}
+}
+
+/* Start timer on a counter channel if it needs it, returns false to use the k_timer */
+static bool hr_start(struct timer_obj *timer, uint64_t duration_ns, uint64_t interval_ns)
+{
+	uint64_t res_ns = (interval_ns != 0U) ? interval_ns : duration_ns;
+	uint64_t max_ns;
+	uint32_t now;
+	int chan;
+
+	/* A whole number of ticks is as accurate on the k_timer */
+	if (!device_is_ready(hr_counter) ||
+	    k_ns_to_ticks_floor64(res_ns) == k_ns_to_ticks_ceil64(res_ns)) {
+		return false;
+	}
+
+	max_ns = counter_ticks_to_us(hr_counter, counter_get_top_value(hr_counter)) *
+		 NSEC_PER_USEC;
+	if (duration_ns > max_ns || interval_ns > max_ns) {
+		return false;
+	}
+
+	for (chan = 0; chan < MIN(counter_get_num_of_channels(hr_counter), ATOMIC_BITS); chan++) {
+		if (!atomic_test_and_set_bit(&hr_chans_used, chan)) {
+			break;
+		}
+	}
+	if (chan == MIN(counter_get_num_of_channels(hr_counter), ATOMIC_BITS)) {
+		LOG_DBG("no free counter channel");
+		return false;
+	}
+
+	if (atomic_cas(&hr_started, 0, 1)) {
+		(void)counter_start(hr_counter);
+	}
+
+	timer->chan = chan;
+	timer->period = hr_ns_to_ticks(interval_ns);
+	(void)atomic_clear(&timer->expirations);
+	(void)counter_get_value(hr_counter, &now);
+	timer->status = ACTIVE;
+	hr_arm(timer, hr_add(now, MAX(hr_ns_to_ticks(duration_ns), 1)));
+
+	return true;
+}
+
+static void hr_stop(struct timer_obj *timer)
+{
+	if (timer->chan >= 0) {
+		(void)counter_cancel_channel_alarm(hr_counter, timer->chan);
+		atomic_clear_bit(&hr_chans_used, timer->chan);
+		timer->chan = -1;
+	}
+}
+
+static uint64_t hr_remaining_ns(struct timer_obj *timer)
+{
+	uint32_t now;
+	uint64_t ticks;
+
+	(void)counter_get_value(hr_counter, &now);
+	ticks = (timer->expiry >= now)
+			? (timer->expiry - now)
+			: ((uint64_t)counter_get_top_value(hr_counter) + 1 - now + timer->expiry);
+
+	return ticks * NSEC_PER_SEC / counter_get_frequency(hr_counter);
+}
+#endif /* CONFIG_POSIX_TIMER_COUNTER */
+
+/* Stop timer, wherever it runs */
+static void timer_stop(struct timer_obj *timer)
+{
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+	if (timer->chan >= 0) {
+		hr_stop(timer);
+		return;
+	}
+#endif
+
+	k_timer_stop(&timer->ztimer);
+}
+
 /**
  * @brief Create a per-process timer.
  *
@@ -133,6 +306,10 @@ int timer_create(clockid_t clockid, struct sigevent *evp, timer_t *timerid)
 
 	*timer = (struct timer_obj){0};
 	timer->evp = *evp;
+	timer->clockid = clockid;
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+	timer->chan = -1;
+#endif
 	evp = &timer->evp;
 
 	switch (evp->sigev_notify) {
@@ -208,8 +385,7 @@ out:
 int timer_gettime(timer_t timerid, struct itimerspec *its)
 {
 	struct timer_obj *timer = (struct timer_obj *)timerid;
-	int32_t remaining, leftover;
-	int64_t   nsecs, secs;
+	uint64_t remaining;
 
 	if (timer == NULL) {
 		errno = EINVAL;
@@ -217,12 +393,15 @@ int timer_gettime(timer_t timerid, struct itimerspec *its)
 	}
 
 	if (timer->status == ACTIVE) {
-		remaining = k_timer_remaining_get(&timer->ztimer);
-		secs =  remaining / MSEC_PER_SEC;
-		leftover = remaining - (secs * MSEC_PER_SEC);
-		nsecs = (int64_t)leftover * NSEC_PER_MSEC;
-		its->it_value.tv_sec = (int32_t) secs;
-		its->it_value.tv_nsec = (int32_t) nsecs;
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+		if (timer->chan >= 0) {
+			remaining = hr_remaining_ns(timer);
+		} else
+#endif
+		{
+			remaining = k_ticks_to_ns_floor64(k_timer_remaining_ticks(&timer->ztimer));
+		}
+		ns_to_ts(remaining, &its->it_value);
 	} else {
 		/* Timer is disarmed */
 		its->it_value.tv_sec = 0;
@@ -243,7 +422,8 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 		  struct itimerspec *ovalue)
 {
 	struct timer_obj *timer = (struct timer_obj *) timerid;
-	uint32_t duration, current;
+	uint64_t duration, interval;
+	struct timespec now;
 
 	if ((timer == NULL) || !timespec_is_valid(&value->it_interval) ||
 	    !timespec_is_valid(&value->it_value)) {
@@ -256,39 +436,40 @@ int timer_settime(timer_t timerid, int flags, const struct itimerspec *value,
 		timer_gettime(timerid, ovalue);
 	}
 
+	/* Also releases the counter channel of an expired one-shot timer */
+	timer_stop(timer);
+
 	/* Stop the timer if the value is 0 */
 	if ((value->it_value.tv_sec == 0) && (value->it_value.tv_nsec == 0)) {
-		if (timer->status == ACTIVE) {
-			k_timer_stop(&timer->ztimer);
-		}
-
 		timer->status = NOT_ACTIVE;
 		return 0;
 	}
 
 	/* Calculate timer period */
-	timer->reload = ts_to_ms(&value->it_interval);
+	interval = ts_to_ns(&value->it_interval);
+	timer->reload = k_ns_to_ticks_ceil64(interval);
 	timer->interval.tv_sec = value->it_interval.tv_sec;
 	timer->interval.tv_nsec = value->it_interval.tv_nsec;
 
 	/* Calculate timer duration */
-	duration = ts_to_ms(&(value->it_value));
+	duration = ts_to_ns(&value->it_value);
 	if ((flags & TIMER_ABSTIME) != 0) {
-		current = k_timer_remaining_get(&timer->ztimer);
-
-		if (current >= duration) {
-			duration = 0U;
-		} else {
-			duration -= current;
+		if (z_clock_gettime(timer->clockid, &now) != 0) {
+			return -1;
 		}
+
+		duration = (duration > ts_to_ns(&now)) ? (duration - ts_to_ns(&now)) : 0U;
 	}
 
-	if (timer->status == ACTIVE) {
-		k_timer_stop(&timer->ztimer);
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+	if (hr_start(timer, duration, interval)) {
+		return 0;
 	}
+#endif
 
 	timer->status = ACTIVE;
-	k_timer_start(&timer->ztimer, K_MSEC(duration), K_MSEC(timer->reload));
+	k_timer_start(&timer->ztimer, K_TICKS(k_ns_to_ticks_ceil64(duration)),
+		      K_TICKS(timer->reload));
 	return 0;
 }
 
@@ -306,7 +487,16 @@ int timer_getoverrun(timer_t timerid)
 		return -1;
 	}
 
-	int overruns = k_timer_status_get(&timer->ztimer) - 1;
+	int overruns;
+
+#ifdef CONFIG_POSIX_TIMER_COUNTER
+	if (timer->chan >= 0) {
+		overruns = atomic_clear(&timer->expirations) - 1;
+	} else
+#endif
+	{
+		overruns = k_timer_status_get(&timer->ztimer) - 1;
+	}
 
 	if (overruns > CONFIG_POSIX_DELAYTIMER_MAX) {
 		overruns = CONFIG_POSIX_DELAYTIMER_MAX;
@@ -329,10 +519,8 @@ int timer_delete(timer_t timerid)
 		return -1;
 	}
 
-	if (timer->status == ACTIVE) {
-		timer->status = NOT_ACTIVE;
-		k_timer_stop(&timer->ztimer);
-	}
+	timer->status = NOT_ACTIVE;
+	timer_stop(timer);
 
 	if (timer->evp.sigev_notify == SIGEV_THREAD) {
 		(void)pthread_cancel(timer->thread);
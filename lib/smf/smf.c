@@ -21,9 +21,78 @@ struct internal_ctx {
 	bool handled: 1;
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+int smf_table_init(struct smf_table *table)
+{
+	for (size_t i = 0; i < table->num_states; i++) {
+		const struct smf_state **row = &table->paths[i * table->max_levels];
+		size_t levels = 0;
+
+		for (const struct smf_state *state = &table->states[i]; state != NULL;
+		     state = state->parent) {
+			if ((state < table->states) ||
+			    (state >= &table->states[table->num_states])) {
+				LOG_ERR("state %p is not in the table", state);
+				return -EINVAL;
+			}
+
+			if (levels == table->max_levels) {
+				return -ENOSPC;
+			}
+
+			levels++;
+		}
+
+		/* Fill the row from the state up to its topmost ancestor */
+		table->depth[i] = levels - 1;
+		for (const struct smf_state *state = &table->states[i]; state != NULL;
+		     state = state->parent) {
+			row[--levels] = state;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the path from the topmost ancestor of a state to the state
+ *
+ * @param table Transition table
+ * @param state State of the table
+ * @param depth Set to the index of the state in the path
+ * @return The path
+ */
+static const struct smf_state *const *table_path(const struct smf_table *table,
+						 const struct smf_state *state, uint8_t *depth)
+{
+	size_t i = state - table->states;
+
+	__ASSERT(i < table->num_states, "state %p is not in the transition table", state);
+
+	*depth = table->depth[i];
+
+	return &table->paths[i * table->max_levels];
+}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 #ifdef CONFIG_SMF_ANCESTOR_SUPPORT
-static bool share_paren(const struct smf_state *test_state, const struct smf_state *target_state)
+static bool share_paren(const struct smf_ctx *ctx, const struct smf_state *test_state,
+			const struct smf_state *target_state)
 {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	if (ctx->table != NULL) {
+		uint8_t test_depth, target_depth;
+		const struct smf_state *const *path =
+			table_path(ctx->table, test_state, &test_depth);
+
+		(void)table_path(ctx->table, target_state, &target_depth);
+
+		return (target_depth <= test_depth) && (path[target_depth] == target_state);
+	}
+#else
+	ARG_UNUSED(ctx);
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 	for (const struct smf_state *state = test_state; state != NULL; state = state->parent) {
 		if (target_state == state) {
 			return true;
@@ -59,18 +128,42 @@ static const struct smf_state *get_last_of(const struct smf_state *states)
 /**
  * @brief Find the Least Common Ancestor (LCA) of two states
  *
+ * @param ctx State machine context
  * @param source transition source
  * @param dest transition destination
  * @return LCA state, or NULL if states have no LCA.
  */
-static const struct smf_state *get_lca_of(const struct smf_state *source,
+static const struct smf_state *get_lca_of(const struct smf_ctx *ctx,
+					  const struct smf_state *source,
 					  const struct smf_state *dest)
 {
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	if (ctx->table != NULL) {
+		uint8_t source_depth, dest_depth, i;
+		const struct smf_state *const *source_path =
+			table_path(ctx->table, source, &source_depth);
+		const struct smf_state *const *dest_path =
+			table_path(ctx->table, dest, &dest_depth);
+
+		/* The paths share their topmost states, down to the deepest common ancestor */
+		for (i = 0; (i < source_depth) && (i <= dest_depth) &&
+			    (source_path[i] == dest_path[i]);
+		     i++) {
+		}
+
+		if (i == 0) {
+			return NULL;
+		}
+
+		return (source_path[i - 1] == dest) ? dest->parent : source_path[i - 1];
+	}
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
+
 	for (const struct smf_state *ancestor = source->parent; ancestor != NULL;
 	     ancestor = ancestor->parent) {
 		if (ancestor == dest) {
 			return ancestor->parent;
-		} else if (share_paren(dest, ancestor)) {
+		} else if (share_paren(ctx, dest, ancestor)) {
 			return ancestor;
 		}
 	}
@@ -97,6 +190,34 @@ static bool smf_execute_all_entry_actions(struct smf_ctx *const ctx,
 		return false;
 	}
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	if (ctx->table != NULL) {
+		uint8_t depth, topmost_depth, i;
+		const struct smf_state *const *path = table_path(ctx->table, new_state, &depth);
+
+		/* Start below topmost, or only enter new_state if it does not contain it */
+		if (topmost == NULL) {
+			i = 0;
+		} else if (share_paren(ctx, new_state, topmost)) {
+			(void)table_path(ctx->table, topmost, &topmost_depth);
+			i = topmost_depth + 1;
+		} else {
+			i = depth;
+		}
+
+		for (; i < depth; i++) {
+			ctx->executing = path[i];
+			if (path[i]->entry) {
+				path[i]->entry(ctx);
+
+				/* No need to continue if terminate was set */
+				if (internal->terminate) {
+					return true;
+				}
+			}
+		}
+	} else
+#endif /* CONFIG_SMF_TRANSITION_TABLE */
 	for (const struct smf_state *to_execute = get_child_of(new_state, topmost);
 	     to_execute != NULL && to_execute != new_state;
 	     to_execute = get_child_of(new_state, to_execute)) {
@@ -288,15 +409,15 @@ void smf_set_state(struct smf_ctx *const ctx, const struct smf_state *new_state)
 #ifdef CONFIG_SMF_ANCESTOR_SUPPORT
 	const struct smf_state *topmost;
 
-	if (share_paren(ctx->executing, new_state)) {
+	if (share_paren(ctx, ctx->executing, new_state)) {
 		/* new state is a parent of where we are now*/
 		topmost = new_state;
-	} else if (share_paren(new_state, ctx->executing)) {
+	} else if (share_paren(ctx, new_state, ctx->executing)) {
 		/* we are a parent of the new state */
 		topmost = ctx->executing;
 	} else {
 		/* not directly related, find LCA */
-		topmost = get_lca_of(ctx->executing, new_state);
+		topmost = get_lca_of(ctx, ctx->executing, new_state);
 	}
 
 	internal->is_exit = true;
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <errno.h>
+#include <string.h>
 #include <zephyr/sys/base64.h>
 
 static const uint8_t base64_enc_map[64] = {
@@ -54,14 +55,75 @@ static const uint8_t base64_dec_map[128] = {
 
 #define BASE64_SIZE_T_MAX	((size_t) -1) /* SIZE_T_MAX is not standard */
 
+/*
+ * Encode ngroups groups of 3 bytes, working on the 24 bits of each group
+ * at once
+ */
+static uint8_t *encode_groups(uint8_t *p, const uint8_t *src, size_t ngroups)
+{
+	uint32_t x;
+
+	for (; ngroups > 0; ngroups--, src += 3) {
+		x = ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+
+		p[0] = base64_enc_map[x >> 18];
+		p[1] = base64_enc_map[(x >> 12) & 0x3F];
+		p[2] = base64_enc_map[(x >> 6) & 0x3F];
+		p[3] = base64_enc_map[x & 0x3F];
+		p += 4;
+	}
+
+	return p;
+}
+
+/*
+ * Encode the last 1 or 2 bytes of the input, with padding
+ */
+static uint8_t *encode_tail(uint8_t *p, const uint8_t *src, size_t len)
+{
+	uint32_t x = ((uint32_t)src[0] << 16) | ((len > 1) ? ((uint32_t)src[1] << 8) : 0U);
+
+	p[0] = base64_enc_map[x >> 18];
+	p[1] = base64_enc_map[(x >> 12) & 0x3F];
+	p[2] = (len > 1) ? base64_enc_map[(x >> 6) & 0x3F] : '=';
+	p[3] = '=';
+
+	return p + 4;
+}
+
+/*
+ * Value of 4 symbols, or -1 if any of them is not a base64 symbol (a
+ * padding, a white space or an invalid character). Most of the input goes
+ * through this, the slower per-character paths only see what is left.
+ */
+static inline int32_t decode_quad(const uint8_t *src)
+{
+	uint32_t a, b, c, d;
+
+	if (((src[0] | src[1] | src[2] | src[3]) & 0x80) != 0U) {
+		return -1;
+	}
+
+	a = base64_dec_map[src[0]];
+	b = base64_dec_map[src[1]];
+	c = base64_dec_map[src[2]];
+	d = base64_dec_map[src[3]];
+
+	/* Symbols are below 64, padding is 64 and invalid characters 127 */
+	if (((a | b | c | d) & 0xC0) != 0U) {
+		return -1;
+	}
+
+	return (int32_t)((a << 18) | (b << 12) | (c << 6) | d);
+}
+
 /*
  * Encode a buffer into base64 format
  */
 int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		  size_t slen)
 {
-	size_t i, n;
-	int C1, C2, C3;
+	size_t n;
 	uint8_t *p;
 
 	if (slen == 0) {
@@ -83,37 +145,87 @@ int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		return -ENOMEM;
 	}
 
-	n = (slen / 3) * 3;
+	p = encode_groups(dst, src, slen / 3);
+
+	if ((slen % 3) != 0) {
+		p = encode_tail(p, &src[slen - slen % 3], slen % 3);
+	}
+
+	*olen = p - dst;
+	*p = 0U;
+
+	return 0;
+}
+
+void base64_encode_init(struct base64_encode_ctx *ctx)
+{
+	ctx->len = 0U;
+}
+
+int base64_encode_update(struct base64_encode_ctx *ctx, uint8_t *dst, size_t dlen,
+			 size_t *olen, const uint8_t *src, size_t slen)
+{
+	size_t ngroups, n;
+	uint8_t *p = dst;
+
+	if (slen > BASE64_SIZE_T_MAX - ctx->len) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	ngroups = (ctx->len + slen) / 3;
+
+	if (ngroups > BASE64_SIZE_T_MAX / 4) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	n = ngroups * 4;
 
-	for (i = 0, p = dst; i < n; i += 3) {
-		C1 = *src++;
-		C2 = *src++;
-		C3 = *src++;
+	if ((n > 0) && ((dlen < n) || (dst == NULL))) {
+		*olen = n;
+		return -ENOMEM;
+	}
 
-		*p++ = base64_enc_map[(C1 >> 2) & 0x3F];
-		*p++ = base64_enc_map[(((C1 &  3) << 4) + (C2 >> 4)) & 0x3F];
-		*p++ = base64_enc_map[(((C2 & 15) << 2) + (C3 >> 6)) & 0x3F];
-		*p++ = base64_enc_map[C3 & 0x3F];
+	/* Complete the group left over by the previous call */
+	if ((ctx->len > 0U) && (ngroups > 0)) {
+		n = 3U - ctx->len;
+		memcpy(&ctx->buf[ctx->len], src, n);
+		p = encode_groups(p, ctx->buf, 1);
+		src += n;
+		slen -= n;
+		ngroups--;
+		ctx->len = 0U;
 	}
 
-	if (i < slen) {
-		C1 = *src++;
-		C2 = ((i + 1) < slen) ? *src++ : 0;
+	p = encode_groups(p, src, ngroups);
+	src += ngroups * 3;
+	slen -= ngroups * 3;
 
-		*p++ = base64_enc_map[(C1 >> 2) & 0x3F];
-		*p++ = base64_enc_map[(((C1 & 3) << 4) + (C2 >> 4)) & 0x3F];
+	memcpy(&ctx->buf[ctx->len], src, slen);
+	ctx->len += slen;
+
+	*olen = p - dst;
 
-		if ((i + 1) < slen) {
-			*p++ = base64_enc_map[((C2 & 15) << 2) & 0x3F];
-		} else {
-			*p++ = '=';
+	return 0;
+}
+
+int base64_encode_finish(struct base64_encode_ctx *ctx, uint8_t *dst, size_t dlen,
+			 size_t *olen)
+{
+	uint8_t *p = dst;
+
+	if (ctx->len > 0U) {
+		if ((dlen < 4) || (dst == NULL)) {
+			*olen = 4;
+			return -ENOMEM;
 		}
 
-		*p++ = '=';
+		p = encode_tail(p, ctx->buf, ctx->len);
+		ctx->len = 0U;
 	}
 
 	*olen = p - dst;
-	*p = 0U;
 
 	return 0;
 }
@@ -130,6 +242,12 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	/* First pass: check for validity and get output length */
 	for (i = n = j = 0U; i < slen; i++) {
+		/* Runs of symbols are valid as long as no padding came before */
+		while ((j == 0U) && ((slen - i) >= 4) && (decode_quad(&src[i]) >= 0)) {
+			i += 4;
+			n += 4;
+		}
+
 		/* Skip spaces before checking for EOL */
 		x = 0U;
 		while (i < slen && src[i] == ' ') {
@@ -188,6 +306,20 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 	}
 
 	for (j = 3U, n = x = 0U, p = dst; i > 0; i--, src++) {
+		int32_t quad;
+
+		/* Decode aligned runs of symbols 4 at a time */
+		while ((n == 0U) && (i >= 4) && ((quad = decode_quad(src)) >= 0)) {
+			*p++ = (uint8_t)(quad >> 16);
+			*p++ = (uint8_t)(quad >> 8);
+			*p++ = (uint8_t)quad;
+			src += 4;
+			i -= 4;
+		}
+
+		if (i == 0) {
+			break;
+		}
 
 		if (*src == '\r' || *src == '\n' || *src == ' ') {
 			continue;
@@ -26,6 +26,55 @@ struct bundle_data {
 	uint32_t smask, emask;
 };
 
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+/* Number of summary words */
+#define summary_words(ba)	DIV_ROUND_UP((ba)->num_bundles, bundle_bitness(ba))
+
+/* Keep the summary bit of a bundle in sync: set when the bundle is full */
+static inline void summary_update(sys_bitarray_t *bitarray, size_t idx)
+{
+	uint32_t bit = BIT(idx % bundle_bitness(bitarray));
+
+	if (~bitarray->bundles[idx] == 0U) {
+		bitarray->summary[idx / bundle_bitness(bitarray)] |= bit;
+	} else {
+		bitarray->summary[idx / bundle_bitness(bitarray)] &= ~bit;
+	}
+}
+
+static void summary_update_range(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	for (size_t idx = sidx; idx <= eidx; idx++) {
+		summary_update(bitarray, idx);
+	}
+}
+
+/* Find the first bundle at or after idx which is not full */
+static size_t summary_next_free(sys_bitarray_t *bitarray, size_t idx)
+{
+	size_t sidx = idx / bundle_bitness(bitarray);
+	uint32_t word;
+
+	if (idx >= bitarray->num_bundles) {
+		return bitarray->num_bundles;
+	}
+
+	word = ~bitarray->summary[sidx] & ~(BIT(idx % bundle_bitness(bitarray)) - 1);
+	while (word == 0U) {
+		if (++sidx >= summary_words(bitarray)) {
+			return bitarray->num_bundles;
+		}
+		word = ~bitarray->summary[sidx];
+	}
+
+	return MIN(sidx * bundle_bitness(bitarray) + find_lsb_set(word) - 1,
+		   bitarray->num_bundles);
+}
+#else
+#define summary_update(bitarray, idx)
+#define summary_update_range(bitarray, sidx, eidx)
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+
 static void setup_bundle_data(sys_bitarray_t *bitarray,
 			      struct bundle_data *bd,
 			      size_t offset, size_t num_bits)
@@ -208,6 +257,74 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	summary_update_range(bitarray, bd->sidx, bd->eidx);
+}
+
+/*
+ * Find the first clear bit at or after a given bit, a bundle at a time.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Bit to start from
+ *
+ * @return Offset of the clear bit, or num_bits if there is none.
+ */
+static size_t find_next_clear(sys_bitarray_t *bitarray, size_t bit)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	if (bit >= bitarray->num_bits) {
+		return bitarray->num_bits;
+	}
+
+	bundle = ~bitarray->bundles[idx] & ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+	while (bundle == 0U) {
+#ifdef CONFIG_SYS_BITARRAY_SUMMARY
+		/* Skip full bundles a summary word at a time */
+		idx = summary_next_free(bitarray, idx + 1);
+#else
+		idx++;
+#endif /* CONFIG_SYS_BITARRAY_SUMMARY */
+		if (idx >= bitarray->num_bundles) {
+			return bitarray->num_bits;
+		}
+		bundle = ~bitarray->bundles[idx];
+	}
+
+	/* Bits past num_bits in the last bundle are always clear */
+	return MIN(idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1,
+		   bitarray->num_bits);
+}
+
+/*
+ * Find the first set bit in a region, a bundle at a time.
+ *
+ * @param bitarray Bitarray struct
+ * @param bit      Start of the region
+ * @param end      End of the region, exclusive, no greater than num_bits
+ *
+ * @return Offset of the set bit, or end if there is none.
+ */
+static size_t find_next_set(sys_bitarray_t *bitarray, size_t bit, size_t end)
+{
+	size_t idx = bit / bundle_bitness(bitarray);
+	uint32_t bundle;
+
+	if (bit >= end) {
+		return end;
+	}
+
+	bundle = bitarray->bundles[idx] & ~(BIT(bit % bundle_bitness(bitarray)) - 1);
+	while (bundle == 0U) {
+		idx++;
+		if ((idx * bundle_bitness(bitarray)) >= end) {
+			return end;
+		}
+		bundle = bitarray->bundles[idx];
+	}
+
+	return MIN(idx * bundle_bitness(bitarray) + find_lsb_set(bundle) - 1, end);
 }
 
 int sys_bitarray_popcount_region(sys_bitarray_t *bitarray, size_t num_bits, size_t offset,
@@ -309,6 +426,8 @@ int sys_bitarray_xor(sys_bitarray_t *dst, sys_bitarray_t *other, size_t num_bits
 		}
 	}
 
+	summary_update_range(dst, bd.sidx, bd.eidx);
+
 	ret = 0;
 
 out:
@@ -337,6 +456,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	summary_update(bitarray, idx);
 
 	ret = 0;
 
@@ -365,6 +485,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	summary_update(bitarray, idx);
 
 	ret = 0;
 
@@ -441,6 +562,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	summary_update(bitarray, idx);
 
 	ret = 0;
 
@@ -480,6 +602,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	summary_update(bitarray, idx);
 
 	ret = 0;
 
@@ -492,11 +615,9 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
+	size_t bit_idx, run_end;
+	size_t off_end;
 	int ret;
-	struct bundle_data bd;
-	size_t off_start, off_end;
-	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
@@ -513,46 +634,24 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
-
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
+	/* Go from one run of free bits to the next, looking at bundles
+	 * instead of individual bits, until one is long enough.
 	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
-
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
-
-		break;
-	}
-
 	off_end = bitarray->num_bits - num_bits;
+	bit_idx = find_next_clear(bitarray, 0);
 	ret = -ENOSPC;
 	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
+		run_end = find_next_set(bitarray, bit_idx, bit_idx + num_bits);
+		if (run_end == (bit_idx + num_bits)) {
+			set_region(bitarray, bit_idx, num_bits, true, NULL);
 
 			*offset = bit_idx;
 			ret = 0;
 			break;
 		}
 
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
+		/* Fast-forward past the allocated bits */
+		bit_idx = find_next_clear(bitarray, run_end);
 	}
 
 out:
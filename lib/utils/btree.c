@@ -0,0 +1,455 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/btree.h>
+
+/*
+ * Classic B-tree with minimum degree T: every node but the root has between
+ * T - 1 and 2T - 1 keys. Both insertion and removal fix nodes on the way
+ * down, splitting full nodes before entering them and filling minimal ones,
+ * so neither has to walk back up.
+ */
+
+#define BTREE_T	       CONFIG_SYS_BTREE_MIN_DEGREE
+#define BTREE_MAX_KEYS (2 * BTREE_T - 1)
+
+BUILD_ASSERT(BTREE_MAX_KEYS <= UINT16_MAX);
+
+struct sys_btree_node {
+	uint16_t num_keys;
+	bool leaf;
+	uint64_t keys[BTREE_MAX_KEYS];
+	uint64_t values[BTREE_MAX_KEYS];
+	/* Only allocated for internal nodes */
+	struct sys_btree_node *children[];
+};
+
+static struct sys_btree_node *btree_node_alloc(struct sys_btree *tree, bool leaf)
+{
+	size_t size = sizeof(struct sys_btree_node);
+	struct sys_btree_node *node;
+
+	if (!leaf) {
+		size += (BTREE_MAX_KEYS + 1) * sizeof(struct sys_btree_node *);
+	}
+
+	node = tree->alloc_func(NULL, size);
+	if (node != NULL) {
+		node->num_keys = 0;
+		node->leaf = leaf;
+	}
+
+	return node;
+}
+
+static inline void btree_node_free(struct sys_btree *tree, struct sys_btree_node *node)
+{
+	(void)tree->alloc_func(node, 0);
+}
+
+/* Index of the first key not less than key */
+static uint16_t btree_node_find(const struct sys_btree_node *node, uint64_t key)
+{
+	uint16_t lo = 0;
+	uint16_t hi = node->num_keys;
+
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2;
+
+		if (node->keys[mid] < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Move n entries (and the children on their right) of node from index from to to */
+static void btree_node_move(struct sys_btree_node *dst, uint16_t to, struct sys_btree_node *src,
+			    uint16_t from, uint16_t n)
+{
+	memmove(&dst->keys[to], &src->keys[from], n * sizeof(dst->keys[0]));
+	memmove(&dst->values[to], &src->values[from], n * sizeof(dst->values[0]));
+	if (!dst->leaf) {
+		memmove(&dst->children[to + 1], &src->children[from + 1],
+			n * sizeof(dst->children[0]));
+	}
+}
+
+/* Split the full child i of parent around its median key */
+static int btree_split_child(struct sys_btree *tree, struct sys_btree_node *parent, uint16_t i)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right = btree_node_alloc(tree, left->leaf);
+
+	if (right == NULL) {
+		return -ENOMEM;
+	}
+
+	btree_node_move(right, 0, left, BTREE_T, BTREE_T - 1);
+	if (!left->leaf) {
+		right->children[0] = left->children[BTREE_T];
+	}
+	right->num_keys = BTREE_T - 1;
+	left->num_keys = BTREE_T - 1;
+
+	btree_node_move(parent, i + 1, parent, i, parent->num_keys - i);
+	parent->keys[i] = left->keys[BTREE_T - 1];
+	parent->values[i] = left->values[BTREE_T - 1];
+	parent->children[i + 1] = right;
+	parent->num_keys++;
+
+	return 0;
+}
+
+int sys_btree_insert(struct sys_btree *tree, uint64_t key, uint64_t value, uint64_t *old_value)
+{
+	struct sys_btree_node *node = tree->root;
+	uint16_t i;
+
+	if (node == NULL) {
+		node = btree_node_alloc(tree, true);
+		if (node == NULL) {
+			return -ENOMEM;
+		}
+		tree->root = node;
+		tree->height = 1;
+	} else if (node->num_keys == BTREE_MAX_KEYS) {
+		struct sys_btree_node *root;
+
+		if (tree->height == SYS_BTREE_MAX_HEIGHT) {
+			return -ENOSPC;
+		}
+
+		root = btree_node_alloc(tree, false);
+		if (root == NULL) {
+			return -ENOMEM;
+		}
+		root->children[0] = node;
+		if (btree_split_child(tree, root, 0) != 0) {
+			btree_node_free(tree, root);
+			return -ENOMEM;
+		}
+		tree->root = root;
+		tree->height++;
+		node = root;
+	}
+
+	while (true) {
+		i = btree_node_find(node, key);
+		if (i < node->num_keys && node->keys[i] == key) {
+			if (old_value != NULL) {
+				*old_value = node->values[i];
+			}
+			node->values[i] = value;
+			return 0;
+		}
+
+		if (node->leaf) {
+			break;
+		}
+
+		if (node->children[i]->num_keys == BTREE_MAX_KEYS) {
+			/* Splits done so far only moved entries around */
+			if (btree_split_child(tree, node, i) != 0) {
+				return -ENOMEM;
+			}
+			if (key == node->keys[i]) {
+				continue;
+			}
+			if (key > node->keys[i]) {
+				i++;
+			}
+		}
+		node = node->children[i];
+	}
+
+	btree_node_move(node, i + 1, node, i, node->num_keys - i);
+	node->keys[i] = key;
+	node->values[i] = value;
+	node->num_keys++;
+	tree->size++;
+
+	return 1;
+}
+
+bool sys_btree_get(const struct sys_btree *tree, uint64_t key, uint64_t *value)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	while (node != NULL) {
+		uint16_t i = btree_node_find(node, key);
+
+		if (i < node->num_keys && node->keys[i] == key) {
+			if (value != NULL) {
+				*value = node->values[i];
+			}
+			return true;
+		}
+
+		node = node->leaf ? NULL : node->children[i];
+	}
+
+	return false;
+}
+
+/* Append the separator i of parent and all of child i + 1 to child i */
+static void btree_merge(struct sys_btree *tree, struct sys_btree_node *parent, uint16_t i)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right = parent->children[i + 1];
+	uint16_t n = left->num_keys;
+
+	left->keys[n] = parent->keys[i];
+	left->values[n] = parent->values[i];
+	btree_node_move(left, n + 1, right, 0, right->num_keys);
+	if (!left->leaf) {
+		left->children[n + 1] = right->children[0];
+	}
+	left->num_keys += right->num_keys + 1;
+
+	btree_node_move(parent, i, parent, i + 1, parent->num_keys - i - 1);
+	parent->num_keys--;
+
+	btree_node_free(tree, right);
+}
+
+/* Make sure child i of parent has more than T - 1 keys, returns that child */
+static struct sys_btree_node *btree_fill_child(struct sys_btree *tree,
+					       struct sys_btree_node *parent, uint16_t i)
+{
+	struct sys_btree_node *child = parent->children[i];
+	struct sys_btree_node *sibling;
+
+	if (child->num_keys >= BTREE_T) {
+		return child;
+	}
+
+	if (i > 0 && parent->children[i - 1]->num_keys >= BTREE_T) {
+		/* Rotate the last entry of the left sibling through the parent */
+		sibling = parent->children[i - 1];
+		memmove(&child->keys[1], &child->keys[0], child->num_keys * sizeof(child->keys[0]));
+		memmove(&child->values[1], &child->values[0],
+			child->num_keys * sizeof(child->values[0]));
+		if (!child->leaf) {
+			memmove(&child->children[1], &child->children[0],
+				(child->num_keys + 1) * sizeof(child->children[0]));
+			child->children[0] = sibling->children[sibling->num_keys];
+		}
+		child->keys[0] = parent->keys[i - 1];
+		child->values[0] = parent->values[i - 1];
+		child->num_keys++;
+
+		sibling->num_keys--;
+		parent->keys[i - 1] = sibling->keys[sibling->num_keys];
+		parent->values[i - 1] = sibling->values[sibling->num_keys];
+
+		return child;
+	}
+
+	if (i < parent->num_keys && parent->children[i + 1]->num_keys >= BTREE_T) {
+		/* Rotate the first entry of the right sibling through the parent */
+		sibling = parent->children[i + 1];
+		child->keys[child->num_keys] = parent->keys[i];
+		child->values[child->num_keys] = parent->values[i];
+		if (!child->leaf) {
+			child->children[child->num_keys + 1] = sibling->children[0];
+		}
+		child->num_keys++;
+
+		parent->keys[i] = sibling->keys[0];
+		parent->values[i] = sibling->values[0];
+		if (!sibling->leaf) {
+			memmove(&sibling->children[0], &sibling->children[1],
+				sibling->num_keys * sizeof(sibling->children[0]));
+		}
+		memmove(&sibling->keys[0], &sibling->keys[1],
+			(sibling->num_keys - 1) * sizeof(sibling->keys[0]));
+		memmove(&sibling->values[0], &sibling->values[1],
+			(sibling->num_keys - 1) * sizeof(sibling->values[0]));
+		sibling->num_keys--;
+
+		return child;
+	}
+
+	if (i == parent->num_keys) {
+		i--;
+	}
+	btree_merge(tree, parent, i);
+
+	return parent->children[i];
+}
+
+bool sys_btree_remove(struct sys_btree *tree, uint64_t key, uint64_t *value)
+{
+	struct sys_btree_node *node = tree->root;
+	struct sys_btree_node *next;
+	bool found = false;
+	uint16_t i;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	while (true) {
+		i = btree_node_find(node, key);
+
+		if (i < node->num_keys && node->keys[i] == key) {
+			if (!found) {
+				found = true;
+				if (value != NULL) {
+					*value = node->values[i];
+				}
+			}
+
+			if (node->leaf) {
+				btree_node_move(node, i, node, i + 1, node->num_keys - i - 1);
+				node->num_keys--;
+				break;
+			}
+
+			if (node->children[i]->num_keys >= BTREE_T) {
+				/* Replace with the predecessor, then remove that one */
+				next = node->children[i];
+				while (!next->leaf) {
+					next = next->children[next->num_keys];
+				}
+				key = next->keys[next->num_keys - 1];
+				node->keys[i] = key;
+				node->values[i] = next->values[next->num_keys - 1];
+				node = node->children[i];
+			} else if (node->children[i + 1]->num_keys >= BTREE_T) {
+				/* Same with the successor */
+				next = node->children[i + 1];
+				while (!next->leaf) {
+					next = next->children[0];
+				}
+				key = next->keys[0];
+				node->keys[i] = key;
+				node->values[i] = next->values[0];
+				node = node->children[i + 1];
+			} else {
+				next = node->children[i];
+				btree_merge(tree, node, i);
+				node = next;
+			}
+			continue;
+		}
+
+		if (node->leaf) {
+			break;
+		}
+
+		node = btree_fill_child(tree, node, i);
+	}
+
+	node = tree->root;
+	if (node->num_keys == 0) {
+		tree->root = node->leaf ? NULL : node->children[0];
+		tree->height--;
+		btree_node_free(tree, node);
+	}
+
+	if (found) {
+		tree->size--;
+	}
+
+	return found;
+}
+
+static void btree_clear_node(struct sys_btree *tree, struct sys_btree_node *node,
+			     sys_btree_callback_t cb, void *cookie)
+{
+	for (uint16_t i = 0; i <= node->num_keys; i++) {
+		if (!node->leaf) {
+			btree_clear_node(tree, node->children[i], cb, cookie);
+		}
+		if (cb != NULL && i < node->num_keys) {
+			cb(node->keys[i], node->values[i], cookie);
+		}
+	}
+
+	btree_node_free(tree, node);
+}
+
+void sys_btree_clear(struct sys_btree *tree, sys_btree_callback_t cb, void *cookie)
+{
+	if (tree->root != NULL) {
+		btree_clear_node(tree, tree->root, cb, cookie);
+	}
+
+	tree->root = NULL;
+	tree->size = 0;
+	tree->height = 0;
+}
+
+static void btree_iter_push(struct sys_btree_iter *it, struct sys_btree_node *node, uint16_t pos)
+{
+	__ASSERT_NO_MSG(it->depth < SYS_BTREE_MAX_HEIGHT);
+
+	it->path[it->depth] = node;
+	it->pos[it->depth] = pos;
+	it->depth++;
+}
+
+void sys_btree_iter_init(const struct sys_btree *tree, struct sys_btree_iter *it, uint64_t key)
+{
+	struct sys_btree_node *node = tree->root;
+
+	it->depth = 0;
+
+	/*
+	 * Every node on the path is left at the first key not yet visited,
+	 * the entries of its child at that position come before it.
+	 */
+	while (node != NULL) {
+		uint16_t i = btree_node_find(node, key);
+
+		btree_iter_push(it, node, i);
+		if (node->leaf || (i < node->num_keys && node->keys[i] == key)) {
+			break;
+		}
+		node = node->children[i];
+	}
+}
+
+bool sys_btree_iter_next(struct sys_btree_iter *it)
+{
+	while (it->depth > 0) {
+		struct sys_btree_node *node = it->path[it->depth - 1];
+		uint16_t i = it->pos[it->depth - 1];
+
+		if (i == node->num_keys) {
+			it->depth--;
+			continue;
+		}
+
+		it->key = node->keys[i];
+		it->value = node->values[i];
+		it->pos[it->depth - 1] = i + 1;
+
+		/* Entries of the next child come before the next key */
+		if (!node->leaf) {
+			node = node->children[i + 1];
+			while (true) {
+				btree_iter_push(it, node, 0);
+				if (node->leaf) {
+					break;
+				}
+				node = node->children[0];
+			}
+		}
+
+		return true;
+	}
+
+	return false;
+}
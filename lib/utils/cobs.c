@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <zephyr/data/cobs.h>
 
 int cobs_encode(struct net_buf *src, struct net_buf *dst, uint32_t flags)
@@ -21,33 +22,30 @@ int cobs_encode(struct net_buf *src, struct net_buf *dst, uint32_t flags)
 	}
 
 	uint8_t *code_ptr = net_buf_add(dst, 1);
-	uint8_t code = 1;
 
-	/* Process all input bytes */
-	uint8_t data = 0;
+	*code_ptr = 1;
 
+	/* Copy each run of non-delimiter bytes at once, up to a full block */
 	while (src->len > 0) {
-		data = net_buf_pull_u8(src);
-		if (data == delimiter) {
-			/* Delimiter found - write current code and start new block */
-			*code_ptr = code;
-			code_ptr = net_buf_add(dst, 1);
-			code = 1;
-		} else {
-			/* Add non-zero byte to output */
-			net_buf_add_u8(dst, data);
-			code++;
-
-			/* If we've reached maximum block size, start a new block */
-			if (code == 0xFF && (src->len - 1 >= 0)) {
-				*code_ptr = code;
-				code_ptr = net_buf_add(dst, 1);
-				code = 1;
-			}
+		size_t max_run = MIN(src->len, 0xFE);
+		const uint8_t *end = memchr(src->data, delimiter, max_run);
+		size_t run = (end != NULL) ? (size_t)(end - src->data) : max_run;
+
+		net_buf_add_mem(dst, net_buf_pull_mem(src, run), run);
+		*code_ptr = run + 1;
+
+		if (end != NULL) {
+			/* Delimiter found - drop it and start a new block */
+			net_buf_pull(src, 1);
+		} else if ((run < 0xFE) || (src->len == 0)) {
+			/* End of the data */
+			break;
 		}
-	}
 
-	*code_ptr = code;
+		/* Next block, delimiter or maximum block size reached */
+		code_ptr = net_buf_add(dst, 1);
+		*code_ptr = 1;
+	}
 
 	if (flags & COBS_FLAG_TRAILING_DELIMITER) {
 		/* Add final delimiter */
@@ -82,14 +80,13 @@ int cobs_decode(struct net_buf *src, struct net_buf *dst, uint32_t flags)
 			return -EINVAL;
 		}
 
-		/* Copy offset-1 bytes */
-		for (uint8_t i = 0; i < offset - 1; i++) {
-			uint8_t byte = net_buf_pull_u8(src);
-
-			if (byte == delimiter) {
+		/* Copy offset-1 bytes, none of which may be a delimiter */
+		if (offset > 1) {
+			if (memchr(src->data, delimiter, offset - 1) != NULL) {
 				return -EINVAL;
 			}
-			net_buf_add_u8(dst, byte);
+
+			net_buf_add_mem(dst, net_buf_pull_mem(src, offset - 1), offset - 1);
 		}
 
 		/* If this wasn't a maximum offset and we have more data,
@@ -9,31 +9,46 @@
 #include <errno.h>
 #include <zephyr/sys/util.h>
 
+static const char hex_digits[16] = "0123456789abcdef";
+
+/*
+ * Value of a hex digit, or a value above 15 if c is not one. Setting bit 5
+ * lowercases letters, and the unsigned subtractions check each range with a
+ * single comparison.
+ */
+static inline uint8_t hex_nibble(char c)
+{
+	uint8_t digit = (uint8_t)c - (uint8_t)'0';
+	uint8_t letter = ((uint8_t)c | 0x20U) - (uint8_t)'a';
+
+	if (digit <= 9U) {
+		return digit;
+	}
+
+	return (letter <= 5U) ? (letter + 10U) : 0xFFU;
+}
+
 int char2hex(char c, uint8_t *x)
 {
-	if ((c >= '0') && (c <= '9')) {
-		*x = c - '0';
-	} else if ((c >= 'a') && (c <= 'f')) {
-		*x = c - 'a' + 10;
-	} else if ((c >= 'A') && (c <= 'F')) {
-		*x = c - 'A' + 10;
-	} else {
+	uint8_t nibble = hex_nibble(c);
+
+	if (nibble > 15U) {
 		return -EINVAL;
 	}
 
+	*x = nibble;
+
 	return 0;
 }
 
 int hex2char(uint8_t x, char *c)
 {
-	if (x <= 9) {
-		*c = x + (char)'0';
-	} else  if (x <= 15) {
-		*c = x - 10 + (char)'a';
-	} else {
+	if (x > 15U) {
 		return -EINVAL;
 	}
 
+	*c = hex_digits[x];
+
 	return 0;
 }
 
@@ -44,12 +59,8 @@ size_t bin2hex(const uint8_t *buf, size_t buflen, char *hex, size_t hexlen)
 	}
 
 	for (size_t i = 0; i < buflen; i++) {
-		if (hex2char(buf[i] >> 4, &hex[2U * i]) < 0) {
-			return 0;
-		}
-		if (hex2char(buf[i] & 0xf, &hex[2U * i + 1U]) < 0) {
-			return 0;
-		}
+		hex[2U * i] = hex_digits[buf[i] >> 4];
+		hex[2U * i + 1U] = hex_digits[buf[i] & 0xf];
 	}
 
 	hex[2U * buflen] = '\0';
@@ -58,7 +69,7 @@ size_t bin2hex(const uint8_t *buf, size_t buflen, char *hex, size_t hexlen)
 
 size_t hex2bin(const char *hex, size_t hexlen, uint8_t *buf, size_t buflen)
 {
-	uint8_t dec;
+	uint8_t dec, hi, lo;
 
 	if (buflen < (hexlen / 2U + hexlen % 2U)) {
 		return 0;
@@ -76,15 +87,15 @@ size_t hex2bin(const char *hex, size_t hexlen, uint8_t *buf, size_t buflen)
 
 	/* regular hex conversion */
 	for (size_t i = 0; i < (hexlen / 2U); i++) {
-		if (char2hex(hex[2U * i], &dec) < 0) {
-			return 0;
-		}
-		buf[i] = dec << 4;
+		hi = hex_nibble(hex[2U * i]);
+		lo = hex_nibble(hex[2U * i + 1U]);
 
-		if (char2hex(hex[2U * i + 1U], &dec) < 0) {
+		/* One check for both digits */
+		if ((hi | lo) > 15U) {
 			return 0;
 		}
-		buf[i] += dec;
+
+		buf[i] = (hi << 4) | lo;
 	}
 
 	return hexlen / 2U + hexlen % 2U;
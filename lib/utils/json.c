@@ -1076,7 +1076,9 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 {
 	struct json_obj_key_value kv;
 	int64_t decoded_fields = 0;
+	size_t next = 0;
 	size_t i;
+	size_t n;
 	int ret;
 
 	while (!obj_next(obj, &kv)) {
@@ -1084,7 +1086,8 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
+		/* Fields mostly come in descriptor order, start after the last match */
+		for (n = 0, i = next; n < descr_len; n++, i = (i + 1 < descr_len) ? i + 1 : 0) {
 			void *decode_field = (char *)val + descr[i].offset;
 
 			/* Field has been decoded already, skip */
@@ -1110,11 +1113,12 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			}
 
 			decoded_fields |= (int64_t)1<<i;
+			next = (i + 1 < descr_len) ? i + 1 : 0;
 			break;
 		}
 
 		/* Skip field, if no descriptor was found */
-		if (i >= descr_len) {
+		if (n >= descr_len) {
 			ret = skip_field(obj, &kv);
 			if (ret < 0) {
 				return ret;
@@ -1189,6 +1193,283 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+enum json_stream_state {
+	JSON_STREAM_VALUE,		/* Value expected */
+	JSON_STREAM_VALUE_OR_END,	/* Value or end of array expected */
+	JSON_STREAM_KEY,		/* Member name expected */
+	JSON_STREAM_KEY_OR_END,		/* Member name or end of object expected */
+	JSON_STREAM_IN_KEY,
+	JSON_STREAM_COLON,
+	JSON_STREAM_IN_STRING,
+	JSON_STREAM_IN_LITERAL,		/* Number, true, false or null */
+	JSON_STREAM_NEXT,		/* Comma or end of container expected */
+	JSON_STREAM_DONE,
+};
+
+void json_stream_parser_init(struct json_stream_parser *parser, char *buf, size_t buf_size,
+			     json_stream_cb_t cb, void *data)
+{
+	*parser = (struct json_stream_parser) {
+		.cb = cb,
+		.data = data,
+		.buf = buf,
+		.buf_size = buf_size,
+		.state = JSON_STREAM_VALUE,
+	};
+}
+
+static bool stream_in_object(const struct json_stream_parser *parser)
+{
+	return parser->depth > 0 && (parser->objects & BIT(parser->depth - 1)) != 0;
+}
+
+static int stream_emit(struct json_stream_parser *parser, enum json_tokens type)
+{
+	struct json_token key = {
+		.type = JSON_TOK_STRING,
+		.start = parser->buf,
+		.end = parser->buf + parser->key_len,
+	};
+	struct json_token value = {
+		.type = type,
+		.start = parser->buf + parser->key_len,
+		.end = parser->buf + parser->key_len + parser->value_len,
+	};
+	int ret;
+
+	ret = parser->cb(parser->has_key ? &key : NULL, &value, parser->depth, parser->data);
+
+	parser->has_key = false;
+	parser->key_len = 0;
+	parser->value_len = 0;
+
+	return ret;
+}
+
+static int stream_open(struct json_stream_parser *parser, enum json_tokens type)
+{
+	int ret;
+
+	if (parser->depth == 32) {
+		return -EINVAL;
+	}
+
+	ret = stream_emit(parser, type);
+	if (ret < 0) {
+		return ret;
+	}
+
+	WRITE_BIT(parser->objects, parser->depth, type == JSON_TOK_OBJECT_START);
+	parser->depth++;
+	parser->state = (type == JSON_TOK_OBJECT_START) ? JSON_STREAM_KEY_OR_END :
+							  JSON_STREAM_VALUE_OR_END;
+
+	return 0;
+}
+
+/* Ends a value, which is complete when its container is */
+static void stream_value_done(struct json_stream_parser *parser)
+{
+	parser->state = (parser->depth == 0) ? JSON_STREAM_DONE : JSON_STREAM_NEXT;
+}
+
+static int stream_close(struct json_stream_parser *parser, char chr)
+{
+	bool object = stream_in_object(parser);
+
+	if (parser->depth == 0 || (chr == '}') != object) {
+		return -EINVAL;
+	}
+
+	parser->depth--;
+	stream_value_done(parser);
+
+	return stream_emit(parser, object ? JSON_TOK_OBJECT_END : JSON_TOK_ARRAY_END);
+}
+
+static int stream_append(struct json_stream_parser *parser, char chr)
+{
+	if (parser->key_len + parser->value_len >= parser->buf_size) {
+		return -ENOSPC;
+	}
+
+	if (parser->state == JSON_STREAM_IN_KEY) {
+		parser->buf[parser->key_len++] = chr;
+	} else {
+		parser->buf[parser->key_len + parser->value_len++] = chr;
+	}
+
+	return 0;
+}
+
+static bool stream_literal_is(const struct json_stream_parser *parser, const char *literal)
+{
+	return parser->value_len == strlen(literal) &&
+	       memcmp(parser->buf + parser->key_len, literal, parser->value_len) == 0;
+}
+
+static int stream_literal_done(struct json_stream_parser *parser)
+{
+	const char *value = parser->buf + parser->key_len;
+	enum json_tokens type;
+
+	if (stream_literal_is(parser, "true")) {
+		type = JSON_TOK_TRUE;
+	} else if (stream_literal_is(parser, "false")) {
+		type = JSON_TOK_FALSE;
+	} else if (stream_literal_is(parser, "null")) {
+		type = JSON_TOK_NULL;
+	} else {
+		/* Same characters as lexer_number() takes */
+		for (size_t i = 0; i < parser->value_len; i++) {
+			if (!isdigit((unsigned char)value[i]) && value[i] != '-' &&
+			    value[i] != '+' && value[i] != '.' && value[i] != 'e' &&
+			    value[i] != 'E') {
+				return -EINVAL;
+			}
+		}
+		type = JSON_TOK_NUMBER;
+	}
+
+	stream_value_done(parser);
+
+	return stream_emit(parser, type);
+}
+
+static int stream_string(struct json_stream_parser *parser, char chr)
+{
+	if (parser->escape) {
+		parser->escape = false;
+	} else if (chr == '\\') {
+		parser->escape = true;
+	} else if (chr == '"') {
+		if (parser->state == JSON_STREAM_IN_KEY) {
+			parser->has_key = true;
+			parser->state = JSON_STREAM_COLON;
+			return 0;
+		}
+
+		stream_value_done(parser);
+		return stream_emit(parser, JSON_TOK_STRING);
+	}
+
+	return stream_append(parser, chr);
+}
+
+static int stream_char(struct json_stream_parser *parser, char chr)
+{
+	bool space = isspace((unsigned char)chr);
+	int ret;
+
+	switch (parser->state) {
+	case JSON_STREAM_IN_KEY:
+	case JSON_STREAM_IN_STRING:
+		return stream_string(parser, chr);
+
+	case JSON_STREAM_IN_LITERAL:
+		if (!space && chr != ',' && chr != ']' && chr != '}') {
+			return stream_append(parser, chr);
+		}
+
+		ret = stream_literal_done(parser);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The delimiter belongs to what comes next */
+		return stream_char(parser, chr);
+
+	case JSON_STREAM_VALUE_OR_END:
+		if (chr == ']') {
+			return stream_close(parser, chr);
+		}
+		__fallthrough;
+	case JSON_STREAM_VALUE:
+		if (space) {
+			return 0;
+		} else if (chr == '{') {
+			return stream_open(parser, JSON_TOK_OBJECT_START);
+		} else if (chr == '[') {
+			return stream_open(parser, JSON_TOK_ARRAY_START);
+		} else if (chr == '"') {
+			parser->state = JSON_STREAM_IN_STRING;
+			return 0;
+		} else if (chr == ',' || chr == ':' || chr == ']' || chr == '}') {
+			return -EINVAL;
+		}
+
+		parser->state = JSON_STREAM_IN_LITERAL;
+		return stream_append(parser, chr);
+
+	case JSON_STREAM_KEY_OR_END:
+		if (chr == '}') {
+			return stream_close(parser, chr);
+		}
+		__fallthrough;
+	case JSON_STREAM_KEY:
+		if (space) {
+			return 0;
+		} else if (chr == '"') {
+			parser->state = JSON_STREAM_IN_KEY;
+			return 0;
+		}
+		return -EINVAL;
+
+	case JSON_STREAM_COLON:
+		if (space) {
+			return 0;
+		} else if (chr == ':') {
+			parser->state = JSON_STREAM_VALUE;
+			return 0;
+		}
+		return -EINVAL;
+
+	case JSON_STREAM_NEXT:
+		if (space) {
+			return 0;
+		} else if (chr == ',') {
+			parser->state = stream_in_object(parser) ? JSON_STREAM_KEY : JSON_STREAM_VALUE;
+			return 0;
+		} else if (chr == ']' || chr == '}') {
+			return stream_close(parser, chr);
+		}
+		return -EINVAL;
+
+	case JSON_STREAM_DONE:
+	default:
+		return space ? 0 : -EINVAL;
+	}
+}
+
+int json_stream_parser_feed(struct json_stream_parser *parser, const char *chunk, size_t len)
+{
+	int ret;
+
+	for (size_t i = 0; i < len; i++) {
+		ret = stream_char(parser, chunk[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int json_stream_parser_end(struct json_stream_parser *parser)
+{
+	int ret;
+
+	/* A number at top level has nothing after it */
+	if (parser->state == JSON_STREAM_IN_LITERAL && parser->depth == 0) {
+		ret = stream_literal_done(parser);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return (parser->state == JSON_STREAM_DONE) ? 0 : -EINVAL;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -0,0 +1,151 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/ring_buffer_spsc.h>
+
+/*
+ * head is only written by the producer and tail only by the consumer. Each
+ * side publishes its index with atomic_set() once the data is written or
+ * read, and reads the index of the other side with atomic_get(). Both are
+ * full barriers, which orders the data accesses of one side with the index
+ * update seen by the other.
+ */
+
+static inline uint32_t ring_buf_spsc_add(const struct ring_buf_spsc *buf, uint32_t pos,
+					 uint32_t n)
+{
+	pos += n;
+	if (pos >= 2U * buf->size) {
+		pos -= 2U * buf->size;
+	}
+
+	return pos;
+}
+
+static inline uint32_t ring_buf_spsc_offset(const struct ring_buf_spsc *buf, uint32_t pos)
+{
+	return (pos >= buf->size) ? (pos - buf->size) : pos;
+}
+
+/* Contiguous area of at most avail bytes starting at pos */
+static uint32_t ring_buf_spsc_area(struct ring_buf_spsc *buf, uint32_t pos, uint32_t avail,
+				   uint8_t **data, uint32_t size)
+{
+	uint32_t offset = ring_buf_spsc_offset(buf, pos);
+
+	size = MIN(size, avail);
+	size = MIN(size, buf->size - offset);
+	*data = &buf->buffer[offset];
+
+	return size;
+}
+
+uint32_t ring_buf_spsc_put_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+	uint32_t space = buf->size - ring_buf_spsc_used(buf, head, tail) - buf->put_claimed;
+
+	size = ring_buf_spsc_area(buf, ring_buf_spsc_add(buf, head, buf->put_claimed), space,
+				  data, size);
+	buf->put_claimed += size;
+
+	return size;
+}
+
+int ring_buf_spsc_put_finish(struct ring_buf_spsc *buf, uint32_t size)
+{
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+
+	if (unlikely(size > buf->put_claimed)) {
+		return -EINVAL;
+	}
+
+	buf->put_claimed = 0U;
+	atomic_set(&buf->head, (atomic_val_t)ring_buf_spsc_add(buf, head, size));
+
+	return 0;
+}
+
+uint32_t ring_buf_spsc_put(struct ring_buf_spsc *buf, const uint8_t *data, uint32_t size)
+{
+	uint8_t *dst;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_put_claim(buf, &dst, size);
+		if (partial_size == 0) {
+			break;
+		}
+		memcpy(dst, data, partial_size);
+		total_size += partial_size;
+		size -= partial_size;
+		data += partial_size;
+	} while (size != 0);
+
+	err = ring_buf_spsc_put_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return total_size;
+}
+
+uint32_t ring_buf_spsc_get_claim(struct ring_buf_spsc *buf, uint8_t **data, uint32_t size)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+	uint32_t avail = ring_buf_spsc_used(buf, head, tail) - buf->get_claimed;
+
+	size = ring_buf_spsc_area(buf, ring_buf_spsc_add(buf, tail, buf->get_claimed), avail,
+				  data, size);
+	buf->get_claimed += size;
+
+	return size;
+}
+
+int ring_buf_spsc_get_finish(struct ring_buf_spsc *buf, uint32_t size)
+{
+	uint32_t tail = (uint32_t)atomic_get(&buf->tail);
+
+	if (unlikely(size > buf->get_claimed)) {
+		return -EINVAL;
+	}
+
+	buf->get_claimed = 0U;
+	atomic_set(&buf->tail, (atomic_val_t)ring_buf_spsc_add(buf, tail, size));
+
+	return 0;
+}
+
+uint32_t ring_buf_spsc_get(struct ring_buf_spsc *buf, uint8_t *data, uint32_t size)
+{
+	uint8_t *src;
+	uint32_t partial_size;
+	uint32_t total_size = 0U;
+	int err;
+
+	do {
+		partial_size = ring_buf_spsc_get_claim(buf, &src, size);
+		if (partial_size == 0) {
+			break;
+		}
+		if (data) {
+			memcpy(data, src, partial_size);
+			data += partial_size;
+		}
+		total_size += partial_size;
+		size -= partial_size;
+	} while (size != 0);
+
+	err = ring_buf_spsc_get_finish(buf, total_size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return total_size;
+}
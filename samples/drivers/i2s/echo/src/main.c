@@ -10,6 +10,9 @@
 #include <zephyr/drivers/i2s.h>
 #include <zephyr/drivers/gpio.h>
 #include <string.h>
+#ifdef CONFIG_DSP
+#include <zephyr/dsp/dsp.h>
+#endif
 
 
 #if DT_NODE_EXISTS(DT_NODELABEL(i2s_rxtx))
@@ -45,6 +48,7 @@ K_MEM_SLAB_DEFINE_STATIC(mem_slab, BLOCK_SIZE, BLOCK_COUNT, 4);
 
 static int16_t echo_block[SAMPLES_PER_BLOCK];
 static volatile bool echo_enabled = true;
+static const struct device *echo_tx_dev;
 static K_SEM_DEFINE(toggle_transfer, 1, 1);
 
 #ifdef CONFIG_TOGGLE_ECHO_EFFECT_SW0
@@ -135,11 +139,19 @@ static void process_block_data(void *mem_block, uint32_t number_of_samples)
 	static bool clear_echo_block;
 
 	if (echo_enabled) {
+#ifdef CONFIG_DSP
+		q15_t *samples = mem_block;
+
+		/* Saturating mix, then the echo decays by half */
+		zdsp_add_q15(samples, echo_block, samples, number_of_samples);
+		zdsp_scale_q15(samples, 0x4000, 0, echo_block, number_of_samples);
+#else
 		for (int i = 0; i < number_of_samples; ++i) {
 			int16_t *sample = &((int16_t *)mem_block)[i];
 			*sample += echo_block[i];
 			echo_block[i] = (*sample) / 2;
 		}
+#endif
 
 		clear_echo_block = true;
 	} else if (clear_echo_block) {
@@ -148,6 +160,40 @@ static void process_block_data(void *mem_block, uint32_t number_of_samples)
 	}
 }
 
+static void block_done(const struct device *dev, enum i2s_dir dir,
+		       void *mem_block, size_t size, void *user_data)
+{
+	if (dir == I2S_DIR_TX) {
+		k_mem_slab_free(&mem_slab, mem_block);
+		return;
+	}
+
+	/* The received block is processed in place and sent back as is */
+	process_block_data(mem_block, MIN(size / BYTES_PER_SAMPLE, SAMPLES_PER_BLOCK));
+
+	if (i2s_write(echo_tx_dev, mem_block, size) < 0) {
+		k_mem_slab_free(&mem_slab, mem_block);
+	}
+}
+
+static bool set_callbacks(const struct device *i2s_dev_rx,
+			  const struct device *i2s_dev_tx)
+{
+	if (i2s_callback_set(i2s_dev_rx, block_done, NULL) < 0) {
+		return false;
+	}
+
+	if (i2s_dev_tx != i2s_dev_rx &&
+	    i2s_callback_set(i2s_dev_tx, block_done, NULL) < 0) {
+		(void)i2s_callback_set(i2s_dev_rx, NULL, NULL);
+		return false;
+	}
+
+	echo_tx_dev = i2s_dev_tx;
+
+	return true;
+}
+
 static bool configure_streams(const struct device *i2s_dev_rx,
 			      const struct device *i2s_dev_tx,
 			      const struct i2s_config *config)
@@ -249,6 +295,7 @@ int main(void)
 	const struct device *const i2s_dev_rx = DEVICE_DT_GET(I2S_RX_NODE);
 	const struct device *const i2s_dev_tx = DEVICE_DT_GET(I2S_TX_NODE);
 	struct i2s_config config;
+	bool callbacks;
 
 	printk("I2S echo sample\n");
 
@@ -284,6 +331,11 @@ int main(void)
 		return 0;
 	}
 
+	callbacks = set_callbacks(i2s_dev_rx, i2s_dev_tx);
+	if (callbacks) {
+		printk("Processing blocks in I2S callbacks\n");
+	}
+
 	for (;;) {
 		k_sem_take(&toggle_transfer, K_FOREVER);
 
@@ -298,7 +350,12 @@ int main(void)
 
 		printk("Streams started\n");
 
-		while (k_sem_take(&toggle_transfer, K_NO_WAIT) != 0) {
+		if (callbacks) {
+			/* Blocks go around in the I2S interrupts until stopped */
+			(void)k_sem_take(&toggle_transfer, K_FOREVER);
+		}
+
+		while (!callbacks && k_sem_take(&toggle_transfer, K_NO_WAIT) != 0) {
 			void *mem_block;
 			uint32_t block_size;
 			int ret;
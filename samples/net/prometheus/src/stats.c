@@ -30,40 +30,24 @@ extern struct http_service_desc test_http_service;
 
 static struct prometheus_counter *http_request_counter;
 static struct prometheus_collector *stats_collector;
-static struct prometheus_collector_walk_context walk_ctx;
+static PROMETHEUS_SCRAPE_CTX_DEFINE(scrape_ctx, NULL);
 
 static int stats_handler(struct http_client_ctx *client, enum http_data_status status,
 			 const struct http_request_ctx *request_ctx,
 			 struct http_response_ctx *response_ctx, void *user_data)
 {
 	int ret;
-	static uint8_t prom_buffer[1024];
 
-	if (status == HTTP_SERVER_DATA_FINAL) {
+	ret = prometheus_scrape_http_handler(client, status, request_ctx, response_ctx,
+					     user_data);
+	if (ret < 0) {
+		LOG_ERR("Cannot format exposition data (%d)", ret);
+		return ret;
+	}
 
+	if (status == HTTP_SERVER_DATA_FINAL && response_ctx->final_chunk) {
 		/* incrase counter per request */
 		prometheus_counter_inc(http_request_counter);
-
-		(void)memset(prom_buffer, 0, sizeof(prom_buffer));
-
-		ret = prometheus_collector_walk_metrics(user_data,
-							prom_buffer,
-							sizeof(prom_buffer));
-		if (ret < 0 && ret != -EAGAIN) {
-			LOG_ERR("Cannot format exposition data (%d)", ret);
-			return ret;
-		}
-
-		response_ctx->body = prom_buffer;
-		response_ctx->body_len = strlen(prom_buffer);
-
-		if (ret == 0) {
-			response_ctx->final_chunk = true;
-			ret = prometheus_collector_walk_init(&walk_ctx, stats_collector);
-			if (ret < 0) {
-				LOG_ERR("Cannot initialize walk context (%d)", ret);
-			}
-		}
 	}
 
 	return 0;
@@ -76,7 +60,7 @@ struct http_resource_detail_dynamic stats_resource_detail = {
 			.content_type = "text/plain",
 	},
 	.cb = stats_handler,
-	.user_data = &walk_ctx,
+	.user_data = &scrape_ctx,
 };
 
 HTTP_RESOURCE_DEFINE(stats_resource, test_http_service, "/statistics", &stats_resource_detail);
@@ -90,7 +74,7 @@ int init_stats(struct prometheus_counter *counter)
 		return -EINVAL;
 	}
 
-	(void)prometheus_collector_walk_init(&walk_ctx, stats_collector);
+	(void)prometheus_collector_walk_init(&scrape_ctx.walk, stats_collector);
 
 	http_request_counter = counter;
 
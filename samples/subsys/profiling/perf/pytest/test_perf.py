@@ -36,3 +36,33 @@ def test_shell_perf(dut: DeviceAdapter, shell: Shell):
     while i < length:
         i += int(lines[i], 16) + 1
         assert i <= length, 'one of the samples is not true to size'
+
+
+def test_shell_perf_stream(dut: DeviceAdapter, shell: Shell):
+
+    shell.base_timeout=10
+
+    logger.info('send "perf stream 200 99" command')
+    lines = shell.exec_command('perf stream 200 99')
+    assert 'Enabled perf' in lines, 'expected response not found'
+    lines = dut.readlines_until(regex='.*Perf done!', print_output=True)
+    logger.info('response is valid')
+
+    samples = 0
+    i = 0
+    while i < len(lines):
+        match = re.search(r"Perf buf length (\d+)", lines[i])
+        i += 1
+        if match is None:
+            continue
+        length = int(match.group(1))
+        assert i + length <= len(lines), 'missing lines'
+
+        j = 0
+        while j < length:
+            j += int(lines[i + j], 16) + 1
+            samples += 1
+            assert j <= length, 'one of the samples is not true to size'
+        i += length
+
+    assert samples != 0, 'no samples'
@@ -217,26 +217,49 @@ class ZephyrElfExptabPreparator():
         return 0
 
     def _prepare_exptab_for_str_linking(self):
-        #TODO: sort the export table by symbol
-        #      name to allow binary search too
-        #
-        # Plan of action:
-        #   1) Locate in which section the names are located
-        #   2) Load the export table and resolve names
-        #   3) Sort the exports by name
-        #       WARN: THIS MUST USE THE SAME SORTING RULES
-        #       AS LLEXT CODE OR DICHOTOMIC SEARCH WILL BREAK
-        #       Using a custom sorting function might be required.
-        #   4) Write back the updated export table
-        #
-        # N.B.: reusing part of the code in _prepare_elf_for_slid_linking
-        # might be possible and desireable.
-        #
-        # As of writing, this function will never be called as this script
-        # is only called if CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID is enabled,
-        # which makes _prepare_exptab_for_slid_linking be called instead.
-        #
-        self.log.warn(f"_prepare_exptab_for_str_linking: do nothing")
+        """
+        IMPLEMENTATION NOTES:
+          Symbol names are pointers to NUL-terminated strings placed
+          anywhere in the image, resolved through the ELF sections.
+
+          The export table is sorted by name in ASCENDING order of
+          their raw bytes, which is the strcmp() order used by the
+          binary search of the LLEXT code.
+        """
+        def read_symbol_name(name_ptr):
+            for section in self.elf.iter_sections():
+                start = section['sh_addr']
+                if (section['sh_type'] == 'SHT_NOBITS' or (section['sh_flags'] & 0x2) == 0
+                        or not start <= name_ptr < start + section['sh_size']):
+                    continue
+
+                raw_name = b''
+                self.elf_fd.seek(section['sh_offset'] + name_ptr - start)
+                c = self.elf_fd.read(1)
+                while c != b'\0':
+                    raw_name += c
+                    c = self.elf_fd.read(1)
+
+                return raw_name
+
+            return None
+
+        #1) Load the export table and resolve names
+        exports_list = []
+        for (name_ptr, export_address) in self.exptab_manipulator:
+            export_name = read_symbol_name(name_ptr)
+            if export_name is None:
+                self.log.error(f"name of export at 0x{export_address:X} not found")
+                return 1
+            exports_list.append((export_name, name_ptr, export_address))
+
+        #2) Sort the exports by name (order specified above)
+        exports_list.sort(key=lambda export: export[0])
+
+        #3) Write back the updated export table
+        for i, (_, name_ptr, export_address) in enumerate(exports_list):
+            self.exptab_manipulator[i] = (name_ptr, export_address)
+
         return 0
 
     def _set_prep_done_shdr_flag(self):
@@ -28,6 +28,16 @@ sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'python-devicetree',
 import edtlib_logger
 from devicetree import edtlib
 
+# Device API classes which can be dispatched at compile time when a single
+# compatible implements them (CONFIG_DEVICE_API_STATIC_DISPATCH), with the
+# test telling whether a node implements the class. Keep in sync with
+# Z_DEVICE_API_STATIC_CHECK() in include/zephyr/device.h.
+STATIC_API_CLASSES = {
+    "gpio": lambda node: "gpio-controller" in node.props,
+    "i2c": lambda node: "i2c" in node.buses or "i3c" in node.buses,
+    "spi": lambda node: "spi" in node.buses,
+}
+
 
 def main():
     global header_file
@@ -972,6 +982,18 @@ def write_global_macros(edt: edtlib.EDT):
             out_define(
                 f"DT_COMPAT_{str2ident(compat)}_BUS_{str2ident(bus)}", 1)
 
+    out_comment('Device API classes implemented by a single compatible\n')
+    for api, implements in STATIC_API_CLASSES.items():
+        api_nodes = [node for node in edt.nodes
+                     if node.status == "okay" and node.matching_compat
+                     and implements(node)]
+        compats = {node.matching_compat for node in api_nodes}
+        if len(compats) == 1:
+            out_dt_define(f"API_HAS_SINGLE_{api}", 1)
+            out_dt_define(f"API_SINGLE_{api}", f"DT_{api_nodes[0].z_path_id}")
+            out_dt_define(f"API_SINGLE_{api}_COMPAT",
+                          str2ident(api_nodes[0].matching_compat))
+
 
 def str2ident(s: str) -> str:
     # Converts 's' to a form suitable for (part of) an identifier
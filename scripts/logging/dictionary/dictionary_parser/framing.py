@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Frame decoder for Dictionary-based Logging
+
+Extracts the payloads of the frames written with
+CONFIG_LOG_DICTIONARY_FRAMING from a byte stream. Each payload holds
+a whole number of log messages and can be given as is to a parser.
+"""
+
+import struct
+
+FRAME_MAGIC = b"\x5a\x4c"
+FRAME_HDR_FMT = "<2sBH"
+FRAME_HDR_SIZE = struct.calcsize(FRAME_HDR_FMT)
+FRAME_CRC_SIZE = 2
+
+FRAME_FLAG_COMPRESSED = 0x01
+
+MIN_MATCH = 3
+
+
+def crc16_ccitt(data, seed=0):
+    """CRC-16/CCITT as computed by crc16_ccitt() on target"""
+    crc = seed
+    for byte in data:
+        e = (crc ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        crc = (crc >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)
+        crc &= 0xFFFF
+
+    return crc
+
+
+def decompress(data, offset, length):
+    """
+    Decompress a payload of length bytes starting at offset.
+
+    Returns a (payload, end offset) tuple, or None if data is too short.
+    Raises ValueError if the data cannot be a compressed payload.
+    """
+    out = bytearray()
+
+    while len(out) < length:
+        if offset >= len(data):
+            return None
+
+        token = data[offset]
+        offset += 1
+
+        if token < 0x80:
+            count = token + 1
+            if offset + count > len(data):
+                return None
+            out += data[offset:offset + count]
+            offset += count
+        else:
+            if offset + 2 > len(data):
+                return None
+            count = (token & 0x7F) + MIN_MATCH
+            dist = data[offset] | (data[offset + 1] << 8)
+            offset += 2
+            if dist == 0 or dist > len(out):
+                raise ValueError("invalid match distance")
+            # Matches may overlap the bytes they produce
+            for _ in range(count):
+                out.append(out[-dist])
+
+        if len(out) > length:
+            raise ValueError("payload longer than frame length")
+
+    return bytes(out), offset
+
+
+class FrameDecoder:
+    """Incremental decoder of a stream of frames"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.crc_errors = 0
+        self.skipped_bytes = 0
+
+    def feed(self, data):
+        """Add data to the stream and return the list of complete payloads"""
+        self.buf += data
+        payloads = []
+
+        while True:
+            idx = self.buf.find(FRAME_MAGIC)
+            if idx < 0:
+                # Keep a possible first half of the magic
+                keep = 1 if self.buf[-1:] == FRAME_MAGIC[:1] else 0
+                self.skipped_bytes += len(self.buf) - keep
+                del self.buf[:len(self.buf) - keep]
+                break
+
+            if idx > 0:
+                self.skipped_bytes += idx
+                del self.buf[:idx]
+
+            if len(self.buf) < FRAME_HDR_SIZE:
+                break
+
+            _, flags, length = struct.unpack_from(FRAME_HDR_FMT, self.buf)
+
+            try:
+                if flags & FRAME_FLAG_COMPRESSED:
+                    ret = decompress(self.buf, FRAME_HDR_SIZE, length)
+                else:
+                    end = FRAME_HDR_SIZE + length
+                    ret = (bytes(self.buf[FRAME_HDR_SIZE:end]), end) \
+                        if end <= len(self.buf) else None
+            except ValueError:
+                ret = False
+
+            if ret is None:
+                # Wait for the rest of the frame
+                break
+
+            if ret is not False:
+                payload, end = ret
+                if end + FRAME_CRC_SIZE > len(self.buf):
+                    break
+
+                crc = struct.unpack_from("<H", self.buf, end)[0]
+                if crc == crc16_ccitt(payload):
+                    payloads.append(payload)
+                    del self.buf[:end + FRAME_CRC_SIZE]
+                    continue
+
+            # Not a valid frame, look for the next magic
+            self.crc_errors += 1
+            self.skipped_bytes += 1
+            del self.buf[:1]
+
+        return payloads
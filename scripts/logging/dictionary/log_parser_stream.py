@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Streaming Log Parser for Dictionary-based Logging
+
+This decodes the framed output of CONFIG_LOG_DICTIONARY_FRAMING as it
+arrives, from a serial port, a file or the standard input. The database
+is loaded once, and only complete, CRC checked frames are parsed so that
+the parser can be attached to a running target.
+"""
+
+import argparse
+import logging
+import sys
+
+import dictionary_parser
+from dictionary_parser.framing import FrameDecoder
+from dictionary_parser.log_database import LogDatabase
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+READ_SIZE = 4096
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("input", nargs="?", default="-",
+                           help="Log data file, or - for the standard input (default)")
+    argparser.add_argument("--serial", metavar="BAUDRATE", type=int,
+                           help="Input is a serial port opened with this baud rate")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def open_input(args):
+    """Return a function reading the next chunk of input, empty at the end"""
+    if args.serial is not None:
+        import serial  # pylint: disable=import-outside-toplevel
+
+        ser = serial.Serial(args.input, args.serial, timeout=0.1)
+
+        # A serial port never ends, return what is there or wait a bit
+        return lambda: ser.read(max(1, ser.in_waiting)) or b""
+
+    if args.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(args.input, "rb")  # pylint: disable=consider-using-with
+
+    return lambda: stream.read1(READ_SIZE) if hasattr(stream, "read1") \
+        else stream.read(READ_SIZE)
+
+
+def main():
+    """Main function of the streaming parser"""
+    args = parse_args()
+
+    logging.basicConfig(format=LOGGER_FORMAT)
+
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    logger.debug("# Build ID: %s", database.get_build_id())
+
+    read = open_input(args)
+    decoder = FrameDecoder()
+    crc_errors = 0
+
+    while True:
+        data = read()
+        if not data and args.serial is None:
+            break
+
+        for payload in decoder.feed(data):
+            if not log_parser.parse_log_data(payload):
+                logger.error("ERROR: there were error(s) parsing log data")
+
+        if decoder.crc_errors != crc_errors:
+            crc_errors = decoder.crc_errors
+            logger.debug("# Dropped invalid frame (%d so far)", crc_errors)
+
+    if decoder.skipped_bytes:
+        logger.debug("# Skipped %d bytes outside of frames", decoder.skipped_bytes)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Convert the function entries and exits recorded with
+CONFIG_PROFILING_INSTRUMENTATION into a trace for Perfetto or
+chrome://tracing, and into call graph timings.
+
+The input is the output of the "instr dump" shell command. Function and
+thread names are taken from the symbols of the ELF file. Each CPU is shown
+as a process and each thread as a thread of the trace.
+
+Usage:
+    ./scripts/profiling/instr_trace.py <instr dump output> <ELF file> -o trace.json
+    ./scripts/profiling/instr_trace.py <instr dump output> <ELF file> --summary
+"""
+
+import argparse
+import bisect
+import json
+import re
+import sys
+from collections import defaultdict
+
+from elftools.elf.elffile import ELFFile
+
+HEADER_RE = re.compile(r"Instr dump (\d+) records (\d+) Hz")
+RECORD_RE = re.compile(r"(\d+) ([EX]) ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+)\s*$")
+END_RE = re.compile(r"Instr dump end")
+
+
+class Symbols:
+    def __init__(self, elf):
+        syms = []
+        for sym in elf.get_section_by_name(".symtab").iter_symbols():
+            if sym.entry.st_info.type not in ("STT_FUNC", "STT_OBJECT"):
+                continue
+            # Bit 0 of Thumb function symbols is set
+            start = sym.entry.st_value & ~1
+            syms.append((start, start + max(sym.entry.st_size, 1), sym.name))
+        syms.sort()
+        self.starts = [s[0] for s in syms]
+        self.syms = syms
+
+    def name(self, addr):
+        i = bisect.bisect_right(self.starts, addr & ~1) - 1
+        if i >= 0 and addr & ~1 < self.syms[i][1]:
+            return self.syms[i][2]
+        return f"0x{addr:x}"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("dump", help="output of the \"instr dump\" shell command")
+    parser.add_argument("elf", help="ELF file of the application")
+    parser.add_argument("-o", "--output", help="JSON trace file to write")
+    parser.add_argument("--summary", action="store_true",
+                        help="print the time spent in each function and call")
+    return parser.parse_args()
+
+
+def read_dump(path):
+    """Return the cycles per second and the records of the last dump"""
+    freq = None
+    records = []
+    with open(path, "r") as f:
+        for line in f:
+            m = HEADER_RE.search(line)
+            if m:
+                freq = int(m.group(2))
+                records = []
+                continue
+            m = RECORD_RE.search(line)
+            if m and freq is not None:
+                records.append((int(m.group(1)), m.group(2) == "E", int(m.group(3), 16),
+                                int(m.group(4), 16), int(m.group(5), 16)))
+
+    if freq is None:
+        sys.exit(f"{path}: no \"instr dump\" output found")
+
+    return freq, records
+
+
+def unwrap(records):
+    """Turn the 32 bits cycle counter values of each CPU into monotonic values"""
+    last = {}
+    high = defaultdict(int)
+    out = []
+    for cpu, entry, ts, func, thread in records:
+        if cpu in last and ts < last[cpu]:
+            high[cpu] += 1 << 32
+        last[cpu] = ts
+        out.append((cpu, entry, ts + high[cpu], func, thread))
+    return out
+
+
+def calls(records):
+    """Pair the entries and exits of each thread, yielding
+    (cpu, thread, func, caller, start, end, nested time)"""
+    stacks = defaultdict(list)
+    for cpu, entry, ts, func, thread in records:
+        stack = stacks[thread]
+        if entry:
+            stack.append([func, ts, 0, cpu])
+            continue
+        # Exits without entry were recorded before the oldest record kept
+        while stack and stack[-1][0] != func:
+            stack.pop()
+        if not stack:
+            continue
+        func, start, nested, cpu = stack.pop()
+        caller = stack[-1][0] if stack else None
+        if stack:
+            stack[-1][2] += ts - start
+        yield cpu, thread, func, caller, start, ts, nested
+
+
+def write_trace(path, records, freq, syms):
+    events = []
+    threads = set()
+    for cpu, thread, func, _, start, end, _ in calls(records):
+        threads.add((cpu, thread))
+        events.append({
+            "name": syms.name(func),
+            "ph": "X",
+            "pid": cpu,
+            "tid": thread,
+            "ts": start * 1e6 / freq,
+            "dur": (end - start) * 1e6 / freq,
+        })
+
+    for cpu in sorted({cpu for cpu, _ in threads}):
+        events.append({"name": "process_name", "ph": "M", "pid": cpu,
+                       "args": {"name": f"CPU {cpu}"}})
+    for cpu, thread in sorted(threads):
+        events.append({"name": "thread_name", "ph": "M", "pid": cpu, "tid": thread,
+                       "args": {"name": syms.name(thread)}})
+
+    with open(path, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+
+
+def print_summary(records, freq, syms):
+    funcs = defaultdict(lambda: [0, 0, 0])
+    edges = defaultdict(lambda: [0, 0])
+    for _, _, func, caller, start, end, nested in calls(records):
+        total = end - start
+        funcs[func][0] += 1
+        funcs[func][1] += total
+        funcs[func][2] += total - nested
+        edges[(caller, func)][0] += 1
+        edges[(caller, func)][1] += total
+
+    def us(cycles):
+        return cycles * 1e6 / freq
+
+    print(f"{'calls':>8} {'total us':>12} {'self us':>12}  function")
+    for func, (count, total, self_time) in sorted(funcs.items(), key=lambda f: -f[1][2]):
+        print(f"{count:>8} {us(total):>12.2f} {us(self_time):>12.2f}  {syms.name(func)}")
+
+    print()
+    print(f"{'calls':>8} {'total us':>12}  caller -> callee")
+    for (caller, func), (count, total) in sorted(edges.items(), key=lambda e: -e[1][1]):
+        name = syms.name(caller) if caller is not None else "[root]"
+        print(f"{count:>8} {us(total):>12.2f}  {name} -> {syms.name(func)}")
+
+
+def main():
+    args = parse_args()
+
+    with open(args.elf, "rb") as f:
+        syms = Symbols(ELFFile(f))
+
+    freq, records = read_dump(args.dump)
+    # Order the records of all the CPUs, for the threads which migrated
+    records = sorted(unwrap(records), key=lambda r: r[2])
+
+    if args.output:
+        write_trace(args.output, records, freq, syms)
+    if args.summary or not args.output:
+        print_summary(records, freq, syms)
+
+
+if __name__ == "__main__":
+    main()
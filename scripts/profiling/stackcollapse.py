@@ -10,7 +10,9 @@ Stack compressor for FlameGraph
 
 This translate stack samples captured by perf subsystem into format
 used by flamegraph.pl. Translation uses .elf file to get function names
-from addresses
+from addresses. Output of both "perf printbuf" and "perf stream" is
+accepted, samples are attributed to the k_thread objects recorded with
+CONFIG_PROFILING_PERF_THREAD.
 
 Usage:
     ./script/perf/stackcollapse.py <file with perf printbuf output> <ELF file>
@@ -28,7 +30,9 @@ from elftools.elf.elffile import ELFFile
 def addr_to_sym(addr, elf):
     symtab = elf.get_section_by_name(".symtab")
     for sym in symtab.iter_symbols():
-        if sym.entry.st_info.type == "STT_FUNC" and sym.entry.st_value <= addr < sym.entry.st_value + sym.entry.st_size:
+        # Bit 0 of Thumb function symbols is set
+        start = sym.entry.st_value & ~1
+        if sym.entry.st_info.type in ("STT_FUNC", "STT_OBJECT") and start <= addr < start + sym.entry.st_size:
             return sym.name
     if addr == 0:
         return "nullptr"
@@ -60,6 +64,14 @@ if __name__ == "__main__":
         inp = f.read()
 
     lines = inp.splitlines()
-    assert int(re.match(r"Perf buf length (\d+)", lines[0]).group(1)) == len(lines) - 1
-    buf = binascii.unhexlify("".join(lines[1:]))
-    collapse(buf, elf)
+    i = 0
+    while i < len(lines):
+        m = re.search(r"Perf buf length (\d+)", lines[i])
+        i += 1
+        if not m:
+            continue
+        length = int(m.group(1))
+        assert i + length <= len(lines)
+        buf = binascii.unhexlify("".join(line.strip() for line in lines[i:i + length]))
+        collapse(buf, elf)
+        i += length
@@ -527,6 +527,29 @@ structure in the main Zephyr tree: boards/<vendor>/<board_name>/""")
              "warn on any footprint change, increase or decrease. "
              "Implies --footprint-threshold=0")
 
+    footprint_group.add_argument(
+        "--compare-recording",
+        metavar='FILENAME',
+        help="Use this report file as a baseline for the data recorded by the harnesses, "
+             "see the 'record' harness configuration. Numeric fields are expected to be "
+             "lower the better unless listed in its 'compare: higher_better' option. "
+             "The file should be of 'twister.json' schema.")
+
+    footprint_group.add_argument(
+        "--recording-threshold",
+        type=float,
+        default=5.0,
+        help="With recording comparison to a baseline, warn about any recorded value "
+             "getting worse by the specified percentage value or more, unless the test "
+             "suite sets its own 'compare: threshold'. "
+             "Default is %(default)s for %(default)s%% delta from the baseline value.")
+
+    footprint_group.add_argument(
+        "--fail-on-regression",
+        action="store_true",
+        help="Fail the run when the footprint or recording comparison to a baseline "
+             "warns about a regression, so that it is reviewed like a test failure.")
+
     footprint_group.add_argument(
         "-z", "--size",
         action="append",
@@ -534,7 +534,7 @@ class Reporting:
     def footprint_reports(self, report, show_footprint, all_deltas,
                           footprint_threshold, last_metrics):
         if not report:
-            return
+            return 0
 
         logger.debug("running footprint_reports")
         deltas = self.compare_metrics(report)
@@ -566,6 +566,97 @@ class Reporting:
                            warnings,
                            (report if not last_metrics else "the last twister run.")))
 
+        return warnings
+
+    @staticmethod
+    def _recording_values(record, prefix=""):
+        # Numeric fields, nested 'as_json' ones with dotted names, and the
+        # other fields which tell the records apart.
+        values = {}
+        labels = {}
+        for k, v in record.items():
+            name = f"{prefix}{k}"
+            if isinstance(v, dict):
+                nested_values, nested_labels = Reporting._recording_values(v, f"{name}.")
+                values.update(nested_values)
+                labels.update(nested_labels)
+            elif isinstance(v, bool | list):
+                continue
+            else:
+                try:
+                    values[name] = float(v)
+                except (TypeError, ValueError):
+                    labels[name] = v
+        return values, labels
+
+    @staticmethod
+    def _recording_index(recording):
+        # Records with the same labels are matched in order of appearance.
+        index = {}
+        occurrences = {}
+        for record in recording or []:
+            values, labels = Reporting._recording_values(record)
+            label_key = tuple(sorted(labels.items()))
+            n = occurrences.get(label_key, 0)
+            occurrences[label_key] = n + 1
+            index[(label_key, n)] = values
+        return index
+
+    def compare_recordings(self, filename, threshold):
+        if not os.path.exists(filename):
+            logger.error(f"Cannot compare recordings, {filename} not found")
+            return []
+
+        saved_recordings = {}
+        with open(filename) as fp:
+            jt = json.load(fp)
+            for ts in jt.get("testsuites", []):
+                if ts.get("recording"):
+                    saved_recordings[(ts.get('name'), ts.get('platform'))] = ts["recording"]
+
+        results = []
+        for instance in self.instances.values():
+            mkey = (instance.testsuite.name, instance.platform.name)
+            if not instance.recording or mkey not in saved_recordings:
+                continue
+            harness_config = instance.testsuite.harness_config or {}
+            compare = harness_config.get('record', {}).get('compare', {})
+            higher_better = compare.get('higher_better', [])
+            ignore = compare.get('ignore', [])
+            suite_threshold = compare.get('threshold', threshold)
+
+            saved_index = self._recording_index(saved_recordings[mkey])
+            for key, values in self._recording_index(instance.recording).items():
+                if key not in saved_index:
+                    continue
+                for metric, value in values.items():
+                    saved = saved_index[key].get(metric)
+                    if metric in ignore or not saved:
+                        continue
+                    change = (value - saved) / abs(saved)
+                    if metric in higher_better:
+                        change = -change
+                    if change * 100.0 >= suite_threshold:
+                        results.append((instance, dict(key[0]), metric, saved, value, change))
+        return results
+
+    def recording_reports(self, report, threshold):
+        logger.debug("running recording_reports")
+        regressions = self.compare_recordings(report, threshold)
+
+        for i, labels, metric, saved, value, change in regressions:
+            record = " ".join(f"{k}={v}" for k, v in labels.items())
+            logger.warning(
+                f"{i.platform.name:<25} {i.testsuite.name:<60} {record} {metric}"
+                f" {saved:g} -> {value:g}, {change:.2%} worse"
+            )
+
+        if regressions:
+            logger.warning(f"Found {len(regressions)} recording regressions to {report}"
+                           " as a baseline.")
+
+        return len(regressions)
+
     def synopsis(self):
         if self.env.options.report_summary == 0:
             count = self.instance_fail_count
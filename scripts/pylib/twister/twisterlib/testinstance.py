@@ -8,6 +8,7 @@
 from __future__ import annotations
 
 import csv
+import json
 import glob
 import hashlib
 import logging
@@ -120,6 +121,9 @@ class TestInstance:
                 cw.writeheader()
                 cw.writerows(self.recording)
 
+            with open(os.path.join(self.build_dir, "recording.json"), 'w') as jsonfile:
+                json.dump(self.recording, jsonfile, indent=4)
+
     @property
     def status(self) -> TwisterStatus:
         return self._status
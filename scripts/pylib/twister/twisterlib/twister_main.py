@@ -169,7 +169,7 @@ def twister(options: argparse.Namespace, default_options: argparse.Namespace):
     elif options.last_metrics:
         report_to_use = previous_results_file
 
-    report.footprint_reports(
+    regressions = report.footprint_reports(
         report_to_use,
         options.show_footprint,
         options.all_deltas,
@@ -177,6 +177,12 @@ def twister(options: argparse.Namespace, default_options: argparse.Namespace):
         options.last_metrics,
     )
 
+    if options.compare_recording:
+        regressions += report.recording_reports(
+            options.compare_recording,
+            options.recording_threshold,
+        )
+
     duration = time.time() - start_time
 
     if options.verbose > 1:
@@ -213,6 +219,7 @@ def twister(options: argparse.Namespace, default_options: argparse.Namespace):
         or runner.results.error
         or (tplan.warnings and options.warnings_as_errors)
         or (options.coverage and not report.coverage_status)
+        or (regressions and options.fail_on_regression)
     ):
         if env.options.quit_on_failure:
             logger.info("twister aborted because of a failure/error")
@@ -258,10 +258,14 @@ def test_testinstance_record(testinstance):
 
     print(mock_file.mock_calls)
 
-    mock_file.assert_called_with(
+    mock_file.assert_any_call(
         os.path.join(testinstance.build_dir, 'recording.csv'),
         'w'
     )
+    mock_file.assert_any_call(
+        os.path.join(testinstance.build_dir, 'recording.json'),
+        'w'
+    )
 
     mock_writeheader.assert_has_calls([mock.call({ k:k for k in recording[0]})])
     mock_writerows.assert_has_calls([mock.call(recording)])
@@ -0,0 +1,412 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to convert CTF tracing data into a Perfetto trace, to be opened with
+https://ui.perfetto.dev or the trace_processor.
+
+The trace shows:
+
+- a lane per CPU with the threads it ran and a lane with its ISRs,
+- a lane per thread with the kernel calls it made, semaphore and mutex
+  operations annotated with the object and the result, and its state
+  changes,
+- a lane per semaphore and mutex, with the owner of the mutexes,
+- the lifetime of network packets, from the net_rx_time / net_tx_time
+  events, along with the sending and receiving calls.
+
+Generate trace using samples/subsys/tracing for example:
+
+    west build -b qemu_x86 samples/subsys/tracing  -t run \\
+      -- -DCONF_FILE=prj_uart_ctf.conf
+
+    mkdir ctf
+    cp build/channel0_0 ctf/
+    cp subsys/tracing/ctf/tsdl/metadata ctf/
+    ./scripts/tracing/trace_perfetto.py -t ctf -o trace.perfetto
+
+With per-CPU buffers, the streams written by trace_split_cpus.py are
+shown on the lanes of their CPU.
+"""
+
+import argparse
+import numbers
+import re
+import sys
+
+# Perfetto protobuf field numbers, see protos/perfetto/trace in the
+# Perfetto sources.
+TRACE_PACKET = 1
+PACKET_TIMESTAMP = 8
+PACKET_SEQUENCE_ID = 10
+PACKET_TRACK_EVENT = 11
+PACKET_SEQUENCE_FLAGS = 13
+PACKET_TRACK_DESCRIPTOR = 60
+SEQ_INCREMENTAL_STATE_CLEARED = 1
+
+TRACK_UUID = 1
+TRACK_NAME = 2
+TRACK_PROCESS = 3
+TRACK_THREAD = 4
+TRACK_PARENT_UUID = 5
+PROCESS_PID = 1
+PROCESS_NAME = 6
+THREAD_PID = 1
+THREAD_TID = 2
+THREAD_NAME = 5
+
+EVENT_ANNOTATION = 4
+EVENT_TYPE = 9
+EVENT_TRACK_UUID = 11
+EVENT_CATEGORY = 22
+EVENT_NAME = 23
+TYPE_SLICE_BEGIN = 1
+TYPE_SLICE_END = 2
+TYPE_INSTANT = 3
+
+ANNOTATION_INT = 4
+ANNOTATION_STRING = 6
+ANNOTATION_POINTER = 7
+ANNOTATION_NAME = 10
+
+ZEPHYR_PID = 1
+SEQUENCE_ID = 1
+
+# Fields holding kernel object or packet addresses
+POINTER_FIELDS = {'id', 'thread_id', 'iface', 'pkt', 'stack_base'}
+
+THREAD_STATE_EVENTS = {
+    'thread_create': 'created',
+    'thread_abort': 'aborted',
+    'thread_suspend': 'suspended',
+    'thread_resume': 'resumed',
+    'thread_ready': 'ready',
+    'thread_pending': 'pending',
+    'thread_wakeup': 'woken up',
+    'thread_priority_set': 'priority set',
+    'user_mode_enter': 'user mode',
+}
+
+NAME_EVENTS = {'thread_create', 'thread_name_set', 'thread_info',
+               'thread_switched_in', 'thread_switched_out'}
+
+
+def varint(value):
+    value &= (1 << 64) - 1
+    out = bytearray()
+    while True:
+        byte = value & 0x7f
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+def field_varint(field, value):
+    return varint(field << 3) + varint(value)
+
+def field_bytes(field, data):
+    return varint(field << 3 | 2) + varint(len(data)) + data
+
+def field_string(field, string):
+    return field_bytes(field, string.encode('utf-8', 'replace'))
+
+def annotation(name, value):
+    data = field_string(ANNOTATION_NAME, name)
+    if isinstance(value, str):
+        data += field_string(ANNOTATION_STRING, value)
+    elif name in POINTER_FIELDS:
+        data += field_varint(ANNOTATION_POINTER, value)
+    else:
+        data += field_varint(ANNOTATION_INT, value)
+    return field_bytes(EVENT_ANNOTATION, data)
+
+
+class Track:
+    def __init__(self, uuid, name, parent=None, tid=None, process=False):
+        self.uuid = uuid
+        self.name = name
+        self.parent = parent
+        self.tid = tid
+        self.process = process
+        # Names of the slices in progress
+        self.stack = []
+
+    def descriptor(self):
+        data = field_varint(TRACK_UUID, self.uuid)
+        if self.tid is not None:
+            thread = (field_varint(THREAD_PID, ZEPHYR_PID) +
+                      field_varint(THREAD_TID, self.tid) +
+                      field_string(THREAD_NAME, self.name))
+            data += field_bytes(TRACK_THREAD, thread)
+        elif self.process:
+            process = (field_varint(PROCESS_PID, ZEPHYR_PID) +
+                       field_string(PROCESS_NAME, self.name))
+            data += field_bytes(TRACK_PROCESS, process)
+        else:
+            data += field_string(TRACK_NAME, self.name)
+        if self.parent is not None:
+            data += field_varint(TRACK_PARENT_UUID, self.parent)
+        return field_bytes(PACKET_TRACK_DESCRIPTOR, data)
+
+
+class Converter:
+    """Turn events into Perfetto track events.
+
+    Events are given in timestamp order as (ns, cpu, name, fields) with
+    fields a dictionary of ints and strings.
+    """
+
+    def __init__(self):
+        self.tracks = {}
+        self.packets = []
+        self.process = self.track(('process',), 'Zephyr', process=True)
+        self.objects = self.track(('objects',), 'Kernel objects')
+        self.network = self.track(('network',), 'Network packets')
+        # Per CPU: running thread id and ISR nesting level
+        self.current = {}
+        self.isr_level = {}
+        self.thread_names = {}
+        self.threads = {}
+        # Lock nesting of the mutexes
+        self.mutex_locks = {}
+        # Length of the packets being sent or received
+        self.pkts = {}
+        # End of the last lifetime shown on each network lane
+        self.pkt_lanes = {}
+
+    def track(self, key, name, parent=None, tid=None, process=False):
+        if key not in self.tracks:
+            self.tracks[key] = Track(len(self.tracks) + 1, name, parent, tid, process)
+        return self.tracks[key]
+
+    def cpu_track(self, cpu):
+        return self.track(('cpu', cpu), 'CPU {}'.format(cpu))
+
+    def isr_track(self, cpu):
+        return self.track(('isr', cpu), 'CPU {} ISR'.format(cpu))
+
+    def thread_track(self, thread_id):
+        if thread_id not in self.threads:
+            self.threads[thread_id] = self.track(('thread', thread_id), '', self.process.uuid,
+                                                 tid=len(self.threads) + 1)
+        return self.threads[thread_id]
+
+    def object_track(self, kind, obj):
+        return self.track((kind, obj), '{} {:#x}'.format(kind, obj), self.objects.uuid)
+
+    def context_track(self, cpu):
+        """Track of the code running on cpu: its ISR or its thread"""
+        if self.isr_level.get(cpu, 0) > 0:
+            return self.isr_track(cpu)
+        if cpu in self.current:
+            return self.thread_track(self.current[cpu])
+        return self.cpu_track(cpu)
+
+    def emit(self, ns, track, kind, name=None, fields=None, category=None):
+        data = field_varint(EVENT_TYPE, kind) + field_varint(EVENT_TRACK_UUID, track.uuid)
+        if name is not None:
+            data += field_string(EVENT_NAME, name)
+        if category is not None:
+            data += field_string(EVENT_CATEGORY, category)
+        for key, value in (fields or {}).items():
+            data += annotation(key, value)
+        self.packets.append((ns, data))
+
+    def begin(self, ns, track, name, fields=None, category=None):
+        track.stack.append(name)
+        self.emit(ns, track, TYPE_SLICE_BEGIN, name, fields, category)
+
+    def end(self, ns, track, name=None, fields=None):
+        """End the slice name, or the innermost one if name is None"""
+        if not track.stack or (name is not None and track.stack[-1] != name):
+            # Its beginning was lost
+            return
+        track.stack.pop()
+        self.emit(ns, track, TYPE_SLICE_END, fields=fields)
+
+    def instant(self, ns, track, name, fields=None, category=None):
+        self.emit(ns, track, TYPE_INSTANT, name, fields, category)
+
+    def thread_name(self, thread_id):
+        return self.thread_names.get(thread_id) or '{:#x}'.format(thread_id)
+
+    def switch_in(self, ns, cpu, thread_id):
+        self.switch_out(ns, cpu)
+        self.current[cpu] = thread_id
+        self.thread_track(thread_id)
+        self.begin(ns, self.cpu_track(cpu), self.thread_name(thread_id),
+                   {'thread_id': thread_id}, 'sched')
+
+    def switch_out(self, ns, cpu):
+        # The calls of the thread in progress go on while it is switched
+        # out, only the CPU lane shows when it runs.
+        if self.current.pop(cpu, None) is not None:
+            self.end(ns, self.cpu_track(cpu))
+
+    def pkt_lifetime(self, ns, name, fields):
+        # The duration is counted from the creation of the packet
+        pkt = fields.get('pkt', 0)
+        start = ns - fields.get('duration_us', 0) * 1000
+        pkt_len = self.pkts.pop(pkt, None)
+
+        # Lifetimes overlap, spread them on as many lanes as needed
+        lane = 0
+        while self.pkt_lanes.get((name, lane), -1) > start:
+            lane += 1
+        self.pkt_lanes[(name, lane)] = ns
+
+        track = self.track(('pkt', name, lane), '{} {}'.format(name, lane),
+                           self.network.uuid)
+        if pkt_len is not None:
+            fields = dict(fields, pkt_len=pkt_len)
+        # The beginning is sorted back at its place in time when serializing
+        self.emit(start, track, TYPE_SLICE_BEGIN, 'pkt {:#x}'.format(pkt), fields, 'net')
+        self.emit(ns, track, TYPE_SLICE_END)
+
+    def event(self, ns, cpu, name, fields):
+        if 'thread_id' in fields and name in NAME_EVENTS and fields.get('name'):
+            self.thread_names[fields['thread_id']] = fields['name']
+
+        if name == 'thread_switched_in':
+            self.switch_in(ns, cpu, fields['thread_id'])
+        elif name == 'thread_switched_out':
+            self.switch_out(ns, cpu)
+        elif name == 'isr_enter':
+            self.isr_level[cpu] = self.isr_level.get(cpu, 0) + 1
+            self.begin(ns, self.isr_track(cpu), 'ISR', category='irq')
+        elif name in ('isr_exit', 'isr_exit_to_scheduler'):
+            if self.isr_level.get(cpu, 0) > 0:
+                self.isr_level[cpu] -= 1
+                self.end(ns, self.isr_track(cpu), 'ISR')
+        elif name in THREAD_STATE_EVENTS:
+            self.instant(ns, self.thread_track(fields['thread_id']),
+                         THREAD_STATE_EVENTS[name], fields, 'sched')
+        elif name in ('net_recv_data_enter', 'net_send_data_enter'):
+            self.pkts[fields.get('pkt', 0)] = fields.get('pkt_len', 0)
+            self.call(ns, cpu, name, fields)
+        elif name in ('net_rx_time', 'net_tx_time'):
+            self.pkt_lifetime(ns, 'RX' if name == 'net_rx_time' else 'TX', fields)
+        else:
+            self.call(ns, cpu, name, fields)
+
+        self.kernel_object(ns, cpu, name, fields)
+
+    def call(self, ns, cpu, name, fields):
+        """Show _enter / _exit pairs as slices of the calling context"""
+        track = self.context_track(cpu)
+        category = name.split('_')[0]
+
+        if name.endswith('_enter'):
+            self.begin(ns, track, name[:-len('_enter')], fields, category)
+        elif name.endswith('_exit'):
+            self.end(ns, track, name[:-len('_exit')], fields)
+        else:
+            self.instant(ns, track, name, fields, category)
+
+    def kernel_object(self, ns, cpu, name, fields):
+        """Show the operations on semaphores and mutexes on their lanes"""
+        if name.startswith('semaphore_'):
+            kind, op = 'sem', name[len('semaphore_'):]
+        elif name.startswith('mutex_'):
+            kind, op = 'mutex', name[len('mutex_'):]
+        else:
+            return
+
+        obj = fields.get('id', 0)
+        track = self.object_track(kind, obj)
+        thread = self.thread_name(self.current[cpu]) if cpu in self.current else 'ISR'
+
+        if op == 'lock_exit' and fields.get('ret', 0) == 0:
+            # Mutexes can be locked recursively by their owner
+            self.mutex_locks[obj] = self.mutex_locks.get(obj, 0) + 1
+            if self.mutex_locks[obj] == 1:
+                self.begin(ns, track, 'held by ' + thread, category=kind)
+        elif op == 'unlock_exit' and self.mutex_locks.get(obj, 0) > 0:
+            self.mutex_locks[obj] -= 1
+            if self.mutex_locks[obj] == 0:
+                self.end(ns, track)
+        elif op in ('init', 'reset', 'give_enter', 'take_blocking', 'lock_blocking') or \
+             (op == 'take_exit' and fields.get('ret', 0) == 0):
+            op = op.replace('_enter', '').replace('_exit', '').replace('_', ' ')
+            self.instant(ns, track, op, dict(fields, thread=thread), kind)
+
+    def serialize(self):
+        out = bytearray()
+        first = True
+        # Thread names are known once the whole trace is read
+        for thread_id, track in self.threads.items():
+            track.name = self.thread_name(thread_id)
+
+        for track in self.tracks.values():
+            packet = field_varint(PACKET_SEQUENCE_ID, SEQUENCE_ID) + track.descriptor()
+            if first:
+                packet += field_varint(PACKET_SEQUENCE_FLAGS, SEQ_INCREMENTAL_STATE_CLEARED)
+                first = False
+            out += field_bytes(TRACE_PACKET, packet)
+
+        # Packet lifetimes are emitted with their beginning in the past
+        for ns, data in sorted(self.packets, key=lambda p: p[0]):
+            packet = (field_varint(PACKET_TIMESTAMP, ns) +
+                      field_varint(PACKET_SEQUENCE_ID, SEQUENCE_ID) +
+                      field_bytes(PACKET_TRACK_EVENT, data))
+            out += field_bytes(TRACE_PACKET, packet)
+        return bytes(out)
+
+
+def field_value(field):
+    if isinstance(field, numbers.Integral):
+        return int(field)
+    return str(field)
+
+def read_ctf(trace):
+    try:
+        import bt2
+    except ImportError:
+        sys.exit("Missing dependency: You need to install python bindings of babeltrace.")
+
+    for msg in bt2.TraceCollectionMessageIterator(trace):
+        if not isinstance(msg, bt2._EventMessageConst):
+            continue
+
+        event = msg.event
+        # Streams split per CPU are named channel0_<cpu>
+        match = re.search(r'_(\d+)$', str(event.stream.name or ''))
+        cpu = int(match.group(1)) if match else 0
+
+        fields = {}
+        if event.payload_field is not None:
+            for name, field in event.payload_field.items():
+                fields[name] = field_value(field)
+
+        yield msg.default_clock_snapshot.ns_from_origin, cpu, event.name, fields
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-t", "--trace", required=True,
+                        help="tracing data (directory with metadata and trace files)")
+    parser.add_argument("-o", "--output", default="trace.perfetto",
+                        help="Perfetto trace file to write")
+    return parser.parse_args()
+
+def main():
+    args = parse_args()
+
+    converter = Converter()
+    count = 0
+    for ns, cpu, name, fields in read_ctf(args.trace):
+        converter.event(ns, cpu, name, fields)
+        count += 1
+
+    with open(args.output, "wb") as f:
+        f.write(converter.serialize())
+
+    print("{} events converted to {}".format(count, args.output))
+
+if __name__ == "__main__":
+    main()
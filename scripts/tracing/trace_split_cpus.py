@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#
+# Copyright The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to split tracing data captured with CONFIG_TRACING_PER_CPU_BUFFERS
+into one CTF stream file per CPU.
+
+The captured data is made of chunks, each one prefixed with a 6 bytes
+header: the 'Z', 'T' magic, the CPU id, a reserved byte and the length of
+the chunk as a 16 bits little endian value. The data of CPU n is written to
+<output_dir>/channel0_<n>, babeltrace merges the streams by timestamp when
+pointed to the directory holding them and the metadata file.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b'ZT'
+HDR = struct.Struct('<2sBxH')
+
+def parse_args():
+    global args
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter, allow_abbrev=False)
+    parser.add_argument("-i", "--input", required=True,
+                        help="captured tracing data")
+    parser.add_argument("-o", "--output_dir", default='.',
+                        help="directory to write the per-CPU streams to")
+    args = parser.parse_args()
+
+def split(data):
+    streams = {}
+    skipped = 0
+    pos = 0
+
+    while pos + HDR.size <= len(data):
+        magic, cpu, length = HDR.unpack_from(data, pos)
+        end = pos + HDR.size + length
+        if magic != MAGIC or length == 0 or end > len(data):
+            # Lost sync, look for the next header
+            pos += 1
+            skipped += 1
+            continue
+
+        streams.setdefault(cpu, bytearray()).extend(data[pos + HDR.size:end])
+        pos = end
+
+    return streams, skipped + len(data) - pos
+
+def main():
+    parse_args()
+
+    try:
+        with open(args.input, "rb") as f:
+            data = f.read()
+    except OSError as e:
+        sys.exit("{}".format(e))
+
+    streams, skipped = split(data)
+    if skipped:
+        print("{} bytes skipped".format(skipped))
+
+    for cpu, stream in sorted(streams.items()):
+        name = os.path.join(args.output_dir, "channel0_{}".format(cpu))
+        with open(name, "wb") as f:
+            f.write(stream)
+        print("CPU {}: {} bytes written to {}".format(cpu, len(stream), name))
+
+if __name__=="__main__":
+    main()
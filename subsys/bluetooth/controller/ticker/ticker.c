@@ -15,6 +15,10 @@
 
 #include "ticker.h"
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+#include <zephyr/kernel.h>
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 #include "hal/debug.h"
 
 /*****************************************************************************
@@ -336,6 +340,10 @@ struct ticker_instance {
 	bool expire_infos_outdated;
 #endif /* CONFIG_BT_TICKER_EXT_EXPIRE_INFO */
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	struct ticker_job_profile profile; /* Ticker job execution profile */
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	ticker_caller_id_get_cb_t caller_id_get_cb; /* Function for retrieving
 						     * the caller id from user
 						     * id
@@ -559,6 +567,26 @@ static void ticker_by_next_slot_get(struct ticker_instance *instance,
 }
 #endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET */
 
+/**
+ * @brief Record the number of nodes walked to enqueue a ticker node
+ *
+ * @param instance Pointer to ticker instance
+ * @param walk     Number of nodes walked so far
+ * @internal
+ */
+static inline void ticker_profile_walk(struct ticker_instance *instance,
+				       uint8_t walk)
+{
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	if (walk > instance->profile.enqueue_walk_max) {
+		instance->profile.enqueue_walk_max = walk;
+	}
+#else /* !CONFIG_BT_TICKER_JOB_PROFILE */
+	ARG_UNUSED(instance);
+	ARG_UNUSED(walk);
+#endif /* !CONFIG_BT_TICKER_JOB_PROFILE */
+}
+
 #if !defined(CONFIG_BT_TICKER_LOW_LAT)
 /**
  * @brief Enqueue ticker node
@@ -579,6 +607,7 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_to_expire_current;
 	struct ticker_node *node;
 	uint32_t ticks_to_expire;
+	__maybe_unused uint8_t walk = 0U;
 	uint8_t previous;
 	uint8_t current;
 
@@ -597,6 +626,7 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		(ticker_current = &node[current])->ticks_to_expire))) {
 
 		ticks_to_expire -= ticks_to_expire_current;
+		ticker_profile_walk(instance, ++walk);
 
 		/* Check for timeout in same tick - prioritize according to
 		 * latency
@@ -654,6 +684,7 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 	uint32_t ticks_slot_previous;
 	struct ticker_node *node;
 	uint32_t ticks_to_expire;
+	__maybe_unused uint8_t walk = 0U;
 	uint8_t previous;
 	uint8_t current;
 	uint8_t collide;
@@ -675,6 +706,7 @@ static uint8_t ticker_enqueue(struct ticker_instance *instance, uint8_t id)
 		(ticks_to_expire_current =
 		 (ticker_current = &node[current])->ticks_to_expire))) {
 		ticks_to_expire -= ticks_to_expire_current;
+		ticker_profile_walk(instance, ++walk);
 
 		if (ticker_current->ticks_slot != 0U) {
 			ticks_slot_previous = ticker_current->ticks_slot;
@@ -3221,6 +3253,10 @@ void ticker_job(void *param)
 	uint8_t insert_head;
 	uint32_t ticks_now;
 	uint8_t pending;
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	uint32_t cycles_start;
+	uint32_t cycles;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 
 	DEBUG_TICKER_JOB(1);
 
@@ -3238,6 +3274,10 @@ void ticker_job(void *param)
 	}
 	instance->job_guard = 1U;
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	cycles_start = k_cycle_get_32();
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	/* Back up the previous known tick */
 	ticks_previous = instance->ticks_current;
 
@@ -3362,6 +3402,15 @@ void ticker_job(void *param)
 		compare_trigger = 0U;
 	}
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+	cycles = k_cycle_get_32() - cycles_start;
+	instance->profile.job_cycles = cycles;
+	if (cycles > instance->profile.job_cycles_max) {
+		instance->profile.job_cycles_max = cycles;
+	}
+	instance->profile.job_count++;
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 	/* Permit worker to run */
 	instance->job_guard = 0U;
 
@@ -4215,6 +4264,33 @@ void ticker_job_sched(uint8_t instance_index, uint8_t user_id)
 			   TICKER_CALL_ID_JOB, 0, instance);
 }
 
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/**
+ * @brief Get ticker job execution profile
+ *
+ * @details Copies the profile gathered by ticker_job since initialization
+ * or the last reset. The copy is not atomic with respect to ticker_job, a
+ * sample taken while the job runs may mix values of two executions.
+ *
+ * @param instance_index Index of ticker instance
+ * @param profile        Pointer to profile to fill
+ * @param reset          Clear the maximum values and the job count
+ */
+void ticker_job_profile_get(uint8_t instance_index,
+			    struct ticker_job_profile *profile, bool reset)
+{
+	struct ticker_instance *instance = &_instance[instance_index];
+
+	*profile = instance->profile;
+
+	if (reset) {
+		instance->profile.job_cycles_max = 0U;
+		instance->profile.job_count = 0U;
+		instance->profile.enqueue_walk_max = 0U;
+	}
+}
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
+
 /**
  * @brief Get current absolute tick count
  *
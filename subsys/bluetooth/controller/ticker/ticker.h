@@ -218,6 +218,20 @@ uint8_t ticker_next_slot_get_ext(uint8_t instance_index, uint8_t user_id,
 uint8_t ticker_job_idle_get(uint8_t instance_index, uint8_t user_id,
 			     ticker_op_func fp_op_func, void *op_context);
 void ticker_job_sched(uint8_t instance_index, uint8_t user_id);
+
+#if defined(CONFIG_BT_TICKER_JOB_PROFILE)
+/** \brief Ticker job execution profile.
+ */
+struct ticker_job_profile {
+	uint32_t job_cycles;     /* Duration of the last job, in CPU cycles */
+	uint32_t job_cycles_max; /* Longest job, in CPU cycles */
+	uint32_t job_count;      /* Number of jobs run */
+	uint8_t  enqueue_walk_max; /* Most nodes walked to enqueue a node */
+};
+
+void ticker_job_profile_get(uint8_t instance_index,
+			    struct ticker_job_profile *profile, bool reset);
+#endif /* CONFIG_BT_TICKER_JOB_PROFILE */
 uint32_t ticker_ticks_now_get(void);
 uint32_t ticker_ticks_diff_get(uint32_t ticks_now, uint32_t ticks_old);
 
@@ -752,6 +752,11 @@ static int send_buf(struct bt_conn *conn, struct net_buf *buf,
 	}
 
 	if (!err) {
+		conn->tx_deficit -= frag_len;
+#if defined(CONFIG_BT_CONN_TX_STATS)
+		conn->tx_stats.bytes += frag_len;
+		conn->tx_stats.packets++;
+#endif /* CONFIG_BT_CONN_TX_STATS */
 		return 0;
 	}
 
@@ -827,6 +832,18 @@ static bool should_stop_tx(struct bt_conn *conn)
 	 */
 	if (!conn->has_data(conn)) {
 		LOG_DBG("No more data for %p", conn);
+		/* An idle connection does not save up for later */
+		conn->tx_deficit = 0;
+		return true;
+	}
+
+	/* Deficit round robin: the connection keeps its place at the head of
+	 * the queue while its deficit covers a whole fragment. Otherwise it
+	 * sends this fragment with a new quantum and goes to the back, so a
+	 * bulk transfer cannot starve the other connections.
+	 */
+	if (conn->tx_deficit < (int32_t)conn_mtu(conn)) {
+		conn->tx_deficit += CONFIG_BT_CONN_TX_QUANTUM;
 		return true;
 	}
 
@@ -1022,7 +1039,7 @@ void bt_conn_suspend_tx(bool suspend)
 }
 #endif	/* CONFIG_BT_TESTING */
 
-void bt_conn_tx_processor(void)
+bool bt_conn_tx_processor(void)
 {
 	LOG_DBG("start");
 	struct bt_conn *conn;
@@ -1030,21 +1047,22 @@ void bt_conn_tx_processor(void)
 	bt_conn_tx_cb_t cb = NULL;
 	size_t buf_len;
 	void *ud = NULL;
+	bool sent = false;
 
 	if (!IS_ENABLED(CONFIG_BT_CONN_TX)) {
 		/* Mom, can we have a real compiler? */
-		return;
+		return false;
 	}
 
 	if (IS_ENABLED(CONFIG_BT_TESTING) && _suspend_tx) {
-		return;
+		return false;
 	}
 
 	conn = get_conn_ready();
 
 	if (!conn) {
 		LOG_DBG("no connection wants to do stuff");
-		return;
+		return false;
 	}
 
 	LOG_DBG("processing conn %p", conn);
@@ -1118,10 +1136,13 @@ void bt_conn_tx_processor(void)
 	 * resources or there is nothing left to send.
 	 */
 	bt_tx_irq_raise();
+	sent = true;
 
 exit:
 	/* Give back the ref that `get_conn_ready()` gave us */
 	bt_conn_unref(conn);
+
+	return sent;
 }
 
 static void process_unack_tx(struct bt_conn *conn)
@@ -2849,6 +2870,19 @@ static enum bt_conn_state conn_internal_to_public_state(bt_conn_state_t state)
 	}
 }
 
+#if defined(CONFIG_BT_CONN_TX_STATS)
+int bt_conn_get_tx_stats(const struct bt_conn *conn, struct bt_conn_tx_stats *stats)
+{
+	if (conn == NULL || stats == NULL) {
+		return -EINVAL;
+	}
+
+	*stats = conn->tx_stats;
+
+	return 0;
+}
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 int bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
 {
 	info->type = conn->type;
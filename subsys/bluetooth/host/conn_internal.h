@@ -327,6 +327,15 @@ struct bt_conn {
 	/* Next buffer should be an ACL/ISO HCI fragment */
 	bool			next_is_frag;
 
+	/* Bytes left to send before the TX processor moves on to the next
+	 * data-ready connection. See `should_stop_tx()`.
+	 */
+	int32_t			tx_deficit;
+
+#if defined(CONFIG_BT_CONN_TX_STATS)
+	struct bt_conn_tx_stats	tx_stats;
+#endif /* CONFIG_BT_CONN_TX_STATS */
+
 	/* Must be at the end so that everything else in the structure can be
 	 * memset to zero without affecting the ref.
 	 */
@@ -591,7 +600,10 @@ void bt_conn_cleanup_all(void);
 /* Selects based on connection type right semaphore for ACL packets */
 struct k_sem *bt_conn_get_pkts(struct bt_conn *conn);
 
-void bt_conn_tx_processor(void);
+/* Sends one fragment of the next data-ready connection, returns false if
+ * there was nothing that could be sent.
+ */
+bool bt_conn_tx_processor(void);
 
 /* To be called by upper layers when they want to send something.
  * Functions just like an IRQ.
@@ -1226,6 +1226,104 @@ static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
 	return BT_GATT_ITER_STOP;
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static struct {
+	/* Attribute of each handle, NULL for handles not in use */
+	const struct bt_gatt_attr *attrs[CONFIG_BT_GATT_ATTR_INDEX_SIZE + 1];
+	/* Next handle in the same UUID bucket, 0 at the end of the chain */
+	uint16_t next[CONFIG_BT_GATT_ATTR_INDEX_SIZE + 1];
+	/* First handle of each UUID bucket, chains are in handle order */
+	uint16_t buckets[CONFIG_BT_GATT_ATTR_INDEX_UUID_BUCKETS];
+	uint16_t max_handle;
+	bool valid;
+} attr_index;
+
+/* Equal UUIDs of different types must land in the same bucket, so hash the
+ * 32-bit short form, which is where a 128-bit UUID keeps it.
+ */
+static uint16_t attr_index_bucket(const struct bt_uuid *uuid)
+{
+	uint32_t val;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		val = BT_UUID_16(uuid)->val;
+		break;
+	case BT_UUID_TYPE_32:
+		val = BT_UUID_32(uuid)->val;
+		break;
+	default:
+		val = sys_get_le32(&BT_UUID_128(uuid)->val[12]);
+		break;
+	}
+
+	return val % CONFIG_BT_GATT_ATTR_INDEX_UUID_BUCKETS;
+}
+
+static bool attr_index_set(uint16_t handle, const struct bt_gatt_attr *attr)
+{
+	if (handle > CONFIG_BT_GATT_ATTR_INDEX_SIZE) {
+		LOG_WRN("Handle 0x%04x not indexed, increase CONFIG_BT_GATT_ATTR_INDEX_SIZE",
+			handle);
+		return false;
+	}
+
+	attr_index.attrs[handle] = attr;
+	attr_index.max_handle = MAX(attr_index.max_handle, handle);
+
+	return true;
+}
+
+static void attr_index_build(void)
+{
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+	uint16_t handle = 1;
+
+	attr_index.valid = false;
+	attr_index.max_handle = 0;
+	(void)memset(attr_index.attrs, 0, sizeof(attr_index.attrs));
+	(void)memset(attr_index.buckets, 0, sizeof(attr_index.buckets));
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!attr_index_set(handle, &static_svc->attrs[i])) {
+				return;
+			}
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			if (!attr_index_set(svc->attrs[i].handle, &svc->attrs[i])) {
+				return;
+			}
+		}
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	/* Prepending from the last handle keeps the chains sorted */
+	for (handle = attr_index.max_handle; handle > 0; handle--) {
+		const struct bt_gatt_attr *attr = attr_index.attrs[handle];
+		uint16_t bucket;
+
+		if (attr == NULL) {
+			continue;
+		}
+
+		bucket = attr_index_bucket(attr->uuid);
+		attr_index.next[handle] = attr_index.buckets[bucket];
+		attr_index.buckets[bucket] = handle;
+	}
+
+	attr_index.valid = true;
+}
+#else
+static inline void attr_index_build(void) {}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static const struct bt_gatt_attr *find_attr(uint16_t handle)
 {
 	const struct bt_gatt_attr *attr = NULL;
@@ -1298,6 +1396,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	attr_index_build();
 
 	return 0;
 }
@@ -1520,6 +1619,8 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+	attr_index_build();
 }
 
 void bt_gatt_init(void)
@@ -1695,6 +1796,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	attr_index_build();
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -2077,6 +2180,50 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static bool foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	uint16_t handle;
+
+	if (!attr_index.valid) {
+		return false;
+	}
+
+	end_handle = MIN(end_handle, attr_index.max_handle);
+
+	if (uuid) {
+		/* Only walk the attributes that may have this UUID */
+		for (handle = attr_index.buckets[attr_index_bucket(uuid)];
+		     handle != 0 && handle <= end_handle;
+		     handle = attr_index.next[handle]) {
+			if (handle >= start_handle &&
+			    gatt_foreach_iter(attr_index.attrs[handle], handle,
+					      start_handle, end_handle, uuid,
+					      attr_data, &num_matches, func,
+					      user_data) == BT_GATT_ITER_STOP) {
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	for (handle = MAX(start_handle, 1); handle <= end_handle; handle++) {
+		if (attr_index.attrs[handle] != NULL &&
+		    gatt_foreach_iter(attr_index.attrs[handle], handle,
+				      start_handle, end_handle, NULL, attr_data,
+				      &num_matches, func, user_data) == BT_GATT_ITER_STOP) {
+			break;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2088,6 +2235,13 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (foreach_attr_type_index(start_handle, end_handle, uuid, attr_data,
+				    num_matches, func, user_data)) {
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -2348,6 +2502,8 @@ struct notify_data {
 #if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
 
 static struct net_buf *nfy_mult[CONFIG_BT_MAX_CONN];
+/* Connections inside bt_gatt_notify_batch(), flushed when it returns */
+static ATOMIC_DEFINE(nfy_mult_batch, CONFIG_BT_MAX_CONN);
 
 static int gatt_notify_mult_send(struct bt_conn *conn, struct net_buf *buf)
 {
@@ -2390,7 +2546,7 @@ static void notify_mult_process(struct k_work *work)
 	for (i = 0; i < ARRAY_SIZE(nfy_mult); i++) {
 		struct net_buf **buf = &nfy_mult[i];
 
-		if (*buf) {
+		if (*buf && !atomic_test_bit(nfy_mult_batch, i)) {
 			struct bt_conn *conn = bt_conn_lookup_index(i);
 
 			gatt_notify_mult_send(conn, *buf);
@@ -2449,7 +2605,11 @@ static void gatt_add_nfy_to_buf(struct net_buf *buf,
 	(void)memcpy(nfy->value, params->data, params->len);
 }
 
-#if (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0)
+static bool gatt_notify_batching(struct bt_conn *conn)
+{
+	return atomic_test_bit(nfy_mult_batch, bt_conn_index(conn));
+}
+
 static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 			    struct bt_gatt_notify_params *params)
 {
@@ -2489,15 +2649,17 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	LOG_DBG("handle 0x%04x len %u", handle, params->len);
 	gatt_add_nfy_to_buf(*buf, handle, params);
 
-	/* Use `k_work_schedule` to keep the original deadline, instead of
-	 * re-setting the timeout whenever a new notification is appended.
-	 */
-	k_work_schedule(&nfy_mult_work,
-			K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS));
+	/* A batch is flushed by bt_gatt_notify_batch() itself */
+	if (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0 && !gatt_notify_batching(conn)) {
+		/* Use `k_work_schedule` to keep the original deadline, instead of
+		 * re-setting the timeout whenever a new notification is appended.
+		 */
+		k_work_schedule(&nfy_mult_work,
+				K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS));
+	}
 
 	return 0;
 }
-#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0 */
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
 static int gatt_notify(struct bt_conn *conn, uint16_t handle,
@@ -2541,8 +2703,9 @@ static int gatt_notify(struct bt_conn *conn, uint16_t handle,
 		return -EINVAL;
 	}
 
-#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE) && (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0)
-	if (gatt_cf_notify_multi(conn)) {
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	if (gatt_cf_notify_multi(conn) &&
+	    (CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS != 0 || gatt_notify_batching(conn))) {
 		return gatt_notify_mult(conn, handle, params);
 	}
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
@@ -3114,6 +3277,41 @@ int bt_gatt_notify_multiple(struct bt_conn *conn,
 }
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
+int bt_gatt_notify_batch(struct bt_conn *conn,
+			 uint16_t num_params,
+			 struct bt_gatt_notify_params params[])
+{
+	__maybe_unused int flush_err;
+	int err = 0;
+
+	CHECKIF(conn == NULL) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	atomic_set_bit(nfy_mult_batch, bt_conn_index(conn));
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
+	for (uint16_t i = 0; i < num_params; i++) {
+		err = bt_gatt_notify_cb(conn, &params[i]);
+		if (err) {
+			break;
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
+	atomic_clear_bit(nfy_mult_batch, bt_conn_index(conn));
+
+	/* Send what was queued, also if a notification failed */
+	flush_err = gatt_notify_flush(conn);
+	if (!err && flush_err < 0) {
+		err = flush_err;
+	}
+#endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
+
+	return err;
+}
+
 int bt_gatt_indicate(struct bt_conn *conn,
 		     struct bt_gatt_indicate_params *params)
 {
@@ -4790,9 +4790,15 @@ static void tx_processor(struct k_work *item)
 		return;
 	}
 
-	/* Hand over control to conn to process pending data */
+	/* Hand over control to conn to process pending data, a few fragments
+	 * at a time while the controller has buffers for them.
+	 */
 	if (IS_ENABLED(CONFIG_BT_CONN_TX)) {
-		bt_conn_tx_processor();
+		for (int i = 0; i < CONFIG_BT_CONN_TX_BATCH; i++) {
+			if (!bt_conn_tx_processor()) {
+				break;
+			}
+		}
 	}
 }
 
@@ -310,6 +310,52 @@ void bt_keys_add_type(struct bt_keys *keys, enum bt_keys_type type)
 	keys->keys |= type;
 }
 
+#if defined(CONFIG_BT_KEYS_BLOB)
+/* One record per bond in the bt/bonds settings entry */
+struct keys_blob_rec {
+	uint8_t id;
+	bt_addr_le_t addr;
+	uint8_t storage[BT_KEYS_STORAGE_LEN];
+} __packed;
+
+static struct keys_blob_rec keys_blob[CONFIG_BT_MAX_PAIRED];
+static K_MUTEX_DEFINE(keys_blob_lock);
+
+/* Set when bonds were loaded from per-device entries */
+static bool keys_blob_migrate;
+
+static int keys_blob_store(void)
+{
+	size_t count = 0;
+	int err;
+
+	k_mutex_lock(&keys_blob_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		struct bt_keys *keys = &key_pool[i];
+
+		if (!keys->keys) {
+			continue;
+		}
+
+		keys_blob[count].id = keys->id;
+		bt_addr_le_copy(&keys_blob[count].addr, &keys->addr);
+		memcpy(keys_blob[count].storage, keys->storage_start, BT_KEYS_STORAGE_LEN);
+		count++;
+	}
+
+	if (count) {
+		err = bt_settings_store_bonds(keys_blob, count * sizeof(keys_blob[0]));
+	} else {
+		err = bt_settings_delete_bonds();
+	}
+
+	k_mutex_unlock(&keys_blob_lock);
+
+	return err;
+}
+#endif /* CONFIG_BT_KEYS_BLOB */
+
 void bt_keys_clear(struct bt_keys *keys)
 {
 	__ASSERT_NO_MSG(keys != NULL);
@@ -320,12 +366,17 @@ void bt_keys_clear(struct bt_keys *keys)
 		bt_id_del(keys);
 	}
 
-	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
+	if (IS_ENABLED(CONFIG_BT_SETTINGS) && !IS_ENABLED(CONFIG_BT_KEYS_BLOB)) {
 		/* Delete stored keys from flash */
 		bt_settings_delete_keys(keys->id, &keys->addr);
 	}
 
 	(void)memset(keys, 0, sizeof(*keys));
+
+#if defined(CONFIG_BT_KEYS_BLOB)
+	/* Rewrite the remaining bonds */
+	(void)keys_blob_store();
+#endif /* CONFIG_BT_KEYS_BLOB */
 }
 
 #if defined(CONFIG_BT_SETTINGS)
@@ -335,8 +386,12 @@ int bt_keys_store(struct bt_keys *keys)
 
 	__ASSERT_NO_MSG(keys != NULL);
 
+#if defined(CONFIG_BT_KEYS_BLOB)
+	err = keys_blob_store();
+#else
 	err = bt_settings_store_keys(keys->id, &keys->addr, keys->storage_start,
 				     BT_KEYS_STORAGE_LEN);
+#endif /* CONFIG_BT_KEYS_BLOB */
 	if (err) {
 		LOG_ERR("Failed to save keys (err %d)", err);
 		return err;
@@ -428,6 +483,9 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	}
 
 	LOG_DBG("Successfully restored keys for %s", bt_addr_le_str(&addr));
+#if defined(CONFIG_BT_KEYS_BLOB)
+	keys_blob_migrate = true;
+#endif /* CONFIG_BT_KEYS_BLOB */
 #if defined(CONFIG_BT_KEYS_OVERWRITE_OLDEST)
 	if (aging_counter_val < keys->aging_counter) {
 		aging_counter_val = keys->aging_counter;
@@ -436,6 +494,70 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	return 0;
 }
 
+#if defined(CONFIG_BT_KEYS_BLOB)
+static int keys_blob_set(const char *name, size_t len_rd, settings_read_cb read_cb,
+			 void *cb_arg)
+{
+	struct keys_blob_rec *rec;
+	struct bt_keys *keys;
+	ssize_t len;
+	int err = 0;
+
+	if (name) {
+		return -ENOENT;
+	}
+
+	if (len_rd % sizeof(keys_blob[0]) || len_rd > sizeof(keys_blob)) {
+		LOG_ERR("Invalid bonds length %zu", len_rd);
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&keys_blob_lock, K_FOREVER);
+
+	len = read_cb(cb_arg, keys_blob, sizeof(keys_blob));
+	if (len < 0) {
+		LOG_ERR("Failed to read value (err %zd)", len);
+		err = -EINVAL;
+		goto unlock;
+	}
+
+	for (rec = keys_blob; rec < &keys_blob[len / sizeof(keys_blob[0])]; rec++) {
+		if (rec->id >= CONFIG_BT_ID_MAX) {
+			LOG_ERR("Invalid local identity %u", rec->id);
+			continue;
+		}
+
+		keys = bt_keys_get_addr(rec->id, &rec->addr);
+		if (!keys) {
+			LOG_ERR("Failed to allocate keys for %s", bt_addr_le_str(&rec->addr));
+			err = -ENOMEM;
+			break;
+		}
+
+		memcpy(keys->storage_start, rec->storage, BT_KEYS_STORAGE_LEN);
+#if defined(CONFIG_BT_KEYS_OVERWRITE_OLDEST)
+		if (aging_counter_val < keys->aging_counter) {
+			aging_counter_val = keys->aging_counter;
+		}
+#endif  /* CONFIG_BT_KEYS_OVERWRITE_OLDEST */
+	}
+
+	LOG_DBG("Restored %zd bonds", len / (ssize_t)sizeof(keys_blob[0]));
+
+unlock:
+	k_mutex_unlock(&keys_blob_lock);
+
+	return err;
+}
+
+BT_SETTINGS_DEFINE(bonds, "bonds", keys_blob_set, NULL);
+
+static void keys_blob_migrated(struct bt_keys *keys, void *data)
+{
+	bt_settings_delete_keys(keys->id, &keys->addr);
+}
+#endif /* CONFIG_BT_KEYS_BLOB */
+
 static void add_id_cb(struct k_work *work)
 {
 	bt_id_pending_keys_update();
@@ -453,6 +575,14 @@ static void id_add(struct bt_keys *keys, void *user_data)
 
 static int keys_commit(void)
 {
+#if defined(CONFIG_BT_KEYS_BLOB)
+	/* Per-device entries are only dropped once the blob holds them */
+	if (keys_blob_migrate && !keys_blob_store()) {
+		bt_keys_foreach_type(BT_KEYS_ALL, keys_blob_migrated, NULL);
+		keys_blob_migrate = false;
+	}
+#endif /* CONFIG_BT_KEYS_BLOB */
+
 	/* We do this in commit() rather than add() since add() may get
 	 * called multiple times for the same address, especially if
 	 * the keys were already removed.
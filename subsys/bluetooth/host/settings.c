@@ -502,3 +502,13 @@ int bt_settings_delete_keys(uint8_t id, const bt_addr_le_t *addr)
 {
 	return bt_settings_delete("keys", id, addr);
 }
+
+int bt_settings_store_bonds(const void *value, size_t val_len)
+{
+	return bt_settings_store("bonds", 0, NULL, value, val_len);
+}
+
+int bt_settings_delete_bonds(void)
+{
+	return bt_settings_delete("bonds", 0, NULL);
+}
@@ -69,3 +69,6 @@ int bt_settings_delete_link_key(const bt_addr_le_t *addr);
 
 int bt_settings_store_keys(uint8_t id, const bt_addr_le_t *addr, const void *value, size_t val_len);
 int bt_settings_delete_keys(uint8_t id, const bt_addr_le_t *addr);
+
+int bt_settings_store_bonds(const void *value, size_t val_len);
+int bt_settings_delete_bonds(void);
@@ -80,11 +80,24 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-	      seq : 17;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
+#define NET_CACHE_BUCKETS MAX(CONFIG_BT_MESH_MSG_CACHE_SIZE / 2, 1)
+
+/* Ring of recently seen values. The values are also chained in hash buckets,
+ * so lookups only compare the few values sharing a bucket instead of the
+ * whole ring. Links hold the entry index plus one, zero ending the chain.
+ */
+struct net_cache {
+	uint32_t val[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+	uint16_t link[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+	uint16_t bucket[NET_CACHE_BUCKETS];
+	ATOMIC_DEFINE(used, CONFIG_BT_MESH_MSG_CACHE_SIZE);
+	uint16_t next;
+};
+
+/* Source and 17 LSbs of the sequence number, the MSb of source is always 0 */
+#define MSG_CACHE_VAL(src, seq) (((uint32_t)(src) << 17) | ((seq) & BIT_MASK(17)))
+
+static struct net_cache msg_cache;
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -116,62 +129,93 @@ K_MEM_SLAB_DEFINE(loopback_buf_pool,
 		  sizeof(struct loopback_buf),
 		  CONFIG_BT_MESH_LOOPBACK_BUFS, __alignof__(struct loopback_buf));
 
-static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static int   dup_cache_next;
+static struct net_cache dup_cache;
 
-static bool check_dup(struct net_buf_simple *data)
+static uint16_t *net_cache_head(struct net_cache *cache, uint32_t val)
 {
-	const uint8_t *tail = net_buf_simple_tail(data);
-	uint32_t val;
-	int i;
-
-	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
+	return &cache->bucket[(val * 0x9e3779b1U >> 16) % NET_CACHE_BUCKETS];
+}
 
-	for (i = dup_cache_next; i > 0;) {
-		if (dup_cache[--i] == val) {
+static bool net_cache_has(struct net_cache *cache, uint32_t val)
+{
+	for (uint16_t i = *net_cache_head(cache, val); i != 0U; i = cache->link[i - 1]) {
+		if (cache->val[i - 1] == val) {
 			return true;
 		}
 	}
 
-	for (i = ARRAY_SIZE(dup_cache); i > dup_cache_next;) {
-		if (dup_cache[--i] == val) {
-			return true;
-		}
+	return false;
+}
+
+static void net_cache_unlink(struct net_cache *cache, uint16_t idx)
+{
+	uint16_t *link;
+
+	if (!atomic_test_and_clear_bit(cache->used, idx)) {
+		return;
 	}
 
-	dup_cache_next %= ARRAY_SIZE(dup_cache);
-	dup_cache[dup_cache_next++] = val;
+	for (link = net_cache_head(cache, cache->val[idx]); *link != idx + 1U;
+	     link = &cache->link[*link - 1]) {
+	}
 
-	return false;
+	*link = cache->link[idx];
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
+static void net_cache_add(struct net_cache *cache, uint32_t val)
 {
-	uint16_t i;
+	uint16_t *head = net_cache_head(cache, val);
+	uint16_t idx;
 
-	for (i = msg_cache_next; i > 0U;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
+	cache->next %= CONFIG_BT_MESH_MSG_CACHE_SIZE;
+	idx = cache->next++;
+
+	/* The oldest entry is overwritten */
+	net_cache_unlink(cache, idx);
+
+	cache->val[idx] = val;
+	cache->link[idx] = *head;
+	*head = idx + 1U;
+	atomic_set_bit(cache->used, idx);
+}
+
+/* Forget the last added value */
+static void net_cache_rewind(struct net_cache *cache)
+{
+	if (cache->next > 0U) {
+		net_cache_unlink(cache, --cache->next);
 	}
+}
 
-	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
+static void net_cache_reset(struct net_cache *cache)
+{
+	(void)memset(cache, 0, sizeof(*cache));
+}
+
+static bool check_dup(struct net_buf_simple *data)
+{
+	const uint8_t *tail = net_buf_simple_tail(data);
+	uint32_t val;
+
+	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
+
+	if (net_cache_has(&dup_cache, val)) {
+		return true;
 	}
 
+	net_cache_add(&dup_cache, val);
+
 	return false;
 }
 
+static bool msg_cache_match(struct net_buf_simple *pdu)
+{
+	return net_cache_has(&msg_cache, MSG_CACHE_VAL(SRC(pdu->data), SEQ(pdu->data)));
+}
+
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
-	msg_cache[msg_cache_next].src = rx->ctx.addr;
-	msg_cache[msg_cache_next].seq = rx->seq;
-	msg_cache_next++;
+	net_cache_add(&msg_cache, MSG_CACHE_VAL(rx->ctx.addr, rx->seq));
 }
 
 static void store_iv(bool only_duration)
@@ -215,8 +259,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const struct bt_mesh_key *ke
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	net_cache_reset(&msg_cache);
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -912,8 +955,8 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		 */
 		LOG_WRN("Removing rejected message from Network Message Cache");
 		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
-		dup_cache[--dup_cache_next] = 0;
+		net_cache_rewind(&msg_cache);
+		net_cache_rewind(&dup_cache);
 		return;
 	} else if (err == -EBADMSG) {
 		LOG_DBG("Not relaying message rejected by the Transport layer");
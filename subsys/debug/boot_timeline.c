@@ -0,0 +1,191 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/debug/boot_timeline.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_BOOT_TIMELINE_RETENTION
+#include <zephyr/retention/retention.h>
+#endif
+#ifdef CONFIG_BOOT_TIMELINE_SHELL
+#include <zephyr/shell/shell.h>
+#endif
+
+#define RECORDS CONFIG_BOOT_TIMELINE_RECORDS
+
+/* Records past the capacity are dropped, the first steps of the boot are kept */
+static struct boot_timeline_record records[RECORDS];
+static size_t count;
+static uint32_t dropped;
+static struct k_spinlock lock;
+
+static void record(enum boot_timeline_event event, const struct init_entry *entry,
+		   uint8_t level, uint32_t start, uint32_t end, int result)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (count < RECORDS) {
+		records[count] = (struct boot_timeline_record){
+			.start = start,
+			.end = end,
+			.entry = entry,
+			.result = (int16_t)CLAMP(result, INT16_MIN, INT16_MAX),
+			.level = level,
+			.event = event,
+		};
+		count++;
+	} else {
+		dropped++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+#ifdef CONFIG_BOOT_TIMELINE_RETENTION
+/* Layout of the retention area: this header, then the records */
+struct boot_timeline_retained {
+	uint32_t count;
+	uint32_t cycles_per_sec;
+};
+
+static void retention_save(void)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_boot_timeline));
+	struct boot_timeline_retained header = {
+		.cycles_per_sec = sys_clock_hw_cycles_per_sec(),
+	};
+	ssize_t size = retention_size(dev);
+	k_spinlock_key_t key;
+
+	if (!device_is_ready(dev) || (size < (ssize_t)sizeof(header))) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	header.count = MIN(count, (size - sizeof(header)) / sizeof(records[0]));
+	k_spin_unlock(&lock, key);
+
+	/* Records up to header.count are complete and never modified again */
+	(void)retention_write(dev, sizeof(header), (const uint8_t *)records,
+			      header.count * sizeof(records[0]));
+	(void)retention_write(dev, 0, (const uint8_t *)&header, sizeof(header));
+}
+#endif /* CONFIG_BOOT_TIMELINE_RETENTION */
+
+void z_boot_timeline_event(enum boot_timeline_event event)
+{
+	uint32_t now = k_cycle_get_32();
+
+	record(event, NULL, 0U, now, now, 0);
+
+#ifdef CONFIG_BOOT_TIMELINE_RETENTION
+	if (event == BOOT_TIMELINE_MAIN) {
+		retention_save();
+	}
+#endif /* CONFIG_BOOT_TIMELINE_RETENTION */
+}
+
+void z_boot_timeline_init_entry(const struct init_entry *entry, uint8_t level, uint32_t start,
+				int result)
+{
+	record(BOOT_TIMELINE_INIT_ENTRY, entry, level, start, k_cycle_get_32(), result);
+}
+
+void boot_timeline_foreach(boot_timeline_cb_t cb, void *user_data)
+{
+	struct boot_timeline_record rec;
+	k_spinlock_key_t key;
+
+	for (size_t i = 0; ; i++) {
+		key = k_spin_lock(&lock);
+		if (i >= count) {
+			k_spin_unlock(&lock, key);
+			break;
+		}
+		rec = records[i];
+		k_spin_unlock(&lock, key);
+
+		cb(&rec, user_data);
+	}
+}
+
+const char *boot_timeline_name(const struct boot_timeline_record *record)
+{
+	if ((record->entry == NULL) || (record->entry->dev == NULL)) {
+		return NULL;
+	}
+
+	return record->entry->dev->name;
+}
+
+#ifdef CONFIG_BOOT_TIMELINE_SHELL
+static const char *const level_names[] = {
+	"EARLY", "PRE_KERNEL_1", "PRE_KERNEL_2", "POST_KERNEL", "APPLICATION", "SMP",
+};
+
+struct shell_print_ctx {
+	const struct shell *sh;
+	uint32_t origin;
+};
+
+static void shell_record_print(const struct boot_timeline_record *rec, void *user_data)
+{
+	struct shell_print_ctx *ctx = user_data;
+	const char *name = boot_timeline_name(rec);
+	const char *level;
+	uint64_t start_us = k_cyc_to_us_floor64(rec->start - ctx->origin);
+	uint64_t duration_us = k_cyc_to_us_floor64(rec->end - rec->start);
+
+	switch (rec->event) {
+	case BOOT_TIMELINE_KERNEL_START:
+		shell_print(ctx->sh, "%10llu %10s %-12s %6s kernel start", start_us, "", "", "");
+		break;
+	case BOOT_TIMELINE_MAIN:
+		shell_print(ctx->sh, "%10llu %10s %-12s %6s main", start_us, "", "", "");
+		break;
+	default:
+		level = (rec->level < ARRAY_SIZE(level_names)) ? level_names[rec->level] : "?";
+
+		if (name != NULL) {
+			shell_print(ctx->sh, "%10llu %10llu %-12s %6d %s", start_us, duration_us,
+				    level, rec->result, name);
+		} else {
+			/* SYS_INIT() functions are only known by their address */
+			shell_print(ctx->sh, "%10llu %10llu %-12s %6d SYS_INIT %p", start_us,
+				    duration_us, level, rec->result,
+				    (void *)(uintptr_t)rec->entry->init_fn);
+		}
+		break;
+	}
+}
+
+static int cmd_boot_timeline(const struct shell *sh, size_t argc, char **argv)
+{
+	struct shell_print_ctx ctx = {
+		.sh = sh,
+		.origin = (count > 0U) ? records[0].start : 0U,
+	};
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%10s %10s %-12s %6s %s", "start us", "took us", "level", "result",
+		    "step");
+	boot_timeline_foreach(shell_record_print, &ctx);
+
+	if (dropped > 0U) {
+		shell_print(sh, "%u steps not recorded, increase CONFIG_BOOT_TIMELINE_RECORDS",
+			    dropped);
+	}
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(boot_timeline, NULL, "Show when each step of the boot ran",
+		   cmd_boot_timeline);
+#endif /* CONFIG_BOOT_TIMELINE_SHELL */
@@ -0,0 +1,277 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/debug/mem_sampler.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/mem_blocks.h>
+#include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/util.h>
+#ifdef CONFIG_NET_BUF
+#include <zephyr/net_buf.h>
+#endif
+#ifdef CONFIG_MEM_SAMPLER_STATS
+#include <zephyr/stats/stats.h>
+#endif
+#ifdef CONFIG_MEM_SAMPLER_SHELL
+#include <zephyr/shell/shell.h>
+#endif
+
+#define RECORDS CONFIG_MEM_SAMPLER_RECORDS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RECORDS), "the number of records must be a power of two");
+
+static struct mem_sampler_record records[RECORDS];
+/* Sequence numbers, records[seq % RECORDS] being the one of seq */
+static uint32_t next_seq;
+static uint32_t first_seq;
+static struct k_spinlock lock;
+
+#ifdef CONFIG_MEM_SAMPLER_STATS
+STATS_SECT_START(mem_sampler)
+STATS_SECT_ENTRY32(samples)
+STATS_SECT_ENTRY32(overwritten)
+STATS_SECT_ENTRY32(heap_peak)
+STATS_SECT_ENTRY32(mem_slab_peak)
+STATS_SECT_ENTRY32(mem_blocks_peak)
+STATS_SECT_ENTRY32(net_buf_peak)
+STATS_SECT_END;
+
+STATS_NAME_START(mem_sampler)
+STATS_NAME(mem_sampler, samples)
+STATS_NAME(mem_sampler, overwritten)
+STATS_NAME(mem_sampler, heap_peak)
+STATS_NAME(mem_sampler, mem_slab_peak)
+STATS_NAME(mem_sampler, mem_blocks_peak)
+STATS_NAME(mem_sampler, net_buf_peak)
+STATS_NAME_END(mem_sampler);
+
+static STATS_SECT_DECL(mem_sampler) mem_sampler_stats;
+
+/* Highest usage of a single pool of a type, in percent */
+static void stats_peak_update(enum mem_sampler_type type, uint32_t used, uint32_t total)
+{
+	uint32_t percent = (total == 0U) ? 0U : (uint32_t)(((uint64_t)used * 100U) / total);
+	uint32_t *peak;
+
+	switch (type) {
+	case MEM_SAMPLER_HEAP:
+		peak = &mem_sampler_stats.heap_peak;
+		break;
+	case MEM_SAMPLER_MEM_SLAB:
+		peak = &mem_sampler_stats.mem_slab_peak;
+		break;
+	case MEM_SAMPLER_MEM_BLOCKS:
+		peak = &mem_sampler_stats.mem_blocks_peak;
+		break;
+	default:
+		peak = &mem_sampler_stats.net_buf_peak;
+		break;
+	}
+
+	*peak = MAX(*peak, percent);
+}
+#else
+#define stats_peak_update(type, used, total)
+#endif /* CONFIG_MEM_SAMPLER_STATS */
+
+static void record(uint32_t timestamp, enum mem_sampler_type type, const void *obj,
+		   size_t used, size_t total)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct mem_sampler_record *rec = &records[next_seq % RECORDS];
+
+	rec->timestamp = timestamp;
+	rec->obj = obj;
+	rec->used = used;
+	rec->total = total;
+	rec->type = type;
+
+	if ((next_seq - first_seq) == RECORDS) {
+		first_seq++;
+		IF_ENABLED(CONFIG_MEM_SAMPLER_STATS, (STATS_INC(mem_sampler_stats, overwritten)));
+	}
+	next_seq++;
+
+	stats_peak_update(type, used, total);
+
+	k_spin_unlock(&lock, key);
+}
+
+static void record_stats(uint32_t timestamp, enum mem_sampler_type type, const void *obj,
+			 const struct sys_memory_stats *stats)
+{
+	record(timestamp, type, obj, stats->allocated_bytes,
+	       stats->allocated_bytes + stats->free_bytes);
+}
+
+void mem_sampler_sample(void)
+{
+	uint32_t now = k_uptime_get_32();
+	struct sys_memory_stats stats;
+
+	STRUCT_SECTION_FOREACH(k_heap, heap) {
+		k_spinlock_key_t key = k_spin_lock(&heap->lock);
+		int ret = sys_heap_runtime_stats_get(&heap->heap, &stats);
+
+		k_spin_unlock(&heap->lock, key);
+		if (ret == 0) {
+			record_stats(now, MEM_SAMPLER_HEAP, heap, &stats);
+		}
+	}
+
+	STRUCT_SECTION_FOREACH(k_mem_slab, slab) {
+		if (k_mem_slab_runtime_stats_get(slab, &stats) == 0) {
+			record_stats(now, MEM_SAMPLER_MEM_SLAB, slab, &stats);
+		}
+	}
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	STRUCT_SECTION_FOREACH_ALTERNATE(sys_mem_blocks_ptr, sys_mem_blocks *, block) {
+		if (sys_mem_blocks_runtime_stats_get(*block, &stats) == 0) {
+			record_stats(now, MEM_SAMPLER_MEM_BLOCKS, *block, &stats);
+		}
+	}
+#endif /* CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS */
+
+#ifdef CONFIG_NET_BUF_POOL_USAGE
+	STRUCT_SECTION_FOREACH(net_buf_pool, pool) {
+		record(now, MEM_SAMPLER_NET_BUF_POOL, pool,
+		       pool->buf_count - atomic_get(&pool->avail_count), pool->buf_count);
+	}
+#endif /* CONFIG_NET_BUF_POOL_USAGE */
+
+	IF_ENABLED(CONFIG_MEM_SAMPLER_STATS, (STATS_INC(mem_sampler_stats, samples)));
+}
+
+void mem_sampler_foreach(mem_sampler_cb_t cb, void *user_data)
+{
+	struct mem_sampler_record rec;
+	k_spinlock_key_t key;
+	uint32_t seq;
+
+	key = k_spin_lock(&lock);
+	seq = first_seq;
+	k_spin_unlock(&lock, key);
+
+	/* Do not hold the lock while calling back, records may be added */
+	for (;;) {
+		key = k_spin_lock(&lock);
+		if ((int32_t)(seq - first_seq) < 0) {
+			/* overwritten meanwhile */
+			seq = first_seq;
+		}
+		if (seq == next_seq) {
+			k_spin_unlock(&lock, key);
+			break;
+		}
+		rec = records[seq % RECORDS];
+		k_spin_unlock(&lock, key);
+
+		cb(&rec, user_data);
+		seq++;
+	}
+}
+
+void mem_sampler_clear(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	first_seq = next_seq;
+
+	k_spin_unlock(&lock, key);
+}
+
+#if CONFIG_MEM_SAMPLER_PERIOD > 0
+static void sample_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_handler);
+
+static void sample_handler(struct k_work *work)
+{
+	mem_sampler_sample();
+	(void)k_work_reschedule(k_work_delayable_from_work(work),
+				K_MSEC(CONFIG_MEM_SAMPLER_PERIOD));
+}
+#endif /* CONFIG_MEM_SAMPLER_PERIOD > 0 */
+
+#ifdef CONFIG_MEM_SAMPLER_SHELL
+static const char *const type_names[] = {
+	[MEM_SAMPLER_HEAP] = "heap",
+	[MEM_SAMPLER_MEM_SLAB] = "slab",
+	[MEM_SAMPLER_MEM_BLOCKS] = "blocks",
+	[MEM_SAMPLER_NET_BUF_POOL] = "net_buf",
+};
+
+static void shell_record_print(const struct mem_sampler_record *rec, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%10u %-8s %p %10u / %-10u %3u%%", rec->timestamp,
+		    type_names[rec->type], rec->obj, rec->used, rec->total,
+		    (rec->total == 0U) ? 0U : (uint32_t)(((uint64_t)rec->used * 100U) / rec->total));
+}
+
+static int cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%10s %-8s %-10s %10s   %-10s %4s", "uptime ms", "type", "object", "used",
+		    "total", "use");
+	mem_sampler_foreach(shell_record_print, (void *)sh);
+
+	return 0;
+}
+
+static int cmd_sample(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mem_sampler_sample();
+	shell_print(sh, "sampled");
+
+	return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	mem_sampler_clear();
+	shell_print(sh, "cleared");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_mem_sampler,
+	SHELL_CMD(show, NULL, "Show the recorded timeline, oldest first", cmd_show),
+	SHELL_CMD(sample, NULL, "Sample all memory pools now", cmd_sample),
+	SHELL_CMD(clear, NULL, "Drop the recorded samples", cmd_clear),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(mem_sampler, &sub_mem_sampler, "Memory usage sampler", NULL);
+#endif /* CONFIG_MEM_SAMPLER_SHELL */
+
+static int mem_sampler_init(void)
+{
+#ifdef CONFIG_MEM_SAMPLER_STATS
+	stats_init(&mem_sampler_stats.s_hdr, STATS_SIZE_32, 6U,
+		   STATS_NAME_INIT_PARMS(mem_sampler));
+	stats_register("mem_sampler", &mem_sampler_stats.s_hdr);
+#endif /* CONFIG_MEM_SAMPLER_STATS */
+
+#if CONFIG_MEM_SAMPLER_PERIOD > 0
+	(void)k_work_schedule(&sample_work, K_MSEC(CONFIG_MEM_SAMPLER_PERIOD));
+#endif /* CONFIG_MEM_SAMPLER_PERIOD > 0 */
+
+	return 0;
+}
+
+SYS_INIT(mem_sampler_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
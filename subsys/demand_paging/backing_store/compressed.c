@@ -0,0 +1,272 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM backing store, in the spirit of zram/zswap
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/sys/util.h>
+
+/* Must match the configuration the library is built with */
+#define LZ4_MEMORY_USAGE CONFIG_LZ4_MEMORY_USAGE
+#include <lz4.h>
+
+/*
+ * Evicted data pages are compressed with LZ4 into blocks of a k_heap.
+ * Location tokens are slot indexes times the page size, each slot of
+ * the table pointing to the block of a stored page.
+ *
+ * As k_mem_paging_backing_store_page_out() cannot fail, a full page is
+ * reserved in the heap when a location is handed out. Page-out then
+ * shrinks that block in place to the compressed size. Pages filled with
+ * a repeated word need no block at all, and pages which do not compress
+ * below CONFIG_BACKING_STORE_COMPRESSED_MAX_PERCENT of their size are
+ * stored as-is.
+ *
+ * A spare page outside of the heap and the last free slot make sure a
+ * location can always be given to page faults, as other requests fail
+ * first when the heap or the slot table is full.
+ *
+ * Like with the RAM backing store, locations are freed as soon as pages
+ * are paged in, so all data pages are treated as dirty.
+ */
+
+#define PAGE_WORDS (CONFIG_MMU_PAGE_SIZE / sizeof(uint32_t))
+#define COMPRESSED_MAX (CONFIG_MMU_PAGE_SIZE * CONFIG_BACKING_STORE_COMPRESSED_MAX_PERCENT / 100)
+
+enum slot_state {
+	SLOT_FREE,
+	SLOT_RESERVED,
+	SLOT_RAW,
+	SLOT_LZ4,
+	SLOT_FILLED,
+};
+
+struct compressed_slot {
+	/* Heap block or spare page, NULL for filled pages */
+	void *data;
+	/* Compressed size, or repeated word for filled pages */
+	uint32_t len;
+	uint8_t state;
+};
+
+static uint8_t heap_mem[CONFIG_BACKING_STORE_COMPRESSED_HEAP_SIZE] __aligned(sizeof(void *));
+static struct k_heap compressed_heap;
+
+static struct compressed_slot slots[CONFIG_BACKING_STORE_COMPRESSED_PAGES];
+static uint16_t free_slots[CONFIG_BACKING_STORE_COMPRESSED_PAGES];
+static unsigned int free_count;
+
+static char spare_page[CONFIG_MMU_PAGE_SIZE] __aligned(sizeof(void *));
+static bool spare_used;
+
+/* Only used by page-outs, which are serialized */
+static LZ4_stream_t lz4_state;
+static char lz4_buf[COMPRESSED_MAX];
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+extern struct k_mem_paging_stats_t paging_stats;
+
+static void stats_update(const struct compressed_slot *slot, bool stored)
+{
+	unsigned long bytes = slot->len;
+	unsigned long *count = NULL;
+
+	if (slot->state == SLOT_FILLED) {
+		bytes = 0;
+		count = &paging_stats.compression.same_filled;
+	} else if (slot->state == SLOT_RAW) {
+		count = &paging_stats.compression.incompressible;
+	}
+
+	if (stored) {
+		paging_stats.compression.pages++;
+		paging_stats.compression.stored_bytes += bytes;
+	} else {
+		paging_stats.compression.pages--;
+		paging_stats.compression.stored_bytes -= bytes;
+	}
+
+	if (count != NULL) {
+		*count = stored ? (*count + 1) : (*count - 1);
+	}
+}
+#else
+#define stats_update(slot, stored)
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+static struct compressed_slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location / CONFIG_MMU_PAGE_SIZE < ARRAY_SIZE(slots),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static bool page_is_filled(const uint32_t *page)
+{
+	for (size_t i = 1; i < PAGE_WORDS; i++) {
+		if (page[i] != page[0]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int k_mem_paging_backing_store_location_get(struct k_mem_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	struct compressed_slot *slot;
+	unsigned int idx;
+	void *data;
+
+	ARG_UNUSED(pf);
+
+	/* Like the spare page, the last slot is kept for page faults */
+	if ((!page_fault && free_count == 1) || free_count == 0) {
+		return -ENOMEM;
+	}
+
+	data = k_heap_alloc(&compressed_heap, CONFIG_MMU_PAGE_SIZE, K_NO_WAIT);
+	if ((data == NULL) && page_fault && !spare_used) {
+		data = spare_page;
+		spare_used = true;
+	}
+	if (data == NULL) {
+		return -ENOMEM;
+	}
+
+	idx = free_slots[--free_count];
+	slot = &slots[idx];
+	__ASSERT(slot->state == SLOT_FREE, "slot %u in use", idx);
+	slot->data = data;
+	slot->len = CONFIG_MMU_PAGE_SIZE;
+	slot->state = SLOT_RESERVED;
+
+	*location = idx * CONFIG_MMU_PAGE_SIZE;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+
+	__ASSERT(slot->state != SLOT_FREE, "location 0x%lx not in use", location);
+
+	if (slot->state != SLOT_RESERVED) {
+		stats_update(slot, false);
+	}
+
+	if (slot->data == spare_page) {
+		spare_used = false;
+	} else if (slot->data != NULL) {
+		k_heap_free(&compressed_heap, slot->data);
+	}
+
+	slot->data = NULL;
+	slot->state = SLOT_FREE;
+	free_slots[free_count++] = slot - slots;
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+	const uint32_t *page = K_MEM_SCRATCH_PAGE;
+	int len;
+
+	__ASSERT(slot->state == SLOT_RESERVED, "location 0x%lx not reserved", location);
+
+	if (page_is_filled(page)) {
+		if (slot->data == spare_page) {
+			spare_used = false;
+		} else {
+			k_heap_free(&compressed_heap, slot->data);
+		}
+		slot->data = NULL;
+		slot->len = page[0];
+		slot->state = SLOT_FILLED;
+		goto out;
+	}
+
+	/* The spare page is kept for page faults, no need to compress */
+	len = 0;
+	if (slot->data != spare_page) {
+		len = LZ4_compress_fast_extState(&lz4_state, K_MEM_SCRATCH_PAGE, lz4_buf,
+						 CONFIG_MMU_PAGE_SIZE, sizeof(lz4_buf), 1);
+	}
+
+	if (len > 0) {
+		/* Shrinking in place, this cannot fail */
+		void *data = k_heap_realloc(&compressed_heap, slot->data, len, K_NO_WAIT);
+
+		__ASSERT_NO_MSG(data == slot->data);
+		(void)memcpy(slot->data, lz4_buf, len);
+		slot->len = len;
+		slot->state = SLOT_LZ4;
+	} else {
+		(void)memcpy(slot->data, K_MEM_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+		slot->state = SLOT_RAW;
+	}
+
+out:
+	stats_update(slot, true);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct compressed_slot *slot = location_to_slot(location);
+	uint32_t *page = K_MEM_SCRATCH_PAGE;
+	int len;
+
+	switch (slot->state) {
+	case SLOT_FILLED:
+		for (size_t i = 0; i < PAGE_WORDS; i++) {
+			page[i] = slot->len;
+		}
+		break;
+	case SLOT_LZ4:
+		len = LZ4_decompress_safe(slot->data, K_MEM_SCRATCH_PAGE, slot->len,
+					  CONFIG_MMU_PAGE_SIZE);
+		__ASSERT(len == CONFIG_MMU_PAGE_SIZE, "corrupted page at 0x%lx", location);
+		ARG_UNUSED(len);
+		break;
+	default:
+		__ASSERT(slot->state == SLOT_RAW, "location 0x%lx not stored", location);
+		(void)memcpy(K_MEM_SCRATCH_PAGE, slot->data, CONFIG_MMU_PAGE_SIZE);
+		break;
+	}
+}
+
+void k_mem_paging_backing_store_page_finalize(struct k_mem_page_frame *pf,
+					      uintptr_t location)
+{
+#ifdef CONFIG_DEMAND_MAPPING
+	/* ignore those */
+	if (location == ARCH_UNPAGED_ANON_ZERO || location == ARCH_UNPAGED_ANON_UNINIT) {
+		return;
+	}
+#endif
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	__ASSERT(LZ4_sizeofState() <= sizeof(lz4_state), "LZ4 state size mismatch");
+
+	k_heap_init(&compressed_heap, heap_mem, sizeof(heap_mem));
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(slots); i++) {
+		free_slots[i] = ARRAY_SIZE(slots) - 1 - i;
+	}
+	free_count = ARRAY_SIZE(slots);
+}
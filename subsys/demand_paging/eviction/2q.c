@@ -0,0 +1,274 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Scan resistant "2Q" eviction algorithm for demand paging.
+ *
+ * Like the LRU algorithm, this relies on the MMU reporting accesses to
+ * unaccessible pages through k_mem_paging_eviction_accessed(). Plain LRU
+ * moves every page touched once to the end of its queue, so a sequential
+ * scan over a large region flushes the whole working set. Here, pages
+ * must prove they are reused before being protected.
+ *
+ * Theory of Operation:
+ *
+ * - Page frames made evictable enter the tail of the probation queue.
+ *   The access which caused the page-in is reported right after it and
+ *   only marks the page as touched.
+ *
+ * - Like with LRU, the head page of each queue is made unaccessible. A
+ *   touched probation page reported as accessed again has been reused,
+ *   and is promoted to the tail of the protected queue.
+ *
+ * - Accessed protected pages move back to the tail of the protected
+ *   queue. The protected queue may only hold a configured share of the
+ *   evictable page frames: above it, its head page is demoted to the
+ *   tail of the probation queue.
+ *
+ * - Victims are taken from the head of the probation queue first, and
+ *   from the protected queue only when probation is empty.
+ *
+ * - The virtual addresses of the last pages evicted from probation are
+ *   remembered. A page fault on such a page shows it was evicted too
+ *   early, and it then enters the protected queue directly.
+ *
+ * Pages touched by a single scan thus never leave probation, and are
+ * evicted before the working set. All operations are O(1) but the lookup
+ * of remembered addresses, which is done once per page-in.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/*
+ * Both queues are circular doubly-linked lists of page frame indexes,
+ * with their own sentinel entry as in the LRU algorithm. Page frame
+ * indexes are offset by 1, the first and last entries being sentinels.
+ */
+#define PF_IDX_BITS ROUND_UP(LOG2CEIL(K_MEM_NUM_PAGE_FRAMES + 2), BITS_PER_BYTE)
+
+#define Q_PROBATION 0
+#define Q_PROTECTED (K_MEM_NUM_PAGE_FRAMES + 1)
+
+enum {
+	STATE_UNQUEUED,
+	STATE_PROBATION,
+	STATE_PROTECTED,
+};
+
+struct twoq_pf_idx {
+	uint32_t next : PF_IDX_BITS;
+	uint32_t prev : PF_IDX_BITS;
+	uint8_t state : 2;
+	uint8_t touched : 1;
+} __packed;
+
+static struct twoq_pf_idx twoq_pf_queue[K_MEM_NUM_PAGE_FRAMES + 2] = {
+	[Q_PROTECTED] = { .next = Q_PROTECTED, .prev = Q_PROTECTED },
+};
+static uint32_t twoq_count[2];
+static struct k_spinlock twoq_lock;
+
+/* Virtual addresses of the pages last evicted from probation */
+static void *twoq_ghosts[CONFIG_EVICTION_2Q_GHOSTS];
+static unsigned int twoq_ghost_next;
+
+/* Page frame returned by the last k_mem_paging_eviction_select() */
+static uint32_t twoq_victim;
+
+static inline uint32_t pf_to_idx(struct k_mem_page_frame *pf)
+{
+	return (pf - k_mem_page_frames) + 1;
+}
+
+static inline struct k_mem_page_frame *idx_to_pf(uint32_t idx)
+{
+	return &k_mem_page_frames[idx - 1];
+}
+
+static inline uint32_t queue_of(uint32_t pf_idx)
+{
+	return (twoq_pf_queue[pf_idx].state == STATE_PROTECTED) ? Q_PROTECTED : Q_PROBATION;
+}
+
+static inline uint32_t *count_of(uint32_t queue)
+{
+	return &twoq_count[(queue == Q_PROTECTED) ? 1 : 0];
+}
+
+static inline uint32_t queue_head(uint32_t queue)
+{
+	uint32_t head = twoq_pf_queue[queue].next;
+
+	return (head == queue) ? 0 : head;
+}
+
+static void make_unaccessible(uint32_t pf_idx)
+{
+	struct k_mem_page_frame *pf = idx_to_pf(pf_idx);
+	uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, true);
+
+	/* clearing the accessed flag expected only on loaded pages */
+	__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0, "");
+	ARG_UNUSED(flags);
+}
+
+static void twoq_append(uint32_t queue, uint32_t pf_idx)
+{
+	uint32_t tail = twoq_pf_queue[queue].prev;
+
+	twoq_pf_queue[pf_idx].next = queue;
+	twoq_pf_queue[pf_idx].prev = tail;
+	twoq_pf_queue[tail].next = pf_idx;
+	twoq_pf_queue[queue].prev = pf_idx;
+	twoq_pf_queue[pf_idx].state = (queue == Q_PROTECTED) ? STATE_PROTECTED : STATE_PROBATION;
+	(*count_of(queue))++;
+}
+
+static void twoq_remove(uint32_t pf_idx)
+{
+	uint32_t queue = queue_of(pf_idx);
+	uint32_t next = twoq_pf_queue[pf_idx].next;
+	uint32_t prev = twoq_pf_queue[pf_idx].prev;
+	uint32_t head;
+
+	twoq_pf_queue[prev].next = next;
+	twoq_pf_queue[next].prev = prev;
+	twoq_pf_queue[pf_idx].next = 0;
+	twoq_pf_queue[pf_idx].prev = 0;
+	twoq_pf_queue[pf_idx].state = STATE_UNQUEUED;
+	(*count_of(queue))--;
+
+	/* make new head PF unaccessible if it exists and it is not alone */
+	head = queue_head(queue);
+	if ((prev == queue) && (head != 0) && (twoq_pf_queue[head].next != queue)) {
+		make_unaccessible(head);
+	}
+}
+
+/* Demote protected pages while there are too many of them */
+static void twoq_balance(void)
+{
+	uint32_t total = twoq_count[0] + twoq_count[1];
+
+	while (((uint64_t)twoq_count[1] * 100U) >
+	       ((uint64_t)total * CONFIG_EVICTION_2Q_PROTECTED_PERCENT)) {
+		uint32_t pf_idx = queue_head(Q_PROTECTED);
+
+		twoq_remove(pf_idx);
+		twoq_append(Q_PROBATION, pf_idx);
+		/* it did get reused: one more access promotes it again */
+		twoq_pf_queue[pf_idx].touched = 1U;
+	}
+}
+
+static bool ghost_take(void *addr)
+{
+	for (int i = 0; i < ARRAY_SIZE(twoq_ghosts); i++) {
+		if (twoq_ghosts[i] == addr) {
+			twoq_ghosts[i] = NULL;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void ghost_add(void *addr)
+{
+	twoq_ghosts[twoq_ghost_next] = addr;
+	twoq_ghost_next = (twoq_ghost_next + 1U) % ARRAY_SIZE(twoq_ghosts);
+}
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&twoq_lock);
+
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	__ASSERT(twoq_pf_queue[pf_idx].state == STATE_UNQUEUED, "");
+
+	if (ghost_take(k_mem_page_frame_to_virt(pf))) {
+		twoq_append(Q_PROTECTED, pf_idx);
+		twoq_pf_queue[pf_idx].touched = 1U;
+		twoq_balance();
+	} else {
+		twoq_append(Q_PROBATION, pf_idx);
+		twoq_pf_queue[pf_idx].touched = 0U;
+	}
+	k_spin_unlock(&twoq_lock, key);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&twoq_lock);
+
+	__ASSERT(twoq_pf_queue[pf_idx].state != STATE_UNQUEUED, "");
+
+	if ((pf_idx == twoq_victim) && (twoq_pf_queue[pf_idx].state == STATE_PROBATION)) {
+		ghost_add(k_mem_page_frame_to_virt(pf));
+	}
+	twoq_victim = 0;
+
+	twoq_remove(pf_idx);
+	k_spin_unlock(&twoq_lock, key);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	struct k_mem_page_frame *pf = k_mem_phys_to_page_frame(phys);
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&twoq_lock);
+
+	switch (twoq_pf_queue[pf_idx].state) {
+	case STATE_PROBATION:
+		if (twoq_pf_queue[pf_idx].touched == 0U) {
+			twoq_pf_queue[pf_idx].touched = 1U;
+			break;
+		}
+		twoq_remove(pf_idx);
+		twoq_append(Q_PROTECTED, pf_idx);
+		twoq_balance();
+		break;
+	case STATE_PROTECTED:
+		twoq_remove(pf_idx);
+		twoq_append(Q_PROTECTED, pf_idx);
+		break;
+	default:
+		break;
+	}
+	k_spin_unlock(&twoq_lock, key);
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	k_spinlock_key_t key = k_spin_lock(&twoq_lock);
+	uint32_t head_pf_idx = queue_head(Q_PROBATION);
+
+	if (head_pf_idx == 0) {
+		head_pf_idx = queue_head(Q_PROTECTED);
+	}
+	twoq_victim = head_pf_idx;
+	k_spin_unlock(&twoq_lock, key);
+
+	if (head_pf_idx == 0) {
+		return NULL;
+	}
+
+	struct k_mem_page_frame *pf = idx_to_pf(head_pf_idx);
+	uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, false);
+
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	*dirty_ptr = ((flags & ARCH_DATA_PAGE_DIRTY) != 0);
+	return pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -23,6 +23,14 @@ LOG_MODULE_REGISTER(flash_img, CONFIG_IMG_MANAGER_LOG_LEVEL);
 #include <bootutil/bootutil_public.h>
 #endif
 
+#ifdef CONFIG_IMG_STREAM_HASH
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+#define HASH_SUCCESS PSA_SUCCESS
+#else
+#define HASH_SUCCESS 0
+#endif
+#endif
+
 #include <zephyr/devicetree.h>
 #ifdef CONFIG_TRUSTED_EXECUTION_NONSECURE
 	#define UPLOAD_FLASH_AREA_LABEL slot1_ns_partition
@@ -56,6 +64,74 @@ BUILD_ASSERT((CONFIG_IMG_BLOCK_BUF_SIZE % FLASH_WRITE_BLOCK_SIZE == 0),
 #define FLASH_CHECK_ERASED_BUFFER_SIZE 16
 #define ERASED_VAL_32(x) (((x) << 24) | ((x) << 16) | ((x) << 8) | (x))
 
+#ifdef CONFIG_IMG_STREAM_HASH
+static void hash_start(struct flash_img_context *ctx)
+{
+	int rc;
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+	ctx->hash = psa_hash_operation_init();
+	rc = psa_hash_setup(&ctx->hash, PSA_ALG_SHA_256);
+#else
+	mbedtls_sha256_init(&ctx->hash);
+	rc = mbedtls_sha256_starts(&ctx->hash, false);
+#endif
+	ctx->hash_ok = (rc == HASH_SUCCESS);
+	if (!ctx->hash_ok) {
+		LOG_WRN("Image hash not available (%d)", rc);
+	}
+}
+
+static void hash_abort(struct flash_img_context *ctx)
+{
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+	psa_hash_abort(&ctx->hash);
+#else
+	mbedtls_sha256_free(&ctx->hash);
+#endif
+	ctx->hash_ok = false;
+}
+
+static void hash_update(struct flash_img_context *ctx, const uint8_t *data, size_t len)
+{
+	int rc;
+
+	if (!ctx->hash_ok || len == 0) {
+		return;
+	}
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+	rc = psa_hash_update(&ctx->hash, data, len);
+#else
+	rc = mbedtls_sha256_update(&ctx->hash, data, len);
+#endif
+	if (rc != HASH_SUCCESS) {
+		LOG_WRN("Image hash update failed (%d)", rc);
+		hash_abort(ctx);
+	}
+}
+
+int flash_img_hash_finish(struct flash_img_context *ctx, uint8_t *hash)
+{
+	int rc;
+
+	if (!ctx->hash_ok) {
+		return -ENODATA;
+	}
+
+#if defined(CONFIG_FLASH_AREA_CHECK_INTEGRITY_PSA)
+	size_t hash_len;
+
+	rc = psa_hash_finish(&ctx->hash, hash, PSA_HASH_LENGTH(PSA_ALG_SHA_256), &hash_len);
+#else
+	rc = mbedtls_sha256_finish(&ctx->hash, hash);
+#endif
+	hash_abort(ctx);
+
+	return (rc == HASH_SUCCESS) ? 0 : -ENODATA;
+}
+#endif /* CONFIG_IMG_STREAM_HASH */
+
 static int scramble_mcuboot_trailer(struct flash_img_context *ctx)
 {
 	int rc = 0;
@@ -125,6 +201,14 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 	 * ensures that stream_flash erases flash progresively.
 	 */
 	rc = stream_flash_buffered_write(&ctx->stream, data, len, flush);
+#ifdef CONFIG_IMG_STREAM_HASH
+	if (rc == 0) {
+		hash_update(ctx, data, len);
+	} else if (ctx->hash_ok) {
+		/* Data in flash is unknown */
+		hash_abort(ctx);
+	}
+#endif
 	if (!flush) {
 		return rc;
 	}
@@ -199,6 +283,10 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 	struct flash_sector sector_data;
 #endif
 
+#ifdef CONFIG_IMG_STREAM_HASH
+	ctx->hash_ok = false;
+#endif
+
 	rc = flash_area_open(area_id,
 			       (const struct flash_area **)&(ctx->flash_area));
 	if (rc) {
@@ -238,14 +326,22 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 		}
 	}
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE,
-				 (ctx->flash_area->fa_off + sector_data.fs_size),
-				 (ctx->flash_area->fa_size - sector_data.fs_size), NULL);
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf, CONFIG_IMG_BLOCK_BUF_SIZE,
+			       (ctx->flash_area->fa_off + sector_data.fs_size),
+			       (ctx->flash_area->fa_size - sector_data.fs_size), NULL);
 #else
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
 #endif
+
+#ifdef CONFIG_IMG_STREAM_HASH
+	if (rc == 0) {
+		hash_start(ctx);
+	}
+#endif
+
+	return rc;
 }
 
 #ifdef CONFIG_MCUBOOT_BOOTLOADER_MODE_RAM_LOAD
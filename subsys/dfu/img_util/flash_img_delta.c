@@ -0,0 +1,222 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+LOG_MODULE_DECLARE(flash_img, CONFIG_IMG_MANAGER_LOG_LEVEL);
+
+int flash_img_delta_parse_header(const uint8_t *data, size_t len,
+				 struct flash_img_delta_header *hdr)
+{
+	if (len < sizeof(*hdr) || sys_get_le32(data) != FLASH_IMG_DELTA_MAGIC) {
+		return -EINVAL;
+	}
+
+	hdr->magic = FLASH_IMG_DELTA_MAGIC;
+	hdr->source_size = sys_get_le32(&data[4]);
+	hdr->source_crc = sys_get_le32(&data[8]);
+	hdr->target_size = sys_get_le32(&data[12]);
+	hdr->target_crc = sys_get_le32(&data[16]);
+
+	return 0;
+}
+
+int flash_img_delta_init(struct flash_img_delta *delta, struct flash_img_context *img,
+			 uint8_t source_area_id)
+{
+	memset(delta, 0, offsetof(struct flash_img_delta, buf));
+	delta->img = img;
+
+	return flash_area_open(source_area_id, &delta->source);
+}
+
+static int delta_emit(struct flash_img_delta *delta, const uint8_t *data, size_t len)
+{
+	delta->crc = crc32_ieee_update(delta->crc, data, len);
+	delta->written += len;
+
+	return flash_img_buffered_write(delta->img, data, len, false);
+}
+
+/* Produces len bytes of the current operation out of the source image, plus
+ * diff when not NULL.
+ */
+static int delta_from_source(struct flash_img_delta *delta, const uint8_t *diff, size_t len)
+{
+	while (len > 0) {
+		size_t chunk = MIN(len, sizeof(delta->buf));
+		int rc;
+
+		rc = flash_area_read(delta->source, delta->op_off, delta->buf, chunk);
+		if (rc != 0) {
+			return rc;
+		}
+
+		if (diff != NULL) {
+			for (size_t i = 0; i < chunk; i++) {
+				delta->buf[i] += diff[i];
+			}
+			diff += chunk;
+		}
+
+		rc = delta_emit(delta, delta->buf, chunk);
+		if (rc != 0) {
+			return rc;
+		}
+
+		delta->op_off += chunk;
+		delta->op_len -= chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static int delta_start(struct flash_img_delta *delta)
+{
+	struct flash_img_delta_header *hdr = &delta->hdr;
+	uint32_t crc = 0;
+	int rc;
+
+	rc = flash_img_delta_parse_header(delta->in, sizeof(delta->in), hdr);
+	if (rc != 0) {
+		LOG_ERR("Not a patch");
+		return rc;
+	}
+
+	if (hdr->source_size > delta->source->fa_size) {
+		LOG_ERR("Patch source larger than its slot: %u", hdr->source_size);
+		return -ESPIPE;
+	}
+
+	/* Nothing is written unless the patch is for the image in the slot */
+	for (uint32_t off = 0; off < hdr->source_size; off += sizeof(delta->buf)) {
+		size_t chunk = MIN(sizeof(delta->buf), hdr->source_size - off);
+
+		rc = flash_area_read(delta->source, off, delta->buf, chunk);
+		if (rc != 0) {
+			return rc;
+		}
+		crc = crc32_ieee_update(crc, delta->buf, chunk);
+	}
+
+	if (crc != hdr->source_crc) {
+		LOG_ERR("Patch does not apply to the source image");
+		return -ESPIPE;
+	}
+
+	delta->started = true;
+
+	return 0;
+}
+
+static int delta_start_op(struct flash_img_delta *delta)
+{
+	uint8_t op = delta->in[0];
+	uint32_t len = sys_get_le32(&delta->in[1]);
+	uint32_t off = sys_get_le32(&delta->in[5]);
+
+	if (op < FLASH_IMG_DELTA_OP_COPY || op > FLASH_IMG_DELTA_OP_INSERT ||
+	    len > delta->hdr.target_size - delta->written) {
+		LOG_ERR("Invalid patch operation %u, length %u", op, len);
+		return -EINVAL;
+	}
+
+	if (op != FLASH_IMG_DELTA_OP_INSERT &&
+	    (off > delta->hdr.source_size || len > delta->hdr.source_size - off)) {
+		LOG_ERR("Patch operation out of source: %u + %u", off, len);
+		return -EINVAL;
+	}
+
+	delta->op = op;
+	delta->op_len = len;
+	delta->op_off = off;
+
+	/* A copy takes no more patch data, do it at once */
+	if (op == FLASH_IMG_DELTA_OP_COPY) {
+		return delta_from_source(delta, NULL, len);
+	}
+
+	return 0;
+}
+
+int flash_img_delta_write(struct flash_img_delta *delta, const uint8_t *data,
+			  size_t len, bool flush)
+{
+	int rc;
+
+	while (len > 0) {
+		size_t n;
+
+		if (delta->op_len == 0) {
+			/* Collect the patch or operation header */
+			size_t need = delta->started ? FLASH_IMG_DELTA_OP_SIZE : sizeof(delta->in);
+
+			n = MIN(len, need - delta->in_len);
+			memcpy(&delta->in[delta->in_len], data, n);
+			delta->in_len += n;
+			data += n;
+			len -= n;
+
+			if (delta->in_len < need) {
+				break;
+			}
+
+			delta->in_len = 0;
+			rc = delta->started ? delta_start_op(delta) : delta_start(delta);
+			if (rc != 0) {
+				return rc;
+			}
+			continue;
+		}
+
+		n = MIN(len, delta->op_len);
+		if (delta->op == FLASH_IMG_DELTA_OP_ADD) {
+			rc = delta_from_source(delta, data, n);
+		} else {
+			rc = delta_emit(delta, data, n);
+			delta->op_len -= n;
+		}
+		if (rc != 0) {
+			return rc;
+		}
+
+		data += n;
+		len -= n;
+	}
+
+	if (!flush) {
+		return 0;
+	}
+
+	if (!delta->started || delta->in_len != 0 || delta->op_len != 0 ||
+	    delta->written != delta->hdr.target_size) {
+		LOG_ERR("Patch truncated: %u of %u bytes produced", delta->written,
+			delta->hdr.target_size);
+		return -EINVAL;
+	}
+
+	rc = flash_img_buffered_write(delta->img, delta->buf, 0, true);
+	if (rc != 0) {
+		return rc;
+	}
+
+	flash_area_close(delta->source);
+
+	if (delta->crc != delta->hdr.target_crc) {
+		LOG_ERR("Patched image CRC mismatch");
+		return -EILSEQ;
+	}
+
+	return 0;
+}
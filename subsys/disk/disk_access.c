@@ -14,6 +14,10 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#ifdef CONFIG_DISK_CACHE
+#include "disk_cache.h"
+#endif
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -62,6 +66,10 @@ int disk_access_init(const char *pdrv)
 	if ((disk != NULL) && (disk->refcnt == 0U)) {
 		/* Disk has not been initialized, start it */
 		if ((disk->ops != NULL) && (disk->ops->init != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+			/* The media may have changed */
+			disk_cache_invalidate(disk);
+#endif
 			rc = disk->ops->init(disk);
 			if (rc == 0) {
 				/* Increment reference count */
@@ -98,7 +106,11 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_read(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -112,7 +124,11 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
+#ifdef CONFIG_DISK_CACHE
+		rc = disk_cache_write(disk, data_buf, start_sector, num_sector);
+#else
 		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+#endif
 	}
 
 	return rc;
@@ -128,6 +144,9 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 		switch (cmd) {
 		case DISK_IOCTL_CTRL_INIT:
 			if (disk->refcnt == 0U) {
+#ifdef CONFIG_DISK_CACHE
+				disk_cache_invalidate(disk);
+#endif
 				rc = disk->ops->ioctl(disk, cmd, buf);
 				if (rc == 0) {
 					disk->refcnt++;
@@ -140,6 +159,12 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 			}
 			break;
 		case DISK_IOCTL_CTRL_DEINIT:
+#ifdef CONFIG_DISK_CACHE
+			if (((buf != NULL) && (*((bool *)buf))) || (disk->refcnt == 1U)) {
+				(void)disk_cache_sync(disk);
+				disk_cache_invalidate(disk);
+			}
+#endif
 			if ((buf != NULL) && (*((bool *)buf))) {
 				/* Force deinit disk */
 				disk->refcnt = 0U;
@@ -157,6 +182,14 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 				LOG_WRN("Disk is already deinitialized");
 			}
 			break;
+#ifdef CONFIG_DISK_CACHE
+		case DISK_IOCTL_CTRL_SYNC:
+			rc = disk_cache_sync(disk);
+			if (rc == 0) {
+				rc = disk->ops->ioctl(disk, cmd, buf);
+			}
+			break;
+#endif
 		default:
 			rc = disk->ops->ioctl(disk, cmd, buf);
 		}
@@ -204,6 +237,11 @@ int disk_access_unregister(struct disk_info *disk)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_DISK_CACHE
+	(void)disk_cache_sync(disk);
+	disk_cache_invalidate(disk);
+#endif
+
 	spinlock_key = k_spin_lock(&lock);
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
@@ -0,0 +1,468 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define SECTOR_SIZE CONFIG_DISK_CACHE_SECTOR_SIZE
+#define BURST_SECTORS CONFIG_DISK_CACHE_BURST_SECTORS
+
+/* disk_info.cache.state, the disks are probed at their first access */
+#define DISK_CACHE_UNKNOWN 0U
+#define DISK_CACHE_ON      1U
+#define DISK_CACHE_OFF     2U
+
+struct disk_cache_block {
+	/* In cache_lru */
+	sys_dnode_t node;
+	/* NULL when free */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+};
+
+/*
+ * Blocks are kept in least recently used order, the free ones at the
+ * tail.  Lookups scan the blocks, which costs little next to a command
+ * to the media for the sizes this cache is meant for.
+ */
+static struct disk_cache_block cache_blocks[CONFIG_DISK_CACHE_BLOCKS];
+static uint8_t cache_data[CONFIG_DISK_CACHE_BLOCKS][SECTOR_SIZE] __aligned(4);
+/* Contiguous sectors of a readahead or of a write-back */
+static uint8_t cache_burst[BURST_SECTORS * SECTOR_SIZE] __aligned(4);
+static sys_dlist_t cache_lru = SYS_DLIST_STATIC_INIT(&cache_lru);
+
+/*
+ * Held across the driver calls.  A disk driver may access another disk,
+ * as the loopback one does through a file system: such nested accesses
+ * only use the blocks already cached and leave cache_burst alone.
+ */
+static K_MUTEX_DEFINE(cache_lock);
+static uint8_t cache_depth;
+
+#ifdef CONFIG_DISK_CACHE_WRITE_BACK
+static void cache_flush_handler(struct k_work *work);
+
+static K_KERNEL_STACK_DEFINE(cache_flush_stack, CONFIG_DISK_CACHE_FLUSH_STACK_SIZE);
+static struct k_work_q cache_flush_work_q;
+static K_WORK_DELAYABLE_DEFINE(cache_flush_work, cache_flush_handler);
+#endif /* CONFIG_DISK_CACHE_WRITE_BACK */
+
+static bool cache_enter(void)
+{
+	(void)k_mutex_lock(&cache_lock, K_FOREVER);
+	cache_depth++;
+
+	return cache_depth > 1U;
+}
+
+static void cache_exit(void)
+{
+	cache_depth--;
+	(void)k_mutex_unlock(&cache_lock);
+}
+
+static inline uint8_t *block_data(const struct disk_cache_block *blk)
+{
+	return cache_data[blk - cache_blocks];
+}
+
+static bool cache_enabled(struct disk_info *disk)
+{
+	uint32_t sector_size;
+
+	/* Before disk_cache_init() */
+	if (sys_dlist_is_empty(&cache_lru)) {
+		return false;
+	}
+
+	if (disk->cache.state == DISK_CACHE_UNKNOWN) {
+		/* Not ready yet, bypass the cache until it is */
+		if ((disk->ops->ioctl == NULL) ||
+		    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size) != 0) ||
+		    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+				      &disk->cache.sector_count) != 0)) {
+			return false;
+		}
+
+		disk->cache.state = (sector_size == SECTOR_SIZE) ? DISK_CACHE_ON : DISK_CACHE_OFF;
+		disk->cache.next_sector = 0U;
+		LOG_DBG("disk %s %scached", disk->name,
+			(disk->cache.state == DISK_CACHE_ON) ? "" : "not ");
+	}
+
+	return disk->cache.state == DISK_CACHE_ON;
+}
+
+static struct disk_cache_block *cache_find(const struct disk_info *disk, uint32_t sector)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		if ((cache_blocks[i].disk == disk) && (cache_blocks[i].sector == sector)) {
+			return &cache_blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct disk_cache_block *blk)
+{
+	sys_dlist_remove(&blk->node);
+	sys_dlist_prepend(&cache_lru, &blk->node);
+}
+
+static void cache_free(struct disk_cache_block *blk)
+{
+	blk->disk = NULL;
+	blk->dirty = false;
+	sys_dlist_remove(&blk->node);
+	sys_dlist_append(&cache_lru, &blk->node);
+}
+
+/* Writes back the dirty blocks of a disk, in increasing sector order */
+static int cache_flush_disk(struct disk_info *disk, bool merge)
+{
+	struct disk_cache_block *first;
+	struct disk_cache_block *blk;
+	uint32_t count;
+	int rc;
+
+	while (true) {
+		first = NULL;
+		for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+			blk = &cache_blocks[i];
+			if ((blk->disk == disk) && blk->dirty &&
+			    ((first == NULL) || (blk->sector < first->sector))) {
+				first = blk;
+			}
+		}
+
+		if (first == NULL) {
+			return 0;
+		}
+
+		/* Merge the contiguous dirty blocks in a single request */
+		for (count = 1U; merge && (count < BURST_SECTORS); count++) {
+			blk = cache_find(disk, first->sector + count);
+			if ((blk == NULL) || !blk->dirty) {
+				break;
+			}
+
+			if (count == 1U) {
+				memcpy(cache_burst, block_data(first), SECTOR_SIZE);
+			}
+
+			memcpy(&cache_burst[count * SECTOR_SIZE], block_data(blk), SECTOR_SIZE);
+		}
+
+		if (count == 1U) {
+			rc = disk->ops->write(disk, block_data(first), first->sector, 1U);
+		} else {
+			rc = disk->ops->write(disk, cache_burst, first->sector, count);
+		}
+
+		if (rc != 0) {
+			LOG_ERR("Error %d writing back %u sectors at %u of disk %s", rc,
+				count, first->sector, disk->name);
+			return rc;
+		}
+
+		for (uint32_t i = 0U; i < count; i++) {
+			cache_find(disk, first->sector + i)->dirty = false;
+		}
+	}
+}
+
+/* The least recently used clean block */
+static struct disk_cache_block *cache_lru_clean(void)
+{
+	struct disk_cache_block *blk;
+	sys_dnode_t *node;
+
+	for (node = sys_dlist_peek_tail(&cache_lru); node != NULL;
+	     node = sys_dlist_peek_prev(&cache_lru, node)) {
+		blk = CONTAINER_OF(node, struct disk_cache_block, node);
+		if (!blk->dirty) {
+			return blk;
+		}
+	}
+
+	return NULL;
+}
+
+/* Caches a sector read from the disk, unless it is cached already */
+static void cache_insert_clean(struct disk_info *disk, uint32_t sector, const uint8_t *data)
+{
+	struct disk_cache_block *blk;
+
+	/* The cached copy may be dirty, so newer than the disk */
+	if (cache_find(disk, sector) != NULL) {
+		return;
+	}
+
+	blk = cache_lru_clean();
+	if (blk == NULL) {
+		return;
+	}
+
+	blk->disk = disk;
+	blk->sector = sector;
+	memcpy(block_data(blk), data, SECTOR_SIZE);
+	cache_touch(blk);
+}
+
+static int cache_fill(struct disk_info *disk, uint8_t *data_buf, uint32_t sector,
+		      uint32_t count, bool readahead)
+{
+	uint32_t burst = BURST_SECTORS;
+	int rc;
+
+	if (sector < disk->cache.sector_count) {
+		burst = MIN(burst, disk->cache.sector_count - sector);
+	}
+
+	if (!IS_ENABLED(CONFIG_DISK_CACHE_READAHEAD) || !readahead || (count >= burst)) {
+		rc = disk->ops->read(disk, data_buf, sector, count);
+		if ((rc == 0) && (count < BURST_SECTORS)) {
+			for (uint32_t i = 0U; i < count; i++) {
+				cache_insert_clean(disk, sector + i, &data_buf[i * SECTOR_SIZE]);
+			}
+		}
+
+		return rc;
+	}
+
+	rc = disk->ops->read(disk, cache_burst, sector, burst);
+	if (rc != 0) {
+		return rc;
+	}
+
+	memcpy(data_buf, cache_burst, count * SECTOR_SIZE);
+	for (uint32_t i = 0U; i < burst; i++) {
+		cache_insert_clean(disk, sector + i, &cache_burst[i * SECTOR_SIZE]);
+	}
+
+	return 0;
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+	bool nested = cache_enter();
+	bool sequential;
+	uint32_t count;
+	uint32_t i = 0U;
+	int rc = 0;
+
+	if (!cache_enabled(disk)) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	sequential = (start_sector == disk->cache.next_sector);
+
+	while (i < num_sector) {
+		blk = cache_find(disk, start_sector + i);
+		if (blk != NULL) {
+			memcpy(&data_buf[i * SECTOR_SIZE], block_data(blk), SECTOR_SIZE);
+			cache_touch(blk);
+			i++;
+			continue;
+		}
+
+		/* Read the missing sectors in a single request */
+		for (count = 1U; (i + count) < num_sector; count++) {
+			if (cache_find(disk, start_sector + i + count) != NULL) {
+				break;
+			}
+		}
+
+		if (nested) {
+			rc = disk->ops->read(disk, &data_buf[i * SECTOR_SIZE],
+					     start_sector + i, count);
+		} else {
+			rc = cache_fill(disk, &data_buf[i * SECTOR_SIZE], start_sector + i,
+					count, sequential);
+		}
+
+		if (rc != 0) {
+			goto out;
+		}
+
+		i += count;
+	}
+
+	disk->cache.next_sector = start_sector + num_sector;
+
+out:
+	cache_exit();
+
+	return rc;
+}
+
+static void cache_schedule_flush(void)
+{
+#ifdef CONFIG_DISK_CACHE_WRITE_BACK
+	if (CONFIG_DISK_CACHE_FLUSH_INTERVAL > 0) {
+		/* Keeps an earlier deadline */
+		(void)k_work_schedule_for_queue(&cache_flush_work_q, &cache_flush_work,
+						K_MSEC(CONFIG_DISK_CACHE_FLUSH_INTERVAL));
+	}
+#endif /* CONFIG_DISK_CACHE_WRITE_BACK */
+}
+
+static int cache_write_back(struct disk_info *disk, const uint8_t *data_buf,
+			    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+	int rc;
+
+	for (uint32_t i = 0U; i < num_sector; i++) {
+		blk = cache_find(disk, start_sector + i);
+		if (blk == NULL) {
+			blk = cache_lru_clean();
+		}
+
+		if (blk == NULL) {
+			/* Everything is dirty, make room */
+			blk = CONTAINER_OF(sys_dlist_peek_tail(&cache_lru),
+					   struct disk_cache_block, node);
+			rc = cache_flush_disk(blk->disk, true);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+
+		blk->disk = disk;
+		blk->sector = start_sector + i;
+		blk->dirty = true;
+		memcpy(block_data(blk), &data_buf[i * SECTOR_SIZE], SECTOR_SIZE);
+		cache_touch(blk);
+	}
+
+	cache_schedule_flush();
+
+	return 0;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_block *blk;
+	bool nested = cache_enter();
+	int rc;
+
+	if (!cache_enabled(disk)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_CACHE_WRITE_BACK) && !nested &&
+	    (num_sector < BURST_SECTORS)) {
+		rc = cache_write_back(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+	if (rc != 0) {
+		goto out;
+	}
+
+	/* Keep the cached copies current, the write supersedes dirty ones */
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		blk = &cache_blocks[i];
+		if ((blk->disk == disk) && (blk->sector >= start_sector) &&
+		    ((blk->sector - start_sector) < num_sector)) {
+			memcpy(block_data(blk),
+			       &data_buf[(blk->sector - start_sector) * SECTOR_SIZE],
+			       SECTOR_SIZE);
+			blk->dirty = false;
+		}
+	}
+
+out:
+	cache_exit();
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	bool nested = cache_enter();
+	int rc = cache_flush_disk(disk, !nested);
+
+	cache_exit();
+
+	return rc;
+}
+
+void disk_cache_invalidate(struct disk_info *disk)
+{
+	(void)cache_enter();
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		if (cache_blocks[i].disk == disk) {
+			cache_free(&cache_blocks[i]);
+		}
+	}
+
+	disk->cache.state = DISK_CACHE_UNKNOWN;
+
+	cache_exit();
+}
+
+#ifdef CONFIG_DISK_CACHE_WRITE_BACK
+static void cache_flush_handler(struct k_work *work)
+{
+	struct disk_cache_block *blk;
+	bool nested;
+
+	ARG_UNUSED(work);
+
+	nested = cache_enter();
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		blk = &cache_blocks[i];
+		if (blk->dirty && (cache_flush_disk(blk->disk, !nested) != 0)) {
+			/* Retry later */
+			cache_schedule_flush();
+			break;
+		}
+	}
+
+	cache_exit();
+}
+#endif /* CONFIG_DISK_CACHE_WRITE_BACK */
+
+static int disk_cache_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache_blocks); i++) {
+		sys_dlist_append(&cache_lru, &cache_blocks[i].node);
+	}
+
+#ifdef CONFIG_DISK_CACHE_WRITE_BACK
+	const struct k_work_queue_config cfg = {.name = "disk_cache"};
+
+	k_work_queue_start(&cache_flush_work_q, cache_flush_stack,
+			   K_KERNEL_STACK_SIZEOF(cache_flush_stack),
+			   CONFIG_DISK_CACHE_FLUSH_PRIORITY, &cfg);
+#endif /* CONFIG_DISK_CACHE_WRITE_BACK */
+
+	return 0;
+}
+
+SYS_INIT(disk_cache_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -67,6 +67,119 @@ struct char_framebuffer {
 
 static struct char_framebuffer char_fb;
 
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE
+/*
+ * Strings printed with line wrapping, by position. The characters of a
+ * string that did not change since it was last printed at the same place
+ * with the same font are still in the framebuffer and are not redrawn.
+ */
+struct text_cache_entry {
+	/** Position the string was printed at */
+	int16_t x;
+	int16_t y;
+
+	/** Area covered by the string, used to invalidate overlapped strings */
+	int16_t x_start;
+	int16_t x_end;
+	int16_t y_end;
+
+	/** Font index and kerning the string was printed with */
+	uint8_t font_idx;
+	int8_t kerning;
+
+	/** Number of cached characters, 0 if unused */
+	uint8_t len;
+
+	char str[CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE_LEN];
+};
+
+static struct text_cache_entry text_cache[CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE_ENTRIES];
+static uint8_t text_cache_next;
+
+static void text_cache_invalidate(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(text_cache); i++) {
+		text_cache[i].len = 0U;
+	}
+}
+
+static struct text_cache_entry *text_cache_lookup(const struct char_framebuffer *fb,
+						  int16_t x, int16_t y)
+{
+	struct text_cache_entry *entry = NULL;
+
+	if (fb->kerning < 0) {
+		/* Characters overlap their neighbors and must all be redrawn */
+		text_cache_invalidate();
+		return NULL;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(text_cache); i++) {
+		if (text_cache[i].len > 0 && text_cache[i].x == x && text_cache[i].y == y) {
+			entry = &text_cache[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		entry = &text_cache[text_cache_next];
+		text_cache_next = (text_cache_next + 1) % ARRAY_SIZE(text_cache);
+		entry->len = 0U;
+	} else if (entry->font_idx != fb->font_idx || entry->kerning != fb->kerning) {
+		entry->len = 0U;
+	}
+
+	entry->x = x;
+	entry->y = y;
+	entry->font_idx = fb->font_idx;
+	entry->kerning = fb->kerning;
+
+	return entry;
+}
+
+static inline bool text_cache_hit(const struct text_cache_entry *entry, size_t i, char c)
+{
+	return entry != NULL && i < entry->len && entry->str[i] == c;
+}
+
+/* Record the printed string, x and y being where its last line ends */
+static void text_cache_store(const struct char_framebuffer *fb, struct text_cache_entry *entry,
+			     const char *str, size_t len, int16_t x, int16_t y)
+{
+	const struct cfb_font *fptr = &(fb->fonts[fb->font_idx]);
+
+	if (entry == NULL) {
+		return;
+	}
+
+	entry->len = MIN(len, sizeof(entry->str));
+	memcpy(entry->str, str, entry->len);
+
+	/* Wrapped strings cover whole lines */
+	entry->x_start = (y == entry->y) ? entry->x : 0;
+	entry->x_end = (y == entry->y) ? x : fb->x_res;
+	entry->y_end = y + fptr->height;
+
+	for (size_t i = 0; i < ARRAY_SIZE(text_cache); i++) {
+		struct text_cache_entry *other = &text_cache[i];
+
+		if (other == entry || other->len == 0) {
+			continue;
+		}
+
+		/* Overwritten, at least in part */
+		if (other->x_start < entry->x_end && entry->x_start < other->x_end &&
+		    other->y < entry->y_end && entry->y < other->y_end) {
+			other->len = 0U;
+		}
+	}
+}
+#else
+static inline void text_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE */
+
 static inline uint8_t *get_glyph_ptr(const struct cfb_font *fptr, uint8_t c)
 {
 	return (uint8_t *)fptr->data +
@@ -91,6 +204,69 @@ static inline uint8_t get_glyph_byte(uint8_t *glyph_ptr, const struct cfb_font *
 	return 0;
 }
 
+/*
+ * Blit a glyph lying entirely inside the monochrome tiled framebuffer one
+ * column at a time: the column is gathered into a 32-bit word, top pixel in
+ * the LSB, shifted to its offset in the first tile and written out a tile
+ * byte at a time under a mask. Returns false if the glyph is not suitable,
+ * so that it is drawn by the generic code.
+ */
+static bool blit_glyph_vtmono(const struct char_framebuffer *fb, const struct cfb_font *fptr,
+			      const uint8_t *glyph_ptr, uint16_t x, uint16_t y, bool draw_bg)
+{
+	const bool font_is_msbfirst = ((fptr->caps & CFB_FONT_MSB_FIRST) != 0);
+	const bool display_is_msbfirst = ((fb->screen_info & SCREEN_INFO_MONO_MSB_FIRST) != 0);
+	const uint8_t glyph_bytes = fptr->height / 8U;
+	const uint8_t offset = y % 8;
+	const uint8_t tiles = DIV_ROUND_UP(offset + fptr->height, 8U);
+	const uint32_t mask = (uint32_t)(BIT64_MASK(fptr->height) << offset);
+	uint8_t *tile_ptr;
+
+	if ((fptr->caps & CFB_FONT_MONO_VPACKED) == 0 || (fptr->height % 8) != 0 ||
+	    (offset + fptr->height) > 32) {
+		return false;
+	}
+
+	if ((x + fptr->width) > fb->x_res || (y + fptr->height) > fb->y_res) {
+		return false;
+	}
+
+	tile_ptr = &fb->buf[(y / 8U) * fb->x_res + x];
+
+	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
+		uint32_t column = 0;
+
+		for (size_t i = 0; i < glyph_bytes; i++) {
+			uint8_t byte = glyph_ptr[g_x * glyph_bytes + i];
+
+			if (font_is_msbfirst) {
+				byte = byte_reverse(byte);
+			}
+			column |= (uint32_t)byte << (i * 8);
+		}
+		column <<= offset;
+
+		for (size_t t = 0; t < tiles; t++) {
+			uint8_t *dst = &tile_ptr[t * fb->x_res + g_x];
+			uint8_t byte = (uint8_t)(column >> (t * 8));
+			uint8_t m = (uint8_t)(mask >> (t * 8));
+
+			if (display_is_msbfirst) {
+				byte = byte_reverse(byte);
+				m = byte_reverse(m);
+			}
+
+			if (draw_bg) {
+				*dst = (*dst & ~m) | byte;
+			} else {
+				*dst |= byte;
+			}
+		}
+	}
+
+	return true;
+}
+
 /*
  * Draw the monochrome character in the monochrome tiled framebuffer,
  * a byte is interpreted as 8 pixels ordered vertically among each other.
@@ -114,6 +290,10 @@ static uint8_t draw_char_vtmono(const struct char_framebuffer *fb,
 		return 0;
 	}
 
+	if (blit_glyph_vtmono(fb, fptr, glyph_ptr, x, y, draw_bg)) {
+		return fptr->width;
+	}
+
 	for (size_t g_x = 0; g_x < fptr->width; g_x++) {
 		const int16_t fb_x = x + g_x;
 
@@ -339,18 +519,35 @@ static int draw_text(const struct device *dev, const char *const str, int16_t x,
 	}
 
 	const size_t len = strlen(str);
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE
+	/* Only printing draws the background, which makes redrawing in place exact */
+	struct text_cache_entry *cached =
+		(wrap && (fb->screen_info & SCREEN_INFO_MONO_VTILED) != 0) ?
+		text_cache_lookup(fb, x, y) : NULL;
+#endif
 
 	for (size_t i = 0; i < len; i++) {
 		if ((x + fptr->width > fb->x_res) && wrap) {
 			x = 0U;
 			y += fptr->height;
 		}
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE
+		if (text_cache_hit(cached, i, str[i])) {
+			x += fb->kerning + fptr->width;
+			continue;
+		}
+#endif
 		if (fb->screen_info & SCREEN_INFO_MONO_VTILED) {
 			x += fb->kerning + draw_char_vtmono(fb, str[i], x, y, wrap);
 		} else {
 			x += fb->kerning + draw_char_htmono(fb, str[i], x, y, wrap);
 		}
 	}
+
+#ifdef CONFIG_CHARACTER_FRAMEBUFFER_TEXT_CACHE
+	text_cache_store(fb, cached, str, len, x, y);
+#endif
+
 	return 0;
 }
 
@@ -358,6 +555,7 @@ int cfb_draw_point(const struct device *dev, const struct cfb_position *pos)
 {
 	struct char_framebuffer *fb = &char_fb;
 
+	text_cache_invalidate();
 	draw_point(fb, pos->x, pos->y);
 
 	return 0;
@@ -368,6 +566,7 @@ int cfb_draw_line(const struct device *dev, const struct cfb_position *start,
 {
 	struct char_framebuffer *fb = &char_fb;
 
+	text_cache_invalidate();
 	draw_line(fb, start->x, start->y, end->x, end->y);
 
 	return 0;
@@ -378,6 +577,7 @@ int cfb_draw_rect(const struct device *dev, const struct cfb_position *start,
 {
 	struct char_framebuffer *fb = &char_fb;
 
+	text_cache_invalidate();
 	draw_line(fb, start->x, start->y, end->x, start->y);
 	draw_line(fb, end->x, start->y, end->x, end->y);
 	draw_line(fb, end->x, end->y, start->x, end->y);
@@ -388,6 +588,8 @@ int cfb_draw_rect(const struct device *dev, const struct cfb_position *start,
 
 int cfb_draw_text(const struct device *dev, const char *const str, int16_t x, int16_t y)
 {
+	text_cache_invalidate();
+
 	return draw_text(dev, str, x, y, false);
 }
 
@@ -408,6 +610,8 @@ int cfb_invert_area(const struct device *dev, uint16_t x, uint16_t y,
 		return -EINVAL;
 	}
 
+	text_cache_invalidate();
+
 	if ((fb->screen_info & SCREEN_INFO_MONO_VTILED)) {
 		if (x > fb->x_res) {
 			x = fb->x_res;
@@ -501,6 +705,7 @@ int cfb_framebuffer_clear(const struct device *dev, bool clear_display)
 	}
 
 	memset(fb->buf, 0, fb->size);
+	text_cache_invalidate();
 
 	if (clear_display) {
 		cfb_framebuffer_finalize(dev);
@@ -652,6 +857,7 @@ int cfb_framebuffer_init(const struct device *dev)
 	}
 
 	memset(fb->buf, 0, fb->size);
+	text_cache_invalidate();
 
 	return 0;
 }
@@ -665,4 +871,5 @@ void cfb_framebuffer_deinit(const struct device *dev)
 		fb->buf = NULL;
 	}
 
+	text_cache_invalidate();
 }
@@ -476,6 +476,81 @@ int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block)
 	return 0;
 }
 
+/*
+ * Read the list of block numbers that contains the entry for the block described by offsets
+ * and cache a window of it, starting at that entry, in the inode.
+ */
+static int map_level_blocks(struct ext2_inode *inode, uint32_t block, uint32_t offsets[4],
+		int max_lvl)
+{
+	struct ext2_data *fs = inode->i_fs;
+	const uint32_t B = fs->block_size / EXT2_BLOCK_NUM_SIZE;
+	struct ext2_block *list_block;
+	uint32_t *list;
+	uint32_t num = inode->i_block[offsets[0]];
+
+	for (int lvl = 1; lvl <= max_lvl; ++lvl) {
+		if (num == 0) {
+			/* Hole: the whole list is made of zeros */
+			inode->map_first = block;
+			inode->map_count = MIN(CONFIG_EXT2_INODE_MAP_SIZE, B - offsets[max_lvl]);
+			memset(inode->map, 0, inode->map_count * sizeof(uint32_t));
+			inode->flags |= INODE_MAPPED;
+			return 0;
+		}
+
+		list_block = ext2_get_block(fs, num);
+		if (list_block == NULL) {
+			return -ENOENT;
+		}
+		list = (uint32_t *)list_block->data;
+
+		if (lvl < max_lvl) {
+			num = sys_le32_to_cpu(list[offsets[lvl]]);
+		} else {
+			inode->map_first = block;
+			inode->map_count = MIN(CONFIG_EXT2_INODE_MAP_SIZE, B - offsets[lvl]);
+			for (uint32_t i = 0; i < inode->map_count; ++i) {
+				inode->map[i] = sys_le32_to_cpu(list[offsets[lvl] + i]);
+			}
+			inode->flags |= INODE_MAPPED;
+		}
+		ext2_drop_block(list_block);
+	}
+	return 0;
+}
+
+int ext2_inode_map_block(struct ext2_inode *inode, uint32_t block, uint32_t *num)
+{
+	int max_lvl, ret;
+	uint32_t offsets[MAX_OFFSETS_SIZE];
+
+	if (block < EXT2_INODE_BLOCK_1LVL) {
+		*num = inode->i_block[block];
+		return 0;
+	}
+
+	if ((inode->flags & INODE_MAPPED) && block >= inode->map_first &&
+			block - inode->map_first < inode->map_count) {
+		*num = inode->map[block - inode->map_first];
+		return 0;
+	}
+
+	max_lvl = get_level_offsets(inode->i_fs, block, offsets);
+	if (max_lvl < 0) {
+		return max_lvl;
+	}
+
+	inode->flags &= ~INODE_MAPPED;
+	ret = map_level_blocks(inode, block, offsets, max_lvl);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*num = inode->map[0];
+	return 0;
+}
+
 static bool all_zero(const uint32_t *offsets, int lvl)
 {
 	for (int i = 0; i < lvl; ++i) {
@@ -639,8 +714,8 @@ static int get_level_offsets(struct ext2_data *fs, uint32_t block, uint32_t offs
 	}
 
 	/* Level 3 */
+	block -= lvl2_blks;
 	if (block < lvl3_blks) {
-		block -= lvl2_blks;
 		offsets[0] = EXT2_INODE_BLOCK_3LVL;
 		offsets[1] = block / (B * B);
 		offsets[2] = (block % (B * B)) / B;
@@ -667,6 +742,9 @@ int64_t ext2_inode_remove_blocks(struct ext2_inode *inode, uint32_t first)
 	uint32_t offsets[4];
 	struct ext2_data *fs = inode->i_fs;
 
+	/* Cached mapping may point to removed blocks */
+	inode->flags &= ~INODE_MAPPED;
+
 	max_lvl = get_level_offsets(inode->i_fs, first, offsets);
 
 	if (all_zero(&offsets[1], max_lvl)) {
@@ -747,6 +825,9 @@ static int alloc_level_blocks(struct ext2_inode *inode)
 		}
 	}
 	if (allocated) {
+		/* Cached mapping may miss the new blocks */
+		inode->flags &= ~INODE_MAPPED;
+
 		/* Update number of reserved blocks.
 		 * (We are always counting 512 size blocks.)
 		 */
@@ -41,6 +41,21 @@ int ext2_fetch_inode(struct ext2_data *fs, uint32_t ino, struct ext2_inode *inod
  */
 int ext2_fetch_inode_block(struct ext2_inode *inode, uint32_t block);
 
+/**
+ * @brief Get number of the disk block that holds given inode block.
+ *
+ * The block numbers read from indirect blocks are cached in the inode, hence mapping
+ * consecutive blocks of a file reads the indirect blocks only once per window.
+ *
+ * @param inode Inode structure
+ * @param block Number of inode block (0 - first block in that inode)
+ * @param num Number of the disk block, 0 if the block isn't allocated
+ *
+ * @retval 0 on success
+ * @retval <0 error
+ */
+int ext2_inode_map_block(struct ext2_inode *inode, uint32_t block, uint32_t *num);
+
 /**
  * @brief Fetch block group into buffer in fs structure.
  *
@@ -34,6 +34,8 @@ char __aligned(sizeof(void *)) __ext2_block_struct_buffer[BLOCK_STRUCT_BUFFER_SI
 K_HEAP_DEFINE(direntry_heap, MAX_DIRENTRY_SIZE);
 K_MEM_SLAB_DEFINE(inode_struct_slab, sizeof(struct ext2_inode), MAX_INODES, sizeof(void *));
 
+static int inode_release(struct ext2_data *fs, uint32_t offset, bool cache);
+
 /* Helper functions --------------------------------------------------------- */
 
 void error_behavior(struct ext2_data *fs, const char *msg)
@@ -363,11 +365,10 @@ int ext2_close_fs(struct ext2_data *fs)
 {
 	int ret = 0;
 
-	/* Close all open inodes */
-	for (int32_t i = 0; i < fs->open_inodes; ++i) {
-		if (fs->inode_pool[i] != NULL) {
-			ext2_inode_drop(fs->inode_pool[i]);
-		}
+	/* Close all open inodes and free the cached ones */
+	for (int32_t i = fs->open_inodes - 1; i >= 0; --i) {
+		fs->inode_pool[i]->i_ref = 0;
+		(void)inode_release(fs, i, false);
 	}
 
 	/* To save file system as correct it must be writable and without errors */
@@ -606,6 +607,50 @@ success:
 
 /* Inode operations --------------------------------------------------------- */
 
+/**
+ * @brief Read whole blocks of the inode that are contiguous on the disk directly into buffer
+ *
+ * @retval >0 Number of read blocks
+ * @retval 0 First block isn't allocated or backend can't read many blocks at once
+ * @retval <0 Error
+ */
+static int inode_read_extent(struct ext2_inode *inode, void *buf, uint32_t block,
+		uint32_t count)
+{
+	int rc;
+	uint32_t first, num;
+	struct ext2_data *fs = inode->i_fs;
+
+	if (fs->backend_ops->read_blocks == NULL) {
+		return 0;
+	}
+
+	rc = ext2_inode_map_block(inode, block, &first);
+	if (rc < 0 || first == 0) {
+		return rc;
+	}
+
+	for (uint32_t i = 1; i < count; ++i) {
+		rc = ext2_inode_map_block(inode, block + i, &num);
+		if (rc < 0) {
+			return rc;
+		}
+		if (num != first + i) {
+			count = i;
+			break;
+		}
+	}
+
+	LOG_DBG("inode:%d read blocks %d-%d (disk: %d)", inode->i_id, block,
+			block + count - 1, first);
+
+	rc = fs->backend_ops->read_blocks(fs, buf, first, count);
+	if (rc < 0) {
+		return rc;
+	}
+	return count;
+}
+
 ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, size_t nbytes)
 {
 	int rc = 0;
@@ -617,6 +662,21 @@ ssize_t ext2_inode_read(struct ext2_inode *inode, void *buf, uint32_t offset, si
 
 		uint32_t block = offset / block_size;
 		uint32_t block_off = offset % block_size;
+		uint32_t whole_blocks = MIN(nbytes_to_read, inode->i_size - offset) / block_size;
+
+		/* Blocks which are read entirely don't have to go through the inode buffer */
+		if (block_off == 0 && whole_blocks > 1) {
+			rc = inode_read_extent(inode, (uint8_t *)buf + read, block, whole_blocks);
+			if (rc < 0) {
+				break;
+			}
+			if (rc > 0) {
+				read += rc * block_size;
+				nbytes_to_read -= rc * block_size;
+				offset += rc * block_size;
+				continue;
+			}
+		}
 
 		rc = ext2_fetch_inode_block(inode, block);
 		if (rc < 0) {
@@ -1438,6 +1498,74 @@ out:
 	return ret;
 }
 
+static void inode_pool_free(struct ext2_data *fs, uint32_t offset)
+{
+	uint32_t last = fs->open_inodes - 1;
+
+	k_mem_slab_free(&inode_struct_slab, (void *)fs->inode_pool[offset]);
+
+	/* copy last open in place of freed inode */
+	fs->inode_pool[offset] = fs->inode_pool[last];
+	fs->open_inodes--;
+}
+
+/**
+ * @brief Free one of the cached (not referenced) inodes other than keep
+ *
+ * @return true if an inode was freed
+ */
+static bool inode_cache_evict(struct ext2_data *fs, struct ext2_inode *keep)
+{
+	for (uint32_t i = 0; i < fs->open_inodes; ++i) {
+		struct ext2_inode *inode = fs->inode_pool[i];
+
+		if (inode->i_ref == 0 && inode != keep && !(inode->flags & INODE_REMOVE)) {
+			inode_pool_free(fs, i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Release inode which isn't referenced anymore
+ *
+ * @param offset Position of the inode in the inode pool
+ * @param cache If true then the inode may be kept in the pool for later lookups
+ */
+static int inode_release(struct ext2_data *fs, uint32_t offset, bool cache)
+{
+	int rc = 0;
+	struct ext2_inode *inode = fs->inode_pool[offset];
+
+	ext2_inode_drop_blocks(inode);
+
+	if (inode->flags & INODE_REMOVE) {
+		/* This is the inode that should be removed because
+		 * there was called unlink function on it.
+		 */
+		rc = remove_inode(inode);
+		if (rc < 0 && cache) {
+			return rc;
+		}
+	} else if (cache && CONFIG_EXT2_INODE_CACHE_SIZE > 0 && inode->i_id != 0) {
+		uint32_t cached = 0;
+
+		for (uint32_t i = 0; i < fs->open_inodes; ++i) {
+			if (fs->inode_pool[i]->i_ref == 0) {
+				cached++;
+			}
+		}
+		if (cached > CONFIG_EXT2_INODE_CACHE_SIZE) {
+			(void)inode_cache_evict(fs, inode);
+		}
+		return 0;
+	}
+
+	inode_pool_free(fs, offset);
+	return rc;
+}
+
 int ext2_inode_get(struct ext2_data *fs, uint32_t ino, struct ext2_inode **ret)
 {
 	int rc;
@@ -1453,11 +1581,10 @@ int ext2_inode_get(struct ext2_data *fs, uint32_t ino, struct ext2_inode **ret)
 		}
 	}
 
-	if (fs->open_inodes >= MAX_INODES) {
+	if (fs->open_inodes >= MAX_INODES && !inode_cache_evict(fs, NULL)) {
 		return -ENOMEM;
 	}
 
-
 	rc = k_mem_slab_alloc(&inode_struct_slab, (void **)&inode, K_FOREVER);
 	if (rc < 0) {
 		return -ENOMEM;
@@ -1512,27 +1639,7 @@ int ext2_inode_drop(struct ext2_inode *inode)
 			return -EINVAL;
 		}
 
-		ext2_inode_drop_blocks(inode);
-
-		if (inode->flags & INODE_REMOVE) {
-			/* This is the inode that should be removed because
-			 * there was called unlink function on it.
-			 */
-			int rc = remove_inode(inode);
-
-			if (rc < 0) {
-				return rc;
-			}
-		}
-
-		k_mem_slab_free(&inode_struct_slab, (void *)inode);
-
-		/* copy last open in place of freed inode */
-		uint32_t last = fs->open_inodes - 1;
-
-		fs->inode_pool[offset] = fs->inode_pool[last];
-		fs->open_inodes--;
-
+		return inode_release(fs, offset, true);
 	}
 
 	return 0;
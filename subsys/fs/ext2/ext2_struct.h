@@ -163,6 +163,7 @@ struct ext2_bgroup {
 /* Flags for inode */
 #define INODE_FETCHED_BLOCK BIT(0)
 #define INODE_REMOVE BIT(1)
+#define INODE_MAPPED BIT(2)
 
 struct ext2_inode {
 	struct ext2_data *i_fs;      /* pointer to file system data */
@@ -180,6 +181,10 @@ struct ext2_inode {
 	uint32_t block_num;        /* relative number of fetched block */
 	uint32_t offsets[4];       /* offsets describing path to fetched block */
 	struct ext2_block *blocks[4];   /* fetched blocks for each level */
+
+	uint32_t map_first;        /* relative number of the block mapped by map[0] */
+	uint32_t map_count;        /* number of valid entries in map */
+	uint32_t map[CONFIG_EXT2_INODE_MAP_SIZE]; /* block numbers read from an indirect block */
 };
 
 static inline struct ext2_block *inode_current_block(struct ext2_inode *inode)
@@ -219,12 +224,13 @@ struct ext2_backend_ops {
 	int64_t (*get_device_size)(struct ext2_data *fs);
 	int64_t (*get_write_size)(struct ext2_data *fs);
 	int (*read_block)(struct ext2_data *fs, void *buf, uint32_t num);
+	int (*read_blocks)(struct ext2_data *fs, void *buf, uint32_t num, uint32_t count);
 	int (*write_block)(struct ext2_data *fs, const void *buf, uint32_t num);
 	int (*read_superblock)(struct ext2_data *fs, struct ext2_disk_superblock *sb);
 	int (*sync)(struct ext2_data *fs);
 };
 
-#define MAX_INODES (CONFIG_EXT2_MAX_FILES + 2)
+#define MAX_INODES (CONFIG_EXT2_MAX_FILES + 2 + CONFIG_EXT2_INODE_CACHE_SIZE)
 
 struct ext2_data {
 	struct ext2_superblock sblock; /* superblock */
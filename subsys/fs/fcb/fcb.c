@@ -167,6 +167,11 @@ int fcb_init(int f_area_id, struct fcb *fcbp)
 			break;
 		}
 	}
+#ifdef CONFIG_FCB_INDEX
+	if (rc == 0) {
+		rc = fcb_index_build(fcbp);
+	}
+#endif
 	k_mutex_init(&fcbp->f_mtx);
 	return rc;
 }
@@ -338,6 +343,34 @@ int fcb_offset_last_n(struct fcb *fcbp, uint8_t entries, struct fcb_entry *last_
 	return (i == 0) ? -ENOENT : 0;
 }
 
+int fcb_get_nth(struct fcb *fcbp, uint32_t n, struct fcb_entry *loc)
+{
+	int rc;
+
+	rc = k_mutex_lock(&fcbp->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	(void)memset(loc, 0, sizeof(*loc));
+#ifdef CONFIG_FCB_INDEX
+	if (fcbp->f_index != NULL) {
+		rc = fcb_index_seek(fcbp, &n, loc);
+	} else
+#endif
+	{
+		rc = fcb_getnext_nolock(fcbp, loc);
+	}
+
+	while (rc == 0 && n > 0U) {
+		rc = fcb_getnext_nolock(fcbp, loc);
+		n--;
+	}
+	k_mutex_unlock(&fcbp->f_mtx);
+
+	return (rc == -ENOTSUP) ? -ENOENT : rc;
+}
+
 /**
  * Clear fcb
  * @param fcb
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include <zephyr/fs/fcb.h>
+#include <zephyr/sys/crc.h>
 #include "fcb_priv.h"
 
 static struct flash_sector *
@@ -53,13 +54,43 @@ fcb_append_to_scratch(struct fcb *fcb)
 	fcb->f_active.fe_sector = sector;
 	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
 	fcb->f_active_id++;
+	fcb_index_reset(fcb, sector);
+	return 0;
+}
+
+/*
+ * Make room for len bytes in the active sector, moving to a new sector
+ * if needed. Called with the FCB locked.
+ */
+static int
+fcb_append_room(struct fcb *fcb, int len)
+{
+	struct flash_sector *sector;
+	int rc;
+
+	if (fcb->f_active.fe_elem_off + len <= fcb->f_active.fe_sector->fs_size) {
+		return 0;
+	}
+
+	sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
+	if (!sector || (sector->fs_size <
+		fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len)) {
+		return -ENOSPC;
+	}
+	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+	if (rc) {
+		return rc;
+	}
+	fcb->f_active.fe_sector = sector;
+	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+	fcb->f_active_id++;
+	fcb_index_reset(fcb, sector);
 	return 0;
 }
 
 int
 fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
-	struct flash_sector *sector;
 	struct fcb_entry *active;
 	int cnt;
 	int rc;
@@ -82,20 +113,9 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 		return -EINVAL;
 	}
 	active = &fcb->f_active;
-	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
-		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
-		if (!sector || (sector->fs_size <
-			fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len + cnt)) {
-			rc = -ENOSPC;
-			goto err;
-		}
-		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
-		if (rc) {
-			goto err;
-		}
-		fcb->f_active.fe_sector = sector;
-		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-		fcb->f_active_id++;
+	rc = fcb_append_room(fcb, len + cnt);
+	if (rc) {
+		goto err;
 	}
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
@@ -136,5 +156,127 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	if (rc) {
 		return -EIO;
 	}
+
+#ifdef CONFIG_FCB_INDEX
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+	fcb_index_add(fcb, loc);
+	k_mutex_unlock(&fcb->f_mtx);
+#endif
 	return 0;
 }
+
+/*
+ * Lay out an element in buf: length, data and end marker, each padded to
+ * the write alignment. Returns the size of the element in flash.
+ */
+static int
+fcb_batch_put(struct fcb *fcb, const struct fcb_batch_elem *elem, uint8_t *buf)
+{
+	uint8_t lenbuf[2];
+	uint8_t em;
+	int cnt;
+	int len_sz;
+	int data_sz;
+
+	cnt = fcb_put_len(fcb, lenbuf, elem->len);
+	len_sz = fcb_len_in_flash(fcb, cnt);
+	data_sz = fcb_len_in_flash(fcb, elem->len);
+
+	memset(buf, fcb->f_erase_value, len_sz + data_sz);
+	memcpy(buf, lenbuf, cnt);
+	memcpy(&buf[len_sz], elem->data, elem->len);
+
+#if defined(CONFIG_FCB_ALLOW_FIXED_ENDMARKER)
+	if (fcb->f_flags & FCB_FLAGS_CRC_DISABLED) {
+		em = FCB_FIXED_ENDMARKER;
+	} else
+#endif
+	{
+		em = crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, lenbuf, cnt);
+		em = crc8_ccitt(em, elem->data, elem->len);
+	}
+
+	/* As written by fcb_append_finish() */
+	memset(&buf[len_sz + data_sz], 0xFF, fcb_len_in_flash(fcb, FCB_CRC_SZ));
+	buf[len_sz + data_sz] = em;
+
+	return len_sz + data_sz + fcb_len_in_flash(fcb, FCB_CRC_SZ);
+}
+
+int
+fcb_append_batch(struct fcb *fcb, const struct fcb_batch_elem *elems, size_t cnt,
+		 uint8_t *buf, size_t buf_size)
+{
+	struct fcb_entry *active = &fcb->f_active;
+	struct fcb_entry loc;
+	size_t first = 0;
+	size_t used = 0;
+	size_t i;
+	int sz;
+	int rc;
+
+	for (i = 0; i < cnt; i++) {
+		if (elems[i].len > FCB_MAX_LEN ||
+		    fcb_len_in_flash(fcb, 2) + fcb_len_in_flash(fcb, elems[i].len) +
+		    fcb_len_in_flash(fcb, FCB_CRC_SZ) > buf_size) {
+			return -EINVAL;
+		}
+	}
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i <= cnt; i++) {
+		sz = 0;
+		if (i < cnt) {
+			sz = fcb_len_in_flash(fcb, (elems[i].len < 0x80) ? 1 : 2) +
+			     fcb_len_in_flash(fcb, elems[i].len) +
+			     fcb_len_in_flash(fcb, FCB_CRC_SZ);
+		}
+
+		/* Write what is laid out once the buffer or the sector is full */
+		if (used > 0 && (i == cnt || used + sz > buf_size ||
+				 active->fe_elem_off + used + sz > active->fe_sector->fs_size)) {
+			rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off,
+					     buf, used);
+			if (rc) {
+				rc = -EIO;
+				goto out;
+			}
+
+			loc.fe_sector = active->fe_sector;
+			loc.fe_elem_off = active->fe_elem_off;
+			for (; first < i; first++) {
+				loc.fe_data_len = elems[first].len;
+				fcb_index_add(fcb, &loc);
+				loc.fe_elem_off += fcb_len_in_flash(fcb,
+					(elems[first].len < 0x80) ? 1 : 2) +
+					fcb_len_in_flash(fcb, elems[first].len) +
+					fcb_len_in_flash(fcb, FCB_CRC_SZ);
+			}
+			active->fe_elem_off += used;
+			used = 0;
+		}
+
+		if (i == cnt) {
+			break;
+		}
+
+		if (used == 0) {
+			rc = fcb_append_room(fcb, sz);
+			if (rc) {
+				goto out;
+			}
+		}
+		used += fcb_batch_put(fcb, &elems[i], &buf[used]);
+	}
+
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+	return rc;
+}
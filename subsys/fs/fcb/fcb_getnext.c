@@ -45,6 +45,12 @@ fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc)
 {
 	int rc;
 
+#ifdef CONFIG_FCB_INDEX
+	if (fcb->f_index != NULL) {
+		return fcb_index_getnext(fcb, loc);
+	}
+#endif
+
 	if (loc->fe_sector == NULL) {
 		/*
 		 * Find the first one we have in flash.
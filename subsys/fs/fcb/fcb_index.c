@@ -0,0 +1,194 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/fs/fcb.h>
+#include "fcb_priv.h"
+
+/*
+ * RAM index of the valid elements of each sector. The index of a sector
+ * always holds all the valid elements up to its last entry, so elements
+ * that do not fit in it are found in flash going on from that entry.
+ */
+
+static struct fcb_sector_index *
+fcb_sector_index(struct fcb *fcbp, const struct flash_sector *sector)
+{
+	return &fcbp->f_index[sector - fcbp->f_sectors];
+}
+
+/* Position of the first indexed element past offset off */
+static uint16_t
+fcb_index_find(const struct fcb_sector_index *si, uint32_t off)
+{
+	uint16_t lo = 0U;
+	uint16_t hi = si->si_cnt;
+
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2U;
+
+		if (si->si_entries[mid].ie_elem_off <= off) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static void
+fcb_index_loc(struct fcb *fcbp, const struct fcb_index_entry *ie, struct fcb_entry *loc)
+{
+	loc->fe_elem_off = ie->ie_elem_off;
+	loc->fe_data_len = ie->ie_data_len;
+	/* Same length encoding as fcb_put_len() */
+	loc->fe_data_off = ie->ie_elem_off +
+			   fcb_len_in_flash(fcbp, (ie->ie_data_len < 0x80) ? 1 : 2);
+}
+
+void
+fcb_index_reset(struct fcb *fcbp, const struct flash_sector *sector)
+{
+	struct fcb_sector_index *si;
+
+	if (fcbp->f_index == NULL) {
+		return;
+	}
+
+	si = fcb_sector_index(fcbp, sector);
+	si->si_cnt = 0U;
+	si->si_overflow = false;
+}
+
+void
+fcb_index_add(struct fcb *fcbp, const struct fcb_entry *loc)
+{
+	struct fcb_sector_index *si;
+	uint16_t i;
+
+	if (fcbp->f_index == NULL) {
+		return;
+	}
+
+	si = fcb_sector_index(fcbp, loc->fe_sector);
+	i = fcb_index_find(si, loc->fe_elem_off);
+	if (i > 0U && si->si_entries[i - 1U].ie_elem_off == loc->fe_elem_off) {
+		return;
+	}
+
+	if (si->si_cnt == CONFIG_FCB_INDEX_SIZE) {
+		si->si_overflow = true;
+		if (i == si->si_cnt) {
+			return;
+		}
+		/* Finished out of order, the last entry is left to flash */
+		si->si_cnt--;
+	}
+
+	memmove(&si->si_entries[i + 1U], &si->si_entries[i],
+		(si->si_cnt - i) * sizeof(si->si_entries[0]));
+	si->si_entries[i].ie_elem_off = loc->fe_elem_off;
+	si->si_entries[i].ie_data_len = loc->fe_data_len;
+	si->si_cnt++;
+}
+
+int
+fcb_index_build(struct fcb *fcbp)
+{
+	struct flash_sector *sector;
+	struct fcb_entry loc;
+	int rc;
+	int i;
+
+	if (fcbp->f_index == NULL) {
+		return 0;
+	}
+
+	for (i = 0; i < fcbp->f_sector_cnt; i++) {
+		fcb_index_reset(fcbp, &fcbp->f_sectors[i]);
+	}
+
+	sector = fcbp->f_oldest;
+	while (1) {
+		loc.fe_sector = sector;
+		loc.fe_elem_off = fcb_len_in_flash(fcbp, sizeof(struct fcb_disk_area));
+		rc = fcb_elem_info(fcbp, &loc);
+		while (rc == 0 || rc == -EBADMSG) {
+			if (rc == 0) {
+				fcb_index_add(fcbp, &loc);
+			}
+			loc.fe_elem_off = loc.fe_data_off +
+			  fcb_len_in_flash(fcbp, loc.fe_data_len) +
+			  fcb_len_in_flash(fcbp, FCB_CRC_SZ);
+			rc = fcb_elem_info(fcbp, &loc);
+		}
+
+		/* Like fcb_getnext(), any other error ends the sector */
+		if (sector == fcbp->f_active.fe_sector) {
+			return 0;
+		}
+		sector = fcb_getnext_sector(fcbp, sector);
+	}
+}
+
+int
+fcb_index_getnext(struct fcb *fcbp, struct fcb_entry *loc)
+{
+	struct fcb_sector_index *si;
+	uint16_t i;
+
+	if (loc->fe_sector == NULL) {
+		loc->fe_sector = fcbp->f_oldest;
+		loc->fe_elem_off = 0U;
+	}
+
+	while (1) {
+		si = fcb_sector_index(fcbp, loc->fe_sector);
+		i = fcb_index_find(si, loc->fe_elem_off);
+		if (i < si->si_cnt) {
+			fcb_index_loc(fcbp, &si->si_entries[i], loc);
+			return 0;
+		}
+
+		/* loc is at or past the last indexed element here */
+		if (si->si_overflow && fcb_getnext_in_sector(fcbp, loc) == 0) {
+			return 0;
+		}
+
+		if (loc->fe_sector == fcbp->f_active.fe_sector) {
+			return -ENOTSUP;
+		}
+		loc->fe_sector = fcb_getnext_sector(fcbp, loc->fe_sector);
+		loc->fe_elem_off = 0U;
+	}
+}
+
+int
+fcb_index_seek(struct fcb *fcbp, uint32_t *n, struct fcb_entry *loc)
+{
+	struct flash_sector *sector = fcbp->f_oldest;
+	struct fcb_sector_index *si;
+	uint16_t i;
+
+	while (1) {
+		si = fcb_sector_index(fcbp, sector);
+		if (*n < si->si_cnt || si->si_overflow) {
+			/* Past an overflowing index, go on from its last entry */
+			i = MIN(*n, si->si_cnt - 1U);
+			loc->fe_sector = sector;
+			fcb_index_loc(fcbp, &si->si_entries[i], loc);
+			*n -= i;
+			return 0;
+		}
+		*n -= si->si_cnt;
+
+		if (sector == fcbp->f_active.fe_sector) {
+			return -ENOTSUP;
+		}
+		sector = fcb_getnext_sector(fcbp, sector);
+	}
+}
@@ -18,6 +18,7 @@ extern "C" {
 
 #define FCB_CRC_SZ	sizeof(uint8_t)
 #define FCB_TMP_BUF_SZ	32
+#define FCB_FIXED_ENDMARKER 0xab
 
 #define FCB_ID_GT(a, b) (((int16_t)(a) - (int16_t)(b)) > 0)
 
@@ -78,6 +79,22 @@ int fcb_elem_endmarker(struct fcb *fcbp, struct fcb_entry *loc, uint8_t *crc8p);
 int fcb_sector_hdr_init(struct fcb *fcbp, struct flash_sector *sector, uint16_t id);
 int fcb_sector_hdr_read(struct fcb *fcbp, struct flash_sector *sector, struct fcb_disk_area *fdap);
 
+#ifdef CONFIG_FCB_INDEX
+int fcb_index_build(struct fcb *fcbp);
+void fcb_index_reset(struct fcb *fcbp, const struct flash_sector *sector);
+void fcb_index_add(struct fcb *fcbp, const struct fcb_entry *loc);
+int fcb_index_getnext(struct fcb *fcbp, struct fcb_entry *loc);
+int fcb_index_seek(struct fcb *fcbp, uint32_t *n, struct fcb_entry *loc);
+#else
+static inline void fcb_index_reset(struct fcb *fcbp, const struct flash_sector *sector)
+{
+}
+
+static inline void fcb_index_add(struct fcb *fcbp, const struct fcb_entry *loc)
+{
+}
+#endif /* CONFIG_FCB_INDEX */
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <ctype.h>
 #include <stdio.h>
 #include <string.h>
 #include <zephyr/types.h>
@@ -127,12 +128,221 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 	return 0;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_LOOKUP_CACHE
+
+/*
+ * Results of path lookups, one entry per hash bucket.  The hash ignores
+ * case so that the paths a case insensitive file system resolves to the
+ * same entry share a bucket and are invalidated together.
+ */
+struct lookup_entry {
+	const struct fs_mount_t *mp;
+	uint32_t hash;
+	int rc;
+	enum fs_dir_entry_type type;
+	size_t size;
+	char path[CONFIG_FILE_SYSTEM_LOOKUP_CACHE_PATH_LEN];
+};
+
+static struct lookup_entry lookup_cache[CONFIG_FILE_SYSTEM_LOOKUP_CACHE_SIZE];
+
+/* Bumped on each invalidation, so lookups racing with it are not stored */
+static uint32_t lookup_gen;
+
+static K_MUTEX_DEFINE(lookup_mutex);
+
+/*
+ * Only paths in canonical form are cached, other spellings of the same
+ * path would not be invalidated with it.
+ */
+static bool lookup_cacheable(const char *path)
+{
+	size_t len = strlen(path);
+
+	return (len < CONFIG_FILE_SYSTEM_LOOKUP_CACHE_PATH_LEN) &&
+	       (path[len - 1] != '/') &&
+	       (strstr(path, "//") == NULL) && (strstr(path, "/.") == NULL);
+}
+
+static uint32_t lookup_hash(const char *path)
+{
+	uint32_t hash = 5381;
+
+	while (*path != '\0') {
+		hash = (hash * 33) + tolower((unsigned char)*path++);
+	}
+
+	return hash;
+}
+
+static void lookup_cache_invalidate_hash(const struct fs_mount_t *mp,
+					 uint32_t hash)
+{
+	struct lookup_entry *ep =
+		&lookup_cache[hash % CONFIG_FILE_SYSTEM_LOOKUP_CACHE_SIZE];
+
+	k_mutex_lock(&lookup_mutex, K_FOREVER);
+	if ((ep->mp == mp) && (ep->hash == hash)) {
+		ep->mp = NULL;
+	}
+	lookup_gen++;
+	k_mutex_unlock(&lookup_mutex);
+}
+
+/* Drops all entries of the mount point, or all entries if mp is NULL */
+static void lookup_cache_invalidate_mount(const struct fs_mount_t *mp)
+{
+	k_mutex_lock(&lookup_mutex, K_FOREVER);
+	for (size_t i = 0; i < ARRAY_SIZE(lookup_cache); ++i) {
+		if ((mp == NULL) || (lookup_cache[i].mp == mp)) {
+			lookup_cache[i].mp = NULL;
+		}
+	}
+	lookup_gen++;
+	k_mutex_unlock(&lookup_mutex);
+}
+
+static void lookup_cache_invalidate(const struct fs_mount_t *mp,
+				    const char *path)
+{
+	if (lookup_cacheable(path)) {
+		lookup_cache_invalidate_hash(mp, lookup_hash(path));
+	} else {
+		lookup_cache_invalidate_mount(mp);
+	}
+}
+
+/* Returns true on hit, with the result of the lookup in rc and entry */
+static bool lookup_cache_get(const struct fs_mount_t *mp, const char *path,
+			     int *rc, struct fs_dirent *entry)
+{
+	struct lookup_entry *ep;
+	uint32_t hash;
+	bool hit = false;
+
+	if (!lookup_cacheable(path)) {
+		return false;
+	}
+
+	hash = lookup_hash(path);
+	ep = &lookup_cache[hash % CONFIG_FILE_SYSTEM_LOOKUP_CACHE_SIZE];
+
+	k_mutex_lock(&lookup_mutex, K_FOREVER);
+	if ((ep->mp == mp) && (ep->hash == hash) &&
+	    (strcmp(ep->path, path) == 0)) {
+		hit = true;
+		*rc = ep->rc;
+		if ((ep->rc == 0) && (entry != NULL)) {
+			entry->type = ep->type;
+			entry->size = ep->size;
+			strcpy(entry->name, strrchr(path, '/') + 1);
+		}
+	}
+	k_mutex_unlock(&lookup_mutex);
+
+	return hit;
+}
+
+static uint32_t lookup_cache_gen(void)
+{
+	uint32_t gen;
+
+	k_mutex_lock(&lookup_mutex, K_FOREVER);
+	gen = lookup_gen;
+	k_mutex_unlock(&lookup_mutex);
+
+	return gen;
+}
+
+/*
+ * Stores the result of a lookup started at generation gen.  Entries are
+ * returned with the name taken from the path, hence a file system that
+ * reported another name (e.g. in other case) is not cached.
+ */
+static void lookup_cache_put(const struct fs_mount_t *mp, const char *path,
+			     uint32_t gen, int rc,
+			     const struct fs_dirent *entry)
+{
+	struct lookup_entry *ep;
+	uint32_t hash;
+
+	if (!lookup_cacheable(path) ||
+	    ((rc == 0) && (strncmp(entry->name, strrchr(path, '/') + 1,
+				   sizeof(entry->name)) != 0))) {
+		return;
+	}
+
+	hash = lookup_hash(path);
+	ep = &lookup_cache[hash % CONFIG_FILE_SYSTEM_LOOKUP_CACHE_SIZE];
+
+	k_mutex_lock(&lookup_mutex, K_FOREVER);
+	if (gen == lookup_gen) {
+		ep->mp = mp;
+		ep->hash = hash;
+		ep->rc = rc;
+		if (rc == 0) {
+			ep->type = entry->type;
+			ep->size = entry->size;
+		}
+		strcpy(ep->path, path);
+	}
+	k_mutex_unlock(&lookup_mutex);
+}
+
+static void lookup_cache_opened(struct fs_file_t *zfp, const char *path)
+{
+	zfp->lookup_hash = lookup_cacheable(path) ? lookup_hash(path) : 0;
+
+	if ((zfp->flags & (FS_O_CREATE | FS_O_WRITE)) != 0) {
+		lookup_cache_invalidate_hash(zfp->mp, zfp->lookup_hash);
+	}
+}
+
+/* Size of a file changes with writes through it */
+static void lookup_cache_file_changed(const struct fs_file_t *zfp)
+{
+	if ((zfp->flags & FS_O_WRITE) == 0) {
+		return;
+	}
+
+	if (zfp->lookup_hash != 0) {
+		lookup_cache_invalidate_hash(zfp->mp, zfp->lookup_hash);
+	} else {
+		lookup_cache_invalidate_mount(zfp->mp);
+	}
+}
+
+#else
+
+static inline void lookup_cache_invalidate_mount(const struct fs_mount_t *mp) {}
+static inline void lookup_cache_invalidate(const struct fs_mount_t *mp,
+					   const char *path) {}
+static inline bool lookup_cache_get(const struct fs_mount_t *mp,
+				    const char *path, int *rc,
+				    struct fs_dirent *entry)
+{
+	return false;
+}
+static inline uint32_t lookup_cache_gen(void)
+{
+	return 0;
+}
+static inline void lookup_cache_put(const struct fs_mount_t *mp,
+				    const char *path, uint32_t gen, int rc,
+				    const struct fs_dirent *entry) {}
+static inline void lookup_cache_opened(struct fs_file_t *zfp,
+				       const char *path) {}
+static inline void lookup_cache_file_changed(const struct fs_file_t *zfp) {}
+
+#endif /* CONFIG_FILE_SYSTEM_LOOKUP_CACHE */
+
 /* File operations */
 int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 {
 	struct fs_mount_t *mp;
 	int rc = -EINVAL;
 	bool truncate_file = false;
+	uint32_t gen;
 
 	if ((file_name == NULL) ||
 			(strlen(file_name) <= 1) || (file_name[0] != '/')) {
@@ -172,20 +382,32 @@ int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 		truncate_file = true;
 	}
 
+	/* A file known to be missing can't be opened without creating it */
+	if (((flags & FS_O_CREATE) == 0) &&
+	    lookup_cache_get(mp, file_name, &rc, NULL) && (rc < 0)) {
+		return rc;
+	}
+
+	gen = lookup_cache_gen();
 	zfp->mp = mp;
 	rc = mp->fs->open(zfp, file_name, flags);
 	if (rc < 0) {
 		LOG_ERR("file open error (%d)", rc);
 		zfp->mp = NULL;
+		if ((rc == -ENOENT) && ((flags & FS_O_CREATE) == 0)) {
+			lookup_cache_put(mp, file_name, gen, rc, NULL);
+		}
 		return rc;
 	}
 
 	/* Copy flags to zfp for use with other fs_ API calls */
 	zfp->flags = flags;
+	lookup_cache_opened(zfp, file_name);
 
 	if (truncate_file) {
 		/* Truncate the opened file to 0 length */
 		rc = mp->fs->truncate(zfp, 0);
+		lookup_cache_file_changed(zfp);
 		if (rc < 0) {
 			LOG_ERR("file truncation failed (%d)", rc);
 			zfp->mp = NULL;
@@ -209,6 +431,7 @@ int fs_close(struct fs_file_t *zfp)
 	}
 
 	rc = zfp->mp->fs->close(zfp);
+	lookup_cache_file_changed(zfp);
 	if (rc < 0) {
 		LOG_ERR("file close error (%d)", rc);
 		return rc;
@@ -252,6 +475,7 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	}
 
 	rc = zfp->mp->fs->write(zfp, ptr, size);
+	lookup_cache_file_changed(zfp);
 	if (rc < 0) {
 		LOG_ERR("file write error (%d)", rc);
 	}
@@ -312,6 +536,7 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 	}
 
 	rc = zfp->mp->fs->truncate(zfp, length);
+	lookup_cache_file_changed(zfp);
 	if (rc < 0) {
 		LOG_ERR("file truncate error (%d)", rc);
 	}
@@ -332,6 +557,7 @@ int fs_sync(struct fs_file_t *zfp)
 	}
 
 	rc = zfp->mp->fs->sync(zfp);
+	lookup_cache_file_changed(zfp);
 	if (rc < 0) {
 		LOG_ERR("file sync error (%d)", rc);
 	}
@@ -339,6 +565,131 @@ int fs_sync(struct fs_file_t *zfp)
 	return rc;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_MMAP
+
+#if CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE > 0
+
+K_HEAP_DEFINE(fs_mmap_heap, CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE);
+
+/* Reads the range into a heap buffer, the file position is restored */
+static int fs_mmap_copy(struct fs_file_t *zfp, off_t offset, size_t len,
+			struct fs_mapping *map)
+{
+	const struct fs_file_system_t *fs = zfp->mp->fs;
+	uint8_t *buf;
+	size_t done = 0;
+	ssize_t rd;
+	off_t pos;
+	int rc;
+
+	CHECKIF((fs->read == NULL) || (fs->lseek == NULL) ||
+		(fs->tell == NULL)) {
+		return -ENOTSUP;
+	}
+
+	buf = k_heap_alloc(&fs_mmap_heap, len, K_NO_WAIT);
+	if (buf == NULL) {
+		return -ENOMEM;
+	}
+
+	pos = fs->tell(zfp);
+	if (pos < 0) {
+		rc = (int)pos;
+		goto out;
+	}
+
+	rc = fs->lseek(zfp, offset, FS_SEEK_SET);
+	if (rc < 0) {
+		goto out;
+	}
+
+	while (done < len) {
+		rd = fs->read(zfp, buf + done, len - done);
+		if (rd <= 0) {
+			/* Range goes beyond the end of the file */
+			rc = (rd < 0) ? (int)rd : -EINVAL;
+			break;
+		}
+		done += rd;
+	}
+
+	if (fs->lseek(zfp, pos, FS_SEEK_SET) < 0) {
+		LOG_WRN("failed to restore file position");
+	}
+
+out:
+	if (rc < 0) {
+		k_heap_free(&fs_mmap_heap, buf);
+		return rc;
+	}
+
+	map->addr = buf;
+	map->len = len;
+	map->copy = true;
+
+	return 0;
+}
+
+#endif /* CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE > 0 */
+
+int fs_mmap(struct fs_file_t *zfp, off_t offset, size_t len,
+	    struct fs_mapping *map)
+{
+	const void *addr;
+	int rc = -ENOTSUP;
+
+	if ((zfp->mp == NULL) || ((zfp->flags & FS_O_READ) == 0)) {
+		return -EBADF;
+	}
+
+	if ((offset < 0) || (len == 0)) {
+		return -EINVAL;
+	}
+
+	if (zfp->mp->fs->mmap != NULL) {
+		rc = zfp->mp->fs->mmap(zfp, offset, len, &addr);
+		if (rc == 0) {
+			map->addr = addr;
+			map->len = len;
+			map->copy = false;
+			return 0;
+		}
+		if (rc != -ENOTSUP) {
+			LOG_ERR("file mmap error (%d)", rc);
+			return rc;
+		}
+	}
+
+#if CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE > 0
+	rc = fs_mmap_copy(zfp, offset, len, map);
+	if (rc < 0) {
+		LOG_ERR("file mmap copy error (%d)", rc);
+	}
+#endif
+
+	return rc;
+}
+
+int fs_munmap(struct fs_mapping *map)
+{
+	if (map->addr == NULL) {
+		return -EINVAL;
+	}
+
+#if CONFIG_FILE_SYSTEM_MMAP_HEAP_SIZE > 0
+	if (map->copy) {
+		k_heap_free(&fs_mmap_heap, (void *)map->addr);
+	}
+#endif
+
+	map->addr = NULL;
+	map->len = 0;
+
+	return 0;
+}
+
+#endif /* CONFIG_FILE_SYSTEM_MMAP */
+
 /* Directory operations */
 int fs_opendir(struct fs_dir_t *zdp, const char *abs_path)
 {
@@ -522,6 +873,7 @@ int fs_mkdir(const char *abs_path)
 	}
 
 	rc = mp->fs->mkdir(mp, abs_path);
+	lookup_cache_invalidate(mp, abs_path);
 	if (rc < 0) {
 		LOG_ERR("failed to create directory (%d)", rc);
 	}
@@ -555,6 +907,7 @@ int fs_unlink(const char *abs_path)
 	}
 
 	rc = mp->fs->unlink(mp, abs_path);
+	lookup_cache_invalidate(mp, abs_path);
 	if (rc < 0) {
 		LOG_ERR("failed to unlink path (%d)", rc);
 	}
@@ -594,7 +947,9 @@ int fs_rename(const char *from, const char *to)
 		return -ENOTSUP;
 	}
 
+	/* Paths of everything below a renamed directory change too */
 	rc = mp->fs->rename(mp, from, to);
+	lookup_cache_invalidate_mount(mp);
 	if (rc < 0) {
 		LOG_ERR("failed to rename file or dir (%d)", rc);
 	}
@@ -606,6 +961,7 @@ int fs_stat(const char *abs_path, struct fs_dirent *entry)
 {
 	struct fs_mount_t *mp;
 	int rc = -EINVAL;
+	uint32_t gen;
 
 	if ((abs_path == NULL) ||
 			(strlen(abs_path) <= 1) || (abs_path[0] != '/')) {
@@ -623,11 +979,19 @@ int fs_stat(const char *abs_path, struct fs_dirent *entry)
 		return -ENOTSUP;
 	}
 
+	if ((entry != NULL) && lookup_cache_get(mp, abs_path, &rc, entry)) {
+		return rc;
+	}
+
+	gen = lookup_cache_gen();
 	rc = mp->fs->stat(mp, abs_path, entry);
 	if (rc == -ENOENT) {
 		/* File doesn't exist, which is a valid stat response */
+		lookup_cache_put(mp, abs_path, gen, rc, entry);
 	} else if (rc < 0) {
 		LOG_ERR("failed get file or dir stat (%d)", rc);
+	} else {
+		lookup_cache_put(mp, abs_path, gen, rc, entry);
 	}
 	return rc;
 }
@@ -740,6 +1104,7 @@ int fs_mount(struct fs_mount_t *mp)
 	/* Update mount point data and append it to the list */
 	mp->mountp_len = len;
 	mp->fs = fs;
+	lookup_cache_invalidate_mount(mp);
 
 	sys_dlist_append(&fs_mnt_list, &mp->node);
 	LOG_DBG("fs mounted at %s", mp->mnt_point);
@@ -774,6 +1139,7 @@ int fs_mkfs(int fs_type, uintptr_t dev_id, void *cfg, int flags)
 	}
 
 	rc = fs->mkfs(dev_id, cfg, flags);
+	lookup_cache_invalidate_mount(NULL);
 	if (rc < 0) {
 		LOG_ERR("mkfs error (%d)", rc);
 		goto mount_err;
@@ -815,6 +1181,7 @@ int fs_unmount(struct fs_mount_t *mp)
 
 	/* remove mount node from the list */
 	sys_dlist_remove(&mp->node);
+	lookup_cache_invalidate_mount(mp);
 	LOG_DBG("fs unmounted from %s", mp->mnt_point);
 
 unmount_err:
@@ -370,8 +370,50 @@ static int littlefs_rename(struct fs_mount_t *mountp, const char *from,
 	return lfs_to_errno(ret);
 }
 
+#if CONFIG_FS_LITTLEFS_IO_CHUNK_SIZE > 0
+/*
+ * Releases the mount lock between chunks so that waiting threads get
+ * to run.  A failure after some progress reports the progress.
+ */
+static ssize_t littlefs_file_io(struct fs_file_t *fp, void *ptr, size_t len, bool write)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	uint8_t *buf = ptr;
+	size_t done = 0;
+	size_t chunk;
+	lfs_ssize_t ret;
+
+	while (done < len) {
+		chunk = MIN(len - done, CONFIG_FS_LITTLEFS_IO_CHUNK_SIZE);
+
+		fs_lock(fs);
+		if (write) {
+			ret = lfs_file_write(&fs->lfs, LFS_FILEP(fp), buf + done, chunk);
+		} else {
+			ret = lfs_file_read(&fs->lfs, LFS_FILEP(fp), buf + done, chunk);
+		}
+		fs_unlock(fs);
+
+		if (ret < 0) {
+			return (done > 0) ? (ssize_t)done : lfs_to_errno(ret);
+		}
+
+		done += ret;
+		if (ret < chunk) {
+			/* End of file, or out of space */
+			break;
+		}
+	}
+
+	return done;
+}
+#endif /* CONFIG_FS_LITTLEFS_IO_CHUNK_SIZE > 0 */
+
 static ssize_t littlefs_read(struct fs_file_t *fp, void *ptr, size_t len)
 {
+#if CONFIG_FS_LITTLEFS_IO_CHUNK_SIZE > 0
+	return littlefs_file_io(fp, ptr, len, false);
+#else
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
 	fs_lock(fs);
@@ -380,10 +422,14 @@ static ssize_t littlefs_read(struct fs_file_t *fp, void *ptr, size_t len)
 
 	fs_unlock(fs);
 	return lfs_to_errno(ret);
+#endif
 }
 
 static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 {
+#if CONFIG_FS_LITTLEFS_IO_CHUNK_SIZE > 0
+	return littlefs_file_io(fp, (void *)ptr, len, true);
+#else
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
 	fs_lock(fs);
@@ -392,6 +438,7 @@ static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 
 	fs_unlock(fs);
 	return lfs_to_errno(ret);
+#endif
 }
 
 BUILD_ASSERT((FS_SEEK_SET == LFS_SEEK_SET)
@@ -891,6 +938,16 @@ static int littlefs_init_cfg(struct fs_littlefs *fs, int flags)
 		(uint32_t)FS_LITTLEFS_DISK_VERSION_MINOR_GET(disk_version));
 #endif /* CONFIG_FS_LITTLEFS_DISK_VERSION */
 
+	if (lcp->metadata_max == 0) {
+		lcp->metadata_max = CONFIG_FS_LITTLEFS_METADATA_MAX;
+	}
+
+	if (lcp->metadata_max > block_size) {
+		LOG_WRN("Metadata size limit %u exceeds the block size, ignored",
+			lcp->metadata_max);
+		lcp->metadata_max = 0;
+	}
+
 	lcp->block_size = block_size;
 	lcp->block_count = block_count;
 	lcp->block_cycles = block_cycles;
@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/nvs.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "nvs_priv.h"
 
@@ -36,14 +37,150 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
-static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+/* Address to start the search of the most recent ATE of id from */
+static inline uint32_t nvs_lookup_get(struct nvs_fs *fs, uint16_t id)
+{
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+}
+
+/* Record addr as the most recent ATE of id, if newer or nothing is recorded yet */
+static inline void nvs_lookup_set(struct nvs_fs *fs, uint16_t id, uint32_t addr, bool newer)
+{
+	uint32_t *cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (newer || (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR)) {
+		*cache_entry = addr;
+	}
+}
+
+static inline void nvs_lookup_clear(struct nvs_fs *fs)
+{
+	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+}
+
+/* Make every lookup search from the end of the file system */
+static inline void nvs_lookup_walk_all(struct nvs_fs *fs)
+{
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = fs->ate_wra;
+	}
+}
+
+static void nvs_lookup_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	uint32_t *cache_entry = fs->lookup_cache;
+	uint32_t *const cache_end = &fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+	for (; cache_entry < cache_end; ++cache_entry) {
+		if ((*cache_entry >> ADDR_SECT_SHIFT) == sector) {
+			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+
+#endif /* CONFIG_NVS_LOOKUP_CACHE */
+
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+
+/* Position of id in the index, or the one it would be inserted at */
+static size_t nvs_lookup_index_pos(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t lo = 0U;
+	size_t hi = fs->lookup_index_count;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2U;
+
+		if (fs->lookup_index_id[mid] < id) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Address of the most recent ATE of id, which is then the first one the
+ * search reads.
+ */
+static uint32_t nvs_lookup_get(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_lookup_index_pos(fs, id);
+
+	if ((pos < fs->lookup_index_count) && (fs->lookup_index_id[pos] == id)) {
+		return fs->lookup_index_addr[pos];
+	}
+
+	/* IDs which did not fit in the index can only be found by walking */
+	return fs->lookup_index_full ? fs->ate_wra : NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static void nvs_lookup_set(struct nvs_fs *fs, uint16_t id, uint32_t addr, bool newer)
+{
+	size_t pos = nvs_lookup_index_pos(fs, id);
+	size_t count = fs->lookup_index_count;
+
+	if ((pos < count) && (fs->lookup_index_id[pos] == id)) {
+		if (newer) {
+			fs->lookup_index_addr[pos] = addr;
+		}
+		return;
+	}
+
+	if (count == CONFIG_NVS_LOOKUP_INDEX_SIZE) {
+		fs->lookup_index_full = true;
+		return;
+	}
+
+	memmove(&fs->lookup_index_id[pos + 1], &fs->lookup_index_id[pos],
+		(count - pos) * sizeof(fs->lookup_index_id[0]));
+	memmove(&fs->lookup_index_addr[pos + 1], &fs->lookup_index_addr[pos],
+		(count - pos) * sizeof(fs->lookup_index_addr[0]));
+	fs->lookup_index_id[pos] = id;
+	fs->lookup_index_addr[pos] = addr;
+	fs->lookup_index_count++;
+}
+
+static inline void nvs_lookup_clear(struct nvs_fs *fs)
+{
+	fs->lookup_index_count = 0U;
+	fs->lookup_index_full = false;
+}
+
+static inline void nvs_lookup_walk_all(struct nvs_fs *fs)
+{
+	fs->lookup_index_count = 0U;
+	fs->lookup_index_full = true;
+}
+
+static void nvs_lookup_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t n = 0U;
+
+	for (size_t i = 0U; i < fs->lookup_index_count; i++) {
+		if ((fs->lookup_index_addr[i] >> ADDR_SECT_SHIFT) == sector) {
+			continue;
+		}
+		fs->lookup_index_id[n] = fs->lookup_index_id[i];
+		fs->lookup_index_addr[n] = fs->lookup_index_addr[i];
+		n++;
+	}
+
+	fs->lookup_index_count = n;
+}
+
+#endif /* CONFIG_NVS_LOOKUP_INDEX */
+
+#ifdef CONFIG_NVS_LOOKUP
+
+static int nvs_lookup_rebuild(struct nvs_fs *fs)
 {
 	int rc;
 	uint32_t addr, ate_addr;
-	uint32_t *cache_entry;
 	struct nvs_ate ate;
 
-	memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	nvs_lookup_clear(fs);
 	addr = fs->ate_wra;
 
 	while (true) {
@@ -55,11 +192,9 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 			return rc;
 		}
 
-		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
-
-		if (ate.id != 0xFFFF && *cache_entry == NVS_LOOKUP_CACHE_NO_ADDR &&
-		    nvs_ate_valid(fs, &ate)) {
-			*cache_entry = ate_addr;
+		/* The walk goes from the most recent ATE to the oldest one */
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate)) {
+			nvs_lookup_set(fs, ate.id, ate_addr, false);
 		}
 
 		if (addr == fs->ate_wra) {
@@ -70,19 +205,7 @@ static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
 	return 0;
 }
 
-static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
-{
-	uint32_t *cache_entry = fs->lookup_cache;
-	uint32_t *const cache_end = &fs->lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
-
-	for (; cache_entry < cache_end; ++cache_entry) {
-		if ((*cache_entry >> ADDR_SECT_SHIFT) == sector) {
-			*cache_entry = NVS_LOOKUP_CACHE_NO_ADDR;
-		}
-	}
-}
-
-#endif /* CONFIG_NVS_LOOKUP_CACHE */
+#endif /* CONFIG_NVS_LOOKUP */
 
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
@@ -163,10 +286,10 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	/* 0xFFFF is a special-purpose identifier. Exclude it from the cache */
+#ifdef CONFIG_NVS_LOOKUP
+	/* 0xFFFF is a special-purpose identifier. Exclude it from the lookup */
 	if (entry->id != 0xFFFF) {
-		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+		nvs_lookup_set(fs, entry->id, fs->ate_wra, true);
 	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -341,8 +464,8 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	LOG_DBG("Erasing flash at %lx, len %d", (long int) offset,
 		fs->sector_size);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#ifdef CONFIG_NVS_LOOKUP
+	nvs_lookup_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_flatten(fs->flash_device, offset, fs->sector_size);
 
@@ -603,6 +726,11 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 	fs->data_wra = fs->ate_wra & ADDR_SECT_MASK;
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	/* Only the sector being left was skipped by the background gc */
+	fs->gc_skip_sector = NVS_GC_NO_SECTOR;
+#endif
+
 	return 0;
 }
 
@@ -673,8 +801,8 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
+#ifdef CONFIG_NVS_LOOKUP
+		wlk_addr = nvs_lookup_get(fs, gc_ate.id);
 
 		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
@@ -745,6 +873,82 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+
+static K_KERNEL_STACK_DEFINE(nvs_gc_stack, CONFIG_NVS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q nvs_gc_work_q;
+
+static bool nvs_gc_needed(struct nvs_fs *fs)
+{
+	size_t threshold = (size_t)fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100U;
+
+	return ((fs->ate_wra - fs->data_wra) < threshold) &&
+	       ((fs->ate_wra >> ADDR_SECT_SHIFT) != fs->gc_skip_sector);
+}
+
+/* Called with nvs_lock held */
+static void nvs_gc_trigger(struct nvs_fs *fs)
+{
+	if (nvs_gc_needed(fs)) {
+		(void)k_work_submit_to_queue(&nvs_gc_work_q, &fs->gc_work);
+	}
+}
+
+/*
+ * Moves to the next sector ahead of time, doing the garbage collection a
+ * writer would otherwise do inline once the active sector is full.  This is
+ * a whole sector at a time: releasing the lock in the middle would let
+ * writers add entries to a sector that the startup recovery of an
+ * interrupted garbage collection erases.
+ */
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	if (!fs->ready || !nvs_gc_needed(fs)) {
+		goto end;
+	}
+
+	LOG_DBG("Background gc of sector %d", fs->ate_wra >> ADDR_SECT_SHIFT);
+
+	rc = nvs_sector_close(fs);
+	if (!rc) {
+		rc = nvs_gc(fs);
+	}
+	if (rc) {
+		LOG_ERR("Background gc failed: %d", rc);
+		goto end;
+	}
+
+	/* The live data alone fills the new sector past the threshold, leave
+	 * the rest of it to the writers instead of moving it around again.
+	 */
+	if (nvs_gc_needed(fs)) {
+		fs->gc_skip_sector = fs->ate_wra >> ADDR_SECT_SHIFT;
+	}
+
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+}
+
+static int nvs_gc_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "nvs_gc"};
+
+	k_work_queue_start(&nvs_gc_work_q, nvs_gc_stack,
+			   K_KERNEL_STACK_SIZEOF(nvs_gc_stack),
+			   CONFIG_NVS_BACKGROUND_GC_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(nvs_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
@@ -917,15 +1121,13 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef CONFIG_NVS_LOOKUP
 		/**
 		 * At this point, the lookup cache wasn't built but the gc function need to use it.
 		 * So, temporarily, we set the lookup cache to the end of the fs.
 		 * The cache will be rebuilt afterwards
 		 **/
-		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
-			fs->lookup_cache[i] = fs->ate_wra;
-		}
+		nvs_lookup_walk_all(fs);
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -962,9 +1164,9 @@ static int nvs_startup(struct nvs_fs *fs)
 
 end:
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef CONFIG_NVS_LOOKUP
 	if (!rc) {
-		rc = nvs_lookup_cache_rebuild(fs);
+		rc = nvs_lookup_rebuild(fs);
 	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
@@ -989,6 +1191,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -1009,6 +1217,17 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* Remounting, the work item may still be queued */
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+	fs->gc_skip_sector = NVS_GC_NO_SECTOR;
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1050,6 +1269,12 @@ int nvs_mount(struct nvs_fs *fs)
 	/* nvs is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	nvs_gc_trigger(fs);
+	k_mutex_unlock(&fs->nvs_lock);
+#endif
+
 	LOG_INF("%d Sectors of %d bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %d, %x",
 		(fs->ate_wra >> ADDR_SECT_SHIFT),
@@ -1061,37 +1286,19 @@ int nvs_mount(struct nvs_fs *fs)
 	return 0;
 }
 
-ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+/* Tells whether the latest entry with id already holds data: returns 1 if
+ * so, 0 if the entry has to be written and a negative value on error.
+ */
+static int nvs_entry_stored(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 {
-	int rc, gc_count;
-	size_t ate_size, data_size;
+	int rc;
 	struct nvs_ate wlk_ate;
 	uint32_t wlk_addr, rd_addr;
-	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
 	bool prev_found = false;
 
-	if (!fs->ready) {
-		LOG_ERR("NVS not initialized");
-		return -EACCES;
-	}
-
-	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
-	data_size = nvs_al_size(fs, len);
-
-	/* The maximum data size is sector size - 4 ate
-	 * where: 1 ate for data, 1 ate for sector close, 1 ate for gc done,
-	 * and 1 ate to always allow a delete.
-	 * Also take into account the data CRC that is appended at the end of the data field,
-	 * if any.
-	 */
-	if ((len > (fs->sector_size - 4 * ate_size - NVS_DATA_CRC_SIZE)) ||
-	    ((len > 0) && (data == NULL))) {
-		return -EINVAL;
-	}
-
 	/* find latest entry with same id */
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#ifdef CONFIG_NVS_LOOKUP
+	wlk_addr = nvs_lookup_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
@@ -1116,7 +1323,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#ifdef CONFIG_NVS_LOOKUP
 no_cached_entry:
 #endif
 
@@ -1131,26 +1338,59 @@ no_cached_entry:
 				/* skip delete entry as it is already the
 				 * last one
 				 */
-				return 0;
+				return 1;
 			}
 		} else if (len + NVS_DATA_CRC_SIZE == wlk_ate.len) {
 			/* do not try to compare if lengths are not equal */
-			/* compare the data and if equal return 0 */
+			/* compare the data and if equal return 1 */
 			/* note: data CRC is not taken into account here, as it has not yet been
 			 * appended to the data buffer
 			 */
 			rc = nvs_flash_block_cmp(fs, rd_addr, data, len);
 			if (rc <= 0) {
-				return rc;
+				return (rc < 0) ? rc : 1;
 			}
 		}
 	} else {
 		/* skip delete entry for non-existing entry */
 		if (len == 0) {
-			return 0;
+			return 1;
 		}
 	}
 
+	return 0;
+}
+
+ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+{
+	int rc, gc_count;
+	size_t ate_size, data_size;
+	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	data_size = nvs_al_size(fs, len);
+
+	/* The maximum data size is sector size - 4 ate
+	 * where: 1 ate for data, 1 ate for sector close, 1 ate for gc done,
+	 * and 1 ate to always allow a delete.
+	 * Also take into account the data CRC that is appended at the end of the data field,
+	 * if any.
+	 */
+	if ((len > (fs->sector_size - 4 * ate_size - NVS_DATA_CRC_SIZE)) ||
+	    ((len > 0) && (data == NULL))) {
+		return -EINVAL;
+	}
+
+	rc = nvs_entry_stored(fs, id, data, len);
+	if (rc) {
+		return (rc < 0) ? rc : 0;
+	}
+
 	/* calculate required space if the entry contains data */
 	if (data_size) {
 		/* Leave space for delete ate */
@@ -1190,6 +1430,9 @@ no_cached_entry:
 		}
 		gc_count++;
 	}
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	nvs_gc_trigger(fs);
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
@@ -1201,6 +1444,226 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+/*
+ * The staging buffer of a batch is laid out like a sector: the data of the
+ * entries, each aligned to the write block size, from the start and their
+ * allocation entries from the end, the first entry last.  The data offsets
+ * in the allocation entries are relative to the start of the buffer until
+ * the commit.
+ */
+static uint8_t *nvs_batch_ate(struct nvs_batch *batch, uint16_t idx)
+{
+	size_t ate_size = nvs_al_size(batch->fs, sizeof(struct nvs_ate));
+
+	return batch->buf + batch->buf_size - (idx + 1U) * ate_size;
+}
+
+static bool nvs_batch_has_id(struct nvs_batch *batch, uint16_t id)
+{
+	struct nvs_ate entry;
+
+	for (uint16_t i = 0U; i < batch->count; i++) {
+		memcpy(&entry, nvs_batch_ate(batch, i), sizeof(entry));
+		if (entry.id == id) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int nvs_batch_begin(struct nvs_fs *fs, struct nvs_batch *batch, void *buf, size_t size)
+{
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	if ((batch == NULL) || (buf == NULL)) {
+		return -EINVAL;
+	}
+
+	batch->fs = fs;
+	batch->buf = buf;
+	batch->buf_size = size;
+	batch->data_size = 0U;
+	batch->count = 0U;
+
+	return 0;
+}
+
+ssize_t nvs_batch_add(struct nvs_batch *batch, uint16_t id, const void *data, size_t len)
+{
+	struct nvs_fs *fs = batch->fs;
+	struct nvs_ate entry;
+	size_t ate_size, data_size, used;
+	uint8_t *data8;
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	/* Same limit as nvs_write() */
+	if ((len > (fs->sector_size - 4 * ate_size - NVS_DATA_CRC_SIZE)) ||
+	    ((len > 0) && (data == NULL))) {
+		return -EINVAL;
+	}
+
+	/* An entry already in the batch is overwritten whatever is in flash */
+	if (!nvs_batch_has_id(batch, id)) {
+		rc = nvs_entry_stored(fs, id, data, len);
+		if (rc) {
+			return (rc < 0) ? rc : 0;
+		}
+	}
+
+	data_size = (len > 0) ? nvs_al_size(fs, len + NVS_DATA_CRC_SIZE) : 0U;
+	used = batch->data_size + data_size + (batch->count + 1U) * ate_size;
+
+	/* All the entries have to fit in a sector, next to the close, gc done
+	 * and delete ate.
+	 */
+	if ((used > batch->buf_size) || (used > (fs->sector_size - 3 * ate_size))) {
+		return -ENOSPC;
+	}
+
+	entry.id = id;
+	entry.offset = (uint16_t)batch->data_size;
+	entry.len = (uint16_t)len;
+	entry.part = 0xff;
+
+	if (len > 0) {
+		data8 = batch->buf + batch->data_size;
+		memcpy(data8, data, len);
+#ifdef CONFIG_NVS_DATA_CRC
+		uint32_t data_crc = crc32_ieee(data, len);
+
+		memcpy(data8 + len, &data_crc, sizeof(data_crc));
+		entry.len += NVS_DATA_CRC_SIZE;
+#endif
+		/* Padding as nvs_flash_al_wrt() does it */
+		(void)memset(data8 + entry.len, fs->flash_parameters->erase_value,
+			     data_size - entry.len);
+		batch->data_size += data_size;
+	}
+
+	data8 = nvs_batch_ate(batch, batch->count);
+	memcpy(data8, &entry, sizeof(entry));
+	(void)memset(data8 + sizeof(entry), fs->flash_parameters->erase_value,
+		     ate_size - sizeof(entry));
+	batch->count++;
+
+	return len;
+}
+
+/* Writes the data, then the allocation entries of the batch in one go each */
+static int nvs_flash_wrt_batch(struct nvs_fs *fs, struct nvs_batch *batch)
+{
+	size_t ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	size_t ates_size = batch->count * ate_size;
+	uint32_t ate_addr = fs->ate_wra + ate_size - ates_size;
+	uint16_t data_offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	struct nvs_ate entry;
+	int rc;
+
+	rc = nvs_flash_al_wrt(fs, fs->data_wra, batch->buf, batch->data_size);
+	fs->data_wra += batch->data_size;
+	if (rc) {
+		return rc;
+	}
+
+	for (uint16_t i = 0U; i < batch->count; i++) {
+		uint8_t *ate = nvs_batch_ate(batch, i);
+
+		memcpy(&entry, ate, sizeof(entry));
+		entry.offset += data_offset;
+		nvs_ate_crc8_update(&entry);
+		memcpy(ate, &entry, sizeof(entry));
+	}
+
+	rc = nvs_flash_al_wrt(fs, ate_addr, nvs_batch_ate(batch, batch->count - 1U),
+			      ates_size);
+
+	for (uint16_t i = 0U; i < batch->count; i++) {
+#ifdef CONFIG_NVS_LOOKUP
+		memcpy(&entry, nvs_batch_ate(batch, i), sizeof(entry));
+		/* 0xFFFF is a special-purpose identifier. Exclude it from the lookup */
+		if ((rc == 0) && (entry.id != 0xFFFF)) {
+			nvs_lookup_set(fs, entry.id, fs->ate_wra, true);
+		}
+#endif
+		fs->ate_wra -= ate_size;
+	}
+
+	return rc;
+}
+
+int nvs_batch_commit(struct nvs_batch *batch)
+{
+	struct nvs_fs *fs = batch->fs;
+	size_t ate_size;
+	uint32_t required_space;
+	int rc, gc_count;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	if (batch->count == 0U) {
+		return 0;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	/* Leave space for delete ate */
+	required_space = batch->data_size + batch->count * ate_size;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	gc_count = 0;
+	while (1) {
+		if (gc_count == fs->sector_count) {
+			/* gc'ed all sectors, no extra space will be created
+			 * by extra gc.
+			 */
+			rc = -ENOSPC;
+			goto end;
+		}
+
+		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+			rc = nvs_flash_wrt_batch(fs, batch);
+			if (rc) {
+				goto end;
+			}
+			break;
+		}
+
+		rc = nvs_sector_close(fs);
+		if (rc) {
+			goto end;
+		}
+
+		rc = nvs_gc(fs);
+		if (rc) {
+			goto end;
+		}
+		gc_count++;
+	}
+#ifdef CONFIG_NVS_BACKGROUND_GC
+	nvs_gc_trigger(fs);
+#endif
+	rc = batch->count;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	batch->data_size = 0U;
+	batch->count = 0U;
+	return rc;
+}
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -1226,8 +1689,8 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+#ifdef CONFIG_NVS_LOOKUP
+	wlk_addr = nvs_lookup_get(fs, id);
 
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
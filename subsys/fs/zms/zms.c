@@ -10,6 +10,7 @@
 #include <errno.h>
 #include <inttypes.h>
 #include <zephyr/fs/zms.h>
+#include <zephyr/init.h>
 #include <zephyr/sys/crc.h>
 #include "zms_priv.h"
 #ifdef CONFIG_ZMS_LOOKUP_CACHE_FOR_SETTINGS
@@ -733,6 +734,11 @@ static int zms_sector_close(struct zms_fs *fs)
 
 	fs->data_wra = fs->ate_wra & ADDR_SECT_MASK;
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	/* Only the sector being left was skipped by the background gc */
+	fs->gc_skip_sector = (uint32_t)ZMS_INVALID_SECTOR_NUM;
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
 	return 0;
 }
 
@@ -1096,6 +1102,82 @@ gc_done:
 	return rc;
 }
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+
+static K_KERNEL_STACK_DEFINE(zms_gc_stack, CONFIG_ZMS_BACKGROUND_GC_STACK_SIZE);
+static struct k_work_q zms_gc_work_q;
+
+static bool zms_gc_needed(struct zms_fs *fs)
+{
+	uint64_t threshold = (uint64_t)fs->sector_size * CONFIG_ZMS_BACKGROUND_GC_THRESHOLD / 100U;
+
+	return ((fs->ate_wra - fs->data_wra) < threshold) &&
+	       (SECTOR_NUM(fs->ate_wra) != fs->gc_skip_sector);
+}
+
+/* Called with zms_lock held */
+static void zms_gc_trigger(struct zms_fs *fs)
+{
+	if (zms_gc_needed(fs)) {
+		(void)k_work_submit_to_queue(&zms_gc_work_q, &fs->gc_work);
+	}
+}
+
+/*
+ * Moves to the next sector ahead of time, doing the garbage collection a
+ * writer would otherwise do inline once the active sector is full.  This is
+ * a whole sector at a time, as zms_sector_use_next() does: writers must not
+ * add entries to the active sector while its garbage collection is in
+ * progress.
+ */
+static void zms_gc_work_handler(struct k_work *work)
+{
+	struct zms_fs *fs = CONTAINER_OF(work, struct zms_fs, gc_work);
+	int rc;
+
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+
+	if (!fs->ready || !zms_gc_needed(fs)) {
+		goto end;
+	}
+
+	LOG_DBG("Background gc of sector %llu", SECTOR_NUM(fs->ate_wra));
+
+	rc = zms_sector_close(fs);
+	if (!rc) {
+		rc = zms_gc(fs);
+	}
+	if (rc) {
+		LOG_ERR("Background garbage collection failed, returned = %d", rc);
+		goto end;
+	}
+
+	/* The live data alone fills the new sector past the threshold, leave
+	 * the rest of it to the writers instead of moving it around again.
+	 */
+	if (zms_gc_needed(fs)) {
+		fs->gc_skip_sector = SECTOR_NUM(fs->ate_wra);
+	}
+
+end:
+	k_mutex_unlock(&fs->zms_lock);
+}
+
+static int zms_gc_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "zms_gc"};
+
+	k_work_queue_start(&zms_gc_work_q, zms_gc_stack,
+			   K_KERNEL_STACK_SIZEOF(zms_gc_stack),
+			   CONFIG_ZMS_BACKGROUND_GC_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(zms_gc_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
 int zms_clear(struct zms_fs *fs)
 {
 	int rc;
@@ -1106,6 +1188,12 @@ int zms_clear(struct zms_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 	for (uint32_t i = 0; i < fs->sector_count; i++) {
 		addr = (uint64_t)i << ADDR_SECT_SHIFT;
@@ -1395,6 +1483,17 @@ int zms_mount(struct zms_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	if (fs->ready) {
+		struct k_work_sync sync;
+
+		/* Remounting, the work item may still be queued */
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+	k_work_init(&fs->gc_work, zms_gc_work_handler);
+	fs->gc_skip_sector = (uint32_t)ZMS_INVALID_SECTOR_NUM;
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
 	k_mutex_init(&fs->zms_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1451,6 +1550,12 @@ int zms_mount(struct zms_fs *fs)
 	/* zms is ready for use */
 	fs->ready = true;
 
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	zms_gc_trigger(fs);
+	k_mutex_unlock(&fs->zms_lock);
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
+
 	LOG_INF("%u Sectors of %u bytes", fs->sector_count, fs->sector_size);
 	LOG_INF("alloc wra: %llu, %llx", SECTOR_NUM(fs->ate_wra), SECTOR_OFFSET(fs->ate_wra));
 	LOG_INF("data wra: %llu, %llx", SECTOR_NUM(fs->data_wra), SECTOR_OFFSET(fs->data_wra));
@@ -1592,6 +1697,9 @@ no_cached_entry:
 		}
 		gc_count++;
 	}
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+	zms_gc_trigger(fs);
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
 	rc = len;
 end:
 	k_mutex_unlock(&fs->zms_lock);
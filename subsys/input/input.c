@@ -16,21 +16,42 @@ LOG_MODULE_REGISTER(input, CONFIG_INPUT_LOG_LEVEL);
 K_MSGQ_DEFINE(input_msgq, sizeof(struct input_event),
 	      CONFIG_INPUT_QUEUE_MAX_MSGS, 4);
 
+static struct input_event input_batch[CONFIG_INPUT_BATCH_MAX_EVENTS];
+/* Events of the batch still to be handed to the current callback */
+static size_t input_batch_left;
+
 #endif
 
-static void input_process(struct input_event *evt)
+/* All the events are from the same device */
+static void input_process(struct input_event *evts, size_t num_evts)
 {
 	STRUCT_SECTION_FOREACH(input_callback, callback) {
-		if (callback->dev == NULL || callback->dev == evt->dev) {
-			callback->callback(evt, callback->user_data);
+		if (callback->dev != NULL && callback->dev != evts[0].dev) {
+			continue;
+		}
+
+		if (callback->batch_callback != NULL) {
+			callback->batch_callback(evts, num_evts, callback->user_data);
+			continue;
+		}
+
+		for (size_t i = 0; i < num_evts; i++) {
+#ifdef CONFIG_INPUT_MODE_THREAD
+			input_batch_left = num_evts - i - 1;
+#endif
+			callback->callback(&evts[i], callback->user_data);
 		}
 	}
+
+#ifdef CONFIG_INPUT_MODE_THREAD
+	input_batch_left = 0;
+#endif
 }
 
 bool input_queue_empty(void)
 {
 #ifdef CONFIG_INPUT_MODE_THREAD
-	if (k_msgq_num_used_get(&input_msgq) > 0) {
+	if (input_batch_left > 0 || k_msgq_num_used_get(&input_msgq) > 0) {
 		return false;
 	}
 #endif
@@ -66,26 +87,44 @@ int input_report(const struct device *dev,
 
 	return 0;
 #else
-	input_process(&evt);
+	input_process(&evt, 1);
 	return 0;
 #endif
 }
 
 #ifdef CONFIG_INPUT_MODE_THREAD
 
+/* Takes the events queued after the first one of the batch, up to the sync */
+static size_t input_batch_fill(void)
+{
+	struct input_event next;
+	size_t num_evts = 1;
+
+	while (!input_batch[num_evts - 1].sync && num_evts < ARRAY_SIZE(input_batch)) {
+		if (k_msgq_peek(&input_msgq, &next) != 0 || next.dev != input_batch[0].dev) {
+			break;
+		}
+
+		/* The only reader, so this is the peeked event */
+		(void)k_msgq_get(&input_msgq, &input_batch[num_evts], K_NO_WAIT);
+		num_evts++;
+	}
+
+	return num_evts;
+}
+
 static void input_thread(void)
 {
-	struct input_event evt;
 	int ret;
 
 	while (true) {
-		ret = k_msgq_get(&input_msgq, &evt, K_FOREVER);
+		ret = k_msgq_get(&input_msgq, &input_batch[0], K_FOREVER);
 		if (ret) {
 			LOG_ERR("k_msgq_get error: %d", ret);
 			continue;
 		}
 
-		input_process(&evt);
+		input_process(input_batch, input_batch_fill());
 	}
 }
 
@@ -38,17 +38,12 @@ static void double_tap_deferred(struct k_work *work)
 	entry->first_tap = false;
 }
 
-static void double_tap_cb(struct input_event *evt, void *user_data)
+static void double_tap_event(const struct device *dev, struct input_event *evt)
 {
-	const struct device *dev = user_data;
 	const struct double_tap_config *cfg = dev->config;
 	struct double_tap_data_entry *entry;
 	int i;
 
-	if (evt->type != INPUT_EV_KEY) {
-		return;
-	}
-
 	for (i = 0; i < cfg->num_codes; i++) {
 		if (evt->code == cfg->input_codes[i]) {
 			break;
@@ -74,6 +69,17 @@ static void double_tap_cb(struct input_event *evt, void *user_data)
 	}
 }
 
+static void double_tap_cb(struct input_event *evts, size_t num_evts, void *user_data)
+{
+	const struct device *dev = user_data;
+
+	for (size_t i = 0; i < num_evts; i++) {
+		if (evts[i].type == INPUT_EV_KEY) {
+			double_tap_event(dev, &evts[i]);
+		}
+	}
+}
+
 static int double_tap_init(const struct device *dev)
 {
 	const struct double_tap_config *cfg = dev->config;
@@ -99,9 +105,9 @@ static int double_tap_init(const struct device *dev)
 	BUILD_ASSERT(DT_INST_PROP_LEN(inst, input_codes) ==                                        \
 		     DT_INST_PROP_LEN(inst, double_tap_codes));                                    \
                                                                                                    \
-	INPUT_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET_OR_NULL(DT_INST_PHANDLE(inst, input)),           \
-				    double_tap_cb, (void *)DEVICE_DT_INST_GET(inst),               \
-				    double_tap_cb_##inst);                                         \
+	INPUT_BATCH_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET_OR_NULL(DT_INST_PHANDLE(inst, input)),     \
+					  double_tap_cb, (void *)DEVICE_DT_INST_GET(inst),         \
+					  double_tap_cb_##inst);                                   \
                                                                                                    \
 	static const uint16_t double_tap_input_codes_##inst[] = DT_INST_PROP(inst, input_codes);   \
                                                                                                    \
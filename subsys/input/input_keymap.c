@@ -29,30 +29,13 @@ struct keymap_data {
 	bool pressed;
 };
 
-static void keymap_cb(struct input_event *evt, void *user_data)
+static void keymap_sync(const struct device *dev)
 {
-	const struct device *dev = user_data;
 	const struct keymap_config *cfg = dev->config;
 	struct keymap_data *data = dev->data;
 	const uint16_t *codes = cfg->codes;
 	uint32_t offset;
 
-	switch (evt->code) {
-	case INPUT_ABS_X:
-		data->col = evt->value;
-		break;
-	case INPUT_ABS_Y:
-		data->row = evt->value;
-		break;
-	case INPUT_BTN_TOUCH:
-		data->pressed = evt->value;
-		break;
-	}
-
-	if (!evt->sync) {
-		return;
-	}
-
 	if (data->row >= cfg->row_size ||
 	    data->col >= cfg->col_size) {
 		LOG_WRN("keymap event out of range: row=%u col=%u", data->row, data->col);
@@ -71,6 +54,30 @@ static void keymap_cb(struct input_event *evt, void *user_data)
 	input_report_key(dev, codes[offset], data->pressed, true, K_FOREVER);
 }
 
+static void keymap_cb(struct input_event *evts, size_t num_evts, void *user_data)
+{
+	const struct device *dev = user_data;
+	struct keymap_data *data = dev->data;
+
+	for (size_t i = 0; i < num_evts; i++) {
+		switch (evts[i].code) {
+		case INPUT_ABS_X:
+			data->col = evts[i].value;
+			break;
+		case INPUT_ABS_Y:
+			data->row = evts[i].value;
+			break;
+		case INPUT_BTN_TOUCH:
+			data->pressed = evts[i].value;
+			break;
+		}
+
+		if (evts[i].sync) {
+			keymap_sync(dev);
+		}
+	}
+}
+
 static int keymap_init(const struct device *dev)
 {
 	const struct keymap_config *cfg = dev->config;
@@ -99,8 +106,8 @@ static int keymap_init(const struct device *dev)
 		KEYMAP_ENTRY_CODE(DT_PROP_BY_IDX(node_id, prop, idx)),
 
 #define INPUT_KEYMAP_DEFINE(inst)								\
-	INPUT_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET(DT_INST_PARENT(inst)), keymap_cb,		\
-				    (void *)DEVICE_DT_INST_GET(inst), keymap_cb_##inst);	\
+	INPUT_BATCH_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET(DT_INST_PARENT(inst)), keymap_cb,	\
+					  (void *)DEVICE_DT_INST_GET(inst), keymap_cb_##inst);	\
 												\
 	DT_INST_FOREACH_PROP_ELEM(inst, keymap, KEYMAP_ENTRY_VALIDATE)				\
 												\
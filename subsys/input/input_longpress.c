@@ -46,17 +46,12 @@ static void longpress_deferred(struct k_work *work)
 	entry->long_fired = true;
 }
 
-static void longpress_cb(struct input_event *evt, void *user_data)
+static void longpress_event(const struct device *dev, struct input_event *evt)
 {
-	const struct device *dev = user_data;
 	const struct longpress_config *cfg = dev->config;
 	struct longpress_data_entry *entry;
 	int i;
 
-	if (evt->type != INPUT_EV_KEY) {
-		return;
-	}
-
 	for (i = 0; i < cfg->num_codes; i++) {
 		if (evt->code == cfg->input_codes[i]) {
 			break;
@@ -83,6 +78,17 @@ static void longpress_cb(struct input_event *evt, void *user_data)
 	}
 }
 
+static void longpress_cb(struct input_event *evts, size_t num_evts, void *user_data)
+{
+	const struct device *dev = user_data;
+
+	for (size_t i = 0; i < num_evts; i++) {
+		if (evts[i].type == INPUT_EV_KEY) {
+			longpress_event(dev, &evts[i]);
+		}
+	}
+}
+
 static int longpress_init(const struct device *dev)
 {
 	const struct longpress_config *cfg = dev->config;
@@ -109,9 +115,9 @@ static int longpress_init(const struct device *dev)
 		      !DT_INST_NODE_HAS_PROP(inst, short_codes));                                  \
 	BUILD_ASSERT(DT_INST_PROP_LEN(inst, input_codes) == DT_INST_PROP_LEN(inst, long_codes));   \
 	                                                                                           \
-	INPUT_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET_OR_NULL(DT_INST_PHANDLE(inst, input)),           \
-				    longpress_cb, (void *)DEVICE_DT_INST_GET(inst),                \
-				    longpress_cb_##inst);                                          \
+	INPUT_BATCH_CALLBACK_DEFINE_NAMED(DEVICE_DT_GET_OR_NULL(DT_INST_PHANDLE(inst, input)),     \
+					  longpress_cb, (void *)DEVICE_DT_INST_GET(inst),          \
+					  longpress_cb_##inst);                                    \
 	                                                                                           \
 	static const uint16_t longpress_input_codes_##inst[] = DT_INST_PROP(inst, input_codes);    \
 	                                                                                           \
@@ -50,7 +50,12 @@
 static const uint8_t magic[] = {0x45, 0x6d, 0x31, 0x6c, 0x31, 0x4b,
 				0x30, 0x72, 0x6e, 0x33, 0x6c, 0x69, 0x34};
 
-#ifdef CONFIG_MULTITHREADING
+/* Incoming data is processed from a work queue, unless straight from the mbox ISR. */
+#if defined(CONFIG_MULTITHREADING) && !defined(CONFIG_IPC_SERVICE_ICMSG_RX_IN_ISR)
+#define ICMSG_RX_WORK 1
+#endif
+
+#ifdef ICMSG_RX_WORK
 #if defined(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE)
 static K_THREAD_STACK_DEFINE(icmsg_stack, CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_STACK_SIZE);
 static struct k_work_q icmsg_workq;
@@ -58,7 +63,7 @@ static struct k_work_q *const workq = &icmsg_workq;
 #else /* defined(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE) */
 static struct k_work_q *const workq = &k_sys_work_q;
 #endif /* defined(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE) */
-#endif /* def CONFIG_MULTITHREADING */
+#endif /* def ICMSG_RX_WORK */
 
 static int mbox_deinit(const struct icmsg_config_t *conf,
 		       struct icmsg_data_t *dev_data)
@@ -75,7 +80,7 @@ static int mbox_deinit(const struct icmsg_config_t *conf,
 		return err;
 	}
 
-#ifdef CONFIG_MULTITHREADING
+#ifdef ICMSG_RX_WORK
 	(void)k_work_cancel(&dev_data->mbox_work);
 #endif
 
@@ -110,7 +115,7 @@ static uint32_t data_available(struct icmsg_data_t *dev_data)
 	return pbuf_read(dev_data->rx_pb, NULL, 0);
 }
 
-#ifdef CONFIG_MULTITHREADING
+#ifdef ICMSG_RX_WORK
 static void submit_mbox_work(struct icmsg_data_t *dev_data)
 {
 	if (k_work_submit_to_queue(workq, &dev_data->mbox_work) < 0) {
@@ -121,7 +126,28 @@ static void submit_mbox_work(struct icmsg_data_t *dev_data)
 	}
 }
 
+#endif /* def ICMSG_RX_WORK */
+
+/* Whether the remote needs a signal for the packet of len bytes just written. */
+static bool notify_needed(struct icmsg_data_t *dev_data, size_t len)
+{
+#if defined(CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE)
+	uint32_t pending = pbuf_tx_pending(dev_data->tx_pb);
+
+	/* The remote goes on reading as long as it finds data after reading a packet,
+	 * so only a packet written once it has read all the others needs a signal.
+	 * Written after the packet, this check cannot miss the remote stopping.
+	 */
+	if (pending == PBUF_PACKET_LEN_SZ + ROUND_UP(len, _PBUF_IDX_SIZE)) {
+		return true;
+	}
+
+	return (CONFIG_IPC_SERVICE_ICMSG_NOTIFY_THRESHOLD > 0) &&
+	       (pending >= CONFIG_IPC_SERVICE_ICMSG_NOTIFY_THRESHOLD);
+#else
+	return true;
 #endif
+}
 
 static int initialize_tx_with_sid_disabled(struct icmsg_data_t *dev_data)
 {
@@ -153,6 +179,8 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 {
 	int ret;
 	uint8_t rx_buffer[CONFIG_PBUF_RX_READ_BUF_SIZE] __aligned(4);
+	char *rx_data = NULL;
+	bool in_place = false;
 	uint32_t len = 0;
 	uint32_t len_available;
 	bool rerun = false;
@@ -256,10 +284,26 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 	case ICMSG_STATE_INITIALIZING_SID_DISABLED:
 #endif
 
-		len_available = data_available(dev_data);
+		if (dev_data->rx_held != NULL) {
+			/* Reception goes on once the held buffer is released. */
+			return false;
+		}
 
-		if (len_available > 0 && sizeof(rx_buffer) >= len_available) {
-			len = pbuf_read(dev_data->rx_pb, rx_buffer, sizeof(rx_buffer));
+		/* Messages are delivered from shared memory unless they wrap around the
+		 * end of the buffer.
+		 */
+		ret = pbuf_rx_buf_get(dev_data->rx_pb, &rx_data);
+		if (ret == -ENOBUFS) {
+			rx_data = (char *)rx_buffer;
+			len_available = data_available(dev_data);
+
+			if (len_available > 0 && sizeof(rx_buffer) >= len_available) {
+				len = pbuf_read(dev_data->rx_pb, rx_buffer, sizeof(rx_buffer));
+			}
+		} else {
+			len_available = MAX(ret, 0);
+			len = len_available;
+			in_place = (len > 0);
 		}
 
 		if (state == ICMSG_STATE_CONNECTED_SID_ENABLED &&
@@ -284,22 +328,31 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 			return false;
 		}
 
-		__ASSERT_NO_MSG(len_available <= sizeof(rx_buffer));
+		__ASSERT_NO_MSG(in_place || len_available <= sizeof(rx_buffer));
 
-		if (sizeof(rx_buffer) < len_available) {
+		if (!in_place && sizeof(rx_buffer) < len_available) {
 			return false;
 		}
 
 		if (state != ICMSG_STATE_INITIALIZING_SID_DISABLED || !UNBOUND_DISABLED) {
 			if (dev_data->cb->received) {
-				dev_data->cb->received(rx_buffer, len, dev_data->ctx);
+				if (in_place) {
+					dev_data->rx_in_place = rx_data;
+					dev_data->rx_in_place_len = len;
+				}
+				dev_data->cb->received(rx_data, len, dev_data->ctx);
 			}
 		} else {
 			/* Allow magic number longer than sizeof(magic) for future protocol
 			 * version.
 			 */
 			bool endpoint_invalid = (len < sizeof(magic) ||
-						memcmp(magic, rx_buffer, sizeof(magic)));
+						memcmp(magic, rx_data, sizeof(magic)));
+
+			if (in_place) {
+				(void)pbuf_rx_buf_free(dev_data->rx_pb, len);
+				in_place = false;
+			}
 
 			if (endpoint_invalid) {
 				__ASSERT_NO_MSG(false);
@@ -314,6 +367,20 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 			notify_remote = true;
 		}
 
+		if (in_place) {
+			k_spinlock_key_t key = k_spin_lock(&dev_data->rx_lock);
+			bool held = (dev_data->rx_held != NULL);
+
+			dev_data->rx_in_place = NULL;
+			k_spin_unlock(&dev_data->rx_lock, key);
+
+			if (held) {
+				/* Freed by icmsg_release_rx_buffer(). */
+				return false;
+			}
+			(void)pbuf_rx_buf_free(dev_data->rx_pb, len);
+		}
+
 		rerun = (data_available(dev_data) > 0);
 		break;
 
@@ -331,7 +398,7 @@ static bool callback_process(struct icmsg_data_t *dev_data)
 	return rerun;
 }
 
-#ifdef CONFIG_MULTITHREADING
+#ifdef ICMSG_RX_WORK
 static void workq_callback_process(struct k_work *item)
 {
 	bool rerun;
@@ -342,7 +409,7 @@ static void workq_callback_process(struct k_work *item)
 		submit_mbox_work(dev_data);
 	}
 }
-#endif /* def CONFIG_MULTITHREADING */
+#endif /* def ICMSG_RX_WORK */
 
 static void mbox_callback(const struct device *instance, uint32_t channel,
 			  void *user_data, struct mbox_msg *msg_data)
@@ -350,7 +417,7 @@ static void mbox_callback(const struct device *instance, uint32_t channel,
 	bool rerun;
 	struct icmsg_data_t *dev_data = user_data;
 
-#ifdef CONFIG_MULTITHREADING
+#ifdef ICMSG_RX_WORK
 	ARG_UNUSED(rerun);
 	submit_mbox_work(dev_data);
 #else
@@ -365,7 +432,7 @@ static int mbox_init(const struct icmsg_config_t *conf,
 {
 	int err;
 
-#ifdef CONFIG_MULTITHREADING
+#ifdef ICMSG_RX_WORK
 	k_work_init(&dev_data->mbox_work, workq_callback_process);
 #endif
 
@@ -407,6 +474,8 @@ int icmsg_open(const struct icmsg_config_t *conf,
 	dev_data->cb = cb;
 	dev_data->ctx = ctx;
 	dev_data->cfg = conf;
+	dev_data->rx_held = NULL;
+	dev_data->tx_buf = NULL;
 
 #ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
 	k_mutex_init(&dev_data->tx_lock);
@@ -498,6 +567,7 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	int write_ret;
 	int release_ret;
 	int sent_bytes;
+	bool notify;
 	uint32_t state = atomic_get(&dev_data->state);
 
 	if (!is_endpoint_ready(state)) {
@@ -517,8 +587,18 @@ int icmsg_send(const struct icmsg_config_t *conf,
 		return -ENOBUFS;
 	}
 
+	if (dev_data->tx_buf != NULL) {
+		/* The claimed buffer is in the way of any other message. */
+		release_ret = release_tx_buffer(dev_data);
+		__ASSERT_NO_MSG(!release_ret);
+		return -EBUSY;
+	}
+
 	write_ret = pbuf_write(dev_data->tx_pb, msg, len);
 
+	/* Decided with the lock taken, so that no later packet is counted in */
+	notify = (write_ret > 0) && notify_needed(dev_data, write_ret);
+
 	release_ret = release_tx_buffer(dev_data);
 	__ASSERT_NO_MSG(!release_ret);
 
@@ -529,6 +609,10 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	}
 	sent_bytes = write_ret;
 
+	if (!notify) {
+		return sent_bytes;
+	}
+
 	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
 
 	ret = mbox_send_dt(&conf->mbox_tx, NULL);
@@ -539,6 +623,171 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	return sent_bytes;
 }
 
+int icmsg_get_tx_buffer(const struct icmsg_config_t *conf,
+			struct icmsg_data_t *dev_data,
+			void **data, uint32_t *size)
+{
+	char *buf;
+	int avail;
+	int ret;
+
+	if (!is_endpoint_ready(atomic_get(&dev_data->state))) {
+		return -EBUSY;
+	}
+
+	ret = reserve_tx_buffer_if_unused(dev_data);
+	if (ret < 0) {
+		return -ENOBUFS;
+	}
+
+	if (dev_data->tx_buf != NULL) {
+		(void)release_tx_buffer(dev_data);
+		return -EALREADY;
+	}
+
+	avail = pbuf_tx_buf_get(dev_data->tx_pb, &buf);
+	if (avail <= 0 || *size > (uint32_t)avail) {
+		(void)release_tx_buffer(dev_data);
+		if (avail <= 0) {
+			return (avail < 0) ? avail : -ENOBUFS;
+		}
+		*size = avail;
+		return -ENOMEM;
+	}
+
+	/* The TX lock stays taken until the buffer is sent or dropped. */
+	dev_data->tx_buf = buf;
+	dev_data->tx_buf_size = avail;
+	*data = buf;
+	*size = avail;
+
+	return 0;
+}
+
+int icmsg_drop_tx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data)
+{
+	if (dev_data->tx_buf == NULL) {
+		return -EALREADY;
+	}
+
+	if (data != dev_data->tx_buf) {
+		return -ENXIO;
+	}
+
+	dev_data->tx_buf = NULL;
+
+	return release_tx_buffer(dev_data);
+}
+
+int icmsg_send_nocopy(const struct icmsg_config_t *conf,
+		      struct icmsg_data_t *dev_data,
+		      const void *msg, size_t len)
+{
+	bool notify;
+	int ret;
+
+	if (dev_data->tx_buf == NULL || msg != dev_data->tx_buf) {
+		return -ENXIO;
+	}
+
+	if (len == 0) {
+		return -ENODATA;
+	}
+
+	if (len > dev_data->tx_buf_size) {
+		return -EBADMSG;
+	}
+
+	ret = pbuf_tx_buf_commit(dev_data->tx_pb, len);
+	notify = (ret > 0) && notify_needed(dev_data, ret);
+
+	dev_data->tx_buf = NULL;
+	(void)release_tx_buffer(dev_data);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!notify) {
+		return len;
+	}
+
+	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
+
+	ret = mbox_send_dt(&conf->mbox_tx, NULL);
+	if (ret) {
+		return ret;
+	}
+
+	return len;
+}
+
+int icmsg_hold_rx_buffer(const struct icmsg_config_t *conf,
+			 struct icmsg_data_t *dev_data,
+			 const void *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&dev_data->rx_lock);
+	int ret = 0;
+
+	if (dev_data->rx_held != NULL) {
+		ret = -EALREADY;
+	} else if (data == NULL || data != dev_data->rx_in_place) {
+		/* Only the message being received, when not copied out of the ring. */
+		ret = -ENXIO;
+	} else {
+		dev_data->rx_held = data;
+		dev_data->rx_held_len = dev_data->rx_in_place_len;
+	}
+
+	k_spin_unlock(&dev_data->rx_lock, key);
+
+	return ret;
+}
+
+int icmsg_release_rx_buffer(const struct icmsg_config_t *conf,
+			    struct icmsg_data_t *dev_data,
+			    const void *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&dev_data->rx_lock);
+	bool in_callback;
+	uint16_t len;
+
+	if (dev_data->rx_held == NULL) {
+		k_spin_unlock(&dev_data->rx_lock, key);
+		return -EALREADY;
+	}
+
+	if (data != dev_data->rx_held) {
+		k_spin_unlock(&dev_data->rx_lock, key);
+		return -ENXIO;
+	}
+
+	/* Still in the receive callback, which frees the buffer itself. */
+	in_callback = (dev_data->rx_in_place == data);
+	len = dev_data->rx_held_len;
+	dev_data->rx_held = NULL;
+
+	k_spin_unlock(&dev_data->rx_lock, key);
+
+	if (in_callback) {
+		return 0;
+	}
+
+	(void)pbuf_rx_buf_free(dev_data->rx_pb, len);
+
+	/* Go on with the messages received meanwhile. */
+#ifdef ICMSG_RX_WORK
+	submit_mbox_work(dev_data);
+#else
+	while (callback_process(dev_data)) {
+	}
+#endif
+
+	return 0;
+}
+
 #if defined(CONFIG_IPC_SERVICE_BACKEND_ICMSG_WQ_ENABLE)
 
 static int work_q_init(void)
@@ -179,6 +179,82 @@ int pbuf_write(struct pbuf *pb, const char *data, uint16_t len)
 	return len;
 }
 
+int pbuf_tx_buf_get(struct pbuf *pb, char **buf)
+{
+	if (pb == NULL || buf == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	/* Invalidate rd_idx only, local wr_idx is used to increase buffer security. */
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	const uint32_t blen = pb->cfg->len;
+	uint32_t rd_idx = *(pb->cfg->rd_idx_loc);
+	uint32_t wr_idx = pb->data.wr_idx;
+
+	if (!IS_PTR_ALIGNED_BYTES(rd_idx, _PBUF_IDX_SIZE)) {
+		return -EINVAL;
+	}
+
+	uint32_t free_space = blen - idx_occupied(blen, wr_idx, rd_idx) - _PBUF_IDX_SIZE;
+
+	if (free_space <= PBUF_PACKET_LEN_SZ) {
+		return 0;
+	}
+
+	/* The data of an in-place packet must not wrap. */
+	uint32_t data_idx = idx_wrap(blen, wr_idx + PBUF_PACKET_LEN_SZ);
+	uint32_t size = MIN(free_space - PBUF_PACKET_LEN_SZ, blen - data_idx);
+
+	*buf = (char *)&pb->cfg->data_loc[data_idx];
+
+	return (int)MIN(size, UINT16_MAX);
+}
+
+int pbuf_tx_buf_commit(struct pbuf *pb, uint16_t len)
+{
+	if (pb == NULL || len == 0) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+	uint32_t wr_idx = pb->data.wr_idx;
+	uint32_t data_idx = idx_wrap(blen, wr_idx + PBUF_PACKET_LEN_SZ);
+
+	if (len > blen - data_idx) {
+		return -EINVAL;
+	}
+
+	/* Same packet header as pbuf_write(), the data is already in place. */
+	*((uint32_t *)(&data_loc[wr_idx])) = 0;
+	sys_put_be16(len, &data_loc[wr_idx]);
+	__sync_synchronize();
+	sys_cache_data_flush_range(&data_loc[wr_idx], PBUF_PACKET_LEN_SZ);
+	sys_cache_data_flush_range(&data_loc[data_idx], len);
+
+	wr_idx = idx_wrap(blen, ROUND_UP(data_idx + len, _PBUF_IDX_SIZE));
+	/* Update wr_idx. */
+	pb->data.wr_idx = wr_idx;
+	*(pb->cfg->wr_idx_loc) = wr_idx;
+	__sync_synchronize();
+	sys_cache_data_flush_range((void *)pb->cfg->wr_idx_loc, sizeof(*(pb->cfg->wr_idx_loc)));
+
+	return len;
+}
+
+uint32_t pbuf_tx_pending(struct pbuf *pb)
+{
+	__sync_synchronize();
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	return idx_occupied(pb->cfg->len, pb->data.wr_idx, *(pb->cfg->rd_idx_loc));
+}
+
 int pbuf_get_initial_buf(struct pbuf *pb, volatile char **buf, uint16_t *len)
 {
 	uint32_t wr_idx;
@@ -295,6 +371,74 @@ int pbuf_read(struct pbuf *pb, char *buf, uint16_t len)
 	return len;
 }
 
+int pbuf_rx_buf_get(struct pbuf *pb, char **buf)
+{
+	if (pb == NULL || buf == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	/* Invalidate wr_idx only, local rd_idx is used to increase buffer security. */
+	sys_cache_data_invd_range((void *)(pb->cfg->wr_idx_loc), sizeof(*(pb->cfg->wr_idx_loc)));
+	__sync_synchronize();
+
+	uint8_t *const data_loc = pb->cfg->data_loc;
+	const uint32_t blen = pb->cfg->len;
+	uint32_t wr_idx = *(pb->cfg->wr_idx_loc);
+	uint32_t rd_idx = pb->data.rd_idx;
+
+	if (!IS_PTR_ALIGNED_BYTES(wr_idx, _PBUF_IDX_SIZE)) {
+		return -EINVAL;
+	}
+
+	if (rd_idx == wr_idx) {
+		/* Buffer is empty. */
+		return 0;
+	}
+
+	/* Get packet len.*/
+	sys_cache_data_invd_range(&data_loc[rd_idx], PBUF_PACKET_LEN_SZ);
+	uint16_t plen = sys_get_be16(&data_loc[rd_idx]);
+
+	if (idx_occupied(blen, wr_idx, rd_idx) < plen + PBUF_PACKET_LEN_SZ) {
+		/* This should never happen. */
+		return -EAGAIN;
+	}
+
+	uint32_t data_idx = idx_wrap(blen, rd_idx + PBUF_PACKET_LEN_SZ);
+
+	if (plen > blen - data_idx) {
+		/* Wrapped packet, only pbuf_read() can get it. */
+		return -ENOBUFS;
+	}
+
+	sys_cache_data_invd_range(&data_loc[data_idx], plen);
+	*buf = (char *)&data_loc[data_idx];
+
+	return plen;
+}
+
+int pbuf_rx_buf_free(struct pbuf *pb, uint16_t len)
+{
+	if (pb == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	const uint32_t blen = pb->cfg->len;
+	uint32_t rd_idx = idx_wrap(blen, pb->data.rd_idx + PBUF_PACKET_LEN_SZ);
+
+	/* Update rd_idx. */
+	rd_idx = idx_wrap(blen, ROUND_UP(rd_idx + len, _PBUF_IDX_SIZE));
+
+	pb->data.rd_idx = rd_idx;
+	*(pb->cfg->rd_idx_loc) = rd_idx;
+	__sync_synchronize();
+	sys_cache_data_flush_range((void *)pb->cfg->rd_idx_loc, sizeof(*(pb->cfg->rd_idx_loc)));
+
+	return 0;
+}
+
 uint32_t pbuf_handshake_read(struct pbuf *pb)
 {
 	volatile uint32_t *ptr = pb->cfg->handshake_loc;
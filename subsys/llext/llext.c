@@ -127,24 +127,49 @@ int llext_iterate(int (*fn)(struct llext *ext, void *arg), void *arg)
 	return ret;
 }
 
-const void *llext_find_sym(const struct llext_symtable *sym_table, const char *sym_name)
+#if defined(CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID) || defined(CONFIG_LLEXT_EXPORT_BUILTINS_SORTED)
+/*
+ * The llext_const_symbol_area section is sorted in ascending SLID order,
+ * or by name with strcmp() ordering, by scripts/build/llext_prepare_exptab.py.
+ */
+static const void *llext_find_builtin_sym(const char *sym_name)
 {
-	if (sym_table == NULL) {
-		/* Built-in symbol table */
+	struct llext_const_symbol *sym;
+	size_t lo = 0;
+	size_t hi;
+	int cmp;
+
+	STRUCT_SECTION_COUNT(llext_const_symbol, &hi);
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		STRUCT_SECTION_GET(llext_const_symbol, mid, &sym);
 #ifdef CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID
 		/* 'sym_name' is actually a SLID to search for */
-		uintptr_t slid = (uintptr_t)sym_name;
-
-		/* TODO: perform a binary search instead of linear.
-		 * Note that - as of writing - the llext_const_symbol_area
-		 * section is sorted in ascending SLID order.
-		 * (see scripts/build/llext_prepare_exptab.py)
-		 */
-		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
-			if (slid == sym->slid) {
-				return sym->addr;
-			}
+		cmp = ((uintptr_t)sym_name > sym->slid) - ((uintptr_t)sym_name < sym->slid);
+#else
+		cmp = strcmp(sym_name, sym->name);
+#endif
+		if (cmp == 0) {
+			return sym->addr;
+		} else if (cmp < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
 		}
+	}
+
+	return NULL;
+}
+#endif
+
+const void *llext_find_sym(const struct llext_symtable *sym_table, const char *sym_name)
+{
+	if (sym_table == NULL) {
+		/* Built-in symbol table */
+#if defined(CONFIG_LLEXT_EXPORT_BUILTINS_BY_SLID) || defined(CONFIG_LLEXT_EXPORT_BUILTINS_SORTED)
+		return llext_find_builtin_sym(sym_name);
 #else
 		STRUCT_SECTION_FOREACH(llext_const_symbol, sym) {
 			if (strcmp(sym->name, sym_name) == 0) {
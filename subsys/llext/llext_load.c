@@ -494,13 +494,17 @@ static int llext_map_sections(struct llext_loader *ldr, struct llext *ext,
 	/*
 	 * Calculate each ELF section's offset inside its memory region. This
 	 * is done as a separate pass so the final regions are already defined.
-	 * Also mark the regions that include relocation targets.
+	 * Also mark the regions that include relocation targets, unless no
+	 * relocation is going to be applied because the extension is already
+	 * linked for its final addresses: read-only regions can then be used
+	 * in place from persistent storage.
 	 */
 	for (i = 0; i < ext->sect_cnt; ++i) {
 		elf_shdr_t *shdr = ext->sect_hdrs + i;
 		enum llext_mem mem_idx = ldr->sect_map[i].mem_idx;
 
-		if (shdr->sh_type == SHT_REL || shdr->sh_type == SHT_RELA) {
+		if ((shdr->sh_type == SHT_REL || shdr->sh_type == SHT_RELA) &&
+		    ldr_parm->relocate_local) {
 			enum llext_mem target_region = ldr->sect_map[shdr->sh_info].mem_idx;
 
 			if (target_region != LLEXT_MEM_COUNT) {
@@ -136,6 +136,25 @@ static int llext_copy_region(struct llext_loader *ldr, struct llext *ext,
 	}
 
 	if (ldr_parm->pre_located) {
+		if ((region->sh_flags & (SHF_ALLOC | SHF_WRITE)) == (SHF_ALLOC | SHF_WRITE) &&
+		    region->sh_type != SHT_NOBITS) {
+			/*
+			 * Writable data of an extension kept in read-only
+			 * storage: copy its initial values to the address
+			 * it was linked for, reserved by the user.
+			 */
+			ext->mem[mem_idx] = (void *)region->sh_addr;
+			ext->mem_on_heap[mem_idx] = false;
+			llext_init_mem_part(ext, mem_idx, region->sh_addr, region_alloc);
+
+			ret = llext_seek(ldr, region->sh_offset);
+			if (ret != 0) {
+				return ret;
+			}
+
+			return llext_read(ldr, ext->mem[mem_idx], region->sh_size);
+		}
+
 		/*
 		 * The ELF file is supposed to be pre-located, but some
 		 * regions are not accessible or not in the correct place.
@@ -134,6 +134,24 @@ static void process(const struct log_backend *const backend,
 	log_output_func(ctx->output, &msg->log, flags);
 }
 
+static void process_batch(const struct log_backend *const backend,
+			  union log_msg_generic **msgs, size_t cnt)
+{
+	const struct lbu_cb_ctx *ctx = backend->cb->ctx;
+	struct lbu_data *data = ctx->data;
+	uint32_t flags = log_backend_std_get_flags() | LOG_OUTPUT_FLAG_NO_FLUSH;
+	log_format_func_t log_output_func = log_format_func_t_get(data->log_format_current);
+
+	/* Messages are accumulated in the output buffer, which is written
+	 * when full and once after the last message.
+	 */
+	for (size_t i = 0; i < cnt; i++) {
+		log_output_func(ctx->output, &msgs[i]->log, flags);
+	}
+
+	log_output_flush(ctx->output);
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	const struct lbu_cb_ctx *ctx = backend->cb->ctx;
@@ -219,6 +237,7 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 
 const struct log_backend_api log_backend_uart_api = {
 	.process = process,
+	.process_batch = process_batch,
 	.panic = panic,
 	.init = log_backend_uart_init,
 	.dropped = IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) ? NULL : dropped,
@@ -15,6 +15,7 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/percpu.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <ctype.h>
 #include <zephyr/logging/log_frontend.h>
@@ -72,6 +73,10 @@ LOG_MODULE_REGISTER(log);
 #define CONFIG_LOG_FAILURE_REPORT_PERIOD 0
 #endif
 
+#ifndef CONFIG_LOG_PROCESS_BATCH_SIZE
+#define CONFIG_LOG_PROCESS_BATCH_SIZE 1
+#endif
+
 #ifndef CONFIG_LOG_ALWAYS_RUNTIME
 BUILD_ASSERT(!IS_ENABLED(CONFIG_NO_OPTIMIZATIONS),
 	     "CONFIG_LOG_ALWAYS_RUNTIME must be enabled when "
@@ -108,7 +113,8 @@ static atomic_t initialized;
 static bool panic_mode;
 static bool backend_attached;
 static atomic_t buffered_cnt;
-static atomic_t dropped_cnt;
+/* Dropping happens on all CPUs when buffers run full, keep it local */
+PERCPU_DEFINE_STATIC(atomic_t, dropped_cnt);
 static k_tid_t proc_tid;
 static struct k_timer log_process_thread_timer;
 
@@ -119,22 +125,36 @@ static log_timestamp_t proc_latency;
 static log_timestamp_t prev_timestamp;
 static atomic_t unordered_cnt;
 static uint64_t last_failure_report;
+#if defined(CONFIG_LOG_RATELIMIT_SUMMARY)
+atomic_t z_log_suppressed_cnt;
+#endif
 static struct k_spinlock process_lock;
 
-static STRUCT_SECTION_ITERABLE(log_msg_ptr, log_msg_ptr);
-static STRUCT_SECTION_ITERABLE_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer);
+#if defined(CONFIG_LOG_PER_CPU_BUFFERS)
+/* Each CPU gets its share of the buffer, merged by timestamp when claiming */
+#define LOG_BUFFER_CNT CONFIG_MP_MAX_NUM_CPUS
+#else
+#define LOG_BUFFER_CNT 1
+#endif
+
+/* Buffers are registered with the ones of the links, so that
+ * z_log_msg_claim_oldest() merges them all.
+ */
+static STRUCT_SECTION_ITERABLE_ARRAY(log_msg_ptr, log_msg_ptr, LOG_BUFFER_CNT);
+static STRUCT_SECTION_ITERABLE_ARRAY_ALTERNATE(log_mpsc_pbuf, mpsc_pbuf_buffer, log_buffer,
+					       LOG_BUFFER_CNT);
 static struct mpsc_pbuf_buffer *curr_log_buffer;
 
 #ifdef CONFIG_MPSC_PBUF
 static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_CNT][CONFIG_LOG_BUFFER_SIZE / sizeof(int) / LOG_BUFFER_CNT];
 
 static void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			      const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.buf = (uint32_t *)buf32[0],
+	.size = ARRAY_SIZE(buf32[0]),
 	.notify_drop = z_log_notify_drop,
 	.get_wlen = log_msg_generic_get_wlen,
 	.flags = (IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -256,7 +276,9 @@ static log_timestamp_t default_rt_get_timestamp(void)
 void log_core_init(void)
 {
 	panic_mode = false;
-	dropped_cnt = 0;
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		atomic_clear(PERCPU_PTR(dropped_cnt, i));
+	}
 	buffered_cnt = 0;
 
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
@@ -519,6 +541,44 @@ static void msg_process(union log_msg_generic *msg)
 	}
 }
 
+/* Claim up to CONFIG_LOG_PROCESS_BATCH_SIZE messages, starting with msg, and
+ * hand them together to each backend.
+ */
+static void msg_batch_process(union log_msg_generic *msg)
+{
+	union log_msg_generic *msgs[CONFIG_LOG_PROCESS_BATCH_SIZE];
+	union log_msg_generic *filtered[CONFIG_LOG_PROCESS_BATCH_SIZE];
+	k_timeout_t backoff;
+	size_t cnt = 0;
+
+	do {
+		msgs[cnt++] = msg;
+	} while (cnt < ARRAY_SIZE(msgs) && (msg = z_log_msg_claim(&backoff)) != NULL);
+
+	STRUCT_SECTION_FOREACH(log_backend, backend) {
+		size_t fcnt = 0;
+
+		if (!log_backend_is_active(backend)) {
+			continue;
+		}
+
+		for (size_t i = 0; i < cnt; i++) {
+			if (msg_filter_check(backend, msgs[i])) {
+				filtered[fcnt++] = msgs[i];
+			}
+		}
+
+		if (fcnt > 0) {
+			log_backend_msg_process_batch(backend, filtered, fcnt);
+		}
+	}
+
+	for (size_t i = 0; i < cnt; i++) {
+		z_log_msg_free(msgs[i]);
+		atomic_dec(&buffered_cnt);
+	}
+}
+
 void dropped_notify(void)
 {
 	uint32_t dropped = z_log_dropped_read_and_clear();
@@ -537,6 +597,39 @@ void unordered_notify(void)
 	LOG_WRN("%d unordered messages since last report", unordered);
 }
 
+static void suppressed_notify(void)
+{
+#if defined(CONFIG_LOG_RATELIMIT_SUMMARY)
+	(void)atomic_clear(&z_log_suppressed_cnt);
+
+	STRUCT_SECTION_FOREACH(log_ratelimit, rl) {
+		uint32_t suppressed = atomic_clear(&rl->suppressed);
+
+		if (suppressed > 0U) {
+			LOG_WRN("%s:%u: %u messages suppressed", rl->file, rl->line, suppressed);
+		}
+	}
+#endif
+}
+
+bool z_log_ratelimit_check(struct log_ratelimit *rl, uint32_t limit)
+{
+	uint32_t now = k_uptime_get_32();
+	atomic_val_t start = atomic_get(&rl->start);
+
+	/* Only the first caller past the interval starts a new one */
+	if ((now - (uint32_t)start) >= CONFIG_LOG_RATELIMIT_INTERVAL &&
+	    atomic_cas(&rl->start, start, (atomic_val_t)now)) {
+		atomic_set(&rl->count, 0);
+	}
+
+	if ((uint32_t)atomic_inc(&rl->count) < limit) {
+		return true;
+	}
+
+	return z_log_ratelimit_suppress(rl);
+}
+
 void z_log_notify_backend_enabled(void)
 {
 	/* Wakeup logger thread after attaching first backend. It might be
@@ -554,6 +647,15 @@ static inline bool z_log_unordered_pending(void)
 	return IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && unordered_cnt;
 }
 
+static inline bool z_log_suppressed_pending(void)
+{
+#if defined(CONFIG_LOG_RATELIMIT_SUMMARY)
+	return atomic_get(&z_log_suppressed_cnt) != 0;
+#else
+	return false;
+#endif
+}
+
 bool z_impl_log_process(void)
 {
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
@@ -569,7 +671,9 @@ bool z_impl_log_process(void)
 
 	msg = z_log_msg_claim(&backoff);
 
-	if (msg) {
+	if (msg && CONFIG_LOG_PROCESS_BATCH_SIZE > 1) {
+		msg_batch_process(msg);
+	} else if (msg) {
 		msg_process(msg);
 		z_log_msg_free(msg);
 		atomic_dec(&buffered_cnt);
@@ -586,8 +690,9 @@ bool z_impl_log_process(void)
 	if (IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
 		bool dropped_pend = z_log_dropped_pending();
 		bool unordered_pend = z_log_unordered_pending();
+		bool suppressed_pend = z_log_suppressed_pending();
 
-		if ((dropped_pend || unordered_pend) &&
+		if ((dropped_pend || unordered_pend || suppressed_pend) &&
 		   (k_uptime_get() - last_failure_report) > CONFIG_LOG_FAILURE_REPORT_PERIOD) {
 			if (dropped_pend) {
 				dropped_notify();
@@ -596,6 +701,10 @@ bool z_impl_log_process(void)
 			if (unordered_pend) {
 				unordered_notify();
 			}
+
+			if (suppressed_pend) {
+				suppressed_notify();
+			}
 		}
 
 		last_failure_report += CONFIG_LOG_FAILURE_REPORT_PERIOD;
@@ -627,7 +736,7 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 
 void z_log_dropped(bool buffered)
 {
-	atomic_inc(&dropped_cnt);
+	atomic_inc(PERCPU_GET(dropped_cnt));
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -640,19 +749,63 @@ void z_log_dropped(bool buffered)
 
 uint32_t z_log_dropped_read_and_clear(void)
 {
-	return atomic_set(&dropped_cnt, 0);
+	uint32_t dropped = 0;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		dropped += atomic_clear(PERCPU_PTR(dropped_cnt, i));
+	}
+
+	return dropped;
 }
 
 bool z_log_dropped_pending(void)
 {
-	return dropped_cnt > 0;
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (atomic_get(PERCPU_PTR(dropped_cnt, i)) > 0) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
-	curr_log_buffer = &log_buffer;
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		config.buf = buf32[i];
+		mpsc_pbuf_init(&log_buffer[i], &config);
+	}
+
+	curr_log_buffer = &log_buffer[0];
+#endif
+}
+
+/* Buffer of the CPU we are running on. It does not matter if the thread
+ * migrates right after, the buffers can be used from any CPU.
+ */
+static struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#if defined(CONFIG_LOG_PER_CPU_BUFFERS)
+	return &log_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer[0];
+#endif
+}
+
+/* Buffer a message was allocated from */
+static struct mpsc_pbuf_buffer *msg_buffer(const struct log_msg *msg)
+{
+#if defined(CONFIG_LOG_PER_CPU_BUFFERS)
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)buf32;
+
+	return &log_buffer[offset / sizeof(buf32[0])];
+#else
+	ARG_UNUSED(msg);
+
+	return &log_buffer[0];
 #endif
 }
 
@@ -671,7 +824,7 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
-	return msg_alloc(&log_buffer, wlen);
+	return msg_alloc(local_buffer(), wlen);
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -703,13 +856,13 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
-	msg_commit(&log_buffer, msg);
+	msg_commit(msg_buffer(msg), msg);
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
 {
 #ifdef CONFIG_MPSC_PBUF
-	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
+	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer[0]);
 #else
 	return NULL;
 #endif
@@ -790,7 +943,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) &&
+	    len > 1) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -825,8 +979,9 @@ bool z_log_msg_pending(void)
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
-	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
-		return msg_pending(&log_buffer);
+	if ((!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && !IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) ||
+	    (len == 1)) {
+		return msg_pending(&log_buffer[0]);
 	}
 
 	STRUCT_SECTION_FOREACH(log_msg_ptr, msg_ptr) {
@@ -852,7 +1007,7 @@ void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len
 {
 	struct log_msg *log_msg = (struct log_msg *)data;
 	size_t wlen = DIV_ROUND_UP(ROUND_UP(len, Z_LOG_MSG_ALIGNMENT), sizeof(int));
-	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : &log_buffer;
+	struct mpsc_pbuf_buffer *mpsc_pbuffer = link->mpsc_pbuf ? link->mpsc_pbuf : local_buffer();
 	struct log_msg *local_msg = msg_alloc(mpsc_pbuffer, wlen);
 
 	if (!local_msg) {
@@ -905,7 +1060,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
-	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+	*buf_size = 0;
+	*usage = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t size, used;
+
+		mpsc_pbuf_get_utilization(&log_buffer[i], &size, &used);
+		*buf_size += size;
+		*usage += used;
+	}
 
 	return 0;
 }
@@ -918,7 +1082,24 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
-	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+	/* Sum of the peaks of all the buffers, which may not have
+	 * happened at the same time.
+	 */
+	*max = 0;
+
+	for (int i = 0; i < LOG_BUFFER_CNT; i++) {
+		uint32_t buf_max;
+		int err;
+
+		err = mpsc_pbuf_get_max_utilization(&log_buffer[i], &buf_max);
+		if (err < 0) {
+			return err;
+		}
+
+		*max += buf_max;
+	}
+
+	return 0;
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
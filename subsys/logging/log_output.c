@@ -680,7 +680,9 @@ void log_output_process(const struct log_output *output,
 		postfix_print(output, flags, level);
 	}
 
-	log_output_flush(output);
+	if (!(flags & LOG_OUTPUT_FLAG_NO_FLUSH)) {
+		log_output_flush(output);
+	}
 }
 
 void log_output_msg_process(const struct log_output *output,
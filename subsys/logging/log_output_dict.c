@@ -10,7 +10,185 @@
 #include <zephyr/logging/log_output.h>
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
+
+struct frame_part {
+	const uint8_t *data;
+	size_t len;
+};
+
+static void dict_write(const struct log_output *output, const void *data, size_t len)
+{
+	log_output_write(output->func, (uint8_t *)data, len, (void *)output->control_block->ctx);
+}
+
+#if defined(CONFIG_LOG_DICTIONARY_FRAMING)
+#define FRAME_HASH_BITS 6
+#define FRAME_MIN_MATCH 3
+#define FRAME_MAX_MATCH (0x7F + FRAME_MIN_MATCH)
+#define FRAME_MAX_LITERALS 0x80
+#define FRAME_NO_MATCH UINT16_MAX
+
+BUILD_ASSERT(CONFIG_LOG_DICTIONARY_FRAME_SIZE < FRAME_NO_MATCH);
+
+static void frame_write_hdr(const struct log_output *output, uint8_t flags, size_t len)
+{
+	struct log_dict_output_frame_hdr_t hdr = {
+		.magic = { LOG_DICT_OUTPUT_FRAME_MAGIC0, LOG_DICT_OUTPUT_FRAME_MAGIC1 },
+		.flags = flags,
+		.len = sys_cpu_to_le16(len),
+	};
+
+	dict_write(output, &hdr, sizeof(hdr));
+}
+
+static void frame_write_crc(const struct log_output *output, uint16_t crc)
+{
+	crc = sys_cpu_to_le16(crc);
+	dict_write(output, &crc, sizeof(crc));
+}
+
+#if defined(CONFIG_LOG_DICTIONARY_COMPRESSION)
+static uint32_t frame_hash(const uint8_t *data)
+{
+	uint32_t v = data[0] | (data[1] << 8) | (data[2] << 16);
+
+	return (v * 2654435761U) >> (32 - FRAME_HASH_BITS);
+}
+
+static void frame_write_literals(const struct log_output *output, const uint8_t *data,
+				 size_t len)
+{
+	while (len > 0) {
+		size_t n = MIN(len, FRAME_MAX_LITERALS);
+		uint8_t token = n - 1;
+
+		dict_write(output, &token, sizeof(token));
+		dict_write(output, data, n);
+		data += n;
+		len -= n;
+	}
+}
+
+/* Greedy compression against the last occurrence of each 3 byte sequence.
+ * Literals are written straight from the frame, so the only state is the
+ * hash table.
+ */
+static void frame_write_compressed(const struct log_output *output, const uint8_t *frame,
+				   size_t len)
+{
+	uint16_t table[BIT(FRAME_HASH_BITS)];
+	size_t pos = 0;
+	size_t lit = 0;
+
+	memset(table, 0xFF, sizeof(table));
+
+	while (pos + FRAME_MIN_MATCH <= len) {
+		uint32_t h = frame_hash(&frame[pos]);
+		size_t match = table[h];
+		size_t max = MIN(len - pos, FRAME_MAX_MATCH);
+		size_t mlen = 0;
+
+		table[h] = pos;
+
+		if (match != FRAME_NO_MATCH) {
+			while (mlen < max && frame[match + mlen] == frame[pos + mlen]) {
+				mlen++;
+			}
+		}
+
+		if (mlen < FRAME_MIN_MATCH) {
+			pos++;
+			continue;
+		}
+
+		uint16_t dist = pos - match;
+		uint8_t token[3] = {
+			0x80 | (mlen - FRAME_MIN_MATCH),
+			dist & 0xFF,
+			dist >> 8,
+		};
+
+		frame_write_literals(output, &frame[lit], pos - lit);
+		dict_write(output, token, sizeof(token));
+		pos += mlen;
+		lit = pos;
+	}
+
+	frame_write_literals(output, &frame[lit], len - lit);
+}
+#endif /* CONFIG_LOG_DICTIONARY_COMPRESSION */
+
+static void frame_emit(const struct log_output *output)
+{
+	struct log_output_control_block *cb = output->control_block;
+
+	if (cb->frame_len == 0U) {
+		return;
+	}
+
+#if defined(CONFIG_LOG_DICTIONARY_COMPRESSION)
+	frame_write_hdr(output, LOG_DICT_OUTPUT_FRAME_COMPRESSED, cb->frame_len);
+	frame_write_compressed(output, cb->frame, cb->frame_len);
+#else
+	frame_write_hdr(output, 0, cb->frame_len);
+	dict_write(output, cb->frame, cb->frame_len);
+#endif
+	frame_write_crc(output, crc16_ccitt(0, cb->frame, cb->frame_len));
+
+	cb->frame_len = 0U;
+}
+
+static void dict_put(const struct log_output *output, const struct frame_part *parts,
+		     size_t cnt)
+{
+	struct log_output_control_block *cb = output->control_block;
+	size_t total = 0;
+
+	for (size_t i = 0; i < cnt; i++) {
+		total += parts[i].len;
+	}
+
+	if (total > sizeof(cb->frame) - cb->frame_len) {
+		frame_emit(output);
+	}
+
+	if (total > sizeof(cb->frame)) {
+		/* Too large to be buffered, written as a frame of its own */
+		uint16_t crc = 0;
+
+		frame_write_hdr(output, 0, total);
+		for (size_t i = 0; i < cnt; i++) {
+			dict_write(output, parts[i].data, parts[i].len);
+			crc = crc16_ccitt(crc, parts[i].data, parts[i].len);
+		}
+		frame_write_crc(output, crc);
+	} else {
+		for (size_t i = 0; i < cnt; i++) {
+			memcpy(&cb->frame[cb->frame_len], parts[i].data, parts[i].len);
+			cb->frame_len += parts[i].len;
+		}
+	}
+
+	/* Batch messages as long as more are queued */
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) || !log_data_pending()) {
+		frame_emit(output);
+	}
+}
+#else
+static void dict_put(const struct log_output *output, const struct frame_part *parts,
+		     size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		if (parts[i].len > 0U) {
+			dict_write(output, parts[i].data, parts[i].len);
+		}
+	}
+}
+#endif /* CONFIG_LOG_DICTIONARY_FRAMING */
 
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
@@ -28,20 +206,14 @@ void log_dict_output_msg_process(const struct log_output *output,
 
 	output_hdr.source = (source != NULL) ? log_source_id(source) : 0U;
 
-	log_output_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-			 (void *)output->control_block->ctx);
+	struct frame_part parts[3] = {
+		{ .data = (const uint8_t *)&output_hdr, .len = sizeof(output_hdr) },
+	};
 
-	size_t len;
-	uint8_t *data = log_msg_get_package(msg, &len);
+	parts[1].data = log_msg_get_package(msg, &parts[1].len);
+	parts[2].data = log_msg_get_data(msg, &parts[2].len);
 
-	if (len > 0U) {
-		log_output_write(output->func, data, len, (void *)output->control_block->ctx);
-	}
-
-	data = log_msg_get_data(msg, &len);
-	if (len > 0U) {
-		log_output_write(output->func, data, len, (void *)output->control_block->ctx);
-	}
+	dict_put(output, parts, ARRAY_SIZE(parts));
 
 	log_output_flush(output);
 }
@@ -53,6 +225,7 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	log_output_write(output->func, (uint8_t *)&msg, sizeof(msg),
-			 (void *)output->control_block->ctx);
+	struct frame_part part = { .data = (const uint8_t *)&msg, .len = sizeof(msg) };
+
+	dict_put(output, &part, 1);
 }
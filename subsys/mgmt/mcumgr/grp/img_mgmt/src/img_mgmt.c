@@ -97,6 +97,15 @@ LOG_MODULE_REGISTER(mcumgr_img_grp, CONFIG_MCUMGR_GRP_IMG_LOG_LEVEL);
 
 struct img_mgmt_state g_img_mgmt_state;
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+/* Upload chunks received ahead of the expected offset, free when len is 0 */
+static struct {
+	size_t off;
+	size_t len;
+	uint8_t data[CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNK_SIZE];
+} img_mgmt_reorder[CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS];
+#endif
+
 #ifdef CONFIG_MCUMGR_GRP_IMG_MUTEX
 static K_MUTEX_DEFINE(img_mgmt_mutex);
 #endif
@@ -407,9 +416,90 @@ static void img_mgmt_reset_upload(void)
 	img_mgmt_take_lock();
 	memset(&g_img_mgmt_state, 0, sizeof(g_img_mgmt_state));
 	g_img_mgmt_state.area_id = -1;
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+	g_img_mgmt_state.delta_area_id = -1;
+#endif
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+	for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_reorder); i++) {
+		img_mgmt_reorder[i].len = 0;
+	}
+#endif
 	img_mgmt_release_lock();
 }
 
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+/**
+ * Keeps a chunk of the ongoing upload that arrived ahead of the expected
+ * offset, if there is room for it.
+ */
+static void img_mgmt_reorder_keep(const struct img_mgmt_upload_req *req)
+{
+	int free_slot = -1;
+
+	if (g_img_mgmt_state.area_id < 0 || req->off == SIZE_MAX ||
+	    req->off <= g_img_mgmt_state.off || req->img_data.len == 0 ||
+	    req->img_data.len > sizeof(img_mgmt_reorder[0].data) ||
+	    req->off + req->img_data.len > g_img_mgmt_state.size) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(img_mgmt_reorder); i++) {
+		if (img_mgmt_reorder[i].len == 0) {
+			if (free_slot < 0) {
+				free_slot = i;
+			}
+		} else if (img_mgmt_reorder[i].off == req->off) {
+			/* Already kept */
+			return;
+		}
+	}
+
+	if (free_slot < 0) {
+		LOG_DBG("No room to keep chunk at %08x", req->off);
+		return;
+	}
+
+	img_mgmt_reorder[free_slot].off = req->off;
+	img_mgmt_reorder[free_slot].len = req->img_data.len;
+	memcpy(img_mgmt_reorder[free_slot].data, req->img_data.value, req->img_data.len);
+}
+
+/**
+ * Writes the kept chunks that follow the data written so far.
+ */
+static int img_mgmt_reorder_write(bool *last)
+{
+	bool found;
+	int rc;
+
+	do {
+		found = false;
+
+		for (int i = 0; i < ARRAY_SIZE(img_mgmt_reorder); i++) {
+			size_t len = img_mgmt_reorder[i].len;
+
+			if (len == 0 || img_mgmt_reorder[i].off != g_img_mgmt_state.off) {
+				continue;
+			}
+
+			*last = (g_img_mgmt_state.off + len == g_img_mgmt_state.size);
+			img_mgmt_reorder[i].len = 0;
+
+			rc = img_mgmt_write_image_data(g_img_mgmt_state.off,
+						       img_mgmt_reorder[i].data, len, *last);
+			if (rc != 0) {
+				return rc;
+			}
+
+			g_img_mgmt_state.off += len;
+			found = true;
+		}
+	} while (found);
+
+	return 0;
+}
+#endif
+
 /**
  * Command handler: image erase
  */
@@ -805,6 +895,9 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 		/* Request specifies incorrect offset.  Respond with a success code and
 		 * the correct offset.
 		 */
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+		img_mgmt_reorder_keep(&req);
+#endif
 		rc = img_mgmt_upload_good_rsp(ctxt);
 		img_mgmt_release_lock();
 		return rc;
@@ -846,6 +939,14 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #endif
 
 		g_img_mgmt_state.off = 0;
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+		g_img_mgmt_state.delta_area_id = action.delta_area_id;
+#endif
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+		for (size_t i = 0; i < ARRAY_SIZE(img_mgmt_reorder); i++) {
+			img_mgmt_reorder[i].len = 0;
+		}
+#endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_STATUS_HOOKS)
 		(void)mgmt_callback_notify(MGMT_EVT_OP_IMG_MGMT_DFU_STARTED, NULL, 0, &err_rc,
@@ -897,7 +998,15 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #ifndef CONFIG_IMG_ERASE_PROGRESSIVELY
 		/* erase the entire req.size all at once */
 		if (action.erase) {
-			rc = img_mgmt_erase_image_data(0, req.size);
+			size_t erase_size = req.size;
+
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+			/* A patch does not have the size of the image it produces */
+			if (action.delta_area_id >= 0) {
+				erase_size = action.delta_image_size;
+			}
+#endif
+			rc = img_mgmt_erase_image_data(0, erase_size);
 			if (rc != 0) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(&action,
 					img_mgmt_err_str_flash_erase_failed);
@@ -923,7 +1032,13 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 						    last);
 		if (rc == 0) {
 			g_img_mgmt_state.off += action.write_bytes;
-		} else {
+#if CONFIG_MCUMGR_GRP_IMG_UPLOAD_REORDER_CHUNKS > 0
+			/* Chunks received ahead of this one can follow it now */
+			rc = img_mgmt_reorder_write(&last);
+#endif
+		}
+
+		if (rc != 0) {
 			/* Write failed, currently not able to recover from this */
 #if defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 			cmd_status_arg.status = IMG_MGMT_ID_UPLOAD_STATUS_COMPLETE;
@@ -948,6 +1063,25 @@ defined(CONFIG_MCUMGR_SMP_COMMAND_STATUS_HOOKS)
 #ifdef CONFIG_IMG_ENABLE_IMAGE_CHECK
 			static struct flash_img_context ctx;
 
+#if defined(CONFIG_MCUMGR_GRP_IMG_DELTA)
+			if (g_img_mgmt_state.delta_area_id >= 0) {
+				/* The patch is not in flash, but applying it has checked the
+				 * CRC of the image it produced.
+				 */
+				data_match = true;
+			} else
+#endif
+#if defined(CONFIG_IMG_STREAM_HASH)
+			if (g_img_mgmt_state.written_sha_valid) {
+				/* Hash was computed while writing, no need to read the image */
+				data_match = (memcmp(g_img_mgmt_state.written_sha,
+						     g_img_mgmt_state.data_sha,
+						     IMG_MGMT_DATA_SHA_LEN) == 0);
+				if (!data_match) {
+					LOG_ERR("Uploaded image sha256 hash verification failed");
+				}
+			} else
+#endif
 			if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) == 0) {
 				struct flash_img_check fic = {
 					.match = g_img_mgmt_state.data_sha,
@@ -371,7 +371,55 @@ int img_mgmt_read(int slot, unsigned int offset, void *dst, unsigned int num_byt
 	return 0;
 }
 
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+static struct flash_img_delta img_mgmt_delta;
+#endif
+
+/* Writes the image data, or builds the image out of it when it is a patch */
+static int img_mgmt_write_chunk(struct flash_img_context *ctx, unsigned int offset,
+				const void *data, unsigned int num_bytes, bool last)
+{
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+	if (g_img_mgmt_state.delta_area_id >= 0) {
+		if (offset == 0 &&
+		    flash_img_delta_init(&img_mgmt_delta, ctx,
+					 g_img_mgmt_state.delta_area_id) != 0) {
+			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
+		}
+
+		if (flash_img_delta_write(&img_mgmt_delta, data, num_bytes, last) != 0) {
+			return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
+		}
+
+		return IMG_MGMT_ERR_OK;
+	}
+#endif
+
+	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
+		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
+	}
+
+	return IMG_MGMT_ERR_OK;
+}
+
 #if defined(CONFIG_MCUMGR_GRP_IMG_USE_HEAP_FOR_FLASH_IMG_CONTEXT)
+#ifdef CONFIG_IMG_STREAM_HASH
+/* Keeps the hash of the image data written since the upload started, so the
+ * uploaded image can be verified without reading it back.
+ */
+static void img_mgmt_written_hash(struct flash_img_context *ctx, unsigned int offset, bool last)
+{
+	if (offset == 0) {
+		g_img_mgmt_state.written_sha_valid = false;
+	}
+
+	if (last) {
+		g_img_mgmt_state.written_sha_valid =
+			(flash_img_hash_finish(ctx, g_img_mgmt_state.written_sha) == 0);
+	}
+}
+#endif
+
 int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned int num_bytes,
 			      bool last)
 {
@@ -406,11 +454,15 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		}
 	}
 
-	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
-		rc = IMG_MGMT_ERR_FLASH_WRITE_FAILED;
+	rc = img_mgmt_write_chunk(ctx, offset, data, num_bytes, last);
+	if (rc != IMG_MGMT_ERR_OK) {
 		goto out;
 	}
 
+#ifdef CONFIG_IMG_STREAM_HASH
+	img_mgmt_written_hash(ctx, offset, last);
+#endif
+
 out:
 	if (last || rc != MGMT_ERR_EOK) {
 		k_free(ctx);
@@ -424,6 +476,7 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 			      bool last)
 {
 	static struct flash_img_context ctx;
+	int rc;
 
 	if (offset == 0) {
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
@@ -431,10 +484,15 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 		}
 	}
 
-	if (flash_img_buffered_write(&ctx, data, num_bytes, last) != 0) {
-		return IMG_MGMT_ERR_FLASH_WRITE_FAILED;
+	rc = img_mgmt_write_chunk(&ctx, offset, data, num_bytes, last);
+	if (rc != IMG_MGMT_ERR_OK) {
+		return rc;
 	}
 
+#ifdef CONFIG_IMG_STREAM_HASH
+	img_mgmt_written_hash(&ctx, offset, last);
+#endif
+
 	return IMG_MGMT_ERR_OK;
 }
 #endif
@@ -553,14 +611,42 @@ int img_mgmt_swap_type(int slot)
  * @return 0 if processing should occur; A MGMT_ERR code if an error response should be sent
  *	   instead.
  */
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+/* Recognizes an upload of a patch, which applies to the running image */
+static int img_mgmt_delta_inspect(const struct img_mgmt_upload_req *req,
+				  struct img_mgmt_upload_action *action)
+{
+	struct flash_img_delta_header hdr;
+
+	if (flash_img_delta_parse_header(req->img_data.value, req->img_data.len, &hdr) != 0) {
+		return IMG_MGMT_ERR_OK;
+	}
+
+	action->delta_area_id = img_mgmt_flash_area_id(img_mgmt_active_slot(req->image));
+	if (action->delta_area_id < 0) {
+		LOG_ERR("Failed to determine active slot for image %d: %d", req->image,
+			action->delta_area_id);
+		return IMG_MGMT_ERR_ACTIVE_SLOT_NOT_KNOWN;
+	}
+
+	action->delta_image_size = hdr.target_size;
+
+	return IMG_MGMT_ERR_OK;
+}
+#endif
+
 int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			    struct img_mgmt_upload_action *action)
 {
 	const struct image_header *hdr;
 	struct image_version cur_ver;
+	size_t image_size;
 	int rc;
 
 	memset(action, 0, sizeof(*action));
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+	action->delta_area_id = -1;
+#endif
 
 	if (req->off == SIZE_MAX) {
 		/* Request did not include an `off` field. */
@@ -604,9 +690,23 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		action->size = req->size;
+		image_size = req->size;
 
 		hdr = (struct image_header *)req->img_data.value;
-		if (hdr->ih_magic != IMAGE_MAGIC) {
+#ifdef CONFIG_MCUMGR_GRP_IMG_DELTA
+		rc = img_mgmt_delta_inspect(req, action);
+		if (rc != IMG_MGMT_ERR_OK) {
+			return rc;
+		}
+
+		if (action->delta_area_id >= 0) {
+			/* The image header is not known until the patch is applied */
+			hdr = NULL;
+			image_size = action->delta_image_size;
+		}
+#endif
+
+		if (hdr != NULL && hdr->ih_magic != IMAGE_MAGIC) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action, img_mgmt_err_str_magic_mismatch);
 			LOG_DBG("Magic mismatch: %08X != %08X", hdr->ih_magic, IMAGE_MAGIC);
 			return IMG_MGMT_ERR_INVALID_IMAGE_HEADER_MAGIC;
@@ -648,11 +748,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 		}
 
 		/* Check that the area is of sufficient size to store the new image */
-		if (req->size > fa->fa_size) {
+		if (image_size > fa->fa_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_DBG("Upload too large for slot: %u > %u", req->size,
+			LOG_DBG("Upload too large for slot: %u > %u", image_size,
 				fa->fa_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
@@ -701,11 +801,11 @@ int img_mgmt_upload_inspect(const struct img_mgmt_upload_req *req,
 			goto skip_size_check;
 		}
 
-		if (req->size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
+		if (image_size > (fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE)) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
-			LOG_DBG("Upload too large for slot (with end offset): %u > %u", req->size,
+			LOG_DBG("Upload too large for slot (with end offset): %u > %u", image_size,
 				(fa->fa_size - CONFIG_MCUBOOT_UPDATE_FOOTER_SIZE));
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
@@ -716,18 +816,18 @@ skip_size_check:
 				   sizeof(max_image_size));
 
 		if (rc == sizeof(max_image_size) && max_image_size > 0 &&
-		    req->size > max_image_size) {
+		    image_size > max_image_size) {
 			IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 				img_mgmt_err_str_image_too_large);
 			flash_area_close(fa);
 			LOG_DBG("Upload too large for slot (with max image size): %u > %u",
-				req->size, max_image_size);
+				image_size, max_image_size);
 			return IMG_MGMT_ERR_INVALID_IMAGE_TOO_LARGE;
 		}
 #endif
 
 #if defined(CONFIG_MCUMGR_GRP_IMG_REJECT_DIRECT_XIP_MISMATCHED_SLOT)
-		if (hdr->ih_flags & IMAGE_F_ROM_FIXED) {
+		if (hdr != NULL && (hdr->ih_flags & IMAGE_F_ROM_FIXED)) {
 			if (fa->fa_off != hdr->ih_load_addr) {
 				IMG_MGMT_UPLOAD_ACTION_SET_RC_RSN(action,
 					img_mgmt_err_str_image_bad_flash_addr);
@@ -741,6 +841,11 @@ skip_size_check:
 
 		flash_area_close(fa);
 
+		if (req->upgrade && hdr == NULL) {
+			LOG_DBG("Upgrade-only upload of a patch");
+			return IMG_MGMT_ERR_INVALID_IMAGE_HEADER;
+		}
+
 		if (req->upgrade) {
 			/* User specified upgrade-only. Make sure new image version is
 			 * greater than that of the currently running image.
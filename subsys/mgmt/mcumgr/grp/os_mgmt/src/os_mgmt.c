@@ -230,10 +230,13 @@ os_mgmt_taskstat_encode_stack_info(zcbor_state_t *zse,
 	}
 #endif /* CONFIG_INIT_STACKS */
 #endif /* CONFIG_THREAD_STACK_INFO */
-	ok = zcbor_tstr_put_lit(zse, "stksiz")		&&
-	     zcbor_uint64_put(zse, stack_size)		&&
-	     zcbor_tstr_put_lit(zse, "stkuse")		&&
-	     zcbor_uint64_put(zse, stack_used);
+	static const struct zcbor_encoded_key keys[] = {
+		ZCBOR_ENCODED_KEY("stksiz"),
+		ZCBOR_ENCODED_KEY("stkuse"),
+	};
+	const uint64_t values[] = { stack_size, stack_used };
+
+	ok = zcbor_encoded_uint_map_put(zse, keys, values, ARRAY_SIZE(keys));
 
 	return ok;
 #else
@@ -254,6 +257,10 @@ os_mgmt_taskstat_encode_runtime_info(zcbor_state_t *zse,
 
 	ok = zcbor_tstr_put_lit(zse, "runtime") &&
 	zcbor_uint64_put(zse, thread_stats.execution_cycles);
+
+#ifdef CONFIG_MCUMGR_GRP_OS_TASKSTAT_USAGE_WINDOWS
+	ok = ok && os_mgmt_taskstat_encode_windows(zse, &thread_stats);
+#endif
 #elif !defined(CONFIG_MCUMGR_GRP_OS_TASKSTAT_ONLY_SUPPORTED_STATS)
 	ok = zcbor_tstr_put_lit(zse, "runtime") &&
 	zcbor_uint32_put(zse, 0);
@@ -262,17 +269,61 @@ os_mgmt_taskstat_encode_runtime_info(zcbor_state_t *zse,
 	return ok;
 }
 
+#ifdef CONFIG_MCUMGR_GRP_OS_TASKSTAT_USAGE_WINDOWS
+/* Loads in thousandths over 1, 10 and 60 seconds and burst percentiles */
+static bool os_mgmt_taskstat_encode_windows(zcbor_state_t *zse,
+					    const k_thread_runtime_stats_t *stats)
+{
+	static const struct zcbor_encoded_key keys[] = {
+		ZCBOR_ENCODED_KEY("load1"),
+		ZCBOR_ENCODED_KEY("load10"),
+		ZCBOR_ENCODED_KEY("load60"),
+		ZCBOR_ENCODED_KEY("burst50"),
+		ZCBOR_ENCODED_KEY("burst90"),
+		ZCBOR_ENCODED_KEY("burst99"),
+	};
+	const uint64_t values[] = {
+		stats->window_load[0], stats->window_load[1], stats->window_load[2],
+		stats->burst_cycles[0], stats->burst_cycles[1], stats->burst_cycles[2],
+	};
+
+	return zcbor_encoded_uint_map_put(zse, keys, values, ARRAY_SIZE(keys));
+}
+
+static bool os_mgmt_taskstat_encode_cpus(zcbor_state_t *zse)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	k_thread_runtime_stats_t stats;
+	bool ok;
+
+	ok = zcbor_tstr_put_lit(zse, "cpus") &&
+	     zcbor_list_start_encode(zse, CONFIG_MP_MAX_NUM_CPUS);
+
+	for (unsigned int i = 0; ok && i < num_cpus; i++) {
+		k_thread_runtime_stats_cpu_get(i, &stats);
+
+		ok = zcbor_map_start_encode(zse, 6)			&&
+		     os_mgmt_taskstat_encode_windows(zse, &stats)	&&
+		     zcbor_map_end_encode(zse, 6);
+	}
+
+	return ok && zcbor_list_end_encode(zse, CONFIG_MP_MAX_NUM_CPUS);
+}
+#endif /* CONFIG_MCUMGR_GRP_OS_TASKSTAT_USAGE_WINDOWS */
+
 static inline bool os_mgmt_taskstat_encode_unsupported(zcbor_state_t *zse)
 {
 	bool ok = true;
 
 	if (!IS_ENABLED(CONFIG_MCUMGR_GRP_OS_TASKSTAT_ONLY_SUPPORTED_STATS)) {
-		ok = zcbor_tstr_put_lit(zse, "cswcnt")		&&
-		     zcbor_uint32_put(zse, 0)			&&
-		     zcbor_tstr_put_lit(zse, "last_checkin")	&&
-		     zcbor_uint32_put(zse, 0)			&&
-		     zcbor_tstr_put_lit(zse, "next_checkin")	&&
-		     zcbor_uint32_put(zse, 0);
+		static const struct zcbor_encoded_key keys[] = {
+			ZCBOR_ENCODED_KEY("cswcnt"),
+			ZCBOR_ENCODED_KEY("last_checkin"),
+			ZCBOR_ENCODED_KEY("next_checkin"),
+		};
+		static const uint64_t values[ARRAY_SIZE(keys)];
+
+		ok = zcbor_encoded_uint_map_put(zse, keys, values, ARRAY_SIZE(keys));
 	} else {
 		ARG_UNUSED(zse);
 	}
@@ -289,6 +340,18 @@ os_mgmt_taskstat_encode_priority(zcbor_state_t *zse, const struct k_thread *thre
 		zcbor_uint32_put(zse, (unsigned int)thread->base.prio) & 0xff);
 }
 
+static inline bool
+os_mgmt_taskstat_encode_tid_state(zcbor_state_t *zse, int idx, const struct k_thread *thread)
+{
+	static const struct zcbor_encoded_key keys[] = {
+		ZCBOR_ENCODED_KEY("tid"),
+		ZCBOR_ENCODED_KEY("state"),
+	};
+	const uint64_t values[] = { (uint32_t)idx, thread->base.thread_state };
+
+	return zcbor_encoded_uint_map_put(zse, keys, values, ARRAY_SIZE(keys));
+}
+
 /**
  * Encodes a single taskstat entry.
  */
@@ -306,10 +369,8 @@ static void os_mgmt_taskstat_encode_one(const struct k_thread *thread, void *use
 							    iterator_ctx->thread_idx, thread)	&&
 			zcbor_map_start_encode(iterator_ctx->zse, TASKSTAT_COLUMNS_MAX)		&&
 			os_mgmt_taskstat_encode_priority(iterator_ctx->zse, thread)		&&
-			zcbor_tstr_put_lit(iterator_ctx->zse, "tid")				&&
-			zcbor_uint32_put(iterator_ctx->zse, iterator_ctx->thread_idx)		&&
-			zcbor_tstr_put_lit(iterator_ctx->zse, "state")				&&
-			zcbor_uint32_put(iterator_ctx->zse, thread->base.thread_state)		&&
+			os_mgmt_taskstat_encode_tid_state(iterator_ctx->zse,
+							  iterator_ctx->thread_idx, thread)	&&
 			os_mgmt_taskstat_encode_stack_info(iterator_ctx->zse, thread)		&&
 			os_mgmt_taskstat_encode_runtime_info(iterator_ctx->zse, thread)		&&
 			os_mgmt_taskstat_encode_unsupported(iterator_ctx->zse)			&&
@@ -346,6 +407,12 @@ static int os_mgmt_taskstat_read(struct smp_streamer *ctxt)
 		return MGMT_ERR_EMSGSIZE;
 	}
 
+#ifdef CONFIG_MCUMGR_GRP_OS_TASKSTAT_USAGE_WINDOWS
+	if (!os_mgmt_taskstat_encode_cpus(zse)) {
+		return MGMT_ERR_EMSGSIZE;
+	}
+#endif
+
 	return 0;
 }
 #endif /* CONFIG_MCUMGR_GRP_OS_TASKSTAT */
@@ -127,6 +127,52 @@ bool zcbor_map_decode_bulk_key_found(struct zcbor_map_decode_key_val *map,
  */
 void zcbor_map_decode_bulk_reset(struct zcbor_map_decode_key_val *map, size_t map_size);
 
+/** Longest key ZCBOR_ENCODED_KEY can take, the longest with a single byte header */
+#define ZCBOR_ENCODED_KEY_MAX_LEN 23
+
+struct zcbor_encoded_key {
+	uint8_t header;				/* CBOR text string header */
+	char text[ZCBOR_ENCODED_KEY_MAX_LEN];	/* Key text, not terminated */
+};
+
+/** @brief Define a map key encoded at build time
+ *
+ * The macro creates a single zcbor_encoded_key type object holding the CBOR
+ * text string encoding of @p k, so that putting the key is a copy.
+ *
+ * @param k	key is "" enclosed string representing key, of at most
+ *		ZCBOR_ENCODED_KEY_MAX_LEN characters.
+ */
+#define ZCBOR_ENCODED_KEY(k)						\
+	{								\
+		.header = 0x60 + sizeof(k) - 1,				\
+		.text = k,						\
+	}
+
+/** @brief Encodes map entries with keys encoded at build time and unsigned values.
+ *
+ * The function takes @p keys defined as:
+ *
+ *	static const struct zcbor_encoded_key keys[] = {
+ *		ZCBOR_ENCODED_KEY("key0"),
+ *		ZCBOR_ENCODED_KEY("key1"),
+ *		...
+ *	};
+ *
+ * and puts each of them followed by the value at the same index of @p values,
+ * into a map already opened by the caller. Keys are copied as they are, only
+ * values go through the zcbor integer encoder.
+ *
+ * @param zse		zcbor encoder state;
+ * @param keys		keys encoded with ZCBOR_ENCODED_KEY;
+ * @param values	values of the keys;
+ * @param count		number of keys and of values.
+ *
+ * @return		true on success, false when the payload is too small.
+ */
+bool zcbor_encoded_uint_map_put(zcbor_state_t *zse, const struct zcbor_encoded_key *keys,
+	const uint64_t *values, size_t count);
+
 /** @endcond */
 
 #ifdef __cplusplus
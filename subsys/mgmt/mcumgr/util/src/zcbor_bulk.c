@@ -9,6 +9,7 @@
 
 #include <zcbor_common.h>
 #include <zcbor_decode.h>
+#include <zcbor_encode.h>
 
 #include <mgmt/mcumgr/util/zcbor_bulk.h>
 
@@ -108,3 +109,28 @@ void zcbor_map_decode_bulk_reset(struct zcbor_map_decode_key_val *map, size_t ma
 		map[map_index].found = false;
 	}
 }
+
+bool zcbor_encoded_uint_map_put(zcbor_state_t *zse, const struct zcbor_encoded_key *keys,
+	const uint64_t *values, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		/* Short text strings carry their length in the header byte */
+		size_t len = keys[i].header & 0x1f;
+
+		if ((size_t)(zse->payload_end - zse->payload_mut) < (1 + len)) {
+			zcbor_error(zse, ZCBOR_ERR_NO_PAYLOAD);
+			return false;
+		}
+
+		*zse->payload_mut++ = keys[i].header;
+		memcpy(zse->payload_mut, keys[i].text, len);
+		zse->payload_mut += len;
+		zse->elem_count++;
+
+		if (!zcbor_uint64_put(zse, values[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
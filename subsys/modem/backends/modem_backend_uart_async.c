@@ -12,24 +12,22 @@ LOG_MODULE_REGISTER(modem_backend_uart_async, CONFIG_MODEM_MODULES_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <string.h>
 
+/* Number of buffers the receive buffer is split into, all handed to the UART in turn */
+#define MODEM_BACKEND_UART_ASYNC_RECEIVE_BUF_COUNT 4
+
 enum {
 	MODEM_BACKEND_UART_ASYNC_STATE_TRANSMITTING_BIT,
 	MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT,
-	MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT,
-	MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT,
 	MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT,
 };
 
 static bool modem_backend_uart_async_is_uart_stopped(struct modem_backend_uart *backend)
 {
+	/* The UART releases all its receive buffers before reporting receive disabled */
 	if (!atomic_test_bit(&backend->async.common.state,
 			    MODEM_BACKEND_UART_ASYNC_STATE_TRANSMITTING_BIT) &&
 	    !atomic_test_bit(&backend->async.common.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT) &&
-	    !atomic_test_bit(&backend->async.common.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT) &&
-	    !atomic_test_bit(&backend->async.common.state,
-			    MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT)) {
+			    MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT)) {
 		return true;
 	}
 
@@ -44,15 +42,44 @@ static bool modem_backend_uart_async_is_open(struct modem_backend_uart *backend)
 
 static uint32_t get_receive_buf_length(struct modem_backend_uart *backend)
 {
-	return ring_buf_size_get(&backend->async.receive_rb);
+	return (uint32_t)atomic_get(&backend->async.receive_rx.pending_bytes);
+}
+
+static void modem_backend_uart_async_receive_buf_rsp(struct modem_backend_uart *backend,
+						     uint8_t *buf)
+{
+	struct uart_async_rx *rx = &backend->async.receive_rx;
+	int ret;
+
+	ret = uart_rx_buf_rsp(backend->uart, buf, uart_async_rx_get_buf_len(rx));
+	if (ret == 0) {
+		return;
+	}
+
+	if (ret == -EACCES && modem_backend_uart_async_is_open(backend)) {
+		/* Receiving stopped while waiting for the buffer, start it again */
+		atomic_clear(&backend->async.receive_buf_req_pending);
+		atomic_set_bit(&backend->async.common.state,
+			       MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
+		ret = uart_rx_enable(backend->uart, buf, uart_async_rx_get_buf_len(rx),
+				     CONFIG_MODEM_BACKEND_UART_ASYNC_RECEIVE_IDLE_TIMEOUT_MS * 1000L);
+		if (ret == 0) {
+			return;
+		}
+
+		atomic_clear_bit(&backend->async.common.state,
+				 MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
+	}
+
+	LOG_WRN("Failed to provide receive buffer (%d)", ret);
+	uart_async_rx_on_buf_rel(rx, buf);
 }
 
 static void modem_backend_uart_async_event_handler(const struct device *dev,
 						   struct uart_event *evt, void *user_data)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *) user_data;
-	k_spinlock_key_t key;
-	uint32_t received;
+	uint8_t *buf;
 
 	switch (evt->type) {
 	case UART_TX_DONE:
@@ -72,61 +99,24 @@ static void modem_backend_uart_async_event_handler(const struct device *dev,
 		break;
 
 	case UART_RX_BUF_REQUEST:
-		if (!atomic_test_and_set_bit(&backend->async.common.state,
-					     MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT)) {
-			uart_rx_buf_rsp(backend->uart, backend->async.receive_bufs[0],
-					backend->async.receive_buf_size);
-
-			break;
-		}
-
-		if (!atomic_test_and_set_bit(&backend->async.common.state,
-					     MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT)) {
-			uart_rx_buf_rsp(backend->uart, backend->async.receive_bufs[1],
-					backend->async.receive_buf_size);
-
+		buf = uart_async_rx_buf_req(&backend->async.receive_rx);
+		if (buf == NULL) {
+			/* Provided once received data is consumed */
+			atomic_inc(&backend->async.receive_buf_req_pending);
 			break;
 		}
 
-		LOG_WRN("No receive buffer available");
+		modem_backend_uart_async_receive_buf_rsp(backend, buf);
 		break;
 
 	case UART_RX_BUF_RELEASED:
-		if (evt->data.rx_buf.buf == backend->async.receive_bufs[0]) {
-			atomic_clear_bit(&backend->async.common.state,
-					 MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT);
-
-			break;
-		}
-
-		if (evt->data.rx_buf.buf == backend->async.receive_bufs[1]) {
-			atomic_clear_bit(&backend->async.common.state,
-					 MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF1_USED_BIT);
-
-			break;
-		}
-
-		LOG_WRN("Unknown receive buffer released");
+		uart_async_rx_on_buf_rel(&backend->async.receive_rx, evt->data.rx_buf.buf);
 		break;
 
 	case UART_RX_RDY:
-		key = k_spin_lock(&backend->async.receive_rb_lock);
-		received = ring_buf_put(&backend->async.receive_rb,
-					&evt->data.rx.buf[evt->data.rx.offset],
-					evt->data.rx.len);
-
-		if (received < evt->data.rx.len) {
-			const unsigned int buf_size = get_receive_buf_length(backend);
-
-			ring_buf_reset(&backend->async.receive_rb);
-			k_spin_unlock(&backend->async.receive_rb_lock, key);
-
-			LOG_WRN("Receive buffer overrun (dropped %u + %u)",
-				buf_size - received, (unsigned int)evt->data.rx.len);
-			break;
-		}
-
-		k_spin_unlock(&backend->async.receive_rb_lock, key);
+		/* Received data stays in the UART buffers until consumed */
+		uart_async_rx_on_rdy(&backend->async.receive_rx, evt->data.rx.buf,
+				     evt->data.rx.len);
 		k_work_schedule(&backend->receive_ready_work, K_NO_WAIT);
 		break;
 
@@ -143,7 +133,8 @@ static void modem_backend_uart_async_event_handler(const struct device *dev,
 		break;
 	}
 
-	if (modem_backend_uart_async_is_uart_stopped(backend)) {
+	if (!modem_backend_uart_async_is_open(backend) &&
+	    modem_backend_uart_async_is_uart_stopped(backend)) {
 		k_work_submit(&backend->async.common.rx_disabled_work);
 	}
 }
@@ -151,21 +142,19 @@ static void modem_backend_uart_async_event_handler(const struct device *dev,
 static int modem_backend_uart_async_open(void *data)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
+	struct uart_async_rx *rx = &backend->async.receive_rx;
 	int ret;
 
 	atomic_clear(&backend->async.common.state);
-	ring_buf_reset(&backend->async.receive_rb);
+	atomic_clear(&backend->async.receive_buf_req_pending);
+	uart_async_rx_reset(rx);
 
-	atomic_set_bit(&backend->async.common.state,
-		       MODEM_BACKEND_UART_ASYNC_STATE_RX_BUF0_USED_BIT);
 	atomic_set_bit(&backend->async.common.state, MODEM_BACKEND_UART_ASYNC_STATE_RECEIVING_BIT);
 	atomic_set_bit(&backend->async.common.state, MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT);
 
-	/* Receive buffers are used internally by UART, receive ring buffer is
-	 * used to store received data.
-	 */
-	ret = uart_rx_enable(backend->uart, backend->async.receive_bufs[0],
-			     backend->async.receive_buf_size,
+	/* Received data is read straight from the receive buffers used by UART */
+	ret = uart_rx_enable(backend->uart, uart_async_rx_buf_req(rx),
+			     uart_async_rx_get_buf_len(rx),
 			     CONFIG_MODEM_BACKEND_UART_ASYNC_RECEIVE_IDLE_TIMEOUT_MS * 1000L);
 	if (ret < 0) {
 		atomic_clear(&backend->async.common.state);
@@ -179,7 +168,8 @@ static int modem_backend_uart_async_open(void *data)
 #if CONFIG_MODEM_STATS
 static uint32_t get_receive_buf_size(struct modem_backend_uart *backend)
 {
-	return ring_buf_capacity_get(&backend->async.receive_rb);
+	return uart_async_rx_get_buf_len(&backend->async.receive_rx) *
+	       MODEM_BACKEND_UART_ASYNC_RECEIVE_BUF_COUNT;
 }
 
 static void advertise_transmit_buf_stats(struct modem_backend_uart *backend, uint32_t length)
@@ -239,21 +229,38 @@ static int modem_backend_uart_async_transmit(void *data, const uint8_t *buf, siz
 static int modem_backend_uart_async_receive(void *data, uint8_t *buf, size_t size)
 {
 	struct modem_backend_uart *backend = (struct modem_backend_uart *)data;
-	k_spinlock_key_t key;
-	uint32_t received;
-	bool empty;
-
-	key = k_spin_lock(&backend->async.receive_rb_lock);
+	struct uart_async_rx *rx = &backend->async.receive_rx;
+	bool buf_available = false;
+	uint32_t received = 0;
+	uint8_t *claimed;
+	size_t length;
 
 #if CONFIG_MODEM_STATS
 	advertise_receive_buf_stats(backend);
 #endif
 
-	received = ring_buf_get(&backend->async.receive_rb, buf, size);
-	empty = ring_buf_is_empty(&backend->async.receive_rb);
-	k_spin_unlock(&backend->async.receive_rb_lock, key);
+	/* Received data may continue from the end of one UART buffer into the next */
+	while (received < size) {
+		length = uart_async_rx_data_claim(rx, &claimed, size - received);
+		if (length == 0) {
+			break;
+		}
+
+		memcpy(&buf[received], claimed, length);
+		buf_available = uart_async_rx_data_consume(rx, length);
+		received += length;
+	}
 
-	if (!empty) {
+	if (buf_available && atomic_get(&backend->async.receive_buf_req_pending) > 0) {
+		uint8_t *rx_buf = uart_async_rx_buf_req(rx);
+
+		if (rx_buf != NULL) {
+			atomic_dec(&backend->async.receive_buf_req_pending);
+			modem_backend_uart_async_receive_buf_rsp(backend, rx_buf);
+		}
+	}
+
+	if (get_receive_buf_length(backend) > 0) {
 		k_work_schedule(&backend->receive_ready_work, K_NO_WAIT);
 	}
 
@@ -267,6 +274,12 @@ static int modem_backend_uart_async_close(void *data)
 	atomic_clear_bit(&backend->async.common.state, MODEM_BACKEND_UART_ASYNC_STATE_OPEN_BIT);
 	uart_tx_abort(backend->uart);
 	uart_rx_disable(backend->uart);
+
+	/* Receiving may have stopped already while waiting for a buffer */
+	if (modem_backend_uart_async_is_uart_stopped(backend)) {
+		k_work_submit(&backend->async.common.rx_disabled_work);
+	}
+
 	return 0;
 }
 
@@ -317,16 +330,20 @@ static void init_stats(struct modem_backend_uart *backend)
 int modem_backend_uart_async_init(struct modem_backend_uart *backend,
 				  const struct modem_backend_uart_config *config)
 {
-	uint32_t receive_buf_size_quarter = config->receive_buf_size / 4;
+	int ret;
 
-	/* Use half the receive buffer for UART receive buffers */
-	backend->async.receive_buf_size = receive_buf_size_quarter;
-	backend->async.receive_bufs[0] = &config->receive_buf[0];
-	backend->async.receive_bufs[1] = &config->receive_buf[receive_buf_size_quarter];
+	/* The whole receive buffer is split into the buffers used by UART */
+	backend->async.receive_rx_config = (struct uart_async_rx_config){
+		.buffer = config->receive_buf,
+		.length = config->receive_buf_size,
+		.buf_cnt = MODEM_BACKEND_UART_ASYNC_RECEIVE_BUF_COUNT,
+	};
 
-	/* Use half the receive buffer for the received data ring buffer */
-	ring_buf_init(&backend->async.receive_rb, (receive_buf_size_quarter * 2),
-		      &config->receive_buf[receive_buf_size_quarter * 2]);
+	ret = uart_async_rx_init(&backend->async.receive_rx, &backend->async.receive_rx_config);
+	if (ret < 0) {
+		LOG_ERR("Invalid receive buffer size %u", config->receive_buf_size);
+		return ret;
+	}
 
 	backend->async.common.transmit_buf = config->transmit_buf;
 	backend->async.common.transmit_buf_size = config->transmit_buf_size;
@@ -313,6 +313,63 @@ static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 	}
 }
 
+/* Length of the leading run of bytes which are neither delimiter nor escape code */
+static size_t modem_ppp_plain_run_length(const uint8_t *data, size_t size)
+{
+	const uint32_t ones = 0x01010101U;
+	const uint32_t highs = 0x80808080U;
+	size_t i = 0;
+
+	/* Skip whole words without either code, see "Determine if a word has a zero byte" */
+	for (; (i + sizeof(uint32_t)) <= size; i += sizeof(uint32_t)) {
+		uint32_t word;
+		uint32_t delimiters;
+		uint32_t escapes;
+
+		memcpy(&word, &data[i], sizeof(word));
+		delimiters = word ^ (ones * MODEM_PPP_CODE_DELIMITER);
+		escapes = word ^ (ones * MODEM_PPP_CODE_ESCAPE);
+
+		if ((((delimiters - ones) & ~delimiters) | ((escapes - ones) & ~escapes)) & highs) {
+			break;
+		}
+	}
+
+	for (; i < size; i++) {
+		if ((data[i] == MODEM_PPP_CODE_DELIMITER) || (data[i] == MODEM_PPP_CODE_ESCAPE)) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+/* Writes bytes needing no unescaping to the frame being received, at once */
+static void modem_ppp_process_received_run(struct modem_ppp *ppp, const uint8_t *data,
+					   size_t size)
+{
+	if (net_pkt_available_buffer(ppp->rx_pkt) <= size) {
+		if (net_pkt_alloc_buffer(ppp->rx_pkt, MAX(size, CONFIG_MODEM_PPP_NET_BUF_FRAG_SIZE),
+					 AF_INET, K_NO_WAIT) < 0) {
+			LOG_WRN("Failed to alloc buffer");
+			net_pkt_unref(ppp->rx_pkt);
+			ppp->rx_pkt = NULL;
+			ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+			return;
+		}
+	}
+
+	if (net_pkt_write(ppp->rx_pkt, data, size) < 0) {
+		LOG_WRN("Dropped PPP frame");
+		net_pkt_unref(ppp->rx_pkt);
+		ppp->rx_pkt = NULL;
+		ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+#if defined(CONFIG_NET_STATISTICS_PPP)
+		ppp->stats.drop++;
+#endif
+	}
+}
+
 #if CONFIG_MODEM_STATS
 static uint32_t get_transmit_buf_length(struct modem_ppp *ppp)
 {
@@ -420,8 +477,19 @@ static void modem_ppp_process_handler(struct k_work *item)
 	advertise_receive_buf_stats(ppp, ret);
 #endif
 
-	for (int i = 0; i < ret; i++) {
+	for (int i = 0; i < ret;) {
+		if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_WRITING) {
+			size_t run = modem_ppp_plain_run_length(&ppp->receive_buf[i], ret - i);
+
+			if (run > 0) {
+				modem_ppp_process_received_run(ppp, &ppp->receive_buf[i], run);
+				i += run;
+				continue;
+			}
+		}
+
 		modem_ppp_process_received_byte(ppp, ppp->receive_buf[i]);
+		i++;
 	}
 
 	k_work_submit(&ppp->process_work);
@@ -17,6 +17,9 @@
 LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/net/net_core.h>
@@ -113,6 +116,246 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/** Connection is chained in the hash table */
+#define NET_CONN_HASHED			BIT(7)
+
+/*
+ * Connection handlers of the IP families are also chained by hash key,
+ * each chain being in the order of conn_used. Handlers without a local
+ * port share the key of port 0, others are keyed by protocol and local
+ * port, and connected ones by remote address and port too.
+ *
+ * Which chain a handler is in depends on its NET_CONN_LOCAL_PORT_SPEC,
+ * NET_CONN_REMOTE_PORT_SPEC and NET_CONN_REMOTE_ADDR_SPEC flags, so the
+ * ranks of handlers of different chains always differ. Looking for the
+ * best match in the chains a packet may belong to thus gives the same
+ * result as going through conn_used.
+ *
+ * The table is allocated from a heap sized for CONFIG_NET_MAX_CONN
+ * handlers. Should it still run out of memory, handlers which could not
+ * be hashed are counted, and lookups go through conn_used as long as
+ * there are any.
+ */
+#define CONN_HASH_BUCKETS							\
+	(2 * NHPOT(DIV_ROUND_UP(CONFIG_NET_MAX_CONN * 100,			\
+				SYS_HASHMAP_DEFAULT_LOAD_FACTOR)))
+#define CONN_HASH_ENTRY_SIZE							\
+	(2 * sizeof(uint64_t) + sizeof(sys_dnode_t) + 2 * sizeof(void *))
+#define CONN_HASH_HEAP_SIZE							\
+	(Z_HEAP_MIN_SIZE + CONFIG_NET_MAX_CONN * CONN_HASH_ENTRY_SIZE +		\
+	 2 * CONN_HASH_BUCKETS * (sizeof(sys_dlist_t) + sizeof(void *)))
+
+static uint8_t conn_hash_mem[CONN_HASH_HEAP_SIZE] __aligned(8);
+static struct sys_heap conn_hash_heap;
+static size_t conn_unhashed;
+
+static void *conn_hash_alloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		sys_heap_free(&conn_hash_heap, ptr);
+		return NULL;
+	}
+
+	return sys_heap_realloc(&conn_hash_heap, ptr, size);
+}
+
+SYS_HASHMAP_SC_DEFINE_STATIC_ADVANCED(conn_hash, sys_hash32, conn_hash_alloc,
+				      SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN,
+							 SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static inline bool conn_is_hashable(struct net_conn *conn)
+{
+	return conn->family == AF_INET || conn->family == AF_INET6 ||
+	       conn->family == AF_UNSPEC;
+}
+
+/* Ports are in network byte order, remote_addr may be NULL */
+static uint64_t conn_hash_key(uint16_t proto, uint16_t local_port,
+			      const uint8_t *remote_addr, size_t addr_len,
+			      uint16_t remote_port)
+{
+	uint64_t key = ((uint64_t)proto << 48) | ((uint64_t)local_port << 32);
+
+	if (remote_addr != NULL) {
+		uint32_t fold = (uint32_t)remote_port << 16;
+
+		for (size_t i = 0; i < addr_len; i += sizeof(uint32_t)) {
+			fold ^= sys_get_le32(&remote_addr[i]);
+		}
+
+		key |= fold;
+	}
+
+	return key;
+}
+
+static uint64_t conn_key(struct net_conn *conn)
+{
+	const uint32_t connected = NET_CONN_LOCAL_PORT_SPEC | NET_CONN_REMOTE_PORT_SPEC |
+				   NET_CONN_REMOTE_ADDR_SPEC;
+	const uint8_t *addr = NULL;
+	size_t addr_len = 0;
+
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) == 0U) {
+		return conn_hash_key(conn->proto, 0U, NULL, 0, 0U);
+	}
+
+	if ((conn->flags & connected) == connected) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    conn->remote_addr.sa_family == AF_INET6) {
+			addr = (const uint8_t *)&net_sin6(&conn->remote_addr)->sin6_addr;
+			addr_len = sizeof(struct in6_addr);
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   conn->remote_addr.sa_family == AF_INET) {
+			addr = (const uint8_t *)&net_sin(&conn->remote_addr)->sin_addr;
+			addr_len = sizeof(struct in_addr);
+		}
+	}
+
+	return conn_hash_key(conn->proto, net_sin(&conn->local_addr)->sin_port,
+			     addr, addr_len,
+			     addr != NULL ? net_sin(&conn->remote_addr)->sin_port : 0U);
+}
+
+/* Get the keys of all the chains which may hold matching handlers */
+static size_t conn_hash_keys(uint64_t keys[3], uint16_t proto, uint16_t local_port,
+			     const uint8_t *remote_addr, size_t addr_len,
+			     uint16_t remote_port)
+{
+	size_t count = 0;
+
+	if (local_port != 0U) {
+		if (remote_addr != NULL) {
+			keys[count++] = conn_hash_key(proto, local_port, remote_addr,
+						      addr_len, remote_port);
+		}
+
+		keys[count] = conn_hash_key(proto, local_port, NULL, 0, 0U);
+		if (count == 0 || keys[count] != keys[0]) {
+			count++;
+		}
+	}
+
+	keys[count++] = conn_hash_key(proto, 0U, NULL, 0, 0U);
+
+	return count;
+}
+
+static struct net_conn *conn_hash_head(uint64_t key)
+{
+	uint64_t value;
+
+	if (!sys_hashmap_get(&conn_hash, key, &value)) {
+		return NULL;
+	}
+
+	return (struct net_conn *)(uintptr_t)value;
+}
+
+/* Insert a handler after prev in its chain, or at its head if prev is NULL */
+static void conn_hash_insert(struct net_conn *conn, uint64_t key,
+			     struct net_conn *prev)
+{
+	conn->hash_key = key;
+
+	if (prev != NULL) {
+		conn->hash_next = prev->hash_next;
+		prev->hash_next = conn;
+	} else {
+		conn->hash_next = conn_hash_head(key);
+
+		if (sys_hashmap_insert(&conn_hash, key, (uintptr_t)conn, NULL) < 0) {
+			NET_DBG("[%zu] connection handler %p not hashed",
+				conn - conns, conn);
+			conn->hash_next = NULL;
+			conn_unhashed++;
+			return;
+		}
+	}
+
+	conn->flags |= NET_CONN_HASHED;
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	struct net_conn *prev;
+
+	if ((conn->flags & NET_CONN_HASHED) == 0U) {
+		if (conn_is_hashable(conn)) {
+			conn_unhashed--;
+		}
+
+		return;
+	}
+
+	prev = conn_hash_head(conn->hash_key);
+	if (prev == conn) {
+		if (conn->hash_next != NULL) {
+			/* Existing key, this does not allocate */
+			(void)sys_hashmap_insert(&conn_hash, conn->hash_key,
+						 (uintptr_t)conn->hash_next, NULL);
+		} else {
+			(void)sys_hashmap_remove(&conn_hash, conn->hash_key, NULL);
+		}
+	} else {
+		while (prev->hash_next != conn) {
+			prev = prev->hash_next;
+		}
+
+		prev->hash_next = conn->hash_next;
+	}
+
+	conn->hash_next = NULL;
+	conn->flags &= ~NET_CONN_HASHED;
+}
+
+/* New handlers are first in conn_used, so at the head of their chain too */
+static void conn_hash_add(struct net_conn *conn)
+{
+	if (conn_is_hashable(conn)) {
+		conn_hash_insert(conn, conn_key(conn), NULL);
+	}
+}
+
+/* Move a handler to the chain of its updated addresses */
+static void conn_hash_update(struct net_conn *conn)
+{
+	uint64_t key = conn_key(conn);
+	struct net_conn *prev = NULL;
+	struct net_conn *tmp;
+
+	if (!conn_is_hashable(conn) ||
+	    ((conn->flags & NET_CONN_HASHED) != 0U && conn->hash_key == key)) {
+		return;
+	}
+
+	conn_hash_remove(conn);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, tmp, node) {
+		if (tmp == conn) {
+			break;
+		}
+
+		if ((tmp->flags & NET_CONN_HASHED) != 0U && tmp->hash_key == key) {
+			prev = tmp;
+		}
+	}
+
+	conn_hash_insert(conn, key, prev);
+}
+
+static void conn_hash_init(void)
+{
+	sys_heap_init(&conn_hash_heap, conn_hash_mem, sizeof(conn_hash_mem));
+}
+#else
+#define conn_hash_add(conn)
+#define conn_hash_remove(conn)
+#define conn_hash_update(conn)
+#define conn_hash_init()
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -138,6 +381,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -150,6 +394,109 @@ static void conn_set_unused(struct net_conn *conn)
 	k_mutex_unlock(&conn_lock);
 }
 
+static bool conn_handler_match(struct net_conn *conn, struct net_if *iface,
+			       uint16_t proto, uint8_t family,
+			       const struct sockaddr *remote_addr,
+			       const struct sockaddr *local_addr,
+			       uint16_t remote_port,
+			       uint16_t local_port,
+			       bool reuseport_set)
+{
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	if (conn->family != family) {
+		return false;
+	}
+
+	if (local_addr) {
+		if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+			return false;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    local_addr->sa_family == AF_INET6 &&
+		    local_addr->sa_family ==
+		    conn->local_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(local_addr)->sin6_addr,
+				    &net_sin6(&conn->local_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   local_addr->sa_family == AF_INET &&
+			   local_addr->sa_family ==
+			   conn->local_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(local_addr)->sin_addr,
+				    &net_sin(&conn->local_addr)->
+							sin_addr)) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+	} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
+		return false;
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port !=
+	    htons(local_port)) {
+		return false;
+	}
+
+	if (remote_addr) {
+		if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+			return false;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    remote_addr->sa_family == AF_INET6 &&
+		    remote_addr->sa_family ==
+		    conn->remote_addr.sa_family) {
+			if (!net_ipv6_addr_cmp(
+				    &net_sin6(remote_addr)->sin6_addr,
+				    &net_sin6(&conn->remote_addr)->
+							sin6_addr)) {
+				return false;
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			   remote_addr->sa_family == AF_INET &&
+			   remote_addr->sa_family ==
+			   conn->remote_addr.sa_family) {
+			if (!net_ipv4_addr_cmp(
+				    &net_sin(remote_addr)->sin_addr,
+				    &net_sin(&conn->remote_addr)->
+							sin_addr)) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+	} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
+		return false;
+	} else if (reuseport_set && conn->context != NULL &&
+		   net_context_is_reuseport_set(conn->context)) {
+		return false;
+	}
+
+	if (net_sin(&conn->remote_addr)->sin_port !=
+	    htons(remote_port)) {
+		return false;
+	}
+
+	if (conn->context != NULL && iface != NULL &&
+	    net_context_is_bound_to_iface(conn->context)) {
+		if (iface != net_context_get_iface(conn->context)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /* Check if we already have identical connection handler installed. */
 static struct net_conn *conn_find_handler(struct net_if *iface,
 					  uint16_t proto, uint8_t family,
@@ -160,109 +507,59 @@ static struct net_conn *conn_find_handler(struct net_if *iface,
 					  bool reuseport_set)
 {
 	struct net_conn *conn;
-	struct net_conn *tmp;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&conn_used, conn, tmp, node) {
-		if (conn->proto != proto) {
-			continue;
-		}
-
-		if (conn->family != family) {
-			continue;
+#if defined(CONFIG_NET_CONN_HASH)
+	if (conn_unhashed == 0U) {
+		const uint8_t *addr = NULL;
+		size_t addr_len = 0;
+		uint64_t keys[3];
+		size_t count;
+
+		if (remote_addr == NULL) {
+			/* No remote address to hash */
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) && remote_addr->sa_family == AF_INET6) {
+			addr = (const uint8_t *)&net_sin6(remote_addr)->sin6_addr;
+			addr_len = sizeof(struct in6_addr);
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) && remote_addr->sa_family == AF_INET) {
+			addr = (const uint8_t *)&net_sin(remote_addr)->sin_addr;
+			addr_len = sizeof(struct in_addr);
 		}
 
-		if (local_addr) {
-			if (!(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
-				continue;
-			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    local_addr->sa_family == AF_INET6 &&
-			    local_addr->sa_family ==
-			    conn->local_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(local_addr)->sin6_addr,
-					    &net_sin6(&conn->local_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   local_addr->sa_family == AF_INET &&
-				   local_addr->sa_family ==
-				   conn->local_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(local_addr)->sin_addr,
-					    &net_sin(&conn->local_addr)->
-								sin_addr)) {
-					continue;
+		count = conn_hash_keys(keys, proto, htons(local_port), addr, addr_len,
+				       htons(remote_port));
+
+		for (size_t i = 0; i < count; i++) {
+			for (conn = conn_hash_head(keys[i]); conn != NULL;
+			     conn = conn->hash_next) {
+				if (conn_handler_match(conn, iface, proto, family,
+						       remote_addr, local_addr,
+						       remote_port, local_port,
+						       reuseport_set)) {
+					goto out;
 				}
-			} else {
-				continue;
 			}
-		} else if (conn->flags & NET_CONN_LOCAL_ADDR_SET) {
-			continue;
 		}
 
-		if (net_sin(&conn->local_addr)->sin_port !=
-		    htons(local_port)) {
-			continue;
-		}
-
-		if (remote_addr) {
-			if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
-				continue;
-			}
-
-			if (IS_ENABLED(CONFIG_NET_IPV6) &&
-			    remote_addr->sa_family == AF_INET6 &&
-			    remote_addr->sa_family ==
-			    conn->remote_addr.sa_family) {
-				if (!net_ipv6_addr_cmp(
-					    &net_sin6(remote_addr)->sin6_addr,
-					    &net_sin6(&conn->remote_addr)->
-								sin6_addr)) {
-					continue;
-				}
-			} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
-				   remote_addr->sa_family == AF_INET &&
-				   remote_addr->sa_family ==
-				   conn->remote_addr.sa_family) {
-				if (!net_ipv4_addr_cmp(
-					    &net_sin(remote_addr)->sin_addr,
-					    &net_sin(&conn->remote_addr)->
-								sin_addr)) {
-					continue;
-				}
-			} else {
-				continue;
-			}
-		} else if (conn->flags & NET_CONN_REMOTE_ADDR_SET) {
-			continue;
-		} else if (reuseport_set && conn->context != NULL &&
-			   net_context_is_reuseport_set(conn->context)) {
-			continue;
-		}
-
-		if (net_sin(&conn->remote_addr)->sin_port !=
-		    htons(remote_port)) {
-			continue;
-		}
+		conn = NULL;
+		goto out;
+	}
+#endif /* CONFIG_NET_CONN_HASH */
 
-		if (conn->context != NULL && iface != NULL &&
-		    net_context_is_bound_to_iface(conn->context)) {
-			if (iface != net_context_get_iface(conn->context)) {
-				continue;
-			}
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+		if (conn_handler_match(conn, iface, proto, family,
+				       remote_addr, local_addr,
+				       remote_port, local_port,
+				       reuseport_set)) {
+			goto out;
 		}
-
-		k_mutex_unlock(&conn_lock);
-		return conn;
 	}
 
+	conn = NULL;
+out:
 	k_mutex_unlock(&conn_lock);
-	return NULL;
+	return conn;
 }
 
 static void net_conn_change_callback(struct net_conn *conn,
@@ -283,6 +580,8 @@ static int net_conn_change_remote(struct net_conn *conn,
 		conn - conns, conn);
 
 	if (remote_addr) {
+		conn->flags &= ~NET_CONN_REMOTE_ADDR_SPEC;
+
 		if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		    remote_addr->sa_family == AF_INET6) {
 			memcpy(&conn->remote_addr, remote_addr,
@@ -330,6 +629,8 @@ static int net_conn_change_local(struct net_conn *conn,
 		conn - conns, conn);
 
 	if (local_addr != NULL) {
+		conn->flags &= ~NET_CONN_LOCAL_ADDR_SPEC;
+
 		if (IS_ENABLED(CONFIG_NET_IPV6) &&
 		    local_addr->sa_family == AF_INET6) {
 			memcpy(&conn->local_addr, local_addr,
@@ -463,6 +764,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -489,15 +791,21 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_local(conn, local_addr, local_port);
 	if (ret < 0) {
-		return ret;
+		goto out;
 	}
 
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
 
+out:
+	conn_hash_update(conn);
+	k_mutex_unlock(&conn_lock);
+
 	return ret;
 }
 
@@ -873,6 +1181,129 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+/* Is the candidate connection matching the TCP/UDP packet? */
+static bool conn_input_match(struct net_conn *conn, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+	uint8_t conn_family = conn->family;
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return false; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn_family != AF_UNSPEC && conn_family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn_family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only && conn->type != SOCK_RAW)) {
+				return false;
+			}
+		} else {
+			return false; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	/* Apply protocol-specific matching criteria... */
+	if (!(IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) ||
+	    !(conn_family == AF_INET || conn_family == AF_INET6 ||
+	      conn_family == AF_UNSPEC)) {
+		return false;
+	}
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn_family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Find the best match of a unicast packet, unless some handlers are unhashed */
+static bool conn_hash_lookup(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			     uint8_t proto, uint16_t src_port, uint16_t dst_port,
+			     struct net_conn **best_match)
+{
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	uint64_t keys[3];
+	size_t count;
+
+	if (conn_unhashed > 0U) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		count = conn_hash_keys(keys, proto, dst_port, ip_hdr->ipv6->src,
+				       sizeof(struct in6_addr), src_port);
+	} else {
+		count = conn_hash_keys(keys, proto, dst_port, ip_hdr->ipv4->src,
+				       sizeof(struct in_addr), src_port);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		for (conn = conn_hash_head(keys[i]); conn != NULL; conn = conn->hash_next) {
+			if (best_rank < NET_CONN_RANK(conn->flags) &&
+			    conn_input_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				*best_match = conn;
+			}
+		}
+	}
+
+	return true;
+}
+#else
+#define conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port, best_match) false
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -938,119 +1369,56 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+	if (!is_mcast_pkt &&
+	    conn_hash_lookup(pkt, ip_hdr, proto, src_port, dst_port, &best_match)) {
+		goto unlock;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
+		if (!conn_input_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+			continue;
 		}
 
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-				      !conn->v6only && conn->type != SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
-
-			/* We might have a match for v4-to-v6 mapping, check more */
-		}
+		if (best_rank < NET_CONN_RANK(conn->flags)) {
+			struct net_pkt *mcast_pkt;
 
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
-		}
+			if (!is_mcast_pkt) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
 
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
+				continue; /* found a match - but maybe not yet the best */
+			}
 
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == AF_INET || conn_family == AF_INET6 ||
-		     conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
+			/* If we have a multicast packet, and we found
+			 * a match, then deliver the packet immediately
+			 * to the handler. As there might be several
+			 * sockets interested about these, we need to
+			 * clone the received pkt.
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
 
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
+			NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
+				conn->user_data);
 
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
+			mcast_pkt = net_pkt_clone(
+				pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
+			if (!mcast_pkt) {
+				k_mutex_unlock(&conn_lock);
+				goto drop;
 			}
 
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
+			    NET_DROP) {
+				net_stats_update_per_proto_drop(pkt_iface, proto);
+				net_pkt_unref(mcast_pkt);
+			} else {
+				net_stats_update_per_proto_recv(pkt_iface, proto);
 			}
 
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
-
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
-				}
-
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
-
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
-
-				mcast_pkt = net_pkt_clone(
-					pkt, K_MSEC(CONFIG_NET_CONN_PACKET_CLONE_TIMEOUT));
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
-
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
-				}
-
-				mcast_pkt_delivered = true;
-			}
+			mcast_pkt_delivered = true;
 		}
 	} /* loop end */
 
+unlock:
 	if (best_match != NULL) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -1119,6 +1487,7 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	conn_hash_init();
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -85,6 +85,14 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Next connection with the same hash key */
+	struct net_conn *hash_next;
+
+	/** Hash key of the connection, see conn_hash_key() */
+	uint64_t hash_key;
+#endif /* CONFIG_NET_CONN_HASH */
 };
 
 /**
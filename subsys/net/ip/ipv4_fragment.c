@@ -141,6 +141,7 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 {
 	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
 	struct net_ipv4_hdr *ipv4_hdr;
+	uint16_t old_len, old_offset;
 	struct net_pkt *pkt;
 	struct net_buf *last;
 	int i;
@@ -196,12 +197,20 @@ static void reassemble_packet(struct net_ipv4_reassembly *reass)
 		goto error;
 	}
 
-	/* Fix the total length, offset and checksum of the IPv4 packet */
+	/* Fix the total length, offset and checksum of the IPv4 packet. The
+	 * header checksum of the first fragment was valid, so only account
+	 * for the fields changed.
+	 */
+	old_len = ipv4_hdr->len;
+	memcpy(&old_offset, ipv4_hdr->offset, sizeof(old_offset));
+
 	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
 	ipv4_hdr->offset[0] = 0;
 	ipv4_hdr->offset[1] = 0;
-	ipv4_hdr->chksum = 0;
-	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+	ipv4_hdr->chksum = net_calc_chksum_update(ipv4_hdr->chksum, old_len,
+						  ipv4_hdr->len);
+	ipv4_hdr->chksum = net_calc_chksum_update(ipv4_hdr->chksum, old_offset,
+						  0U);
 
 	net_pkt_set_data(pkt, &ipv4_access);
 	net_pkt_set_ip_reassembled(pkt, true);
@@ -624,9 +633,10 @@ enum net_verdict net_ipv4_prepare_for_send_fragment(struct net_pkt *pkt)
 	}
 
 	/* If we have already fragmented the packet, the ID field will contain a non-zero value
-	 * and we can skip other checks.
+	 * and we can skip other checks. TCP packets built for segmentation offload are split
+	 * by L2 instead.
 	 */
-	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0) {
+	if (ip_hdr->id[0] == 0 && ip_hdr->id[1] == 0 && net_pkt_tso_mss(pkt) == 0U) {
 		size_t pkt_len = net_pkt_get_len(pkt);
 		uint16_t mtu;
 
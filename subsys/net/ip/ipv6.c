@@ -322,6 +322,18 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	struct net_route_entry *route;
 	struct in6_addr *nexthop;
 	bool found;
+	int ret;
+
+	/* A flow already forwarded via a neighbor has passed the checks
+	 * below, so send it to the same neighbor right away.
+	 */
+	ret = net_route_packet_cached(pkt);
+	if (ret == 0) {
+		return NET_OK;
+	} else if (ret != -ENOENT) {
+		NET_DBG("Cannot forward pkt %p from cache (%d)", pkt, ret);
+		goto drop;
+	}
 
 	/* Check if the packet can be routed */
 	if (IS_ENABLED(CONFIG_NET_ROUTING)) {
@@ -334,8 +346,6 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 	}
 
 	if (found) {
-		int ret;
-
 		if (IS_ENABLED(CONFIG_NET_ROUTING) &&
 		    (net_ipv6_is_ll_addr((struct in6_addr *)hdr->src) ||
 		     net_ipv6_is_ll_addr((struct in6_addr *)hdr->dst))) {
@@ -380,7 +390,6 @@ static enum net_verdict ipv6_route_packet(struct net_pkt *pkt,
 		}
 	} else {
 		struct net_if *iface = NULL;
-		int ret;
 
 		if (net_if_ipv6_addr_onlink(&iface, (struct in6_addr *)hdr->dst)) {
 			ret = net_route_packet_if(pkt, iface);
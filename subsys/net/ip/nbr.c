@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_nbr, CONFIG_NET_IPV6_NBR_CACHE_LOG_LEVEL);
 #include "net_private.h"
 
 #include "nbr.h"
+#include "route.h"
 
 NET_NBR_LLADDR_INIT(net_neighbor_lladdr, CONFIG_NET_IPV6_MAX_NEIGHBORS);
 
@@ -35,6 +36,8 @@ void net_nbr_unref(struct net_nbr *nbr)
 		return;
 	}
 
+	net_route_fwd_cache_flush();
+
 	if (nbr->remove) {
 		nbr->remove(nbr);
 	}
@@ -108,6 +111,8 @@ int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
 			nbr->idx = i;
 			nbr->iface = iface;
 
+			net_route_fwd_cache_flush();
+
 			return 0;
 		}
 	}
@@ -130,6 +135,8 @@ int net_nbr_link(struct net_nbr *nbr, struct net_if *iface,
 
 	nbr->iface = iface;
 
+	net_route_fwd_cache_flush();
+
 	return 0;
 }
 
@@ -154,6 +161,8 @@ int net_nbr_unlink(struct net_nbr *nbr, struct net_linkaddr *lladdr)
 	nbr->idx = NET_NBR_LLADDR_UNKNOWN;
 	nbr->iface = NULL;
 
+	net_route_fwd_cache_flush();
+
 	return 0;
 }
 
@@ -1726,6 +1726,21 @@ static int get_context_rcvbuf(struct net_context *context,
 #endif
 }
 
+static int get_context_busy_poll(struct net_context *context,
+				 void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_BUSY_POLL)
+	return get_uint16_option(context->options.busy_poll,
+				 value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int get_context_sndbuf(struct net_context *context,
 				void *value, size_t *len)
 {
@@ -2865,6 +2880,33 @@ int net_context_sendmsg(struct net_context *context,
 	return ret;
 }
 
+int net_context_send_zerocopy(struct net_context *context,
+			      const void *buf,
+			      size_t len,
+			      net_context_zerocopy_cb_t cb,
+			      void *user_data)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_ZEROCOPY) ||
+	    net_context_get_proto(context) != IPPROTO_TCP ||
+	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
+		return -EOPNOTSUPP;
+	}
+
+	if (cb == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = net_tcp_queue_zerocopy(context, buf, len, cb, user_data);
+
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 int net_context_sendto(struct net_context *context,
 		       const void *buf,
 		       size_t len,
@@ -3391,6 +3433,20 @@ static int set_context_rcvbuf(struct net_context *context,
 #endif
 }
 
+static int set_context_busy_poll(struct net_context *context,
+				 const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_BUSY_POLL)
+	return set_uint16_option(&context->options.busy_poll, value, len);
+#else
+	ARG_UNUSED(context);
+	ARG_UNUSED(value);
+	ARG_UNUSED(len);
+
+	return -ENOTSUP;
+#endif
+}
+
 static int set_context_sndbuf(struct net_context *context,
 				const void *value, size_t len)
 {
@@ -3867,6 +3923,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_IPV4_MCAST_LOOP:
 		ret = set_context_ipv4_mcast_loop(context, value, len);
 		break;
+	case NET_OPT_BUSY_POLL:
+		ret = set_context_busy_poll(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -3958,6 +4017,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_IPV4_MCAST_LOOP:
 		ret = get_context_ipv4_mcast_loop(context, value, len);
 		break;
+	case NET_OPT_BUSY_POLL:
+		ret = get_context_busy_poll(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -37,6 +37,9 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #if defined(CONFIG_NET_LLDP)
 #include <zephyr/net/lldp.h>
 #endif
+#if defined(CONFIG_OPENTHREAD_RADIO_RX_DIRECT)
+#include <zephyr/net/openthread.h>
+#endif
 
 #include "net_private.h"
 #include "shell/net_shell.h"
@@ -518,6 +521,24 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
+/* Radio frames only go through the OpenThread L2 on their way to the
+ * OpenThread thread, which has its own queue. Packets OpenThread injects back
+ * from its thread and reassembled ones take the RX queue as usual.
+ */
+static bool net_rx_is_direct(struct net_if *iface, struct net_pkt *pkt)
+{
+#if defined(CONFIG_OPENTHREAD_RADIO_RX_DIRECT)
+	return net_if_l2(iface) == &NET_L2_GET_NAME(OPENTHREAD) &&
+	       !net_pkt_is_ip_reassembled(pkt) &&
+	       k_current_get() != openthread_thread_id_get();
+#else
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return false;
+#endif /* CONFIG_OPENTHREAD_RADIO_RX_DIRECT */
+}
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	size_t len = net_pkt_get_len(pkt);
@@ -529,7 +550,8 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 
 	if ((IS_ENABLED(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO) &&
-	     prio >= NET_PRIORITY_CA) || NET_TC_RX_COUNT == 0) {
+	     prio >= NET_PRIORITY_CA) || NET_TC_RX_COUNT == 0 ||
+	    net_rx_is_direct(iface, pkt)) {
 		net_process_rx_packet(pkt);
 	} else {
 		if (net_tc_submit_to_rx_queue(tc, pkt) != NET_OK) {
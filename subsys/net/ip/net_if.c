@@ -397,6 +397,8 @@ void net_if_stats_reset(struct net_if *iface)
 		if (iface == tmp) {
 			net_if_lock(iface);
 			memset(&iface->stats, 0, sizeof(iface->stats));
+			IF_ENABLED(CONFIG_NET_STATISTICS_PER_CPU,
+				   (memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));))
 			net_if_unlock(iface);
 			return;
 		}
@@ -412,6 +414,8 @@ void net_if_stats_reset_all(void)
 	STRUCT_SECTION_FOREACH(net_if, iface) {
 		net_if_lock(iface);
 		memset(&iface->stats, 0, sizeof(iface->stats));
+		IF_ENABLED(CONFIG_NET_STATISTICS_PER_CPU,
+			   (memset(iface->stats_cpu, 0, sizeof(iface->stats_cpu));))
 		net_if_unlock(iface);
 	}
 #endif
@@ -138,6 +138,15 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_BUF_DATA_
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT, CONFIG_NET_BUF_DATA_SIZE,
 			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
 
+#if defined(CONFIG_NET_PKT_INLINE_DATA)
+NET_BUF_POOL_FIXED_DEFINE(rx_inline_bufs, CONFIG_NET_PKT_INLINE_DATA_RX_COUNT,
+			  CONFIG_NET_PKT_INLINE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(tx_inline_bufs, CONFIG_NET_PKT_INLINE_DATA_TX_COUNT,
+			  CONFIG_NET_PKT_INLINE_DATA_SIZE,
+			  CONFIG_NET_PKT_BUF_USER_DATA_SIZE, NULL);
+#endif /* CONFIG_NET_PKT_INLINE_DATA */
+
 #else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT, CONFIG_NET_PKT_BUF_RX_DATA_POOL_SIZE,
@@ -295,6 +304,14 @@ const char *net_pkt_pool2str(struct net_buf_pool *pool)
 		return "TDATA";
 	}
 
+#if defined(CONFIG_NET_PKT_INLINE_DATA)
+	if (pool == &rx_inline_bufs) {
+		return "RINLINE";
+	} else if (pool == &tx_inline_bufs) {
+		return "TINLINE";
+	}
+#endif
+
 	return "EDATA";
 }
 
@@ -616,6 +633,65 @@ done:
 	k_mem_slab_free(pkt->slab, (void *)pkt);
 }
 
+/* Number of buffer chains handed back to their pools at once */
+#define PKT_BULK_BATCH 16
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+void net_pkt_unref_bulk_debug(struct net_pkt **pkts, int count,
+			      const char *caller, int line)
+{
+	/* Keep the allocation tracking of the single packet path */
+	for (int i = 0; i < count; i++) {
+		net_pkt_unref_debug(pkts[i], caller, line);
+	}
+}
+#else
+void net_pkt_unref_bulk(struct net_pkt **pkts, int count)
+{
+	struct net_buf *frags[PKT_BULK_BATCH];
+	int n = 0;
+
+	for (int i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+		atomic_val_t ref;
+
+		if (!pkt) {
+			continue;
+		}
+
+		do {
+			ref = atomic_get(&pkt->atomic_ref);
+			if (!ref) {
+				break;
+			}
+		} while (!atomic_cas(&pkt->atomic_ref, ref, ref - 1));
+
+		if (ref != 1) {
+			continue;
+		}
+
+		if (pkt->frags) {
+			if (n == ARRAY_SIZE(frags)) {
+				net_buf_unref_bulk(frags, n);
+				n = 0;
+			}
+
+			frags[n++] = pkt->frags;
+			pkt->frags = NULL;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_DEBUG_NET_PKT_NON_FRAGILE_ACCESS)) {
+			pkt->buffer = NULL;
+			net_pkt_cursor_init(pkt);
+		}
+
+		k_mem_slab_free(pkt->slab, (void *)pkt);
+	}
+
+	net_buf_unref_bulk(frags, n);
+}
+#endif /* NET_LOG_LEVEL >= LOG_LEVEL_DBG */
+
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
 struct net_pkt *net_pkt_ref_debug(struct net_pkt *pkt, const char *caller,
 				  int line)
@@ -1267,7 +1343,7 @@ int net_pkt_alloc_buffer_with_reserve(struct net_pkt *pkt,
 	struct net_buf_pool *pool = NULL;
 	size_t alloc_len = 0;
 	size_t hdr_len = 0;
-	struct net_buf *buf;
+	struct net_buf *buf = NULL;
 
 	if (!size && proto == 0 && net_pkt_family(pkt) == AF_UNSPEC) {
 		return 0;
@@ -1302,12 +1378,34 @@ int net_pkt_alloc_buffer_with_reserve(struct net_pkt *pkt,
 		pool = pkt->slab == &tx_pkts ? &tx_bufs : &rx_bufs;
 	}
 
+#if defined(CONFIG_NET_PKT_INLINE_DATA)
+	/* A packet fitting one fragment is contiguous already, only use
+	 * the contiguous buffers for those which would need a chain.
+	 */
+	if ((pool == &tx_bufs || pool == &rx_bufs) && !pkt->buffer &&
+	    alloc_len + reserve > CONFIG_NET_BUF_DATA_SIZE &&
+	    alloc_len + reserve <= CONFIG_NET_PKT_INLINE_DATA_SIZE) {
+		struct net_buf_pool *inline_pool =
+			pool == &tx_bufs ? &tx_inline_bufs : &rx_inline_bufs;
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+		buf = pkt_alloc_buffer(pkt, inline_pool, alloc_len, reserve,
+				       K_NO_WAIT, caller, line);
+#else
+		buf = pkt_alloc_buffer(pkt, inline_pool, alloc_len, reserve,
+				       K_NO_WAIT);
+#endif
+	}
+#endif /* CONFIG_NET_PKT_INLINE_DATA */
+
+	if (!buf) {
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
-	buf = pkt_alloc_buffer(pkt, pool, alloc_len, reserve,
-			       timeout, caller, line);
+		buf = pkt_alloc_buffer(pkt, pool, alloc_len, reserve,
+				       timeout, caller, line);
 #else
-	buf = pkt_alloc_buffer(pkt, pool, alloc_len, reserve, timeout);
+		buf = pkt_alloc_buffer(pkt, pool, alloc_len, reserve, timeout);
 #endif
+	}
 
 	if (!buf) {
 #if NET_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -1750,6 +1848,94 @@ struct net_pkt *net_pkt_rx_alloc_with_buffer(struct net_if *iface,
 #endif
 }
 
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+int net_pkt_rx_alloc_bulk_debug(struct net_if *iface, size_t size,
+				sa_family_t family,
+				enum net_ip_protocol proto,
+				struct net_pkt **pkts, int count,
+				const char *caller, int line)
+#else
+int net_pkt_rx_alloc_bulk(struct net_if *iface, size_t size,
+			  sa_family_t family, enum net_ip_protocol proto,
+			  struct net_pkt **pkts, int count)
+#endif
+{
+	struct net_buf *bufs[PKT_BULK_BATCH];
+	size_t alloc_len;
+	int n = 0;
+
+	while (n < count) {
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+		pkts[n] = pkt_alloc_on_iface(&rx_pkts, iface, K_NO_WAIT,
+					     caller, line);
+#else
+		pkts[n] = pkt_alloc_on_iface(&rx_pkts, iface, K_NO_WAIT);
+#endif
+		if (!pkts[n]) {
+			break;
+		}
+
+		net_pkt_set_family(pkts[n], family);
+		n++;
+	}
+
+	if (!n || (!size && proto == 0 && family == AF_UNSPEC)) {
+		return n;
+	}
+
+	alloc_len = pkt_buffer_length(pkts[0],
+				      size + pkt_estimate_headers_length(pkts[0],
+									 family,
+									 proto),
+				      proto, 0);
+
+	if (IS_ENABLED(CONFIG_NET_BUF_FIXED_DATA_SIZE) &&
+	    alloc_len > CONFIG_NET_BUF_DATA_SIZE) {
+		/* Each packet needs a chain of fragments */
+		for (int i = 0; i < n; i++) {
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+			if (net_pkt_alloc_buffer_debug(pkts[i], size, proto,
+						       K_NO_WAIT, caller,
+						       line) == 0) {
+				continue;
+			}
+#else
+			if (net_pkt_alloc_buffer(pkts[i], size, proto,
+						 K_NO_WAIT) == 0) {
+				continue;
+			}
+#endif
+			net_pkt_unref_bulk(&pkts[i], n - i);
+			return i;
+		}
+
+		return n;
+	}
+
+	for (int i = 0; i < n; ) {
+		int req = MIN(n - i, (int)ARRAY_SIZE(bufs));
+		int got = net_buf_alloc_bulk(&rx_bufs, alloc_len, bufs, req);
+
+		for (int j = 0; j < got; j++) {
+#if CONFIG_NET_PKT_LOG_LEVEL >= LOG_LEVEL_DBG
+			net_pkt_alloc_add(bufs[j], false, caller, line);
+#endif
+			net_pkt_append_buffer(pkts[i + j], bufs[j]);
+		}
+
+		i += got;
+
+		if (got < req) {
+			NET_DBG("Data buffer allocation failed for %d packets",
+				n - i);
+			net_pkt_unref_bulk(&pkts[i], n - i);
+			return i;
+		}
+	}
+
+	return n;
+}
+
 void net_pkt_append_buffer(struct net_pkt *pkt, struct net_buf *buffer)
 {
 	if (!pkt->buffer) {
@@ -2052,6 +2238,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
 	net_pkt_set_l2_processed(clone_pkt, net_pkt_is_l2_processed(pkt));
 	net_pkt_set_ll_proto_type(clone_pkt, net_pkt_ll_proto_type(pkt));
+	net_pkt_set_tso_mss(clone_pkt, net_pkt_tso_mss(pkt));
 
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_L2_IPIP)
 	net_pkt_set_remote_address(clone_pkt, net_pkt_remote_address(pkt),
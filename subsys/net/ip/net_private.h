@@ -281,6 +281,39 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 extern uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Update a checksum after a 16-bit field it covers changed
+ *
+ * Implements RFC 1624, so that a forwarding path rewriting a few header
+ * fields does not need to sum the whole data again.
+ *
+ * @param chksum  Checksum field, as stored in the header.
+ * @param old_val Old value of the field, as stored in the header.
+ * @param new_val New value of the field, as stored in the header.
+ *
+ * @return New value of the checksum field.
+ */
+extern uint16_t net_calc_chksum_update(uint16_t chksum, uint16_t old_val,
+				       uint16_t new_val);
+
+/**
+ * @brief Update a checksum after some data it covers changed
+ *
+ * Same as net_calc_chksum_update() for a field of @a len bytes, e.g. an
+ * address. The field must start at an even offset of the summed data.
+ *
+ * @param chksum   Checksum field, as stored in the header.
+ * @param old_data Old content of the field.
+ * @param new_data New content of the field.
+ * @param len      Length of the field.
+ *
+ * @return New value of the checksum field.
+ */
+extern uint16_t net_calc_chksum_update_buf(uint16_t chksum,
+					   const uint8_t *old_data,
+					   const uint8_t *new_data,
+					   size_t len);
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -34,6 +34,47 @@ LOG_MODULE_REGISTER(net_stats, NET_LOG_LEVEL);
  */
 struct net_stats net_stats = { 0 };
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+/* Only counters are kept per CPU, see the dependencies of the option */
+BUILD_ASSERT(sizeof(struct net_stats) % sizeof(net_stats_t) == 0);
+
+PERCPU_DEFINE(net_stats_cpu);
+static struct k_spinlock net_stats_lock;
+
+/* Sum the counters of the per-CPU copies, stride bytes apart, into dst */
+static void net_stats_sum(struct net_stats *dst, const struct net_stats *src, size_t stride)
+{
+	net_stats_t *counters = (net_stats_t *)dst;
+
+	for (size_t i = 0; i < sizeof(*dst) / sizeof(net_stats_t); i++) {
+		net_stats_t sum = 0;
+
+		for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			sum += ((const net_stats_t *)((const uint8_t *)src + cpu * stride))[i];
+		}
+
+		counters[i] = sum;
+	}
+}
+
+void net_stats_sync(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&net_stats_lock);
+
+	net_stats_sum(&net_stats, &PERCPU_PTR(net_stats_cpu, 0)->stats,
+		      sizeof(net_stats_cpu[0]));
+
+#if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+	STRUCT_SECTION_FOREACH(net_if, iface) {
+		net_stats_sum(&iface->stats, &iface->stats_cpu[0].stats,
+			      sizeof(iface->stats_cpu[0]));
+	}
+#endif
+
+	k_spin_unlock(&net_stats_lock, key);
+}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
 #if defined(CONFIG_NET_STATISTICS_PERIODIC_OUTPUT)
 
 #define PRINT_STATISTICS_INTERVAL (30 * MSEC_PER_SEC)
@@ -227,6 +268,8 @@ static inline void stats(struct net_if *iface)
 
 void net_print_statistics_iface(struct net_if *iface)
 {
+	net_stats_sync();
+
 	/* In order to make the info print lines shorter, use shorter
 	 * function name.
 	 */
@@ -258,6 +301,8 @@ static int net_stats_get(uint32_t mgmt_request, struct net_if *iface,
 	size_t len_chk = 0;
 	void *src = NULL;
 
+	net_stats_sync();
+
 	switch (NET_MGMT_GET_COMMAND(mgmt_request)) {
 	case NET_REQUEST_STATS_CMD_GET_ALL:
 		len_chk = sizeof(struct net_stats);
@@ -412,6 +457,12 @@ void net_stats_reset(struct net_if *iface)
 
 	net_if_stats_reset_all();
 	memset(&net_stats, 0, sizeof(net_stats));
+
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+		memset(PERCPU_PTR(net_stats_cpu, cpu), 0, sizeof(struct net_stats_cpu));
+	}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
 }
 
 #if defined(CONFIG_NET_STATISTICS_VIA_PROMETHEUS)
@@ -477,6 +528,26 @@ static void register_prometheus_metrics(struct net_if *iface)
 		net_if_get_by_iface(iface));
 }
 
+/* Read a counter of the interface, summing the per-CPU copies if needed */
+static net_stats_t prometheus_stat_get(struct net_if *iface, net_stats_t *stat)
+{
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+	size_t offset = (uint8_t *)stat - (uint8_t *)&iface->stats;
+
+	if (offset < sizeof(iface->stats)) {
+		net_stats_t sum = 0;
+
+		for (unsigned int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			sum += *(net_stats_t *)((uint8_t *)&iface->stats_cpu[cpu].stats + offset);
+		}
+
+		return sum;
+	}
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+	return *stat;
+}
+
 /* Do not update metrics one by one as that would require searching
  * each individual metric from the collector. Instead, let the
  * Prometheus API scrape the data from net_stats stored in net_if when
@@ -506,7 +577,7 @@ int net_stats_prometheus_scrape(struct prometheus_collector *collector,
 			return -EAGAIN;
 		}
 
-		value = *((net_stats_t *)counter->user_data);
+		value = prometheus_stat_get(iface, counter->user_data);
 
 		prometheus_counter_set(counter, (uint64_t)value);
 
@@ -518,7 +589,7 @@ int net_stats_prometheus_scrape(struct prometheus_collector *collector,
 			return -EAGAIN;
 		}
 
-		value = *((net_stats_t *)gauge->user_data);
+		value = prometheus_stat_get(iface, gauge->user_data);
 
 		prometheus_gauge_set(gauge, (double)value);
 
@@ -18,19 +18,40 @@
 extern struct net_stats net_stats;
 
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
-#define SET_STAT(cmd) (cmd)
 #define GET_STAT(iface, s) (iface ? iface->stats.s : net_stats.s)
 #define GET_STAT_ADDR(iface, s) (iface ? &iface->stats.s : &net_stats.s)
 #else
-#define SET_STAT(cmd)
 #define GET_STAT(iface, s) (net_stats.s)
 #define GET_STAT_ADDR(iface, s) (&GET_STAT(iface, s))
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_PER_CPU)
+#include <zephyr/sys/percpu.h>
+
+/* The statistics are summed into net_stats and the statistics of each
+ * interface by net_stats_sync()
+ */
+PERCPU_DECLARE(struct net_stats_cpu, net_stats_cpu);
+
+#define UPDATE_STAT_GLOBAL(cmd) (PERCPU_GET(net_stats_cpu)->cmd)
+
+void net_stats_sync(void);
+#else
 #define UPDATE_STAT_GLOBAL(cmd) (net_##cmd)
+#define net_stats_sync()
+#endif /* CONFIG_NET_STATISTICS_PER_CPU */
+
+#if !defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
+#define UPDATE_STAT_IFACE(iface, cmd)
+#elif defined(CONFIG_NET_STATISTICS_PER_CPU)
+#define UPDATE_STAT_IFACE(iface, cmd) ((iface)->stats_cpu[arch_curr_cpu()->id].cmd)
+#else
+#define UPDATE_STAT_IFACE(iface, cmd) ((iface)->cmd)
+#endif
+
 #define UPDATE_STAT(_iface, _cmd) \
 	{ NET_ASSERT(_iface); (UPDATE_STAT_GLOBAL(_cmd)); \
-	  SET_STAT(_iface->_cmd); }
+	  UPDATE_STAT_IFACE(_iface, _cmd); }
 /* Core stats */
 
 static inline void net_stats_update_processing_error(struct net_if *iface)
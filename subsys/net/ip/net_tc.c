@@ -13,13 +13,24 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
+
+/* With receive side scaling, each RX traffic class has several queues */
+#if defined(CONFIG_NET_RX_RSS)
+#define NET_TC_RX_QUEUES CONFIG_NET_RX_RSS_QUEUES
+#else
+#define NET_TC_RX_QUEUES 1
+#endif
+#define NET_TC_RX_THREADS (NET_TC_RX_COUNT * NET_TC_RX_QUEUES)
 
 #define TC_RX_PSEUDO_QUEUE (COND_CODE_1(CONFIG_NET_TC_RX_SKIP_FOR_HIGH_PRIO, (1), (0)))
-#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_COUNT + TC_RX_PSEUDO_QUEUE)
+#define NET_TC_RX_EFFECTIVE_COUNT (NET_TC_RX_THREADS + TC_RX_PSEUDO_QUEUE)
 
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 #define NET_TC_RX_SLOTS (CONFIG_NET_PKT_RX_COUNT / NET_TC_RX_EFFECTIVE_COUNT)
@@ -46,15 +57,21 @@ BUILD_ASSERT(NET_TC_TX_SLOTS > 0,
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With receive side scaling, RX threads are named "rx_q[y.z]" where z is the
+ * queue of the traffic class.
  */
+#if defined(CONFIG_NET_RX_RSS)
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+#else
 #define MAX_NAME_LEN sizeof("xx_q[y]")
+#endif
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_THREADS,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -62,9 +79,102 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_THREADS];
 #endif
 
+#if defined(CONFIG_NET_RX_RSS)
+static uint32_t rss_mix(uint32_t hash, uint32_t val)
+{
+	return (hash ^ val) * 0x9e3779b1U;
+}
+
+/* Hash the addresses and ports of a packet, as found in its first buffer.
+ * Headers which are not there leave the hash to the fields seen so far, so
+ * that a flow always gets the same value.
+ */
+static uint32_t rss_flow_hash(struct net_pkt *pkt)
+{
+	uint32_t hash = rss_mix(0U, net_if_get_by_iface(net_pkt_iface(pkt)));
+	struct net_buf *buf = pkt->buffer;
+	const uint8_t *data;
+	size_t len, off = 0;
+	uint16_t ptype;
+	uint8_t proto;
+
+	if (buf == NULL) {
+		return hash;
+	}
+
+	data = buf->data;
+	len = buf->len;
+
+	if (net_pkt_is_l2_processed(pkt)) {
+		if (len < 1) {
+			return hash;
+		}
+
+		ptype = (data[0] >> 4) == 6 ? NET_ETH_PTYPE_IPV6 : NET_ETH_PTYPE_IP;
+	} else {
+#if defined(CONFIG_NET_L2_ETHERNET)
+		if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(ETHERNET) ||
+		    len < sizeof(struct net_eth_hdr)) {
+			return hash;
+		}
+
+		off = sizeof(struct net_eth_hdr);
+		ptype = sys_get_be16(&data[off - sizeof(uint16_t)]);
+		if (ptype == NET_ETH_PTYPE_VLAN && len >= off + 4) {
+			ptype = sys_get_be16(&data[off + 2]);
+			off += 4;
+		}
+#else
+		return hash;
+#endif /* CONFIG_NET_L2_ETHERNET */
+	}
+
+	if (ptype == NET_ETH_PTYPE_IP && len >= off + 20) {
+		hash = rss_mix(hash, sys_get_be32(&data[off + 12]));
+		hash = rss_mix(hash, sys_get_be32(&data[off + 16]));
+		proto = data[off + 9];
+
+		/* Only the first fragment has the ports, use the addresses */
+		if ((sys_get_be16(&data[off + 6]) & 0x3fff) != 0U) {
+			goto out;
+		}
+
+		off += (data[off] & 0x0f) * 4U;
+	} else if (ptype == NET_ETH_PTYPE_IPV6 && len >= off + 40) {
+		for (size_t i = 8; i < 40; i += sizeof(uint32_t)) {
+			hash = rss_mix(hash, sys_get_be32(&data[off + i]));
+		}
+
+		/* Extension headers are not followed, they are rare enough */
+		proto = data[off + 6];
+		off += 40;
+	} else {
+		return hash;
+	}
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) && len >= off + 4) {
+		hash = rss_mix(hash, sys_get_be32(&data[off]));
+	}
+
+out:
+	return hash ^ (hash >> 16);
+}
+
+static uint8_t rss_queue(struct net_pkt *pkt)
+{
+	int queue = net_pkt_rx_queue(pkt);
+
+	if (queue >= 0) {
+		return queue % NET_TC_RX_QUEUES;
+	}
+
+	return rss_flow_hash(pkt) % NET_TC_RX_QUEUES;
+}
+#endif /* CONFIG_NET_RX_RSS */
+
 enum net_verdict net_tc_try_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt,
 					       k_timeout_t timeout)
 {
@@ -94,6 +204,10 @@ enum net_verdict net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #endif
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+#if defined(CONFIG_NET_RX_RSS)
+	tc = tc * NET_TC_RX_QUEUES + rss_queue(pkt);
+#endif
+
 #if NET_TC_RX_EFFECTIVE_COUNT > 1
 	while (k_sem_take(&rx_classes[tc].fifo_slot, K_NO_WAIT) != 0) {
 		if (k_is_in_isr() || retry_cnt == 0) {
@@ -296,6 +410,9 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 #endif
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_TCP_GRO)
+	int burst = 0;
+#endif
 
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
@@ -307,7 +424,21 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		k_sem_give(fifo_slot);
 #endif
 
+#if defined(CONFIG_NET_TCP_GRO)
+		/* TCP merges segments until no more packets are waiting */
+		if (burst++ == 0) {
+			net_tcp_gro_begin();
+		}
+#endif /* CONFIG_NET_TCP_GRO */
+
 		net_process_rx_packet(pkt);
+
+#if defined(CONFIG_NET_TCP_GRO)
+		if (burst == CONFIG_NET_TCP_GRO_BURST || k_fifo_is_empty(fifo)) {
+			net_tcp_gro_end();
+			burst = 0;
+		}
+#endif /* CONFIG_NET_TCP_GRO */
 	}
 }
 #endif
@@ -425,12 +556,12 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_THREADS; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_TC_RX_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -467,10 +598,20 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
+#if defined(CONFIG_NET_RX_RSS) && defined(CONFIG_SCHED_CPU_MASK)
+		/* Spread the queues of a traffic class over the CPUs */
+		(void)k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUES) % arch_num_cpus());
+#endif
+
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
+#if defined(CONFIG_NET_RX_RSS)
+			snprintk(name, sizeof(name), "rx_q[%d.%d]",
+				 i / NET_TC_RX_QUEUES, i % NET_TC_RX_QUEUES);
+#else
 			snprintk(name, sizeof(name), "rx_q[%d]", i);
+#endif
 			k_thread_name_set(tid, name);
 		}
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* PI servo for the PTP and gPTP stacks. The gains are derived from the loop
+ * bandwidth and the interval between the samples, as for a second order PLL
+ * with a damping factor of 1/sqrt(2). Offset spikes, typically caused by a
+ * packet delayed in a switch queue, are removed with a median filter.
+ */
+
+#include <zephyr/sys_clock.h>
+#include <zephyr/sys/util.h>
+
+#include "ptp_servo.h"
+
+#define DAMPING 0.7071
+#define DEFAULT_INTERVAL 1.0
+#define MAX_INTERVAL 16.0
+
+void net_ptp_servo_init(struct net_ptp_servo *servo, uint32_t bandwidth_mhz,
+			uint32_t max_ppb)
+{
+	servo->wn = 2.0 * 3.14159265358979 * bandwidth_mhz / 1000.0;
+	servo->max_ppb = max_ppb;
+	servo->drift = 0.0;
+
+	net_ptp_servo_reset(servo);
+}
+
+void net_ptp_servo_reset(struct net_ptp_servo *servo)
+{
+	servo->count = 0U;
+	servo->last_time = 0U;
+}
+
+static int64_t median_offset(struct net_ptp_servo *servo, int64_t offset)
+{
+	int64_t a, b, c;
+
+	servo->samples[servo->count % NET_PTP_SERVO_FILTER_LEN] = offset;
+	servo->count++;
+
+	if (servo->count < NET_PTP_SERVO_FILTER_LEN) {
+		return offset;
+	}
+
+	a = servo->samples[0];
+	b = servo->samples[1];
+	c = servo->samples[2];
+
+	return MAX(MIN(a, b), MIN(MAX(a, b), c));
+}
+
+double net_ptp_servo_sample(struct net_ptp_servo *servo, int64_t offset, uint64_t local_time)
+{
+	double interval = DEFAULT_INTERVAL;
+	double kp, ki, ppb;
+
+	if (servo->last_time != 0U && local_time > servo->last_time) {
+		interval = (double)(local_time - servo->last_time) / NSEC_PER_SEC;
+		interval = MIN(interval, MAX_INTERVAL);
+	}
+
+	servo->last_time = local_time;
+
+	offset = median_offset(servo, offset);
+
+	kp = 2.0 * DAMPING * servo->wn;
+	ki = servo->wn * servo->wn * interval;
+
+	ppb = kp * offset + servo->drift + ki * offset;
+
+	/* Do not let the integral term wind up while saturated */
+	if (ppb > servo->max_ppb) {
+		return servo->max_ppb;
+	}
+
+	if (ppb < -servo->max_ppb) {
+		return -servo->max_ppb;
+	}
+
+	servo->drift += ki * offset;
+
+	return ppb;
+}
@@ -0,0 +1,74 @@
+/** @file
+ * @brief PI servo shared by the PTP and gPTP stacks
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __NET_PTP_SERVO_H
+#define __NET_PTP_SERVO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of offset samples the spike filter looks at */
+#define NET_PTP_SERVO_FILTER_LEN 3
+
+/** PI servo state */
+struct net_ptp_servo {
+	/** Last offset samples, for the median filter */
+	int64_t samples[NET_PTP_SERVO_FILTER_LEN];
+	/** Local time of the last sample, in nanoseconds */
+	uint64_t last_time;
+	/** Integral term, in ppb */
+	double drift;
+	/** Natural frequency of the loop, in rad/s */
+	double wn;
+	/** Largest frequency adjustment, in ppb */
+	double max_ppb;
+	/** Number of samples since the last reset */
+	uint32_t count;
+};
+
+/**
+ * @brief Initialize the servo.
+ *
+ * @param servo Servo to initialize
+ * @param bandwidth_mhz Bandwidth of the loop, in mHz
+ * @param max_ppb Largest frequency adjustment the servo outputs, in ppb
+ */
+void net_ptp_servo_init(struct net_ptp_servo *servo, uint32_t bandwidth_mhz,
+			uint32_t max_ppb);
+
+/**
+ * @brief Forget the past samples, but keep the frequency estimate.
+ *
+ * To be called when the clock was stepped.
+ *
+ * @param servo Servo to reset
+ */
+void net_ptp_servo_reset(struct net_ptp_servo *servo);
+
+/**
+ * @brief Feed an offset sample to the servo.
+ *
+ * @param servo Servo
+ * @param offset Offset to correct in nanoseconds, positive when the local
+ *        clock is late
+ * @param local_time Local time the offset was measured at, in nanoseconds.
+ *        The interval between the samples is derived from it.
+ *
+ * @return Frequency adjustment to apply, in ppb
+ */
+double net_ptp_servo_sample(struct net_ptp_servo *servo, int64_t offset, uint64_t local_time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_PTP_SERVO_H */
@@ -40,6 +40,62 @@ static sys_slist_t active_route_lifetime_timers;
 /* Timer that manages expired route entries. */
 static struct k_work_delayable route_lifetime_timer;
 
+/* The forwarding information base is a path compressed binary trie of the
+ * route prefixes. A node exists for every prefix that has routes, and for
+ * every bit position where the prefixes below it diverge. So a lookup
+ * visits at most one node per prefix bit, whatever the number of routes.
+ */
+struct net_route_fib_node {
+	/** Child nodes, indexed by the first bit after the prefix. */
+	struct net_route_fib_node *child[2];
+
+	/** Routes having this prefix, one per interface. */
+	sys_slist_t routes;
+
+	/** Prefix of the node, the bits after prefix_len are zero. */
+	struct in6_addr prefix;
+
+	/** Length of the prefix. */
+	uint8_t prefix_len;
+};
+
+/* Each route adds at most one prefix node and one branch node */
+K_MEM_SLAB_DEFINE_STATIC(fib_slab, sizeof(struct net_route_fib_node),
+			 CONFIG_NET_MAX_ROUTES * 2, 4);
+
+static struct net_route_fib_node *fib_root;
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* The lookup results of the latest destinations, including misses */
+struct net_route_cache_entry {
+	struct net_if *iface;
+	struct net_route_entry *route;
+	struct in6_addr dst;
+	bool valid;
+};
+
+static struct net_route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+#endif
+
+#if CONFIG_NET_ROUTE_FWD_CACHE_SIZE > 0
+/* Next hops of the latest forwarded flows. Flushing just bumps the
+ * generation, so that it can be done from the neighbor code without
+ * taking locks.
+ */
+struct net_route_fwd_cache_entry {
+	struct net_if *iface;
+	struct net_if *route_iface;
+	struct net_nbr *nexthop;
+	struct in6_addr src;
+	struct in6_addr dst;
+	uint32_t gen;
+	uint8_t proto;
+};
+
+static struct net_route_fwd_cache_entry fwd_cache[CONFIG_NET_ROUTE_FWD_CACHE_SIZE];
+static atomic_t fwd_cache_gen = ATOMIC_INIT(1);
+#endif
+
 static void net_route_nexthop_remove(struct net_nbr *nbr)
 {
 	NET_DBG("Nexthop %p removed", nbr);
@@ -267,37 +323,280 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static inline uint8_t fib_bit(const struct in6_addr *addr, uint8_t bit)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
-	int i;
+	return (addr->s6_addr[bit / 8] >> (7 - bit % 8)) & 1;
+}
 
-	net_ipv6_nbr_lock();
+/* Number of leading bits, up to max_len, that are the same in both */
+static uint8_t fib_common_len(const struct in6_addr *addr1,
+			      const struct in6_addr *addr2,
+			      uint8_t max_len)
+{
+	uint8_t len = 0U;
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+	while (len < max_len) {
+		uint8_t diff = addr1->s6_addr[len / 8] ^ addr2->s6_addr[len / 8];
 
-		if (!nbr->ref) {
+		if (diff == 0U) {
+			len += 8U;
 			continue;
 		}
 
-		if (iface && nbr->iface != iface) {
+		while (!(diff & 0x80)) {
+			diff <<= 1;
+			len++;
+		}
+
+		break;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_route_fib_node *fib_node_alloc(const struct in6_addr *prefix,
+						 uint8_t prefix_len)
+{
+	struct net_route_fib_node *node;
+	int i;
+
+	if (k_mem_slab_alloc(&fib_slab, (void **)&node, K_NO_WAIT) < 0) {
+		return NULL;
+	}
+
+	memset(node, 0, sizeof(*node));
+	sys_slist_init(&node->routes);
+
+	for (i = 0; i < prefix_len; i++) {
+		if (fib_bit(prefix, i)) {
+			node->prefix.s6_addr[i / 8] |= 0x80 >> (i % 8);
+		}
+	}
+
+	node->prefix_len = prefix_len;
+
+	return node;
+}
+
+static void fib_node_free(struct net_route_fib_node *node)
+{
+	k_mem_slab_free(&fib_slab, (void *)node);
+}
+
+/* Return the node for the prefix, creating it when needed */
+static struct net_route_fib_node *fib_node_get(const struct in6_addr *prefix,
+					       uint8_t prefix_len)
+{
+	struct net_route_fib_node **link = &fib_root;
+	struct net_route_fib_node *node, *branch, *leaf;
+	uint8_t len;
+
+	while (*link != NULL) {
+		node = *link;
+		len = fib_common_len(prefix, &node->prefix,
+				     MIN(prefix_len, node->prefix_len));
+
+		if (len == node->prefix_len) {
+			if (len == prefix_len) {
+				return node;
+			}
+
+			link = &node->child[fib_bit(prefix, len)];
 			continue;
 		}
 
-		route = net_route_data(nbr);
+		/* The prefix diverges from the node, or is above it */
+		leaf = fib_node_alloc(prefix, prefix_len);
+		if (leaf == NULL) {
+			return NULL;
+		}
+
+		if (len == prefix_len) {
+			leaf->child[fib_bit(&node->prefix, len)] = node;
+			*link = leaf;
+
+			return leaf;
+		}
+
+		branch = fib_node_alloc(prefix, len);
+		if (branch == NULL) {
+			fib_node_free(leaf);
+			return NULL;
+		}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+		branch->child[fib_bit(prefix, len)] = leaf;
+		branch->child[fib_bit(&node->prefix, len)] = node;
+		*link = branch;
+
+		return leaf;
+	}
+
+	node = fib_node_alloc(prefix, prefix_len);
+	*link = node;
+
+	return node;
+}
+
+static int fib_add(struct net_route_entry *route)
+{
+	struct net_route_fib_node *node;
+
+	node = fib_node_get(&route->addr, route->prefix_len);
+	if (node == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_prepend(&node->routes, &route->fib_node);
+
+	return 0;
+}
+
+/* Remove the route, then its node if no routes are left on it, and the
+ * branch node above that is not needed any more.
+ */
+static void fib_del(struct net_route_entry *route)
+{
+	struct net_route_fib_node **link = &fib_root, **parent_link = NULL;
+	struct net_route_fib_node *node, *parent, *child;
+
+	while ((node = *link) != NULL && node->prefix_len < route->prefix_len) {
+		parent_link = link;
+		link = &node->child[fib_bit(&route->addr, node->prefix_len)];
+	}
+
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->routes, &route->fib_node)) {
+		return;
+	}
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	child = node->child[0] != NULL ? node->child[0] : node->child[1];
+	*link = child;
+	fib_node_free(node);
+
+	if (child != NULL || parent_link == NULL) {
+		return;
+	}
+
+	parent = *parent_link;
+	if (!sys_slist_is_empty(&parent->routes)) {
+		return;
+	}
+
+	*parent_link = parent->child[0] != NULL ? parent->child[0] :
+						  parent->child[1];
+	fib_node_free(parent);
+}
+
+static struct net_route_entry *fib_lookup(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct net_route_fib_node *node = fib_root;
+	struct net_route_entry *route, *found = NULL;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, fib_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
 		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[fib_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+
+/* Route to exactly this prefix, not to a shorter one covering it */
+static struct net_route_entry *fib_lookup_exact(struct net_if *iface,
+						struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	struct net_route_fib_node *node = fib_root;
+	struct net_route_entry *route;
+
+	while (node != NULL && node->prefix_len < prefix_len) {
+		node = node->child[fib_bit(addr, node->prefix_len)];
+	}
+
+	if (node == NULL || node->prefix_len != prefix_len ||
+	    !net_ipv6_is_prefix(addr->s6_addr, node->prefix.s6_addr,
+				prefix_len)) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, fib_node) {
+		if (route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+static struct net_route_cache_entry *route_cache_slot(struct net_if *iface,
+						      struct in6_addr *dst)
+{
+	uint32_t hash = POINTER_TO_UINT(iface);
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		hash ^= UNALIGNED_GET(&dst->s6_addr32[i]);
 	}
 
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &route_cache[hash % CONFIG_NET_ROUTE_CACHE_SIZE];
+}
+
+static void route_cache_flush(void)
+{
+	memset(route_cache, 0, sizeof(route_cache));
+}
+#else
+static inline void route_cache_flush(void) { }
+#endif /* CONFIG_NET_ROUTE_CACHE_SIZE > 0 */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	struct net_route_cache_entry *cached;
+#endif
+
+	net_ipv6_nbr_lock();
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+	cached = route_cache_slot(iface, dst);
+	if (cached->valid && cached->iface == iface &&
+	    net_ipv6_addr_cmp(&cached->dst, dst)) {
+		found = cached->route;
+	} else {
+		found = fib_lookup(iface, dst);
+
+		cached->iface = iface;
+		cached->route = found;
+		net_ipaddr_copy(&cached->dst, dst);
+		cached->valid = true;
+	}
+#else
+	found = fib_lookup(iface, dst);
+#endif
+
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -361,7 +660,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	route = fib_lookup_exact(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
@@ -442,6 +741,17 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+	if (fib_add(route) < 0) {
+		NET_ERR("No FIB node available!");
+		release_nexthop_route(nexthop_route);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+
+	route_cache_flush();
+	net_route_fwd_cache_flush();
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -588,6 +898,10 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+	fib_del(route);
+	route_cache_flush();
+	net_route_fwd_cache_flush();
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		net_ipv6_nbr_unlock();
@@ -1029,36 +1343,23 @@ static bool is_ll_addr_supported(struct net_if *iface)
 	return true;
 }
 
-int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+/* Prepare the packet to be sent to the neighbor, with the neighbor lock held */
+static int route_packet_to_nbr(struct net_pkt *pkt, struct net_nbr *nbr)
 {
 	struct net_linkaddr *lladdr = NULL;
-	struct net_nbr *nbr;
-	int err;
-
-	net_ipv6_nbr_lock();
-
-	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
-	if (!nbr) {
-		NET_DBG("Cannot find %s neighbor",
-			net_sprint_ipv6_addr(nexthop));
-		err = -ENOENT;
-		goto error;
-	}
 
 	if (is_ll_addr_supported(nbr->iface) && is_ll_addr_supported(net_pkt_iface(pkt)) &&
 	    is_ll_addr_supported(net_pkt_orig_iface(pkt))) {
 		lladdr = net_nbr_get_lladdr(nbr->idx);
 		if (!lladdr) {
 			NET_DBG("Cannot find %s neighbor link layer address.",
-				net_sprint_ipv6_addr(nexthop));
-			err = -ESRCH;
-			goto error;
+				net_sprint_ipv6_addr(&net_ipv6_nbr_data(nbr)->addr));
+			return -ESRCH;
 		}
 
 		if (net_pkt_lladdr_src(pkt)->len == 0) {
 			NET_DBG("Link layer source address not set");
-			err = -EINVAL;
-			goto error;
+			return -EINVAL;
 		}
 
 		/* Sanitycheck: If src and dst ll addresses are going
@@ -1068,8 +1369,7 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 		if (!memcmp(net_pkt_lladdr_src(pkt)->addr, lladdr->addr,
 				lladdr->len)) {
 			NET_ERR("Src ll and Dst ll are same");
-			err = -EINVAL;
-			goto error;
+			return -EINVAL;
 		}
 	}
 
@@ -1089,6 +1389,127 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
 
 	net_pkt_set_iface(pkt, nbr->iface);
 
+	return 0;
+}
+
+#if CONFIG_NET_ROUTE_FWD_CACHE_SIZE > 0
+static struct net_route_fwd_cache_entry *fwd_cache_slot(struct net_if *iface,
+							struct net_ipv6_hdr *hdr)
+{
+	uint32_t hash = POINTER_TO_UINT(iface) ^ hdr->nexthdr;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		hash ^= UNALIGNED_GET((uint32_t *)hdr->src + i);
+		hash ^= UNALIGNED_GET((uint32_t *)hdr->dst + i);
+	}
+
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return &fwd_cache[hash % CONFIG_NET_ROUTE_FWD_CACHE_SIZE];
+}
+
+static bool fwd_cache_match(struct net_route_fwd_cache_entry *entry,
+			    struct net_if *iface, struct net_ipv6_hdr *hdr)
+{
+	return entry->gen == (uint32_t)atomic_get(&fwd_cache_gen) &&
+	       entry->iface == iface && entry->proto == hdr->nexthdr &&
+	       net_ipv6_addr_cmp_raw(entry->dst.s6_addr, hdr->dst) &&
+	       net_ipv6_addr_cmp_raw(entry->src.s6_addr, hdr->src);
+}
+
+static void fwd_cache_add(struct net_pkt *pkt, struct net_if *route_iface,
+			  struct net_nbr *nbr)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct net_route_fwd_cache_entry *entry;
+
+	if (hdr == NULL || net_pkt_orig_iface(pkt) == NULL) {
+		return;
+	}
+
+	entry = fwd_cache_slot(net_pkt_orig_iface(pkt), hdr);
+
+	entry->iface = net_pkt_orig_iface(pkt);
+	entry->route_iface = route_iface;
+	entry->nexthop = nbr;
+	net_ipv6_addr_copy_raw(entry->src.s6_addr, hdr->src);
+	net_ipv6_addr_copy_raw(entry->dst.s6_addr, hdr->dst);
+	entry->proto = hdr->nexthdr;
+	entry->gen = (uint32_t)atomic_get(&fwd_cache_gen);
+}
+
+int net_route_packet_cached(struct net_pkt *pkt)
+{
+	struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+	struct net_route_fwd_cache_entry *entry;
+	int err;
+
+	if (hdr == NULL) {
+		return -ENOENT;
+	}
+
+	net_ipv6_nbr_lock();
+
+	entry = fwd_cache_slot(net_pkt_iface(pkt), hdr);
+	if (!fwd_cache_match(entry, net_pkt_iface(pkt), hdr)) {
+		net_ipv6_nbr_unlock();
+		return -ENOENT;
+	}
+
+	net_pkt_set_orig_iface(pkt, net_pkt_iface(pkt));
+	net_pkt_set_iface(pkt, entry->route_iface);
+
+	err = route_packet_to_nbr(pkt, entry->nexthop);
+
+	net_ipv6_nbr_unlock();
+
+	if (err < 0) {
+		return err;
+	}
+
+	return net_send_data(pkt);
+}
+
+void net_route_fwd_cache_flush(void)
+{
+	atomic_inc(&fwd_cache_gen);
+}
+#else
+static inline void fwd_cache_add(struct net_pkt *pkt,
+				 struct net_if *route_iface,
+				 struct net_nbr *nbr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(route_iface);
+	ARG_UNUSED(nbr);
+}
+#endif /* CONFIG_NET_ROUTE_FWD_CACHE_SIZE > 0 */
+
+int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop)
+{
+	struct net_if *route_iface = net_pkt_iface(pkt);
+	struct net_nbr *nbr;
+	int err;
+
+	net_ipv6_nbr_lock();
+
+	nbr = net_ipv6_nbr_lookup(NULL, nexthop);
+	if (!nbr) {
+		NET_DBG("Cannot find %s neighbor",
+			net_sprint_ipv6_addr(nexthop));
+		err = -ENOENT;
+		goto error;
+	}
+
+	err = route_packet_to_nbr(pkt, nbr);
+	if (err < 0) {
+		goto error;
+	}
+
+	fwd_cache_add(pkt, route_iface, nbr);
+
 	net_ipv6_nbr_unlock();
 
 	return net_send_data(pkt);
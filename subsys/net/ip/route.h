@@ -52,6 +52,11 @@ struct net_route_entry {
 	/** List of neighbors that the routes go through. */
 	sys_slist_t nexthop;
 
+	/** Node in the list of routes sharing the same prefix in the
+	 * forwarding information base.
+	 */
+	sys_snode_t fib_node;
+
 	/** Network interface for the route. */
 	struct net_if *iface;
 
@@ -328,6 +333,39 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+#if defined(CONFIG_NET_ROUTE) && CONFIG_NET_ROUTE_FWD_CACHE_SIZE > 0
+/**
+ * @brief Forward the network packet using the forwarding cache.
+ *
+ * If a packet of the same flow, i.e. with the same incoming interface,
+ * source and destination addresses and next header, has been forwarded
+ * via a next hop neighbor before, the packet is sent to that neighbor
+ * without looking up the route again.
+ *
+ * @param pkt Network packet to forward.
+ *
+ * @return 0 if the packet was sent, -ENOENT if the flow is not cached,
+ * other <0 value if the packet could not be sent.
+ */
+int net_route_packet_cached(struct net_pkt *pkt);
+
+/**
+ * @brief Invalidate the forwarding cache.
+ *
+ * Must be called when routes or neighbors change.
+ */
+void net_route_fwd_cache_flush(void);
+#else
+static inline int net_route_packet_cached(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return -ENOENT;
+}
+
+static inline void net_route_fwd_cache_flush(void) { }
+#endif
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -76,25 +76,88 @@ static K_MUTEX_DEFINE(tcp_lock);
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
+K_MEM_SLAB_DEFINE_STATIC(tcp_ooo_slab, sizeof(struct tcp_ooo_range),
+				CONFIG_NET_TCP_RECV_QUEUE_RANGES, 4);
+
 static struct k_work_q tcp_work_q;
 static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
 static void tcp_out(struct tcp *conn, uint8_t flags);
+static void tcp_conn_ref(struct tcp *conn);
 static const char *tcp_state_to_str(enum tcp_state state, bool prefix);
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
 
-static uint32_t tcp_get_seq(struct net_buf *buf)
+static bool tcp_ooo_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct tcp_ooo_range *range_a = CONTAINER_OF(a, struct tcp_ooo_range, node);
+	struct tcp_ooo_range *range_b = CONTAINER_OF(b, struct tcp_ooo_range, node);
+
+	return net_tcp_seq_cmp(range_a->seq, range_b->seq) < 0;
+}
+
+/* Find the last out-of-order range starting at or before seq, or with
+ * after set, the first one starting after it.
+ */
+static struct tcp_ooo_range *tcp_ooo_find(struct tcp *conn, uint32_t seq,
+					  bool after)
+{
+	struct rbnode *node = conn->ooo_ranges.root;
+	struct tcp_ooo_range *found = NULL;
+
+	while (node != NULL) {
+		struct tcp_ooo_range *range =
+			CONTAINER_OF(node, struct tcp_ooo_range, node);
+		bool before = net_tcp_seq_cmp(range->seq, seq) <= 0;
+
+		if (before != after) {
+			found = range;
+		}
+
+		node = z_rb_child(node, before ? 1U : 0U);
+	}
+
+	return found;
+}
+
+static void tcp_ooo_free(struct tcp *conn, struct tcp_ooo_range *range)
+{
+	rb_remove(&conn->ooo_ranges, &range->node);
+
+	if (range->buf != NULL) {
+		net_buf_unref(range->buf);
+	}
+
+	k_mem_slab_free(&tcp_ooo_slab, (void *)range);
+}
+
+static void tcp_ooo_flush(struct tcp *conn)
 {
-	return *(uint32_t *)net_buf_user_data(buf);
+	struct rbnode *node;
+
+	while ((node = rb_get_min(&conn->ooo_ranges)) != NULL) {
+		tcp_ooo_free(conn, CONTAINER_OF(node, struct tcp_ooo_range, node));
+	}
 }
 
-static void tcp_set_seq(struct net_buf *buf, uint32_t seq)
+/* Drop len bytes from the start of a buffer chain */
+static struct net_buf *tcp_buf_pull(struct net_buf *buf, size_t len)
 {
-	*(uint32_t *)net_buf_user_data(buf) = seq;
+	while (buf != NULL && len > 0) {
+		size_t pull_len = MIN(len, buf->len);
+
+		net_buf_pull(buf, pull_len);
+		len -= pull_len;
+
+		if (buf->len == 0) {
+			buf = net_buf_frag_del(NULL, buf);
+		}
+	}
+
+	return buf;
 }
 
 static int tcp_pkt_linearize(struct net_pkt *pkt, size_t pos, size_t len)
@@ -443,21 +506,53 @@ static void tcp_derive_rto(struct tcp *conn)
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-/* Implementation according to RFC6582 */
+/* Longest congestion control algorithm name, with the terminating null */
+#define TCP_CA_NAME_MAX 16
+
+/* The minimum RTT estimate is refreshed if not seen again for this long */
+#define TCP_CA_MIN_RTT_WIN_MS 10000
 
-static void tcp_new_reno_log(struct tcp *conn, char *step)
+static void tcp_ca_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
-		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
-		conn->ca.pending_fast_retransmit_bytes);
+	NET_DBG("conn: %p, ca %s %s, cwnd=%d, ssthres=%d, fast_pend=%i, srtt=%u",
+		conn, conn->ca.ops->name, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.pending_fast_retransmit_bytes, conn->ca.srtt);
 }
 
-static void tcp_new_reno_init(struct tcp *conn)
+static void tcp_ca_base_init(struct tcp *conn)
 {
 	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
 	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
 	conn->ca.pending_fast_retransmit_bytes = 0;
-	tcp_new_reno_log(conn, "init");
+	conn->ca.rtt_pending = false;
+}
+
+/* Leave fast recovery once the data sent before it has been acknowledged.
+ * Returns false if the connection is not (anymore) in fast recovery.
+ */
+static bool tcp_ca_recovery_acked(struct tcp *conn, uint32_t acked_len)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		return false;
+	}
+
+	if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+		conn->ca.pending_fast_retransmit_bytes = 0;
+		conn->ca.cwnd = conn->ca.ssthresh;
+	} else {
+		conn->ca.pending_fast_retransmit_bytes -= acked_len;
+		conn->ca.cwnd -= acked_len;
+	}
+
+	return true;
+}
+
+/* Implementation according to RFC6582 */
+
+static void tcp_new_reno_init(struct tcp *conn)
+{
+	tcp_ca_base_init(conn);
+	tcp_ca_log(conn, "init");
 }
 
 static void tcp_new_reno_fast_retransmit(struct tcp *conn)
@@ -467,7 +562,7 @@ static void tcp_new_reno_fast_retransmit(struct tcp *conn)
 		/* Account for the lost segments */
 		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
 		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
-		tcp_new_reno_log(conn, "fast_retransmit");
+		tcp_ca_log(conn, "fast_retransmit");
 	}
 }
 
@@ -475,7 +570,7 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 {
 	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, conn->unacked_len / 2);
 	conn->ca.cwnd = conn_mss(conn);
-	tcp_new_reno_log(conn, "timeout");
+	tcp_ca_log(conn, "timeout");
 }
 
 /* For every duplicate ack increment the cwnd by mss */
@@ -485,7 +580,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 
 	new_win += conn_mss(conn);
 	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
-	tcp_new_reno_log(conn, "dup_ack");
+	tcp_ca_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
@@ -493,7 +588,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	int32_t new_win = conn->ca.cwnd;
 	int32_t win_inc = MIN(acked_len, conn_mss(conn));
 
-	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+	if (!tcp_ca_recovery_acked(conn, acked_len)) {
 		if (conn->ca.cwnd < conn->ca.ssthresh) {
 			new_win += win_inc;
 		} else {
@@ -501,42 +596,417 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
 		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	}
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_new_reno_ops = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+
+/* Implementation according to RFC9438, with C = 0.4 and beta = 0.7 */
+
+#define TCP_CUBIC_BETA 7 /* tenths */
+/* Limit for the time in the window function, keeps its cube in 64 bits */
+#define TCP_CUBIC_MAX_T_MS 30000
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	tcp_ca_base_init(conn);
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_ca_log(conn, "init");
+}
+
+/* Multiplicative decrease from the current flight size */
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint16_t flight = MIN(conn->unacked_len, UINT16_MAX);
+
+	/* Fast convergence, release bandwidth to new flows */
+	if (flight < cubic->w_max) {
+		cubic->w_max = flight * (10 + TCP_CUBIC_BETA) / 20;
 	} else {
-		/* Check if it is still in fast recovery mode */
-		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
-			conn->ca.pending_fast_retransmit_bytes = 0;
-			conn->ca.cwnd = conn->ca.ssthresh;
+		cubic->w_max = flight;
+	}
+
+	cubic->epoch_start = 0;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2, flight * TCP_CUBIC_BETA / 10);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_ca_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	int32_t mss = conn_mss(conn);
+	int32_t win_inc = MIN(acked_len, mss);
+	int32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t t, target;
+
+	if (tcp_ca_recovery_acked(conn, acked_len)) {
+		goto out;
+	}
+
+	if (cwnd < conn->ca.ssthresh) {
+		conn->ca.cwnd = MIN(cwnd + win_inc, UINT16_MAX);
+		goto out;
+	}
+
+	if (cubic->epoch_start == 0) {
+		/* Start of a congestion avoidance epoch */
+		cubic->epoch_start = MAX(now, 1);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((w_max - cwnd) / C), in ms */
+			cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						  2500000000ULL / mss);
+			cubic->origin = cubic->w_max;
 		} else {
-			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
+			cubic->k = 0;
+			cubic->origin = cwnd;
 		}
 	}
-	tcp_new_reno_log(conn, "pkts_acked");
+
+	/* Target is the window function one RTT ahead, C * (t - K)^3 + w_max,
+	 * limited to 1.5 times the current window.
+	 */
+	t = (int64_t)(now - cubic->epoch_start) + conn->ca.srtt - cubic->k;
+	t = CLAMP(t, -TCP_CUBIC_MAX_T_MS, TCP_CUBIC_MAX_T_MS);
+	target = cubic->origin + (t * t * t * mss * 4) / 10000000000LL;
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2);
+
+	/* Do at least as well as Reno would, with alpha = 3 * (1 - beta) / (1 + beta) */
+	cubic->w_est = MIN(cubic->w_est + (9 * win_inc * win_inc + 17 * cwnd - 1) / (17 * cwnd),
+			   UINT16_MAX);
+	target = MAX(target, cubic->w_est);
+
+	cwnd += ((target - cwnd) * win_inc + cwnd - 1) / cwnd;
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+
+out:
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_cubic_ops = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+
+/* Model based congestion control after BBR: estimate the bottleneck
+ * bandwidth and the minimum RTT, and keep a multiple of their product
+ * in flight. Packets are not paced, so the gains (in percent) apply
+ * to the congestion window, which is twice the estimated BDP once the
+ * bandwidth is found, cycling between probing for more and draining
+ * the queue this created.
+ */
+#define TCP_BBR_STARTUP_GAIN 289
+#define TCP_BBR_DRAIN_GAIN 100
+#define TCP_BBR_BW_WIN_ROUNDS 10
+#define TCP_BBR_FULL_BW_ROUNDS 3
+#define TCP_BBR_MIN_CWND_SEGS 4
+
+static const uint16_t tcp_bbr_cycle_gain[] = {
+	250, 150, 200, 200, 200, 200, 200, 200
+};
+
+static uint32_t tcp_bbr_bdp(struct tcp *conn, uint32_t gain)
+{
+	uint64_t bdp = (uint64_t)conn->ca.bbr.btl_bw * conn->ca.min_rtt / MSEC_PER_SEC;
+
+	return MIN(bdp * gain / 100, UINT16_MAX);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+
+	tcp_ca_base_init(conn);
+	memset(bbr, 0, sizeof(*bbr));
+	/* Probe like slow start until the bandwidth stops growing */
+	conn->ca.ssthresh = UINT16_MAX;
+	conn->ca.cwnd = conn_mss(conn) * TCP_BBR_MIN_CWND_SEGS;
+	bbr->mode = TCP_CA_BBR_STARTUP;
+	bbr->round_start = k_uptime_get_32();
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+	tcp_ca_log(conn, "init");
+}
+
+/* Losses are not a congestion signal for the model, but in-flight data
+ * is brought back to the estimated BDP.
+ */
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	uint16_t bdp = tcp_bbr_bdp(conn, 100);
+
+	if (bdp > 0) {
+		conn->ca.cwnd = MAX(bdp, conn_mss(conn) * TCP_BBR_MIN_CWND_SEGS);
+	}
+
+	tcp_ca_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_ca_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+/* Update the model once all data sent at the start of the round is acked */
+static void tcp_bbr_round_end(struct tcp *conn, uint32_t now)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	uint32_t elapsed = MAX(now - bbr->round_start, 1);
+	uint32_t bw = (uint64_t)bbr->round_delivered * MSEC_PER_SEC / elapsed;
+
+	bbr->round_count++;
+
+	/* Windowed max filter of the delivery rate */
+	if (bw >= bbr->btl_bw ||
+	    (uint16_t)(bbr->round_count - bbr->btl_bw_round) > TCP_BBR_BW_WIN_ROUNDS) {
+		bbr->btl_bw = bw;
+		bbr->btl_bw_round = bbr->round_count;
+	}
+
+	switch (bbr->mode) {
+	case TCP_CA_BBR_STARTUP:
+		if (bbr->btl_bw >= bbr->full_bw + bbr->full_bw / 4) {
+			bbr->full_bw = bbr->btl_bw;
+			bbr->full_bw_count = 0;
+		} else if (++bbr->full_bw_count >= TCP_BBR_FULL_BW_ROUNDS) {
+			bbr->mode = TCP_CA_BBR_DRAIN;
+		}
+		break;
+	case TCP_CA_BBR_DRAIN:
+		if (conn->unacked_len <= tcp_bbr_bdp(conn, 100)) {
+			bbr->mode = TCP_CA_BBR_PROBE_BW;
+			bbr->cycle_idx = 0;
+		}
+		break;
+	case TCP_CA_BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(tcp_bbr_cycle_gain);
+		break;
+	}
+
+	bbr->round_delivered = 0;
+	bbr->round_start = now;
+	bbr->round_end_seq = conn->seq + conn->unacked_len;
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_bbr *bbr = &conn->ca.bbr;
+	int32_t cwnd = conn->ca.cwnd + acked_len;
+	uint32_t gain;
+
+	bbr->round_delivered += acked_len;
+	if (net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end_seq) >= 0) {
+		tcp_bbr_round_end(conn, k_uptime_get_32());
+	}
+
+	if (bbr->mode != TCP_CA_BBR_STARTUP && conn->ca.min_rtt > 0) {
+		gain = (bbr->mode == TCP_CA_BBR_DRAIN) ? TCP_BBR_DRAIN_GAIN :
+			tcp_bbr_cycle_gain[bbr->cycle_idx];
+		cwnd = MIN(cwnd, tcp_bbr_bdp(conn, gain));
+	}
+
+	cwnd = MAX(cwnd, conn_mss(conn) * TCP_BBR_MIN_CWND_SEGS);
+	conn->ca.cwnd = MIN(cwnd, UINT16_MAX);
+	tcp_ca_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_bbr_ops = {
+	.name = "bbr",
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.dup_ack = tcp_bbr_dup_ack,
+	.pkts_acked = tcp_bbr_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_BBR */
+
+static const struct tcp_ca_ops *const tcp_ca_algos[] = {
+	&tcp_new_reno_ops,
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+	&tcp_cubic_ops,
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+	&tcp_bbr_ops,
+#endif
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT (&tcp_cubic_ops)
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT (&tcp_bbr_ops)
+#else
+#define TCP_CA_DEFAULT (&tcp_new_reno_ops)
+#endif
+
+/* Time the data just sent, if no other RTT measurement is pending */
+static void tcp_ca_rtt_start(struct tcp *conn)
+{
+	if (conn->ca.rtt_pending || conn->data_mode != TCP_DATA_MODE_SEND) {
+		return;
+	}
+
+	conn->ca.rtt_pending = true;
+	conn->ca.rtt_seq = conn->seq + conn->unacked_len;
+	conn->ca.rtt_start = k_uptime_get_32();
+}
+
+static void tcp_ca_rtt_update(struct tcp *conn, uint32_t ack)
+{
+	uint32_t now, rtt;
+
+	if (!conn->ca.rtt_pending || net_tcp_seq_cmp(ack, conn->ca.rtt_seq) < 0) {
+		return;
+	}
+
+	now = k_uptime_get_32();
+	rtt = MAX(now - conn->ca.rtt_start, 1);
+	conn->ca.rtt_pending = false;
+
+	/* Smoothed as in RFC6298 */
+	if (conn->ca.srtt == 0) {
+		conn->ca.srtt = rtt;
+	} else {
+		conn->ca.srtt = (7 * conn->ca.srtt + rtt) / 8;
+	}
+
+	if (conn->ca.min_rtt == 0 || rtt <= conn->ca.min_rtt ||
+	    now - conn->ca.min_rtt_stamp > TCP_CA_MIN_RTT_WIN_MS) {
+		conn->ca.min_rtt = rtt;
+		conn->ca.min_rtt_stamp = now;
+	}
 }
 
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.ops->init(conn);
 }
 
+/* Retransmitted data gives no RTT sample (Karn's algorithm) */
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.rtt_pending = false;
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	tcp_ca_rtt_update(conn, conn->seq + acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	char name[TCP_CA_NAME_MAX];
+
+	if (value == NULL || len == 0 || len > sizeof(name)) {
+		return -EINVAL;
+	}
+
+	memcpy(name, value, len);
+	name[MIN(len, sizeof(name) - 1)] = '\0';
+
+	ARRAY_FOR_EACH(tcp_ca_algos, i) {
+		if (strcmp(name, tcp_ca_algos[i]->name) != 0) {
+			continue;
+		}
+
+		conn->ca.ops = tcp_ca_algos[i];
+
+		/* Otherwise done when the connection gets established */
+		if (conn->state == TCP_ESTABLISHED ||
+		    conn->state == TCP_CLOSE_WAIT) {
+			tcp_ca_init(conn);
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->ca.ops->name, *len);
+
+	return 0;
 }
 #else
 
@@ -550,6 +1020,18 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_rtt_start(struct tcp *conn) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	return -ENOPROTOOPT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	return -ENOPROTOOPT;
+}
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -752,6 +1234,77 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+/* Zero-copy data is queued in send_data as buffers pointing to the
+ * application data. Segments reference it through buffers of their own,
+ * each holding a reference to the queued one. The application is told
+ * when the queued buffer is freed, as it then is neither queued nor used
+ * by any segment anymore.
+ */
+struct tcp_zc {
+	/* Queued buffer, NULL for the queued buffer itself */
+	struct net_buf *parent;
+	net_context_zerocopy_cb_t cb;
+	void *user_data;
+	const void *data;
+	size_t len;
+	int status;
+};
+
+static void tcp_zc_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(tcp_zc_pool, CONFIG_NET_TCP_ZEROCOPY_BUF_COUNT, 0,
+		    sizeof(struct tcp_zc), tcp_zc_destroy);
+
+static void tcp_zc_destroy(struct net_buf *buf)
+{
+	struct tcp_zc zc = *(struct tcp_zc *)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+
+	if (zc.parent != NULL) {
+		net_buf_unref(zc.parent);
+	} else {
+		zc.cb(zc.data, zc.len, zc.status, zc.user_data);
+	}
+}
+
+static bool tcp_buf_is_zc(struct net_buf *buf)
+{
+	return net_buf_pool_get(buf->pool_id) == &tcp_zc_pool;
+}
+
+static struct net_buf *tcp_zc_ref(struct net_buf *parent, size_t offset,
+				  size_t len)
+{
+	struct net_buf *buf;
+	struct tcp_zc *zc;
+
+	buf = net_buf_alloc_with_data(&tcp_zc_pool, parent->data + offset, len,
+				      TCP_PKT_ALLOC_TIMEOUT);
+	if (buf == NULL) {
+		return NULL;
+	}
+
+	zc = net_buf_user_data(buf);
+	zc->parent = net_buf_ref(parent);
+
+	return buf;
+}
+
+/* Data still queued when the connection goes away was not acknowledged */
+static void tcp_zc_abort(struct net_pkt *send_data)
+{
+	for (struct net_buf *buf = send_data->buffer; buf != NULL; buf = buf->frags) {
+		if (tcp_buf_is_zc(buf)) {
+			((struct tcp_zc *)net_buf_user_data(buf))->status = -ECONNABORTED;
+		}
+	}
+}
+#else
+#define tcp_zc_abort(send_data)
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
+
 static void tcp_conn_release(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, conn_release);
@@ -794,10 +1347,11 @@ static void tcp_conn_release(struct k_work *work)
 	tcp_send_queue_flush(conn);
 
 	(void)k_work_cancel_delayable(&conn->send_data_timer);
+	tcp_zc_abort(conn->send_data);
 	tcp_pkt_unref(conn->send_data);
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		tcp_pkt_unref(conn->queue_recv_data);
+		tcp_ooo_flush(conn);
 	}
 
 	(void)k_work_cancel_delayable(&conn->timewait_timer);
@@ -854,6 +1408,142 @@ static int tcp_conn_unref(struct tcp *conn)
 	return ref_count;
 }
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Connections with data merged during the current RX bursts */
+static sys_slist_t tcp_gro_conns = SYS_SLIST_STATIC_INIT(&tcp_gro_conns);
+static struct k_spinlock tcp_gro_lock;
+static int tcp_gro_bursts;
+
+/* Keep only the data of the packet, the headers were processed already */
+static void tcp_gro_merge(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	while (buf != NULL && buf != pkt->cursor.buf) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	if (buf != NULL) {
+		net_buf_pull(buf, pkt->cursor.pos - buf->data);
+		net_pkt_append_buffer(conn->gro_pkt, buf);
+	}
+
+	pkt->buffer = NULL;
+	tcp_pkt_unref(pkt);
+	conn->gro_segs++;
+}
+
+/* Called with the connection locked, returns true if pkt was taken */
+static bool tcp_gro_add(struct tcp *conn, struct net_pkt *pkt)
+{
+	k_spinlock_key_t key;
+
+	/* Whoever queued the connection will pass the data on */
+	if (conn->gro_pkt != NULL) {
+		tcp_gro_merge(conn, pkt);
+		return true;
+	}
+
+	key = k_spin_lock(&tcp_gro_lock);
+
+	if (tcp_gro_bursts == 0) {
+		k_spin_unlock(&tcp_gro_lock, key);
+		return false;
+	}
+
+	if (!conn->gro_queued) {
+		tcp_conn_ref(conn);
+		sys_slist_append(&tcp_gro_conns, &conn->gro_node);
+		conn->gro_queued = true;
+	}
+
+	k_spin_unlock(&tcp_gro_lock, key);
+
+	conn->gro_pkt = pkt;
+	conn->gro_segs = 1;
+
+	return true;
+}
+
+static void tcp_gro_flush(struct tcp *conn)
+{
+	struct net_conn *conn_handler = NULL;
+	void *recv_user_data;
+	struct net_pkt *pkt;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	pkt = conn->gro_pkt;
+	conn->gro_pkt = NULL;
+
+	if (conn->gro_ack) {
+		conn->gro_ack = false;
+
+		if (conn->state != TCP_CLOSED && conn->state != TCP_UNUSED) {
+			k_work_cancel_delayable(&conn->ack_timer);
+			tcp_out(conn, ACK);
+		}
+	}
+
+	if (conn->context != NULL) {
+		conn_handler = (struct net_conn *)conn->context->conn_handler;
+	}
+
+	recv_user_data = conn->recv_user_data;
+
+	k_mutex_unlock(&conn->lock);
+
+	/* Like in tcp_in(), without holding the connection lock */
+	if (pkt != NULL &&
+	    (conn_handler == NULL ||
+	     net_context_packet_received(conn_handler, pkt, NULL, NULL,
+					 recv_user_data) == NET_DROP)) {
+		tcp_pkt_unref(pkt);
+	}
+}
+
+void net_tcp_gro_begin(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&tcp_gro_lock);
+
+	tcp_gro_bursts++;
+
+	k_spin_unlock(&tcp_gro_lock, key);
+}
+
+void net_tcp_gro_end(void)
+{
+	sys_slist_t conns;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	struct tcp *conn;
+
+	key = k_spin_lock(&tcp_gro_lock);
+	tcp_gro_bursts--;
+	conns = tcp_gro_conns;
+	sys_slist_init(&tcp_gro_conns);
+	k_spin_unlock(&tcp_gro_lock, key);
+
+	while (true) {
+		/* The connection may be queued again once out of the list */
+		key = k_spin_lock(&tcp_gro_lock);
+		node = sys_slist_get(&conns);
+		if (node != NULL) {
+			conn = CONTAINER_OF(node, struct tcp, gro_node);
+			conn->gro_queued = false;
+		}
+		k_spin_unlock(&tcp_gro_lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		tcp_gro_flush(conn);
+		tcp_conn_unref(conn);
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 #define tcp_conn_close(conn, status)				\
 	tcp_conn_close_debug(conn, status, __func__, __LINE__)
@@ -867,6 +1557,10 @@ static int tcp_conn_close(struct tcp *conn, int status)
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 	NET_DBG("conn: %p closed by TCP stack (%s():%d)", conn, caller, line);
 #endif
+#if defined(CONFIG_NET_TCP_GRO)
+	/* Merged data must reach the application before the EOF */
+	tcp_gro_flush(conn);
+#endif /* CONFIG_NET_TCP_GRO */
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	conn_state(conn, TCP_CLOSED);
 	keep_alive_timer_stop(conn);
@@ -1148,6 +1842,34 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + sizeof(struct tcp_sack_block) ||
+			    (opt_len - 2) % sizeof(struct tcp_sack_block) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count =
+				MIN((opt_len - 2) / sizeof(struct tcp_sack_block),
+				    NET_TCP_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *block = options + 2 + i * sizeof(struct tcp_sack_block);
+
+				recv_options->sack[i].start = sys_get_be32(block);
+				recv_options->sack[i].end = sys_get_be32(block + 4);
+			}
+			break;
+#endif /* CONFIG_NET_TCP_SACK */
 		default:
 			continue;
 		}
@@ -1223,60 +1945,46 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
+	struct tcphdr *th = th_get(pkt);
+	uint32_t expected_seq = th_seq(th) + len;
 	size_t pending_len = 0;
+	bool dequeued = false;
+	struct rbnode *node;
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
-	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
-		 */
-		struct tcphdr *th = th_get(pkt);
-		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
-			}
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
+		return 0;
+	}
 
-			NET_DBG("Found pending data seq %u len %zd",
-				expected_seq, pending_len);
+	/* Append the queued ranges the incoming data reaches, dropping the
+	 * part of them that it already has.
+	 */
+	while ((node = rb_get_min(&conn->ooo_ranges)) != NULL) {
+		struct tcp_ooo_range *range =
+			CONTAINER_OF(node, struct tcp_ooo_range, node);
+		uint32_t overlap = expected_seq - range->seq;
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+		if (net_tcp_seq_cmp(range->seq, expected_seq) > 0) {
+			break;
+		}
 
-			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
+		if (overlap < range->len) {
+			NET_DBG("Found pending data seq %u len %u",
+				expected_seq, range->len - overlap);
 
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
+			range->buf = tcp_buf_pull(range->buf, overlap);
+			net_buf_frag_add(pkt->buffer, range->buf);
+			range->buf = NULL;
 
-			pending_len = 0;
+			pending_len += range->len - overlap;
+			expected_seq += range->len - overlap;
 		}
+
+		tcp_ooo_free(conn, range);
+		dequeued = true;
+	}
+
+	if (dequeued && conn->ooo_ranges.root == NULL) {
+		k_work_cancel_delayable(&conn->recv_queue_timer);
 	}
 
 	return pending_len;
@@ -1315,6 +2023,12 @@ static enum net_verdict tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size
 		 * data is placed in fifo which is flushed in tcp_in()
 		 * after unlocking the conn
 		 */
+#if defined(CONFIG_NET_TCP_GRO)
+		if (tcp_gro_add(conn, pkt)) {
+			ret = NET_OK;
+			goto out;
+		}
+#endif /* CONFIG_NET_TCP_GRO */
 		k_fifo_put(&conn->recv_data, pkt);
 
 		ret = NET_OK;
@@ -1338,8 +2052,124 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_NET_TCP_TSO)
+static struct net_pkt *tcp_tso_seg_alloc(struct net_pkt *pkt, size_t len)
+{
+	struct net_pkt *seg;
+
+	/* Get all the attributes of the packet, but none of its data */
+	seg = net_pkt_shallow_clone(pkt, TCP_PKT_ALLOC_TIMEOUT);
+	if (seg == NULL) {
+		return NULL;
+	}
+
+	net_pkt_frag_unref(seg->buffer);
+	seg->buffer = NULL;
+	net_pkt_set_tso_mss(seg, 0);
+
+	if (net_pkt_alloc_buffer_raw(seg, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		tcp_pkt_unref(seg);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+}
+
+static int tcp_tso_seg_finalize(struct net_pkt *seg, uint32_t seq, uint8_t flags)
+{
+	struct tcphdr *th;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		/* The checksum is computed over the header */
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	}
+
+	th = th_get(seg);
+	if (th == NULL) {
+		return -ENOBUFS;
+	}
+
+	UNALIGNED_PUT(htonl(seq), &th->th_seq);
+	UNALIGNED_PUT(flags, &th->th_flags);
+
+	return tcp_finalize_pkt(seg);
+}
+
+int net_tcp_tso_segment(struct net_if *iface, struct net_pkt *pkt,
+			int (*send)(struct net_if *iface, struct net_pkt *pkt))
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t mss = net_pkt_tso_mss(pkt);
+	size_t hdr_len, data_len, len;
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret = 0;
+
+	th = th_get(pkt);
+	if (th == NULL) {
+		return -EINVAL;
+	}
+
+	hdr_len = ip_len + th->th_off * 4U;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	if (net_pkt_get_len(pkt) < hdr_len) {
+		return -EINVAL;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < data_len; offset += len) {
+		len = MIN(mss, data_len - offset);
+
+		seg = tcp_tso_seg_alloc(pkt, hdr_len + len);
+		if (seg == NULL) {
+			ret = -ENOBUFS;
+			break;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		if (net_pkt_copy(seg, pkt, hdr_len) < 0 ||
+		    net_pkt_skip(pkt, offset) < 0 ||
+		    net_pkt_copy(seg, pkt, len) < 0) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		/* Only the last segment ends the data */
+		ret = tcp_tso_seg_finalize(seg, seq + offset,
+					   (offset + len < data_len) ?
+					   (flags & ~(FIN | PSH)) : flags);
+		if (ret < 0) {
+			tcp_pkt_unref(seg);
+			break;
+		}
+
+		ret = send(iface, seg);
+		if (ret < 0) {
+			tcp_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+	}
+
+	net_pkt_set_overwrite(pkt, false);
+
+	return (ret < 0) ? ret : sent;
+}
+#endif /* CONFIG_NET_TCP_TSO */
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1353,11 +2183,7 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
@@ -1412,30 +2238,102 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 
 	*((int *)value) = no_delay_int;
 
-	if (len) {
-		*len = sizeof(int);
+	if (len) {
+		*len = sizeof(int);
+	}
+	return 0;
+}
+
+static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
+	struct tcp_mss_option *mss;
+	uint32_t recv_mss;
+
+	mss = net_pkt_get_data(pkt, &mss_opt_access);
+	if (!mss) {
+		return -ENOBUFS;
+	}
+
+	recv_mss = net_tcp_get_supported_mss(conn);
+	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+
+	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+
+	return net_pkt_set_data(pkt, &mss_opt_access);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+static int net_tcp_set_sack_perm_opt(struct net_pkt *pkt)
+{
+	const uint8_t opt[] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+	};
+
+	return net_pkt_write(pkt, opt, sizeof(opt));
+}
+
+/* Get the SACK blocks to send, the first one holding the latest received
+ * data as required by RFC 2018. Only sent in packets without data, so that
+ * the segments keep their size.
+ */
+static int tcp_sack_blocks_get(struct tcp *conn, uint8_t flags,
+			       struct net_pkt *data,
+			       struct tcp_sack_block *blocks)
+{
+	struct tcp_ooo_range *last, *range;
+	int count = 0;
+
+	if (!conn->sack_ok || data != NULL || (flags & (ACK | SYN)) != ACK) {
+		return 0;
+	}
+
+	last = tcp_ooo_find(conn, conn->sack_last_seq, false);
+	if (last == NULL) {
+		return 0;
+	}
+
+	blocks[count].start = last->seq;
+	blocks[count].end = last->seq + last->len;
+	count++;
+
+	RB_FOR_EACH_CONTAINER(&conn->ooo_ranges, range, node) {
+		if (count == NET_TCP_SACK_BLOCKS) {
+			break;
+		}
+
+		if (range == last) {
+			continue;
+		}
+
+		blocks[count].start = range->seq;
+		blocks[count].end = range->seq + range->len;
+		count++;
 	}
-	return 0;
+
+	return count;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+static int net_tcp_set_sack_opt(struct net_pkt *pkt,
+				const struct tcp_sack_block *blocks, int count)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
-
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
-	}
+	uint8_t opt[4 + NET_TCP_SACK_BLOCKS * sizeof(struct tcp_sack_block)];
+	size_t len = 4 + count * sizeof(struct tcp_sack_block);
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	opt[0] = NET_TCP_NOP_OPT;
+	opt[1] = NET_TCP_NOP_OPT;
+	opt[2] = NET_TCP_SACK_OPT;
+	opt[3] = len - 2;
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	for (int i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].start, &opt[4 + i * sizeof(struct tcp_sack_block)]);
+		sys_put_be32(blocks[i].end, &opt[8 + i * sizeof(struct tcp_sack_block)]);
+	}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return net_pkt_write(pkt, opt, len);
 }
+#endif /* CONFIG_NET_TCP_SACK */
 
 static bool is_destination_local(struct net_pkt *pkt)
 {
@@ -1545,15 +2443,29 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	size_t opts_len = 0;
 	struct net_pkt *pkt;
 	int ret = 0;
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+	int sack_count = tcp_sack_blocks_get(conn, flags, data, sack);
+	bool sack_perm = conn->send_options.mss_found && conn->sack_ok;
+
+	if (sack_perm) {
+		opts_len += NET_TCP_NOP_SIZE * 2 + NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (sack_count > 0) {
+		opts_len += NET_TCP_NOP_SIZE * 2 + 2 +
+			    sack_count * sizeof(struct tcp_sack_block);
+	}
+#endif /* CONFIG_NET_TCP_SACK */
 
 	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
+		opts_len += sizeof(uint32_t);
 	}
 
-	pkt = tcp_pkt_alloc(conn, alloc_len);
+	pkt = tcp_pkt_alloc(conn, sizeof(struct tcphdr) + opts_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
 		goto out;
@@ -1562,6 +2474,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_tso_mss(pkt, net_pkt_tso_mss(data));
 		data->buffer = NULL;
 	}
 
@@ -1571,7 +2484,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1585,6 +2498,24 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	if (sack_perm) {
+		ret = net_tcp_set_sack_perm_opt(pkt);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+	if (sack_count > 0) {
+		ret = net_tcp_set_sack_opt(pkt, sack, sack_count);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+#endif /* CONFIG_NET_TCP_SACK */
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1631,14 +2562,80 @@ static int tcp_pkt_pull(struct net_pkt *pkt, size_t len)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+	/* Zero-copy data must not be moved, drop it from the buffers */
+	while (len > 0) {
+		struct net_buf *buf = pkt->buffer;
+		size_t pull_len = MIN(len, buf->len);
+
+		net_buf_pull(buf, pull_len);
+		len -= pull_len;
+
+		if (buf->len == 0) {
+			pkt->buffer = buf->frags;
+			buf->frags = NULL;
+			net_buf_unref(buf);
+		}
+	}
+
+	net_pkt_cursor_init(pkt);
+#else
 	net_pkt_cursor_init(pkt);
 	net_pkt_set_overwrite(pkt, true);
 	net_pkt_pull(pkt, len);
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
 	net_pkt_trim_buffer(pkt);
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+/* Zero-copy data is referenced, other data copied into new buffers */
+static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
+			size_t len)
+{
+	struct net_buf *src = from->buffer;
+
+	while (src != NULL && pos >= src->len) {
+		pos -= src->len;
+		src = src->frags;
+	}
+
+	while (src != NULL && len > 0) {
+		size_t src_len = MIN(len, src->len - pos);
+		struct net_buf *buf;
+
+		if (tcp_buf_is_zc(src)) {
+			buf = tcp_zc_ref(src, pos, src_len);
+			if (buf == NULL) {
+				return -ENOBUFS;
+			}
+
+			net_pkt_append_buffer(to, buf);
+			pos += src_len;
+			len -= src_len;
+		} else {
+			buf = net_pkt_get_frag(to, src_len, TCP_PKT_ALLOC_TIMEOUT);
+			if (buf == NULL) {
+				return -ENOBUFS;
+			}
+
+			net_pkt_append_buffer(to, buf);
+			src_len = MIN(src_len, net_buf_tailroom(buf));
+			net_buf_add_mem(buf, src->data + pos, src_len);
+			pos += src_len;
+			len -= src_len;
+		}
+
+		if (pos == src->len) {
+			pos = 0;
+			src = src->frags;
+		}
+	}
+
+	return len == 0 ? 0 : -EINVAL;
+}
+#else
 static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 			size_t len)
 {
@@ -1652,6 +2649,7 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 
 	return net_pkt_copy(to, from, len);
 }
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
 
 static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
 {
@@ -1740,13 +2738,101 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Largest amount of data to send in one packet */
+static int tcp_send_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_TSO)
+	/* Ethernet splits larger packets, in hardware if it can. Leave
+	 * buffers for the segments of the software fallback.
+	 */
+	if (conn->iface != NULL &&
+	    net_if_l2(conn->iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		return MAX(mss, MIN(CONFIG_NET_TCP_TSO_MAX_SIZE, tcp_tx_window / 2));
+	}
+#endif /* CONFIG_NET_TCP_TSO */
+
+	return mss;
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Keep the SACK blocks of an incoming ACK that are above it and within the
+ * sent data. The peer repeats the blocks still relevant in each ACK.
+ */
+static void tcp_sack_update(struct tcp *conn, uint32_t ack)
+{
+	struct tcp_options *options = &conn->recv_options;
+	uint32_t end = conn->seq + conn->send_data_total;
+
+	conn->sacked_count = 0;
+
+	for (int i = 0; i < options->sack_count; i++) {
+		struct tcp_sack_block *block = &options->sack[i];
+
+		if (net_tcp_seq_cmp(block->start, ack) <= 0 ||
+		    net_tcp_seq_cmp(block->end, end) > 0 ||
+		    net_tcp_seq_cmp(block->end, block->start) <= 0) {
+			continue;
+		}
+
+		conn->sacked[conn->sacked_count++] = *block;
+	}
+}
+
+/* Move the send position past data the peer already has */
+static void tcp_sack_skip(struct tcp *conn)
+{
+	bool skipped;
+
+	do {
+		uint32_t pos = conn->seq + conn->unacked_len;
+
+		skipped = false;
+
+		for (int i = 0; i < conn->sacked_count; i++) {
+			if (net_tcp_seq_cmp(conn->sacked[i].start, pos) <= 0 &&
+			    net_tcp_seq_cmp(conn->sacked[i].end, pos) > 0) {
+				conn->unacked_len = conn->sacked[i].end - conn->seq;
+				skipped = true;
+			}
+		}
+	} while (skipped);
+}
+
+/* Stop sending at the next data the peer already has */
+static int tcp_sack_limit(struct tcp *conn, int len)
+{
+	uint32_t pos = conn->seq + conn->unacked_len;
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		if (net_tcp_seq_cmp(conn->sacked[i].start, pos) > 0) {
+			len = MIN(len, (int)(conn->sacked[i].start - pos));
+		}
+	}
+
+	return len;
+}
+#else
+static void tcp_sack_update(struct tcp *conn, uint32_t ack) { }
+
+static void tcp_sack_skip(struct tcp *conn) { }
+
+static int tcp_sack_limit(struct tcp *conn, int len)
+{
+	return len;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	tcp_sack_skip(conn);
+
+	len = MIN(tcp_unsent_len(conn), tcp_send_max_len(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1757,7 +2843,10 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	len = tcp_sack_limit(conn, len);
+
+	/* Zero-copy segments get their buffers while peeking the data */
+	pkt = tcp_pkt_alloc(conn, IS_ENABLED(CONFIG_NET_TCP_ZEROCOPY) ? 0 : len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -1771,9 +2860,14 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
+	if (len > conn_mss(conn)) {
+		net_pkt_set_tso_mss(pkt, conn_mss(conn));
+	}
+
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
+		tcp_ca_rtt_start(conn);
 
 		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
@@ -1796,6 +2890,52 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_recovery_start(struct tcp *conn)
+{
+	conn->sack_recovery = conn->sacked_count > 0;
+	conn->sack_recovery_seq = conn->seq + conn->unacked_len;
+}
+
+/* During fast recovery, retransmit the next hole as soon as an ACK shows
+ * that the previous one has been filled, rather than waiting for three
+ * more duplicate ACKs or the retransmission timer.
+ */
+static void tcp_sack_recover(struct tcp *conn)
+{
+	int unacked_len = conn->unacked_len;
+
+	if (!conn->sack_recovery || conn->data_mode != TCP_DATA_MODE_SEND) {
+		return;
+	}
+
+	if (conn->sacked_count == 0 ||
+	    net_tcp_seq_cmp(conn->seq, conn->sack_recovery_seq) >= 0) {
+		conn->sack_recovery = false;
+		return;
+	}
+
+	conn->data_mode = TCP_DATA_MODE_RESEND;
+	conn->unacked_len = 0;
+	(void)tcp_send_data(conn);
+	conn->unacked_len = unacked_len;
+	conn->data_mode = TCP_DATA_MODE_SEND;
+}
+
+/* The peer may drop data it has acknowledged selectively (RFC 2018, section 8) */
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_count = 0;
+	conn->sack_recovery = false;
+}
+#else
+static void tcp_sack_recovery_start(struct tcp *conn) { }
+
+static void tcp_sack_recover(struct tcp *conn) { }
+
+static void tcp_sack_reset(struct tcp *conn) { }
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1851,12 +2991,9 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 
 	k_mutex_lock(&conn->lock, K_FOREVER);
 
-	NET_DBG("Cleanup recv queue conn %p len %zd seq %u", conn,
-		net_pkt_get_len(conn->queue_recv_data),
-		tcp_get_seq(conn->queue_recv_data->buffer));
+	NET_DBG("Cleanup recv queue conn %p", conn);
 
-	net_buf_unref(conn->queue_recv_data->buffer);
-	conn->queue_recv_data->buffer = NULL;
+	tcp_ooo_flush(conn);
 
 	k_mutex_unlock(&conn->lock);
 }
@@ -1889,6 +3026,7 @@ static void tcp_resend_data(struct k_work *work)
 
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
+	tcp_sack_reset(conn);
 
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
@@ -2106,14 +3244,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	memset(conn, 0, sizeof(*conn));
 
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-		conn->queue_recv_data = tcp_rx_pkt_alloc(conn, 0);
-		if (conn->queue_recv_data == NULL) {
-			NET_ERR("Cannot allocate %s queue for conn %p", "recv",
-				conn);
-			goto fail;
-		}
-	}
+	conn->ooo_ranges.lessthan_fn = tcp_ooo_lessthan;
 
 	conn->send_data = tcp_pkt_alloc(conn, 0);
 	if (conn->send_data == NULL) {
@@ -2143,6 +3274,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2173,11 +3305,6 @@ out:
 	return conn;
 
 fail:
-	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->queue_recv_data) {
-		tcp_pkt_unref(conn->queue_recv_data);
-		conn->queue_recv_data = NULL;
-	}
-
 	k_mem_slab_free(&tcp_conns_slab, (void *)conn);
 	return NULL;
 }
@@ -2551,165 +3678,69 @@ static enum tcp_state tcp_enter_time_wait(struct tcp *conn)
 	return TCP_TIME_WAIT;
 }
 
-static bool check_seq_list(struct net_buf *buf)
-{
-	struct net_buf *last = NULL;
-	struct net_buf *tmp = buf;
-	uint32_t seq;
-	uint32_t next_seq = 0;
-	bool result = true;
-
-	while (tmp) {
-		seq = tcp_get_seq(tmp);
-
-		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
-
-		if (last != NULL) {
-			if (next_seq != seq) {
-				result = false;
-			}
-		}
-
-		next_seq = seq + tmp->len;
-		last = tmp;
-		tmp = tmp->frags;
-	}
-	return result;
-}
-
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
-	uint32_t seq_start = seq;
-	bool inserted = false;
-	struct net_buf *tmp;
+	struct tcp_ooo_range *range, *next;
+	uint32_t overlap;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
-
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
-
-	while (tmp) {
-		tcp_set_seq(tmp, seq);
-		seq += tmp->len;
-		tmp = tmp->frags;
-	}
-
-	if (IS_ENABLED(CONFIG_NET_TCP_LOG_LEVEL_DBG)) {
-		NET_DBG("Queuing data: conn %p", conn);
-	}
-
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
-
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
-
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
-
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
-
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
-
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
-
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
-
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
+	/* Ranges are kept apart and sorted, so the data can only extend the
+	 * range it starts in or right after, and then swallow the following
+	 * ranges it reaches.
+	 */
+	range = tcp_ooo_find(conn, seq, false);
+	if (range != NULL &&
+	    net_tcp_seq_cmp(range->seq + range->len, seq) >= 0) {
+		overlap = range->seq + range->len - seq;
+		if (overlap >= len) {
+			NET_DBG("Data already queued");
+			return;
 		}
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
+		pkt->buffer = tcp_buf_pull(pkt->buffer, overlap);
+		net_buf_frag_insert(range->last, pkt->buffer);
+		range->last = net_buf_frag_last(pkt->buffer);
+		range->len += len - overlap;
+	} else {
+		if (k_mem_slab_alloc(&tcp_ooo_slab, (void **)&range, K_NO_WAIT) < 0) {
 			NET_DBG("Cannot add new data to queue");
+			return;
 		}
-	} else {
-		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
+
+		range->buf = pkt->buffer;
+		range->last = net_buf_frag_last(pkt->buffer);
+		range->seq = seq;
+		range->len = len;
+		rb_insert(&conn->ooo_ranges, &range->node);
+	}
+
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
+
+	while ((next = tcp_ooo_find(conn, range->seq, true)) != NULL &&
+	       net_tcp_seq_cmp(next->seq, range->seq + range->len) <= 0) {
+		overlap = range->seq + range->len - next->seq;
+		if (overlap < next->len) {
+			next->buf = tcp_buf_pull(next->buf, overlap);
+			net_buf_frag_insert(range->last, next->buf);
+			range->last = next->last;
+			range->len += next->len - overlap;
+			next->buf = NULL;
+		}
+
+		tcp_ooo_free(conn, next);
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_last_seq = seq;
+#endif
 
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 	}
 }
 
@@ -2727,6 +3758,17 @@ static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 	net_stats_update_tcp_seg_recv(conn->iface);
 	conn_ack(conn, *len);
 
+#if defined(CONFIG_NET_TCP_GRO)
+	/* Acknowledge merged data once at the end of the burst. Besides
+	 * PSH, two full segments are enough to do so, as in RFC 1122.
+	 */
+	if (conn->gro_pkt != NULL && !tcp_short_window(conn) &&
+	    (psh || conn->gro_segs >= 2)) {
+		conn->gro_ack = true;
+		return ret;
+	}
+#endif /* CONFIG_NET_TCP_GRO */
+
 	/* Delay ACK response in case of small window or missing PSH,
 	 * as described in RFC 813.
 	 */
@@ -2891,6 +3933,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Also when the packet has no options at all */
+	conn->recv_options.sack_perm_found = false;
+	conn->recv_options.sack_count = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2944,6 +3992,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2971,6 +4022,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3059,6 +4113,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
 			conn_ack(conn, th_seq(th) + 1);
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->sack_ok = conn->recv_options.sack_perm_found;
+#endif
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
 				if (verdict == NET_OK) {
@@ -3129,6 +4186,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn, th_ack(th));
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3158,6 +4217,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 				/* Restore the current transmission */
 				conn->unacked_len = temp_unacked_len;
+				tcp_sack_recovery_start(conn);
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
@@ -3217,6 +4277,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 			conn_send_data_dump(conn);
 
+			tcp_sack_recover(conn);
+
 			conn->send_data_retries = 0;
 			if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 				conn->unacked_len = 0;
@@ -3696,6 +4758,30 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	return ret;
 }
 
+/* Account for data appended to send_data and try to send it */
+static int tcp_queued(struct tcp *conn, size_t queued_len)
+{
+	int ret;
+
+	conn->send_data_total += queued_len;
+
+	/* Successfully queued data for transmission. Even if there's a transmit
+	 * failure now (out-of-buf case), it can be ignored for now, retransmit
+	 * timer will take care of queued data retransmission.
+	 */
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_conn_close(conn, ret);
+		return ret;
+	}
+
+	if (tcp_window_full(conn)) {
+		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+	}
+
+	return queued_len;
+}
+
 int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		  const struct msghdr *msg)
 {
@@ -3764,28 +4850,67 @@ int net_tcp_queue(struct net_context *context, const void *data, size_t len,
 		queued_len = len;
 	}
 
-	conn->send_data_total += queued_len;
+	ret = tcp_queued(conn, queued_len);
+out:
+	k_mutex_unlock(&conn->lock);
 
-	/* Successfully queued data for transmission. Even if there's a transmit
-	 * failure now (out-of-buf case), it can be ignored for now, retransmit
-	 * timer will take care of queued data retransmission.
-	 */
-	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_close(conn, ret);
-		goto out;
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+int net_tcp_queue_zerocopy(struct net_context *context, const void *data,
+			   size_t len, net_context_zerocopy_cb_t cb,
+			   void *user_data)
+{
+	struct tcp *conn = context->tcp;
+	struct net_buf *buf;
+	struct tcp_zc *zc;
+	int ret = 0;
+
+	if (!conn || conn->state != TCP_ESTABLISHED) {
+		return -ENOTCONN;
 	}
 
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
 	if (tcp_window_full(conn)) {
-		(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
+		ret = -EAGAIN;
+		goto out;
+	}
+
+	/* Buffer lengths are 16 bits */
+	len = MIN(conn->send_win - conn->send_data_total, len);
+	len = MIN(len, UINT16_MAX);
+	if (len == 0) {
+		goto out;
+	}
+
+	/* The stack never writes to it, the buffer only points to it */
+	buf = net_buf_alloc_with_data(&tcp_zc_pool, (void *)data, len, K_NO_WAIT);
+	if (buf == NULL) {
+		ret = -ENOBUFS;
+		goto out;
 	}
 
-	ret = queued_len;
+	zc = net_buf_user_data(buf);
+	zc->parent = NULL;
+	zc->cb = cb;
+	zc->user_data = user_data;
+	zc->data = data;
+	zc->len = len;
+	zc->status = 0;
+
+	net_pkt_append_buffer(conn->send_data, buf);
+
+	/* Once the data is queued, errors are reported to the callback */
+	(void)tcp_queued(conn, len);
+	ret = len;
 out:
 	k_mutex_unlock(&conn->lock);
 
 	return ret;
 }
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
 
 /* net context is about to send out queued data - inform caller only */
 int net_tcp_send_data(struct net_context *context, net_context_send_cb_t cb,
@@ -3806,6 +4931,10 @@ static int tcp_start_handshake(struct tcp *conn)
 	k_mutex_lock(&conn->lock, K_FOREVER);
 	tcp_check_sock_options(conn);
 	conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Offered, until the peer tells if it supports it too */
+	conn->sack_ok = true;
+#endif
 	ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 	if (ret < 0) {
 		k_mutex_unlock(&conn->lock);
@@ -4571,6 +5700,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4608,6 +5740,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
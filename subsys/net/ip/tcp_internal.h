@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -312,6 +313,90 @@ static inline int net_tcp_queue(struct net_context *context, const void *data,
 }
 #endif
 
+/**
+ * @brief Enqueue data for transmission without copying it
+ *
+ * @param context	Network context
+ * @param data		Pointer to the data, referenced until @p cb is called
+ * @param len		Number of bytes
+ * @param cb		Callback called when the data is no longer used
+ * @param user_data	User data given to @p cb
+ *
+ * @return Number of bytes queued if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+int net_tcp_queue_zerocopy(struct net_context *context, const void *data,
+			   size_t len, net_context_zerocopy_cb_t cb,
+			   void *user_data);
+#else
+static inline int net_tcp_queue_zerocopy(struct net_context *context,
+					 const void *data, size_t len,
+					 net_context_zerocopy_cb_t cb,
+					 void *user_data)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -EOPNOTSUPP;
+}
+#endif
+
+/**
+ * @brief Split a TCP packet built for segmentation offload
+ *
+ * Used by L2 to send the segments of a packet with net_pkt_tso_mss() set
+ * through an interface which cannot do it in hardware.
+ *
+ * @param iface		Interface the segments are sent to
+ * @param pkt		Packet to split, which is not released
+ * @param send		Function sending one segment, releasing it on success
+ *
+ * @return Number of bytes sent if ok, < 0 if error
+ */
+#if defined(CONFIG_NET_TCP_TSO)
+int net_tcp_tso_segment(struct net_if *iface, struct net_pkt *pkt,
+			int (*send)(struct net_if *iface, struct net_pkt *pkt));
+#else
+static inline int net_tcp_tso_segment(struct net_if *iface,
+				      struct net_pkt *pkt,
+				      int (*send)(struct net_if *iface,
+						  struct net_pkt *pkt))
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(send);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Tell TCP that an RX thread starts processing a burst of packets
+ *
+ * Until the matching net_tcp_gro_end(), the data of in-order segments of
+ * a connection is merged instead of being passed to the application.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_begin(void);
+#else
+static inline void net_tcp_gro_begin(void) { }
+#endif
+
+/**
+ * @brief Tell TCP that an RX thread is done with a burst of packets
+ *
+ * Passes the data merged during the burst to the applications, and sends
+ * the ACKs that were held back.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_end(void);
+#else
+static inline void net_tcp_gro_end(void) { }
+#endif
+
 /**
  * @brief Update TCP receive window
  *
@@ -227,37 +227,120 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+
+/* Max number of SACK blocks in an option, the most that fits in 40 bytes */
+#define NET_TCP_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	uint16_t mss;
 	uint16_t window;
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+};
+
+/* Contiguous range of out-of-order received data */
+struct tcp_ooo_range {
+	struct rbnode node;
+	struct net_buf *buf;
+	struct net_buf *last;
+	uint32_t seq;
+	uint32_t len;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
+/* Congestion control algorithm, selected per connection */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t epoch_start;	/* ms, 0 when not in congestion avoidance */
+	uint32_t k;		/* ms to get back to w_max */
+	uint16_t w_max;
+	uint16_t origin;
+	uint16_t w_est;
+};
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+enum tcp_ca_bbr_mode {
+	TCP_CA_BBR_STARTUP,
+	TCP_CA_BBR_DRAIN,
+	TCP_CA_BBR_PROBE_BW,
+};
+
+struct tcp_ca_bbr {
+	uint32_t btl_bw;	/* bytes/s, max of the recent rounds */
+	uint32_t full_bw;
+	uint32_t round_start;	/* ms */
+	uint32_t round_end_seq;
+	uint32_t round_delivered;
+	uint16_t round_count;
+	uint16_t btl_bw_round;
+	uint8_t full_bw_count;
+	uint8_t cycle_idx;
+	uint8_t mode;
+};
+#endif
+
+struct tcp_collision_avoidance {
+	const struct tcp_ca_ops *ops;
 	uint16_t cwnd;
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
+	bool rtt_pending;
+	uint32_t rtt_seq;	/* Sequence number timed for the RTT sample */
+	uint32_t rtt_start;	/* ms */
+	uint32_t srtt;		/* ms */
+	uint32_t min_rtt;	/* ms, 0 until the first sample */
+	uint32_t min_rtt_stamp;	/* ms */
+	union {
+#if defined(CONFIG_NET_TCP_CONGESTION_CUBIC)
+		struct tcp_ca_cubic cubic;
+#endif
+#if defined(CONFIG_NET_TCP_CONGESTION_BBR)
+		struct tcp_ca_bbr bbr;
+#endif
+		uint8_t unused;
+	};
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
 	struct net_context *context;
 	struct net_pkt *send_data;
-	struct net_pkt *queue_recv_data;
+	struct rbtree ooo_ranges; /* Out-of-order received data, by sequence number */
 	struct net_if *iface;
 	void *recv_user_data;
 	sys_slist_t send_queue;
@@ -286,6 +369,11 @@ struct tcp { /* TCP connection */
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	struct k_work conn_release;
+#if defined(CONFIG_NET_TCP_GRO)
+	struct net_pkt *gro_pkt; /* data merged during the current RX burst */
+	sys_snode_t gro_node;
+	uint16_t gro_segs;
+#endif /* CONFIG_NET_TCP_GRO */
 
 	union {
 		/* Because FIN and establish timers are never happening
@@ -323,8 +411,14 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_collision_avoidance ca;
 #endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sacked[NET_TCP_SACK_BLOCKS]; /* Sent data the peer has */
+	uint32_t sack_last_seq; /* Latest out-of-order data received */
+	uint32_t sack_recovery_seq; /* End of the data sent before the loss */
+	uint8_t sacked_count;
+#endif /* CONFIG_NET_TCP_SACK */
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
@@ -339,6 +433,14 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#if defined(CONFIG_NET_TCP_GRO)
+	bool gro_queued : 1;
+	bool gro_ack : 1;
+#endif /* CONFIG_NET_TCP_GRO */
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+	bool sack_recovery : 1;
+#endif /* CONFIG_NET_TCP_SACK */
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
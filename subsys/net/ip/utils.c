@@ -594,6 +594,38 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+
+#if defined(CONFIG_64BIT)
+	if ((((uintptr_t)data & 0x04) != 0) && (pending >= sizeof(uint32_t))) {
+		pending -= sizeof(uint32_t);
+		sum = sum + *((uint32_t *)data);
+		data += sizeof(uint32_t);
+	}
+
+	/* Add whole 64-bit words, the carries out of the accumulator are
+	 * counted aside and added back in (end-around carry).
+	 */
+	if (pending >= sizeof(uint64_t) * 2) {
+		uint64_t *q = (uint64_t *)data;
+		uint64_t carry = 0;
+
+		while (pending >= sizeof(uint64_t) * 2) {
+			uint64_t w_a = q[0];
+			uint64_t w_b = q[1];
+
+			pending -= sizeof(uint64_t) * 2;
+			sum += w_a;
+			carry += (sum < w_a);
+			sum += w_b;
+			carry += (sum < w_b);
+			q += 2;
+		}
+
+		sum = (sum & 0xffffffff) + (sum >> 32) + carry;
+		data = (uint8_t *)q;
+	}
+#endif /* CONFIG_64BIT */
+
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -636,6 +668,29 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 	}
 }
 
+/* Incremental update as per RFC 1624 eqn. 3: HC' = ~(~HC + ~m + m') */
+uint16_t net_calc_chksum_update(uint16_t chksum, uint16_t old_val,
+				uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum;
+
+	sum += (uint16_t)~old_val;
+	sum += new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+uint16_t net_calc_chksum_update_buf(uint16_t chksum, const uint8_t *old_data,
+				    const uint8_t *new_data, size_t len)
+{
+	return net_calc_chksum_update(chksum,
+				      htons(calc_chksum(0, old_data, len)),
+				      htons(calc_chksum(0, new_data, len)));
+}
+
 #if defined(CONFIG_NET_NATIVE_IP)
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
@@ -27,6 +27,7 @@ LOG_MODULE_REGISTER(net_ethernet, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv6.h"
 #include "ipv4.h"
+#include "tcp_internal.h"
 #include "bridge.h"
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
@@ -708,6 +709,19 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 		goto send;
 	}
 
+	/* TCP packets larger than the MSS are split here if the hardware
+	 * cannot do it.
+	 */
+	if (net_pkt_tso_mss(pkt) > 0U &&
+	    !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TSO)) {
+		ret = net_tcp_tso_segment(iface, pkt, ethernet_send);
+		if (ret >= 0) {
+			net_pkt_unref(pkt);
+		}
+
+		goto error;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET &&
 	    net_pkt_ll_proto_type(pkt) == NET_ETH_PTYPE_IP) {
 		if (!net_pkt_ipv4_acd(pkt)) {
@@ -912,18 +912,6 @@ int gptp_get_port_data(struct gptp_domain *domain,
 	return 0;
 }
 
-double gptp_servo_pi(int64_t nanosecond_diff)
-{
-	double kp = 0.7;
-	double ki = 0.3;
-	double ppb;
-
-	gptp_clock.pi_drift += ki * nanosecond_diff;
-	ppb = kp * nanosecond_diff + gptp_clock.pi_drift;
-
-	return ppb;
-}
-
 static void init_ports(void)
 {
 	net_if_foreach(gptp_add_port, &gptp_domain.default_ds.nb_ports);
@@ -943,7 +931,11 @@ void net_gptp_init(void)
 	gptp_domain.default_ds.nb_ports = 0U;
 
 	gptp_clock.domain = &gptp_domain;
-	gptp_clock.pi_drift = 0.0;
+
+#if defined(CONFIG_NET_GPTP_USE_DEFAULT_CLOCK_UPDATE)
+	net_ptp_servo_init(&gptp_clock.servo, CONFIG_NET_GPTP_SERVO_BANDWIDTH,
+			   CONFIG_NET_GPTP_SERVO_MAX_PPB);
+#endif
 
 	init_ports();
 }
@@ -16,6 +16,8 @@
 
 #include <zephyr/net/gptp.h>
 
+#include "ptp_servo.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,8 +38,8 @@ extern "C" {
 struct gptp_clock_data {
 	/** gptp_domain pointer */
 	struct gptp_domain *domain;
-	/** pi control drift value */
-	double pi_drift;
+	/** Servo adjusting the local clock */
+	struct net_ptp_servo servo;
 };
 
 extern struct gptp_clock_data gptp_clock;
@@ -129,15 +131,6 @@ static inline uint64_t gptp_timestamp_to_nsec(struct net_ptp_time *ts)
 	return (ts->second * NSEC_PER_SEC) + ts->nanosecond;
 }
 
-/**
- * @brief gPTP PI servo.
- *
- * @param nanosecond_diff nanosecond offset.
- *
- * @return ppb value to adjust.
- */
-double gptp_servo_pi(int64_t nanosecond_diff);
-
 /**
  * @brief Change the port state
  *
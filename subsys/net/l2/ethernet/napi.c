@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_eth_napi, CONFIG_NET_L2_ETHERNET_LOG_LEVEL);
+
+#include <zephyr/init.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/ethernet.h>
+
+static struct k_work_q napi_work_q;
+static K_KERNEL_STACK_DEFINE(napi_work_q_stack,
+			     CONFIG_NET_ETHERNET_NAPI_STACK_SIZE);
+
+/* Poll once. If the budget is used up, more frames are likely waiting, so
+ * the poll is rescheduled after the other work, otherwise the ring is empty
+ * and the interrupt can be enabled again.
+ */
+static int napi_poll(struct net_eth_napi *napi)
+{
+	int count;
+
+	count = napi->poll(napi, CONFIG_NET_ETHERNET_NAPI_BUDGET);
+	if (count >= CONFIG_NET_ETHERNET_NAPI_BUDGET) {
+		k_work_submit_to_queue(&napi_work_q, &napi->work);
+		return count;
+	}
+
+	atomic_clear_bit(&napi->state, NET_ETH_NAPI_SCHED);
+	napi->irq_enable(napi);
+
+	return count;
+}
+
+static void napi_work_handler(struct k_work *work)
+{
+	(void)napi_poll(CONTAINER_OF(work, struct net_eth_napi, work));
+}
+
+void net_eth_napi_init(struct net_eth_napi *napi, struct net_if *iface,
+		       net_eth_napi_poll_t poll,
+		       net_eth_napi_irq_enable_t irq_enable)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+
+	k_work_init(&napi->work, napi_work_handler);
+	napi->iface = iface;
+	napi->poll = poll;
+	napi->irq_enable = irq_enable;
+	atomic_clear(&napi->state);
+
+	ctx->napi = napi;
+
+	NET_DBG("Polled reception for iface %d", net_if_get_by_iface(iface));
+}
+
+bool net_eth_napi_schedule(struct net_eth_napi *napi)
+{
+	if (atomic_test_and_set_bit(&napi->state, NET_ETH_NAPI_SCHED)) {
+		return false;
+	}
+
+	k_work_submit_to_queue(&napi_work_q, &napi->work);
+
+	return true;
+}
+
+int net_eth_napi_busy_poll(struct net_if *iface)
+{
+	struct ethernet_context *ctx;
+	struct net_eth_napi *napi;
+
+	if (iface == NULL || net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return -ENOTSUP;
+	}
+
+	ctx = net_if_l2_data(iface);
+	napi = ctx->napi;
+	if (napi == NULL) {
+		return -ENOTSUP;
+	}
+
+	/* Owning the poll keeps the ISR from scheduling it meanwhile. The
+	 * interrupt may still fire and disable itself, napi_poll() enables
+	 * it again.
+	 */
+	if (atomic_test_and_set_bit(&napi->state, NET_ETH_NAPI_SCHED)) {
+		return 0;
+	}
+
+	return napi_poll(napi);
+}
+
+static int net_eth_napi_sys_init(void)
+{
+	k_work_queue_start(&napi_work_q, napi_work_q_stack,
+			   K_KERNEL_STACK_SIZEOF(napi_work_q_stack),
+			   K_PRIO_COOP(CONFIG_NET_ETHERNET_NAPI_PRIO), NULL);
+	k_thread_name_set(&napi_work_q.thread, "eth_napi");
+
+	return 0;
+}
+
+SYS_INIT(net_eth_napi_sys_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
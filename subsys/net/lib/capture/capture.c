@@ -525,6 +525,10 @@ int net_capture_pkt_with_status(struct net_if *iface, struct net_pkt *pkt)
 		return -EALREADY;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CAPTURE_RING)) {
+		net_capture_ring_pkt(iface, pkt);
+	}
+
 	k_mutex_lock(&lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_NODE_SAFE(&net_capture_devlist, sn, sns) {
@@ -0,0 +1,178 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Capture of packet headers into a ring buffer. Unlike the tunnel based
+ * capture, packets are not cloned: the first bytes of each packet are copied
+ * with a timestamp into a pre-allocated buffer, which is drained later.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_capture, CONFIG_NET_CAPTURE_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/capture.h>
+
+#define RING_WORDS (CONFIG_NET_CAPTURE_RING_SIZE / sizeof(uint32_t))
+
+struct ring_record {
+	MPSC_PBUF_HDR;
+	uint32_t caplen : 14;
+	uint32_t iface : 8;
+	uint32_t unused : 8;
+	uint32_t timestamp;
+	uint32_t len;
+	uint8_t data[];
+};
+
+BUILD_ASSERT(CONFIG_NET_CAPTURE_RING_SNAPLEN < BIT(14));
+
+static uint32_t ring_buf[RING_WORDS];
+static struct mpsc_pbuf_buffer ring;
+static atomic_t ring_dropped;
+static atomic_t ring_enabled;
+
+static struct {
+	struct net_if *iface;
+	net_capture_ring_filter_t filter;
+	void *user_data;
+} ring_ctx;
+
+static uint32_t record_wlen(uint32_t caplen)
+{
+	return DIV_ROUND_UP(sizeof(struct ring_record) + caplen, sizeof(uint32_t));
+}
+
+static uint32_t get_wlen(const union mpsc_pbuf_generic *packet)
+{
+	const struct ring_record *record = (const struct ring_record *)packet;
+
+	return record_wlen(record->caplen);
+}
+
+static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			const union mpsc_pbuf_generic *packet)
+{
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(packet);
+
+	atomic_inc(&ring_dropped);
+}
+
+static const struct mpsc_pbuf_buffer_config ring_config = {
+	.buf = ring_buf,
+	.size = RING_WORDS,
+	.notify_drop = notify_drop,
+	.get_wlen = get_wlen,
+	.flags = (IS_POWER_OF_TWO(RING_WORDS) ? MPSC_PBUF_SIZE_POW2 : 0) |
+		 (IS_ENABLED(CONFIG_NET_CAPTURE_RING_OVERWRITE) ? MPSC_PBUF_MODE_OVERWRITE : 0),
+};
+
+int net_capture_ring_enable(struct net_if *iface, net_capture_ring_filter_t filter,
+			    void *user_data)
+{
+	if (atomic_get(&ring_enabled)) {
+		return -EALREADY;
+	}
+
+	ring_ctx.iface = iface;
+	ring_ctx.filter = filter;
+	ring_ctx.user_data = user_data;
+
+	mpsc_pbuf_init(&ring, &ring_config);
+	atomic_clear(&ring_dropped);
+
+	atomic_set(&ring_enabled, 1);
+
+	return 0;
+}
+
+int net_capture_ring_disable(void)
+{
+	if (!atomic_cas(&ring_enabled, 1, 0)) {
+		return -EALREADY;
+	}
+
+	return 0;
+}
+
+void net_capture_ring_pkt(struct net_if *iface, struct net_pkt *pkt)
+{
+	union mpsc_pbuf_generic *packet;
+	struct ring_record *record;
+	size_t len, caplen;
+
+	if (!atomic_get(&ring_enabled)) {
+		return;
+	}
+
+	if (ring_ctx.iface != NULL && ring_ctx.iface != iface) {
+		return;
+	}
+
+	/* Filter before anything is copied */
+	if (ring_ctx.filter != NULL && !ring_ctx.filter(iface, pkt, ring_ctx.user_data)) {
+		return;
+	}
+
+	len = net_pkt_get_len(pkt);
+	caplen = MIN(len, CONFIG_NET_CAPTURE_RING_SNAPLEN);
+
+	packet = mpsc_pbuf_alloc(&ring, record_wlen(caplen), K_NO_WAIT);
+	if (packet == NULL) {
+		atomic_inc(&ring_dropped);
+		return;
+	}
+
+	record = (struct ring_record *)packet;
+	record->caplen = net_buf_linearize(record->data, caplen, pkt->buffer, 0, caplen);
+	record->iface = net_if_get_by_iface(iface);
+	record->timestamp = k_cycle_get_32();
+	record->len = len;
+
+	mpsc_pbuf_commit(&ring, packet);
+}
+
+int net_capture_ring_drain(net_capture_ring_cb_t cb, void *user_data)
+{
+	const union mpsc_pbuf_generic *packet;
+	struct net_capture_record info;
+	int count = 0;
+
+	if (cb == NULL) {
+		return -EINVAL;
+	}
+
+	if (ring.buf == NULL) {
+		/* Never enabled */
+		return 0;
+	}
+
+	while ((packet = mpsc_pbuf_claim(&ring)) != NULL) {
+		const struct ring_record *record = (const struct ring_record *)packet;
+
+		info.timestamp = record->timestamp;
+		info.len = record->len;
+		info.caplen = record->caplen;
+		info.iface = net_if_get_by_index(record->iface);
+		info.data = record->data;
+
+		cb(&info, user_data);
+
+		mpsc_pbuf_free(&ring, packet);
+		count++;
+	}
+
+	return count;
+}
+
+uint32_t net_capture_ring_dropped(void)
+{
+	return (uint32_t)atomic_get(&ring_dropped);
+}
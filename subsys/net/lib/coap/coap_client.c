@@ -766,6 +766,270 @@ static bool find_echo_option(const struct coap_packet *response, struct coap_opt
 	return coap_find_options(response, COAP_OPTION_ECHO, option, 1);
 }
 
+/* Build the request for the next block of a blockwise transfer and restart its
+ * retransmission timer.
+ */
+static int prepare_next_block(struct coap_client *client,
+			      struct coap_client_internal_request *internal_req,
+			      bool reconstruct)
+{
+	struct coap_transmission_parameters params = internal_req->pending.params;
+	int ret;
+
+	ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
+				       reconstruct);
+	if (ret < 0) {
+		LOG_ERR("Error creating a CoAP request");
+		return ret;
+	}
+
+	ret = coap_pending_init(&internal_req->pending, &internal_req->request,
+				&client->address, &params);
+	if (ret < 0) {
+		LOG_ERR("Error creating pending");
+		return ret;
+	}
+
+	coap_pending_cycle(&internal_req->pending);
+
+	return 0;
+}
+
+#if CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1
+#define BLOCK2_SLOTS (CONFIG_COAP_CLIENT_BLOCK2_WINDOW - 1)
+
+/* Blocks are requested ahead only for plain block-wise GETs: Block1 transfers
+ * must stay sequential for the server, and blocks larger than the buffers
+ * cannot be kept until their turn comes.
+ */
+static bool block2_window_usable(struct coap_client_internal_request *internal_req)
+{
+	return internal_req->send_blk_ctx.total_size == 0 && !internal_req->is_observe &&
+	       coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size) <=
+	       CONFIG_COAP_CLIENT_BLOCK_SIZE;
+}
+
+static uint32_t block2_current_num(struct coap_client_internal_request *internal_req)
+{
+	return internal_req->recv_blk_ctx.current /
+	       coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+}
+
+static bool block2_window_pending(struct coap_client_internal_request *internal_req)
+{
+	for (int i = 0; i < BLOCK2_SLOTS; i++) {
+		if (internal_req->block2_slots[i].sent) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Keep a response to a block requested ahead of the current one until the
+ * application has been given the blocks before it.
+ */
+static bool block2_window_store(struct coap_client_internal_request *internal_req,
+				const struct coap_packet *response, bool truncated)
+{
+	struct coap_client_block2_slot *slot = NULL;
+	const uint8_t *payload;
+	uint16_t payload_len;
+	int block_option;
+
+	if (!block2_window_pending(internal_req)) {
+		return false;
+	}
+
+	block_option = coap_get_option_int(response, COAP_OPTION_BLOCK2);
+
+	for (int i = 0; i < BLOCK2_SLOTS; i++) {
+		struct coap_client_block2_slot *s = &internal_req->block2_slots[i];
+
+		if (!s->sent || s->received) {
+			continue;
+		}
+
+		/* Error responses carry no Block2 option, match their message ID */
+		if (block_option > 0 ? GET_BLOCK_NUM(block_option) == s->num :
+				       coap_header_get_id(response) == s->mid) {
+			slot = s;
+			break;
+		}
+	}
+
+	if (slot == NULL) {
+		if (block_option > 0 &&
+		    GET_BLOCK_NUM(block_option) != block2_current_num(internal_req)) {
+			LOG_DBG("Drop unexpected block %d", GET_BLOCK_NUM(block_option));
+			return true;
+		}
+
+		return false;
+	}
+
+	if (truncated || (block_option > 0 &&
+			  GET_BLOCK_SIZE(block_option) != internal_req->recv_blk_ctx.block_size)) {
+		/* Request the block again when its turn comes */
+		slot->sent = false;
+		return true;
+	}
+
+	payload = coap_packet_get_payload(response, &payload_len);
+
+	slot->code = coap_header_get_code(response);
+	slot->more = block_option > 0 && GET_MORE(block_option);
+	slot->len = MIN(payload_len, sizeof(slot->payload));
+	slot->received = true;
+	if (slot->len > 0) {
+		memcpy(slot->payload, payload, slot->len);
+	}
+
+	if (!slot->more) {
+		internal_req->block2_last = slot->num;
+		internal_req->block2_last_known = true;
+	}
+
+	return true;
+}
+
+static void block2_prefetch(struct coap_client *client,
+			    struct coap_client_internal_request *internal_req,
+			    struct coap_client_block2_slot *slot, uint32_t num)
+{
+	struct coap_block_context blk_ctx = internal_req->recv_blk_ctx;
+	uint16_t last_id = internal_req->last_id;
+	int ret;
+
+	internal_req->recv_blk_ctx.current = num * coap_block_size_to_bytes(blk_ctx.block_size);
+	internal_req->last_id = coap_next_id();
+
+	ret = coap_client_init_request(client, &internal_req->coap_request, internal_req, true);
+	if (ret == 0) {
+		ret = send_request(client->fd, internal_req->request.data,
+				   internal_req->request.offset, 0, &client->address,
+				   client->socklen);
+	}
+
+	if (ret >= 0) {
+		*slot = (struct coap_client_block2_slot){
+			.num = num,
+			.mid = internal_req->last_id,
+			.sent = true,
+		};
+	} else {
+		/* Not fatal, the block is requested again when its turn comes */
+		LOG_DBG("Failed to request block %u ahead (%d)", num, ret);
+	}
+
+	internal_req->recv_blk_ctx = blk_ctx;
+	internal_req->last_id = last_id;
+}
+
+/* Move to the next block of a pipelined Block2 transfer. Blocks already
+ * received are handed to the application, the current block is requested
+ * unless it is already in flight, and the window is refilled.
+ *
+ * Returns 1 while the transfer goes on, 0 when it has completed and a
+ * negative error code on failure.
+ */
+static int block2_window_next(struct coap_client *client,
+			      struct coap_client_internal_request *internal_req)
+{
+	size_t block_bytes = coap_block_size_to_bytes(internal_req->recv_blk_ctx.block_size);
+	struct coap_client_block2_slot *slot;
+	uint32_t num;
+	bool in_flight = false;
+	int ret;
+
+	while (true) {
+		num = block2_current_num(internal_req);
+		slot = &internal_req->block2_slots[num % BLOCK2_SLOTS];
+
+		if (!slot->sent || slot->num != num) {
+			break;
+		}
+
+		if (!slot->received) {
+			/* Wait for it as the current block, retransmissions keep its
+			 * message ID.
+			 */
+			internal_req->last_id = slot->mid;
+			slot->sent = false;
+			in_flight = true;
+			break;
+		}
+
+		slot->sent = false;
+
+		if (internal_req->coap_request.cb) {
+			if (!atomic_set(&internal_req->in_callback, 1)) {
+				internal_req->coap_request.cb(slot->code, internal_req->offset,
+							      slot->payload, slot->len,
+							      !slot->more,
+							      internal_req->coap_request.user_data);
+				atomic_clear(&internal_req->in_callback);
+			}
+			if (!internal_req->request_ongoing) {
+				/* User callback must have called coap_client_cancel_requests(). */
+				return 0;
+			}
+		}
+
+		if (!slot->more) {
+			return 0;
+		}
+
+		internal_req->offset += slot->len;
+		internal_req->recv_blk_ctx.current += block_bytes;
+	}
+
+	/* Keep the token, responses to the blocks requested ahead match on it */
+	if (!in_flight) {
+		internal_req->last_id = coap_next_id();
+	}
+
+	ret = prepare_next_block(client, internal_req, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!in_flight) {
+		ret = send_request(client->fd, internal_req->request.data,
+				   internal_req->request.offset, 0, &client->address,
+				   client->socklen);
+		if (ret < 0) {
+			LOG_ERR("Error sending a CoAP request");
+			return ret;
+		}
+	}
+
+	for (uint32_t next = num + 1; next < num + CONFIG_COAP_CLIENT_BLOCK2_WINDOW; next++) {
+		if (internal_req->block2_last_known && next > internal_req->block2_last) {
+			break;
+		}
+
+		/* Size2 tells where the resource ends */
+		if (internal_req->recv_blk_ctx.total_size > 0 &&
+		    next * block_bytes >= internal_req->recv_blk_ctx.total_size) {
+			break;
+		}
+
+		slot = &internal_req->block2_slots[next % BLOCK2_SLOTS];
+		if (slot->sent && slot->num == next) {
+			continue;
+		}
+
+		block2_prefetch(client, internal_req, slot, next);
+	}
+
+	/* The request now holds the last block requested ahead, retransmissions
+	 * of the current block rebuild it.
+	 */
+	return 1;
+}
+#endif /* CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1 */
+
 static int handle_response(struct coap_client *client, const struct coap_packet *response,
 			   bool response_truncated)
 {
@@ -897,6 +1161,12 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 		return 0;
 	}
 
+#if CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1
+	if (block2_window_store(internal_req, response, response_truncated)) {
+		return 0;
+	}
+#endif
+
 	if (internal_req->pending.timeout != 0) {
 		coap_pending_clear(&internal_req->pending);
 	}
@@ -963,22 +1233,21 @@ static int handle_response(struct coap_client *client, const struct coap_packet
 
 	/* If this wasn't last block, send the next request */
 	if (blockwise_transfer && !last_block) {
-		ret = coap_client_init_request(client, &internal_req->coap_request, internal_req,
-					       false);
+#if CONFIG_COAP_CLIENT_BLOCK2_WINDOW > 1
+		if (block2_window_usable(internal_req)) {
+			ret = block2_window_next(client, internal_req);
+			if (ret <= 0) {
+				goto fail;
+			}
 
-		if (ret < 0) {
-			LOG_ERR("Error creating a CoAP request");
-			goto fail;
+			return 1;
 		}
+#endif
 
-		struct coap_transmission_parameters params = internal_req->pending.params;
-		ret = coap_pending_init(&internal_req->pending, &internal_req->request,
-					&client->address, &params);
+		ret = prepare_next_block(client, internal_req, false);
 		if (ret < 0) {
-			LOG_ERR("Error creating pending");
 			goto fail;
 		}
-		coap_pending_cycle(&internal_req->pending);
 
 		ret = send_request(client->fd, internal_req->request.data,
 				   internal_req->request.offset, 0, &client->address,
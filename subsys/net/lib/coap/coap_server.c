@@ -122,6 +122,165 @@ static int coap_service_remove_observer(const struct coap_service *service,
 	return 0;
 }
 
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+/* Trie of the resource path segments of all the services. Node 0 is never
+ * allocated, so that 0 means "no node".
+ */
+struct resource_index_node {
+	const char *segment;
+	uint16_t len;
+	uint16_t child;
+	uint16_t sibling;
+	int16_t resource;
+};
+
+static struct resource_index_node resource_index[CONFIG_COAP_SERVER_RESOURCE_INDEX_NODES + 1];
+static uint16_t resource_index_used = 1;
+
+static uint16_t resource_index_alloc(const char *segment)
+{
+	uint16_t node;
+
+	if (resource_index_used >= ARRAY_SIZE(resource_index)) {
+		return 0;
+	}
+
+	node = resource_index_used++;
+	resource_index[node] = (struct resource_index_node){
+		.segment = segment,
+		.len = segment != NULL ? strlen(segment) : 0,
+		.resource = -1,
+	};
+
+	return node;
+}
+
+static uint16_t resource_index_child(uint16_t parent, const char *segment)
+{
+	uint16_t node;
+
+	for (node = resource_index[parent].child; node != 0; node = resource_index[node].sibling) {
+		if (strcmp(resource_index[node].segment, segment) == 0) {
+			return node;
+		}
+	}
+
+	node = resource_index_alloc(segment);
+	if (node != 0) {
+		resource_index[node].sibling = resource_index[parent].child;
+		resource_index[parent].child = node;
+	}
+
+	return node;
+}
+
+static bool resource_index_is_wildcard(uint16_t node, char wildcard)
+{
+	return IS_ENABLED(CONFIG_COAP_URI_WILDCARD) && resource_index[node].len == 1 &&
+	       resource_index[node].segment[0] == wildcard;
+}
+
+static void resource_index_build(const struct coap_service *service)
+{
+	uint16_t root, node;
+
+	root = resource_index_alloc(NULL);
+
+	for (size_t i = 0; root != 0 && i < COAP_SERVICE_RESOURCE_COUNT(service); i++) {
+		const char * const *path = service->res_begin[i].path;
+
+		node = root;
+		for (size_t j = 0; node != 0 && path[j] != NULL; j++) {
+			node = resource_index_child(node, path[j]);
+
+			/* Anything after a multi-level wildcard is ignored */
+			if (node != 0 && resource_index_is_wildcard(node, '#')) {
+				break;
+			}
+		}
+
+		if (node == 0) {
+			root = 0;
+		} else if (resource_index[node].resource < 0) {
+			/* The first resource matching a path takes precedence */
+			resource_index[node].resource = i;
+		}
+	}
+
+	if (root == 0) {
+		LOG_WRN("Resource index full, %s resources are looked up linearly",
+			service->name);
+	}
+
+	service->data->index_root = root;
+}
+
+/* Find the first resource, in definition order, matching the remaining path
+ * segments.
+ */
+static int resource_index_match(uint16_t node, struct coap_option **segments,
+				uint8_t count)
+{
+	int best = -1;
+	int ret;
+
+	if (count == 0) {
+		return resource_index[node].resource;
+	}
+
+	for (node = resource_index[node].child; node != 0; node = resource_index[node].sibling) {
+		if (resource_index_is_wildcard(node, '#')) {
+			ret = resource_index[node].resource;
+		} else if (resource_index_is_wildcard(node, '+') ||
+			   (resource_index[node].len == segments[0]->len &&
+			    memcmp(resource_index[node].segment, segments[0]->value,
+				   segments[0]->len) == 0)) {
+			ret = resource_index_match(node, segments + 1, count - 1);
+		} else {
+			continue;
+		}
+
+		if (ret >= 0 && (best < 0 || ret < best)) {
+			best = ret;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_COAP_SERVER_RESOURCE_INDEX */
+
+static int coap_server_handle_request(const struct coap_service *service,
+				      struct coap_packet *request,
+				      struct coap_option *options, uint8_t opt_num,
+				      struct sockaddr *addr, socklen_t addr_len)
+{
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+	if (service->data->index_root != 0 && coap_packet_is_request(request)) {
+		struct coap_option *segments[MAX_OPTIONS];
+		uint8_t count = 0;
+		int i;
+
+		for (i = 0; i < opt_num; i++) {
+			if (options[i].delta == COAP_OPTION_URI_PATH) {
+				segments[count++] = &options[i];
+			}
+		}
+
+		i = resource_index_match(service->data->index_root, segments, count);
+		if (i < 0) {
+			return -ENOENT;
+		}
+
+		return coap_handle_request_len(request, &service->res_begin[i], 1,
+					       options, opt_num, addr, addr_len);
+	}
+#endif
+
+	return coap_handle_request_len(request, service->res_begin,
+				       COAP_SERVICE_RESOURCE_COUNT(service),
+				       options, opt_num, addr, addr_len);
+}
+
 static int coap_server_process(int sock_fd)
 {
 	static uint8_t buf[CONFIG_COAP_SERVER_MESSAGE_SIZE];
@@ -254,9 +413,8 @@ static int coap_server_process(int sock_fd)
 
 		ret = coap_service_send(service, &response, &client_addr, client_addr_len, NULL);
 	} else {
-		ret = coap_handle_request_len(&request, service->res_begin,
-					      COAP_SERVICE_RESOURCE_COUNT(service),
-					      options, opt_num, &client_addr, client_addr_len);
+		ret = coap_server_handle_request(service, &request, options, opt_num,
+						 &client_addr, client_addr_len);
 
 		/* Translate errors to response codes */
 		switch (ret) {
@@ -797,6 +955,16 @@ static void coap_server_thread(void *p1, void *p2, void *p3)
 		return;
 	}
 
+#if defined(CONFIG_COAP_SERVER_RESOURCE_INDEX)
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	COAP_SERVICE_FOREACH(svc) {
+		resource_index_build(svc);
+	}
+
+	(void)k_mutex_unlock(&lock);
+#endif
+
 	COAP_SERVICE_FOREACH(svc) {
 		if (svc->flags & COAP_SERVICE_AUTOSTART) {
 			ret = coap_service_start(svc);
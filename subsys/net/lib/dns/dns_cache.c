@@ -6,18 +6,138 @@
 
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/net/net_ip.h>
+#include <zephyr/sys/hash_function.h>
 #include "dns_cache.h"
 
 LOG_MODULE_REGISTER(net_dns_cache, CONFIG_DNS_RESOLVER_LOG_LEVEL);
 
-static void dns_cache_clean(struct dns_cache const *cache);
+static void dns_cache_clean(struct dns_cache *cache);
 
-int dns_cache_flush(struct dns_cache *cache)
+/* Needs to be called when lock is already acquired */
+static void dns_cache_init(struct dns_cache *cache)
 {
-	k_mutex_lock(cache->lock, K_FOREVER);
+	sys_slist_init(&cache->free_list);
+	sys_dlist_init(&cache->expiry_list);
+
+	for (size_t i = 0; i < cache->num_buckets; i++) {
+		sys_slist_init(&cache->buckets[i]);
+	}
+
 	for (size_t i = 0; i < cache->size; i++) {
 		cache->entries[i].in_use = false;
+		sys_slist_append(&cache->free_list, &cache->entries[i].node);
+	}
+
+	cache->initialized = true;
+}
+
+static void dns_cache_lock(struct dns_cache *cache)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+
+	if (!cache->initialized) {
+		dns_cache_init(cache);
+	}
+}
+
+static sys_slist_t *dns_cache_bucket(struct dns_cache *cache, uint32_t hash)
+{
+	return &cache->buckets[hash % cache->num_buckets];
+}
+
+static bool dns_cache_entry_matches(struct dns_cache_entry const *entry, uint32_t hash,
+				    char const *query)
+{
+	return entry->hash == hash && strcmp(entry->query, query) == 0;
+}
+
+static void dns_cache_release(struct dns_cache *cache, struct dns_cache_entry *entry)
+{
+	sys_slist_find_and_remove(dns_cache_bucket(cache, entry->hash), &entry->node);
+	sys_dlist_remove(&entry->expiry_node);
+	entry->in_use = false;
+	sys_slist_prepend(&cache->free_list, &entry->node);
+}
+
+/* Keep the expiry list sorted. New entries usually have the latest expiry,
+ * so the search starts from the tail.
+ */
+static void dns_cache_schedule(struct dns_cache *cache, struct dns_cache_entry *entry,
+			       uint32_t ttl)
+{
+	sys_dnode_t *node = sys_dlist_peek_tail(&cache->expiry_list);
+	struct dns_cache_entry *other;
+
+	entry->ttl = ttl;
+	entry->expiry = sys_timepoint_calc(K_SECONDS(ttl));
+
+	while (node != NULL) {
+		other = CONTAINER_OF(node, struct dns_cache_entry, expiry_node);
+		if (sys_timepoint_cmp(other->expiry, entry->expiry) <= 0) {
+			/* Insert after the other entry */
+			sys_dlist_insert(node->next, &entry->expiry_node);
+			return;
+		}
+
+		node = sys_dlist_peek_prev(&cache->expiry_list, node);
+	}
+
+	sys_dlist_prepend(&cache->expiry_list, &entry->expiry_node);
+}
+
+static int dns_cache_check_query(char const *query)
+{
+	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
+		NET_WARN("Query string to big to be processed %u >= "
+			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
+			 strlen(query));
+		return -EINVAL;
 	}
+
+	return 0;
+}
+
+/* Needs to be called when lock is already acquired */
+static struct dns_cache_entry *dns_cache_alloc(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+	sys_snode_t *node;
+
+	node = sys_slist_get(&cache->free_list);
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct dns_cache_entry, node);
+	}
+
+	/* Replace the entry closest to expiry */
+	entry = SYS_DLIST_PEEK_HEAD_CONTAINER(&cache->expiry_list, entry, expiry_node);
+	NET_DBG("Overwrite \"%s\"", entry->query);
+	dns_cache_release(cache, entry);
+
+	return CONTAINER_OF(sys_slist_get(&cache->free_list), struct dns_cache_entry, node);
+}
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_insert(struct dns_cache *cache, char const *query, uint32_t hash,
+			     struct dns_addrinfo const *addrinfo, bool negative, uint32_t ttl)
+{
+	struct dns_cache_entry *entry = dns_cache_alloc(cache);
+
+	strncpy(entry->query, query, CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
+	entry->query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1] = '\0';
+	entry->data = *addrinfo;
+	entry->hash = hash;
+	entry->negative = negative;
+	entry->prefetch = false;
+	entry->in_use = true;
+
+	sys_slist_prepend(dns_cache_bucket(cache, hash), &entry->node);
+	dns_cache_schedule(cache, entry, ttl);
+}
+
+int dns_cache_flush(struct dns_cache *cache)
+{
+	k_mutex_lock(cache->lock, K_FOREVER);
+	dns_cache_init(cache);
 	k_mutex_unlock(cache->lock);
 
 	return 0;
@@ -26,47 +146,84 @@ int dns_cache_flush(struct dns_cache *cache)
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl)
 {
-	k_timepoint_t closest_to_expiry = sys_timepoint_calc(K_FOREVER);
-	size_t index_to_replace = 0;
-	bool found_empty = false;
+	struct dns_cache_entry *entry, *next;
+	uint32_t hash;
 
 	if (cache == NULL || query == NULL || addrinfo == NULL || ttl == 0) {
 		return -EINVAL;
 	}
 
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
 
 	NET_DBG("Add \"%s\" with TTL %" PRIu32, query, ttl);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			index_to_replace = i;
-			found_empty = true;
-			break;
-		} else if (sys_timepoint_cmp(closest_to_expiry, cache->entries[i].expiry) > 0) {
-			index_to_replace = i;
-			closest_to_expiry = cache->entries[i].expiry;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, node) {
+		if (!dns_cache_entry_matches(entry, hash, query) ||
+		    entry->data.ai_family != addrinfo->ai_family) {
+			continue;
+		}
+
+		if (entry->negative) {
+			/* The query resolves now */
+			dns_cache_release(cache, entry);
+		} else if (entry->prefetch && entry->data.ai_addrlen == addrinfo->ai_addrlen &&
+			   memcmp(&entry->data.ai_addr, &addrinfo->ai_addr,
+				  addrinfo->ai_addrlen) == 0) {
+			/* Answer of a refresh query, extend the existing entry */
+			entry->prefetch = false;
+			sys_dlist_remove(&entry->expiry_node);
+			dns_cache_schedule(cache, entry, ttl);
+			k_mutex_unlock(cache->lock);
+
+			return 0;
 		}
 	}
 
-	if (!found_empty) {
-		NET_DBG("Overwrite \"%s\"", cache->entries[index_to_replace].query);
+	dns_cache_insert(cache, query, hash, addrinfo, false, ttl);
+
+	k_mutex_unlock(cache->lock);
+
+	return 0;
+}
+
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl)
+{
+	struct dns_addrinfo addrinfo = {0};
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || ttl == 0) {
+		return -EINVAL;
+	}
+
+	if (type == DNS_QUERY_TYPE_A) {
+		addrinfo.ai_family = AF_INET;
+	} else if (type == DNS_QUERY_TYPE_AAAA) {
+		addrinfo.ai_family = AF_INET6;
+	} else {
+		return -EINVAL;
+	}
+
+	if (dns_cache_check_query(query) < 0) {
+		return -EINVAL;
 	}
 
-	strncpy(cache->entries[index_to_replace].query, query,
-		CONFIG_DNS_RESOLVER_MAX_QUERY_LEN - 1);
-	cache->entries[index_to_replace].data = *addrinfo;
-	cache->entries[index_to_replace].expiry = sys_timepoint_calc(K_SECONDS(ttl));
-	cache->entries[index_to_replace].in_use = true;
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
+
+	NET_DBG("Add negative \"%s\" with TTL %" PRIu32, query, ttl);
+
+	dns_cache_clean(cache);
+	dns_cache_insert(cache, query, hash, &addrinfo, true, ttl);
 
 	k_mutex_unlock(cache->lock);
 
@@ -75,21 +232,23 @@ int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinf
 
 int dns_cache_remove(struct dns_cache *cache, char const *query)
 {
+	struct dns_cache_entry *entry, *next;
+	uint32_t hash;
+
 	NET_DBG("Remove all entries with query \"%s\"", query);
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (cache->entries[i].in_use && strcmp(cache->entries[i].query, query) == 0) {
-			cache->entries[i].in_use = false;
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(dns_cache_bucket(cache, hash), entry, next, node) {
+		if (dns_cache_entry_matches(entry, hash, query)) {
+			dns_cache_release(cache, entry);
 		}
 	}
 
@@ -98,11 +257,14 @@ int dns_cache_remove(struct dns_cache *cache, char const *query)
 	return 0;
 }
 
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len)
 {
+	struct dns_cache_entry *entry;
+	bool negative = false;
 	size_t found = 0;
 	sa_family_t family;
+	uint32_t hash;
 
 	NET_DBG("Find \"%s\"", query);
 	if (cache == NULL || query == NULL || addrinfo == NULL || addrinfo_array_len <= 0) {
@@ -115,32 +277,32 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	} else {
 		return -EINVAL;
 	}
-	if (strlen(query) >= CONFIG_DNS_RESOLVER_MAX_QUERY_LEN) {
-		NET_WARN("Query string to big to be processed %u >= "
-			 "CONFIG_DNS_RESOLVER_MAX_QUERY_LEN",
-			 strlen(query));
+	if (dns_cache_check_query(query) < 0) {
 		return -EINVAL;
 	}
 
-	k_mutex_lock(cache->lock, K_FOREVER);
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
 
 	dns_cache_clean(cache);
 
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, node) {
+		if (!dns_cache_entry_matches(entry, hash, query)) {
 			continue;
 		}
-		if (strcmp(cache->entries[i].query, query) != 0) {
+		if (entry->data.ai_family != family) {
 			continue;
 		}
-		if (cache->entries[i].data.ai_family != family) {
+		if (entry->negative) {
+			negative = true;
 			continue;
 		}
 		if (found >= addrinfo_array_len) {
 			NET_WARN("Found \"%s\" but not enough space in provided buffer.", query);
 			found++;
 		} else {
-			addrinfo[found] = cache->entries[i].data;
+			addrinfo[found] = entry->data;
 			found++;
 			NET_DBG("Found \"%s\"", query);
 		}
@@ -153,22 +315,79 @@ int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_qu
 	}
 
 	if (found == 0) {
+		if (negative) {
+			NET_DBG("Found negative \"%s\"", query);
+			return -ENOENT;
+		}
+
 		NET_DBG("Could not find \"%s\"", query);
 	}
 	return found;
 }
 
-/* Needs to be called when lock is already acquired */
-static void dns_cache_clean(struct dns_cache const *cache)
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+static bool dns_cache_entry_prefetch_due(struct dns_cache_entry const *entry)
 {
-	for (size_t i = 0; i < cache->size; i++) {
-		if (!cache->entries[i].in_use) {
-			continue;
+	uint64_t remaining_ms = k_ticks_to_ms_floor64(sys_timepoint_timeout(entry->expiry).ticks);
+
+	return remaining_ms * 100U <=
+	       (uint64_t)entry->ttl * MSEC_PER_SEC * CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD;
+}
+
+bool dns_cache_prefetch_due(struct dns_cache *cache, const char *query, enum dns_query_type type)
+{
+	struct dns_cache_entry *entry;
+	sa_family_t family;
+	bool due = false;
+	uint32_t hash;
+
+	if (cache == NULL || query == NULL || dns_cache_check_query(query) < 0) {
+		return false;
+	}
+
+	family = type == DNS_QUERY_TYPE_A ? AF_INET : AF_INET6;
+	hash = sys_hash32(query, strlen(query));
+
+	dns_cache_lock(cache);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, node) {
+		if (dns_cache_entry_matches(entry, hash, query) && !entry->negative &&
+		    !entry->prefetch && entry->data.ai_family == family &&
+		    dns_cache_entry_prefetch_due(entry)) {
+			due = true;
+			break;
 		}
+	}
+
+	if (due) {
+		NET_DBG("Prefetch \"%s\"", query);
 
-		if (sys_timepoint_expired(cache->entries[i].expiry)) {
-			NET_DBG("Remove \"%s\"", cache->entries[i].query);
-			cache->entries[i].in_use = false;
+		SYS_SLIST_FOR_EACH_CONTAINER(dns_cache_bucket(cache, hash), entry, node) {
+			if (dns_cache_entry_matches(entry, hash, query) &&
+			    entry->data.ai_family == family) {
+				entry->prefetch = true;
+			}
 		}
 	}
+
+	k_mutex_unlock(cache->lock);
+
+	return due;
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
+/* Needs to be called when lock is already acquired */
+static void dns_cache_clean(struct dns_cache *cache)
+{
+	struct dns_cache_entry *entry;
+
+	while ((entry = SYS_DLIST_PEEK_HEAD_CONTAINER(&cache->expiry_list, entry,
+						      expiry_node)) != NULL) {
+		if (!sys_timepoint_expired(entry->expiry)) {
+			break;
+		}
+
+		NET_DBG("Remove \"%s\"", entry->query);
+		dns_cache_release(cache, entry);
+	}
 }
@@ -16,18 +16,36 @@
 #include <stdint.h>
 #include <zephyr/net/dns_resolve.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/sys_clock.h>
 
 struct dns_cache_entry {
 	char query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
 	struct dns_addrinfo data;
 	k_timepoint_t expiry;
+	/* Node in the hash bucket of the query, or in the free list */
+	sys_snode_t node;
+	/* Node in the list of entries ordered by expiry */
+	sys_dnode_t expiry_node;
+	uint32_t hash;
+	uint32_t ttl;
 	bool in_use;
+	/* The query is known to have no record of this family */
+	bool negative;
+	/* A refresh of the query was requested before expiry */
+	bool prefetch;
 };
 
 struct dns_cache {
 	size_t size;
 	struct dns_cache_entry *entries;
+	size_t num_buckets;
+	sys_slist_t *buckets;
+	sys_slist_t free_list;
+	/* In use entries, closest to expiry first */
+	sys_dlist_t expiry_list;
+	bool initialized;
 	struct k_mutex *lock;
 };
 
@@ -43,8 +61,11 @@ struct dns_cache {
 #define DNS_CACHE_DEFINE(name, cache_size)                                                         \
 	static K_MUTEX_DEFINE(name##_mutex);                                                       \
 	static struct dns_cache_entry name##_entries[cache_size];                                  \
+	static sys_slist_t name##_buckets[cache_size];                                             \
 	static struct dns_cache name = {                                                           \
-		.entries = name##_entries, .size = cache_size, .lock = &name##_mutex};
+		.entries = name##_entries, .size = cache_size,                                     \
+		.buckets = name##_buckets, .num_buckets = cache_size,                              \
+		.lock = &name##_mutex};
 
 /**
  * @brief Flushes the dns cache removing all its entries.
@@ -71,6 +92,20 @@ int dns_cache_flush(struct dns_cache *cache);
 int dns_cache_add(struct dns_cache *cache, char const *query, struct dns_addrinfo const *addrinfo,
 		  uint32_t ttl);
 
+/**
+ * @brief Adds a negative entry to the dns cache, recording that the query
+ * has no record of the given type.
+ *
+ * @param cache Cache where the entry should be added.
+ * @param query Query which should be persisted in the cache.
+ * @param type Query type which did not resolve.
+ * @param ttl Time to live for the entry in seconds.
+ * @retval 0 on success
+ * @retval On error, a negative value is returned.
+ */
+int dns_cache_add_negative(struct dns_cache *cache, char const *query, enum dns_query_type type,
+			   uint32_t ttl);
+
 /**
  * @brief Removes all entries with the given query
  *
@@ -94,8 +129,26 @@ int dns_cache_remove(struct dns_cache *cache, char const *query);
  * @retval On error a negative value is returned.
  * -ENOSR means there was not enough space in the addrinfo array to accommodate all cache hits the
  * array will however be filled with valid data.
+ * -ENOENT means a negative entry was found, the query is known not to resolve.
  */
-int dns_cache_find(struct dns_cache const *cache, const char *query, enum dns_query_type type,
+int dns_cache_find(struct dns_cache *cache, const char *query, enum dns_query_type type,
 		   struct dns_addrinfo *addrinfo, size_t addrinfo_array_len);
 
+/**
+ * @brief Checks whether the cached records of a query should be refreshed.
+ *
+ * Returns true once the remaining time to live of one of the records falls
+ * below CONFIG_DNS_RESOLVER_CACHE_PREFETCH_THRESHOLD percent of its TTL. The
+ * records are then marked so that the answer of the refresh query updates
+ * them instead of adding new entries, and true is not returned again for
+ * them.
+ *
+ * @param cache Cache where the entries should be searched.
+ * @param query Query which should be searched for.
+ * @param type Query type of the records.
+ * @retval true if the query should be resolved again.
+ * @retval false otherwise.
+ */
+bool dns_cache_prefetch_due(struct dns_cache *cache, const char *query, enum dns_query_type type);
+
 #endif /* ZEPHYR_INCLUDE_NET_DNS_CACHE_H_ */
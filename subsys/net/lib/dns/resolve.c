@@ -1173,6 +1173,14 @@ static int dns_read(struct dns_resolve_context *ctx,
 		goto quit;
 	}
 
+#ifdef CONFIG_DNS_RESOLVER_CACHE
+	if (ret == DNS_EAI_NODATA && CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL > 0) {
+		dns_cache_add_negative(&dns_cache, ctx->queries[query_idx].query,
+				       ctx->queries[query_idx].query_type,
+				       CONFIG_DNS_RESOLVER_CACHE_NEGATIVE_TTL);
+	}
+#endif /* CONFIG_DNS_RESOLVER_CACHE */
+
 	invoke_query_callback(ret, NULL, &ctx->queries[query_idx]);
 
 	/* Marks the end of the results */
@@ -1480,6 +1488,49 @@ static void query_timeout(struct k_work *work)
 	k_mutex_unlock(&pending_query->ctx->lock);
 }
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+/* A single background refresh is done at a time */
+static char dns_prefetch_query[CONFIG_DNS_RESOLVER_MAX_QUERY_LEN];
+static atomic_t dns_prefetch_busy;
+
+static void dns_prefetch_cb(enum dns_resolve_status status,
+			    struct dns_addrinfo *info,
+			    void *user_data)
+{
+	ARG_UNUSED(info);
+	ARG_UNUSED(user_data);
+
+	/* The cache entries are refreshed when the answers are parsed */
+	if (status != DNS_EAI_INPROGRESS) {
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+
+static void dns_prefetch(struct dns_resolve_context *ctx, const char *query,
+			 enum dns_query_type type, int32_t timeout)
+{
+	int ret;
+
+	if (!atomic_cas(&dns_prefetch_busy, 0, 1)) {
+		return;
+	}
+
+	if (!dns_cache_prefetch_due(&dns_cache, query, type)) {
+		atomic_clear(&dns_prefetch_busy);
+		return;
+	}
+
+	strncpy(dns_prefetch_query, query, sizeof(dns_prefetch_query) - 1);
+
+	ret = dns_resolve_name_internal(ctx, dns_prefetch_query, type, NULL,
+					dns_prefetch_cb, NULL, timeout, false);
+	if (ret < 0) {
+		NET_DBG("Cannot refresh \"%s\" (%d)", query, ret);
+		atomic_clear(&dns_prefetch_busy);
+	}
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
+
 int dns_resolve_name_internal(struct dns_resolve_context *ctx,
 			      const char *query,
 			      enum dns_query_type type,
@@ -1575,6 +1626,16 @@ try_resolve:
 
 			cb(DNS_EAI_ALLDONE, NULL, user_data);
 
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+			dns_prefetch(ctx, query, type, timeout);
+#endif
+			return 0;
+		}
+
+		if (ret == -ENOENT) {
+			/* Known not to resolve */
+			cb(DNS_EAI_NODATA, NULL, user_data);
+
 			return 0;
 		}
 	}
@@ -44,6 +44,26 @@ const char *http_compression_text(enum http_compression compression);
 int http_compression_from_text(enum http_compression *compression, const char *text);
 bool compression_value_is_valid(enum http_compression compression);
 
+/* Static filesystem resource cache */
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+#define HTTP_SERVER_ETAG_FMT "\"%08x\""
+#define HTTP_SERVER_ETAG_LEN sizeof("\"01234567\"")
+
+struct http_server_fs_cache_entry {
+	char fname[HTTP_SERVER_MAX_URL_LENGTH];
+	size_t len;
+	uint32_t etag;
+	uint32_t last_used;
+	int refs;
+	uint8_t data[CONFIG_HTTP_SERVER_STATIC_FS_CACHE_FILE_SIZE];
+};
+
+const struct http_server_fs_cache_entry *http_server_fs_cache_get(const char *fname,
+								  size_t file_size);
+void http_server_fs_cache_put(const struct http_server_fs_cache_entry *entry);
+bool http_server_fs_cache_parse_etag(const char *value, size_t len, uint32_t *etag);
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
+
 /* Others */
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
@@ -53,6 +73,8 @@ void http_server_get_content_type_from_extension(char *url, char *content_type,
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
 			  uint8_t supported_compression, enum http_compression *chosen_compression);
 void http_client_timer_restart(struct http_client_ctx *client);
+bool http_server_acquire_dynamic(struct http_resource_detail_dynamic *dynamic_detail,
+				 struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
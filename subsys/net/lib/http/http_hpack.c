@@ -96,6 +96,200 @@ const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
 	return &http_hpack_table_static[key];
 }
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table,
+				   uint32_t max_size)
+{
+	table->size = 0;
+	table->max_size = MIN(max_size, sizeof(table->data));
+	table->first = 0;
+	table->count = 0;
+	table->head = 0;
+}
+
+static uint32_t hpack_dynamic_entry_size(const struct http_hpack_dynamic_entry *entry)
+{
+	return entry->name_len + entry->value_len + HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD;
+}
+
+static void hpack_dynamic_table_evict(struct http_hpack_dynamic_table *table,
+				      uint32_t max_size)
+{
+	/* Based on RFC7541, ch 4.4, oldest entries are evicted first. */
+	while (table->count > 0 && table->size > max_size) {
+		table->size -= hpack_dynamic_entry_size(&table->entries[table->first]);
+		table->first = (table->first + 1) % ARRAY_SIZE(table->entries);
+		table->count--;
+	}
+}
+
+static void hpack_dynamic_table_write(struct http_hpack_dynamic_table *table,
+				      const char *str, size_t len)
+{
+	size_t chunk = MIN(len, sizeof(table->data) - table->head);
+
+	memcpy(&table->data[table->head], str, chunk);
+	memcpy(table->data, str + chunk, len - chunk);
+
+	table->head = (table->head + len) % sizeof(table->data);
+}
+
+static int hpack_dynamic_table_read(struct http_hpack_header_buf *header,
+				    uint16_t offset, size_t len, const char **str)
+{
+	struct http_hpack_dynamic_table *table = header->dynamic_table;
+	size_t chunk = sizeof(table->data) - offset;
+	uint8_t *buf = header->buf + header->datalen;
+
+	if (len <= chunk) {
+		*str = (const char *)&table->data[offset];
+		return 0;
+	}
+
+	/* String wraps around the end of the table, copy it to make it
+	 * contiguous.
+	 */
+	if (len > sizeof(header->buf) - header->datalen) {
+		return -ENOBUFS;
+	}
+
+	memcpy(buf, &table->data[offset], chunk);
+	memcpy(buf + chunk, table->data, len - chunk);
+	header->datalen += len;
+	*str = (const char *)buf;
+
+	return 0;
+}
+
+static int hpack_dynamic_table_get(struct http_hpack_header_buf *header,
+				   uint32_t index, bool name_only)
+{
+	struct http_hpack_dynamic_table *table = header->dynamic_table;
+	const struct http_hpack_dynamic_entry *entry;
+	int ret;
+
+	if (table == NULL) {
+		return -EBADMSG;
+	}
+
+	/* Dynamic table indexes follow the static table, newest entry first. */
+	index -= HTTP_SERVER_HPACK_WWW_AUTHENTICATE + 1;
+	if (index >= table->count) {
+		return -EBADMSG;
+	}
+
+	entry = &table->entries[(table->first + table->count - 1 - index) %
+				ARRAY_SIZE(table->entries)];
+
+	ret = hpack_dynamic_table_read(header, entry->offset, entry->name_len,
+				       &header->name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	header->name_len = entry->name_len;
+
+	if (name_only) {
+		return 0;
+	}
+
+	ret = hpack_dynamic_table_read(header,
+				       (entry->offset + entry->name_len) % sizeof(table->data),
+				       entry->value_len, &header->value);
+	if (ret < 0) {
+		return ret;
+	}
+
+	header->value_len = entry->value_len;
+
+	return 0;
+}
+
+static int hpack_dynamic_table_add(struct http_hpack_header_buf *header)
+{
+	struct http_hpack_dynamic_table *table = header->dynamic_table;
+	const char *data = (const char *)table->data;
+	struct http_hpack_dynamic_entry *entry;
+	uint32_t entry_size;
+
+	entry_size = header->name_len + header->value_len + HTTP_HPACK_DYNAMIC_ENTRY_OVERHEAD;
+	if (entry_size > table->max_size) {
+		/* Based on RFC7541, ch 4.4, such an entry empties the table. */
+		hpack_dynamic_table_evict(table, 0);
+		return 0;
+	}
+
+	/* The name may refer to an entry about to be evicted and overwritten. */
+	if (header->name >= data && header->name < data + sizeof(table->data)) {
+		if (header->name_len > sizeof(header->buf) - header->datalen) {
+			return -ENOBUFS;
+		}
+
+		memcpy(header->buf + header->datalen, header->name, header->name_len);
+		header->name = (const char *)header->buf + header->datalen;
+		header->datalen += header->name_len;
+	}
+
+	hpack_dynamic_table_evict(table, table->max_size - entry_size);
+
+	entry = &table->entries[(table->first + table->count) % ARRAY_SIZE(table->entries)];
+	entry->offset = table->head;
+	entry->name_len = header->name_len;
+	entry->value_len = header->value_len;
+
+	hpack_dynamic_table_write(table, header->name, header->name_len);
+	hpack_dynamic_table_write(table, header->value, header->value_len);
+
+	table->size += entry_size;
+	table->count++;
+
+	return 0;
+}
+
+static int hpack_dynamic_table_resize(struct http_hpack_header_buf *header,
+				      uint32_t max_size)
+{
+	struct http_hpack_dynamic_table *table = header->dynamic_table;
+
+	if (table == NULL) {
+		return 0;
+	}
+
+	if (max_size > sizeof(table->data)) {
+		return -EBADMSG;
+	}
+
+	table->max_size = max_size;
+	hpack_dynamic_table_evict(table, max_size);
+
+	return 0;
+}
+#else
+void http_hpack_dynamic_table_init(struct http_hpack_dynamic_table *table,
+				   uint32_t max_size)
+{
+	ARG_UNUSED(table);
+	ARG_UNUSED(max_size);
+}
+
+static int hpack_dynamic_table_get(struct http_hpack_header_buf *header,
+				   uint32_t index, bool name_only)
+{
+	return -EBADMSG;
+}
+
+static int hpack_dynamic_table_add(struct http_hpack_header_buf *header)
+{
+	return 0;
+}
+
+static int hpack_dynamic_table_resize(struct http_hpack_header_buf *header,
+				      uint32_t max_size)
+{
+	return 0;
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 static int http_hpack_find_index(struct http_hpack_header_buf *header,
 				 bool *name_only)
 {
@@ -286,7 +480,7 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 {
 	const struct hpack_table_entry *entry;
 	uint32_t index;
-	int ret;
+	int ret, err;
 
 	ret = hpack_integer_decode(buf, datalen, HPACK_PREFIX_LEN_INDEXED,
 				   &index);
@@ -298,11 +492,18 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 		return -EBADMSG;
 	}
 
-	entry = http_hpack_table_get(index);
-	if (entry == NULL) {
-		return -EBADMSG;
+	if (!http_hpack_key_is_static(index)) {
+		header->datalen = 0;
+
+		err = hpack_dynamic_table_get(header, index, false);
+		if (err < 0) {
+			return err;
+		}
+
+		return ret;
 	}
 
+	entry = http_hpack_table_get(index);
 	if (entry->name == NULL || entry->value == NULL) {
 		return -EBADMSG;
 	}
@@ -344,21 +545,23 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		len += ret;
 		buf += ret;
 		datalen -= ret;
-	} else {
+	} else if (http_hpack_key_is_static(index)) {
 		/* Indexed name. */
 		const struct hpack_table_entry *entry;
 
 		entry = http_hpack_table_get(index);
-		if (entry == NULL) {
-			return -EBADMSG;
-		}
-
 		if (entry->name == NULL) {
 			return -EBADMSG;
 		}
 
 		header->name = entry->name;
 		header->name_len = strlen(entry->name);
+	} else {
+		/* Indexed name from the dynamic table. */
+		ret = hpack_dynamic_table_get(header, index, true);
+		if (ret < 0) {
+			return ret;
+		}
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -374,10 +577,20 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 static int hpack_handle_literal_index(const uint8_t *buf, size_t datalen,
 			       struct http_hpack_header_buf *header)
 {
-	/* TODO Add dynamic table support, if needed. */
+	int ret, len;
 
-	return hpack_handle_literal(buf, datalen, header,
-				    HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	len = hpack_handle_literal(buf, datalen, header,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING);
+	if (len < 0 || header->dynamic_table == NULL) {
+		return len;
+	}
+
+	ret = hpack_dynamic_table_add(header);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return len;
 }
 
 static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
@@ -387,10 +600,11 @@ static int hpack_handle_literal_no_index(const uint8_t *buf, size_t datalen,
 				    HPACK_PREFIX_LEN_LITERAL_NO_INDEXING);
 }
 
-static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
+static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen,
+					    struct http_hpack_header_buf *header)
 {
 	uint32_t max_size;
-	int ret;
+	int ret, err;
 
 	ret = hpack_integer_decode(
 		buf, datalen, HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE, &max_size);
@@ -398,7 +612,16 @@ static int hpack_handle_dynamic_size_update(const uint8_t *buf, size_t datalen)
 		return ret;
 	}
 
-	/* TODO Add dynamic table support, if needed. */
+	err = hpack_dynamic_table_resize(header, max_size);
+	if (err < 0) {
+		return err;
+	}
+
+	/* No header field is carried by a size update. */
+	header->name = "";
+	header->name_len = 0;
+	header->value = "";
+	header->value_len = 0;
 
 	return ret;
 }
@@ -431,7 +654,7 @@ int http_hpack_decode_header(const uint8_t *buf, size_t datalen,
 		ret = hpack_handle_literal_no_index(buf, datalen, header);
 	} else if ((prefix & HPACK_PREFIX_DYNAMIC_TABLE_SIZE_MASK) ==
 		   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE) {
-		ret = hpack_handle_dynamic_size_update(buf, datalen);
+		ret = hpack_handle_dynamic_size_update(buf, datalen, header);
 	} else {
 		ret = -EINVAL;
 	}
@@ -298,11 +298,94 @@ static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
 	return false;
 }
 
+/* Codes up to 8 bits long are decoded with a single lookup of the 8 most
+ * significant bits of the input in decode_fast_index, which holds the index of
+ * the matching decode_table entry. Longer codes all start with 0xfe or 0xff
+ * and, as the code is canonical, are decoded per bit length range.
+ */
+#define LONG_CODE 0xff
+#define FAST_BITLEN 8
+
+static const uint8_t decode_fast_index[256] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+	  2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   3,   3,
+	  4,   4,   4,   4,   4,   4,   4,   4,   5,   5,   5,   5,   5,   5,   5,   5,
+	  6,   6,   6,   6,   6,   6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,
+	  8,   8,   8,   8,   8,   8,   8,   8,   9,   9,   9,   9,   9,   9,   9,   9,
+	 10,  10,  10,  10,  11,  11,  11,  11,  12,  12,  12,  12,  13,  13,  13,  13,
+	 14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,  17,  17,  17,  17,
+	 18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,  20,  21,  21,  21,  21,
+	 22,  22,  22,  22,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,  25,  25,
+	 26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,  29,  29,  29,
+	 30,  30,  30,  30,  31,  31,  31,  31,  32,  32,  32,  32,  33,  33,  33,  33,
+	 34,  34,  34,  34,  35,  35,  35,  35,  36,  36,  37,  37,  38,  38,  39,  39,
+	 40,  40,  41,  41,  42,  42,  43,  43,  44,  44,  45,  45,  46,  46,  47,  47,
+	 48,  48,  49,  49,  50,  50,  51,  51,  52,  52,  53,  53,  54,  54,  55,  55,
+	 56,  56,  57,  57,  58,  58,  59,  59,  60,  60,  61,  61,  62,  62,  63,  63,
+	 64,  64,  65,  65,  66,  66,  67,  67,  68,  69,  70,  71,  72,  73, LONG_CODE, LONG_CODE,
+};
+
+struct decode_range {
+	uint8_t bitlen;
+	uint8_t index;
+	uint8_t count;
+	uint32_t first_code;
+};
+
+static const struct decode_range decode_ranges[] = {
+	{ 10,  74,  5, 0x000003f8 },
+	{ 11,  79,  3, 0x000007fa },
+	{ 12,  82,  2, 0x00000ffa },
+	{ 13,  84,  6, 0x00001ff8 },
+	{ 14,  90,  2, 0x00003ffc },
+	{ 15,  92,  3, 0x00007ffc },
+	{ 19,  95,  3, 0x0007fff0 },
+	{ 20,  98,  8, 0x000fffe6 },
+	{ 21, 106, 13, 0x001fffdc },
+	{ 22, 119, 26, 0x003fffd2 },
+	{ 23, 145, 29, 0x007fffd8 },
+	{ 24, 174, 12, 0x00ffffea },
+	{ 25, 186,  4, 0x01ffffec },
+	{ 26, 190, 15, 0x03ffffe0 },
+	{ 27, 205, 19, 0x07ffffde },
+	{ 28, 224, 29, 0x0fffffe2 },
+	{ 30, 253,  3, 0x3ffffffc },
+};
+
+/* Index of each symbol in decode_table, used by the encoder. */
+static const uint8_t encode_index[256] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241, 242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,  65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108, 163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182, 114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220, 221, 222, 223, 204,
+};
+
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
+	uint8_t index = decode_fast_index[bits >> (UINT32_BITLEN - FAST_BITLEN)];
+
+	if (index != LONG_CODE) {
+		return &decode_table[index];
+	}
+
+	ARRAY_FOR_EACH_PTR(decode_ranges, range) {
+		uint32_t offset = (bits >> (UINT32_BITLEN - range->bitlen)) -
+				  range->first_code;
+
+		if (offset < range->count) {
+			return &decode_table[range->index + offset];
 		}
 	}
 
@@ -315,13 +398,7 @@ static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 
 static const struct decode_elem *huffman_find_entry(uint8_t symbol)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
-		}
-	}
-
-	return NULL;
+	return &decode_table[encode_index[symbol]];
 }
 
 #define MAX_PADDING_LEN 7
@@ -41,29 +41,157 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+/* The server thread only polls the listen sockets, the accepted sockets
+ * are polled by the worker owning them.
+ */
+#define HTTP_SERVER_WORKER_MAX_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+#define HTTP_SERVER_CLIENT_COUNT (HTTP_SERVER_NUM_WORKERS * HTTP_SERVER_WORKER_MAX_CLIENTS)
+#define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES)
+#else
+#define HTTP_SERVER_CLIENT_COUNT HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#endif
+
+/* Bits of http_server_ctx.events */
+#define HTTP_SERVER_EVENT_STOP 0
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+/* Accepted connection handed over from the server thread to a worker. A
+ * NULL service asks the worker to close its connections and stop.
+ */
+struct http_server_handoff {
+	const struct http_service_desc *service;
+	int fd;
+};
+
+struct http_server_worker {
+	/* First pollfd is eventfd signaling pending handoffs, then we have
+	 * the sockets of the clients owned by the worker.
+	 */
+	struct zsock_pollfd fds[1 + HTTP_SERVER_WORKER_MAX_CLIENTS];
+	struct http_client_ctx *clients;
+
+	/* Number of clients handed over to the worker and not released yet. */
+	atomic_t num_clients;
+
+	struct k_msgq handoff_q;
+	char __aligned(sizeof(void *))
+		handoff_buf[(HTTP_SERVER_WORKER_MAX_CLIENTS + 1) * sizeof(struct http_server_handoff)];
+
+	struct k_sem start;
+	struct k_thread thread;
+};
+#endif
 
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
 
 	/* First pollfd is eventfd that can be used to stop the server,
 	 * then we have the server listen sockets,
-	 * and then the accepted sockets.
+	 * and then the accepted sockets (if there are no workers).
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
-	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+	struct http_client_ctx clients[HTTP_SERVER_CLIENT_COUNT];
+
+	atomic_t events;
+
+	/* Protects the service client counters and the dynamic resource
+	 * holders, which are shared between the workers.
+	 */
+	struct k_spinlock lock;
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	struct http_server_worker workers[HTTP_SERVER_NUM_WORKERS];
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, HTTP_SERVER_NUM_WORKERS,
+				   CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+static K_SEM_DEFINE(workers_stopped, 0, HTTP_SERVER_NUM_WORKERS);
+#endif
+
 #if defined(CONFIG_HTTP_SERVER_TLS_USE_ALPN)
 static const char *const alpn_list[] = {"h2", "http/1.1"};
 #endif
 
 static void close_client_connection(struct http_client_ctx *client);
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+static void workers_close_eventfds(struct http_server_ctx *ctx)
+{
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		if (worker->fds[0].fd >= 0) {
+			zsock_close(worker->fds[0].fd);
+			worker->fds[0].fd = INVALID_SOCK;
+		}
+	}
+}
+
+static int workers_init(struct http_server_ctx *ctx)
+{
+	int fd;
+
+	ARRAY_FOR_EACH(ctx->workers, i) {
+		struct http_server_worker *worker = &ctx->workers[i];
+
+		ARRAY_FOR_EACH(worker->fds, j) {
+			worker->fds[j].fd = INVALID_SOCK;
+			worker->fds[j].events = ZSOCK_POLLIN;
+			worker->fds[j].revents = 0;
+		}
+
+		worker->clients = &ctx->clients[i * HTTP_SERVER_WORKER_MAX_CLIENTS];
+		atomic_clear(&worker->num_clients);
+		k_msgq_purge(&worker->handoff_q);
+	}
+
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+			workers_close_eventfds(ctx);
+			return fd;
+		}
+
+		worker->fds[0].fd = fd;
+	}
+
+	return 0;
+}
+
+static void workers_stop(struct http_server_ctx *ctx)
+{
+	struct http_server_handoff stop = {
+		.service = NULL,
+		.fd = INVALID_SOCK,
+	};
+
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		/* There is always room for the stop request, on top of the
+		 * clients the worker may own.
+		 */
+		(void)k_msgq_put(&worker->handoff_q, &stop, K_NO_WAIT);
+		eventfd_write(worker->fds[0].fd, 1);
+	}
+
+	for (int i = 0; i < HTTP_SERVER_NUM_WORKERS; i++) {
+		k_sem_take(&workers_stopped, K_FOREVER);
+	}
+
+	workers_close_eventfds(ctx);
+}
+#endif
+
 HTTP_SERVER_CONTENT_TYPE(html, "text/html")
 HTTP_SERVER_CONTENT_TYPE(css, "text/css")
 HTTP_SERVER_CONTENT_TYPE(js, "text/javascript")
@@ -109,6 +237,16 @@ int http_server_init(struct http_server_ctx *ctx)
 	ctx->fds[count].events = ZSOCK_POLLIN;
 	count++;
 
+	atomic_clear(&ctx->events);
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	fd = workers_init(ctx);
+	if (fd < 0) {
+		zsock_close(ctx->fds[0].fd);
+		return fd;
+	}
+#endif
+
 	HTTP_SERVICE_FOREACH(svc) {
 		/* set the default address (in6addr_any / INADDR_ANY are all 0) */
 		memset(&addr_storage, 0, sizeof(struct sockaddr_storage));
@@ -248,6 +386,9 @@ int http_server_init(struct http_server_ctx *ctx)
 		LOG_ERR("All services failed (%d)", failed);
 		/* Close eventfd socket */
 		zsock_close(ctx->fds[0].fd);
+#if HTTP_SERVER_NUM_WORKERS > 0
+		workers_close_eventfds(ctx);
+#endif
 		return -ESRCH;
 	}
 
@@ -281,6 +422,11 @@ static int accept_new_client(int server_fd)
 
 static void close_all_sockets(struct http_server_ctx *ctx)
 {
+#if HTTP_SERVER_NUM_WORKERS > 0
+	/* Workers close their clients, which may still signal the eventfd. */
+	workers_stop(ctx);
+#endif
+
 	zsock_close(ctx->fds[0].fd); /* close eventfd */
 	ctx->fds[0].fd = -1;
 
@@ -345,17 +491,64 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+bool http_server_acquire_dynamic(struct http_resource_detail_dynamic *dynamic_detail,
+				 struct http_client_ctx *client)
+{
+	k_spinlock_key_t key;
+	bool acquired = false;
+
+	key = k_spin_lock(&server_ctx.lock);
+
+	if (dynamic_detail->holder == NULL || dynamic_detail->holder == client) {
+		dynamic_detail->holder = client;
+		acquired = true;
+	}
+
+	k_spin_unlock(&server_ctx.lock, key);
+
+	return acquired;
+}
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+static void worker_release_client(struct http_client_ctx *client, bool resume)
+{
+	int idx = ARRAY_INDEX(server_ctx.clients, client);
+	struct http_server_worker *worker =
+		&server_ctx.workers[idx / HTTP_SERVER_WORKER_MAX_CLIENTS];
+
+	worker->fds[1 + idx % HTTP_SERVER_WORKER_MAX_CLIENTS].fd = INVALID_SOCK;
+	atomic_dec(&worker->num_clients);
+
+	if (resume) {
+		/* The service was at its client limit, let the server thread
+		 * listen on it again.
+		 */
+		eventfd_write(server_ctx.fds[0].fd, 1);
+	}
+}
+#endif
+
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
 	struct k_work_sync sync;
+	k_spinlock_key_t key;
+	bool resume;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
 
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
-	client->service->data->num_clients--;
+	key = k_spin_lock(&server_ctx.lock);
+	resume = client->service->data->num_clients-- >= client->service->concurrent;
+	k_spin_unlock(&server_ctx.lock, key);
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	worker_release_client(client, resume);
+#else
+	int i;
+
+	ARG_UNUSED(resume);
 
 	for (i = 0; i < server_ctx.listen_fds; i++) {
 		if (server_ctx.fds[i].fd == *client->service->fd) {
@@ -369,6 +562,7 @@ void http_server_release_client(struct http_client_ctx *client)
 			break;
 		}
 	}
+#endif
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
@@ -437,6 +631,12 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	}
 
 	client->current_stream = NULL;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_dynamic_table_init(&client->hpack_table,
+				      CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	client->header_field.dynamic_table = &client->hpack_table;
+#endif
 }
 
 static int handle_http_preface(struct http_client_ctx *client)
@@ -544,19 +744,241 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
+static void handle_client_events(struct http_client_ctx *client, short revents)
+{
+	int ret;
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+
+	if (revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client #%d has disconnected",
+			(int)ARRAY_INDEX(server_ctx.clients, client));
+		close_client_connection(client);
+		return;
+	}
+
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d",
+				(int)ARRAY_INDEX(server_ctx.clients, client));
+		} else {
+			ret = -errno;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
+		}
+
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
+		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+static void worker_close_clients(struct http_server_worker *worker)
+{
+	for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+		if (worker->fds[i].fd >= 0) {
+			close_client_connection(&worker->clients[i - 1]);
+		}
+	}
+}
+
+/* Returns false if the worker was asked to stop. */
+static bool worker_add_clients(struct http_server_worker *worker)
+{
+	struct http_server_handoff handoff;
+	int i;
+
+	while (k_msgq_get(&worker->handoff_q, &handoff, K_NO_WAIT) == 0) {
+		if (handoff.service == NULL) {
+			return false;
+		}
+
+		for (i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+			if (worker->fds[i].fd == INVALID_SOCK) {
+				break;
+			}
+		}
+
+		/* The server thread reserved a slot before the handoff. */
+		__ASSERT_NO_MSG(i < ARRAY_SIZE(worker->fds));
+
+		worker->fds[i].fd = handoff.fd;
+		worker->fds[i].events = ZSOCK_POLLIN;
+		worker->fds[i].revents = 0;
+
+		LOG_DBG("Init client #%d",
+			(int)ARRAY_INDEX(server_ctx.clients, &worker->clients[i - 1]));
+
+		init_client_ctx(&worker->clients[i - 1], handoff.service, handoff.fd);
+	}
+
+	return true;
+}
+
+static void worker_run(struct http_server_worker *worker)
+{
+	eventfd_t value;
+	int ret;
+
+	while (true) {
+		ret = zsock_poll(worker->fds, ARRAY_SIZE(worker->fds), -1);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_ERR("Worker poll failed (%d)", ret);
+			worker_close_clients(worker);
+			k_sleep(K_MSEC(CONFIG_HTTP_SERVER_RESTART_DELAY));
+			continue;
+		}
+
+		if (worker->fds[0].revents) {
+			eventfd_read(worker->fds[0].fd, &value);
+
+			if (!worker_add_clients(worker)) {
+				break;
+			}
+		}
+
+		for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+			if (worker->fds[i].fd < 0) {
+				continue;
+			}
+
+			handle_client_events(&worker->clients[i - 1], worker->fds[i].revents);
+		}
+	}
+
+	worker_close_clients(worker);
+}
+
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
+{
+	struct http_server_worker *worker = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&worker->start, K_FOREVER);
+
+		worker_run(worker);
+
+		k_sem_give(&workers_stopped);
+	}
+}
+
+static void workers_create(struct http_server_ctx *ctx)
+{
+	char name[sizeof("http_worker_XX")];
+
+	ARRAY_FOR_EACH(ctx->workers, i) {
+		struct http_server_worker *worker = &ctx->workers[i];
+
+		k_msgq_init(&worker->handoff_q, worker->handoff_buf,
+			    sizeof(struct http_server_handoff),
+			    HTTP_SERVER_WORKER_MAX_CLIENTS + 1);
+		k_sem_init(&worker->start, 0, 1);
+
+		k_thread_create(&worker->thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				http_server_worker_thread, worker, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		snprintk(name, sizeof(name), "http_worker_%d", (int)i);
+		k_thread_name_set(&worker->thread, name);
+	}
+}
+
+/* Hand the new client over to the least loaded worker. */
+static bool handoff_client(struct http_server_ctx *ctx,
+			   const struct http_service_desc *service, int new_socket)
+{
+	struct http_server_worker *worker = NULL;
+	struct http_server_handoff handoff = {
+		.service = service,
+		.fd = new_socket,
+	};
+	atomic_val_t load, min_load = HTTP_SERVER_WORKER_MAX_CLIENTS;
+	k_spinlock_key_t key;
+
+	ARRAY_FOR_EACH_PTR(ctx->workers, w) {
+		load = atomic_get(&w->num_clients);
+		if (load < min_load) {
+			min_load = load;
+			worker = w;
+		}
+	}
+
+	if (worker == NULL) {
+		return false;
+	}
+
+	key = k_spin_lock(&ctx->lock);
+	service->data->num_clients++;
+	k_spin_unlock(&ctx->lock, key);
+
+	/* Only this thread increments the counter, so the slot reserved here
+	 * cannot be taken before the worker picks the client up.
+	 */
+	atomic_inc(&worker->num_clients);
+	(void)k_msgq_put(&worker->handoff_q, &handoff, K_NO_WAIT);
+	eventfd_write(worker->fds[0].fd, 1);
+
+	return true;
+}
+#endif
+
 static int http_server_run(struct http_server_ctx *ctx)
 {
-	struct http_client_ctx *client;
 	const struct http_service_desc *service;
 	eventfd_t value;
 	bool found_slot;
 	int new_socket;
-	int ret, i, j;
+	int ret, i;
 	int sock_error;
 	socklen_t optlen = sizeof(int);
+	k_spinlock_key_t key;
 
 	value = 0;
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		k_sem_give(&worker->start);
+	}
+#endif
+
 	while (1) {
 		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
 		if (ret < 0) {
@@ -570,11 +992,21 @@ static int http_server_run(struct http_server_ctx *ctx)
 			break;
 		}
 
-		if (ret == 1 && ctx->fds[0].revents) {
+		if (ctx->fds[0].revents) {
 			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
+
+			if (atomic_test_and_clear_bit(&ctx->events, HTTP_SERVER_EVENT_STOP)) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
+
+			/* A client was released by a worker, listen again on
+			 * the services that reached their client limit.
+			 */
+			for (i = 1; i < ctx->listen_fds; i++) {
+				ctx->fds[i].events = ZSOCK_POLLIN;
+			}
 		}
 
 		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
@@ -582,15 +1014,13 @@ static int http_server_run(struct http_server_ctx *ctx)
 				continue;
 			}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
-
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+			if (i >= ctx->listen_fds) {
+				handle_client_events(&ctx->clients[i - ctx->listen_fds],
+						     ctx->fds[i].revents);
+				continue;
+			}
 
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
 				continue;
 			}
 
@@ -599,106 +1029,64 @@ static int http_server_run(struct http_server_ctx *ctx)
 						       SO_ERROR, &sock_error, &optlen);
 				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
-
 				/* Listening socket error, abort. */
 				LOG_ERR("Listening socket error, aborting.");
 				ret = -sock_error;
 				goto closing;
-
 			}
 
 			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
 				continue;
 			}
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
+			service = lookup_service(ctx->fds[i].fd);
+			__ASSERT(NULL != service, "fd not associated with a service");
 
-				if (service->data->num_clients >= service->concurrent) {
-					ctx->fds[i].events = 0;
-					continue;
-				}
-
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
-
-				found_slot = false;
-
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
-
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+			key = k_spin_lock(&ctx->lock);
+			if (service->data->num_clients >= service->concurrent) {
+				k_spin_unlock(&ctx->lock, key);
+				ctx->fds[i].events = 0;
+				continue;
+			}
+			k_spin_unlock(&ctx->lock, key);
 
-					service->data->num_clients++;
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
+				continue;
+			}
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+#if HTTP_SERVER_NUM_WORKERS > 0
+			found_slot = handoff_client(ctx, service, new_socket);
+#else
+			found_slot = false;
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
+			for (int j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+				if (ctx->fds[j].fd != INVALID_SOCK) {
+					continue;
 				}
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+				ctx->fds[j].fd = new_socket;
+				ctx->fds[j].events = ZSOCK_POLLIN;
+				ctx->fds[j].revents = 0;
 
-				continue;
-			}
+				key = k_spin_lock(&ctx->lock);
+				service->data->num_clients++;
+				k_spin_unlock(&ctx->lock, key);
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
-
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+				LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-				close_client_connection(client);
-				continue;
+				init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
+						new_socket);
+				found_slot = true;
+				break;
 			}
+#endif
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
-
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
+			if (!found_slot) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
 			}
 		}
 	}
@@ -960,6 +1348,7 @@ int http_server_stop(void)
 
 	server_running = false;
 	k_sem_reset(&server_start);
+	atomic_set_bit(&server_ctx.events, HTTP_SERVER_EVENT_STOP);
 	eventfd_write(server_ctx.fds[0].fd, 1);
 
 	LOG_DBG("Stopping HTTP server");
@@ -975,6 +1364,10 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+	workers_create(&server_ctx);
+#endif
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -0,0 +1,168 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/sys/crc.h>
+
+LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
+
+#include "headers/server_internal.h"
+
+/* An entry with an empty file name is free. An entry can only be reused
+ * once all the clients sending it have released it.
+ */
+static struct http_server_fs_cache_entry cache[CONFIG_HTTP_SERVER_STATIC_FS_CACHE_ENTRIES];
+static uint32_t cache_clock;
+static K_MUTEX_DEFINE(cache_lock);
+
+static int cache_load(struct http_server_fs_cache_entry *entry, const char *fname,
+		      size_t file_size)
+{
+	struct fs_file_t file;
+	size_t offset = 0;
+	ssize_t len;
+	int ret;
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, fname, FS_O_READ);
+	if (ret < 0) {
+		LOG_ERR("fs_open %s: %d", fname, ret);
+		return ret;
+	}
+
+	while (offset < file_size) {
+		len = fs_read(&file, entry->data + offset, file_size - offset);
+		if (len <= 0) {
+			ret = (len < 0) ? (int)len : -EIO;
+			LOG_ERR("Filesystem read error (%d)", ret);
+			break;
+		}
+
+		offset += len;
+	}
+
+	fs_close(&file);
+
+	if (ret < 0) {
+		entry->fname[0] = '\0';
+		return ret;
+	}
+
+	strcpy(entry->fname, fname);
+	entry->len = file_size;
+	entry->etag = crc32_ieee(entry->data, file_size);
+
+	LOG_DBG("Cached %s, %zu bytes, etag %08x", fname, file_size, entry->etag);
+
+	return 0;
+}
+
+const struct http_server_fs_cache_entry *http_server_fs_cache_get(const char *fname,
+								  size_t file_size)
+{
+	struct http_server_fs_cache_entry *entry = NULL;
+	struct http_server_fs_cache_entry *victim = NULL;
+
+	if (file_size > CONFIG_HTTP_SERVER_STATIC_FS_CACHE_FILE_SIZE ||
+	    strlen(fname) >= sizeof(cache[0].fname)) {
+		return NULL;
+	}
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	ARRAY_FOR_EACH_PTR(cache, e) {
+		if (e->fname[0] != '\0' && strcmp(e->fname, fname) == 0) {
+			entry = e;
+			break;
+		}
+
+		if (e->refs > 0) {
+			continue;
+		}
+
+		/* Free entries come first, then the least recently used one. */
+		if (victim == NULL || e->fname[0] == '\0' ||
+		    (victim->fname[0] != '\0' && e->last_used < victim->last_used)) {
+			victim = e;
+		}
+	}
+
+	if (entry != NULL && entry->len != file_size) {
+		/* The file was modified, reload it unless it is being sent. */
+		victim = (entry->refs == 0) ? entry : NULL;
+		entry = NULL;
+	}
+
+	if (entry == NULL) {
+		if (victim == NULL || cache_load(victim, fname, file_size) < 0) {
+			k_mutex_unlock(&cache_lock);
+			return NULL;
+		}
+
+		entry = victim;
+	}
+
+	entry->refs++;
+	entry->last_used = ++cache_clock;
+
+	k_mutex_unlock(&cache_lock);
+
+	return entry;
+}
+
+void http_server_fs_cache_put(const struct http_server_fs_cache_entry *entry)
+{
+	struct http_server_fs_cache_entry *e = &cache[ARRAY_INDEX(cache, entry)];
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+	__ASSERT_NO_MSG(e->refs > 0);
+	e->refs--;
+	k_mutex_unlock(&cache_lock);
+}
+
+void http_server_fs_cache_flush(void)
+{
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	/* Entries still being sent keep their data until released. */
+	ARRAY_FOR_EACH_PTR(cache, e) {
+		e->fname[0] = '\0';
+	}
+
+	k_mutex_unlock(&cache_lock);
+}
+
+bool http_server_fs_cache_parse_etag(const char *value, size_t len, uint32_t *etag)
+{
+	char tag[HTTP_SERVER_ETAG_LEN - 2];
+	char *endptr;
+
+	/* Weak comparison is used for If-None-Match */
+	if (len >= 2 && value[0] == 'W' && value[1] == '/') {
+		value += 2;
+		len -= 2;
+	}
+
+	if (len < HTTP_SERVER_ETAG_LEN - 1 || value[0] != '"' ||
+	    value[HTTP_SERVER_ETAG_LEN - 2] != '"') {
+		return false;
+	}
+
+	memcpy(tag, &value[1], sizeof(tag) - 1);
+	tag[sizeof(tag) - 1] = '\0';
+
+	*etag = strtoul(tag, &endptr, 16);
+
+	return *endptr == '\0';
+}
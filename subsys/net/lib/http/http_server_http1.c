@@ -72,6 +72,22 @@ static int send_http1_409(struct http_client_ctx *client)
 				       sizeof(conflict_response) - 1);
 }
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+static int send_http1_304(struct http_client_ctx *client, uint32_t etag)
+{
+#define HTTP_304_RESPONSE_TEMPLATE		\
+	"HTTP/1.1 304 Not Modified\r\n"		\
+	"ETag: " HTTP_SERVER_ETAG_FMT "\r\n\r\n"
+
+	char response[sizeof(HTTP_304_RESPONSE_TEMPLATE) + HTTP_SERVER_ETAG_LEN];
+	int len;
+
+	len = snprintk(response, sizeof(response), HTTP_304_RESPONSE_TEMPLATE, etag);
+
+	return send_http1_error_common(client, response, len);
+}
+#endif
+
 static void send_http1_500(struct http_client_ctx *client, int error_code)
 {
 #define HTTP_500_RESPONSE_TEMPLATE			\
@@ -472,14 +488,18 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 #define RESPONSE_TEMPLATE_STATIC_FS                                                                \
 	"HTTP/1.1 200 OK\r\n"                                                                      \
 	"Content-Length: %zd\r\n"                                                                  \
-	"Content-Type: %s%s%s\r\n\r\n"
+	"Content-Type: %s%s%s%s\r\n\r\n"
 #define CONTENT_ENCODING_HEADER "\r\nContent-Encoding: "
+#define ETAG_HEADER "\r\nETag: "
+#define ETAG_HEADER_SIZE                                                                           \
+	COND_CODE_1(IS_ENABLED(CONFIG_HTTP_SERVER_STATIC_FS_CACHE),                                \
+		    (sizeof(ETAG_HEADER) + HTTP_SERVER_ETAG_LEN), (1))
 /* Add couple of bytes to response template size to have space
- * for the content type and encoding
+ * for the content type, encoding and entity tag
  */
 #define STATIC_FS_RESPONSE_BASE_SIZE                                                               \
 	sizeof(RESPONSE_TEMPLATE_STATIC_FS) + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +                   \
-		sizeof("Content-Length: 01234567890123456789\r\n")
+		sizeof("Content-Length: 01234567890123456789\r\n") + ETAG_HEADER_SIZE
 #define CONTENT_ENCODING_HEADER_SIZE                                                               \
 	sizeof(CONTENT_ENCODING_HEADER) + HTTP_COMPRESSION_MAX_STRING_LEN + sizeof("\r\n")
 #define STATIC_FS_RESPONSE_SIZE                                                                    \
@@ -497,6 +517,8 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	char http_response[STATIC_FS_RESPONSE_SIZE];
+	char etag_header[ETAG_HEADER_SIZE] = "";
+	const struct http_server_fs_cache_entry *cache_entry = NULL;
 
 	if (client->method != HTTP_GET) {
 		return send_http1_405(client);
@@ -525,13 +547,30 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		LOG_ERR("fs_stat %s: %d", fname, ret);
 		return send_http1_404(client);
 	}
-	fs_file_t_init(&file);
-	ret = fs_open(&file, fname, FS_O_READ);
-	if (ret < 0) {
-		LOG_ERR("fs_open %s: %d", fname, ret);
-		if (ret < 0) {
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	cache_entry = http_server_fs_cache_get(fname, file_size);
+	if (cache_entry != NULL) {
+		if (client->if_none_match_set && client->if_none_match == cache_entry->etag) {
+			ret = send_http1_304(client, cache_entry->etag);
+			http_server_fs_cache_put(cache_entry);
 			return ret;
 		}
+
+		snprintk(etag_header, sizeof(etag_header), ETAG_HEADER HTTP_SERVER_ETAG_FMT,
+			 cache_entry->etag);
+	}
+#endif
+
+	if (cache_entry == NULL) {
+		fs_file_t_init(&file);
+		ret = fs_open(&file, fname, FS_O_READ);
+		if (ret < 0) {
+			LOG_ERR("fs_open %s: %d", fname, ret);
+			if (ret < 0) {
+				return ret;
+			}
+		}
 	}
 
 	LOG_DBG("found %s, file size: %zu", fname, file_size);
@@ -541,10 +580,10 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	    http_compression_text(chosen_compression)[0] != 0) {
 		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
 			       file_size, content_type, CONTENT_ENCODING_HEADER,
-			       http_compression_text(chosen_compression));
+			       http_compression_text(chosen_compression), etag_header);
 	} else {
 		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
-			       file_size, content_type, "", "");
+			       file_size, content_type, "", "", etag_header);
 	}
 	ret = http_server_sendall(client, http_response, len);
 	if (ret < 0) {
@@ -553,6 +592,19 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 
 	client->http1_headers_sent = true;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	if (cache_entry != NULL) {
+		/* send the cached file directly, without an intermediate copy */
+		ret = http_server_sendall(client, cache_entry->data, cache_entry->len);
+		if (ret < 0) {
+			goto close;
+		}
+
+		ret = http_server_sendall(client, "\r\n\r\n", 4);
+		goto close;
+	}
+#endif
+
 	/* read and send file */
 	remaining = file_size;
 	while (remaining > 0) {
@@ -571,6 +623,13 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	ret = http_server_sendall(client, "\r\n\r\n", 4);
 
 close:
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	if (cache_entry != NULL) {
+		http_server_fs_cache_put(cache_entry);
+		return ret;
+	}
+#endif
+
 	/* close file */
 	fs_close(&file);
 
@@ -595,7 +654,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_acquire_dynamic(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -604,8 +663,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -724,6 +781,11 @@ static int on_header_field(struct http_parser *parser, const char *at,
 				ctx->accept_encoding_next = true;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+			else if (strcasecmp(ctx->header_buffer, "If-None-Match") == 0) {
+				ctx->if_none_match_next = true;
+			}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -816,6 +878,13 @@ static int on_header_value(struct http_parser *parser,
 				ctx->accept_encoding_next = false;
 			}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+			if (ctx->if_none_match_next) {
+				ctx->if_none_match_set = http_server_fs_cache_parse_etag(
+					ctx->header_buffer, offset, &ctx->if_none_match);
+				ctx->if_none_match_next = false;
+			}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 			ctx->header_buffer[0] = '\0';
 		}
@@ -896,6 +965,11 @@ int enter_http1_request(struct http_client_ctx *client)
 	client->parser_state = HTTP1_INIT_HEADER_STATE;
 	client->http1_headers_sent = false;
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	client->if_none_match_next = false;
+	client->if_none_match_set = false;
+#endif
+
 	if (IS_ENABLED(CONFIG_HTTP_SERVER_CAPTURE_HEADERS)) {
 		client->header_capture_ctx.store_next_value = false;
 	}
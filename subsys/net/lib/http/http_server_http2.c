@@ -23,6 +23,9 @@ LOG_MODULE_DECLARE(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 
 #include "headers/server_internal.h"
 
+/* Initial SETTINGS_MAX_FRAME_SIZE value, RFC 9113 section 6.5.2 */
+#define HTTP2_DEFAULT_MAX_FRAME_SIZE 16384
+
 static const char content_404[] = {
 #ifdef INCLUDE_HTML_CONTENT
 #include "not_found_page.html.gz.inc"
@@ -262,7 +265,8 @@ int send_settings_frame(struct http_client_ctx *client, bool ack)
 			(settings_frame + HTTP2_FRAME_HEADER_SIZE);
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_HEADER_TABLE_SIZE),
 			      &setting->id);
-		UNALIGNED_PUT(0, &setting->value);
+		UNALIGNED_PUT(htonl(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE),
+			      &setting->value);
 
 		setting++;
 		UNALIGNED_PUT(htons(HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS),
@@ -470,6 +474,14 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	int len;
 	int remaining;
 	char tmp[64];
+	const struct http_server_fs_cache_entry *cache_entry = NULL;
+	struct http_header etag_header = {
+		.name = "etag",
+		.value = NULL,
+	};
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	char etag[HTTP_SERVER_ETAG_LEN];
+#endif
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
@@ -508,12 +520,36 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		}
 		return ret;
 	}
-	fs_file_t_init(&file);
-	ret = fs_open(&file, fname, FS_O_READ);
-	if (ret < 0) {
-		LOG_ERR("fs_open %s: %d", fname, ret);
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	cache_entry = http_server_fs_cache_get(fname, client->data_len);
+	if (cache_entry != NULL) {
+		snprintk(etag, sizeof(etag), HTTP_SERVER_ETAG_FMT, cache_entry->etag);
+		etag_header.value = etag;
+
+		if (client->if_none_match_set && client->if_none_match == cache_entry->etag) {
+			ret = send_headers_frame(client, HTTP_304_NOT_MODIFIED,
+						 frame->stream_identifier, NULL,
+						 HTTP2_FLAG_END_STREAM, &etag_header, 1);
+			if (ret < 0) {
+				LOG_DBG("Cannot write to socket (%d)", ret);
+			} else {
+				client->current_stream->end_stream_sent = true;
+			}
+
+			goto out;
+		}
+	}
+#endif
+
+	if (cache_entry == NULL) {
+		fs_file_t_init(&file);
+		ret = fs_open(&file, fname, FS_O_READ);
 		if (ret < 0) {
-			return ret;
+			LOG_ERR("fs_open %s: %d", fname, ret);
+			if (ret < 0) {
+				return ret;
+			}
 		}
 	}
 
@@ -522,12 +558,37 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		res_detail.content_encoding = http_compression_text(chosen_compression);
 	}
 	ret = send_headers_frame(client, HTTP_200_OK, frame->stream_identifier, &res_detail, 0,
-				 NULL, 0);
+				 &etag_header, etag_header.value != NULL ? 1 : 0);
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
 		goto out;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	if (cache_entry != NULL) {
+		/* send the cached file directly, without an intermediate copy */
+		const uint8_t *data = cache_entry->data;
+
+		remaining = cache_entry->len;
+		do {
+			len = MIN(remaining, HTTP2_DEFAULT_MAX_FRAME_SIZE);
+			remaining -= len;
+
+			ret = send_data_frame(client, (const char *)data, len, frame->stream_identifier,
+					      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
+			if (ret < 0) {
+				LOG_DBG("Cannot write to socket (%d)", ret);
+				goto out;
+			}
+
+			data += len;
+		} while (remaining > 0);
+
+		client->current_stream->end_stream_sent = true;
+		goto out;
+	}
+#endif
+
 	/* read and send file */
 	remaining = client->data_len;
 	while (remaining > 0) {
@@ -549,6 +610,13 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 	client->current_stream->end_stream_sent = true;
 
 out:
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	if (cache_entry != NULL) {
+		http_server_fs_cache_put(cache_entry);
+		return ret;
+	}
+#endif
+
 	/* close file */
 	fs_close(&file);
 
@@ -782,7 +850,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_acquire_dynamic(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +859,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -934,6 +1000,10 @@ static int enter_http_frame_headers_state(struct http_client_ctx *client)
 		client->header_capture_ctx.current_stream = stream;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	client->if_none_match_set = false;
+#endif
+
 	client->server_state = HTTP_SERVER_FRAME_HEADERS_STATE;
 
 	return 0;
@@ -1405,6 +1475,13 @@ static int process_header(struct http_client_ctx *client,
 						       &client->supported_compression);
 	}
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
+#ifdef CONFIG_HTTP_SERVER_STATIC_FS_CACHE
+	else if (header->name_len == (sizeof("if-none-match") - 1) &&
+		 memcmp(header->name, "if-none-match", header->name_len) == 0) {
+		client->if_none_match_set = http_server_fs_cache_parse_etag(
+			header->value, header->value_len, &client->if_none_match);
+	}
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 	else {
 		/* Just ignore for now. */
 		LOG_DBG("Ignoring field %.*s", (int)header->name_len, header->name);
@@ -3180,8 +3180,19 @@ msg_init:
 	/* set the output writer */
 	select_writer(&msg->out, obs->format);
 	if (obs->composite) {
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+		sys_slist_t unchanged;
+		uint32_t dirty_paths;
+
+		/* Leave out the paths which have not been updated */
+		dirty_paths = lwm2m_observe_split_unchanged(obs, &unchanged);
+		/* Use do send which actually do Composite read operation */
+		ret = do_send_op(msg, obs->format, &obs->path_list);
+		lwm2m_observe_merge_unchanged(obs, &unchanged, dirty_paths);
+#else
 		/* Use do send which actually do Composite read operation */
 		ret = do_send_op(msg, obs->format, &obs->path_list);
+#endif
 	} else {
 		ret = do_read_op(msg, obs->format);
 	}
@@ -3199,6 +3210,9 @@ msg_init:
 
 	obs->active_notify = msg;
 	obs->resource_update = false;
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+	obs->dirty_paths = 0;
+#endif
 	lwm2m_information_interface_send(msg);
 #if defined(CONFIG_LWM2M_RESOURCE_DATA_CACHE_SUPPORT)
 	msg->cache_info = NULL;
@@ -203,6 +203,74 @@ static bool lwm2m_notify_observer_list(sys_slist_t *path_list, const struct lwm2
 	return false;
 }
 
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+/* Paths past the last bit share it and are always notified */
+#define DIRTY_PATH_BIT(idx) BIT(MIN(idx, 31))
+
+static void lwm2m_notify_observer_mark_dirty(struct observe_node *obs,
+					     const struct lwm2m_obj_path *path)
+{
+	struct lwm2m_obj_path_list *o_p;
+	int idx = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&obs->path_list, o_p, node) {
+		if (lwm2m_observer_path_compare(&o_p->path, path)) {
+			obs->dirty_paths |= DIRTY_PATH_BIT(idx);
+		}
+		idx++;
+	}
+}
+
+static bool lwm2m_observe_path_unchanged(uint32_t dirty_paths, int idx)
+{
+	return idx < 31 && !(dirty_paths & DIRTY_PATH_BIT(idx));
+}
+
+uint32_t lwm2m_observe_split_unchanged(struct observe_node *obs, sys_slist_t *unchanged)
+{
+	uint32_t dirty_paths = obs->dirty_paths;
+	sys_snode_t *node, *next, *prev = NULL;
+	int idx = 0;
+
+	sys_slist_init(unchanged);
+
+	if (!obs->resource_update || !dirty_paths) {
+		return 0;
+	}
+
+	SYS_SLIST_FOR_EACH_NODE_SAFE(&obs->path_list, node, next) {
+		if (lwm2m_observe_path_unchanged(dirty_paths, idx)) {
+			sys_slist_remove(&obs->path_list, prev, node);
+			sys_slist_append(unchanged, node);
+		} else {
+			prev = node;
+		}
+		idx++;
+	}
+
+	return dirty_paths;
+}
+
+void lwm2m_observe_merge_unchanged(struct observe_node *obs, sys_slist_t *unchanged,
+				   uint32_t dirty_paths)
+{
+	sys_slist_t changed = obs->path_list;
+	sys_slist_t *from;
+
+	if (sys_slist_is_empty(unchanged)) {
+		return;
+	}
+
+	sys_slist_init(&obs->path_list);
+
+	for (int idx = 0; !sys_slist_is_empty(&changed) || !sys_slist_is_empty(unchanged);
+	     idx++) {
+		from = lwm2m_observe_path_unchanged(dirty_paths, idx) ? unchanged : &changed;
+		sys_slist_append(&obs->path_list, sys_slist_get_not_empty(from));
+	}
+}
+#endif
+
 int lwm2m_notify_observer(uint16_t obj_id, uint16_t obj_inst_id, uint16_t res_id)
 {
 	struct lwm2m_obj_path path;
@@ -368,6 +436,11 @@ int lwm2m_notify_observer_path(const struct lwm2m_obj_path *path)
 	for (i = 0; i < lwm2m_sock_nfds(); ++i) {
 		SYS_SLIST_FOR_EACH_CONTAINER(&sock_ctx[i]->observer, obs, node) {
 			if (lwm2m_notify_observer_list(&obs->path_list, path)) {
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+				if (obs->composite) {
+					lwm2m_notify_observer_mark_dirty(obs, path);
+				}
+#endif
 				/* update the event time for this observer */
 				ret = engine_observe_attribute_list_get(&obs->path_list, &nattrs,
 									sock_ctx[i]->srv_obj_inst);
@@ -456,6 +529,9 @@ static void engine_observe_node_init(struct observe_node *obs, const uint8_t *to
 		obs->event_timestamp = 0;
 	}
 	obs->resource_update = false;
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+	obs->dirty_paths = 0;
+#endif
 	obs->active_notify = NULL;
 	obs->format = format;
 	obs->counter = OBSERVE_COUNTER_START;
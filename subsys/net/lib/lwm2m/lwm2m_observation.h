@@ -24,6 +24,9 @@ struct observe_node {
 	uint8_t tkl;
 	bool resource_update : 1;            /* Resource is updated */
 	bool composite : 1;                  /* Composite Observation */
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+	uint32_t dirty_paths;                /* Paths updated since last Notify */
+#endif
 };
 /* Attribute handling. */
 
@@ -45,6 +48,22 @@ struct observe_node *engine_observe_node_discover(sys_slist_t *observe_node_list
 						  sys_slist_t *lwm2m_path_list,
 						  const uint8_t *token, uint8_t tkl);
 
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+/**
+ * Move the paths of a composite observation which have not been updated
+ * since the last notification to @p unchanged, so that only the updated
+ * ones are read. Nothing is moved unless the notification is triggered by
+ * a resource update. Returns the updated paths bitmap the split is based on.
+ */
+uint32_t lwm2m_observe_split_unchanged(struct observe_node *obs, sys_slist_t *unchanged);
+/**
+ * Put back the paths moved out by @ref lwm2m_observe_split_unchanged,
+ * restoring the original order of the path list.
+ */
+void lwm2m_observe_merge_unchanged(struct observe_node *obs, sys_slist_t *unchanged,
+				   uint32_t dirty_paths);
+#endif
+
 int engine_remove_observer_by_token(struct lwm2m_ctx *ctx, const uint8_t *token, uint8_t tkl);
 
 int lwm2m_write_attr_handler(struct lwm2m_engine_obj *obj, struct lwm2m_message *msg);
@@ -29,32 +29,34 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
 #include "lwm2m_object.h"
 #include "lwm2m_rw_senml_cbor.h"
 #include "lwm2m_senml_cbor_decode.h"
-#include "lwm2m_senml_cbor_encode.h"
 #include "lwm2m_senml_cbor_types.h"
 #include "lwm2m_util.h"
 
 #define SENML_MAX_NAME_SIZE sizeof("/65535/65535/")
 
+/* Upper limit of the record count, used to reserve room for the array header */
+#define SENML_CBOR_MAX_RECORDS UINT16_MAX
+/* bn, bt, n, t and the value */
+#define SENML_CBOR_MAX_RECORD_FIELDS 5
+
 struct cbor_out_fmt_data {
-	/* Data */
-	struct lwm2m_senml input;
+	/* Record being formed, encoded into the message once it gets a value */
+	struct record current;
+
+	/* Storage for the basename and name of the current record */
+	char basename[SENML_MAX_NAME_SIZE];
+	char name[SENML_MAX_NAME_SIZE];
 
-	/* Storage for basenames and names ~ sizeof("/65535/65535/") */
-	struct {
-		char names[CONFIG_LWM2M_RW_SENML_CBOR_RECORDS][SENML_MAX_NAME_SIZE];
-		size_t name_sz; /* Name buff size */
-		uint8_t name_cnt;
-	};
+	/* Storage for the object link of the current record */
+	char objlnk[sizeof("65535:65535")];
 
 	/* Basetime for Cached data timestamp */
 	time_t basetime;
 
-	/* Storage for object links */
-	struct {
-		char objlnk[CONFIG_LWM2M_RW_SENML_CBOR_RECORDS][sizeof("65535:65535")];
-		size_t objlnk_sz; /* Object link buff size */
-		uint8_t objlnk_cnt;
-	};
+	/* Encoder state of the record array, started with the first record */
+	zcbor_state_t states[4];
+	uint8_t *payload;
+	bool started;
 };
 
 struct cbor_in_fmt_data {
@@ -78,15 +80,10 @@ static int path_to_string(char *buf, size_t buf_size, const struct lwm2m_obj_pat
  */
 K_MUTEX_DEFINE(fd_mtx);
 
-#define GET_CBOR_FD_NAME(fd) ((fd)->names[(fd)->name_cnt])
 /* Get the current record */
-#define GET_CBOR_FD_REC(fd) \
-	&((fd)->input.lwm2m_senml_record_m[(fd)->input.lwm2m_senml_record_m_count])
+#define GET_CBOR_FD_REC(fd) (&(fd)->current)
 /* Get a record */
 #define GET_IN_FD_REC_I(fd, i) &((fd)->dcd.lwm2m_senml_record_m[i])
-/* Consume the current record */
-#define CONSUME_CBOR_FD_REC(fd) \
-	&((fd)->input.lwm2m_senml_record_m[(fd)->input.lwm2m_senml_record_m_count++])
 /* Get CBOR output formatter data */
 #define LWM2M_OFD_CBOR(octx) ((struct cbor_out_fmt_data *)engine_get_out_user_data(octx))
 
@@ -98,9 +95,7 @@ static void setup_out_fmt_data(struct lwm2m_message *msg)
 
 	(void)memset(fd, 0, sizeof(*fd));
 	engine_set_out_user_data(&msg->out, fd);
-	fd->name_sz = SENML_MAX_NAME_SIZE;
 	fd->basetime = 0;
-	fd->objlnk_sz = sizeof("65535:65535");
 }
 
 static void clear_out_fmt_data(struct lwm2m_message *msg)
@@ -127,12 +122,86 @@ static void clear_in_fmt_data(struct lwm2m_message *msg)
 	k_mutex_unlock(&fd_mtx);
 }
 
-static int fmt_range_check(struct cbor_out_fmt_data *fd)
+static bool encode_record_value(zcbor_state_t *state, const struct record_union_r *value)
 {
-	if (fd->name_cnt >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
-	    fd->objlnk_cnt >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS ||
-	    fd->input.lwm2m_senml_record_m_count >= CONFIG_LWM2M_RW_SENML_CBOR_RECORDS) {
-		LOG_ERR("CONFIG_LWM2M_RW_SENML_CBOR_RECORDS too small");
+	switch (value->record_union_choice) {
+	case union_vi_c:
+		return zcbor_uint32_put(state, lwm2m_senml_cbor_key_vi) &&
+		       zcbor_int64_encode(state, &value->union_vi);
+	case union_vf_c:
+		return zcbor_uint32_put(state, lwm2m_senml_cbor_key_vf) &&
+		       zcbor_float64_encode(state, &value->union_vf);
+	case union_vs_c:
+		return zcbor_uint32_put(state, lwm2m_senml_cbor_key_vs) &&
+		       zcbor_tstr_encode(state, &value->union_vs);
+	case union_vb_c:
+		return zcbor_uint32_put(state, lwm2m_senml_cbor_key_vb) &&
+		       zcbor_bool_encode(state, &value->union_vb);
+	case union_vd_c:
+		return zcbor_uint32_put(state, lwm2m_senml_cbor_key_vd) &&
+		       zcbor_bstr_encode(state, &value->union_vd);
+	case union_vlo_c:
+		return zcbor_tstr_put_lit(state, "vlo") &&
+		       zcbor_tstr_encode(state, &value->union_vlo);
+	default:
+		return false;
+	}
+}
+
+/* Encode the current record straight into the message, with the same layout
+ * as the generated encoder, and start over with an empty one.
+ */
+static int consume_record(struct lwm2m_output_context *out)
+{
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
+	struct record *record = GET_CBOR_FD_REC(fd);
+	zcbor_state_t *state = fd->states;
+	bool ok;
+
+	if (!fd->started) {
+		fd->payload = CPKT_BUF_W_PTR(out->out_cpkt);
+		zcbor_new_encode_state(fd->states, ARRAY_SIZE(fd->states),
+				       CPKT_BUF_W_REGION(out->out_cpkt), 1);
+
+		if (!zcbor_list_start_encode(state, SENML_CBOR_MAX_RECORDS)) {
+			return -ENOMEM;
+		}
+
+		fd->started = true;
+	}
+
+	ok = zcbor_map_start_encode(state, SENML_CBOR_MAX_RECORD_FIELDS);
+
+	if (ok && record->record_bn_present) {
+		ok = zcbor_int32_put(state, lwm2m_senml_cbor_key_bn) &&
+		     zcbor_tstr_encode(state, &record->record_bn.record_bn);
+	}
+
+	if (ok && record->record_bt_present) {
+		ok = zcbor_int32_put(state, lwm2m_senml_cbor_key_bt) &&
+		     zcbor_int64_encode(state, &record->record_bt.record_bt);
+	}
+
+	if (ok && record->record_n_present) {
+		ok = zcbor_uint32_put(state, lwm2m_senml_cbor_key_n) &&
+		     zcbor_tstr_encode(state, &record->record_n.record_n);
+	}
+
+	if (ok && record->record_t_present) {
+		ok = zcbor_uint32_put(state, lwm2m_senml_cbor_key_t) &&
+		     zcbor_int64_encode(state, &record->record_t.record_t);
+	}
+
+	if (ok && record->record_union_present) {
+		ok = encode_record_value(state, &record->record_union);
+	}
+
+	ok = ok && zcbor_map_end_encode(state, SENML_CBOR_MAX_RECORD_FIELDS);
+
+	(void)memset(record, 0, sizeof(*record));
+
+	if (!ok) {
+		LOG_DBG("record does not fit in the message");
 		return -ENOMEM;
 	}
 
@@ -143,16 +212,9 @@ static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 	int len;
-	int ret;
 
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
-
-	char *basename = GET_CBOR_FD_NAME(fd);
-
-	len = path_to_string(basename, fd->name_sz, path, LWM2M_PATH_LEVEL_OBJECT_INST);
+	len = path_to_string(fd->basename, sizeof(fd->basename), path,
+			     LWM2M_PATH_LEVEL_OBJECT_INST);
 
 	if (len < 0) {
 		return len;
@@ -161,7 +223,7 @@ static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path
 	/* Tell CBOR encoder where to find the name */
 	struct record *record = GET_CBOR_FD_REC(fd);
 
-	record->record_bn.record_bn.value = basename;
+	record->record_bn.record_bn.value = fd->basename;
 	record->record_bn.record_bn.len = len;
 	record->record_bn_present = 1;
 
@@ -170,8 +232,6 @@ static int put_basename(struct lwm2m_output_context *out, struct lwm2m_obj_path
 		return -EINVAL;
 	}
 
-	fd->name_cnt++;
-
 	return 0;
 }
 
@@ -187,24 +247,23 @@ static int put_empty_array(struct lwm2m_output_context *out)
 
 static int put_end(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
+	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 	size_t len;
-	struct lwm2m_senml *input = &(LWM2M_OFD_CBOR(out)->input);
 
-	if (!input->lwm2m_senml_record_m_count) {
+	if (!fd->started) {
 		len = put_empty_array(out);
 
 		return len;
 	}
 
-	uint_fast8_t ret =
-		cbor_encode_lwm2m_senml(CPKT_BUF_W_REGION(out->out_cpkt), input, &len);
-
-	if (ret != ZCBOR_SUCCESS) {
+	/* Shrinks the array header to the actual record count */
+	if (!zcbor_list_end_encode(fd->states, SENML_CBOR_MAX_RECORDS)) {
 		LOG_ERR("unable to encode senml cbor msg");
 
 		return -E2BIG;
 	}
 
+	len = fd->states[0].payload - fd->payload;
 	out->out_cpkt->offset += len;
 
 	return len;
@@ -228,47 +287,22 @@ static int put_begin_r(struct lwm2m_output_context *out, struct lwm2m_obj_path *
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 	int len;
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
-
-	char *name = GET_CBOR_FD_NAME(fd);
 
 	/* Write resource name */
-	len = snprintk(name, sizeof("65535"), "%" PRIu16 "", path->res_id);
+	len = snprintk(fd->name, sizeof("65535"), "%" PRIu16 "", path->res_id);
 
 	if (len < sizeof("0") - 1) {
 		__ASSERT_NO_MSG(false);
 		return -EINVAL;
 	}
 
-	/* Check if we could use an already existing name
-	 * -> latest name slot is used as a scratchpad
-	 */
-	for (int idx = 0; idx < fd->name_cnt; idx++) {
-		if (strncmp(name, fd->names[idx], len) == 0) {
-			name = fd->names[idx];
-			break;
-		}
-	}
-
 	/* Tell CBOR encoder where to find the name */
 	struct record *record = GET_CBOR_FD_REC(fd);
 
-	record->record_n.record_n.value = name;
+	record->record_n.record_n.value = fd->name;
 	record->record_n.record_n.len = len;
 	record->record_n_present = 1;
 
-	/* Makes possible to use same slot for storing r/ri name combination.
-	 * No need to increase the name count if an existing name has been used
-	 */
-	if (path->level < LWM2M_PATH_LEVEL_RESOURCE_INST && name == GET_CBOR_FD_NAME(fd)) {
-		fd->name_cnt++;
-	}
-
 	return 0;
 }
 
@@ -276,12 +310,6 @@ static int put_data_timestamp(struct lwm2m_output_context *out, time_t value)
 {
 	struct record *out_record;
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
 
 	/* Tell CBOR encoder where to find the name */
 	out_record = GET_CBOR_FD_REC(fd);
@@ -302,17 +330,10 @@ static int put_data_timestamp(struct lwm2m_output_context *out, time_t value)
 static int put_begin_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path *path)
 {
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
-	char *name = GET_CBOR_FD_NAME(fd);
 	struct record *record = GET_CBOR_FD_REC(fd);
-	int ret;
-
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
 
 	/* Forms name from resource id and resource instance id */
-	int len = snprintk(name, SENML_MAX_NAME_SIZE,
+	int len = snprintk(fd->name, SENML_MAX_NAME_SIZE,
 			   "%" PRIu16 "/%" PRIu16 "",
 			   path->res_id, path->res_inst_id);
 
@@ -321,26 +342,11 @@ static int put_begin_ri(struct lwm2m_output_context *out, struct lwm2m_obj_path
 		return -EINVAL;
 	}
 
-	/* Check if we could use an already existing name
-	 * -> latest name slot is used as a scratchpad
-	 */
-	for (int idx = 0; idx < fd->name_cnt; idx++) {
-		if (strncmp(name, fd->names[idx], len) == 0) {
-			name = fd->names[idx];
-			break;
-		}
-	}
-
 	/* Tell CBOR encoder where to find the name */
-	record->record_n.record_n.value = name;
+	record->record_n.record_n.value = fd->name;
 	record->record_n.record_n.len = len;
 	record->record_n_present = 1;
 
-	/* No need to increase the name count if an existing name has been used */
-	if (name == GET_CBOR_FD_NAME(fd)) {
-		fd->name_cnt++;
-	}
-
 	return 0;
 }
 
@@ -369,14 +375,14 @@ static int put_value(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vi_c;
 	record->record_union.union_vi = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_s8(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, int8_t value)
@@ -407,14 +413,14 @@ static int put_time(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vi_c;
 	record->record_union.union_vi = (int64_t)value;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, double *value)
@@ -425,14 +431,14 @@ static int put_float(struct lwm2m_output_context *out, struct lwm2m_obj_path *pa
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vf_c;
 	record->record_union.union_vf = *value;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -444,7 +450,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vs_c;
@@ -452,7 +458,7 @@ static int put_string(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vs.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, bool value)
@@ -463,14 +469,14 @@ static int put_bool(struct lwm2m_output_context *out, struct lwm2m_obj_path *pat
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vb_c;
 	record->record_union.union_vb = value;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *path, char *buf,
@@ -482,7 +488,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vd_c;
@@ -490,7 +496,7 @@ static int put_opaque(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	record->record_union.union_vd.len = buflen;
 	record->record_union_present = 1;
 
-	return 0;
+	return consume_record(out);
 }
 
 static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *path,
@@ -499,16 +505,9 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 	int ret = 0;
 	struct cbor_out_fmt_data *fd = LWM2M_OFD_CBOR(out);
 
-	ret = fmt_range_check(fd);
-	if (ret < 0) {
-		return ret;
-	}
-
 	/* Format object link */
-	int objlnk_idx = fd->objlnk_cnt;
-	char *objlink_buf = fd->objlnk[objlnk_idx];
-	int objlnk_len =
-		snprintk(objlink_buf, fd->objlnk_sz, "%u:%u", value->obj_id, value->obj_inst);
+	int objlnk_len = snprintk(fd->objlnk, sizeof(fd->objlnk), "%u:%u", value->obj_id,
+				  value->obj_inst);
 	if (objlnk_len < 0) {
 		return -EINVAL;
 	}
@@ -519,17 +518,15 @@ static int put_objlnk(struct lwm2m_output_context *out, struct lwm2m_obj_path *p
 		return ret;
 	}
 
-	struct record *record = CONSUME_CBOR_FD_REC(LWM2M_OFD_CBOR(out));
+	struct record *record = GET_CBOR_FD_REC(fd);
 
 	/* Write the value */
 	record->record_union.record_union_choice = union_vlo_c;
-	record->record_union.union_vlo.value = objlink_buf;
+	record->record_union.union_vlo.value = fd->objlnk;
 	record->record_union.union_vlo.len = objlnk_len;
 	record->record_union_present = 1;
 
-	fd->objlnk_cnt++;
-
-	return 0;
+	return consume_record(out);
 }
 
 static int get_opaque(struct lwm2m_input_context *in,
@@ -18,6 +18,78 @@ LOG_MODULE_REGISTER(net_mqtt, CONFIG_MQTT_LOG_LEVEL);
 #include "mqtt_internal.h"
 #include "mqtt_os.h"
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+/* Packet identifiers are usually allocated sequentially, so they are used as
+ * their own hash: consecutive identifiers land in consecutive slots. The table
+ * is at least twice as large as the window, so a free slot always exists.
+ */
+static size_t inflight_slot(const struct mqtt_client *client, uint16_t message_id)
+{
+	const size_t mask = ARRAY_SIZE(client->internal.inflight_ids) - 1;
+	size_t i = message_id & mask;
+
+	while (client->internal.inflight_ids[i] != 0U &&
+	       client->internal.inflight_ids[i] != message_id) {
+		i = (i + 1) & mask;
+	}
+
+	return i;
+}
+
+static int inflight_add(struct mqtt_client *client,
+			const struct mqtt_publish_param *param)
+{
+	size_t i;
+
+	if (param->message.topic.qos == MQTT_QOS_0_AT_MOST_ONCE) {
+		return 0;
+	}
+
+	i = inflight_slot(client, param->message_id);
+	if (client->internal.inflight_ids[i] == param->message_id) {
+		/* Retransmission of a message already in flight. */
+		return 0;
+	}
+
+	if (client->internal.inflight_count >= CONFIG_MQTT_INFLIGHT_MAX) {
+		return -EAGAIN;
+	}
+
+	client->internal.inflight_ids[i] = param->message_id;
+	client->internal.inflight_count++;
+
+	return 0;
+}
+
+void mqtt_inflight_remove(struct mqtt_client *client, uint16_t message_id)
+{
+	const size_t mask = ARRAY_SIZE(client->internal.inflight_ids) - 1;
+	uint16_t *ids = client->internal.inflight_ids;
+	size_t i, j, home;
+
+	i = inflight_slot(client, message_id);
+	if (ids[i] == 0U) {
+		return;
+	}
+
+	client->internal.inflight_count--;
+
+	/* Move the following entries of the cluster back into the hole, so
+	 * that lookups never need to skip deleted slots.
+	 */
+	for (j = (i + 1) & mask; ids[j] != 0U; j = (j + 1) & mask) {
+		home = ids[j] & mask;
+
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			ids[i] = ids[j];
+			i = j;
+		}
+	}
+
+	ids[i] = 0U;
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 static void client_reset(struct mqtt_client *client)
 {
 	MQTT_STATE_INIT(client);
@@ -25,6 +97,12 @@ static void client_reset(struct mqtt_client *client)
 	client->internal.last_activity = 0U;
 	client->internal.rx_buf_datalen = 0U;
 	client->internal.remaining_payload = 0U;
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+	memset(client->internal.inflight_ids, 0,
+	       sizeof(client->internal.inflight_ids));
+	client->internal.inflight_count = 0U;
+#endif
 }
 
 /** @brief Initialize tx buffer. */
@@ -293,6 +371,35 @@ static int verify_tx_state(const struct mqtt_client *client)
 	return 0;
 }
 
+/* Encode a PUBLISH packet at the current position of the buffer and point
+ * the two I/O vectors at its header and payload.
+ */
+static int publish_prepare(struct mqtt_client *client,
+			   const struct mqtt_publish_param *param,
+			   struct buf_ctx *packet, struct iovec *io_vector)
+{
+	int err_code;
+
+	err_code = publish_encode(client, param, packet);
+	if (err_code < 0) {
+		return err_code;
+	}
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+	err_code = inflight_add(client, param);
+	if (err_code < 0) {
+		return err_code;
+	}
+#endif
+
+	io_vector[0].iov_base = packet->cur;
+	io_vector[0].iov_len = packet->end - packet->cur;
+	io_vector[1].iov_base = param->message.payload.data;
+	io_vector[1].iov_len = param->message.payload.len;
+
+	return 0;
+}
+
 int mqtt_publish(struct mqtt_client *client,
 		 const struct mqtt_publish_param *param)
 {
@@ -318,16 +425,11 @@ int mqtt_publish(struct mqtt_client *client,
 		goto error;
 	}
 
-	err_code = publish_encode(client, param, &packet);
+	err_code = publish_prepare(client, param, &packet, io_vector);
 	if (err_code < 0) {
 		goto error;
 	}
 
-	io_vector[0].iov_base = packet.cur;
-	io_vector[0].iov_len = packet.end - packet.cur;
-	io_vector[1].iov_base = param->message.payload.data;
-	io_vector[1].iov_len = param->message.payload.len;
-
 	memset(&msg, 0, sizeof(msg));
 
 	msg.msg_iov = io_vector;
@@ -344,6 +446,83 @@ error:
 	return err_code;
 }
 
+int mqtt_publish_batch(struct mqtt_client *client,
+		       const struct mqtt_publish_param *params,
+		       size_t count)
+{
+	int err_code;
+	struct buf_ctx packet;
+	struct iovec io_vector[2 * CONFIG_MQTT_PUBLISH_BATCH_MAX];
+	struct msghdr msg;
+	uint8_t *end;
+	size_t sent = 0;
+
+	NULL_PARAM_CHECK(client);
+	NULL_PARAM_CHECK(params);
+
+	if (count == 0) {
+		return -EINVAL;
+	}
+
+	count = MIN(count, CONFIG_MQTT_PUBLISH_BATCH_MAX);
+
+	NET_DBG("[CID %p]:[State 0x%02x]: >> %zu messages",
+		 client, client->internal.state, count);
+
+	mqtt_mutex_lock(client);
+
+	tx_buf_init(client, &packet);
+	end = packet.end;
+
+	err_code = verify_tx_state(client);
+	if (err_code < 0) {
+		goto error;
+	}
+
+	/* Headers are encoded one after the other in the TX buffer, payloads
+	 * are sent from the application buffers.
+	 */
+	while (sent < count) {
+		if (end - packet.cur < MQTT_FIXED_HEADER_MAX_SIZE) {
+			err_code = -ENOMEM;
+			break;
+		}
+
+		err_code = publish_prepare(client, &params[sent], &packet,
+					   &io_vector[2 * sent]);
+		if (err_code < 0) {
+			break;
+		}
+
+		sent++;
+
+		packet.cur = packet.end;
+		packet.end = end;
+	}
+
+	if (sent == 0) {
+		goto error;
+	}
+
+	memset(&msg, 0, sizeof(msg));
+
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2 * sent;
+
+	err_code = client_write_msg(client, &msg);
+	if (err_code == 0) {
+		err_code = sent;
+	}
+
+error:
+	NET_DBG("[CID %p]:[State 0x%02x]: << result 0x%08x",
+			 client, client->internal.state, err_code);
+
+	mqtt_mutex_unlock(client);
+
+	return err_code;
+}
+
 int mqtt_publish_qos1_ack(struct mqtt_client *client,
 			  const struct mqtt_puback_param *param)
 {
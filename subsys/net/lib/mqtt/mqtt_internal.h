@@ -208,6 +208,22 @@ int mqtt_handle_rx(struct mqtt_client *client);
  */
 void mqtt_client_disconnect(struct mqtt_client *client, int result, bool notify);
 
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+/**@brief Release the in-flight window slot of an acknowledged message.
+ *
+ * @param[in] client Identifies the client which received the acknowledgment.
+ * @param[in] message_id Packet identifier of the acknowledged message.
+ */
+void mqtt_inflight_remove(struct mqtt_client *client, uint16_t message_id);
+#else
+static inline void mqtt_inflight_remove(struct mqtt_client *client,
+					uint16_t message_id)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(message_id);
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 /**@brief Constructs/encodes Connect packet.
  *
  * @param[in] client Identifies the client for which the procedure is requested.
@@ -38,6 +38,11 @@ int prometheus_collector_register_metric(struct prometheus_collector *collector,
 	/* Node cannot be added to list twice */
 	(void)sys_slist_find_and_remove(&collector->metrics, &metric->node);
 
+#if defined(CONFIG_PROMETHEUS_LABEL_CACHE)
+	/* Labels may have changed, render them again on next scrape */
+	metric->cache_len = 0;
+#endif
+
 	sys_slist_prepend(&collector->metrics, &metric->node);
 
 	k_mutex_unlock(&collector->lock);
@@ -24,133 +24,221 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pm_formatter, CONFIG_PROMETHEUS_LOG_LEVEL);
 
-static int write_metric_to_buffer(char *buffer, size_t buffer_size, const char *format, ...)
+/* Append formatted text at *len, keeping the buffer NUL terminated */
+static int write_metric_to_buffer(char *buffer, size_t buffer_size, size_t *len,
+				  const char *format, ...)
 {
-	/* helper function to write formatted metric to buffer */
 	va_list args;
-	size_t len = strlen(buffer);
+	int ret;
 
-	if (len >= buffer_size) {
+	if (*len >= buffer_size) {
 		return -ENOMEM;
 	}
-	buffer += len;
-	buffer_size -= len;
 
 	va_start(args, format);
-	len = vsnprintf(buffer, buffer_size, format, args);
+	ret = vsnprintf(buffer + *len, buffer_size - *len, format, args);
 	va_end(args);
-	if (len >= buffer_size) {
+	if (ret < 0 || (size_t)ret >= buffer_size - *len) {
+		buffer[*len] = '\0';
 		return -ENOMEM;
 	}
 
+	*len += ret;
+
 	return 0;
 }
 
-int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
-				 size_t buffer_size, int *written)
+static int copy_to_buffer(char *buffer, size_t buffer_size, size_t *len, const char *str,
+			  size_t str_len)
 {
-	int ret = 0;
+	if (*len >= buffer_size || str_len >= buffer_size - *len) {
+		return -ENOMEM;
+	}
+
+	memcpy(buffer + *len, str, str_len);
+	*len += str_len;
+	buffer[*len] = '\0';
+
+	return 0;
+}
+
+static const char *metric_type_name(enum prometheus_metric_type type)
+{
+	switch (type) {
+	case PROMETHEUS_COUNTER:
+		return "counter";
+	case PROMETHEUS_GAUGE:
+		return "gauge";
+	case PROMETHEUS_HISTOGRAM:
+		return "histogram";
+	case PROMETHEUS_SUMMARY:
+		return "summary";
+	default:
+		return "untyped";
+	}
+}
+
+/* HELP and TYPE lines */
+static int format_header(const struct prometheus_metric *metric, char *buffer,
+			 size_t buffer_size, size_t *len)
+{
+	int ret;
 
 	/* write HELP line if available */
 	if (metric->description[0] != '\0') {
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# HELP %s %s\n", metric->name,
-					     metric->description);
+		ret = write_metric_to_buffer(buffer, buffer_size, len, "# HELP %s %s\n",
+					     metric->name, metric->description);
 		if (ret < 0) {
-			LOG_ERR("Error writing to buffer");
-			goto out;
+			return ret;
 		}
 	}
 
-	/* write TYPE line */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s counter\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing counter");
-			goto out;
-		}
+	return write_metric_to_buffer(buffer, buffer_size, len, "# TYPE %s %s\n", metric->name,
+				      metric_type_name(metric->type));
+}
 
-		break;
+/* Name and label of a counter or gauge sample, up to its value */
+static int format_sample_prefix(const struct prometheus_metric *metric, int label,
+				char *buffer, size_t buffer_size, size_t *len)
+{
+	return write_metric_to_buffer(buffer, buffer_size, len, "%s{%s=\"%s\"} ", metric->name,
+				      metric->labels[label].key, metric->labels[label].value);
+}
 
-	case PROMETHEUS_GAUGE:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s gauge\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing gauge");
-			goto out;
-		}
+static int format_sample_value(const struct prometheus_metric *metric, char *buffer,
+			       size_t buffer_size, size_t *len)
+{
+	if (metric->type == PROMETHEUS_COUNTER) {
+		const struct prometheus_counter *counter =
+			CONTAINER_OF(metric, struct prometheus_counter, base);
 
-		break;
+		return write_metric_to_buffer(buffer, buffer_size, len, "%llu\n", counter->value);
+	}
 
-	case PROMETHEUS_HISTOGRAM:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s histogram\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
+	const struct prometheus_gauge *gauge = CONTAINER_OF(metric, struct prometheus_gauge, base);
 
-		break;
+	return write_metric_to_buffer(buffer, buffer_size, len, "%f\n", gauge->value);
+}
 
-	case PROMETHEUS_SUMMARY:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s summary\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
-		}
+#if defined(CONFIG_PROMETHEUS_LABEL_CACHE)
+/* The cache holds the header lines, followed by the NUL terminated sample
+ * prefix of each label of counters and gauges.
+ */
+static void render_cache(struct prometheus_metric *metric)
+{
+	size_t len = 0;
+	int ret;
 
-		break;
+	ret = format_header(metric, metric->cache, sizeof(metric->cache), &len);
+	if (ret < 0) {
+		goto unfit;
+	}
 
-	default:
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "# TYPE %s untyped\n", metric->name);
-		if (ret < 0) {
-			LOG_ERR("Error writing untyped");
-			goto out;
+	metric->cache_header_len = len;
+
+	if (metric->type == PROMETHEUS_COUNTER || metric->type == PROMETHEUS_GAUGE) {
+		for (int i = 0; i < metric->num_labels; ++i) {
+			ret = format_sample_prefix(metric, i, metric->cache, sizeof(metric->cache),
+						   &len);
+			if (ret < 0 || len + 1 >= sizeof(metric->cache)) {
+				goto unfit;
+			}
+
+			/* Keep the terminating NUL as separator */
+			len++;
 		}
+	}
 
-		break;
+	metric->cache_len = len;
+
+	return;
+
+unfit:
+	LOG_DBG("Metric %s does not fit in the label cache", metric->name);
+	metric->cache_len = PROMETHEUS_CACHE_UNFIT;
+}
+
+static bool cache_usable(struct prometheus_metric *metric)
+{
+	if (metric->cache_len == 0) {
+		render_cache(metric);
 	}
 
-	/* write metric-specific fields */
-	switch (metric->type) {
-	case PROMETHEUS_COUNTER: {
-		const struct prometheus_counter *counter =
-			CONTAINER_OF(metric, struct prometheus_counter, base);
+	return metric->cache_len != PROMETHEUS_CACHE_UNFIT;
+}
+#endif /* CONFIG_PROMETHEUS_LABEL_CACHE */
 
-		LOG_DBG("counter->value: %llu", counter->value);
+static int write_header(struct prometheus_metric *metric, char *buffer, size_t buffer_size,
+			size_t *len)
+{
+#if defined(CONFIG_PROMETHEUS_LABEL_CACHE)
+	if (cache_usable(metric)) {
+		return copy_to_buffer(buffer, buffer_size, len, metric->cache,
+				      metric->cache_header_len);
+	}
+#endif
 
-		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %llu\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, counter->value);
-			if (ret < 0) {
-				LOG_ERR("Error writing counter");
-				goto out;
-			}
-		}
+	return format_header(metric, buffer, buffer_size, len);
+}
 
-		break;
+/* Pre-rendered sample prefixes of the metric, NULL if there are none */
+static const char *cached_prefixes(struct prometheus_metric *metric)
+{
+#if defined(CONFIG_PROMETHEUS_LABEL_CACHE)
+	if (cache_usable(metric)) {
+		return metric->cache + metric->cache_header_len;
 	}
+#else
+	ARG_UNUSED(metric);
+#endif
 
-	case PROMETHEUS_GAUGE: {
-		const struct prometheus_gauge *gauge =
-			CONTAINER_OF(metric, struct prometheus_gauge, base);
+	return NULL;
+}
+
+static int write_sample_prefix(const struct prometheus_metric *metric, int label,
+			       const char **cached, char *buffer, size_t buffer_size,
+			       size_t *len)
+{
+	size_t prefix_len;
+	int ret;
+
+	if (*cached == NULL) {
+		return format_sample_prefix(metric, label, buffer, buffer_size, len);
+	}
+
+	prefix_len = strlen(*cached);
+	ret = copy_to_buffer(buffer, buffer_size, len, *cached, prefix_len);
+	*cached += prefix_len + 1;
+
+	return ret;
+}
+
+static int format_metric(struct prometheus_metric *metric, char *buffer, size_t buffer_size,
+			 size_t *len)
+{
+	int ret;
+
+	ret = write_header(metric, buffer, buffer_size, len);
+	if (ret < 0) {
+		LOG_DBG("Error writing header of %s", metric->name);
+		return ret;
+	}
 
-		LOG_DBG("gauge->value: %f", gauge->value);
+	/* write metric-specific fields */
+	switch (metric->type) {
+	case PROMETHEUS_COUNTER:
+	case PROMETHEUS_GAUGE: {
+		const char *cached = cached_prefixes(metric);
 
 		for (int i = 0; i < metric->num_labels; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%s\"} %f\n", metric->name, metric->labels[i].key,
-				metric->labels[i].value, gauge->value);
+			ret = write_sample_prefix(metric, i, &cached, buffer, buffer_size, len);
+			if (ret == 0) {
+				ret = format_sample_value(metric, buffer, buffer_size, len);
+			}
+
 			if (ret < 0) {
-				LOG_ERR("Error writing gauge");
-				goto out;
+				LOG_DBG("Error writing %s", metric->name);
+				return ret;
 			}
 		}
 
@@ -164,30 +252,22 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		LOG_DBG("histogram->count: %lu", histogram->count);
 
 		for (int i = 0; i < histogram->num_buckets; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s_bucket{le=\"%f\"} %lu\n", metric->name,
-				histogram->buckets[i].upper_bound,
-				histogram->buckets[i].count);
+			ret = write_metric_to_buffer(buffer, buffer_size, len,
+						     "%s_bucket{le=\"%f\"} %lu\n", metric->name,
+						     histogram->buckets[i].upper_bound,
+						     histogram->buckets[i].count);
 			if (ret < 0) {
-				LOG_ERR("Error writing histogram");
-				goto out;
+				LOG_DBG("Error writing histogram");
+				return ret;
 			}
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, histogram->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
-		}
-
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
+		ret = write_metric_to_buffer(buffer, buffer_size, len, "%s_sum %f\n%s_count %lu\n",
+					     metric->name, histogram->sum, metric->name,
 					     histogram->count);
 		if (ret < 0) {
-			LOG_ERR("Error writing histogram");
-			goto out;
+			LOG_DBG("Error writing histogram");
+			return ret;
 		}
 
 		break;
@@ -200,30 +280,22 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 		LOG_DBG("summary->count: %lu", summary->count);
 
 		for (int i = 0; i < summary->num_quantiles; ++i) {
-			ret = write_metric_to_buffer(
-				buffer + *written, buffer_size - *written,
-				"%s{%s=\"%f\"} %f\n", metric->name, "quantile",
-				summary->quantiles[i].quantile,
-				summary->quantiles[i].value);
+			ret = write_metric_to_buffer(buffer, buffer_size, len,
+						     "%s{%s=\"%f\"} %f\n", metric->name, "quantile",
+						     summary->quantiles[i].quantile,
+						     summary->quantiles[i].value);
 			if (ret < 0) {
-				LOG_ERR("Error writing summary");
-				goto out;
+				LOG_DBG("Error writing summary");
+				return ret;
 			}
 		}
 
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_sum %f\n", metric->name, summary->sum);
-		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
-		}
-
-		ret = write_metric_to_buffer(buffer + *written, buffer_size - *written,
-					     "%s_count %lu\n", metric->name,
+		ret = write_metric_to_buffer(buffer, buffer_size, len, "%s_sum %f\n%s_count %lu\n",
+					     metric->name, summary->sum, metric->name,
 					     summary->count);
 		if (ret < 0) {
-			LOG_ERR("Error writing summary");
-			goto out;
+			LOG_DBG("Error writing summary");
+			return ret;
 		}
 
 		break;
@@ -232,11 +304,25 @@ int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
 	default:
 		/* should not happen */
 		LOG_ERR("Unsupported metric type %d", metric->type);
-		ret = -EINVAL;
-		goto out;
+		return -EINVAL;
 	}
 
-out:
+	return 0;
+}
+
+int prometheus_format_one_metric(struct prometheus_metric *metric, char *buffer,
+				 size_t buffer_size, int *written)
+{
+	size_t len = strnlen(buffer, buffer_size);
+	int ret;
+
+	ret = format_metric(metric, buffer, buffer_size, &len);
+	if (ret < 0) {
+		LOG_ERR("Error writing to buffer");
+	}
+
+	*written = len;
+
 	return ret;
 }
 
@@ -282,3 +368,126 @@ out:
 
 	return ret;
 }
+
+int prometheus_format_exposition_chunk(struct prometheus_collector_walk_context *ctx,
+				       char *buffer, size_t buffer_size)
+{
+	struct prometheus_collector *collector = ctx->collector;
+	struct prometheus_metric *metric;
+	size_t len = 0;
+	size_t mark;
+	int ret = 0;
+
+	if (collector == NULL || buffer == NULL || buffer_size == 0) {
+		LOG_ERR("Invalid arguments");
+		return -EINVAL;
+	}
+
+	buffer[0] = '\0';
+
+	if (ctx->state == PROMETHEUS_WALK_STOP) {
+		return 0;
+	}
+
+	k_mutex_lock(&collector->lock, K_FOREVER);
+
+	if (ctx->state == PROMETHEUS_WALK_START) {
+		ctx->metric = SYS_SLIST_PEEK_HEAD_CONTAINER(&collector->metrics, ctx->metric,
+							    node);
+		ctx->state = PROMETHEUS_WALK_CONTINUE;
+	}
+
+	while (ctx->metric != NULL) {
+		metric = ctx->metric;
+
+		/* If there is a user callback, use it to update the metric data. */
+		if (collector->user_cb) {
+			ret = collector->user_cb(collector, metric, collector->user_data);
+			if (ret == -EAGAIN) {
+				/* Skip this metric for now */
+				ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(metric, node);
+				ret = 0;
+				continue;
+			}
+
+			if (ret < 0) {
+				LOG_ERR("Error in user callback (%d)", ret);
+				goto out;
+			}
+		}
+
+		mark = len;
+
+		ret = format_metric(metric, buffer, buffer_size, &len);
+		if (ret == -ENOMEM && mark > 0) {
+			/* The metric goes into the next chunk */
+			len = mark;
+			buffer[len] = '\0';
+			ret = 0;
+			goto out;
+		}
+
+		if (ret < 0) {
+			LOG_ERR("Cannot format metric %s (%d)", metric->name, ret);
+			goto out;
+		}
+
+		ctx->metric = SYS_SLIST_PEEK_NEXT_CONTAINER(metric, node);
+	}
+
+	ctx->state = PROMETHEUS_WALK_STOP;
+
+out:
+	if (ret < 0) {
+		ctx->state = PROMETHEUS_WALK_STOP;
+	}
+
+	k_mutex_unlock(&collector->lock);
+
+	return ret < 0 ? ret : (int)len;
+}
+
+/* Whether a response has been started for the current request */
+static bool response_started(const struct http_client_ctx *client)
+{
+	if (client->preface_sent && client->current_stream != NULL) {
+		return client->current_stream->headers_sent;
+	}
+
+	return client->http1_headers_sent;
+}
+
+int prometheus_scrape_http_handler(struct http_client_ctx *client, enum http_data_status status,
+				   const struct http_request_ctx *request_ctx,
+				   struct http_response_ctx *response_ctx, void *user_data)
+{
+	struct prometheus_scrape_ctx *ctx = user_data;
+	int ret;
+
+	ARG_UNUSED(request_ctx);
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		ctx->walk.state = PROMETHEUS_WALK_START;
+		return 0;
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* Start over on a new request, even if a previous one was cut short */
+	if (!response_started(client)) {
+		ctx->walk.state = PROMETHEUS_WALK_START;
+	}
+
+	ret = prometheus_format_exposition_chunk(&ctx->walk, ctx->buffer, sizeof(ctx->buffer));
+	if (ret < 0) {
+		return ret;
+	}
+
+	response_ctx->body = (const uint8_t *)ctx->buffer;
+	response_ctx->body_len = ret;
+	response_ctx->final_chunk = (ctx->walk.state == PROMETHEUS_WALK_STOP);
+
+	return 0;
+}
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(ptp_clock, CONFIG_PTP_LOG_LEVEL);
 #include "btca.h"
 #include "clock.h"
 #include "ddt.h"
+#include "ptp_servo.h"
 #include "msg.h"
 #include "port.h"
 #include "tlv.h"
@@ -53,7 +54,7 @@ struct ptp_clock {
 		uint64_t	    t3;
 		uint64_t	    t4;
 	} timestamp;			/* latest timestamps in nanoseconds */
-	double pi_drift;
+	struct net_ptp_servo servo;
 };
 
 __maybe_unused static struct ptp_clock ptp_clk = { 0 };
@@ -286,6 +287,8 @@ const struct ptp_clock *ptp_clock_init(void)
 		return NULL;
 	}
 
+	net_ptp_servo_init(&ptp_clk.servo, CONFIG_PTP_SERVO_BANDWIDTH, CONFIG_PTP_SERVO_MAX_PPB);
+
 	ptp_clk.pollfd[0].fd = eventfd(0, EFD_NONBLOCK);
 	ptp_clk.pollfd[0].events = ZSOCK_POLLIN;
 
@@ -507,18 +510,6 @@ int ptp_clock_management_msg_process(struct ptp_port *port, struct ptp_msg *msg)
 	return state_decision_required;
 }
 
-static double ptp_servo_pi(int64_t nanosecond_diff)
-{
-	double kp = 0.7;
-	double ki = 0.3;
-	double ppb;
-
-	ptp_clk.pi_drift += ki * nanosecond_diff;
-	ppb = kp * nanosecond_diff + ptp_clk.pi_drift;
-
-	return ppb;
-}
-
 void ptp_clock_synchronize(uint64_t ingress, uint64_t egress)
 {
 	double ppb;
@@ -557,6 +548,7 @@ void ptp_clock_synchronize(uint64_t ingress, uint64_t egress)
 		current.nanosecond = (uint32_t)dest_nsec;
 
 		ptp_clock_set(ptp_clk.phc, &current);
+		net_ptp_servo_reset(&ptp_clk.servo);
 		LOG_WRN("Set clock time: %"PRIu64".%09u", current.second, current.nanosecond);
 		return;
 	}
@@ -564,7 +556,7 @@ void ptp_clock_synchronize(uint64_t ingress, uint64_t egress)
 	LOG_DBG("Offset %lldns", offset);
 	ptp_clk.current_ds.offset_from_tt = clock_ns_to_timeinterval(offset);
 
-	ppb = ptp_servo_pi(-offset);
+	ppb = net_ptp_servo_sample(&ptp_clk.servo, -offset, ingress);
 	ptp_clock_rate_adjust(ptp_clk.phc, 1.0 + (ppb / 1000000000.0));
 }
 
@@ -129,6 +129,22 @@ static void tcp_cb(struct tcp *conn, void *user_data)
 	(*count)++;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+static void tcp_ca_cb(struct tcp *conn, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *sh = data->sh;
+
+	if (conn->ca.ops == NULL) {
+		return;
+	}
+
+	PR("%p %-8s %5u    %5u %8u %10u\n",
+	   conn, conn->ca.ops->name, conn->ca.cwnd, conn->ca.ssthresh,
+	   conn->ca.srtt, conn->ca.min_rtt);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 {
@@ -246,6 +262,12 @@ static int cmd_net_conn(const struct shell *sh, size_t argc, char *argv[])
 	if (count == 0) {
 		PR("No TCP connections\n");
 	} else {
+#if defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+		PR("\nTCP        Cong-ctl  Cwnd Ssthresh SRTT(ms) MinRTT(ms)\n");
+
+		net_tcp_foreach(tcp_ca_cb, &user_data);
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 		/* Print information about pending packets */
 		struct tcp_detail_info details;
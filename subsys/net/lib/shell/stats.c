@@ -139,6 +139,7 @@ static void print_ppp_stats(struct net_if *iface, struct net_stats_ppp *data,
 
 #if !defined(CONFIG_NET_NATIVE)
 #define GET_STAT(a, b) 0
+#define net_stats_sync()
 #endif
 
 #if defined(CONFIG_NET_PKT_TXTIME_STATS_DETAIL) || \
@@ -447,6 +448,8 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	struct net_shell_user_data *data = user_data;
 	const struct shell *sh = data->sh;
 
+	net_stats_sync();
+
 	if (iface) {
 		const char *extra;
 
@@ -46,20 +46,34 @@ LOG_MODULE_REGISTER(net_sock_addr, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 struct getaddrinfo_state {
 	const struct zsock_addrinfo *hints;
-	struct k_sem sem;
-	int status;
+	struct k_spinlock lock;
 	uint16_t idx;
 	uint16_t port;
-	uint16_t dns_id;
 	struct zsock_addrinfo *ai_arr;
 };
 
+/* The IPv4 and IPv6 queries run concurrently and store their results in the
+ * same state.
+ */
+struct getaddrinfo_query {
+	struct getaddrinfo_state *state;
+	struct k_sem sem;
+	k_timepoint_t end;
+	k_timeout_t timeout;
+	int timeout_ms;
+	int status;
+	uint16_t dns_id;
+	enum dns_query_type qtype;
+};
+
 static void dns_resolve_cb(enum dns_resolve_status status,
 			   struct dns_addrinfo *info, void *user_data)
 {
-	struct getaddrinfo_state *state = user_data;
+	struct getaddrinfo_query *query = user_data;
+	struct getaddrinfo_state *state = query->state;
 	struct zsock_addrinfo *ai;
 	int socktype = SOCK_STREAM;
+	k_spinlock_key_t key;
 
 	NET_DBG("dns status: %d", status);
 
@@ -67,20 +81,20 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 		if (status == DNS_EAI_ALLDONE) {
 			status = 0;
 		}
-		state->status = status;
-		k_sem_give(&state->sem);
+		query->status = status;
+		k_sem_give(&query->sem);
 		return;
 	}
 
+	key = k_spin_lock(&state->lock);
+
 	if (state->idx >= AI_ARR_MAX) {
+		k_spin_unlock(&state->lock, key);
 		NET_DBG("getaddrinfo entries overflow");
 		return;
 	}
 
 	ai = &state->ai_arr[state->idx];
-	if (state->idx > 0) {
-		state->ai_arr[state->idx - 1].ai_next = ai;
-	}
 
 	memcpy(&ai->_ai_addr, &info->ai_addr, info->ai_addrlen);
 	net_sin(&ai->_ai_addr)->sin_port = state->port;
@@ -101,6 +115,8 @@ static void dns_resolve_cb(enum dns_resolve_status status,
 	ai->ai_protocol = (socktype == SOCK_DGRAM) ? IPPROTO_UDP : IPPROTO_TCP;
 
 	state->idx++;
+
+	k_spin_unlock(&state->lock, key);
 }
 
 static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
@@ -118,27 +134,36 @@ static k_timeout_t recalc_timeout(k_timepoint_t end, k_timeout_t timeout)
 	return timeout;
 }
 
-static int exec_query(const char *host, int family,
-		      struct getaddrinfo_state *ai_state)
+static void init_query(struct getaddrinfo_query *query, int family,
+		       struct getaddrinfo_state *ai_state)
 {
-	enum dns_query_type qtype = DNS_QUERY_TYPE_A;
-	k_timepoint_t end = sys_timepoint_calc(K_MSEC(CONFIG_NET_SOCKETS_DNS_TIMEOUT));
-	k_timeout_t timeout = K_MSEC(MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
-					 CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL));
-	int timeout_ms;
-	int st, ret;
+	query->state = ai_state;
+	query->qtype = (family == AF_INET6) ? DNS_QUERY_TYPE_AAAA : DNS_QUERY_TYPE_A;
+	query->end = sys_timepoint_calc(K_MSEC(CONFIG_NET_SOCKETS_DNS_TIMEOUT));
+	query->timeout = K_MSEC(MIN(CONFIG_NET_SOCKETS_DNS_TIMEOUT,
+				    CONFIG_NET_SOCKETS_DNS_BACKOFF_INTERVAL));
+	query->dns_id = 0;
+	k_sem_init(&query->sem, 0, K_SEM_MAX_LIMIT);
+}
 
-	if (family == AF_INET6) {
-		qtype = DNS_QUERY_TYPE_AAAA;
-	}
+static int start_query(const char *host, struct getaddrinfo_query *query)
+{
+	query->timeout_ms = k_ticks_to_ms_ceil32(query->timeout.ticks);
 
-again:
-	timeout_ms = k_ticks_to_ms_ceil32(timeout.ticks);
+	NET_DBG("Timeout %d", query->timeout_ms);
 
-	NET_DBG("Timeout %d", timeout_ms);
+	return dns_get_addr_info(host, query->qtype, &query->dns_id,
+				 dns_resolve_cb, query, query->timeout_ms);
+}
 
-	ret = dns_get_addr_info(host, qtype, &ai_state->dns_id,
-				dns_resolve_cb, ai_state, timeout_ms);
+/* Wait for the result of a query started with start_query(), which returned
+ * ret, retrying with exponential backoff until the DNS timeout.
+ */
+static int wait_query(const char *host, struct getaddrinfo_query *query, int ret)
+{
+	int st;
+
+again:
 	if (ret == 0) {
 		/* If the DNS query for reason fails so that the
 		 * dns_resolve_cb() would not be called, then we want the
@@ -146,24 +171,27 @@ again:
 		 * So make the sem timeout longer than the DNS timeout so that
 		 * we do not need to start to cancel any pending DNS queries.
 		 */
-		ret = k_sem_take(&ai_state->sem, K_MSEC(timeout_ms + 100));
+		ret = k_sem_take(&query->sem, K_MSEC(query->timeout_ms + 100));
 		if (ret == -EAGAIN) {
-			if (!sys_timepoint_expired(end)) {
-				timeout = recalc_timeout(end, timeout);
+			if (!sys_timepoint_expired(query->end)) {
+				query->timeout = recalc_timeout(query->end, query->timeout);
+				ret = start_query(host, query);
 				goto again;
 			}
 
-			(void)dns_cancel_addr_info(ai_state->dns_id);
+			(void)dns_cancel_addr_info(query->dns_id);
 			st = DNS_EAI_AGAIN;
 		} else {
-			if (ai_state->status == DNS_EAI_CANCELED) {
-				if (!sys_timepoint_expired(end)) {
-					timeout = recalc_timeout(end, timeout);
+			if (query->status == DNS_EAI_CANCELED) {
+				if (!sys_timepoint_expired(query->end)) {
+					query->timeout = recalc_timeout(query->end,
+									query->timeout);
+					ret = start_query(host, query);
 					goto again;
 				}
 			}
 
-			st = ai_state->status;
+			st = query->status;
 		}
 	} else if (ret == -EPFNOSUPPORT) {
 		/* If we are returned -EPFNOSUPPORT then that will indicate
@@ -179,6 +207,34 @@ again:
 	return st;
 }
 
+/* Results arrive in any order from the concurrent queries. List the IPv4
+ * addresses first, as when the queries were done one after the other.
+ */
+static void sort_results(struct getaddrinfo_state *ai_state)
+{
+	struct zsock_addrinfo *ai_arr = ai_state->ai_arr;
+	struct zsock_addrinfo tmp;
+
+	for (uint16_t i = 1; i < ai_state->idx; i++) {
+		for (uint16_t j = i; j > 0; j--) {
+			if (ai_arr[j].ai_family != AF_INET ||
+			    ai_arr[j - 1].ai_family == AF_INET) {
+				break;
+			}
+
+			tmp = ai_arr[j];
+			ai_arr[j] = ai_arr[j - 1];
+			ai_arr[j - 1] = tmp;
+		}
+	}
+
+	for (uint16_t i = 0; i < ai_state->idx; i++) {
+		ai_arr[i].ai_addr = &ai_arr[i]._ai_addr;
+		ai_arr[i].ai_canonname = ai_arr[i]._ai_canonname;
+		ai_arr[i].ai_next = (i + 1 < ai_state->idx) ? &ai_arr[i + 1] : NULL;
+	}
+}
+
 static int getaddrinfo_null_host(int port, const struct zsock_addrinfo *hints,
 				struct zsock_addrinfo *res)
 {
@@ -223,8 +279,11 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 	int ai_flags = 0;
 	long int port = 0;
 	int st1 = DNS_EAI_ADDRFAMILY, st2 = DNS_EAI_ADDRFAMILY;
+	struct getaddrinfo_query query4, query6;
 	struct sockaddr *ai_addr;
-	struct getaddrinfo_state ai_state;
+	struct getaddrinfo_state ai_state = { 0 };
+	bool query_v4, query_v6;
+	int ret4 = 0, ret6 = 0;
 
 	if (hints) {
 		family = hints->ai_family;
@@ -259,33 +318,53 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 		return getaddrinfo_null_host(port, hints, res);
 	}
 
+	query_v4 = (family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4);
+	query_v6 = (family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6);
+
 	ai_state.hints = hints;
 	ai_state.idx = 0U;
 	ai_state.port = htons(port);
 	ai_state.ai_arr = res;
-	ai_state.dns_id = 0;
-	k_sem_init(&ai_state.sem, 0, K_SEM_MAX_LIMIT);
 
-	/* If family is AF_UNSPEC, then we query IPv4 address first
-	 * if IPv4 is enabled in the config.
+	/* Both queries are sent before waiting for the answers. If the
+	 * resolver has no room for the second one, it is sent once the
+	 * first one has completed.
 	 */
-	if ((family != AF_INET6) && IS_ENABLED(CONFIG_NET_IPV4)) {
-		st1 = exec_query(host, AF_INET, &ai_state);
+	if (query_v4) {
+		init_query(&query4, AF_INET, &ai_state);
+		ret4 = start_query(host, &query4);
+	}
+
+	if (query_v6) {
+		init_query(&query6, AF_INET6, &ai_state);
+		ret6 = start_query(host, &query6);
+	}
+
+	if (query_v4) {
+		st1 = wait_query(host, &query4, ret4);
 		if (st1 == DNS_EAI_AGAIN) {
+			if (query_v6 && ret6 == 0) {
+				(void)dns_cancel_addr_info(query6.dns_id);
+			}
+
 			return st1;
 		}
 	}
 
-	/* If family is AF_UNSPEC, the IPv4 query has been already done
-	 * so we can do IPv6 query next if IPv6 is enabled in the config.
-	 */
-	if ((family != AF_INET) && IS_ENABLED(CONFIG_NET_IPV6)) {
-		st2 = exec_query(host, AF_INET6, &ai_state);
+	if (query_v6) {
+		if (ret6 == -EAGAIN) {
+			init_query(&query6, AF_INET6, &ai_state);
+			ret6 = start_query(host, &query6);
+		}
+
+		st2 = wait_query(host, &query6, ret6);
 		if (st2 == DNS_EAI_AGAIN) {
 			return st2;
 		}
 	}
 
+	sort_results(&ai_state);
+
 	for (uint16_t idx = 0; idx < ai_state.idx; idx++) {
 		ai_addr = &ai_state.ai_arr[idx]._ai_addr;
 		net_sin(ai_addr)->sin_port = htons(port);
@@ -299,9 +378,6 @@ int z_impl_z_zsock_getaddrinfo_internal(const char *host, const char *service,
 		return st2;
 	}
 
-	/* Mark entry as last */
-	ai_state.ai_arr[ai_state.idx - 1].ai_next = NULL;
-
 	return 0;
 }
 
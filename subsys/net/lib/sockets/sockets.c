@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/timeutil.h>
 
 #include "sockets_internal.h"
 
@@ -710,6 +711,330 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Batches are capped like in Linux, where this is UIO_MAXIOV */
+#define MMSG_VLEN_MAX 1024
+
+typedef ssize_t (*mmsg_op_t)(void *obj, const struct socket_op_vtable *vtable,
+			     struct mmsghdr *mmsg, int flags);
+
+static ssize_t mmsg_send(void *obj, const struct socket_op_vtable *vtable,
+			 struct mmsghdr *mmsg, int flags)
+{
+	ssize_t ret = vtable->sendmsg(obj, &mmsg->msg_hdr, flags);
+
+	if (ret >= 0) {
+		mmsg->msg_len = ret;
+	}
+
+	return ret;
+}
+
+static ssize_t mmsg_recv(void *obj, const struct socket_op_vtable *vtable,
+			 struct mmsghdr *mmsg, int flags)
+{
+	ssize_t ret = vtable->recvmsg(obj, &mmsg->msg_hdr, flags);
+
+	if (ret >= 0) {
+		mmsg->msg_len = ret;
+	}
+
+	return ret;
+}
+
+/* Send or receive a batch of messages with the socket locked only once.
+ * With ZSOCK_MSG_WAITFORONE, receiving only blocks for the first message,
+ * so that all the messages already queued are returned on a single wakeup.
+ */
+static int sock_mmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+		     int flags, const struct timespec *timeout, bool send,
+		     mmsg_op_t op)
+{
+	const struct socket_op_vtable *vtable;
+	k_timepoint_t end = sys_timepoint_calc(K_FOREVER);
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if ((send && vtable->sendmsg == NULL) || (!send && vtable->recvmsg == NULL)) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout != NULL) {
+		if (!timespec_is_valid(timeout)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		end = sys_timepoint_calc(timespec_to_timeout(timeout));
+	}
+
+	vlen = MIN(vlen, MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = op(obj, vtable, &msgvec[count], flags & ~ZSOCK_MSG_WAITFORONE);
+
+		if (send) {
+			sock_obj_core_update_send_stats(sock, ret);
+		} else {
+			sock_obj_core_update_recv_stats(sock, ret);
+		}
+
+		if (ret < 0) {
+			break;
+		}
+
+		if (!send) {
+			if ((flags & ZSOCK_MSG_WAITFORONE) != 0) {
+				flags |= ZSOCK_MSG_DONTWAIT;
+			}
+
+			/* Like in Linux, the timeout is only checked between messages */
+			if (sys_timepoint_expired(end)) {
+				count++;
+				break;
+			}
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* Errors after the first message are left for the next call */
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	return sock_mmsg(sock, msgvec, vlen, flags, NULL, true, mmsg_send);
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, const struct timespec *timeout)
+{
+	return sock_mmsg(sock, msgvec, vlen, flags, timeout, false, mmsg_recv);
+}
+
+#ifdef CONFIG_USERSPACE
+/* Kernel copy of a message of a user mode batch. Only the headers are
+ * copied: like for zsock_sendto() and zsock_recvfrom(), the data buffers
+ * are checked and accessed in place.
+ */
+struct mmsg_copy {
+	struct msghdr msg;
+	struct sockaddr_storage name;
+	struct iovec *user_iov;
+	void *user_name;
+	void *user_control;
+	size_t iovlen;
+	size_t controllen;
+	socklen_t namelen;
+};
+
+static void mmsg_copy_free(struct mmsg_copy *copy)
+{
+	k_free(copy->msg.msg_iov);
+	k_free(copy->msg.msg_control);
+}
+
+static int mmsg_copy_in(struct mmsg_copy *copy, struct mmsghdr *mmsg,
+			bool write)
+{
+	struct msghdr *msg = &copy->msg;
+
+	if (k_usermode_from_copy(msg, &mmsg->msg_hdr, sizeof(*msg)) != 0) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	copy->user_iov = msg->msg_iov;
+	copy->user_name = msg->msg_name;
+	copy->user_control = msg->msg_control;
+	copy->iovlen = msg->msg_iovlen;
+	copy->controllen = msg->msg_controllen;
+	copy->namelen = MIN(msg->msg_namelen, sizeof(copy->name));
+
+	msg->msg_iov = NULL;
+	msg->msg_name = NULL;
+	msg->msg_control = NULL;
+
+	/* Destination addresses must fit, received ones get truncated */
+	if (!write && msg->msg_namelen > sizeof(copy->name)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	msg->msg_namelen = copy->namelen;
+
+	if (copy->namelen > 0) {
+		if (write ? K_SYSCALL_MEMORY_WRITE(copy->user_name, copy->namelen) :
+			    k_usermode_from_copy(&copy->name, copy->user_name,
+						 copy->namelen)) {
+			errno = EFAULT;
+			return -1;
+		}
+
+		msg->msg_name = &copy->name;
+	}
+
+	if (copy->iovlen > 0) {
+		if (copy->iovlen > SIZE_MAX / sizeof(struct iovec)) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		msg->msg_iov = k_usermode_alloc_from_copy(copy->user_iov,
+							  copy->iovlen * sizeof(struct iovec));
+		if (msg->msg_iov == NULL) {
+			errno = ENOMEM;
+			return -1;
+		}
+
+		for (size_t i = 0; i < copy->iovlen; i++) {
+			if (K_SYSCALL_MEMORY(msg->msg_iov[i].iov_base,
+					     msg->msg_iov[i].iov_len, write)) {
+				errno = EFAULT;
+				return -1;
+			}
+		}
+	}
+
+	if (copy->controllen > 0) {
+		msg->msg_control = k_usermode_alloc_from_copy(copy->user_control,
+							      copy->controllen);
+		if (msg->msg_control == NULL) {
+			errno = ENOMEM;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int mmsg_copy_out(struct mmsg_copy *copy, struct mmsghdr *mmsg,
+			 unsigned int len)
+{
+	struct msghdr *msg = &copy->msg;
+	int ret = 0;
+
+	ret |= k_usermode_to_copy(&mmsg->msg_len, &len, sizeof(len));
+	ret |= k_usermode_to_copy(&mmsg->msg_hdr.msg_flags, &msg->msg_flags,
+				  sizeof(msg->msg_flags));
+
+	if (copy->namelen > 0) {
+		ret |= k_usermode_to_copy(copy->user_name, &copy->name,
+					  MIN(msg->msg_namelen, copy->namelen));
+		ret |= k_usermode_to_copy(&mmsg->msg_hdr.msg_namelen, &msg->msg_namelen,
+					  sizeof(msg->msg_namelen));
+	}
+
+	if (copy->controllen > 0) {
+		ret |= k_usermode_to_copy(copy->user_control, msg->msg_control,
+					  MIN(msg->msg_controllen, copy->controllen));
+	}
+	ret |= k_usermode_to_copy(&mmsg->msg_hdr.msg_controllen, &msg->msg_controllen,
+				  sizeof(msg->msg_controllen));
+
+	if (copy->iovlen > 0) {
+		ret |= k_usermode_to_copy(copy->user_iov, msg->msg_iov,
+					  MIN(msg->msg_iovlen, copy->iovlen) *
+					  sizeof(struct iovec));
+		ret |= k_usermode_to_copy(&mmsg->msg_hdr.msg_iovlen, &msg->msg_iovlen,
+					  sizeof(msg->msg_iovlen));
+	}
+
+	if (ret != 0) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	return 0;
+}
+
+/* The socket is locked while these run, so user memory faults must not
+ * oops but fail the current message.
+ */
+static ssize_t mmsg_send_user(void *obj, const struct socket_op_vtable *vtable,
+			      struct mmsghdr *mmsg, int flags)
+{
+	struct mmsg_copy copy = { 0 };
+	ssize_t ret = -1;
+
+	if (mmsg_copy_in(&copy, mmsg, false) == 0) {
+		ret = vtable->sendmsg(obj, &copy.msg, flags);
+	}
+
+	if (ret >= 0) {
+		unsigned int len = ret;
+
+		if (k_usermode_to_copy(&mmsg->msg_len, &len, sizeof(len)) != 0) {
+			errno = EFAULT;
+			ret = -1;
+		}
+	}
+
+	mmsg_copy_free(&copy);
+
+	return ret;
+}
+
+static ssize_t mmsg_recv_user(void *obj, const struct socket_op_vtable *vtable,
+			      struct mmsghdr *mmsg, int flags)
+{
+	struct mmsg_copy copy = { 0 };
+	ssize_t ret = -1;
+
+	if (mmsg_copy_in(&copy, mmsg, true) == 0) {
+		ret = vtable->recvmsg(obj, &copy.msg, flags);
+	}
+
+	if (ret >= 0 && mmsg_copy_out(&copy, mmsg, ret) < 0) {
+		ret = -1;
+	}
+
+	mmsg_copy_free(&copy);
+
+	return ret;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	return sock_mmsg(sock, msgvec, vlen, flags, NULL, true, mmsg_send_user);
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					const struct timespec *timeout)
+{
+	struct timespec timeout_copy;
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, (void *)timeout,
+					    sizeof(timeout_copy)));
+	}
+
+	return sock_mmsg(sock, msgvec, vlen, flags,
+			 timeout != NULL ? &timeout_copy : NULL, false,
+			 mmsg_recv_user);
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
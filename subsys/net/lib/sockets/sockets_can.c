@@ -13,6 +13,7 @@ LOG_MODULE_REGISTER(net_sock_can, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/entropy.h>
+#include <zephyr/sys/slist.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_pkt.h>
@@ -28,7 +29,12 @@ LOG_MODULE_REGISTER(net_sock_can, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #define MEM_ALLOC_TIMEOUT K_MSEC(50)
 
+#define RECV_HASH_MASK (CONFIG_NET_SOCKETS_CAN_RECEIVERS_HASH_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_NET_SOCKETS_CAN_RECEIVERS_HASH_SIZE));
+
 struct can_recv {
+	sys_snode_t node;
 	struct net_if *iface;
 	struct net_context *ctx;
 	socketcan_id_t can_id;
@@ -37,6 +43,66 @@ struct can_recv {
 
 static struct can_recv receivers[CONFIG_NET_SOCKETS_CAN_RECEIVERS];
 
+/* Receivers whose mask covers the low ID bits are hashed by those, as only
+ * frames with the same low bits can match them. The others, in the last
+ * list, are checked against every frame.
+ */
+static sys_slist_t receivers_hash[CONFIG_NET_SOCKETS_CAN_RECEIVERS_HASH_SIZE + 1];
+static struct k_spinlock receivers_lock;
+
+static sys_slist_t *can_recv_list(socketcan_id_t can_id, socketcan_id_t can_mask)
+{
+	if ((can_mask & RECV_HASH_MASK) != RECV_HASH_MASK) {
+		return &receivers_hash[ARRAY_SIZE(receivers_hash) - 1];
+	}
+
+	return &receivers_hash[can_id & RECV_HASH_MASK];
+}
+
+static int can_find_receivers(struct net_if *iface, socketcan_id_t can_id,
+			      struct net_context **ctxs)
+{
+	sys_slist_t *lists[] = {
+		&receivers_hash[can_id & RECV_HASH_MASK],
+		&receivers_hash[ARRAY_SIZE(receivers_hash) - 1],
+	};
+	k_spinlock_key_t key = k_spin_lock(&receivers_lock);
+	struct can_recv *recv;
+	int count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(lists); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], recv, node) {
+			if (recv->iface == iface &&
+			    (can_id & recv->can_mask) == (recv->can_id & recv->can_mask)) {
+				ctxs[count++] = recv->ctx;
+			}
+		}
+	}
+
+	k_spin_unlock(&receivers_lock, key);
+
+	return count;
+}
+
+static int can_find_iface_receivers(struct net_if *iface, struct net_context **ctxs)
+{
+	k_spinlock_key_t key = k_spin_lock(&receivers_lock);
+	struct can_recv *recv;
+	int count = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(receivers_hash); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&receivers_hash[i], recv, node) {
+			if (recv->iface == iface) {
+				ctxs[count++] = recv->ctx;
+			}
+		}
+	}
+
+	k_spin_unlock(&receivers_lock, key);
+
+	return count;
+}
+
 extern const struct socket_op_vtable sock_fd_op_vtable;
 
 static const struct socket_op_vtable can_sock_fd_op_vtable;
@@ -86,104 +152,109 @@ int zcan_socket(int family, int type, int proto)
 	return fd;
 }
 
-static void zcan_received_cb(struct net_context *ctx, struct net_pkt *pkt,
-			     union net_ip_header *ip_hdr,
-			     union net_proto_header *proto_hdr,
-			     int status, void *user_data)
+static void zcan_deliver(struct net_context *ctx, struct net_pkt *pkt, int status)
 {
-	/* The ctx parameter is not really relevant here. It refers to first
-	 * net_context that was used when registering CAN socket.
-	 * In practice there can be multiple sockets that are interested in
-	 * same CAN id packets. That is why we need to implement the dispatcher
-	 * which will give the packet to correct net_context(s).
+	/* To prevent the reader from missing the wake-up signal
+	 *  as described in commit 1184089 and implemented in sockets.c
 	 */
-	struct net_pkt *clone = NULL;
-	int i;
+	if (ctx->cond.lock) {
+		(void)k_mutex_lock(ctx->cond.lock, K_FOREVER);
+	}
 
-	for (i = 0; i < ARRAY_SIZE(receivers); i++) {
-		struct can_frame *zframe =
-			(struct can_frame *)net_pkt_data(pkt);
-		struct socketcan_frame sframe;
+	NET_DBG("ctx %p pkt %p st %d", ctx, pkt, status);
 
-		if (!receivers[i].ctx ||
-		    receivers[i].iface != net_pkt_iface(pkt)) {
-			continue;
-		}
+	net_pkt_set_eof(pkt, false);
+	k_fifo_put(&ctx->recv_q, pkt);
 
-		socketcan_from_can_frame(zframe, &sframe);
+	if (ctx->cond.lock) {
+		k_mutex_unlock(ctx->cond.lock);
+	}
 
-		if ((sframe.can_id & receivers[i].can_mask) !=
-		    (receivers[i].can_id & receivers[i].can_mask)) {
-			continue;
-		}
+	k_condvar_signal(&ctx->cond.recv);
+}
 
-		/* If there are multiple receivers configured, we use the
-		 * original net_pkt as a template, and just clone it to all
-		 * recipients. This is done like this so that we avoid the
-		 * original net_pkt being freed while we are cloning it.
-		 */
-		if (pkt != NULL && ARRAY_SIZE(receivers) > 1) {
-			/* There are multiple receivers, we need to clone
-			 * the packet.
-			 */
-			clone = net_pkt_clone(pkt, MEM_ALLOC_TIMEOUT);
-			if (!clone) {
-				/* Sent the packet to at least one recipient
-				 * if there is no memory to clone the packet.
-				 */
-				clone = pkt;
-			}
-		} else {
-			clone = pkt;
-		}
+static void zcan_deliver_eof(struct net_context *ctx)
+{
+	struct net_pkt *last_pkt;
 
-		ctx = receivers[i].ctx;
+	if (ctx->cond.lock) {
+		(void)k_mutex_lock(ctx->cond.lock, K_FOREVER);
+	}
 
-		/* To prevent the reader from missing the wake-up signal
-		 *  as described in commit 1184089 and implemented in sockets.c
+	last_pkt = k_fifo_peek_tail(&ctx->recv_q);
+	if (!last_pkt) {
+		/* If there're no packets in the queue, recv() may be
+		 * blocked waiting on it to become non-empty, so cancel
+		 * that wait.
 		 */
-		if (ctx->cond.lock) {
-			(void)k_mutex_lock(ctx->cond.lock, K_FOREVER);
-		}
+		sock_set_eof(ctx);
+		k_fifo_cancel_wait(&ctx->recv_q);
 
-		NET_DBG("[%d] ctx %p pkt %p st %d", i, ctx, clone, status);
+		NET_DBG("Marked socket %p as peer-closed", ctx);
+	} else {
+		net_pkt_set_eof(last_pkt, true);
 
-		/* if pkt is NULL, EOF */
-		if (!clone) {
-			struct net_pkt *last_pkt =
-				k_fifo_peek_tail(&ctx->recv_q);
+		NET_DBG("Set EOF flag on pkt %p", last_pkt);
+	}
 
-			if (!last_pkt) {
-				/* If there're no packets in the queue,
-				 * recv() may be blocked waiting on it to
-				 * become non-empty, so cancel that wait.
-				 */
-				sock_set_eof(ctx);
-				k_fifo_cancel_wait(&ctx->recv_q);
+	if (ctx->cond.lock) {
+		k_mutex_unlock(ctx->cond.lock);
+	}
 
-				NET_DBG("Marked socket %p as peer-closed", ctx);
-			} else {
-				net_pkt_set_eof(last_pkt, true);
+	k_condvar_signal(&ctx->cond.recv);
+}
 
-				NET_DBG("Set EOF flag on pkt %p", ctx);
-			}
-		} else {
-			/* Normal packet */
-			net_pkt_set_eof(clone, false);
+static void zcan_received_cb(struct net_context *ctx, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status, void *user_data)
+{
+	/* The ctx parameter is not really relevant here. It refers to first
+	 * net_context that was used when registering CAN socket.
+	 * In practice there can be multiple sockets that are interested in
+	 * same CAN id packets. That is why we need to implement the dispatcher
+	 * which will give the packet to correct net_context(s).
+	 */
+	struct net_context *ctxs[ARRAY_SIZE(receivers)];
+	const struct can_frame *zframe;
+	socketcan_id_t can_id;
+	int count;
 
-			k_fifo_put(&ctx->recv_q, clone);
-		}
+	/* if pkt is NULL, EOF for all the receivers of the interface */
+	if (pkt == NULL) {
+		count = can_find_iface_receivers(net_context_get_iface(ctx), ctxs);
 
-		if (ctx->cond.lock) {
-			k_mutex_unlock(ctx->cond.lock);
+		for (int i = 0; i < count; i++) {
+			zcan_deliver_eof(ctxs[i]);
 		}
 
-		k_condvar_signal(&ctx->cond.recv);
+		return;
 	}
 
-	if (clone && clone != pkt) {
+	zframe = (const struct can_frame *)net_pkt_data(pkt);
+	can_id = zframe->id;
+	can_id |= (zframe->flags & CAN_FRAME_IDE) != 0 ? BIT(31) : 0;
+	can_id |= (zframe->flags & CAN_FRAME_RTR) != 0 ? BIT(30) : 0;
+
+	count = can_find_receivers(net_pkt_iface(pkt), can_id, ctxs);
+	if (count == 0) {
 		net_pkt_unref(pkt);
+		return;
+	}
+
+	/* Every recipient but the last one gets a clone of the packet */
+	for (int i = 0; i < count - 1; i++) {
+		struct net_pkt *clone = net_pkt_clone(pkt, MEM_ALLOC_TIMEOUT);
+
+		if (clone == NULL) {
+			NET_DBG("No memory to clone pkt %p for ctx %p", pkt, ctxs[i]);
+			continue;
+		}
+
+		zcan_deliver(ctxs[i], clone, status);
 	}
+
+	zcan_deliver(ctxs[count - 1], pkt, status);
 }
 
 static int zcan_bind_ctx(struct net_context *ctx, const struct sockaddr *addr,
@@ -418,8 +489,13 @@ static int can_close_socket(struct net_context *ctx)
 	for (i = 0; i < ARRAY_SIZE(receivers); i++) {
 		if (receivers[i].ctx == ctx) {
 			struct socketcan_filter sfilter;
+			k_spinlock_key_t key = k_spin_lock(&receivers_lock);
 
+			(void)sys_slist_find_and_remove(can_recv_list(receivers[i].can_id,
+								      receivers[i].can_mask),
+							&receivers[i].node);
 			receivers[i].ctx = NULL;
+			k_spin_unlock(&receivers_lock, key);
 
 			sfilter.can_id = receivers[i].can_id;
 			sfilter.can_mask = receivers[i].can_mask;
@@ -548,14 +624,19 @@ static int can_register_receiver(struct net_if *iface, struct net_context *ctx,
 	NET_DBG("Max %zu receivers", ARRAY_SIZE(receivers));
 
 	for (i = 0; i < ARRAY_SIZE(receivers); i++) {
+		k_spinlock_key_t key;
+
 		if (receivers[i].ctx != NULL) {
 			continue;
 		}
 
+		key = k_spin_lock(&receivers_lock);
 		receivers[i].ctx = ctx;
 		receivers[i].iface = iface;
 		receivers[i].can_id = can_id;
 		receivers[i].can_mask = can_mask;
+		sys_slist_append(can_recv_list(can_id, can_mask), &receivers[i].node);
+		k_spin_unlock(&receivers_lock, key);
 
 		return i;
 	}
@@ -574,7 +655,12 @@ static void can_unregister_receiver(struct net_if *iface,
 		    receivers[i].iface == iface &&
 		    receivers[i].can_id == can_id &&
 		    receivers[i].can_mask == can_mask) {
+			k_spinlock_key_t key = k_spin_lock(&receivers_lock);
+
+			(void)sys_slist_find_and_remove(can_recv_list(can_id, can_mask),
+							&receivers[i].node);
 			receivers[i].ctx = NULL;
+			k_spin_unlock(&receivers_lock, key);
 			return;
 		}
 	}
@@ -0,0 +1,254 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* RFC 8305 ("Happy Eyeballs") connection establishment. */
+
+#include <errno.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_sock_happy, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/fdtable.h>
+
+#define MAX_ATTEMPTS CONFIG_NET_SOCKETS_HAPPY_EYEBALLS_MAX_ATTEMPTS
+
+struct happy_eyeballs {
+	/* Next address of each family to try */
+	const struct zsock_addrinfo *next_v6;
+	const struct zsock_addrinfo *next_v4;
+	/* Family of the address to try next, if available */
+	bool prefer_v6;
+	/* Pending connection attempts */
+	struct zsock_pollfd fds[MAX_ATTEMPTS];
+	int flags[MAX_ATTEMPTS];
+	int count;
+};
+
+static const struct zsock_addrinfo *find_family(const struct zsock_addrinfo *ai, int family)
+{
+	while (ai != NULL && ai->ai_family != family) {
+		ai = ai->ai_next;
+	}
+
+	return ai;
+}
+
+/* Pick the next address, alternating between the address families. */
+static const struct zsock_addrinfo *next_addr(struct happy_eyeballs *he)
+{
+	const struct zsock_addrinfo *ai;
+
+	if ((he->prefer_v6 && he->next_v6 != NULL) || he->next_v4 == NULL) {
+		ai = he->next_v6;
+		if (ai != NULL) {
+			he->next_v6 = find_family(ai->ai_next, AF_INET6);
+		}
+	} else {
+		ai = he->next_v4;
+		he->next_v4 = find_family(ai->ai_next, AF_INET);
+	}
+
+	he->prefer_v6 = !he->prefer_v6;
+
+	return ai;
+}
+
+static bool has_next_addr(struct happy_eyeballs *he)
+{
+	return he->next_v6 != NULL || he->next_v4 != NULL;
+}
+
+static int poll_timeout(k_timepoint_t timepoint)
+{
+	k_timeout_t timeout = sys_timepoint_timeout(timepoint);
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return -1;
+	}
+
+	return k_ticks_to_ms_ceil32(timeout.ticks);
+}
+
+/* Start connecting to ai. Returns 1 if the attempt is pending, 0 if it
+ * completed immediately and a negative errno value if it failed.
+ */
+static int start_attempt(struct happy_eyeballs *he, const struct zsock_addrinfo *ai)
+{
+	int sock, flags, ret;
+
+	sock = zsock_socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+	if (sock < 0) {
+		return -errno;
+	}
+
+	flags = zsock_fcntl(sock, ZVFS_F_GETFL, 0);
+	if (flags < 0 || zsock_fcntl(sock, ZVFS_F_SETFL, flags | ZVFS_O_NONBLOCK) < 0) {
+		ret = -errno;
+		goto fail;
+	}
+
+	he->fds[he->count].fd = sock;
+	he->fds[he->count].events = ZSOCK_POLLOUT;
+	he->fds[he->count].revents = 0;
+	he->flags[he->count] = flags;
+	he->count++;
+
+	ret = zsock_connect(sock, ai->ai_addr, ai->ai_addrlen);
+	if (ret == 0) {
+		return 0;
+	}
+
+	if (errno == EINPROGRESS) {
+		return 1;
+	}
+
+	ret = -errno;
+	he->count--;
+
+fail:
+	NET_DBG("Cannot connect socket %d (%d)", sock, ret);
+	(void)zsock_close(sock);
+
+	return ret;
+}
+
+/* Check a pending attempt reported by poll(). Returns 0 if it connected and
+ * a negative errno value if it failed.
+ */
+static int check_attempt(struct zsock_pollfd *pfd)
+{
+	socklen_t optlen = sizeof(int);
+	int error = 0;
+
+	if (zsock_getsockopt(pfd->fd, SOL_SOCKET, SO_ERROR, &error, &optlen) < 0) {
+		return -errno;
+	}
+
+	if (error == 0 && (pfd->revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP | ZSOCK_POLLNVAL))) {
+		error = ECONNREFUSED;
+	}
+
+	return -error;
+}
+
+static void remove_attempt(struct happy_eyeballs *he, int i)
+{
+	he->count--;
+	he->fds[i] = he->fds[he->count];
+	he->flags[i] = he->flags[he->count];
+}
+
+/* Keep the socket of attempt i and close all the others. */
+static int finish(struct happy_eyeballs *he, int i)
+{
+	int sock = he->fds[i].fd;
+
+	(void)zsock_fcntl(sock, ZVFS_F_SETFL, he->flags[i]);
+
+	remove_attempt(he, i);
+
+	while (he->count > 0) {
+		(void)zsock_close(he->fds[--he->count].fd);
+	}
+
+	return sock;
+}
+
+int zsock_connect_happy(const struct zsock_addrinfo *res, int timeout)
+{
+	struct happy_eyeballs he = { 0 };
+	k_timepoint_t end, next_attempt;
+	const struct zsock_addrinfo *ai;
+	int error = EHOSTUNREACH;
+	int ret;
+
+	if (res == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	he.next_v6 = find_family(res, AF_INET6);
+	he.next_v4 = find_family(res, AF_INET);
+	he.prefer_v6 = true;
+
+	end = sys_timepoint_calc(timeout < 0 ? K_FOREVER : K_MSEC(timeout));
+	next_attempt = sys_timepoint_calc(K_NO_WAIT);
+
+	while (true) {
+		if (he.count < MAX_ATTEMPTS && has_next_addr(&he) &&
+		    (he.count == 0 || sys_timepoint_expired(next_attempt))) {
+			ai = next_addr(&he);
+
+			ret = start_attempt(&he, ai);
+			if (ret == 0) {
+				return finish(&he, he.count - 1);
+			}
+
+			if (ret < 0) {
+				/* Go on with the next address right away */
+				error = -ret;
+				continue;
+			}
+
+			next_attempt = sys_timepoint_calc(
+				K_MSEC(CONFIG_NET_SOCKETS_HAPPY_EYEBALLS_DELAY));
+		}
+
+		if (he.count == 0) {
+			/* All the addresses failed */
+			break;
+		}
+
+		if (sys_timepoint_expired(end)) {
+			error = ETIMEDOUT;
+			break;
+		}
+
+		if (he.count < MAX_ATTEMPTS && has_next_addr(&he) &&
+		    sys_timepoint_cmp(next_attempt, end) < 0) {
+			ret = zsock_poll(he.fds, he.count, poll_timeout(next_attempt));
+		} else {
+			ret = zsock_poll(he.fds, he.count, poll_timeout(end));
+		}
+
+		if (ret < 0) {
+			error = errno;
+			break;
+		}
+
+		for (int i = 0; i < he.count && ret > 0; i++) {
+			if (he.fds[i].revents == 0) {
+				continue;
+			}
+
+			ret--;
+
+			error = -check_attempt(&he.fds[i]);
+			if (error == 0) {
+				return finish(&he, i);
+			}
+
+			NET_DBG("Connection attempt on socket %d failed (%d)", he.fds[i].fd, error);
+
+			(void)zsock_close(he.fds[i].fd);
+			remove_attempt(&he, i);
+			i--;
+
+			/* Do not wait for the delay when an attempt fails */
+			next_attempt = sys_timepoint_calc(K_NO_WAIT);
+		}
+	}
+
+	while (he.count > 0) {
+		(void)zsock_close(he.fds[--he.count].fd);
+	}
+
+	errno = error;
+
+	return -1;
+}
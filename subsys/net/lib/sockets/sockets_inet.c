@@ -15,6 +15,7 @@ LOG_MODULE_DECLARE(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/mld.h>
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/net_pkt.h>
+#include <zephyr/net/ethernet.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/socket_types.h>
@@ -676,6 +677,66 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+ssize_t zsock_send_zerocopy(int sock, const void *buf, size_t len, int flags,
+			    zsock_zerocopy_cb_t cb, void *user_data)
+{
+	const struct fd_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	k_timepoint_t buf_timeout, end;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	int status;
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_STREAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+		buf_timeout = sys_timepoint_calc(K_NO_WAIT);
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_timepoint_calc(MAX_WAIT_BUFS);
+	}
+	end = sys_timepoint_calc(timeout);
+
+	while (1) {
+		status = net_context_send_zerocopy(ctx, buf, len, cb, user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				break;
+			}
+
+			/* Update the timeout value in case loop is repeated. */
+			timeout = sys_timepoint_timeout(end);
+
+			continue;
+		}
+
+		sock_obj_core_update_send_stats(sock, status);
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	return status;
+}
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
+
 ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 			  int flags)
 {
@@ -921,6 +982,41 @@ void net_socket_update_tc_rx_time(struct net_pkt *pkt, uint32_t end_tick)
 	}
 }
 
+#if defined(CONFIG_NET_CONTEXT_BUSY_POLL)
+/* Poll the driver for a while before sleeping, if the socket asks for it */
+static void zsock_busy_poll(struct net_context *ctx)
+{
+	struct net_if *iface = net_context_get_iface(ctx);
+	uint16_t busy_poll = ctx->options.busy_poll;
+	int64_t end;
+
+	if (busy_poll == 0U || iface == NULL) {
+		return;
+	}
+
+	end = k_uptime_ticks() + k_us_to_ticks_ceil64(busy_poll);
+
+	/* The receive callback needs the lock to queue the data */
+	(void)k_mutex_unlock(ctx->cond.lock);
+
+	while (k_fifo_is_empty(&ctx->recv_q) && k_uptime_ticks() < end) {
+		if (net_eth_napi_busy_poll(iface) < 0) {
+			break;
+		}
+
+		/* Let the RX thread pass on what was received */
+		k_yield();
+	}
+
+	(void)k_mutex_lock(ctx->cond.lock, K_FOREVER);
+}
+#else
+static inline void zsock_busy_poll(struct net_context *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+#endif /* CONFIG_NET_CONTEXT_BUSY_POLL */
+
 int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 {
 	int ret;
@@ -935,6 +1031,11 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 		return -EINVAL;
 	}
 
+	if (k_fifo_is_empty(&ctx->recv_q) &&
+	    !K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+		zsock_busy_poll(ctx);
+	}
+
 	if (k_fifo_is_empty(&ctx->recv_q)) {
 		/* Wait for the data to arrive but without holding a lock */
 		ret = k_condvar_wait(&ctx->cond.recv, ctx->cond.lock,
@@ -1077,6 +1178,40 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static ssize_t zsock_recv_dgram(struct net_context *ctx,
 				struct msghdr *msg,
 				void *buf,
@@ -1128,37 +1263,11 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1473,6 +1582,137 @@ static ssize_t zsock_recv_stream(struct net_context *ctx, struct msghdr *msg,
 	return recv_len;
 }
 
+/* Take the unread part of the packet data out of the packet */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt)
+{
+	struct net_buf *frags = pkt->buffer;
+	struct net_buf *cur = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+
+	pkt->buffer = NULL;
+	net_pkt_cursor_init(pkt);
+
+	/* Drop the headers and what was read already */
+	while (frags != NULL && frags != cur) {
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	if (frags != NULL) {
+		net_buf_pull(frags, pos - frags->data);
+		if (frags->len == 0) {
+			frags = net_buf_frag_del(NULL, frags);
+		}
+	}
+
+	return frags;
+}
+
+ssize_t zsock_recv_zerocopy(int sock, struct net_buf **frags, int flags,
+			    struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct fd_op_vtable *vtable;
+	k_timeout_t timeout = K_FOREVER;
+	enum net_sock_type sock_type;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	struct net_pkt *pkt;
+	ssize_t len, ret;
+
+	ctx = zvfs_get_fd_obj_and_vtable(sock, &vtable, &lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable != (const struct fd_op_vtable *)&sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*frags = NULL;
+	sock_type = net_context_get_type(ctx);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			ret = -ENOTCONN;
+			goto out;
+		}
+
+		if (sock_is_error(ctx)) {
+			ret = -POINTER_TO_INT(ctx->user_data);
+			goto out;
+		}
+
+		if (sock_is_eof(ctx)) {
+			ret = 0;
+			goto out;
+		}
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			goto out;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (pkt == NULL) {
+		/* Woken up by the peer closing the connection */
+		ret = (sock_type == SOCK_STREAM && sock_is_eof(ctx)) ? 0 : -EAGAIN;
+		goto out;
+	}
+
+	if (sock_type != SOCK_STREAM && src_addr != NULL && addrlen != NULL) {
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	*frags = sock_pkt_detach_data(pkt);
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+	sock_obj_core_update_recv_stats(sock, len);
+	ret = len;
+
+out:
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return ret;
+}
+
 ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 			   int flags,
 			   struct sockaddr *src_addr, socklen_t *addrlen)
@@ -1828,6 +2068,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			}
 			break;
 
+		case SO_BUSY_POLL:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_BUSY_POLL)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_BUSY_POLL,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+			break;
+
 		case SO_REUSEADDR:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEADDR)) {
 				ret = net_context_get_option(ctx,
@@ -1914,6 +2168,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2283,6 +2551,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_BUSY_POLL:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_BUSY_POLL)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_BUSY_POLL,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_REUSEADDR:
 			if (IS_ENABLED(CONFIG_NET_CONTEXT_REUSEADDR)) {
 				ret = net_context_set_option(ctx,
@@ -2543,6 +2826,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -47,8 +47,15 @@ LOG_MODULE_REGISTER(net_sock_tls, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <mbedtls/error.h>
 #include <mbedtls/platform.h>
 #include <mbedtls/ssl_cache.h>
+#include <mbedtls/ssl_ticket.h>
+#include <mbedtls/ssl_ciphersuites.h>
 #endif /* CONFIG_MBEDTLS */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+#include <zephyr/crypto/crypto.h>
+#include <zephyr/sys/byteorder.h>
+#endif
+
 #include "sockets_internal.h"
 #include "tls_internal.h"
 
@@ -107,6 +114,12 @@ struct tls_session_cache {
 	/** Peer address. */
 	struct sockaddr peer_addr;
 
+	/** Peer hostname, if set on the socket. Sessions of a named peer are
+	 *  looked up by hostname and port, so that they can be resumed with
+	 *  any address of the peer. Stored in the session buffer.
+	 */
+	const char *hostname;
+
 	/** Session buffer. */
 	uint8_t *session;
 
@@ -114,6 +127,54 @@ struct tls_session_cache {
 	size_t session_len;
 };
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+/** TLS 1.2 AES-GCM record layer handed over to a crypto driver once the
+ *  handshake is complete. Records are encrypted and decrypted in place in
+ *  the mbedTLS I/O buffers, which mbedTLS no longer uses at that point.
+ */
+struct tls_record_offload {
+	/** Crypto driver sessions. */
+	struct cipher_ctx enc;
+	struct cipher_ctx dec;
+
+	/** Write keys, used by the crypto driver for the whole session. */
+	uint8_t enc_key[32];
+	uint8_t dec_key[32];
+
+	/** Implicit part of the GCM nonces. */
+	uint8_t enc_salt[4];
+	uint8_t dec_salt[4];
+
+	/** Record sequence numbers. */
+	uint64_t enc_seq;
+	uint64_t dec_seq;
+
+	/** Max plaintext length of an outgoing record. */
+	size_t max_out;
+
+	/** Outgoing record being sent, and its plaintext length. */
+	size_t tx_len;
+	size_t tx_sent;
+	size_t tx_data_len;
+
+	/** Length of the incoming record received so far. */
+	size_t rx_len;
+
+	/** Decrypted data of the last incoming record not read yet. */
+	size_t rx_data_off;
+	size_t rx_data_len;
+
+	/** Master secret and randoms exported during the handshake. */
+	uint8_t master_secret[48];
+	uint8_t randbytes[64];
+	mbedtls_tls_prf_types prf_type;
+	bool secret_set;
+
+	/** Records are processed by the crypto driver. */
+	bool active;
+};
+#endif /* CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD */
+
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 struct tls_dtls_cid {
 	bool enabled;
@@ -246,6 +307,11 @@ __net_socket struct tls_context {
 #endif /* MBEDTLS_X509_CRT_PARSE_C */
 
 #endif /* CONFIG_MBEDTLS */
+
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	/** Record layer offloaded to a crypto driver. */
+	struct tls_record_offload record_offload;
+#endif
 };
 
 
@@ -258,6 +324,15 @@ static struct tls_session_cache client_cache[CONFIG_NET_SOCKETS_TLS_MAX_CLIENT_S
 static mbedtls_ssl_cache_context server_cache;
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+static mbedtls_ssl_ticket_context server_ticket;
+static bool server_ticket_ready;
+#endif
+
+/* Session cache lookups, see TLS_SESSION_CACHE_STATS. */
+static atomic_t session_cache_hits;
+static atomic_t session_cache_misses;
+
 /* A mutex for protecting TLS context allocation. */
 static struct k_mutex context_lock;
 
@@ -362,6 +437,9 @@ static int dtls_get_remaining_timeout(struct tls_context *ctx)
 /* Initialize TLS internals. */
 static int tls_init(void)
 {
+#if defined(MBEDTLS_SSL_TICKET_C)
+	int ret;
+#endif
 
 #if !defined(CONFIG_ENTROPY_HAS_DRIVER)
 	NET_WARN("No entropy device on the system, "
@@ -377,6 +455,19 @@ static int tls_init(void)
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	mbedtls_ssl_ticket_init(&server_ticket);
+
+	ret = mbedtls_ssl_ticket_setup(&server_ticket, tls_ctr_drbg_random, NULL,
+				       MBEDTLS_CIPHER_AES_256_GCM,
+				       CONFIG_NET_SOCKETS_TLS_SESSION_TICKET_LIFETIME);
+	if (ret != 0) {
+		NET_WARN("Failed to set up session tickets, err: -0x%x", -ret);
+	} else {
+		server_ticket_ready = true;
+	}
+#endif
+
 	return 0;
 }
 
@@ -535,6 +626,9 @@ static int tls_release(struct tls_context *tls)
 		return -EBADF;
 	}
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	tls_record_offload_stop(tls);
+#endif
 #if defined(CONFIG_NET_SOCKETS_ENABLE_DTLS)
 	mbedtls_ssl_cookie_free(&tls->cookie);
 #endif
@@ -575,10 +669,26 @@ static bool peer_addr_cmp(const struct sockaddr *addr,
 	return false;
 }
 
-static int tls_session_save(const struct sockaddr *peer_addr,
+static bool tls_session_match(const struct tls_session_cache *entry,
+			      const char *hostname,
+			      const struct sockaddr *peer_addr)
+{
+	if (hostname == NULL) {
+		return entry->hostname == NULL &&
+		       peer_addr_cmp(&entry->peer_addr, peer_addr);
+	}
+
+	/* Port is at the same offset in sockaddr_in and sockaddr_in6. */
+	return entry->hostname != NULL && strcmp(entry->hostname, hostname) == 0 &&
+	       net_sin(&entry->peer_addr)->sin_port == net_sin(peer_addr)->sin_port;
+}
+
+static int tls_session_save(const char *hostname,
+			    const struct sockaddr *peer_addr,
 			    mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
+	size_t hostname_len = 0;
 	size_t session_len;
 	int ret;
 
@@ -589,7 +699,7 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 				entry = &client_cache[i];
 			}
 		} else {
-			if (peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
+			if (tls_session_match(&client_cache[i], hostname, peer_addr)) {
 				/* Reuse old entry for given address. */
 				entry = &client_cache[i];
 				break;
@@ -609,11 +719,16 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 	if (entry->session != NULL) {
 		mbedtls_free(entry->session);
 		entry->session = NULL;
+		entry->hostname = NULL;
 	}
 
 	(void)mbedtls_ssl_session_save(session, NULL, 0, &session_len);
 
-	entry->session = mbedtls_calloc(1, session_len);
+	if (hostname != NULL) {
+		hostname_len = strlen(hostname) + 1;
+	}
+
+	entry->session = mbedtls_calloc(1, session_len + hostname_len);
 	if (entry->session == NULL) {
 		NET_ERR("Failed to allocate session buffer.");
 		return -ENOMEM;
@@ -628,6 +743,11 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 		return -ENOMEM;
 	}
 
+	if (hostname != NULL) {
+		memcpy(entry->session + session_len, hostname, hostname_len);
+		entry->hostname = (const char *)entry->session + session_len;
+	}
+
 	entry->session_len = session_len;
 	entry->timestamp = k_uptime_get();
 	memcpy(&entry->peer_addr, peer_addr, sizeof(*peer_addr));
@@ -635,7 +755,8 @@ static int tls_session_save(const struct sockaddr *peer_addr,
 	return 0;
 }
 
-static int tls_session_get(const struct sockaddr *peer_addr,
+static int tls_session_get(const char *hostname,
+			   const struct sockaddr *peer_addr,
 			   mbedtls_ssl_session *session)
 {
 	struct tls_session_cache *entry = NULL;
@@ -643,7 +764,7 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 
 	for (int i = 0; i < ARRAY_SIZE(client_cache); i++) {
 		if (client_cache[i].session != NULL &&
-		    peer_addr_cmp(&client_cache[i].peer_addr, peer_addr)) {
+		    tls_session_match(&client_cache[i], hostname, peer_addr)) {
 			entry = &client_cache[i];
 			break;
 		}
@@ -659,6 +780,7 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 		/* Discard corrupted session data. */
 		mbedtls_free(entry->session);
 		entry->session = NULL;
+		entry->hostname = NULL;
 		NET_ERR("Failed to load TLS session %d", ret);
 		return -EIO;
 	}
@@ -666,6 +788,19 @@ static int tls_session_get(const struct sockaddr *peer_addr,
 	return 0;
 }
 
+/* Hostname the session cache is keyed by, NULL to use the peer address. */
+static const char *tls_session_hostname(struct tls_context *context)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+	if (context->options.is_hostname_set && context->ssl.hostname != NULL &&
+	    context->ssl.hostname[0] != '\0') {
+		return context->ssl.hostname;
+	}
+#endif
+
+	return NULL;
+}
+
 static void tls_session_store(struct tls_context *context,
 			      const struct sockaddr *addr,
 			      socklen_t addrlen)
@@ -687,7 +822,7 @@ static void tls_session_store(struct tls_context *context,
 		goto exit;
 	}
 
-	ret = tls_session_save(&peer_addr, &session);
+	ret = tls_session_save(tls_session_hostname(context), &peer_addr, &session);
 	if (ret < 0) {
 		NET_ERR("Failed to save session for %p", context);
 	}
@@ -711,12 +846,15 @@ static void tls_session_restore(struct tls_context *context,
 	memcpy(&peer_addr, addr, addrlen);
 	mbedtls_ssl_session_init(&session);
 
-	ret = tls_session_get(&peer_addr, &session);
+	ret = tls_session_get(tls_session_hostname(context), &peer_addr, &session);
 	if (ret < 0) {
 		NET_DBG("Session not found for %p", context);
+		atomic_inc(&session_cache_misses);
 		goto exit;
 	}
 
+	atomic_inc(&session_cache_hits);
+
 	ret = mbedtls_ssl_set_session(&context->ssl, &session);
 	if (ret < 0) {
 		NET_ERR("Failed to set session for %p", context);
@@ -726,6 +864,50 @@ exit:
 	mbedtls_ssl_session_free(&session);
 }
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+/* TLS 1.3 tickets are received after the handshake, store the session again
+ * when one arrives.
+ */
+static void tls_session_ticket_store(struct tls_context *context)
+{
+	struct sockaddr peer_addr;
+	socklen_t addrlen = sizeof(peer_addr);
+
+	if (context->type != SOCK_STREAM ||
+	    zsock_getpeername(context->sock, &peer_addr, &addrlen) < 0) {
+		return;
+	}
+
+	tls_session_store(context, &peer_addr, addrlen);
+}
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+static int tls_server_cache_get(void *data, unsigned char const *session_id,
+				size_t session_id_len, mbedtls_ssl_session *session)
+{
+	int ret;
+
+	ret = mbedtls_ssl_cache_get(data, session_id, session_id_len, session);
+	atomic_inc(ret == 0 ? &session_cache_hits : &session_cache_misses);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_CACHE_C */
+
+#if defined(MBEDTLS_SSL_TICKET_C)
+static int tls_server_ticket_parse(void *p_ticket, mbedtls_ssl_session *session,
+				   unsigned char *buf, size_t len)
+{
+	int ret;
+
+	ret = mbedtls_ssl_ticket_parse(p_ticket, session, buf, len);
+	atomic_inc(ret == 0 ? &session_cache_hits : &session_cache_misses);
+
+	return ret;
+}
+#endif /* MBEDTLS_SSL_TICKET_C */
+
 static void tls_session_purge(void)
 {
 	tls_session_cache_reset();
@@ -734,6 +916,9 @@ static void tls_session_purge(void)
 	mbedtls_ssl_cache_free(&server_cache);
 	mbedtls_ssl_cache_init(&server_cache);
 #endif
+
+	atomic_clear(&session_cache_hits);
+	atomic_clear(&session_cache_misses);
 }
 
 static inline int time_left(uint32_t start, uint32_t timeout)
@@ -952,6 +1137,433 @@ static int tls_rx(void *ctx, unsigned char *buf, size_t len)
 	return received;
 }
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+#define TLS_RECORD_OFFLOAD_DEV DEVICE_DT_GET(DT_CHOSEN(zephyr_crypto))
+
+#define TLS_RECORD_HEADER_LEN 5
+#define TLS_RECORD_NONCE_LEN 8
+#define TLS_RECORD_TAG_LEN 16
+#define TLS_RECORD_SALT_LEN 4
+#define TLS_RECORD_OVERHEAD \
+	(TLS_RECORD_HEADER_LEN + TLS_RECORD_NONCE_LEN + TLS_RECORD_TAG_LEN)
+#define TLS_RECORD_AAD_LEN 13
+
+#define TLS_RECORD_TYPE_ALERT 21
+#define TLS_RECORD_TYPE_HANDSHAKE 22
+#define TLS_RECORD_TYPE_APP_DATA 23
+
+#define TLS_RECORD_CAPS (CAP_RAW_KEY | CAP_INPLACE_OPS | CAP_SYNC_OPS)
+
+static void tls_record_offload_export_keys(void *p_expkey,
+					   mbedtls_ssl_key_export_type type,
+					   const unsigned char *secret,
+					   size_t secret_len,
+					   const unsigned char client_random[32],
+					   const unsigned char server_random[32],
+					   mbedtls_tls_prf_types tls_prf_type)
+{
+	struct tls_record_offload *ro = p_expkey;
+
+	if (type != MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET ||
+	    secret_len != sizeof(ro->master_secret)) {
+		return;
+	}
+
+	memcpy(ro->master_secret, secret, secret_len);
+	/* Order used by the key expansion. */
+	memcpy(ro->randbytes, server_random, 32);
+	memcpy(ro->randbytes + 32, client_random, 32);
+	ro->prf_type = tls_prf_type;
+	ro->secret_set = true;
+}
+
+static void tls_record_offload_stop(struct tls_context *ctx)
+{
+	struct tls_record_offload *ro = &ctx->record_offload;
+
+	if (ro->active) {
+		/* Let mbedTLS take over again, for instance to send the
+		 * close notification.
+		 */
+		sys_put_be64(ro->enc_seq, ctx->ssl.cur_out_ctr);
+
+		(void)cipher_free_session(TLS_RECORD_OFFLOAD_DEV, &ro->enc);
+		(void)cipher_free_session(TLS_RECORD_OFFLOAD_DEV, &ro->dec);
+	}
+
+	mbedtls_platform_zeroize(ro, sizeof(*ro));
+}
+
+static int tls_record_offload_session(struct cipher_ctx *cipher,
+				      const uint8_t *key, size_t keylen,
+				      enum cipher_op op)
+{
+	cipher->keylen = keylen;
+	cipher->key.bit_stream = key;
+	cipher->flags = TLS_RECORD_CAPS;
+	cipher->mode_params.gcm_info.tag_len = TLS_RECORD_TAG_LEN;
+	cipher->mode_params.gcm_info.nonce_len = TLS_RECORD_SALT_LEN +
+						 TLS_RECORD_NONCE_LEN;
+
+	return cipher_begin_session(TLS_RECORD_OFFLOAD_DEV, cipher,
+				    CRYPTO_CIPHER_ALGO_AES,
+				    CRYPTO_CIPHER_MODE_GCM, op);
+}
+
+/* Hand the record layer over to the crypto driver if the session allows it:
+ * TLS 1.2 over TCP with an AES-GCM ciphersuite, and no record buffered by
+ * mbedTLS. Otherwise mbedTLS keeps processing the records.
+ */
+static void tls_record_offload_start(struct tls_context *ctx)
+{
+	struct tls_record_offload *ro = &ctx->record_offload;
+	const mbedtls_ssl_ciphersuite_t *suite;
+	const uint8_t *client_key, *server_key;
+	uint8_t key_block[2 * 32 + 2 * TLS_RECORD_SALT_LEN];
+	bool is_server;
+	size_t keylen;
+	int ret;
+
+	if (ctx->type != SOCK_STREAM || !ro->secret_set ||
+	    mbedtls_ssl_get_version_number(&ctx->ssl) != MBEDTLS_SSL_VERSION_TLS1_2 ||
+	    ctx->ssl.in_left != 0 || ctx->ssl.in_msglen != 0 ||
+	    ctx->ssl.out_left != 0) {
+		goto fallback;
+	}
+
+	suite = mbedtls_ssl_ciphersuite_from_id(
+			mbedtls_ssl_get_ciphersuite_id_from_ssl(&ctx->ssl));
+	if (suite == NULL) {
+		goto fallback;
+	}
+
+	if (suite->cipher == MBEDTLS_CIPHER_AES_128_GCM) {
+		keylen = 16;
+	} else if (suite->cipher == MBEDTLS_CIPHER_AES_256_GCM) {
+		keylen = 32;
+	} else {
+		goto fallback;
+	}
+
+	if (!device_is_ready(TLS_RECORD_OFFLOAD_DEV) ||
+	    (crypto_query_hwcaps(TLS_RECORD_OFFLOAD_DEV) & TLS_RECORD_CAPS) !=
+	    TLS_RECORD_CAPS) {
+		goto fallback;
+	}
+
+	ret = mbedtls_ssl_get_max_out_record_payload(&ctx->ssl);
+	if (ret <= 0) {
+		goto fallback;
+	}
+
+	ro->max_out = MIN((size_t)ret, MBEDTLS_SSL_OUT_CONTENT_LEN);
+
+	/* client_write_key, server_write_key, client_write_IV,
+	 * server_write_IV. AEAD ciphers have no MAC keys.
+	 */
+	ret = mbedtls_ssl_tls_prf(ro->prf_type, ro->master_secret,
+				  sizeof(ro->master_secret), "key expansion",
+				  ro->randbytes, sizeof(ro->randbytes),
+				  key_block, 2 * keylen + 2 * TLS_RECORD_SALT_LEN);
+	if (ret != 0) {
+		goto fallback;
+	}
+
+	client_key = key_block;
+	server_key = key_block + keylen;
+	is_server = mbedtls_ssl_conf_get_endpoint(&ctx->config) == MBEDTLS_SSL_IS_SERVER;
+
+	memcpy(ro->enc_key, is_server ? server_key : client_key, keylen);
+	memcpy(ro->dec_key, is_server ? client_key : server_key, keylen);
+	memcpy(ro->enc_salt, key_block + 2 * keylen +
+	       (is_server ? TLS_RECORD_SALT_LEN : 0), TLS_RECORD_SALT_LEN);
+	memcpy(ro->dec_salt, key_block + 2 * keylen +
+	       (is_server ? 0 : TLS_RECORD_SALT_LEN), TLS_RECORD_SALT_LEN);
+	mbedtls_platform_zeroize(key_block, sizeof(key_block));
+
+	ret = tls_record_offload_session(&ro->enc, ro->enc_key, keylen,
+					 CRYPTO_CIPHER_OP_ENCRYPT);
+	if (ret < 0) {
+		goto fallback;
+	}
+
+	ret = tls_record_offload_session(&ro->dec, ro->dec_key, keylen,
+					 CRYPTO_CIPHER_OP_DECRYPT);
+	if (ret < 0) {
+		(void)cipher_free_session(TLS_RECORD_OFFLOAD_DEV, &ro->enc);
+		goto fallback;
+	}
+
+	/* Continue from the sequence numbers of the handshake records. */
+	ro->enc_seq = sys_get_be64(ctx->ssl.cur_out_ctr);
+	ro->dec_seq = sys_get_be64(ctx->ssl.in_ctr);
+
+	mbedtls_platform_zeroize(ro->master_secret, sizeof(ro->master_secret));
+	ro->active = true;
+
+	NET_DBG("TLS records of %p offloaded to %s", ctx, TLS_RECORD_OFFLOAD_DEV->name);
+
+	return;
+
+fallback:
+	tls_record_offload_stop(ctx);
+}
+
+static void tls_record_offload_aad(uint8_t *aad, uint64_t seq, uint8_t type,
+				   size_t len)
+{
+	sys_put_be64(seq, aad);
+	aad[8] = type;
+	aad[9] = MBEDTLS_SSL_MAJOR_VERSION_3;
+	aad[10] = MBEDTLS_SSL_MINOR_VERSION_3;
+	sys_put_be16(len, &aad[11]);
+}
+
+/* Encrypt the len bytes of plaintext following the record header and
+ * explicit nonce in rec.
+ */
+static int tls_record_offload_encrypt(struct tls_record_offload *ro,
+				      uint8_t *rec, size_t len)
+{
+	uint8_t nonce[TLS_RECORD_SALT_LEN + TLS_RECORD_NONCE_LEN];
+	uint8_t aad[TLS_RECORD_AAD_LEN];
+	uint8_t *data = rec + TLS_RECORD_HEADER_LEN + TLS_RECORD_NONCE_LEN;
+	struct cipher_pkt pkt = {
+		.in_buf = data,
+		.in_len = len,
+		.out_buf = data,
+		.out_buf_max = len,
+	};
+	struct cipher_aead_pkt aead = {
+		.pkt = &pkt,
+		.ad = aad,
+		.ad_len = sizeof(aad),
+		.tag = data + len,
+	};
+	int ret;
+
+	rec[0] = TLS_RECORD_TYPE_APP_DATA;
+	rec[1] = MBEDTLS_SSL_MAJOR_VERSION_3;
+	rec[2] = MBEDTLS_SSL_MINOR_VERSION_3;
+	sys_put_be16(len + TLS_RECORD_NONCE_LEN + TLS_RECORD_TAG_LEN, &rec[3]);
+
+	/* The sequence number is used as the explicit nonce. */
+	sys_put_be64(ro->enc_seq, &rec[TLS_RECORD_HEADER_LEN]);
+	memcpy(nonce, ro->enc_salt, TLS_RECORD_SALT_LEN);
+	memcpy(nonce + TLS_RECORD_SALT_LEN, &rec[TLS_RECORD_HEADER_LEN],
+	       TLS_RECORD_NONCE_LEN);
+
+	tls_record_offload_aad(aad, ro->enc_seq, TLS_RECORD_TYPE_APP_DATA, len);
+
+	ret = cipher_gcm_op(&ro->enc, &aead, nonce);
+	if (ret < 0) {
+		NET_ERR("Record encryption failed (%d)", ret);
+		return MBEDTLS_ERR_SSL_INTERNAL_ERROR;
+	}
+
+	ro->enc_seq++;
+
+	return 0;
+}
+
+static int tls_record_offload_write(struct tls_context *ctx,
+				    const uint8_t *buf, size_t len)
+{
+	struct tls_record_offload *ro = &ctx->record_offload;
+	uint8_t *rec = ctx->ssl.out_buf;
+	int ret;
+
+	/* As with mbedtls_ssl_write(), a record not sent completely is
+	 * flushed on the next call, which reports its length.
+	 */
+	if (ro->tx_len == 0) {
+		len = MIN(len, ro->max_out);
+
+		memcpy(rec + TLS_RECORD_HEADER_LEN + TLS_RECORD_NONCE_LEN, buf, len);
+
+		ret = tls_record_offload_encrypt(ro, rec, len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ro->tx_len = len + TLS_RECORD_OVERHEAD;
+		ro->tx_sent = 0;
+		ro->tx_data_len = len;
+	}
+
+	while (ro->tx_sent < ro->tx_len) {
+		ret = tls_tx(ctx, rec + ro->tx_sent, ro->tx_len - ro->tx_sent);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ro->tx_sent += ret;
+	}
+
+	ro->tx_len = 0;
+
+	return ro->tx_data_len;
+}
+
+/* Decrypt and process the complete record in rec. */
+static int tls_record_offload_process(struct tls_record_offload *ro,
+				      uint8_t *rec, size_t rec_len)
+{
+	uint8_t nonce[TLS_RECORD_SALT_LEN + TLS_RECORD_NONCE_LEN];
+	uint8_t aad[TLS_RECORD_AAD_LEN];
+	uint8_t *data = rec + TLS_RECORD_HEADER_LEN + TLS_RECORD_NONCE_LEN;
+	size_t len = rec_len - TLS_RECORD_OVERHEAD;
+	struct cipher_pkt pkt = {
+		.in_buf = data,
+		.in_len = len,
+		.out_buf = data,
+		.out_buf_max = len,
+	};
+	struct cipher_aead_pkt aead = {
+		.pkt = &pkt,
+		.ad = aad,
+		.ad_len = sizeof(aad),
+		.tag = data + len,
+	};
+	uint8_t type = rec[0];
+	int ret;
+
+	memcpy(nonce, ro->dec_salt, TLS_RECORD_SALT_LEN);
+	memcpy(nonce + TLS_RECORD_SALT_LEN, &rec[TLS_RECORD_HEADER_LEN],
+	       TLS_RECORD_NONCE_LEN);
+
+	tls_record_offload_aad(aad, ro->dec_seq, type, len);
+
+	ret = cipher_gcm_op(&ro->dec, &aead, nonce);
+	if (ret < 0) {
+		NET_ERR("Record decryption failed (%d)", ret);
+		return MBEDTLS_ERR_SSL_INVALID_MAC;
+	}
+
+	ro->dec_seq++;
+
+	switch (type) {
+	case TLS_RECORD_TYPE_APP_DATA:
+		ro->rx_data_off = data - rec;
+		ro->rx_data_len = len;
+		return 0;
+
+	case TLS_RECORD_TYPE_ALERT:
+		if (len != 2) {
+			return MBEDTLS_ERR_SSL_INVALID_RECORD;
+		}
+
+		if (data[1] == MBEDTLS_SSL_ALERT_MSG_CLOSE_NOTIFY) {
+			return MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY;
+		}
+
+		if (data[0] == MBEDTLS_SSL_ALERT_LEVEL_FATAL) {
+			return MBEDTLS_ERR_SSL_FATAL_ALERT_MESSAGE;
+		}
+
+		return 0;
+
+	default:
+		/* Renegotiation is not supported, ignore the request. */
+		NET_DBG("Ignoring handshake message");
+		return 0;
+	}
+}
+
+static int tls_record_offload_read(struct tls_context *ctx, uint8_t *buf,
+				   size_t len)
+{
+	struct tls_record_offload *ro = &ctx->record_offload;
+	uint8_t *rec = ctx->ssl.in_buf;
+	size_t rec_len;
+	int ret;
+
+	while (ro->rx_data_len == 0) {
+		rec_len = TLS_RECORD_HEADER_LEN;
+
+		if (ro->rx_len >= TLS_RECORD_HEADER_LEN) {
+			rec_len += sys_get_be16(&rec[3]);
+
+			if ((rec[0] != TLS_RECORD_TYPE_ALERT &&
+			     rec[0] != TLS_RECORD_TYPE_HANDSHAKE &&
+			     rec[0] != TLS_RECORD_TYPE_APP_DATA) ||
+			    rec[1] != MBEDTLS_SSL_MAJOR_VERSION_3 ||
+			    rec[2] != MBEDTLS_SSL_MINOR_VERSION_3 ||
+			    rec_len < TLS_RECORD_OVERHEAD ||
+			    rec_len > MBEDTLS_SSL_IN_CONTENT_LEN + TLS_RECORD_OVERHEAD) {
+				return MBEDTLS_ERR_SSL_INVALID_RECORD;
+			}
+		}
+
+		if (ro->rx_len < rec_len) {
+			ret = tls_rx(ctx, rec + ro->rx_len, rec_len - ro->rx_len);
+			if (ret < 0) {
+				return ret;
+			}
+
+			if (ret == 0) {
+				return MBEDTLS_ERR_SSL_CONN_EOF;
+			}
+
+			ro->rx_len += ret;
+			continue;
+		}
+
+		ro->rx_len = 0;
+
+		ret = tls_record_offload_process(ro, rec, rec_len);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	len = MIN(len, ro->rx_data_len);
+	if (len > 0) {
+		memcpy(buf, rec + ro->rx_data_off, len);
+		ro->rx_data_off += len;
+		ro->rx_data_len -= len;
+	}
+
+	return len;
+}
+#endif /* CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD */
+
+/* mbedtls_ssl_read(), mbedtls_ssl_write() and mbedtls_ssl_get_bytes_avail()
+ * for application data, going through the offloaded record layer if active.
+ */
+static int tls_ssl_read(struct tls_context *ctx, uint8_t *buf, size_t len)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	if (ctx->record_offload.active) {
+		return tls_record_offload_read(ctx, buf, len);
+	}
+#endif
+
+	return mbedtls_ssl_read(&ctx->ssl, buf, len);
+}
+
+static int tls_ssl_write(struct tls_context *ctx, const uint8_t *buf, size_t len)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	if (ctx->record_offload.active) {
+		return tls_record_offload_write(ctx, buf, len);
+	}
+#endif
+
+	return mbedtls_ssl_write(&ctx->ssl, buf, len);
+}
+
+static size_t tls_ssl_get_bytes_avail(struct tls_context *ctx)
+{
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	if (ctx->record_offload.active) {
+		return ctx->record_offload.rx_data_len;
+	}
+#endif
+
+	return mbedtls_ssl_get_bytes_avail(&ctx->ssl);
+}
+
 #if defined(MBEDTLS_X509_CRT_PARSE_C)
 static bool crt_is_pem(const unsigned char *buf, size_t buflen)
 {
@@ -1167,6 +1779,10 @@ static int tls_mbedtls_reset(struct tls_context *context)
 {
 	int ret;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	tls_record_offload_stop(context);
+#endif
+
 	ret = mbedtls_ssl_session_reset(&context->ssl);
 	if (ret != 0) {
 		return ret;
@@ -1281,6 +1897,9 @@ static int tls_mbedtls_handshake(struct tls_context *context,
 	}
 
 	if (ret == 0) {
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+		tls_record_offload_start(context);
+#endif
 		k_sem_give(&context->tls_established);
 	}
 
@@ -1420,11 +2039,20 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 #if defined(MBEDTLS_SSL_CACHE_C)
 	if (is_server && context->options.cache_enabled) {
 		mbedtls_ssl_conf_session_cache(&context->config, &server_cache,
-					       mbedtls_ssl_cache_get,
+					       tls_server_cache_get,
 					       mbedtls_ssl_cache_set);
 	}
 #endif
 
+#if defined(MBEDTLS_SSL_TICKET_C)
+	if (is_server && context->options.cache_enabled && server_ticket_ready) {
+		mbedtls_ssl_conf_session_tickets_cb(&context->config,
+						    mbedtls_ssl_ticket_write,
+						    tls_server_ticket_parse,
+						    &server_ticket);
+	}
+#endif
+
 #if defined(MBEDTLS_SSL_EARLY_DATA)
 	mbedtls_ssl_conf_early_data(&context->config, MBEDTLS_SSL_EARLY_DATA_ENABLED);
 #endif
@@ -1459,6 +2087,12 @@ static int tls_mbedtls_init(struct tls_context *context, bool is_server)
 	}
 #endif /* CONFIG_NET_SOCKETS_ENABLE_DTLS && CONFIG_MBEDTLS_SSL_DTLS_CONNECTION_ID */
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	mbedtls_ssl_set_export_keys_cb(&context->ssl,
+				       tls_record_offload_export_keys,
+				       &context->record_offload);
+#endif
+
 	context->is_initialized = true;
 
 	return 0;
@@ -1957,6 +2591,23 @@ static int tls_opt_session_cache_get(struct tls_context *context,
 	return 0;
 }
 
+static int tls_opt_session_cache_stats_get(struct tls_context *context,
+					   void *optval, socklen_t *optlen)
+{
+	struct tls_session_cache_stats *stats = optval;
+
+	ARG_UNUSED(context);
+
+	if (*optlen != sizeof(*stats)) {
+		return -EINVAL;
+	}
+
+	stats->hits = (uint32_t)atomic_get(&session_cache_hits);
+	stats->misses = (uint32_t)atomic_get(&session_cache_misses);
+
+	return 0;
+}
+
 static int tls_opt_cert_verify_result_get(struct tls_context *context,
 					  void *optval, socklen_t *optlen)
 {
@@ -2175,6 +2826,10 @@ int ztls_close_ctx(struct tls_context *ctx, int sock)
 	/* Try to send close notification. */
 	ctx->flags = 0;
 
+#if defined(CONFIG_NET_SOCKETS_TLS_RECORD_OFFLOAD)
+	tls_record_offload_stop(ctx);
+#endif
+
 	(void)mbedtls_ssl_close_notify(&ctx->ssl);
 
 	err = tls_release(ctx);
@@ -2361,7 +3016,7 @@ static ssize_t send_tls(struct tls_context *ctx, const void *buf,
 	end = sys_timepoint_calc(timeout);
 
 	do {
-		ret = mbedtls_ssl_write(&ctx->ssl, buf, len);
+		ret = tls_ssl_write(ctx, buf, len);
 		if (ret >= 0) {
 			return ret;
 		}
@@ -2656,8 +3311,7 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 	do {
 		size_t read_len = max_len - recv_len;
 
-		ret = mbedtls_ssl_read(&ctx->ssl, (uint8_t *)buf + recv_len,
-				       read_len);
+		ret = tls_ssl_read(ctx, (uint8_t *)buf + recv_len, read_len);
 		if (ret < 0) {
 			if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
 				/* Peer notified that it's closing the
@@ -2676,6 +3330,12 @@ static ssize_t recv_tls(struct tls_context *ctx, void *buf,
 				break;
 			}
 
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+			if (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
+				tls_session_ticket_store(ctx);
+			}
+#endif
+
 			if (ret == MBEDTLS_ERR_SSL_WANT_READ ||
 			    ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
 			    ret == MBEDTLS_ERR_SSL_ASYNC_IN_PROGRESS ||
@@ -3043,7 +3703,7 @@ static int ztls_poll_prepare_pollin(struct tls_context *ctx)
 	 * so we won't block in the k_poll.
 	 */
 	if (!ctx->is_listening) {
-		if (mbedtls_ssl_get_bytes_avail(&ctx->ssl) > 0) {
+		if (tls_ssl_get_bytes_avail(ctx) > 0) {
 			return -EALREADY;
 		}
 	}
@@ -3155,7 +3815,7 @@ static int ztls_socket_data_check(struct tls_context *ctx)
 
 	ctx->flags = ZSOCK_MSG_DONTWAIT;
 
-	ret = mbedtls_ssl_read(&ctx->ssl, NULL, 0);
+	ret = tls_ssl_read(ctx, NULL, 0);
 	if (ret < 0) {
 		if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY) {
 			/* Don't reset the context for STREAM socket - the
@@ -3198,7 +3858,7 @@ static int ztls_socket_data_check(struct tls_context *ctx)
 		return -ECONNABORTED;
 	}
 
-	return mbedtls_ssl_get_bytes_avail(&ctx->ssl);
+	return tls_ssl_get_bytes_avail(ctx);
 }
 
 static int ztls_poll_update_pollin(int fd, struct tls_context *ctx,
@@ -3208,7 +3868,7 @@ static int ztls_poll_update_pollin(int fd, struct tls_context *ctx,
 
 	if (!ctx->is_listening) {
 		/* Already had TLS data to read on socket. */
-		if (mbedtls_ssl_get_bytes_avail(&ctx->ssl) > 0) {
+		if (tls_ssl_get_bytes_avail(ctx) > 0) {
 			pfd->revents |= ZSOCK_POLLIN;
 			goto next;
 		}
@@ -3553,6 +4213,10 @@ int ztls_getsockopt_ctx(struct tls_context *ctx, int level, int optname,
 		err = tls_opt_session_cache_get(ctx, optval, optlen);
 		break;
 
+	case TLS_SESSION_CACHE_STATS:
+		err = tls_opt_session_cache_stats_get(ctx, optval, optlen);
+		break;
+
 	case TLS_CERT_VERIFY_RESULT:
 		err = tls_opt_cert_verify_result_get(ctx, optval, optlen);
 		break;
@@ -32,6 +32,9 @@ static struct k_work_q pm_device_runtime_wq;
 
 #define EVENT_MASK		(EVENT_STATE_ACTIVE | EVENT_STATE_SUSPENDED)
 
+/* runtime_suspend() left the suspension, and putting the domain, to the work */
+#define SUSPEND_QUEUED		1
+
 /**
  * @brief Suspend a device
  *
@@ -45,7 +48,8 @@ static struct k_work_q pm_device_runtime_wq;
  * @param async Perform operation asynchronously.
  * @param delay Period to delay the asynchronous operation.
  *
- * @retval 0 If device has been suspended or queued for suspend.
+ * @retval 0 If device has been suspended or is still in use.
+ * @retval SUSPEND_QUEUED If device has been queued for suspend.
  * @retval -EALREADY If device is already suspended (can only happen if get/put
  * calls are unbalanced).
  * @retval -EBUSY If the device is busy.
@@ -93,6 +97,7 @@ static int runtime_suspend(const struct device *dev, bool async,
 #else
 		(void)k_work_schedule_for_queue(&pm_device_runtime_wq, &pm->work, delay);
 #endif /* CONFIG_PM_DEVICE_RUNTIME_USE_SYSTEM_WQ */
+		ret = SUSPEND_QUEUED;
 #endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
 	} else {
 		/* suspend now */
@@ -250,6 +255,13 @@ int pm_device_runtime_get(const struct device *dev)
 	if ((pm->base.state == PM_DEVICE_STATE_SUSPENDING) &&
 		((k_work_cancel_delayable(&pm->work) & K_WORK_RUNNING) == 0)) {
 		pm->base.state = PM_DEVICE_STATE_ACTIVE;
+		/*
+		 * The cancelled work would have put the domain, the claim
+		 * taken above is one too many.
+		 */
+		if (domain != NULL) {
+			(void)pm_device_runtime_put(domain);
+		}
 		goto unlock;
 	}
 
@@ -349,13 +361,21 @@ int pm_device_runtime_put(const struct device *dev)
 
 		k_spin_unlock(&pm_sync->lock, k);
 	} else {
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+		uint32_t delay = dev->pm->autosuspend_delay;
+
+		ret = runtime_suspend(dev, delay != 0U, K_MSEC(delay));
+#else
 		ret = runtime_suspend(dev, false, K_NO_WAIT);
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
 
 		/*
-		 * Now put the domain
+		 * Now put the domain, unless the queued suspend does it
 		 */
-		if ((ret == 0) &&
-		    atomic_test_bit(&dev->pm_base->flags, PM_DEVICE_FLAG_PD_CLAIMED)) {
+		if (ret == SUSPEND_QUEUED) {
+			ret = 0;
+		} else if ((ret == 0) &&
+			   atomic_test_bit(&dev->pm_base->flags, PM_DEVICE_FLAG_PD_CLAIMED)) {
 			ret = pm_device_runtime_put(PM_DOMAIN(dev->pm_base));
 		}
 	}
@@ -383,6 +403,9 @@ int pm_device_runtime_put_async(const struct device *dev, k_timeout_t delay)
 		k_spin_unlock(&pm_sync->lock, k);
 	} else {
 		ret = runtime_suspend(dev, true, delay);
+		if (ret == SUSPEND_QUEUED) {
+			ret = 0;
+		}
 	}
 	SYS_PORT_TRACING_FUNC_EXIT(pm, device_runtime_put_async, dev, delay, ret);
 
@@ -393,6 +416,25 @@ int pm_device_runtime_put_async(const struct device *dev, k_timeout_t delay)
 #endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
 }
 
+int pm_device_runtime_autosuspend_delay_set(const struct device *dev, uint32_t delay_ms)
+{
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+	if ((dev->pm_base == NULL) ||
+	    atomic_test_bit(&dev->pm_base->flags, PM_DEVICE_FLAG_ISR_SAFE)) {
+		return -ENOTSUP;
+	}
+
+	dev->pm->autosuspend_delay = delay_ms;
+
+	return 0;
+#else
+	ARG_UNUSED(dev);
+	ARG_UNUSED(delay_ms);
+
+	return -ENOSYS;
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+}
+
 __boot_func
 int pm_device_runtime_auto_enable(const struct device *dev)
 {
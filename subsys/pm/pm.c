@@ -103,6 +103,11 @@ void pm_system_resume(void)
 	 * The kernel scheduler will get control after the ISR finishes
 	 * and it may schedule another thread.
 	 */
+#ifdef CONFIG_PM_POLICY_MENU
+	/* Before any woken thread runs, the idle period ends here */
+	pm_policy_menu_idle_exit(id);
+#endif /* CONFIG_PM_POLICY_MENU */
+
 	if (atomic_test_and_clear_bit(z_post_ops_required, id)) {
 #ifdef CONFIG_PM_DEVICE_SYSTEM_MANAGED
 		if (atomic_add(&_cpus_active, 1) == 0) {
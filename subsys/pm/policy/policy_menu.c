@@ -0,0 +1,287 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/policy.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Idle residency prediction, after the Linux "menu" cpuidle governor.
+ *
+ * The time until the next event is an upper bound of the idle residency,
+ * interrupts often end idle periods much earlier. Two estimates are thus
+ * combined, and the smallest one is used to pick a state:
+ *
+ * - The time to the next event scaled by a correction factor, the decaying
+ *   average of measured over expected residency. Factors are kept per
+ *   order of magnitude of the expected residency.
+ * - The average of the last few idle periods, when they are regular enough
+ *   (standard deviation below a sixth of the average once outliers have
+ *   been discarded).
+ */
+
+#define MENU_RESOLUTION 1024U
+#define MENU_DECAY 8U
+#define MENU_UNITY (MENU_RESOLUTION * MENU_DECAY)
+#define MENU_FACTORS 6U
+#define MENU_HISTORY 8U
+
+/* Power states are described per devicetree CPU node */
+#define MENU_NUM_CPUS MAX(DT_CHILD_NUM_STATUS_OKAY(DT_PATH(cpus)), CONFIG_MP_MAX_NUM_CPUS)
+
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+typedef uint64_t menu_cycles_t;
+#define menu_cycle_get() k_cycle_get_64()
+#else
+typedef uint32_t menu_cycles_t;
+#define menu_cycle_get() k_cycle_get_32()
+#endif /* CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER */
+
+struct menu_cpu {
+	uint32_t factors[MENU_FACTORS];
+	uint32_t intervals[MENU_HISTORY];
+	uint8_t next_interval;
+	uint8_t num_intervals;
+
+	/* Idle period in progress */
+	bool pending;
+	uint8_t factor;
+	uint32_t expected_us;
+	int chosen;
+	menu_cycles_t start;
+
+	struct pm_policy_menu_stats stats;
+};
+
+static struct menu_cpu menu_cpus[MENU_NUM_CPUS];
+static struct k_spinlock menu_lock;
+
+static uint8_t menu_factor_index(uint32_t expected_us)
+{
+	uint8_t i = 0U;
+
+	for (uint32_t limit = 10U; (i < (MENU_FACTORS - 1U)) && (expected_us >= limit);
+	     limit *= 10U) {
+		i++;
+	}
+
+	return i;
+}
+
+static uint32_t menu_factor_get(struct menu_cpu *menu, uint8_t i)
+{
+	/* Zero means not yet trained, i.e. trust the next event */
+	return (menu->factors[i] == 0U) ? MENU_UNITY : menu->factors[i];
+}
+
+static uint32_t menu_typical_interval(struct menu_cpu *menu)
+{
+	uint32_t thresh = UINT32_MAX;
+
+	if (menu->num_intervals < MENU_HISTORY) {
+		return UINT32_MAX;
+	}
+
+	for (;;) {
+		uint64_t sum = 0U;
+		uint64_t variance = 0U;
+		uint64_t avg;
+		uint32_t max = 0U;
+		uint32_t count = 0U;
+
+		for (uint32_t i = 0U; i < MENU_HISTORY; i++) {
+			uint32_t v = menu->intervals[i];
+
+			if (v <= thresh) {
+				sum += v;
+				max = MAX(max, v);
+				count++;
+			}
+		}
+
+		if (count == 0U) {
+			return UINT32_MAX;
+		}
+
+		avg = sum / count;
+		for (uint32_t i = 0U; i < MENU_HISTORY; i++) {
+			uint32_t v = menu->intervals[i];
+
+			if (v <= thresh) {
+				uint64_t diff = (v > avg) ? (v - avg) : (avg - v);
+
+				variance += (diff * diff) / count;
+			}
+		}
+
+		if (((avg * avg) / 36U) > variance) {
+			return (uint32_t)avg;
+		}
+
+		/* Drop the longest period and retry, while 3/4 are left */
+		if ((count * 4U) <= (MENU_HISTORY * 3U)) {
+			return UINT32_MAX;
+		}
+		thresh = max - 1U;
+	}
+}
+
+static inline uint32_t state_residency_us(const struct pm_state_info *state)
+{
+	return state->min_residency_us + state->exit_latency_us;
+}
+
+const struct pm_state_info *pm_policy_next_state(uint8_t cpu, int32_t ticks)
+{
+	struct menu_cpu *menu = &menu_cpus[cpu];
+	uint8_t num_cpu_states;
+	const struct pm_state_info *cpu_states;
+	const struct pm_state_info *out_state = NULL;
+	uint32_t expected_us;
+	uint32_t predicted_us;
+	uint8_t factor;
+
+	menu->pending = false;
+
+#ifdef CONFIG_PM_NEED_ALL_DEVICES_IDLE
+	if (pm_device_is_any_busy()) {
+		return NULL;
+	}
+#endif
+
+	if (ticks == K_TICKS_FOREVER) {
+		expected_us = UINT32_MAX;
+	} else {
+		expected_us = (uint32_t)MIN(k_ticks_to_us_floor64(ticks), UINT32_MAX);
+	}
+
+	factor = menu_factor_index(expected_us);
+	if (expected_us == UINT32_MAX) {
+		predicted_us = UINT32_MAX;
+	} else {
+		predicted_us = (uint32_t)(((uint64_t)expected_us *
+					   menu_factor_get(menu, factor)) / MENU_UNITY);
+	}
+	predicted_us = MIN(predicted_us, menu_typical_interval(menu));
+
+	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+
+	for (uint32_t i = 0; i < num_cpu_states; i++) {
+		const struct pm_state_info *state = &cpu_states[i];
+
+		if (predicted_us < state_residency_us(state)) {
+			break;
+		}
+
+		/* check if state is available. */
+		if (!pm_policy_state_is_available(state->state, state->substate_id)) {
+			continue;
+		}
+
+		out_state = state;
+	}
+
+	menu->pending = true;
+	menu->factor = factor;
+	menu->expected_us = expected_us;
+	menu->chosen = (out_state == NULL) ? -1 : (int)(out_state - cpu_states);
+	menu->start = menu_cycle_get();
+
+	return out_state;
+}
+
+void pm_policy_menu_idle_exit(uint8_t cpu)
+{
+	struct menu_cpu *menu = &menu_cpus[cpu];
+	menu_cycles_t elapsed = menu_cycle_get() - menu->start;
+	const struct pm_state_info *cpu_states;
+	uint8_t num_cpu_states;
+	uint32_t measured_us;
+	uint32_t clamped_us;
+	uint32_t factor;
+	uint32_t bucket;
+	int ideal = -1;
+	k_spinlock_key_t key;
+
+	if (!menu->pending) {
+		/* pm_policy_next_state() was not consulted */
+		return;
+	}
+	menu->pending = false;
+
+	measured_us = (uint32_t)MIN(k_cyc_to_us_floor64(elapsed), UINT32_MAX);
+
+	/* We cannot have slept longer than the next event, bar exit latency */
+	clamped_us = MIN(measured_us, menu->expected_us);
+	if (menu->expected_us != UINT32_MAX) {
+		factor = menu_factor_get(menu, menu->factor);
+		factor -= factor / MENU_DECAY;
+		if (menu->expected_us != 0U) {
+			factor += (uint32_t)(((uint64_t)MENU_RESOLUTION * clamped_us) /
+					     menu->expected_us);
+		} else {
+			factor += MENU_RESOLUTION;
+		}
+		menu->factors[menu->factor] = MAX(factor, 1U);
+	}
+
+	menu->intervals[menu->next_interval] = measured_us;
+	menu->next_interval = (menu->next_interval + 1U) % MENU_HISTORY;
+	menu->num_intervals = MIN(menu->num_intervals + 1U, MENU_HISTORY);
+
+	num_cpu_states = pm_state_cpu_get_all(cpu, &cpu_states);
+	for (uint8_t i = 0U; i < num_cpu_states; i++) {
+		if (measured_us < state_residency_us(&cpu_states[i])) {
+			break;
+		}
+		ideal = i;
+	}
+
+	bucket = (measured_us < 2U) ? 0U : (31U - u32_count_leading_zeros(measured_us));
+	bucket = MIN(bucket, CONFIG_PM_POLICY_MENU_HIST_BUCKETS - 1U);
+
+	key = k_spin_lock(&menu_lock);
+	menu->stats.idle_count++;
+	menu->stats.residency_us += measured_us;
+	menu->stats.hist[bucket]++;
+	if (menu->chosen == ideal) {
+		menu->stats.hits++;
+	} else if (menu->chosen > ideal) {
+		menu->stats.too_deep++;
+	} else {
+		menu->stats.too_shallow++;
+	}
+	k_spin_unlock(&menu_lock, key);
+}
+
+int pm_policy_menu_stats_get(uint8_t cpu, struct pm_policy_menu_stats *stats)
+{
+	if ((cpu >= ARRAY_SIZE(menu_cpus)) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&menu_lock) {
+		memcpy(stats, &menu_cpus[cpu].stats, sizeof(*stats));
+	}
+
+	return 0;
+}
+
+void pm_policy_menu_stats_reset(void)
+{
+	K_SPINLOCK(&menu_lock) {
+		for (size_t i = 0; i < ARRAY_SIZE(menu_cpus); i++) {
+			memset(&menu_cpus[i].stats, 0, sizeof(menu_cpus[i].stats));
+		}
+	}
+}
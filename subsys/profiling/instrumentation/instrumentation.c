@@ -0,0 +1,264 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Recorder of the function entries and exits reported by the code compiled
+ * with -finstrument-functions. Each CPU writes to its own buffer with the
+ * interrupts locked, so recording takes no lock shared between the CPUs.
+ * Nothing here may be instrumented: the recorder would call itself.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/profiling/instrumentation.h>
+#include <zephyr/shell/shell.h>
+
+#define INSTR_NUM_CPUS CONFIG_MP_MAX_NUM_CPUS
+#define INSTR_SIZE CONFIG_PROFILING_INSTRUMENTATION_BUFFER_SIZE
+
+#define __no_instrument __attribute__((__no_instrument_function__))
+
+struct instr_buf {
+	struct instr_record records[INSTR_SIZE];
+	/* Index of the next record to write */
+	uint32_t head;
+	uint32_t count;
+	uint32_t dropped;
+	/* Set while recording, so that the functions instrumented and called
+	 * by the recorder, such as the system timer driver, are skipped.
+	 */
+	bool busy;
+};
+
+static struct instr_buf instr_bufs[INSTR_NUM_CPUS];
+static volatile bool instr_enabled;
+
+static ALWAYS_INLINE void instr_record(void *func, uint32_t type)
+{
+	struct instr_record *record;
+	struct instr_buf *buf;
+	unsigned int key;
+
+	if (!instr_enabled) {
+		return;
+	}
+
+	key = arch_irq_lock();
+	buf = &instr_bufs[arch_curr_cpu()->id];
+
+	if (buf->busy) {
+		goto out;
+	}
+
+	if (buf->count == INSTR_SIZE) {
+		buf->dropped++;
+		if (!IS_ENABLED(CONFIG_PROFILING_INSTRUMENTATION_OVERWRITE)) {
+			goto out;
+		}
+	} else {
+		buf->count++;
+	}
+
+	buf->busy = true;
+
+	record = &buf->records[buf->head];
+	record->func = (uintptr_t)func;
+	record->thread = (uintptr_t)arch_curr_cpu()->current;
+	record->type = type;
+	record->timestamp = k_cycle_get_32();
+
+	buf->head = (buf->head + 1U == INSTR_SIZE) ? 0U : buf->head + 1U;
+	buf->busy = false;
+
+out:
+	arch_irq_unlock(key);
+}
+
+__no_instrument void __cyg_profile_func_enter(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	instr_record(func, INSTR_RECORD_ENTRY);
+}
+
+__no_instrument void __cyg_profile_func_exit(void *func, void *call_site)
+{
+	ARG_UNUSED(call_site);
+
+	instr_record(func, INSTR_RECORD_EXIT);
+}
+
+void instr_start(void)
+{
+	instr_enabled = true;
+}
+
+void instr_stop(void)
+{
+	instr_enabled = false;
+}
+
+bool instr_is_enabled(void)
+{
+	return instr_enabled;
+}
+
+void instr_reset(void)
+{
+	for (unsigned int cpu = 0; cpu < INSTR_NUM_CPUS; cpu++) {
+		struct instr_buf *buf = &instr_bufs[cpu];
+		unsigned int key = arch_irq_lock();
+
+		/* Other CPUs may still write to their buffer, the records
+		 * they are writing are lost.
+		 */
+		buf->head = 0U;
+		buf->count = 0U;
+		buf->dropped = 0U;
+		arch_irq_unlock(key);
+	}
+}
+
+int instr_foreach(instr_record_cb_t cb, void *user_data)
+{
+	if (instr_enabled) {
+		return -EBUSY;
+	}
+
+	for (unsigned int cpu = 0; cpu < INSTR_NUM_CPUS; cpu++) {
+		const struct instr_buf *buf = &instr_bufs[cpu];
+		uint32_t idx = (buf->head + INSTR_SIZE - buf->count) % INSTR_SIZE;
+
+		for (uint32_t i = 0; i < buf->count; i++) {
+			cb(cpu, &buf->records[idx], user_data);
+			idx = (idx + 1U == INSTR_SIZE) ? 0U : idx + 1U;
+		}
+	}
+
+	return 0;
+}
+
+uint32_t instr_dropped(void)
+{
+	uint32_t dropped = 0U;
+
+	for (unsigned int cpu = 0; cpu < INSTR_NUM_CPUS; cpu++) {
+		dropped += instr_bufs[cpu].dropped;
+	}
+
+	return dropped;
+}
+
+#if defined(CONFIG_PROFILING_INSTRUMENTATION_AT_BOOT)
+static int instr_init(void)
+{
+	instr_start();
+
+	return 0;
+}
+
+SYS_INIT(instr_init, POST_KERNEL, 0);
+#endif
+
+#if defined(CONFIG_PROFILING_INSTRUMENTATION_SHELL)
+static void instr_count(unsigned int cpu, const struct instr_record *record, void *user_data)
+{
+	ARG_UNUSED(cpu);
+	ARG_UNUSED(record);
+
+	(*(size_t *)user_data)++;
+}
+
+static void instr_print(unsigned int cpu, const struct instr_record *record, void *user_data)
+{
+	const struct shell *sh = user_data;
+
+	shell_print(sh, "%u %c %08x %0*lx %0*lx", cpu,
+		    record->type == INSTR_RECORD_ENTRY ? 'E' : 'X', record->timestamp,
+		    (int)(2 * sizeof(uintptr_t)), record->func,
+		    (int)(2 * sizeof(uintptr_t)), record->thread);
+}
+
+static int cmd_instr_start(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instr_start();
+	shell_print(sh, "Recording");
+
+	return 0;
+}
+
+static int cmd_instr_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instr_stop();
+	shell_print(sh, "Stopped");
+
+	return 0;
+}
+
+static int cmd_instr_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	instr_reset();
+	shell_print(sh, "Records discarded");
+
+	return 0;
+}
+
+static int cmd_instr_status(const struct shell *sh, size_t argc, char **argv)
+{
+	size_t count = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (instr_is_enabled()) {
+		shell_print(sh, "Recording, %u records dropped", instr_dropped());
+		return 0;
+	}
+
+	(void)instr_foreach(instr_count, &count);
+	shell_print(sh, "Stopped, %zu records, %u dropped", count, instr_dropped());
+
+	return 0;
+}
+
+static int cmd_instr_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	size_t count = 0;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (instr_is_enabled()) {
+		shell_error(sh, "Recording must be stopped");
+		return -EBUSY;
+	}
+
+	(void)instr_foreach(instr_count, &count);
+	shell_print(sh, "Instr dump %zu records %u Hz", count, sys_clock_hw_cycles_per_sec());
+	(void)instr_foreach(instr_print, (void *)sh);
+	shell_print(sh, "Instr dump end");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_instr,
+	SHELL_CMD_ARG(start, NULL, "Start recording", cmd_instr_start, 1, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop recording", cmd_instr_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Discard the records", cmd_instr_reset, 1, 0),
+	SHELL_CMD_ARG(status, NULL, "Print the recording status", cmd_instr_status, 1, 0),
+	SHELL_CMD_ARG(dump, NULL, "Print the records", cmd_instr_dump, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_ARG_REGISTER(instr, &m_sub_instr, "Function instrumentation", NULL, 2, 0);
+#endif /* CONFIG_PROFILING_INSTRUMENTATION_SHELL */
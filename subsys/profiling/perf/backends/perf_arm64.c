@@ -0,0 +1,94 @@
+/*
+ *  Copyright The Zephyr Project Contributors
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/linker-defs.h>
+
+static bool valid_stack(uintptr_t addr, k_tid_t current)
+{
+	return current->stack_info.start <= addr &&
+		addr < current->stack_info.start + current->stack_info.size;
+}
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	return (addr >= (uintptr_t)__text_region_start) && (addr < (uintptr_t)__text_region_end);
+}
+
+/*
+ * This function use frame pointers to unwind stack and get trace of return addresses.
+ * Return addresses are translated in corresponding function's names using .elf file.
+ * So we get function call trace
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	if (size < 2U) {
+		return 0;
+	}
+
+	size_t idx = 0;
+
+	/*
+	 * In arm64 (arch/arm64/core/vector_table.S) the registers of the
+	 * interrupted context are saved on its stack in struct arch_esf.
+	 * Then, if the interrupt is not nested, _isr_wrapper switches $sp to
+	 * _current_cpu->irq_stack and saves the previous $sp, pointing to the
+	 * esf, with offset -16 on irq stack
+	 *
+	 * The following lines do the reverse things to get lr, elr and fp
+	 */
+	const struct arch_esf * const esf =
+		*((struct arch_esf **)(((uintptr_t)_current_cpu->irq_stack) - 16));
+
+	/*
+	 * x29 is frame pointer, it points to a frame record.
+	 *
+	 * stack frame in memory:
+	 * (addresses growth up)
+	 *  ....
+	 *  x30 (lr)
+	 *  x29 (next) <- x29 (curr)
+	 *  ....
+	 */
+	void **fp = (void **)esf->fp;
+
+	/* $elr points the location where interrupt was occurred */
+	buf[idx++] = (uintptr_t)esf->elr;
+
+	/*
+	 * During function prologue and epilogue fp is equal to fp of
+	 * previous function stack frame, it looks like second function
+	 * from top is missed.
+	 * So saving lr will help in case when irq occurred in
+	 * function prologue or epilogue.
+	 */
+	buf[idx++] = (uintptr_t)esf->lr;
+
+	while (valid_stack((uintptr_t)fp, _current)) {
+		if (idx >= size) {
+			return 0;
+		}
+
+		if (!in_text_region((uintptr_t)fp[1])) {
+			break;
+		}
+
+		buf[idx++] = (uintptr_t)fp[1];
+		void **new_fp = (void **)fp[0];
+
+		/*
+		 * anti-infinity-loop if
+		 * new_fp can't be smaller than fp, cause the stack is growing down
+		 * and trace moves deeper into the stack
+		 */
+		if (new_fp <= fp) {
+			break;
+		}
+		fp = new_fp;
+	}
+
+	return idx;
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright The Zephyr Project Contributors
+ *
+ *  SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/linker-defs.h>
+#include <cmsis_core.h>
+
+static bool valid_stack(uintptr_t addr, k_tid_t current)
+{
+	return current->stack_info.start <= addr &&
+		addr < current->stack_info.start + current->stack_info.size;
+}
+
+static inline bool in_text_region(uintptr_t addr)
+{
+	return (addr >= (uintptr_t)__text_region_start) && (addr < (uintptr_t)__text_region_end);
+}
+
+/*
+ * Thumb return addresses have bit 0 set and follow a BL or BLX instruction.
+ */
+static bool is_return_address(uintptr_t addr)
+{
+	const uint16_t *insn = (const uint16_t *)(addr & ~1UL);
+
+	if ((addr & 1UL) == 0U || !in_text_region(addr - 5U) || !in_text_region(addr)) {
+		return false;
+	}
+
+	/* BLX <Rm> */
+	if ((insn[-1] & 0xFF87U) == 0x4780U) {
+		return true;
+	}
+
+	/* BL <label> */
+	return (insn[-2] & 0xF800U) == 0xF000U && (insn[-1] & 0xD000U) == 0xD000U;
+}
+
+/*
+ * GCC does not keep a frame chain in Thumb code, even with frame pointers,
+ * so the stack of the interrupted thread is scanned for return addresses
+ * instead. Return addresses are translated in corresponding function's names
+ * using .elf file. So we get function call trace
+ */
+size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
+{
+	if (size < 2U) {
+		return 0;
+	}
+
+	size_t idx = 0;
+
+	/*
+	 * On exception entry from thread mode, the core stacks the basic frame
+	 * of struct arch_esf on the process stack, which $psp points to while
+	 * the handler runs on the main stack. Interrupted ISRs are accounted
+	 * to the thread they preempted.
+	 */
+	const struct arch_esf * const esf = (const struct arch_esf *)__get_PSP();
+	const uintptr_t *sp = (const uintptr_t *)(&esf->basic + 1);
+
+	/* $pc points the location where interrupt was occurred */
+	buf[idx++] = (uintptr_t)esf->basic.pc;
+
+	if (!valid_stack((uintptr_t)esf, _current)) {
+		/* e.g. on the privileged stack of a user thread */
+		return idx;
+	}
+
+	/*
+	 * $lr holds the return address of a function which has not saved it
+	 * yet, or did not call any other function
+	 */
+	if (is_return_address(esf->basic.lr)) {
+		buf[idx++] = esf->basic.lr & ~1UL;
+	}
+
+	while (valid_stack((uintptr_t)sp, _current)) {
+		if (is_return_address(*sp)) {
+			if (idx >= size) {
+				return 0;
+			}
+
+			buf[idx++] = *sp & ~1UL;
+		}
+		sp++;
+	}
+
+	return idx;
+}
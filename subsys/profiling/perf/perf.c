@@ -15,6 +15,8 @@
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+#define PERF_STREAM_PERIOD K_MSEC(100)
+
 struct perf_data_t {
 	struct k_timer timer;
 
@@ -22,6 +24,15 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
+	/* Streaming: samples are written to one half of the buffer while the
+	 * other one is printed.
+	 */
+	struct k_work_delayable stream_dwork;
+	bool streaming;
+	size_t base;
+	size_t size;
+	uint32_t dropped;
+
 	size_t idx;
 	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
 	bool buf_full;
@@ -29,27 +40,47 @@ struct perf_data_t {
 
 static void perf_tracer(struct k_timer *timer);
 static void perf_dwork_handler(struct k_work *work);
+static void perf_stream_dwork_handler(struct k_work *work);
 static struct perf_data_t perf_data = {
 	.timer = Z_TIMER_INITIALIZER(perf_data.timer, perf_tracer, NULL),
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
+	.stream_dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_stream_dwork_handler),
+	.size = CONFIG_PROFILING_PERF_BUFFER_SIZE,
 };
 
 static void perf_tracer(struct k_timer *timer)
 {
 	struct perf_data_t *perf_data_ptr =
 		(struct perf_data_t *)k_timer_user_data_get(timer);
+	uintptr_t *buf = perf_data_ptr->buf + perf_data_ptr->base;
+	size_t size = perf_data_ptr->size;
 
 	size_t trace_length = 0;
 
-	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
+	if (++perf_data_ptr->idx < size) {
 		trace_length = arch_perf_current_stack_trace(
-					perf_data_ptr->buf + perf_data_ptr->idx,
-					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx);
+					buf + perf_data_ptr->idx,
+					size - perf_data_ptr->idx);
+	}
+
+#if defined(CONFIG_PROFILING_PERF_THREAD)
+	/* The interrupted thread is the root of the trace */
+	if (trace_length != 0) {
+		if (perf_data_ptr->idx + trace_length < size) {
+			buf[perf_data_ptr->idx + trace_length++] = (uintptr_t)k_current_get();
+		} else {
+			trace_length = 0;
+		}
 	}
+#endif
 
 	if (trace_length != 0) {
-		perf_data_ptr->buf[perf_data_ptr->idx - 1] = trace_length;
+		buf[perf_data_ptr->idx - 1] = trace_length;
 		perf_data_ptr->idx += trace_length;
+	} else if (perf_data_ptr->streaming) {
+		/* Wait for the buffer to be swapped */
+		--perf_data_ptr->idx;
+		perf_data_ptr->dropped++;
 	} else {
 		--perf_data_ptr->idx;
 		perf_data_ptr->buf_full = true;
@@ -57,13 +88,56 @@ static void perf_tracer(struct k_timer *timer)
 	}
 }
 
+static void perf_print_samples(const struct shell *sh, const uintptr_t *buf, size_t length)
+{
+	shell_print(sh, "Perf buf length %zu", length);
+	for (size_t i = 0; i < length; i++) {
+		shell_print(sh, "%016lx", buf[i]);
+	}
+}
+
+/* Print the samples written since the previous call */
+static void perf_stream_flush(struct perf_data_t *perf_data_ptr)
+{
+	size_t base, length;
+	unsigned int key;
+
+	key = irq_lock();
+	base = perf_data_ptr->base;
+	length = perf_data_ptr->idx;
+	perf_data_ptr->base = (base == 0) ? perf_data_ptr->size : 0;
+	perf_data_ptr->idx = 0;
+	irq_unlock(key);
+
+	if (length != 0) {
+		perf_print_samples(perf_data_ptr->sh, perf_data_ptr->buf + base, length);
+	}
+}
+
+static void perf_stream_dwork_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, stream_dwork);
+
+	perf_stream_flush(perf_data_ptr);
+	k_work_reschedule(&perf_data_ptr->stream_dwork, PERF_STREAM_PERIOD);
+}
+
 static void perf_dwork_handler(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
-	if (perf_data_ptr->buf_full) {
+	if (perf_data_ptr->streaming) {
+		k_work_cancel_delayable(&perf_data_ptr->stream_dwork);
+		perf_stream_flush(perf_data_ptr);
+		perf_data_ptr->streaming = false;
+		perf_data_ptr->base = 0;
+		perf_data_ptr->size = CONFIG_PROFILING_PERF_BUFFER_SIZE;
+		shell_print(perf_data_ptr->sh, "Perf done! %u samples dropped",
+			    perf_data_ptr->dropped);
+	} else if (perf_data_ptr->buf_full) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
 	} else {
 		shell_print(perf_data_ptr->sh, "Perf done!");
@@ -97,6 +171,35 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_perf_stream(const struct shell *sh, size_t argc, char **argv)
+{
+	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	k_timeout_t duration = K_MSEC(strtoll(argv[1], NULL, 10));
+	k_timeout_t period = K_NSEC(1000000000 / strtoll(argv[2], NULL, 10));
+
+	perf_data.sh = sh;
+	perf_data.streaming = true;
+	perf_data.dropped = 0;
+	perf_data.base = 0;
+	perf_data.size = CONFIG_PROFILING_PERF_BUFFER_SIZE / 2;
+	perf_data.idx = 0;
+	perf_data.buf_full = false;
+
+	k_timer_user_data_set(&perf_data.timer, &perf_data);
+	k_timer_start(&perf_data.timer, K_NO_WAIT, period);
+
+	k_work_schedule(&perf_data.stream_dwork, PERF_STREAM_PERIOD);
+	k_work_schedule(&perf_data.dwork, duration);
+
+	shell_print(sh, "Enabled perf");
+
+	return 0;
+}
+
 static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 {
 	if (sh != NULL) {
@@ -132,10 +235,7 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 		return -EINPROGRESS;
 	}
 
-	shell_print(sh, "Perf buf length %zu", perf_data.idx);
-	for (size_t i = 0; i < perf_data.idx; i++) {
-		shell_print(sh, "%016lx", perf_data.buf[i]);
-	}
+	perf_print_samples(sh, perf_data.buf, perf_data.idx);
 
 	cmd_perf_clear(NULL, 0, NULL);
 
@@ -146,8 +246,13 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
 	"Usage: record <duration> <frequency>"
 
+#define CMD_HELP_STREAM                                                                            \
+	"Print samples while recording for <duration> ms on <frequency> Hz\n"                      \
+	"Usage: stream <duration> <frequency>"
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
+	SHELL_CMD_ARG(stream, NULL, CMD_HELP_STREAM, cmd_perf_stream, 3, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
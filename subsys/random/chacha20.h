@@ -0,0 +1,72 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* ChaCha20 block function of the CSPRNG, shared with its tests */
+
+#ifndef ZEPHYR_SUBSYS_RANDOM_CHACHA20_H_
+#define ZEPHYR_SUBSYS_RANDOM_CHACHA20_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+
+#define CHACHA20_KEY_WORDS	8
+#define CHACHA20_NONCE_WORDS	3
+#define CHACHA20_BLOCK_SIZE	64
+
+static inline void chacha20_erase(void *buf, size_t len)
+{
+	volatile uint8_t *p = buf;
+
+	while (len-- > 0) {
+		*p++ = 0U;
+	}
+}
+
+#define CHACHA20_ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define CHACHA20_QUARTER_ROUND(a, b, c, d)			\
+	do {							\
+		a += b; d ^= a; d = CHACHA20_ROTL32(d, 16);	\
+		c += d; b ^= c; b = CHACHA20_ROTL32(b, 12);	\
+		a += b; d ^= a; d = CHACHA20_ROTL32(d, 8);	\
+		c += d; b ^= c; b = CHACHA20_ROTL32(b, 7);	\
+	} while (false)
+
+/* RFC 8439 block function */
+static inline void chacha20_block(const uint32_t key[CHACHA20_KEY_WORDS], uint32_t counter,
+				  const uint32_t nonce[CHACHA20_NONCE_WORDS],
+				  uint8_t out[CHACHA20_BLOCK_SIZE])
+{
+	uint32_t in[16] = {
+		0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+		key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+		counter, nonce[0], nonce[1], nonce[2],
+	};
+	uint32_t x[16];
+
+	memcpy(x, in, sizeof(x));
+
+	for (int i = 0; i < 10; i++) {
+		CHACHA20_QUARTER_ROUND(x[0], x[4], x[8], x[12]);
+		CHACHA20_QUARTER_ROUND(x[1], x[5], x[9], x[13]);
+		CHACHA20_QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+		CHACHA20_QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+		CHACHA20_QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+		CHACHA20_QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+		CHACHA20_QUARTER_ROUND(x[2], x[7], x[8], x[13]);
+		CHACHA20_QUARTER_ROUND(x[3], x[4], x[9], x[14]);
+	}
+
+	for (int i = 0; i < 16; i++) {
+		sys_put_le32(x[i] + in[i], &out[i * sizeof(uint32_t)]);
+	}
+
+	chacha20_erase(x, sizeof(x));
+	chacha20_erase(in, sizeof(in));
+}
+
+#endif /* ZEPHYR_SUBSYS_RANDOM_CHACHA20_H_ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * ChaCha20 CSPRNG with fast key erasure: every ChaCha20 block generated
+ * replaces the key it was generated from, so the output handed out before
+ * cannot be recovered from the state. Each CPU has its own state, only
+ * interrupts are locked while using it, and the entropy driver is queried
+ * from a work item which hands the fresh seed over to the CPUs.
+ */
+
+#include <zephyr/init.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/entropy.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "chacha20.h"
+
+struct chacha20_cpu {
+	uint32_t key[CHACHA20_KEY_WORDS];
+	/* Key stream not handed out yet, used from the end */
+	uint8_t buf[CHACHA20_BLOCK_SIZE - sizeof(uint32_t) * CHACHA20_KEY_WORDS];
+	uint8_t avail;
+	/* Seed generation mixed into the key */
+	atomic_val_t seed_gen;
+};
+
+static const struct device *const entropy_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_entropy));
+static struct chacha20_cpu cpu_state[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct k_spinlock seed_lock;
+static uint32_t seed[CHACHA20_KEY_WORDS];
+/* Zero until the first seed */
+static atomic_t seed_gen;
+
+static void reseed_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(reseed_work, reseed_work_handler);
+
+/* Replace the key of a CPU, leaving the rest of the block in its buffer */
+static void cpu_refill(struct chacha20_cpu *s, uint32_t cpu_id)
+{
+	/* CPUs are kept apart by the nonce even when their keys are equal */
+	const uint32_t nonce[CHACHA20_NONCE_WORDS] = { cpu_id, 0, 0 };
+	uint8_t block[CHACHA20_BLOCK_SIZE];
+
+	chacha20_block(s->key, 0, nonce, block);
+
+	for (int i = 0; i < CHACHA20_KEY_WORDS; i++) {
+		s->key[i] = sys_get_le32(&block[i * sizeof(uint32_t)]);
+	}
+	memcpy(s->buf, &block[sizeof(s->key)], sizeof(s->buf));
+	s->avail = sizeof(s->buf);
+
+	chacha20_erase(block, sizeof(block));
+}
+
+static void cpu_reseed(struct chacha20_cpu *s)
+{
+	k_spinlock_key_t key = k_spin_lock(&seed_lock);
+
+	for (int i = 0; i < CHACHA20_KEY_WORDS; i++) {
+		s->key[i] ^= seed[i];
+	}
+	s->seed_gen = atomic_get(&seed_gen);
+
+	k_spin_unlock(&seed_lock, key);
+
+	/* Nothing generated from the old key is handed out anymore */
+	chacha20_erase(s->buf, sizeof(s->buf));
+	s->avail = 0U;
+}
+
+/* Called with interrupts locked, len is at most sizeof(s->buf) */
+static void cpu_take(struct chacha20_cpu *s, uint32_t cpu_id, uint8_t *dst, size_t len)
+{
+	if (s->avail < len) {
+		cpu_refill(s, cpu_id);
+	}
+
+	s->avail -= len;
+	memcpy(dst, &s->buf[s->avail], len);
+	chacha20_erase(&s->buf[s->avail], len);
+}
+
+static int reseed(void)
+{
+	uint32_t fresh[CHACHA20_KEY_WORDS];
+	k_spinlock_key_t key;
+	int ret;
+
+	if (!device_is_ready(entropy_dev)) {
+		return -ENODEV;
+	}
+
+	if (k_is_in_isr()) {
+		ret = entropy_get_entropy_isr(entropy_dev, (uint8_t *)fresh, sizeof(fresh),
+					      ENTROPY_BUSYWAIT);
+		ret = (ret == sizeof(fresh)) ? 0 : -EIO;
+	} else {
+		ret = entropy_get_entropy(entropy_dev, (uint8_t *)fresh, sizeof(fresh));
+	}
+
+	if (ret == 0) {
+		key = k_spin_lock(&seed_lock);
+		memcpy(seed, fresh, sizeof(seed));
+		atomic_inc(&seed_gen);
+		k_spin_unlock(&seed_lock, key);
+	}
+
+	chacha20_erase(fresh, sizeof(fresh));
+
+	return ret;
+}
+
+static void reseed_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)reseed();
+
+	(void)k_work_schedule(&reseed_work, K_SECONDS(CONFIG_CS_CHACHA20_RESEED_INTERVAL));
+}
+
+int z_impl_sys_csrand_get(void *dst, size_t outlen)
+{
+	struct chacha20_cpu *s;
+	uint32_t child[CHACHA20_KEY_WORDS];
+	uint32_t nonce[CHACHA20_NONCE_WORDS] = { 0 };
+	uint8_t block[CHACHA20_BLOCK_SIZE];
+	uint8_t *out = dst;
+	unsigned int key;
+	uint32_t cpu_id;
+	uint32_t counter;
+
+	if (unlikely(atomic_get(&seed_gen) == 0)) {
+		if (reseed() != 0) {
+			return -EIO;
+		}
+	}
+
+	key = arch_irq_lock();
+	cpu_id = arch_curr_cpu()->id;
+	s = &cpu_state[cpu_id];
+
+	if (unlikely(s->seed_gen != atomic_get(&seed_gen))) {
+		cpu_reseed(s);
+	}
+
+	if (outlen <= sizeof(s->buf)) {
+		cpu_take(s, cpu_id, out, outlen);
+		arch_irq_unlock(key);
+		return 0;
+	}
+
+	/* Long requests are generated from a key of their own, unlocked */
+	cpu_take(s, cpu_id, (uint8_t *)child, sizeof(child));
+	arch_irq_unlock(key);
+
+	for (counter = 0; outlen > 0; counter++) {
+		size_t len = MIN(outlen, sizeof(block));
+
+		chacha20_block(child, counter, nonce, block);
+		memcpy(out, block, len);
+		out += len;
+		outlen -= len;
+	}
+
+	chacha20_erase(block, sizeof(block));
+	chacha20_erase(child, sizeof(child));
+
+	return 0;
+}
+
+static int chacha20_csprng_init(void)
+{
+	(void)k_work_schedule(&reseed_work, K_NO_WAIT);
+
+	return 0;
+}
+
+SYS_INIT(chacha20_csprng_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -56,6 +56,34 @@ static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
 }
 
+/**
+ * @brief Check if a submission may join a batch for its iodev
+ *
+ * Executor operations and canceled submissions are always handled on their own.
+ */
+static inline bool rtio_iodev_batchable(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_iodev *iodev = iodev_sqe->sqe.iodev;
+
+	return iodev != NULL && iodev->api->submit_batch != NULL &&
+	       !FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags);
+}
+
+/**
+ * @brief Submit a batch of submissions to their common iodev
+ *
+ * @param batch Submissions, all for the same iodev
+ * @param count Number of submissions in the batch
+ */
+static void rtio_iodev_submit_batch(struct rtio_iodev_sqe **batch, size_t count)
+{
+	if (count == 1) {
+		batch[0]->sqe.iodev->api->submit(batch[0]);
+	} else if (count > 1) {
+		batch[0]->sqe.iodev->api->submit_batch(batch, count);
+	}
+}
+
 /**
  * @brief Submit operations in the queue to iodevs
  *
@@ -66,6 +94,8 @@ static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
 void rtio_executor_submit(struct rtio *r)
 {
 	const uint16_t cancel_no_response = (RTIO_SQE_CANCELED | RTIO_SQE_NO_RESPONSE);
+	struct rtio_iodev_sqe *batch[CONFIG_RTIO_SUBMIT_BATCH_SIZE];
+	size_t batch_cnt = 0;
 	struct mpsc_node *node = mpsc_pop(&r->sq);
 
 	while (node != NULL) {
@@ -113,10 +143,29 @@ void rtio_executor_submit(struct rtio *r)
 		curr->next = NULL;
 		curr->r = r;
 
-		rtio_iodev_submit(iodev_sqe);
+		/* Consecutive submissions to the same iodev are handed over together,
+		 * any other submission first flushes the batch to keep the order.
+		 */
+		if (batch_cnt > 0 && (!rtio_iodev_batchable(iodev_sqe) ||
+				      iodev_sqe->sqe.iodev != batch[0]->sqe.iodev)) {
+			rtio_iodev_submit_batch(batch, batch_cnt);
+			batch_cnt = 0;
+		}
+
+		if (rtio_iodev_batchable(iodev_sqe)) {
+			batch[batch_cnt++] = iodev_sqe;
+			if (batch_cnt == ARRAY_SIZE(batch)) {
+				rtio_iodev_submit_batch(batch, batch_cnt);
+				batch_cnt = 0;
+			}
+		} else {
+			rtio_iodev_submit(iodev_sqe);
+		}
 
 		node = mpsc_pop(&r->sq);
 	}
+
+	rtio_iodev_submit_batch(batch, batch_cnt);
 }
 
 /**
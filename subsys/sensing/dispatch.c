@@ -3,14 +3,94 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <errno.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/rtio/rtio.h>
+#include <zephyr/sensing/sensing.h>
 #include <zephyr/sensing/sensing_sensor.h>
 #include "sensor_mgmt.h"
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
+/* Data buffers kept by clients past their data event callbacks */
+struct sensing_data_ref {
+	const void *data;
+	uint32_t data_len;
+	/* Number of holders, the dispatch thread being one while it sends */
+	atomic_t refs;
+};
+
+static struct sensing_data_ref data_refs[CONFIG_SENSING_DATA_HOLD_COUNT];
+
+static struct sensing_data_ref *data_ref_find(const void *buf)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(data_refs); i++) {
+		if (data_refs[i].data == buf && atomic_get(&data_refs[i].refs) > 0) {
+			return &data_refs[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Takes a free reference for a buffer about to be sent, if any is left */
+static struct sensing_data_ref *data_ref_claim(const void *data, uint32_t data_len)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(data_refs); i++) {
+		if (atomic_cas(&data_refs[i].refs, 0, 1)) {
+			data_refs[i].data = data;
+			data_refs[i].data_len = data_len;
+			return &data_refs[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void data_ref_put(struct sensing_data_ref *ref)
+{
+	const void *data = ref->data;
+	uint32_t data_len = ref->data_len;
+
+	if (atomic_dec(&ref->refs) == 1) {
+		rtio_release_buffer(&sensing_rtio_ctx, (void *)data, data_len);
+	}
+}
+
+int sensing_data_hold(const void *buf)
+{
+	struct sensing_data_ref *ref = data_ref_find(buf);
+	atomic_val_t refs;
+
+	if (ref == NULL) {
+		return -ENOMEM;
+	}
+
+	do {
+		refs = atomic_get(&ref->refs);
+		if (refs == 0) {
+			return -EINVAL;
+		}
+	} while (!atomic_cas(&ref->refs, refs, refs + 1));
+
+	return 0;
+}
+
+int sensing_data_release(const void *buf)
+{
+	struct sensing_data_ref *ref = data_ref_find(buf);
+
+	if (ref == NULL) {
+		return -EINVAL;
+	}
+
+	data_ref_put(ref);
+
+	return 0;
+}
+
 /* check whether it is right time for client to consume this sample */
 static inline bool sensor_test_consume_time(struct sensing_sensor *sensor,
 				     struct sensing_connection *conn,
@@ -40,6 +120,8 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 {
 	struct sensing_sensor *client;
 	struct sensing_connection *conn;
+	/* All the clients get the same buffer, checked against the same time */
+	uint64_t cur_time = get_us();
 
 	for_each_client_conn(sensor, conn) {
 		client = conn->sink;
@@ -53,7 +135,7 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 		 * true: it's time for client consuming the data
 		 * false: client time not arrived yet, not consume the data
 		 */
-		if (!sensor_test_consume_time(sensor, conn, get_us())) {
+		if (!sensor_test_consume_time(sensor, conn, cur_time)) {
 			continue;
 		}
 
@@ -112,8 +194,15 @@ static void dispatch_task(void *a, void *b, void *c)
 			    (uintptr_t)STRUCT_SECTION_START(sensing_sensor) &&
 		    (uintptr_t)cqe.userdata < (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
 			struct sensing_sensor *sensor = cqe.userdata;
+			struct sensing_data_ref *ref = data_ref_claim(data, data_len);
 
 			send_data_to_clients(sensor, data);
+
+			/* The buffer goes back to the pool with its last holder */
+			if (ref != NULL) {
+				data_ref_put(ref);
+				continue;
+			}
 		}
 
 		rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
@@ -48,6 +48,22 @@ struct settings_nvs {
 	uint16_t cache_total;
 	bool loaded;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Every name ID in use, in descending order, with the hashes of the
+	 * name and of its first element.
+	 */
+	struct {
+		uint16_t name_id;
+		uint16_t name_hash;
+		uint16_t root_hash;
+	} index[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+
+	uint16_t index_count;
+	/* The index holds all the names, set by a complete load */
+	bool index_valid;
+	/* Cleared when the index being loaded misses names */
+	bool index_building;
+#endif
 };
 
 /* register nvs to be a source of settings */
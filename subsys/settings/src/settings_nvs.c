@@ -120,16 +120,207 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+static uint16_t settings_nvs_root_hash(const char *name)
+{
+	return crc16_ccitt(0xffff, name, settings_name_next(name, NULL));
+}
+
+/* Inserts name_id, keeping the index sorted */
+static void settings_nvs_index_add(struct settings_nvs *cf, const char *name,
+				   uint16_t name_id)
+{
+	uint16_t pos = cf->index_count;
+
+	if (cf->index_count == ARRAY_SIZE(cf->index)) {
+		cf->index_valid = false;
+		cf->index_building = false;
+		return;
+	}
+
+	while ((pos > 0) && (cf->index[pos - 1].name_id < name_id)) {
+		cf->index[pos] = cf->index[pos - 1];
+		pos--;
+	}
+
+	cf->index[pos].name_id = name_id;
+	cf->index[pos].name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	cf->index[pos].root_hash = settings_nvs_root_hash(name);
+	cf->index_count++;
+}
+
+static void settings_nvs_index_remove(struct settings_nvs *cf, uint16_t pos)
+{
+	cf->index_count--;
+	memmove(&cf->index[pos], &cf->index[pos + 1],
+		(cf->index_count - pos) * sizeof(cf->index[0]));
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 char *rdname, size_t len, uint16_t *pos)
+{
+	uint16_t name_hash = crc16_ccitt(0xffff, name, strlen(name));
+	int rc;
+
+	for (uint16_t i = 0; i < cf->index_count; i++) {
+		if (cf->index[i].name_hash != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, cf->index[i].name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		*pos = i;
+		return cf->index[i].name_id;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+
+/* Lowest name ID not in use, as the scan of settings_nvs_save() finds it */
+static uint16_t settings_nvs_index_free_id(struct settings_nvs *cf)
+{
+	uint16_t name_id = NVS_NAMECNT_ID + 1;
+
+	for (uint16_t i = cf->index_count; i > 0; i--) {
+		if (cf->index[i - 1].name_id != name_id) {
+			break;
+		}
+		name_id++;
+	}
+
+	return MIN(name_id, cf->last_name_id + 1);
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
+/* Loads the setting stored at name_id. found is cleared when there is no
+ * complete setting at this ID, whose entries are then cleaned.
+ */
+static int settings_nvs_load_id(struct settings_nvs *cf, uint16_t name_id,
+				const struct settings_load_arg *arg, char *name,
+				size_t name_size, bool *found)
+{
+	struct settings_nvs_read_fn_arg read_fn_arg;
+	char buf;
+	ssize_t rc1, rc2;
+
+	*found = false;
+
+	/* In the NVS backend, each setting item is stored in two NVS
+	 * entries one for the setting's name and one with the
+	 * setting's value.
+	 */
+	rc1 = nvs_read(&cf->cf_nvs, name_id, name, name_size);
+	rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
+		       &buf, sizeof(buf));
+
+	if ((rc1 <= 0) && (rc2 <= 0)) {
+		/* Settings largest ID in use is invalid due to
+		 * reset, power failure or partition overflow.
+		 * Decrement it and check the next ID in subsequent
+		 * iteration.
+		 */
+		if (name_id == cf->last_name_id) {
+			cf->last_name_id--;
+			nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+				  &cf->last_name_id, sizeof(uint16_t));
+		}
+
+		return 0;
+	}
+
+	if ((rc1 <= 0) || (rc2 <= 0)) {
+		/* Settings item is not stored correctly in the NVS.
+		 * NVS entry for its name or value is either missing
+		 * or deleted. Clean dirty entries to make space for
+		 * future settings item.
+		 */
+		nvs_delete(&cf->cf_nvs, name_id);
+		nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+
+		if (name_id == cf->last_name_id) {
+			cf->last_name_id--;
+			nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
+				  &cf->last_name_id, sizeof(uint16_t));
+		}
+
+		return 0;
+	}
+
+	/* Found a name, this might not include a trailing \0 */
+	name[rc1] = '\0';
+	read_fn_arg.fs = &cf->cf_nvs;
+	read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
+	*found = true;
+
+	return settings_call_set_handler(
+		name, rc2,
+		settings_nvs_read_fn, &read_fn_arg,
+		(void *)arg);
+}
+
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+/* Loads the settings of the index, only those under the same first element
+ * as the subtree, if any.
+ */
+static int settings_nvs_load_index(struct settings_nvs *cf,
+				   const struct settings_load_arg *arg)
+{
+	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+	bool subtree = (arg != NULL) && (arg->subtree != NULL);
+	uint16_t root_hash = subtree ? settings_nvs_root_hash(arg->subtree) : 0;
+	uint16_t i = 0;
+	uint16_t name_id;
+	bool found;
+	int ret;
+
+	while (i < cf->index_count) {
+		if (subtree && (cf->index[i].root_hash != root_hash)) {
+			i++;
+			continue;
+		}
+
+		name_id = cf->index[i].name_id;
+		ret = settings_nvs_load_id(cf, name_id, arg, name, sizeof(name), &found);
+		if (!found) {
+			settings_nvs_index_remove(cf, i);
+			continue;
+		}
+
+		if (ret) {
+			return ret;
+		}
+
+		if ((i < cf->index_count) && (cf->index[i].name_id == name_id)) {
+			i++;
+			continue;
+		}
+
+		/* The handler saved settings, which moved the entries */
+		for (i = 0; (i < cf->index_count) && (cf->index[i].name_id >= name_id); i++) {
+		}
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
 	int ret = 0;
 	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
-	struct settings_nvs_read_fn_arg read_fn_arg;
 	char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
-	char buf;
-	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+	bool found;
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 	uint16_t cached = 0;
@@ -137,6 +328,16 @@ static int settings_nvs_load(struct settings_store *cs,
 	cf->loaded = false;
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (cf->index_valid) {
+		return settings_nvs_load_index(cf, arg);
+	}
+
+	/* Rebuilt from the names found below, a save meanwhile spoils it */
+	cf->index_count = 0;
+	cf->index_building = true;
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -146,65 +347,26 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 			cf->loaded = true;
 			cf->cache_total = cached;
+#endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			cf->index_valid = cf->index_building;
 #endif
 			break;
 		}
 
-		/* In the NVS backend, each setting item is stored in two NVS
-		 * entries one for the setting's name and one with the
-		 * setting's value.
-		 */
-		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
-		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
-			       &buf, sizeof(buf));
-
-		if ((rc1 <= 0) && (rc2 <= 0)) {
-			/* Settings largest ID in use is invalid due to
-			 * reset, power failure or partition overflow.
-			 * Decrement it and check the next ID in subsequent
-			 * iteration.
-			 */
-			if (name_id == cf->last_name_id) {
-				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
-			}
-
-			continue;
-		}
-
-		if ((rc1 <= 0) || (rc2 <= 0)) {
-			/* Settings item is not stored correctly in the NVS.
-			 * NVS entry for its name or value is either missing
-			 * or deleted. Clean dirty entries to make space for
-			 * future settings item.
-			 */
-			nvs_delete(&cf->cf_nvs, name_id);
-			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
-
-			if (name_id == cf->last_name_id) {
-				cf->last_name_id--;
-				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-					  &cf->last_name_id, sizeof(uint16_t));
-			}
-
+		ret = settings_nvs_load_id(cf, name_id, arg, name, sizeof(name), &found);
+		if (!found) {
 			continue;
 		}
 
-		/* Found a name, this might not include a trailing \0 */
-		name[rc1] = '\0';
-		read_fn_arg.fs = &cf->cf_nvs;
-		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
-
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 		settings_nvs_cache_add(cf, name, name_id);
 		cached++;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_add(cf, name, name_id);
+#endif
 
-		ret = settings_call_set_handler(
-			name, rc2,
-			settings_nvs_read_fn, &read_fn_arg,
-			(void *)arg);
 		if (ret) {
 			break;
 		}
@@ -240,6 +402,26 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	uint16_t index_pos = 0;
+
+	if (cf->index_valid) {
+		name_id = settings_nvs_index_match(cf, name, rdname, sizeof(rdname),
+						   &index_pos);
+		if (name_id != NVS_NAMECNT_ID) {
+			write_name_id = name_id;
+			write_name = false;
+		} else {
+			write_name_id = settings_nvs_index_free_id(cf);
+			write_name = true;
+		}
+		goto found;
+	}
+
+	/* A load building the index may have gone past this name already */
+	cf->index_building = false;
+#endif
+
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
 	write_name = true;
@@ -297,6 +479,12 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (cf->index_valid) {
+			settings_nvs_index_remove(cf, index_pos);
+		}
+#endif
+
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
 			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
@@ -351,6 +539,12 @@ found:
 	}
 #endif
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (write_name && cf->index_valid) {
+		settings_nvs_index_add(cf, name, write_name_id);
+	}
+#endif
+
 	return 0;
 }
 
@@ -370,6 +564,11 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		return rc;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	cf->index_count = 0;
+	cf->index_valid = false;
+#endif
+
 	rc = nvs_read(&cf->cf_nvs, NVS_NAMECNT_ID, &last_name_id,
 		      sizeof(last_name_id));
 	if (rc < 0) {
@@ -23,18 +23,67 @@ LOG_MODULE_REGISTER(shell_uart);
 #define RX_POLL_PERIOD K_NO_WAIT
 #endif
 
+#define ASYNC_TX_BUFFERED (CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE > 0)
+
 #ifdef CONFIG_MCUMGR_TRANSPORT_SHELL
 NET_BUF_POOL_DEFINE(smp_shell_rx_pool, CONFIG_MCUMGR_TRANSPORT_SHELL_RX_BUF_COUNT,
 		    SMP_SHELL_RX_BUF_SIZE, 0, NULL);
 #endif /* CONFIG_MCUMGR_TRANSPORT_SHELL */
 
+/* Start sending the content of the TX buffer, unless a transfer is in progress. */
+static void async_tx_kick(struct shell_uart_async *sh_uart)
+{
+	uint8_t *data;
+	uint32_t len;
+	int err;
+
+	while (!ring_buf_is_empty(&sh_uart->tx_ringbuf) &&
+	       atomic_cas(&sh_uart->tx_busy, 0, 1)) {
+		len = ring_buf_get_claim(&sh_uart->tx_ringbuf, &data,
+					 sh_uart->tx_ringbuf.size);
+
+		err = uart_tx(sh_uart->common.dev, data, len, SYS_FOREVER_US);
+		if (err == 0) {
+			return;
+		}
+
+		/* Drop what cannot be sent rather than stalling the shell */
+		(void)ring_buf_get_finish(&sh_uart->tx_ringbuf, len);
+		atomic_clear(&sh_uart->tx_busy);
+	}
+}
+
+static void async_tx_done(struct shell_uart_async *sh_uart, size_t len, bool restart)
+{
+	int err = ring_buf_get_finish(&sh_uart->tx_ringbuf, len);
+
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	atomic_clear(&sh_uart->tx_busy);
+	if (restart) {
+		async_tx_kick(sh_uart);
+	}
+
+	sh_uart->common.handler(SHELL_TRANSPORT_EVT_TX_RDY, sh_uart->common.context);
+}
+
 static void async_callback(const struct device *dev, struct uart_event *evt, void *user_data)
 {
 	struct shell_uart_async *sh_uart = (struct shell_uart_async *)user_data;
 
 	switch (evt->type) {
 	case  UART_TX_DONE:
-		k_sem_give(&sh_uart->tx_sem);
+		if (ASYNC_TX_BUFFERED) {
+			async_tx_done(sh_uart, evt->data.tx.len, true);
+		} else {
+			k_sem_give(&sh_uart->tx_sem);
+		}
+		break;
+	case  UART_TX_ABORTED:
+		if (ASYNC_TX_BUFFERED) {
+			async_tx_done(sh_uart, evt->data.tx.len, !sh_uart->common.blocking_tx);
+		}
 		break;
 	case  UART_RX_RDY:
 		uart_async_rx_on_rdy(&sh_uart->async_rx, evt->data.rx.buf, evt->data.rx.len);
@@ -244,6 +293,9 @@ static void async_init(struct shell_uart_async *sh_uart)
 	};
 
 	k_sem_init(&sh_uart->tx_sem, 0, 1);
+	ring_buf_init(&sh_uart->tx_ringbuf, CONFIG_SHELL_BACKEND_SERIAL_ASYNC_TX_BUFFER_SIZE,
+		      sh_uart->tx_buf);
+	sh_uart->tx_busy = 0;
 
 	err = uart_async_rx_init(async_rx, &sh_uart->async_rx_config);
 	(void)err;
@@ -353,6 +405,12 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 		uart_irq_tx_disable(sh_uart->dev);
 	}
 
+	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_API_ASYNC) && ASYNC_TX_BUFFERED &&
+	    blocking_tx) {
+		/* Output is polled from now on, stop the buffered transfer */
+		(void)uart_tx_abort(sh_uart->dev);
+	}
+
 	return 0;
 }
 
@@ -389,6 +447,13 @@ static int async_write(struct shell_uart_async *sh_uart,
 {
 	int err;
 
+	if (ASYNC_TX_BUFFERED) {
+		*cnt = ring_buf_put(&sh_uart->tx_ringbuf, data, length);
+		async_tx_kick(sh_uart);
+
+		return 0;
+	}
+
 	err = uart_tx(sh_uart->common.dev, data, length, SYS_FOREVER_US);
 	if (err < 0) {
 		*cnt = 0;
@@ -0,0 +1,83 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+static void shell_print_irq_stats(const struct shell *sh, const char *name,
+				  const struct k_irq_stats *stats)
+{
+	shell_fprintf(sh, SHELL_NORMAL, "%s: samples %u, max %u, avg %llu\n ", name,
+		      stats->count, stats->max,
+		      (stats->count != 0U) ? (stats->total / stats->count) : 0ULL);
+	for (int b = 0; b < CONFIG_IRQ_STATS_BUCKETS; b++) {
+		shell_fprintf(sh, SHELL_NORMAL, " %u", stats->hist[b]);
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+
+static int cmd_kernel_irq_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+#ifdef CONFIG_IRQ_STATS_ISR
+	struct k_irq_stats isr;
+	char name[sizeof("IRQ 4294967295")];
+
+	for (unsigned int irq = 0; irq < CONFIG_NUM_IRQS; irq++) {
+		(void)k_irq_stats_get(irq, &isr);
+
+		if (isr.count == 0U) {
+			continue;
+		}
+
+		snprintf(name, sizeof(name), "IRQ %u", irq);
+		shell_print_irq_stats(sh, name, &isr);
+	}
+#endif /* CONFIG_IRQ_STATS_ISR */
+
+#ifdef CONFIG_IRQ_STATS_LOCK
+	static struct k_irq_lock_stats lock;
+
+	(void)k_irq_lock_stats_get(&lock);
+	shell_print_irq_stats(sh, "Masked", &lock.masked);
+
+	for (int i = 0; i < CONFIG_IRQ_STATS_LOCK_HOLDERS; i++) {
+		if (lock.holders[i].max == 0U) {
+			break;
+		}
+
+		shell_print(sh, "  %#lx: max %u", lock.holders[i].addr, lock.holders[i].max);
+	}
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
+	return 0;
+}
+
+static int cmd_kernel_irq_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_irq_stats_reset();
+	shell_print(sh, "Interrupt statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_irq_stats,
+	SHELL_CMD(reset, NULL, "Reset the statistics.", cmd_kernel_irq_stats_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(irq_stats, &sub_kernel_irq_stats,
+	       "ISR duration and interrupt masking histograms, buckets are powers\n"
+	       "of two of the runtime statistics time base. Masking locations are\n"
+	       "return addresses of the lock calls.",
+	       cmd_kernel_irq_stats);
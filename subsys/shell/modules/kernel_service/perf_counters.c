@@ -0,0 +1,132 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+static const char *const event_names[] = {
+	[K_PERF_EVENT_NONE] = "none",
+	[K_PERF_EVENT_CYCLES] = "cycles",
+	[K_PERF_EVENT_INSTRUCTIONS] = "instructions",
+	[K_PERF_EVENT_CACHE_MISSES] = "cache-misses",
+	[K_PERF_EVENT_BRANCH_MISSES] = "branch-misses",
+	[K_PERF_EVENT_STALLS] = "stalls",
+};
+
+static struct k_perf_counter_stats shell_perf_stats;
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+static void shell_perf_counters_thread(const struct k_thread *cthread, void *user_data)
+{
+	const struct shell *sh = user_data;
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const char *tname = k_thread_name_get(thread);
+
+	(void)k_thread_perf_counter_stats_get(thread, &shell_perf_stats);
+
+	shell_fprintf(sh, SHELL_NORMAL, "  %-16s %p:", (tname != NULL) ? tname : "NA", thread);
+	for (int i = 0; i < CONFIG_PERF_COUNTERS_NUM; i++) {
+		if (shell_perf_stats.event[i] != K_PERF_EVENT_NONE) {
+			shell_fprintf(sh, SHELL_NORMAL, " %llu", shell_perf_stats.count[i]);
+		}
+	}
+	shell_fprintf(sh, SHELL_NORMAL, "\n");
+}
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
+static int cmd_kernel_perf_counters(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_perf_counter_stats *stats = &shell_perf_stats;
+
+	(void)k_perf_counter_stats_get(stats);
+
+	for (int i = 0; i < CONFIG_PERF_COUNTERS_NUM; i++) {
+		if (stats->event[i] != K_PERF_EVENT_NONE) {
+			shell_print(sh, "%d: %-14s %llu", i, event_names[stats->event[i]],
+				    stats->count[i]);
+		}
+	}
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+	shell_print(sh, "Threads:");
+	k_thread_foreach_unlocked(shell_perf_counters_thread, (void *)sh);
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
+	return 0;
+}
+
+static int cmd_kernel_perf_counters_start(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+
+	unsigned int idx = strtoul(argv[1], NULL, 10);
+	int ret;
+
+	for (size_t event = K_PERF_EVENT_CYCLES; event < ARRAY_SIZE(event_names); event++) {
+		if (strcmp(argv[2], event_names[event]) != 0) {
+			continue;
+		}
+
+		ret = k_perf_counter_start(idx, event);
+		if (ret < 0) {
+			shell_error(sh, "Cannot count %s with counter %u (%d)", argv[2], idx, ret);
+		}
+
+		return ret;
+	}
+
+	shell_error(sh, "Unknown event %s", argv[2]);
+
+	return -EINVAL;
+}
+
+static int cmd_kernel_perf_counters_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+
+	unsigned int idx = strtoul(argv[1], NULL, 10);
+	int ret;
+
+	ret = k_perf_counter_stop(idx);
+	if (ret < 0) {
+		shell_error(sh, "Invalid counter %u", idx);
+	}
+
+	return ret;
+}
+
+static int cmd_kernel_perf_counters_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_perf_counter_stats_reset();
+	shell_print(sh, "Performance counters reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_perf_counters,
+	SHELL_CMD_ARG(start, NULL,
+		      "Start counting an event: <counter> cycles|instructions|\n"
+		      "cache-misses|branch-misses|stalls",
+		      cmd_kernel_perf_counters_start, 3, 0),
+	SHELL_CMD_ARG(stop, NULL, "Stop a counter: <counter>",
+		      cmd_kernel_perf_counters_stop, 2, 0),
+	SHELL_CMD(reset, NULL, "Reset the counted events.", cmd_kernel_perf_counters_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(perf_counters, &sub_kernel_perf_counters,
+	       "Hardware performance counters of the system and of each thread.",
+	       cmd_kernel_perf_counters);
@@ -0,0 +1,70 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+static struct k_sched_latency_stats shell_latency_stats;
+
+static int cmd_kernel_sched_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct k_sched_latency_stats *stats = &shell_latency_stats;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		(void)k_sched_latency_stats_get(cpu, stats);
+
+		shell_print(sh, "CPU%u: samples %u, max %u, avg %llu", cpu,
+			    stats->count, stats->max,
+			    (stats->count != 0U) ? (stats->total / stats->count) : 0ULL);
+
+		for (int p = 0; p < K_SCHED_LATENCY_PRIOS; p++) {
+			uint32_t *hist = stats->hist[p];
+			bool used = false;
+
+			for (int b = 0; b < CONFIG_SCHED_LATENCY_STATS_BUCKETS; b++) {
+				used = used || (hist[b] != 0U);
+			}
+
+			if (!used) {
+				continue;
+			}
+
+			shell_fprintf(sh, SHELL_NORMAL, "  prio %3d:",
+				      p + K_HIGHEST_THREAD_PRIO);
+			for (int b = 0; b < CONFIG_SCHED_LATENCY_STATS_BUCKETS; b++) {
+				shell_fprintf(sh, SHELL_NORMAL, " %u", hist[b]);
+			}
+			shell_fprintf(sh, SHELL_NORMAL, "\n");
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_sched_latency_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_sched_latency_stats_reset();
+	shell_print(sh, "Scheduler latency statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_sched_latency,
+	SHELL_CMD(reset, NULL, "Reset the statistics.", cmd_kernel_sched_latency_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(sched_latency, &sub_kernel_sched_latency,
+	       "Wake-to-run latency histograms, buckets are powers of two of the\n"
+	       "runtime statistics time base.",
+	       cmd_kernel_sched_latency);
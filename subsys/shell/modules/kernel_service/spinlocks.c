@@ -0,0 +1,70 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+#define SPINLOCKS_TOP 8
+
+static struct k_spinlock_stats shell_spinlock_stats[SPINLOCKS_TOP];
+
+static int cmd_kernel_spinlocks(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	unsigned int n = k_spinlock_stats_top(shell_spinlock_stats, SPINLOCKS_TOP);
+
+	shell_print(sh, "%-12s %10s %10s %12s %10s %10s", "Lock", "Acquired", "Contended",
+		    "Spins", "Max spins", "Max hold");
+
+	for (unsigned int i = 0; i < n; i++) {
+		const struct k_spinlock_stats *stats = &shell_spinlock_stats[i];
+
+		shell_print(sh, "%-12p %10u %10u %12llu %10u %10u", stats->lock, stats->count,
+			    stats->contended, stats->spins, stats->max_spins, stats->max_hold);
+
+		for (int s = 0; s < CONFIG_SPINLOCK_STATS_SITES; s++) {
+			const struct k_spinlock_site_stats *site = &stats->sites[s];
+
+			if (site->addr == 0U) {
+				continue;
+			}
+
+			shell_print(sh, "  %#-10lx %10u %10u %12llu %10s %10u", site->addr,
+				    site->count, site->contended, site->spins, "", site->max_hold);
+		}
+	}
+
+	if (k_spinlock_stats_dropped() != 0U) {
+		shell_print(sh, "%u acquisitions not recorded, increase "
+			    "CONFIG_SPINLOCK_STATS_LOCKS", k_spinlock_stats_dropped());
+	}
+
+	return 0;
+}
+
+static int cmd_kernel_spinlocks_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_spinlock_stats_reset();
+	shell_print(sh, "Spinlock statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_spinlocks,
+	SHELL_CMD(reset, NULL, "Reset the statistics.", cmd_kernel_spinlocks_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+KERNEL_CMD_ADD(spinlocks, &sub_kernel_spinlocks,
+	       "Most contended spinlocks, with their call sites as return\n"
+	       "addresses of k_spin_lock(). Hold times are in cycles.",
+	       cmd_kernel_spinlocks);
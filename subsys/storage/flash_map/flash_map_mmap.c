@@ -0,0 +1,49 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/storage/flash_map.h>
+#include "flash_map_priv.h"
+
+/* Fixed partitions of flash memory (soc-nv-flash) the CPU can read directly */
+struct flash_area_mem {
+	uint8_t fa_id;
+	off_t fa_off;
+	uintptr_t addr;
+};
+
+#define FLASH_AREA_MEM(part)								\
+	COND_CODE_1(UTIL_AND(DT_NODE_EXISTS(DT_MEM_FROM_FIXED_PARTITION(part)),		\
+			     DT_NODE_HAS_STATUS_OKAY(DT_MTD_FROM_FIXED_PARTITION(part))),	\
+		({.fa_id = DT_FIXED_PARTITION_ID(part),					\
+		  .fa_off = DT_REG_ADDR(part),						\
+		  .addr = DT_FIXED_PARTITION_ADDR(part), },), ())
+
+#define FOR_EACH_PARTITION_TABLE(table) DT_FOREACH_CHILD(table, FLASH_AREA_MEM)
+
+static const struct flash_area_mem flash_area_mem[] = {
+	DT_FOREACH_STATUS_OKAY(fixed_partitions, FOR_EACH_PARTITION_TABLE)
+};
+
+int flash_area_mmap(const struct flash_area *fa, off_t off, size_t len,
+		    const void **addr)
+{
+	if (!is_in_flash_area_bounds(fa, off, len)) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(flash_area_mem); i++) {
+		/* An area of a custom flash map may only share the ID */
+		if ((flash_area_mem[i].fa_id == fa->fa_id) &&
+		    (flash_area_mem[i].fa_off == fa->fa_off)) {
+			*addr = (const void *)(flash_area_mem[i].addr + off);
+			return 0;
+		}
+	}
+
+	return -ENOTSUP;
+}
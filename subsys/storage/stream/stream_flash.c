@@ -129,6 +129,8 @@ static int stream_flash_erase_to_append(struct stream_flash_ctx *ctx, size_t siz
 	return rc;
 }
 
+static int stream_flash_sync_wait(struct stream_flash_ctx *ctx);
+
 #if defined(CONFIG_STREAM_FLASH_ERASE)
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -137,6 +139,12 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 	int rc;
 	struct flash_pages_info page;
 
+	/* The work queue may be erasing ahead */
+	rc = stream_flash_sync_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
 	if (off < ctx->offset || (off - ctx->offset) >= ctx->available) {
 		LOG_ERR("Offset out of designated range");
 		return -ERANGE;
@@ -184,7 +192,8 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Writes len bytes of buf at ctx->bytes_written, without updating it */
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf, size_t len)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -192,33 +201,28 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
-		rc = stream_flash_erase_to_append(ctx, ctx->buf_bytes);
+		rc = stream_flash_erase_to_append(ctx, len);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_forward_erase %d range=0x%08zx",
-				rc, ctx->buf_bytes);
+				rc, len);
 			return rc;
 		}
 	}
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (len % fill_length) {
+		fill_length -= len % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + len, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = len + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -232,18 +236,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < len; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, len);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, len, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
@@ -252,10 +255,162 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 
 #endif
 
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+
+static K_KERNEL_STACK_DEFINE(stream_flash_stack, CONFIG_STREAM_FLASH_DOUBLE_BUFFER_STACK_SIZE);
+static struct k_work_q stream_flash_work_q;
+
+/*
+ * While a half is in flight, the work queue owns it along with
+ * ctx->erased_up_to, and ctx->bytes_written does not move: the caller
+ * only accounts for the half once it waited for it.
+ */
+static void stream_flash_sync_work(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx = CONTAINER_OF(work, struct stream_flash_ctx, sync_work);
+
+	ctx->sync_rc = flash_program(ctx, ctx->sync_buf, ctx->sync_bytes);
+
+	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE) && (ctx->sync_rc == 0)) {
+		/* Erase ahead for the half being filled, failures are
+		 * retried when it is written.
+		 */
+		(void)stream_flash_erase_to_append(ctx,
+			MIN(ctx->sync_bytes + ctx->buf_len, ctx->available - ctx->bytes_written));
+	}
+
+	k_sem_give(&ctx->sync_done);
+}
+
+static int stream_flash_sync_wait(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->sync_bytes == 0) {
+		return 0;
+	}
+
+	(void)k_sem_take(&ctx->sync_done, K_FOREVER);
+
+	rc = ctx->sync_rc;
+	if (rc == 0) {
+		ctx->bytes_written += ctx->sync_bytes;
+	}
+	ctx->sync_bytes = 0;
+
+	return rc;
+}
+
+static int flash_sync_submit(struct stream_flash_ctx *ctx)
+{
+	uint8_t *buf = ctx->buf;
+	int rc;
+
+	rc = stream_flash_sync_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+
+	ctx->buf = ctx->sync_buf;
+	ctx->sync_buf = buf;
+	ctx->sync_bytes = ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+
+	(void)k_work_submit_to_queue(&stream_flash_work_q, &ctx->sync_work);
+
+	return 0;
+}
+
+static inline size_t stream_flash_in_flight(const struct stream_flash_ctx *ctx)
+{
+	return ctx->sync_bytes;
+}
+
+int stream_flash_double_buffer_enable(struct stream_flash_ctx *ctx)
+{
+	size_t half;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	if (ctx->sync_buf != NULL) {
+		return -EALREADY;
+	}
+
+	if (ctx->buf_bytes != 0) {
+		return -EBUSY;
+	}
+
+	half = ctx->buf_len / 2;
+	if (half == 0 || half % ctx->write_block_size) {
+		LOG_ERR("Buffer halves are not aligned to minimal write-block-size");
+		return -EINVAL;
+	}
+
+	ctx->buf_len = half;
+	ctx->sync_buf = ctx->buf + half;
+	ctx->sync_bytes = 0;
+	ctx->sync_rc = 0;
+	k_work_init(&ctx->sync_work, stream_flash_sync_work);
+	k_sem_init(&ctx->sync_done, 0, 1);
+
+	return 0;
+}
+
+static int stream_flash_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "stream_flash"};
+
+	k_work_queue_start(&stream_flash_work_q, stream_flash_stack,
+			   K_KERNEL_STACK_SIZEOF(stream_flash_stack),
+			   CONFIG_STREAM_FLASH_DOUBLE_BUFFER_PRIORITY, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+static inline int stream_flash_sync_wait(struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	return 0;
+}
+
+static inline size_t stream_flash_in_flight(const struct stream_flash_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+	return 0;
+}
+#endif /* CONFIG_STREAM_FLASH_DOUBLE_BUFFER */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	if (ctx->sync_buf != NULL) {
+		return flash_sync_submit(ctx);
+	}
+#endif
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc != 0) {
+		return rc;
+	}
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
-	return rc;
+	return 0;
 }
 
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
@@ -269,7 +424,8 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+	if (ctx->bytes_written + stream_flash_in_flight(ctx) + ctx->buf_bytes + len >
+	    ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -299,6 +455,10 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+	if (flush && rc == 0) {
+		rc = stream_flash_sync_wait(ctx);
+	}
+
 	return rc;
 }
 
@@ -395,6 +555,10 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->offset = offset;
 	ctx->available = size;
 	ctx->write_block_size = params->write_block_size;
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+	ctx->sync_buf = NULL;
+	ctx->sync_bytes = 0;
+#endif
 
 #if !defined(CONFIG_STREAM_FLASH_POST_WRITE_CALLBACK)
 	ARG_UNUSED(cb);
@@ -440,7 +604,11 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
-	int rc = stream_flash_settings_init();
+	int rc = stream_flash_sync_wait(ctx);
+
+	if (rc == 0) {
+		rc = stream_flash_settings_init();
+	}
 
 	if (rc == 0) {
 		rc = settings_load_subtree_direct(settings_key, settings_direct_loader,
@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/toolchain.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -26,6 +27,17 @@ void tracing_buffer_init(void);
  */
 bool tracing_buffer_is_empty(void);
 
+/**
+ * @brief Tracing buffer written by the current CPU is empty or not.
+ *
+ * Same as @ref tracing_buffer_is_empty unless
+ * CONFIG_TRACING_PER_CPU_BUFFERS is enabled. Must be called with
+ * interrupts locked.
+ *
+ * @return true if the ring buffer is empty, or false if not.
+ */
+bool tracing_buffer_local_is_empty(void);
+
 /**
  * @brief Get free space in the tracing buffer.
  *
@@ -104,6 +116,48 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+/**
+ * @brief Claim the data written by a CPU.
+ *
+ * @param cpu  CPU whose buffer is read, 0 without
+ *             CONFIG_TRACING_PER_CPU_BUFFERS.
+ * @param data Pointer to the address. It's set to a location
+ *             within the tracing buffer.
+ * @param size Requested buffer size (in bytes).
+ *
+ * @return Size of the data claimed (in bytes).
+ */
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size);
+
+/**
+ * @brief Indicate number of bytes read from the buffer of a CPU.
+ *
+ * @param cpu  CPU whose buffer is read.
+ * @param size Number of bytes that can be freed.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL Given @a size exceeds claimed space.
+ */
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size);
+
+/** First byte of the header of a chunk of per-CPU data. */
+#define TRACING_CPU_CHUNK_MAGIC0 0x5A
+/** Second byte of the header of a chunk of per-CPU data. */
+#define TRACING_CPU_CHUNK_MAGIC1 0x54
+
+/**
+ * @brief Header output before each chunk of data of a CPU.
+ *
+ * Used with CONFIG_TRACING_PER_CPU_BUFFERS so that the host can split the
+ * output back into one stream per CPU. @a len is little endian.
+ */
+struct tracing_cpu_chunk_hdr {
+	uint8_t magic[2];
+	uint8_t cpu;
+	uint8_t reserved;
+	uint16_t len;
+} __packed;
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
@@ -14,9 +14,16 @@
 extern "C" {
 #endif
 
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+/* Each CPU has its own buffer, locking local interrupts is enough */
+#define TRACING_LOCK()		{ unsigned int key; key = arch_irq_lock()
+
+#define TRACING_UNLOCK()	{ arch_irq_unlock(key); } }
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -4,10 +4,27 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/ring_buffer.h>
+#include <tracing_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#if defined(CONFIG_TRACING_PER_CPU_BUFFERS)
+/* Each CPU writes to its own buffer with only local interrupts locked. The
+ * tracing thread is the single reader of all of them.
+ */
+#define TRACING_BUFFER_CNT CONFIG_MP_MAX_NUM_CPUS
+#define LOCAL_RING_BUF (&tracing_ring_buf[arch_curr_cpu()->id])
+#else
+#define TRACING_BUFFER_CNT 1
+#define LOCAL_RING_BUF (&tracing_ring_buf[0])
+#endif
+
+#define TRACING_BUFFER_SIZE (CONFIG_TRACING_BUFFER_SIZE / TRACING_BUFFER_CNT)
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_CNT];
+static uint8_t tracing_buffer[TRACING_BUFFER_CNT][TRACING_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
@@ -19,51 +36,108 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(LOCAL_RING_BUF, data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		/* Data must be visible to the reading CPU before the index */
+		barrier_dmem_fence_full();
+	}
+
+	return ring_buf_put_finish(LOCAL_RING_BUF, size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	uint8_t *dst;
+	uint32_t partial, total = 0;
+
+	if (!IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		return ring_buf_put(LOCAL_RING_BUF, data, size);
+	}
+
+	do {
+		partial = tracing_buffer_put_claim(&dst, size);
+		memcpy(dst, data, partial);
+		total += partial;
+		size -= partial;
+		data += partial;
+	} while (size && partial);
+
+	tracing_buffer_put_finish(total);
+
+	return total;
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return tracing_buffer_cpu_get_claim(0, data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return tracing_buffer_cpu_get_finish(0, size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(&tracing_ring_buf[0], data, size);
+}
+
+uint32_t tracing_buffer_cpu_get_claim(unsigned int cpu, uint8_t **data, uint32_t size)
+{
+	uint32_t len = ring_buf_get_claim(&tracing_ring_buf[cpu], data, size);
+
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		/* Do not read data older than the index written by the CPU */
+		barrier_dmem_fence_full();
+	}
+
+	return len;
+}
+
+int tracing_buffer_cpu_get_finish(unsigned int cpu, uint32_t size)
+{
+	if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+		/* Data must be read before the space is given back */
+		barrier_dmem_fence_full();
+	}
+
+	return ring_buf_get_finish(&tracing_ring_buf[cpu], size);
 }
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_CNT; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_CNT; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool tracing_buffer_local_is_empty(void)
+{
+	return ring_buf_is_empty(LOCAL_RING_BUF);
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(&tracing_ring_buf[0]);
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(LOCAL_RING_BUF);
 }
@@ -14,6 +14,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
 #include <tracing_core.h>
 #include <tracing_buffer.h>
 #include <tracing_backend.h>
@@ -54,6 +55,30 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+/* Output what each CPU has written, in chunks prefixed with the CPU id */
+static void tracing_cpu_buffers_drain(uint32_t max_length)
+{
+	struct tracing_cpu_chunk_hdr hdr = {
+		.magic = { TRACING_CPU_CHUNK_MAGIC0, TRACING_CPU_CHUNK_MAGIC1 },
+	};
+	uint8_t *data;
+	uint32_t length;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		length = tracing_buffer_cpu_get_claim(cpu, &data,
+						      MIN(max_length, UINT16_MAX));
+		if (length == 0) {
+			continue;
+		}
+
+		hdr.cpu = cpu;
+		hdr.len = sys_cpu_to_le16(length);
+		tracing_buffer_handle((uint8_t *)&hdr, sizeof(hdr));
+		tracing_buffer_handle(data, length);
+		tracing_buffer_cpu_get_finish(cpu, length);
+	}
+}
+
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -66,6 +91,8 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 	while (true) {
 		if (tracing_buffer_is_empty()) {
 			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		} else if (IS_ENABLED(CONFIG_TRACING_PER_CPU_BUFFERS)) {
+			tracing_cpu_buffers_drain(tracing_buffer_max_length);
 		} else {
 			transferring_length =
 				tracing_buffer_get_claim(
@@ -35,7 +35,6 @@ enum {
 	CDC_NCM_IFACE_UP,
 	CDC_NCM_DATA_IFACE_ENABLED,
 	CDC_NCM_CLASS_SUSPENDED,
-	CDC_NCM_OUT_ENGAGED,
 };
 
 /* Chapter 6.2.7 table 6-4 */
@@ -171,11 +170,13 @@ union recv_ntb {
 } __packed;
 
 /*
- * Transfers through two endpoints proceed in a synchronous manner,
+ * IN transfers proceed in a synchronous manner, while up to
+ * CONFIG_USBD_CDC_NCM_OUT_BUF_COUNT OUT transfers are kept queued,
  * with maximum block of CDC_NCM_SEND_NTB_MAX_SIZE.
  */
 UDC_BUF_POOL_DEFINE(cdc_ncm_ep_pool,
-		    DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
+		    DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) *
+		    (1 + CONFIG_USBD_CDC_NCM_OUT_BUF_COUNT),
 		    MAX(CDC_NCM_SEND_NTB_MAX_SIZE, CDC_NCM_RECV_NTB_MAX_SIZE),
 		    sizeof(struct udc_buf_info), NULL);
 
@@ -226,6 +227,8 @@ struct cdc_ncm_eth_data {
 	uint8_t mac_addr[6];
 
 	atomic_t state;
+	/* Number of OUT transfers queued on the bulk OUT endpoint */
+	atomic_t out_queued;
 	enum iface_state if_state;
 	uint16_t tx_seq;
 	uint16_t rx_seq;
@@ -323,25 +326,30 @@ static int cdc_ncm_out_start(struct usbd_class_data *const c_data)
 	uint8_t ep;
 	int ret;
 
-	if (atomic_test_and_set_bit(&data->state, CDC_NCM_OUT_ENGAGED)) {
-		return -EBUSY;
-	}
-
 	ep = cdc_ncm_get_bulk_out(c_data);
-	buf = cdc_ncm_buf_alloc(ep);
-	if (buf == NULL) {
-		return -ENOMEM;
-	}
 
-	ret = usbd_ep_enqueue(c_data, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
-	} else {
+	/* Keep the endpoint busy while the previous NTBs are processed */
+	while (atomic_inc(&data->out_queued) < CONFIG_USBD_CDC_NCM_OUT_BUF_COUNT) {
+		buf = cdc_ncm_buf_alloc(ep);
+		if (buf == NULL) {
+			atomic_dec(&data->out_queued);
+			return -ENOMEM;
+		}
+
+		ret = usbd_ep_enqueue(c_data, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
+			atomic_dec(&data->out_queued);
+			net_buf_unref(buf);
+			return ret;
+		}
+
 		LOG_DBG("enqueue out %u", buf->size);
 	}
 
-	return  ret;
+	atomic_dec(&data->out_queued);
+
+	return 0;
 }
 
 static int verify_nth16(struct cdc_ncm_eth_data *const data,
@@ -608,7 +616,7 @@ unref_packet:
 restart_out_transfer:
 	net_buf_unref(buf);
 
-	atomic_clear_bit(&data->state, CDC_NCM_OUT_ENGAGED);
+	atomic_dec(&data->out_queued);
 	if (atomic_test_bit(&data->state, CDC_NCM_DATA_IFACE_ENABLED)) {
 		return cdc_ncm_out_start(c_data);
 	}
@@ -254,6 +254,7 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 {
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
 	int bytes_queued = 0;
+	bool refill = false;
 	struct net_buf *buf;
 	uint8_t ep;
 	size_t len;
@@ -293,7 +294,14 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		ctx->scsi_offset += len;
 
 		if (ctx->scsi_bytes == ctx->scsi_offset) {
-			/* SCSI buffer can be reused now */
+			/* SCSI buffer can be reused now, but there is no need
+			 * to wait for the disk when the net buf is full.
+			 */
+			if (bytes_queued == MSC_BUF_SIZE) {
+				refill = true;
+				break;
+			}
+
 			ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
 			ctx->scsi_offset = 0;
 		}
@@ -307,6 +315,15 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 		net_buf_unref(buf);
 		atomic_clear_bit(&ctx->bits, MSC_BULK_IN_QUEUED);
 	}
+
+	/* Read the next data from the disk while the IN transfer is ongoing.
+	 * The transfer completion is handled by this thread, so the state is
+	 * consistent again before it is processed.
+	 */
+	if (refill) {
+		ctx->scsi_bytes = scsi_read_data(lun, ctx->scsi_buf);
+		ctx->scsi_offset = 0;
+	}
 }
 
 static void msc_process_cbw(struct msc_bot_ctx *ctx)
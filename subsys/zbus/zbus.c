@@ -6,6 +6,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/net_buf.h>
@@ -34,10 +35,18 @@ static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, si
 
 #else
 
-NET_BUF_POOL_FIXED_DEFINE(_zbus_msg_subscribers_pool,
-			  (CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE),
-			  (CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE),
-			  sizeof(struct zbus_channel *), NULL);
+/* Room for every buffer of the pool to hold its own message: the data, its
+ * reference count and the heap chunk header. Clones delivered to the message
+ * subscribers share the data of the published buffer instead of copying it.
+ */
+#define _ZBUS_MSG_SUBSCRIBER_NET_BUF_HEAP_SIZE                                                     \
+	(Z_HEAP_MIN_SIZE +                                                                         \
+	 CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE *                                            \
+		 ROUND_UP(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE + 2 * sizeof(void *), \
+			  8))
+
+NET_BUF_POOL_VAR_DEFINE(_zbus_msg_subscribers_pool, (CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE),
+			_ZBUS_MSG_SUBSCRIBER_NET_BUF_HEAP_SIZE, sizeof(struct zbus_channel *), NULL);
 
 static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, size_t size,
 						   k_timeout_t timeout)
@@ -46,7 +55,7 @@ static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, si
 		 "CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE must be greater or equal to "
 		 "%d",
 		 (int)size);
-	return net_buf_alloc(pool, timeout);
+	return net_buf_alloc_len(pool, size, timeout);
 }
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC */
 
@@ -374,6 +383,43 @@ static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 }
 
+/* Marks the beginning and the end of a change of the message, under the channel semaphore */
+static inline void chan_msg_change(const struct zbus_channel *chan)
+{
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	atomic_inc(&chan->data->seq);
+#else
+	ARG_UNUSED(chan);
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+}
+
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+/* Number of lock-free attempts before falling back to the semaphore */
+#define ZBUS_SEQLOCK_READ_TRIES 2
+
+static inline bool chan_read_seqlock(const struct zbus_channel *chan, void *msg)
+{
+	for (int i = 0; i < ZBUS_SEQLOCK_READ_TRIES; i++) {
+		atomic_val_t seq = atomic_get(&chan->data->seq);
+
+		if (seq & 1) {
+			/* Being written, possibly by a context this one preempted */
+			return false;
+		}
+
+		memcpy(msg, chan->message, chan->message_size);
+
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&chan->data->seq) == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -405,7 +451,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 	chan->data->publish_count += 1;
 #endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
 
+	chan_msg_change(chan);
 	memcpy(chan->message, msg, chan->message_size);
+	chan_msg_change(chan);
 
 	err = _zbus_vded_exec(chan, end_time);
 
@@ -425,6 +473,12 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		timeout = K_NO_WAIT;
 	}
 
+#if defined(CONFIG_ZBUS_CHANNEL_SEQLOCK)
+	if (chan_read_seqlock(chan, msg)) {
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_CHANNEL_SEQLOCK */
+
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
@@ -481,6 +535,9 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The message may be changed in place until the channel is finished */
+	chan_msg_change(chan);
+
 	return 0;
 }
 
@@ -488,6 +545,8 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	chan_msg_change(chan);
+
 	k_sem_give(&chan->data->sem);
 
 	return 0;
@@ -533,6 +592,51 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+int zbus_sub_wait_msg_batch(const struct zbus_observer *sub, const struct zbus_channel **chans,
+			    void *msgs, size_t msg_size, size_t max, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_msg_batch cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chans != NULL, "chans is required");
+	_ZBUS_ASSERT(msgs != NULL, "msgs is required");
+	_ZBUS_ASSERT(max > 0, "max must be greater than zero");
+
+	uint8_t *msg = msgs;
+	size_t count = 0;
+
+	while (count < max) {
+		struct net_buf *buf =
+			k_fifo_get(sub->message_fifo, (count == 0) ? timeout : K_NO_WAIT);
+
+		if (buf == NULL) {
+			break;
+		}
+
+		const struct zbus_channel *chan = *((struct zbus_channel **)net_buf_user_data(buf));
+
+		if (zbus_chan_msg_size(chan) > msg_size) {
+			/* Left for a call with a large enough slot */
+			k_queue_prepend(&sub->message_fifo->_queue, buf);
+
+			return (count == 0) ? -EMSGSIZE : (int)count;
+		}
+
+		chans[count] = chan;
+		memcpy(msg, net_buf_remove_mem(buf, zbus_chan_msg_size(chan)),
+		       zbus_chan_msg_size(chan));
+
+		net_buf_unref(buf);
+
+		msg += msg_size;
+		count++;
+	}
+
+	return (count == 0) ? -ENOMSG : (int)count;
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
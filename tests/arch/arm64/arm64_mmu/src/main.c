@@ -6,7 +6,9 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
+#include <zephyr/kernel/internal/mm.h>
 #include <kernel_arch_interface.h>
+#include <mmu.h>
 
 /*
  * Virtual and physical addresses used to exercize MMU page table recycling.
@@ -21,6 +23,9 @@
 extern int arm64_mmu_nb_free_tables(void);
 extern int arm64_mmu_tables_total_usage(void);
 
+/* Number of descriptors in a table usage count, the upper bits count references */
+#define PTE_COUNT(usage) ((usage) & GENMASK(15, 0))
+
 /* initial states to compare against */
 static int initial_nb_free_tables;
 static int initial_tables_usage;
@@ -218,4 +223,55 @@ ZTEST(arm64_mmu, test_arm64_mmu_05_hole_in_block)
 		     "%#x vs %#x", unmapped_tables_usage, initial_tables_usage);
 }
 
+ZTEST(arm64_mmu, test_arm64_mmu_06_large_mapping)
+{
+	/*
+	 * Map a block of RAM along with the page before and the page after
+	 * it, at the end of RAM away from the kernel image. K_MEM_MAP_LARGE
+	 * lines up the virtual address with the physical one within a block,
+	 * so that the whole block takes a single descriptor instead of a
+	 * table of pages.
+	 */
+	int table_entries = CONFIG_MMU_PAGE_SIZE / sizeof(uint64_t);
+	size_t block_size = table_entries * CONFIG_MMU_PAGE_SIZE;
+	uintptr_t block = ROUND_DOWN(K_MEM_PHYS_RAM_END, block_size) - 2 * block_size;
+	uintptr_t phys = block - CONFIG_MMU_PAGE_SIZE;
+	size_t size = block_size + 2 * CONFIG_MMU_PAGE_SIZE;
+	uintptr_t page_phys;
+	uint8_t *virt;
+	int usage_before = arm64_mmu_tables_total_usage();
+	int usage;
+
+	zassert_equal(arch_mem_large_page_size(phys, size), block_size);
+
+	k_mem_map_phys_bare(&virt, phys, size, K_MEM_CACHE_WB | K_MEM_PERM_RW | K_MEM_MAP_LARGE);
+	zassert_not_null(virt, "cannot map 0x%lx", phys);
+
+	usage = arm64_mmu_tables_total_usage() - usage_before;
+
+	TC_PRINT("  Mapped 0x%lx at %p, table usage %+#x\n", phys, virt, usage);
+
+	zassert_equal(((uintptr_t)virt - phys) & (block_size - 1), 0,
+		      "%p not congruent to 0x%lx", virt, phys);
+	zassert_true(PTE_COUNT(usage) < table_entries, "block mapped with pages (%#x)", usage);
+
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		zassert_ok(arch_page_phys_get(virt + offset, &page_phys));
+		zassert_equal(page_phys, phys + offset, "%p maps 0x%lx instead of 0x%lx",
+			      virt + offset, page_phys, phys + offset);
+
+		virt[offset] = (uint8_t)(offset / CONFIG_MMU_PAGE_SIZE);
+	}
+
+	for (size_t offset = 0; offset < size; offset += CONFIG_MMU_PAGE_SIZE) {
+		zassert_equal(virt[offset], (uint8_t)(offset / CONFIG_MMU_PAGE_SIZE),
+			      "bad data at %p", virt + offset);
+	}
+
+	k_mem_unmap_phys_bare(virt, size);
+
+	zassert_equal(arch_page_phys_get(virt + CONFIG_MMU_PAGE_SIZE, NULL), -EFAULT);
+	zassert_equal(arm64_mmu_tables_total_usage(), usage_before, "tables not released");
+}
+
 ZTEST_SUITE(arm64_mmu, NULL, arm64_mmu_test_init, NULL, NULL, NULL);
@@ -0,0 +1,158 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief B-tree and red/black tree benchmark
+ *
+ * @defgroup lib_btree_perf_tests B-tree performance
+ *
+ * Measures inserting, finding, walking and removing the same scattered keys
+ * in a sys_btree and in an rbtree, to compare the two ordered containers.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/btree.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_KEYS 1024
+
+struct rb_item {
+	struct rbnode node;
+	uint64_t key;
+};
+
+static struct rb_item items[NUM_KEYS];
+static struct rbtree rb_tree;
+static SYS_BTREE_DEFINE(b_tree);
+
+static bool rb_item_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct rb_item, node)->key <
+	       CONTAINER_OF(b, struct rb_item, node)->key;
+}
+
+static void report(const char *name, const char *op, uint64_t cycles)
+{
+	uint64_t avg = cycles / NUM_KEYS;
+
+	printk("REC: btree_perf.%s.%-7s : %7llu cycles , %7u ns :\n", name, op, avg,
+	       (uint32_t)timing_cycles_to_ns(avg));
+}
+
+/**
+ * @brief Measure the B-tree
+ *
+ * @ingroup lib_btree_perf_tests
+ */
+ZTEST(btree_perf, test_btree)
+{
+	struct sys_btree_iter it;
+	timing_t start, finish;
+	uint64_t prev = 0;
+	size_t count = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		zassert_equal(sys_btree_insert(&b_tree, items[i].key, i, NULL), 1);
+	}
+	finish = timing_counter_get();
+	report("btree", "insert", timing_cycles_get(&start, &finish));
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		zassert_true(sys_btree_contains_key(&b_tree, items[i].key));
+	}
+	finish = timing_counter_get();
+	report("btree", "find", timing_cycles_get(&start, &finish));
+
+	start = timing_counter_get();
+	SYS_BTREE_FOR_EACH(&b_tree, it) {
+		zassert_true(count == 0 || it.key > prev);
+		prev = it.key;
+		count++;
+	}
+	finish = timing_counter_get();
+	zassert_equal(count, NUM_KEYS);
+	report("btree", "walk", timing_cycles_get(&start, &finish));
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		zassert_true(sys_btree_remove(&b_tree, items[i].key, NULL));
+	}
+	finish = timing_counter_get();
+	report("btree", "remove", timing_cycles_get(&start, &finish));
+}
+
+/**
+ * @brief Measure the red/black tree with the same keys
+ *
+ * @ingroup lib_btree_perf_tests
+ */
+ZTEST(btree_perf, test_rbtree)
+{
+	struct rb_item *item;
+	timing_t start, finish;
+	uint64_t prev = 0;
+	size_t count = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		rb_insert(&rb_tree, &items[i].node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "insert", timing_cycles_get(&start, &finish));
+
+	/* rb_contains() searches by key, like a lookup would */
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		zassert_true(rb_contains(&rb_tree, &items[i].node));
+	}
+	finish = timing_counter_get();
+	report("rbtree", "find", timing_cycles_get(&start, &finish));
+
+	start = timing_counter_get();
+	RB_FOR_EACH_CONTAINER(&rb_tree, item, node) {
+		zassert_true(count == 0 || item->key > prev);
+		prev = item->key;
+		count++;
+	}
+	finish = timing_counter_get();
+	zassert_equal(count, NUM_KEYS);
+	report("rbtree", "walk", timing_cycles_get(&start, &finish));
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_KEYS; i++) {
+		rb_remove(&rb_tree, &items[i].node);
+	}
+	finish = timing_counter_get();
+	report("rbtree", "remove", timing_cycles_get(&start, &finish));
+}
+
+static void *btree_perf_setup(void)
+{
+	/* Distinct keys in scattered order, the multiplier being odd */
+	for (int i = 0; i < NUM_KEYS; i++) {
+		items[i].key = (uint64_t)i * 0x9e3779b97f4a7c15ULL;
+	}
+
+	rb_tree.lessthan_fn = rb_item_lessthan;
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void btree_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(btree_perf, NULL, btree_perf_setup, NULL, NULL, btree_perf_teardown);
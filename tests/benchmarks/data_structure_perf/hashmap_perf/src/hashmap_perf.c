@@ -0,0 +1,155 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Hashmap benchmark
+ *
+ * @defgroup lib_hashmap_perf_tests Hashmap performance
+ *
+ * Measures inserting, finding, missing and removing keys in each of the
+ * hashmap implementations enabled in the build, at the default load factor.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_KEYS 512
+#define NUM_ROUNDS 10
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_SWISS_DEFINE_STATIC(swiss_map);
+#if defined(CONFIG_SYS_HASH_MAP_CXX)
+SYS_HASHMAP_CXX_DEFINE_STATIC(cxx_map);
+#endif
+
+/* Spread out keys, like pointers or identifiers would be */
+static inline uint64_t key_of(uint32_t i)
+{
+	return (uint64_t)i * 0x9e3779b1U;
+}
+
+static void report(const char *name, const char *op, uint64_t cycles)
+{
+	uint64_t avg = cycles / (NUM_ROUNDS * NUM_KEYS);
+
+	printk("REC: hashmap_perf.%s.%-8s : %7llu cycles , %7u ns :\n", name, op, avg,
+	       (uint32_t)timing_cycles_to_ns(avg));
+}
+
+static void run(const char *name, struct sys_hashmap *map)
+{
+	uint64_t insert_cycles = 0;
+	uint64_t get_cycles = 0;
+	uint64_t miss_cycles = 0;
+	uint64_t remove_cycles = 0;
+	timing_t start, finish;
+	uint64_t value;
+
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		start = timing_counter_get();
+		for (uint32_t i = 0; i < NUM_KEYS; i++) {
+			zassert_equal(sys_hashmap_insert(map, key_of(i), i, NULL), 1,
+				      "insert failed");
+		}
+		finish = timing_counter_get();
+		insert_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (uint32_t i = 0; i < NUM_KEYS; i++) {
+			zassert_true(sys_hashmap_get(map, key_of(i), &value), "key not found");
+		}
+		finish = timing_counter_get();
+		get_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (uint32_t i = 0; i < NUM_KEYS; i++) {
+			zassert_false(sys_hashmap_get(map, key_of(i + NUM_KEYS), &value),
+				      "unexpected key");
+		}
+		finish = timing_counter_get();
+		miss_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (uint32_t i = 0; i < NUM_KEYS; i++) {
+			zassert_true(sys_hashmap_remove(map, key_of(i), NULL), "remove failed");
+		}
+		finish = timing_counter_get();
+		remove_cycles += timing_cycles_get(&start, &finish);
+
+		zassert_true(sys_hashmap_is_empty(map), "map not empty");
+	}
+
+	report(name, "insert", insert_cycles);
+	report(name, "get", get_cycles);
+	report(name, "get_miss", miss_cycles);
+	report(name, "remove", remove_cycles);
+
+	sys_hashmap_clear(map, NULL, NULL);
+}
+
+/**
+ * @brief Measure the separate chaining hashmap
+ *
+ * @ingroup lib_hashmap_perf_tests
+ */
+ZTEST(hashmap_perf, test_separate_chaining)
+{
+	run("sc", &sc_map);
+}
+
+/**
+ * @brief Measure the linear probe open addressing hashmap
+ *
+ * @ingroup lib_hashmap_perf_tests
+ */
+ZTEST(hashmap_perf, test_open_addressing)
+{
+	run("oa_lp", &oa_lp_map);
+}
+
+/**
+ * @brief Measure the Swiss table hashmap
+ *
+ * @ingroup lib_hashmap_perf_tests
+ */
+ZTEST(hashmap_perf, test_swiss_table)
+{
+	run("swiss", &swiss_map);
+}
+
+/**
+ * @brief Measure the C++ std::unordered_map wrapper
+ *
+ * @ingroup lib_hashmap_perf_tests
+ */
+ZTEST(hashmap_perf, test_cxx)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_SYS_HASH_MAP_CXX);
+
+#if defined(CONFIG_SYS_HASH_MAP_CXX)
+	run("cxx", &cxx_map);
+#endif
+}
+
+static void *hashmap_perf_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void hashmap_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(hashmap_perf, NULL, hashmap_perf_setup, NULL, NULL, hashmap_perf_teardown);
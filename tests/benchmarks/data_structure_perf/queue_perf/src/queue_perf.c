@@ -0,0 +1,224 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief k_queue uncontended path benchmark
+ *
+ * @defgroup kernel_queue_perf_tests Queue performance
+ *
+ * Measures the cost of handing items through a k_fifo when no consumer
+ * is waiting, and compares it to a queue guarded by a plain spinlock and
+ * to the lock-free MPSC queue. The latter is what a lock-free k_queue
+ * producer path could at best save, k_queue keeps its lock.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/sflist.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_ITEMS 64
+#define NUM_ROUNDS 100
+
+struct item {
+	union {
+		void *fifo_reserved;
+		sys_sfnode_t sfnode;
+		struct mpsc_node mpsc_node;
+	};
+	int value;
+};
+
+static struct item items[NUM_ITEMS];
+
+static K_FIFO_DEFINE(perf_fifo);
+
+/* Baseline: what every k_queue operation costs with the lock always taken */
+static struct {
+	struct k_spinlock lock;
+	sys_sflist_t list;
+} locked_q;
+
+static struct mpsc mpsc_q = MPSC_INIT(mpsc_q);
+
+static void locked_append(struct item *it)
+{
+	K_SPINLOCK(&locked_q.lock) {
+		sys_sfnode_init(&it->sfnode, 0x0);
+		sys_sflist_append(&locked_q.list, &it->sfnode);
+	}
+}
+
+static struct item *locked_get(void)
+{
+	sys_sfnode_t *node = NULL;
+
+	K_SPINLOCK(&locked_q.lock) {
+		node = sys_sflist_get(&locked_q.list);
+	}
+
+	return (node == NULL) ? NULL : CONTAINER_OF(node, struct item, sfnode);
+}
+
+static void report(const char *tag, uint64_t cycles, uint32_t ops)
+{
+	uint64_t avg = cycles / ops;
+
+	printk("REC: queue_perf.%-22s : %7llu cycles , %7u ns :\n", tag, avg,
+	       (uint32_t)timing_cycles_to_ns(avg));
+}
+
+/**
+ * @brief Measure appending to and getting from a k_fifo without waiters
+ *
+ * @ingroup kernel_queue_perf_tests
+ *
+ * @see k_fifo_put(), k_fifo_get()
+ */
+ZTEST(queue_perf, test_fifo_put_get)
+{
+	uint64_t put_cycles = 0;
+	uint64_t get_cycles = 0;
+	timing_t start, finish;
+
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			k_fifo_put(&perf_fifo, &items[i]);
+		}
+		finish = timing_counter_get();
+		put_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			struct item *it = k_fifo_get(&perf_fifo, K_NO_WAIT);
+
+			zassert_equal_ptr(it, &items[i], "fifo order broken");
+		}
+		finish = timing_counter_get();
+		get_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	report("fifo.put", put_cycles, NUM_ROUNDS * NUM_ITEMS);
+	report("fifo.get", get_cycles, NUM_ROUNDS * NUM_ITEMS);
+}
+
+/**
+ * @brief Measure polling an empty k_fifo
+ *
+ * @ingroup kernel_queue_perf_tests
+ *
+ * @see k_fifo_get()
+ */
+ZTEST(queue_perf, test_fifo_get_empty)
+{
+	uint64_t cycles;
+	timing_t start, finish;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_ROUNDS * NUM_ITEMS; i++) {
+		zassert_is_null(k_fifo_get(&perf_fifo, K_NO_WAIT), "fifo not empty");
+	}
+	finish = timing_counter_get();
+	cycles = timing_cycles_get(&start, &finish);
+
+	report("fifo.get_empty", cycles, NUM_ROUNDS * NUM_ITEMS);
+}
+
+/**
+ * @brief Measure the same pattern on a spinlock-protected list
+ *
+ * @ingroup kernel_queue_perf_tests
+ */
+ZTEST(queue_perf, test_spinlock_put_get)
+{
+	uint64_t put_cycles = 0;
+	uint64_t get_cycles = 0;
+	uint64_t empty_cycles;
+	timing_t start, finish;
+
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			locked_append(&items[i]);
+		}
+		finish = timing_counter_get();
+		put_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			zassert_equal_ptr(locked_get(), &items[i], "list order broken");
+		}
+		finish = timing_counter_get();
+		get_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_ROUNDS * NUM_ITEMS; i++) {
+		zassert_is_null(locked_get(), "list not empty");
+	}
+	finish = timing_counter_get();
+	empty_cycles = timing_cycles_get(&start, &finish);
+
+	report("spinlock.put", put_cycles, NUM_ROUNDS * NUM_ITEMS);
+	report("spinlock.get", get_cycles, NUM_ROUNDS * NUM_ITEMS);
+	report("spinlock.get_empty", empty_cycles, NUM_ROUNDS * NUM_ITEMS);
+}
+
+/**
+ * @brief Measure the same pattern on the lock-free MPSC queue
+ *
+ * @ingroup kernel_queue_perf_tests
+ *
+ * @see mpsc_push(), mpsc_pop()
+ */
+ZTEST(queue_perf, test_mpsc_push_pop)
+{
+	uint64_t push_cycles = 0;
+	uint64_t pop_cycles = 0;
+	timing_t start, finish;
+
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			mpsc_push(&mpsc_q, &items[i].mpsc_node);
+		}
+		finish = timing_counter_get();
+		push_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		for (int i = 0; i < NUM_ITEMS; i++) {
+			struct mpsc_node *n = mpsc_pop(&mpsc_q);
+
+			zassert_equal_ptr(n, &items[i].mpsc_node, "mpsc order broken");
+		}
+		finish = timing_counter_get();
+		pop_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	report("mpsc.push", push_cycles, NUM_ROUNDS * NUM_ITEMS);
+	report("mpsc.pop", pop_cycles, NUM_ROUNDS * NUM_ITEMS);
+}
+
+static void *queue_perf_setup(void)
+{
+	sys_sflist_init(&locked_q.list);
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+static void queue_perf_teardown(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	timing_stop();
+}
+
+ZTEST_SUITE(queue_perf, NULL, queue_perf_setup, NULL, NULL, queue_perf_teardown);
@@ -81,6 +81,22 @@ void preemptive_entry(void *p1, void *p2, void *p3)
 	}
 }
 
+#ifdef CONFIG_SCHED_IPI_STATS
+static void report_ipi_stats(struct k_ipi_stats *last)
+{
+	struct k_ipi_stats stats;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		k_ipi_stats_get(i, &stats);
+		printf("    - CPU #%u IPIs Requested: %u Sent: %u Received: %u\n", i,
+		       stats.requested - last[i].requested, stats.sent - last[i].sent,
+		       stats.received - last[i].received);
+		last[i] = stats;
+	}
+}
+#endif
+
 void report(void)
 {
 	unsigned int elapsed_time = IPI_TEST_INTERVAL_DURATION;
@@ -92,6 +108,9 @@ void report(void)
 	unsigned long tmp_preempt[NUM_PREEMPTIVE_THREADS] = {};
 	unsigned int i;
 	unsigned int tmp_ipi_counter;
+#ifdef CONFIG_SCHED_IPI_STATS
+	struct k_ipi_stats last_ipi_stats[CONFIG_MP_MAX_NUM_CPUS] = {};
+#endif
 
 	atomic_set(&ipi_counter, 0);
 
@@ -129,6 +148,9 @@ void report(void)
 		}
 
 		printf("  IPI Count: %u\n", tmp_ipi_counter);
+#ifdef CONFIG_SCHED_IPI_STATS
+		report_ipi_stats(last_ipi_stats);
+#endif
 
 		printf("  Total Work: %lu\n", total_work);
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief C library string functions benchmark
+ *
+ * @defgroup libc_string_perf_tests C library string performance
+ *
+ * Measures memcpy(), memset(), memcmp() and strlen() of the C library the
+ * test is built with, for a few lengths and alignments. Run it once per
+ * C library to compare them on the same target.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#define BUF_SIZE 1024
+#define NUM_ROUNDS 100
+
+static uint8_t src_buf[BUF_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+static uint8_t dst_buf[BUF_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+
+/* Kept out of reach of the optimizer, so the calls are made */
+static volatile size_t lengths[] = { 16, 64, 256, BUF_SIZE };
+static volatile size_t offsets[] = { 0, 1 };
+
+static void report(const char *tag, size_t len, size_t off, uint64_t cycles)
+{
+	uint64_t avg = cycles / NUM_ROUNDS;
+
+	printk("REC: libc_string.%s.%zu.%s : %7llu cycles , %7u ns :\n", tag, len,
+	       (off == 0) ? "aligned" : "unaligned", avg, (uint32_t)timing_cycles_to_ns(avg));
+}
+
+static void *libc_string_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	for (size_t i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = (i % 251) + 1;
+	}
+
+	return NULL;
+}
+
+static void libc_string_teardown(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	timing_stop();
+}
+
+/**
+ * @brief Measure memcpy() between buffers of the same and of different alignment
+ *
+ * @ingroup libc_string_perf_tests
+ */
+ZTEST(libc_string, test_memcpy)
+{
+	timing_t start, finish;
+
+	for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+		for (size_t o = 0; o < ARRAY_SIZE(offsets); o++) {
+			size_t len = lengths[l];
+			size_t off = offsets[o];
+
+			start = timing_counter_get();
+			for (int r = 0; r < NUM_ROUNDS; r++) {
+				memcpy(&dst_buf[off], src_buf, len);
+			}
+			finish = timing_counter_get();
+
+			zassert_mem_equal(&dst_buf[off], src_buf, len);
+			report("memcpy", len, off, timing_cycles_get(&start, &finish));
+		}
+	}
+}
+
+/**
+ * @brief Measure memset()
+ *
+ * @ingroup libc_string_perf_tests
+ */
+ZTEST(libc_string, test_memset)
+{
+	timing_t start, finish;
+
+	for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+		for (size_t o = 0; o < ARRAY_SIZE(offsets); o++) {
+			size_t len = lengths[l];
+			size_t off = offsets[o];
+
+			start = timing_counter_get();
+			for (int r = 0; r < NUM_ROUNDS; r++) {
+				memset(&dst_buf[off], r, len);
+			}
+			finish = timing_counter_get();
+
+			zassert_equal(dst_buf[off + len - 1], (uint8_t)(NUM_ROUNDS - 1));
+			report("memset", len, off, timing_cycles_get(&start, &finish));
+		}
+	}
+}
+
+/**
+ * @brief Measure memcmp() of equal buffers, the worst case
+ *
+ * @ingroup libc_string_perf_tests
+ */
+ZTEST(libc_string, test_memcmp)
+{
+	timing_t start, finish;
+	int ret = 0;
+
+	for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+		for (size_t o = 0; o < ARRAY_SIZE(offsets); o++) {
+			size_t len = lengths[l];
+			size_t off = offsets[o];
+			/* Pure functions, keep the calls in the loop */
+			const uint8_t *volatile buf = &dst_buf[off];
+
+			memcpy(&dst_buf[off], src_buf, len);
+
+			start = timing_counter_get();
+			for (int r = 0; r < NUM_ROUNDS; r++) {
+				ret |= memcmp(buf, src_buf, len);
+			}
+			finish = timing_counter_get();
+
+			zassert_equal(ret, 0);
+			report("memcmp", len, off, timing_cycles_get(&start, &finish));
+		}
+	}
+}
+
+/**
+ * @brief Measure strlen()
+ *
+ * @ingroup libc_string_perf_tests
+ */
+ZTEST(libc_string, test_strlen)
+{
+	timing_t start, finish;
+	size_t ret = 0;
+
+	for (size_t l = 0; l < ARRAY_SIZE(lengths); l++) {
+		for (size_t o = 0; o < ARRAY_SIZE(offsets); o++) {
+			size_t len = lengths[l];
+			size_t off = offsets[o];
+			const char *volatile str = (const char *)&dst_buf[off];
+
+			memcpy(&dst_buf[off], src_buf, len - 1);
+			dst_buf[off + len - 1] = '\0';
+
+			start = timing_counter_get();
+			for (int r = 0; r < NUM_ROUNDS; r++) {
+				ret = strlen(str);
+			}
+			finish = timing_counter_get();
+
+			zassert_equal(ret, len - 1);
+			report("strlen", len, off, timing_cycles_get(&start, &finish));
+		}
+	}
+}
+
+ZTEST_SUITE(libc_string, NULL, libc_string_setup, NULL, NULL, libc_string_teardown);
@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the network stack throughput and per packet CPU cost using zperf.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/tc_util.h>
+
+#define LOOPBACK_PEER "127.0.0.1"
+
+typedef int (*upload_fn)(const struct zperf_upload_params *param, struct zperf_results *result);
+
+static struct k_mem_slab *pkt_rx_slab;
+static struct k_mem_slab *pkt_tx_slab;
+static struct net_buf_pool *buf_rx_pool;
+static struct net_buf_pool *buf_tx_pool;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result, void *user_data)
+{
+	ARG_UNUSED(result);
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_ERROR) {
+		TC_ERROR("zperf server session failed\n");
+	}
+}
+
+static int servers_start(void)
+{
+	struct zperf_download_params param = {
+		.port = CONFIG_NET_BENCH_PORT,
+	};
+	int ret;
+
+	ret = zperf_udp_download(&param, server_cb, NULL);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return zperf_tcp_download(&param, server_cb, NULL);
+}
+
+static void mem_usage_reset(void)
+{
+	(void)k_mem_slab_runtime_stats_reset_max(pkt_rx_slab);
+	(void)k_mem_slab_runtime_stats_reset_max(pkt_tx_slab);
+	buf_rx_pool->max_used = 0U;
+	buf_tx_pool->max_used = 0U;
+}
+
+static uint64_t cpu_cycles_get(void)
+{
+	k_thread_runtime_stats_t stats;
+
+	(void)k_thread_runtime_stats_all_get(&stats);
+
+	/* Cycles the CPUs were not idle */
+	return stats.total_cycles;
+}
+
+static int run(const char *name, upload_fn upload, const struct zperf_upload_params *param)
+{
+	struct zperf_results result = { 0 };
+	uint64_t cycles;
+	uint64_t mbps_x100;
+	uint32_t pps;
+	int ret;
+
+	mem_usage_reset();
+	cycles = cpu_cycles_get();
+
+	ret = upload(param, &result);
+	if (ret < 0) {
+		TC_ERROR("%s upload failed (%d)\n", name, ret);
+		return ret;
+	}
+
+	cycles = cpu_cycles_get() - cycles;
+
+	if ((result.nb_packets_sent == 0U) || (result.client_time_in_us == 0U)) {
+		TC_ERROR("%s upload sent nothing\n", name);
+		return -EIO;
+	}
+
+	mbps_x100 = (result.total_len * 8U * 100U) / result.client_time_in_us;
+	pps = (uint32_t)(((uint64_t)result.nb_packets_sent * USEC_PER_SEC) /
+			 result.client_time_in_us);
+
+	printk("%s: %u.%02u Mbps %u pps %u cycles/packet\n", name,
+	       (uint32_t)(mbps_x100 / 100U), (uint32_t)(mbps_x100 % 100U), pps,
+	       (uint32_t)(cycles / result.nb_packets_sent));
+	printk("%s memory: pkt rx %u tx %u buf rx %u tx %u\n", name,
+	       k_mem_slab_max_used_get(pkt_rx_slab), k_mem_slab_max_used_get(pkt_tx_slab),
+	       buf_rx_pool->max_used, buf_tx_pool->max_used);
+
+	if (result.nb_packets_lost != 0U) {
+		printk("%s: %u/%u packets lost\n", name, result.nb_packets_lost,
+		       result.nb_packets_rcvd + result.nb_packets_lost);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	struct zperf_upload_params param = {
+		.duration_ms = CONFIG_NET_BENCH_DURATION_MS,
+		.rate_kbps = CONFIG_NET_BENCH_UDP_RATE_KBPS,
+		.packet_size = CONFIG_NET_BENCH_PACKET_SIZE,
+	};
+	struct sockaddr_in *peer = net_sin(&param.peer_addr);
+	int errors = 0;
+	int ret;
+
+	TC_START("Network throughput benchmark");
+
+	net_pkt_get_info(&pkt_rx_slab, &pkt_tx_slab, &buf_rx_pool, &buf_tx_pool);
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(CONFIG_NET_BENCH_PORT);
+	if (zsock_inet_pton(AF_INET, CONFIG_NET_BENCH_PEER_ADDR, &peer->sin_addr) != 1) {
+		TC_ERROR("invalid peer address %s\n", CONFIG_NET_BENCH_PEER_ADDR);
+		errors++;
+		goto end;
+	}
+
+	/* Talking to ourselves, so serve ourselves too */
+	if (strcmp(CONFIG_NET_BENCH_PEER_ADDR, LOOPBACK_PEER) == 0) {
+		ret = servers_start();
+		if (ret < 0) {
+			TC_ERROR("cannot start zperf servers (%d)\n", ret);
+			errors++;
+			goto end;
+		}
+	}
+
+	printk("%u byte packets, %u ms per measurement\n", CONFIG_NET_BENCH_PACKET_SIZE,
+	       CONFIG_NET_BENCH_DURATION_MS);
+
+	for (int i = 0; i < CONFIG_NET_BENCH_ROUNDS; i++) {
+		errors += (run("UDP", zperf_udp_upload, &param) < 0) ? 1 : 0;
+		errors += (run("TCP", zperf_tcp_upload, &param) < 0) ? 1 : 0;
+	}
+
+end:
+	TC_END_REPORT((errors == 0) ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
@@ -38,6 +38,12 @@ static struct k_thread test_thread[CONFIG_BENCHMARK_NUM_THREADS];
 static uint64_t add_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 static uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 
+#ifdef CONFIG_BENCHMARK_SMP_SCALING
+static uint64_t smp_cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t smp_go;
+static atomic_t smp_done;
+#endif
+
 extern void z_unready_thread(struct k_thread *thread);
 
 static void busy_entry(void *p1, void *p2, void *p3)
@@ -222,6 +228,75 @@ static void compute_and_report_stats(unsigned int num_threads, unsigned int num_
 #endif
 }
 
+#ifdef CONFIG_BENCHMARK_SMP_SCALING
+/*
+ * Every CPU repeatedly unreadies and readies its own slice of the test
+ * threads at the same time as all the others, so that the cost per
+ * operation reflects contention on the ready queue(s).
+ */
+static void smp_ready_unready(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	unsigned int cpu = (unsigned int)(uintptr_t)p1;
+	unsigned int per_cpu = CONFIG_BENCHMARK_NUM_THREADS / arch_num_cpus();
+	struct k_thread *slice = &test_thread[cpu * per_cpu];
+	timing_t start;
+	timing_t finish;
+
+	while (atomic_get(&smp_go) == 0) {
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < per_cpu; j++) {
+			z_unready_thread(&slice[j]);
+		}
+		for (unsigned int j = 0; j < per_cpu; j++) {
+			z_ready_thread(&slice[j]);
+		}
+	}
+	finish = timing_counter_get();
+
+	smp_cycles[cpu] = timing_cycles_get(&start, &finish);
+	atomic_inc(&smp_done);
+}
+
+static void test_smp_scaling(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int per_cpu = CONFIG_BENCHMARK_NUM_THREADS / num_cpus;
+	unsigned int i;
+
+	/* Replace the spinning threads by workers, and keep this thread
+	 * from being preempted while it takes part as CPU 0's worker.
+	 */
+	for (i = 0; i < num_cpus - 1; i++) {
+		k_thread_abort(&busy_thread[i]);
+	}
+
+	k_thread_priority_set(k_current_get(), -1);
+
+	for (i = 0; i < num_cpus - 1; i++) {
+		k_thread_create(&busy_thread[i], busy_stack[i], BUSY_STACK_SIZE,
+				smp_ready_unready, (void *)(uintptr_t)(i + 1), NULL, NULL,
+				-1, 0, K_NO_WAIT);
+	}
+
+	atomic_set(&smp_go, 1);
+	smp_ready_unready((void *)(uintptr_t)0, NULL, NULL);
+
+	while (atomic_get(&smp_done) != num_cpus) {
+		k_busy_wait(100);
+	}
+
+	compute_and_report_stats(num_cpus, CONFIG_BENCHMARK_NUM_ITERATIONS * per_cpu * 2,
+				 smp_cycles, "sched.smp.ready_unready.all_cpus",
+				 "Ready/unready a thread with all CPUs contending");
+}
+#endif /* CONFIG_BENCHMARK_SMP_SCALING */
+
 int main(void)
 {
 	unsigned int i;
@@ -325,6 +400,10 @@ int main(void)
 	}
 #endif
 
+#ifdef CONFIG_BENCHMARK_SMP_SCALING
+	test_smp_scaling();
+#endif
+
 	for (i = 0; i < CONFIG_BENCHMARK_NUM_THREADS; i++) {
 		k_thread_abort(&test_thread[i]);
 	}
@@ -0,0 +1,124 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/storage/flash_map.h>
+#include "storage_bench.h"
+
+/* Mount point and key file name */
+#define PATH_LEN 32
+
+#ifdef CONFIG_FILE_SYSTEM_LITTLEFS
+#include <zephyr/fs/littlefs.h>
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_data);
+
+static struct fs_mount_t mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &lfs_data,
+	.storage_dev = (void *)FIXED_PARTITION_ID(storage_partition),
+	.mnt_point = "/lfs",
+};
+#else
+#include <ff.h>
+
+static FATFS fat_data;
+
+static struct fs_mount_t mnt = {
+	.type = FS_FATFS,
+	.fs_data = &fat_data,
+	.mnt_point = CONFIG_STORAGE_BENCH_FAT_MOUNT_POINT,
+};
+#endif /* CONFIG_FILE_SYSTEM_LITTLEFS */
+
+static bool mounted;
+
+const char *storage_bench_fs_mount(void)
+{
+	if (mounted) {
+		(void)fs_unmount(&mnt);
+		mounted = false;
+	}
+
+	/* Blank storage is formatted on mount */
+	if (fs_mount(&mnt) < 0) {
+		return NULL;
+	}
+	mounted = true;
+
+	return mnt.mnt_point;
+}
+
+#if defined(CONFIG_STORAGE_BENCH_LITTLEFS) || defined(CONFIG_STORAGE_BENCH_FAT)
+static void key_path(char *path, size_t size, uint32_t key)
+{
+	(void)snprintf(path, size, "%s/k%x", mnt.mnt_point, key);
+}
+
+static int fs_bench_mount(void)
+{
+	return (storage_bench_fs_mount() != NULL) ? 0 : -EIO;
+}
+
+static int fs_bench_write(uint32_t key, const void *data, size_t len)
+{
+	struct fs_file_t file;
+	char path[PATH_LEN];
+	ssize_t rc;
+
+	key_path(path, sizeof(path), key);
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE | FS_O_TRUNC);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = fs_write(&file, data, len);
+	(void)fs_close(&file);
+
+	return (rc < 0) ? (int)rc : 0;
+}
+
+static int fs_bench_read(uint32_t key, void *data, size_t len)
+{
+	struct fs_file_t file;
+	char path[PATH_LEN];
+	ssize_t rc;
+
+	key_path(path, sizeof(path), key);
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, path, FS_O_READ);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = fs_read(&file, data, len);
+	(void)fs_close(&file);
+
+	return (rc < 0) ? (int)rc : 0;
+}
+
+static int fs_bench_delete(uint32_t key)
+{
+	char path[PATH_LEN];
+
+	key_path(path, sizeof(path), key);
+
+	return fs_unlink(path);
+}
+
+const struct storage_bench_backend storage_bench_backend = {
+	.name = IS_ENABLED(CONFIG_STORAGE_BENCH_LITTLEFS) ? "littlefs" : "fat",
+	.mount = fs_bench_mount,
+	.write = fs_bench_write,
+	.read = fs_bench_read,
+	.delete = fs_bench_delete,
+};
+#endif /* CONFIG_STORAGE_BENCH_LITTLEFS || CONFIG_STORAGE_BENCH_FAT */
@@ -0,0 +1,316 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the latencies of a storage back-end and the flash it wears.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/arch/common/ffs.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/tc_util.h>
+#include "storage_bench.h"
+
+/* The flash simulator counts what the flash back-ends write */
+#if defined(CONFIG_FLASH_SIMULATOR_STATS) && !defined(CONFIG_STORAGE_BENCH_FAT)
+#include <zephyr/stats/stats.h>
+#define WEAR_STATS 1
+#endif
+
+#define KEYS       CONFIG_STORAGE_BENCH_KEYS
+#define VALUE_SIZE CONFIG_STORAGE_BENCH_VALUE_SIZE
+
+/* Latencies in us, bucket b > 0 counts [2^(b-1), 2^b) */
+#define HIST_BUCKETS 24
+
+enum op {
+	OP_MOUNT,
+	OP_WRITE,
+	OP_READ,
+	OP_UPDATE,
+	OP_REMOUNT,
+	OP_DELETE,
+	OP_COUNT,
+};
+
+struct op_stats {
+	uint32_t count;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+	uint32_t hist[HIST_BUCKETS];
+};
+
+static const char *const op_names[OP_COUNT] = {
+	[OP_MOUNT] = "mount",
+	[OP_WRITE] = "write",
+	[OP_READ] = "read",
+	[OP_UPDATE] = "update",
+	[OP_REMOUNT] = "remount",
+	[OP_DELETE] = "delete",
+};
+
+static const struct storage_bench_backend *const backend = &storage_bench_backend;
+static struct op_stats stats[OP_COUNT];
+static uint8_t value[VALUE_SIZE];
+static uint8_t read_back[VALUE_SIZE];
+static uint64_t payload_bytes;
+
+static void op_record(enum op op, uint32_t cycles)
+{
+	struct op_stats *s = &stats[op];
+	uint32_t us = k_cyc_to_us_near32(cycles);
+
+	s->min_us = (s->count == 0U) ? us : MIN(s->min_us, us);
+	s->max_us = MAX(s->max_us, us);
+	s->total_us += us;
+	s->count++;
+	s->hist[MIN(find_msb_set(us), HIST_BUCKETS - 1)]++;
+}
+
+static void op_report(enum op op)
+{
+	const struct op_stats *s = &stats[op];
+
+	if (s->count == 0U) {
+		return;
+	}
+
+	printk("RESULT backend=%s op=%s count=%u min_us=%u avg_us=%u max_us=%u\n",
+	       backend->name, op_names[op], s->count, s->min_us,
+	       (uint32_t)(s->total_us / s->count), s->max_us);
+
+	for (int b = 0; b < HIST_BUCKETS; b++) {
+		if (s->hist[b] != 0U) {
+			printk("HIST backend=%s op=%s from_us=%u count=%u\n", backend->name,
+			       op_names[op], (uint32_t)((b == 0) ? 0U : BIT(b - 1)), s->hist[b]);
+		}
+	}
+}
+
+static int timed_mount(enum op op)
+{
+	uint32_t start = k_cycle_get_32();
+	int rc = backend->mount();
+
+	op_record(op, k_cycle_get_32() - start);
+
+	return rc;
+}
+
+static int timed_write(enum op op, uint32_t key, uint32_t round)
+{
+	uint32_t start;
+	int rc;
+
+	memset(value, (uint8_t)(key + round), sizeof(value));
+
+	start = k_cycle_get_32();
+	rc = backend->write(key, value, sizeof(value));
+	op_record(op, k_cycle_get_32() - start);
+
+	payload_bytes += sizeof(value);
+
+	return rc;
+}
+
+static int timed_read(uint32_t key, uint32_t round)
+{
+	uint32_t start;
+	int rc;
+
+	memset(read_back, 0, sizeof(read_back));
+
+	start = k_cycle_get_32();
+	rc = backend->read(key, read_back, sizeof(read_back));
+	op_record(OP_READ, k_cycle_get_32() - start);
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	memset(value, (uint8_t)(key + round), sizeof(value));
+
+	return (memcmp(value, read_back, sizeof(value)) == 0) ? 0 : -EIO;
+}
+
+static int timed_delete(uint32_t key)
+{
+	uint32_t start = k_cycle_get_32();
+	int rc = backend->delete(key);
+
+	op_record(OP_DELETE, k_cycle_get_32() - start);
+
+	return rc;
+}
+
+#ifndef CONFIG_STORAGE_BENCH_FAT
+/* Start from blank storage so that runs are comparable */
+static int storage_erase(void)
+{
+	const struct flash_area *fa;
+	int rc;
+
+	rc = flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa);
+	if (rc < 0) {
+		return rc;
+	}
+
+	rc = flash_area_flatten(fa, 0, fa->fa_size);
+	flash_area_close(fa);
+
+	return rc;
+}
+#endif /* CONFIG_STORAGE_BENCH_FAT */
+
+#ifdef WEAR_STATS
+struct flash_usage {
+	uint32_t bytes_written;
+	uint32_t erases;
+};
+
+static int flash_stat_cb(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	struct flash_usage *usage = arg;
+	uint32_t val = *(uint32_t *)((uint8_t *)hdr + off);
+
+	if (strcmp(name, "bytes_written") == 0) {
+		usage->bytes_written = val;
+	} else if (strcmp(name, "flash_erase_calls") == 0) {
+		usage->erases = val;
+	}
+
+	return 0;
+}
+
+static void flash_usage_get(struct flash_usage *usage)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+
+	if (hdr != NULL) {
+		(void)stats_walk(hdr, flash_stat_cb, usage);
+	}
+}
+
+static void wear_report(const struct flash_usage *before)
+{
+	struct flash_usage after = { 0 };
+	uint32_t written;
+
+	flash_usage_get(&after);
+	written = after.bytes_written - before->bytes_written;
+
+	/* The amplification is flash bytes written per 100 bytes of payload */
+	printk("RESULT backend=%s op=wear payload_bytes=%u flash_bytes=%u erases=%u "
+	       "amplification=%u\n", backend->name, (uint32_t)payload_bytes, written,
+	       after.erases - before->erases,
+	       (uint32_t)(((uint64_t)written * 100U) / MAX(payload_bytes, 1U)));
+}
+#endif /* WEAR_STATS */
+
+static int run(void)
+{
+	uint32_t round;
+	int rc;
+
+	rc = timed_mount(OP_MOUNT);
+	if (rc < 0) {
+		TC_ERROR("mount failed (%d)\n", rc);
+		return rc;
+	}
+
+	for (uint32_t key = 0; key < KEYS; key++) {
+		rc = timed_write(OP_WRITE, key, 0);
+		if (rc < 0) {
+			TC_ERROR("write of key %u failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+
+	for (uint32_t key = 0; key < KEYS; key++) {
+		rc = timed_read(key, 0);
+		if (rc < 0) {
+			TC_ERROR("read of key %u failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+
+	for (round = 1; round <= CONFIG_STORAGE_BENCH_UPDATE_ROUNDS; round++) {
+		for (uint32_t key = 0; key < KEYS; key++) {
+			rc = timed_write(OP_UPDATE, key, round);
+			if (rc < 0) {
+				TC_ERROR("update of key %u failed (%d)\n", key, rc);
+				return rc;
+			}
+		}
+	}
+
+	rc = timed_mount(OP_REMOUNT);
+	if (rc < 0) {
+		TC_ERROR("remount failed (%d)\n", rc);
+		return rc;
+	}
+
+	/* The last round must have survived the remount */
+	for (uint32_t key = 0; key < KEYS; key++) {
+		rc = timed_read(key, round - 1U);
+		if (rc < 0) {
+			TC_ERROR("read of key %u after remount failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+
+	for (uint32_t key = 0; key < KEYS; key++) {
+		rc = timed_delete(key);
+		if (rc < 0) {
+			TC_ERROR("delete of key %u failed (%d)\n", key, rc);
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int rc = 0;
+#ifdef WEAR_STATS
+	struct flash_usage before = { 0 };
+#endif
+
+	TC_START("Storage benchmark");
+	printk("backend=%s keys=%u value_size=%u update_rounds=%u\n", backend->name, KEYS,
+	       VALUE_SIZE, CONFIG_STORAGE_BENCH_UPDATE_ROUNDS);
+
+#ifndef CONFIG_STORAGE_BENCH_FAT
+	rc = storage_erase();
+	if (rc < 0) {
+		TC_ERROR("cannot erase the storage partition (%d)\n", rc);
+		goto end;
+	}
+#endif /* CONFIG_STORAGE_BENCH_FAT */
+
+#ifdef WEAR_STATS
+	flash_usage_get(&before);
+#endif
+
+	rc = run();
+
+	for (enum op op = 0; op < OP_COUNT; op++) {
+		op_report(op);
+	}
+
+#ifdef WEAR_STATS
+	wear_report(&before);
+#endif
+
+end:
+	TC_END_REPORT((rc == 0) ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
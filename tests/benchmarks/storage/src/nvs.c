@@ -0,0 +1,65 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/storage/flash_map.h>
+#include "storage_bench.h"
+
+/* NVS identifiers are 16 bits */
+#define KEY_ID(key) ((uint16_t)(key))
+
+static struct nvs_fs fs;
+
+static int nvs_bench_mount(void)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	fs.flash_device = FIXED_PARTITION_DEVICE(storage_partition);
+	if (!device_is_ready(fs.flash_device)) {
+		return -ENODEV;
+	}
+
+	fs.offset = FIXED_PARTITION_OFFSET(storage_partition);
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc < 0) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = FIXED_PARTITION_SIZE(storage_partition) / info.size;
+
+	return nvs_mount(&fs);
+}
+
+static int nvs_bench_write(uint32_t key, const void *data, size_t len)
+{
+	ssize_t rc = nvs_write(&fs, KEY_ID(key), data, len);
+
+	return (rc < 0) ? (int)rc : 0;
+}
+
+static int nvs_bench_read(uint32_t key, void *data, size_t len)
+{
+	ssize_t rc = nvs_read(&fs, KEY_ID(key), data, len);
+
+	return (rc < 0) ? (int)rc : 0;
+}
+
+static int nvs_bench_delete(uint32_t key)
+{
+	return nvs_delete(&fs, KEY_ID(key));
+}
+
+const struct storage_bench_backend storage_bench_backend = {
+	.name = "nvs",
+	.mount = nvs_bench_mount,
+	.write = nvs_bench_write,
+	.read = nvs_bench_read,
+	.delete = nvs_bench_delete,
+};
@@ -0,0 +1,103 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <zephyr/settings/settings.h>
+#include "storage_bench.h"
+
+#define KEY_NAME_LEN sizeof("bench/ffffffff")
+
+struct read_ctx {
+	void *data;
+	size_t len;
+	int rc;
+};
+
+static void key_name(char *name, size_t size, uint32_t key)
+{
+	(void)snprintf(name, size, "bench/%x", key);
+}
+
+static int settings_bench_mount(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		/* What a reboot does with the stored settings */
+		return settings_load();
+	}
+
+#ifdef CONFIG_SETTINGS_FILE
+	if (storage_bench_fs_mount() == NULL) {
+		return -EIO;
+	}
+#endif /* CONFIG_SETTINGS_FILE */
+
+	initialized = true;
+
+	return settings_subsys_init();
+}
+
+static int settings_bench_write(uint32_t key, const void *data, size_t len)
+{
+	char name[KEY_NAME_LEN];
+
+	key_name(name, sizeof(name), key);
+
+	return settings_save_one(name, data, len);
+}
+
+static int read_cb(const char *key, size_t len, settings_read_cb read_fn, void *cb_arg,
+		   void *param)
+{
+	struct read_ctx *ctx = param;
+	ssize_t rc;
+
+	ARG_UNUSED(key);
+	ARG_UNUSED(len);
+
+	rc = read_fn(cb_arg, ctx->data, ctx->len);
+	ctx->rc = (rc < 0) ? (int)rc : 0;
+
+	return 0;
+}
+
+static int settings_bench_read(uint32_t key, void *data, size_t len)
+{
+	char name[KEY_NAME_LEN];
+	struct read_ctx ctx = {
+		.data = data,
+		.len = len,
+		.rc = -ENOENT,
+	};
+	int rc;
+
+	key_name(name, sizeof(name), key);
+
+	rc = settings_load_subtree_direct(name, read_cb, &ctx);
+
+	return (rc < 0) ? rc : ctx.rc;
+}
+
+static int settings_bench_delete(uint32_t key)
+{
+	char name[KEY_NAME_LEN];
+
+	key_name(name, sizeof(name), key);
+
+	return settings_delete(name);
+}
+
+const struct storage_bench_backend storage_bench_backend = {
+	.name = IS_ENABLED(CONFIG_SETTINGS_NVS) ? "settings_nvs" :
+		IS_ENABLED(CONFIG_SETTINGS_ZMS) ? "settings_zms" :
+		IS_ENABLED(CONFIG_SETTINGS_FILE) ? "settings_file" : "settings",
+	.mount = settings_bench_mount,
+	.write = settings_bench_write,
+	.read = settings_bench_read,
+	.delete = settings_bench_delete,
+};
@@ -0,0 +1,41 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TESTS_BENCHMARKS_STORAGE_BENCH_H_
+#define TESTS_BENCHMARKS_STORAGE_BENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Operations of the storage back-end under test.
+ *
+ * All of them return 0 or a negative errno value.
+ */
+struct storage_bench_backend {
+	/** Name used in the report */
+	const char *name;
+	/** Mount the storage, or mount it again if already mounted */
+	int (*mount)(void);
+	/** Write the value of a key */
+	int (*write)(uint32_t key, const void *data, size_t len);
+	/** Read the value of a key */
+	int (*read)(uint32_t key, void *data, size_t len);
+	/** Delete a key */
+	int (*delete)(uint32_t key);
+};
+
+/** The back-end selected by CONFIG_STORAGE_BENCH_BACKEND */
+extern const struct storage_bench_backend storage_bench_backend;
+
+/**
+ * @brief Mount the file system used by the file back-ends.
+ *
+ * @return The mount point, or NULL on failure.
+ */
+const char *storage_bench_fs_mount(void);
+
+#endif /* TESTS_BENCHMARKS_STORAGE_BENCH_H_ */
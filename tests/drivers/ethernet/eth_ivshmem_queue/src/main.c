@@ -177,4 +177,54 @@ ZTEST(eth_ivshmem_queue_tests, test_queue_shmem_full)
 	zassert_equal(queue_tx(&q1, large_message, sizeof(large_message)), -ENOBUFS);
 }
 
+ZTEST(eth_ivshmem_queue_tests, test_tx_kick_event_index)
+{
+	int x = 0;
+
+	/* First frame needs a notification */
+	zassert_ok(queue_tx(&q1, &x, sizeof(x)));
+	zassert_true(eth_ivshmem_queue_tx_kick(&q1));
+
+	/* Peer has not caught up yet, no further notification */
+	zassert_ok(queue_tx(&q1, &x, sizeof(x)));
+	zassert_false(eth_ivshmem_queue_tx_kick(&q1));
+
+	/* Peer consumes everything and waits for the next frame */
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(eth_ivshmem_queue_rx(&q2, &rx_message, &rx_len));
+		zassert_ok(eth_ivshmem_queue_rx_complete(&q2));
+	}
+	zassert_ok(queue_tx(&q1, &x, sizeof(x)));
+	zassert_true(eth_ivshmem_queue_tx_kick(&q1));
+}
+
+ZTEST(eth_ivshmem_queue_tests, test_rx_take_release)
+{
+	uint16_t pos[2];
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(queue_tx(&q1, &i, sizeof(i)));
+	}
+
+	for (int i = 0; i < 2; i++) {
+		zassert_ok(eth_ivshmem_queue_rx(&q2, &rx_message, &rx_len));
+		zassert_equal(*(int *)rx_message, i);
+		zassert_ok(eth_ivshmem_queue_rx_take(&q2, &pos[i]));
+	}
+	zassert_equal(eth_ivshmem_queue_rx_take(&q2, &pos[0]), -EWOULDBLOCK);
+
+#ifdef CONFIG_ETH_IVSHMEM_RX_ZERO_COPY
+	zassert_ok(eth_ivshmem_queue_rx_release(&q2, pos[1]));
+	zassert_ok(eth_ivshmem_queue_rx_release(&q2, pos[0]));
+#else
+	zassert_equal(eth_ivshmem_queue_rx_release(&q2, pos[1]), -EINVAL);
+	zassert_ok(eth_ivshmem_queue_rx_release(&q2, pos[0]));
+	zassert_ok(eth_ivshmem_queue_rx_release(&q2, pos[1]));
+#endif
+	zassert_true(eth_ivshmem_queue_rx_kick(&q2));
+
+	/* Released twice */
+	zassert_equal(eth_ivshmem_queue_rx_release(&q2, pos[0]), -EINVAL);
+}
+
 ZTEST_SUITE(eth_ivshmem_queue_tests, NULL, NULL, test_setup, NULL, NULL);
@@ -309,6 +309,52 @@ ZTEST(flash_driver, test_flash_erase)
 	zassert_not_equal(expected[0], erase_value, "These values shall be different");
 }
 
+#ifdef CONFIG_FLASH_RTIO
+RTIO_IODEV_DEFINE(flash_iodev, &flash_iodev_api, (void *)TEST_AREA_DEVICE);
+RTIO_DEFINE(flash_rtio, 4, 4);
+
+ZTEST(flash_driver, test_flash_rtio)
+{
+	uint8_t read_buf[EXPECTED_SIZE];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int rc;
+
+	/* Erase, write and read back, chained so that they run in order */
+	sqe = rtio_sqe_acquire(&flash_rtio);
+	zassert_not_null(sqe);
+	flash_rtio_prep_erase(sqe, &flash_iodev, page_info.start_offset,
+			      page_info.size * ((EXPECTED_SIZE + page_info.size - 1) / page_info.size),
+			      (void *)(uintptr_t)RTIO_OP_FLASH_ERASE);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&flash_rtio);
+	zassert_not_null(sqe);
+	flash_rtio_prep_write(sqe, &flash_iodev, page_info.start_offset, expected,
+			      EXPECTED_SIZE, (void *)(uintptr_t)RTIO_OP_FLASH_WRITE);
+	sqe->flags |= RTIO_SQE_CHAINED;
+
+	sqe = rtio_sqe_acquire(&flash_rtio);
+	zassert_not_null(sqe);
+	memset(read_buf, 0, sizeof(read_buf));
+	flash_rtio_prep_read(sqe, &flash_iodev, page_info.start_offset, read_buf,
+			     EXPECTED_SIZE, (void *)(uintptr_t)RTIO_OP_FLASH_READ);
+
+	rc = rtio_submit(&flash_rtio, 3);
+	zassert_equal(rc, 0, "Cannot submit flash operations");
+
+	for (uintptr_t op = RTIO_OP_FLASH_ERASE; op >= RTIO_OP_FLASH_READ; op--) {
+		cqe = rtio_cqe_consume_block(&flash_rtio);
+		zassert_equal(cqe->result, 0, "Flash operation %u failed: %d", (unsigned int)op,
+			      cqe->result);
+		zassert_equal((uintptr_t)cqe->userdata, op, "Flash operation out of order");
+		rtio_cqe_release(&flash_rtio, cqe);
+	}
+
+	zassert_mem_equal(read_buf, expected, EXPECTED_SIZE, "Flash read back mismatch");
+}
+#endif /* CONFIG_FLASH_RTIO */
+
 struct test_cb_data_type {
 	uint32_t page_counter; /* used to count how many pages was iterated */
 	uint32_t exit_page;    /* terminate iteration when this page is reached */
@@ -0,0 +1,414 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/drivers/sensor_batch.h>
+#include <zephyr/ztest.h>
+
+#define MAX_FRAMES  40
+#define BASE_TIME   1000000ULL
+#define FRAME_TIME  1250
+
+#define Q31_HALF    0x40000000
+#define Q31_QUARTER 0x20000000
+
+/* Raw data of the mock sensor, one shift per frame */
+struct mock_frame {
+	uint64_t timestamp_ns;
+	int8_t shift;
+	q31_t values[SENSOR_BATCH_MAX_AXES];
+};
+
+struct mock_buf {
+	uint16_t count;
+	struct mock_frame frames[MAX_FRAMES];
+};
+
+static int mock_get_frame_count(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				uint16_t *frame_count)
+{
+	const struct mock_buf *buf = (const struct mock_buf *)buffer;
+
+	ARG_UNUSED(chan_spec);
+
+	*frame_count = buf->count;
+	return 0;
+}
+
+static int mock_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size,
+			      size_t *frame_size)
+{
+	switch (chan_spec.chan_type) {
+	case SENSOR_CHAN_ACCEL_XYZ:
+		*base_size = sizeof(struct sensor_three_axis_data);
+		*frame_size = sizeof(struct sensor_three_axis_sample_data);
+		return 0;
+	case SENSOR_CHAN_DIE_TEMP:
+		*base_size = sizeof(struct sensor_q31_data);
+		*frame_size = sizeof(struct sensor_q31_sample_data);
+		return 0;
+	case SENSOR_CHAN_PROX:
+		*base_size = sizeof(struct sensor_byte_data);
+		*frame_size = sizeof(struct sensor_byte_sample_data);
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+/* Like the drivers, decodes frames of a single shift per call */
+static int mock_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec, uint32_t *fit,
+		       uint16_t max_count, void *data_out)
+{
+	const struct mock_buf *buf = (const struct mock_buf *)buffer;
+	const struct mock_frame *first = &buf->frames[*fit];
+	struct sensor_three_axis_data *three_axis = data_out;
+	struct sensor_q31_data *q31 = data_out;
+	int count = 0;
+
+	if (*fit >= buf->count) {
+		return 0;
+	}
+
+	while (count < max_count && (*fit + count) < buf->count &&
+	       buf->frames[*fit + count].shift == first->shift) {
+		const struct mock_frame *frame = &buf->frames[*fit + count];
+		uint32_t delta = frame->timestamp_ns - first->timestamp_ns;
+
+		if (chan_spec.chan_type == SENSOR_CHAN_ACCEL_XYZ) {
+			three_axis->readings[count].timestamp_delta = delta;
+			memcpy(three_axis->readings[count].values, frame->values,
+			       sizeof(three_axis->readings[count].values));
+		} else {
+			q31->readings[count].timestamp_delta = delta;
+			q31->readings[count].value = frame->values[0];
+		}
+
+		count++;
+	}
+
+	if (chan_spec.chan_type == SENSOR_CHAN_ACCEL_XYZ) {
+		three_axis->header.base_timestamp_ns = first->timestamp_ns;
+		three_axis->header.reading_count = count;
+		three_axis->shift = first->shift;
+	} else {
+		q31->header.base_timestamp_ns = first->timestamp_ns;
+		q31->header.reading_count = count;
+		q31->shift = first->shift;
+	}
+
+	*fit += count;
+	return count;
+}
+
+static const struct sensor_decoder_api mock_decoder = {
+	.get_frame_count = mock_get_frame_count,
+	.get_size_info = mock_get_size_info,
+	.decode = mock_decode,
+};
+
+static const struct sensor_chan_spec accel_xyz = {SENSOR_CHAN_ACCEL_XYZ, 0};
+static const struct sensor_chan_spec die_temp = {SENSOR_CHAN_DIE_TEMP, 0};
+
+static struct mock_buf mock_buf;
+static q31_t values[SENSOR_BATCH_MAX_AXES][MAX_FRAMES];
+static uint32_t timestamp_deltas[MAX_FRAMES];
+static struct sensor_batch batch;
+
+static q31_t frame_value(int i, int axis)
+{
+	/* Multiples of 4, different on each axis, negative on the Y one */
+	return (axis == 1 ? -1 : 1) * 4 * (i + 1) * (axis + 1) * 1000;
+}
+
+static void fill_frames(uint16_t count, int8_t shift)
+{
+	mock_buf.count = count;
+
+	for (int i = 0; i < count; i++) {
+		mock_buf.frames[i].timestamp_ns = BASE_TIME + i * FRAME_TIME;
+		mock_buf.frames[i].shift = shift;
+
+		for (int axis = 0; axis < SENSOR_BATCH_MAX_AXES; axis++) {
+			mock_buf.frames[i].values[axis] = frame_value(i, axis);
+		}
+	}
+}
+
+static int decode(struct sensor_chan_spec chan_spec)
+{
+	return sensor_batch_decode(&mock_decoder, (const uint8_t *)&mock_buf, chan_spec, &batch);
+}
+
+/* All the frames are decoded, in order, over as many decoder calls as needed */
+ZTEST(sensor_batch, test_decode_three_axis)
+{
+	fill_frames(MAX_FRAMES, 4);
+
+	zassert_ok(decode(accel_xyz));
+	zassert_equal(batch.count, MAX_FRAMES);
+	zassert_equal(batch.num_axes, 3);
+	zassert_equal(batch.shift, 4);
+	zassert_equal(batch.base_timestamp_ns, BASE_TIME);
+
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			zassert_equal(batch.values[axis][i], frame_value(i, axis),
+				      "Sample %d of axis %d", i, axis);
+		}
+
+		zassert_equal(batch.timestamp_deltas[i], i * FRAME_TIME, "Timestamp of sample %d",
+			      i);
+	}
+}
+
+ZTEST(sensor_batch, test_decode_q31)
+{
+	fill_frames(MAX_FRAMES, 7);
+	batch.values[1] = NULL;
+	batch.values[2] = NULL;
+	batch.timestamp_deltas = NULL;
+
+	zassert_ok(decode(die_temp));
+	zassert_equal(batch.count, MAX_FRAMES);
+	zassert_equal(batch.num_axes, 1);
+	zassert_equal(batch.shift, 7);
+
+	for (int i = 0; i < MAX_FRAMES; i++) {
+		zassert_equal(batch.values[0][i], frame_value(i, 0), "Sample %d", i);
+	}
+}
+
+/* Samples of another shift are converted to the one of the first frame */
+ZTEST(sensor_batch, test_decode_shift)
+{
+	fill_frames(24, 4);
+
+	for (int i = 8; i < 16; i++) {
+		mock_buf.frames[i].shift = 6;
+	}
+	for (int i = 16; i < 24; i++) {
+		mock_buf.frames[i].shift = 2;
+	}
+	mock_buf.frames[15].values[0] = INT32_MAX / 2;
+	mock_buf.frames[15].values[1] = INT32_MIN / 2;
+
+	zassert_ok(decode(accel_xyz));
+	zassert_equal(batch.count, 24);
+	zassert_equal(batch.shift, 4);
+
+	for (int i = 0; i < 24; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			q31_t expected = frame_value(i, axis);
+
+			if (i == 15 && axis < 2) {
+				/* Saturated */
+				expected = (axis == 0) ? INT32_MAX : INT32_MIN;
+			} else if (i >= 16) {
+				expected /= 4;
+			} else if (i >= 8) {
+				expected *= 4;
+			}
+
+			zassert_equal(batch.values[axis][i], expected, "Sample %d of axis %d", i,
+				      axis);
+		}
+
+		zassert_equal(batch.timestamp_deltas[i], i * FRAME_TIME, "Timestamp of sample %d",
+			      i);
+	}
+}
+
+ZTEST(sensor_batch, test_decode_errors)
+{
+	struct sensor_chan_spec prox = {SENSOR_CHAN_PROX, 0};
+
+	fill_frames(MAX_FRAMES, 0);
+
+	zassert_equal(decode(prox), -ENOTSUP);
+
+	batch.capacity = MAX_FRAMES - 1;
+	zassert_equal(decode(accel_xyz), -ENOSPC);
+	batch.capacity = MAX_FRAMES;
+
+	batch.values[2] = NULL;
+	zassert_equal(decode(accel_xyz), -EINVAL);
+
+	/* One axis is enough for a q31 channel */
+	zassert_ok(decode(die_temp));
+}
+
+#ifdef CONFIG_SENSOR_BATCH_FILTER
+#define BLOCK   8
+#define FIR_LEN 4
+
+static q31_t input(int n, int axis)
+{
+	/* Multiples of 4, so that the averages are exact */
+	return 4 * (n * n - 20 * n + (axis + 1) * 1000);
+}
+
+static void fill_batch(int block)
+{
+	batch.count = BLOCK;
+	batch.num_axes = 3;
+
+	for (int i = 0; i < BLOCK; i++) {
+		for (int axis = 0; axis < 3; axis++) {
+			batch.values[axis][i] = input(block * BLOCK + i, axis);
+		}
+
+		batch.timestamp_deltas[i] = i * FRAME_TIME;
+	}
+}
+
+/* The state is kept from one batch to the next */
+ZTEST(sensor_batch, test_filter_fir)
+{
+	static const q31_t coeffs[FIR_LEN] = {Q31_QUARTER, Q31_QUARTER, Q31_QUARTER,
+					      Q31_QUARTER};
+	static q31_t state[3 * (FIR_LEN + BLOCK - 1)];
+	struct sensor_batch_filter fir;
+
+	zassert_ok(sensor_batch_filter_init_fir(&fir, 3, FIR_LEN, coeffs, BLOCK, state));
+
+	for (int block = 0; block < 2; block++) {
+		fill_batch(block);
+		zassert_ok(sensor_batch_filter(&fir, 1, &batch));
+		zassert_equal(batch.count, BLOCK);
+
+		for (int i = 0; i < BLOCK; i++) {
+			int n = block * BLOCK + i;
+
+			for (int axis = 0; axis < 3; axis++) {
+				q31_t expected = 0;
+
+				for (int k = MAX(n - FIR_LEN + 1, 0); k <= n; k++) {
+					expected += input(k, axis) / 4;
+				}
+
+				zassert_within(batch.values[axis][i], expected, 1,
+					       "Sample %d of axis %d", n, axis);
+			}
+		}
+	}
+}
+
+/* First order low-pass filter, y[n] = (x[n] + y[n - 1]) / 2 */
+ZTEST(sensor_batch, test_filter_biquad)
+{
+	static const q31_t coeffs[5] = {Q31_HALF, 0, 0, Q31_HALF, 0};
+	static q31_t state[3 * 4];
+	struct sensor_batch_filter biquad;
+	q31_t expected[3] = {0};
+
+	zassert_ok(sensor_batch_filter_init_biquad(&biquad, 3, 1, coeffs, 0, state));
+
+	for (int block = 0; block < 2; block++) {
+		fill_batch(block);
+		zassert_ok(sensor_batch_filter(&biquad, 1, &batch));
+		zassert_equal(batch.count, BLOCK);
+
+		for (int i = 0; i < BLOCK; i++) {
+			int n = block * BLOCK + i;
+
+			for (int axis = 0; axis < 3; axis++) {
+				expected[axis] = ((int64_t)input(n, axis) + expected[axis]) >> 1;
+
+				zassert_within(batch.values[axis][i], expected[axis], 2,
+					       "Sample %d of axis %d", n, axis);
+				expected[axis] = batch.values[axis][i];
+			}
+		}
+	}
+}
+
+/* Each output sample averages two input samples, and gets the time of the last one */
+ZTEST(sensor_batch, test_filter_decimate)
+{
+	static const q31_t coeffs[2] = {Q31_HALF, Q31_HALF};
+	static q31_t state[3 * (2 + BLOCK - 1)];
+	struct sensor_batch_filter decimate;
+
+	zassert_ok(sensor_batch_filter_init_decimate(&decimate, 3, 2, 2, coeffs, BLOCK, state));
+
+	for (int block = 0; block < 2; block++) {
+		fill_batch(block);
+		zassert_ok(sensor_batch_filter(&decimate, 1, &batch));
+		zassert_equal(batch.count, BLOCK / 2);
+
+		for (int i = 0; i < BLOCK / 2; i++) {
+			int n = block * BLOCK + 2 * i;
+
+			for (int axis = 0; axis < 3; axis++) {
+				q31_t expected = input(n, axis) / 2;
+
+				if (n > 0) {
+					expected += input(n - 1, axis) / 2;
+				}
+
+				zassert_within(batch.values[axis][i], expected, 1,
+					       "Sample %d of axis %d", i, axis);
+			}
+
+			zassert_equal(batch.timestamp_deltas[i], (2 * i + 1) * FRAME_TIME,
+				      "Timestamp of sample %d", i);
+		}
+	}
+}
+
+/* A decoded batch goes through a chain of filters, which must match it */
+ZTEST(sensor_batch, test_filter_chain)
+{
+	static const q31_t biquad_coeffs[5] = {Q31_HALF, 0, 0, Q31_HALF, 0};
+	static const q31_t fir_coeffs[2] = {Q31_HALF, Q31_HALF};
+	static q31_t biquad_state[3 * 4];
+	static q31_t fir_state[3 * (2 + MAX_FRAMES - 1)];
+	struct sensor_batch_filter filters[2];
+
+	zassert_ok(sensor_batch_filter_init_biquad(&filters[0], 3, 1, biquad_coeffs, 0,
+						   biquad_state));
+	zassert_ok(sensor_batch_filter_init_decimate(&filters[1], 3, 2, 4, fir_coeffs,
+						     MAX_FRAMES, fir_state));
+
+	fill_frames(MAX_FRAMES, 4);
+	zassert_ok(decode(accel_xyz));
+	zassert_ok(sensor_batch_filter(filters, ARRAY_SIZE(filters), &batch));
+	zassert_equal(batch.count, MAX_FRAMES / 4);
+
+	for (int i = 0; i < batch.count; i++) {
+		zassert_equal(batch.timestamp_deltas[i], (4 * i + 3) * FRAME_TIME,
+			      "Timestamp of sample %d", i);
+	}
+
+	/* Not a multiple of the decimation factor */
+	fill_frames(MAX_FRAMES - 2, 4);
+	zassert_ok(decode(accel_xyz));
+	zassert_equal(sensor_batch_filter(&filters[1], 1, &batch), -EINVAL);
+
+	/* Not the number of axes of the filters */
+	zassert_ok(decode(die_temp));
+	zassert_equal(sensor_batch_filter(filters, ARRAY_SIZE(filters), &batch), -EINVAL);
+}
+#endif /* CONFIG_SENSOR_BATCH_FILTER */
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&batch, 0, sizeof(batch));
+	memset(&mock_buf, 0, sizeof(mock_buf));
+
+	for (int axis = 0; axis < SENSOR_BATCH_MAX_AXES; axis++) {
+		batch.values[axis] = values[axis];
+	}
+	batch.timestamp_deltas = timestamp_deltas;
+	batch.capacity = MAX_FRAMES;
+}
+
+ZTEST_SUITE(sensor_batch, NULL, NULL, before, NULL, NULL);
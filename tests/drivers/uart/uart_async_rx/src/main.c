@@ -144,6 +144,43 @@ ZTEST(uart_async_rx, test_rx_late_consume)
 	zassert_equal(claim_len, 0);
 }
 
+ZTEST(uart_async_rx, test_rx_large_buf)
+{
+	int err;
+	static uint8_t buf[1024];
+	static const int buf_cnt = 2;
+	size_t aloc_len;
+	size_t claim_len;
+	uint8_t *claim_buf;
+	uint8_t *aloc_buf;
+	struct uart_async_rx async_rx;
+	const struct uart_async_rx_config config = {
+		.buffer = buf,
+		.length = sizeof(buf),
+		.buf_cnt = buf_cnt
+	};
+
+	err = uart_async_rx_init(&async_rx, &config);
+	zassert_equal(err, 0);
+
+	aloc_len = uart_async_rx_get_buf_len(&async_rx);
+	zassert_true(aloc_len > 500);
+
+	aloc_buf = uart_async_rx_buf_req(&async_rx);
+	mem_fill(aloc_buf, 0, UINT8_MAX);
+	uart_async_rx_on_rdy(&async_rx, aloc_buf, 300);
+
+	/* Data is claimed in place, beyond what a byte can index. */
+	claim_len = uart_async_rx_data_claim(&async_rx, &claim_buf, aloc_len);
+	zassert_equal(claim_len, 300);
+	zassert_equal(claim_buf, aloc_buf);
+	zassert_true(mem_check(claim_buf, 0, UINT8_MAX));
+
+	(void)uart_async_rx_data_consume(&async_rx, 300);
+	claim_len = uart_async_rx_data_claim(&async_rx, &claim_buf, aloc_len);
+	zassert_equal(claim_len, 0);
+}
+
 struct test_async_rx {
 	struct uart_async_rx async_rx;
 	atomic_t pending_req;
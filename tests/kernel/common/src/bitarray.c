@@ -525,6 +525,73 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test contiguous allocations in a large fragmented bitarray
+ *
+ * @see sys_bitarray_alloc()
+ * @see sys_bitarray_free()
+ */
+ZTEST(bitarray, test_bitarray_alloc_large)
+{
+	int ret;
+	size_t offset;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	SYS_BITARRAY_DEFINE(ba, 4096);
+
+	ret = sys_bitarray_alloc(&ba, 4000, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 0, "sys_bitarray_alloc() offset expected %d, got %d", 0, offset);
+
+	/* Leave a 64-bit hole, not aligned on bundles */
+	ret = sys_bitarray_free(&ba, 64, 100);
+	zassert_ok(ret, "sys_bitarray_free() failed: %d", ret);
+
+	/* Too big for the hole, goes to the end */
+	ret = sys_bitarray_alloc(&ba, 65, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 4000, "sys_bitarray_alloc() offset expected %d, got %d",
+		      4000, offset);
+
+	ret = sys_bitarray_alloc(&ba, 64, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 100, "sys_bitarray_alloc() offset expected %d, got %d", 100, offset);
+
+	/* Only 31 bits are left, at the very end */
+	ret = sys_bitarray_alloc(&ba, 32, &offset);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc() should fail but not");
+
+	ret = sys_bitarray_alloc(&ba, 31, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 4065, "sys_bitarray_alloc() offset expected %d, got %d",
+		      4065, offset);
+
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc() should fail but not");
+
+	/* Free a whole bundle in the middle, then a single bit before it */
+	ret = sys_bitarray_free(&ba, 32, 2048);
+	zassert_ok(ret, "sys_bitarray_free() failed: %d", ret);
+	ret = sys_bitarray_free(&ba, 1, 7);
+	zassert_ok(ret, "sys_bitarray_free() failed: %d", ret);
+
+	ret = sys_bitarray_alloc(&ba, 2, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 2048, "sys_bitarray_alloc() offset expected %d, got %d",
+		      2048, offset);
+
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_ok(ret, "sys_bitarray_alloc() failed: %d", ret);
+	zassert_equal(offset, 7, "sys_bitarray_alloc() offset expected %d, got %d", 7, offset);
+
+	zassert_true(sys_bitarray_is_region_set(&ba, 2050, 0), "region should be all set");
+	zassert_true(sys_bitarray_is_region_cleared(&ba, 30, 2050), "region should be clear");
+}
+
 ZTEST(bitarray, test_bitarray_popcount_region)
 {
 	int ret;
@@ -0,0 +1,217 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/debug/boot_timeline.h>
+#include <zephyr/ztest.h>
+
+#define DT_DRV_COMPAT vnd_lazy_device
+
+#define LAZY_BASE  DEVICE_DT_GET(DT_NODELABEL(lazy_base))
+#define LAZY_TOP   DEVICE_DT_GET(DT_NODELABEL(lazy_top))
+#define LAZY_ISR   DEVICE_DT_GET(DT_NODELABEL(lazy_isr))
+#define LAZY_SLOW  DEVICE_DT_GET(DT_NODELABEL(lazy_slow))
+#define LAZY_OTHER DEVICE_DT_GET(DT_NODELABEL(lazy_other))
+#define EAGER      DEVICE_DT_GET(DT_NODELABEL(eager))
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct lazy_dev_data {
+	/* Number of calls to the init function */
+	atomic_t inits;
+	/* Position of the last call among all the init calls */
+	atomic_val_t seq;
+};
+
+static atomic_t init_seq;
+
+/* Given once the slow device may complete its initialization */
+static K_SEM_DEFINE(slow_go, 0, 1);
+static int slow_wait_res = -EINPROGRESS;
+
+static K_THREAD_STACK_DEFINE(stack_a, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(stack_b, STACK_SIZE);
+static struct k_thread thread_a;
+static struct k_thread thread_b;
+
+static int lazy_dev_init(const struct device *dev)
+{
+	struct lazy_dev_data *data = dev->data;
+
+	data->seq = atomic_inc(&init_seq);
+	(void)atomic_inc(&data->inits);
+
+	if (dev == LAZY_SLOW) {
+		slow_wait_res = k_sem_take(&slow_go, K_SECONDS(1));
+	}
+
+	return (dev == EAGER) ? -EIO : 0;
+}
+
+#define LAZY_DEV_DEFINE(n)                                                                 \
+	static struct lazy_dev_data lazy_dev_data_##n;                                     \
+	DEVICE_DT_INST_DEFINE(n, lazy_dev_init, NULL, &lazy_dev_data_##n, NULL,            \
+			      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(LAZY_DEV_DEFINE)
+
+static atomic_val_t inits(const struct device *dev)
+{
+	return atomic_get(&((struct lazy_dev_data *)dev->data)->inits);
+}
+
+static atomic_val_t seq(const struct device *dev)
+{
+	return ((struct lazy_dev_data *)dev->data)->seq;
+}
+
+/* zephyr,lazy-init marks a device as lazy, the others are initialized on boot */
+ZTEST(device_lazy_init, test_dt_property)
+{
+	zassert_not_equal(LAZY_BASE->flags & DEVICE_FLAG_INIT_LAZY, 0U);
+	zassert_not_equal(LAZY_BASE->flags & DEVICE_FLAG_INIT_DEFERRED, 0U);
+	zassert_equal(EAGER->flags & (DEVICE_FLAG_INIT_LAZY | DEVICE_FLAG_INIT_DEFERRED), 0U);
+
+	zassert_equal(inits(EAGER), 1);
+	zassert_true(EAGER->state->initialized);
+
+	/* A failed eager device is not initialized again */
+	zassert_false(device_is_ready(EAGER));
+	zassert_equal(inits(EAGER), 1);
+}
+
+/* The lazy devices a device requires are initialized first, and once */
+ZTEST(device_lazy_init, test_dependency_order)
+{
+	zassert_equal(inits(LAZY_BASE), 0);
+	zassert_equal(inits(LAZY_TOP), 0);
+
+	zassert_true(device_is_ready(LAZY_TOP));
+
+	zassert_equal(inits(LAZY_BASE), 1);
+	zassert_equal(inits(LAZY_TOP), 1);
+	zassert_true(seq(LAZY_BASE) < seq(LAZY_TOP), "Dependency initialized after its user");
+
+	zassert_true(device_is_ready(LAZY_BASE));
+	zassert_true(device_is_ready(LAZY_TOP));
+	zassert_equal(inits(LAZY_BASE), 1);
+	zassert_equal(inits(LAZY_TOP), 1);
+}
+
+static bool isr_ready;
+static K_SEM_DEFINE(isr_done, 0, 1);
+
+static void isr_check(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	isr_ready = device_is_ready(LAZY_ISR);
+	k_sem_give(&isr_done);
+}
+
+/* A lazy device is not initialized from an interrupt, only reported not ready */
+ZTEST(device_lazy_init, test_isr)
+{
+	struct k_timer timer;
+
+	k_timer_init(&timer, isr_check, NULL);
+	k_timer_start(&timer, K_MSEC(1), K_NO_WAIT);
+	zassert_ok(k_sem_take(&isr_done, K_SECONDS(1)));
+
+	zassert_false(isr_ready);
+	zassert_equal(inits(LAZY_ISR), 0);
+
+	zassert_true(device_is_ready(LAZY_ISR));
+	zassert_equal(inits(LAZY_ISR), 1);
+}
+
+static void check_slow(void *p1, void *p2, void *p3)
+{
+	bool *ready = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	*ready = device_is_ready(LAZY_SLOW);
+}
+
+/*
+ * While a device is initialized, the other lazy devices can be checked, so
+ * that its init function can wait on them, and concurrent users of the
+ * device wait for its initialization to be done.
+ */
+ZTEST(device_lazy_init, test_concurrent)
+{
+	bool ready_a = false;
+	bool ready_b = false;
+
+	k_thread_create(&thread_a, stack_a, K_THREAD_STACK_SIZEOF(stack_a), check_slow,
+			&ready_a, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	while (inits(LAZY_SLOW) == 0) {
+		k_sleep(K_MSEC(1));
+	}
+
+	k_thread_create(&thread_b, stack_b, K_THREAD_STACK_SIZEOF(stack_b), check_slow,
+			&ready_b, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_thread_join(&thread_b, K_MSEC(10)), -EAGAIN,
+		      "Second user did not wait for the initialization");
+
+	zassert_true(device_is_ready(LAZY_OTHER));
+	k_sem_give(&slow_go);
+
+	zassert_ok(k_thread_join(&thread_a, K_SECONDS(2)));
+	zassert_ok(k_thread_join(&thread_b, K_SECONDS(2)));
+
+	zassert_ok(slow_wait_res, "Initialization blocked other lazy devices");
+	zassert_true(ready_a);
+	zassert_true(ready_b);
+	zassert_equal(inits(LAZY_SLOW), 1);
+}
+
+struct timeline_check {
+	size_t records;
+	uint8_t first_event;
+	uint8_t last_event;
+	bool eager_found;
+};
+
+static void timeline_cb(const struct boot_timeline_record *record, void *user_data)
+{
+	struct timeline_check *check = user_data;
+
+	if (check->records == 0U) {
+		check->first_event = record->event;
+	}
+	check->last_event = record->event;
+	check->records++;
+
+	if (record->event != BOOT_TIMELINE_INIT_ENTRY) {
+		return;
+	}
+
+	if (record->entry->dev == EAGER) {
+		zassert_str_equal(boot_timeline_name(record), EAGER->name);
+		zassert_equal(record->result, -EIO);
+		check->eager_found = true;
+	}
+}
+
+/* The timeline holds the kernel start, the init entries then main() */
+ZTEST(device_lazy_init, test_boot_timeline)
+{
+	struct timeline_check check = { 0 };
+
+	boot_timeline_foreach(timeline_cb, &check);
+
+	zassert_true(check.records > 2U);
+	zassert_equal(check.first_event, BOOT_TIMELINE_KERNEL_START);
+	zassert_equal(check.last_event, BOOT_TIMELINE_MAIN);
+	zassert_true(check.eager_found, "Eager device not recorded");
+}
+
+ZTEST_SUITE(device_lazy_init, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,187 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/ztest.h>
+
+#define DEV(label) DEVICE_DT_GET(DT_NODELABEL(label))
+
+/* Long enough for another device to start meanwhile */
+#define SLOW_INIT_MS 50
+
+/* Each start and end of an init call takes the next position */
+struct init_record {
+	atomic_t inits;
+	atomic_val_t start;
+	atomic_val_t end;
+};
+
+static atomic_t init_seq;
+
+static void record_start(struct init_record *record)
+{
+	record->start = atomic_inc(&init_seq);
+	(void)atomic_inc(&record->inits);
+}
+
+static void record_end(struct init_record *record)
+{
+	record->end = atomic_inc(&init_seq);
+}
+
+static int init_dev_init(const struct device *dev)
+{
+	struct init_record *record = dev->data;
+
+	record_start(record);
+
+	if ((dev == DEV(slow_p)) || (dev == DEV(slow_q))) {
+		k_msleep(SLOW_INIT_MS);
+	}
+
+	record_end(record);
+
+	return 0;
+}
+
+#define INIT_DEV_DEFINE(label, prio)                                                       \
+	static struct init_record init_record_##label;                                     \
+	DEVICE_DT_DEFINE(DT_NODELABEL(label), init_dev_init, NULL, &init_record_##label,   \
+			 NULL, APPLICATION, prio, NULL)
+
+/* Independent slow devices, and a device waiting for one of them */
+INIT_DEV_DEFINE(slow_p, 10);
+INIT_DEV_DEFINE(slow_q, 10);
+INIT_DEV_DEFINE(after_p, 10);
+
+/* Circular dependencies */
+INIT_DEV_DEFINE(cycle_stub, 20);
+INIT_DEV_DEFINE(cycle_a, 20);
+INIT_DEV_DEFINE(cycle_b, 20);
+
+/* Dependency on a device of a later priority, in the same run */
+INIT_DEV_DEFINE(back_user, 30);
+INIT_DEV_DEFINE(back_dep, 35);
+
+/* Dependency on a deferred device */
+INIT_DEV_DEFINE(deferred_dev, 40);
+INIT_DEV_DEFINE(deferred_user, 40);
+
+/* Dependency on a device of a later run, past the SYS_INIT() below */
+INIT_DEV_DEFINE(split_user, 45);
+INIT_DEV_DEFINE(split_dep, 60);
+
+static struct init_record separator;
+
+static int separator_init(void)
+{
+	record_start(&separator);
+	record_end(&separator);
+
+	return 0;
+}
+
+SYS_INIT(separator_init, APPLICATION, 50);
+
+/*
+ * Devicetree cannot express a dependency cycle: close it at boot by making
+ * cycle_b require cycle_a instead of cycle_stub.
+ */
+static int make_cycle(void)
+{
+	device_handle_t stub = device_handle_get(DEV(cycle_stub));
+	device_handle_t *handles = DEV(cycle_b)->deps;
+	size_t count;
+
+	(void)device_required_handles_get(DEV(cycle_b), &count);
+
+	for (size_t i = 0; i < count; i++) {
+		if (handles[i] == stub) {
+			handles[i] = device_handle_get(DEV(cycle_a));
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(make_cycle, PRE_KERNEL_1, 0);
+
+static const struct init_record *record_of(const struct device *dev)
+{
+	const struct init_record *record = dev->data;
+
+	zassert_equal(atomic_get(&record->inits), 1, "%s initialized %ld times", dev->name,
+		      (long)atomic_get(&record->inits));
+
+	return record;
+}
+
+static void assert_before(const struct device *first, const struct device *second)
+{
+	zassert_true(record_of(first)->end < record_of(second)->start, "%s not done before %s",
+		     first->name, second->name);
+}
+
+ZTEST(device_parallel_init, test_independent)
+{
+	const struct init_record *p = record_of(DEV(slow_p));
+	const struct init_record *q = record_of(DEV(slow_q));
+
+	zassert_true((p->start < q->end) && (q->start < p->end),
+		     "Independent devices were not initialized together");
+	assert_before(DEV(slow_p), DEV(after_p));
+}
+
+ZTEST(device_parallel_init, test_circular)
+{
+	device_handle_t handle_a = device_handle_get(DEV(cycle_a));
+	const device_handle_t *handles;
+	size_t count;
+
+	handles = device_required_handles_get(DEV(cycle_b), &count);
+	zassert_equal(count, 1);
+	zassert_equal(handles[0], handle_a, "No dependency cycle");
+
+	/* Stuck on the cycle, the run falls back to link order */
+	assert_before(DEV(cycle_stub), DEV(cycle_b));
+	assert_before(DEV(cycle_b), DEV(cycle_a));
+}
+
+ZTEST(device_parallel_init, test_backward)
+{
+	assert_before(DEV(back_dep), DEV(back_user));
+}
+
+ZTEST(device_parallel_init, test_deferred)
+{
+	const struct init_record *record = DEV(deferred_dev)->data;
+
+	(void)record_of(DEV(deferred_user));
+	zassert_equal(atomic_get(&record->inits), 0);
+
+	zassert_ok(device_init(DEV(deferred_dev)));
+	(void)record_of(DEV(deferred_dev));
+}
+
+ZTEST(device_parallel_init, test_sys_init)
+{
+	const struct device *const before[] = {
+		DEV(slow_p), DEV(slow_q), DEV(after_p), DEV(cycle_stub), DEV(cycle_a),
+		DEV(cycle_b), DEV(back_user), DEV(back_dep), DEV(deferred_user), DEV(split_user),
+	};
+
+	ARRAY_FOR_EACH(before, i) {
+		zassert_true(record_of(before[i])->end < separator.start,
+			     "%s not done before the SYS_INIT()", before[i]->name);
+	}
+
+	/* The later run only starts after it, whatever the dependencies */
+	zassert_true(separator.end < record_of(DEV(split_dep))->start);
+}
+
+ZTEST_SUITE(device_parallel_init, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,84 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * @brief eager FPU context restore test
+ *
+ * A thread which used the FPU gets its FPU context back when scheduled in,
+ * before any FP instruction, for CONFIG_FPU_SHARING_EAGER_SWITCHES context
+ * switches at most while it does not use the FPU again.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel_structs.h>
+
+#include "test_common.h"
+
+#ifdef CONFIG_FPU_SHARING_EAGER_SWITCHES
+
+#define EAGER_SWITCHES CONFIG_FPU_SHARING_EAGER_SWITCHES
+
+static K_THREAD_STACK_DEFINE(fpu_user_stack, THREAD_STACK_SIZE);
+static struct k_thread fpu_user_thread;
+static K_SEM_DEFINE(fpu_user_sem, 0, 1);
+static K_SEM_DEFINE(fpu_used_sem, 0, 1);
+
+static volatile double fp_value = 1.0;
+
+static __noinline void fp_use(void)
+{
+	fp_value = fp_value * 1.5 + 1.0;
+}
+
+static bool fpu_owned(void)
+{
+	unsigned int key = arch_irq_lock();
+	bool owned = atomic_ptr_get(&_current_cpu->arch.fpu_owner) == _current;
+
+	arch_irq_unlock(key);
+	return owned;
+}
+
+/* Takes the FPU away from the test thread each time it is woken up */
+static void fpu_user(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&fpu_user_sem, K_FOREVER);
+		fp_use();
+		k_sem_give(&fpu_used_sem);
+	}
+}
+
+ZTEST(fpu_sharing_generic, test_eager_restore)
+{
+	k_thread_create(&fpu_user_thread, fpu_user_stack, K_THREAD_STACK_SIZEOF(fpu_user_stack),
+			fpu_user, NULL, NULL, NULL, THREAD_HIGH_PRIORITY, THREAD_FP_FLAGS,
+			K_NO_WAIT);
+
+	fp_use();
+	zassert_true(fpu_owned(), "FPU not owned after use");
+
+	for (int i = 0; i <= EAGER_SWITCHES; i++) {
+		/* Switch to the FPU user and back */
+		k_sem_give(&fpu_user_sem);
+		k_sem_take(&fpu_used_sem, K_FOREVER);
+
+		if (i < EAGER_SWITCHES) {
+			zassert_true(fpu_owned(), "FPU context not restored after %d switches", i);
+		} else {
+			zassert_false(fpu_owned(), "FPU context restored after %d switches", i);
+		}
+	}
+
+	k_thread_abort(&fpu_user_thread);
+}
+
+#endif /* CONFIG_FPU_SHARING_EAGER_SWITCHES */
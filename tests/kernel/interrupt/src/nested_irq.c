@@ -156,6 +156,10 @@ ZTEST(interrupt_feature, test_nested_isr)
 	irq_enable(irq_line_0);
 	irq_enable(irq_line_1);
 
+#ifdef CONFIG_IRQ_STATS_ISR
+	k_irq_stats_reset();
+#endif
+
 	/* Trigger test IRQ 0 */
 	trigger_irq(irq_line_0);
 
@@ -164,6 +168,19 @@ ZTEST(interrupt_feature, test_nested_isr)
 
 	/* Validate ISR result token */
 	zassert_equal(isr0_result, ISR0_TOKEN, "isr0 did not execute");
+
+#ifdef CONFIG_IRQ_STATS_ISR
+	struct k_irq_stats stats0, stats1;
+
+	zassert_equal(k_irq_stats_get(irq_line_0, &stats0), 0);
+	zassert_equal(k_irq_stats_get(irq_line_1, &stats1), 0);
+	zassert_equal(stats0.count, 1, "isr0 not measured");
+	zassert_equal(stats1.count, 1, "isr1 not measured");
+
+	/* isr0 busy waits, the time spent in isr1 is not counted to it */
+	zassert_true(stats0.max > stats1.max);
+	zassert_equal(k_irq_stats_get(CONFIG_NUM_IRQS, &stats0), -EINVAL);
+#endif
 }
 #else
 ZTEST(interrupt_feature, test_nested_isr)
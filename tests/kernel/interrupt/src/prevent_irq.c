@@ -64,4 +64,34 @@ ZTEST(interrupt_feature, test_prevent_interruption)
 	k_timer_stop(&irqlock_timer);
 }
 
+#ifdef CONFIG_IRQ_STATS_LOCK
+/**
+ * @brief Test interrupt masking statistics
+ *
+ * @ingroup kernel_interrupt_tests
+ *
+ * Verify that a section run with interrupts locked is measured and that
+ * its longest duration is attributed to a holder.
+ */
+ZTEST(interrupt_feature, test_irq_lock_stats)
+{
+	struct k_irq_lock_stats stats;
+	unsigned int key;
+
+	k_irq_stats_reset();
+
+	key = irq_lock();
+	k_busy_wait(DURATION * USEC_PER_MSEC);
+	irq_unlock(key);
+
+	zassert_equal(k_irq_lock_stats_get(&stats), 0);
+	zassert_true(stats.masked.count > 0, "masked section not measured");
+	zassert_true(stats.masked.max > 0);
+	zassert_not_equal(stats.holders[0].addr, 0, "no holder recorded");
+	zassert_equal(stats.holders[0].max, stats.masked.max,
+		      "longest holder does not match the maximum");
+	zassert_equal(k_irq_lock_stats_get(NULL), -EINVAL);
+}
+#endif /* CONFIG_IRQ_STATS_LOCK */
+
 ZTEST_SUITE(interrupt_feature, NULL, NULL, NULL, NULL, NULL);
@@ -178,6 +178,202 @@ ZTEST(k_heap_api, test_k_heap_free)
 	k_heap_free(&k_heap_test, p);
 }
 
+#ifdef CONFIG_HEAP_PERCPU_CACHE
+/**
+ * @brief Test the per-CPU caches of small blocks
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @details Small blocks are served from and freed to the per-CPU cache,
+ * and the cache is flushed back to the heap when a larger allocation
+ * does not fit otherwise.
+ *
+ * @see k_heap_alloc(), k_heap_free(), k_heap_cache_stats_get()
+ */
+ZTEST(k_heap_api, test_k_heap_percpu_cache)
+{
+	struct k_heap_cache_stats before, after;
+	void *blocks[8];
+	char *p;
+
+	/* Stay on this CPU, and thus on its cache */
+	k_sched_lock();
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = k_heap_alloc(&k_heap_test, 100, K_NO_WAIT);
+		zassert_not_null(blocks[i], "k_heap_alloc operation failed");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		k_heap_free(&k_heap_test, blocks[i]);
+	}
+
+	zassert_ok(k_heap_cache_stats_get(&k_heap_test, &before));
+	zassert_true(before.refills > 0U, "cache never refilled");
+	zassert_true(before.cached_bytes > 0U, "freed blocks were not cached");
+
+	p = k_heap_alloc(&k_heap_test, 100, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	zassert_ok(k_heap_cache_stats_get(&k_heap_test, &after));
+	zassert_equal(after.hits, before.hits + 1U, "allocation missed the cache");
+	k_heap_free(&k_heap_test, p);
+
+	/* Only fits once the cached blocks are back in the heap */
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not flushed");
+	k_heap_free(&k_heap_test, p);
+
+	k_sched_unlock();
+}
+
+#define CACHED_BLOCKS 8
+#define FILLER_SIZE   32
+
+static K_THREAD_STACK_DEFINE(remote_stack, STACK_SIZE);
+static struct k_thread remote_thread;
+static void *cached_blocks[CACHED_BLOCKS];
+static void *fillers[HEAP_SIZE / FILLER_SIZE];
+
+static void run_on_cpu(struct k_thread *thread, k_thread_stack_t *stack, int cpu,
+		       k_thread_entry_t entry, void *arg)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry, arg, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(thread, cpu));
+	k_thread_start(thread);
+}
+
+/* Aligned allocations bypass the caches: fill the heap up with them */
+static int fill_heap(void)
+{
+	int n = 0;
+
+	while (n < ARRAY_SIZE(fillers)) {
+		fillers[n] = k_heap_aligned_alloc(&k_heap_test, sizeof(void *), FILLER_SIZE,
+						  K_NO_WAIT);
+		if (fillers[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+	zassert_true(n < ARRAY_SIZE(fillers), "heap never filled up");
+
+	return n;
+}
+
+static void free_fillers(int n)
+{
+	for (int i = 0; i < n; i++) {
+		k_heap_free(&k_heap_test, fillers[i]);
+	}
+}
+
+static void cpu1_alloc_cached(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < CACHED_BLOCKS; i++) {
+		cached_blocks[i] = k_heap_alloc(&k_heap_test, 100, K_NO_WAIT);
+		zassert_not_null(cached_blocks[i], "k_heap_alloc operation failed");
+	}
+}
+
+static void cpu1_free_cached(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < CACHED_BLOCKS; i++) {
+		k_heap_free(&k_heap_test, cached_blocks[i]);
+	}
+}
+
+static void cpu0_alloc_nowait(void *p1, void *p2, void *p3)
+{
+	void **p = p1;
+
+	*p = k_heap_aligned_alloc(&k_heap_test, sizeof(void *), 100, K_NO_WAIT);
+}
+
+/**
+ * @brief Test the reclaim of the blocks cached by another CPU
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @details CPU1 caches blocks in a full heap, then an allocation on CPU0
+ * only fits once the blocks cached by CPU1 are given back to the heap.
+ *
+ * @see k_heap_alloc(), k_heap_free(), k_heap_cache_stats_get()
+ */
+ZTEST(k_heap_api, test_k_heap_percpu_cache_remote)
+{
+	struct k_heap_cache_stats stats;
+	void *p = NULL;
+	int n;
+
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	run_on_cpu(&remote_thread, remote_stack, 1, cpu1_alloc_cached, NULL);
+	k_thread_join(&remote_thread, K_FOREVER);
+
+	n = fill_heap();
+
+	run_on_cpu(&remote_thread, remote_stack, 1, cpu1_free_cached, NULL);
+	k_thread_join(&remote_thread, K_FOREVER);
+
+	zassert_ok(k_heap_cache_stats_get(&k_heap_test, &stats));
+	zassert_true(stats.cached_bytes >= CACHED_BLOCKS * 100, "CPU1 did not cache its blocks");
+
+	run_on_cpu(&remote_thread, remote_stack, 0, cpu0_alloc_nowait, &p);
+	k_thread_join(&remote_thread, K_FOREVER);
+
+	zassert_not_null(p, "blocks cached by CPU1 were not reclaimed");
+	zassert_ok(k_heap_cache_stats_get(&k_heap_test, &stats));
+	zassert_equal(stats.cached_bytes, 0U, "caches were not flushed");
+
+	k_heap_free(&k_heap_test, p);
+	free_fillers(n);
+}
+
+static void cpu1_free_filler(void *p1, void *p2, void *p3)
+{
+	k_msleep(50);
+	k_heap_free(&k_heap_test, p1);
+}
+
+/**
+ * @brief Test a waiter woken by a free on another CPU
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @details An allocation waiting for memory in a full heap gets the block
+ * freed on CPU1, which must not be kept in the cache of CPU1.
+ *
+ * @see k_heap_aligned_alloc(), k_heap_free()
+ */
+ZTEST(k_heap_api, test_k_heap_percpu_cache_waiter)
+{
+	struct k_heap_cache_stats stats;
+	void *p;
+	int n;
+
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	n = fill_heap();
+	zassert_true(n > 0, "no room for fillers");
+
+	run_on_cpu(&remote_thread, remote_stack, 1, cpu1_free_filler, fillers[--n]);
+
+	p = k_heap_aligned_alloc(&k_heap_test, sizeof(void *), FILLER_SIZE, K_FOREVER);
+	zassert_not_null(p, "waiter was not woken");
+	k_thread_join(&remote_thread, K_FOREVER);
+
+	zassert_ok(k_heap_cache_stats_get(&k_heap_test, &stats));
+	zassert_equal(stats.cached_bytes, 0U, "block freed to a waiter was cached");
+
+	k_heap_free(&k_heap_test, p);
+	free_fillers(n);
+}
+#endif /* CONFIG_HEAP_PERCPU_CACHE */
+
 /**
  * @brief Validate allocation and free heap memory in isr context.
  *
@@ -9,10 +9,13 @@
 #include <zephyr/kernel/mm/demand_paging.h>
 #include <zephyr/timing/timing.h>
 #include <mmu.h>
+#include <kernel_arch_interface.h>
 #include <zephyr/linker/sections.h>
 
 #ifdef CONFIG_BACKING_STORE_RAM_PAGES
 #define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#elif defined(CONFIG_BACKING_STORE_COMPRESSED_PAGES)
+#define EXTRA_PAGES	(CONFIG_BACKING_STORE_COMPRESSED_PAGES - 1)
 #else
 #error "Unsupported configuration"
 #endif
@@ -113,6 +116,8 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+	printk("    - Refaults: %lu\n",
+	       stats->eviction.refaults);
 }
 
 static void touch_anon_pages(bool zig, bool zag)
@@ -232,6 +237,54 @@ ZTEST(demand_paging, test_unmap_anon_pages)
 	 ztest_test_fail();
 }
 
+#define ZERO_PAGE_TEST_PAGES 4
+
+/* Show that zeroed pages only read share a page of zeroes, until written */
+ZTEST(demand_paging, test_zero_page)
+{
+#ifdef CONFIG_DEMAND_MAPPING_ZERO_PAGE
+	size_t size = ZERO_PAGE_TEST_PAGES * CONFIG_MMU_PAGE_SIZE;
+	uintptr_t zero_phys, phys, location;
+	char *mem;
+
+	mem = k_mem_map(size, K_MEM_PERM_RW);
+	zassert_not_null(mem, "failed to map %zu bytes", size);
+
+	for (size_t i = 0; i < size; i++) {
+		zassert_equal(mem[i], '\x00', "page not zeroed at index %zu", i);
+	}
+
+	zassert_ok(arch_page_phys_get(mem, &zero_phys));
+	for (size_t i = 0; i < size; i += CONFIG_MMU_PAGE_SIZE) {
+		zassert_ok(arch_page_phys_get(&mem[i], &phys));
+		zassert_equal(phys, zero_phys, "page %zu not mapped to the zero page", i);
+		zassert_equal(arch_page_location_get(&mem[i], &location),
+			      ARCH_PAGE_LOCATION_PAGED_OUT, "zero page %zu reported paged in", i);
+		zassert_equal(location, ARCH_UNPAGED_ANON_ZERO);
+	}
+
+	/* The first write gets a page frame of its own */
+	mem[0] = nums[0];
+
+	zassert_equal(arch_page_location_get(mem, &location), ARCH_PAGE_LOCATION_PAGED_IN,
+		      "written page not paged in");
+	zassert_not_equal(location, zero_phys, "written page still mapped to the zero page");
+	zassert_equal(mem[0], nums[0]);
+	zassert_equal(mem[1], '\x00', "page not zeroed on first write");
+
+	/* The other pages still share the zero page, which is left unchanged */
+	for (size_t i = CONFIG_MMU_PAGE_SIZE; i < size; i += CONFIG_MMU_PAGE_SIZE) {
+		zassert_ok(arch_page_phys_get(&mem[i], &phys));
+		zassert_equal(phys, zero_phys, "page %zu not mapped to the zero page", i);
+		zassert_equal(mem[i], '\x00', "zero page written");
+	}
+
+	k_mem_unmap(mem, size);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_DEMAND_MAPPING_ZERO_PAGE */
+}
+
 static void test_k_mem_page_out(void)
 {
 	unsigned long faults;
@@ -288,6 +341,42 @@ ZTEST(demand_paging_api, test_k_mem_page_in)
 		      faults);
 }
 
+/* Show that two page faults on consecutive pages read the next ones ahead */
+ZTEST(demand_paging_api, test_readahead)
+{
+#ifdef CONFIG_DEMAND_PAGING_READAHEAD
+	size_t ahead = MIN(CONFIG_DEMAND_PAGING_READAHEAD_PAGES, HALF_PAGES - 2);
+	uintptr_t location;
+	int key, ret;
+
+	ret = k_mem_page_out(arena, HALF_BYTES);
+	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
+
+	/* No other page fault in between */
+	key = irq_lock();
+	arena[0] = nums[0];
+	arena[CONFIG_MMU_PAGE_SIZE] = nums[1];
+	irq_unlock(key);
+
+	/* Let the system work queue page them in */
+	k_msleep(100);
+
+	for (size_t i = 2; i < (2 + ahead); i++) {
+		zassert_equal(arch_page_location_get(&arena[i * CONFIG_MMU_PAGE_SIZE], &location),
+			      ARCH_PAGE_LOCATION_PAGED_IN, "page %zu not read ahead", i);
+	}
+
+	if ((2 + CONFIG_DEMAND_PAGING_READAHEAD_PAGES) < HALF_PAGES) {
+		size_t i = 2 + CONFIG_DEMAND_PAGING_READAHEAD_PAGES;
+
+		zassert_equal(arch_page_location_get(&arena[i * CONFIG_MMU_PAGE_SIZE], &location),
+			      ARCH_PAGE_LOCATION_PAGED_OUT, "page %zu read ahead", i);
+	}
+#else
+	ztest_test_skip();
+#endif /* CONFIG_DEMAND_PAGING_READAHEAD */
+}
+
 ZTEST(demand_paging_api, test_k_mem_pin)
 {
 	unsigned long faults;
@@ -328,6 +417,50 @@ ZTEST(demand_paging_api, test_k_mem_unpin)
 	test_k_mem_page_out();
 }
 
+/* Pages at the start of the arena used as working set by the scan test */
+#define WORKING_SET_PAGES 4
+
+static void touch_pages(const char *start, size_t pages)
+{
+	for (size_t i = 0; i < pages; i++) {
+		(void)*(volatile const char *)&start[i * CONFIG_MMU_PAGE_SIZE];
+	}
+}
+
+/* Show that a working set is not evicted by a single scan over the rest
+ * of the arena, which does not fit in RAM.
+ */
+ZTEST(demand_paging_scan, test_scan_resistance)
+{
+	const char *scan = arena + (WORKING_SET_PAGES * CONFIG_MMU_PAGE_SIZE);
+	size_t scan_pages = (arena_size / CONFIG_MMU_PAGE_SIZE) - WORKING_SET_PAGES;
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults;
+
+	if (!IS_ENABLED(CONFIG_EVICTION_2Q)) {
+		ztest_test_skip();
+	}
+
+	/* Reuse the working set all along a first pass so that it gets protected */
+	for (size_t i = 0; i < scan_pages; i++) {
+		touch_pages(&scan[i * CONFIG_MMU_PAGE_SIZE], 1);
+		touch_pages(arena, WORKING_SET_PAGES);
+	}
+
+	/* Then scan alone, touching each page once */
+	touch_pages(scan, scan_pages);
+
+	faults = k_mem_num_pagefaults_get();
+	touch_pages(arena, WORKING_SET_PAGES);
+	faults = k_mem_num_pagefaults_get() - faults;
+
+	k_mem_paging_stats_get(&stats);
+	print_paging_stats(&stats, "kernel");
+
+	zassert_true(faults < WORKING_SET_PAGES,
+		     "working set evicted by the scan, %lu page faults", faults);
+}
+
 /* Show that even if we map enough anonymous memory to fill the backing
  * store, we can still handle pagefaults.
  * This eats up memory so should be last in the suite.
@@ -337,8 +470,7 @@ ZTEST(demand_paging_stat, test_backing_store_capacity)
 	char *mem, *ret;
 	unsigned int key;
 	unsigned long faults;
-	size_t size = (((CONFIG_BACKING_STORE_RAM_PAGES - 1) - HALF_PAGES) *
-		       CONFIG_MMU_PAGE_SIZE);
+	size_t size = ((EXTRA_PAGES - HALF_PAGES) * CONFIG_MMU_PAGE_SIZE);
 
 	/* Consume the rest of memory */
 	mem = k_mem_map(size, K_MEM_PERM_RW);
@@ -385,6 +517,19 @@ ZTEST_USER(demand_paging_stat, test_user_get_stats)
 			  "test thread should have dirty pages evicted.");
 	zassert_not_equal(stats.eviction.clean, 0UL,
 			  "test thread should have clean pages evicted.");
+#ifdef CONFIG_BACKING_STORE_COMPRESSED
+	/* The backing store is full of pages of repeated digits */
+	printk("* Compression (kernel - usermode):\n");
+	printk("    - Pages stored: %lu\n", stats.compression.pages);
+	printk("    - Bytes stored: %lu\n", stats.compression.stored_bytes);
+	printk("    - Same filled: %lu\n", stats.compression.same_filled);
+	printk("    - Incompressible: %lu\n", stats.compression.incompressible);
+	zassert_not_equal(stats.compression.pages, 0UL,
+			  "backing store should hold pages.");
+	zassert_true(stats.compression.stored_bytes <
+		     stats.compression.pages * CONFIG_MMU_PAGE_SIZE,
+		     "pages should have been compressed.");
+#endif /* CONFIG_BACKING_STORE_COMPRESSED */
 
 	/* per-thread statistics */
 	printk("\nPaging stats for current thread (%p):\n", tid);
@@ -468,4 +613,6 @@ ZTEST_SUITE(demand_paging, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(demand_paging_api, NULL, demand_paging_api_setup,
 		NULL, NULL, NULL);
 
+ZTEST_SUITE(demand_paging_scan, NULL, NULL, NULL, NULL, NULL);
+
 ZTEST_SUITE(demand_paging_stat, NULL, NULL, NULL, NULL, NULL);
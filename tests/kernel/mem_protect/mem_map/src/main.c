@@ -280,6 +280,31 @@ ZTEST(mem_map, test_k_mem_map_phys_bare_unmap_reclaim_addr)
 	zassert_equal(mapped, mapped_old, "Virtual memory region not reclaimed!");
 }
 
+/**
+ * Show that K_MEM_MAP_LARGE mappings keep the offset within large pages
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(mem_map, test_k_mem_map_phys_bare_large)
+{
+	uintptr_t phys = k_mem_phys_addr(test_page);
+	size_t large = arch_mem_large_page_size(phys, sizeof(test_page));
+	uint8_t *mapped;
+
+	zassert_true(large >= CONFIG_MMU_PAGE_SIZE, "bad large page size %zu", large);
+
+	test_page[0] = 42;
+
+	k_mem_map_phys_bare(&mapped, phys, sizeof(test_page),
+			    BASE_FLAGS | K_MEM_PERM_RW | K_MEM_MAP_LARGE);
+
+	zassert_equal(((uintptr_t)mapped - phys) & (large - 1), 0,
+		      "mapping %p not congruent to 0x%lx", mapped, phys);
+	zassert_equal(mapped[0], 42, "bad data through large mapping");
+
+	k_mem_unmap_phys_bare(mapped, sizeof(test_page));
+}
+
 /**
  * Basic k_mem_map() and k_mem_unmap() functionality
  *
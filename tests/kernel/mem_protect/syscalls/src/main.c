@@ -10,6 +10,9 @@
 #include <zephyr/linker/linker-defs.h>
 #include "test_syscalls.h"
 #include <mmu.h>
+#ifdef CONFIG_SYSCALL_BATCH
+#include <zephyr/sys/syscall_batch.h>
+#endif
 
 #define BUF_SIZE	32
 
@@ -507,6 +510,42 @@ ZTEST(syscalls, test_syscall_context)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+#ifdef CONFIG_SYSCALL_BATCH
+K_SEM_DEFINE(batch_sem, 0, 10);
+
+/* Calls made in a batch behave as if made one after another */
+ZTEST_USER(syscalls, test_syscall_batch)
+{
+	int err = -1;
+	struct k_syscall_batch_entry batch[] = {
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_RESET, &batch_sem),
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_GIVE, &batch_sem),
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_GIVE, &batch_sem),
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_COUNT_GET, &batch_sem),
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_STRING_NLEN, user_string, BUF_SIZE, &err),
+	};
+
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)), 0, "batch failed");
+	zassert_equal(batch[3].ret, 2, "semaphore count %u in batch", (unsigned int)batch[3].ret);
+	zassert_equal(k_sem_count_get(&batch_sem), 2, "semaphore not given by batch");
+	zassert_equal(batch[4].ret, strlen(user_string), "incorrect length returned");
+	zassert_equal(err, 0, "user string faulted (%d)", err);
+
+	zassert_equal(k_syscall_batch(batch, CONFIG_SYSCALL_BATCH_MAX + 1), -EINVAL,
+		      "oversized batch accepted");
+}
+
+ZTEST(syscalls, test_syscall_batch_supervisor)
+{
+	struct k_syscall_batch_entry batch[] = {
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_GIVE, &batch_sem),
+	};
+
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)), -ENOTSUP,
+		      "batch run from supervisor mode");
+}
+#endif /* CONFIG_SYSCALL_BATCH */
+
 K_HEAP_DEFINE(test_heap, BUF_SIZE * (4 * MAX_NR_THREADS));
 
 void *syscalls_setup(void)
@@ -514,6 +553,9 @@ void *syscalls_setup(void)
 	sprintf(kernel_string, "this is a kernel string");
 	sprintf(user_string, "this is a user string");
 	k_thread_heap_assign(k_current_get(), &test_heap);
+#ifdef CONFIG_SYSCALL_BATCH
+	k_object_access_all_grant(&batch_sem);
+#endif
 
 	return NULL;
 }
@@ -955,6 +955,118 @@ ZTEST(userspace, test_object_recycle)
 	zassert_true(perms_count == 1, "invalid number of thread permissions");
 }
 
+#ifdef CONFIG_OBJ_VALIDATION_CACHE
+static struct k_sem cache_sem;
+ZTEST_BMEM static volatile bool cache_cached;
+ZTEST_BMEM static volatile bool cache_invalidated;
+ZTEST_BMEM static volatile bool cache_stale_use;
+
+static void cache_user(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* The second call finds the object in the validation cache */
+	k_sem_give(sem);
+	k_sem_take(sem, K_NO_WAIT);
+
+	/* Wait without using any other object, which could evict sem */
+	cache_cached = true;
+	while (!cache_invalidated) {
+		k_msleep(1);
+	}
+
+	k_sem_take(sem, K_NO_WAIT);
+	cache_stale_use = true;
+}
+
+/* Have a user thread validate sem from its cache after invalidate() ran */
+static void check_cache_invalidated(struct k_sem *sem, void (*invalidate)(struct k_sem *sem))
+{
+	cache_cached = false;
+	cache_invalidated = false;
+	cache_stale_use = false;
+
+	k_thread_create(&test_thread, test_stack, STACKSIZE, cache_user,
+			sem, NULL, NULL, -1, K_USER, K_FOREVER);
+	k_thread_access_grant(&test_thread, sem);
+	k_thread_start(&test_thread);
+
+	while (!cache_cached) {
+		k_msleep(1);
+	}
+	invalidate(sem);
+
+	set_fault(K_ERR_KERNEL_OOPS);
+	cache_invalidated = true;
+	k_thread_join(&test_thread, K_FOREVER);
+
+	zassert_false(cache_stale_use, "stale validation cache entry was used");
+	zassert_false(expect_fault, "using invalidated object did not fault");
+}
+
+static void cache_revoke(struct k_sem *sem)
+{
+	k_object_access_revoke(sem, &test_thread);
+}
+
+static void cache_recycle(struct k_sem *sem)
+{
+	k_object_recycle(sem);
+}
+
+/**
+ * @brief Test revoking access invalidates the object validation cache
+ *
+ * @see k_object_access_revoke()
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(userspace, test_obj_cache_revoke)
+{
+	k_sem_init(&cache_sem, 0, 1);
+	check_cache_invalidated(&cache_sem, cache_revoke);
+}
+
+/**
+ * @brief Test recycling an object invalidates the object validation cache
+ *
+ * @see k_object_recycle()
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(userspace, test_obj_cache_recycle)
+{
+	k_sem_init(&cache_sem, 0, 1);
+	check_cache_invalidated(&cache_sem, cache_recycle);
+}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+static void cache_free(struct k_sem *sem)
+{
+	k_object_free(sem);
+}
+
+/**
+ * @brief Test freeing an object invalidates the object validation cache
+ *
+ * @see k_object_free()
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(userspace, test_obj_cache_free)
+{
+	struct k_sem *sem = k_object_alloc(K_OBJ_SEM);
+
+	zassert_not_null(sem, "failed to allocate semaphore");
+	k_sem_init(sem, 0, 1);
+	check_cache_invalidated(sem, cache_free);
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+#endif /* CONFIG_OBJ_VALIDATION_CACHE */
+
 #define test_oops(provided, expected) do { \
 	expect_fault = true; \
 	expected_reason = expected; \
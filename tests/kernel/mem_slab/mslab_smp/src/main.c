@@ -0,0 +1,227 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/atomic.h>
+
+#define MAX_THREADS 4
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define LOOP 1000
+#define BLK_NUM 3
+#define BLK_SIZE 16
+#define BLK_ALIGN 8
+
+/* Enough blocks for one of the threads to always get all it needs */
+#define SLAB_BLOCKS (MAX_THREADS * (BLK_NUM - 1) + 1)
+
+K_MEM_SLAB_DEFINE_STATIC(smp_slab, BLK_SIZE, SLAB_BLOCKS, BLK_ALIGN);
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, MAX_THREADS, STACK_SIZE);
+static struct k_thread tdata[MAX_THREADS];
+
+/* Thread owning each block, plus one */
+static atomic_t owner[SLAB_BLOCKS];
+static volatile bool success[MAX_THREADS];
+
+static void *waiter_block;
+static int waiter_result;
+
+static int block_index(void *block)
+{
+	return ((char *)block - smp_slab.buffer) / BLK_SIZE;
+}
+
+/* Lowest bit of the lock-free free list head, see kernel/mem_slab.c */
+static bool slab_waiters_flagged(void)
+{
+#ifdef CONFIG_MEM_SLAB_LOCKLESS
+	return (atomic_get(&smp_slab.free_head) & BIT(0)) != 0;
+#else
+	return false;
+#endif /* CONFIG_MEM_SLAB_LOCKLESS */
+}
+
+static void run_on_cpu(int id, int cpu, k_thread_entry_t entry, void *arg)
+{
+	k_thread_create(&tdata[id], tstack[id], STACK_SIZE, entry, arg,
+			INT_TO_POINTER(id), NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(&tdata[id], cpu));
+	k_thread_start(&tdata[id]);
+}
+
+static void alloc_free_blocks(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p2);
+	void *block[BLK_NUM];
+	int idx;
+
+	for (int j = 0; j < LOOP; j++) {
+		for (int i = 0; i < BLK_NUM; i++) {
+			zassert_ok(k_mem_slab_alloc(&smp_slab, &block[i], K_FOREVER));
+
+			idx = block_index(block[i]);
+			zassert_true(atomic_cas(&owner[idx], 0, id + 1),
+				     "block %d handed out to threads %d and %d", idx,
+				     (int)atomic_get(&owner[idx]) - 1, id);
+			(void)memset(block[i], id, BLK_SIZE);
+		}
+
+		zassert_true(k_mem_slab_num_used_get(&smp_slab) <= SLAB_BLOCKS,
+			     "%u blocks used", k_mem_slab_num_used_get(&smp_slab));
+
+		for (int i = 0; i < BLK_NUM; i++) {
+			for (int n = 0; n < BLK_SIZE; n++) {
+				zassert_equal(((uint8_t *)block[i])[n], id,
+					      "block written by another thread");
+			}
+
+			idx = block_index(block[i]);
+			atomic_set(&owner[idx], 0);
+			k_mem_slab_free(&smp_slab, block[i]);
+		}
+	}
+
+	success[id] = true;
+}
+
+static void alloc_waiter(void *p1, void *p2, void *p3)
+{
+	k_timeout_t *timeout = p1;
+
+	waiter_result = k_mem_slab_alloc(&smp_slab, &waiter_block, *timeout);
+}
+
+static void free_block(void *p1, void *p2, void *p3)
+{
+	k_mem_slab_free(&smp_slab, p1);
+}
+
+static void alloc_all(void **blocks)
+{
+	for (int i = 0; i < SLAB_BLOCKS; i++) {
+		zassert_ok(k_mem_slab_alloc(&smp_slab, &blocks[i], K_NO_WAIT));
+	}
+}
+
+static void free_all(void **blocks, int num)
+{
+	for (int i = 0; i < num; i++) {
+		k_mem_slab_free(&smp_slab, blocks[i]);
+	}
+}
+
+/**
+ * @brief Verify alloc and free from threads on all the CPUs
+ *
+ * @details One thread per CPU allocates and frees blocks concurrently,
+ * and checks that no block is ever handed out to two threads. The usage
+ * counters must add up once they are done.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_smp, test_mslab_smp_alloc_free)
+{
+	int num = MIN(arch_num_cpus(), MAX_THREADS);
+
+	for (int i = 0; i < num; i++) {
+		success[i] = false;
+		run_on_cpu(i, i, alloc_free_blocks, NULL);
+	}
+
+	for (int i = 0; i < num; i++) {
+		zassert_ok(k_thread_join(&tdata[i], K_FOREVER));
+		zassert_true(success[i], "thread %d failed", i);
+	}
+
+	zassert_equal(k_mem_slab_num_used_get(&smp_slab), 0, "%u blocks still used",
+		      k_mem_slab_num_used_get(&smp_slab));
+	zassert_true(k_mem_slab_max_used_get(&smp_slab) <= SLAB_BLOCKS, "%u blocks used at most",
+		     k_mem_slab_max_used_get(&smp_slab));
+	zassert_true(k_mem_slab_max_used_get(&smp_slab) >= BLK_NUM, "%u blocks used at most",
+		     k_mem_slab_max_used_get(&smp_slab));
+}
+
+/**
+ * @brief Verify a waiting thread gets the block freed on another CPU
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_smp, test_mslab_smp_waiter_woken)
+{
+	k_timeout_t timeout = K_FOREVER;
+	void *blocks[SLAB_BLOCKS];
+
+	alloc_all(blocks);
+
+	waiter_block = NULL;
+	waiter_result = -EINVAL;
+	run_on_cpu(0, 0, alloc_waiter, &timeout);
+
+	/* Let the waiter pend */
+	k_msleep(50);
+	zassert_equal(waiter_result, -EINVAL, "waiter did not pend");
+	zassert_equal(slab_waiters_flagged(), IS_ENABLED(CONFIG_MEM_SLAB_LOCKLESS),
+		      "waiter not flagged");
+
+	run_on_cpu(1, 1, free_block, blocks[0]);
+	zassert_ok(k_thread_join(&tdata[1], K_FOREVER));
+
+	zassert_ok(k_thread_join(&tdata[0], K_MSEC(1000)), "waiter not woken");
+	zassert_ok(waiter_result, "waiter failed to allocate");
+	zassert_equal(waiter_block, blocks[0], "waiter did not get the freed block");
+	zassert_false(slab_waiters_flagged(), "waiter still flagged");
+	zassert_equal(k_mem_slab_num_used_get(&smp_slab), SLAB_BLOCKS, "%u blocks used",
+		      k_mem_slab_num_used_get(&smp_slab));
+
+	free_all(blocks, SLAB_BLOCKS);
+	zassert_equal(k_mem_slab_num_used_get(&smp_slab), 0, "%u blocks still used",
+		      k_mem_slab_num_used_get(&smp_slab));
+}
+
+/**
+ * @brief Verify a free after a waiter timed out
+ *
+ * @details The waiter leaves the slab flagged as having waiters when it
+ * times out. The next free from another CPU must clear the flag and put
+ * the block back on the free list.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_smp, test_mslab_smp_waiter_timeout)
+{
+	k_timeout_t timeout = K_MSEC(50);
+	void *blocks[SLAB_BLOCKS];
+	void *block;
+
+	alloc_all(blocks);
+
+	waiter_result = 0;
+	run_on_cpu(0, 0, alloc_waiter, &timeout);
+	zassert_ok(k_thread_join(&tdata[0], K_FOREVER));
+	zassert_equal(waiter_result, -EAGAIN, "waiter did not time out");
+	zassert_equal(slab_waiters_flagged(), IS_ENABLED(CONFIG_MEM_SLAB_LOCKLESS),
+		      "timed out waiter not flagged");
+
+	run_on_cpu(1, 1, free_block, blocks[0]);
+	zassert_ok(k_thread_join(&tdata[1], K_FOREVER));
+
+	zassert_false(slab_waiters_flagged(), "flag not cleared by the free");
+	zassert_equal(k_mem_slab_num_used_get(&smp_slab), SLAB_BLOCKS - 1, "%u blocks used",
+		      k_mem_slab_num_used_get(&smp_slab));
+
+	zassert_ok(k_mem_slab_alloc(&smp_slab, &block, K_NO_WAIT), "freed block lost");
+	zassert_equal(block, blocks[0], "freed block not back on the list");
+
+	free_all(blocks, SLAB_BLOCKS);
+}
+
+static bool mslab_smp_predicate(const void *state)
+{
+	ARG_UNUSED(state);
+
+	return arch_num_cpus() > 1;
+}
+
+ZTEST_SUITE(mslab_smp, mslab_smp_predicate, NULL, NULL, NULL, NULL);
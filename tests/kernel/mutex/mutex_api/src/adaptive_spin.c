@@ -0,0 +1,149 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test adaptive spinning on a mutex owned by a running thread
+ *
+ * A low priority owner holds the mutex while a higher priority contender,
+ * on the other CPU, tries to lock it. The contender pending on the mutex
+ * is seen by the owner as a boost of its priority, by priority
+ * inheritance, so the owner tells whether the contender spun or pended.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define STACKSIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define OWNER_PRIO     K_PRIO_PREEMPT(10)
+#define CONTENDER_PRIO K_PRIO_PREEMPT(5)
+
+/* Short holds, well within the spin budget */
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+#define SHORT_HOLD_US (CONFIG_MUTEX_ADAPTIVE_SPIN_US / 4)
+#else
+#define SHORT_HOLD_US 0
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+#define SHORT_HOLDS 10
+
+static K_MUTEX_DEFINE(spin_mutex);
+static K_SEM_DEFINE(owner_locked, 0, 1);
+static atomic_t contender_locking;
+
+static K_THREAD_STACK_DEFINE(owner_stack, STACKSIZE);
+static K_THREAD_STACK_DEFINE(contender_stack, STACKSIZE);
+static struct k_thread owner_thread;
+static struct k_thread contender_thread;
+
+enum hold {
+	HOLD_SHORT,
+	HOLD_LONG,
+	HOLD_SLEEPING,
+};
+
+static bool owner_boosted(void)
+{
+	return k_thread_priority_get(k_current_get()) != OWNER_PRIO;
+}
+
+static void owner(void *p1, void *p2, void *p3)
+{
+	enum hold hold = POINTER_TO_INT(p1);
+	bool *pended = p2;
+	uint32_t start;
+
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+	k_sem_give(&owner_locked);
+
+	if (hold == HOLD_SLEEPING) {
+		k_msleep(20);
+		*pended = owner_boosted();
+	} else {
+		while (!atomic_get(&contender_locking)) {
+			arch_spin_relax();
+		}
+
+		start = k_cycle_get_32();
+		while (k_cyc_to_us_floor32(k_cycle_get_32() - start) <
+		       ((hold == HOLD_SHORT) ? SHORT_HOLD_US : 10 * USEC_PER_MSEC)) {
+			*pended = *pended || owner_boosted();
+		}
+	}
+
+	zassert_ok(k_mutex_unlock(&spin_mutex));
+}
+
+static void contender(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_ok(k_sem_take(&owner_locked, K_FOREVER));
+	atomic_set(&contender_locking, 1);
+
+	zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+	zassert_ok(k_mutex_unlock(&spin_mutex));
+}
+
+/* Returns whether the contender pended on the mutex */
+static bool contend(enum hold hold)
+{
+	bool pended = false;
+
+	atomic_set(&contender_locking, 0);
+
+	k_thread_create(&owner_thread, owner_stack, K_THREAD_STACK_SIZEOF(owner_stack), owner,
+			INT_TO_POINTER(hold), &pended, NULL, OWNER_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&contender_thread, contender_stack,
+			K_THREAD_STACK_SIZEOF(contender_stack), contender, NULL, NULL, NULL,
+			CONTENDER_PRIO, 0, K_NO_WAIT);
+
+	zassert_ok(k_thread_join(&contender_thread, K_SECONDS(1)));
+	zassert_ok(k_thread_join(&owner_thread, K_SECONDS(1)));
+
+	return pended;
+}
+
+static bool adaptive_spin_predicate(const void *state)
+{
+	ARG_UNUSED(state);
+
+	return IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) && (arch_num_cpus() > 1);
+}
+
+/* A mutex held briefly by a running owner is taken without pending */
+ZTEST(mutex_adaptive_spin, test_spin_short_hold)
+{
+	int spun = 0;
+
+	for (int i = 0; i < SHORT_HOLDS; i++) {
+		if (!contend(HOLD_SHORT)) {
+			spun++;
+		}
+	}
+
+	/* The owner may be preempted by the host on emulated targets */
+	zassert_true(spun > (SHORT_HOLDS / 2), "Contender pended %d times out of %d",
+		     SHORT_HOLDS - spun, SHORT_HOLDS);
+}
+
+/* The spin is bounded, the contender ends up pending on a long hold */
+ZTEST(mutex_adaptive_spin, test_spin_budget)
+{
+	zassert_true(contend(HOLD_LONG), "Contender did not pend");
+}
+
+/* An owner that is not running is not spun on */
+ZTEST(mutex_adaptive_spin, test_no_spin_on_sleeping_owner)
+{
+	zassert_true(contend(HOLD_SLEEPING), "Contender did not pend");
+}
+
+ZTEST_SUITE(mutex_adaptive_spin, adaptive_spin_predicate, NULL, NULL, NULL, NULL);
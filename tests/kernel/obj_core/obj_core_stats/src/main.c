@@ -693,6 +693,85 @@ ZTEST(obj_core_stats_mem_slab, test_obj_core_stats_mem_slab)
 	k_mem_slab_free(&mem_slab, mem2);
 }
 
+/***************** WAIT STATISTICS *********************/
+
+#ifdef CONFIG_OBJ_CORE_STATS_SEM
+K_SEM_DEFINE(stats_sem, 0, 2);
+
+ZTEST(obj_core_stats_wait, test_obj_core_stats_sem)
+{
+	struct k_obj_wait_stats stats;
+	int  status;
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&stats_sem));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	/* Neither an immediate failure nor a timeout complete the take */
+
+	zassert_equal(k_sem_take(&stats_sem, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_sem_take(&stats_sem, K_MSEC(2)), -EAGAIN);
+
+	k_sem_give(&stats_sem);
+	k_sem_give(&stats_sem);
+	zassert_equal(k_sem_take(&stats_sem, K_NO_WAIT), 0);
+
+	status = k_obj_core_stats_query(K_OBJ_CORE(&stats_sem), &stats,
+					sizeof(stats));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	zassert_equal(stats.unavailable, 2, "Expected 2, got %u", stats.unavailable);
+	zassert_equal(stats.pended, 1, "Expected 1, got %u", stats.pended);
+	zassert_equal(stats.timeouts, 1, "Expected 1, got %u", stats.timeouts);
+	zassert_equal(stats.waiting, 0, "Expected 0, got %u", stats.waiting);
+	zassert_equal(stats.max_waiting, 1, "Expected 1, got %u", stats.max_waiting);
+	zassert_true(stats.max_wait > 0, "No wait time recorded");
+	zassert_equal(stats.total_wait, stats.max_wait);
+	zassert_equal(stats.max_level, 2, "Expected 2, got %u", stats.max_level);
+
+	/* The maximum level restarts from the current count */
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&stats_sem));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	status = k_obj_core_stats_raw(K_OBJ_CORE(&stats_sem), &stats,
+				      sizeof(stats));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+	zassert_equal(stats.unavailable, 0, "Expected 0, got %u", stats.unavailable);
+	zassert_equal(stats.max_level, 1, "Expected 1, got %u", stats.max_level);
+
+	k_sem_reset(&stats_sem);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_SEM */
+
+#ifdef CONFIG_OBJ_CORE_STATS_MSGQ
+K_MSGQ_DEFINE(stats_msgq, sizeof(uint32_t), 2, 4);
+
+ZTEST(obj_core_stats_wait, test_obj_core_stats_msgq)
+{
+	struct k_obj_wait_stats stats;
+	uint32_t msg = 0;
+	int  status;
+
+	status = k_obj_core_stats_reset(K_OBJ_CORE(&stats_msgq));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	zassert_equal(k_msgq_put(&stats_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put(&stats_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_put(&stats_msgq, &msg, K_MSEC(2)), -EAGAIN);
+	k_msgq_purge(&stats_msgq);
+	zassert_equal(k_msgq_get(&stats_msgq, &msg, K_NO_WAIT), -ENOMSG);
+
+	status = k_obj_core_stats_query(K_OBJ_CORE(&stats_msgq), &stats,
+					sizeof(stats));
+	zassert_equal(status, 0, "Expected 0, got %d\n", status);
+
+	zassert_equal(stats.unavailable, 2, "Expected 2, got %u", stats.unavailable);
+	zassert_equal(stats.pended, 1, "Expected 1, got %u", stats.pended);
+	zassert_equal(stats.timeouts, 1, "Expected 1, got %u", stats.timeouts);
+	zassert_equal(stats.max_level, 2, "Expected 2, got %u", stats.max_level);
+}
+#endif /* CONFIG_OBJ_CORE_STATS_MSGQ */
+
 ZTEST_SUITE(obj_core_stats_system, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
 
@@ -704,3 +783,6 @@ ZTEST_SUITE(obj_core_stats_mem_block, NULL, NULL,
 
 ZTEST_SUITE(obj_core_stats_mem_slab, NULL, NULL,
 	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
+
+ZTEST_SUITE(obj_core_stats_wait, NULL, NULL,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -755,6 +755,66 @@ ZTEST(poll_api, test_poll_multi)
 	k_thread_abort(tid2);
 }
 
+static struct k_poll_signal multi_signal =
+	K_POLL_SIGNAL_INITIALIZER(multi_signal);
+static K_SEM_DEFINE(multi_signal_reply, 0, 2);
+
+static void multi_signal_poller(void *p1, void *p2, void *p3)
+{
+	(void)p1; (void)p2; (void)p3;
+
+	struct k_poll_event event;
+	int rc;
+
+	k_poll_event_init(&event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &multi_signal);
+
+	rc = k_poll(&event, 1, K_FOREVER);
+	zassert_equal(rc, 0, "");
+	zassert_equal(event.state, K_POLL_STATE_SIGNALED, "");
+	k_sem_give(&multi_signal_reply);
+}
+
+/**
+ * @brief Test signaling of multiple pollers at once
+ *
+ * @details
+ * - Two threads poll the same signal, which is raised once: both must
+ * be woken up by that single k_poll_signal_raise().
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll(), k_poll_signal_raise()
+ */
+ZTEST(poll_api, test_poll_signal_multi)
+{
+	const int poller_prio = k_thread_priority_get(k_current_get()) - 1;
+	int rc;
+
+	k_tid_t tid1 = k_thread_create(&test_thread, test_stack,
+			K_THREAD_STACK_SIZEOF(test_stack),
+			multi_signal_poller, 0, 0, 0, poller_prio,
+			0, K_NO_WAIT);
+	k_tid_t tid2 = k_thread_create(&test_loprio_thread, test_loprio_stack,
+			K_THREAD_STACK_SIZEOF(test_loprio_stack),
+			multi_signal_poller, 0, 0, 0, poller_prio,
+			0, K_NO_WAIT);
+
+	/* Let both threads start polling */
+	k_sleep(K_MSEC(50));
+
+	k_poll_signal_raise(&multi_signal, SIGNAL_RESULT);
+
+	rc = k_sem_take(&multi_signal_reply, K_SECONDS(1));
+	zassert_equal(rc, 0, "first poller not woken");
+	rc = k_sem_take(&multi_signal_reply, K_SECONDS(1));
+	zassert_equal(rc, 0, "second poller not woken");
+
+	k_thread_join(tid1, K_FOREVER);
+	k_thread_join(tid2, K_FOREVER);
+	k_poll_signal_reset(&multi_signal);
+}
+
 static struct k_poll_signal signal;
 
 static void threadstate(void *p1, void *p2, void *p3)
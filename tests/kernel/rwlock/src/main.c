@@ -0,0 +1,229 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS 4
+#define STRESS_LOOPS 200
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static K_RWLOCK_DEFINE(rwlock);
+
+static int results[NUM_THREADS];
+static atomic_t readers_in;
+static volatile int writers_in;
+static volatile bool violation;
+
+static void start(int i, k_thread_entry_t entry, int prio)
+{
+	k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+			INT_TO_POINTER(i), NULL, NULL, prio, 0, K_NO_WAIT);
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	results[i] = k_rwlock_read_lock(&rwlock, K_FOREVER);
+	if (results[i] == 0) {
+		atomic_inc(&readers_in);
+	}
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	results[i] = k_rwlock_write_lock(&rwlock, K_FOREVER);
+	if (results[i] == 0) {
+		writers_in++;
+		(void)k_rwlock_write_unlock(&rwlock);
+	}
+}
+
+static void timed_reader(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	results[i] = k_rwlock_read_lock(&rwlock, K_MSEC(50));
+	if (results[i] == 0) {
+		(void)k_rwlock_read_unlock(&rwlock);
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(k_rwlock_init(&rwlock));
+	atomic_set(&readers_in, 0);
+	writers_in = 0;
+	violation = false;
+	memset(results, 0, sizeof(results));
+}
+
+/**
+ * @brief Test that readers share the lock and a writer excludes everyone
+ */
+ZTEST(rwlock, test_rwlock_trylock)
+{
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_writer_get(&rwlock), k_current_get());
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	zassert_is_null(k_rwlock_writer_get(&rwlock));
+
+	/* Nothing should be left behind by the failed attempts */
+	zassert_equal(atomic_get(&rwlock.state), 0);
+}
+
+/**
+ * @brief Test the unlock error paths
+ */
+ZTEST(rwlock, test_rwlock_unlock_errors)
+{
+	zassert_equal(k_rwlock_read_unlock(&rwlock), -EINVAL);
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM);
+
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_unlock(&rwlock), -EPERM);
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+}
+
+/**
+ * @brief Test that a waiting writer holds back new readers
+ */
+ZTEST(rwlock, test_rwlock_writer_preference)
+{
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	zassert_ok(k_rwlock_read_lock(&rwlock, K_FOREVER));
+
+	/* Higher priority, so it runs and pends right away */
+	start(0, writer, prio);
+	zassert_equal(writers_in, 0);
+
+	zassert_equal(k_rwlock_read_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	start(1, reader, prio);
+	zassert_equal(atomic_get(&readers_in), 0, "reader overtook a waiting writer");
+
+	/* The writer gets in, then lets the queued reader in */
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	k_thread_join(&threads[0], K_FOREVER);
+	k_thread_join(&threads[1], K_FOREVER);
+	zassert_ok(results[0]);
+	zassert_ok(results[1]);
+	zassert_equal(writers_in, 1);
+	zassert_equal(atomic_get(&readers_in), 1);
+
+	/* The reader thread exited holding its read lock */
+	zassert_equal(k_rwlock_write_lock(&rwlock, K_NO_WAIT), -EBUSY);
+	zassert_ok(k_rwlock_read_unlock(&rwlock));
+	zassert_equal(atomic_get(&rwlock.state), 0);
+}
+
+/**
+ * @brief Test that a writer releasing the lock wakes all waiting readers
+ */
+ZTEST(rwlock, test_rwlock_wake_readers)
+{
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		start(i, reader, prio);
+	}
+	zassert_equal(atomic_get(&readers_in), 0);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		zassert_ok(results[i]);
+	}
+	zassert_equal(atomic_get(&readers_in), NUM_THREADS);
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		zassert_ok(k_rwlock_read_unlock(&rwlock));
+	}
+	zassert_equal(atomic_get(&rwlock.state), 0);
+}
+
+/**
+ * @brief Test timing out while waiting for the lock
+ */
+ZTEST(rwlock, test_rwlock_timeout)
+{
+	int prio = k_thread_priority_get(k_current_get()) - 1;
+
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+
+	start(0, timed_reader, prio);
+	k_thread_join(&threads[0], K_FOREVER);
+	zassert_equal(results[0], -EAGAIN);
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	zassert_equal(atomic_get(&rwlock.state), 0);
+}
+
+static void stress(void *p1, void *p2, void *p3)
+{
+	int i = POINTER_TO_INT(p1);
+
+	for (int n = 0; n < STRESS_LOOPS; n++) {
+		if (((n + i) % 4) == 0) {
+			zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+			if ((writers_in++ != 0) || (atomic_get(&readers_in) != 0)) {
+				violation = true;
+			}
+			k_busy_wait(10);
+			writers_in--;
+			zassert_ok(k_rwlock_write_unlock(&rwlock));
+		} else {
+			zassert_ok(k_rwlock_read_lock(&rwlock, K_FOREVER));
+			atomic_inc(&readers_in);
+			if (writers_in != 0) {
+				violation = true;
+			}
+			k_busy_wait(10);
+			atomic_dec(&readers_in);
+			zassert_ok(k_rwlock_read_unlock(&rwlock));
+		}
+		if ((n % 16) == 0) {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Test mutual exclusion with readers and writers contending
+ */
+ZTEST(rwlock, test_rwlock_stress)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	for (int i = 0; i < NUM_THREADS; i++) {
+		start(i, stress, prio);
+	}
+	for (int i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	zassert_false(violation, "readers and writers overlapped");
+	zassert_equal(atomic_get(&rwlock.state), 0);
+}
+
+ZTEST_SUITE(rwlock, NULL, NULL, before, NULL, NULL);
@@ -9,6 +9,7 @@
 #include <zephyr/kernel.h>
 #include <ksched.h>
 #include <zephyr/kernel_structs.h>
+#include <zephyr/sys/percpu.h>
 
 #if CONFIG_MP_MAX_NUM_CPUS < 2
 #error SMP test requires at least two CPUs!
@@ -675,6 +676,57 @@ ZTEST(smp, test_get_cpu)
 	k_thread_join(thread_id, K_FOREVER);
 }
 
+PERCPU_DEFINE_STATIC(uint32_t, percpu_counter);
+
+static void thread_percpu_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int key = arch_irq_lock();
+
+	*PERCPU_GET(percpu_counter) += 1;
+	arch_irq_unlock(key);
+}
+
+/**
+ * @brief Test per-CPU variables
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Check that the copies of each CPU, as well as the CPU
+ * structures, are on separate cache lines, then count one increment per
+ * thread across all copies.
+ *
+ * @see PERCPU_GET()
+ */
+ZTEST(smp, test_percpu)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t sum = 0;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		zassert_equal((uintptr_t)PERCPU_PTR(percpu_counter, i) % PERCPU_ALIGN, 0,
+			      "copy of CPU %u misaligned", i);
+		zassert_equal((uintptr_t)&_kernel.cpus[i] % PERCPU_ALIGN, 0,
+			      "struct _cpu %u misaligned", i);
+	}
+	zassert_true((uintptr_t)PERCPU_PTR(percpu_counter, 1) -
+		     (uintptr_t)PERCPU_PTR(percpu_counter, 0) >= CONFIG_SMP_CACHE_LINE_SIZE,
+		     "copies share a cache line");
+
+	for (int i = 0; i < num_cpus; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				thread_percpu_entry, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+	for (int i = 0; i < num_cpus; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		sum += *PERCPU_PTR(percpu_counter, i);
+	}
+	zassert_equal(sum, num_cpus, "lost per-CPU updates");
+}
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 /* global variable for testing send IPI */
 static volatile int sched_ipi_has_called;
@@ -1217,6 +1269,103 @@ ZTEST(smp, test_smp_affinity)
 }
 #endif
 
+#if defined(CONFIG_TIMEOUT_PER_CPU) && defined(CONFIG_SCHED_CPU_MASK)
+static struct k_timer cpu_timers[MAX_NUM_THREADS];
+static volatile int timer_cpu[MAX_NUM_THREADS];
+
+static void cpu_timer_expiry(struct k_timer *timer)
+{
+	timer_cpu[ARRAY_INDEX(cpu_timers, timer)] = curr_cpu();
+}
+
+static void start_cpu_timer(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	int i = POINTER_TO_INT(arg0);
+
+	k_timer_start(&cpu_timers[i], K_MSEC(10 + i), K_NO_WAIT);
+	k_timer_status_sync(&cpu_timers[i]);
+}
+
+/**
+ * @brief Test that per-CPU timeouts expire on the arming CPU
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Arm a timer from a thread pinned to each CPU and check that
+ *          every expiry callback runs on the CPU that armed it.
+ */
+ZTEST(smp, test_smp_timeout_per_cpu)
+{
+	int num_threads = arch_num_cpus();
+
+	for (int i = 0; i < num_threads; ++i) {
+		timer_cpu[i] = -1;
+		k_timer_init(&cpu_timers[i], cpu_timer_expiry, NULL);
+		k_thread_create(&tthread[i], tstack[i],
+				STACK_SIZE, start_cpu_timer,
+				INT_TO_POINTER(i), NULL, NULL,
+				0, 0, K_FOREVER);
+
+		k_thread_cpu_pin(&tthread[i], i);
+		k_thread_start(&tthread[i]);
+	}
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+		zassert_equal(timer_cpu[i], i, "timer %d expired on CPU %d", i,
+			      timer_cpu[i]);
+	}
+}
+#endif
+
+static volatile bool async_abort_running;
+
+static void async_abort_spin(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	async_abort_running = true;
+	while (true) {
+		arch_spin_relax();
+	}
+}
+
+/**
+ * @brief Test aborting a thread running on another CPU asynchronously
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Start a cooperative thread spinning on another CPU, abort it
+ *          without waiting and check that joining it then completes.
+ */
+ZTEST(smp, test_smp_abort_async)
+{
+	int ret;
+
+	async_abort_running = false;
+	k_thread_create(&t2, t2_stack, T2_STACK_SIZE, async_abort_spin,
+			NULL, NULL, NULL, K_PRIO_COOP(2), 0, K_NO_WAIT);
+
+	while (!async_abort_running) {
+		k_busy_wait(10);
+	}
+
+	ret = k_thread_abort_async(&t2);
+	zassert_true((ret == 0) || (ret == -EINPROGRESS),
+		     "unexpected return %d", ret);
+
+	ret = k_thread_join(&t2, K_MSEC(TIMEOUT));
+	zassert_ok(ret, "aborted thread didn't finish");
+
+	/* Aborting a dead thread completes right away */
+	zassert_ok(k_thread_abort_async(&t2));
+}
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
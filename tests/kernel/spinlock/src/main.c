@@ -143,6 +143,55 @@ ZTEST(spinlock, test_spinlock_bounce)
 	k_thread_join(&cpu1_thread, K_FOREVER);
 }
 
+#ifdef CONFIG_SPINLOCK_STATS
+/**
+ * @brief Test spinlock contention statistics
+ *
+ * @ingroup kernel_spinlock_tests
+ *
+ * Bounce a lock between two CPUs and check that the contention on it is
+ * recorded and attributed to a call site.
+ *
+ * @see k_spinlock_stats_get(), k_spinlock_stats_top()
+ */
+ZTEST(spinlock, test_spinlock_stats)
+{
+	static struct k_spinlock unused_lock;
+	static struct k_spinlock_stats stats, top;
+	int i;
+
+	k_spinlock_stats_reset();
+
+	k_thread_create(&cpu1_thread, cpu1_stack, CPU1_STACK_SIZE,
+			cpu1_fn, NULL, NULL, NULL,
+			0, 0, K_NO_WAIT);
+
+	k_busy_wait(10);
+
+	for (i = 0; i < 10000; i++) {
+		bounce_once(1234, false);
+	}
+
+	bounce_done = 1;
+
+	k_thread_join(&cpu1_thread, K_FOREVER);
+
+	zassert_equal(k_spinlock_stats_get(&bounce_lock, &stats), 0);
+	zassert_equal(stats.lock, &bounce_lock);
+	zassert_true(stats.count >= 10000, "acquisitions not counted");
+	zassert_true(stats.contended > 0, "contention not recorded");
+	zassert_true(stats.spins >= stats.contended);
+	zassert_true(stats.max_hold > 0, "hold time not recorded");
+	zassert_not_equal(stats.sites[0].addr, 0, "call site not recorded");
+
+	zassert_equal(k_spinlock_stats_top(&top, 1), 1);
+	zassert_true(top.spins >= stats.spins, "top spinlock not sorted first");
+
+	zassert_equal(k_spinlock_stats_get(&unused_lock, &stats), -ENOENT);
+	zassert_equal(k_spinlock_stats_get(NULL, &stats), -EINVAL);
+}
+#endif /* CONFIG_SPINLOCK_STATS */
+
 /**
  * @brief Test basic mutual exclusion using interrupt masking
  *
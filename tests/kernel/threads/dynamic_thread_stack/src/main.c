@@ -168,6 +168,48 @@ ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_alloc)
 	}
 }
 
+static k_thread_stack_t *cached_stack;
+static k_thread_stack_t *recycled_stack;
+
+static void stack_cache_func(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	cached_stack = k_thread_stack_alloc(CONFIG_DYNAMIC_THREAD_STACK_SIZE, 0);
+	zassert_not_null(cached_stack);
+	zassert_ok(k_thread_stack_free(cached_stack));
+
+	/* A smaller request of the same size class gets the same stack */
+	recycled_stack = k_thread_stack_alloc(CONFIG_DYNAMIC_THREAD_STACK_SIZE / 2, 0);
+}
+
+/** @brief Check that freed heap stacks are recycled by the stack cache */
+ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_cache)
+{
+	static K_THREAD_STACK_DEFINE(stack_cache_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+	static struct k_thread stack_cache_thread;
+
+	if (!IS_ENABLED(CONFIG_DYNAMIC_THREAD_STACK_CACHE) ||
+	    !IS_ENABLED(CONFIG_DYNAMIC_THREAD_PREFER_ALLOC)) {
+		ztest_test_skip();
+	}
+
+	/* Stay on one CPU, magazines are per CPU */
+	k_thread_create(&stack_cache_thread, stack_cache_stack,
+			K_THREAD_STACK_SIZEOF(stack_cache_stack), stack_cache_func, NULL, NULL,
+			NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+	zassert_ok(k_thread_cpu_pin(&stack_cache_thread, 0));
+#endif
+	k_thread_start(&stack_cache_thread);
+	zassert_ok(k_thread_join(&stack_cache_thread, K_FOREVER));
+
+	zassert_equal_ptr(recycled_stack, cached_stack, "stack not served from the cache");
+	zassert_ok(k_thread_stack_free(recycled_stack));
+}
+
 K_SEM_DEFINE(perm_sem, 0, 1);
 ZTEST_BMEM static volatile bool expect_fault;
 ZTEST_BMEM static volatile unsigned int expected_reason;
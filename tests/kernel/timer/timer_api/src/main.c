@@ -63,8 +63,25 @@ static struct k_timer periodicity_timer;
 static struct k_timer status_timer;
 static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
+static struct k_timer slack_timer;
 static struct k_timer remain_timer;
 
+/* Expiries in ticks, on both sides of the 32 and 1024 tick boundaries of the
+ * timeout wheel levels, in order. Two timers share an expiry.
+ */
+static const uint16_t order_ticks[] = {
+	1, 31, 32, 32, 33, 63, 64, 300, 1023, 1024, 1025, 1100,
+};
+#define ORDER_TIMERS ARRAY_SIZE(order_ticks)
+/* Started first to last, the shared expiry in order */
+static const uint8_t order_start[ORDER_TIMERS] = { 7, 2, 10, 0, 3, 11, 5, 1, 9, 4, 8, 6 };
+/* Stopped while pending in an upper level */
+#define ORDER_STOPPED 9
+static struct k_timer order_timers[ORDER_TIMERS];
+static ZTEST_BMEM int64_t order_expired_at[ORDER_TIMERS];
+static ZTEST_BMEM int order_position[ORDER_TIMERS];
+static ZTEST_BMEM int order_count;
+
 static ZTEST_BMEM struct timer_data tdata;
 
 #define TIMER_ASSERT(exp, tmr)			 \
@@ -847,6 +864,118 @@ ZTEST_USER(timer_api, test_sleep_abs)
 
 }
 
+/**
+ * @brief Test that a timer with slack shares the wakeup of a later timeout
+ *
+ * @details Start a timer with a generous slack and busy wait past its
+ * expiry: with nothing else scheduled the timer must not have fired yet.
+ * A sleep ending inside the slack window then expires it as well.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start_slack()
+ */
+ZTEST_USER(timer_api, test_timer_slack)
+{
+	if (!IS_ENABLED(CONFIG_TIMEOUT_SLACK) || !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		ztest_test_skip();
+	}
+
+	const int expiry_ticks = 10;
+	const int slack_ticks = 40;
+
+	k_usleep(1); /* tick align */
+
+	k_timer_start_slack(&slack_timer, K_TICKS(expiry_ticks), K_NO_WAIT,
+			    K_TICKS(slack_ticks));
+
+	k_busy_wait(k_ticks_to_us_ceil32(2 * expiry_ticks));
+	TIMER_ASSERT(k_timer_status_get(&slack_timer) == 0, &slack_timer);
+
+	k_sleep(K_TICKS(expiry_ticks));
+	TIMER_ASSERT(k_timer_status_get(&slack_timer) == 1, &slack_timer);
+
+	k_timer_stop(&slack_timer);
+}
+
+static void order_expire(struct k_timer *timer)
+{
+	size_t i = ARRAY_INDEX(order_timers, timer);
+
+	order_expired_at[i] = k_uptime_ticks();
+	order_position[i] = order_count++;
+}
+
+static void wait_until_tick(int64_t tick)
+{
+	while (k_uptime_ticks() < tick) {
+		if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+			k_sleep(K_TICKS(tick - k_uptime_ticks()));
+		} else {
+			k_busy_wait(k_ticks_to_us_ceil32(1));
+		}
+	}
+}
+
+/**
+ * @brief Test that timers expire on time and in order
+ *
+ * @details Start timers with absolute expiries spread over several timeout
+ * wheel levels and beyond the top one of small wheels, in mixed order. Each
+ * timer must expire on its tick, timers sharing an expiry in the order they
+ * were started, and a timer stopped before its expiry must not expire.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_stop()
+ */
+ZTEST_USER(timer_api, test_timer_expiry_order)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	int slop = MAX(2, k_us_to_ticks_ceil32(250));
+	int64_t base;
+	int position = 0;
+
+	order_count = 0;
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+		k_usleep(1); /* tick align */
+	}
+
+	base = k_uptime_ticks();
+
+	for (size_t i = 0; i < ORDER_TIMERS; i++) {
+		size_t t = order_start[i];
+
+		k_timer_start(&order_timers[t], K_TIMEOUT_ABS_TICKS(base + order_ticks[t]),
+			      K_NO_WAIT);
+	}
+
+	wait_until_tick(base + order_ticks[ORDER_STOPPED] / 2);
+	k_timer_stop(&order_timers[ORDER_STOPPED]);
+
+	wait_until_tick(base + order_ticks[ORDER_TIMERS - 1] + slop);
+
+	for (size_t i = 0; i < ORDER_TIMERS; i++) {
+		if (i == ORDER_STOPPED) {
+			zassert_equal(k_timer_status_get(&order_timers[i]), 0,
+				      "Stopped timer expired");
+			continue;
+		}
+
+		int64_t late = order_expired_at[i] - (base + order_ticks[i]);
+
+		zassert_equal(k_timer_status_get(&order_timers[i]), 1,
+			      "Timer %zu did not expire", i);
+		zassert_true((late >= 0) && (late <= slop),
+			     "Timer %zu expired %lld ticks late", i, (long long)late);
+		zassert_equal(order_position[i], position,
+			      "Timer %zu expired in position %d", i, order_position[i]);
+		position++;
+	}
+#endif /* CONFIG_TIMEOUT_64BIT */
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -868,6 +997,11 @@ void *setup_timer_api(void)
 	timer_init(&status_anytime_timer, NULL, NULL);
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
+	timer_init(&slack_timer, NULL, NULL);
+
+	for (size_t i = 0; i < ORDER_TIMERS; i++) {
+		timer_init(&order_timers[i], order_expire, NULL);
+	}
 
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
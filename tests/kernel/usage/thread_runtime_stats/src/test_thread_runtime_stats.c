@@ -547,5 +547,184 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_LATENCY_STATS
+#define LATENCY_WAKEUPS 10
+
+static K_SEM_DEFINE(latency_sem, 0, 1);
+static volatile int latency_wakeups;
+
+/**
+ * @brief Helper thread to test_sched_latency_stats()
+ */
+void latency_helper(void *p1, void *p2, void *p3)
+{
+	while (1) {
+		k_sem_take(&latency_sem, K_FOREVER);
+		latency_wakeups++;
+	}
+}
+
+/**
+ * @brief Test the scheduler wake-to-run latency statistics
+ *
+ * A higher priority helper is woken repeatedly through a semaphore, each
+ * wakeup must be recorded in the histogram of the helper's priority.
+ */
+ZTEST(usage_api, test_sched_latency_stats)
+{
+	static struct k_sched_latency_stats stats;
+	int  prio = k_thread_priority_get(k_current_get()) - 1;
+	uint32_t  samples = 0;
+	k_tid_t  tid;
+
+	zassert_equal(k_sched_latency_stats_get(0, NULL), -EINVAL);
+	zassert_equal(k_sched_latency_stats_get(arch_num_cpus(), &stats),
+		      -EINVAL);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      latency_helper, NULL, NULL, NULL,
+			      prio, 0, K_NO_WAIT);
+
+	/* Let the helper block on the semaphore */
+
+	k_sleep(K_TICKS(2));
+
+	k_sched_latency_stats_reset();
+	k_sched_latency_stats_get(0, &stats);
+	zassert_equal(stats.count, 0);
+
+	latency_wakeups = 0;
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+	}
+	zassert_equal(latency_wakeups, LATENCY_WAKEUPS);
+
+	k_sched_latency_stats_get(0, &stats);
+	for (int b = 0; b < CONFIG_SCHED_LATENCY_STATS_BUCKETS; b++) {
+		samples += stats.hist[prio - K_HIGHEST_THREAD_PRIO][b];
+	}
+
+	zassert_true(samples >= LATENCY_WAKEUPS, "only %u samples", samples);
+	zassert_true(stats.count >= samples);
+	zassert_true(stats.total >= stats.max);
+
+	k_thread_abort(tid);
+}
+#endif /* CONFIG_SCHED_LATENCY_STATS */
+
+#ifdef CONFIG_THREAD_PERF_COUNTERS
+/**
+ * @brief Helper thread to test_thread_perf_counters()
+ */
+void perf_helper(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_FOREVER);
+}
+
+/**
+ * @brief Test the per thread performance counters
+ *
+ * Cycles counted while the main thread busy loops must be attributed to
+ * it, not to a helper thread which stays blocked.
+ */
+ZTEST(usage_api, test_thread_perf_counters)
+{
+	static struct k_perf_counter_stats sys1, sys2, main1, main2, help1, help2;
+	k_thread_runtime_stats_t  rt_stats;
+	int  prio = k_thread_priority_get(k_current_get()) - 1;
+	k_tid_t  tid;
+	int  ret;
+
+	zassert_equal(k_perf_counter_start(CONFIG_PERF_COUNTERS_NUM,
+					   K_PERF_EVENT_CYCLES), -EINVAL);
+	zassert_equal(k_perf_counter_stats_get(NULL), -EINVAL);
+	zassert_equal(k_thread_perf_counter_stats_get(NULL, &sys1), -EINVAL);
+
+	ret = k_perf_counter_start(0, K_PERF_EVENT_CYCLES);
+	if (ret == -ENOTSUP) {
+		ztest_test_skip();
+	}
+	zassert_equal(ret, 0);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      perf_helper, NULL, NULL, NULL,
+			      prio, 0, K_NO_WAIT);
+
+	/* Let the helper block */
+
+	k_sleep(K_TICKS(2));
+
+	k_perf_counter_stats_get(&sys1);
+	k_thread_perf_counter_stats_get(k_current_get(), &main1);
+	k_thread_perf_counter_stats_get(tid, &help1);
+
+	busy_loop(2);
+
+	k_thread_perf_counter_stats_get(tid, &help2);
+	k_thread_perf_counter_stats_get(k_current_get(), &main2);
+	k_perf_counter_stats_get(&sys2);
+
+	zassert_equal(main2.event[0], K_PERF_EVENT_CYCLES);
+	zassert_true(main2.count[0] > main1.count[0]);
+	zassert_equal(help2.count[0], help1.count[0]);
+	zassert_true(sys2.count[0] - sys1.count[0] >=
+		     main2.count[0] - main1.count[0]);
+
+	k_thread_runtime_stats_get(k_current_get(), &rt_stats);
+	zassert_true(rt_stats.perf_counters[0] >= main2.count[0]);
+
+	zassert_equal(k_perf_counter_stop(0), 0);
+	k_perf_counter_stats_reset();
+	k_thread_perf_counter_stats_get(k_current_get(), &main1);
+	zassert_equal(main1.count[0], 0);
+
+	k_thread_abort(tid);
+}
+#endif /* CONFIG_THREAD_PERF_COUNTERS */
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_WINDOWS
+/**
+ * @brief Test the rolling usage windows and burst percentiles
+ *
+ * Busy loop for more than a second, so that the last full second of the
+ * main thread and of the CPU is busy, then sleep for more than a second
+ * so that it is idle.
+ */
+ZTEST(usage_api, test_thread_usage_windows)
+{
+	k_thread_runtime_stats_t  thread_stats;
+	k_thread_runtime_stats_t  cpu_stats;
+
+	busy_loop(k_ms_to_ticks_ceil32(2100));
+
+	k_thread_runtime_stats_get(k_current_get(), &thread_stats);
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats);
+
+	zassert_true(thread_stats.window_load[0] > 900,
+		     "thread load %u", thread_stats.window_load[0]);
+	zassert_true(cpu_stats.window_load[0] > 900,
+		     "CPU load %u", cpu_stats.window_load[0]);
+	zassert_true(cpu_stats.window_load[1] >= thread_stats.window_load[1]);
+
+	k_sleep(K_MSEC(2100));
+
+	k_thread_runtime_stats_get(k_current_get(), &thread_stats);
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats);
+
+	zassert_true(thread_stats.window_load[0] < 100,
+		     "thread load %u", thread_stats.window_load[0]);
+	zassert_true(cpu_stats.window_load[0] < 100,
+		     "CPU load %u", cpu_stats.window_load[0]);
+
+	/* The busy loop is the longest burst of the main thread */
+	zassert_true(thread_stats.burst_cycles[0] > 0);
+	zassert_true(thread_stats.burst_cycles[0] <= thread_stats.burst_cycles[1]);
+	zassert_true(thread_stats.burst_cycles[1] <= thread_stats.burst_cycles[2]);
+	zassert_true(thread_stats.burst_cycles[2] <= thread_stats.peak_cycles);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_WINDOWS */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
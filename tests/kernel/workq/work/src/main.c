@@ -1442,6 +1442,110 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+#define POOL_WORKERS 2
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, POOL_WORKERS, STACK_SIZE);
+static struct k_thread pool_threads[POOL_WORKERS - 1];
+static struct k_work_q pool_queue;
+static struct k_sem pool_sem;
+static atomic_t pool_active;
+static atomic_t pool_max_active;
+static atomic_t pool_runs;
+
+static void pool_handler(struct k_work *work)
+{
+	atomic_val_t active = atomic_inc(&pool_active) + 1;
+	atomic_val_t max = atomic_get(&pool_max_active);
+
+	while ((active > max) && !atomic_cas(&pool_max_active, max, active)) {
+		max = atomic_get(&pool_max_active);
+	}
+
+	atomic_inc(&pool_runs);
+	k_sem_take(&pool_sem, K_FOREVER);
+	atomic_dec(&pool_active);
+}
+
+static void pool_reset(void)
+{
+	k_sem_init(&pool_sem, 0, K_SEM_MAX_LIMIT);
+	atomic_clear(&pool_active);
+	atomic_clear(&pool_max_active);
+	atomic_clear(&pool_runs);
+
+	if ((pool_queue.flags & K_WORK_QUEUE_STARTED) == 0U) {
+		k_work_queue_init(&pool_queue);
+		k_work_queue_start_pool(&pool_queue, pool_threads,
+					pool_stacks[0], STACK_SIZE,
+					POOL_WORKERS, PREEMPT_PRIORITY, NULL);
+	}
+}
+
+/* Two blocking items on a pool of two workers are handled concurrently. */
+ZTEST(work, test_pool_concurrent)
+{
+	static struct k_work work[POOL_WORKERS];
+	int rc;
+
+	pool_reset();
+
+	for (size_t i = 0; i < ARRAY_SIZE(work); i++) {
+		k_work_init(&work[i], pool_handler);
+		rc = k_work_submit_to_queue(&pool_queue, &work[i]);
+		zassert_equal(rc, 1);
+	}
+
+	k_sleep(K_MSEC(DELAY_MS));
+	zassert_equal(atomic_get(&pool_max_active), POOL_WORKERS);
+	zassert_equal(k_work_busy_get(&work[0]), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&work[1]), K_WORK_RUNNING);
+
+	for (size_t i = 0; i < ARRAY_SIZE(work); i++) {
+		k_sem_give(&pool_sem);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(work); i++) {
+		struct k_work_sync sync;
+
+		k_work_flush(&work[i], &sync);
+		zassert_equal(k_work_busy_get(&work[i]), 0);
+	}
+	zassert_equal(atomic_get(&pool_runs), POOL_WORKERS);
+}
+
+/* An item resubmitted while running is never run on a second worker. */
+ZTEST(work, test_pool_no_reentrancy)
+{
+	static struct k_work work;
+	struct k_work_sync sync;
+	int rc;
+
+	pool_reset();
+	k_work_init(&work, pool_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 1);
+	k_sleep(K_MSEC(DELAY_MS));
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 2);
+	k_sleep(K_MSEC(DELAY_MS));
+
+	/* The idle worker must not pick up the queued item. */
+	zassert_equal(atomic_get(&pool_max_active), 1);
+	zassert_equal(atomic_get(&pool_runs), 1);
+
+	k_sem_give(&pool_sem);
+	k_sem_give(&pool_sem);
+	k_work_flush(&work, &sync);
+
+	zassert_equal(atomic_get(&pool_runs), 2);
+	zassert_equal(atomic_get(&pool_max_active), 1);
+	zassert_equal(k_work_busy_get(&work), 0);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
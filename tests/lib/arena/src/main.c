@@ -0,0 +1,122 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/arena.h>
+
+#define ARENA_SIZE 256
+
+SYS_ARENA_DEFINE(static_arena, ARENA_SIZE);
+K_HEAP_DEFINE(arena_heap, 512);
+
+static uint8_t __aligned(8) unaligned_buf[ARENA_SIZE + 1];
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_arena_reset(&static_arena);
+}
+
+/**
+ * @brief Test allocation alignment and exhaustion
+ */
+ZTEST(lib_arena, test_arena_alloc)
+{
+	uint8_t *p1, *p2, *p3;
+
+	p1 = sys_arena_alloc(&static_arena, 1);
+	p2 = sys_arena_alloc(&static_arena, 3);
+	zassert_not_null(p1);
+	zassert_not_null(p2);
+	zassert_equal((uintptr_t)p2 % SYS_ARENA_ALIGN, 0, "misaligned %p", p2);
+	zassert_equal(p2 - p1, SYS_ARENA_ALIGN);
+
+	p3 = sys_arena_aligned_alloc(&static_arena, 64, 16);
+	zassert_not_null(p3);
+	zassert_equal((uintptr_t)p3 % 64, 0, "misaligned %p", p3);
+
+	zassert_is_null(sys_arena_alloc(&static_arena, 0));
+	zassert_is_null(sys_arena_alloc(&static_arena, ARENA_SIZE));
+	zassert_is_null(sys_arena_alloc(&static_arena, SIZE_MAX));
+
+	/* What is left can still be allocated exactly */
+	p1 = sys_arena_alloc(&static_arena, ARENA_SIZE - sys_arena_used(&static_arena));
+	zassert_not_null(p1);
+	zassert_equal(sys_arena_used(&static_arena), ARENA_SIZE);
+	zassert_is_null(sys_arena_alloc(&static_arena, 1));
+
+	sys_arena_reset(&static_arena);
+	zassert_equal(sys_arena_used(&static_arena), 0);
+	zassert_equal(sys_arena_max_used(&static_arena), ARENA_SIZE);
+}
+
+/**
+ * @brief Test nested checkpoints
+ */
+ZTEST(lib_arena, test_arena_checkpoints)
+{
+	sys_arena_checkpoint_t outer, inner;
+	void *p1, *p2, *p3;
+
+	p1 = sys_arena_alloc(&static_arena, 16);
+	outer = sys_arena_checkpoint(&static_arena);
+
+	p2 = sys_arena_alloc(&static_arena, 16);
+	inner = sys_arena_checkpoint(&static_arena);
+	zassert_not_null(sys_arena_alloc(&static_arena, 16));
+
+	sys_arena_rewind(&static_arena, inner);
+	p3 = sys_arena_alloc(&static_arena, 16);
+	zassert_equal_ptr(p3, (uint8_t *)p2 + 16, "inner rewind did not free");
+
+	sys_arena_rewind(&static_arena, outer);
+	p3 = sys_arena_alloc(&static_arena, 16);
+	zassert_equal_ptr(p3, p2, "outer rewind did not free");
+	zassert_equal_ptr(sys_arena_alloc(&static_arena, 16), (uint8_t *)p1 + 32);
+}
+
+/**
+ * @brief Test arenas over an unaligned buffer
+ */
+ZTEST(lib_arena, test_arena_unaligned)
+{
+	struct sys_arena arena;
+	uint8_t *p;
+
+	sys_arena_init(&arena, &unaligned_buf[1], ARENA_SIZE);
+
+	p = sys_arena_alloc(&arena, 1);
+	zassert_equal_ptr(p, &unaligned_buf[SYS_ARENA_ALIGN]);
+
+	/* The padding counts against the arena size */
+	zassert_is_null(sys_arena_alloc(&arena, ARENA_SIZE - SYS_ARENA_ALIGN));
+	zassert_not_null(sys_arena_alloc(&arena, ARENA_SIZE - 2 * SYS_ARENA_ALIGN + 1));
+}
+
+/**
+ * @brief Test arenas carved from a k_heap
+ */
+ZTEST(lib_arena, test_arena_from_heap)
+{
+	struct sys_arena arena;
+
+	zassert_equal(sys_arena_init_from_heap(&arena, &arena_heap, 1024, K_NO_WAIT),
+		      -ENOMEM);
+
+	zassert_ok(sys_arena_init_from_heap(&arena, &arena_heap, 256, K_NO_WAIT));
+	zassert_not_null(sys_arena_alloc(&arena, 200));
+	zassert_is_null(sys_arena_alloc(&arena, 100));
+
+	/* The memory is back in the heap once released */
+	sys_arena_release(&arena);
+	zassert_is_null(sys_arena_alloc(&arena, 1));
+	zassert_ok(sys_arena_init_from_heap(&arena, &arena_heap, 256, K_NO_WAIT));
+	sys_arena_release(&arena);
+}
+
+ZTEST_SUITE(lib_arena, NULL, NULL, before, NULL, NULL);
@@ -212,6 +212,31 @@ ZTEST(libc_common, test_strlen)
 	zassert_equal(strnlen(buffer, BUFSIZE), 5, "strnlen failed");
 }
 
+/**
+ * @brief Test string length from every alignment, with the terminator at
+ * every offset
+ *
+ * The filling bytes are chosen to trip word at a time zero byte checks.
+ *
+ * @see strlen()
+ */
+ZTEST(libc_common, test_strlen_offsets)
+{
+	static char str[64] __aligned(16);
+	const char fill[] = { 'x', 0x01, (char)0x80, (char)0xff };
+
+	for (size_t f = 0; f < ARRAY_SIZE(fill); f++) {
+		for (size_t start = 0; start < 16; start++) {
+			for (size_t len = 0; start + len < sizeof(str); len++) {
+				(void)memset(str, fill[f], sizeof(str));
+				str[start + len] = '\0';
+				zassert_equal(strlen(&str[start]), len,
+					      "strlen failed from %zu with length %zu", start, len);
+			}
+		}
+	}
+}
+
 /**
  * @brief Test string compare function
  *
@@ -367,6 +392,38 @@ ZTEST(libc_common, test_memcmp)
 	zassert_true((ret != 0), "memcmp 2 block of memory failed");
 }
 
+/**
+ *
+ * @brief Test memory comparison of buffers differing in their last word
+ *
+ * @see memcmp()
+ */
+ZTEST(libc_common, test_memcmp_last_word)
+{
+	static uint8_t m1[40] __aligned(16);
+	static uint8_t m2[40] __aligned(16);
+	const size_t n = 32;
+
+	for (size_t i = 0; i < sizeof(m1); i++) {
+		m1[i] = 'a' + (i % 26);
+	}
+
+	/* Aligned and unaligned starts, with a difference in each of the last bytes */
+	for (size_t start = 0; start < 8; start++) {
+		for (size_t pos = n - 8; pos < n; pos++) {
+			(void)memcpy(m2, m1, sizeof(m2));
+			m2[start + pos]++;
+
+			zassert_true(memcmp(&m1[start], &m2[start], n) < 0,
+				     "memcmp from %zu differing at %zu failed", start, pos);
+			zassert_true(memcmp(&m2[start], &m1[start], n) > 0,
+				     "memcmp from %zu differing at %zu failed", start, pos);
+			zassert_equal(memcmp(&m1[start], &m2[start], pos), 0,
+				      "memcmp from %zu up to %zu failed", start, pos);
+		}
+	}
+}
+
 /**
  *
  * @brief Test binary search function
@@ -0,0 +1,114 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/cpp/coroutine.hpp>
+#include <zephyr/ztest.h>
+
+static zephyr::executor exec;
+
+K_SEM_DEFINE(done, 0, 2);
+K_SEM_DEFINE(sem, 0, 1);
+K_MSGQ_DEFINE(msgq, sizeof(int), 4, 4);
+
+static zephyr::task<int> add_later(int a, int b)
+{
+	co_await zephyr::sleep_for(exec, K_MSEC(10));
+	co_return a + b;
+}
+
+static zephyr::task<> run_add(int *result)
+{
+	*result = co_await add_later(1, 2);
+	*result += co_await add_later(3, 4);
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coroutine, test_task_result)
+{
+	int result = 0;
+
+	zassert_true(zephyr::spawn(exec, run_add(&result)));
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(result, 10);
+}
+
+static zephyr::task<> run_sem_take(int *ret, bool *resumed)
+{
+	*ret = co_await zephyr::sem_take(exec, &sem, K_FOREVER);
+	*resumed = true;
+	*ret |= co_await zephyr::sem_take(exec, &sem, K_MSEC(10)) != -EAGAIN;
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coroutine, test_sem_take)
+{
+	bool resumed = false;
+	int ret = -1;
+
+	zassert_true(zephyr::spawn(exec, run_sem_take(&ret, &resumed)));
+	k_msleep(10);
+	zassert_false(resumed, "resumed before the semaphore was given");
+
+	k_sem_give(&sem);
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_true(resumed);
+	zassert_equal(ret, 0);
+}
+
+static zephyr::task<> run_msgq_get(int *sum)
+{
+	int msg;
+
+	for (int i = 0; i < 3; i++) {
+		if (co_await zephyr::msgq_get(exec, &msgq, &msg, K_SECONDS(1)) == 0) {
+			*sum += msg;
+		}
+	}
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coroutine, test_msgq_get)
+{
+	int sum = 0;
+
+	zassert_true(zephyr::spawn(exec, run_msgq_get(&sum)));
+
+	for (int i = 1; i <= 3; i++) {
+		k_msleep(1);
+		zassert_ok(k_msgq_put(&msgq, &i, K_NO_WAIT));
+	}
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_equal(sum, 6);
+}
+
+static zephyr::task<> run_yield(int id, int *order, int *n)
+{
+	for (int i = 0; i < 2; i++) {
+		order[(*n)++] = id;
+		co_await exec.schedule();
+	}
+	k_sem_give(&done);
+}
+
+ZTEST(cpp_coroutine, test_schedule)
+{
+	int order[4];
+	int n = 0;
+
+	zassert_true(zephyr::spawn(exec, run_yield(1, order, &n)));
+	zassert_true(zephyr::spawn(exec, run_yield(2, order, &n)));
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+	zassert_ok(k_sem_take(&done, K_SECONDS(1)));
+
+	/* Yielding lets the other coroutine run */
+	zassert_equal(n, 4);
+	zassert_equal(order[0], 1);
+	zassert_equal(order[1], 2);
+	zassert_equal(order[2], 1);
+	zassert_equal(order[3], 2);
+}
+
+ZTEST_SUITE(cpp_coroutine, NULL, NULL, NULL, NULL, NULL);
@@ -6,11 +6,16 @@
 
 #include <array>
 #include <functional>
+#include <list>
 #include <memory>
 #include <vector>
 #include <zephyr/ztest.h>
 #include <zephyr/kernel.h>
 
+#if __has_include(<memory_resource>)
+#include <zephyr/cpp/memory_resource.hpp>
+#endif
+
 BUILD_ASSERT(__cplusplus == 201703);
 
 std::array<int, 4> array = {1, 2, 3, 4};
@@ -107,6 +112,56 @@ ZTEST(libcxx_tests, test_new_aligned)
 	zassert_not_null(test_aligned, "aligned allocation failed");
 }
 
+#if __has_include(<memory_resource>)
+K_HEAP_DEFINE(pmr_heap, 1024);
+K_MEM_SLAB_DEFINE_STATIC(pmr_slab, 32, 4, 8);
+
+ZTEST(libcxx_tests, test_pmr_k_heap)
+{
+	zephyr::k_heap_resource resource(&pmr_heap);
+	std::pmr::vector<int> v(&resource);
+
+	for (int i = 0; i < 16; i++) {
+		v.push_back(i);
+	}
+	zassert_true(v.data() >= pmr_heap.heap.init_mem &&
+		     (uint8_t *)v.data() < (uint8_t *)pmr_heap.heap.init_mem +
+					      pmr_heap.heap.init_bytes,
+		     "not allocated from the heap");
+}
+
+ZTEST(libcxx_tests, test_pmr_k_mem_slab)
+{
+	zephyr::k_mem_slab_resource resource(&pmr_slab, std::pmr::new_delete_resource());
+
+	{
+		std::pmr::list<int> l(&resource);
+
+		/* More nodes than blocks, the others come from upstream */
+		for (int i = 0; i < 8; i++) {
+			l.push_back(i);
+		}
+		zassert_equal(k_mem_slab_num_used_get(&pmr_slab), 4);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&pmr_slab), 0);
+}
+
+ZTEST(libcxx_tests, test_pmr_sys_arena)
+{
+	SYS_ARENA_DEFINE(arena, 256);
+	zephyr::sys_arena_resource resource(&arena);
+	std::pmr::vector<char> v(&resource);
+
+	v.reserve(100);
+	zassert_true(sys_arena_used(&arena) >= 100);
+
+	v.clear();
+	v.shrink_to_fit();
+	sys_arena_reset(&arena);
+	zassert_equal(sys_arena_used(&arena), 0);
+}
+#endif /* __has_include(<memory_resource>) */
+
 static void *libcxx_tests_setup(void)
 {
 	TC_PRINT("version %u\n", (uint32_t)__cplusplus);
@@ -0,0 +1,86 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dma_memcpy.h>
+#include <zephyr/ztest.h>
+
+#define BUF_SIZE 1024
+
+static uint8_t __aligned(32) src_buf[BUF_SIZE];
+static uint8_t __aligned(32) dst_buf[BUF_SIZE];
+
+static void fill_src(void)
+{
+	for (size_t i = 0; i < sizeof(src_buf); i++) {
+		src_buf[i] = (uint8_t)(i * 7U);
+	}
+	memset(dst_buf, 0, sizeof(dst_buf));
+}
+
+ZTEST(dma_memcpy, test_copy_sizes)
+{
+	/* Below and above the threshold, aligned and not */
+	static const size_t sizes[] = {1, 3, 63, 64, 65, 255, 256, BUF_SIZE - 1};
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		size_t off = sizes[i] & 1U;
+		size_t len = sizes[i] - off;
+
+		fill_src();
+		zassert_ok(sys_dma_memcpy(&dst_buf[off], &src_buf[off], len));
+		zassert_mem_equal(&dst_buf[off], &src_buf[off], len, "size %zu", sizes[i]);
+		zassert_equal(dst_buf[off + len], 0, "copied past size %zu", sizes[i]);
+	}
+}
+
+ZTEST(dma_memcpy, test_copy_signal)
+{
+	struct k_poll_signal sig;
+	struct k_poll_event evt = K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+							   K_POLL_MODE_NOTIFY_ONLY, &sig);
+	unsigned int signaled;
+	int result;
+
+	fill_src();
+	k_poll_signal_init(&sig);
+
+	sys_dma_memcpy_async(dst_buf, src_buf, BUF_SIZE, sys_dma_memcpy_signal, &sig);
+
+	zassert_ok(k_poll(&evt, 1, K_SECONDS(1)));
+	k_poll_signal_check(&sig, &signaled, &result);
+	zassert_true(signaled);
+	zassert_ok(result);
+	zassert_mem_equal(dst_buf, src_buf, BUF_SIZE);
+}
+
+static void count_cb(void *user_data, int result)
+{
+	atomic_t *count = user_data;
+
+	zassert_ok(result);
+	atomic_inc(count);
+}
+
+ZTEST(dma_memcpy, test_memset)
+{
+	atomic_t count = ATOMIC_INIT(0);
+
+	memset(dst_buf, 0, sizeof(dst_buf));
+
+	sys_dma_memset_async(&dst_buf[1], 0xa5, BUF_SIZE - 2, count_cb, &count);
+	while (atomic_get(&count) == 0) {
+		k_yield();
+	}
+
+	zassert_equal(dst_buf[0], 0);
+	zassert_equal(dst_buf[BUF_SIZE - 1], 0);
+	for (size_t i = 1; i < BUF_SIZE - 1; i++) {
+		zassert_equal(dst_buf[i], 0xa5, "byte %zu", i);
+	}
+}
+
+ZTEST_SUITE(dma_memcpy, NULL, NULL, NULL, NULL, NULL);
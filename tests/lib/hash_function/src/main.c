@@ -138,4 +138,22 @@ ZTEST(hash_function, test_sys_hash32)
 	zassert_ok(kolmogorov_smirnov_test(buckets, ARRAY_SIZE(buckets)));
 }
 
+ZTEST(hash_function, test_sys_hash32_xxhash32)
+{
+	static const char str[] = "Nobody inspects the spammish repetition";
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_SYS_HASH_FUNC32_XXHASH32);
+
+#if defined(CONFIG_SYS_HASH_FUNC32_XXHASH32)
+	/* Reference values, the long one also goes through the 16 byte loop */
+	zassert_equal(sys_hash32_xxhash32("", 0), 0x02cc5d05);
+	zassert_equal(sys_hash32_xxhash32("abc", 3), 0x32d153ff);
+	zassert_equal(sys_hash32_xxhash32(str, sizeof(str) - 1), 0xe2293b2f);
+	/* Unaligned input */
+	zassert_equal(sys_hash32_xxhash32(&str[1], sizeof(str) - 2),
+		      sys_hash32_xxhash32("obody inspects the spammish repetition",
+					  sizeof(str) - 2));
+#endif
+}
+
 ZTEST_SUITE(hash_function, NULL, NULL, NULL, NULL, NULL);
@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/heap_profile.h>
 #include <inttypes.h>
 
 /* Guess at a value for heap size based on available memory on the
@@ -268,6 +269,48 @@ ZTEST(lib_heap, test_solo_free_header)
 	}
 }
 
+/* With CONFIG_SYS_HEAP_TLSF, free chunks of the same power-of-two size
+ * category are filed by finer size, so that an allocation finds a chunk
+ * close to its size even behind more chunks of that category than the
+ * allocator tries.  Without it, the smaller chunks exhaust the tries and
+ * the allocation is carved out of the large free chunk at the end.
+ */
+ZTEST(lib_heap, test_tlsf_close_fit)
+{
+	struct sys_heap heap;
+	void *small[CONFIG_SYS_HEAP_ALLOC_LOOPS + 1];
+	void *guards[ARRAY_SIZE(small) + 1];
+	void *close, *p;
+
+	if (!IS_ENABLED(CONFIG_SYS_HEAP_TLSF)) {
+		ztest_test_skip();
+	}
+
+	sys_heap_init(&heap, heapmem, MIN(BIG_HEAP_SZ, 16 * 1024));
+
+	/* Guards keep the freed chunks from merging */
+	for (int i = 0; i < ARRAY_SIZE(small); i++) {
+		small[i] = sys_heap_alloc(&heap, 1100);
+		guards[i] = sys_heap_alloc(&heap, 8);
+		zassert_not_null(small[i]);
+		zassert_not_null(guards[i]);
+	}
+	close = sys_heap_alloc(&heap, 1900);
+	guards[ARRAY_SIZE(small)] = sys_heap_alloc(&heap, 8);
+	zassert_not_null(close);
+	zassert_not_null(guards[ARRAY_SIZE(small)]);
+
+	for (int i = 0; i < ARRAY_SIZE(small); i++) {
+		sys_heap_free(&heap, small[i]);
+	}
+	sys_heap_free(&heap, close);
+	zassert_true(sys_heap_validate(&heap));
+
+	p = sys_heap_alloc(&heap, 1850);
+	zassert_equal(p, close, "Allocation not served by the closest free chunk");
+	zassert_true(sys_heap_validate(&heap));
+}
+
 /* Simple clobber detection */
 void realloc_fill_block(uint8_t *p, size_t sz)
 {
@@ -485,4 +528,155 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+#ifdef CONFIG_SYS_HEAP_PROFILE
+static struct sys_heap profile_heap;
+static struct sys_heap_profile profile;
+
+static __noinline void *profile_alloc_a(size_t bytes)
+{
+	return sys_heap_alloc(&profile_heap, bytes);
+}
+
+static __noinline void *profile_alloc_b(size_t bytes)
+{
+	return sys_heap_alloc(&profile_heap, bytes);
+}
+
+K_HEAP_DEFINE(profile_kheap, 1024);
+
+static __noinline void *profile_kheap_alloc(size_t bytes)
+{
+	return k_heap_alloc(&profile_kheap, bytes, K_NO_WAIT);
+}
+
+static __noinline void *profile_kheap_calloc(size_t bytes)
+{
+	return k_heap_calloc(&profile_kheap, 1, bytes, K_NO_WAIT);
+}
+
+static __noinline void *profile_kheap_aligned_alloc(size_t bytes)
+{
+	return k_heap_aligned_alloc(&profile_kheap, 16, bytes, K_NO_WAIT);
+}
+
+static void count_profile(struct sys_heap_profile *p, void *user_data)
+{
+	if (p == &profile) {
+		(*(int *)user_data)++;
+	}
+}
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+
+ZTEST(lib_heap, test_heap_profile)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	struct sys_heap_profile_site site;
+	void *a[3], *b;
+	size_t free_bytes, largest_free;
+	unsigned int frag;
+	int sites = 0;
+
+	sys_heap_init(&profile_heap, heapmem, SMALL_HEAP_SZ);
+
+	zassert_ok(sys_heap_profile_start(&profile, &profile_heap, NULL));
+	zassert_equal(sys_heap_profile_start(&profile, &profile_heap, NULL), -EBUSY);
+
+	for (int i = 0; i < ARRAY_SIZE(a); i++) {
+		a[i] = profile_alloc_a(32U);
+		zassert_not_null(a[i]);
+	}
+	b = profile_alloc_b(200U);
+	zassert_not_null(b);
+
+	/* Shrinking in place reports the new block before the old one */
+	zassert_equal(sys_heap_realloc(&profile_heap, b, 100U), b);
+
+	sys_heap_free(&profile_heap, a[0]);
+	sys_heap_free(&profile_heap, a[2]);
+
+	for (unsigned int i = 0; sys_heap_profile_site_get(&profile, i, &site) == 0; i++) {
+		sites++;
+		if (site.allocs == 3U) {
+			/* profile_alloc_a() */
+			zassert_equal(site.frees, 2U);
+			zassert_equal(site.live_bytes, sys_heap_usable_size(&profile_heap, a[1]));
+		} else if (site.live_bytes != 0U) {
+			/* The test itself, calling sys_heap_realloc() */
+			zassert_equal(site.allocs, 1U);
+			zassert_equal(site.frees, 0U);
+		} else {
+			/* profile_alloc_b(), whose block was reallocated */
+			zassert_equal(site.allocs, 1U);
+			zassert_equal(site.frees, 1U);
+		}
+	}
+	zassert_equal(sites, 3, "expected 3 call sites, got %d", sites);
+
+	/* a[0] is a hole well before the rest of the free memory */
+	frag = sys_heap_fragmentation(&profile_heap, &free_bytes, &largest_free);
+	zassert_true(largest_free < free_bytes);
+	zassert_true((frag > 0U) && (frag < 1000U), "unexpected fragmentation %u", frag);
+
+	sys_heap_profile_print(&profile);
+
+	sys_heap_free(&profile_heap, a[1]);
+	sys_heap_free(&profile_heap, b);
+	sys_heap_profile_stop(&profile);
+
+	frag = sys_heap_fragmentation(&profile_heap, &free_bytes, &largest_free);
+	zassert_equal(frag, 0U, "free memory should be coalesced");
+	zassert_equal(largest_free, free_bytes);
+
+	/* Stopped profiles keep their data and can be restarted */
+	zassert_ok(sys_heap_profile_site_get(&profile, 0, &site));
+	zassert_ok(sys_heap_profile_start(&profile, &profile_heap, NULL));
+	zassert_equal(sys_heap_profile_site_get(&profile, 0, &site), -ENOENT);
+	sys_heap_profile_stop(&profile);
+#else /* CONFIG_SYS_HEAP_PROFILE */
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+}
+
+/* Allocations made through k_heap are accounted to the caller of k_heap */
+ZTEST(lib_heap, test_heap_profile_k_heap)
+{
+#ifdef CONFIG_SYS_HEAP_PROFILE
+	struct sys_heap_profile_site site;
+	void *mem[4];
+	int sites = 0;
+	int running = 0;
+
+	zassert_ok(sys_heap_profile_start(&profile, &profile_kheap.heap, &profile_kheap.lock));
+
+	mem[0] = profile_kheap_alloc(32U);
+	mem[1] = profile_kheap_alloc(32U);
+	mem[2] = profile_kheap_calloc(32U);
+	mem[3] = profile_kheap_aligned_alloc(32U);
+
+	for (unsigned int i = 0; sys_heap_profile_site_get(&profile, i, &site) == 0; i++) {
+		sites++;
+		zassert_true(site.allocs <= 2U, "allocations of different callers merged");
+	}
+	zassert_equal(sites, 3, "expected 3 call sites, got %d", sites);
+
+	/* Dumping takes the k_heap lock around the free list walk */
+	sys_heap_profile_foreach(count_profile, &running);
+	zassert_equal(running, 1);
+	sys_heap_profile_print(&profile);
+
+	for (int i = 0; i < ARRAY_SIZE(mem); i++) {
+		zassert_not_null(mem[i]);
+		k_heap_free(&profile_kheap, mem[i]);
+	}
+
+	sys_heap_profile_stop(&profile);
+
+	running = 0;
+	sys_heap_profile_foreach(count_profile, &running);
+	zassert_equal(running, 0);
+#else /* CONFIG_SYS_HEAP_PROFILE */
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_PROFILE */
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
@@ -2178,4 +2178,92 @@ ZTEST(lib_json_test, test_json_enums)
 		     "Enums not decoded correctly");
 }
 
+ZTEST(lib_json_test, test_json_enums_out_of_order)
+{
+	char encoded[] = "{\"u32\":7,\"i8\":-1,\"u16\":5,\"u8\":2,\"i32\":-6,\"i16\":-3}";
+	struct test_enums enums = {0};
+	int64_t ret;
+
+	ret = json_obj_parse(encoded, sizeof(encoded) - 1, enums_descr,
+			     ARRAY_SIZE(enums_descr), &enums);
+
+	zassert_equal(ret, (1 << ARRAY_SIZE(enums_descr)) - 1, "Not all fields decoded");
+	zassert_equal(enums.i8, -1);
+	zassert_equal(enums.u8, 2);
+	zassert_equal(enums.i16, -3);
+	zassert_equal(enums.u16, 5);
+	zassert_equal(enums.i32, -6);
+	zassert_equal(enums.u32, 7);
+}
+
+struct stream_test_ctx {
+	char events[256];
+	size_t len;
+};
+
+static int stream_test_cb(const struct json_token *key, const struct json_token *value,
+			  size_t depth, void *data)
+{
+	struct stream_test_ctx *ctx = data;
+
+	/* Record "<depth><key>=<type><value>;" for each value */
+	ctx->len += snprintk(&ctx->events[ctx->len], sizeof(ctx->events) - ctx->len,
+			     "%zu%.*s=%c%.*s;", depth,
+			     key ? (int)(key->end - key->start) : 0, key ? key->start : "",
+			     value->type, (int)(value->end - value->start), value->start);
+
+	return 0;
+}
+
+ZTEST(lib_json_test, test_json_stream_parser)
+{
+	const char doc[] = "{\"name\": \"a\\\"b\", \"list\": [1, -2.5e1, true, null],"
+			   " \"obj\": {\"off\": false}, \"empty\": []}";
+	const char expected[] = "0={;1name=\"a\\\"b;1list=[;2=01;2=0-2.5e1;2=ttrue;2=nnull;"
+				"1=];1obj={;2off=ffalse;1=};1empty=[;1=];0=};";
+	struct stream_test_ctx ctx;
+	struct json_stream_parser parser;
+	char buf[16];
+
+	/* Same events whatever the chunk size */
+	for (size_t chunk = 1; chunk <= sizeof(doc) - 1; chunk++) {
+		memset(&ctx, 0, sizeof(ctx));
+		json_stream_parser_init(&parser, buf, sizeof(buf), stream_test_cb, &ctx);
+
+		for (size_t off = 0; off < sizeof(doc) - 1; off += chunk) {
+			zassert_ok(json_stream_parser_feed(&parser, &doc[off],
+							   MIN(chunk, sizeof(doc) - 1 - off)));
+		}
+
+		zassert_ok(json_stream_parser_end(&parser));
+		zassert_str_equal(ctx.events, expected, "Chunks of %zu: %s", chunk, ctx.events);
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_parser_invalid)
+{
+	const char *const docs[] = { "[1,]", "{\"a\" 1}", "{\"a\":1}}", "[1}", ",", "{]" };
+	struct stream_test_ctx ctx;
+	struct json_stream_parser parser;
+	char buf[16];
+
+	for (size_t i = 0; i < ARRAY_SIZE(docs); i++) {
+		memset(&ctx, 0, sizeof(ctx));
+		json_stream_parser_init(&parser, buf, sizeof(buf), stream_test_cb, &ctx);
+
+		zassert_equal(json_stream_parser_feed(&parser, docs[i], strlen(docs[i])), -EINVAL,
+			      "'%s' accepted", docs[i]);
+	}
+
+	/* Truncated document */
+	json_stream_parser_init(&parser, buf, sizeof(buf), stream_test_cb, &ctx);
+	zassert_ok(json_stream_parser_feed(&parser, "[1", 2));
+	zassert_equal(json_stream_parser_end(&parser), -EINVAL);
+
+	/* Member name and value larger than the buffer */
+	json_stream_parser_init(&parser, buf, sizeof(buf), stream_test_cb, &ctx);
+	zassert_equal(json_stream_parser_feed(&parser, "{\"key\":\"0123456789abcdef\"}", 26),
+		      -ENOSPC);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
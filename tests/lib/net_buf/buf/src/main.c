@@ -12,6 +12,7 @@
 #include <zephyr/sys/printk.h>
 
 #include <zephyr/net_buf.h>
+#include <zephyr/sys/arena.h>
 
 #include <zephyr/ztest.h>
 
@@ -72,6 +73,11 @@ NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
 
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, 6, FIXED_BUFFER_SIZE, USER_DATA_FIXED, NULL);
+
+SYS_ARENA_DEFINE(buf_arena, 512);
+NET_BUF_POOL_ARENA_DEFINE(arena_pool, 4, &buf_arena, 0, NULL);
+
 static void buf_destroy(struct net_buf *buf)
 {
 	struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
@@ -529,6 +535,103 @@ ZTEST(net_buf_tests, test_net_buf_var_pool)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+ZTEST(net_buf_tests, test_net_buf_arena_pool)
+{
+	struct net_buf *buf1, *buf2, *buf3;
+	sys_arena_checkpoint_t cp;
+
+	sys_arena_reset(&buf_arena);
+	cp = sys_arena_checkpoint(&buf_arena);
+
+	buf1 = net_buf_alloc_len(&arena_pool, 100, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer");
+
+	buf2 = net_buf_alloc_len(&arena_pool, 300, K_NO_WAIT);
+	zassert_not_null(buf2, "Failed to get buffer");
+
+	/* The arena is exhausted, even though buffers are left in the pool */
+	buf3 = net_buf_alloc_len(&arena_pool, 200, K_NO_WAIT);
+	zassert_is_null(buf3, "Arena should be exhausted");
+
+	buf3 = net_buf_clone(buf2, K_NO_WAIT);
+	zassert_not_null(buf3, "Failed to clone buffer");
+	zassert_equal(buf3->data, buf2->data, "Cloned data doesn't match");
+
+	net_buf_unref(buf1);
+	net_buf_unref(buf2);
+	net_buf_unref(buf3);
+
+	/* Data memory only comes back in bulk */
+	zassert_true(sys_arena_used(&buf_arena) >= 400U);
+	sys_arena_rewind(&buf_arena, cp);
+
+	buf1 = net_buf_alloc_len(&arena_pool, 500, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer after rewind");
+	net_buf_unref(buf1);
+	sys_arena_reset(&buf_arena);
+}
+
+ZTEST(net_buf_tests, test_net_buf_bulk)
+{
+	struct net_buf *bufs[6];
+	int n;
+
+	n = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, bufs, 4);
+	zassert_equal(n, 4, "Failed to get buffers");
+
+	/* Only what is left gets allocated */
+	n = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, &bufs[4], 4);
+	zassert_equal(n, 2, "Wrong number of buffers");
+	zassert_is_null(net_buf_alloc_fixed(&bulk_pool, K_NO_WAIT),
+			"Pool should be exhausted");
+
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		zassert_equal(bufs[i]->ref, 1U, "Bad buffer ref");
+		zassert_true(net_buf_tailroom(bufs[i]) >= FIXED_BUFFER_SIZE,
+			     "Not enough room");
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(bufs[i], bufs[j], "Buffer allocated twice");
+		}
+	}
+
+	net_buf_unref_bulk(bufs, ARRAY_SIZE(bufs));
+
+	/* All freed buffers, cached or not, can be allocated again */
+	n = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, bufs, ARRAY_SIZE(bufs));
+	zassert_equal(n, ARRAY_SIZE(bufs), "Failed to get buffers back");
+	net_buf_unref_bulk(bufs, n);
+}
+
+static struct net_buf *bulk_bufs[6];
+static K_THREAD_STACK_DEFINE(bulk_stack, 512 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread bulk_thread;
+
+static void bulk_unref(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(50));
+	net_buf_unref(bulk_bufs[0]);
+}
+
+ZTEST(net_buf_tests, test_net_buf_bulk_wait)
+{
+	struct net_buf *buf;
+	int n;
+
+	n = net_buf_alloc_bulk(&bulk_pool, FIXED_BUFFER_SIZE, bulk_bufs, ARRAY_SIZE(bulk_bufs));
+	zassert_equal(n, ARRAY_SIZE(bulk_bufs), "Failed to get buffers");
+
+	/* A buffer freed while waiting must not stay in a cache */
+	k_thread_create(&bulk_thread, bulk_stack, K_THREAD_STACK_SIZEOF(bulk_stack),
+			bulk_unref, NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	buf = net_buf_alloc_fixed(&bulk_pool, TEST_TIMEOUT);
+	zassert_equal_ptr(buf, bulk_bufs[0], "Failed to get freed buffer");
+	k_thread_join(&bulk_thread, K_FOREVER);
+
+	bulk_bufs[0] = buf;
+	net_buf_unref_bulk(bulk_bufs, ARRAY_SIZE(bulk_bufs));
+}
+
 ZTEST(net_buf_tests, test_net_buf_byte_order)
 {
 	struct net_buf *buf;
@@ -274,5 +274,91 @@ ZTEST(lib_p4wq_1cpu, test_p4wq_simple)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+#ifdef CONFIG_SCHED_CPU_MASK
+static volatile int handler_cpu;
+
+static void cpu_mask_handler(struct k_p4wq_work *work)
+{
+	unsigned int key = arch_irq_lock();
+
+	handler_cpu = arch_curr_cpu()->id;
+	arch_irq_unlock(key);
+	has_run = true;
+}
+
+/* Validate that an item's CPU mask is applied to the worker running it */
+ZTEST(lib_p4wq, test_cpu_mask)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		simple_item = (struct k_p4wq_work){};
+		simple_item.handler = cpu_mask_handler;
+		simple_item.cpu_mask = BIT(cpu);
+		simple_item.sync = true;
+
+		has_run = false;
+		handler_cpu = -1;
+		k_p4wq_submit(&wq, &simple_item);
+		zassert_ok(k_p4wq_wait(&simple_item, K_MSEC(100)),
+			   "item didn't complete");
+		zassert_true(has_run, "item didn't run");
+		zassert_equal(handler_cpu, cpu, "ran on CPU %d, expected %u",
+			      handler_cpu, cpu);
+	}
+}
+
+/* A single worker, so that it picks up queued items itself */
+K_P4WQ_DEFINE(solo_wq, 1, 2048);
+
+static struct k_p4wq_work pinned_items[2];
+static volatile int pinned_cpus[2];
+
+static void pinned_handler(struct k_p4wq_work *work)
+{
+	int idx = work - pinned_items;
+	unsigned int key = arch_irq_lock();
+
+	pinned_cpus[idx] = arch_curr_cpu()->id;
+	arch_irq_unlock(key);
+
+	if (idx == 0) {
+		/* Queued, as the only worker is busy running this one */
+		k_p4wq_submit(&solo_wq, &pinned_items[1]);
+	}
+}
+
+/* Validate that a running worker migrates to the CPU of the next item
+ * it picks up from the queue
+ */
+ZTEST(lib_p4wq, test_cpu_mask_running_worker)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		unsigned int other = (cpu + 1) % num_cpus;
+
+		for (size_t i = 0; i < ARRAY_SIZE(pinned_items); i++) {
+			pinned_items[i] = (struct k_p4wq_work){};
+			pinned_items[i].handler = pinned_handler;
+			pinned_items[i].sync = true;
+			pinned_cpus[i] = -1;
+		}
+		pinned_items[0].cpu_mask = BIT(cpu);
+		pinned_items[1].cpu_mask = BIT(other);
+
+		k_p4wq_submit(&solo_wq, &pinned_items[0]);
+		zassert_ok(k_p4wq_wait(&pinned_items[0], K_MSEC(100)),
+			   "first item didn't complete");
+		zassert_ok(k_p4wq_wait(&pinned_items[1], K_MSEC(100)),
+			   "second item didn't complete");
+		zassert_equal(pinned_cpus[0], cpu, "first item ran on CPU %d, expected %u",
+			      pinned_cpus[0], cpu);
+		zassert_equal(pinned_cpus[1], other, "second item ran on CPU %d, expected %u",
+			      pinned_cpus[1], other);
+	}
+}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 ZTEST_SUITE(lib_p4wq, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(lib_p4wq_1cpu, NULL, NULL, ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -0,0 +1,141 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/ring_buffer_spsc.h>
+
+#define SPSC_SIZE 29
+
+RING_BUF_SPSC_DECLARE(spsc_rb, SPSC_SIZE);
+
+/**
+ * @brief Test claim and finish on the lock-free SPSC ring buffer
+ *
+ * @details Fill the buffer across its end with two claims, hand over only
+ * part of them, and check that the consumer sees exactly those bytes, in
+ * order, also with a partial get finish.
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_spsc_claim)
+{
+	uint8_t *data;
+	uint8_t out[SPSC_SIZE];
+	uint32_t len;
+
+	ring_buf_spsc_init(&spsc_rb, SPSC_SIZE, spsc_rb.buffer);
+	zassert_true(ring_buf_spsc_is_empty(&spsc_rb));
+	zassert_equal(ring_buf_spsc_capacity_get(&spsc_rb), SPSC_SIZE);
+
+	/* Move the positions close to the end */
+	zassert_equal(ring_buf_spsc_put(&spsc_rb, out, 20), 20);
+	zassert_equal(ring_buf_spsc_get(&spsc_rb, NULL, 20), 20);
+
+	len = ring_buf_spsc_put_claim(&spsc_rb, &data, 15);
+	zassert_equal(len, SPSC_SIZE - 20, "claim does not stop at the end");
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = i;
+	}
+	len = ring_buf_spsc_put_claim(&spsc_rb, &data, 15);
+	zassert_equal(len, 15);
+	zassert_equal_ptr(data, spsc_rb.buffer);
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = SPSC_SIZE - 20 + i;
+	}
+
+	zassert_equal(ring_buf_spsc_size_get(&spsc_rb), 0, "visible before finish");
+	zassert_equal(ring_buf_spsc_put_finish(&spsc_rb, 25), -EINVAL);
+	zassert_ok(ring_buf_spsc_put_finish(&spsc_rb, 20));
+	zassert_equal(ring_buf_spsc_size_get(&spsc_rb), 20);
+	zassert_equal(ring_buf_spsc_space_get(&spsc_rb), SPSC_SIZE - 20);
+
+	len = ring_buf_spsc_get_claim(&spsc_rb, &data, 4);
+	zassert_equal(len, 4);
+	zassert_ok(ring_buf_spsc_get_finish(&spsc_rb, 2));
+
+	zassert_equal(ring_buf_spsc_get(&spsc_rb, out, sizeof(out)), 18);
+	for (uint32_t i = 0; i < 18; i++) {
+		zassert_equal(out[i], i + 2);
+	}
+	zassert_true(ring_buf_spsc_is_empty(&spsc_rb));
+
+	/* Full, then nothing more fits */
+	zassert_equal(ring_buf_spsc_put(&spsc_rb, out, sizeof(out)), SPSC_SIZE);
+	zassert_equal(ring_buf_spsc_put_claim(&spsc_rb, &data, 1), 0);
+	zassert_ok(ring_buf_spsc_put_finish(&spsc_rb, 0));
+	zassert_equal(ring_buf_spsc_get(&spsc_rb, NULL, SPSC_SIZE), SPSC_SIZE);
+}
+
+static bool spsc_produce(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	static uint8_t cnt;
+	static uint32_t wr;
+	uint8_t *data;
+	uint32_t len;
+
+	if (iter_cnt == 0) {
+		cnt = 0;
+		wr = 1;
+	}
+
+	len = ring_buf_spsc_put_claim(&spsc_rb, &data, wr);
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = cnt++;
+	}
+
+	wr = (wr % 13) + 1;
+
+	zassert_ok(ring_buf_spsc_put_finish(&spsc_rb, len));
+
+	return true;
+}
+
+static bool spsc_consume(void *user_data, uint32_t iter_cnt, bool last, int prio)
+{
+	static uint8_t cnt;
+	static uint32_t rd;
+	uint8_t *data;
+	uint32_t len;
+
+	if (iter_cnt == 0) {
+		cnt = 0;
+		rd = 1;
+	}
+
+	len = ring_buf_spsc_get_claim(&spsc_rb, &data, rd);
+	for (uint32_t i = 0; i < len; i++) {
+		zassert_equal(data[i], cnt, "Got %02x, exp: %02x", data[i], cnt);
+		cnt++;
+	}
+
+	rd = (rd % 11) + 1;
+
+	zassert_ok(ring_buf_spsc_get_finish(&spsc_rb, len));
+
+	return true;
+}
+
+static void spsc_ztress(ztress_handler high_handler, ztress_handler low_handler)
+{
+	ring_buf_spsc_init(&spsc_rb, SPSC_SIZE, spsc_rb.buffer);
+
+	ztress_set_timeout((CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) :
+								       K_MSEC(10000));
+	ZTRESS_EXECUTE(ZTRESS_THREAD(high_handler, NULL, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(low_handler, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+}
+
+/* Lock-free SPSC ring buffer. Test is validating single producer, single
+ * consumer from different priorities, without any lock.
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_spsc_stress)
+{
+	PRINT("Producing interrupts consuming\n");
+	spsc_ztress(spsc_produce, spsc_consume);
+
+	PRINT("Consuming interrupts producing\n");
+	spsc_ztress(spsc_consume, spsc_produce);
+}
@@ -212,6 +212,42 @@ ZTEST(shared_multi_heap, test_shared_multi_heap)
 	/* Request a non-existent attribute */
 	block = shared_multi_heap_alloc(MAX_SHARED_MULTI_HEAP_ATTR, 0x100);
 	zassert_is_null(block, "wrong attribute accepted as valid");
+
+	/*
+	 * There is no external memory region. Once spilling over to
+	 * cacheable memory, external requests are served from it.
+	 */
+	block = shared_multi_heap_alloc(SMH_REG_ATTR_EXTERNAL, 0x100);
+	zassert_is_null(block, "allocated from a missing attribute");
+
+	zassert_equal(shared_multi_heap_spill_set(SMH_REG_ATTR_EXTERNAL,
+						  SMH_REG_ATTR_EXTERNAL), -EINVAL);
+	zassert_ok(shared_multi_heap_spill_set(SMH_REG_ATTR_EXTERNAL,
+					       SMH_REG_ATTR_CACHEABLE));
+
+	block = shared_multi_heap_alloc(SMH_REG_ATTR_EXTERNAL, 0x100);
+	reg_map = get_region_map(block);
+
+	zassert_not_null(reg_map, "spill-over allocation failed");
+	zassert_equal(reg_map->region.attr, SMH_REG_ATTR_CACHEABLE, "wrong memory attribute");
+
+#ifdef CONFIG_SHARED_MULTI_HEAP_STATS
+	struct shared_multi_heap_stats stats;
+
+	zassert_ok(shared_multi_heap_stats_get(SMH_REG_ATTR_NON_CACHEABLE, 0, &stats));
+	zassert_equal(stats.alloc_cnt, 2, "wrong allocation count");
+	zassert_equal(stats.fail_cnt, 1, "wrong failure count");
+	zassert_true(stats.heap.allocated_bytes >= 0x200, "wrong allocated size");
+
+	zassert_ok(shared_multi_heap_stats_get(SMH_REG_ATTR_CACHEABLE, 0, &stats));
+	zassert_equal(stats.spill_cnt, 1, "spill-over not accounted");
+
+	zassert_equal(shared_multi_heap_stats_get(SMH_REG_ATTR_EXTERNAL, 0, &stats), -ENOENT);
+#endif /* CONFIG_SHARED_MULTI_HEAP_STATS */
+
+	shared_multi_heap_free(block);
+	zassert_ok(shared_multi_heap_spill_set(SMH_REG_ATTR_EXTERNAL,
+					       MAX_SHARED_MULTI_HEAP_ATTR));
 }
 
 ZTEST_SUITE(shared_multi_heap, NULL, NULL, NULL, NULL, NULL);
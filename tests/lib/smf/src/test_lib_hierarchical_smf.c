@@ -351,13 +351,27 @@ static const struct smf_state test_states[] = {
 				     NULL, NULL),
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+SMF_TABLE_DEFINE(test_table, test_states, 2);
+#endif
+
+static void test_set_initial(const struct smf_state *init_state)
+{
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	zassert_ok(smf_table_init(&test_table));
+	smf_set_table((struct smf_ctx *)&test_obj, &test_table);
+#endif
+
+	smf_set_initial((struct smf_ctx *)&test_obj, init_state);
+}
+
 ZTEST(smf_tests, test_smf_hierarchical)
 {
 	/* A) Test state transitions */
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = NONE;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -374,7 +388,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = PARENT_ENTRY;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -391,7 +405,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = PARENT_RUN;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -408,7 +422,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = PARENT_EXIT;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -425,7 +439,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = ENTRY;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -442,7 +456,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = RUN;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -459,7 +473,7 @@ ZTEST(smf_tests, test_smf_hierarchical)
 
 	test_obj.transition_bits = 0;
 	test_obj.terminate = EXIT;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[STATE_A]);
+	test_set_initial(&test_states[STATE_A]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -459,6 +459,20 @@ static const struct smf_state test_states[] = {
 				     NULL),
 };
 
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+SMF_TABLE_DEFINE(test_table, test_states, 3);
+#endif
+
+static void test_set_initial(const struct smf_state *init_state)
+{
+#ifdef CONFIG_SMF_TRANSITION_TABLE
+	zassert_ok(smf_table_init(&test_table));
+	smf_set_table((struct smf_ctx *)&test_obj, &test_table);
+#endif
+
+	smf_set_initial((struct smf_ctx *)&test_obj, init_state);
+}
+
 ZTEST(smf_tests, test_smf_self_transition)
 {
 	/* A) Test state transitions */
@@ -466,7 +480,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = NONE;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -483,7 +497,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = PARENT_ENTRY;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -501,7 +515,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = PARENT_RUN;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -519,7 +533,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = PARENT_EXIT;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -537,7 +551,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = ENTRY;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -555,7 +569,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = RUN;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
@@ -573,7 +587,7 @@ ZTEST(smf_tests, test_smf_self_transition)
 	test_obj.transition_bits = 0;
 	test_obj.first_time = FIRST_TIME_BITS;
 	test_obj.terminate = EXIT;
-	smf_set_initial((struct smf_ctx *)&test_obj, &test_states[PARENT_AB]);
+	test_set_initial(&test_states[PARENT_AB]);
 
 	for (int i = 0; i < SMF_RUN; i++) {
 		if (smf_run_state((struct smf_ctx *)&test_obj) < 0) {
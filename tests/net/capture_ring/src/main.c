@@ -0,0 +1,221 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net/capture.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/ztest.h>
+
+/* Longer than the snapshot length */
+#define LONG_PKT_LEN (CONFIG_NET_CAPTURE_RING_SNAPLEN * 3)
+/* Enough packets to overflow the ring buffer */
+#define FULL_PKT_COUNT 20
+
+static int fake_dev_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static const struct dummy_api fake_dev_api = {
+	.send = fake_dev_send,
+};
+
+NET_DEVICE_INIT_INSTANCE(capture_dev_0, "capture_dev_0", 0, NULL, NULL, NULL, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_dev_api, DUMMY_L2,
+			 NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+NET_DEVICE_INIT_INSTANCE(capture_dev_1, "capture_dev_1", 1, NULL, NULL, NULL, NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &fake_dev_api, DUMMY_L2,
+			 NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static struct net_if *iface_0;
+static struct net_if *iface_1;
+
+struct drained {
+	int count;
+	/* Id of each record, its first byte */
+	uint8_t ids[FULL_PKT_COUNT];
+	struct net_capture_record records[FULL_PKT_COUNT];
+};
+
+/* Capture a packet whose byte i is id + i */
+static void capture(struct net_if *iface, uint8_t id, size_t len)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate packet");
+
+	for (size_t i = 0; i < len; i++) {
+		zassert_ok(net_pkt_write_u8(pkt, (uint8_t)(id + i)));
+	}
+
+	net_capture_pkt(iface, pkt);
+	net_pkt_unref(pkt);
+}
+
+static void drain_cb(const struct net_capture_record *record, void *user_data)
+{
+	struct drained *drained = user_data;
+
+	zassert_true(drained->count < FULL_PKT_COUNT, "Too many records");
+
+	for (size_t i = 0; i < record->caplen; i++) {
+		zassert_equal(record->data[i], (uint8_t)(record->data[0] + i),
+			      "Bad data at %zu", i);
+	}
+
+	drained->ids[drained->count] = record->data[0];
+	drained->records[drained->count] = *record;
+	/* Only valid during the call */
+	drained->records[drained->count].data = NULL;
+	drained->count++;
+}
+
+static void drain(struct drained *drained)
+{
+	memset(drained, 0, sizeof(*drained));
+	zassert_equal(net_capture_ring_drain(drain_cb, drained), drained->count);
+}
+
+/* Packets are recorded in order, truncated to the snapshot length */
+ZTEST(net_capture_ring, test_records)
+{
+	struct drained drained;
+
+	zassert_ok(net_capture_ring_enable(NULL, NULL, NULL));
+	zassert_equal(net_capture_ring_enable(NULL, NULL, NULL), -EALREADY);
+
+	capture(iface_0, 10, 8);
+	capture(iface_1, 20, LONG_PKT_LEN);
+
+	drain(&drained);
+	zassert_equal(drained.count, 2);
+
+	zassert_equal(drained.ids[0], 10);
+	zassert_equal(drained.records[0].len, 8);
+	zassert_equal(drained.records[0].caplen, 8);
+	zassert_equal(drained.records[0].iface, iface_0);
+
+	zassert_equal(drained.ids[1], 20);
+	zassert_equal(drained.records[1].len, LONG_PKT_LEN);
+	zassert_equal(drained.records[1].caplen, CONFIG_NET_CAPTURE_RING_SNAPLEN);
+	zassert_equal(drained.records[1].iface, iface_1);
+
+	zassert_true((int32_t)(drained.records[1].timestamp - drained.records[0].timestamp) >= 0,
+		     "Records out of order");
+
+	/* Drained records are gone */
+	drain(&drained);
+	zassert_equal(drained.count, 0);
+
+	/* Nothing is recorded once disabled */
+	zassert_ok(net_capture_ring_disable());
+	zassert_equal(net_capture_ring_disable(), -EALREADY);
+
+	capture(iface_0, 30, 8);
+
+	drain(&drained);
+	zassert_equal(drained.count, 0);
+	zassert_equal(net_capture_ring_dropped(), 0);
+}
+
+static bool even_filter(struct net_if *iface, struct net_pkt *pkt, void *user_data)
+{
+	int *calls = user_data;
+	uint8_t id;
+
+	ARG_UNUSED(iface);
+
+	(*calls)++;
+
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read_u8(pkt, &id));
+
+	return (id % 2) == 0;
+}
+
+/* Only the packets of the interface passing the filter are recorded */
+ZTEST(net_capture_ring, test_filter)
+{
+	struct drained drained;
+	int calls = 0;
+
+	zassert_ok(net_capture_ring_enable(iface_0, even_filter, &calls));
+
+	for (uint8_t id = 0; id < 6; id++) {
+		capture(iface_0, id, 8);
+	}
+	capture(iface_1, 6, 8);
+
+	zassert_ok(net_capture_ring_disable());
+
+	/* The filter is not called for other interfaces */
+	zassert_equal(calls, 6);
+
+	drain(&drained);
+	zassert_equal(drained.count, 3);
+	zassert_equal(drained.ids[0], 0);
+	zassert_equal(drained.ids[1], 2);
+	zassert_equal(drained.ids[2], 4);
+}
+
+/*
+ * Packets that do not fit are counted as dropped. They are the new ones by
+ * default, the oldest ones when overwriting.
+ */
+ZTEST(net_capture_ring, test_full)
+{
+	struct drained drained;
+	int first;
+
+	zassert_ok(net_capture_ring_enable(NULL, NULL, NULL));
+
+	for (uint8_t id = 0; id < FULL_PKT_COUNT; id++) {
+		capture(iface_0, id, LONG_PKT_LEN);
+	}
+
+	zassert_ok(net_capture_ring_disable());
+
+	drain(&drained);
+	zassert_true(drained.count > 0 && drained.count < FULL_PKT_COUNT,
+		     "%d records for %d packets", drained.count, FULL_PKT_COUNT);
+	zassert_equal(drained.count + net_capture_ring_dropped(), FULL_PKT_COUNT,
+		      "%d records and %u dropped for %d packets", drained.count,
+		      net_capture_ring_dropped(), FULL_PKT_COUNT);
+
+	first = IS_ENABLED(CONFIG_NET_CAPTURE_RING_OVERWRITE) ?
+		(FULL_PKT_COUNT - drained.count) : 0;
+
+	for (int i = 0; i < drained.count; i++) {
+		zassert_equal(drained.ids[i], first + i, "Record %d is packet %d", i,
+			      drained.ids[i]);
+	}
+
+	/* Enabling the capture again starts from an empty buffer */
+	zassert_ok(net_capture_ring_enable(NULL, NULL, NULL));
+	zassert_equal(net_capture_ring_dropped(), 0);
+	zassert_ok(net_capture_ring_disable());
+
+	drain(&drained);
+	zassert_equal(drained.count, 0);
+}
+
+static void *setup(void)
+{
+	iface_0 = net_if_lookup_by_dev(DEVICE_GET(capture_dev_0));
+	iface_1 = net_if_lookup_by_dev(DEVICE_GET(capture_dev_1));
+
+	zassert_not_null(iface_0);
+	zassert_not_null(iface_1);
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_capture_ring, NULL, setup, NULL, NULL, NULL);
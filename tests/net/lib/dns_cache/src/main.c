@@ -174,3 +174,85 @@ ZTEST(net_dns_cache_test, test_only_expected_type_returned)
 	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type_b, &info_read, 1));
 	zassert_equal(AF_INET6, info_read.ai_family);
 }
+
+ZTEST(net_dns_cache_test, test_many_queries)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+	char query[sizeof("example-00.com")];
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example-%02u.com", (unsigned int)i);
+		net_sin(&info_write.ai_addr)->sin_port = i;
+		zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write,
+					 TEST_DNS_CACHE_DEFAULT_TTL),
+			   "Cache entry adding should work.");
+	}
+
+	for (size_t i = 0; i < TEST_DNS_CACHE_SIZE; i++) {
+		snprintk(query, sizeof(query), "example-%02u.com", (unsigned int)i);
+		zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, &info_read, 1));
+		zassert_equal(i, net_sin(&info_read.ai_addr)->sin_port);
+	}
+
+	zassert_ok(dns_cache_remove(&test_dns_cache, "example-03.com"));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example-03.com", query_type,
+					&info_read, 1));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, "example-04.com", query_type,
+					&info_read, 1));
+}
+
+ZTEST(net_dns_cache_test, test_negative_entry)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read = {0};
+	const char *query = "example.com";
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	zassert_equal(-ENOENT, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					      &info_read, 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_A, &info_read, 1));
+
+	/* A positive answer replaces the negative entry */
+	info_write.ai_family = AF_INET6;
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, DNS_QUERY_TYPE_AAAA,
+					&info_read, 1));
+
+	zassert_ok(dns_cache_add_negative(&test_dns_cache, "example2.com", DNS_QUERY_TYPE_A,
+					  TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Negative cache entry adding should work.");
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 + 1));
+	zassert_equal(0, dns_cache_find(&test_dns_cache, "example2.com", DNS_QUERY_TYPE_A,
+					&info_read, 1));
+}
+
+#if defined(CONFIG_DNS_RESOLVER_CACHE_PREFETCH)
+ZTEST(net_dns_cache_test, test_prefetch)
+{
+	struct dns_addrinfo info_write = {.ai_family = AF_INET};
+	struct dns_addrinfo info_read[2] = {0};
+	const char *query = "example.com";
+	enum dns_query_type query_type = DNS_QUERY_TYPE_A;
+
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_false(dns_cache_prefetch_due(&test_dns_cache, query, query_type));
+
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 * 95 / 100));
+	zassert_true(dns_cache_prefetch_due(&test_dns_cache, query, query_type));
+	zassert_false(dns_cache_prefetch_due(&test_dns_cache, query, query_type),
+		      "Refresh should only be requested once.");
+
+	/* The refreshed answer extends the entry instead of adding one */
+	zassert_ok(dns_cache_add(&test_dns_cache, query, &info_write, TEST_DNS_CACHE_DEFAULT_TTL),
+		   "Cache entry adding should work.");
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+	k_sleep(K_MSEC(TEST_DNS_CACHE_DEFAULT_TTL * 1000 * 10 / 100));
+	zassert_equal(1, dns_cache_find(&test_dns_cache, query, query_type, info_read, 2));
+}
+#endif /* CONFIG_DNS_RESOLVER_CACHE_PREFETCH */
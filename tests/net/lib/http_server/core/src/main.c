@@ -628,7 +628,7 @@ static void expect_contains_header(const uint8_t *buffer, size_t len,
 {
 	int ret;
 	bool found = false;
-	struct http_hpack_header_buf header_buf;
+	struct http_hpack_header_buf header_buf = { 0 };
 	size_t consumed = 0;
 
 	while (consumed < len) {
@@ -2495,6 +2495,7 @@ ZTEST(server_function_tests_no_init, test_parse_http_frames)
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/littlefs.h>
+#include <zephyr/sys/crc.h>
 
 FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
 
@@ -2675,23 +2676,48 @@ static int setup_fs(const char *file_ending)
 	return test_mkdir(TEST_DIR_PATH, filename_buf);
 }
 
+#define STATIC_FS_ETAG_HEADER "ETag: \"%08x\"\r\n"
+
+/* Cached files are served with an ETag header */
+static const char *static_fs_etag_header(void)
+{
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+	static char etag_header[sizeof(STATIC_FS_ETAG_HEADER)];
+
+	snprintf(etag_header, sizeof(etag_header), STATIC_FS_ETAG_HEADER,
+		 crc32_ieee((const uint8_t *)TEST_STATIC_FS_PAYLOAD,
+			    sizeof(TEST_STATIC_FS_PAYLOAD) - 1));
+
+	return etag_header;
+#else
+	return "";
+#endif
+}
+
 ZTEST(server_function_tests, test_http1_static_fs)
 {
+#define HTTP1_STATIC_FS_RESPONSE                                                                   \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Length: 30\r\n"                                                                   \
+	"Content-Type: text/html\r\n"                                                              \
+	"%s"                                                                                       \
+	"\r\n" TEST_STATIC_FS_PAYLOAD
+
 	static const char http1_request[] =
 		"GET /static_file.html HTTP/1.1\r\n"
 		"Host: 127.0.0.1:8080\r\n"
 		"User-Agent: curl/7.68.0\r\n"
 		"Accept: */*\r\n"
 		"\r\n";
-	static const char expected_response[] =
-		"HTTP/1.1 200 OK\r\n"
-		"Content-Length: 30\r\n"
-		"Content-Type: text/html\r\n"
-		"\r\n"
-		TEST_STATIC_FS_PAYLOAD;
+	static char expected_response[sizeof(HTTP1_STATIC_FS_RESPONSE) +
+				      sizeof(STATIC_FS_ETAG_HEADER)];
+	int expected_response_size;
 	size_t offset = 0;
 	int ret;
 
+	expected_response_size = sprintf(expected_response, HTTP1_STATIC_FS_RESPONSE,
+					 static_fs_etag_header());
+
 	ret = setup_fs("");
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -2700,10 +2726,52 @@ ZTEST(server_function_tests, test_http1_static_fs)
 
 	memset(buf, 0, sizeof(buf));
 
-	test_read_data(&offset, sizeof(expected_response) - 1);
-	zassert_mem_equal(buf, expected_response, sizeof(expected_response) - 1,
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
+			  "Received data doesn't match expected response");
+}
+
+#if defined(CONFIG_HTTP_SERVER_STATIC_FS_CACHE)
+ZTEST(server_function_tests, test_http1_static_fs_not_modified)
+{
+#define HTTP1_IF_NONE_MATCH_REQUEST                                                                \
+	"GET /static_file.html HTTP/1.1\r\n"                                                       \
+	"Host: 127.0.0.1:8080\r\n"                                                                 \
+	"User-Agent: curl/7.68.0\r\n"                                                              \
+	"Accept: */*\r\n"                                                                          \
+	"If-None-Match: \"%08x\"\r\n"                                                              \
+	"\r\n"
+#define HTTP1_NOT_MODIFIED_RESPONSE                                                                \
+	"HTTP/1.1 304 Not Modified\r\n"                                                            \
+	"%s"                                                                                       \
+	"\r\n"
+
+	static char http1_request[sizeof(HTTP1_IF_NONE_MATCH_REQUEST) + 8];
+	static char expected_response[sizeof(HTTP1_NOT_MODIFIED_RESPONSE) +
+				      sizeof(STATIC_FS_ETAG_HEADER)];
+	int expected_response_size;
+	size_t offset = 0;
+	int ret;
+
+	sprintf(http1_request, HTTP1_IF_NONE_MATCH_REQUEST,
+		crc32_ieee((const uint8_t *)TEST_STATIC_FS_PAYLOAD,
+			   sizeof(TEST_STATIC_FS_PAYLOAD) - 1));
+	expected_response_size = sprintf(expected_response, HTTP1_NOT_MODIFIED_RESPONSE,
+					 static_fs_etag_header());
+
+	ret = setup_fs("");
+	zassert_equal(ret, TC_PASS, "Failed to mount fs");
+
+	ret = zsock_send(client_fd, http1_request, strlen(http1_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	test_read_data(&offset, expected_response_size);
+	zassert_mem_equal(buf, expected_response, expected_response_size,
 			  "Received data doesn't match expected response");
 }
+#endif /* CONFIG_HTTP_SERVER_STATIC_FS_CACHE */
 
 ZTEST(server_function_tests, test_http1_static_fs_compression)
 {
@@ -2719,13 +2787,15 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	"Content-Length: 30\r\n"                                                                   \
 	"Content-Type: text/html\r\n"                                                              \
 	"Content-Encoding: %s\r\n"                                                                 \
+	"%s"                                                                                       \
 	"\r\n" TEST_STATIC_FS_PAYLOAD
 
 	static const char mixed_compression_str[] = "gzip, deflate, br";
 	static char http1_request[sizeof(HTTP1_COMPRESSION_REQUEST) +
 				  ARRAY_SIZE(mixed_compression_str)] = {0};
 	static char expected_response[sizeof(HTTP1_COMPRESSION_RESPONSE) +
-				      HTTP_COMPRESSION_MAX_STRING_LEN] = {0};
+				      HTTP_COMPRESSION_MAX_STRING_LEN +
+				      sizeof(STATIC_FS_ETAG_HEADER)] = {0};
 	static const char *const file_ending_map[] = {[HTTP_GZIP] = ".gz",
 						      [HTTP_COMPRESS] = ".lzw",
 						      [HTTP_DEFLATE] = ".zz",
@@ -2747,7 +2817,8 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 
 		sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, http_compression_text(i));
 		expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-						 http_compression_text(i));
+						 http_compression_text(i),
+						 static_fs_etag_header());
 
 		ret = setup_fs(file_ending_map[i]);
 		zassert_equal(ret, TC_PASS, "Failed to mount fs");
@@ -2766,7 +2837,7 @@ ZTEST(server_function_tests, test_http1_static_fs_compression)
 	TC_PRINT("Testing mixed compression...\n");
 	sprintf(http1_request, HTTP1_COMPRESSION_REQUEST, mixed_compression_str);
 	expected_response_size = sprintf(expected_response, HTTP1_COMPRESSION_RESPONSE,
-					 http_compression_text(HTTP_BR));
+					 http_compression_text(HTTP_BR), static_fs_etag_header());
 	ret = setup_fs(file_ending_map[HTTP_BR]);
 	zassert_equal(ret, TC_PASS, "Failed to mount fs");
 
@@ -268,7 +268,7 @@ static void test_hpack_verify_decode(const struct example_headers *example,
 				     size_t num_examples)
 {
 	for (int i = 0; i < num_examples; i++) {
-		struct http_hpack_header_buf hdr;
+		struct http_hpack_header_buf hdr = { 0 };
 		int ret;
 
 		ret = http_hpack_decode_header(example[i].encoded, example[i].encoded_len, &hdr);
@@ -494,4 +494,149 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+/* Requests from RFC7541, C.3, decoded with the same dynamic table. */
+static const struct example_headers test_dynamic_request_1[] = {
+	{ ":method", "GET", { 0x82 }, 1 },
+	{ ":scheme", "http", { 0x86 }, 1 },
+	{ ":path", "/", { 0x84 }, 1 },
+	{ ":authority", "www.example.com",
+	  { 0x41, 0x0f, 0x77, 0x77, 0x77, 0x2e, 0x65, 0x78,
+	    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f,
+	    0x6d },
+	  17 },
+};
+
+static const struct example_headers test_dynamic_request_2[] = {
+	{ ":method", "GET", { 0x82 }, 1 },
+	{ ":scheme", "http", { 0x86 }, 1 },
+	{ ":path", "/", { 0x84 }, 1 },
+	{ ":authority", "www.example.com", { 0xbe }, 1 },
+	{ "cache-control", "no-cache",
+	  { 0x58, 0x08, 0x6e, 0x6f, 0x2d, 0x63, 0x61, 0x63,
+	    0x68, 0x65 },
+	  10 },
+};
+
+static const struct example_headers test_dynamic_request_3[] = {
+	{ ":method", "GET", { 0x82 }, 1 },
+	{ ":scheme", "https", { 0x87 }, 1 },
+	{ ":path", "/index.html", { 0x85 }, 1 },
+	{ ":authority", "www.example.com", { 0xbf }, 1 },
+	{ "custom-key", "custom-value",
+	  { 0x40, 0x0a, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d,
+	    0x2d, 0x6b, 0x65, 0x79, 0x0c, 0x63, 0x75, 0x73,
+	    0x74, 0x6f, 0x6d, 0x2d, 0x76, 0x61, 0x6c, 0x75,
+	    0x65 },
+	  25 },
+	{ "custom-key", "custom-value", { 0xbe }, 1 },
+};
+
+static struct http_hpack_dynamic_table test_dynamic_table;
+
+static void test_hpack_verify_dynamic_decode(const struct example_headers *example,
+					     size_t num_examples)
+{
+	for (int i = 0; i < num_examples; i++) {
+		struct http_hpack_header_buf hdr = {
+			.dynamic_table = &test_dynamic_table,
+		};
+		int ret;
+
+		ret = http_hpack_decode_header(example[i].encoded, example[i].encoded_len, &hdr);
+		zassert_equal(ret, example[i].encoded_len, "Wrong decoding length");
+		zassert_equal(hdr.name_len, strlen(example[i].name),
+			      "Wrong decoded header name length");
+		zassert_equal(hdr.value_len, strlen(example[i].value),
+			      "Wrong decoded header value length");
+		zassert_mem_equal(hdr.name, example[i].name, hdr.name_len,
+				  "Header name wrongly decoded");
+		zassert_mem_equal(hdr.value, example[i].value, hdr.value_len,
+				  "Header value wrongly decoded");
+	}
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_decode)
+{
+	http_hpack_dynamic_table_init(&test_dynamic_table, 4096);
+
+	test_hpack_verify_dynamic_decode(test_dynamic_request_1,
+					 ARRAY_SIZE(test_dynamic_request_1));
+	zassert_equal(test_dynamic_table.size, 57, "Wrong dynamic table size");
+
+	test_hpack_verify_dynamic_decode(test_dynamic_request_2,
+					 ARRAY_SIZE(test_dynamic_request_2));
+	zassert_equal(test_dynamic_table.size, 110, "Wrong dynamic table size");
+
+	test_hpack_verify_dynamic_decode(test_dynamic_request_3,
+					 ARRAY_SIZE(test_dynamic_request_3));
+	zassert_equal(test_dynamic_table.size, 164, "Wrong dynamic table size");
+	zassert_equal(test_dynamic_table.count, 3, "Wrong dynamic table entry count");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_eviction)
+{
+	struct http_hpack_header_buf hdr = {
+		.dynamic_table = &test_dynamic_table,
+	};
+	uint8_t indexed = 0xbe;
+	int ret;
+
+	/* Room for a single entry, so that every insertion evicts the
+	 * previous one and the stored strings wrap around the table.
+	 */
+	http_hpack_dynamic_table_init(&test_dynamic_table, 80);
+
+	for (int i = 0; i < 500; i++) {
+		size_t value_len = 10 + i % 5;
+		uint8_t encoded[32] = { 0x40, 0x05, 'a', 'b', 'c', 'd', 'e' };
+
+		encoded[7] = value_len;
+		memset(&encoded[8], '0' + i % 10, value_len);
+
+		ret = http_hpack_decode_header(encoded, 8 + value_len, &hdr);
+		zassert_equal(ret, 8 + value_len, "Wrong decoding length");
+		zassert_equal(test_dynamic_table.count, 1, "Wrong dynamic table entry count");
+
+		ret = http_hpack_decode_header(&indexed, sizeof(indexed), &hdr);
+		zassert_equal(ret, sizeof(indexed), "Wrong decoding length");
+		zassert_equal(hdr.name_len, 5, "Wrong decoded header name length");
+		zassert_mem_equal(hdr.name, "abcde", hdr.name_len,
+				  "Header name wrongly decoded");
+		zassert_equal(hdr.value_len, value_len, "Wrong decoded header value length");
+		for (int j = 0; j < value_len; j++) {
+			zassert_equal(hdr.value[j], '0' + i % 10, "Header value wrongly decoded");
+		}
+	}
+
+	/* Only one entry in the table. */
+	indexed = 0xbf;
+	ret = http_hpack_decode_header(&indexed, sizeof(indexed), &hdr);
+	zassert_equal(ret, -EBADMSG, "Out of range index should fail");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_table_size_update)
+{
+	struct http_hpack_header_buf hdr = {
+		.dynamic_table = &test_dynamic_table,
+	};
+	/* Size update to 4097, above the default table size. */
+	const uint8_t too_large[] = { 0x3f, 0xe2, 0x1f };
+	const uint8_t clear = 0x20;
+	int ret;
+
+	http_hpack_dynamic_table_init(&test_dynamic_table, 4096);
+	test_hpack_verify_dynamic_decode(test_dynamic_request_1,
+					 ARRAY_SIZE(test_dynamic_request_1));
+	zassert_equal(test_dynamic_table.count, 1, "Wrong dynamic table entry count");
+
+	ret = http_hpack_decode_header(&clear, sizeof(clear), &hdr);
+	zassert_equal(ret, sizeof(clear), "Wrong decoding length");
+	zassert_equal(hdr.name_len, 0, "Size update should not carry a header");
+	zassert_equal(test_dynamic_table.count, 0, "Dynamic table should be empty");
+	zassert_equal(test_dynamic_table.size, 0, "Dynamic table should be empty");
+
+	ret = http_hpack_decode_header(too_large, sizeof(too_large), &hdr);
+	zassert_equal(ret, -EBADMSG, "Too large size update should fail");
+}
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
@@ -501,4 +501,81 @@ ZTEST(lwm2m_observation, test_add_path_to_list_duplicate)
 	run_insertion_test(insert_path_str, ARRAY_SIZE(insert_path_str), expected_path_str);
 }
 
+#if defined(CONFIG_LWM2M_COMPOSITE_NOTIFY_CHANGED_ONLY)
+static void assert_path_list_equal(sys_slist_t *lwm2m_path_list, char const *expected_path_str[],
+				   int expected_count)
+{
+	struct lwm2m_obj_path_list *entry;
+	int path_num = 0;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(lwm2m_path_list, entry, node) {
+		struct lwm2m_obj_path expected_path;
+
+		zassert_true(path_num < expected_count, "Too many paths");
+		lwm2m_string_to_path(expected_path_str[path_num++], &expected_path, '/');
+		zassert_mem_equal(&entry->path, &expected_path, sizeof(struct lwm2m_obj_path),
+				  "Path #%d did not match expectation", path_num);
+	}
+
+	zassert_equal(path_num, expected_count, "Missing paths");
+}
+
+ZTEST(lwm2m_observation, test_split_unchanged_paths)
+{
+	/* clang-format off */
+	char const *path_str[] = {
+		LWM2M_PATH(1, 0, 1),
+		LWM2M_PATH(1, 0, 2),
+		LWM2M_PATH(3, 0, 1),
+		LWM2M_PATH(3, 0, 2),
+	};
+
+	char const *changed_path_str[] = {
+		LWM2M_PATH(1, 0, 2),
+		LWM2M_PATH(3, 0, 2),
+	};
+
+	char const *unchanged_path_str[] = {
+		LWM2M_PATH(1, 0, 1),
+		LWM2M_PATH(3, 0, 1),
+	};
+	/* clang-format on */
+
+	struct lwm2m_obj_path_list lwm2m_path_list_buf[ARRAY_SIZE(path_str)];
+	sys_slist_t lwm2m_path_free_list;
+	struct observe_node obs = { 0 };
+	struct lwm2m_obj_path path;
+	sys_slist_t unchanged;
+	uint32_t dirty_paths;
+
+	lwm2m_engine_path_list_init(&obs.path_list, &lwm2m_path_free_list, lwm2m_path_list_buf,
+				    ARRAY_SIZE(path_str));
+
+	for (int i = 0; i < ARRAY_SIZE(path_str); ++i) {
+		lwm2m_string_to_path(path_str[i], &path, '/');
+		zassert_ok(lwm2m_engine_add_path_to_list(&obs.path_list, &lwm2m_path_free_list,
+							 &path));
+	}
+
+	/* GIVEN: no resource update, nothing is left out */
+	obs.dirty_paths = BIT(1) | BIT(3);
+	dirty_paths = lwm2m_observe_split_unchanged(&obs, &unchanged);
+	zassert_true(sys_slist_is_empty(&unchanged));
+	lwm2m_observe_merge_unchanged(&obs, &unchanged, dirty_paths);
+	assert_path_list_equal(&obs.path_list, path_str, ARRAY_SIZE(path_str));
+
+	/* WHEN: splitting after an update of the second and fourth path */
+	obs.resource_update = true;
+	dirty_paths = lwm2m_observe_split_unchanged(&obs, &unchanged);
+
+	/* THEN: only the updated paths are left in the list */
+	assert_path_list_equal(&obs.path_list, changed_path_str, ARRAY_SIZE(changed_path_str));
+	assert_path_list_equal(&unchanged, unchanged_path_str, ARRAY_SIZE(unchanged_path_str));
+
+	/* AND: merging restores the original order */
+	lwm2m_observe_merge_unchanged(&obs, &unchanged, dirty_paths);
+	assert_path_list_equal(&obs.path_list, path_str, ARRAY_SIZE(path_str));
+}
+#endif
+
 ZTEST_SUITE(lwm2m_observation, NULL, NULL, NULL, NULL, NULL);
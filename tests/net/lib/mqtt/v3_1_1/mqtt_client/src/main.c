@@ -751,6 +751,85 @@ ZTEST(mqtt_client, test_mqtt_publish_qos2)
 	test_disconnect();
 }
 
+ZTEST(mqtt_client, test_mqtt_publish_batch)
+{
+	struct mqtt_publish_param params[3];
+	int ret;
+
+	test_ctx.payload = payload_short;
+
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		params[i].message.topic.qos = MQTT_QOS_0_AT_MOST_ONCE;
+		params[i].message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+		params[i].message.topic.topic.size = strlen(get_mqtt_topic());
+		params[i].message.payload.data = (uint8_t *)test_ctx.payload;
+		params[i].message.payload.len = strlen(test_ctx.payload);
+		params[i].message_id = 0U;
+		params[i].dup_flag = 0U;
+		params[i].retain_flag = 0U;
+	}
+
+	test_connect();
+
+	ret = mqtt_publish_batch(&client_ctx, params, ARRAY_SIZE(params));
+	zassert_equal(ret, ARRAY_SIZE(params), "MQTT client failed to publish (%d)", ret);
+
+	for (int i = 0; i < ARRAY_SIZE(params); i++) {
+		broker_process(MQTT_PKT_TYPE_PUBLISH);
+	}
+
+	test_disconnect();
+}
+
+#if defined(CONFIG_MQTT_INFLIGHT_WINDOW)
+ZTEST(mqtt_client, test_mqtt_publish_inflight_window)
+{
+	struct mqtt_publish_param param;
+	int ret;
+
+	zassert_equal(CONFIG_MQTT_INFLIGHT_MAX, 1, "Test expects a window of 1");
+
+	test_ctx.payload = payload_short;
+	test_ctx.msg_id = 1U;
+
+	param.message.topic.qos = MQTT_QOS_1_AT_LEAST_ONCE;
+	param.message.topic.topic.utf8 = (uint8_t *)get_mqtt_topic();
+	param.message.topic.topic.size = strlen(get_mqtt_topic());
+	param.message.payload.data = (uint8_t *)test_ctx.payload;
+	param.message.payload.len = strlen(test_ctx.payload);
+	param.message_id = 1U;
+	param.dup_flag = 0U;
+	param.retain_flag = 0U;
+
+	test_connect();
+
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	/* The window is full until the PUBACK is processed. */
+	param.message_id = 2U;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_equal(ret, -EAGAIN, "Publish should be refused (%d)", ret);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+	zassert_true(test_ctx.puback_handled, "MQTT client should receive puback");
+
+	test_ctx.msg_id = 2U;
+	ret = mqtt_publish(&client_ctx, &param);
+	zassert_ok(ret, "MQTT client failed to publish (%d)", ret);
+	broker_process(MQTT_PKT_TYPE_PUBLISH);
+
+	client_wait(false);
+	ret = mqtt_input(&client_ctx);
+	zassert_ok(ret, "MQTT client input processing failed (%d)", ret);
+
+	test_disconnect();
+}
+#endif /* CONFIG_MQTT_INFLIGHT_WINDOW */
+
 ZTEST(mqtt_client, test_mqtt_subscribe)
 {
 	test_connect();
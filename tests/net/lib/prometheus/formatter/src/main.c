@@ -11,6 +11,8 @@
 #include <zephyr/net/prometheus/formatter.h>
 
 #define MAX_BUFFER_SIZE 256
+/* Holds one of the test metrics, but not two */
+#define CHUNK_SIZE 128
 
 PROMETHEUS_COUNTER_DEFINE(test_counter, "Test counter",
 			  ({ .key = "test", .value = "counter" }), NULL);
@@ -63,4 +65,55 @@ ZTEST(test_formatter, test_prometheus_formatter_simple)
 		      exposed, formatted);
 }
 
+/**
+ * @brief Test Prometheus formatter in chunks
+ * @details The test shall format the exposition data in chunks too small to
+ * hold all the metrics, and check that the chunks hold whole metrics and add
+ * up to the output of the one shot formatter.
+ */
+ZTEST(test_formatter, test_prometheus_formatter_chunks)
+{
+	int ret;
+	char formatted[MAX_BUFFER_SIZE] = { 0 };
+	char chunked[MAX_BUFFER_SIZE] = { 0 };
+	char chunk[CHUNK_SIZE];
+	struct prometheus_collector_walk_context ctx;
+	size_t len = 0;
+	int chunks = 0;
+
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter.base);
+	prometheus_collector_register_metric(&test_custom_collector, &test_counter2.base);
+
+	ret = prometheus_format_exposition(&test_custom_collector, formatted, sizeof(formatted));
+	zassert_ok(ret, "Error formatting exposition data");
+
+	ret = prometheus_collector_walk_init(&ctx, &test_custom_collector);
+	zassert_ok(ret, "Error initializing walk context");
+
+	while (ctx.state != PROMETHEUS_WALK_STOP) {
+		ret = prometheus_format_exposition_chunk(&ctx, chunk, sizeof(chunk));
+		zassert_true(ret > 0, "Error formatting chunk (%d)", ret);
+		zassert_equal(strncmp(chunk, "# HELP", strlen("# HELP")), 0,
+			      "Chunk does not start with a metric");
+		zassert_true(len + ret < sizeof(chunked), "Too much data");
+
+		memcpy(chunked + len, chunk, ret);
+		len += ret;
+		chunks++;
+	}
+
+	zassert_equal(chunks, 2, "Unexpected number of chunks %d", chunks);
+	zassert_equal(strcmp(chunked, formatted), 0,
+		      "Chunks are not as expected (expected\n\"%s\", got\n\"%s\")",
+		      formatted, chunked);
+
+	ret = prometheus_format_exposition_chunk(&ctx, chunk, sizeof(chunk));
+	zassert_equal(ret, 0, "Data after the end of the walk");
+
+	/* A metric larger than the buffer cannot be split */
+	(void)prometheus_collector_walk_init(&ctx, &test_custom_collector);
+	ret = prometheus_format_exposition_chunk(&ctx, chunk, 32);
+	zassert_equal(ret, -ENOMEM, "Metric should not fit (%d)", ret);
+}
+
 ZTEST_SUITE(test_formatter, NULL, NULL, NULL, NULL, NULL);
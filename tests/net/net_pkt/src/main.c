@@ -1291,4 +1291,70 @@ ZTEST(net_pkt_test_suite, test_net_pkt_shallow_clone_append_buf_2)
 	test_net_pkt_shallow_clone_append_buf(2);
 }
 
+ZTEST(net_pkt_test_suite, test_net_pkt_bulk)
+{
+	struct net_pkt *pkts[4];
+	struct net_buf_pool *rx_data;
+	struct k_mem_slab *rx;
+	uint32_t free_pkts;
+	int count;
+
+	net_pkt_get_info(&rx, NULL, &rx_data, NULL);
+	free_pkts = k_mem_slab_num_free_get(rx);
+
+	count = net_pkt_rx_alloc_bulk(NULL, 64, AF_INET, IPPROTO_UDP,
+				      pkts, ARRAY_SIZE(pkts));
+	zassert_equal(count, ARRAY_SIZE(pkts), "Pkts not allocated");
+	zassert_equal(k_mem_slab_num_free_get(rx), free_pkts - count,
+		      "Incorrect net pkt allocation");
+	zassert_equal(atomic_get(&rx_data->avail_count),
+		      rx_data->buf_count - count,
+		      "Incorrect net buf allocation");
+
+	for (int i = 0; i < count; i++) {
+		zassert_not_null(pkts[i]->buffer, "Pkt has no buffer");
+		zassert_equal(net_pkt_family(pkts[i]), AF_INET,
+			      "Wrong family");
+		zassert_true(net_pkt_available_payload_buffer(pkts[i],
+							      IPPROTO_UDP) >= 64,
+			     "Buffer too small");
+	}
+
+	/* A packet still referenced elsewhere is kept */
+	net_pkt_ref(pkts[0]);
+	net_pkt_unref_bulk(pkts, count);
+
+	zassert_equal(k_mem_slab_num_free_get(rx), free_pkts - 1,
+		      "Incorrect net pkt release");
+	zassert_equal(atomic_get(&rx_data->avail_count),
+		      rx_data->buf_count - 1,
+		      "Incorrect net buf release");
+
+	net_pkt_unref(pkts[0]);
+
+	zassert_equal(k_mem_slab_num_free_get(rx), free_pkts, "Leak detected");
+	zassert_equal(atomic_get(&rx_data->avail_count), rx_data->buf_count,
+		      "Leak detected");
+}
+
+#if defined(CONFIG_NET_PKT_INLINE_DATA)
+ZTEST(net_pkt_test_suite, test_net_pkt_inline_data)
+{
+	struct net_pkt *pkt;
+	size_t size;
+
+	/* Too big for one fragment but small enough for a contiguous buffer */
+	size = CONFIG_NET_PKT_INLINE_DATA_SIZE - NET_IPV4UDPH_LEN;
+
+	pkt = net_pkt_alloc_with_buffer(NULL, size, AF_INET, IPPROTO_UDP,
+					K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+	zassert_is_null(pkt->buffer->frags, "Pkt buffer is not contiguous");
+	zassert_true(net_buf_max_len(pkt->buffer) >= size + NET_IPV4UDPH_LEN,
+		     "Pkt size is not right");
+
+	net_pkt_unref(pkt);
+}
+#endif /* CONFIG_NET_PKT_INLINE_DATA */
+
 ZTEST_SUITE(net_pkt_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -544,6 +544,44 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *route_64, *route_96, *entry;
+
+	route_64 = net_route_add(my_iface,
+				 &dest_addr, 64,
+				 &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_64, "Route add failed");
+
+	route_96 = net_route_add(my_iface,
+				 &dest_addr, 96,
+				 &peer_addr_alt,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_96, "Route add failed");
+	zassert_not_equal(route_96, route_64, "Routes are the same");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, route_96, "Longest prefix not matched");
+
+	entry = net_route_lookup(my_iface, &generic_addr);
+	zassert_equal_ptr(entry, route_96, "Longest prefix not matched");
+
+	entry = net_route_lookup(my_iface, &ll_addr);
+	zassert_is_null(entry, "Route found for unrelated address");
+
+	net_route_del(route_96);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, route_64, "Shorter prefix not matched");
+
+	net_route_del(route_64);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Route found after delete");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +604,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
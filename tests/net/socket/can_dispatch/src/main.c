@@ -0,0 +1,138 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/can.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socketcan.h>
+#include <zephyr/net/socketcan_utils.h>
+#include <zephyr/ztest.h>
+
+/* Frames are looped back by the CAN driver, give them time to come back */
+#define LOOPBACK_DELAY K_MSEC(100)
+
+static const struct device *const can_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_canbus));
+
+static int create_socket(uint32_t id, uint32_t mask)
+{
+	const struct can_filter zfilter = {
+		.id = id,
+		.mask = mask,
+	};
+	struct socketcan_filter sfilter;
+	struct sockaddr_can can_addr = { 0 };
+	struct net_if *iface;
+	int fd;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(CANBUS_RAW));
+	zassert_not_null(iface, "No CANBUS network interface");
+
+	fd = zsock_socket(AF_CAN, SOCK_RAW, CAN_RAW);
+	zassert_true(fd >= 0, "Cannot create CAN socket (%d)", errno);
+
+	can_addr.can_ifindex = net_if_get_by_iface(iface);
+	can_addr.can_family = PF_CAN;
+	zassert_ok(zsock_bind(fd, (struct sockaddr *)&can_addr, sizeof(can_addr)),
+		   "Cannot bind CAN socket (%d)", errno);
+
+	socketcan_from_can_filter(&zfilter, &sfilter);
+	zassert_ok(zsock_setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &sfilter, sizeof(sfilter)),
+		   "Cannot set CAN filter (%d)", errno);
+
+	return fd;
+}
+
+static void send_frame(int fd, uint32_t id)
+{
+	struct can_frame zframe = {
+		.id = id,
+		.dlc = 1U,
+		.data = { (uint8_t)id },
+	};
+	struct socketcan_frame sframe;
+
+	socketcan_from_can_frame(&zframe, &sframe);
+	zassert_equal(zsock_send(fd, &sframe, sizeof(sframe), 0), sizeof(sframe),
+		      "Cannot send CAN frame (%d)", errno);
+}
+
+/* Receive all the queued frames, expecting exactly the given IDs in order */
+static void expect_frames(int fd, const uint32_t *ids, size_t count)
+{
+	struct socketcan_frame sframe;
+	struct can_frame zframe;
+	size_t received = 0;
+
+	while (zsock_recv(fd, &sframe, sizeof(sframe), ZSOCK_MSG_DONTWAIT) == sizeof(sframe)) {
+		socketcan_to_can_frame(&sframe, &zframe);
+
+		zassert_true(received < count, "Unexpected frame 0x%x on fd %d", zframe.id, fd);
+		zassert_equal(zframe.id, ids[received], "Got frame 0x%x instead of 0x%x on fd %d",
+			      zframe.id, ids[received], fd);
+		received++;
+	}
+
+	zassert_equal(received, count, "Got %zu frames instead of %zu on fd %d", received, count,
+		      fd);
+}
+
+/*
+ * Receivers of the same hash bucket must only get their own frames, while
+ * receivers whose filter does not cover the hashed bits see every frame
+ * matching their filter. Receivers sharing a filter each get the frame.
+ */
+ZTEST(socket_can_dispatch, test_dispatch)
+{
+	/* 0x123 and 0x133 share the low ID bits, thus their hash bucket */
+	const uint32_t ids_a[] = { 0x123 };
+	const uint32_t ids_b[] = { 0x133 };
+	/* Does not cover the low ID bits, checked against every frame */
+	const uint32_t ids_c[] = { 0x703, 0x7f0 };
+	int fd_a, fd_a2, fd_b, fd_c;
+
+	fd_a = create_socket(0x123, CAN_STD_ID_MASK);
+	fd_a2 = create_socket(0x123, CAN_STD_ID_MASK);
+	fd_b = create_socket(0x133, CAN_STD_ID_MASK);
+	fd_c = create_socket(0x700, 0x700);
+
+	send_frame(fd_a, 0x123);
+	send_frame(fd_a, 0x133);
+	send_frame(fd_a, 0x703);
+	send_frame(fd_a, 0x7f0);
+	/* Matches no receiver, in the bucket of 0x123 */
+	send_frame(fd_a, 0x143);
+
+	k_sleep(LOOPBACK_DELAY);
+
+	expect_frames(fd_a, ids_a, ARRAY_SIZE(ids_a));
+	expect_frames(fd_a2, ids_a, ARRAY_SIZE(ids_a));
+	expect_frames(fd_b, ids_b, ARRAY_SIZE(ids_b));
+	expect_frames(fd_c, ids_c, ARRAY_SIZE(ids_c));
+
+	/* Closed sockets are removed from their bucket */
+	zassert_ok(zsock_close(fd_a2));
+	send_frame(fd_a, 0x123);
+
+	k_sleep(LOOPBACK_DELAY);
+
+	expect_frames(fd_a, ids_a, ARRAY_SIZE(ids_a));
+	expect_frames(fd_b, NULL, 0);
+	expect_frames(fd_c, NULL, 0);
+
+	zassert_ok(zsock_close(fd_a));
+	zassert_ok(zsock_close(fd_b));
+	zassert_ok(zsock_close(fd_c));
+}
+
+static void *setup(void)
+{
+	zassert_true(device_is_ready(can_dev), "CAN device not ready");
+	zassert_ok(can_start(can_dev));
+
+	return NULL;
+}
+
+ZTEST_SUITE(socket_can_dispatch, NULL, setup, NULL, NULL, NULL);
@@ -2430,6 +2430,47 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "none", sizeof("none"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno", strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "reno", "getsockopt got invalid value");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_str_equal(name, "cubic", "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -2502,6 +2543,114 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+static K_SEM_DEFINE(zerocopy_sem, 0, 1);
+static const void *zerocopy_buf;
+static size_t zerocopy_len;
+static int zerocopy_status;
+
+static void zerocopy_cb(const void *buf, size_t len, int status, void *user_data)
+{
+	zassert_equal_ptr(user_data, &zerocopy_sem, "wrong user data");
+
+	zerocopy_buf = buf;
+	zerocopy_len = len;
+	zerocopy_status = status;
+	k_sem_give(&zerocopy_sem);
+}
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
+
+ZTEST(net_socket_tcp, test_v4_send_zerocopy)
+{
+#if defined(CONFIG_NET_TCP_ZEROCOPY)
+	static const char data[] = TEST_STR_LONG;
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	char rx_buf[sizeof(data)];
+	size_t received = 0;
+	int ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	ret = zsock_send_zerocopy(c_sock, data, sizeof(data), 0, zerocopy_cb,
+				  &zerocopy_sem);
+	zassert_equal(ret, sizeof(data), "send failed (%d)", errno);
+
+	while (received < sizeof(data)) {
+		ret = zsock_recv(new_sock, rx_buf + received,
+				 sizeof(rx_buf) - received, 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		received += ret;
+	}
+
+	zassert_mem_equal(rx_buf, data, sizeof(data), "invalid data");
+
+	/* The buffer is released once the data is acknowledged */
+	zassert_ok(k_sem_take(&zerocopy_sem, K_SECONDS(1)), "no completion");
+	zassert_equal_ptr(zerocopy_buf, data, "wrong buffer");
+	zassert_equal(zerocopy_len, sizeof(data), "wrong length");
+	zassert_equal(zerocopy_status, 0, "wrong status");
+
+	/* Not available on other socket types */
+	ret = zsock_send_zerocopy(s_sock, data, sizeof(data), 0, zerocopy_cb,
+				  &zerocopy_sem);
+	zassert_equal(ret, -1, "send succeeded on a listening socket");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_TCP_ZEROCOPY */
+}
+
+ZTEST(net_socket_tcp, test_v4_recv_zerocopy)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	char rx_buf[sizeof(TEST_STR_SMALL) - 1];
+	struct net_buf *frags;
+	ssize_t len;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+
+	len = zsock_recv_zerocopy(new_sock, &frags, 0, NULL, NULL);
+	zassert_equal(len, strlen(TEST_STR_SMALL), "recv_zerocopy failed (%d)", errno);
+	zassert_equal(net_buf_frags_len(frags), len, "invalid length");
+	zassert_equal(net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+					sizeof(rx_buf)), len);
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL, len, "invalid data");
+	net_buf_unref(frags);
+
+	/* End of stream once the peer is gone */
+	test_shutdown(c_sock, ZSOCK_SHUT_WR);
+	len = zsock_recv_zerocopy(new_sock, &frags, 0, NULL, NULL);
+	zassert_equal(len, 0, "no end of stream (%d)", errno);
+	zassert_is_null(frags, "unexpected buffers");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -220,6 +220,7 @@ static int test_configure_server(k_tid_t *server_thread_id, int peer_verify,
 	const sec_tag_t *sec_tag_list;
 	size_t sec_tag_list_size;
 	struct sockaddr_in sa;
+	const int session_cache = TLS_SESSION_CACHE_ENABLED;
 	const int yes = true;
 	char *addrstrp;
 	int server_fd;
@@ -264,6 +265,10 @@ static int test_configure_server(k_tid_t *server_thread_id, int peer_verify,
 		       sizeof("localhost"));
 	zassert_not_equal(r, -1, "failed to set TLS_HOSTNAME (%d)", errno);
 
+	r = setsockopt(server_fd, SOL_TLS, TLS_SESSION_CACHE, &session_cache,
+		       sizeof(session_cache));
+	zassert_not_equal(r, -1, "failed to set TLS_SESSION_CACHE (%d)", errno);
+
 	memset(&sa, 0, sizeof(sa));
 	/* The server listens on all network interfaces */
 	sa.sin_addr.s_addr = INADDR_ANY;
@@ -546,6 +551,54 @@ ZTEST(net_socket_tls_api_extension, test_tls_cert_verify_cb_opt_bad_cert)
 	test_tls_cert_verify_cb_opt_common(MBEDTLS_ERR_X509_CERT_VERIFY_FAILED);
 }
 
+static void test_tls_session_cache_connect(struct tls_session_cache_stats *stats,
+					   bool purge)
+{
+	const int session_cache = TLS_SESSION_CACHE_ENABLED;
+	socklen_t optlen = sizeof(*stats);
+	int server_fd, client_fd, ret;
+	k_tid_t server_thread_id;
+	struct sockaddr_in sa;
+
+	server_fd = test_configure_server(&server_thread_id, TLS_PEER_VERIFY_NONE,
+					  false, false);
+	client_fd = test_configure_client(&sa, false, "localhost");
+
+	ret = zsock_setsockopt(client_fd, SOL_TLS, TLS_SESSION_CACHE,
+			       &session_cache, sizeof(session_cache));
+	zassert_ok(ret, "failed to set TLS_SESSION_CACHE (%d)", errno);
+
+	if (purge) {
+		ret = zsock_setsockopt(client_fd, SOL_TLS, TLS_SESSION_CACHE_PURGE,
+				       &session_cache, sizeof(session_cache));
+		zassert_ok(ret, "failed to set TLS_SESSION_CACHE_PURGE (%d)", errno);
+	}
+
+	ret = zsock_connect(client_fd, (struct sockaddr *)&sa, sizeof(sa));
+	zassert_not_equal(ret, -1, "failed to connect (%d)", errno);
+
+	ret = zsock_getsockopt(client_fd, SOL_TLS, TLS_SESSION_CACHE_STATS,
+			       stats, &optlen);
+	zassert_ok(ret, "failed to get TLS_SESSION_CACHE_STATS (%d)", errno);
+
+	test_shutdown(client_fd, server_fd, server_thread_id);
+}
+
+ZTEST(net_socket_tls_api_extension, test_tls_session_cache)
+{
+	struct tls_session_cache_stats stats;
+
+	/* Full handshake, the session is saved by the client. */
+	test_tls_session_cache_connect(&stats, true);
+	zassert_equal(stats.hits, 0, "unexpected cache hits %u", stats.hits);
+	zassert_equal(stats.misses, 1, "unexpected cache misses %u", stats.misses);
+
+	/* The client offers the saved session and the server resumes it. */
+	test_tls_session_cache_connect(&stats, false);
+	zassert_true(stats.hits >= 1, "session not resumed");
+	zassert_equal(stats.misses, 1, "unexpected cache misses %u", stats.misses);
+}
+
 static void *setup(void)
 {
 	int r;
@@ -3106,6 +3106,143 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#define MMSG_COUNT 4
+
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr[MMSG_COUNT];
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec io_vector[MMSG_COUNT];
+	struct timespec timeout = { 0 };
+	char bufs[MMSG_COUNT][8];
+	char expected[8];
+	int client_sock;
+	int server_sock;
+	int received;
+	int rv;
+	int i;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_connect(client_sock, (struct sockaddr *)&server_addr,
+			   sizeof(server_addr));
+	zassert_equal(rv, 0, "connect failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		snprintk(bufs[i], sizeof(bufs[i]), "msg%d", i);
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = strlen(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen("msg0"), "invalid length");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+	memset(bufs, 0, sizeof(bufs));
+	for (i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+	}
+
+	/* The timeout is only checked after a message, so this gets one */
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT, 0, &timeout);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+
+	/* The others may still be on their way, get whatever is queued */
+	for (received = 1; received < MMSG_COUNT; received += rv) {
+		rv = zsock_recvmmsg(server_sock, &msgs[received],
+				    MMSG_COUNT - received, ZSOCK_MSG_WAITFORONE,
+				    NULL);
+		zassert_true(rv > 0, "recvmmsg failed (%d)", errno);
+	}
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		snprintk(expected, sizeof(expected), "msg%d", i);
+		zassert_equal(msgs[i].msg_len, strlen(expected), "invalid length");
+		zassert_mem_equal(bufs[i], expected, strlen(expected), "invalid data");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen, sizeof(struct sockaddr_in),
+			      "invalid address length");
+		zassert_equal(addr[i].sin_family, AF_INET, "invalid address");
+	}
+
+	/* Errors are reported when nothing could be received */
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT, ZSOCK_MSG_DONTWAIT, NULL);
+	zassert_equal(rv, -1, "recvmmsg succeeded");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_42_v4_recv_zerocopy)
+{
+	static const char data[] = TEST_STR_SMALL;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	socklen_t addrlen = sizeof(addr);
+	char rx_buf[sizeof(data)];
+	struct net_buf *frags;
+	int client_sock;
+	int server_sock;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	len = zsock_sendto(client_sock, data, sizeof(data), 0,
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(len, sizeof(data), "sendto failed (%d)", errno);
+
+	len = zsock_recv_zerocopy(server_sock, &frags, 0,
+				  (struct sockaddr *)&addr, &addrlen);
+	zassert_equal(len, sizeof(data), "recv_zerocopy failed (%d)", errno);
+	zassert_not_null(frags, "no buffers");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "invalid address length");
+	zassert_equal(addr.sin_family, AF_INET, "invalid address");
+
+	/* Only the payload is left in the buffers */
+	zassert_equal(net_buf_frags_len(frags), sizeof(data), "invalid length");
+	zassert_equal(net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+					sizeof(rx_buf)), sizeof(data));
+	zassert_mem_equal(rx_buf, data, sizeof(data), "invalid data");
+	net_buf_unref(frags);
+
+	len = zsock_recv_zerocopy(server_sock, &frags, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(len, -1, "recv_zerocopy succeeded");
+	zassert_equal(errno, EAGAIN, "invalid errno (%d)", errno);
+	zassert_is_null(frags, "unexpected buffers");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
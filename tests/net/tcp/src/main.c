@@ -31,6 +31,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "tcp.h"
+#include "tcp_internal.h"
 #include "tcp_private.h"
 #include "net_stats.h"
 
@@ -114,6 +115,8 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_GRO = 19,
+	TEST_SERVER_SACK = 20,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +141,8 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_server_gro(struct tcphdr *th);
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,6 +240,13 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options added to all the segments of the peer when set */
+static uint8_t peer_options[40];
+static uint8_t peer_options_len;
+
+/* Whether the last SYN sent to the peer offered SACK */
+static bool syn_sack_perm;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -245,11 +257,16 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (peer_options_len > 0) {
+		opts = peer_options;
+		opts_len = peer_options_len;
 	}
 
 	/* Allocate buffer */
@@ -284,11 +301,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = NET_IPV6_MTU;
@@ -303,9 +316,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +433,67 @@ fail:
 	return -EINVAL;
 }
 
+struct sack_options {
+	struct tcp_sack_block blocks[NET_TCP_SACK_BLOCKS];
+	int count;
+	bool perm;
+};
+
+static int read_sack_options(struct net_pkt *pkt, struct tcphdr *th,
+			     struct sack_options *sack)
+{
+	uint8_t opts[40];
+	size_t opts_len = th->th_off * 4U - sizeof(struct tcphdr);
+	size_t i = 0;
+	int ret;
+
+	memset(sack, 0, sizeof(*sack));
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret == 0) {
+		ret = net_pkt_read(pkt, opts, opts_len);
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	if (ret < 0) {
+		return -EINVAL;
+	}
+
+	while (i + 1 < opts_len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (opts[i + 1] < 2U || i + opts[i + 1] > opts_len) {
+			return -EINVAL;
+		}
+
+		if (opts[i] == NET_TCP_SACK_PERM_OPT) {
+			sack->perm = true;
+		} else if (opts[i] == NET_TCP_SACK_OPT) {
+			sack->count = MIN((opts[i + 1] - 2) / sizeof(struct tcp_sack_block),
+					  NET_TCP_SACK_BLOCKS);
+
+			for (int n = 0; n < sack->count; n++) {
+				uint8_t *block = &opts[i + 2 + n * sizeof(struct tcp_sack_block)];
+
+				sack->blocks[n].start = sys_get_be32(block);
+				sack->blocks[n].end = sys_get_be32(block + 4);
+			}
+		}
+
+		i += opts[i + 1];
+	}
+
+	return 0;
+}
+
 static int tester_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct tcphdr th;
@@ -435,6 +509,17 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 		goto fail;
 	}
 
+	if (th.th_flags & SYN) {
+		struct sack_options sack;
+
+		ret = read_sack_options(pkt, &th, &sack);
+		if (ret < 0) {
+			goto fail;
+		}
+
+		syn_sack_perm = sack.perm;
+	}
+
 	switch (test_case_no) {
 	case TEST_CLIENT_IPV4:
 	case TEST_CLIENT_IPV6:
@@ -484,6 +569,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_GRO:
+		handle_server_gro(&th);
+		break;
+	case TEST_SERVER_SACK:
+		handle_server_sack(pkt, &th);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -617,6 +708,9 @@ ZTEST(net_tcp, test_client_ipv4)
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
 
+	zassert_equal(syn_sack_perm, IS_ENABLED(CONFIG_NET_TCP_SACK),
+		      "SACK offered in the SYN: %d", syn_sack_perm);
+
 	ret = net_context_send(ctx, &data, 1, NULL, K_NO_WAIT, NULL);
 	if (ret < 0) {
 		zassert_true(false, "Failed to send data to peer");
@@ -2065,9 +2159,9 @@ struct out_of_order_check_struct {
 static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
-	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 10,  9, 0, 0}, /* Section with a gap, queued separately */
+	{ 0,  10, 19, 0}, /* Data up to the gap */
+	{ 19,  1, 40, 0}, /* First sequence complete */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
@@ -2591,4 +2685,387 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#define GRO_SEGMENTS 8
+#define GRO_SEGMENT_LEN 50
+
+static int gro_acks;
+static uint32_t gro_last_ack;
+static int gro_deliveries;
+static size_t gro_bytes;
+
+static void handle_server_gro(struct tcphdr *th)
+{
+	test_verify_flags(th, ACK);
+
+	gro_acks++;
+	gro_last_ack = ntohl(th->th_ack);
+}
+
+static void test_gro_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	if (pkt) {
+		gro_deliveries++;
+		gro_bytes += net_pkt_remaining_data(pkt);
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Test case scenario
+ *   Establish a connection,
+ *   send in-order data segments in a single RX burst,
+ *   expect a single delivery of all the data,
+ *   expect a single ACK for all the data.
+ */
+ZTEST(net_tcp, test_server_gro)
+{
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	uint32_t first_seq;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+		ztest_test_skip();
+	}
+
+	ctx = create_server_socket(0, 0);
+
+	accepted_ctx->recv_cb = test_gro_recv_cb;
+	test_case_no = TEST_SERVER_GRO;
+	gro_acks = 0;
+	gro_deliveries = 0;
+	gro_bytes = 0;
+	first_seq = seq;
+
+	/* Keep the RX thread from running until all the segments are queued */
+	k_sched_lock();
+
+	for (int i = 0; i < GRO_SEGMENTS; i++) {
+		pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					  (const uint8_t *)&lorem_ipsum[i * GRO_SEGMENT_LEN],
+					  GRO_SEGMENT_LEN);
+		zassert_not_null(pkt, "Cannot create pkt");
+		seq += GRO_SEGMENT_LEN;
+
+		ret = net_recv_data(net_iface, pkt);
+		zassert_ok(ret, "recv data failed (%d)", ret);
+	}
+
+	k_sched_unlock();
+
+	/* Let the receiving thread run, well within the delayed ACK timeout */
+	k_msleep(50);
+
+	zassert_equal(gro_deliveries, 1, "Data delivered in %d packets", gro_deliveries);
+	zassert_equal(gro_bytes, GRO_SEGMENTS * GRO_SEGMENT_LEN, "Got %zu bytes", gro_bytes);
+	zassert_equal(gro_acks, 1, "%d ACKs sent for the burst", gro_acks);
+	zassert_equal(gro_last_ack, first_seq + GRO_SEGMENTS * GRO_SEGMENT_LEN,
+		      "Expected ACK %u but got %u", first_seq + GRO_SEGMENTS * GRO_SEGMENT_LEN,
+		      gro_last_ack);
+
+	/* Abort the connection, no need for the closing handshake */
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+#define SACK_MSS 100
+#define SACK_SEGMENTS 4
+#define SACK_DATA_LEN 10
+
+static struct sack_options sack_sent;
+static uint32_t sack_last_ack;
+static struct tcp_sack_block sack_segments[2 * SACK_SEGMENTS];
+static int sack_segment_count;
+
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t len = net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		     net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+	int ret;
+
+	test_verify_flags(th, len > 0 ? PSH | ACK : ACK);
+
+	ret = read_sack_options(pkt, th, &sack_sent);
+	zassert_ok(ret, "Cannot read the TCP options");
+
+	sack_last_ack = ntohl(th->th_ack);
+
+	if (len == 0) {
+		test_sem_give();
+	} else if (sack_segment_count < ARRAY_SIZE(sack_segments)) {
+		sack_segments[sack_segment_count].start = ntohl(th->th_seq);
+		sack_segments[sack_segment_count].end = ntohl(th->th_seq) + len;
+		sack_segment_count++;
+	}
+}
+
+/* Set the options of the next segments of the peer */
+static void sack_set_peer_options(bool perm, const struct tcp_sack_block *blocks, int count)
+{
+	uint8_t *opts = peer_options;
+
+	if (perm) {
+		*opts++ = NET_TCP_MSS_OPT;
+		*opts++ = NET_TCP_MSS_SIZE;
+		sys_put_be16(SACK_MSS, opts);
+		opts += sizeof(uint16_t);
+		*opts++ = NET_TCP_NOP_OPT;
+		*opts++ = NET_TCP_NOP_OPT;
+		*opts++ = NET_TCP_SACK_PERM_OPT;
+		*opts++ = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (count > 0) {
+		*opts++ = NET_TCP_NOP_OPT;
+		*opts++ = NET_TCP_NOP_OPT;
+		*opts++ = NET_TCP_SACK_OPT;
+		*opts++ = 2 + count * sizeof(struct tcp_sack_block);
+
+		for (int i = 0; i < count; i++) {
+			sys_put_be32(blocks[i].start, opts);
+			sys_put_be32(blocks[i].end, opts + 4);
+			opts += sizeof(struct tcp_sack_block);
+		}
+	}
+
+	peer_options_len = opts - peer_options;
+}
+
+static struct net_context *sack_connect(bool perm)
+{
+	struct net_context *ctx;
+
+	sack_set_peer_options(perm, NULL, 0);
+	ctx = create_server_socket(0, 0);
+	sack_set_peer_options(false, NULL, 0);
+
+	test_case_no = TEST_SERVER_SACK;
+	sack_segment_count = 0;
+	k_sem_reset(&test_sem);
+
+	return ctx;
+}
+
+static void sack_close(struct net_context *ctx)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	/* Abort the connection, no need for the closing handshake */
+	sack_set_peer_options(false, NULL, 0);
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+static void sack_send_data(uint32_t seq_value, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = seq_value;
+	pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+				  (const uint8_t *)lorem_ipsum, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Peer will release the semaphore after it gets the ACK */
+	test_sem_take(K_MSEC(1000), __LINE__);
+}
+
+static void sack_send_ack(uint32_t ack_value, const struct tcp_sack_block *blocks, int count)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	ack = ack_value;
+	sack_set_peer_options(false, blocks, count);
+	pkt = prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	sack_set_peer_options(false, NULL, 0);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_ok(ret, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+}
+
+static void sack_check_segment(int i, uint32_t start, uint32_t end)
+{
+	zassert_true(i < sack_segment_count, "Segment %d not sent", i);
+	zassert_equal(sack_segments[i].start, start, "Segment %d starts at %u, not %u", i,
+		      sack_segments[i].start, start);
+	zassert_equal(sack_segments[i].end, end, "Segment %d ends at %u, not %u", i,
+		      sack_segments[i].end, end);
+}
+
+/* Test case scenario
+ *   Expect SYN with SACK-permitted, send SYN ACK with SACK-permitted,
+ *   then expect SYN without SACK-permitted, send SYN ACK without it.
+ */
+ZTEST(net_tcp, test_server_sack_handshake)
+{
+	struct net_context *ctx;
+
+	ctx = sack_connect(true);
+	zassert_equal(syn_sack_perm, IS_ENABLED(CONFIG_NET_TCP_SACK),
+		      "SACK accepted in the SYN ACK: %d", syn_sack_perm);
+#if defined(CONFIG_NET_TCP_SACK)
+	zassert_true(((struct tcp *)accepted_ctx->tcp)->sack_ok, "SACK not enabled");
+#endif
+	sack_close(ctx);
+
+	ctx = sack_connect(false);
+	zassert_false(syn_sack_perm, "SACK accepted in the SYN ACK but not offered");
+#if defined(CONFIG_NET_TCP_SACK)
+	zassert_false(((struct tcp *)accepted_ctx->tcp)->sack_ok, "SACK enabled");
+#endif
+	sack_close(ctx);
+}
+
+/* Test case scenario
+ *   Establish a connection with SACK,
+ *   send disjoint out-of-order data until the range pool is exhausted,
+ *   expect ACKs with SACK blocks, the latest range first, at most four,
+ *   expect no SACK block for the data dropped when the pool is empty,
+ *   send the missing in-order data, expect the first range to be acknowledged.
+ */
+ZTEST(net_tcp, test_server_sack_blocks)
+{
+	struct net_context *ctx;
+	uint32_t base, start;
+	int ranges = CONFIG_NET_TCP_RECV_QUEUE_RANGES;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		ztest_test_skip();
+	}
+
+	ctx = sack_connect(true);
+	base = seq;
+
+	for (int i = 0; i <= ranges; i++) {
+		int latest = MIN(i, ranges - 1);
+
+		/* Leave a hole before each range */
+		start = base + SACK_DATA_LEN + 2 * SACK_DATA_LEN * i;
+		sack_send_data(start, SACK_DATA_LEN);
+
+		zassert_equal(sack_last_ack, base, "Expected ACK %u but got %u", base,
+			      sack_last_ack);
+		zassert_equal(sack_sent.count, MIN(latest + 1, NET_TCP_SACK_BLOCKS),
+			      "%d SACK blocks for %d ranges", sack_sent.count, latest + 1);
+
+		start = base + SACK_DATA_LEN + 2 * SACK_DATA_LEN * latest;
+		zassert_equal(sack_sent.blocks[0].start, start,
+			      "Latest SACK block starts at %u, not %u",
+			      sack_sent.blocks[0].start, start);
+		zassert_equal(sack_sent.blocks[0].end, start + SACK_DATA_LEN,
+			      "Latest SACK block ends at %u, not %u",
+			      sack_sent.blocks[0].end, start + SACK_DATA_LEN);
+
+		for (int n = 1; n < sack_sent.count; n++) {
+			zassert_true(net_tcp_seq_cmp(sack_sent.blocks[n].start, start) < 0,
+				     "SACK block %d beyond the latest", n);
+		}
+	}
+
+	/* Fill the first hole, the first range follows */
+	sack_send_data(base, SACK_DATA_LEN);
+
+	zassert_equal(sack_last_ack, base + 2 * SACK_DATA_LEN, "Expected ACK %u but got %u",
+		      base + 2 * SACK_DATA_LEN, sack_last_ack);
+	zassert_equal(sack_sent.count, MIN(ranges - 1, NET_TCP_SACK_BLOCKS),
+		      "%d SACK blocks for %d ranges", sack_sent.count, ranges - 1);
+
+	seq = base + 2 * SACK_DATA_LEN;
+	sack_close(ctx);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Test case scenario
+ *   Establish a connection with SACK and a small MSS,
+ *   send four segments, expect the first one to be retransmitted,
+ *   send an ACK for the first segment and a SACK for the third one,
+ *   expect the second and fourth segments only,
+ *   send an ACK past the SACK block, expect the SACK block to be forgotten.
+ */
+ZTEST(net_tcp, test_server_sack_retransmit)
+{
+	struct net_context *ctx;
+	struct tcp_sack_block block;
+	struct tcp *conn;
+	uint32_t base;
+	int nodelay = 1;
+	int ret;
+
+	/* The initial congestion window would only let one segment through */
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	ctx = sack_connect(true);
+	conn = accepted_ctx->tcp;
+	base = ack;
+
+	/* Send the segments after a hole right away */
+	ret = net_tcp_set_option(accepted_ctx, TCP_OPT_NODELAY, &nodelay, sizeof(nodelay));
+	zassert_ok(ret, "Cannot set TCP_NODELAY (%d)", ret);
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, SACK_SEGMENTS * SACK_MSS, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_true(ret >= 0, "Failed to send data to peer (%d)", ret);
+
+	/* Wait for the retransmission timeout */
+	k_msleep(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT + 50);
+
+	zassert_equal(sack_segment_count, SACK_SEGMENTS + 1, "%d segments sent",
+		      sack_segment_count);
+	for (int i = 0; i < SACK_SEGMENTS; i++) {
+		sack_check_segment(i, base + i * SACK_MSS, base + (i + 1) * SACK_MSS);
+	}
+	sack_check_segment(SACK_SEGMENTS, base, base + SACK_MSS);
+
+	/* The first segment got through, and so did the third one */
+	block.start = base + 2 * SACK_MSS;
+	block.end = base + 3 * SACK_MSS;
+	sack_send_ack(base + SACK_MSS, &block, 1);
+
+	zassert_equal(conn->sacked_count, 1, "%d SACK blocks kept", conn->sacked_count);
+	zassert_equal(sack_segment_count, SACK_SEGMENTS + 3, "%d segments sent",
+		      sack_segment_count);
+	sack_check_segment(SACK_SEGMENTS + 1, base + SACK_MSS, base + 2 * SACK_MSS);
+	sack_check_segment(SACK_SEGMENTS + 2, base + 3 * SACK_MSS, base + 4 * SACK_MSS);
+
+	/* The ACK moves past the SACK block, which is then dropped */
+	sack_send_ack(base + 3 * SACK_MSS, &block, 1);
+	zassert_equal(conn->sacked_count, 0, "%d SACK blocks kept", conn->sacked_count);
+
+	sack_send_ack(base + SACK_SEGMENTS * SACK_MSS, NULL, 0);
+	zassert_equal(conn->send_data_total, 0, "%zu bytes not acknowledged",
+		      conn->send_data_total);
+
+	sack_close(ctx);
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
@@ -653,4 +653,94 @@ ZTEST(udp_fn_tests, test_udp)
 	zassert_false(test_failed, "udp tests failed");
 }
 
+/* Number of connected handlers sharing a local port in test_udp_demux */
+#define DEMUX_CONNECTED 16
+
+/*
+ * Handlers of each kind, connected, bound to a local address and port, to a
+ * local port only and to any port, overlap. Each packet must reach the best
+ * match, whichever order the handlers are registered and removed in. This
+ * holds for the linear and the hashed lookups alike.
+ */
+ZTEST(udp_fn_tests, test_udp_demux)
+{
+	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
+	struct net_conn_handle *connected[DEMUX_CONNECTED];
+	static struct ud connected_ud[DEMUX_CONNECTED];
+	struct ud *wild, *lport, *laddr, *conn, *ud;
+	struct net_if *iface;
+	int ret, i = 0;
+	bool st;
+
+	struct sockaddr_in6 my_addr6 = { .sin6_family = AF_INET6 };
+	struct in6_addr in6addr_my = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					   0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+
+	struct sockaddr_in6 peer_addr6 = { .sin6_family = AF_INET6 };
+	struct in6_addr in6addr_peer = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0x4e, 0x11, 0, 0, 0x2 } } };
+
+	struct sockaddr_in my_addr4 = { .sin_family = AF_INET };
+	struct in_addr in4addr_my = { { { 192, 0, 2, 1 } } };
+
+	struct sockaddr_in peer_addr4 = { .sin_family = AF_INET };
+	struct in_addr in4addr_peer = { { { 192, 0, 2, 9 } } };
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	net_ipaddr_copy(&my_addr6.sin6_addr, &in6addr_my);
+	net_ipaddr_copy(&peer_addr6.sin6_addr, &in6addr_peer);
+	net_ipaddr_copy(&my_addr4.sin_addr, &in4addr_my);
+	net_ipaddr_copy(&peer_addr4.sin_addr, &in4addr_peer);
+
+	k_sem_init(&recv_lock, 0, UINT_MAX);
+
+	zassert_not_null(net_if_ipv6_addr_add(iface, &in6addr_my, NET_ADDR_MANUAL, 0));
+	zassert_not_null(net_if_ipv4_addr_add(iface, &in4addr_my, NET_ADDR_MANUAL, 0));
+
+	/* From the worst match to the best one */
+	wild = REGISTER(AF_UNSPEC, NULL, NULL, 0, 0);
+	lport = REGISTER(AF_UNSPEC, NULL, NULL, 0, 5001);
+	laddr = REGISTER(AF_INET, NULL, &my_addr4, 0, 5001);
+	conn = REGISTER(AF_INET, &peer_addr4, &my_addr4, 6001, 5001);
+
+	TEST_IPV4_OK(conn, &in4addr_peer, &in4addr_my, 6001, 5001);
+	TEST_IPV4_OK(laddr, &in4addr_peer, &in4addr_my, 6002, 5001);
+	TEST_IPV6_OK(lport, &in6addr_peer, &in6addr_my, 6001, 5001);
+	TEST_IPV4_OK(wild, &in4addr_peer, &in4addr_my, 6001, 5002);
+
+	/* Connected handlers on the same local port each get their own packets */
+	for (int j = 0; j < DEMUX_CONNECTED; j++) {
+		connected_ud[j].test = "connected";
+		set_port(AF_INET6, (struct sockaddr *)&peer_addr6, (struct sockaddr *)&my_addr6,
+			 7000 + j, 5001);
+		ret = net_udp_register(AF_INET6, (struct sockaddr *)&peer_addr6,
+				       (struct sockaddr *)&my_addr6, 7000 + j, 5001, NULL,
+				       test_ok, &connected_ud[j], &connected[j]);
+		zassert_ok(ret, "UDP register %d failed (%d)", j, ret);
+	}
+
+	for (int j = DEMUX_CONNECTED - 1; j >= 0; j--) {
+		ud = &connected_ud[j];
+		TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 7000 + j, 5001);
+	}
+	TEST_IPV6_OK(lport, &in6addr_peer, &in6addr_my, 7000 + DEMUX_CONNECTED, 5001);
+
+	for (int j = 0; j < DEMUX_CONNECTED; j++) {
+		zassert_ok(net_udp_unregister(connected[j]));
+	}
+
+	/* From the best match to the worst one */
+	UNREGISTER(conn);
+	TEST_IPV4_OK(laddr, &in4addr_peer, &in4addr_my, 6001, 5001);
+	UNREGISTER(laddr);
+	TEST_IPV4_OK(lport, &in4addr_peer, &in4addr_my, 6001, 5001);
+	UNREGISTER(lport);
+	TEST_IPV4_OK(wild, &in4addr_peer, &in4addr_my, 6001, 5001);
+	UNREGISTER(wild);
+	TEST_IPV4_FAIL(wild, &in4addr_peer, &in4addr_my, 6001, 5001);
+
+	zassert_false(fail, "Tests failed");
+}
+
 ZTEST_SUITE(udp_fn_tests, NULL, NULL, NULL, NULL, NULL);
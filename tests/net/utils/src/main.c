@@ -1365,6 +1365,42 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 }
 
+ZTEST(test_utils_fn, test_ip_checksum_update)
+{
+	/* IPv4 header with a valid checksum */
+	uint8_t hdr[] = {
+		0x45, 0x00, 0x00, 0x4c, 0x48, 0x8e, 0x00, 0x00,
+		0x40, 0x11, 0x57, 0x34, 0xc0, 0xa8, 0x58, 0x29,
+		0xc1, 0xe5, 0x00, 0x28,
+	};
+	const uint8_t new_dst[] = { 0x0a, 0x00, 0x00, 0x01 };
+	uint16_t old_val, new_val, chksum;
+
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Invalid test header\n");
+
+	/* Decrement the TTL */
+	memcpy(&old_val, &hdr[8], sizeof(old_val));
+	hdr[8]--;
+	memcpy(&new_val, &hdr[8], sizeof(new_val));
+	memcpy(&chksum, &hdr[10], sizeof(chksum));
+
+	chksum = net_calc_chksum_update(chksum, old_val, new_val);
+	memcpy(&hdr[10], &chksum, sizeof(chksum));
+
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Checksum not updated for the TTL\n");
+
+	/* Rewrite the destination address */
+	chksum = net_calc_chksum_update_buf(chksum, &hdr[16], new_dst,
+					    sizeof(new_dst));
+	memcpy(&hdr[16], new_dst, sizeof(new_dst));
+	memcpy(&hdr[10], &chksum, sizeof(chksum));
+
+	zassert_equal(calc_chksum(0, hdr, sizeof(hdr)), 0xffff,
+		      "Checksum not updated for the address\n");
+}
+
 /* Verify that the net_pkt pointer to the received link layer address
  * is correct.
  */
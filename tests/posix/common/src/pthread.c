@@ -456,6 +456,53 @@ ZTEST(pthread, test_pthread_descriptor_leak)
 	}
 }
 
+#ifdef CONFIG_PTHREAD_RECYCLE_STACKS
+/* Recycled threads keep their stacks for the next threads created with default attributes */
+ZTEST(pthread, test_pthread_recycle_stacks)
+{
+	void *stacks[CONFIG_DYNAMIC_THREAD_POOL_SIZE + 1];
+	pthread_attr_t attr;
+	pthread_t pthread1;
+	void *stackaddr;
+	size_t stacksize;
+	size_t n;
+
+	zassert_ok(pthread_create(&pthread1, NULL, create_thread1, NULL));
+	zassert_ok(pthread_join(pthread1, NULL));
+	k_msleep(2 * CONFIG_PTHREAD_RECYCLER_DELAY_MS);
+
+	/* Take every stack left in the pool */
+	for (n = 0; n < ARRAY_SIZE(stacks); n++) {
+		stacks[n] = k_thread_stack_alloc(CONFIG_DYNAMIC_THREAD_STACK_SIZE, 0);
+		if (stacks[n] == NULL) {
+			break;
+		}
+	}
+
+	if (n == ARRAY_SIZE(stacks)) {
+		while (n > 0) {
+			zassert_ok(k_thread_stack_free(stacks[--n]));
+		}
+
+		ztest_test_skip();
+	}
+
+	zassert_ok(pthread_create(&pthread1, NULL, create_thread1, NULL),
+		   "cached stack not reused");
+	zassert_ok(pthread_join(pthread1, NULL));
+	k_msleep(2 * CONFIG_PTHREAD_RECYCLER_DELAY_MS);
+
+	zassert_ok(pthread_attr_init(&attr));
+	zassert_ok(pthread_attr_getstack(&attr, &stackaddr, &stacksize));
+	zassert_not_null(stackaddr, "cached stack not taken by pthread_attr_init()");
+	zassert_ok(pthread_attr_destroy(&attr));
+
+	while (n > 0) {
+		zassert_ok(k_thread_stack_free(stacks[--n]));
+	}
+}
+#endif
+
 ZTEST(pthread, test_pthread_equal)
 {
 	zassert_true(pthread_equal(pthread_self(), pthread_self()));
@@ -0,0 +1,137 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/posix/sys/epoll.h>
+#include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/posix/unistd.h>
+#include <zephyr/ztest.h>
+
+static int epfd;
+static int efd[2];
+
+static void write_efd(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_ok(eventfd_write(efd[0], 1));
+}
+
+static K_WORK_DELAYABLE_DEFINE(write_work, write_efd);
+
+static void add_efd(int i, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.u32 = i,
+	};
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_ADD, efd[i], &ev));
+}
+
+ZTEST(posix_epoll, test_epoll_level_triggered)
+{
+	struct epoll_event ev[2];
+	eventfd_t val;
+
+	add_efd(0, EPOLLIN);
+	add_efd(1, EPOLLIN);
+
+	zassert_equal(epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0), 0);
+
+	zassert_ok(eventfd_write(efd[1], 1));
+
+	zassert_equal(epoll_wait(epfd, ev, ARRAY_SIZE(ev), 100), 1);
+	zassert_equal(ev[0].data.u32, 1);
+	zassert_equal(ev[0].events, EPOLLIN);
+
+	/* Still reported until the data is read */
+	zassert_equal(epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0), 1);
+	zassert_equal(ev[0].data.u32, 1);
+
+	zassert_ok(eventfd_read(efd[1], &val));
+	zassert_equal(epoll_wait(epfd, ev, ARRAY_SIZE(ev), 0), 0);
+}
+
+ZTEST(posix_epoll, test_epoll_blocking)
+{
+	struct epoll_event ev;
+
+	add_efd(0, EPOLLIN);
+
+	k_work_schedule(&write_work, K_MSEC(50));
+
+	zassert_equal(epoll_wait(epfd, &ev, 1, 1000), 1);
+	zassert_equal(ev.data.u32, 0);
+	zassert_equal(ev.events, EPOLLIN);
+}
+
+ZTEST(posix_epoll, test_epoll_oneshot)
+{
+	struct epoll_event ev;
+
+	add_efd(0, EPOLLIN | EPOLLONESHOT);
+	zassert_ok(eventfd_write(efd[0], 1));
+
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+	zassert_equal(epoll_wait(epfd, &ev, 1, 0), 0);
+
+	/* Enable it again */
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_MOD, efd[0], &ev));
+	zassert_equal(epoll_wait(epfd, &ev, 1, 100), 1);
+}
+
+ZTEST(posix_epoll, test_epoll_ctl_errors)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN,
+	};
+
+	add_efd(0, EPOLLIN);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, efd[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_MOD, efd[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(epoll_ctl(epfd, EPOLL_CTL_DEL, efd[0], NULL));
+	zassert_equal(epoll_ctl(epfd, EPOLL_CTL_DEL, efd[0], NULL), -1);
+	zassert_equal(errno, ENOENT);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1() failed: %d", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(efd); i++) {
+		efd[i] = eventfd(0, EFD_NONBLOCK);
+		zassert_true(efd[i] >= 0, "eventfd() failed: %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	k_work_cancel_delayable(&write_work);
+
+	zassert_ok(close(epfd));
+
+	for (int i = 0; i < ARRAY_SIZE(efd); i++) {
+		zassert_ok(close(efd[i]));
+	}
+}
+
+ZTEST_SUITE(posix_epoll, NULL, NULL, before, after, NULL);
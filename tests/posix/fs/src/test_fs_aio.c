@@ -0,0 +1,169 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/posix/aio.h>
+#include <zephyr/posix/fcntl.h>
+#include <zephyr/posix/unistd.h>
+#include "test_fs.h"
+
+#define TEST_AIO_FILE FATFS_MNTP "/aio.dat"
+#define CHUNK_SIZE    32
+#define NUM_CHUNKS    4
+
+static int fd = -1;
+static K_SEM_DEFINE(notify_sem, 0, 1);
+
+static void notify_fn(union sigval val)
+{
+	zassert_equal(val.sival_int, 42);
+	k_sem_give(&notify_sem);
+}
+
+static void wait_for(const struct aiocb *cb)
+{
+	const struct aiocb *const list[] = {cb};
+
+	while (aio_error(cb) == EINPROGRESS) {
+		zassert_ok(aio_suspend(list, ARRAY_SIZE(list), NULL));
+	}
+}
+
+static void before_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	fd = open(TEST_AIO_FILE, O_CREAT | O_RDWR, 0660);
+	zassert_true(fd >= 0, "Failed creating test file");
+}
+
+static void after_fn(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	zassert_ok(close(fd));
+	zassert_ok(unlink(TEST_AIO_FILE));
+	fd = -1;
+}
+
+ZTEST_SUITE(posix_fs_aio_test, NULL, test_mount, before_fn, after_fn, test_unmount);
+
+/**
+ * @brief Test aio_write() and aio_read() at an offset, with a thread notification
+ */
+ZTEST(posix_fs_aio_test, test_aio_read_write)
+{
+	char buf[CHUNK_SIZE] = {0};
+	struct aiocb cb = {
+		.aio_fildes = fd,
+		.aio_offset = 8,
+		.aio_buf = (void *)test_str,
+		.aio_nbytes = strlen(test_str),
+		.aio_sigevent = {
+			.sigev_notify = SIGEV_THREAD,
+			.sigev_notify_function = notify_fn,
+			.sigev_value.sival_int = 42,
+		},
+	};
+
+	zassert_ok(aio_write(&cb));
+	wait_for(&cb);
+	zassert_ok(aio_error(&cb));
+	zassert_equal(aio_return(&cb), strlen(test_str));
+	zassert_ok(k_sem_take(&notify_sem, K_SECONDS(1)));
+
+	cb.aio_buf = buf;
+	cb.aio_sigevent.sigev_notify = SIGEV_NONE;
+	zassert_ok(aio_read(&cb));
+	wait_for(&cb);
+	zassert_equal(aio_return(&cb), strlen(test_str));
+	zassert_mem_equal(buf, test_str, strlen(test_str));
+
+#ifdef O_SYNC
+	zassert_ok(aio_fsync(O_SYNC, &cb));
+	wait_for(&cb);
+	zassert_ok(aio_error(&cb));
+#endif
+
+	zassert_equal(aio_cancel(fd, &cb), AIO_ALLDONE);
+}
+
+/**
+ * @brief Test lio_listio() with LIO_WAIT and LIO_NOWAIT
+ */
+ZTEST(posix_fs_aio_test, test_lio_listio)
+{
+	static char bufs[NUM_CHUNKS][CHUNK_SIZE];
+	static struct aiocb cbs[NUM_CHUNKS];
+	struct aiocb *list[NUM_CHUNKS];
+	struct sigevent sig = {
+		.sigev_notify = SIGEV_THREAD,
+		.sigev_notify_function = notify_fn,
+		.sigev_value.sival_int = 42,
+	};
+
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		memset(bufs[i], 'a' + i, CHUNK_SIZE);
+		cbs[i] = (struct aiocb){
+			.aio_fildes = fd,
+			.aio_offset = i * CHUNK_SIZE,
+			.aio_buf = bufs[i],
+			.aio_nbytes = CHUNK_SIZE,
+			.aio_sigevent.sigev_notify = SIGEV_NONE,
+			.aio_lio_opcode = LIO_WRITE,
+		};
+		list[i] = &cbs[i];
+	}
+
+	zassert_ok(lio_listio(LIO_WAIT, list, NUM_CHUNKS, NULL));
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		memset(bufs[i], 0, CHUNK_SIZE);
+		cbs[i].aio_lio_opcode = LIO_READ;
+	}
+
+	/* The whole list is notified once */
+	zassert_ok(lio_listio(LIO_NOWAIT, list, NUM_CHUNKS, &sig));
+	zassert_ok(k_sem_take(&notify_sem, K_SECONDS(1)));
+	for (int i = 0; i < NUM_CHUNKS; i++) {
+		zassert_equal(aio_return(&cbs[i]), CHUNK_SIZE);
+		for (int j = 0; j < CHUNK_SIZE; j++) {
+			zassert_equal(bufs[i][j], 'a' + i);
+		}
+	}
+
+	cbs[0].aio_lio_opcode = LIO_NOP - 1;
+	zassert_equal(lio_listio(LIO_WAIT, list, NUM_CHUNKS, NULL), -1);
+	zassert_equal(errno, EINVAL);
+}
+
+/**
+ * @brief Test the errors of a request on a bad file descriptor
+ */
+ZTEST(posix_fs_aio_test, test_aio_errors)
+{
+	char c;
+	struct aiocb cb = {
+		.aio_fildes = -1,
+		.aio_buf = &c,
+		.aio_nbytes = 1,
+		.aio_sigevent.sigev_notify = SIGEV_NONE,
+	};
+
+	zassert_ok(aio_read(&cb));
+	wait_for(&cb);
+	zassert_equal(aio_error(&cb), EBADF);
+	zassert_equal(aio_return(&cb), -1);
+
+	cb.aio_offset = -1;
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+
+	cb.aio_offset = 0;
+	cb.aio_sigevent.sigev_notify = SIGEV_SIGNAL;
+	zassert_equal(aio_read(&cb), -1);
+	zassert_equal(errno, EINVAL);
+}
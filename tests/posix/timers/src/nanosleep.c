@@ -136,3 +136,29 @@ ZTEST(posix_timers, test_nanosleep_execution)
 	/* sleep for 1s + 1us + 1ns */
 	common_lower_bound_check(SELECT_NANOSLEEP, 0, 0, 1, 1001);
 }
+
+/* With CONFIG_POSIX_CLOCK_NANOSLEEP_HIGH_RES, the sleep ends at the deadline, not at a tick */
+ZTEST(posix_timers, test_clock_nanosleep_high_res)
+{
+	const uint64_t tick_ns = k_ticks_to_ns_floor64(1);
+	const uint64_t req_ns[] = {tick_ns / 2, tick_ns + tick_ns / 2};
+	struct timespec req;
+	uint64_t actual_ns;
+	uint64_t then;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_POSIX_CLOCK_NANOSLEEP_HIGH_RES);
+
+	for (size_t i = 0; i < ARRAY_SIZE(req_ns); i++) {
+		req.tv_sec = req_ns[i] / NSEC_PER_SEC;
+		req.tv_nsec = req_ns[i] % NSEC_PER_SEC;
+
+		then = k_cycle_get_64();
+		zassert_ok(clock_nanosleep(CLOCK_MONOTONIC, 0, &req, NULL));
+		actual_ns = k_cyc_to_ns_ceil64(k_cycle_get_64() - then);
+
+		zassert_true(actual_ns >= req_ns[i], "actual: %llu expected: %llu", actual_ns,
+			     req_ns[i]);
+		zassert_true(actual_ns < req_ns[i] + tick_ns / 2, "actual: %llu expected: %llu",
+			     actual_ns, req_ns[i]);
+	}
+}
@@ -144,6 +144,75 @@ ZTEST(posix_timers, test_one_shot__SIGEV_SIGNAL)
 	zassert_equal(exp_count, 1, "Number of expiry is incorrect");
 }
 
+/*
+ * A period which is not a whole number of milliseconds is not truncated. It runs on the
+ * counter with CONFIG_POSIX_TIMER_COUNTER, when not a whole number of ticks either.
+ */
+ZTEST(posix_timers, test_timer_resolution)
+{
+	struct sigevent sig = {0};
+	struct itimerspec value;
+	uint64_t period_ns;
+	uint64_t elapsed_ns;
+	int64_t start;
+
+	exp_count = 0;
+	sig.sigev_notify = SIGEV_SIGNAL;
+	sig.sigev_notify_function = handler;
+	sig.sigev_value.sival_int = TEST_SIGNAL_VAL;
+
+	zassert_ok(timer_create(CLOCK_MONOTONIC, &sig, &timerid));
+
+	value.it_interval.tv_sec = 0;
+	value.it_interval.tv_nsec = 1500 * NSEC_PER_USEC;
+	value.it_value = value.it_interval;
+
+	if (IS_ENABLED(CONFIG_POSIX_TIMER_COUNTER)) {
+		period_ns = value.it_interval.tv_nsec;
+	} else {
+		/* rounded up to the next tick */
+		period_ns = k_ticks_to_ns_floor64(k_ns_to_ticks_ceil64(value.it_interval.tv_nsec));
+	}
+
+	start = k_uptime_ticks();
+	zassert_ok(timer_settime(timerid, 0, &value, NULL));
+	k_sleep(K_MSEC(150));
+	zassert_ok(timer_delete(timerid));
+	elapsed_ns = k_ticks_to_ns_floor64(k_uptime_ticks() - start);
+	timerid = -1;
+
+	zassert_within(exp_count, elapsed_ns / period_ns, 2, "%d expirations in %llu ns",
+		       exp_count, elapsed_ns);
+}
+
+/* An absolute expiration is relative to the clock of the timer */
+ZTEST(posix_timers, test_timer_abstime)
+{
+	struct sigevent sig = {0};
+	struct itimerspec value = {0};
+
+	exp_count = 0;
+	sig.sigev_notify = SIGEV_SIGNAL;
+	sig.sigev_notify_function = handler;
+	sig.sigev_value.sival_int = TEST_SIGNAL_VAL;
+
+	zassert_ok(timer_create(CLOCK_MONOTONIC, &sig, &timerid));
+
+	zassert_ok(clock_gettime(CLOCK_MONOTONIC, &value.it_value));
+	value.it_value.tv_nsec += 100 * NSEC_PER_MSEC;
+	if (value.it_value.tv_nsec >= NSEC_PER_SEC) {
+		value.it_value.tv_sec++;
+		value.it_value.tv_nsec -= NSEC_PER_SEC;
+	}
+	zassert_ok(timer_settime(timerid, TIMER_ABSTIME, &value, NULL));
+
+	k_sleep(K_MSEC(50));
+	zassert_equal(exp_count, 0, "Expired too early");
+
+	k_sleep(K_MSEC(100));
+	zassert_equal(exp_count, 1, "Number of expiry is incorrect");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
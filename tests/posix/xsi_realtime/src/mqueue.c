@@ -297,3 +297,46 @@ ZTEST(xsi_realtime, test_mqueue_open_and_unlink_multiple)
 	zassert_ok(mq_close(mqd1), "Unable to close message queue 1 descriptor.");
 	zassert_ok(mq_close(mqd2), "Unable to close message queue 2 descriptor.");
 }
+
+ZTEST(xsi_realtime, test_mqueue_priority)
+{
+	static const unsigned int prios[] = {1, 5, 1, 3};
+	static const unsigned int order[] = {1, 3, 0, 2};
+	mqd_t mqd;
+	struct mq_attr attrs = {
+		.mq_msgsize = MESSAGE_SIZE,
+		.mq_maxmsg = MESG_COUNT_PERMQ,
+	};
+	char msg[MESSAGE_SIZE];
+	unsigned int prio;
+	int32_t mode = 0777;
+	int flags = O_RDWR | O_CREAT | O_NONBLOCK;
+
+	mqd = mq_open(queue, flags, mode, &attrs);
+
+	/* Message i is i + 1 bytes long */
+	for (int i = 0; i < ARRAY_SIZE(prios); i++) {
+		memset(msg, 'a' + i, sizeof(msg));
+		zassert_ok(mq_send(mqd, msg, i + 1, prios[i]), "Unable to send message");
+	}
+
+	zassert_not_ok(mq_send(mqd, msg, 1, 0), "Queue should be full.");
+	zassert_equal(errno, EAGAIN);
+
+	/* Highest priority first, FIFO within a priority */
+	for (int i = 0; i < ARRAY_SIZE(order); i++) {
+		zassert_equal(mq_receive(mqd, msg, MESSAGE_SIZE, &prio), order[i] + 1);
+		zassert_equal(prio, prios[order[i]]);
+		zassert_equal(msg[0], 'a' + order[i]);
+	}
+
+	zassert_not_ok(mq_receive(mqd, msg, MESSAGE_SIZE, &prio), "Queue should be empty.");
+	zassert_equal(errno, EAGAIN);
+
+	zassert_not_ok(mq_send(mqd, msg, 1, CONFIG_POSIX_MQ_PRIO_MAX),
+		       "Priority should be out of range.");
+	zassert_equal(errno, EINVAL);
+
+	zassert_ok(mq_close(mqd), "Unable to close message queue descriptor.");
+	zassert_ok(mq_unlink(queue), "Unable to unlink queue");
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/debug/mem_sampler.h>
+
+K_HEAP_DEFINE(test_heap, 512);
+K_MEM_SLAB_DEFINE(test_slab, 32, 4, 4);
+
+struct sample_state {
+	size_t count;
+	uint32_t heap_used;
+	uint32_t slab_used;
+	uint32_t slab_total;
+	uint32_t last_timestamp;
+	bool ordered;
+};
+
+static void check_record(const struct mem_sampler_record *rec, void *user_data)
+{
+	struct sample_state *state = user_data;
+
+	state->count++;
+	if (rec->timestamp < state->last_timestamp) {
+		state->ordered = false;
+	}
+	state->last_timestamp = rec->timestamp;
+
+	if ((rec->type == MEM_SAMPLER_HEAP) && (rec->obj == &test_heap)) {
+		state->heap_used = rec->used;
+	} else if ((rec->type == MEM_SAMPLER_MEM_SLAB) && (rec->obj == &test_slab)) {
+		state->slab_used = rec->used;
+		state->slab_total = rec->total;
+	}
+}
+
+static void walk(struct sample_state *state)
+{
+	*state = (struct sample_state){ .ordered = true };
+	mem_sampler_foreach(check_record, state);
+}
+
+ZTEST(mem_sampler, test_sample)
+{
+	struct sample_state state;
+	void *block, *p;
+
+	mem_sampler_clear();
+	walk(&state);
+	zassert_equal(state.count, 0, "records left after clear");
+
+	zassert_ok(k_mem_slab_alloc(&test_slab, &block, K_NO_WAIT));
+	p = k_heap_alloc(&test_heap, 100, K_NO_WAIT);
+	zassert_not_null(p);
+
+	mem_sampler_sample();
+	walk(&state);
+	zassert_true(state.count >= 2, "pools not sampled");
+	zassert_true(state.ordered, "records out of order");
+	zassert_true(state.heap_used >= 100, "wrong heap usage %u", state.heap_used);
+	zassert_equal(state.slab_used, 32, "wrong slab usage %u", state.slab_used);
+	zassert_equal(state.slab_total, 4 * 32, "wrong slab size %u", state.slab_total);
+
+	/* The latest sample shows the pools released */
+	k_mem_slab_free(&test_slab, block);
+	k_heap_free(&test_heap, p);
+
+	mem_sampler_sample();
+	walk(&state);
+	zassert_equal(state.heap_used, 0, "wrong heap usage %u", state.heap_used);
+	zassert_equal(state.slab_used, 0, "wrong slab usage %u", state.slab_used);
+}
+
+ZTEST(mem_sampler, test_overwrite)
+{
+	struct sample_state state;
+
+	mem_sampler_clear();
+
+	/* Older records get overwritten once the ring is full */
+	for (int i = 0; i < CONFIG_MEM_SAMPLER_RECORDS; i++) {
+		mem_sampler_sample();
+	}
+
+	walk(&state);
+	zassert_equal(state.count, CONFIG_MEM_SAMPLER_RECORDS, "ring not full");
+	zassert_true(state.ordered, "records out of order");
+}
+
+ZTEST_SUITE(mem_sampler, NULL, NULL, NULL, NULL, NULL);
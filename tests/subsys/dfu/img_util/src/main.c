@@ -8,6 +8,8 @@
 #include <zephyr/ztest.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/dfu/flash_img.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 #define SLOT0_PARTITION		slot0_partition
 #define SLOT1_PARTITION		slot1_partition
@@ -165,4 +167,133 @@ ZTEST(img_util, test_check_flash)
 	flash_area_close(ctx.flash_area);
 }
 
+ZTEST(img_util, test_stream_hash)
+{
+#ifdef CONFIG_IMG_STREAM_HASH
+	/* sha256("abc") */
+	const uint8_t abc_sha[] = { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+				    0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+				    0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+				    0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+	struct flash_img_context ctx;
+	uint8_t hash[32];
+	int ret;
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_img_buffered_write(&ctx, "a", 1, false);
+	zassert_true(ret == 0, "Flash img buffered write");
+	ret = flash_img_buffered_write(&ctx, "bc", 2, true);
+	zassert_true(ret == 0, "Flash img buffered write");
+
+	ret = flash_img_hash_finish(&ctx, hash);
+	zassert_true(ret == 0, "Flash img hash finish (%d)", ret);
+	zassert_mem_equal(hash, abc_sha, sizeof(hash), "Wrong image hash");
+
+	ret = flash_img_hash_finish(&ctx, hash);
+	zassert_equal(ret, -ENODATA, "Hash taken twice");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#ifdef CONFIG_IMG_DELTA
+static uint8_t *delta_put_op(uint8_t *p, uint8_t op, uint32_t len, uint32_t off)
+{
+	*p++ = op;
+	sys_put_le32(len, p);
+	sys_put_le32(off, p + 4);
+
+	return p + 8;
+}
+#endif
+
+ZTEST(img_util, test_delta)
+{
+#ifdef CONFIG_IMG_DELTA
+	static uint8_t source[1024];
+	static uint8_t target[406];
+	static uint8_t patch[sizeof(struct flash_img_delta_header) +
+			     3 * FLASH_IMG_DELTA_OP_SIZE + 300 + 6];
+	static struct flash_img_delta delta;
+	const struct flash_area *fa;
+	struct flash_img_context ctx;
+	uint8_t *p = patch;
+	uint8_t buf[64];
+	int ret;
+
+	for (size_t i = 0; i < sizeof(source); i++) {
+		source[i] = i * 7;
+	}
+	ret = flash_area_open(SLOT0_PARTITION_ID, &fa);
+	zassert_true(ret == 0, "Flash area open");
+	ret = flash_area_flatten(fa, 0, fa->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+	ret = flash_area_write(fa, 0, source, sizeof(source));
+	zassert_true(ret == 0, "Flash write failure (%d)", ret);
+	flash_area_close(fa);
+
+	/* Copy, add one to each byte and insert */
+	memcpy(target, &source[200], 100);
+	for (size_t i = 0; i < 300; i++) {
+		target[100 + i] = source[i] + 1;
+	}
+	memcpy(&target[400], "zephyr", 6);
+
+	sys_put_le32(FLASH_IMG_DELTA_MAGIC, p);
+	sys_put_le32(sizeof(source), p + 4);
+	sys_put_le32(crc32_ieee(source, sizeof(source)), p + 8);
+	sys_put_le32(sizeof(target), p + 12);
+	sys_put_le32(crc32_ieee(target, sizeof(target)), p + 16);
+	p += sizeof(struct flash_img_delta_header);
+	p = delta_put_op(p, FLASH_IMG_DELTA_OP_COPY, 100, 200);
+	p = delta_put_op(p, FLASH_IMG_DELTA_OP_ADD, 300, 0);
+	memset(p, 1, 300);
+	p += 300;
+	p = delta_put_op(p, FLASH_IMG_DELTA_OP_INSERT, 6, 0);
+	memcpy(p, "zephyr", 6);
+
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_flatten(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	ret = flash_img_delta_init(&delta, &ctx, SLOT0_PARTITION_ID);
+	zassert_true(ret == 0, "Delta init");
+
+	/* Split the patch inside the headers and the added data */
+	for (size_t i = 0; i < 30; i++) {
+		ret = flash_img_delta_write(&delta, &patch[i], 1, false);
+		zassert_true(ret == 0, "Delta write (%d)", ret);
+	}
+	ret = flash_img_delta_write(&delta, &patch[30], 100, false);
+	zassert_true(ret == 0, "Delta write (%d)", ret);
+	ret = flash_img_delta_write(&delta, &patch[130], sizeof(patch) - 130, true);
+	zassert_true(ret == 0, "Delta write (%d)", ret);
+
+	for (size_t off = 0; off < sizeof(target); off += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), sizeof(target) - off);
+
+		ret = flash_area_read(ctx.flash_area, off, buf, len);
+		zassert_true(ret == 0, "Flash read failure (%d)", ret);
+		zassert_mem_equal(buf, &target[off], len, "Wrong patched image");
+	}
+
+	/* A patch for another source image must not write anything */
+	sys_put_le32(0, &patch[8]);
+	ret = flash_img_init_id(&ctx, SLOT1_PARTITION_ID);
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_img_delta_init(&delta, &ctx, SLOT0_PARTITION_ID);
+	zassert_true(ret == 0, "Delta init");
+	ret = flash_img_delta_write(&delta, patch, sizeof(patch), true);
+	zassert_equal(ret, -ESPIPE, "Patch applied to another image");
+	zassert_equal(flash_img_bytes_written(&ctx), 0, "Data written");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_SUITE(img_util, NULL, NULL, NULL, NULL, NULL);
@@ -219,4 +219,18 @@ ZTEST(print_rectspace1016, test_print_wrap_to_3_lines)
 	zassert_true(verify_image(13, 49, kerning_3_12rectspace1016, 153, 16));
 }
 
+ZTEST(print_rectspace1016, test_print_again_after_draw_point)
+{
+	struct cfb_position pos = {5, 8};
+
+	zassert_ok(cfb_print(dev, " ", 1, 1));
+	zassert_ok(cfb_draw_point(dev, &pos));
+
+	/* Printing the same string again clears the point inside the glyph */
+	zassert_ok(cfb_print(dev, " ", 1, 1));
+	zassert_ok(cfb_framebuffer_finalize(dev));
+
+	zassert_true(verify_image_and_bg(1, 1, rectspace1016, 10, 16, 0));
+}
+
 ZTEST_SUITE(print_rectspace1016, NULL, NULL, cfb_test_before, cfb_test_after, NULL);
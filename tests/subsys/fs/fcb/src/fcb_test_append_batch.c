@@ -0,0 +1,60 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+#define BATCH_ELEMS 128
+
+ZTEST(fcb_test_with_2sectors_set, test_fcb_append_batch)
+{
+	static uint8_t test_data[BATCH_ELEMS][BATCH_ELEMS];
+	struct fcb_batch_elem elems[BATCH_ELEMS];
+	struct fcb *fcb = &test_fcb;
+	struct fcb_entry loc;
+	uint8_t buf[256];
+	int var_cnt;
+	int rc;
+	int i;
+	int j;
+
+	for (i = 0; i < BATCH_ELEMS; i++) {
+		for (j = 0; j < i; j++) {
+			test_data[i][j] = fcb_test_append_data(i, j);
+		}
+		elems[i].data = test_data[i];
+		elems[i].len = i;
+	}
+
+	/* Elements too large for the buffer are refused */
+	rc = fcb_append_batch(fcb, elems, BATCH_ELEMS, buf, 64);
+	zassert_equal(rc, -EINVAL, "fcb_append_batch accepted a too small buffer");
+
+	rc = fcb_append_batch(fcb, elems, BATCH_ELEMS, buf, sizeof(buf));
+	zassert_true(rc == 0, "fcb_append_batch call failure");
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, BATCH_ELEMS, "fetched element count does not match");
+
+	/* Elements are found again after initialization */
+	rc = fcb_init(TEST_FCB_FLASH_AREA_ID, fcb);
+	zassert_true(rc == 0, "fcb_init call failure");
+
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_equal(var_cnt, BATCH_ELEMS, "fetched element count does not match");
+
+	for (i = 0; i < BATCH_ELEMS; i += 9) {
+		rc = fcb_get_nth(fcb, i, &loc);
+		zassert_true(rc == 0, "fcb_get_nth call failure");
+		zassert_equal(loc.fe_data_len, i, "fcb_get_nth: fetched wrong element");
+	}
+
+	rc = fcb_get_nth(fcb, BATCH_ELEMS, &loc);
+	zassert_equal(rc, -ENOENT, "fcb_get_nth past the last element");
+}
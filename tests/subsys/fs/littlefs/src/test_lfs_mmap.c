@@ -0,0 +1,63 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Read-only mapping of littlefs files, which goes through the copy
+ * fallback as littlefs doesn't store files contiguously.
+ */
+
+#include <zephyr/ztest.h>
+#include "testfs_tests.h"
+#include "testfs_lfs.h"
+
+#define MMAP_FILE_LEN 600
+#define MMAP_OFFSET 100
+#define MMAP_LEN 300
+
+ZTEST(littlefs, test_lfs_mmap)
+{
+	struct fs_mount_t *mp = &testfs_small_mnt;
+	struct testfs_path path;
+	struct fs_file_t file;
+	struct fs_mapping map;
+	const uint8_t *data;
+
+	if (!IS_ENABLED(CONFIG_FILE_SYSTEM_MMAP)) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(testfs_lfs_wipe_partition(mp), TC_PASS,
+		      "failed to wipe partition");
+	zassert_equal(fs_mount(mp), 0, "mount failed");
+
+	testfs_path_init(&path, mp, "mmap", TESTFS_PATH_END);
+	fs_file_t_init(&file);
+
+	zassert_equal(fs_open(&file, path.path, FS_O_CREATE | FS_O_RDWR), 0,
+		      "open failed");
+	zassert_equal(testfs_write_incrementing(&file, 0, MMAP_FILE_LEN),
+		      MMAP_FILE_LEN, "write failed");
+	zassert_equal(fs_seek(&file, 10, FS_SEEK_SET), 0, "seek failed");
+
+	zassert_equal(fs_mmap(&file, MMAP_OFFSET, MMAP_LEN, &map), 0,
+		      "mmap failed");
+	zassert_equal(map.len, MMAP_LEN, "wrong mapping length");
+
+	data = map.addr;
+	for (int i = 0; i < MMAP_LEN; i++) {
+		zassert_equal(data[i], (uint8_t)(MMAP_OFFSET + i),
+			      "wrong data at %d", i);
+	}
+
+	zassert_equal(fs_tell(&file), 10, "file position changed");
+	zassert_equal(fs_munmap(&map), 0, "munmap failed");
+	zassert_equal(fs_munmap(&map), -EINVAL, "munmap twice succeeded");
+
+	zassert_equal(fs_mmap(&file, MMAP_FILE_LEN - 10, 20, &map), -EINVAL,
+		      "mmap beyond end of file succeeded");
+
+	zassert_equal(fs_close(&file), 0, "close failed");
+	zassert_equal(fs_unmount(mp), 0, "unmount failed");
+}
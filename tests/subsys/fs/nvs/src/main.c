@@ -962,6 +962,324 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 #endif
 }
 
+/*
+ * Test that the NVS lookup index holds the exact address of the most recent ATE
+ * of each ID, is rebuilt on nvs_mount() and still lets IDs which did not fit in
+ * it be read.
+ */
+ZTEST_F(nvs, test_nvs_index)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+	uint32_t ate_addr;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.lookup_index_count, 0, "uninitialized index");
+
+	/* Write the IDs in descending order to exercise the sorted insertion */
+
+	for (id = CONFIG_NVS_LOOKUP_INDEX_SIZE; id > 0; id--) {
+		data = id;
+		ate_addr = fixture->fs.ate_wra;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+		zassert_equal(fixture->fs.lookup_index_id[0], id, "index not sorted");
+		zassert_equal(fixture->fs.lookup_index_addr[0], ate_addr,
+			      "invalid index entry after write");
+	}
+
+	zassert_equal(fixture->fs.lookup_index_count, CONFIG_NVS_LOOKUP_INDEX_SIZE);
+	zassert_false(fixture->fs.lookup_index_full);
+
+	/* One more ID than the index holds */
+
+	data = 0;
+	err = nvs_write(&fixture->fs, 0, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	zassert_true(fixture->fs.lookup_index_full, "index overflow not flagged");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.lookup_index_count, CONFIG_NVS_LOOKUP_INDEX_SIZE,
+		      "index not rebuilt");
+
+	for (id = 0; id <= CONFIG_NVS_LOOKUP_INDEX_SIZE; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that NVS lookup index does not contain any address from gc-ed sector
+ */
+ZTEST_F(nvs, test_nvs_index_gc)
+{
+#ifdef CONFIG_NVS_LOOKUP_INDEX
+	int err;
+	uint16_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1, then delete it */
+
+	while (fixture->fs.data_wra + sizeof(data) + sizeof(struct nvs_ate)
+	       <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	err = nvs_delete(&fixture->fs, 1);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+	zassert_equal(fixture->fs.lookup_index_count, 1, "deleted ID not indexed");
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Sector 0 has been gc-ed, the deleted ID went with it */
+
+	zassert_equal(fixture->fs.lookup_index_count, 1, "invalid index content after gc");
+	zassert_equal(fixture->fs.lookup_index_id[0], 2, "invalid index content after gc");
+	zassert_equal(nvs_read(&fixture->fs, 1, &data, sizeof(data)), -ENOENT);
+#endif
+}
+
+/*
+ * Test that the entries of a batch are written together, survive a remount and
+ * that entries already stored are left out.
+ */
+ZTEST_F(nvs, test_nvs_batch)
+{
+	int err;
+	ssize_t len;
+	uint8_t buf[512];
+	struct nvs_batch batch;
+	uint32_t data;
+	const uint16_t count = 8;
+#ifdef CONFIG_TEST_NVS_SIMULATOR
+	uint32_t *flash_write_stat = NULL;
+#endif /* CONFIG_TEST_NVS_SIMULATOR */
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_batch_begin(&fixture->fs, &batch, buf, sizeof(buf));
+	zassert_true(err == 0, "nvs_batch_begin call failure: %d", err);
+
+	for (uint16_t id = 1; id <= count; id++) {
+		data = id;
+		len = nvs_batch_add(&batch, id, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_batch_add call failure: %d", len);
+	}
+
+	/* The last value of an ID added twice wins */
+	data = 0xdeadbeef;
+	len = nvs_batch_add(&batch, 1, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "nvs_batch_add call failure: %d", len);
+
+#ifdef CONFIG_TEST_NVS_SIMULATOR
+	if (fixture->sim_stats) {
+		stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+		*flash_write_stat = 0;
+	}
+#endif /* CONFIG_TEST_NVS_SIMULATOR */
+
+	err = nvs_batch_commit(&batch);
+	zassert_equal(err, count + 1, "nvs_batch_commit call failure: %d", err);
+
+#ifdef CONFIG_TEST_NVS_SIMULATOR
+	/* One write for the data and one for the allocation entries */
+	if (flash_write_stat != NULL) {
+		zassert_equal(*flash_write_stat, 2, "unexpected number of flash writes");
+	}
+#endif /* CONFIG_TEST_NVS_SIMULATOR */
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (uint16_t id = 1; id <= count; id++) {
+		len = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_read call failure: %d", len);
+		zassert_equal(data, (id == 1) ? 0xdeadbeef : id, "incorrect data read");
+	}
+
+	/* Nothing to write for an unchanged entry or the delete of a missing one */
+	err = nvs_batch_begin(&fixture->fs, &batch, buf, sizeof(buf));
+	zassert_true(err == 0, "nvs_batch_begin call failure: %d", err);
+
+	data = 2;
+	len = nvs_batch_add(&batch, 2, &data, sizeof(data));
+	zassert_equal(len, 0, "unchanged entry staged");
+	len = nvs_batch_add(&batch, count + 1, NULL, 0);
+	zassert_equal(len, 0, "delete of a missing entry staged");
+	len = nvs_batch_add(&batch, 3, NULL, 0);
+	zassert_equal(len, 0, "nvs_batch_add call failure: %d", len);
+
+	err = nvs_batch_commit(&batch);
+	zassert_equal(err, 1, "nvs_batch_commit call failure: %d", err);
+	zassert_equal(nvs_read(&fixture->fs, 3, &data, sizeof(data)), -ENOENT);
+
+	/* The entries have to fit in the buffer */
+	err = nvs_batch_begin(&fixture->fs, &batch, buf, sizeof(struct nvs_ate));
+	zassert_true(err == 0, "nvs_batch_begin call failure: %d", err);
+	len = nvs_batch_add(&batch, 1, &data, sizeof(data));
+	zassert_equal(len, -ENOSPC, "entry staged past the buffer end");
+}
+
+/*
+ * Test that a batch which does not fit in the active sector is written in the
+ * next one.
+ */
+ZTEST_F(nvs, test_nvs_batch_gc)
+{
+	int err;
+	ssize_t len;
+	uint8_t buf[512];
+	struct nvs_batch batch;
+	uint32_t data = 0;
+	int count;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Leave room for less than the batch in the first sector */
+	while (fixture->fs.ate_wra - fixture->fs.data_wra > sizeof(buf) / 2) {
+		++data;
+		len = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "nvs_write call failure: %d", len);
+	}
+
+	err = nvs_batch_begin(&fixture->fs, &batch, buf, sizeof(buf));
+	zassert_true(err == 0, "nvs_batch_begin call failure: %d", err);
+
+	for (uint16_t id = 2; nvs_batch_add(&batch, id, &id, sizeof(id)) > 0; id++) {
+	}
+
+	count = nvs_batch_commit(&batch);
+	zassert_true(count > 0, "nvs_batch_commit call failure: %d", count);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1, "batch not in next sector");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	len = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "nvs_read call failure: %d", len);
+	for (uint16_t id = 2; id < count + 2; id++) {
+		uint16_t value;
+
+		len = nvs_read(&fixture->fs, id, &value, sizeof(value));
+		zassert_equal(len, sizeof(value), "nvs_read call failure: %d", len);
+		zassert_equal(value, id, "incorrect data read");
+	}
+}
+
+#ifdef CONFIG_NVS_BACKGROUND_GC
+#define BG_GC_ID 1
+#define BG_GC_LIVE_ID 100
+
+static size_t bg_gc_free(struct nvs_fs *fs)
+{
+	return fs->ate_wra - fs->data_wra;
+}
+
+static size_t bg_gc_threshold(struct nvs_fs *fs)
+{
+	return (size_t)fs->sector_size * CONFIG_NVS_BACKGROUND_GC_THRESHOLD / 100U;
+}
+
+static void bg_gc_write(struct nvs_fs *fs, uint16_t id)
+{
+	static uint32_t data;
+	ssize_t len;
+
+	++data;
+	len = nvs_write(fs, id, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "nvs_write call failure: %d", len);
+}
+
+/* Write to the active sector until the background gc moves to the next one */
+static void bg_gc_fill_sector(struct nvs_fs *fs)
+{
+	uint16_t sector = fs->ate_wra >> ADDR_SECT_SHIFT;
+	struct k_work_sync sync;
+
+	while (bg_gc_free(fs) >= bg_gc_threshold(fs)) {
+		bg_gc_write(fs, BG_GC_ID);
+	}
+	zassert_equal(fs->ate_wra >> ADDR_SECT_SHIFT, sector, "sector closed by a write");
+
+	(void)k_work_flush(&fs->gc_work, &sync);
+	zassert_not_equal(fs->ate_wra >> ADDR_SECT_SHIFT, sector,
+			  "no background gc of sector %u", sector);
+}
+
+/*
+ * Test that the background gc runs once the free space of the active sector
+ * drops under the threshold, that it leaves a sector filled with live data
+ * to the writers, and that it runs again when wrapping around to that sector.
+ */
+ZTEST_F(nvs, test_nvs_background_gc)
+{
+	uint16_t live_id = BG_GC_LIVE_ID;
+	uint32_t data;
+	ssize_t len;
+	int err;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Live data taking more than the threshold allows in sector 0 */
+	while (bg_gc_free(&fixture->fs) >= bg_gc_threshold(&fixture->fs)) {
+		bg_gc_write(&fixture->fs, live_id++);
+	}
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1);
+
+	/* Moving to sector 2 copies the live data there, it is left as is */
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2);
+	zassert_equal(fixture->fs.gc_skip_sector, 2, "sector 2 not skipped");
+
+	/* Drop the live data, then let the writers fill and close sector 2 */
+	for (uint16_t id = BG_GC_LIVE_ID; id < live_id; id++) {
+		err = nvs_delete(&fixture->fs, id);
+		zassert_true(err == 0, "nvs_delete call failure: %d", err);
+	}
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 2) {
+		bg_gc_write(&fixture->fs, BG_GC_ID);
+	}
+	zassert_equal(fixture->fs.gc_skip_sector, NVS_GC_NO_SECTOR,
+		      "skipped sector kept after leaving it");
+
+	/* Wrap around, sector 2 is collected in the background again */
+	bg_gc_fill_sector(&fixture->fs);
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2);
+	bg_gc_fill_sector(&fixture->fs);
+
+	len = nvs_read(&fixture->fs, BG_GC_ID, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "nvs_read call failure: %d", len);
+	len = nvs_read(&fixture->fs, BG_GC_LIVE_ID, &data, sizeof(data));
+	zassert_equal(len, -ENOENT, "deleted ID still found: %d", len);
+}
+#endif /* CONFIG_NVS_BACKGROUND_GC */
+
 #ifdef CONFIG_TEST_NVS_SIMULATOR
 /*
  * Test NVS bad region initialization recovery.
@@ -889,3 +889,96 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_ZMS_BACKGROUND_GC
+#define BG_GC_ID      1
+#define BG_GC_LIVE_ID 100
+
+static uint64_t bg_gc_free(struct zms_fs *fs)
+{
+	return fs->ate_wra - fs->data_wra;
+}
+
+static uint64_t bg_gc_threshold(struct zms_fs *fs)
+{
+	return (uint64_t)fs->sector_size * CONFIG_ZMS_BACKGROUND_GC_THRESHOLD / 100U;
+}
+
+static void bg_gc_write(struct zms_fs *fs, uint32_t id)
+{
+	static uint32_t data;
+	ssize_t len;
+
+	++data;
+	len = zms_write(fs, id, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "zms_write call failure: %d", len);
+}
+
+/* Write to the active sector until the background gc moves to the next one */
+static void bg_gc_fill_sector(struct zms_fs *fs)
+{
+	uint64_t sector = fs->ate_wra >> ADDR_SECT_SHIFT;
+	struct k_work_sync sync;
+
+	while (bg_gc_free(fs) >= bg_gc_threshold(fs)) {
+		bg_gc_write(fs, BG_GC_ID);
+	}
+	zassert_equal(fs->ate_wra >> ADDR_SECT_SHIFT, sector, "sector closed by a write");
+
+	(void)k_work_flush(&fs->gc_work, &sync);
+	zassert_not_equal(fs->ate_wra >> ADDR_SECT_SHIFT, sector,
+			  "no background gc of sector %llu", (unsigned long long)sector);
+}
+
+/*
+ * Test that the background gc runs once the free space of the active sector
+ * drops under the threshold, that it leaves a sector filled with live data
+ * to the writers, and that it runs again when wrapping around to that sector.
+ */
+ZTEST_F(zms, test_zms_background_gc)
+{
+	uint32_t live_id = BG_GC_LIVE_ID;
+	uint32_t data;
+	ssize_t len;
+	int err;
+
+	fixture->fs.sector_count = 3;
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 0, "unexpected write sector");
+
+	/* Live data taking more than the threshold allows in sector 0 */
+	while (bg_gc_free(&fixture->fs) >= bg_gc_threshold(&fixture->fs)) {
+		bg_gc_write(&fixture->fs, live_id++);
+	}
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 1, "unexpected write sector");
+
+	/* Moving to sector 2 copies the live data there, it is left as is */
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2, "unexpected write sector");
+	zassert_equal(fixture->fs.gc_skip_sector, 2, "sector 2 not skipped");
+
+	/* Drop the live data, then let the writers fill and close sector 2 */
+	for (uint32_t id = BG_GC_LIVE_ID; id < live_id; id++) {
+		err = zms_delete(&fixture->fs, id);
+		zassert_true(err == 0, "zms_delete call failure: %d", err);
+	}
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 2) {
+		bg_gc_write(&fixture->fs, BG_GC_ID);
+	}
+	zassert_equal(fixture->fs.gc_skip_sector, (uint32_t)ZMS_INVALID_SECTOR_NUM,
+		      "skipped sector kept after leaving it");
+
+	/* Wrap around, sector 2 is collected in the background again */
+	bg_gc_fill_sector(&fixture->fs);
+	bg_gc_fill_sector(&fixture->fs);
+	zassert_equal(fixture->fs.ate_wra >> ADDR_SECT_SHIFT, 2, "unexpected write sector");
+	bg_gc_fill_sector(&fixture->fs);
+
+	len = zms_read(&fixture->fs, BG_GC_ID, &data, sizeof(data));
+	zassert_equal(len, sizeof(data), "zms_read call failure: %d", len);
+	len = zms_read(&fixture->fs, BG_GC_LIVE_ID, &data, sizeof(data));
+	zassert_equal(len, -ENOENT, "deleted ID still found: %d", len);
+}
+#endif /* CONFIG_ZMS_BACKGROUND_GC */
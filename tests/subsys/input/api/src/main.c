@@ -84,6 +84,46 @@ ZTEST(input_api, test_sequence_thread)
 	zassert_equal(message_count_unfiltered, CONFIG_INPUT_QUEUE_MAX_MSGS + 1);
 }
 
+static const struct device fake_batch_dev;
+static size_t batch_sizes[4];
+static int batch_count;
+static K_SEM_DEFINE(batch_done, 0, 1);
+
+static void input_cb_batch(struct input_event *evts, size_t num_evts, void *user_data)
+{
+	for (size_t i = 0; i < num_evts; i++) {
+		zassert_equal(evts[i].dev, &fake_batch_dev);
+		zassert_equal(evts[i].sync, i == num_evts - 1);
+	}
+
+	if (batch_count < ARRAY_SIZE(batch_sizes)) {
+		batch_sizes[batch_count] = num_evts;
+	}
+	batch_count++;
+
+	if (batch_count == 2) {
+		k_sem_give(&batch_done);
+	}
+}
+INPUT_BATCH_CALLBACK_DEFINE(&fake_batch_dev, input_cb_batch, NULL);
+
+ZTEST(input_api, test_batch_thread)
+{
+	batch_count = 0;
+
+	/* queued before the lower priority input thread runs */
+	input_report_abs(&fake_batch_dev, INPUT_ABS_X, 1, false, K_FOREVER);
+	input_report_abs(&fake_batch_dev, INPUT_ABS_Y, 2, false, K_FOREVER);
+	input_report_key(&fake_batch_dev, INPUT_BTN_TOUCH, 1, true, K_FOREVER);
+	input_report_abs(&fake_batch_dev, INPUT_ABS_X, 3, true, K_FOREVER);
+
+	zassert_ok(k_sem_take(&batch_done, K_SECONDS(1)));
+
+	zassert_equal(batch_count, 2);
+	zassert_equal(batch_sizes[0], 3);
+	zassert_equal(batch_sizes[1], 1);
+}
+
 #else /* CONFIG_INPUT_MODE_THREAD */
 
 static void input_cb_filtered(struct input_event *evt, void *user_data)
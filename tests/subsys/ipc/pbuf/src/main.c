@@ -106,6 +106,64 @@ ZTEST(test_pbuf, test_rw)
 	zassert_mem_equal(write_buf, read_buf, MPS);
 }
 
+/* In-place write/read tests. */
+ZTEST(test_pbuf, test_in_place)
+{
+	uint8_t read_buf[MEM_AREA_SZ] = {0};
+	uint8_t write_buf[MEM_AREA_SZ];
+	char *buf;
+	int ret;
+
+	static PBUF_MAYBE_CONST struct pbuf_cfg cfg = PBUF_CFG_INIT(memory_area, MEM_AREA_SZ, 0, 0);
+
+	static struct pbuf pb = {
+		.cfg = &cfg,
+	};
+
+	for (size_t i = 0; i < MEM_AREA_SZ; i++) {
+		write_buf[i] = i+1;
+	}
+
+	zassert_equal(pbuf_tx_init(&pb), 0);
+
+	/* The whole free space is contiguous in an empty buffer. */
+	ret = pbuf_tx_buf_get(&pb, &buf);
+	zassert_true(ret >= MPS);
+	memcpy(buf, write_buf, MSGA_SZ);
+	ret = pbuf_tx_buf_commit(&pb, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+
+	/* The packet can be got in place, and stays until freed. */
+	ret = pbuf_rx_buf_get(&pb, &buf);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_mem_equal(buf, write_buf, MSGA_SZ);
+	ret = pbuf_read(&pb, NULL, 0);
+	zassert_equal(ret, MSGA_SZ);
+	zassert_equal(pbuf_rx_buf_free(&pb, MSGA_SZ), 0);
+	ret = pbuf_read(&pb, NULL, 0);
+	zassert_equal(ret, 0);
+	ret = pbuf_rx_buf_get(&pb, &buf);
+	zassert_equal(ret, 0);
+
+	/* A wrapped packet can only be read. */
+	ret = pbuf_write(&pb, write_buf, MPS);
+	zassert_equal(ret, MPS);
+	ret = pbuf_rx_buf_get(&pb, &buf);
+	zassert_equal(ret, -ENOBUFS);
+	ret = pbuf_read(&pb, read_buf, MPS);
+	zassert_equal(ret, MPS);
+	zassert_mem_equal(write_buf, read_buf, MPS);
+
+	/* Only the space up to the end of the buffer can be written in place. */
+	ret = pbuf_tx_buf_get(&pb, &buf);
+	zassert_true(ret > 0 && ret < MPS);
+	zassert_equal(pbuf_tx_buf_commit(&pb, ret + 1), -EINVAL);
+	memcpy(buf, write_buf, ret);
+	zassert_equal(pbuf_tx_buf_commit(&pb, ret), ret);
+	zassert_equal(pbuf_read(&pb, read_buf, sizeof(read_buf)), ret);
+	zassert_mem_equal(write_buf, read_buf, ret);
+}
+
 /* API ret codes tests. */
 ZTEST(test_pbuf, test_retcodes)
 {
@@ -8,6 +8,7 @@
 Pytest harness to test the output of the dictionary logging.
 '''
 
+import binascii
 import logging
 import os
 import re
@@ -20,7 +21,25 @@ ZEPHYR_BASE = os.getenv("ZEPHYR_BASE")
 
 logger = logging.getLogger(__name__)
 
-def process_logs(dut: DeviceAdapter, build_dir):
+def hex_to_bin(encoded_logs):
+    '''
+    Convert the hexadecimal log data following the marker to binary,
+    stopping at the first character that is not part of it.
+    '''
+    hexdata = encoded_logs[len("##ZLOGV1##"):]
+    end = 0
+
+    while end + 2 <= len(hexdata):
+        try:
+            binascii.unhexlify(hexdata[end:end + 2])
+        except binascii.Error:
+            break
+        end += 2
+
+    return binascii.unhexlify(hexdata[:end])
+
+
+def process_logs(dut: DeviceAdapter, build_dir, is_framed_build):
     '''
     This grabs the encoded log from console and parse the log
     through the dictionary logging parser.
@@ -28,7 +47,8 @@ def process_logs(dut: DeviceAdapter, build_dir):
     Returns the decoded log lines.
     '''
     # Make sure the log parser script is there...
-    parser_script = os.path.join(ZEPHYR_BASE, "scripts", "logging", "dictionary", "log_parser.py")
+    parser_name = "log_parser_stream.py" if is_framed_build else "log_parser.py"
+    parser_script = os.path.join(ZEPHYR_BASE, "scripts", "logging", "dictionary", parser_name)
     assert os.path.isfile(parser_script)
     logger.info(f'Log parser script: {parser_script}')
 
@@ -50,16 +70,30 @@ def process_logs(dut: DeviceAdapter, build_dir):
     ridx = handler_output.rfind("##ZLOGV1##")
     encoded_logs = handler_output[ridx:]
 
-    encoded_log_file = os.path.join(build_dir, "encoded.log")
-    with open(encoded_log_file, 'w', encoding='utf-8') as fp:
-        fp.write(encoded_logs)
+    if is_framed_build:
+        # The streaming parser takes the binary frames
+        encoded_log_file = os.path.join(build_dir, "encoded.bin")
+        with open(encoded_log_file, 'wb') as fp:
+            fp.write(hex_to_bin(encoded_logs))
+
+        cmd = [parser_script, '--debug', dictionary_json, encoded_log_file]
+    else:
+        encoded_log_file = os.path.join(build_dir, "encoded.log")
+        with open(encoded_log_file, 'w', encoding='utf-8') as fp:
+            fp.write(encoded_logs)
+
+        cmd = [parser_script, '--hex', dictionary_json, encoded_log_file]
 
     # Run the log parser
-    cmd = [parser_script, '--hex', dictionary_json, encoded_log_file]
     logger.info(f'Running parser script: {shlex.join(cmd)}')
     result = subprocess.run(cmd, capture_output=True, text=True, check=True)
     assert result.returncode == 0
 
+    if is_framed_build:
+        # Every frame must pass its CRC check once decompressed
+        assert 'Dropped invalid frame' not in result.stderr
+        assert 'error' not in result.stderr.lower()
+
     # Grab the decoded log lines from stdout, print a copy and return it
     decoded_logs = result.stdout
     logger.info(f'Decoded logs: {decoded_logs}')
@@ -150,15 +184,16 @@ def regex_matching(decoded_logs, expected_regex):
     return all(regex_results)
 
 
-def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build):
+def test_logging_dictionary(dut: DeviceAdapter, is_fpu_build, is_framed_build):
     '''
     Main entrance to setup test result validation.
     '''
     build_dir = dut.device_config.app_build_dir
 
     logger.info(f'FPU build? {is_fpu_build}')
+    logger.info(f'Framed build? {is_framed_build}')
 
-    decoded_logs = process_logs(dut, build_dir)
+    decoded_logs = process_logs(dut, build_dir, is_framed_build)
 
     assert regex_matching(decoded_logs, expected_regex_common())
 
@@ -820,6 +820,62 @@ ZTEST(test_log_api, test_log_wrn_once)
 	process_and_validate(false, false);
 }
 
+static void log_wrn_ratelimit_run(int i)
+{
+	LOG_WRN_RATELIMIT(2, "ratelimit %d", i);
+}
+
+ZTEST(test_log_api, test_log_wrn_ratelimit)
+{
+	log_timestamp_t exp_timestamp = TIMESTAMP_INIT_VAL;
+
+	log_setup(false);
+
+	mock_log_frontend_record(LOG_CURRENT_MODULE_ID(), LOG_LEVEL_WRN, "ratelimit 0");
+	mock_log_backend_record(&backend1, LOG_CURRENT_MODULE_ID(),
+				Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "ratelimit 0");
+	mock_log_frontend_record(LOG_CURRENT_MODULE_ID(), LOG_LEVEL_WRN, "ratelimit 1");
+	mock_log_backend_record(&backend1, LOG_CURRENT_MODULE_ID(),
+				Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+				exp_timestamp++, "ratelimit 1");
+
+	/* All calls are well within one interval */
+	for (int i = 0; i < 5; i++) {
+		log_wrn_ratelimit_run(i);
+	}
+
+	process_and_validate(false, false);
+}
+
+static void log_wrn_sampled_run(int i)
+{
+	LOG_WRN_SAMPLED(3, "sampled %d", i);
+}
+
+ZTEST(test_log_api, test_log_wrn_sampled)
+{
+	log_timestamp_t exp_timestamp = TIMESTAMP_INIT_VAL;
+
+	log_setup(false);
+
+	for (int i = 0; i < 7; i += 3) {
+		char str[16];
+
+		snprintk(str, sizeof(str), "sampled %d", i);
+		mock_log_frontend_record(LOG_CURRENT_MODULE_ID(), LOG_LEVEL_WRN, str);
+		mock_log_backend_record(&backend1, LOG_CURRENT_MODULE_ID(),
+					Z_LOG_LOCAL_DOMAIN_ID, LOG_LEVEL_WRN,
+					exp_timestamp++, str);
+	}
+
+	for (int i = 0; i < 7; i++) {
+		log_wrn_sampled_run(i);
+	}
+
+	process_and_validate(false, false);
+}
+
 ZTEST(test_log_api, test_log_override_level)
 {
 	log_timestamp_t exp_timestamp = TIMESTAMP_INIT_VAL;
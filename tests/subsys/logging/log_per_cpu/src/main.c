@@ -0,0 +1,195 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+
+LOG_MODULE_REGISTER(test);
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Each message carries the CPU it was logged from and its rank on it */
+#define CNT_BITS   28
+#define MAX_MSGS   64
+#define MERGE_MSGS 10
+/* Fits in the buffer of a CPU, unlike the flood */
+#define SMALL_MSGS 8
+#define FLOOD_MSGS 200
+
+struct mock_log_backend {
+	uint32_t cnt;
+	uint32_t dropped;
+	uint32_t cpu_cnt[2];
+	uint32_t args[MAX_MSGS];
+	log_timestamp_t timestamps[MAX_MSGS];
+};
+
+static struct mock_log_backend mock_backend;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACK_SIZE);
+static struct k_thread threads[2];
+
+static void process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+	uint32_t arg;
+
+	package += 2 * sizeof(void *);
+	arg = *(uint32_t *)package;
+
+	mock_backend.cpu_cnt[arg >> CNT_BITS]++;
+
+	if (mock_backend.cnt < MAX_MSGS) {
+		mock_backend.args[mock_backend.cnt] = arg;
+		mock_backend.timestamps[mock_backend.cnt] = log_msg_get_timestamp(&msg->log);
+	}
+
+	mock_backend.cnt++;
+}
+
+static void mock_init(struct log_backend const *const backend)
+{
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	zassert_true(false);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	mock_backend.dropped += cnt;
+}
+
+static const struct log_backend_api log_backend_api = {
+	.process = process,
+	.panic = panic,
+	.init = mock_init,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(test, log_backend_api, true, NULL);
+
+static void log_msgs(void *p1, void *p2, void *p3)
+{
+	uint32_t cpu = POINTER_TO_UINT(p1);
+	uint32_t cnt = POINTER_TO_UINT(p2);
+	uint32_t delay_us = POINTER_TO_UINT(p3);
+
+	zassert_equal(arch_curr_cpu()->id, cpu, "Not running on CPU %u", cpu);
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		LOG_INF("%u", (cpu << CNT_BITS) | i);
+		k_busy_wait(delay_us);
+	}
+}
+
+static void start_logging(uint32_t cpu, uint32_t cnt, uint32_t delay_us)
+{
+	k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE, log_msgs, UINT_TO_POINTER(cpu),
+			UINT_TO_POINTER(cnt), UINT_TO_POINTER(delay_us), K_PRIO_PREEMPT(5), 0,
+			K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(&threads[cpu], cpu));
+	k_thread_start(&threads[cpu]);
+}
+
+static void log_on(uint32_t cpu, uint32_t cnt)
+{
+	start_logging(cpu, cnt, 0);
+	zassert_ok(k_thread_join(&threads[cpu], K_SECONDS(5)));
+}
+
+static void process_all(void)
+{
+	while (log_process()) {
+	}
+}
+
+/* Messages logged at the same time on both CPUs are merged by timestamp */
+ZTEST(log_per_cpu, test_merge)
+{
+	uint32_t next[2] = { 0 };
+
+	start_logging(0, MERGE_MSGS, 10);
+	start_logging(1, MERGE_MSGS, 10);
+	zassert_ok(k_thread_join(&threads[0], K_SECONDS(5)));
+	zassert_ok(k_thread_join(&threads[1], K_SECONDS(5)));
+
+	process_all();
+
+	zassert_equal(mock_backend.dropped, 0);
+	zassert_equal(mock_backend.cnt, 2 * MERGE_MSGS);
+
+	for (uint32_t i = 0; i < mock_backend.cnt; i++) {
+		uint32_t cpu = mock_backend.args[i] >> CNT_BITS;
+
+		zassert_equal(mock_backend.args[i] & BIT_MASK(CNT_BITS), next[cpu],
+			      "Message %u of CPU %u out of order", next[cpu], cpu);
+		next[cpu]++;
+
+		if (i > 0) {
+			zassert_true(mock_backend.timestamps[i] >= mock_backend.timestamps[i - 1],
+				     "Message %u not merged by timestamp", i);
+		}
+	}
+}
+
+/* A CPU flooding its buffer does not make the other CPU lose messages */
+ZTEST(log_per_cpu, test_isolation)
+{
+	log_on(1, SMALL_MSGS);
+	log_on(0, FLOOD_MSGS);
+	log_on(1, SMALL_MSGS);
+
+	process_all();
+
+	zassert_equal(mock_backend.cpu_cnt[1], 2 * SMALL_MSGS, "CPU 1 lost %u messages",
+		      2 * SMALL_MSGS - mock_backend.cpu_cnt[1]);
+	zassert_true(mock_backend.dropped > 0, "Flood did not fill the buffer");
+	zassert_equal(mock_backend.cpu_cnt[0] + mock_backend.dropped, FLOOD_MSGS);
+}
+
+/* The memory usage covers the buffers of all the CPUs */
+ZTEST(log_per_cpu, test_mem_usage)
+{
+	uint32_t size, usage;
+
+	zassert_ok(log_mem_get_usage(&size, &usage));
+
+	/* Each buffer keeps a word to tell full from empty */
+	zassert_equal(size, CONFIG_LOG_BUFFER_SIZE - CONFIG_MP_MAX_NUM_CPUS * sizeof(int),
+		      "Size %u", size);
+	zassert_equal(usage, 0);
+
+	log_on(0, SMALL_MSGS);
+	zassert_ok(log_mem_get_usage(&size, &usage));
+	zassert_true(usage > 0);
+
+	process_all();
+	zassert_ok(log_mem_get_usage(&size, &usage));
+	zassert_equal(usage, 0);
+}
+
+static bool predicate(const void *state)
+{
+	ARG_UNUSED(state);
+
+	return arch_num_cpus() > 1;
+}
+
+static void before(void *data)
+{
+	ARG_UNUSED(data);
+
+	process_all();
+	memset(&mock_backend, 0, sizeof(mock_backend));
+}
+
+ZTEST_SUITE(log_per_cpu, predicate, NULL, before, NULL, NULL);
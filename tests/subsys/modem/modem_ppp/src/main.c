@@ -20,7 +20,10 @@
 #include <zephyr/modem/ppp.h>
 #include <modem_backend_mock.h>
 
+/* Also limits the size of mock pipe reads and writes to half of it */
+#ifndef TEST_MODEM_PPP_BUF_SIZE
 #define TEST_MODEM_PPP_BUF_SIZE		     (16)
+#endif
 #define TEST_MODEM_PPP_TX_PKT_BUF_SIZE	     (5)
 #define TEST_MODEM_PPP_MOCK_PIPE_RX_BUF_SIZE (4096)
 #define TEST_MODEM_PPP_MOCK_PIPE_TX_BUF_SIZE (4096)
@@ -28,6 +31,7 @@
 #define TEST_MODEM_PPP_IP_FRAME_SEND_MULT_N	(5)
 #define TEST_MODEM_PPP_IP_FRAME_SEND_LARGE_N	(2048)
 #define TEST_MODEM_PPP_IP_FRAME_RECEIVE_LARGE_N (2048)
+#define TEST_MODEM_PPP_IP_FRAME_RECEIVE_RUNS_N	(40)
 
 /*************************************************************************************************/
 /*                                          Mock pipe                                            */
@@ -228,6 +232,37 @@ static void test_modem_ppp_generate_ppp_frame(uint8_t *frame, size_t size)
 	frame[size - 1] = fcs;
 }
 
+/*
+ * Generates a frame of plain runs of increasing length, each followed by a byte which must be
+ * escaped, so that escapes land at every offset within a word and a read.
+ */
+static size_t test_modem_ppp_generate_runs_ppp_frame(uint8_t *frame)
+{
+	static const uint8_t escaped[] = {0x7E, 0x7D, 0x00, 0x13};
+	uint8_t byte;
+	uint16_t fcs;
+	size_t size = 0;
+
+	frame[size++] = 0x00;
+	frame[size++] = 0x21;
+
+	for (size_t run = 0; run < TEST_MODEM_PPP_IP_FRAME_RECEIVE_RUNS_N; run++) {
+		for (size_t i = 0; i < run; i++) {
+			frame[size++] = 0x20 + ((run + i) % 0x5D);
+		}
+
+		frame[size++] = escaped[run % ARRAY_SIZE(escaped)];
+	}
+
+	byte = 0x03;
+	fcs = crc16_ccitt(0xFFFF, &byte, 0x01);
+	fcs = crc16_ccitt(fcs, frame, size) ^ 0xFFFF;
+
+	frame[size++] = fcs >> 8;
+	frame[size++] = fcs;
+	return size;
+}
+
 static size_t test_modem_ppp_wrap_ppp_frame(uint8_t *wrapped, const uint8_t *frame, size_t size)
 {
 	size_t wrapped_pos = 4;
@@ -271,7 +306,7 @@ static void *test_modem_ppp_setup(void)
 		.rx_buf_size = sizeof(mock_rx_buf),
 		.tx_buf = mock_tx_buf,
 		.tx_buf_size = sizeof(mock_tx_buf),
-		.limit = 8,
+		.limit = TEST_MODEM_PPP_BUF_SIZE / 2,
 	};
 
 	mock_pipe = modem_backend_mock_init(&mock, &mock_config);
@@ -516,6 +551,43 @@ ZTEST(modem_ppp, test_ip_frame_receive_large)
 	/* FCS is removed from packet data */
 	zassert_true(pkt_len == (TEST_MODEM_PPP_IP_FRAME_RECEIVE_LARGE_N - 2),
 		     "Incorrect length of net packet received");
+
+	/* Validate data of received frame */
+	net_pkt_cursor_init(pkt);
+	zassert_ok(net_pkt_read(pkt, unwrapped_buffer, pkt_len));
+	zassert_true(memcmp(unwrapped_buffer, buffer, pkt_len) == 0,
+		     "Received net pkt data incorrect");
+}
+
+ZTEST(modem_ppp, test_ip_frame_receive_runs)
+{
+	struct net_pkt *pkt;
+	size_t frame_size;
+	size_t size;
+
+	frame_size = test_modem_ppp_generate_runs_ppp_frame(buffer);
+	size = test_modem_ppp_wrap_ppp_frame(wrapped_buffer, buffer, frame_size);
+
+	/* Put the frame twice back to back */
+	memcpy(&wrapped_buffer[size], wrapped_buffer, size);
+	modem_backend_mock_put(&mock, wrapped_buffer, size * 2);
+
+	k_msleep(size * 4);
+
+	zassert_true(received_packets_len == 2, "Expected to receive two network packets");
+
+	for (size_t i = 0; i < received_packets_len; i++) {
+		pkt = received_packets[i];
+
+		/* FCS is removed from packet data */
+		zassert_true(net_pkt_get_len(pkt) == (frame_size - 2),
+			     "Incorrect length of net packet received");
+
+		net_pkt_cursor_init(pkt);
+		zassert_ok(net_pkt_read(pkt, unwrapped_buffer, frame_size - 2));
+		zassert_true(memcmp(unwrapped_buffer, buffer, frame_size - 2) == 0,
+			     "Received net pkt data incorrect");
+	}
 }
 
 ZTEST_SUITE(modem_ppp, NULL, test_modem_ppp_setup, test_modem_ppp_before, NULL, NULL);
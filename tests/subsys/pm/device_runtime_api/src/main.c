@@ -314,6 +314,45 @@ ZTEST(device_runtime_api, test_pm_device_runtime_auto)
 	zassert_equal(pm_device_runtime_put(dev), 0, "");
 }
 
+ZTEST(device_runtime_api, test_pm_device_runtime_autosuspend)
+{
+	const struct device *const dev = DEVICE_DT_GET(DT_NODELABEL(test_dev));
+	enum pm_device_state state;
+
+#ifdef CONFIG_PM_DEVICE_RUNTIME_ASYNC
+	/* The delay comes from devicetree */
+	zassert_equal(pm_device_runtime_get(dev), 0);
+	zassert_equal(pm_device_runtime_put(dev), 0);
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDING);
+
+	/* Getting it again within the delay keeps it active */
+	zassert_equal(pm_device_runtime_get(dev), 0);
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_ACTIVE);
+
+	zassert_equal(pm_device_runtime_put(dev), 0);
+	k_sleep(K_MSEC(60));
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+
+	/* Without delay the device is suspended right away */
+	zassert_equal(pm_device_runtime_autosuspend_delay_set(dev, 0), 0);
+	zassert_equal(pm_device_runtime_get(dev), 0);
+	zassert_equal(pm_device_runtime_put(dev), 0);
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+
+	zassert_equal(pm_device_runtime_autosuspend_delay_set(dev, 50), 0);
+#else
+	zassert_equal(pm_device_runtime_autosuspend_delay_set(dev, 0), -ENOSYS);
+	zassert_equal(pm_device_runtime_get(dev), 0);
+	zassert_equal(pm_device_runtime_put(dev), 0);
+	(void)pm_device_state_get(dev, &state);
+	zassert_equal(state, PM_DEVICE_STATE_SUSPENDED);
+#endif /* CONFIG_PM_DEVICE_RUNTIME_ASYNC */
+}
+
 void *device_runtime_api_setup(void)
 {
 	test_dev = device_get_binding("test_driver");
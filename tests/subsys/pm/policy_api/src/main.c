@@ -304,6 +304,52 @@ ZTEST(policy_api, test_pm_policy_next_state_custom)
 }
 #endif /* CONFIG_PM_POLICY_CUSTOM */
 
+#ifdef CONFIG_PM_POLICY_MENU
+#define MENU_IDLE_MS 20
+#define MENU_BUSY_US 50000U
+#define MENU_PERIODS 8U
+
+/**
+ * @brief Test that the menu policy measures the idle periods of cpu 0 up to
+ * the wakeup when CONFIG_PM_POLICY_MENU=y.
+ */
+ZTEST(policy_api, test_pm_policy_next_state_menu)
+{
+	struct pm_policy_menu_stats stats;
+	uint32_t hist_total = 0U;
+
+	pm_policy_menu_stats_reset();
+
+	/* Too short for any state, the idle thread goes through k_cpu_idle() */
+	for (uint32_t i = 0U; i < MENU_PERIODS; i++) {
+		k_msleep(MENU_IDLE_MS);
+		/* Woken thread running, the CPU is not idle anymore */
+		k_busy_wait(MENU_BUSY_US);
+	}
+
+	zassert_ok(pm_policy_menu_stats_get(0U, &stats));
+	zassert_true(stats.idle_count >= MENU_PERIODS, "%u idle periods", stats.idle_count);
+	zassert_true(stats.residency_us >= MENU_PERIODS * MENU_IDLE_MS * 1000U / 2U,
+		     "idle residency %llu us too short",
+		     (unsigned long long)stats.residency_us);
+	zassert_true(stats.residency_us <
+		     MENU_PERIODS * (MENU_IDLE_MS * 1000U + MENU_BUSY_US / 2U),
+		     "idle residency %llu us includes busy time",
+		     (unsigned long long)stats.residency_us);
+	for (int i = 0; i < CONFIG_PM_POLICY_MENU_HIST_BUCKETS; i++) {
+		hist_total += stats.hist[i];
+	}
+	zassert_equal(hist_total, stats.idle_count);
+
+	zassert_equal(pm_policy_menu_stats_get(2U, &stats), -EINVAL);
+}
+#else
+ZTEST(policy_api, test_pm_policy_next_state_menu)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_PM_POLICY_MENU */
+
 ZTEST(policy_api, test_pm_policy_events)
 {
 	struct pm_policy_event evt1;
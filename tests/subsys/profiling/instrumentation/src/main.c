@@ -0,0 +1,164 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/profiling/instrumentation.h>
+
+#define BUFFER_SIZE CONFIG_PROFILING_INSTRUMENTATION_BUFFER_SIZE
+
+/* Records of the functions below, made by the test thread */
+struct calls {
+	size_t count;
+	size_t others;
+	struct instr_record records[2 * BUFFER_SIZE];
+};
+
+static volatile int depth;
+
+static __noinline void inner(void)
+{
+	depth++;
+}
+
+static __noinline void outer(void)
+{
+	inner();
+	depth--;
+}
+
+static __noinline void marker(void)
+{
+	depth = 0;
+}
+
+/* Not instrumented, so that it adds no record of its own */
+static __attribute__((no_instrument_function)) bool traced(uintptr_t func)
+{
+	return (func == (uintptr_t)inner) || (func == (uintptr_t)outer) ||
+	       (func == (uintptr_t)marker);
+}
+
+static __attribute__((no_instrument_function)) void collect(unsigned int cpu,
+							    const struct instr_record *record,
+							    void *user_data)
+{
+	struct calls *calls = user_data;
+
+	ARG_UNUSED(cpu);
+
+	if (!traced(record->func) || (record->thread != (uintptr_t)k_current_get())) {
+		calls->others++;
+		return;
+	}
+
+	zassert_true(calls->count < ARRAY_SIZE(calls->records));
+	calls->records[calls->count++] = *record;
+}
+
+static void check_record(const struct calls *calls, size_t i, void (*func)(void),
+			 uint32_t type)
+{
+	zassert_true(i < calls->count, "Missing record %zu", i);
+	zassert_equal(calls->records[i].func, (uintptr_t)func, "Record %zu of another function",
+		      i);
+	zassert_equal(calls->records[i].type, type, "Record %zu of type %u", i,
+		      calls->records[i].type);
+}
+
+/* Entries and exits of nested calls are recorded in order */
+ZTEST(instrumentation, test_nested_calls)
+{
+	static struct calls calls;
+
+	instr_reset();
+	instr_start();
+	zassert_true(instr_is_enabled());
+	outer();
+	instr_stop();
+
+	zassert_false(instr_is_enabled());
+	zassert_ok(instr_foreach(collect, &calls));
+
+	zassert_equal(calls.count, 4, "%zu records", calls.count);
+	check_record(&calls, 0, outer, INSTR_RECORD_ENTRY);
+	check_record(&calls, 1, inner, INSTR_RECORD_ENTRY);
+	check_record(&calls, 2, inner, INSTR_RECORD_EXIT);
+	check_record(&calls, 3, outer, INSTR_RECORD_EXIT);
+
+	for (size_t i = 1; i < calls.count; i++) {
+		zassert_true(calls.records[i].timestamp - calls.records[i - 1].timestamp <
+			     (UINT32_MAX / 2), "Record %zu older than the previous one", i);
+	}
+
+	zassert_equal(instr_dropped(), 0);
+}
+
+/* Nothing is recorded while stopped, and records are not walked while recording */
+ZTEST(instrumentation, test_stopped)
+{
+	static struct calls calls;
+
+	instr_reset();
+	outer();
+
+	zassert_ok(instr_foreach(collect, &calls));
+	zassert_equal(calls.count, 0);
+	zassert_equal(calls.others, 0);
+
+	instr_start();
+	zassert_equal(instr_foreach(collect, &calls), -EBUSY);
+	instr_stop();
+}
+
+/*
+ * Once a buffer is full, the oldest records are overwritten, or the new
+ * ones are dropped, and the lost records are counted.
+ */
+ZTEST(instrumentation, test_full)
+{
+	static struct calls calls;
+	size_t recorded;
+
+	instr_reset();
+	instr_start();
+	for (int i = 0; i < BUFFER_SIZE; i++) {
+		inner();
+	}
+	marker();
+	instr_stop();
+
+	zassert_ok(instr_foreach(collect, &calls));
+
+	/* The test thread may be interrupted, others record on other CPUs */
+	recorded = calls.count + calls.others;
+	zassert_true(recorded <= BUFFER_SIZE * arch_num_cpus());
+	zassert_true(instr_dropped() >= 2 * BUFFER_SIZE + 2 - recorded,
+		     "%u dropped for %zu records", instr_dropped(), recorded);
+
+	if (IS_ENABLED(CONFIG_PROFILING_INSTRUMENTATION_OVERWRITE)) {
+		check_record(&calls, calls.count - 2, marker, INSTR_RECORD_ENTRY);
+		check_record(&calls, calls.count - 1, marker, INSTR_RECORD_EXIT);
+	} else {
+		check_record(&calls, 0, inner, INSTR_RECORD_ENTRY);
+		check_record(&calls, 1, inner, INSTR_RECORD_EXIT);
+
+		for (size_t i = 0; i < calls.count; i++) {
+			zassert_not_equal(calls.records[i].func, (uintptr_t)marker,
+					  "Record %zu made once full", i);
+		}
+	}
+
+	/* A reset makes room again */
+	instr_reset();
+	zassert_equal(instr_dropped(), 0);
+
+	memset(&calls, 0, sizeof(calls));
+	zassert_ok(instr_foreach(collect, &calls));
+	zassert_equal(calls.count + calls.others, 0);
+}
+
+ZTEST_SUITE(instrumentation, NULL, NULL, NULL, NULL, NULL);
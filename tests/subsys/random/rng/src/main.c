@@ -17,6 +17,10 @@
 #include <kernel_internal.h>
 #include <zephyr/random/random.h>
 
+#if defined(CONFIG_CHACHA20_CSPRNG_GENERATOR)
+#include "chacha20.h"
+#endif
+
 #define N_VALUES 10
 
 
@@ -121,4 +125,32 @@ ZTEST(rng_common, test_rand32)
 #endif /* CONFIG_CSPRNG_ENABLED */
 }
 
+#if defined(CONFIG_CHACHA20_CSPRNG_GENERATOR)
+/* RFC 8439, 2.3.2: test vector for the ChaCha20 block function */
+ZTEST(rng_common, test_chacha20_block)
+{
+	static const uint8_t expected[CHACHA20_BLOCK_SIZE] = {
+		0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15,
+		0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+		0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03,
+		0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+		0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09,
+		0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+		0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9,
+		0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e,
+	};
+	/* Key 00:01:02:...:1f, nonce 00:00:00:09:00:00:00:4a:00:00:00:00 */
+	const uint32_t key[CHACHA20_KEY_WORDS] = {
+		0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+		0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c,
+	};
+	const uint32_t nonce[CHACHA20_NONCE_WORDS] = { 0x09000000, 0x4a000000, 0x00000000 };
+	uint8_t out[CHACHA20_BLOCK_SIZE];
+
+	chacha20_block(key, 1, nonce, out);
+
+	zassert_mem_equal(out, expected, sizeof(expected), "ChaCha20 block mismatch");
+}
+#endif /* CONFIG_CHACHA20_CSPRNG_GENERATOR */
+
 ZTEST_SUITE(rng_common, NULL, NULL, NULL, NULL, NULL);
@@ -26,6 +26,9 @@ struct rtio_iodev_test_data {
 	/* Count of submit calls */
 	atomic_t submit_count;
 
+	/* Count of submit_batch calls */
+	atomic_t batch_count;
+
 	/* Lock around kicking off next timer */
 	struct k_spinlock lock;
 };
@@ -126,10 +129,29 @@ static void rtio_iodev_test_submit(struct rtio_iodev_sqe *iodev_sqe)
 	rtio_iodev_test_next(data, false);
 }
 
+static void rtio_iodev_test_submit_batch(struct rtio_iodev_sqe **iodev_sqes, size_t count)
+{
+	struct rtio_iodev *iodev = (struct rtio_iodev *)iodev_sqes[0]->sqe.iodev;
+	struct rtio_iodev_test_data *data = iodev->data;
+
+	atomic_inc(&data->batch_count);
+
+	for (size_t i = 0; i < count; i++) {
+		mpsc_push(&data->io_q, &iodev_sqes[i]->q);
+	}
+
+	rtio_iodev_test_next(data, false);
+}
+
 const struct rtio_iodev_api rtio_iodev_test_api = {
 	.submit = rtio_iodev_test_submit,
 };
 
+const struct rtio_iodev_api rtio_iodev_test_batch_api = {
+	.submit = rtio_iodev_test_submit,
+	.submit_batch = rtio_iodev_test_submit_batch,
+};
+
 void rtio_iodev_test_init(struct rtio_iodev *test)
 {
 	struct rtio_iodev_test_data *data = test->data;
@@ -137,6 +159,7 @@ void rtio_iodev_test_init(struct rtio_iodev *test)
 	mpsc_init(&data->io_q);
 	data->txn_head = NULL;
 	data->txn_curr = NULL;
+	atomic_clear(&data->batch_count);
 	k_timer_init(&data->timer, rtio_iodev_timer_fn, NULL);
 }
 
@@ -144,6 +167,10 @@ void rtio_iodev_test_init(struct rtio_iodev *test)
 	static struct rtio_iodev_test_data _iodev_data_##name;                                     \
 	RTIO_IODEV_DEFINE(name, &rtio_iodev_test_api, &_iodev_data_##name)
 
+#define RTIO_IODEV_TEST_BATCH_DEFINE(name)                                                         \
+	static struct rtio_iodev_test_data _iodev_data_##name;                                     \
+	RTIO_IODEV_DEFINE(name, &rtio_iodev_test_batch_api, &_iodev_data_##name)
+
 
 
 #endif /* RTIO_IODEV_TEST_H_ */
@@ -649,6 +649,71 @@ ZTEST(rtio_api, test_rtio_cqe_count_overflow)
 	}
 }
 
+RTIO_DEFINE(r_batch, SQE_POOL_SIZE, CQE_POOL_SIZE);
+
+RTIO_IODEV_TEST_BATCH_DEFINE(iodev_test_batch);
+RTIO_IODEV_TEST_DEFINE(iodev_test_batch_other);
+
+/**
+ * @brief Test batched submissions
+ *
+ * Ensures that consecutive submissions to an iodev implementing submit_batch
+ * are handed to it together, that a submission to another iodev splits the
+ * batch, and that completions still come in order.
+ */
+ZTEST(rtio_api, test_rtio_batch)
+{
+	struct rtio *r = &r_batch;
+	struct rtio_iodev_test_data *data = iodev_test_batch.data;
+	struct rtio_iodev *iodevs[4] = {&iodev_test_batch, &iodev_test_batch,
+					&iodev_test_batch_other, &iodev_test_batch};
+	uint32_t userdata[4] = {0, 1, 2, 3};
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int res;
+
+	rtio_iodev_test_init(&iodev_test_batch);
+	rtio_iodev_test_init(&iodev_test_batch_other);
+	atomic_clear(&data->submit_count);
+
+	for (int i = 0; i < 4; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, &iodev_test_batch, &userdata[i]);
+	}
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_submit");
+	zassert_equal(atomic_get(&data->batch_count), 1, "Expected a single batch");
+	zassert_equal(atomic_get(&data->submit_count), 0, "Expected no single submission");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, &userdata[i], "Expected in order completions");
+		rtio_cqe_release(r, cqe);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		sqe = rtio_sqe_acquire(r);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, iodevs[i], &userdata[i]);
+	}
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_submit");
+	zassert_equal(atomic_get(&data->batch_count), 2, "Expected the first two batched");
+	zassert_equal(atomic_get(&data->submit_count), 1, "Expected the last one alone");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_cqe_consume(r);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		rtio_cqe_release(r, cqe);
+	}
+}
+
 #define RTIO_DELAY_NUM_ELEMS 10
 
 RTIO_DEFINE(r_delay, RTIO_DELAY_NUM_ELEMS, RTIO_DELAY_NUM_ELEMS);
@@ -394,6 +394,49 @@ ZTEST(lib_stream_flash, test_stream_flash_flush)
 	zassert_equal(rc, 0, "expected success");
 }
 
+#ifdef CONFIG_STREAM_FLASH_DOUBLE_BUFFER
+ZTEST(lib_stream_flash, test_stream_flash_double_buffer)
+{
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_double_buffer_enable(&ctx);
+	zassert_equal(rc, -EBUSY, "should fail as data is buffered");
+
+	init_target();
+
+	rc = stream_flash_double_buffer_enable(&ctx);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_double_buffer_enable(&ctx);
+	zassert_equal(rc, -EALREADY, "should fail as already enabled");
+	zassert_equal(ctx.buf_len, BUF_LEN / 2, "expected half of the buffer");
+
+	/* Fill the halves a few times, then flush a partial one */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN * 3 + 128, false);
+	zassert_equal(rc, 0, "expected success");
+	zassert_true(stream_flash_bytes_written(&ctx) <= BUF_LEN * 3,
+		     "half being filled should not be accounted");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 3 + 128,
+		      "all data should be written once flushed");
+	VERIFY_WRITTEN(0, BUF_LEN * 3 + 128);
+
+	/* A failed write is reported by a later call */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN / 2, false);
+	zassert_equal(rc, 0, "expected write to be deferred");
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN * 3 + 128,
+		      "failed write should not be accounted");
+}
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 ZTEST(lib_stream_flash, test_stream_flash_buffered_write_whole_page)
 {
@@ -0,0 +1,168 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/tracing/tracing_format.h>
+#include <tracing_buffer.h>
+#include <tracing_core.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Records are written in bursts, leaving time to the tracing thread */
+#define BURSTS     8
+#define BURST_LEN  8
+#define RECORD_CNT (BURSTS * BURST_LEN)
+
+/* Not ASCII, so not found in the strings of the kernel events */
+#define RECORD_MAGIC0 0xFE
+#define RECORD_MAGIC1 0xCA
+
+struct record {
+	uint8_t magic[2];
+	uint8_t cpu;
+	uint8_t reserved;
+	uint16_t seq;
+} __packed;
+
+extern uint8_t ram_tracing[CONFIG_RAM_TRACING_BUFFER_SIZE];
+
+/* Output of each CPU, rebuilt from the chunks */
+static uint8_t streams[2][CONFIG_RAM_TRACING_BUFFER_SIZE / 2];
+static size_t stream_len[2];
+
+static uint8_t enable_cmd[] = "enable";
+static uint8_t disable_cmd[] = "disable";
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACK_SIZE);
+static struct k_thread threads[2];
+
+static void trace_records(void *p1, void *p2, void *p3)
+{
+	uint8_t cpu = POINTER_TO_UINT(p1);
+	struct record record = {
+		.magic = { RECORD_MAGIC0, RECORD_MAGIC1 },
+		.cpu = cpu,
+	};
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(arch_curr_cpu()->id, cpu, "Not running on CPU %u", cpu);
+
+	for (uint16_t i = 0; i < RECORD_CNT; i++) {
+		record.seq = sys_cpu_to_le16(i);
+		tracing_format_raw_data((uint8_t *)&record, sizeof(record));
+
+		if ((i % BURST_LEN) == (BURST_LEN - 1)) {
+			k_msleep(10);
+		}
+	}
+}
+
+static void split_chunks(void)
+{
+	const struct tracing_cpu_chunk_hdr *hdr;
+	size_t pos = 0;
+	uint16_t len;
+
+	/* The RAM backend only holds chunks, the rest of it is zeroed */
+	while (pos + sizeof(*hdr) <= sizeof(ram_tracing)) {
+		hdr = (const struct tracing_cpu_chunk_hdr *)&ram_tracing[pos];
+
+		if ((hdr->magic[0] != TRACING_CPU_CHUNK_MAGIC0) ||
+		    (hdr->magic[1] != TRACING_CPU_CHUNK_MAGIC1)) {
+			break;
+		}
+
+		len = sys_le16_to_cpu(hdr->len);
+		pos += sizeof(*hdr);
+
+		zassert_true(len > 0U, "Empty chunk at %zu", pos);
+		zassert_true(pos + len <= sizeof(ram_tracing), "Truncated chunk at %zu", pos);
+
+		if (hdr->cpu >= ARRAY_SIZE(streams)) {
+			/* Events of a CPU not used by the test */
+			pos += len;
+			continue;
+		}
+
+		zassert_true(stream_len[hdr->cpu] + len <= sizeof(streams[0]));
+		memcpy(&streams[hdr->cpu][stream_len[hdr->cpu]], &ram_tracing[pos], len);
+		stream_len[hdr->cpu] += len;
+		pos += len;
+	}
+
+	zassert_true(pos > 0U, "No chunk output");
+	zassert_true((pos == sizeof(ram_tracing)) || (ram_tracing[pos] == 0U),
+		     "Garbage after the chunks at %zu", pos);
+}
+
+static void check_stream(uint8_t cpu)
+{
+	const struct record *record;
+	uint16_t next = 0;
+
+	for (size_t i = 0; i + sizeof(*record) <= stream_len[cpu]; i++) {
+		record = (const struct record *)&streams[cpu][i];
+
+		if ((record->magic[0] != RECORD_MAGIC0) || (record->magic[1] != RECORD_MAGIC1)) {
+			continue;
+		}
+
+		zassert_equal(record->cpu, cpu, "Record of CPU %u in the stream of CPU %u",
+			      record->cpu, cpu);
+		zassert_equal(sys_le16_to_cpu(record->seq), next,
+			      "Got record %u instead of %u from CPU %u",
+			      sys_le16_to_cpu(record->seq), next, cpu);
+		next++;
+		i += sizeof(*record) - 1;
+	}
+
+	zassert_equal(next, RECORD_CNT, "Got %u records instead of %u from CPU %u", next,
+		      RECORD_CNT, cpu);
+}
+
+/*
+ * The data traced on each CPU is output in chunks tagged with that CPU,
+ * complete and in order, while both CPUs trace at the same time.
+ */
+ZTEST(tracing_per_cpu, test_chunks)
+{
+	tracing_cmd_handle(enable_cmd, sizeof(enable_cmd) - 1);
+
+	for (uint8_t cpu = 0; cpu < 2; cpu++) {
+		k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE, trace_records,
+				UINT_TO_POINTER(cpu), NULL, NULL, K_PRIO_PREEMPT(5), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&threads[cpu], cpu));
+	}
+
+	k_thread_start(&threads[0]);
+	k_thread_start(&threads[1]);
+	zassert_ok(k_thread_join(&threads[0], K_SECONDS(5)));
+	zassert_ok(k_thread_join(&threads[1], K_SECONDS(5)));
+
+	tracing_cmd_handle(disable_cmd, sizeof(disable_cmd) - 1);
+
+	while (!tracing_buffer_is_empty()) {
+		k_msleep(10);
+	}
+
+	split_chunks();
+	check_stream(0);
+	check_stream(1);
+}
+
+static bool predicate(const void *state)
+{
+	ARG_UNUSED(state);
+
+	return arch_num_cpus() > 1;
+}
+
+ZTEST_SUITE(tracing_per_cpu, predicate, NULL, NULL, NULL, NULL);
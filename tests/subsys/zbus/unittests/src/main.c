@@ -780,6 +780,39 @@ ZTEST(basic, test_specification_based__zbus_sub_wait_msg)
 	irq_offload(isr_sub_wait_msg, NULL);
 }
 
+static void isr_sub_wait_msg_batch(const void *operation)
+{
+	const struct zbus_channel *chans[2];
+	int msgs[2];
+
+	/* All the calls must not work. Zbus cannot work in IRSs */
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(&foo_msg_sub, chans, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+}
+ZTEST(basic, test_specification_based__zbus_sub_wait_msg_batch)
+{
+	const struct zbus_channel *chans[2];
+	int msgs[2];
+
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(NULL, chans, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(&foo_sub, chans, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(&foo_msg_sub, NULL, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(&foo_msg_sub, chans, NULL, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+	zassert_equal(-EFAULT, zbus_sub_wait_msg_batch(&foo_msg_sub, chans, msgs, sizeof(msgs[0]),
+						       0, K_NO_WAIT));
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg_batch(&foo_msg_sub, chans, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_NO_WAIT));
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg_batch(&foo_msg_sub, chans, msgs, sizeof(msgs[0]),
+						       ARRAY_SIZE(msgs), K_MSEC(200)));
+
+	irq_offload(isr_sub_wait_msg_batch, NULL);
+}
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 static void isr_obs_attach_detach(const void *operation)
 {
@@ -129,4 +129,59 @@ ZTEST(lib_base64, test_base64_codec)
 	zassert_equal(rc, -ENOMEM, "Error: dst NULL: decode test return value");
 }
 
+ZTEST(lib_base64, test_base64_encode_stream)
+{
+	struct base64_encode_ctx ctx;
+	unsigned char expected[128];
+	unsigned char buffer[128];
+	unsigned char small[3];
+	size_t expected_len, len, pos;
+	int rc;
+
+	rc = base64_encode(expected, sizeof(expected), &expected_len, base64_test_dec,
+			   sizeof(base64_test_dec));
+	zassert_equal(rc, 0, "Error: one-shot encode");
+
+	/* Any split of the input gives the same output as encoding at once */
+	for (size_t chunk = 1; chunk <= 7; chunk++) {
+		base64_encode_init(&ctx);
+		pos = 0;
+
+		for (size_t i = 0; i < sizeof(base64_test_dec); i += chunk) {
+			rc = base64_encode_update(&ctx, &buffer[pos], sizeof(buffer) - pos, &len,
+						  &base64_test_dec[i],
+						  MIN(chunk, sizeof(base64_test_dec) - i));
+			zassert_equal(rc, 0, "Error: chunk %zu: update", chunk);
+			pos += len;
+		}
+
+		rc = base64_encode_finish(&ctx, &buffer[pos], sizeof(buffer) - pos, &len);
+		zassert_equal(rc, 0, "Error: chunk %zu: finish", chunk);
+		pos += len;
+
+		zassert_equal(pos, expected_len, "Error: chunk %zu: length", chunk);
+		zassert_mem_equal(buffer, expected, pos, "Error: chunk %zu: output", chunk);
+	}
+
+	/* Too small buffers report the size needed and consume nothing */
+	base64_encode_init(&ctx);
+	rc = base64_encode_update(&ctx, small, sizeof(small), &len, base64_test_dec, 5);
+	zassert_equal(rc, -ENOMEM, "Error: small: update return value");
+	zassert_equal(len, 4, "Error: small: update length value");
+
+	rc = base64_encode_update(&ctx, small, sizeof(small), &len, base64_test_dec, 2);
+	zassert_equal(rc, 0, "Error: partial group: update return value");
+	zassert_equal(len, 0, "Error: partial group: update length value");
+
+	rc = base64_encode_finish(&ctx, small, sizeof(small), &len);
+	zassert_equal(rc, -ENOMEM, "Error: small: finish return value");
+	zassert_equal(len, 4, "Error: small: finish length value");
+
+	rc = base64_encode_finish(&ctx, buffer, sizeof(buffer), &len);
+	zassert_equal(rc, 0, "Error: finish return value");
+	zassert_equal(len, 4, "Error: finish length value");
+	zassert_mem_equal(buffer, expected, 2, "Error: finish output");
+	zassert_equal(buffer[3], '=', "Error: finish padding");
+}
+
 ZTEST_SUITE(lib_base64, NULL, NULL, NULL, NULL, NULL);
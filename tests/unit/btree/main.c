@@ -0,0 +1,269 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+#include "../../../lib/utils/btree.c"
+
+#define NUM_KEYS 1000
+
+static struct sys_btree tree;
+
+/* Reference contents, indexed by key / 3 */
+static bool present[NUM_KEYS];
+static uint64_t values[NUM_KEYS];
+
+static int live_nodes;
+static bool fail_alloc;
+
+static void *test_allocator(void *ptr, size_t size)
+{
+	if (size == 0) {
+		if (ptr != NULL) {
+			live_nodes--;
+		}
+		free(ptr);
+		return NULL;
+	}
+
+	if (fail_alloc) {
+		return NULL;
+	}
+
+	live_nodes++;
+	return realloc(ptr, size);
+}
+
+/* Check the B-tree invariants below node, returns the number of keys */
+static size_t check_node(const struct sys_btree_node *node, int depth, bool is_root, uint64_t lo,
+			 uint64_t hi)
+{
+	size_t count = node->num_keys;
+
+	zassert_true(node->num_keys <= BTREE_MAX_KEYS, "node overflow");
+	zassert_true(is_root || node->num_keys >= BTREE_T - 1, "node underflow");
+
+	for (int i = 0; i < node->num_keys; i++) {
+		zassert_true(node->keys[i] >= lo && node->keys[i] <= hi, "key out of range");
+		zassert_true(i == 0 || node->keys[i] > node->keys[i - 1], "keys out of order");
+	}
+
+	if (node->leaf) {
+		zassert_equal(depth, tree.height, "leaves at different depths");
+		return count;
+	}
+
+	for (int i = 0; i <= node->num_keys; i++) {
+		count += check_node(node->children[i], depth + 1, false,
+				    (i == 0) ? lo : node->keys[i - 1] + 1,
+				    (i == node->num_keys) ? hi : node->keys[i] - 1);
+	}
+
+	return count;
+}
+
+static void check_tree(void)
+{
+	size_t count = 0;
+
+	for (int i = 0; i < NUM_KEYS; i++) {
+		count += present[i];
+	}
+
+	zassert_equal(sys_btree_size(&tree), count);
+	if (tree.root != NULL) {
+		zassert_equal(check_node(tree.root, 1, true, 0, UINT64_MAX), count);
+	} else {
+		zassert_equal(count, 0);
+	}
+}
+
+static void reset(void)
+{
+	sys_btree_clear(&tree, NULL, NULL);
+	zassert_equal(live_nodes, 0, "nodes leaked");
+	memset(present, 0, sizeof(present));
+}
+
+ZTEST(btree, test_insert_get_remove)
+{
+	uint64_t value;
+
+	reset();
+
+	for (uint64_t k = 0; k < 100; k++) {
+		zassert_equal(sys_btree_insert(&tree, k, k * 10, NULL), 1);
+	}
+	zassert_equal(sys_btree_size(&tree), 100);
+	zassert_true(tree.height > 1, "root never split");
+
+	zassert_equal(sys_btree_insert(&tree, 42, 4242, &value), 0);
+	zassert_equal(value, 420);
+
+	for (uint64_t k = 0; k < 100; k++) {
+		zassert_true(sys_btree_get(&tree, k, &value));
+		zassert_equal(value, (k == 42) ? 4242 : k * 10);
+	}
+	zassert_false(sys_btree_contains_key(&tree, 100));
+
+	for (uint64_t k = 0; k < 100; k += 2) {
+		zassert_true(sys_btree_remove(&tree, k, &value));
+		zassert_equal(value, (k == 42) ? 4242 : k * 10);
+	}
+	zassert_false(sys_btree_remove(&tree, 0, NULL));
+
+	for (uint64_t k = 1; k < 100; k += 2) {
+		zassert_true(sys_btree_remove(&tree, k, NULL));
+	}
+	zassert_true(sys_btree_is_empty(&tree));
+	zassert_is_null(tree.root);
+	zassert_equal(live_nodes, 0, "nodes leaked");
+}
+
+ZTEST(btree, test_random)
+{
+	uint64_t value;
+
+	reset();
+	srand(1);
+
+	for (int n = 0; n < 200000; n++) {
+		int i = rand() % NUM_KEYS;
+		uint64_t key = i * 3;
+		int op = rand() % 3;
+
+		/* Alternate growing and shrinking phases */
+		if (op == 0 || (op == 1 && (n / 20000) % 2 == 0)) {
+			zassert_equal(sys_btree_insert(&tree, key, n, &value), present[i] ? 0 : 1);
+			zassert_true(!present[i] || value == values[i]);
+			present[i] = true;
+			values[i] = n;
+		} else if (op == 1) {
+			zassert_equal(sys_btree_remove(&tree, key, &value), present[i]);
+			zassert_true(!present[i] || value == values[i]);
+			present[i] = false;
+		} else {
+			zassert_equal(sys_btree_get(&tree, key, &value), present[i]);
+			zassert_true(!present[i] || value == values[i]);
+			zassert_false(sys_btree_contains_key(&tree, key + 1));
+		}
+
+		if (n % 1000 == 0) {
+			check_tree();
+		}
+	}
+
+	check_tree();
+}
+
+ZTEST(btree, test_iterator)
+{
+	struct sys_btree_iter it;
+	int i;
+
+	reset();
+
+	for (i = 0; i < NUM_KEYS; i++) {
+		present[i] = (rand() % 2) == 0;
+		values[i] = rand();
+		if (present[i]) {
+			zassert_equal(sys_btree_insert(&tree, i * 3, values[i], NULL), 1);
+		}
+	}
+
+	i = 0;
+	SYS_BTREE_FOR_EACH(&tree, it) {
+		while (!present[i]) {
+			i++;
+		}
+		zassert_equal(it.key, i * 3);
+		zassert_equal(it.value, values[i]);
+		i++;
+	}
+	while (i < NUM_KEYS) {
+		zassert_false(present[i++], "entry not visited");
+	}
+
+	/* Start on, just before and just after existing keys */
+	for (int start = 0; start < NUM_KEYS * 3; start += 7) {
+		sys_btree_iter_init(&tree, &it, start);
+		for (i = DIV_ROUND_UP(start, 3); i < NUM_KEYS && !present[i]; i++) {
+		}
+		if (i == NUM_KEYS) {
+			zassert_false(sys_btree_iter_next(&it));
+		} else {
+			zassert_true(sys_btree_iter_next(&it));
+			zassert_equal(it.key, i * 3);
+		}
+	}
+}
+
+static void count_entry(uint64_t key, uint64_t value, void *cookie)
+{
+	size_t *count = cookie;
+
+	zassert_equal(value, key + 1);
+	(*count)++;
+}
+
+ZTEST(btree, test_clear)
+{
+	size_t count = 0;
+
+	reset();
+
+	for (uint64_t k = 0; k < 500; k++) {
+		zassert_equal(sys_btree_insert(&tree, k, k + 1, NULL), 1);
+	}
+
+	sys_btree_clear(&tree, count_entry, &count);
+	zassert_equal(count, 500);
+	zassert_true(sys_btree_is_empty(&tree));
+	zassert_equal(live_nodes, 0, "nodes leaked");
+}
+
+ZTEST(btree, test_no_memory)
+{
+	struct sys_btree_iter it;
+	uint64_t k;
+	int ret;
+
+	reset();
+
+	fail_alloc = true;
+	zassert_equal(sys_btree_insert(&tree, 1, 1, NULL), -ENOMEM);
+	fail_alloc = false;
+
+	/* Fill until an insertion needs a split, then fail it */
+	for (k = 0; sys_btree_size(&tree) < BTREE_MAX_KEYS; k++) {
+		zassert_equal(sys_btree_insert(&tree, k, k, NULL), 1);
+	}
+	fail_alloc = true;
+	ret = sys_btree_insert(&tree, k, k, NULL);
+	fail_alloc = false;
+
+	zassert_equal(ret, -ENOMEM);
+	zassert_equal(sys_btree_size(&tree), BTREE_MAX_KEYS);
+	zassert_false(sys_btree_contains_key(&tree, k));
+
+	k = 0;
+	SYS_BTREE_FOR_EACH(&tree, it) {
+		zassert_equal(it.key, k++);
+	}
+	zassert_equal(k, BTREE_MAX_KEYS);
+
+	reset();
+}
+
+static void *btree_setup(void)
+{
+	sys_btree_init(&tree, test_allocator);
+
+	return NULL;
+}
+
+ZTEST_SUITE(btree, NULL, btree_setup, NULL, NULL, NULL);
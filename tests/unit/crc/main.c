@@ -73,6 +73,19 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc32_long)
+{
+	uint8_t test[100];
+
+	for (size_t i = 0; i < sizeof(test); i++) {
+		test[i] = i * 7 + 3;
+	}
+
+	/* Unaligned and not a multiple of the word or slice length */
+	zassert_equal(crc32_ieee(&test[1], 97), 0x3C88FABB);
+	zassert_equal(crc32_c(0, &test[3], 90, true, true), 0x434F8697);
+}
+
 ZTEST(crc, test_crc24_pgp)
 {
 	uint8_t test1[] = { 'A' };
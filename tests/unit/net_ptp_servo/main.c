@@ -0,0 +1,148 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <math.h>
+
+#include "../../../subsys/net/ip/ptp_servo.c"
+
+#define BANDWIDTH_MHZ 40
+#define MAX_PPB       100000
+/* The local clock runs slower than the master by this much */
+#define CLOCK_ERR_PPB 1000.0
+
+/* Local clock disciplined by the servo, one sample per second */
+struct sim {
+	struct net_ptp_servo servo;
+	double offset;
+	uint64_t time;
+};
+
+static void sim_init(struct sim *sim, uint32_t bandwidth_mhz, uint32_t max_ppb)
+{
+	net_ptp_servo_init(&sim->servo, bandwidth_mhz, max_ppb);
+	sim->offset = 0.0;
+	sim->time = NSEC_PER_SEC;
+}
+
+/* Feed a sample measured with the given error, then let a second pass */
+static double sim_step(struct sim *sim, double measure_err)
+{
+	double ppb;
+
+	ppb = net_ptp_servo_sample(&sim->servo, (int64_t)(sim->offset + measure_err), sim->time);
+
+	sim->offset += CLOCK_ERR_PPB - ppb;
+	sim->time += NSEC_PER_SEC;
+
+	return ppb;
+}
+
+static void sim_converge(struct sim *sim)
+{
+	double ppb = 0.0;
+
+	for (int i = 0; i < 100; i++) {
+		ppb = sim_step(sim, 0.0);
+	}
+
+	zassert_within(sim->offset, 0.0, 10.0, "Offset %f ns not corrected", sim->offset);
+	zassert_within(ppb, CLOCK_ERR_PPB, 10.0, "Adjustment %f ppb", ppb);
+}
+
+/* The servo locks on the master frequency, removing the offset */
+ZTEST(net_ptp_servo, test_convergence)
+{
+	struct sim sim;
+
+	sim_init(&sim, BANDWIDTH_MHZ, MAX_PPB);
+	sim_converge(&sim);
+}
+
+/* A single delayed Sync message does not disturb a locked servo */
+ZTEST(net_ptp_servo, test_spike)
+{
+	struct sim sim;
+	double ppb;
+
+	sim_init(&sim, BANDWIDTH_MHZ, MAX_PPB);
+	sim_converge(&sim);
+
+	ppb = sim_step(&sim, 1000000.0);
+	zassert_within(ppb, CLOCK_ERR_PPB, 10.0, "Spike changed the adjustment to %f ppb", ppb);
+
+	for (int i = 0; i < 3; i++) {
+		ppb = sim_step(&sim, 0.0);
+		zassert_within(ppb, CLOCK_ERR_PPB, 10.0, "Spike changed the adjustment to %f ppb",
+			       ppb);
+	}
+}
+
+/* The output is limited, and the integral term does not wind up meanwhile */
+ZTEST(net_ptp_servo, test_saturation)
+{
+	struct net_ptp_servo servo;
+	uint64_t time = NSEC_PER_SEC;
+	int i;
+
+	net_ptp_servo_init(&servo, BANDWIDTH_MHZ, 500);
+
+	for (i = 0; i < 10; i++, time += NSEC_PER_SEC) {
+		zassert_equal(net_ptp_servo_sample(&servo, 1000000, time), 500.0);
+	}
+
+	/* Once the median filter sees the offset gone, nothing is left */
+	for (i = 0; i < NET_PTP_SERVO_FILTER_LEN; i++, time += NSEC_PER_SEC) {
+		(void)net_ptp_servo_sample(&servo, 0, time);
+	}
+
+	zassert_equal(net_ptp_servo_sample(&servo, 0, time), 0.0);
+}
+
+/* The gains follow the bandwidth and the interval between the samples */
+ZTEST(net_ptp_servo, test_gains)
+{
+	struct net_ptp_servo servo;
+	double wn, ppb;
+
+	for (uint32_t bandwidth = 10; bandwidth <= 160; bandwidth *= 2) {
+		wn = 2.0 * M_PI * bandwidth / 1000.0;
+
+		/* The first sample has no interval, one second is assumed */
+		net_ptp_servo_init(&servo, bandwidth, MAX_PPB);
+		ppb = net_ptp_servo_sample(&servo, 1000, NSEC_PER_SEC);
+		zassert_within(ppb, (2.0 * DAMPING * wn + wn * wn) * 1000, 0.01,
+			       "%f ppb at %u mHz", ppb, bandwidth);
+
+		/* Four seconds later, the integral term is four times larger */
+		net_ptp_servo_init(&servo, bandwidth, MAX_PPB);
+		(void)net_ptp_servo_sample(&servo, 0, NSEC_PER_SEC);
+		ppb = net_ptp_servo_sample(&servo, 1000, 5 * NSEC_PER_SEC);
+		zassert_within(ppb, (2.0 * DAMPING * wn + 4.0 * wn * wn) * 1000, 0.01,
+			       "%f ppb at %u mHz", ppb, bandwidth);
+	}
+}
+
+/* A reset forgets the offsets measured before a step, not the frequency */
+ZTEST(net_ptp_servo, test_reset)
+{
+	struct sim sim;
+	double ppb;
+
+	sim_init(&sim, BANDWIDTH_MHZ, MAX_PPB);
+	sim_converge(&sim);
+
+	/* Without a reset, this offset would be taken as a spike */
+	net_ptp_servo_reset(&sim.servo);
+	sim.offset = 1000.0;
+
+	ppb = sim_step(&sim, 0.0);
+	zassert_true(ppb > CLOCK_ERR_PPB + 100.0, "Offset ignored after a reset (%f ppb)", ppb);
+	zassert_within(sim.servo.drift, CLOCK_ERR_PPB, 100.0, "Frequency lost (%f ppb)",
+		       sim.servo.drift);
+}
+
+ZTEST_SUITE(net_ptp_servo, NULL, NULL, NULL, NULL, NULL);